@@ -4,8 +4,13 @@
 
 #include "base/allocator/allocator_extension.h"
 
+#include "base/allocator/buildflags.h"
 #include "base/logging.h"
 
+#if BUILDFLAG(CAN_USE_THREAD_CACHE_ALLOCATOR)
+#include "base/allocator/thread_cache_allocator.h"
+#endif
+
 #if defined(USE_TCMALLOC)
 #include "third_party/tcmalloc/chromium/src/gperftools/heap-profiler.h"
 #include "third_party/tcmalloc/chromium/src/gperftools/malloc_extension.h"
@@ -16,6 +21,9 @@ namespace base {
 namespace allocator {
 
 void ReleaseFreeMemory() {
+#if BUILDFLAG(CAN_USE_THREAD_CACHE_ALLOCATOR)
+  PurgeThreadCacheAllocator();
+#endif
 #if defined(USE_TCMALLOC)
   ::MallocExtension::instance()->ReleaseFreeMemory();
 #endif
@@ -0,0 +1,758 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/allocator/thread_cache_allocator.h"
+
+#include <pthread.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include <algorithm>
+
+#include "base/allocator/allocator_shim.h"
+#include "base/bind.h"
+#include "base/bits.h"
+#include "base/logging.h"
+#include "base/memory/memory_pressure_listener.h"
+#include "base/memory/ptr_util.h"
+#include "base/no_destructor.h"
+#include "base/numerics/checked_math.h"
+#include "base/synchronization/lock.h"
+#include "build/build_config.h"
+
+namespace base {
+namespace allocator {
+namespace internal {
+
+namespace {
+
+// Slots are at least this large, which is also their minimum alignment.
+constexpr size_t kMinSlotSize = 16;
+
+// Size classes are spaced by kMinSlotSize up to 128 bytes, then 4 per power of
+// two up to kMaxSlotSize, which bounds the rounding up of allocations to 25%.
+constexpr size_t kNumLinearSizeClasses = 8;
+constexpr size_t kNumSizeClasses = 40;
+
+// Size of the spans in which slots are carved and which are purged as a
+// whole. Spans are aligned on their size.
+constexpr size_t kSpanSize = 64 * 1024;
+
+// Address space reserved for each size class.
+constexpr size_t kRegionSize = size_t{256} * 1024 * 1024;
+constexpr size_t kSpansPerRegion = kRegionSize / kSpanSize;
+
+// Each thread caches up to this many bytes of free slots per size class, with
+// at least one and at most kMaxCachedSlots slots.
+constexpr size_t kThreadCacheBytesPerSizeClass = 8 * 1024;
+constexpr size_t kMaxCachedSlots = 128;
+
+// Set in the TLS slot while the thread cache is created, as this may allocate,
+// and once it was destroyed, so that slots freed later during thread teardown
+// go straight to the spans.
+void* const kInitializationSentinel = reinterpret_cast<void*>(1);
+void* const kTeardownSentinel = reinterpret_cast<void*>(2);
+
+// Copy of the TLS slot of the allocator a thread last used, which is much
+// faster to read. Allocators are identified by a unique id rather than their
+// address, which could be reused by an allocator created after one was
+// deleted, e.g. in tests. The initial-exec model keeps accesses from calling
+// into the dynamic linker, which may allocate.
+std::atomic<uint64_t> g_next_allocator_id{1};
+__thread uint64_t g_fast_thread_cache_allocator_id
+    __attribute__((tls_model("initial-exec")));
+__thread void* g_fast_thread_cache __attribute__((tls_model("initial-exec")));
+
+constexpr size_t GetSlotSizeOfClass(size_t size_class) {
+  return size_class < kNumLinearSizeClasses
+             ? (size_class + 1) * kMinSlotSize
+             : (size_t{1} << ((size_class - kNumLinearSizeClasses) / 4 + 7)) +
+                   ((size_class - kNumLinearSizeClasses) % 4 + 1) *
+                       (size_t{1}
+                        << ((size_class - kNumLinearSizeClasses) / 4 + 5));
+}
+
+static_assert(GetSlotSizeOfClass(kNumLinearSizeClasses - 1) == 128,
+              "Linear size classes must end at 128 bytes");
+static_assert(GetSlotSizeOfClass(kNumSizeClasses - 1) ==
+                  ThreadCacheAllocator::kMaxSlotSize,
+              "The last size class must be kMaxSlotSize");
+static_assert(kSpanSize >= 2 * ThreadCacheAllocator::kMaxSlotSize,
+              "Spans must hold several slots of any size class");
+
+size_t GetSizeClass(size_t size) {
+  DCHECK_LE(size, ThreadCacheAllocator::kMaxSlotSize);
+  if (size <= GetSlotSizeOfClass(kNumLinearSizeClasses - 1))
+    return size == 0 ? 0 : (size - 1) / kMinSlotSize;
+
+  // |size| is in (2^order, 2^(order + 1)], which is split in 4 size classes.
+  const int order = bits::Log2Floor(static_cast<uint32_t>(size - 1));
+  const size_t step = size_t{1} << (order - 2);
+  return kNumLinearSizeClasses + (order - 7) * 4 +
+         (size - (size_t{1} << order) - 1) / step;
+}
+
+}  // namespace
+
+struct ThreadCacheAllocator::FreeSlot {
+  FreeSlot* next;
+};
+
+// Metadata of the spans lives apart from the spans so that purging a span
+// doesn't lose it.
+struct ThreadCacheAllocator::SpanMetadata {
+  // Free slots, among the first |num_carved_slots| of the span.
+  FreeSlot* free_list;
+
+  // Neighbours in the list of available spans of the size class.
+  SpanMetadata* prev;
+  SpanMetadata* next;
+
+  uint32_t num_allocated_slots;
+
+  // Number of slots from the start of the span handed out since the span was
+  // last committed. The others have never been touched.
+  uint32_t num_carved_slots;
+
+  // Whether the span was touched since it was last purged.
+  bool committed;
+
+  // Whether the span is in the list of available spans, i.e. has free slots.
+  bool available;
+};
+
+struct ThreadCacheAllocator::SizeClass {
+  // Protects all the members below but the constant ones, and the metadata
+  // of the spans of this size class.
+  Lock lock;
+
+  size_t slot_size = 0;
+  uint32_t slots_per_span = 0;
+  uint32_t max_cached_slots = 0;
+
+  // Number of spans from the start of the region which were ever used. Spans
+  // past it are inaccessible.
+  size_t num_used_spans = 0;
+
+  size_t num_committed_spans = 0;
+  size_t num_allocated_slots = 0;
+
+  // Spans with free slots, most recently available first.
+  SpanMetadata* available_spans = nullptr;
+
+  void LinkAvailableSpan(SpanMetadata* span) {
+    DCHECK(!span->available);
+    span->available = true;
+    span->prev = nullptr;
+    span->next = available_spans;
+    if (available_spans)
+      available_spans->prev = span;
+    available_spans = span;
+  }
+
+  void UnlinkAvailableSpan(SpanMetadata* span) {
+    DCHECK(span->available);
+    span->available = false;
+    if (span->prev)
+      span->prev->next = span->next;
+    else
+      available_spans = span->next;
+    if (span->next)
+      span->next->prev = span->prev;
+    span->prev = nullptr;
+    span->next = nullptr;
+  }
+};
+
+// Allocated in a slot of the allocator itself.
+struct ThreadCacheAllocator::ThreadCache {
+  ThreadCacheAllocator* owner;
+  uint32_t purge_generation;
+
+  FreeSlot* free_lists[kNumSizeClasses];
+  uint32_t num_cached_slots[kNumSizeClasses];
+
+  size_t cached_bytes;
+  // Value of |cached_bytes| last added to the process-wide count.
+  size_t reported_cached_bytes;
+};
+
+// static
+constexpr size_t ThreadCacheAllocator::kMaxSlotSize;
+
+// static
+std::unique_ptr<ThreadCacheAllocator> ThreadCacheAllocator::Create() {
+#if defined(ARCH_CPU_64_BITS)
+  const size_t metadata_size = bits::Align(
+      kNumSizeClasses * kSpansPerRegion * sizeof(SpanMetadata), kSpanSize);
+  // Leaves room to align the regions on kSpanSize.
+  const size_t mapping_size =
+      metadata_size + kNumSizeClasses * kRegionSize + kSpanSize;
+
+  // Nothing is committed until spans are used, and only the metadata is
+  // accessible.
+  void* const mapping =
+      mmap(nullptr, mapping_size, PROT_NONE,
+           MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (mapping == MAP_FAILED)
+    return nullptr;
+  if (mprotect(mapping, metadata_size, PROT_READ | PROT_WRITE) != 0) {
+    munmap(mapping, mapping_size);
+    return nullptr;
+  }
+
+  char* const regions = reinterpret_cast<char*>(bits::Align(
+      reinterpret_cast<uintptr_t>(mapping) + metadata_size, kSpanSize));
+  return WrapUnique(new ThreadCacheAllocator(static_cast<char*>(mapping),
+                                             mapping_size, regions));
+#else
+  // There isn't enough address space to reserve regions.
+  return nullptr;
+#endif  // defined(ARCH_CPU_64_BITS)
+}
+
+ThreadCacheAllocator::ThreadCacheAllocator(char* mapping,
+                                           size_t mapping_size,
+                                           char* regions)
+    : id_(g_next_allocator_id.fetch_add(1, std::memory_order_relaxed)),
+      mapping_(mapping),
+      mapping_size_(mapping_size),
+      regions_(regions),
+      size_classes_(new SizeClass[kNumSizeClasses]),
+      thread_cache_tls_(&ThreadCacheAllocator::OnThreadExit) {
+  for (size_t size_class = 0; size_class < kNumSizeClasses; ++size_class) {
+    SizeClass& sc = size_classes_[size_class];
+    sc.slot_size = GetSlotSizeOfClass(size_class);
+    sc.slots_per_span = kSpanSize / sc.slot_size;
+    sc.max_cached_slots = std::max<size_t>(
+        1, std::min(kMaxCachedSlots,
+                    kThreadCacheBytesPerSizeClass / sc.slot_size));
+  }
+}
+
+ThreadCacheAllocator::~ThreadCacheAllocator() {
+  munmap(mapping_, mapping_size_);
+}
+
+void* ThreadCacheAllocator::Allocate(size_t size) {
+  if (size > kMaxSlotSize)
+    return nullptr;
+  return AllocateFromSizeClass(GetSizeClass(size));
+}
+
+void* ThreadCacheAllocator::AllocateAligned(size_t alignment, size_t size) {
+  if (alignment <= kMinSlotSize)
+    return Allocate(size);
+  if (alignment > kMaxSlotSize || !bits::IsPowerOfTwo(alignment) ||
+      size > kMaxSlotSize) {
+    return nullptr;
+  }
+
+  // Spans are aligned on kSpanSize, so all the slots of a size class are
+  // aligned on |alignment| if their size is a multiple of it. Powers of two
+  // are size classes.
+  for (size_t size_class = GetSizeClass(std::max(size, alignment));
+       size_class < kNumSizeClasses; ++size_class) {
+    if (size_classes_[size_class].slot_size % alignment == 0)
+      return AllocateFromSizeClass(size_class);
+  }
+  NOTREACHED();
+  return nullptr;
+}
+
+void ThreadCacheAllocator::Free(void* address) {
+  DCHECK(Owns(address));
+  const size_t size_class = GetSizeClassOf(address);
+  FreeSlot* const slot = static_cast<FreeSlot*>(address);
+
+  ThreadCache* const cache = GetThreadCache();
+  if (!cache) {
+    slot->next = nullptr;
+    PushSlots(size_class, slot, 1);
+    return;
+  }
+
+  slot->next = cache->free_lists[size_class];
+  cache->free_lists[size_class] = slot;
+  cache->cached_bytes += size_classes_[size_class].slot_size;
+  if (++cache->num_cached_slots[size_class] >
+      size_classes_[size_class].max_cached_slots) {
+    ReleaseCachedSlots(cache, size_class);
+  }
+}
+
+bool ThreadCacheAllocator::Owns(const void* address) const {
+  const char* const p = static_cast<const char*>(address);
+  return p >= regions_ && p < regions_ + kNumSizeClasses * kRegionSize;
+}
+
+size_t ThreadCacheAllocator::GetSlotSize(const void* address) const {
+  DCHECK(Owns(address));
+  return size_classes_[GetSizeClassOf(address)].slot_size;
+}
+
+// static
+bool ThreadCacheAllocator::IsSameSizeClass(size_t size, size_t new_size) {
+  return size <= kMaxSlotSize && new_size <= kMaxSlotSize &&
+         GetSizeClass(size) == GetSizeClass(new_size);
+}
+
+void ThreadCacheAllocator::Purge() {
+  purge_generation_.fetch_add(1, std::memory_order_relaxed);
+  // Flushes the cache of the calling thread.
+  GetThreadCache();
+
+  for (size_t size_class = 0; size_class < kNumSizeClasses; ++size_class) {
+    SizeClass& sc = size_classes_[size_class];
+    AutoLock auto_lock(sc.lock);
+    for (SpanMetadata* span = sc.available_spans; span; span = span->next) {
+      if (span->num_allocated_slots != 0 || !span->committed)
+        continue;
+      const size_t span_index = span - GetSpanMetadata(size_class, 0);
+      madvise(GetSpanStart(size_class, span_index), kSpanSize, MADV_DONTNEED);
+      // The free list was stored in the discarded pages.
+      span->free_list = nullptr;
+      span->num_carved_slots = 0;
+      span->committed = false;
+      --sc.num_committed_spans;
+    }
+  }
+}
+
+ThreadCacheAllocatorStats ThreadCacheAllocator::GetStats() {
+  ThreadCache* const cache = GetThreadCache();
+  if (cache)
+    ReportThreadCacheBytes(cache);
+
+  ThreadCacheAllocatorStats stats;
+  size_t allocated_slot_bytes = 0;
+  for (size_t size_class = 0; size_class < kNumSizeClasses; ++size_class) {
+    SizeClass& sc = size_classes_[size_class];
+    AutoLock auto_lock(sc.lock);
+    stats.committed_bytes += sc.num_committed_spans * kSpanSize;
+    allocated_slot_bytes += sc.num_allocated_slots * sc.slot_size;
+  }
+  // Slots in thread caches were allocated from the spans. Counts of other
+  // threads lag behind, so clamp.
+  stats.thread_cache_bytes = std::min(
+      allocated_slot_bytes,
+      static_cast<size_t>(std::max<int64_t>(
+          0, thread_cache_bytes_.load(std::memory_order_relaxed))));
+  stats.allocated_bytes = allocated_slot_bytes - stats.thread_cache_bytes;
+  return stats;
+}
+
+void ThreadCacheAllocator::LockAll() {
+  for (size_t size_class = 0; size_class < kNumSizeClasses; ++size_class)
+    size_classes_[size_class].lock.Acquire();
+}
+
+void ThreadCacheAllocator::UnlockAll() {
+  for (size_t size_class = 0; size_class < kNumSizeClasses; ++size_class)
+    size_classes_[size_class].lock.Release();
+}
+
+void* ThreadCacheAllocator::AllocateFromSizeClass(size_t size_class) {
+  ThreadCache* const cache = GetThreadCache();
+  if (!cache)
+    return AllocateUncached(size_class);
+
+  FreeSlot* const slot = cache->free_lists[size_class];
+  if (!slot)
+    return RefillAndAllocate(cache, size_class);
+
+  cache->free_lists[size_class] = slot->next;
+  --cache->num_cached_slots[size_class];
+  cache->cached_bytes -= size_classes_[size_class].slot_size;
+  return slot;
+}
+
+ThreadCacheAllocator::ThreadCache* ThreadCacheAllocator::GetThreadCache() {
+  ThreadCache* cache;
+  if (LIKELY(g_fast_thread_cache_allocator_id == id_)) {
+    cache = static_cast<ThreadCache*>(g_fast_thread_cache);
+  } else {
+    cache = GetThreadCacheSlow();
+    if (!cache)
+      return nullptr;
+  }
+
+  const uint32_t purge_generation =
+      purge_generation_.load(std::memory_order_relaxed);
+  if (UNLIKELY(cache->purge_generation != purge_generation)) {
+    cache->purge_generation = purge_generation;
+    FlushThreadCache(cache);
+  }
+  return cache;
+}
+
+ThreadCacheAllocator::ThreadCache* ThreadCacheAllocator::GetThreadCacheSlow() {
+  if (ThreadLocalStorage::HasBeenDestroyed())
+    return nullptr;
+  void* const value = thread_cache_tls_.Get();
+  if (value == kInitializationSentinel || value == kTeardownSentinel)
+    return nullptr;
+
+  ThreadCache* cache = static_cast<ThreadCache*>(value);
+  if (!cache) {
+    // Prevent reentrancy, as setting the TLS slot may allocate.
+    thread_cache_tls_.Set(kInitializationSentinel);
+    static_assert(sizeof(ThreadCache) <= kMaxSlotSize,
+                  "ThreadCache must fit in a slot");
+    cache = static_cast<ThreadCache*>(
+        AllocateUncached(GetSizeClass(sizeof(ThreadCache))));
+    if (!cache) {
+      thread_cache_tls_.Set(nullptr);
+      return nullptr;
+    }
+    memset(cache, 0, sizeof(*cache));
+    cache->owner = this;
+    cache->purge_generation = purge_generation_.load(std::memory_order_relaxed);
+    thread_cache_tls_.Set(cache);
+  }
+
+  g_fast_thread_cache_allocator_id = id_;
+  g_fast_thread_cache = cache;
+  return cache;
+}
+
+// static
+void ThreadCacheAllocator::OnThreadExit(void* value) {
+  // This is called a second time with the sentinel set below.
+  if (value == kTeardownSentinel)
+    return;
+  DCHECK_NE(kInitializationSentinel, value);
+
+  ThreadCache* const cache = static_cast<ThreadCache*>(value);
+  ThreadCacheAllocator* const owner = cache->owner;
+  owner->thread_cache_tls_.Set(kTeardownSentinel);
+  if (g_fast_thread_cache_allocator_id == owner->id_) {
+    g_fast_thread_cache_allocator_id = 0;
+    g_fast_thread_cache = nullptr;
+  }
+  owner->FlushThreadCache(cache);
+
+  FreeSlot* const slot = reinterpret_cast<FreeSlot*>(cache);
+  slot->next = nullptr;
+  owner->PushSlots(owner->GetSizeClassOf(slot), slot, 1);
+}
+
+void* ThreadCacheAllocator::AllocateUncached(size_t size_class) {
+  size_t num_popped;
+  return PopSlots(size_class, 1, &num_popped);
+}
+
+void* ThreadCacheAllocator::RefillAndAllocate(ThreadCache* cache,
+                                              size_t size_class) {
+  DCHECK(!cache->free_lists[size_class]);
+  const SizeClass& sc = size_classes_[size_class];
+
+  // One slot for the caller, and half a cache.
+  size_t num_popped;
+  FreeSlot* const slots =
+      PopSlots(size_class, sc.max_cached_slots / 2 + 1, &num_popped);
+  if (!slots)
+    return nullptr;
+
+  cache->free_lists[size_class] = slots->next;
+  cache->num_cached_slots[size_class] = num_popped - 1;
+  cache->cached_bytes += (num_popped - 1) * sc.slot_size;
+  ReportThreadCacheBytes(cache);
+  return slots;
+}
+
+void ThreadCacheAllocator::ReleaseCachedSlots(ThreadCache* cache,
+                                              size_t size_class) {
+  const SizeClass& sc = size_classes_[size_class];
+  const uint32_t num_cached_slots = cache->num_cached_slots[size_class];
+  const uint32_t num_kept_slots = sc.max_cached_slots / 2;
+  DCHECK_GT(num_cached_slots, num_kept_slots);
+
+  // Keep the most recently freed slots, which are at the head of the list.
+  FreeSlot* released_slots;
+  if (num_kept_slots == 0) {
+    released_slots = cache->free_lists[size_class];
+    cache->free_lists[size_class] = nullptr;
+  } else {
+    FreeSlot* last_kept_slot = cache->free_lists[size_class];
+    for (uint32_t i = 1; i < num_kept_slots; ++i)
+      last_kept_slot = last_kept_slot->next;
+    released_slots = last_kept_slot->next;
+    last_kept_slot->next = nullptr;
+  }
+
+  const size_t num_released_slots = num_cached_slots - num_kept_slots;
+  cache->num_cached_slots[size_class] = num_kept_slots;
+  cache->cached_bytes -= num_released_slots * sc.slot_size;
+  PushSlots(size_class, released_slots, num_released_slots);
+  ReportThreadCacheBytes(cache);
+}
+
+void ThreadCacheAllocator::FlushThreadCache(ThreadCache* cache) {
+  for (size_t size_class = 0; size_class < kNumSizeClasses; ++size_class) {
+    if (!cache->free_lists[size_class])
+      continue;
+    PushSlots(size_class, cache->free_lists[size_class],
+              cache->num_cached_slots[size_class]);
+    cache->free_lists[size_class] = nullptr;
+    cache->num_cached_slots[size_class] = 0;
+  }
+  cache->cached_bytes = 0;
+  ReportThreadCacheBytes(cache);
+}
+
+void ThreadCacheAllocator::ReportThreadCacheBytes(ThreadCache* cache) {
+  thread_cache_bytes_.fetch_add(
+      static_cast<int64_t>(cache->cached_bytes) -
+          static_cast<int64_t>(cache->reported_cached_bytes),
+      std::memory_order_relaxed);
+  cache->reported_cached_bytes = cache->cached_bytes;
+}
+
+ThreadCacheAllocator::FreeSlot* ThreadCacheAllocator::PopSlots(
+    size_t size_class,
+    size_t count,
+    size_t* popped) {
+  SizeClass& sc = size_classes_[size_class];
+  FreeSlot* head = nullptr;
+  size_t num_popped = 0;
+
+  AutoLock auto_lock(sc.lock);
+  while (num_popped < count) {
+    SpanMetadata* span = sc.available_spans;
+    if (!span) {
+      // Make the next span of the region accessible.
+      if (sc.num_used_spans == kSpansPerRegion)
+        break;
+      if (mprotect(GetSpanStart(size_class, sc.num_used_spans), kSpanSize,
+                   PROT_READ | PROT_WRITE) != 0) {
+        break;
+      }
+      span = GetSpanMetadata(size_class, sc.num_used_spans++);
+      sc.LinkAvailableSpan(span);
+    }
+    if (!span->committed) {
+      span->committed = true;
+      ++sc.num_committed_spans;
+    }
+
+    char* const span_start =
+        GetSpanStart(size_class, span - GetSpanMetadata(size_class, 0));
+    while (num_popped < count &&
+           span->num_allocated_slots < sc.slots_per_span) {
+      FreeSlot* slot = span->free_list;
+      if (slot) {
+        span->free_list = slot->next;
+      } else {
+        DCHECK_LT(span->num_carved_slots, sc.slots_per_span);
+        slot = reinterpret_cast<FreeSlot*>(
+            span_start + span->num_carved_slots++ * sc.slot_size);
+      }
+      slot->next = head;
+      head = slot;
+      ++span->num_allocated_slots;
+      ++num_popped;
+    }
+    if (span->num_allocated_slots == sc.slots_per_span)
+      sc.UnlinkAvailableSpan(span);
+  }
+
+  sc.num_allocated_slots += num_popped;
+  *popped = num_popped;
+  return head;
+}
+
+void ThreadCacheAllocator::PushSlots(size_t size_class,
+                                     FreeSlot* head,
+                                     size_t count) {
+  SizeClass& sc = size_classes_[size_class];
+  AutoLock auto_lock(sc.lock);
+
+  FreeSlot* slot = head;
+  for (size_t i = 0; i < count; ++i) {
+    DCHECK(slot);
+    DCHECK_EQ(size_class, GetSizeClassOf(slot));
+    FreeSlot* const next = slot->next;
+    SpanMetadata* const span = GetSpanMetadata(
+        size_class,
+        (reinterpret_cast<char*>(slot) - regions_) % kRegionSize / kSpanSize);
+    DCHECK_GT(span->num_allocated_slots, 0u);
+    slot->next = span->free_list;
+    span->free_list = slot;
+    if (span->num_allocated_slots-- == sc.slots_per_span)
+      sc.LinkAvailableSpan(span);
+    slot = next;
+  }
+  DCHECK(!slot);
+  sc.num_allocated_slots -= count;
+}
+
+size_t ThreadCacheAllocator::GetSizeClassOf(const void* address) const {
+  return (static_cast<const char*>(address) - regions_) / kRegionSize;
+}
+
+ThreadCacheAllocator::SpanMetadata* ThreadCacheAllocator::GetSpanMetadata(
+    size_t size_class,
+    size_t span_index) {
+  return reinterpret_cast<SpanMetadata*>(mapping_) +
+         size_class * kSpansPerRegion + span_index;
+}
+
+char* ThreadCacheAllocator::GetSpanStart(size_t size_class,
+                                         size_t span_index) const {
+  return regions_ + size_class * kRegionSize + span_index * kSpanSize;
+}
+
+}  // namespace internal
+
+namespace {
+
+using internal::ThreadCacheAllocator;
+
+// Set once, before the dispatch is inserted.
+ThreadCacheAllocator* g_allocator = nullptr;
+
+void* ThreadCacheMalloc(const AllocatorDispatch* self,
+                        size_t size,
+                        void* context) {
+  void* const address = g_allocator->Allocate(size);
+  if (address)
+    return address;
+  return self->next->alloc_function(self->next, size, context);
+}
+
+void* ThreadCacheCalloc(const AllocatorDispatch* self,
+                        size_t n,
+                        size_t size,
+                        void* context) {
+  size_t total_size;
+  if (CheckMul(n, size).AssignIfValid(&total_size)) {
+    void* const address = g_allocator->Allocate(total_size);
+    if (address) {
+      // Slots are recycled without being cleared.
+      memset(address, 0, total_size);
+      return address;
+    }
+  }
+  return self->next->alloc_zero_initialized_function(self->next, n, size,
+                                                     context);
+}
+
+void* ThreadCacheMemalign(const AllocatorDispatch* self,
+                          size_t alignment,
+                          size_t size,
+                          void* context) {
+  void* const address = g_allocator->AllocateAligned(alignment, size);
+  if (address)
+    return address;
+  return self->next->alloc_aligned_function(self->next, alignment, size,
+                                            context);
+}
+
+void ThreadCacheFree(const AllocatorDispatch* self,
+                     void* address,
+                     void* context) {
+  // Allocations made before the allocator was installed, or too large for it,
+  // belong to the next allocator.
+  if (g_allocator->Owns(address)) {
+    g_allocator->Free(address);
+    return;
+  }
+  self->next->free_function(self->next, address, context);
+}
+
+void* ThreadCacheRealloc(const AllocatorDispatch* self,
+                         void* address,
+                         size_t size,
+                         void* context) {
+  if (!address)
+    return ThreadCacheMalloc(self, size, context);
+  if (!g_allocator->Owns(address))
+    return self->next->realloc_function(self->next, address, size, context);
+  if (size == 0) {
+    g_allocator->Free(address);
+    return nullptr;
+  }
+
+  const size_t slot_size = g_allocator->GetSlotSize(address);
+  if (ThreadCacheAllocator::IsSameSizeClass(slot_size, size))
+    return address;
+  void* const new_address = ThreadCacheMalloc(self, size, context);
+  if (!new_address)
+    return nullptr;
+  memcpy(new_address, address, std::min(slot_size, size));
+  g_allocator->Free(address);
+  return new_address;
+}
+
+size_t ThreadCacheGetSizeEstimate(const AllocatorDispatch* self,
+                                  void* address,
+                                  void* context) {
+  if (g_allocator->Owns(address))
+    return g_allocator->GetSlotSize(address);
+  return self->next->get_size_estimate_function(self->next, address, context);
+}
+
+AllocatorDispatch g_thread_cache_allocator_dispatch = {
+    &ThreadCacheMalloc,          /* alloc_function */
+    &ThreadCacheCalloc,          /* alloc_zero_initialized_function */
+    &ThreadCacheMemalign,        /* alloc_aligned_function */
+    &ThreadCacheRealloc,         /* realloc_function */
+    &ThreadCacheFree,            /* free_function */
+    &ThreadCacheGetSizeEstimate, /* get_size_estimate_function */
+    nullptr,                     /* batch_malloc_function */
+    nullptr,                     /* batch_free_function */
+    nullptr,                     /* free_definite_size_function */
+    nullptr,                     /* next */
+};
+
+// Holding all the locks across fork() prevents the child from inheriting a
+// lock held by a thread which doesn't exist in it.
+void LockBeforeFork() {
+  g_allocator->LockAll();
+}
+
+void UnlockAfterFork() {
+  g_allocator->UnlockAll();
+}
+
+void OnMemoryPressure(MemoryPressureListener::MemoryPressureLevel level) {
+  // Notifications are only sent for moderate and critical pressure.
+  DCHECK_NE(MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE, level);
+  PurgeThreadCacheAllocator();
+}
+
+}  // namespace
+
+bool InstallThreadCacheAllocator() {
+  DCHECK(!g_allocator);
+  std::unique_ptr<ThreadCacheAllocator> allocator =
+      ThreadCacheAllocator::Create();
+  if (!allocator)
+    return false;
+  g_allocator = allocator.release();
+  pthread_atfork(&LockBeforeFork, &UnlockAfterFork, &UnlockAfterFork);
+  InsertAllocatorDispatch(&g_thread_cache_allocator_dispatch);
+  return true;
+}
+
+void PurgeThreadCacheAllocator() {
+  if (g_allocator)
+    g_allocator->Purge();
+}
+
+void PurgeThreadCacheAllocatorOnMemoryPressure() {
+  static NoDestructor<MemoryPressureListener> listener(
+      BindRepeating(&OnMemoryPressure));
+}
+
+bool GetThreadCacheAllocatorStats(ThreadCacheAllocatorStats* stats) {
+  if (!g_allocator)
+    return false;
+  *stats = g_allocator->GetStats();
+  return true;
+}
+
+}  // namespace allocator
+}  // namespace base
@@ -0,0 +1,192 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_ALLOCATOR_THREAD_CACHE_ALLOCATOR_H_
+#define BASE_ALLOCATOR_THREAD_CACHE_ALLOCATOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+
+#include "base/base_export.h"
+#include "base/macros.h"
+#include "base/threading/thread_local_storage.h"
+
+namespace base {
+namespace allocator {
+
+// The thread cache allocator is a size-class allocator for allocations of up
+// to 32 KiB, which can be inserted in front of the allocator shim chain to
+// serve malloc() and operator new in place of glibc or tcmalloc.
+//
+// Each size class gets its own region of address space, carved into 64 KiB
+// spans of equally sized slots, so that the size of an allocation is known
+// from its address alone and objects of different sizes never share a span.
+// Each thread caches a few free slots per size class, which it allocates and
+// frees without locking; slots move between thread caches and the span free
+// lists in batches. Spans which become entirely free are returned to the
+// system by PurgeThreadCacheAllocator().
+//
+// Larger allocations, and allocations made before the allocator was installed,
+// are left to the next allocator in the chain.
+
+struct ThreadCacheAllocatorStats {
+  // Bytes of spans whose pages may be resident.
+  size_t committed_bytes = 0;
+  // Bytes of slots allocated by the program, including the rounding up of
+  // requests to their size class.
+  size_t allocated_bytes = 0;
+  // Bytes of free slots held in thread caches. Counts from threads other than
+  // the calling thread are updated when they exchange slots with the spans,
+  // and may lag behind.
+  size_t thread_cache_bytes = 0;
+};
+
+// Inserts the thread cache allocator in front of the allocator shim chain.
+// This should be done early during startup, before inserting allocator
+// dispatches which observe allocations, such as heap profilers, which would
+// otherwise not see the allocations served by it. Returns false if the
+// allocator can't reserve its address space, e.g. on 32-bit platforms.
+// Must be called at most once.
+BASE_EXPORT bool InstallThreadCacheAllocator();
+
+// Flushes the thread caches and returns the pages of entirely free spans to
+// the system. Threads other than the calling thread flush their cache the
+// next time they allocate or free. Does nothing if the allocator isn't
+// installed.
+BASE_EXPORT void PurgeThreadCacheAllocator();
+
+// Calls PurgeThreadCacheAllocator() on MEMORY_PRESSURE_LEVEL_MODERATE and
+// MEMORY_PRESSURE_LEVEL_CRITICAL notifications for the rest of the process'
+// lifetime. Must be called at most once, on a sequence.
+BASE_EXPORT void PurgeThreadCacheAllocatorOnMemoryPressure();
+
+// Fills |stats| and returns true if the allocator is installed.
+BASE_EXPORT bool GetThreadCacheAllocatorStats(ThreadCacheAllocatorStats* stats);
+
+namespace internal {
+
+// The allocator behind InstallThreadCacheAllocator(). Exposed for testing,
+// which can create instances which aren't in the allocator shim chain.
+// This class is thread-safe.
+class BASE_EXPORT ThreadCacheAllocator {
+ public:
+  // Allocations larger than this are left to the next allocator.
+  static constexpr size_t kMaxSlotSize = 32 * 1024;
+
+  // Returns null if the address space can't be reserved.
+  static std::unique_ptr<ThreadCacheAllocator> Create();
+
+  // Unmaps all the memory of the allocator, including allocations which
+  // weren't freed.
+  ~ThreadCacheAllocator();
+
+  // Returns a slot of at least |size| bytes, aligned on 16 bytes, or null if
+  // |size| is larger than kMaxSlotSize or the size class is out of space.
+  void* Allocate(size_t size);
+
+  // Same as Allocate(), but also returns null if |alignment| isn't a power of
+  // two of at most kMaxSlotSize.
+  void* AllocateAligned(size_t alignment, size_t size);
+
+  // Frees |address|, which must be owned by this allocator.
+  void Free(void* address);
+
+  // Returns whether |address| was returned by this allocator.
+  bool Owns(const void* address) const;
+
+  // Returns the size of the slot at |address|, which must be owned by this
+  // allocator.
+  size_t GetSlotSize(const void* address) const;
+
+  // Returns whether |size| and |new_size| are in the same size class, in
+  // which case reallocating from one to the other needn't move the slot.
+  static bool IsSameSizeClass(size_t size, size_t new_size);
+
+  // See PurgeThreadCacheAllocator() and GetThreadCacheAllocatorStats().
+  void Purge();
+  ThreadCacheAllocatorStats GetStats();
+
+  // Acquire and release the locks of all size classes, around fork().
+  void LockAll();
+  void UnlockAll();
+
+ private:
+  struct SizeClass;
+  struct SpanMetadata;
+  struct ThreadCache;
+  struct FreeSlot;
+
+  ThreadCacheAllocator(char* mapping, size_t mapping_size, char* regions);
+
+  void* AllocateFromSizeClass(size_t size_class);
+
+  // Returns the cache of the calling thread, creating it if needed, or null
+  // while it can't be used, e.g. during thread teardown.
+  ThreadCache* GetThreadCache();
+  ThreadCache* GetThreadCacheSlow();
+  static void OnThreadExit(void* value);
+
+  // Allocates a slot of |size_class| without going through a thread cache.
+  void* AllocateUncached(size_t size_class);
+
+  // Allocates a slot of |size_class| from the spans, and up to
+  // |max_cached_slots| / 2 more which are added to |cache|.
+  void* RefillAndAllocate(ThreadCache* cache, size_t size_class);
+
+  // Returns the slots cached for |size_class|, but the most recently freed
+  // |max_cached_slots| / 2, to the spans.
+  void ReleaseCachedSlots(ThreadCache* cache, size_t size_class);
+
+  // Returns all slots in |cache| to the spans.
+  void FlushThreadCache(ThreadCache* cache);
+
+  // Adds the change of the number of bytes in |cache| to the process-wide
+  // count.
+  void ReportThreadCacheBytes(ThreadCache* cache);
+
+  // Pops up to |count| slots of |size_class| from the spans and links them
+  // into a list. Returns the head of the list and the number of slots in
+  // |*popped|.
+  FreeSlot* PopSlots(size_t size_class, size_t count, size_t* popped);
+
+  // Pushes the |count| slots of |size_class| listed from |head| back to their
+  // spans.
+  void PushSlots(size_t size_class, FreeSlot* head, size_t count);
+
+  size_t GetSizeClassOf(const void* address) const;
+  SpanMetadata* GetSpanMetadata(size_t size_class, size_t span_index);
+  char* GetSpanStart(size_t size_class, size_t span_index) const;
+
+  // Never 0.
+  const uint64_t id_;
+
+  // All the address space of the allocator, which starts with the span
+  // metadata and is followed by |regions_|.
+  char* const mapping_;
+  const size_t mapping_size_;
+
+  // The regions of all size classes, one after the other.
+  char* const regions_;
+
+  const std::unique_ptr<SizeClass[]> size_classes_;
+
+  // Incremented by Purge(), which flushes the thread caches whose generation
+  // differs.
+  std::atomic<uint32_t> purge_generation_{0};
+
+  std::atomic<int64_t> thread_cache_bytes_{0};
+
+  ThreadLocalStorage::Slot thread_cache_tls_;
+
+  DISALLOW_COPY_AND_ASSIGN(ThreadCacheAllocator);
+};
+
+}  // namespace internal
+}  // namespace allocator
+}  // namespace base
+
+#endif  // BASE_ALLOCATOR_THREAD_CACHE_ALLOCATOR_H_
@@ -0,0 +1,197 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/allocator/thread_cache_allocator.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <memory>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/threading/simple_thread.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+namespace allocator {
+namespace internal {
+
+namespace {
+
+constexpr size_t kSizes[] = {0,   1,    8,    16,   17,   100,
+                             128, 129,  1000, 4096, 5000, 16385,
+                             ThreadCacheAllocator::kMaxSlotSize};
+
+class ThreadCacheAllocatorTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    allocator_ = ThreadCacheAllocator::Create();
+    ASSERT_TRUE(allocator_);
+  }
+
+  std::unique_ptr<ThreadCacheAllocator> allocator_;
+};
+
+// Allocates and frees blocks of various sizes, freeing them on another thread
+// than the one which allocated them half of the time.
+class AllocatingThread : public SimpleThread {
+ public:
+  AllocatingThread(ThreadCacheAllocator* allocator,
+                   std::vector<void*>* to_free,
+                   std::vector<void*>* allocated)
+      : SimpleThread("AllocatingThread"),
+        allocator_(allocator),
+        to_free_(to_free),
+        allocated_(allocated) {}
+
+  void Run() override {
+    for (void* address : *to_free_)
+      allocator_->Free(address);
+    for (int i = 0; i < 10000; ++i) {
+      void* const address = allocator_->Allocate(kSizes[i % arraysize(kSizes)]);
+      ASSERT_TRUE(address);
+      if (i % 2)
+        allocator_->Free(address);
+      else
+        allocated_->push_back(address);
+    }
+  }
+
+ private:
+  ThreadCacheAllocator* const allocator_;
+  std::vector<void*>* const to_free_;
+  std::vector<void*>* const allocated_;
+
+  DISALLOW_COPY_AND_ASSIGN(AllocatingThread);
+};
+
+}  // namespace
+
+TEST_F(ThreadCacheAllocatorTest, AllocateAndFree) {
+  std::vector<void*> addresses;
+  for (size_t size : kSizes) {
+    void* const address = allocator_->Allocate(size);
+    ASSERT_TRUE(address);
+    EXPECT_TRUE(allocator_->Owns(address));
+    EXPECT_GE(allocator_->GetSlotSize(address), size);
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(address) % 16);
+    memset(address, 0xAB, size);
+    addresses.push_back(address);
+  }
+  for (void* address : addresses)
+    allocator_->Free(address);
+
+  EXPECT_FALSE(allocator_->Allocate(ThreadCacheAllocator::kMaxSlotSize + 1));
+  int on_stack;
+  EXPECT_FALSE(allocator_->Owns(&on_stack));
+  EXPECT_FALSE(allocator_->Owns(nullptr));
+}
+
+TEST_F(ThreadCacheAllocatorTest, ReusesFreedSlots) {
+  void* const address = allocator_->Allocate(40);
+  allocator_->Free(address);
+  EXPECT_EQ(address, allocator_->Allocate(48));
+  allocator_->Free(address);
+}
+
+TEST_F(ThreadCacheAllocatorTest, SizeClasses) {
+  EXPECT_TRUE(ThreadCacheAllocator::IsSameSizeClass(1, 16));
+  EXPECT_FALSE(ThreadCacheAllocator::IsSameSizeClass(16, 17));
+  EXPECT_TRUE(ThreadCacheAllocator::IsSameSizeClass(129, 160));
+  EXPECT_FALSE(ThreadCacheAllocator::IsSameSizeClass(160, 161));
+  EXPECT_FALSE(ThreadCacheAllocator::IsSameSizeClass(
+      ThreadCacheAllocator::kMaxSlotSize,
+      ThreadCacheAllocator::kMaxSlotSize + 1));
+
+  // Size classes round up by at most 25% past 128 bytes.
+  for (size_t size = 1; size <= ThreadCacheAllocator::kMaxSlotSize;
+       size += 7) {
+    void* const address = allocator_->Allocate(size);
+    const size_t slot_size = allocator_->GetSlotSize(address);
+    EXPECT_GE(slot_size, size);
+    EXPECT_LE(slot_size, std::max<size_t>(size + 15, size * 5 / 4 + 1));
+    allocator_->Free(address);
+  }
+}
+
+TEST_F(ThreadCacheAllocatorTest, AllocateAligned) {
+  for (size_t alignment = 32; alignment <= ThreadCacheAllocator::kMaxSlotSize;
+       alignment *= 2) {
+    void* const address = allocator_->AllocateAligned(alignment, 24);
+    ASSERT_TRUE(address);
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(address) % alignment);
+    allocator_->Free(address);
+  }
+  EXPECT_FALSE(allocator_->AllocateAligned(48, 24));
+  EXPECT_FALSE(allocator_->AllocateAligned(
+      ThreadCacheAllocator::kMaxSlotSize * 2, 24));
+}
+
+TEST_F(ThreadCacheAllocatorTest, PurgeReleasesFreeSpans) {
+  const ThreadCacheAllocatorStats initial_stats = allocator_->GetStats();
+
+  std::vector<void*> addresses;
+  for (int i = 0; i < 10000; ++i)
+    addresses.push_back(allocator_->Allocate(100));
+  ThreadCacheAllocatorStats stats = allocator_->GetStats();
+  EXPECT_GE(stats.allocated_bytes, initial_stats.allocated_bytes + 1000000);
+  EXPECT_GE(stats.committed_bytes, stats.allocated_bytes);
+
+  for (void* address : addresses)
+    allocator_->Free(address);
+  stats = allocator_->GetStats();
+  EXPECT_EQ(initial_stats.allocated_bytes, stats.allocated_bytes);
+  EXPECT_GT(stats.thread_cache_bytes, 0u);
+  EXPECT_GE(stats.committed_bytes, 1000000u);
+
+  allocator_->Purge();
+  stats = allocator_->GetStats();
+  EXPECT_EQ(initial_stats.allocated_bytes, stats.allocated_bytes);
+  EXPECT_EQ(0u, stats.thread_cache_bytes);
+  EXPECT_LT(stats.committed_bytes, 1000000u);
+
+  // Purged spans are reused.
+  void* const address = allocator_->Allocate(100);
+  ASSERT_TRUE(address);
+  memset(address, 0xAB, 100);
+  allocator_->Free(address);
+}
+
+TEST_F(ThreadCacheAllocatorTest, MultipleThreads) {
+  const ThreadCacheAllocatorStats initial_stats = allocator_->GetStats();
+
+  constexpr int kNumThreads = 8;
+  std::vector<std::vector<void*>> allocated(kNumThreads);
+  for (int round = 0; round < 2; ++round) {
+    // Each thread frees what the previous one allocated in the last round.
+    std::vector<std::vector<void*>> to_free(kNumThreads);
+    for (int i = 0; i < kNumThreads; ++i)
+      to_free[i].swap(allocated[(i + 1) % kNumThreads]);
+
+    std::vector<std::unique_ptr<AllocatingThread>> threads;
+    for (int i = 0; i < kNumThreads; ++i) {
+      threads.push_back(std::make_unique<AllocatingThread>(
+          allocator_.get(), &to_free[i], &allocated[i]));
+    }
+    for (const auto& thread : threads)
+      thread->Start();
+    for (const auto& thread : threads)
+      thread->Join();
+  }
+  for (const auto& addresses : allocated) {
+    for (void* address : addresses)
+      allocator_->Free(address);
+  }
+
+  // The exited threads flushed their cache.
+  allocator_->Purge();
+  const ThreadCacheAllocatorStats stats = allocator_->GetStats();
+  EXPECT_EQ(initial_stats.allocated_bytes, stats.allocated_bytes);
+  EXPECT_EQ(0u, stats.thread_cache_bytes);
+}
+
+}  // namespace internal
+}  // namespace allocator
+}  // namespace base
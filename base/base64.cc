@@ -5,35 +5,515 @@
 #include "base/base64.h"
 
 #include <stddef.h>
+#include <stdint.h>
 
+#include <algorithm>
+
+#include "build/build_config.h"
 #include "third_party/modp_b64/modp_b64.h"
 
+// The SSSE3 and AVX2 loops are compiled per function and picked with runtime
+// detection, since the baseline x86 targets have neither. NEON is part of the
+// ARM64 baseline.
+#if defined(ARCH_CPU_X86_FAMILY) && defined(COMPILER_GCC) && !defined(OS_NACL)
+#define BASE64_USE_X86_SIMD
+#include <immintrin.h>
+
+#include "base/cpu.h"
+#elif defined(ARCH_CPU_ARM64)
+#define BASE64_USE_NEON
+#include <arm_neon.h>
+#endif
+
 namespace base {
 
-void Base64Encode(const StringPiece& input, std::string* output) {
-  std::string temp;
-  temp.resize(modp_b64_encode_len(input.size()));  // makes room for null byte
+namespace {
+
+// The vectorized loops below only handle whole blocks at the start of the
+// input and leave the rest, including any padding, to modp_b64. modp_b64
+// handles every group of three bytes or four characters on its own, so the
+// output and the validation are the same as with modp_b64 alone: a block is
+// only decoded if all of its characters are in the base64 alphabet, and '='
+// is never valid before the last group.
+
+#if defined(BASE64_USE_X86_SIMD)
+
+// Returns the base64 characters of the 6-bit values in |indices|, following
+// http://0x80.pl/notesen/2016-01-12-sse-base64-encoding.html.
+__attribute__((target("ssse3"))) inline __m128i IndicesToCharsSSSE3(
+    __m128i indices) {
+  // Maps 0..25 to 13, 26..51 to 0, 52..61 to 1..10, 62 to 11 and 63 to 12,
+  // which index the offset of each range from its characters.
+  const __m128i kOffsets =
+      _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                    '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+                    '/' - 63, 'A', 0, 0);
+  __m128i range = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+  const __m128i upper = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+  range = _mm_or_si128(range, _mm_and_si128(upper, _mm_set1_epi8(13)));
+  return _mm_add_epi8(indices, _mm_shuffle_epi8(kOffsets, range));
+}
+
+// Encodes the 12 bytes at the start of |input|, whose last four bytes are
+// ignored.
+__attribute__((target("ssse3"))) inline __m128i EncodeBlockSSSE3(
+    __m128i input) {
+  // Each 32-bit lane gets the three bytes of one group as [b, a, c, b].
+  input = _mm_shuffle_epi8(
+      input, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+  // Move the four 6-bit values of each lane to the low bits of its bytes.
+  const __m128i ac =
+      _mm_mulhi_epu16(_mm_and_si128(input, _mm_set1_epi32(0x0fc0fc00)),
+                      _mm_set1_epi32(0x04000040));
+  const __m128i bd =
+      _mm_mullo_epi16(_mm_and_si128(input, _mm_set1_epi32(0x003f03f0)),
+                      _mm_set1_epi32(0x01000010));
+  return IndicesToCharsSSSE3(_mm_or_si128(ac, bd));
+}
+
+// Returns the 6-bit values of the base64 characters in |input|, or false if
+// any of them is outside of the alphabet, following
+// http://0x80.pl/notesen/2016-01-17-sse-base64-decoding.html.
+__attribute__((target("ssse3"))) inline bool CharsToIndicesSSSE3(
+    __m128i input,
+    __m128i* indices) {
+  // Each valid character has a bit in the entry of its high nibble which is
+  // clear in the entry of its low nibble.
+  const __m128i kLowNibbleBits =
+      _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                    0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a);
+  const __m128i kHighNibbleBits =
+      _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10,
+                    0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+  // Offsets from the characters to their values, by high nibble, with '/'
+  // moved to entry 1.
+  const __m128i kOffsets = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0,
+                                         0, 0, 0, 0, 0, 0, 0);
+  const __m128i high_nibbles =
+      _mm_and_si128(_mm_srli_epi32(input, 4), _mm_set1_epi8(0x0f));
+  const __m128i low_nibbles = _mm_and_si128(input, _mm_set1_epi8(0x0f));
+  const __m128i invalid =
+      _mm_and_si128(_mm_shuffle_epi8(kLowNibbleBits, low_nibbles),
+                    _mm_shuffle_epi8(kHighNibbleBits, high_nibbles));
+  if (_mm_movemask_epi8(_mm_cmpgt_epi8(invalid, _mm_setzero_si128())))
+    return false;
+  const __m128i is_slash = _mm_cmpeq_epi8(input, _mm_set1_epi8('/'));
+  *indices = _mm_add_epi8(
+      input,
+      _mm_shuffle_epi8(kOffsets, _mm_add_epi8(is_slash, high_nibbles)));
+  return true;
+}
+
+// Packs the 6-bit values in |indices| into 12 bytes at the start of the
+// result.
+__attribute__((target("ssse3"))) inline __m128i PackIndicesSSSE3(
+    __m128i indices) {
+  const __m128i pairs =
+      _mm_maddubs_epi16(indices, _mm_set1_epi32(0x01400140));
+  const __m128i groups = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+  return _mm_shuffle_epi8(groups, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14,
+                                                13, 12, -1, -1, -1, -1));
+}
+
+__attribute__((target("ssse3"))) size_t EncodeBlocksSSSE3(const uint8_t* input,
+                                                          size_t size,
+                                                          char* output) {
+  size_t i = 0;
+  // Each block reads 16 bytes and encodes 12 of them.
+  for (; i + 16 <= size; i += 12, output += 16) {
+    const __m128i block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output),
+                     EncodeBlockSSSE3(block));
+  }
+  return i;
+}
+
+__attribute__((target("ssse3"))) bool DecodeBlocksSSSE3(const char* input,
+                                                        size_t size,
+                                                        uint8_t* output,
+                                                        size_t* decoded) {
+  size_t i = 0;
+  // Each block decodes 16 characters and writes 16 bytes, of which 12 are
+  // output.
+  for (; i + 16 <= size; i += 16, output += 12) {
+    __m128i indices;
+    if (!CharsToIndicesSSSE3(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i)),
+            &indices)) {
+      return false;
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output),
+                     PackIndicesSSSE3(indices));
+  }
+  *decoded = i;
+  return true;
+}
+
+// The AVX2 loops run the SSSE3 steps on both 128-bit lanes.
+
+__attribute__((target("avx2"))) size_t EncodeBlocksAVX2(const uint8_t* input,
+                                                        size_t size,
+                                                        char* output) {
+  const __m256i kShuffle = _mm256_broadcastsi128_si256(
+      _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+  const __m256i kOffsets = _mm256_broadcastsi128_si256(
+      _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                    '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+                    '/' - 63, 'A', 0, 0));
+  size_t i = 0;
+  // Each block reads 28 bytes and encodes 24 of them.
+  for (; i + 28 <= size; i += 24, output += 32) {
+    __m256i block = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i))),
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i + 12)), 1);
+    block = _mm256_shuffle_epi8(block, kShuffle);
+    const __m256i ac = _mm256_mulhi_epu16(
+        _mm256_and_si256(block, _mm256_set1_epi32(0x0fc0fc00)),
+        _mm256_set1_epi32(0x04000040));
+    const __m256i bd = _mm256_mullo_epi16(
+        _mm256_and_si256(block, _mm256_set1_epi32(0x003f03f0)),
+        _mm256_set1_epi32(0x01000010));
+    const __m256i indices = _mm256_or_si256(ac, bd);
+    __m256i range = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+    const __m256i upper = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+    range =
+        _mm256_or_si256(range, _mm256_and_si256(upper, _mm256_set1_epi8(13)));
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(output),
+        _mm256_add_epi8(indices, _mm256_shuffle_epi8(kOffsets, range)));
+  }
+  return i + EncodeBlocksSSSE3(input + i, size - i, output);
+}
+
+__attribute__((target("avx2"))) bool DecodeBlocksAVX2(const char* input,
+                                                      size_t size,
+                                                      uint8_t* output,
+                                                      size_t* decoded) {
+  const __m256i kLowNibbleBits = _mm256_broadcastsi128_si256(
+      _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                    0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a));
+  const __m256i kHighNibbleBits = _mm256_broadcastsi128_si256(
+      _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10,
+                    0x10, 0x10, 0x10, 0x10, 0x10, 0x10));
+  const __m256i kOffsets = _mm256_broadcastsi128_si256(_mm_setr_epi8(
+      0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0));
+  const __m256i kPack = _mm256_broadcastsi128_si256(_mm_setr_epi8(
+      2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+  size_t i = 0;
+  // Each block decodes 32 characters and writes 28 bytes, of which 24 are
+  // output.
+  for (; i + 32 <= size; i += 32, output += 24) {
+    const __m256i block =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+    const __m256i high_nibbles =
+        _mm256_and_si256(_mm256_srli_epi32(block, 4), _mm256_set1_epi8(0x0f));
+    const __m256i low_nibbles =
+        _mm256_and_si256(block, _mm256_set1_epi8(0x0f));
+    const __m256i invalid =
+        _mm256_and_si256(_mm256_shuffle_epi8(kLowNibbleBits, low_nibbles),
+                         _mm256_shuffle_epi8(kHighNibbleBits, high_nibbles));
+    if (_mm256_movemask_epi8(
+            _mm256_cmpgt_epi8(invalid, _mm256_setzero_si256()))) {
+      return false;
+    }
+    const __m256i is_slash = _mm256_cmpeq_epi8(block, _mm256_set1_epi8('/'));
+    const __m256i indices = _mm256_add_epi8(
+        block, _mm256_shuffle_epi8(kOffsets,
+                                   _mm256_add_epi8(is_slash, high_nibbles)));
+    const __m256i pairs =
+        _mm256_maddubs_epi16(indices, _mm256_set1_epi32(0x01400140));
+    const __m256i groups =
+        _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+    const __m256i packed = _mm256_shuffle_epi8(groups, kPack);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output),
+                     _mm256_castsi256_si128(packed));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output + 12),
+                     _mm256_extracti128_si256(packed, 1));
+  }
+  size_t rest = 0;
+  if (!DecodeBlocksSSSE3(input + i, size - i, output, &rest))
+    return false;
+  *decoded = i + rest;
+  return true;
+}
+
+#elif defined(BASE64_USE_NEON)
+
+const uint8_t kEncodeTable[64] = {
+    'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M',
+    'N', 'O', 'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z',
+    'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm',
+    'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z',
+    '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '+', '/'};
+
+// The value of each character below 128, or 255 if it is not in the alphabet.
+const uint8_t kDecodeTable[128] = {
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 62,  255,
+    255, 255, 63,  52,  53,  54,  55,  56,  57,  58,  59,  60,  61,  255, 255,
+    255, 255, 255, 255, 255, 0,   1,   2,   3,   4,   5,   6,   7,   8,   9,
+    10,  11,  12,  13,  14,  15,  16,  17,  18,  19,  20,  21,  22,  23,  24,
+    25,  255, 255, 255, 255, 255, 255, 26,  27,  28,  29,  30,  31,  32,  33,
+    34,  35,  36,  37,  38,  39,  40,  41,  42,  43,  44,  45,  46,  47,  48,
+    49,  50,  51,  255, 255, 255, 255, 255};
+
+uint8x16x4_t LoadTable(const uint8_t* table) {
+  uint8x16x4_t result;
+  result.val[0] = vld1q_u8(table);
+  result.val[1] = vld1q_u8(table + 16);
+  result.val[2] = vld1q_u8(table + 32);
+  result.val[3] = vld1q_u8(table + 48);
+  return result;
+}
+
+size_t EncodeBlocksNEON(const uint8_t* input, size_t size, char* output) {
+  const uint8x16x4_t table = LoadTable(kEncodeTable);
+  const uint8x16_t kMask = vdupq_n_u8(0x3f);
+  size_t i = 0;
+  // Each block encodes 48 bytes, de-interleaved into the first, second and
+  // third bytes of the groups.
+  for (; i + 48 <= size; i += 48, output += 64) {
+    const uint8x16x3_t bytes = vld3q_u8(input + i);
+    uint8x16x4_t chars;
+    chars.val[0] = vshrq_n_u8(bytes.val[0], 2);
+    chars.val[1] = vandq_u8(
+        vorrq_u8(vshlq_n_u8(bytes.val[0], 4), vshrq_n_u8(bytes.val[1], 4)),
+        kMask);
+    chars.val[2] = vandq_u8(
+        vorrq_u8(vshlq_n_u8(bytes.val[1], 2), vshrq_n_u8(bytes.val[2], 6)),
+        kMask);
+    chars.val[3] = vandq_u8(bytes.val[2], kMask);
+    for (int j = 0; j < 4; ++j)
+      chars.val[j] = vqtbl4q_u8(table, chars.val[j]);
+    vst4q_u8(reinterpret_cast<uint8_t*>(output), chars);
+  }
+  return i;
+}
+
+bool DecodeBlocksNEON(const char* input,
+                      size_t size,
+                      uint8_t* output,
+                      size_t* decoded) {
+  const uint8x16x4_t low_table = LoadTable(kDecodeTable);
+  const uint8x16x4_t high_table = LoadTable(kDecodeTable + 64);
+  const uint8x16_t k64 = vdupq_n_u8(64);
+  const uint8x16_t k63 = vdupq_n_u8(63);
+  size_t i = 0;
+  // Each block decodes 64 characters, de-interleaved into the first to fourth
+  // characters of the groups.
+  for (; i + 64 <= size; i += 64, output += 48) {
+    uint8x16x4_t values =
+        vld4q_u8(reinterpret_cast<const uint8_t*>(input + i));
+    uint8x16_t invalid = vdupq_n_u8(0);
+    for (int j = 0; j < 4; ++j) {
+      // Characters from 128 are left at 0 by both lookups, and rejected by
+      // their top bit.
+      const uint8x16_t chars = values.val[j];
+      values.val[j] = vqtbx4q_u8(vqtbl4q_u8(low_table, chars), high_table,
+                                 vsubq_u8(chars, k64));
+      invalid = vorrq_u8(invalid, vorrq_u8(vcgtq_u8(values.val[j], k63),
+                                           vcgtq_u8(chars, vdupq_n_u8(127))));
+    }
+    if (vmaxvq_u8(invalid))
+      return false;
+    uint8x16x3_t bytes;
+    bytes.val[0] =
+        vorrq_u8(vshlq_n_u8(values.val[0], 2), vshrq_n_u8(values.val[1], 4));
+    bytes.val[1] =
+        vorrq_u8(vshlq_n_u8(values.val[1], 4), vshrq_n_u8(values.val[2], 2));
+    bytes.val[2] = vorrq_u8(vshlq_n_u8(values.val[2], 6), values.val[3]);
+    vst3q_u8(output, bytes);
+  }
+  *decoded = i;
+  return true;
+}
 
-  // modp_b64_encode_len() returns at least 1, so temp[0] is safe to use.
-  size_t output_size = modp_b64_encode(&(temp[0]), input.data(), input.size());
+#endif
 
-  temp.resize(output_size);  // strips off null byte
+// Encodes a prefix of the |size| bytes of |input|, whose length is a multiple
+// of three, and returns that length.
+size_t EncodeBlocks(const uint8_t* input, size_t size, char* output) {
+#if defined(BASE64_USE_X86_SIMD)
+  static const bool has_avx2 = CPU().has_avx2();
+  static const bool has_ssse3 = CPU().has_ssse3();
+  if (has_avx2)
+    return EncodeBlocksAVX2(input, size, output);
+  if (has_ssse3)
+    return EncodeBlocksSSSE3(input, size, output);
+#elif defined(BASE64_USE_NEON)
+  return EncodeBlocksNEON(input, size, output);
+#endif
+  return 0;
+}
+
+// Decodes a prefix of the |size| characters of |input|, whose length is a
+// multiple of four, into |output|, which has room for at least four more
+// bytes than the decoding of |input|. Returns false if the prefix has a
+// character outside of the alphabet, and otherwise sets |decoded| to its
+// length.
+bool DecodeBlocks(const char* input,
+                  size_t size,
+                  uint8_t* output,
+                  size_t* decoded) {
+  *decoded = 0;
+#if defined(BASE64_USE_X86_SIMD)
+  static const bool has_avx2 = CPU().has_avx2();
+  static const bool has_ssse3 = CPU().has_ssse3();
+  if (has_avx2)
+    return DecodeBlocksAVX2(input, size, output, decoded);
+  if (has_ssse3)
+    return DecodeBlocksSSSE3(input, size, output, decoded);
+#elif defined(BASE64_USE_NEON)
+  return DecodeBlocksNEON(input, size, output, decoded);
+#endif
+  return true;
+}
+
+// Appends the encoding of |input| to |output|.
+void AppendEncoded(const StringPiece& input, std::string* output) {
+  const size_t output_start = output->size();
+  // Makes room for the null byte written by modp_b64_encode().
+  const size_t input_size = input.size();
+  output->resize(output_start + modp_b64_encode_len(input_size));
+  char* out = &(*output)[output_start];
+
+  const uint8_t* in = reinterpret_cast<const uint8_t*>(input.data());
+  const size_t encoded = EncodeBlocks(in, input_size, out);
+  const size_t output_size =
+      encoded / 3 * 4 + modp_b64_encode(out + encoded / 3 * 4,
+                                        input.data() + encoded,
+                                        input_size - encoded);
+  output->resize(output_start + output_size);  // strips off null byte
+}
+
+// Appends the decoding of |input| to |output|, and returns false if it is
+// invalid. Only the last group of characters of |input| may be padded if
+// |is_last| is true, and none otherwise.
+bool AppendDecoded(const StringPiece& input,
+                   bool is_last,
+                   std::string* output) {
+  const size_t input_size = input.size();
+  if (!is_last && input_size && input[input_size - 1] == '=')
+    return false;
+
+  const size_t output_start = output->size();
+  output->resize(output_start + modp_b64_decode_len(input_size));
+  uint8_t* out = reinterpret_cast<uint8_t*>(&(*output)[output_start]);
+
+  // The last group is left to modp_b64, which handles its padding. This also
+  // leaves room for the bytes written past the decoding by DecodeBlocks().
+  size_t decoded = 0;
+  if (input_size > 4 && input_size % 4 == 0 &&
+      !DecodeBlocks(input.data(), input_size - 4, out, &decoded)) {
+    output->resize(output_start);
+    return false;
+  }
+  // does not null terminate result since result is binary data!
+  const size_t output_size =
+      modp_b64_decode(reinterpret_cast<char*>(out + decoded / 4 * 3),
+                      input.data() + decoded, input_size - decoded);
+  if (output_size == MODP_B64_ERROR) {
+    output->resize(output_start);
+    return false;
+  }
+  output->resize(output_start + decoded / 4 * 3 + output_size);
+  return true;
+}
+
+}  // namespace
+
+void Base64Encode(const StringPiece& input, std::string* output) {
+  std::string temp;
+  AppendEncoded(input, &temp);
   output->swap(temp);
 }
 
 bool Base64Decode(const StringPiece& input, std::string* output) {
   std::string temp;
-  temp.resize(modp_b64_decode_len(input.size()));
+  if (!AppendDecoded(input, true, &temp))
+    return false;
+  output->swap(temp);
+  return true;
+}
 
-  // does not null terminate result since result is binary data!
-  size_t input_size = input.size();
-  size_t output_size = modp_b64_decode(&(temp[0]), input.data(), input_size);
-  if (output_size == MODP_B64_ERROR)
+Base64Encoder::Base64Encoder() = default;
+
+Base64Encoder::~Base64Encoder() = default;
+
+void Base64Encoder::Append(const StringPiece& input, std::string* output) {
+  StringPiece rest = input;
+  if (pending_size_) {
+    const size_t count = std::min(3 - pending_size_, rest.size());
+    if (pending_size_ + count < 3) {
+      std::copy(rest.begin(), rest.begin() + count, pending_ + pending_size_);
+      pending_size_ += count;
+      return;
+    }
+    char group[3];
+    std::copy(pending_, pending_ + pending_size_, group);
+    std::copy(rest.begin(), rest.begin() + count, group + pending_size_);
+    AppendEncoded(StringPiece(group, 3), output);
+    rest.remove_prefix(count);
+    pending_size_ = 0;
+  }
+
+  const size_t whole_groups_size = rest.size() - rest.size() % 3;
+  AppendEncoded(rest.substr(0, whole_groups_size), output);
+  rest.remove_prefix(whole_groups_size);
+  std::copy(rest.begin(), rest.end(), pending_);
+  pending_size_ = rest.size();
+}
+
+void Base64Encoder::Finish(std::string* output) {
+  AppendEncoded(StringPiece(pending_, pending_size_), output);
+  pending_size_ = 0;
+}
+
+Base64Decoder::Base64Decoder() = default;
+
+Base64Decoder::~Base64Decoder() = default;
+
+bool Base64Decoder::Append(const StringPiece& input, std::string* output) {
+  if (failed_)
     return false;
 
-  temp.resize(output_size);
-  output->swap(temp);
+  // Everything but the last group, and any incomplete group after it, is
+  // decoded.
+  const size_t total_size = pending_.size() + input.size();
+  const size_t held_back_size = total_size % 4 ? total_size % 4 : 4;
+  if (total_size <= held_back_size) {
+    pending_.append(input.data(), input.size());
+    return true;
+  }
+
+  StringPiece rest = input;
+  if (!pending_.empty()) {
+    const size_t count = 4 - pending_.size();
+    pending_.append(rest.data(), count);
+    rest.remove_prefix(count);
+    if (!AppendDecoded(pending_, false, output)) {
+      failed_ = true;
+      return false;
+    }
+  }
+  if (!AppendDecoded(rest.substr(0, rest.size() - held_back_size), false,
+                     output)) {
+    failed_ = true;
+    return false;
+  }
+  rest.remove_prefix(rest.size() - held_back_size);
+  pending_.assign(rest.data(), rest.size());
   return true;
 }
 
+bool Base64Decoder::Finish(std::string* output) {
+  bool result = !failed_ && AppendDecoded(pending_, true, output);
+  pending_.clear();
+  failed_ = false;
+  return result;
+}
+
 }  // namespace base
@@ -5,9 +5,12 @@
 #ifndef BASE_BASE64_H_
 #define BASE_BASE64_H_
 
+#include <stddef.h>
+
 #include <string>
 
 #include "base/base_export.h"
+#include "base/macros.h"
 #include "base/strings/string_piece.h"
 
 namespace base {
@@ -20,6 +23,56 @@ BASE_EXPORT void Base64Encode(const StringPiece& input, std::string* output);
 // be done in-place.
 BASE_EXPORT bool Base64Decode(const StringPiece& input, std::string* output);
 
+// Encodes input given in pieces in base64, appending the encoding of each
+// piece to an output string that the caller may consume in between, so that
+// neither the whole input nor the whole encoding has to be held at once. The
+// concatenated output is the same as Base64Encode() of the concatenated input.
+class BASE_EXPORT Base64Encoder {
+ public:
+  Base64Encoder();
+  ~Base64Encoder();
+
+  // Encodes |input| after the input of the previous calls. Up to two bytes
+  // are held back until they can be encoded with the next input or Finish().
+  void Append(const StringPiece& input, std::string* output);
+
+  // Encodes the bytes held back, with padding, and resets the encoder.
+  void Finish(std::string* output);
+
+ private:
+  char pending_[2];
+  size_t pending_size_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(Base64Encoder);
+};
+
+// Decodes base64 input given in pieces, appending the decoding of each piece
+// to an output string that the caller may consume in between. The input is
+// validated exactly as by Base64Decode(), and the concatenated output is the
+// same as Base64Decode() of the concatenated input. Once a call has returned
+// false, |output| may hold part of the decoding and all later calls until
+// Finish() return false.
+class BASE_EXPORT Base64Decoder {
+ public:
+  Base64Decoder();
+  ~Base64Decoder();
+
+  // Decodes |input| after the input of the previous calls. The last group of
+  // up to four characters is held back until it is known whether it ends the
+  // input, since only that group may be padded.
+  bool Append(const StringPiece& input, std::string* output);
+
+  // Decodes the characters held back and resets the decoder. Returns false if
+  // the input as a whole was invalid.
+  bool Finish(std::string* output);
+
+ private:
+  std::string pending_;
+  bool failed_ = false;
+
+  DISALLOW_COPY_AND_ASSIGN(Base64Decoder);
+};
+
 }  // namespace base
 
 #endif  // BASE_BASE64_H_
@@ -5,11 +5,38 @@
 #include <string>
 
 #include "base/base64.h"
+#include "base/logging.h"
 #include "base/strings/string_piece.h"
+#include "third_party/modp_b64/modp_b64.h"
 
+// Decode some random data, checking that the vectorized decoding and the
+// streaming decoder accept the same input as modp_b64 with the same result.
 extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
   std::string decode_output;
   base::StringPiece data_piece(reinterpret_cast<const char*>(data), size);
-  base::Base64Decode(data_piece, &decode_output);
+  bool success = base::Base64Decode(data_piece, &decode_output);
+
+  std::string modp_output(modp_b64_decode_len(size), '\0');
+  size_t modp_size =
+      modp_b64_decode(&modp_output[0], data_piece.data(), data_piece.size());
+  CHECK_EQ(modp_size != MODP_B64_ERROR, success);
+  if (success) {
+    modp_output.resize(modp_size);
+    CHECK_EQ(modp_output, decode_output);
+  }
+
+  // Split the input in three pieces of varying size.
+  base::Base64Decoder decoder;
+  std::string stream_output;
+  bool stream_success = true;
+  for (size_t i = 0; i < 3; ++i) {
+    stream_success &= decoder.Append(
+        data_piece.substr(i * size / 3, (i + 1) * size / 3 - i * size / 3),
+        &stream_output);
+  }
+  stream_success &= decoder.Finish(&stream_output);
+  CHECK_EQ(success, stream_success);
+  if (success)
+    CHECK_EQ(decode_output, stream_output);
   return 0;
 }
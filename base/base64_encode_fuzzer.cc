@@ -7,8 +7,10 @@
 #include "base/base64.h"
 #include "base/logging.h"
 #include "base/strings/string_piece.h"
+#include "third_party/modp_b64/modp_b64.h"
 
-// Encode some random data, and then decode it.
+// Encode some random data, and then decode it. The vectorized encoding and the
+// streaming encoder must give the same result as modp_b64.
 extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
   std::string encode_output;
   std::string decode_output;
@@ -16,5 +18,21 @@ extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
   base::Base64Encode(data_piece, &encode_output);
   CHECK(base::Base64Decode(encode_output, &decode_output));
   CHECK_EQ(data_piece, decode_output);
+
+  std::string modp_output(modp_b64_encode_len(size), '\0');
+  modp_output.resize(
+      modp_b64_encode(&modp_output[0], data_piece.data(), data_piece.size()));
+  CHECK_EQ(modp_output, encode_output);
+
+  // Split the input in pieces of one to seven bytes, taken from the input.
+  base::Base64Encoder encoder;
+  std::string stream_output;
+  for (size_t i = 0; i < size;) {
+    size_t piece_size = 1 + data[i] % 7;
+    encoder.Append(data_piece.substr(i, piece_size), &stream_output);
+    i += piece_size;
+  }
+  encoder.Finish(&stream_output);
+  CHECK_EQ(encode_output, stream_output);
   return 0;
 }
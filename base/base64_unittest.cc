@@ -37,4 +37,108 @@ TEST(Base64Test, InPlace) {
   EXPECT_EQ(text, kText);
 }
 
+namespace {
+
+// Returns |size| bytes with every value.
+std::string MakeBinaryData(size_t size) {
+  std::string data(size, 0);
+  for (size_t i = 0; i < size; ++i)
+    data[i] = static_cast<char>(i * 7 + i / 256);
+  return data;
+}
+
+}  // namespace
+
+TEST(Base64Test, LongInputMatchesGroupwiseCoding) {
+  // Long inputs take the vectorized paths, which must give the same result as
+  // coding each group on its own.
+  for (size_t size = 0; size < 300; ++size) {
+    const std::string data = MakeBinaryData(size);
+    std::string encoded;
+    Base64Encode(data, &encoded);
+
+    std::string expected;
+    for (size_t i = 0; i < size; i += 3) {
+      std::string group;
+      Base64Encode(data.substr(i, 3), &group);
+      expected += group;
+    }
+    EXPECT_EQ(expected, encoded) << size;
+
+    std::string decoded;
+    EXPECT_TRUE(Base64Decode(encoded, &decoded)) << size;
+    EXPECT_EQ(data, decoded) << size;
+  }
+}
+
+TEST(Base64Test, InvalidCharacterInLongInput) {
+  std::string encoded;
+  Base64Encode(MakeBinaryData(150), &encoded);
+  ASSERT_EQ(200u, encoded.size());
+
+  for (char invalid : {'!', '=', '\0', '\x80', '-', '_'}) {
+    for (size_t i = 0; i < encoded.size() - 4; ++i) {
+      std::string input = encoded;
+      input[i] = invalid;
+      std::string output = "unchanged";
+      EXPECT_FALSE(Base64Decode(input, &output)) << i;
+      EXPECT_EQ("unchanged", output);
+    }
+  }
+}
+
+TEST(Base64Test, EncoderMatchesBase64Encode) {
+  const std::string data = MakeBinaryData(1000);
+  std::string expected;
+  Base64Encode(data, &expected);
+
+  for (size_t chunk_size : {1, 2, 3, 5, 64, 999}) {
+    Base64Encoder encoder;
+    std::string encoded;
+    for (size_t i = 0; i < data.size(); i += chunk_size)
+      encoder.Append(StringPiece(data).substr(i, chunk_size), &encoded);
+    encoder.Finish(&encoded);
+    EXPECT_EQ(expected, encoded) << chunk_size;
+  }
+}
+
+TEST(Base64Test, DecoderMatchesBase64Decode) {
+  const std::string data = MakeBinaryData(1000);
+  std::string encoded;
+  Base64Encode(data, &encoded);
+
+  for (size_t chunk_size : {1, 3, 4, 7, 64, 1335}) {
+    Base64Decoder decoder;
+    std::string decoded;
+    for (size_t i = 0; i < encoded.size(); i += chunk_size) {
+      EXPECT_TRUE(
+          decoder.Append(StringPiece(encoded).substr(i, chunk_size), &decoded));
+    }
+    EXPECT_TRUE(decoder.Finish(&decoded));
+    EXPECT_EQ(data, decoded) << chunk_size;
+  }
+}
+
+TEST(Base64Test, DecoderRejectsWhatBase64DecodeRejects) {
+  std::string output;
+  Base64Decoder decoder;
+
+  // Padding is only valid at the end of the whole input.
+  EXPECT_TRUE(decoder.Append("aGk=", &output));
+  EXPECT_FALSE(decoder.Append("aGk=", &output));
+  EXPECT_FALSE(decoder.Finish(&output));
+
+  // A trailing incomplete group is only found invalid at the end.
+  output.clear();
+  EXPECT_TRUE(decoder.Append("aGVsbG8", &output));
+  EXPECT_FALSE(decoder.Finish(&output));
+
+  // The decoder is usable again after Finish().
+  output.clear();
+  EXPECT_TRUE(decoder.Append("aGVs", &output));
+  EXPECT_TRUE(decoder.Append("bG8=", &output));
+  EXPECT_TRUE(decoder.Finish(&output));
+  EXPECT_EQ("hello", output);
+}
+
 }  // namespace base
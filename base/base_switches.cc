@@ -33,6 +33,10 @@ const char kEnableLowEndDeviceMode[]        = "enable-low-end-device-mode";
 // Force disabling of low-end device mode when set.
 const char kDisableLowEndDeviceMode[]       = "disable-low-end-device-mode";
 
+// Records the queueing time and the run time of TaskScheduler tasks per
+// posting location, and reports them in memory dumps and histograms.
+const char kEnableTaskLatencyByLocation[] = "enable-task-latency-by-location";
+
 // This option can be used to force field trials when testing changes locally.
 // The argument is a list of name and value pairs, separated by slashes. If a
 // trial name is prefixed with an asterisk, that trial will start activated.
@@ -5,6 +5,7 @@
 #include "base/callback_internal.h"
 
 #include "base/logging.h"
+#include "base/memory/small_block_cache.h"
 
 namespace base {
 namespace internal {
@@ -21,6 +22,16 @@ void BindStateBaseRefCountTraits::Destruct(const BindStateBase* bind_state) {
   bind_state->destructor_(bind_state);
 }
 
+// static
+void* BindStateBase::operator new(size_t size) {
+  return SmallBlockCache::Allocate(size);
+}
+
+// static
+void BindStateBase::operator delete(void* bind_state, size_t size) {
+  SmallBlockCache::Free(bind_state, size);
+}
+
 BindStateBase::BindStateBase(InvokeFuncStorage polymorphic_invoke,
                              void (*destructor)(const BindStateBase*))
     : BindStateBase(polymorphic_invoke, destructor, &ReturnFalse) {
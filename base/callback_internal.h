@@ -8,6 +8,8 @@
 #ifndef BASE_CALLBACK_INTERNAL_H_
 #define BASE_CALLBACK_INTERNAL_H_
 
+#include <stddef.h>
+
 #include "base/base_export.h"
 #include "base/callback_forward.h"
 #include "base/macros.h"
@@ -65,6 +67,11 @@ class BASE_EXPORT BindStateBase
 
   using InvokeFuncStorage = void(*)();
 
+  // BindStates are small and are allocated and freed at high rates by task
+  // posting, so they are recycled through SmallBlockCache.
+  static void* operator new(size_t size);
+  static void operator delete(void* bind_state, size_t size);
+
  private:
   BindStateBase(InvokeFuncStorage polymorphic_invoke,
                 void (*destructor)(const BindStateBase*));
@@ -0,0 +1,262 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_CONTAINERS_FLAT_HASH_MAP_H_
+#define BASE_CONTAINERS_FLAT_HASH_MAP_H_
+
+#include <functional>
+#include <new>
+#include <tuple>
+#include <utility>
+
+#include "base/containers/flat_hash_table.h"
+#include "base/containers/flat_map.h"
+
+namespace base {
+
+// flat_hash_map is a container with a std::unordered_map-like interface that
+// stores its contents in a single open-addressing array.
+//
+// Please see //base/containers/README.md for an overview of which container
+// to select.
+//
+// PROS
+//
+//  - Good memory locality: a lookup usually touches one cache line of
+//    metadata and one slot.
+//  - One allocation for the whole table, and no per-element overhead besides
+//    one byte of metadata.
+//  - Lookups, inserts and removals are O(1) on average.
+//
+// CONS
+//
+//  - Elements are stored inline, so large values make the table large and
+//    slow to rehash. Consider storing large values in std::unique_ptr.
+//  - Iteration order is unspecified, and changes across rehashes.
+//
+// IMPORTANT NOTES
+//
+//  - Iterators and references are invalidated by inserts that rehash, unlike
+//    std::unordered_map's references. Erasing never invalidates iterators or
+//    references to other elements.
+//  - If the number of elements is known, call reserve() before inserting.
+//
+// QUICK REFERENCE
+//
+// Most of the core functionality is inherited from flat_hash_table. Please see
+// flat_hash_table.h for more details for most of these functions. As a quick
+// reference, the functions available are:
+//
+// Constructors:
+//   flat_hash_map(InputIterator first, InputIterator last);
+//   flat_hash_map(const flat_hash_map&);
+//   flat_hash_map(flat_hash_map&&);
+//   flat_hash_map(std::initializer_list<value_type> ilist);
+//
+// Assignment functions:
+//   flat_hash_map& operator=(const flat_hash_map&);
+//   flat_hash_map& operator=(flat_hash_map&&);
+//   flat_hash_map& operator=(initializer_list<value_type>);
+//
+// Memory management functions:
+//   void   reserve(size_t);
+//   size_t capacity() const;
+//   void   shrink_to_fit();
+//
+// Size management functions:
+//   void   clear();
+//   size_t size() const;
+//   size_t max_size() const;
+//   bool   empty() const;
+//
+// Iterator functions:
+//   iterator       begin();
+//   const_iterator begin() const;
+//   const_iterator cbegin() const;
+//   iterator       end();
+//   const_iterator end() const;
+//   const_iterator cend() const;
+//
+// Insert and accessor functions:
+//   mapped_type&         operator[](const key_type&);
+//   mapped_type&         operator[](key_type&&);
+//   pair<iterator, bool> insert(const value_type&);
+//   pair<iterator, bool> insert(value_type&&);
+//   void                 insert(InputIterator first, InputIterator last);
+//   pair<iterator, bool> insert_or_assign(const key_type&, M&&);
+//   pair<iterator, bool> insert_or_assign(key_type&&, M&&);
+//   pair<iterator, bool> emplace(Args&&...);
+//   pair<iterator, bool> try_emplace(const key_type&, Args&&...);
+//   pair<iterator, bool> try_emplace(key_type&&, Args&&...);
+//
+// Erase functions:
+//   iterator erase(iterator);
+//   iterator erase(const_iterator);
+//   iterator erase(const_iterator first, const_iterator& last);
+//   template <class K> size_t erase(const K& key);
+//
+// Observers (see std::unordered_map documentation).
+//   hasher    hash_function() const;
+//   key_equal key_eq() const;
+//
+// Search functions:
+//   template <typename K> size_t         count(const K&) const;
+//   template <typename K> iterator       find(const K&);
+//   template <typename K> const_iterator find(const K&) const;
+//
+// General functions:
+//   void swap(flat_hash_map&&);
+//
+// Non-member operators:
+//   bool operator==(const flat_hash_map&, const flat_hash_map);
+//   bool operator!=(const flat_hash_map&, const flat_hash_map);
+//
+// Heterogeneous lookups (e.g. finding a std::string key with a StringPiece)
+// are supported when both |Hash| and |KeyEqual| define |is_transparent|.
+template <class Key,
+          class Mapped,
+          class Hash = std::hash<Key>,
+          class KeyEqual = std::equal_to<Key>>
+class flat_hash_map
+    : public ::base::internal::flat_hash_table<
+          Key,
+          std::pair<Key, Mapped>,
+          ::base::internal::GetKeyFromValuePairFirst<Key, Mapped>,
+          Hash,
+          KeyEqual> {
+ private:
+  using table = typename ::base::internal::flat_hash_table<
+      Key,
+      std::pair<Key, Mapped>,
+      ::base::internal::GetKeyFromValuePairFirst<Key, Mapped>,
+      Hash,
+      KeyEqual>;
+
+ public:
+  using key_type = typename table::key_type;
+  using mapped_type = Mapped;
+  using value_type = typename table::value_type;
+  using iterator = typename table::iterator;
+  using const_iterator = typename table::const_iterator;
+
+  // --------------------------------------------------------------------------
+  // Lifetime and assignments.
+
+  flat_hash_map() = default;
+
+  template <class InputIterator>
+  flat_hash_map(InputIterator first, InputIterator last)
+      : table(first, last) {}
+
+  flat_hash_map(std::initializer_list<value_type> ilist) : table(ilist) {}
+
+  flat_hash_map(const flat_hash_map&) = default;
+  flat_hash_map(flat_hash_map&&) noexcept = default;
+
+  ~flat_hash_map() = default;
+
+  flat_hash_map& operator=(const flat_hash_map&) = default;
+  flat_hash_map& operator=(flat_hash_map&&) = default;
+  flat_hash_map& operator=(std::initializer_list<value_type> ilist) {
+    table::operator=(ilist);
+    return *this;
+  }
+
+  // --------------------------------------------------------------------------
+  // Map-specific insert operations.
+  //
+  // Normal insert() functions are inherited from flat_hash_table.
+
+  mapped_type& operator[](const key_type& key);
+  mapped_type& operator[](key_type&& key);
+
+  template <class M>
+  std::pair<iterator, bool> insert_or_assign(const key_type& key, M&& obj);
+  template <class M>
+  std::pair<iterator, bool> insert_or_assign(key_type&& key, M&& obj);
+
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args);
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(key_type&& key, Args&&... args);
+
+  // --------------------------------------------------------------------------
+  // General operations.
+
+  void swap(flat_hash_map& other) noexcept { table::swap(other); }
+
+  friend void swap(flat_hash_map& lhs, flat_hash_map& rhs) noexcept {
+    lhs.swap(rhs);
+  }
+};
+
+// ----------------------------------------------------------------------------
+// Insert operations.
+
+template <class Key, class Mapped, class Hash, class KeyEqual>
+auto flat_hash_map<Key, Mapped, Hash, KeyEqual>::operator[](
+    const key_type& key) -> mapped_type& {
+  return try_emplace(key).first->second;
+}
+
+template <class Key, class Mapped, class Hash, class KeyEqual>
+auto flat_hash_map<Key, Mapped, Hash, KeyEqual>::operator[](key_type&& key)
+    -> mapped_type& {
+  return try_emplace(std::move(key)).first->second;
+}
+
+template <class Key, class Mapped, class Hash, class KeyEqual>
+template <class M>
+auto flat_hash_map<Key, Mapped, Hash, KeyEqual>::insert_or_assign(
+    const key_type& key,
+    M&& obj) -> std::pair<iterator, bool> {
+  std::pair<iterator, bool> result = try_emplace(key, std::forward<M>(obj));
+  if (!result.second)
+    result.first->second = std::forward<M>(obj);
+  return result;
+}
+
+template <class Key, class Mapped, class Hash, class KeyEqual>
+template <class M>
+auto flat_hash_map<Key, Mapped, Hash, KeyEqual>::insert_or_assign(
+    key_type&& key,
+    M&& obj) -> std::pair<iterator, bool> {
+  std::pair<iterator, bool> result =
+      try_emplace(std::move(key), std::forward<M>(obj));
+  if (!result.second)
+    result.first->second = std::forward<M>(obj);
+  return result;
+}
+
+template <class Key, class Mapped, class Hash, class KeyEqual>
+template <class... Args>
+auto flat_hash_map<Key, Mapped, Hash, KeyEqual>::try_emplace(
+    const key_type& key,
+    Args&&... args) -> std::pair<iterator, bool> {
+  std::pair<size_t, bool> result = table::FindOrPrepareInsert(key);
+  if (result.second) {
+    new (table::slot(result.first))
+        value_type(std::piecewise_construct, std::forward_as_tuple(key),
+                   std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+  return {table::iterator_at(result.first), result.second};
+}
+
+template <class Key, class Mapped, class Hash, class KeyEqual>
+template <class... Args>
+auto flat_hash_map<Key, Mapped, Hash, KeyEqual>::try_emplace(
+    key_type&& key,
+    Args&&... args) -> std::pair<iterator, bool> {
+  std::pair<size_t, bool> result = table::FindOrPrepareInsert(key);
+  if (result.second) {
+    new (table::slot(result.first)) value_type(
+        std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+  return {table::iterator_at(result.first), result.second};
+}
+
+}  // namespace base
+
+#endif  // BASE_CONTAINERS_FLAT_HASH_MAP_H_
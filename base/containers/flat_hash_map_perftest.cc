@@ -0,0 +1,150 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/containers/flat_hash_map.h"
+
+#include <stdint.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/rand_util.h"
+#include "base/strings/stringprintf.h"
+#include "base/test/perf_benchmark.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+// Roughly the payload of a disk_cache::EntryMetadata.
+struct EntryMetadata {
+  uint32_t last_used_time;
+  uint32_t entry_size;
+};
+
+// Hostnames, like the keys of net::HostCache.
+std::vector<std::string> GenerateHostnames(size_t count) {
+  std::vector<std::string> keys;
+  keys.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    keys.push_back(StringPrintf("www.host%zu.subdomain%zu.example.com", i,
+                                i % 17));
+  }
+  return keys;
+}
+
+// Random 64-bit entry hashes, like the keys of disk_cache::SimpleIndex's
+// EntrySet.
+std::vector<uint64_t> GenerateEntryHashes(size_t count) {
+  std::vector<uint64_t> keys;
+  keys.reserve(count);
+  for (size_t i = 0; i < count; ++i)
+    keys.push_back(RandUint64());
+  return keys;
+}
+
+// "host:port" pairs, like the keys of net::SpdySessionPool's available
+// sessions. Pools are small, so each measurement uses many of them.
+std::vector<std::string> GenerateHostPortPairs(size_t count) {
+  std::vector<std::string> keys;
+  keys.reserve(count);
+  for (size_t i = 0; i < count; ++i)
+    keys.push_back(StringPrintf("origin%zu.example.org:443", i));
+  return keys;
+}
+
+// Measures inserting |keys| into |num_maps| maps, looking each of them up,
+// looking up as many missing keys, and erasing them.
+template <class Map, class Key, class Value>
+void RunBenchmark(const std::string& trace,
+                  const std::vector<Key>& keys,
+                  const std::vector<Key>& missing_keys,
+                  const Value& value,
+                  int num_maps) {
+  PerfBenchmark::Options options;
+  options.operations_per_run = static_cast<double>(keys.size()) * num_maps;
+  std::vector<Map> maps;
+  auto fill_maps = [&] {
+    for (Map& map : maps) {
+      for (const Key& key : keys)
+        map.emplace(key, value);
+    }
+  };
+
+  // Inserting and erasing change the maps, so each repetition starts from new
+  // maps and is measured on its own.
+  PerfBenchmark("Insert", trace, options).RunMeasured([&] {
+    maps = std::vector<Map>(num_maps);
+    TimeTicks start = TimeTicks::Now();
+    fill_maps();
+    return TimeTicks::Now() - start;
+  });
+
+  PerfBenchmark("FindHit", trace, options).Run([&] {
+    size_t found = 0;
+    for (const Map& map : maps) {
+      for (const Key& key : keys)
+        found += map.count(key);
+    }
+    EXPECT_EQ(keys.size() * num_maps, found);
+  });
+
+  PerfBenchmark("FindMiss", trace, options).Run([&] {
+    size_t found = 0;
+    for (const Map& map : maps) {
+      for (const Key& key : missing_keys)
+        found += map.count(key);
+    }
+    EXPECT_EQ(0U, found);
+  });
+
+  PerfBenchmark("Erase", trace, options).RunMeasured([&] {
+    maps = std::vector<Map>(num_maps);
+    fill_maps();
+    TimeTicks start = TimeTicks::Now();
+    for (Map& map : maps) {
+      for (const Key& key : keys)
+        map.erase(key);
+    }
+    return TimeTicks::Now() - start;
+  });
+}
+
+}  // namespace
+
+TEST(FlatHashMapPerfTest, HostCacheLikeKeys) {
+  const std::vector<std::string> keys = GenerateHostnames(2000);
+  const std::vector<std::string> missing_keys = GenerateHostnames(4000);
+  const std::vector<std::string> misses(missing_keys.begin() + 2000,
+                                        missing_keys.end());
+  RunBenchmark<flat_hash_map<std::string, int>>("flat_hash_map", keys, misses,
+                                                0, 100);
+  RunBenchmark<std::unordered_map<std::string, int>>(
+      "std::unordered_map", keys, misses, 0, 100);
+}
+
+TEST(FlatHashMapPerfTest, SimpleIndexLikeKeys) {
+  const std::vector<uint64_t> keys = GenerateEntryHashes(500000);
+  const std::vector<uint64_t> misses = GenerateEntryHashes(500000);
+  RunBenchmark<flat_hash_map<uint64_t, EntryMetadata>>(
+      "flat_hash_map", keys, misses, EntryMetadata(), 2);
+  RunBenchmark<std::unordered_map<uint64_t, EntryMetadata>>(
+      "std::unordered_map", keys, misses, EntryMetadata(), 2);
+}
+
+TEST(FlatHashMapPerfTest, SpdySessionPoolLikeKeys) {
+  const std::vector<std::string> all_keys = GenerateHostPortPairs(16);
+  const std::vector<std::string> keys(all_keys.begin(), all_keys.begin() + 8);
+  const std::vector<std::string> misses(all_keys.begin() + 8, all_keys.end());
+  void* const session = nullptr;
+  RunBenchmark<flat_hash_map<std::string, void*>>("flat_hash_map", keys,
+                                                  misses, session, 20000);
+  RunBenchmark<std::unordered_map<std::string, void*>>(
+      "std::unordered_map", keys, misses, session, 20000);
+}
+
+}  // namespace base
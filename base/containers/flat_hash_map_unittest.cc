@@ -0,0 +1,396 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/containers/flat_hash_map.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/rand_util.h"
+#include "base/strings/string_piece.h"
+#include "base/test/move_only_int.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// flat_hash_map is a thin wrapper around flat_hash_table, so the bulk of the
+// table tests are here; flat_hash_set_unittest.cc only covers set-specific
+// behavior.
+
+using ::testing::Pair;
+using ::testing::UnorderedElementsAre;
+
+namespace base {
+
+namespace {
+
+struct MoveOnlyIntHash {
+  size_t operator()(const MoveOnlyInt& value) const {
+    return std::hash<int>()(value.data());
+  }
+};
+
+// Sends every key to the same probe sequence, so that all lookups have to
+// look past the first group.
+struct ConstantHash {
+  size_t operator()(int) const { return 42; }
+};
+
+// Hashes std::string and StringPiece identically, for heterogeneous lookups.
+struct TransparentStringHash {
+  using is_transparent = void;
+  size_t operator()(StringPiece str) const { return StringPieceHash()(str); }
+};
+
+using StringMap =
+    flat_hash_map<std::string, int, TransparentStringHash, std::equal_to<>>;
+
+}  // namespace
+
+TEST(FlatHashMap, IncompleteType) {
+  struct A {
+    using Map = flat_hash_map<int, A>;
+    int data;
+    Map map_with_incomplete_type;
+    Map::iterator it;
+    Map::const_iterator cit;
+  };
+
+  A a;
+}
+
+TEST(FlatHashMap, Empty) {
+  flat_hash_map<int, int> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(0U, map.size());
+  EXPECT_EQ(0U, map.capacity());
+  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_EQ(map.end(), map.find(1));
+  EXPECT_EQ(0U, map.count(1));
+  EXPECT_EQ(0U, map.erase(1));
+  map.clear();
+  EXPECT_TRUE(map.empty());
+}
+
+TEST(FlatHashMap, InsertAndFind) {
+  flat_hash_map<int, int> map;
+  auto result = map.insert(std::make_pair(1, 10));
+  EXPECT_TRUE(result.second);
+  EXPECT_EQ(1, result.first->first);
+  EXPECT_EQ(10, result.first->second);
+
+  result = map.insert(std::make_pair(1, 20));
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(10, result.first->second);
+
+  result = map.emplace(2, 20);
+  EXPECT_TRUE(result.second);
+
+  EXPECT_EQ(2U, map.size());
+  EXPECT_EQ(1U, map.count(1));
+  EXPECT_EQ(1U, map.count(2));
+  EXPECT_EQ(0U, map.count(3));
+  EXPECT_EQ(20, map.find(2)->second);
+  EXPECT_EQ(map.end(), map.find(3));
+  EXPECT_THAT(map, UnorderedElementsAre(Pair(1, 10), Pair(2, 20)));
+}
+
+TEST(FlatHashMap, RangeAndInitializerListConstructors) {
+  std::vector<std::pair<int, int>> input = {{1, 1}, {2, 2}, {1, 3}, {3, 3}};
+
+  // Keeps the first of duplicates, like std::unordered_map.
+  flat_hash_map<int, int> from_range(input.begin(), input.end());
+  EXPECT_THAT(from_range,
+              UnorderedElementsAre(Pair(1, 1), Pair(2, 2), Pair(3, 3)));
+
+  flat_hash_map<int, int> from_list = {{1, 1}, {2, 2}, {1, 3}, {3, 3}};
+  EXPECT_EQ(from_range, from_list);
+
+  from_list = {{4, 4}};
+  EXPECT_THAT(from_list, UnorderedElementsAre(Pair(4, 4)));
+}
+
+TEST(FlatHashMap, SubscriptOperator) {
+  flat_hash_map<std::string, int> map;
+  map["a"] = 1;
+  std::string key = "b";
+  map[std::move(key)] = 2;
+  ++map["a"];
+  EXPECT_EQ(0, map["c"]);
+  EXPECT_THAT(map, UnorderedElementsAre(Pair("a", 2), Pair("b", 2),
+                                        Pair("c", 0)));
+}
+
+TEST(FlatHashMap, InsertOrAssign) {
+  flat_hash_map<int, std::string> map;
+  auto result = map.insert_or_assign(1, "a");
+  EXPECT_TRUE(result.second);
+  EXPECT_EQ("a", result.first->second);
+
+  result = map.insert_or_assign(1, "b");
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ("b", result.first->second);
+  EXPECT_EQ(1U, map.size());
+}
+
+TEST(FlatHashMap, TryEmplace) {
+  flat_hash_map<MoveOnlyInt, MoveOnlyInt, MoveOnlyIntHash> map;
+  auto result = map.try_emplace(MoveOnlyInt(1), 10);
+  EXPECT_TRUE(result.second);
+  EXPECT_EQ(10, result.first->second.data());
+
+  // The key and the arguments are not moved from if the key is present.
+  MoveOnlyInt key(1);
+  MoveOnlyInt value(20);
+  result = map.try_emplace(std::move(key), std::move(value));
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(1, key.data());
+  EXPECT_EQ(20, value.data());
+  EXPECT_EQ(10, result.first->second.data());
+}
+
+TEST(FlatHashMap, Erase) {
+  flat_hash_map<int, int> map = {{1, 1}, {2, 2}, {3, 3}, {4, 4}};
+  EXPECT_EQ(1U, map.erase(2));
+  EXPECT_EQ(0U, map.erase(2));
+  EXPECT_EQ(map.end(), map.find(2));
+  EXPECT_THAT(map,
+              UnorderedElementsAre(Pair(1, 1), Pair(3, 3), Pair(4, 4)));
+
+  map.erase(map.find(3));
+  EXPECT_THAT(map, UnorderedElementsAre(Pair(1, 1), Pair(4, 4)));
+
+  map.erase(map.cbegin(), map.cend());
+  EXPECT_TRUE(map.empty());
+}
+
+TEST(FlatHashMap, EraseWhileIterating) {
+  flat_hash_map<int, int> map;
+  for (int i = 0; i < 1000; ++i)
+    map[i] = i;
+
+  for (auto it = map.begin(); it != map.end();) {
+    if (it->first % 3 == 0)
+      it = map.erase(it);
+    else
+      ++it;
+  }
+
+  EXPECT_EQ(666U, map.size());
+  for (int i = 0; i < 1000; ++i)
+    EXPECT_EQ(i % 3 == 0 ? 0U : 1U, map.count(i)) << i;
+}
+
+TEST(FlatHashMap, ErasingKeepsOtherReferences) {
+  flat_hash_map<int, int> map;
+  for (int i = 0; i < 100; ++i)
+    map[i] = i;
+  int* value = &map[50];
+  for (int i = 0; i < 100; ++i) {
+    if (i != 50)
+      map.erase(i);
+  }
+  EXPECT_EQ(value, &map[50]);
+  EXPECT_EQ(50, *value);
+}
+
+TEST(FlatHashMap, Rehash) {
+  flat_hash_map<int, int> map;
+  size_t last_capacity = map.capacity();
+  for (int i = 0; i < 10000; ++i) {
+    map[i] = -i;
+    // At most 7/8 of the slots are used.
+    EXPECT_LE(map.size() * 8, map.capacity() * 7 + 8);
+    if (map.capacity() != last_capacity) {
+      last_capacity = map.capacity();
+      // Capacities are powers of 2 minus 1.
+      EXPECT_EQ(0U, last_capacity & (last_capacity + 1));
+    }
+  }
+  ASSERT_EQ(10000U, map.size());
+  for (int i = 0; i < 10000; ++i)
+    EXPECT_EQ(-i, map.find(i)->second);
+}
+
+TEST(FlatHashMap, Reserve) {
+  flat_hash_map<int, int> map;
+  map.reserve(1000);
+  const size_t capacity = map.capacity();
+  EXPECT_GE(capacity, 1000U);
+
+  map[0] = 0;
+  int* first = &map[0];
+  for (int i = 1; i < 1000; ++i)
+    map[i] = i;
+  EXPECT_EQ(capacity, map.capacity());
+  EXPECT_EQ(first, &map[0]);
+
+  // Reserving less than the current size does nothing.
+  map.reserve(10);
+  EXPECT_EQ(capacity, map.capacity());
+}
+
+TEST(FlatHashMap, ClearKeepsCapacity) {
+  flat_hash_map<int, int> map;
+  for (int i = 0; i < 100; ++i)
+    map[i] = i;
+  const size_t capacity = map.capacity();
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(capacity, map.capacity());
+  EXPECT_EQ(map.begin(), map.end());
+  for (int i = 0; i < 100; ++i)
+    map[i] = i;
+  EXPECT_EQ(capacity, map.capacity());
+}
+
+TEST(FlatHashMap, ShrinkToFit) {
+  flat_hash_map<int, int> map;
+  for (int i = 0; i < 1000; ++i)
+    map[i] = i;
+  for (int i = 10; i < 1000; ++i)
+    map.erase(i);
+  map.shrink_to_fit();
+  EXPECT_LT(map.capacity(), 32U);
+  for (int i = 0; i < 10; ++i)
+    EXPECT_EQ(i, map[i]);
+
+  map.clear();
+  map.shrink_to_fit();
+  EXPECT_EQ(0U, map.capacity());
+}
+
+// Erasing and inserting in a loop must reclaim deleted slots instead of
+// growing the table indefinitely.
+TEST(FlatHashMap, ChurnDoesNotGrow) {
+  flat_hash_map<int, int> map;
+  for (int i = 0; i < 100; ++i)
+    map[i] = i;
+  const size_t capacity = map.capacity();
+  for (int i = 100; i < 100000; ++i) {
+    map.erase(i - 100);
+    map[i] = i;
+  }
+  EXPECT_EQ(100U, map.size());
+  EXPECT_LE(map.capacity(), capacity * 2 + 1);
+  for (int i = 100000 - 100; i < 100000; ++i)
+    EXPECT_EQ(i, map[i]);
+}
+
+TEST(FlatHashMap, CollidingHashes) {
+  flat_hash_map<int, int, ConstantHash> map;
+  for (int i = 0; i < 100; ++i)
+    map[i] = i;
+  for (int i = 0; i < 100; i += 2)
+    map.erase(i);
+  EXPECT_EQ(50U, map.size());
+  for (int i = 0; i < 100; ++i)
+    EXPECT_EQ(i % 2 ? 1U : 0U, map.count(i)) << i;
+}
+
+// Compares against std::map under random operations.
+TEST(FlatHashMap, RandomOperations) {
+  flat_hash_map<int, int> map;
+  std::map<int, int> expected;
+  for (int i = 0; i < 100000; ++i) {
+    const int key = RandInt(0, 2000);
+    switch (RandInt(0, 2)) {
+      case 0:
+        map[key] = i;
+        expected[key] = i;
+        break;
+      case 1:
+        EXPECT_EQ(expected.erase(key), map.erase(key));
+        break;
+      case 2:
+        EXPECT_EQ(expected.count(key), map.count(key));
+        break;
+    }
+  }
+  EXPECT_EQ(expected.size(), map.size());
+  std::map<int, int> actual(map.begin(), map.end());
+  EXPECT_EQ(expected, actual);
+}
+
+TEST(FlatHashMap, CopyAndMove) {
+  flat_hash_map<int, std::string> original;
+  for (int i = 0; i < 100; ++i)
+    original[i] = std::to_string(i);
+
+  flat_hash_map<int, std::string> copy(original);
+  EXPECT_EQ(original, copy);
+
+  flat_hash_map<int, std::string> assigned;
+  assigned[1000] = "x";
+  assigned = copy;
+  EXPECT_EQ(original, assigned);
+
+  flat_hash_map<int, std::string> moved(std::move(copy));
+  EXPECT_EQ(original, moved);
+  EXPECT_TRUE(copy.empty());
+
+  assigned = std::move(moved);
+  EXPECT_EQ(original, assigned);
+
+  // Moved-from maps are usable.
+  copy[1] = "1";
+  EXPECT_EQ(1U, copy.size());
+}
+
+TEST(FlatHashMap, MoveOnlyValues) {
+  flat_hash_map<int, std::unique_ptr<int>> map;
+  for (int i = 0; i < 100; ++i)
+    map[i] = std::make_unique<int>(i);
+  for (int i = 0; i < 100; ++i)
+    EXPECT_EQ(i, *map[i]);
+}
+
+TEST(FlatHashMap, Swap) {
+  flat_hash_map<int, int> a = {{1, 1}};
+  flat_hash_map<int, int> b = {{2, 2}, {3, 3}};
+  swap(a, b);
+  EXPECT_THAT(a, UnorderedElementsAre(Pair(2, 2), Pair(3, 3)));
+  EXPECT_THAT(b, UnorderedElementsAre(Pair(1, 1)));
+}
+
+TEST(FlatHashMap, Equality) {
+  flat_hash_map<int, int> a = {{1, 1}, {2, 2}};
+  flat_hash_map<int, int> b = {{2, 2}, {1, 1}};
+  flat_hash_map<int, int> c = {{1, 1}, {2, 3}};
+  EXPECT_TRUE(a == b);
+  EXPECT_FALSE(a != b);
+  EXPECT_FALSE(a == c);
+  EXPECT_TRUE(a != c);
+}
+
+TEST(FlatHashMap, HeterogeneousLookup) {
+  StringMap map;
+  map["a"] = 1;
+  map["bc"] = 2;
+
+  StringPiece key = "bc";
+  EXPECT_EQ(1U, map.count(key));
+  EXPECT_EQ(2, map.find(key)->second);
+  EXPECT_EQ(map.end(), map.find(StringPiece("d")));
+
+  const StringMap& const_map = map;
+  EXPECT_EQ(1, const_map.find(StringPiece("a"))->second);
+
+  EXPECT_EQ(1U, map.erase(StringPiece("a")));
+  EXPECT_THAT(map, UnorderedElementsAre(Pair("bc", 2)));
+}
+
+TEST(FlatHashMap, ConstIterators) {
+  flat_hash_map<int, int> map = {{1, 1}, {2, 2}};
+  flat_hash_map<int, int>::const_iterator it = map.begin();
+  EXPECT_EQ(it, map.cbegin());
+  int sum = 0;
+  for (; it != map.cend(); ++it)
+    sum += it->second;
+  EXPECT_EQ(3, sum);
+}
+
+}  // namespace base
@@ -0,0 +1,60 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_CONTAINERS_FLAT_HASH_SET_H_
+#define BASE_CONTAINERS_FLAT_HASH_SET_H_
+
+#include <functional>
+
+#include "base/containers/flat_hash_table.h"
+#include "base/containers/flat_tree.h"
+
+namespace base {
+
+// flat_hash_set is a container with a std::unordered_set-like interface that
+// stores its contents in a single open-addressing array.
+//
+// Please see //base/containers/README.md for an overview of which container
+// to select.
+//
+// PROS
+//
+//  - Good memory locality: a lookup usually touches one cache line of
+//    metadata and one slot.
+//  - One allocation for the whole table, and no per-element overhead besides
+//    one byte of metadata.
+//  - Lookups, inserts and removals are O(1) on average.
+//
+// CONS
+//
+//  - Elements are stored inline, so large elements make the table large and
+//    slow to rehash.
+//  - Iteration order is unspecified, and changes across rehashes.
+//
+// IMPORTANT NOTES
+//
+//  - Iterators and references are invalidated by inserts that rehash. Erasing
+//    never invalidates iterators or references to other elements.
+//  - If the number of elements is known, call reserve() before inserting.
+//
+// QUICK REFERENCE
+//
+// The functions available are those of flat_hash_map (see
+// flat_hash_map.h), minus the map-specific insert and accessor functions.
+//
+// Heterogeneous lookups (e.g. finding a std::string with a StringPiece) are
+// supported when both |Hash| and |KeyEqual| define |is_transparent|.
+template <class Key,
+          class Hash = std::hash<Key>,
+          class KeyEqual = std::equal_to<Key>>
+using flat_hash_set = typename ::base::internal::flat_hash_table<
+    Key,
+    Key,
+    ::base::internal::GetKeyFromValueIdentity<Key>,
+    Hash,
+    KeyEqual>;
+
+}  // namespace base
+
+#endif  // BASE_CONTAINERS_FLAT_HASH_SET_H_
@@ -0,0 +1,80 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/containers/flat_hash_set.h"
+
+#include <string>
+#include <utility>
+
+#include "base/strings/string_piece.h"
+#include "base/test/move_only_int.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// A flat_hash_set is basically an alias of flat_hash_table. So several basic
+// operations are tested to make sure things are set up properly, but the bulk
+// of the tests are in flat_hash_map_unittest.cc.
+
+using ::testing::UnorderedElementsAre;
+
+namespace base {
+
+TEST(FlatHashSet, IncompleteType) {
+  struct A {
+    using Set = flat_hash_set<A*>;
+    int data;
+    Set set_with_incomplete_type;
+    Set::iterator it;
+    Set::const_iterator cit;
+  };
+
+  A a;
+}
+
+TEST(FlatHashSet, InsertFindErase) {
+  flat_hash_set<int> set = {1, 2, 2, 3};
+  EXPECT_THAT(set, UnorderedElementsAre(1, 2, 3));
+
+  EXPECT_FALSE(set.insert(2).second);
+  EXPECT_TRUE(set.insert(4).second);
+  EXPECT_EQ(1U, set.count(4));
+  EXPECT_EQ(4, *set.find(4));
+
+  EXPECT_EQ(1U, set.erase(1));
+  EXPECT_EQ(0U, set.erase(1));
+  EXPECT_THAT(set, UnorderedElementsAre(2, 3, 4));
+}
+
+TEST(FlatHashSet, MoveOnlyKeys) {
+  struct Hash {
+    size_t operator()(const MoveOnlyInt& value) const {
+      return std::hash<int>()(value.data());
+    }
+  };
+
+  flat_hash_set<MoveOnlyInt, Hash> set;
+  for (int i = 1; i <= 100; ++i)
+    set.insert(MoveOnlyInt(i));
+  EXPECT_EQ(100U, set.size());
+
+  int sum = 0;
+  for (const MoveOnlyInt& value : set)
+    sum += value.data();
+  EXPECT_EQ(5050, sum);
+}
+
+TEST(FlatHashSet, HeterogeneousLookup) {
+  struct Hash {
+    using is_transparent = void;
+    size_t operator()(StringPiece str) const { return StringPieceHash()(str); }
+  };
+
+  flat_hash_set<std::string, Hash, std::equal_to<>> set = {"a", "bc"};
+  EXPECT_EQ(1U, set.count(StringPiece("bc")));
+  EXPECT_EQ(set.end(), set.find(StringPiece("b")));
+  EXPECT_EQ(1U, set.erase(StringPiece("a")));
+  EXPECT_THAT(set, UnorderedElementsAre("bc"));
+}
+
+}  // namespace base
@@ -0,0 +1,967 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_CONTAINERS_FLAT_HASH_TABLE_H_
+#define BASE_CONTAINERS_FLAT_HASH_TABLE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "base/bits.h"
+#include "base/compiler_specific.h"
+#include "base/containers/flat_tree.h"
+#include "base/logging.h"
+#include "base/numerics/checked_math.h"
+#include "build/build_config.h"
+
+// NaCl does not allow intrinsics.
+#if defined(ARCH_CPU_X86_FAMILY) && !defined(OS_NACL)
+#include <emmintrin.h>
+#define BASE_FLAT_HASH_TABLE_USE_SSE2
+#endif
+
+namespace base {
+
+namespace internal {
+
+// Implementation of an open-addressing hash table for backing flat_hash_set
+// and flat_hash_map. Do not use directly.
+//
+// This is a "Swiss table": slots are stored in one array, and each slot has a
+// one-byte control byte in a parallel array. The control byte of a full slot
+// holds 7 bits of the hash of its key (H2). The other bits (H1) select where a
+// lookup starts probing. A lookup loads a group of control bytes at a time
+// and compares all of them to H2 at once, using SSE2 when available, so that
+// keys are only compared for the few slots whose H2 matches. Probing stops at
+// the first group with an empty slot.
+//
+// The control bytes array has |capacity_| + 1 + (FlatHashGroup::kWidth - 1)
+// elements: a sentinel that marks the end for iterators follows the control
+// bytes of the slots, then copies of the first kWidth - 1 control bytes so
+// that groups can be loaded at any position without wrapping around.
+//
+// |capacity_| is either 0 or a power of 2 minus 1. At most 7/8 of the slots
+// are used, so that probing always terminates. Erased slots are marked as
+// deleted rather than empty when a probe might have continued past them, and
+// are reclaimed when the table is rehashed.
+
+// Values of control bytes. Full slots have a value in [0, 127].
+enum FlatHashCtrl : int8_t {
+  kFlatHashEmpty = -128,  // 0b10000000
+  kFlatHashDeleted = -2,  // 0b11111110
+  kFlatHashSentinel = -1,  // 0b11111111
+};
+
+inline bool FlatHashIsFull(int8_t ctrl) {
+  return ctrl >= 0;
+}
+
+inline bool FlatHashIsEmptyOrDeleted(int8_t ctrl) {
+  return ctrl < kFlatHashSentinel;
+}
+
+// The control bytes of tables without slots. Loading a group from it never
+// finds a match, and iterating from it immediately finds the sentinel.
+inline int8_t* FlatHashEmptyGroup() {
+  alignas(16) static int8_t empty_group[16] = {
+      kFlatHashSentinel, kFlatHashEmpty, kFlatHashEmpty, kFlatHashEmpty,
+      kFlatHashEmpty,    kFlatHashEmpty, kFlatHashEmpty, kFlatHashEmpty,
+      kFlatHashEmpty,    kFlatHashEmpty, kFlatHashEmpty, kFlatHashEmpty,
+      kFlatHashEmpty,    kFlatHashEmpty, kFlatHashEmpty, kFlatHashEmpty};
+  return empty_group;
+}
+
+// A set of slots of a group, as returned by the Match functions of
+// FlatHashGroup. Each slot corresponds to 2^|kShift| bits of |T|, of which
+// only the highest can be set.
+template <class T, size_t kWidth, int kShift>
+class FlatHashBitMask {
+ public:
+  explicit FlatHashBitMask(T mask) : mask_(mask) {}
+
+  explicit operator bool() const { return mask_ != 0; }
+
+  // Returns the index of the first slot in the set, which must not be empty.
+  uint32_t LowestBitSet() const {
+    return static_cast<uint32_t>(bits::CountTrailingZeroBits(mask_)) >> kShift;
+  }
+
+  // Returns the number of slots after the last slot in the set.
+  uint32_t LeadingZeros() const {
+    constexpr int kExtraBits = sizeof(T) * 8 - (kWidth << kShift);
+    return static_cast<uint32_t>(bits::CountLeadingZeroBits(mask_) -
+                                 kExtraBits) >>
+           kShift;
+  }
+
+  // Removes the first slot from the set.
+  void ClearLowestBit() { mask_ &= mask_ - 1; }
+
+ private:
+  T mask_;
+};
+
+#if defined(BASE_FLAT_HASH_TABLE_USE_SSE2)
+
+// Compares 16 control bytes at once.
+class FlatHashGroup {
+ public:
+  static constexpr size_t kWidth = 16;
+  using BitMask = FlatHashBitMask<uint32_t, kWidth, 0>;
+
+  explicit FlatHashGroup(const int8_t* pos)
+      : ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos))) {}
+
+  // Returns the slots whose control byte is |h2|.
+  BitMask Match(int8_t h2) const {
+    return BitMask(static_cast<uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_))));
+  }
+
+  BitMask MatchEmpty() const { return Match(kFlatHashEmpty); }
+
+  BitMask MatchEmptyOrDeleted() const {
+    return BitMask(static_cast<uint32_t>(_mm_movemask_epi8(
+        _mm_cmpgt_epi8(_mm_set1_epi8(kFlatHashSentinel), ctrl_))));
+  }
+
+  // Returns the number of empty or deleted slots at the start of the group.
+  uint32_t CountLeadingEmptyOrDeleted() const {
+    const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(
+        _mm_cmpgt_epi8(_mm_set1_epi8(kFlatHashSentinel), ctrl_)));
+    return static_cast<uint32_t>(bits::CountTrailingZeroBits(mask + 1));
+  }
+
+ private:
+  __m128i ctrl_;
+};
+
+#else  // defined(BASE_FLAT_HASH_TABLE_USE_SSE2)
+
+// Compares 8 control bytes at once, using 64-bit arithmetic. Assumes a
+// little-endian architecture.
+class FlatHashGroup {
+ public:
+  static constexpr size_t kWidth = 8;
+  using BitMask = FlatHashBitMask<uint64_t, kWidth, 3>;
+
+  explicit FlatHashGroup(const int8_t* pos) { memcpy(&ctrl_, pos, kWidth); }
+
+  // Returns the slots whose control byte is |h2|. There can be false
+  // positives, but only for full slots that follow a true positive, which is
+  // fine since keys are compared anyway.
+  BitMask Match(int8_t h2) const {
+    const uint64_t x = ctrl_ ^ (kLsbs * static_cast<uint8_t>(h2));
+    return BitMask((x - kLsbs) & ~x & kMsbs);
+  }
+
+  // Empty slots are the only ones with the high bit set and bit 1 clear.
+  BitMask MatchEmpty() const { return BitMask(ctrl_ & (~ctrl_ << 6) & kMsbs); }
+
+  // Empty and deleted slots are the only ones with the high bit set and bit 0
+  // clear.
+  BitMask MatchEmptyOrDeleted() const {
+    return BitMask(ctrl_ & (~ctrl_ << 7) & kMsbs);
+  }
+
+  // Returns the number of empty or deleted slots at the start of the group.
+  uint32_t CountLeadingEmptyOrDeleted() const {
+    constexpr uint64_t kGaps = UINT64_C(0x00FEFEFEFEFEFEFE);
+    return static_cast<uint32_t>(
+        (bits::CountTrailingZeroBits(((~ctrl_ & (ctrl_ >> 7)) | kGaps) + 1) +
+         7) >>
+        3);
+  }
+
+ private:
+  static constexpr uint64_t kMsbs = UINT64_C(0x8080808080808080);
+  static constexpr uint64_t kLsbs = UINT64_C(0x0101010101010101);
+
+  uint64_t ctrl_;
+};
+
+#endif  // defined(BASE_FLAT_HASH_TABLE_USE_SSE2)
+
+// The sequence of groups probed for a hash: triangular (quadratic) probing
+// over groups, which visits every group when the number of slots is a power
+// of 2.
+class FlatHashProbeSeq {
+ public:
+  FlatHashProbeSeq(size_t hash, size_t mask)
+      : mask_(mask), offset_(hash & mask) {}
+
+  // Returns the position of the current group.
+  size_t offset() const { return offset_; }
+
+  // Returns the position of the |i|th slot of the current group.
+  size_t offset(size_t i) const { return (offset_ + i) & mask_; }
+
+  void next() {
+    index_ += FlatHashGroup::kWidth;
+    offset_ = (offset_ + index_) & mask_;
+  }
+
+ private:
+  const size_t mask_;
+  size_t offset_;
+  size_t index_ = 0;
+};
+
+// Mixes the bits of |hash|, so that hash functions that leave the low or the
+// high bits mostly constant (e.g. std::hash<int> or std::hash<T*>) still
+// produce good H1 and H2 values.
+inline size_t FlatHashMix(size_t hash) {
+  const uint64_t product =
+      static_cast<uint64_t>(hash) * UINT64_C(0x9E3779B97F4A7C15);
+  return static_cast<size_t>(product ^ (product >> 32));
+}
+
+// Selects the type of the key passed to lookup functions: when both the hash
+// function and the key comparator are transparent, any type they accept can
+// be looked up without being converted to the key type.
+template <bool kIsTransparent>
+struct FlatHashKeyArg {
+  template <class K, class KeyType>
+  using type = K;
+};
+
+template <>
+struct FlatHashKeyArg<false> {
+  template <class K, class KeyType>
+  using type = KeyType;
+};
+
+// The helper class GetKeyFromValue provides the means to extract a key from a
+// value, like for flat_tree. It should implement:
+//   const Key& operator()(const Value&).
+template <class Key,
+          class Value,
+          class GetKeyFromValue,
+          class Hash,
+          class KeyEqual>
+class flat_hash_table {
+ private:
+  template <class K>
+  using key_arg = typename FlatHashKeyArg<
+      IsTransparentCompare<Hash>::value &&
+      IsTransparentCompare<KeyEqual>::value>::template type<K, Key>;
+
+ public:
+  // --------------------------------------------------------------------------
+  // Types.
+  //
+  using key_type = Key;
+  using value_type = Value;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using pointer = value_type*;
+  using const_pointer = const value_type*;
+
+  // Forward iterator over the full slots.
+  template <class T>
+  class hash_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = typename flat_hash_table::value_type;
+    using difference_type = ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+    hash_iterator() = default;
+
+    // Allows converting an iterator to a const_iterator.
+    template <class U,
+              class = std::enable_if_t<std::is_convertible<U*, T*>::value>>
+    hash_iterator(const hash_iterator<U>& other)
+        : ctrl_(other.ctrl_), slot_(other.slot_) {}
+
+    reference operator*() const {
+      DCHECK(FlatHashIsFull(*ctrl_));
+      return *slot_;
+    }
+    pointer operator->() const { return &operator*(); }
+
+    hash_iterator& operator++() {
+      DCHECK(FlatHashIsFull(*ctrl_));
+      ++ctrl_;
+      ++slot_;
+      SkipEmptyOrDeleted();
+      return *this;
+    }
+    hash_iterator operator++(int) {
+      hash_iterator result = *this;
+      ++*this;
+      return result;
+    }
+
+    friend bool operator==(const hash_iterator& lhs, const hash_iterator& rhs) {
+      return lhs.ctrl_ == rhs.ctrl_;
+    }
+    friend bool operator!=(const hash_iterator& lhs, const hash_iterator& rhs) {
+      return lhs.ctrl_ != rhs.ctrl_;
+    }
+
+   private:
+    friend class flat_hash_table;
+    template <class U>
+    friend class hash_iterator;
+
+    // Points to the first full slot at or after |slot|, or to the end.
+    hash_iterator(const int8_t* ctrl, T* slot) : ctrl_(ctrl), slot_(slot) {
+      SkipEmptyOrDeleted();
+    }
+
+    void SkipEmptyOrDeleted() {
+      // The sentinel stops the loop.
+      while (FlatHashIsEmptyOrDeleted(*ctrl_)) {
+        const uint32_t shift =
+            FlatHashGroup(ctrl_).CountLeadingEmptyOrDeleted();
+        ctrl_ += shift;
+        slot_ += shift;
+      }
+    }
+
+    const int8_t* ctrl_ = nullptr;
+    T* slot_ = nullptr;
+  };
+
+  using iterator = hash_iterator<value_type>;
+  using const_iterator = hash_iterator<const value_type>;
+
+  // --------------------------------------------------------------------------
+  // Lifetime.
+
+  flat_hash_table() = default;
+
+  template <class InputIterator>
+  flat_hash_table(InputIterator first, InputIterator last);
+
+  flat_hash_table(std::initializer_list<value_type> ilist);
+
+  flat_hash_table(const flat_hash_table& other);
+  flat_hash_table(flat_hash_table&& other) noexcept;
+
+  ~flat_hash_table();
+
+  // --------------------------------------------------------------------------
+  // Assignments.
+
+  flat_hash_table& operator=(const flat_hash_table& other);
+  flat_hash_table& operator=(flat_hash_table&& other) noexcept;
+  flat_hash_table& operator=(std::initializer_list<value_type> ilist);
+
+  // --------------------------------------------------------------------------
+  // Memory management.
+  //
+  // Beware that shrink_to_fit() simply forwards the request to
+  // rehash() and may not release memory if there are many tombstones.
+
+  // Makes room for |new_size| elements without rehashing.
+  void reserve(size_type new_size);
+
+  // Returns the number of slots. Only 7/8 of them can be used before the
+  // table grows.
+  size_type capacity() const { return capacity_; }
+
+  // Rehashes into the smallest table that holds size() elements.
+  void shrink_to_fit();
+
+  // --------------------------------------------------------------------------
+  // Size management.
+
+  // Destroys all elements but keeps the slots.
+  void clear();
+
+  size_type size() const { return size_; }
+  size_type max_size() const { return SIZE_MAX / (sizeof(value_type) + 1); }
+  bool empty() const { return size_ == 0; }
+
+  // --------------------------------------------------------------------------
+  // Iterators.
+  //
+  // Iterators are in an unspecified order that changes when the table is
+  // rehashed.
+
+  iterator begin() { return iterator(ctrl_, slots_); }
+  const_iterator begin() const { return const_iterator(ctrl_, slots_); }
+  const_iterator cbegin() const { return begin(); }
+
+  iterator end() { return iterator(ctrl_ + capacity_, slots_ + capacity_); }
+  const_iterator end() const {
+    return const_iterator(ctrl_ + capacity_, slots_ + capacity_);
+  }
+  const_iterator cend() const { return end(); }
+
+  // --------------------------------------------------------------------------
+  // Insert operations.
+  //
+  // Insertions invalidate iterators and references if they rehash, which
+  // happens when the table is full, unless reserve() made room beforehand.
+
+  std::pair<iterator, bool> insert(const value_type& val);
+  std::pair<iterator, bool> insert(value_type&& val);
+
+  template <class InputIterator>
+  void insert(InputIterator first, InputIterator last);
+
+  template <class... Args>
+  std::pair<iterator, bool> emplace(Args&&... args);
+
+  // --------------------------------------------------------------------------
+  // Erase operations.
+  //
+  // Erasing never invalidates iterators or references to other elements, so
+  // that elements can be erased while iterating.
+
+  // Returns the iterator following |position|.
+  iterator erase(iterator position);
+  iterator erase(const_iterator position);
+  iterator erase(const_iterator first, const_iterator last);
+  template <class K = key_type>
+  size_type erase(const key_arg<K>& key);
+
+  // --------------------------------------------------------------------------
+  // Search operations.
+
+  template <class K = key_type>
+  size_type count(const key_arg<K>& key) const;
+
+  template <class K = key_type>
+  iterator find(const key_arg<K>& key);
+
+  template <class K = key_type>
+  const_iterator find(const key_arg<K>& key) const;
+
+  // --------------------------------------------------------------------------
+  // Observers.
+
+  hasher hash_function() const { return hash_; }
+  key_equal key_eq() const { return key_equal_; }
+
+  // --------------------------------------------------------------------------
+  // General operations.
+
+  void swap(flat_hash_table& other) noexcept;
+
+  // Tables are equal if they contain equal elements, in any order.
+  friend bool operator==(const flat_hash_table& lhs,
+                         const flat_hash_table& rhs) {
+    if (lhs.size() != rhs.size())
+      return false;
+    for (const value_type& val : lhs) {
+      const_iterator found = rhs.find(GetKeyFromValue()(val));
+      if (found == rhs.end() || !(*found == val))
+        return false;
+    }
+    return true;
+  }
+
+  friend bool operator!=(const flat_hash_table& lhs,
+                         const flat_hash_table& rhs) {
+    return !(lhs == rhs);
+  }
+
+ protected:
+  // Returns the slot of the element with |key| if there is one. Otherwise,
+  // marks a slot as full, rehashing if needed, and returns it: the caller
+  // must then construct an element with |key| in it. The second value is
+  // true in the latter case.
+  template <class K>
+  std::pair<size_t, bool> FindOrPrepareInsert(const K& key);
+
+  // Returns the slot of the element with |key|, or |capacity_| if there is
+  // none.
+  template <class K>
+  size_t FindIndex(const K& key) const;
+
+  value_type* slot(size_t index) { return slots_ + index; }
+
+  iterator iterator_at(size_t index) {
+    return iterator(ctrl_ + index, slots_ + index);
+  }
+
+ private:
+  static size_t H1(size_t mixed_hash, const int8_t* ctrl) {
+    // Salting with the address of the control bytes spreads the elements of
+    // tables of the same size differently, so that inserting the elements of
+    // a table into another one in iteration order doesn't cluster them.
+    return (mixed_hash >> 7) ^ (reinterpret_cast<uintptr_t>(ctrl) >> 12);
+  }
+  static int8_t H2(size_t mixed_hash) {
+    return static_cast<int8_t>(mixed_hash & 0x7F);
+  }
+
+  // Returns the number of elements that a table with |capacity| slots can hold
+  // before growing.
+  static size_t CapacityToGrowth(size_t capacity) {
+    // With 8-wide groups, a table of 7 slots is probed in one group that
+    // contains all slots: one of them must stay empty to stop probing.
+    if (FlatHashGroup::kWidth == 8 && capacity == 7)
+      return 6;
+    return capacity - capacity / 8;
+  }
+
+  // Returns the smallest valid capacity that can hold |size| elements.
+  static size_t SizeToCapacity(size_t size) {
+    if (FlatHashGroup::kWidth == 8 && size == 7)
+      return 15;
+    const size_t min_capacity = size ? size + (size - 1) / 7 : 1;
+    return SIZE_MAX >> bits::CountLeadingZeroBits(min_capacity);
+  }
+
+  size_t MixedHash(const value_type& val) const {
+    return FlatHashMix(hash_(GetKeyFromValue()(val)));
+  }
+
+  // Returns the first empty or deleted slot in the probe sequence for
+  // |mixed_hash|.
+  size_t FindFirstNonFull(size_t mixed_hash) const;
+
+  // Sets the control byte of a slot and of its copy after the sentinel.
+  void SetCtrl(size_t index, int8_t ctrl);
+
+  // Allocates and initializes the slots for |capacity|, and rehashes the
+  // elements into them.
+  void Resize(size_t capacity);
+
+  // Makes room for one more element, by reclaiming deleted slots or by
+  // growing the table.
+  void RehashForInsert();
+
+  // Destroys the elements and frees the slots.
+  void DestroySlots();
+
+  int8_t* ctrl_ = FlatHashEmptyGroup();
+  value_type* slots_ = nullptr;
+  size_t size_ = 0;
+  size_t capacity_ = 0;
+
+  // Number of elements that can be inserted before the table must grow.
+  // Deleted slots don't count.
+  size_t growth_left_ = 0;
+
+  Hash hash_;
+  KeyEqual key_equal_;
+};
+
+// ----------------------------------------------------------------------------
+// Lifetime.
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class KE>
+template <class InputIterator>
+flat_hash_table<Key, Value, GetKeyFromValue, Hash, KE>::flat_hash_table(
+    InputIterator first,
+    InputIterator last) {
+  insert(first, last);
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class KE>
+flat_hash_table<Key, Value, GetKeyFromValue, Hash, KE>::flat_hash_table(
+    std::initializer_list<value_type> ilist)
+    : flat_hash_table(std::begin(ilist), std::end(ilist)) {}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class KE>
+flat_hash_table<Key, Value, GetKeyFromValue, Hash, KE>::flat_hash_table(
+    const flat_hash_table& other)
+    : hash_(other.hash_), key_equal_(other.key_equal_) {
+  reserve(other.size());
+  // Elements of |other| are unique, so there's no need to look them up.
+  for (const value_type& val : other) {
+    const size_t mixed_hash = MixedHash(val);
+    const size_t index = FindFirstNonFull(mixed_hash);
+    SetCtrl(index, H2(mixed_hash));
+    new (slots_ + index) value_type(val);
+  }
+  size_ = other.size();
+  growth_left_ -= other.size();
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class KE>
+flat_hash_table<Key, Value, GetKeyFromValue, Hash, KE>::flat_hash_table(
+    flat_hash_table&& other) noexcept
+    : ctrl_(other.ctrl_),
+      slots_(other.slots_),
+      size_(other.size_),
+      capacity_(other.capacity_),
+      growth_left_(other.growth_left_),
+      hash_(std::move(other.hash_)),
+      key_equal_(std::move(other.key_equal_)) {
+  other.ctrl_ = FlatHashEmptyGroup();
+  other.slots_ = nullptr;
+  other.size_ = 0;
+  other.capacity_ = 0;
+  other.growth_left_ = 0;
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class KE>
+flat_hash_table<Key, Value, GetKeyFromValue, Hash, KE>::~flat_hash_table() {
+  DestroySlots();
+}
+
+// ----------------------------------------------------------------------------
+// Assignments.
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class KE>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, KE>::operator=(
+    const flat_hash_table& other) -> flat_hash_table& {
+  if (this != &other) {
+    flat_hash_table copy(other);
+    swap(copy);
+  }
+  return *this;
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class KE>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, KE>::operator=(
+    flat_hash_table&& other) noexcept -> flat_hash_table& {
+  flat_hash_table moved(std::move(other));
+  swap(moved);
+  return *this;
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class KE>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, KE>::operator=(
+    std::initializer_list<value_type> ilist) -> flat_hash_table& {
+  clear();
+  insert(std::begin(ilist), std::end(ilist));
+  return *this;
+}
+
+// ----------------------------------------------------------------------------
+// Memory management.
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class KE>
+void flat_hash_table<Key, Value, GetKeyFromValue, Hash, KE>::reserve(
+    size_type new_size) {
+  if (new_size > size_ + growth_left_)
+    Resize(SizeToCapacity(new_size));
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class KE>
+void flat_hash_table<Key, Value, GetKeyFromValue, Hash, KE>::shrink_to_fit() {
+  if (empty()) {
+    DestroySlots();
+    ctrl_ = FlatHashEmptyGroup();
+    slots_ = nullptr;
+    capacity_ = 0;
+    growth_left_ = 0;
+    return;
+  }
+  const size_t capacity = SizeToCapacity(size_);
+  if (capacity < capacity_)
+    Resize(capacity);
+}
+
+// ----------------------------------------------------------------------------
+// Size management.
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class KE>
+void flat_hash_table<Key, Value, GetKeyFromValue, Hash, KE>::clear() {
+  if (!capacity_)
+    return;
+  for (size_t i = 0; i != capacity_; ++i) {
+    if (FlatHashIsFull(ctrl_[i]))
+      slots_[i].~value_type();
+  }
+  memset(ctrl_, kFlatHashEmpty, capacity_ + FlatHashGroup::kWidth);
+  ctrl_[capacity_] = kFlatHashSentinel;
+  size_ = 0;
+  growth_left_ = CapacityToGrowth(capacity_);
+}
+
+// ----------------------------------------------------------------------------
+// Insert operations.
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class KE>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, KE>::insert(
+    const value_type& val) -> std::pair<iterator, bool> {
+  std::pair<size_t, bool> result = FindOrPrepareInsert(GetKeyFromValue()(val));
+  if (result.second)
+    new (slots_ + result.first) value_type(val);
+  return {iterator_at(result.first), result.second};
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class KE>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, KE>::insert(
+    value_type&& val) -> std::pair<iterator, bool> {
+  std::pair<size_t, bool> result = FindOrPrepareInsert(GetKeyFromValue()(val));
+  if (result.second)
+    new (slots_ + result.first) value_type(std::move(val));
+  return {iterator_at(result.first), result.second};
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class KE>
+template <class InputIterator>
+void flat_hash_table<Key, Value, GetKeyFromValue, Hash, KE>::insert(
+    InputIterator first,
+    InputIterator last) {
+  if (is_multipass<InputIterator>())
+    reserve(size_ + static_cast<size_t>(std::distance(first, last)));
+  for (; first != last; ++first)
+    insert(*first);
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class KE>
+template <class... Args>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, KE>::emplace(
+    Args&&... args) -> std::pair<iterator, bool> {
+  return insert(value_type(std::forward<Args>(args)...));
+}
+
+// ----------------------------------------------------------------------------
+// Erase operations.
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class KE>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, KE>::erase(
+    iterator position) -> iterator {
+  return erase(const_iterator(position));
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class KE>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, KE>::erase(
+    const_iterator position) -> iterator {
+  const size_t index = static_cast<size_t>(position.ctrl_ - ctrl_);
+  DCHECK_LT(index, capacity_);
+  DCHECK(FlatHashIsFull(ctrl_[index]));
+  slots_[index].~value_type();
+  --size_;
+
+  // If no group that contains |index| was ever full, no probe ever continued
+  // past |index|, and the slot can be marked empty again.
+  const size_t index_before = (index - FlatHashGroup::kWidth) & capacity_;
+  const auto empty_after = FlatHashGroup(ctrl_ + index).MatchEmpty();
+  const auto empty_before = FlatHashGroup(ctrl_ + index_before).MatchEmpty();
+  const bool was_never_full =
+      empty_before && empty_after &&
+      empty_after.LowestBitSet() + empty_before.LeadingZeros() <
+          FlatHashGroup::kWidth;
+  SetCtrl(index, was_never_full ? kFlatHashEmpty : kFlatHashDeleted);
+  if (was_never_full)
+    ++growth_left_;
+
+  return iterator_at(index);
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class KE>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, KE>::erase(
+    const_iterator first,
+    const_iterator last) -> iterator {
+  while (first != last)
+    first = erase(first);
+  return iterator_at(static_cast<size_t>(last.ctrl_ - ctrl_));
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class KE>
+template <class K>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, KE>::erase(
+    const key_arg<K>& key) -> size_type {
+  const size_t index = FindIndex(key);
+  if (index == capacity_)
+    return 0;
+  erase(iterator_at(index));
+  return 1;
+}
+
+// ----------------------------------------------------------------------------
+// Search operations.
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class KE>
+template <class K>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, KE>::count(
+    const key_arg<K>& key) const -> size_type {
+  return FindIndex(key) == capacity_ ? 0 : 1;
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class KE>
+template <class K>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, KE>::find(
+    const key_arg<K>& key) -> iterator {
+  return iterator_at(FindIndex(key));
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class KE>
+template <class K>
+auto flat_hash_table<Key, Value, GetKeyFromValue, Hash, KE>::find(
+    const key_arg<K>& key) const -> const_iterator {
+  const size_t index = FindIndex(key);
+  return const_iterator(ctrl_ + index, slots_ + index);
+}
+
+// ----------------------------------------------------------------------------
+// General operations.
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class KE>
+void flat_hash_table<Key, Value, GetKeyFromValue, Hash, KE>::swap(
+    flat_hash_table& other) noexcept {
+  std::swap(ctrl_, other.ctrl_);
+  std::swap(slots_, other.slots_);
+  std::swap(size_, other.size_);
+  std::swap(capacity_, other.capacity_);
+  std::swap(growth_left_, other.growth_left_);
+  std::swap(hash_, other.hash_);
+  std::swap(key_equal_, other.key_equal_);
+}
+
+// ----------------------------------------------------------------------------
+// Protected and private methods.
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class KE>
+template <class K>
+std::pair<size_t, bool>
+flat_hash_table<Key, Value, GetKeyFromValue, Hash, KE>::FindOrPrepareInsert(
+    const K& key) {
+  const size_t mixed_hash = FlatHashMix(hash_(key));
+  FlatHashProbeSeq seq(H1(mixed_hash, ctrl_), capacity_);
+  while (true) {
+    FlatHashGroup group(ctrl_ + seq.offset());
+    for (auto match = group.Match(H2(mixed_hash)); match;
+         match.ClearLowestBit()) {
+      const size_t index = seq.offset(match.LowestBitSet());
+      if (key_equal_(GetKeyFromValue()(slots_[index]), key))
+        return {index, false};
+    }
+    if (group.MatchEmpty())
+      break;
+    seq.next();
+  }
+
+  size_t index = FindFirstNonFull(mixed_hash);
+  if (UNLIKELY(growth_left_ == 0 && ctrl_[index] != kFlatHashDeleted)) {
+    RehashForInsert();
+    index = FindFirstNonFull(mixed_hash);
+  }
+  ++size_;
+  if (ctrl_[index] == kFlatHashEmpty)
+    --growth_left_;
+  SetCtrl(index, H2(mixed_hash));
+  return {index, true};
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class KE>
+template <class K>
+size_t flat_hash_table<Key, Value, GetKeyFromValue, Hash, KE>::FindIndex(
+    const K& key) const {
+  const size_t mixed_hash = FlatHashMix(hash_(key));
+  FlatHashProbeSeq seq(H1(mixed_hash, ctrl_), capacity_);
+  while (true) {
+    FlatHashGroup group(ctrl_ + seq.offset());
+    for (auto match = group.Match(H2(mixed_hash)); match;
+         match.ClearLowestBit()) {
+      const size_t index = seq.offset(match.LowestBitSet());
+      if (key_equal_(GetKeyFromValue()(slots_[index]), key))
+        return index;
+    }
+    if (group.MatchEmpty())
+      return capacity_;
+    seq.next();
+  }
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class KE>
+size_t
+flat_hash_table<Key, Value, GetKeyFromValue, Hash, KE>::FindFirstNonFull(
+    size_t mixed_hash) const {
+  FlatHashProbeSeq seq(H1(mixed_hash, ctrl_), capacity_);
+  while (true) {
+    const auto mask = FlatHashGroup(ctrl_ + seq.offset()).MatchEmptyOrDeleted();
+    if (mask)
+      return seq.offset(mask.LowestBitSet());
+    seq.next();
+  }
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class KE>
+void flat_hash_table<Key, Value, GetKeyFromValue, Hash, KE>::SetCtrl(
+    size_t index,
+    int8_t ctrl) {
+  DCHECK_LT(index, capacity_);
+  constexpr size_t kNumClonedBytes = FlatHashGroup::kWidth - 1;
+  ctrl_[index] = ctrl;
+  ctrl_[((index - kNumClonedBytes) & capacity_) +
+        (kNumClonedBytes & capacity_)] = ctrl;
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class KE>
+void flat_hash_table<Key, Value, GetKeyFromValue, Hash, KE>::Resize(
+    size_t capacity) {
+  static_assert(alignof(value_type) <= alignof(max_align_t),
+                "over-aligned types are not supported");
+  DCHECK_GE(CapacityToGrowth(capacity), size_);
+
+  // The control bytes and the slots share one allocation.
+  const size_t num_ctrl_bytes = capacity + FlatHashGroup::kWidth;
+  const size_t slots_offset =
+      (num_ctrl_bytes + alignof(value_type) - 1) & ~(alignof(value_type) - 1);
+  char* memory = static_cast<char*>(
+      malloc(CheckAdd(slots_offset, CheckMul(capacity, sizeof(value_type)))
+                 .ValueOrDie()));
+  CHECK(memory);
+
+  int8_t* old_ctrl = ctrl_;
+  value_type* old_slots = slots_;
+  const size_t old_capacity = capacity_;
+
+  ctrl_ = reinterpret_cast<int8_t*>(memory);
+  slots_ = reinterpret_cast<value_type*>(memory + slots_offset);
+  capacity_ = capacity;
+  growth_left_ = CapacityToGrowth(capacity) - size_;
+  memset(ctrl_, kFlatHashEmpty, num_ctrl_bytes);
+  ctrl_[capacity_] = kFlatHashSentinel;
+
+  for (size_t i = 0; i != old_capacity; ++i) {
+    if (!FlatHashIsFull(old_ctrl[i]))
+      continue;
+    const size_t mixed_hash = MixedHash(old_slots[i]);
+    const size_t index = FindFirstNonFull(mixed_hash);
+    SetCtrl(index, H2(mixed_hash));
+    new (slots_ + index) value_type(std::move(old_slots[i]));
+    old_slots[i].~value_type();
+  }
+
+  if (old_capacity)
+    free(old_ctrl);
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class KE>
+void flat_hash_table<Key, Value, GetKeyFromValue, Hash, KE>::RehashForInsert() {
+  if (capacity_ == 0) {
+    Resize(SizeToCapacity(1));
+  } else if (capacity_ > FlatHashGroup::kWidth &&
+             size_ * 32 <= capacity_ * 25) {
+    // Enough of the used slots are deleted ones: reclaim them without
+    // growing, which also makes |size_| * 8 / 7 slots available.
+    Resize(capacity_);
+  } else {
+    Resize(capacity_ * 2 + 1);
+  }
+}
+
+template <class Key, class Value, class GetKeyFromValue, class Hash, class KE>
+void flat_hash_table<Key, Value, GetKeyFromValue, Hash, KE>::DestroySlots() {
+  if (!capacity_)
+    return;
+  for (size_t i = 0; i != capacity_; ++i) {
+    if (FlatHashIsFull(ctrl_[i]))
+      slots_[i].~value_type();
+  }
+  free(ctrl_);
+}
+
+}  // namespace internal
+
+}  // namespace base
+
+#endif  // BASE_CONTAINERS_FLAT_HASH_TABLE_H_
@@ -46,7 +46,9 @@ CPU::CPU()
     has_popcnt_(false),
     has_avx_(false),
     has_avx2_(false),
+    has_fma3_(false),
     has_aesni_(false),
+    has_sha_(false),
     has_non_stop_time_stamp_counter_(false),
     cpu_vendor_("unknown") {
   Initialize();
@@ -193,6 +195,9 @@ void CPU::Initialize() {
         (_xgetbv(0) & 6) == 6 /* XSAVE enabled by kernel */;
     has_aesni_ = (cpu_info[2] & 0x02000000) != 0;
     has_avx2_ = has_avx_ && (cpu_info7[1] & 0x00000020) != 0;
+    has_sha_ = (cpu_info7[1] & 0x20000000) != 0;
+    // FMA3 operates on the AVX registers, so it is only usable with AVX.
+    has_fma3_ = has_avx_ && (cpu_info[2] & 0x00001000) != 0;
   }
 
   // Get the brand string of the cpu.
@@ -48,7 +48,9 @@ class BASE_EXPORT CPU final {
   bool has_popcnt() const { return has_popcnt_; }
   bool has_avx() const { return has_avx_; }
   bool has_avx2() const { return has_avx2_; }
+  bool has_fma3() const { return has_fma3_; }
   bool has_aesni() const { return has_aesni_; }
+  bool has_sha() const { return has_sha_; }
   bool has_non_stop_time_stamp_counter() const {
     return has_non_stop_time_stamp_counter_;
   }
@@ -77,7 +79,9 @@ class BASE_EXPORT CPU final {
   bool has_popcnt_;
   bool has_avx_;
   bool has_avx2_;
+  bool has_fma3_;
   bool has_aesni_;
+  bool has_sha_;
   bool has_non_stop_time_stamp_counter_;
   std::string cpu_vendor_;
   std::string cpu_brand_;
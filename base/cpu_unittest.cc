@@ -72,6 +72,16 @@ TEST(CPU, RunExtendedInstructions) {
     __asm__ __volatile__("vpunpcklbw %%ymm0, %%ymm0, %%ymm0\n" : : : "xmm0");
   }
 
+  if (cpu.has_fma3()) {
+    // Execute an FMA 3 instruction.
+    __asm__ __volatile__("vfmadd132ps %%xmm0, %%xmm0, %%xmm0\n" : : : "xmm0");
+  }
+
+  if (cpu.has_sha()) {
+    // Execute a SHA instruction.
+    __asm__ __volatile__("sha1nexte %%xmm0, %%xmm0\n" : : : "xmm0");
+  }
+
 // Visual C 32 bit and ClangCL 32/64 bit test.
 #elif defined(COMPILER_MSVC) && (defined(ARCH_CPU_32_BITS) || \
       (defined(ARCH_CPU_64_BITS) && defined(__clang__)))
@@ -121,6 +131,11 @@ TEST(CPU, RunExtendedInstructions) {
     // Execute an AVX 2 instruction.
     __asm vpunpcklbw ymm0, ymm0, ymm0
   }
+
+  if (cpu.has_fma3()) {
+    // Execute an FMA 3 instruction.
+    __asm vfmadd132ps xmm0, xmm0, xmm0
+  }
 #endif  // _MSC_VER >= 1700
 #endif  // defined(COMPILER_GCC)
 #endif  // defined(ARCH_CPU_X86_FAMILY)
@@ -0,0 +1,677 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/files/file_io_uring_linux.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <string>
+#include <utility>
+
+#include "base/atomicops.h"
+#include "base/bind.h"
+#include "base/files/scoped_file.h"
+#include "base/location.h"
+#include "base/logging.h"
+#include "base/macros.h"
+#include "base/memory/ptr_util.h"
+#include "base/posix/eintr_wrapper.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "base/threading/thread_restrictions.h"
+#include "base/time/time.h"
+#include "build/build_config.h"
+
+// The io_uring system calls have the same numbers on all architectures.
+#if !defined(__NR_io_uring_setup)
+#define __NR_io_uring_setup 425
+#endif
+#if !defined(__NR_io_uring_enter)
+#define __NR_io_uring_enter 426
+#endif
+#if !defined(__NR_io_uring_register)
+#define __NR_io_uring_register 427
+#endif
+
+namespace base {
+
+namespace {
+
+// The io_uring ABI, from <linux/io_uring.h>, which older sysroots don't have.
+
+struct IOUringSubmissionRingOffsets {
+  uint32_t head;
+  uint32_t tail;
+  uint32_t ring_mask;
+  uint32_t ring_entries;
+  uint32_t flags;
+  uint32_t dropped;
+  uint32_t array;
+  uint32_t resv1;
+  uint64_t resv2;
+};
+
+struct IOUringCompletionRingOffsets {
+  uint32_t head;
+  uint32_t tail;
+  uint32_t ring_mask;
+  uint32_t ring_entries;
+  uint32_t overflow;
+  uint32_t cqes;
+  uint64_t resv[2];
+};
+
+struct IOUringParams {
+  uint32_t sq_entries;
+  uint32_t cq_entries;
+  uint32_t flags;
+  uint32_t sq_thread_cpu;
+  uint32_t sq_thread_idle;
+  uint32_t resv[5];
+  IOUringSubmissionRingOffsets sq_off;
+  IOUringCompletionRingOffsets cq_off;
+};
+
+struct IOUringSubmissionEntry {
+  uint8_t opcode;
+  uint8_t flags;
+  uint16_t ioprio;
+  int32_t fd;
+  uint64_t off;
+  uint64_t addr;
+  uint32_t len;
+  uint32_t op_flags;  // rw_flags, fsync_flags, open_flags...
+  uint64_t user_data;
+  uint64_t pad[3];
+};
+
+struct IOUringCompletionEntry {
+  uint64_t user_data;
+  int32_t res;
+  uint32_t flags;
+};
+
+struct IOUringProbeOp {
+  uint8_t op;
+  uint8_t resv;
+  uint16_t flags;
+  uint32_t resv2;
+};
+
+struct IOUringProbe {
+  uint8_t last_op;
+  uint8_t ops_len;
+  uint16_t resv;
+  uint32_t resv2[3];
+  IOUringProbeOp ops[];
+};
+
+static_assert(sizeof(IOUringParams) == 120, "Unexpected io_uring_params size");
+static_assert(sizeof(IOUringSubmissionEntry) == 64,
+              "Unexpected io_uring_sqe size");
+static_assert(sizeof(IOUringCompletionEntry) == 16,
+              "Unexpected io_uring_cqe size");
+static_assert(sizeof(IOUringProbe) == 16, "Unexpected io_uring_probe size");
+
+constexpr uint8_t kIOUringOpFsync = 3;
+constexpr uint8_t kIOUringOpOpenat = 18;
+constexpr uint8_t kIOUringOpRead = 22;
+constexpr uint8_t kIOUringOpWrite = 23;
+
+constexpr uint32_t kIOUringFsyncDatasync = 1;
+constexpr uint32_t kIOUringEnterGetEvents = 1;
+constexpr unsigned kIOUringRegisterEventFD = 4;
+constexpr unsigned kIOUringRegisterProbe = 8;
+constexpr uint16_t kIOUringOpSupported = 1;
+
+constexpr off_t kIOUringOffSubmissionRing = 0;
+constexpr off_t kIOUringOffCompletionRing = 0x8000000;
+constexpr off_t kIOUringOffSubmissionEntries = 0x10000000;
+
+// How long to wait before submitting again when the kernel is short of
+// resources and no completion will trigger it.
+constexpr TimeDelta kSubmitRetryDelay = TimeDelta::FromMilliseconds(10);
+
+uint32_t LoadAcquire(const volatile uint32_t* value) {
+  return static_cast<uint32_t>(subtle::Acquire_Load(
+      reinterpret_cast<const volatile subtle::Atomic32*>(value)));
+}
+
+void StoreRelease(volatile uint32_t* value, uint32_t new_value) {
+  subtle::Release_Store(reinterpret_cast<volatile subtle::Atomic32*>(value),
+                        static_cast<subtle::Atomic32>(new_value));
+}
+
+// Maps |file_flags| to the flags of open(2), as File::DoInitialize() does.
+// Returns false if |file_flags| can't be honored by a single open(2).
+bool FileFlagsToOpenFlags(uint32_t file_flags, int* open_flags) {
+  constexpr uint32_t kSupportedFlags =
+      File::FLAG_OPEN | File::FLAG_CREATE | File::FLAG_OPEN_ALWAYS |
+      File::FLAG_CREATE_ALWAYS | File::FLAG_OPEN_TRUNCATED | File::FLAG_READ |
+      File::FLAG_WRITE | File::FLAG_APPEND;
+  if (file_flags & ~kSupportedFlags)
+    return false;
+
+  int flags = 0;
+  if (file_flags & File::FLAG_CREATE) {
+    flags = O_CREAT | O_EXCL;
+  } else if (file_flags & File::FLAG_CREATE_ALWAYS) {
+    DCHECK(file_flags & File::FLAG_WRITE);
+    flags = O_CREAT | O_TRUNC;
+  } else if (file_flags & File::FLAG_OPEN_TRUNCATED) {
+    DCHECK(file_flags & File::FLAG_WRITE);
+    flags = O_TRUNC;
+  } else if (file_flags & File::FLAG_OPEN_ALWAYS) {
+    flags = O_CREAT;
+  } else if (!(file_flags & File::FLAG_OPEN)) {
+    return false;
+  }
+
+  if (file_flags & File::FLAG_WRITE && file_flags & File::FLAG_READ)
+    flags |= O_RDWR;
+  else if (file_flags & File::FLAG_WRITE)
+    flags |= O_WRONLY;
+
+  if (file_flags & File::FLAG_APPEND && file_flags & File::FLAG_READ)
+    flags |= O_APPEND | O_RDWR;
+  else if (file_flags & File::FLAG_APPEND)
+    flags |= O_APPEND | O_WRONLY;
+
+  *open_flags = flags;
+  return true;
+}
+
+}  // namespace
+
+// The rings shared with the kernel. See io_uring(7).
+class FileIOUring::Ring {
+ public:
+  ~Ring();
+
+  // Returns null if io_uring, or one of the operations FileIOUring uses, isn't
+  // supported.
+  static std::unique_ptr<Ring> Create(uint32_t queue_depth);
+
+  // Readable when completions were added to the ring.
+  int event_fd() const { return event_fd_.get(); }
+
+  // The number of operations whose completions fit in the ring.
+  uint32_t completion_capacity() const { return cq_entries_; }
+
+  // Returns a zeroed entry to add to the submission queue, or null if the
+  // queue is full. The entry is added by PublishSubmissionEntries().
+  IOUringSubmissionEntry* GetSubmissionEntry();
+
+  // Makes the entries returned by GetSubmissionEntry() visible to the kernel.
+  void PublishSubmissionEntries();
+
+  // Removes the last |count| published entries, which the kernel mustn't have
+  // consumed yet.
+  void UnpublishSubmissionEntries(uint32_t count);
+
+  // Submits the published entries which the kernel hasn't consumed and, if
+  // |min_complete| isn't 0, waits for that many completions. Returns the
+  // number of entries consumed, or a negated errno.
+  int Enter(uint32_t min_complete);
+
+  // Pops the oldest completion into |user_data| and |result|. Returns false if
+  // there are none.
+  bool PopCompletion(uint64_t* user_data, int32_t* result);
+
+ private:
+  Ring() = default;
+
+  ScopedFD ring_fd_;
+  ScopedFD event_fd_;
+
+  void* sq_ring_ = MAP_FAILED;
+  size_t sq_ring_size_ = 0;
+  void* cq_ring_ = MAP_FAILED;
+  size_t cq_ring_size_ = 0;
+  IOUringSubmissionEntry* sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+
+  volatile uint32_t* sq_head_ = nullptr;
+  volatile uint32_t* sq_tail_ = nullptr;
+  volatile uint32_t* sq_array_ = nullptr;
+  uint32_t sq_mask_ = 0;
+  uint32_t sq_entries_ = 0;
+
+  // The tail of the submission queue, including unpublished entries.
+  uint32_t sq_local_tail_ = 0;
+
+  volatile uint32_t* cq_head_ = nullptr;
+  volatile uint32_t* cq_tail_ = nullptr;
+  const IOUringCompletionEntry* cqes_ = nullptr;
+  uint32_t cq_mask_ = 0;
+  uint32_t cq_entries_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(Ring);
+};
+
+FileIOUring::Ring::~Ring() {
+  if (sqes_)
+    munmap(sqes_, sqes_size_);
+  if (cq_ring_ != MAP_FAILED)
+    munmap(cq_ring_, cq_ring_size_);
+  if (sq_ring_ != MAP_FAILED)
+    munmap(sq_ring_, sq_ring_size_);
+}
+
+// static
+std::unique_ptr<FileIOUring::Ring> FileIOUring::Ring::Create(
+    uint32_t queue_depth) {
+  std::unique_ptr<Ring> ring(new Ring);
+
+  IOUringParams params;
+  memset(&params, 0, sizeof(params));
+  ring->ring_fd_.reset(
+      static_cast<int>(syscall(__NR_io_uring_setup, queue_depth, &params)));
+  if (!ring->ring_fd_.is_valid()) {
+    DPLOG_IF(ERROR, errno != ENOSYS && errno != EPERM) << "io_uring_setup";
+    return nullptr;
+  }
+  const int ring_fd = ring->ring_fd_.get();
+
+  // Linux 5.6 added the probe, along with the read, write and openat
+  // operations.
+  constexpr unsigned kNumProbeOps = 256;
+  std::unique_ptr<char[]> probe_buffer(
+      new char[sizeof(IOUringProbe) + kNumProbeOps * sizeof(IOUringProbeOp)]());
+  IOUringProbe* probe = reinterpret_cast<IOUringProbe*>(probe_buffer.get());
+  if (syscall(__NR_io_uring_register, ring_fd, kIOUringRegisterProbe, probe,
+              kNumProbeOps) != 0) {
+    return nullptr;
+  }
+  for (uint8_t op :
+       {kIOUringOpFsync, kIOUringOpOpenat, kIOUringOpRead, kIOUringOpWrite}) {
+    if (op > probe->last_op || !(probe->ops[op].flags & kIOUringOpSupported))
+      return nullptr;
+  }
+
+  ring->sq_ring_size_ =
+      params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+  ring->sq_ring_ =
+      mmap(nullptr, ring->sq_ring_size_, PROT_READ | PROT_WRITE,
+           MAP_SHARED | MAP_POPULATE, ring_fd, kIOUringOffSubmissionRing);
+  ring->cq_ring_size_ =
+      params.cq_off.cqes + params.cq_entries * sizeof(IOUringCompletionEntry);
+  ring->cq_ring_ =
+      mmap(nullptr, ring->cq_ring_size_, PROT_READ | PROT_WRITE,
+           MAP_SHARED | MAP_POPULATE, ring_fd, kIOUringOffCompletionRing);
+  ring->sqes_size_ = params.sq_entries * sizeof(IOUringSubmissionEntry);
+  void* sqes =
+      mmap(nullptr, ring->sqes_size_, PROT_READ | PROT_WRITE,
+           MAP_SHARED | MAP_POPULATE, ring_fd, kIOUringOffSubmissionEntries);
+  if (ring->sq_ring_ == MAP_FAILED || ring->cq_ring_ == MAP_FAILED ||
+      sqes == MAP_FAILED) {
+    DPLOG(ERROR) << "mmap";
+    if (sqes != MAP_FAILED)
+      munmap(sqes, ring->sqes_size_);
+    return nullptr;
+  }
+  ring->sqes_ = static_cast<IOUringSubmissionEntry*>(sqes);
+
+  char* sq_ring = static_cast<char*>(ring->sq_ring_);
+  ring->sq_head_ = reinterpret_cast<uint32_t*>(sq_ring + params.sq_off.head);
+  ring->sq_tail_ = reinterpret_cast<uint32_t*>(sq_ring + params.sq_off.tail);
+  ring->sq_array_ = reinterpret_cast<uint32_t*>(sq_ring + params.sq_off.array);
+  ring->sq_mask_ =
+      *reinterpret_cast<uint32_t*>(sq_ring + params.sq_off.ring_mask);
+  ring->sq_entries_ = params.sq_entries;
+  ring->sq_local_tail_ = *ring->sq_tail_;
+
+  char* cq_ring = static_cast<char*>(ring->cq_ring_);
+  ring->cq_head_ = reinterpret_cast<uint32_t*>(cq_ring + params.cq_off.head);
+  ring->cq_tail_ = reinterpret_cast<uint32_t*>(cq_ring + params.cq_off.tail);
+  ring->cqes_ =
+      reinterpret_cast<IOUringCompletionEntry*>(cq_ring + params.cq_off.cqes);
+  ring->cq_mask_ =
+      *reinterpret_cast<uint32_t*>(cq_ring + params.cq_off.ring_mask);
+  ring->cq_entries_ = params.cq_entries;
+
+  ring->event_fd_.reset(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK));
+  if (!ring->event_fd_.is_valid()) {
+    DPLOG(ERROR) << "eventfd";
+    return nullptr;
+  }
+  const int event_fd = ring->event_fd_.get();
+  if (syscall(__NR_io_uring_register, ring_fd, kIOUringRegisterEventFD,
+              &event_fd, 1) != 0) {
+    DPLOG(ERROR) << "io_uring_register";
+    return nullptr;
+  }
+
+  return ring;
+}
+
+IOUringSubmissionEntry* FileIOUring::Ring::GetSubmissionEntry() {
+  if (sq_local_tail_ - LoadAcquire(sq_head_) >= sq_entries_)
+    return nullptr;
+  const uint32_t index = sq_local_tail_ & sq_mask_;
+  ++sq_local_tail_;
+  sq_array_[index] = index;
+  IOUringSubmissionEntry* entry = &sqes_[index];
+  memset(entry, 0, sizeof(*entry));
+  return entry;
+}
+
+void FileIOUring::Ring::PublishSubmissionEntries() {
+  StoreRelease(sq_tail_, sq_local_tail_);
+}
+
+void FileIOUring::Ring::UnpublishSubmissionEntries(uint32_t count) {
+  DCHECK_LE(count, sq_local_tail_ - LoadAcquire(sq_head_));
+  sq_local_tail_ -= count;
+  StoreRelease(sq_tail_, sq_local_tail_);
+}
+
+int FileIOUring::Ring::Enter(uint32_t min_complete) {
+  const uint32_t to_submit = *sq_tail_ - LoadAcquire(sq_head_);
+  const int result = static_cast<int>(HANDLE_EINTR(
+      syscall(__NR_io_uring_enter, ring_fd_.get(), to_submit, min_complete,
+              min_complete ? kIOUringEnterGetEvents : 0, nullptr, 0)));
+  return result < 0 ? -errno : result;
+}
+
+bool FileIOUring::Ring::PopCompletion(uint64_t* user_data, int32_t* result) {
+  const uint32_t head = *cq_head_;
+  if (head == LoadAcquire(cq_tail_))
+    return false;
+  const IOUringCompletionEntry& entry = cqes_[head & cq_mask_];
+  *user_data = entry.user_data;
+  *result = entry.res;
+  StoreRelease(cq_head_, head + 1);
+  return true;
+}
+
+struct FileIOUring::Operation {
+  enum Type {
+    OPEN,
+    READ,
+    WRITE,
+    FLUSH,
+  };
+
+  explicit Operation(Type type) : type(type) {}
+
+  // Fills |entry| to submit the operation.
+  void PrepareEntry(IOUringSubmissionEntry* entry) {
+    entry->user_data = reinterpret_cast<uintptr_t>(this);
+    entry->fd = file;
+    switch (type) {
+      case OPEN:
+        entry->opcode = kIOUringOpOpenat;
+        entry->fd = AT_FDCWD;
+        entry->addr = reinterpret_cast<uintptr_t>(path.c_str());
+        entry->len = mode;
+        entry->op_flags = open_flags;
+        break;
+      case READ:
+      case WRITE:
+        entry->opcode = type == READ ? kIOUringOpRead : kIOUringOpWrite;
+        entry->off = offset;
+        entry->addr = reinterpret_cast<uintptr_t>(buffer.get());
+        entry->len = size;
+        break;
+      case FLUSH:
+        entry->opcode = kIOUringOpFsync;
+        // Like File::Flush().
+        entry->op_flags = kIOUringFsyncDatasync;
+        break;
+    }
+  }
+
+  const Type type;
+  PlatformFile file = kInvalidPlatformFile;
+  int64_t offset = 0;
+
+  // For OPEN.
+  std::string path;
+  int open_flags = 0;
+  int mode = 0;
+
+  // For READ and WRITE.
+  std::unique_ptr<char[]> buffer;
+  int size = 0;
+
+  OpenCallback open_callback;
+  ReadCallback read_callback;
+  WriteCallback write_callback;
+  StatusCallback status_callback;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(Operation);
+};
+
+// static
+std::unique_ptr<FileIOUring> FileIOUring::Create(uint32_t queue_depth) {
+  DCHECK_GT(queue_depth, 0u);
+  std::unique_ptr<Ring> ring = Ring::Create(queue_depth);
+  if (!ring)
+    return nullptr;
+  return WrapUnique(new FileIOUring(std::move(ring)));
+}
+
+FileIOUring::FileIOUring(std::unique_ptr<Ring> ring)
+    : ring_(std::move(ring)), weak_factory_(this) {
+  completion_watcher_ = FileDescriptorWatcher::WatchReadable(
+      ring_->event_fd(), BindRepeating(&FileIOUring::OnOperationsCompleted,
+                                       Unretained(this)));
+}
+
+FileIOUring::~FileIOUring() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  completion_watcher_.reset();
+
+  // The kernel won't consume the operations it didn't yet.
+  ring_->UnpublishSubmissionEntries(unsubmitted_operations_.size());
+  for (Operation* operation : unsubmitted_operations_)
+    delete operation;
+  num_operations_in_ring_ -= unsubmitted_operations_.size();
+
+  if (num_operations_in_ring_)
+    AssertBlockingAllowed();
+  while (num_operations_in_ring_) {
+    uint64_t user_data;
+    int32_t result;
+    while (ring_->PopCompletion(&user_data, &result)) {
+      delete reinterpret_cast<Operation*>(user_data);
+      --num_operations_in_ring_;
+    }
+    if (num_operations_in_ring_ && ring_->Enter(num_operations_in_ring_) < 0) {
+      // Leak the remaining operations rather than freeing buffers the kernel
+      // may still write to.
+      DPLOG(ERROR) << "io_uring_enter";
+      break;
+    }
+  }
+}
+
+void FileIOUring::Open(const FilePath& path,
+                       uint32_t file_flags,
+                       OpenCallback callback) {
+  DCHECK(!callback.is_null());
+  auto operation = std::make_unique<Operation>(Operation::OPEN);
+  operation->path = path.value();
+  operation->mode = S_IRUSR | S_IWUSR;
+#if defined(OS_CHROMEOS)
+  operation->mode |= S_IRGRP | S_IROTH;
+#endif
+  operation->open_callback = std::move(callback);
+  if (!FileFlagsToOpenFlags(file_flags, &operation->open_flags)) {
+    NOTREACHED();
+    SequencedTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE, BindOnce(&FileIOUring::CompleteOperation,
+                            std::move(operation), -EOPNOTSUPP));
+    return;
+  }
+  AddOperation(std::move(operation));
+}
+
+void FileIOUring::Read(PlatformFile file,
+                       int64_t offset,
+                       int bytes_to_read,
+                       ReadCallback callback) {
+  DCHECK_GE(bytes_to_read, 0);
+  DCHECK(!callback.is_null());
+  auto operation = std::make_unique<Operation>(Operation::READ);
+  operation->file = file;
+  operation->offset = offset;
+  operation->buffer.reset(new char[bytes_to_read]);
+  operation->size = bytes_to_read;
+  operation->read_callback = std::move(callback);
+  AddOperation(std::move(operation));
+}
+
+void FileIOUring::Write(PlatformFile file,
+                        int64_t offset,
+                        const char* buffer,
+                        int bytes_to_write,
+                        WriteCallback callback) {
+  DCHECK_GE(bytes_to_write, 0);
+  auto operation = std::make_unique<Operation>(Operation::WRITE);
+  operation->file = file;
+  operation->offset = offset;
+  operation->buffer.reset(new char[bytes_to_write]);
+  memcpy(operation->buffer.get(), buffer, bytes_to_write);
+  operation->size = bytes_to_write;
+  operation->write_callback = std::move(callback);
+  AddOperation(std::move(operation));
+}
+
+void FileIOUring::Flush(PlatformFile file, StatusCallback callback) {
+  auto operation = std::make_unique<Operation>(Operation::FLUSH);
+  operation->file = file;
+  operation->status_callback = std::move(callback);
+  AddOperation(std::move(operation));
+}
+
+void FileIOUring::AddOperation(std::unique_ptr<Operation> operation) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  queued_operations_.push_back(std::move(operation));
+  if (submit_posted_)
+    return;
+  submit_posted_ = true;
+  SequencedTaskRunnerHandle::Get()->PostTask(
+      FROM_HERE, BindOnce(&FileIOUring::SubmitOperations,
+                          weak_factory_.GetWeakPtr()));
+}
+
+void FileIOUring::SubmitOperations() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  submit_posted_ = false;
+
+  // Bounding the operations in the ring to its completion capacity ensures
+  // that no completion is dropped.
+  while (!queued_operations_.empty() &&
+         num_operations_in_ring_ < ring_->completion_capacity()) {
+    IOUringSubmissionEntry* entry = ring_->GetSubmissionEntry();
+    if (!entry)
+      break;
+    Operation* operation = queued_operations_.front().release();
+    queued_operations_.pop_front();
+    operation->PrepareEntry(entry);
+    unsubmitted_operations_.push_back(operation);
+    ++num_operations_in_ring_;
+  }
+  if (unsubmitted_operations_.empty())
+    return;
+
+  ring_->PublishSubmissionEntries();
+  const int result = ring_->Enter(0);
+  if (result > 0) {
+    // Operations the kernel didn't consume are submitted again on the next
+    // completion.
+    unsubmitted_operations_.erase(unsubmitted_operations_.begin(),
+                                  unsubmitted_operations_.begin() + result);
+    return;
+  }
+
+  if (result == 0 || result == -EAGAIN || result == -EBUSY) {
+    // The kernel is short of resources. Try again on the next completion or,
+    // if no operation is in flight, after a delay.
+    if (num_operations_in_ring_ == unsubmitted_operations_.size() &&
+        !submit_posted_) {
+      submit_posted_ = true;
+      SequencedTaskRunnerHandle::Get()->PostDelayedTask(
+          FROM_HERE,
+          BindOnce(&FileIOUring::SubmitOperations, weak_factory_.GetWeakPtr()),
+          kSubmitRetryDelay);
+    }
+    return;
+  }
+
+  // Fail the operations the kernel refused.
+  errno = -result;
+  DPLOG(ERROR) << "io_uring_enter";
+  ring_->UnpublishSubmissionEntries(unsubmitted_operations_.size());
+  num_operations_in_ring_ -= unsubmitted_operations_.size();
+  for (Operation* operation : unsubmitted_operations_) {
+    SequencedTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE, BindOnce(&FileIOUring::CompleteOperation,
+                            WrapUnique(operation), result));
+  }
+  unsubmitted_operations_.clear();
+}
+
+void FileIOUring::OnOperationsCompleted() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  // Reset the event before reaping completions, so that none is missed.
+  uint64_t count;
+  ignore_result(HANDLE_EINTR(read(ring_->event_fd(), &count, sizeof(count))));
+
+  std::vector<std::pair<std::unique_ptr<Operation>, int>> completed_operations;
+  uint64_t user_data;
+  int32_t result;
+  while (ring_->PopCompletion(&user_data, &result)) {
+    completed_operations.emplace_back(
+        WrapUnique(reinterpret_cast<Operation*>(user_data)), result);
+    --num_operations_in_ring_;
+  }
+
+  // Keep the ring busy while the callbacks run.
+  SubmitOperations();
+
+  // The callbacks may delete |this|.
+  for (auto& completed_operation : completed_operations) {
+    CompleteOperation(std::move(completed_operation.first),
+                      completed_operation.second);
+  }
+}
+
+// static
+void FileIOUring::CompleteOperation(std::unique_ptr<Operation> operation,
+                                    int result) {
+  const File::Error error =
+      result < 0 ? File::OSErrorToFileError(-result) : File::FILE_OK;
+  switch (operation->type) {
+    case Operation::OPEN:
+      std::move(operation->open_callback)
+          .Run(result < 0 ? File(error) : File(result));
+      break;
+    case Operation::READ:
+      std::move(operation->read_callback)
+          .Run(error, result < 0 ? nullptr : operation->buffer.get(),
+               result < 0 ? 0 : result);
+      break;
+    case Operation::WRITE:
+      if (!operation->write_callback.is_null())
+        std::move(operation->write_callback).Run(error, result < 0 ? 0 : result);
+      break;
+    case Operation::FLUSH:
+      if (!operation->status_callback.is_null())
+        std::move(operation->status_callback).Run(error);
+      break;
+  }
+}
+
+}  // namespace base
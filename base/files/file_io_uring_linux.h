@@ -0,0 +1,132 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_FILES_FILE_IO_URING_LINUX_H_
+#define BASE_FILES_FILE_IO_URING_LINUX_H_
+
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "base/base_export.h"
+#include "base/callback.h"
+#include "base/containers/circular_deque.h"
+#include "base/files/file.h"
+#include "base/files/file_descriptor_watcher_posix.h"
+#include "base/files/file_path.h"
+#include "base/files/platform_file.h"
+#include "base/macros.h"
+#include "base/memory/weak_ptr.h"
+#include "base/sequence_checker.h"
+
+namespace base {
+
+// This class provides asynchronous file operations backed by an io_uring, the
+// asynchronous I/O interface of Linux 5.6 and later. Unlike FileProxy, which
+// blocks a thread of its TaskRunner for each operation, many operations can
+// be in flight at once without tying up any thread: the operations issued
+// during a task are submitted to the kernel together once it returns, and
+// their callbacks are invoked on the sequence of the FileIOUring when they
+// complete. Operations may complete in any order.
+//
+// A FileIOUring can be used on any sequence on which FileDescriptorWatcher is
+// available, i.e. on a MessageLoopForIO thread or in a TaskScheduler task.
+// All methods, ctor and dtor must be called on that sequence. Files passed to
+// the operations must stay open until the callbacks of these operations are
+// invoked.
+//
+// As with FileProxy, callbacks receive data and errors as base::File does,
+// but bytes read or written may be fewer than requested.
+class BASE_EXPORT FileIOUring {
+ public:
+  using OpenCallback = OnceCallback<void(File file)>;
+  using StatusCallback = OnceCallback<void(File::Error)>;
+  using ReadCallback =
+      OnceCallback<void(File::Error, const char* data, int bytes_read)>;
+  using WriteCallback = OnceCallback<void(File::Error, int bytes_written)>;
+
+  // Creates a FileIOUring which submits up to |queue_depth| operations to the
+  // kernel at once, later ones waiting for earlier ones to complete. Returns
+  // null if the kernel doesn't support io_uring or one of the operations
+  // below, or if the sandbox doesn't allow it, in which case FileProxy should
+  // be used instead.
+  static std::unique_ptr<FileIOUring> Create(uint32_t queue_depth);
+
+  // Operations in flight are abandoned without invoking their callbacks, but
+  // this blocks until the kernel is done with their buffers.
+  ~FileIOUring();
+
+  // Opens the file at |path| with |file_flags|, as File::Initialize() does
+  // except that File::FLAG_OPEN_ALWAYS doesn't report whether the file was
+  // created. Only the flags selecting how to open the file and the access
+  // mode are supported. It is invalid to pass a null callback.
+  void Open(const FilePath& path, uint32_t file_flags, OpenCallback callback);
+
+  // Reads up to |bytes_to_read| bytes at |offset| of |file|. It is invalid to
+  // pass a null callback. |data| is only valid during the callback.
+  void Read(PlatformFile file,
+            int64_t offset,
+            int bytes_to_read,
+            ReadCallback callback);
+
+  // Writes |bytes_to_write| bytes from |buffer| at |offset| of |file|.
+  // |buffer| is copied and needn't outlive the call. |callback| may be null.
+  void Write(PlatformFile file,
+             int64_t offset,
+             const char* buffer,
+             int bytes_to_write,
+             WriteCallback callback);
+
+  // Flushes |file| to disk, as File::Flush() does. |callback| may be null.
+  void Flush(PlatformFile file, StatusCallback callback);
+
+ private:
+  class Ring;
+  struct Operation;
+
+  explicit FileIOUring(std::unique_ptr<Ring> ring);
+
+  // Queues |operation| and makes sure that SubmitOperations() will run once
+  // the current task returns.
+  void AddOperation(std::unique_ptr<Operation> operation);
+
+  // Submits as many queued operations to the kernel as it can take.
+  void SubmitOperations();
+
+  // Invoked when the kernel signals completed operations.
+  void OnOperationsCompleted();
+
+  // Invokes the callback of |operation| with |result|, the number of bytes
+  // read or written or the file descriptor opened, or a negated errno.
+  static void CompleteOperation(std::unique_ptr<Operation> operation,
+                                int result);
+
+  const std::unique_ptr<Ring> ring_;
+
+  // Operations which haven't been added to the ring yet.
+  circular_deque<std::unique_ptr<Operation>> queued_operations_;
+
+  // Operations added to the ring, in order, that the kernel hasn't consumed.
+  std::vector<Operation*> unsubmitted_operations_;
+
+  // Number of operations added to the ring whose completion wasn't reaped.
+  // They are owned by the ring until then.
+  uint32_t num_operations_in_ring_ = 0;
+
+  // Whether a call to SubmitOperations() is posted.
+  bool submit_posted_ = false;
+
+  std::unique_ptr<FileDescriptorWatcher::Controller> completion_watcher_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+
+  WeakPtrFactory<FileIOUring> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(FileIOUring);
+};
+
+}  // namespace base
+
+#endif  // BASE_FILES_FILE_IO_URING_LINUX_H_
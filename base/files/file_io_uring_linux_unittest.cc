@@ -0,0 +1,184 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/files/file_io_uring_linux.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/barrier_closure.h"
+#include "base/bind.h"
+#include "base/files/file.h"
+#include "base/files/file_descriptor_watcher_posix.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/logging.h"
+#include "base/macros.h"
+#include "base/message_loop/message_loop.h"
+#include "base/run_loop.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+class FileIOUringTest : public testing::Test {
+ public:
+  FileIOUringTest() : file_descriptor_watcher_(&message_loop_) {}
+
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    io_uring_ = FileIOUring::Create(4);
+    if (!io_uring_)
+      LOG(WARNING) << "io_uring isn't supported, skipping test";
+  }
+
+ protected:
+  FilePath TestPath() const {
+    return temp_dir_.GetPath().AppendASCII("test");
+  }
+
+  // Opens TestPath() with |file_flags| through |io_uring_|.
+  File Open(uint32_t file_flags) {
+    File file;
+    RunLoop run_loop;
+    io_uring_->Open(TestPath(), file_flags,
+                    BindOnce(
+                        [](File* file, OnceClosure quit_closure,
+                           File opened_file) {
+                          *file = std::move(opened_file);
+                          std::move(quit_closure).Run();
+                        },
+                        &file, run_loop.QuitClosure()));
+    run_loop.Run();
+    return file;
+  }
+
+  MessageLoopForIO message_loop_;
+  FileDescriptorWatcher file_descriptor_watcher_;
+  ScopedTempDir temp_dir_;
+  std::unique_ptr<FileIOUring> io_uring_;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(FileIOUringTest);
+};
+
+TEST_F(FileIOUringTest, OpenWriteFlushRead) {
+  if (!io_uring_)
+    return;
+
+  File file = Open(File::FLAG_CREATE | File::FLAG_READ | File::FLAG_WRITE);
+  ASSERT_TRUE(file.IsValid());
+
+  // The write and the flush may complete in any order.
+  RunLoop write_loop;
+  RepeatingClosure barrier = BarrierClosure(2, write_loop.QuitClosure());
+  File::Error write_error = File::FILE_ERROR_FAILED;
+  int bytes_written = 0;
+  io_uring_->Write(file.GetPlatformFile(), 0, "foobar", 6,
+                   BindOnce(
+                       [](File::Error* error, int* bytes_written,
+                          RepeatingClosure barrier, File::Error result_error,
+                          int result_bytes) {
+                         *error = result_error;
+                         *bytes_written = result_bytes;
+                         barrier.Run();
+                       },
+                       &write_error, &bytes_written, barrier));
+  File::Error flush_error = File::FILE_ERROR_FAILED;
+  io_uring_->Flush(file.GetPlatformFile(),
+                   BindOnce(
+                       [](File::Error* error, RepeatingClosure barrier,
+                          File::Error result_error) {
+                         *error = result_error;
+                         barrier.Run();
+                       },
+                       &flush_error, barrier));
+  write_loop.Run();
+  EXPECT_EQ(File::FILE_OK, write_error);
+  EXPECT_EQ(6, bytes_written);
+  EXPECT_EQ(File::FILE_OK, flush_error);
+
+  RunLoop read_loop;
+  std::string data;
+  io_uring_->Read(file.GetPlatformFile(), 3, 10,
+                  BindOnce(
+                      [](std::string* data, OnceClosure quit_closure,
+                         File::Error error, const char* result_data,
+                         int bytes_read) {
+                        EXPECT_EQ(File::FILE_OK, error);
+                        data->assign(result_data, bytes_read);
+                        std::move(quit_closure).Run();
+                      },
+                      &data, read_loop.QuitClosure()));
+  read_loop.Run();
+  EXPECT_EQ("bar", data);
+}
+
+TEST_F(FileIOUringTest, OpenErrors) {
+  if (!io_uring_)
+    return;
+
+  File file = Open(File::FLAG_OPEN | File::FLAG_READ);
+  EXPECT_FALSE(file.IsValid());
+  EXPECT_EQ(File::FILE_ERROR_NOT_FOUND, file.error_details());
+
+  ASSERT_TRUE(WriteFile(TestPath(), "foo", 3));
+  file = Open(File::FLAG_CREATE | File::FLAG_WRITE);
+  EXPECT_FALSE(file.IsValid());
+  EXPECT_EQ(File::FILE_ERROR_EXISTS, file.error_details());
+}
+
+// More operations than the queue depth are issued at once.
+TEST_F(FileIOUringTest, ManyReads) {
+  if (!io_uring_)
+    return;
+
+  constexpr int kNumReads = 64;
+  std::string content;
+  for (int i = 0; i < kNumReads; ++i)
+    content.push_back('a' + i % 26);
+  ASSERT_EQ(kNumReads, WriteFile(TestPath(), content.data(), kNumReads));
+  File file(TestPath(), File::FLAG_OPEN | File::FLAG_READ);
+  ASSERT_TRUE(file.IsValid());
+
+  std::string data(kNumReads, ' ');
+  int num_reads_left = kNumReads;
+  RunLoop run_loop;
+  for (int i = 0; i < kNumReads; ++i) {
+    io_uring_->Read(file.GetPlatformFile(), i, 1,
+                    BindOnce(
+                        [](char* c, int* num_reads_left,
+                           OnceClosure quit_closure, File::Error error,
+                           const char* result_data, int bytes_read) {
+                          EXPECT_EQ(File::FILE_OK, error);
+                          ASSERT_EQ(1, bytes_read);
+                          *c = *result_data;
+                          if (!--*num_reads_left)
+                            std::move(quit_closure).Run();
+                        },
+                        &data[i], &num_reads_left, run_loop.QuitClosure()));
+  }
+  run_loop.Run();
+  EXPECT_EQ(content, data);
+}
+
+// Destroying the FileIOUring with operations in flight doesn't invoke their
+// callbacks.
+TEST_F(FileIOUringTest, DestroyWithPendingOperations) {
+  if (!io_uring_)
+    return;
+
+  File file(TestPath(), File::FLAG_CREATE | File::FLAG_WRITE);
+  ASSERT_TRUE(file.IsValid());
+  bool called = false;
+  io_uring_->Flush(file.GetPlatformFile(),
+                   BindOnce([](bool* called, File::Error) { *called = true; },
+                            &called));
+  io_uring_.reset();
+  RunLoop().RunUntilIdle();
+  EXPECT_FALSE(called);
+}
+
+}  // namespace base
@@ -0,0 +1,113 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/files/important_file_write_coordinator.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/callback_helpers.h"
+#include "base/critical_closure.h"
+#include "base/location.h"
+#include "base/logging.h"
+#include "base/sequenced_task_runner.h"
+
+namespace base {
+
+namespace {
+
+void RunBothClosures(const Closure& first, const Closure& second) {
+  if (!first.is_null())
+    first.Run();
+  if (!second.is_null())
+    second.Run();
+}
+
+void RunBothResultCallbacks(const Callback<void(bool success)>& first,
+                            const Callback<void(bool success)>& second,
+                            bool success) {
+  if (!first.is_null())
+    first.Run(success);
+  if (!second.is_null())
+    second.Run(success);
+}
+
+}  // namespace
+
+ImportantFileWriteCoordinator::ImportantFileWriteCoordinator(
+    scoped_refptr<SequencedTaskRunner> task_runner,
+    TimeDelta batch_interval)
+    : task_runner_(std::move(task_runner)), batch_interval_(batch_interval) {
+  DCHECK(task_runner_);
+}
+
+ImportantFileWriteCoordinator::~ImportantFileWriteCoordinator() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (HasPendingWrites())
+    CommitPendingWrites();
+}
+
+void ImportantFileWriteCoordinator::AddWrite(
+    ImportantFileWriter::BatchedWrite write) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  DCHECK(write.data);
+
+  // Batches are usually small, a linear search is fine.
+  for (ImportantFileWriter::BatchedWrite& pending_write : pending_writes_) {
+    if (pending_write.path != write.path)
+      continue;
+    pending_write.data = std::move(write.data);
+    if (!write.before_write_callback.is_null()) {
+      pending_write.before_write_callback =
+          Bind(&RunBothClosures, std::move(pending_write.before_write_callback),
+               std::move(write.before_write_callback));
+    }
+    if (!write.after_write_callback.is_null()) {
+      pending_write.after_write_callback =
+          Bind(&RunBothResultCallbacks,
+               std::move(pending_write.after_write_callback),
+               std::move(write.after_write_callback));
+    }
+    return;
+  }
+  pending_writes_.push_back(std::move(write));
+
+  if (!timer().IsRunning()) {
+    timer().Start(FROM_HERE, batch_interval_,
+                  Bind(&ImportantFileWriteCoordinator::CommitPendingWrites,
+                       Unretained(this)));
+  }
+}
+
+bool ImportantFileWriteCoordinator::HasPendingWrites() const {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  return !pending_writes_.empty();
+}
+
+void ImportantFileWriteCoordinator::CommitPendingWrites() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  timer().Stop();
+  if (pending_writes_.empty())
+    return;
+
+  Closure task = AdaptCallbackForRepeating(
+      BindOnce(&ImportantFileWriter::WriteFilesAtomically,
+               std::move(pending_writes_)));
+  pending_writes_.clear();
+
+  if (!task_runner_->PostTask(FROM_HERE, MakeCriticalClosure(task))) {
+    // Posting the task to background message loop is not expected
+    // to fail, but if it does, avoid losing data and just hit the disk
+    // on the current thread.
+    NOTREACHED();
+
+    task.Run();
+  }
+}
+
+void ImportantFileWriteCoordinator::SetTimerForTesting(Timer* timer_override) {
+  timer_override_ = timer_override;
+}
+
+}  // namespace base
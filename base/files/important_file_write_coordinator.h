@@ -0,0 +1,84 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_FILES_IMPORTANT_FILE_WRITE_COORDINATOR_H_
+#define BASE_FILES_IMPORTANT_FILE_WRITE_COORDINATOR_H_
+
+#include <vector>
+
+#include "base/base_export.h"
+#include "base/files/important_file_writer.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/sequence_checker.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+
+namespace base {
+
+class SequencedTaskRunner;
+
+// Batches the writes of several ImportantFileWriters, usually of different
+// files, so that they are done in a single task on the I/O sequence and their
+// files are flushed together (see ImportantFileWriter::WriteFilesAtomically()).
+// This saves syncs, and thus time and flash wear, when many files are saved at
+// once, for instance on shutdown. Each file is still written atomically.
+//
+// All methods, ctor and dtor must be called on the sequence of the writers.
+class BASE_EXPORT ImportantFileWriteCoordinator {
+ public:
+  // |task_runner| is the SequencedTaskRunner on which the writes are done. A
+  // batch is written |batch_interval| after its first write was added.
+  ImportantFileWriteCoordinator(scoped_refptr<SequencedTaskRunner> task_runner,
+                                TimeDelta batch_interval);
+
+  // Commits the pending writes, if any.
+  ~ImportantFileWriteCoordinator();
+
+  const scoped_refptr<SequencedTaskRunner>& task_runner() const {
+    return task_runner_;
+  }
+
+  TimeDelta batch_interval() const { return batch_interval_; }
+
+  // Adds |write| to the batch. If the batch already has a write of the same
+  // file, |write| replaces it, and the callbacks of both are invoked.
+  void AddWrite(ImportantFileWriter::BatchedWrite write);
+
+  // Returns true if there are writes which haven't been committed yet.
+  bool HasPendingWrites() const;
+
+  // Posts the writes of the batch to |task_runner_| without waiting for the
+  // end of the batch interval.
+  void CommitPendingWrites();
+
+  // Overrides the timer to use for scheduling commits with |timer_override|.
+  void SetTimerForTesting(Timer* timer_override);
+
+ private:
+  Timer& timer() { return timer_override_ ? *timer_override_ : timer_; }
+
+  // TaskRunner for the thread on which file I/O can be done.
+  const scoped_refptr<SequencedTaskRunner> task_runner_;
+
+  // Time delta after which a batch is committed.
+  const TimeDelta batch_interval_;
+
+  // Timer used to commit the batch after its first write.
+  OneShotTimer timer_;
+
+  // An override for |timer_| used for testing.
+  Timer* timer_override_ = nullptr;
+
+  // The writes of the batch, in the order they were first added.
+  std::vector<ImportantFileWriter::BatchedWrite> pending_writes_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+
+  DISALLOW_COPY_AND_ASSIGN(ImportantFileWriteCoordinator);
+};
+
+}  // namespace base
+
+#endif  // BASE_FILES_IMPORTANT_FILE_WRITE_COORDINATOR_H_
@@ -0,0 +1,174 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/files/important_file_write_coordinator.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/files/file_enumerator.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/important_file_writer.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/macros.h"
+#include "base/message_loop/message_loop.h"
+#include "base/run_loop.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "base/time/time.h"
+#include "base/timer/mock_timer.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+constexpr auto kBatchInterval = TimeDelta::FromSeconds(1);
+
+std::string GetFileContent(const FilePath& path) {
+  std::string content;
+  if (!ReadFileToString(path, &content))
+    return "<unreadable>";
+  return content;
+}
+
+void AppendResult(std::vector<bool>* results, bool success) {
+  results->push_back(success);
+}
+
+void Increment(int* count) {
+  ++*count;
+}
+
+}  // namespace
+
+class ImportantFileWriteCoordinatorTest : public testing::Test {
+ public:
+  ImportantFileWriteCoordinatorTest() = default;
+  void SetUp() override { ASSERT_TRUE(temp_dir_.CreateUniqueTempDir()); }
+
+ protected:
+  FilePath GetPath(const char* name) const {
+    return temp_dir_.GetPath().AppendASCII(name);
+  }
+
+  MessageLoop loop_;
+
+ private:
+  ScopedTempDir temp_dir_;
+
+  DISALLOW_COPY_AND_ASSIGN(ImportantFileWriteCoordinatorTest);
+};
+
+TEST_F(ImportantFileWriteCoordinatorTest, BatchesWritesOfSeveralFiles) {
+  MockTimer timer(false, false);
+  ImportantFileWriteCoordinator coordinator(ThreadTaskRunnerHandle::Get(),
+                                            kBatchInterval);
+  coordinator.SetTimerForTesting(&timer);
+  ImportantFileWriter foo_writer(GetPath("foo"), &coordinator, kBatchInterval);
+  ImportantFileWriter bar_writer(GetPath("bar"), &coordinator, kBatchInterval);
+
+  foo_writer.WriteNow(std::make_unique<std::string>("foo"));
+  EXPECT_TRUE(coordinator.HasPendingWrites());
+  ASSERT_TRUE(timer.IsRunning());
+  EXPECT_EQ(kBatchInterval, timer.GetCurrentDelay());
+  bar_writer.WriteNow(std::make_unique<std::string>("bar"));
+
+  // Nothing is written before the end of the batch.
+  RunLoop().RunUntilIdle();
+  EXPECT_FALSE(PathExists(foo_writer.path()));
+  EXPECT_FALSE(PathExists(bar_writer.path()));
+
+  timer.Fire();
+  EXPECT_FALSE(coordinator.HasPendingWrites());
+  RunLoop().RunUntilIdle();
+  EXPECT_EQ("foo", GetFileContent(foo_writer.path()));
+  EXPECT_EQ("bar", GetFileContent(bar_writer.path()));
+}
+
+TEST_F(ImportantFileWriteCoordinatorTest, CoalescesWritesOfSameFile) {
+  MockTimer timer(false, false);
+  ImportantFileWriteCoordinator coordinator(ThreadTaskRunnerHandle::Get(),
+                                            kBatchInterval);
+  coordinator.SetTimerForTesting(&timer);
+  ImportantFileWriter writer(GetPath("foo"), &coordinator, kBatchInterval);
+
+  int before_write_count = 0;
+  std::vector<bool> results;
+  writer.RegisterOnNextWriteCallbacks(Bind(&Increment, &before_write_count),
+                                      Bind(&AppendResult, &results));
+  writer.WriteNow(std::make_unique<std::string>("foo"));
+  writer.RegisterOnNextWriteCallbacks(Bind(&Increment, &before_write_count),
+                                      Bind(&AppendResult, &results));
+  writer.WriteNow(std::make_unique<std::string>("bar"));
+
+  coordinator.CommitPendingWrites();
+  EXPECT_FALSE(timer.IsRunning());
+  RunLoop().RunUntilIdle();
+  EXPECT_EQ("bar", GetFileContent(writer.path()));
+
+  // The callbacks of both writes are invoked.
+  EXPECT_EQ(2, before_write_count);
+  EXPECT_EQ(std::vector<bool>({true, true}), results);
+}
+
+TEST_F(ImportantFileWriteCoordinatorTest, FailedWriteDoesNotFailBatch) {
+  ImportantFileWriteCoordinator coordinator(ThreadTaskRunnerHandle::Get(),
+                                            kBatchInterval);
+  // Use an invalid file path (relative paths are invalid) to fail one write.
+  ImportantFileWriter bad_writer(FilePath().AppendASCII("bad/../path"),
+                                 &coordinator, kBatchInterval);
+  ImportantFileWriter writer(GetPath("foo"), &coordinator, kBatchInterval);
+
+  std::vector<bool> results;
+  bad_writer.RegisterOnNextWriteCallbacks(Closure(),
+                                          Bind(&AppendResult, &results));
+  bad_writer.WriteNow(std::make_unique<std::string>("bad"));
+  writer.RegisterOnNextWriteCallbacks(Closure(), Bind(&AppendResult, &results));
+  writer.WriteNow(std::make_unique<std::string>("foo"));
+
+  coordinator.CommitPendingWrites();
+  RunLoop().RunUntilIdle();
+  EXPECT_EQ(std::vector<bool>({false, true}), results);
+  EXPECT_FALSE(PathExists(bad_writer.path()));
+  EXPECT_EQ("foo", GetFileContent(writer.path()));
+}
+
+TEST_F(ImportantFileWriteCoordinatorTest, CommitsOnDestruction) {
+  const FilePath path = GetPath("foo");
+  {
+    ImportantFileWriteCoordinator coordinator(ThreadTaskRunnerHandle::Get(),
+                                              kBatchInterval);
+    ImportantFileWriter writer(path, &coordinator, kBatchInterval);
+    writer.WriteNow(std::make_unique<std::string>("foo"));
+  }
+  RunLoop().RunUntilIdle();
+  EXPECT_EQ("foo", GetFileContent(path));
+}
+
+TEST_F(ImportantFileWriteCoordinatorTest, WriteFilesAtomically) {
+  std::vector<ImportantFileWriter::BatchedWrite> writes;
+  for (const char* name : {"foo", "bar", "baz"}) {
+    ImportantFileWriter::BatchedWrite write;
+    write.path = GetPath(name);
+    write.data = std::make_unique<std::string>(name);
+    writes.push_back(std::move(write));
+  }
+  ImportantFileWriter::WriteFilesAtomically(std::move(writes));
+  EXPECT_EQ("foo", GetFileContent(GetPath("foo")));
+  EXPECT_EQ("bar", GetFileContent(GetPath("bar")));
+  EXPECT_EQ("baz", GetFileContent(GetPath("baz")));
+
+  // No temp file is left behind.
+  FileEnumerator enumerator(GetPath("foo").DirName(), false,
+                            FileEnumerator::FILES);
+  int num_files = 0;
+  while (!enumerator.Next().empty())
+    ++num_files;
+  EXPECT_EQ(3, num_files);
+}
+
+}  // namespace base
@@ -7,8 +7,10 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <map>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "base/bind.h"
 #include "base/callback_helpers.h"
@@ -17,6 +19,7 @@
 #include "base/files/file.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
+#include "base/files/important_file_write_coordinator.h"
 #include "base/logging.h"
 #include "base/macros.h"
 #include "base/metrics/histogram_functions.h"
@@ -30,6 +33,11 @@
 #include "base/time/time.h"
 #include "build/build_config.h"
 
+#if defined(OS_LINUX)
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace base {
 
 namespace {
@@ -129,32 +137,17 @@ void DeleteTmpFile(const FilePath& tmp_file_path,
   }
 }
 
-}  // namespace
-
-// static
-bool ImportantFileWriter::WriteFileAtomically(const FilePath& path,
-                                              StringPiece data,
-                                              StringPiece histogram_suffix) {
-#if defined(OS_CHROMEOS)
-  // On Chrome OS, chrome gets killed when it cannot finish shutdown quickly,
-  // and this function seems to be one of the slowest shutdown steps.
-  // Include some info to the report for investigation. crbug.com/418627
-  // TODO(hashimoto): Remove this.
-  struct {
-    size_t data_size;
-    char path[128];
-  } file_info;
-  file_info.data_size = data.size();
-  strlcpy(file_info.path, path.value().c_str(), arraysize(file_info.path));
-  debug::Alias(&file_info);
-#endif
-
-  // Write the data to a temp file then rename to avoid data loss if we crash
-  // while writing the file. Ensure that the temp file is on the same volume
-  // as target file, so it can be moved in one step, and that the temp file
-  // is securely created.
-  FilePath tmp_file_path;
-  if (!CreateTemporaryFileInDir(path.DirName(), &tmp_file_path)) {
+// Creates a temp file in the directory of |path|, so that it is on the same
+// volume and can replace |path| in one step, and writes |data| to it. On
+// success, leaves the temp file open in |tmp_file| to be flushed. On failure,
+// deletes it.
+bool CreateAndWriteTempFile(const FilePath& path,
+                            StringPiece data,
+                            StringPiece histogram_suffix,
+                            FilePath* tmp_file_path,
+                            File* tmp_file) {
+  // The temp file is securely created.
+  if (!CreateTemporaryFileInDir(path.DirName(), tmp_file_path)) {
     UmaHistogramExactLinearWithSuffix(
         "ImportantFile.FileCreateError", histogram_suffix,
         -base::File::GetLastFileError(), -base::File::FILE_ERROR_MAX);
@@ -163,41 +156,57 @@ bool ImportantFileWriter::WriteFileAtomically(const FilePath& path,
     return false;
   }
 
-  File tmp_file(tmp_file_path, File::FLAG_OPEN | File::FLAG_WRITE);
-  if (!tmp_file.IsValid()) {
+  tmp_file->Initialize(*tmp_file_path, File::FLAG_OPEN | File::FLAG_WRITE);
+  if (!tmp_file->IsValid()) {
     UmaHistogramExactLinearWithSuffix(
         "ImportantFile.FileOpenError", histogram_suffix,
-        -tmp_file.error_details(), -base::File::FILE_ERROR_MAX);
+        -tmp_file->error_details(), -base::File::FILE_ERROR_MAX);
     LogFailure(path, histogram_suffix, FAILED_OPENING,
                "could not open temporary file");
-    DeleteFile(tmp_file_path, false);
+    DeleteFile(*tmp_file_path, false);
     return false;
   }
 
   // If this fails in the wild, something really bad is going on.
   const int data_length = checked_cast<int32_t>(data.length());
-  int bytes_written = tmp_file.Write(0, data.data(), data_length);
+  int bytes_written = tmp_file->Write(0, data.data(), data_length);
   if (bytes_written < data_length) {
     UmaHistogramExactLinearWithSuffix(
         "ImportantFile.FileWriteError", histogram_suffix,
         -base::File::GetLastFileError(), -base::File::FILE_ERROR_MAX);
-  }
-  bool flush_success = tmp_file.Flush();
-  tmp_file.Close();
-
-  if (bytes_written < data_length) {
+    tmp_file->Close();
     LogFailure(path, histogram_suffix, FAILED_WRITING,
                "error writing, bytes_written=" + IntToString(bytes_written));
-    DeleteTmpFile(tmp_file_path, histogram_suffix);
+    DeleteTmpFile(*tmp_file_path, histogram_suffix);
     return false;
   }
 
+  return true;
+}
+
+// Flushes and closes the |tmp_file| written by CreateAndWriteTempFile(). On
+// failure, deletes it.
+bool FlushTempFile(const FilePath& path,
+                   const FilePath& tmp_file_path,
+                   StringPiece histogram_suffix,
+                   File* tmp_file) {
+  bool flush_success = tmp_file->Flush();
+  tmp_file->Close();
+
   if (!flush_success) {
     LogFailure(path, histogram_suffix, FAILED_FLUSHING, "error flushing");
     DeleteTmpFile(tmp_file_path, histogram_suffix);
     return false;
   }
 
+  return true;
+}
+
+// Replaces |path| with the flushed temp file at |tmp_file_path|. On failure,
+// deletes the temp file.
+bool ReplaceWithTempFile(const FilePath& path,
+                         const FilePath& tmp_file_path,
+                         StringPiece histogram_suffix) {
   base::File::Error replace_file_error = base::File::FILE_OK;
   if (!ReplaceFile(tmp_file_path, path, &replace_file_error)) {
     UmaHistogramExactLinearWithSuffix("ImportantFile.FileRenameError",
@@ -212,6 +221,117 @@ bool ImportantFileWriter::WriteFileAtomically(const FilePath& path,
   return true;
 }
 
+}  // namespace
+
+// static
+bool ImportantFileWriter::WriteFileAtomically(const FilePath& path,
+                                              StringPiece data,
+                                              StringPiece histogram_suffix) {
+#if defined(OS_CHROMEOS)
+  // On Chrome OS, chrome gets killed when it cannot finish shutdown quickly,
+  // and this function seems to be one of the slowest shutdown steps.
+  // Include some info to the report for investigation. crbug.com/418627
+  // TODO(hashimoto): Remove this.
+  struct {
+    size_t data_size;
+    char path[128];
+  } file_info;
+  file_info.data_size = data.size();
+  strlcpy(file_info.path, path.value().c_str(), arraysize(file_info.path));
+  debug::Alias(&file_info);
+#endif
+
+  // Write the data to a temp file then rename to avoid data loss if we crash
+  // while writing the file.
+  FilePath tmp_file_path;
+  File tmp_file;
+  return CreateAndWriteTempFile(path, data, histogram_suffix, &tmp_file_path,
+                                &tmp_file) &&
+         FlushTempFile(path, tmp_file_path, histogram_suffix, &tmp_file) &&
+         ReplaceWithTempFile(path, tmp_file_path, histogram_suffix);
+}
+
+// static
+void ImportantFileWriter::WriteFilesAtomically(
+    std::vector<BatchedWrite> writes) {
+  for (const BatchedWrite& write : writes) {
+    if (!write.before_write_callback.is_null())
+      write.before_write_callback.Run();
+  }
+
+  TimeTicks start_time = TimeTicks::Now();
+
+  // Write all the temp files before flushing any of them, so that the flushes
+  // can be batched. A temp file stays open until it is flushed.
+  std::vector<FilePath> tmp_file_paths(writes.size());
+  std::vector<File> tmp_files(writes.size());
+  std::vector<bool> results(writes.size());
+  for (size_t i = 0; i < writes.size(); ++i) {
+    DCHECK(writes[i].data);
+    results[i] = CreateAndWriteTempFile(writes[i].path, *writes[i].data,
+                                        writes[i].histogram_suffix,
+                                        &tmp_file_paths[i], &tmp_files[i]);
+  }
+
+#if defined(OS_LINUX)
+  // syncfs() flushes a whole file system in one call, which is cheaper than
+  // flushing several of its files one by one. Unlike File::Flush(), it doesn't
+  // report write back errors on Linux kernels older than 5.8, which doesn't
+  // weaken the guarantees of the class comment: temp files only replace their
+  // target once written, which is what protects against application crashes.
+  std::map<dev_t, std::vector<size_t>> files_by_device;
+  for (size_t i = 0; i < writes.size(); ++i) {
+    struct stat file_info;
+    if (tmp_files[i].IsValid() &&
+        fstat(tmp_files[i].GetPlatformFile(), &file_info) == 0) {
+      files_by_device[file_info.st_dev].push_back(i);
+    }
+  }
+  for (const auto& device_files : files_by_device) {
+    const std::vector<size_t>& indices = device_files.second;
+    if (indices.size() < 2 ||
+        syncfs(tmp_files[indices.front()].GetPlatformFile()) != 0) {
+      continue;
+    }
+    for (size_t i : indices)
+      tmp_files[i].Close();
+  }
+#endif  // defined(OS_LINUX)
+
+  // Flush the temp files that weren't flushed in batches.
+  for (size_t i = 0; i < writes.size(); ++i) {
+    if (tmp_files[i].IsValid()) {
+      results[i] = FlushTempFile(writes[i].path, tmp_file_paths[i],
+                                 writes[i].histogram_suffix, &tmp_files[i]);
+    }
+  }
+
+  for (size_t i = 0; i < writes.size(); ++i) {
+    if (results[i]) {
+      results[i] = ReplaceWithTempFile(writes[i].path, tmp_file_paths[i],
+                                       writes[i].histogram_suffix);
+    }
+  }
+
+  UmaHistogramTimes("ImportantFile.TimeToWriteBatch",
+                    TimeTicks::Now() - start_time);
+
+  for (size_t i = 0; i < writes.size(); ++i) {
+    if (!writes[i].after_write_callback.is_null())
+      writes[i].after_write_callback.Run(results[i]);
+  }
+}
+
+ImportantFileWriter::BatchedWrite::BatchedWrite() = default;
+
+ImportantFileWriter::BatchedWrite::BatchedWrite(BatchedWrite&& other) =
+    default;
+
+ImportantFileWriter::BatchedWrite::~BatchedWrite() = default;
+
+ImportantFileWriter::BatchedWrite& ImportantFileWriter::BatchedWrite::
+operator=(BatchedWrite&& other) = default;
+
 ImportantFileWriter::ImportantFileWriter(
     const FilePath& path,
     scoped_refptr<SequencedTaskRunner> task_runner,
@@ -235,6 +355,18 @@ ImportantFileWriter::ImportantFileWriter(
   DCHECK(task_runner_);
 }
 
+ImportantFileWriter::ImportantFileWriter(
+    const FilePath& path,
+    ImportantFileWriteCoordinator* coordinator,
+    TimeDelta interval,
+    const char* histogram_suffix)
+    : ImportantFileWriter(path,
+                          coordinator->task_runner(),
+                          interval,
+                          histogram_suffix) {
+  coordinator_ = coordinator;
+}
+
 ImportantFileWriter::~ImportantFileWriter() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   // We're usually a member variable of some other object, which also tends
@@ -255,6 +387,18 @@ void ImportantFileWriter::WriteNow(std::unique_ptr<std::string> data) {
     return;
   }
 
+  if (coordinator_) {
+    BatchedWrite write;
+    write.path = path_;
+    write.data = std::move(data);
+    write.before_write_callback = std::move(before_next_write_callback_);
+    write.after_write_callback = std::move(after_next_write_callback_);
+    write.histogram_suffix = histogram_suffix_;
+    coordinator_->AddWrite(std::move(write));
+    ClearPendingWrite();
+    return;
+  }
+
   Closure task = AdaptCallbackForRepeating(
       BindOnce(&WriteScopedStringToFileAtomically, path_, std::move(data),
                std::move(before_next_write_callback_),
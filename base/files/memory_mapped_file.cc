@@ -4,14 +4,23 @@
 
 #include "base/files/memory_mapped_file.h"
 
+#include <algorithm>
+#include <memory>
 #include <utility>
 
+#include "base/bind.h"
 #include "base/files/file_path.h"
+#include "base/location.h"
 #include "base/logging.h"
 #include "base/numerics/safe_math.h"
 #include "base/sys_info.h"
+#include "base/task_scheduler/post_task.h"
 #include "build/build_config.h"
 
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+#include <fcntl.h>
+#endif
+
 namespace base {
 
 const MemoryMappedFile::Region MemoryMappedFile::Region::kWholeFile = {0, 0};
@@ -31,6 +40,30 @@ MemoryMappedFile::~MemoryMappedFile() {
 }
 
 #if !defined(OS_NACL)
+namespace {
+
+// Reads [offset, offset + size) of |file| into the OS's cache.
+void ReadAheadFileRegion(File file, int64_t offset, size_t size) {
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+  // readahead() populates the page cache without copying the data out.
+  if (readahead(file.GetPlatformFile(), offset, size) == 0)
+    return;
+#endif
+
+  constexpr size_t kChunkSize = 64 * 1024;
+  std::unique_ptr<char[]> buffer(new char[kChunkSize]);
+  while (size > 0) {
+    const int bytes_read = file.Read(
+        offset, buffer.get(), static_cast<int>(std::min(size, kChunkSize)));
+    if (bytes_read <= 0)
+      return;
+    offset += bytes_read;
+    size -= bytes_read;
+  }
+}
+
+}  // namespace
+
 bool MemoryMappedFile::Initialize(const FilePath& file_name, Access access) {
   if (IsValid())
     return false;
@@ -48,6 +81,7 @@ bool MemoryMappedFile::Initialize(const FilePath& file_name, Access access) {
       NOTREACHED();
   }
   file_.Initialize(file_name, flags);
+  file_offset_ = 0;
 
   if (!file_.IsValid()) {
     DLOG(ERROR) << "Couldn't open " << file_name.AsUTF8Unsafe();
@@ -99,6 +133,7 @@ bool MemoryMappedFile::Initialize(File file,
     DCHECK_GE(region.offset, 0);
 
   file_ = std::move(file);
+  file_offset_ = region == Region::kWholeFile ? 0 : region.offset;
 
   if (!MapFileRegionToMemory(region, access)) {
     CloseHandles();
@@ -112,6 +147,24 @@ bool MemoryMappedFile::IsValid() const {
   return data_ != nullptr;
 }
 
+void MemoryMappedFile::PrefetchAsync(size_t offset, size_t size) {
+  DCHECK(IsValid());
+  DCHECK_LE(offset, length_);
+  size = std::min(size, length_ - offset);
+
+  File file = file_.Duplicate();
+  if (!file.IsValid()) {
+    DPLOG(ERROR) << "Couldn't duplicate the mapped file";
+    return;
+  }
+  PostTaskWithTraits(
+      FROM_HERE,
+      {MayBlock(), TaskPriority::BACKGROUND,
+       TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN},
+      BindOnce(&ReadAheadFileRegion, std::move(file), file_offset_ + offset,
+               size));
+}
+
 // static
 void MemoryMappedFile::CalculateVMAlignedBoundaries(int64_t start,
                                                     size_t size,
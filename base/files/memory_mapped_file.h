@@ -46,6 +46,20 @@ class BASE_EXPORT MemoryMappedFile {
     READ_WRITE_EXTEND,
   };
 
+  // Hints at how the mapped data will be accessed, so that the OS can tune
+  // read-ahead when paging it in.
+  enum AccessPattern {
+    // No particular order. This is the default.
+    NORMAL_ACCESS,
+
+    // In increasing address order: pages can be read ahead aggressively and
+    // dropped soon after access.
+    SEQUENTIAL_ACCESS,
+
+    // In no predictable order: reading ahead would waste I/O and memory.
+    RANDOM_ACCESS,
+  };
+
   // The default constructor sets all members to invalid/null values.
   MemoryMappedFile();
   ~MemoryMappedFile();
@@ -100,6 +114,28 @@ class BASE_EXPORT MemoryMappedFile {
   // Is file_ a valid file handle that points to an open, memory mapped file?
   bool IsValid() const;
 
+  // The methods below are hints which the OS may ignore, and which don't
+  // change the contents of the mapping. They must be called on a valid
+  // mapping. Ranges are relative to data() and clamped to length().
+
+  // Hints that the whole mapping will be accessed according to |pattern|.
+  void SetAccessPattern(AccessPattern pattern);
+
+  // Asks the OS to start paging in [offset, offset + size), so that later
+  // accesses don't fault on I/O. Doesn't wait for the data to be read.
+  void Prefetch(size_t offset, size_t size);
+
+  // Same as Prefetch(), but the I/O is done by a background task which reads
+  // the file rather than the mapping. This warms mapped data off the critical
+  // path of startup, and is safe even if the mapping is closed before the task
+  // runs.
+  void PrefetchAsync(size_t offset, size_t size);
+
+  // Asks the OS to back the mapping with huge pages, which saves TLB misses on
+  // large mappings that are accessed randomly. Returns false if that isn't
+  // supported, which is the case on most platforms and file systems.
+  bool UseHugePages();
+
  private:
   // Given the arbitrarily aligned memory region [start, size], returns the
   // boundaries of the region aligned to the granularity specified by the OS,
@@ -124,6 +160,9 @@ class BASE_EXPORT MemoryMappedFile {
   uint8_t* data_;
   size_t length_;
 
+  // Offset in |file_| of data().
+  int64_t file_offset_;
+
 #if defined(OS_WIN)
   win::ScopedHandle file_mapping_;
 #endif
@@ -4,6 +4,7 @@
 
 #include "base/files/memory_mapped_file.h"
 
+#include <errno.h>
 #include <fcntl.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -11,8 +12,11 @@
 #include <sys/stat.h>
 #include <unistd.h>
 
+#include <algorithm>
+
 #include "base/logging.h"
 #include "base/numerics/safe_conversions.h"
+#include "base/sys_info.h"
 #include "base/threading/thread_restrictions.h"
 #include "build/build_config.h"
 
@@ -22,9 +26,30 @@
 
 namespace base {
 
-MemoryMappedFile::MemoryMappedFile() : data_(nullptr), length_(0) {}
+MemoryMappedFile::MemoryMappedFile()
+    : data_(nullptr), length_(0), file_offset_(0) {}
 
 #if !defined(OS_NACL)
+namespace {
+
+// Applies |advice| to the pages which contain [data + offset, data + offset +
+// size). Returns false on failure.
+bool AdviseRange(uint8_t* data, size_t offset, size_t size, int advice) {
+  if (!size)
+    return true;
+  const uintptr_t mask = SysInfo::VMAllocationGranularity() - 1;
+  const uintptr_t start = reinterpret_cast<uintptr_t>(data) + offset;
+  const uintptr_t aligned_start = start & ~mask;
+  if (madvise(reinterpret_cast<void*>(aligned_start),
+              size + (start - aligned_start), advice) != 0) {
+    DPLOG_IF(ERROR, errno != EINVAL) << "madvise";
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
 bool MemoryMappedFile::MapFileRegionToMemory(
     const MemoryMappedFile::Region& region,
     Access access) {
@@ -169,6 +194,40 @@ bool MemoryMappedFile::MapFileRegionToMemory(
   data_ += data_offset;
   return true;
 }
+
+void MemoryMappedFile::SetAccessPattern(AccessPattern pattern) {
+  DCHECK(IsValid());
+  int advice = MADV_NORMAL;
+  switch (pattern) {
+    case NORMAL_ACCESS:
+      advice = MADV_NORMAL;
+      break;
+    case SEQUENTIAL_ACCESS:
+      advice = MADV_SEQUENTIAL;
+      break;
+    case RANDOM_ACCESS:
+      advice = MADV_RANDOM;
+      break;
+  }
+  AdviseRange(data_, 0, length_, advice);
+}
+
+void MemoryMappedFile::Prefetch(size_t offset, size_t size) {
+  DCHECK(IsValid());
+  DCHECK_LE(offset, length_);
+  AdviseRange(data_, offset, std::min(size, length_ - offset), MADV_WILLNEED);
+}
+
+bool MemoryMappedFile::UseHugePages() {
+  DCHECK(IsValid());
+#if defined(MADV_HUGEPAGE)
+  // Only file systems supporting transparent huge pages honor this, others
+  // fail with EINVAL.
+  return AdviseRange(data_, 0, length_, MADV_HUGEPAGE);
+#else
+  return false;
+#endif
+}
 #endif
 
 void MemoryMappedFile::CloseHandles() {
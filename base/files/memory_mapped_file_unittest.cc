@@ -11,6 +11,7 @@
 
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
+#include "base/test/scoped_task_environment.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/platform_test.h"
 
@@ -170,6 +171,46 @@ TEST_F(MemoryMappedFileTest, MapLargePartialRegionInTheMiddle) {
   ASSERT_TRUE(CheckBufferContents(map.data(), kPartialSize, kOffset));
 }
 
+TEST_F(MemoryMappedFileTest, AccessHints) {
+  const size_t kFileSize = 157 * 1024;
+  CreateTemporaryTestFile(kFileSize);
+  MemoryMappedFile map;
+
+  File file(temp_file_path(), File::FLAG_OPEN | File::FLAG_READ);
+  const size_t kOffset = 4 * 1024 + 17;
+  map.Initialize(std::move(file),
+                 {static_cast<int64_t>(kOffset), kFileSize - kOffset});
+  ASSERT_TRUE(map.IsValid());
+
+  // Hints must not change the contents of the mapping.
+  map.SetAccessPattern(MemoryMappedFile::SEQUENTIAL_ACCESS);
+  map.SetAccessPattern(MemoryMappedFile::RANDOM_ACCESS);
+  map.SetAccessPattern(MemoryMappedFile::NORMAL_ACCESS);
+  map.Prefetch(0, map.length());
+  map.Prefetch(3, 10);
+  map.Prefetch(map.length() - 1, 100);
+  map.Prefetch(map.length(), 0);
+  map.UseHugePages();
+  EXPECT_TRUE(CheckBufferContents(map.data(), map.length(), kOffset));
+}
+
+TEST_F(MemoryMappedFileTest, PrefetchAsync) {
+  test::ScopedTaskEnvironment scoped_task_environment;
+  const size_t kFileSize = 157 * 1024;
+  CreateTemporaryTestFile(kFileSize);
+  {
+    MemoryMappedFile map;
+    map.Initialize(temp_file_path());
+    ASSERT_TRUE(map.IsValid());
+    map.PrefetchAsync(0, map.length());
+    map.PrefetchAsync(1024, 2 * kFileSize);
+    EXPECT_TRUE(CheckBufferContents(map.data(), kFileSize, 0));
+  }
+
+  // The prefetch tasks don't depend on the mapping.
+  scoped_task_environment.RunUntilIdle();
+}
+
 TEST_F(MemoryMappedFileTest, WriteableFile) {
   const size_t kFileSize = 127;
   CreateTemporaryTestFile(kFileSize);
@@ -7,9 +7,11 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <algorithm>
 #include <limits>
 
 #include "base/files/file_path.h"
+#include "base/logging.h"
 #include "base/strings/string16.h"
 #include "base/threading/thread_restrictions.h"
 
@@ -17,8 +19,8 @@
 
 namespace base {
 
-MemoryMappedFile::MemoryMappedFile() : data_(NULL), length_(0) {
-}
+MemoryMappedFile::MemoryMappedFile()
+    : data_(NULL), length_(0), file_offset_(0) {}
 
 bool MemoryMappedFile::MapFileRegionToMemory(
     const MemoryMappedFile::Region& region,
@@ -94,6 +96,37 @@ bool MemoryMappedFile::MapFileRegionToMemory(
   return true;
 }
 
+void MemoryMappedFile::SetAccessPattern(AccessPattern pattern) {
+  DCHECK(IsValid());
+  // Windows has no equivalent of madvise() for mapped views.
+}
+
+void MemoryMappedFile::Prefetch(size_t offset, size_t size) {
+  DCHECK(IsValid());
+  DCHECK_LE(offset, length_);
+
+  // PrefetchVirtualMemory() is only available on Windows 8 and later.
+  using PrefetchVirtualMemoryFunction =
+      BOOL(WINAPI*)(HANDLE, ULONG_PTR, PWIN32_MEMORY_RANGE_ENTRY, ULONG);
+  static const PrefetchVirtualMemoryFunction prefetch_virtual_memory =
+      reinterpret_cast<PrefetchVirtualMemoryFunction>(::GetProcAddress(
+          ::GetModuleHandle(L"kernel32.dll"), "PrefetchVirtualMemory"));
+  if (!prefetch_virtual_memory)
+    return;
+
+  WIN32_MEMORY_RANGE_ENTRY range;
+  range.VirtualAddress = data_ + offset;
+  range.NumberOfBytes = std::min(size, length_ - offset);
+  if (range.NumberOfBytes)
+    prefetch_virtual_memory(::GetCurrentProcess(), 1, &range, 0);
+}
+
+bool MemoryMappedFile::UseHugePages() {
+  DCHECK(IsValid());
+  // Large pages can't back file mappings on Windows.
+  return false;
+}
+
 void MemoryMappedFile::CloseHandles() {
   if (data_)
     ::UnmapViewOfFile(data_);
@@ -4,6 +4,8 @@
 
 #include "base/hash.h"
 
+#include <string.h>
+
 // Definition in base/third_party/superfasthash/superfasthash.c. (Third-party
 // code did not come with its own header file, so declaring the function here.)
 // Note: This algorithm is also in Blink under Source/wtf/StringHasher.h.
@@ -11,6 +13,106 @@ extern "C" uint32_t SuperFastHash(const char* data, int len);
 
 namespace base {
 
+namespace {
+
+// Mixing constants of FastHash(). These are the wyhash primes, which have an
+// even number of set bits in each byte.
+constexpr uint64_t kFastHashP0 = 0xa0761d6478bd642full;
+constexpr uint64_t kFastHashP1 = 0xe7037ed1a0b428dbull;
+constexpr uint64_t kFastHashP2 = 0x8ebc6af09c88c6e3ull;
+constexpr uint64_t kFastHashP3 = 0x589965cc75374cc3ull;
+
+// Multiplies |a| and |b| to 128 bits and folds the result to 64 bits.
+inline uint64_t FastHashMix(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+  unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+  return static_cast<uint64_t>(product) ^
+         static_cast<uint64_t>(product >> 64);
+#else
+  uint64_t a_lo = a & 0xffffffff;
+  uint64_t a_hi = a >> 32;
+  uint64_t b_lo = b & 0xffffffff;
+  uint64_t b_hi = b >> 32;
+  uint64_t lo_lo = a_lo * b_lo;
+  uint64_t hi_lo = a_hi * b_lo;
+  uint64_t lo_hi = a_lo * b_hi;
+  uint64_t hi_hi = a_hi * b_hi;
+  uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xffffffff) + lo_hi;
+  uint64_t high = hi_hi + (hi_lo >> 32) + (cross >> 32);
+  uint64_t low = (cross << 32) | (lo_lo & 0xffffffff);
+  return low ^ high;
+#endif
+}
+
+inline uint64_t FastHashRead64(const uint8_t* p) {
+  uint64_t value;
+  memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+inline uint64_t FastHashRead32(const uint8_t* p) {
+  uint32_t value;
+  memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+// Reads 1 to 3 bytes without branching on the exact length.
+inline uint64_t FastHashRead3(const uint8_t* p, size_t length) {
+  return (static_cast<uint64_t>(p[0]) << 16) |
+         (static_cast<uint64_t>(p[length >> 1]) << 8) | p[length - 1];
+}
+
+uint64_t FastHash64(const uint8_t* p, size_t length) {
+  uint64_t seed = kFastHashP0;
+  uint64_t a;
+  uint64_t b;
+  if (length <= 16) {
+    if (length >= 4) {
+      // Two possibly overlapping 4-byte reads at each end.
+      size_t offset = (length >> 3) << 2;
+      a = (FastHashRead32(p) << 32) | FastHashRead32(p + offset);
+      b = (FastHashRead32(p + length - 4) << 32) |
+          FastHashRead32(p + length - 4 - offset);
+    } else if (length > 0) {
+      a = FastHashRead3(p, length);
+      b = 0;
+    } else {
+      a = b = 0;
+    }
+  } else {
+    size_t remaining = length;
+    if (remaining > 48) {
+      // Three independent lanes keep the multipliers busy on long inputs.
+      uint64_t seed1 = seed;
+      uint64_t seed2 = seed;
+      do {
+        seed = FastHashMix(FastHashRead64(p) ^ kFastHashP1,
+                           FastHashRead64(p + 8) ^ seed);
+        seed1 = FastHashMix(FastHashRead64(p + 16) ^ kFastHashP2,
+                            FastHashRead64(p + 24) ^ seed1);
+        seed2 = FastHashMix(FastHashRead64(p + 32) ^ kFastHashP3,
+                            FastHashRead64(p + 40) ^ seed2);
+        p += 48;
+        remaining -= 48;
+      } while (remaining > 48);
+      seed ^= seed1 ^ seed2;
+    }
+    while (remaining > 16) {
+      seed = FastHashMix(FastHashRead64(p) ^ kFastHashP1,
+                         FastHashRead64(p + 8) ^ seed);
+      p += 16;
+      remaining -= 16;
+    }
+    // The last 16 bytes of the input, which may overlap what was mixed above.
+    a = FastHashRead64(p + remaining - 16);
+    b = FastHashRead64(p + remaining - 8);
+  }
+  return FastHashMix(kFastHashP1 ^ length,
+                     FastHashMix(a ^ kFastHashP1, b ^ seed));
+}
+
+}  // namespace
+
 uint32_t Hash(const void* data, size_t length) {
   // Currently our in-memory hash is the same as the persistent hash. The
   // split between in-memory and persistent hash functions is maintained to
@@ -26,6 +128,15 @@ uint32_t Hash(const string16& str) {
   return PersistentHash(str.data(), str.size() * sizeof(char16));
 }
 
+size_t FastHash(const void* data, size_t length) {
+  return static_cast<size_t>(
+      FastHash64(reinterpret_cast<const uint8_t*>(data), length));
+}
+
+size_t FastHash(const std::string& str) {
+  return FastHash(str.data(), str.size());
+}
+
 uint32_t PersistentHash(const void* data, size_t length) {
   // This hash function must not change, since it is designed to be persistable
   // to disk.
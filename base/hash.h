@@ -27,6 +27,16 @@ BASE_EXPORT uint32_t Hash(const void* data, size_t length);
 BASE_EXPORT uint32_t Hash(const std::string& str);
 BASE_EXPORT uint32_t Hash(const string16& str);
 
+// Computes a word-sized hash of a memory buffer. This is a multiply-based hash
+// which is considerably faster than Hash() on long inputs and mixes better on
+// 64-bit platforms. Like Hash(), it is subject to change in the future, so use
+// it only for temporary in-memory structures such as hash table keys and
+// cache lookups.
+//
+// WARNING: This hash function should not be used for any cryptographic purpose.
+BASE_EXPORT size_t FastHash(const void* data, size_t length);
+BASE_EXPORT size_t FastHash(const std::string& str);
+
 // Computes a hash of a memory buffer. This hash function must not change so
 // that code can use the hashed values for persistent storage purposes or
 // sending across the network. If a new persistent hash function is desired, a
@@ -0,0 +1,71 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/hash.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "base/debug/alias.h"
+#include "base/rand_util.h"
+#include "base/sha1.h"
+#include "base/strings/stringprintf.h"
+#include "base/test/perf_benchmark.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+// Input sizes: a short key, a URL-sized string and a cache entry-sized blob.
+constexpr size_t kSizes[] = {16, 256, 4096};
+
+// Measures |hash_function| on |size|-byte inputs and prints the time per call
+// and the throughput.
+template <typename HashFunction>
+void RunBenchmark(const std::string& name,
+                  size_t size,
+                  HashFunction hash_function) {
+  const std::string input = RandBytesAsString(size);
+  // Accumulates the results so that the calls are not optimized away.
+  uint64_t result = 0;
+
+  PerfBenchmark::Options options;
+  options.bytes_per_operation = size;
+  PerfBenchmark(name, StringPrintf("%zu_bytes", size), options)
+      .Run([&] { result += hash_function(input); });
+  debug::Alias(&result);
+}
+
+}  // namespace
+
+TEST(HashPerfTest, Hash) {
+  for (size_t size : kSizes) {
+    RunBenchmark("Hash", size,
+                 [](const std::string& input) { return Hash(input); });
+  }
+}
+
+TEST(HashPerfTest, FastHash) {
+  for (size_t size : kSizes) {
+    RunBenchmark("FastHash", size,
+                 [](const std::string& input) { return FastHash(input); });
+  }
+}
+
+TEST(HashPerfTest, SHA1) {
+  for (size_t size : kSizes) {
+    RunBenchmark("SHA1", size, [](const std::string& input) {
+      unsigned char hash[kSHA1Length];
+      SHA1HashBytes(reinterpret_cast<const unsigned char*>(input.data()),
+                    input.size(), hash);
+      return hash[0];
+    });
+  }
+}
+
+}  // namespace base
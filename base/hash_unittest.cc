@@ -79,4 +79,29 @@ TEST(HashTest, CString) {
   EXPECT_EQ(2794219650u, Hash(str, strlen("hello world")));
 }
 
+TEST(HashTest, FastHashIsDeterministic) {
+  const std::string str = "hello world";
+  EXPECT_EQ(FastHash(str), FastHash(str.data(), str.size()));
+  EXPECT_EQ(FastHash(str), FastHash(std::string(str)));
+  EXPECT_NE(FastHash(str), FastHash(std::string("helmo world")));
+}
+
+TEST(HashTest, FastHashCoversEveryByte) {
+  // Flipping any single bit of inputs of every length up to a few blocks of
+  // the long-input loop changes the hash.
+  std::vector<unsigned char> buffer(200);
+  for (size_t i = 0; i < buffer.size(); ++i)
+    buffer[i] = static_cast<unsigned char>(i * 7);
+  for (size_t length = 1; length <= buffer.size(); ++length) {
+    size_t hash = FastHash(buffer.data(), length);
+    EXPECT_NE(hash, FastHash(buffer.data(), length - 1));
+    for (size_t i = 0; i < length; ++i) {
+      buffer[i] ^= 1;
+      EXPECT_NE(hash, FastHash(buffer.data(), length))
+          << "length " << length << ", byte " << i;
+      buffer[i] ^= 1;
+    }
+  }
+}
+
 }  // namespace base
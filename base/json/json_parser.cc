@@ -8,6 +8,8 @@
 #include <utility>
 #include <vector>
 
+#include "base/auto_reset.h"
+#include "base/bits.h"
 #include "base/logging.h"
 #include "base/macros.h"
 #include "base/numerics/safe_conversions.h"
@@ -19,6 +21,16 @@
 #include "base/strings/utf_string_conversions.h"
 #include "base/third_party/icu/icu_utf.h"
 #include "base/values.h"
+#include "build/build_config.h"
+
+// NaCl does not allow intrinsics.
+#if defined(ARCH_CPU_X86_FAMILY) && !defined(OS_NACL)
+#include <emmintrin.h>
+#define JSON_PARSER_USE_SSE2
+#elif defined(ARCH_CPU_ARM_FAMILY) && defined(__ARM_NEON) && !defined(OS_NACL)
+#include <arm_neon.h>
+#define JSON_PARSER_USE_NEON
+#endif
 
 namespace base {
 namespace internal {
@@ -50,6 +62,91 @@ class StackMarker {
 
 constexpr uint32_t kUnicodeReplacementPoint = 0xFFFD;
 
+// Returns true if |c| can be appended to a string as is, i.e. if it is an ASCII
+// character other than the quote and the backslash.
+bool IsPlainStringByte(char c) {
+  return static_cast<unsigned char>(c) < kExtendedASCIIStart && c != '"' &&
+         c != '\\';
+}
+
+// Returns the number of bytes at the beginning of [|begin|, |end|) for which
+// IsPlainStringByte() is true. Strings in JSON files mostly consist of such
+// bytes, so they are scanned 16 at a time when SIMD instructions are available.
+size_t CountPlainStringBytes(const char* begin, const char* end) {
+  const char* p = begin;
+#if defined(JSON_PARSER_USE_SSE2)
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i backslash = _mm_set1_epi8('\\');
+  for (; end - p >= 16; p += 16) {
+    const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    // The most significant bit of |chars| is set for non-ASCII bytes.
+    const __m128i special = _mm_or_si128(
+        chars, _mm_or_si128(_mm_cmpeq_epi8(chars, quote),
+                            _mm_cmpeq_epi8(chars, backslash)));
+    const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(special));
+    if (mask)
+      return (p - begin) + bits::CountTrailingZeroBits(mask);
+  }
+#elif defined(JSON_PARSER_USE_NEON)
+  const uint8x16_t quote = vdupq_n_u8('"');
+  const uint8x16_t backslash = vdupq_n_u8('\\');
+  const uint8x16_t extended_ascii_start = vdupq_n_u8(kExtendedASCIIStart);
+  for (; end - p >= 16; p += 16) {
+    const uint8x16_t chars = vld1q_u8(reinterpret_cast<const uint8_t*>(p));
+    const uint8x16_t special =
+        vorrq_u8(vcgeq_u8(chars, extended_ascii_start),
+                 vorrq_u8(vceqq_u8(chars, quote), vceqq_u8(chars, backslash)));
+    uint8x8_t any_special =
+        vorr_u8(vget_low_u8(special), vget_high_u8(special));
+    any_special = vpmax_u8(any_special, any_special);
+    any_special = vpmax_u8(any_special, any_special);
+    any_special = vpmax_u8(any_special, any_special);
+    // The loop below finds the special byte in these 16 bytes.
+    if (vget_lane_u8(any_special, 0))
+      break;
+  }
+#endif
+  while (p < end && IsPlainStringByte(*p))
+    ++p;
+  return p - begin;
+}
+
+// Returns the number of spaces and tabs at the beginning of [|begin|, |end|).
+size_t CountSpacesAndTabs(const char* begin, const char* end) {
+  const char* p = begin;
+#if defined(JSON_PARSER_USE_SSE2)
+  const __m128i space = _mm_set1_epi8(' ');
+  const __m128i tab = _mm_set1_epi8('\t');
+  for (; end - p >= 16; p += 16) {
+    const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    const __m128i blank =
+        _mm_or_si128(_mm_cmpeq_epi8(chars, space), _mm_cmpeq_epi8(chars, tab));
+    const uint32_t mask =
+        ~static_cast<uint32_t>(_mm_movemask_epi8(blank)) & 0xFFFF;
+    if (mask)
+      return (p - begin) + bits::CountTrailingZeroBits(mask);
+  }
+#elif defined(JSON_PARSER_USE_NEON)
+  const uint8x16_t space = vdupq_n_u8(' ');
+  const uint8x16_t tab = vdupq_n_u8('\t');
+  for (; end - p >= 16; p += 16) {
+    const uint8x16_t chars = vld1q_u8(reinterpret_cast<const uint8_t*>(p));
+    const uint8x16_t blank =
+        vorrq_u8(vceqq_u8(chars, space), vceqq_u8(chars, tab));
+    uint8x8_t all_blank = vand_u8(vget_low_u8(blank), vget_high_u8(blank));
+    all_blank = vpmin_u8(all_blank, all_blank);
+    all_blank = vpmin_u8(all_blank, all_blank);
+    all_blank = vpmin_u8(all_blank, all_blank);
+    // The loop below finds the first non-blank byte in these 16 bytes.
+    if (!vget_lane_u8(all_blank, 0))
+      break;
+  }
+#endif
+  while (p < end && (*p == ' ' || *p == '\t'))
+    ++p;
+  return p - begin;
+}
+
 }  // namespace
 
 // This is U+FFFD.
@@ -60,6 +157,7 @@ JSONParser::JSONParser(int options, int max_depth)
       max_depth_(max_depth),
       index_(0),
       stack_depth_(0),
+      skip_values_(false),
       line_number_(0),
       index_last_line_(0),
       error_code_(JSONReader::JSON_NO_ERROR),
@@ -70,27 +168,18 @@ JSONParser::JSONParser(int options, int max_depth)
 
 JSONParser::~JSONParser() = default;
 
-Optional<Value> JSONParser::Parse(StringPiece input) {
-  input_ = input;
-  index_ = 0;
-  line_number_ = 1;
-  index_last_line_ = 0;
+JSONParser::LazyValue::LazyValue() = default;
 
-  error_code_ = JSONReader::JSON_NO_ERROR;
-  error_line_ = 0;
-  error_column_ = 0;
+JSONParser::LazyValue::LazyValue(LazyValue&& other) = default;
 
-  // ICU and ReadUnicodeCharacter() use int32_t for lengths, so ensure
-  // that the index_ will not overflow when parsing.
-  if (!base::IsValueInRangeForNumericType<int32_t>(input.length())) {
-    ReportError(JSONReader::JSON_TOO_LARGE, 0);
-    return nullopt;
-  }
+JSONParser::LazyValue::~LazyValue() = default;
 
-  // When the input JSON string starts with a UTF-8 Byte-Order-Mark,
-  // advance the start position to avoid the ParseNextToken function mis-
-  // treating a Unicode BOM as an invalid character and returning NULL.
-  ConsumeIfMatch("\xEF\xBB\xBF");
+JSONParser::LazyValue& JSONParser::LazyValue::operator=(LazyValue&& other) =
+    default;
+
+Optional<Value> JSONParser::Parse(StringPiece input) {
+  if (!StartParsing(input))
+    return nullopt;
 
   // Parse the first and any nested tokens.
   Optional<Value> root(ParseNextToken());
@@ -106,6 +195,85 @@ Optional<Value> JSONParser::Parse(StringPiece input) {
   return root;
 }
 
+Optional<JSONParser::LazyValue> JSONParser::ParseLazily(StringPiece input) {
+  if (!StartParsing(input))
+    return nullopt;
+
+  AutoReset<bool> skip_values(&skip_values_, true);
+  LazyValue root;
+  if (!ConsumeLazyValue(GetNextToken(), &root))
+    return nullopt;
+
+  // Make sure the input stream is at an end.
+  if (GetNextToken() != T_END_OF_INPUT) {
+    ReportError(JSONReader::JSON_UNEXPECTED_DATA_AFTER_ROOT, 1);
+    return nullopt;
+  }
+
+  return std::move(root);
+}
+
+bool JSONParser::IndexContainer(StringPiece input,
+                                std::vector<LazyValue>* members) {
+  if (!StartParsing(input))
+    return false;
+
+  AutoReset<bool> skip_values(&skip_values_, true);
+  const Token begin_token = GetNextToken();
+  if (begin_token != T_OBJECT_BEGIN && begin_token != T_ARRAY_BEGIN) {
+    ReportError(JSONReader::JSON_UNEXPECTED_TOKEN, 1);
+    return false;
+  }
+  const bool is_dict = begin_token == T_OBJECT_BEGIN;
+  const Token end_token = is_dict ? T_OBJECT_END : T_ARRAY_END;
+  ConsumeChar();
+
+  Token token = GetNextToken();
+  while (token != end_token) {
+    LazyValue member;
+    if (is_dict) {
+      if (token != T_STRING) {
+        ReportError(JSONReader::JSON_UNQUOTED_DICTIONARY_KEY, 1);
+        return false;
+      }
+
+      StringBuilder key;
+      if (!ConsumeStringRaw(&key))
+        return false;
+      if (Optional<StringPiece> key_piece = key.AsStringPiece())
+        member.key = *key_piece;
+      else
+        member.decoded_key = key.DestructiveAsString();
+
+      if (GetNextToken() != T_OBJECT_PAIR_SEPARATOR) {
+        ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
+        return false;
+      }
+      ConsumeChar();
+      token = GetNextToken();
+    }
+
+    if (!ConsumeLazyValue(token, &member))
+      return false;
+    members->push_back(std::move(member));
+
+    token = GetNextToken();
+    if (token == T_LIST_SEPARATOR) {
+      ConsumeChar();
+      token = GetNextToken();
+      if (token == end_token && !(options_ & JSON_ALLOW_TRAILING_COMMAS)) {
+        ReportError(JSONReader::JSON_TRAILING_COMMA, 1);
+        return false;
+      }
+    } else if (token != end_token) {
+      ReportError(JSONReader::JSON_SYNTAX_ERROR, 0);
+      return false;
+    }
+  }
+
+  return true;
+}
+
 JSONReader::JsonParseError JSONParser::error_code() const {
   return error_code_;
 }
@@ -151,6 +319,22 @@ void JSONParser::StringBuilder::Append(uint32_t point) {
   }
 }
 
+void JSONParser::StringBuilder::AppendPlainBytes(const char* bytes,
+                                                 size_t length) {
+  if (string_) {
+    string_->append(bytes, length);
+  } else {
+    DCHECK_EQ(bytes, pos_ + length_);
+    length_ += length;
+  }
+}
+
+Optional<StringPiece> JSONParser::StringBuilder::AsStringPiece() const {
+  if (string_)
+    return nullopt;
+  return StringPiece(pos_, length_);
+}
+
 void JSONParser::StringBuilder::Convert() {
   if (string_)
     return;
@@ -165,6 +349,30 @@ std::string JSONParser::StringBuilder::DestructiveAsString() {
 
 // JSONParser private //////////////////////////////////////////////////////////
 
+bool JSONParser::StartParsing(StringPiece input) {
+  input_ = input;
+  index_ = 0;
+  line_number_ = 1;
+  index_last_line_ = 0;
+
+  error_code_ = JSONReader::JSON_NO_ERROR;
+  error_line_ = 0;
+  error_column_ = 0;
+
+  // ICU and ReadUnicodeCharacter() use int32_t for lengths, so ensure
+  // that the index_ will not overflow when parsing.
+  if (!base::IsValueInRangeForNumericType<int32_t>(input.length())) {
+    ReportError(JSONReader::JSON_TOO_LARGE, 0);
+    return false;
+  }
+
+  // When the input JSON string starts with a UTF-8 Byte-Order-Mark,
+  // advance the start position to avoid the ParseNextToken function mis-
+  // treating a Unicode BOM as an invalid character and returning NULL.
+  ConsumeIfMatch("\xEF\xBB\xBF");
+  return true;
+}
+
 Optional<StringPiece> JSONParser::PeekChars(int count) {
   if (static_cast<size_t>(index_) + count > input_.length())
     return nullopt;
@@ -254,10 +462,11 @@ void JSONParser::EatWhitespaceAndComments() {
         if (!(c == '\n' && index_ > 0 && input_[index_ - 1] == '\r')) {
           ++line_number_;
         }
-        FALLTHROUGH;
+        ConsumeChar();
+        break;
       case ' ':
       case '\t':
-        ConsumeChar();
+        index_ += CountSpacesAndTabs(pos(), input_.data() + input_.length());
         break;
       case '/':
         if (!EatComment())
@@ -325,6 +534,18 @@ Optional<Value> JSONParser::ParseToken(Token token) {
   }
 }
 
+bool JSONParser::ConsumeLazyValue(Token token, LazyValue* out) {
+  DCHECK(skip_values_);
+  const int start_index = index_;
+  Optional<Value> value = ParseToken(token);
+  if (!value)
+    return false;
+
+  out->type = value->type();
+  out->json = StringPiece(input_.data() + start_index, index_ - start_index);
+  return true;
+}
+
 Optional<Value> JSONParser::ConsumeDictionary() {
   if (ConsumeChar() != '{') {
     ReportError(JSONReader::JSON_UNEXPECTED_TOKEN, 1);
@@ -367,8 +588,10 @@ Optional<Value> JSONParser::ConsumeDictionary() {
       return nullopt;
     }
 
-    dict_storage.emplace_back(key.DestructiveAsString(),
-                              std::make_unique<Value>(std::move(*value)));
+    if (!skip_values_) {
+      dict_storage.emplace_back(key.DestructiveAsString(),
+                                std::make_unique<Value>(std::move(*value)));
+    }
 
     token = GetNextToken();
     if (token == T_LIST_SEPARATOR) {
@@ -386,7 +609,11 @@ Optional<Value> JSONParser::ConsumeDictionary() {
 
   ConsumeChar();  // Closing '}'.
 
-  return Value(Value::DictStorage(std::move(dict_storage), KEEP_LAST_OF_DUPES));
+  // Parsed values tend to be long-lived (preferences, policy, manifests), so
+  // don't keep the slack left by growing the storage one entry at a time.
+  Value::DictStorage dict(std::move(dict_storage), KEEP_LAST_OF_DUPES);
+  dict.shrink_to_fit();
+  return Value(std::move(dict));
 }
 
 Optional<Value> JSONParser::ConsumeList() {
@@ -411,7 +638,8 @@ Optional<Value> JSONParser::ConsumeList() {
       return nullopt;
     }
 
-    list_storage.push_back(std::move(*item));
+    if (!skip_values_)
+      list_storage.push_back(std::move(*item));
 
     token = GetNextToken();
     if (token == T_LIST_SEPARATOR) {
@@ -429,6 +657,7 @@ Optional<Value> JSONParser::ConsumeList() {
 
   ConsumeChar();  // Closing ']'.
 
+  list_storage.shrink_to_fit();
   return Value(std::move(list_storage));
 }
 
@@ -437,6 +666,8 @@ Optional<Value> JSONParser::ConsumeString() {
   if (!ConsumeStringRaw(&string))
     return nullopt;
 
+  if (skip_values_)
+    return Value(Value::Type::STRING);
   return Value(string.DestructiveAsString());
 }
 
@@ -452,6 +683,15 @@ bool JSONParser::ConsumeStringRaw(StringBuilder* out) {
   StringBuilder string(pos());
 
   while (PeekChar()) {
+    // Append runs of bytes that don't need to be decoded at once.
+    const size_t num_plain_bytes =
+        CountPlainStringBytes(pos(), input_.data() + input_.length());
+    if (num_plain_bytes) {
+      string.AppendPlainBytes(pos(), num_plain_bytes);
+      index_ += static_cast<int>(num_plain_bytes);
+      continue;
+    }
+
     uint32_t next_char = 0;
     if (!ReadUnicodeCharacter(input_.data(),
                               static_cast<int32_t>(input_.length()),
@@ -10,6 +10,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/base_export.h"
 #include "base/compiler_specific.h"
@@ -18,11 +19,10 @@
 #include "base/macros.h"
 #include "base/optional.h"
 #include "base/strings/string_piece.h"
+#include "base/values.h"
 
 namespace base {
 
-class Value;
-
 namespace internal {
 
 class JSONParserTest;
@@ -43,6 +43,26 @@ class JSONParserTest;
 // of the next token.
 class BASE_EXPORT JSONParser {
  public:
+  // The type and extent of a value that was validated without being built,
+  // and its key if it is a dictionary member. See ParseLazily().
+  struct LazyValue {
+    LazyValue();
+    LazyValue(LazyValue&& other);
+    ~LazyValue();
+    LazyValue& operator=(LazyValue&& other);
+
+    Value::Type type = Value::Type::NONE;
+
+    // The JSON text of the value, pointing into the parsed input.
+    StringPiece json;
+
+    // The key of a dictionary member. Points into the parsed input, unless
+    // the key had to be decoded (e.g. because of escape sequences), in which
+    // case it is in |decoded_key| instead.
+    StringPiece key;
+    Optional<std::string> decoded_key;
+  };
+
   JSONParser(int options, int max_depth = JSONReader::kStackMaxDepth);
   ~JSONParser();
 
@@ -52,6 +72,16 @@ class BASE_EXPORT JSONParser {
   // convert to a FooValue at the same time.
   Optional<Value> Parse(StringPiece input);
 
+  // Validates the input string like Parse() does, but without building any
+  // container or string, and returns the type and extent of the root value.
+  Optional<LazyValue> ParseLazily(StringPiece input);
+
+  // Assuming that |input| is a dictionary or a list that was validated by
+  // ParseLazily(), appends the type and extent of each of its members or items
+  // to |members| without building them. Nested containers are validated
+  // again, but not indexed. Returns false on error.
+  bool IndexContainer(StringPiece input, std::vector<LazyValue>* members);
+
   // Returns the error code.
   JSONReader::JsonParseError error_code() const;
 
@@ -105,6 +135,16 @@ class BASE_EXPORT JSONParser {
     // converted, or by appending the UTF8 bytes for the code point.
     void Append(uint32_t point);
 
+    // Appends the |length| bytes at |bytes|, which must all be ASCII
+    // characters other than '"' and '\\'. If the string has not been
+    // converted, |bytes| must directly follow the bytes that make up the
+    // string.
+    void AppendPlainBytes(const char* bytes, size_t length);
+
+    // Returns the string without copying it if the builder has not been
+    // converted, and nullopt otherwise.
+    Optional<StringPiece> AsStringPiece() const;
+
     // Converts the builder from its default StringPiece to a full std::string,
     // performing a copy. Once a builder is converted, it cannot be made a
     // StringPiece again.
@@ -127,6 +167,10 @@ class BASE_EXPORT JSONParser {
     base::Optional<std::string> string_;
   };
 
+  // Resets the parser state to parse |input|. Returns false if |input| can't
+  // be parsed at all.
+  bool StartParsing(StringPiece input);
+
   // Returns the next |count| bytes of the input stream, or nullopt if fewer
   // than |count| bytes remain.
   Optional<StringPiece> PeekChars(int count);
@@ -162,6 +206,11 @@ class BASE_EXPORT JSONParser {
   // in RFC terms) and consumes it, returning the result as a Value.
   Optional<Value> ParseToken(Token token);
 
+  // Takes a token that represents the start of a Value and consumes it
+  // without building containers or strings (see |skip_values_|), recording
+  // its type and extent in |out|. Returns false on error.
+  bool ConsumeLazyValue(Token token, LazyValue* out);
+
   // Assuming that the parser is currently wound to '{', this parses a JSON
   // object into a Value.
   Optional<Value> ConsumeDictionary();
@@ -226,6 +275,10 @@ class BASE_EXPORT JSONParser {
   // The number of times the parser has recursed (current stack depth).
   int stack_depth_;
 
+  // When set, the Consume functions validate dictionaries, lists and strings
+  // but return them as empty Values of the right type. Used for lazy parsing.
+  bool skip_values_;
+
   // The line number that the parser is at currently.
   int line_number_;
 
@@ -247,6 +300,7 @@ class BASE_EXPORT JSONParser {
   FRIEND_TEST_ALL_PREFIXES(JSONParserTest, ErrorMessages);
   FRIEND_TEST_ALL_PREFIXES(JSONParserTest, ReplaceInvalidCharacters);
   FRIEND_TEST_ALL_PREFIXES(JSONParserTest, ReplaceInvalidUTF16EscapeSequence);
+  FRIEND_TEST_ALL_PREFIXES(JSONParserTest, WhitespaceRuns);
 
   DISALLOW_COPY_AND_ASSIGN(JSONParser);
 };
@@ -458,5 +458,83 @@ TEST_F(JSONParserTest, UnterminatedInputs) {
   }
 }
 
+// Strings and whitespace are scanned several bytes at a time. Verify that
+// special bytes are handled at every position relative to the scanned blocks.
+TEST_F(JSONParserTest, SpecialCharacterAtEveryOffset) {
+  struct {
+    const char* json;
+    const char* expected;
+  } kSpecialCharacters[] = {
+      {"\\n", "\n"},         {"\\\"", "\""},
+      {"\\u00e9", "\xC3\xA9"}, {"\xC3\xA9", "\xC3\xA9"},
+      {"\x01", "\x01"},       {"\x7F", "\x7F"},
+  };
+
+  for (const auto& special_character : kSpecialCharacters) {
+    for (size_t offset = 0; offset < 40; ++offset) {
+      SCOPED_TRACE(StringPrintf("%s at offset %zu", special_character.json,
+                                offset));
+      const std::string prefix(offset, 'a');
+      const std::string suffix(40 - offset, 'b');
+      const std::string json =
+          "\"" + prefix + special_character.json + suffix + "\"";
+
+      std::unique_ptr<char[]> input_owner;
+      StringPiece input = MakeNotNullTerminatedInput(json.c_str(), &input_owner);
+      std::unique_ptr<Value> value = JSONReader::Read(input);
+      ASSERT_TRUE(value);
+      std::string str;
+      EXPECT_TRUE(value->GetAsString(&str));
+      EXPECT_EQ(prefix + special_character.expected + suffix, str);
+
+      // Without the closing quote, the string is unterminated.
+      input = MakeNotNullTerminatedInput(
+          json.substr(0, json.length() - 1).c_str(), &input_owner);
+      EXPECT_FALSE(JSONReader::Read(input));
+    }
+  }
+}
+
+TEST_F(JSONParserTest, WhitespaceRuns) {
+  int error_code = 0;
+  std::string error_message;
+  for (size_t num_blanks = 0; num_blanks < 40; ++num_blanks) {
+    SCOPED_TRACE(StringPrintf("%zu blanks", num_blanks));
+    std::string blanks;
+    for (size_t i = 0; i < num_blanks; ++i)
+      blanks.push_back(i % 3 ? ' ' : '\t');
+
+    std::unique_ptr<char[]> input_owner;
+    std::string json = "[" + blanks + "1" + blanks + "," + blanks + "2]";
+    std::unique_ptr<Value> value =
+        JSONReader::Read(MakeNotNullTerminatedInput(json.c_str(), &input_owner));
+    ASSERT_TRUE(value);
+    ASSERT_TRUE(value->is_list());
+    EXPECT_EQ(2U, value->GetList().size());
+
+    // Blanks are counted in the column of errors.
+    json = "[\n" + blanks + "1 2]";
+    EXPECT_FALSE(JSONReader::ReadAndReturnError(
+        MakeNotNullTerminatedInput(json.c_str(), &input_owner),
+        JSON_PARSE_RFC, &error_code, &error_message));
+    EXPECT_EQ(JSONParser::FormatErrorMessage(2, 4 + num_blanks,
+                                             JSONReader::kSyntaxError),
+              error_message);
+  }
+}
+
+TEST_F(JSONParserTest, ParsedContainersHaveNoSlack) {
+  // Sizes which are not powers of two leave capacity unused while growing.
+  std::unique_ptr<Value> value = JSONReader::Read(
+      R"({"a": 1, "b": [1, 2, 3, 4, 5], "c": {"d": "e", "f": "g", "h": []},)"
+      R"( "i": [[1, 2, 3], {"j": 1, "k": 2, "l": 3}], "m": true})");
+  ASSERT_TRUE(value);
+  EXPECT_EQ(value->Clone().EstimateMemoryUsage(), value->EstimateMemoryUsage());
+
+  const Value* list = value->FindKey("b");
+  ASSERT_TRUE(list);
+  EXPECT_EQ(list->GetList().size(), list->GetList().capacity());
+}
+
 }  // namespace internal
 }  // namespace base
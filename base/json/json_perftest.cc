@@ -2,14 +2,25 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include "base/files/file.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
 #include "base/json/json_reader.h"
 #include "base/json/json_writer.h"
+#include "base/json/lazy_json_value.h"
 #include "base/memory/ptr_util.h"
+#include "base/strings/stringprintf.h"
+#include "base/test/perf_benchmark.h"
 #include "base/time/time.h"
 #include "base/values.h"
+#include "build/build_config.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/perf/perf_test.h"
 
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+#include <sys/resource.h>
+#endif
+
 namespace base {
 
 namespace {
@@ -47,6 +58,121 @@ std::unique_ptr<DictionaryValue> GenerateLayeredDict(int breadth, int depth) {
   return root;
 }
 
+// Generates a dictionary shaped like a preferences or policy file: nested
+// dictionaries of long strings (mostly URLs, some with escapes or non-ASCII
+// text), lists and scalars. Its pretty-printed size is ~|num_entries| * 1 KB.
+std::unique_ptr<DictionaryValue> GenerateProfileLikeDict(int num_entries) {
+  auto root = std::make_unique<DictionaryValue>();
+  for (int i = 0; i < num_entries; ++i) {
+    auto entry = std::make_unique<DictionaryValue>();
+    entry->SetString(
+        "url", StringPrintf("https://www.example%d.com/path/to/some/resource/"
+                            "index.html?query=%d&session=abcdef0123456789",
+                            i, i * 7));
+    entry->SetString("title",
+                     i % 5 ? StringPrintf("Example page number %d with a "
+                                          "reasonably long title",
+                                          i)
+                           : StringPrintf("Caf\xC3\xA9 \xE6\x97\xA5\xE6"
+                                          "\x9C\xAC %d \"quoted\"\ttext",
+                                          i));
+    entry->SetString("description",
+                     "Lorem ipsum dolor sit amet, consectetur adipiscing elit, "
+                     "sed do eiusmod tempor incididunt ut labore et dolore "
+                     "magna aliqua.\nUt enim ad minim veniam.");
+    entry->SetInteger("visit_count", i);
+    entry->SetDouble("last_visit_time", 13170000000000000.0 + i);
+    entry->SetBoolean("enabled", i % 2 == 0);
+
+    auto patterns = std::make_unique<ListValue>();
+    for (int j = 0; j < 4; ++j) {
+      patterns->AppendString(
+          StringPrintf("[*.]example%d.com/subdirectory%d/*", i, j));
+    }
+    entry->Set("patterns", std::move(patterns));
+
+    root->Set("entry_" + std::to_string(i), std::move(entry));
+  }
+  return root;
+}
+
+// Generates a dictionary shaped like a set of extension manifests: many small
+// dictionaries with short keys, and short lists of short strings.
+std::unique_ptr<DictionaryValue> GenerateManifestLikeDict(int num_extensions) {
+  auto root = std::make_unique<DictionaryValue>();
+  for (int i = 0; i < num_extensions; ++i) {
+    auto manifest = std::make_unique<DictionaryValue>();
+    manifest->SetString("name", StringPrintf("Extension %d", i));
+    manifest->SetString("version", StringPrintf("1.%d.0", i % 13));
+    manifest->SetInteger("manifest_version", 2);
+
+    auto permissions = std::make_unique<ListValue>();
+    permissions->AppendString("tabs");
+    permissions->AppendString("storage");
+    permissions->AppendString(StringPrintf("https://*.example%d.com/*", i));
+    manifest->Set("permissions", std::move(permissions));
+
+    auto content_scripts = std::make_unique<ListValue>();
+    for (int j = 0; j < 3; ++j) {
+      auto script = std::make_unique<DictionaryValue>();
+      auto matches = std::make_unique<ListValue>();
+      matches->AppendString("<all_urls>");
+      script->Set("matches", std::move(matches));
+      auto js = std::make_unique<ListValue>();
+      js->AppendString(StringPrintf("content%d.js", j));
+      script->Set("js", std::move(js));
+      script->SetString("run_at", "document_idle");
+      content_scripts->Append(std::move(script));
+    }
+    manifest->Set("content_scripts", std::move(content_scripts));
+
+    auto icons = std::make_unique<DictionaryValue>();
+    icons->SetString("16", "icon16.png");
+    icons->SetString("48", "icon48.png");
+    icons->SetString("128", "icon128.png");
+    manifest->Set("icons", std::move(icons));
+
+    root->Set(StringPrintf("ext%08d", i), std::move(manifest));
+  }
+  return root;
+}
+
+// Options for the measurements of large inputs, which take milliseconds each.
+PerfBenchmark::Options GetLargeInputOptions() {
+  PerfBenchmark::Options options;
+  options.repetitions = 10;
+  options.time_unit = PerfBenchmark::TimeUnit::kMilliseconds;
+  return options;
+}
+
+// Parses |json| and reports the memory taken by the resulting value and the
+// time it takes to parse and to copy it.
+void TestParseAndClone(const std::string& shape, const std::string& json) {
+  const std::string description = StringPrintf(
+      "%s, %.1f MB", shape.c_str(), json.size() / (1024.0 * 1024.0));
+
+  std::unique_ptr<Value> root;
+  PerfBenchmark("Parse", description, GetLargeInputOptions()).Run([&] {
+    root = JSONReader::Read(json);
+    ASSERT_TRUE(root);
+  });
+  perf_test::PrintResult("ParsedMemory", "", description,
+                         root->EstimateMemoryUsage() / 1024, "KB", true);
+
+  PerfBenchmark("Clone", description, GetLargeInputOptions()).Run([&] {
+    EXPECT_TRUE(root->Clone().is_dict());
+  });
+}
+
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+// Returns the peak resident set size of the process so far, in KB.
+long GetPeakRSSInKB() {
+  struct rusage usage;
+  EXPECT_EQ(0, getrusage(RUSAGE_SELF, &usage));
+  return usage.ru_maxrss;
+}
+#endif
+
 }  // namespace
 
 class JSONPerfTest : public testing::Test {
@@ -73,6 +199,100 @@ class JSONPerfTest : public testing::Test {
   }
 };
 
+TEST_F(JSONPerfTest, ReadLargeProfileLikeJSON) {
+  std::string json;
+  JSONWriter::WriteWithOptions(*GenerateProfileLikeDict(5000),
+                               JSONWriter::OPTIONS_PRETTY_PRINT, &json);
+  const std::string description =
+      StringPrintf("%.1f MB", json.size() / (1024.0 * 1024.0));
+
+  PerfBenchmark::Options options = GetLargeInputOptions();
+  options.bytes_per_operation = json.size();
+  PerfBenchmark("ReadLarge", description, options).Run([&] {
+    ASSERT_TRUE(JSONReader::Read(json));
+  });
+}
+
+TEST_F(JSONPerfTest, ReadFewKeysLazily) {
+  std::string json;
+  JSONWriter::WriteWithOptions(*GenerateProfileLikeDict(5000),
+                               JSONWriter::OPTIONS_PRETTY_PRINT, &json);
+  const std::string description =
+      StringPrintf("%.1f MB", json.size() / (1024.0 * 1024.0));
+
+  PerfBenchmark("ReadFewKeys", description, GetLargeInputOptions()).Run([&] {
+    std::unique_ptr<Value> root = JSONReader::Read(json);
+    ASSERT_TRUE(root);
+    ASSERT_TRUE(root->FindPath({"entry_42", "url"}));
+    ASSERT_TRUE(root->FindPath({"entry_4242", "title"}));
+    ASSERT_TRUE(root->FindPath({"entry_4999", "visit_count"}));
+  });
+
+  PerfBenchmark("ReadFewKeysLazily", description, GetLargeInputOptions())
+      .Run([&] {
+        std::unique_ptr<LazyJSONValue> root = JSONReader::ReadLazily(json);
+        ASSERT_TRUE(root);
+        ASSERT_TRUE(root->FindPath({"entry_42", "url"}));
+        ASSERT_TRUE(root->FindPath({"entry_4242", "title"}));
+        ASSERT_TRUE(root->FindPath({"entry_4999", "visit_count"}));
+      });
+}
+
+TEST_F(JSONPerfTest, ParseAndCloneMemory) {
+  std::string json;
+  JSONWriter::Write(*GenerateProfileLikeDict(5000), &json);
+  TestParseAndClone("Profile", json);
+  JSONWriter::Write(*GenerateManifestLikeDict(2000), &json);
+  TestParseAndClone("Manifests", json);
+}
+
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+// Measures how much writing a large value to a file raises the peak RSS of the
+// process, with and without buffering all of the output. The peak can't be
+// reset, so the streaming writer, which is expected to need less memory, must
+// be measured first.
+TEST_F(JSONPerfTest, WriteLargeValueToFilePeakRSS) {
+  ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  const FilePath path = temp_dir.GetPath().AppendASCII("large.json");
+  auto dict = GenerateProfileLikeDict(50000);
+
+  long peak_rss_before = GetPeakRSSInKB();
+  TimeTicks start = TimeTicks::Now();
+  {
+    File file(path, File::FLAG_CREATE_ALWAYS | File::FLAG_WRITE);
+    ASSERT_TRUE(file.IsValid());
+    JSONWriter::FileSink sink(&file);
+    ASSERT_TRUE(JSONWriter::WriteToSink(*dict, JSONWriter::OPTIONS_PRETTY_PRINT,
+                                        &sink));
+  }
+  TimeDelta elapsed = TimeTicks::Now() - start;
+  long peak_rss_after = GetPeakRSSInKB();
+  perf_test::PrintResult("WriteToFileSink", "", "Time",
+                         elapsed.InMillisecondsF(), "ms", true);
+  perf_test::PrintResult("WriteToFileSink", "", "PeakRSSIncrease",
+                         static_cast<size_t>(peak_rss_after - peak_rss_before),
+                         "KB", true);
+
+  peak_rss_before = peak_rss_after;
+  start = TimeTicks::Now();
+  {
+    std::string json;
+    ASSERT_TRUE(JSONWriter::WriteWithOptions(
+        *dict, JSONWriter::OPTIONS_PRETTY_PRINT, &json));
+    const int size = static_cast<int>(json.size());
+    ASSERT_EQ(size, WriteFile(path, json.data(), size));
+  }
+  elapsed = TimeTicks::Now() - start;
+  peak_rss_after = GetPeakRSSInKB();
+  perf_test::PrintResult("WriteToString", "", "Time",
+                         elapsed.InMillisecondsF(), "ms", true);
+  perf_test::PrintResult("WriteToString", "", "PeakRSSIncrease",
+                         static_cast<size_t>(peak_rss_after - peak_rss_before),
+                         "KB", true);
+}
+#endif  // defined(OS_LINUX) || defined(OS_ANDROID)
+
 TEST_F(JSONPerfTest, StressTest) {
   for (int i = 0; i < 4; ++i) {
     for (int j = 0; j < 12; ++j) {
@@ -8,7 +8,9 @@
 #include <vector>
 
 #include "base/json/json_parser.h"
+#include "base/json/lazy_json_value.h"
 #include "base/logging.h"
+#include "base/memory/ptr_util.h"
 #include "base/optional.h"
 #include "base/values.h"
 
@@ -80,6 +82,29 @@ std::unique_ptr<Value> JSONReader::ReadAndReturnError(
   return root ? std::make_unique<Value>(std::move(*root)) : nullptr;
 }
 
+// static
+std::unique_ptr<LazyJSONValue> JSONReader::ReadLazily(
+    std::string json,
+    int options,
+    int* error_code_out,
+    std::string* error_msg_out) {
+  // The buffer is heap allocated so that moving it into the root doesn't
+  // invalidate StringPieces into a short string.
+  auto buffer = std::make_unique<std::string>(std::move(json));
+  internal::JSONParser parser(options);
+  Optional<internal::JSONParser::LazyValue> root = parser.ParseLazily(*buffer);
+  if (!root) {
+    if (error_code_out)
+      *error_code_out = parser.error_code();
+    if (error_msg_out)
+      *error_msg_out = parser.GetErrorMessage();
+    return nullptr;
+  }
+
+  return WrapUnique(
+      new LazyJSONValue(options, root->type, root->json, std::move(buffer)));
+}
+
 // static
 std::string JSONReader::ErrorCodeToString(JsonParseError error_code) {
   switch (error_code) {
@@ -36,6 +36,7 @@
 
 namespace base {
 
+class LazyJSONValue;
 class Value;
 
 namespace internal {
@@ -111,6 +112,17 @@ class BASE_EXPORT JSONReader {
       int* error_line_out = nullptr,
       int* error_column_out = nullptr);
 
+  // Validates |json| like ReadAndReturnError() but doesn't build a Value:
+  // dictionaries, lists and strings are only parsed when they are accessed
+  // through the returned LazyJSONValue, which keeps |json| in a single buffer.
+  // Prefer this to Read() when only a small part of a large document is used.
+  // |error_code_out| and |error_msg_out| are optional.
+  static std::unique_ptr<LazyJSONValue> ReadLazily(
+      std::string json,
+      int options = JSON_PARSE_RFC,
+      int* error_code_out = nullptr,
+      std::string* error_msg_out = nullptr);
+
   // Converts a JSON parse error code into a human readable message.
   // Returns an empty string if error_code is JSON_NO_ERROR.
   static std::string ErrorCodeToString(JsonParseError error_code);
@@ -9,8 +9,10 @@
 #include <cmath>
 #include <limits>
 
+#include "base/files/file.h"
 #include "base/json/string_escape.h"
 #include "base/logging.h"
+#include "base/numerics/safe_conversions.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/values.h"
@@ -24,6 +26,21 @@ const char kPrettyPrintLineEnding[] = "\r\n";
 const char kPrettyPrintLineEnding[] = "\n";
 #endif
 
+const size_t JSONWriter::kDefaultChunkSize = 64 * 1024;
+
+JSONWriter::FileSink::FileSink(File* file) : file_(file) {
+  DCHECK(file_);
+  DCHECK(file_->IsValid());
+}
+
+JSONWriter::FileSink::~FileSink() = default;
+
+bool JSONWriter::FileSink::Write(StringPiece chunk) {
+  // WriteAtCurrentPos() makes a best effort to write all of |chunk|.
+  const int size = checked_cast<int>(chunk.size());
+  return file_->WriteAtCurrentPos(chunk.data(), size) == size;
+}
+
 // static
 bool JSONWriter::Write(const Value& node, std::string* json) {
   return WriteWithOptions(node, 0, json);
@@ -46,15 +63,62 @@ bool JSONWriter::WriteWithOptions(const Value& node,
   return result;
 }
 
+// static
+bool JSONWriter::WriteToSink(const Value& node,
+                             int options,
+                             Sink* sink,
+                             size_t chunk_size) {
+  DCHECK(sink);
+  DCHECK_GT(chunk_size, 0U);
+
+  JSONWriter writer(options, sink, chunk_size);
+  bool result = writer.BuildJSONString(node, 0U);
+  if (!writer.sink_ok_)
+    return false;
+
+  if (options & OPTIONS_PRETTY_PRINT)
+    writer.json_string_->append(kPrettyPrintLineEnding);
+
+  return writer.Flush() && result;
+}
+
 JSONWriter::JSONWriter(int options, std::string* json)
     : omit_binary_values_((options & OPTIONS_OMIT_BINARY_VALUES) != 0),
       omit_double_type_preservation_(
           (options & OPTIONS_OMIT_DOUBLE_TYPE_PRESERVATION) != 0),
       pretty_print_((options & OPTIONS_PRETTY_PRINT) != 0),
-      json_string_(json) {
+      json_string_(json),
+      sink_(nullptr),
+      chunk_size_(0) {
   DCHECK(json);
 }
 
+JSONWriter::JSONWriter(int options, Sink* sink, size_t chunk_size)
+    : omit_binary_values_((options & OPTIONS_OMIT_BINARY_VALUES) != 0),
+      omit_double_type_preservation_(
+          (options & OPTIONS_OMIT_DOUBLE_TYPE_PRESERVATION) != 0),
+      pretty_print_((options & OPTIONS_PRETTY_PRINT) != 0),
+      json_string_(&buffer_),
+      sink_(sink),
+      chunk_size_(chunk_size) {
+  // Leave room for the value that makes |buffer_| reach |chunk_size_|.
+  buffer_.reserve(chunk_size_ + chunk_size_ / 4);
+}
+
+bool JSONWriter::MaybeFlush() {
+  if (!sink_ || json_string_->size() < chunk_size_)
+    return sink_ok_;
+  return Flush();
+}
+
+bool JSONWriter::Flush() {
+  DCHECK(sink_);
+  if (sink_ok_ && !json_string_->empty())
+    sink_ok_ = sink_->Write(*json_string_);
+  json_string_->clear();
+  return sink_ok_;
+}
+
 bool JSONWriter::BuildJSONString(const Value& node, size_t depth) {
   switch (node.type()) {
     case Value::Type::NONE: {
@@ -139,6 +203,8 @@ bool JSONWriter::BuildJSONString(const Value& node, size_t depth) {
 
         if (!BuildJSONString(value, depth))
           result = false;
+        if (!MaybeFlush())
+          return false;
 
         first_value_has_been_output = true;
       }
@@ -180,6 +246,8 @@ bool JSONWriter::BuildJSONString(const Value& node, size_t depth) {
 
         if (!BuildJSONString(itr.value(), depth + 1U))
           result = false;
+        if (!MaybeFlush())
+          return false;
 
         first_value_has_been_output = true;
       }
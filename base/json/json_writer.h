@@ -11,9 +11,11 @@
 
 #include "base/base_export.h"
 #include "base/macros.h"
+#include "base/strings/string_piece.h"
 
 namespace base {
 
+class File;
 class Value;
 
 class BASE_EXPORT JSONWriter {
@@ -36,6 +38,35 @@ class BASE_EXPORT JSONWriter {
     OPTIONS_PRETTY_PRINT = 1 << 2,
   };
 
+  // Receives the output of WriteToSink() in chunks.
+  class BASE_EXPORT Sink {
+   public:
+    virtual ~Sink() = default;
+
+    // Called with each chunk of the output, in order. Returns false on error,
+    // in which case writing is aborted.
+    virtual bool Write(StringPiece chunk) = 0;
+  };
+
+  // A Sink that writes to |file| at its current position. |file| must be
+  // valid and outlive the sink.
+  class BASE_EXPORT FileSink : public Sink {
+   public:
+    explicit FileSink(File* file);
+    ~FileSink() override;
+
+    // Sink:
+    bool Write(StringPiece chunk) override;
+
+   private:
+    File* const file_;
+
+    DISALLOW_COPY_AND_ASSIGN(FileSink);
+  };
+
+  // The default size of the chunks passed to a Sink by WriteToSink().
+  static const size_t kDefaultChunkSize;
+
   // Given a root node, generates a JSON string and puts it into |json|.
   // The output string is overwritten and not appended.
   //
@@ -50,8 +81,27 @@ class BASE_EXPORT JSONWriter {
                                int options,
                                std::string* json);
 
+  // Same as WriteWithOptions() but passes the output to |sink| as it is
+  // generated instead of holding all of it in memory. Chunks are of about
+  // |chunk_size| bytes, but can be larger when a single string or number
+  // doesn't fit. Returns false on failure, including when |sink| fails, in
+  // which case |sink| may have received part of the output.
+  static bool WriteToSink(const Value& node,
+                          int options,
+                          Sink* sink,
+                          size_t chunk_size = kDefaultChunkSize);
+
  private:
   JSONWriter(int options, std::string* json);
+  JSONWriter(int options, Sink* sink, size_t chunk_size);
+
+  // Passes the output generated so far to |sink_| if there is enough of it.
+  // Returns false if |sink_| failed.
+  bool MaybeFlush();
+
+  // Passes the output generated so far to |sink_|. Returns false if |sink_|
+  // failed.
+  bool Flush();
 
   // Called recursively to build the JSON string. When completed,
   // |json_string_| will contain the JSON.
@@ -67,6 +117,15 @@ class BASE_EXPORT JSONWriter {
   // Where we write JSON data as we generate it.
   std::string* json_string_;
 
+  // Used by WriteToSink(): output is generated into |buffer_|, which is
+  // emptied into |sink_| whenever it holds |chunk_size_| bytes or more.
+  std::string buffer_;
+  Sink* const sink_;
+  const size_t chunk_size_;
+
+  // False once |sink_| failed.
+  bool sink_ok_ = true;
+
   DISALLOW_COPY_AND_ASSIGN(JSONWriter);
 };
 
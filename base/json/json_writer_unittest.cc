@@ -4,13 +4,73 @@
 
 #include "base/json/json_writer.h"
 
+#include <stdint.h>
+
+#include <vector>
+
+#include "base/files/file.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/macros.h"
 #include "base/memory/ptr_util.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/values.h"
 #include "build/build_config.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace base {
 
+namespace {
+
+// A Sink that records the chunks it receives, and fails after
+// |max_num_chunks| of them.
+class RecordingSink : public JSONWriter::Sink {
+ public:
+  explicit RecordingSink(size_t max_num_chunks = SIZE_MAX)
+      : max_num_chunks_(max_num_chunks) {}
+
+  // JSONWriter::Sink:
+  bool Write(StringPiece chunk) override {
+    if (chunks_.size() == max_num_chunks_)
+      return false;
+    chunks_.push_back(chunk.as_string());
+    return true;
+  }
+
+  const std::vector<std::string>& chunks() const { return chunks_; }
+
+  std::string Concatenated() const {
+    std::string result;
+    for (const std::string& chunk : chunks_)
+      result += chunk;
+    return result;
+  }
+
+ private:
+  const size_t max_num_chunks_;
+  std::vector<std::string> chunks_;
+
+  DISALLOW_COPY_AND_ASSIGN(RecordingSink);
+};
+
+Value CreateLargeValue() {
+  Value list(Value::Type::LIST);
+  for (int i = 0; i < 100; ++i) {
+    Value dict(Value::Type::DICTIONARY);
+    dict.SetKey("index", Value(i));
+    dict.SetKey("name", Value("item " + IntToString(i)));
+    dict.SetKey("ratio", Value(i / 7.0));
+    Value nested(Value::Type::LIST);
+    nested.GetList().emplace_back(true);
+    nested.GetList().emplace_back(Value::Type::NONE);
+    dict.SetKey("nested", std::move(nested));
+    list.GetList().push_back(std::move(dict));
+  }
+  return list;
+}
+
+}  // namespace
+
 TEST(JSONWriterTest, BasicTypes) {
   std::string output_js;
 
@@ -151,4 +211,78 @@ TEST(JSONWriterTest, DoublesAsInts) {
   EXPECT_EQ("10000000000", output_js);
 }
 
+TEST(JSONWriterTest, WriteToSink) {
+  const Value value = CreateLargeValue();
+  for (int options : {0, static_cast<int>(JSONWriter::OPTIONS_PRETTY_PRINT)}) {
+    std::string expected;
+    EXPECT_TRUE(JSONWriter::WriteWithOptions(value, options, &expected));
+
+    for (size_t chunk_size : {size_t{1}, size_t{100}, size_t{1000},
+                              JSONWriter::kDefaultChunkSize}) {
+      SCOPED_TRACE(chunk_size);
+      RecordingSink sink;
+      EXPECT_TRUE(JSONWriter::WriteToSink(value, options, &sink, chunk_size));
+      EXPECT_EQ(expected, sink.Concatenated());
+
+      // No chunk is much larger than |chunk_size|.
+      for (const std::string& chunk : sink.chunks()) {
+        EXPECT_FALSE(chunk.empty());
+        EXPECT_LT(chunk.size(), chunk_size + 200);
+      }
+      if (chunk_size < expected.size())
+        EXPECT_GT(sink.chunks().size(), 1U);
+    }
+  }
+}
+
+TEST(JSONWriterTest, WriteToSinkBinaryValues) {
+  ListValue binary_list;
+  binary_list.Append(Value::CreateWithCopiedBuffer("asdf", 4));
+  binary_list.AppendInteger(5);
+  binary_list.Append(Value::CreateWithCopiedBuffer("asdf", 4));
+
+  RecordingSink sink;
+  EXPECT_FALSE(JSONWriter::WriteToSink(binary_list, 0, &sink));
+
+  RecordingSink omitting_sink;
+  EXPECT_TRUE(JSONWriter::WriteToSink(
+      binary_list, JSONWriter::OPTIONS_OMIT_BINARY_VALUES, &omitting_sink));
+  EXPECT_EQ("[5]", omitting_sink.Concatenated());
+}
+
+TEST(JSONWriterTest, WriteToFailingSink) {
+  const Value value = CreateLargeValue();
+
+  // Writing stops at the first failure.
+  RecordingSink sink(3);
+  EXPECT_FALSE(JSONWriter::WriteToSink(value, 0, &sink, 100));
+  EXPECT_EQ(3U, sink.chunks().size());
+
+  RecordingSink sink_failing_immediately(0);
+  EXPECT_FALSE(
+      JSONWriter::WriteToSink(Value(42), 0, &sink_failing_immediately));
+}
+
+TEST(JSONWriterTest, WriteToFileSink) {
+  ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  const FilePath path = temp_dir.GetPath().AppendASCII("test.json");
+
+  const Value value = CreateLargeValue();
+  {
+    File file(path, File::FLAG_CREATE_ALWAYS | File::FLAG_WRITE);
+    ASSERT_TRUE(file.IsValid());
+    JSONWriter::FileSink sink(&file);
+    EXPECT_TRUE(JSONWriter::WriteToSink(
+        value, JSONWriter::OPTIONS_PRETTY_PRINT, &sink, 256));
+  }
+
+  std::string expected;
+  EXPECT_TRUE(JSONWriter::WriteWithOptions(
+      value, JSONWriter::OPTIONS_PRETTY_PRINT, &expected));
+  std::string contents;
+  EXPECT_TRUE(ReadFileToString(path, &contents));
+  EXPECT_EQ(expected, contents);
+}
+
 }  // namespace base
@@ -0,0 +1,123 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/json/lazy_json_value.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/json/json_parser.h"
+#include "base/logging.h"
+#include "base/memory/ptr_util.h"
+#include "base/optional.h"
+
+namespace base {
+
+LazyJSONValue::LazyJSONValue(int options,
+                             Value::Type type,
+                             StringPiece json,
+                             std::unique_ptr<std::string> buffer)
+    : options_(options), type_(type), json_(json), buffer_(std::move(buffer)) {}
+
+LazyJSONValue::~LazyJSONValue() = default;
+
+size_t LazyJSONValue::size() const {
+  EnsureIndexed();
+  return members_.size();
+}
+
+const LazyJSONValue* LazyJSONValue::FindKey(StringPiece key) const {
+  if (!is_dict())
+    return nullptr;
+  EnsureIndexed();
+
+  auto it = std::lower_bound(
+      members_.begin(), members_.end(), key,
+      [](const std::unique_ptr<LazyJSONValue>& member, StringPiece key) {
+        return member->key_ < key;
+      });
+  if (it == members_.end() || (*it)->key_ != key)
+    return nullptr;
+  return it->get();
+}
+
+const LazyJSONValue* LazyJSONValue::FindPath(
+    std::initializer_list<StringPiece> path) const {
+  const LazyJSONValue* cur = this;
+  for (StringPiece component : path) {
+    cur = cur->FindKey(component);
+    if (!cur)
+      return nullptr;
+  }
+  return cur;
+}
+
+const LazyJSONValue* LazyJSONValue::GetListItem(size_t index) const {
+  if (!is_list())
+    return nullptr;
+  EnsureIndexed();
+
+  if (index >= members_.size())
+    return nullptr;
+  return members_[index].get();
+}
+
+const Value& LazyJSONValue::value() const {
+  if (!value_) {
+    // The document was validated by JSONReader::ReadLazily(), so this can
+    // only fail if the buffer was modified.
+    internal::JSONParser parser(options_);
+    Optional<Value> value = parser.Parse(json_);
+    DCHECK(value) << parser.GetErrorMessage();
+    value_ = value ? std::make_unique<Value>(std::move(*value))
+                   : std::make_unique<Value>();
+  }
+  return *value_;
+}
+
+void LazyJSONValue::EnsureIndexed() const {
+  if (indexed_)
+    return;
+  indexed_ = true;
+  if (!is_dict() && !is_list())
+    return;
+
+  internal::JSONParser parser(options_);
+  std::vector<internal::JSONParser::LazyValue> lazy_members;
+  bool indexed = parser.IndexContainer(json_, &lazy_members);
+  DCHECK(indexed) << parser.GetErrorMessage();
+
+  members_.reserve(lazy_members.size());
+  for (internal::JSONParser::LazyValue& lazy_member : lazy_members) {
+    std::unique_ptr<LazyJSONValue> member = WrapUnique(new LazyJSONValue(
+        options_, lazy_member.type, lazy_member.json, nullptr));
+    if (lazy_member.decoded_key) {
+      member->decoded_key_ = std::move(*lazy_member.decoded_key);
+      member->key_ = member->decoded_key_;
+    } else {
+      member->key_ = lazy_member.key;
+    }
+    members_.push_back(std::move(member));
+  }
+
+  if (!is_dict())
+    return;
+
+  // Sort members by key for lookups, keeping the last of duplicate keys like
+  // Value::DictStorage(KEEP_LAST_OF_DUPES) does.
+  std::stable_sort(members_.begin(), members_.end(),
+                   [](const std::unique_ptr<LazyJSONValue>& lhs,
+                      const std::unique_ptr<LazyJSONValue>& rhs) {
+                     return lhs->key_ < rhs->key_;
+                   });
+  auto last_of_dupes = std::unique(
+      members_.rbegin(), members_.rend(),
+      [](const std::unique_ptr<LazyJSONValue>& lhs,
+         const std::unique_ptr<LazyJSONValue>& rhs) {
+        return lhs->key_ == rhs->key_;
+      });
+  members_.erase(members_.begin(), last_of_dupes.base());
+}
+
+}  // namespace base
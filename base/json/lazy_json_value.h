@@ -0,0 +1,119 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_JSON_LAZY_JSON_VALUE_H_
+#define BASE_JSON_LAZY_JSON_VALUE_H_
+
+#include <stddef.h>
+
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/base_export.h"
+#include "base/macros.h"
+#include "base/strings/string_piece.h"
+#include "base/values.h"
+
+namespace base {
+
+class JSONReader;
+
+// A JSON value that is only parsed as far as it is accessed. Returned by
+// JSONReader::ReadLazily().
+//
+// The whole document is validated when it is read, but no Value is built and
+// no string is copied: a LazyJSONValue records the type of a value and the
+// extent of its JSON text in the document, which is kept in a single buffer.
+// The members of a dictionary or the items of a list are indexed the first
+// time they are accessed, and a Value is only built when value() is called.
+// This makes reading a few keys out of a large document much cheaper than
+// building the full Value tree with JSONReader::Read().
+//
+// Members are owned by their container and point into the buffer owned by
+// the root, so they must not outlive the root. This class is not thread-safe,
+// even for const methods.
+//
+// Example:
+//   std::unique_ptr<LazyJSONValue> root = JSONReader::ReadLazily(json);
+//   const LazyJSONValue* homepage = root->FindPath({"browser", "homepage"});
+//   if (homepage && homepage->type() == Value::Type::STRING)
+//     ... homepage->value().GetString() ...
+class BASE_EXPORT LazyJSONValue {
+ public:
+  ~LazyJSONValue();
+
+  Value::Type type() const { return type_; }
+  bool is_dict() const { return type_ == Value::Type::DICTIONARY; }
+  bool is_list() const { return type_ == Value::Type::LIST; }
+
+  // Returns the JSON text of this value.
+  StringPiece json() const { return json_; }
+
+  // Returns the number of members of a dictionary or the number of items of a
+  // list. Returns 0 for other types.
+  size_t size() const;
+
+  // Returns the member of a dictionary with |key|, or nullptr if there is none
+  // or if this is not a dictionary. As with JSONReader::Read(), the last
+  // member wins if |key| appears several times.
+  const LazyJSONValue* FindKey(StringPiece key) const;
+
+  // Same as FindKey() for each component of |path| in turn, like
+  // Value::FindPath().
+  const LazyJSONValue* FindPath(std::initializer_list<StringPiece> path) const;
+
+  // Returns the item at |index| of a list, or nullptr if |index| is out of
+  // range or if this is not a list.
+  const LazyJSONValue* GetListItem(size_t index) const;
+
+  // Returns this value, including all its nested values, as a Value. It is
+  // built on the first call.
+  const Value& value() const;
+
+ private:
+  friend class JSONReader;
+
+  // Constructs a root value whose JSON text is all of |*buffer|, except for
+  // surrounding whitespace.
+  LazyJSONValue(int options,
+                Value::Type type,
+                StringPiece json,
+                std::unique_ptr<std::string> buffer);
+
+  // Indexes the members or items of this container, if it hasn't been done
+  // yet.
+  void EnsureIndexed() const;
+
+  // base::JSONParserOptions used to parse the document.
+  const int options_;
+
+  const Value::Type type_;
+
+  // Points into the buffer owned by the root.
+  const StringPiece json_;
+
+  // The key of a dictionary member. Points into the buffer owned by the root,
+  // or into |decoded_key_|.
+  StringPiece key_;
+  std::string decoded_key_;
+
+  // Members or items of a container, once indexed. Dictionary members are
+  // sorted by key, without duplicates.
+  mutable bool indexed_ = false;
+  mutable std::vector<std::unique_ptr<LazyJSONValue>> members_;
+
+  // Built by value().
+  mutable std::unique_ptr<Value> value_;
+
+  // The document. Only set on the root.
+  const std::unique_ptr<std::string> buffer_;
+
+  DISALLOW_COPY_AND_ASSIGN(LazyJSONValue);
+};
+
+}  // namespace base
+
+#endif  // BASE_JSON_LAZY_JSON_VALUE_H_
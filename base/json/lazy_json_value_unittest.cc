@@ -0,0 +1,187 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/json/lazy_json_value.h"
+
+#include <memory>
+#include <string>
+
+#include "base/json/json_reader.h"
+#include "base/values.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+const char kDocument[] =
+    "  {\n"
+    "    \"browser\": {\n"
+    "      \"homepage\": \"https://www.example.com/\",\n"
+    "      \"show_home_button\": true,\n"
+    "      \"window\": { \"width\": 800, \"zoom\": 1.5 }\n"
+    "    },\n"
+    "    // Comments are ignored.\n"
+    "    \"history\": [ \"a\", [ 1, 2 ], null, { \"k\": \"v\" } ],\n"
+    "    \"esc\\u0061ped\": \"tab\\there\",\n"
+    "    \"dup\": 1,\n"
+    "    \"empty\": {},\n"
+    "    \"dup\": 2\n"
+    "  }  ";
+
+}  // namespace
+
+TEST(LazyJSONValueTest, FindKey) {
+  std::unique_ptr<LazyJSONValue> root = JSONReader::ReadLazily(kDocument);
+  ASSERT_TRUE(root);
+  ASSERT_TRUE(root->is_dict());
+  EXPECT_EQ('{', root->json().front());
+  EXPECT_EQ('}', root->json().back());
+  EXPECT_EQ(5U, root->size());
+
+  const LazyJSONValue* browser = root->FindKey("browser");
+  ASSERT_TRUE(browser);
+  EXPECT_TRUE(browser->is_dict());
+  EXPECT_EQ(3U, browser->size());
+
+  const LazyJSONValue* homepage = browser->FindKey("homepage");
+  ASSERT_TRUE(homepage);
+  EXPECT_EQ(Value::Type::STRING, homepage->type());
+  EXPECT_EQ("\"https://www.example.com/\"", homepage->json());
+  EXPECT_EQ("https://www.example.com/", homepage->value().GetString());
+
+  EXPECT_EQ(Value::Type::BOOLEAN, browser->FindKey("show_home_button")->type());
+  EXPECT_EQ(Value::Type::INTEGER,
+            root->FindPath({"browser", "window", "width"})->type());
+  EXPECT_EQ(800,
+            root->FindPath({"browser", "window", "width"})->value().GetInt());
+  EXPECT_EQ(Value::Type::DOUBLE,
+            root->FindPath({"browser", "window", "zoom"})->type());
+
+  EXPECT_FALSE(root->FindKey("missing"));
+  EXPECT_FALSE(root->FindPath({"browser", "missing"}));
+  EXPECT_FALSE(root->FindPath({"browser", "homepage", "missing"}));
+  EXPECT_FALSE(homepage->FindKey("missing"));
+  EXPECT_EQ(0U, homepage->size());
+
+  const LazyJSONValue* empty = root->FindKey("empty");
+  ASSERT_TRUE(empty);
+  EXPECT_TRUE(empty->is_dict());
+  EXPECT_EQ(0U, empty->size());
+}
+
+TEST(LazyJSONValueTest, EscapedKey) {
+  std::unique_ptr<LazyJSONValue> root = JSONReader::ReadLazily(kDocument);
+  ASSERT_TRUE(root);
+  const LazyJSONValue* escaped = root->FindKey("escaped");
+  ASSERT_TRUE(escaped);
+  EXPECT_EQ("tab\there", escaped->value().GetString());
+  EXPECT_FALSE(root->FindKey("esc\\u0061ped"));
+}
+
+TEST(LazyJSONValueTest, DuplicateKeys) {
+  std::unique_ptr<LazyJSONValue> root = JSONReader::ReadLazily(kDocument);
+  ASSERT_TRUE(root);
+  const LazyJSONValue* dup = root->FindKey("dup");
+  ASSERT_TRUE(dup);
+  EXPECT_EQ(2, dup->value().GetInt());
+}
+
+TEST(LazyJSONValueTest, List) {
+  std::unique_ptr<LazyJSONValue> root = JSONReader::ReadLazily(kDocument);
+  ASSERT_TRUE(root);
+  const LazyJSONValue* history = root->FindKey("history");
+  ASSERT_TRUE(history);
+  ASSERT_TRUE(history->is_list());
+  ASSERT_EQ(4U, history->size());
+
+  EXPECT_EQ(Value::Type::STRING, history->GetListItem(0)->type());
+  EXPECT_EQ(Value::Type::LIST, history->GetListItem(1)->type());
+  EXPECT_EQ(2U, history->GetListItem(1)->size());
+  EXPECT_EQ(2, history->GetListItem(1)->GetListItem(1)->value().GetInt());
+  EXPECT_EQ(Value::Type::NONE, history->GetListItem(2)->type());
+  EXPECT_EQ("v", history->GetListItem(3)->FindKey("k")->value().GetString());
+  EXPECT_FALSE(history->GetListItem(4));
+
+  EXPECT_FALSE(history->FindKey("k"));
+  EXPECT_FALSE(root->GetListItem(0));
+}
+
+TEST(LazyJSONValueTest, ValueMatchesRead) {
+  std::unique_ptr<Value> expected = JSONReader::Read(kDocument);
+  ASSERT_TRUE(expected);
+
+  std::unique_ptr<LazyJSONValue> root = JSONReader::ReadLazily(kDocument);
+  ASSERT_TRUE(root);
+  EXPECT_EQ(*expected, root->value());
+  EXPECT_EQ(*expected->FindKey("history"), root->FindKey("history")->value());
+  EXPECT_EQ(*expected->FindPath({"browser", "window"}),
+            root->FindPath({"browser", "window"})->value());
+
+  // Values built before and after indexing are the same.
+  std::unique_ptr<LazyJSONValue> other_root =
+      JSONReader::ReadLazily(kDocument);
+  ASSERT_TRUE(other_root);
+  EXPECT_EQ(3U, other_root->FindKey("browser")->size());
+  EXPECT_EQ(*expected, other_root->value());
+}
+
+TEST(LazyJSONValueTest, Scalars) {
+  std::unique_ptr<LazyJSONValue> root = JSONReader::ReadLazily("  42 ");
+  ASSERT_TRUE(root);
+  EXPECT_EQ(Value::Type::INTEGER, root->type());
+  EXPECT_EQ("42", root->json());
+  EXPECT_EQ(42, root->value().GetInt());
+
+  root = JSONReader::ReadLazily("\xEF\xBB\xBF\"bom\"");
+  ASSERT_TRUE(root);
+  EXPECT_EQ("bom", root->value().GetString());
+}
+
+TEST(LazyJSONValueTest, Errors) {
+  const char* const kInvalidDocuments[] = {
+      "",
+      "{\"a\": [1, 2,]}",
+      "{\"a\": {\"b\": \"\\q\"}}",
+      "{\"a\": {\"b\": nul}}",
+      "[1, 2] 3",
+      "{\"a\" 1}",
+      "[\"unterminated]",
+  };
+  for (const char* json : kInvalidDocuments) {
+    SCOPED_TRACE(json);
+    int expected_error_code = 0;
+    std::string expected_error_message;
+    EXPECT_FALSE(JSONReader::ReadAndReturnError(json, JSON_PARSE_RFC,
+                                                &expected_error_code,
+                                                &expected_error_message));
+
+    int error_code = 0;
+    std::string error_message;
+    EXPECT_FALSE(JSONReader::ReadLazily(json, JSON_PARSE_RFC, &error_code,
+                                        &error_message));
+    EXPECT_EQ(expected_error_code, error_code);
+    EXPECT_EQ(expected_error_message, error_message);
+  }
+
+  std::string too_deep(JSONReader::kStackMaxDepth + 1, '[');
+  too_deep.append(JSONReader::kStackMaxDepth + 1, ']');
+  int error_code = 0;
+  EXPECT_FALSE(JSONReader::ReadLazily(too_deep, JSON_PARSE_RFC, &error_code));
+  EXPECT_EQ(JSONReader::JSON_TOO_MUCH_NESTING, error_code);
+}
+
+TEST(LazyJSONValueTest, Options) {
+  const char kTrailingCommas[] = "{\"a\": [1, 2,], \"b\": {\"c\": 3,},}";
+  EXPECT_FALSE(JSONReader::ReadLazily(kTrailingCommas));
+
+  std::unique_ptr<LazyJSONValue> root =
+      JSONReader::ReadLazily(kTrailingCommas, JSON_ALLOW_TRAILING_COMMAS);
+  ASSERT_TRUE(root);
+  EXPECT_EQ(2U, root->FindKey("a")->size());
+  EXPECT_EQ(3, root->FindPath({"b", "c"})->value().GetInt());
+  EXPECT_EQ(2U, root->value().FindKey("a")->GetList().size());
+}
+
+}  // namespace base
@@ -4,6 +4,7 @@
 
 #include "base/memory/memory_pressure_listener.h"
 
+#include "base/memory/memory_reclaimer.h"
 #include "base/observer_list_threadsafe.h"
 #include "base/trace_event/trace_event.h"
 
@@ -124,6 +125,7 @@ void MemoryPressureListener::DoNotifyMemoryPressure(
   DCHECK_NE(memory_pressure_level, MEMORY_PRESSURE_LEVEL_NONE);
 
   GetMemoryPressureObserver()->Notify(memory_pressure_level);
+  MemoryReclaimer::GetInstance()->OnMemoryPressure(memory_pressure_level);
 }
 
 }  // namespace base
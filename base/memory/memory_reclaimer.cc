@@ -0,0 +1,188 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/memory/memory_reclaimer.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "base/bind.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "base/trace_event/trace_event.h"
+
+namespace base {
+
+namespace {
+
+// Fraction of the reclaimable memory freed at moderate pressure.
+const double kModerateReclaimFraction = 0.5;
+
+// Estimated cost that may be spent freeing memory at moderate pressure.
+constexpr TimeDelta kModerateCostBudget = TimeDelta::FromMilliseconds(100);
+
+// Bytes freed per microsecond of cost, with free reclamation first.
+double GetBenefitPerCost(const MemoryReclaimer::Estimate& estimate) {
+  if (estimate.cost <= TimeDelta())
+    return std::numeric_limits<double>::infinity();
+  return estimate.reclaimable_bytes / estimate.cost.InMicrosecondsF();
+}
+
+}  // namespace
+
+MemoryReclaimer::Reclamation::Reclamation() = default;
+
+MemoryReclaimer::Reclamation::~Reclamation() = default;
+
+// static
+MemoryReclaimer* MemoryReclaimer::GetInstance() {
+  return Singleton<MemoryReclaimer,
+                   LeakySingletonTraits<MemoryReclaimer>>::get();
+}
+
+MemoryReclaimer::MemoryReclaimer() = default;
+
+MemoryReclaimer::~MemoryReclaimer() = default;
+
+void MemoryReclaimer::Register(Client* client) {
+  // Like MemoryCoordinatorClientRegistry, ignore clients on threads which
+  // can't be posted to.
+  if (!SequencedTaskRunnerHandle::IsSet())
+    return;
+
+  AutoLock lock(lock_);
+  DCHECK(!clients_.count(client));
+  clients_[client] = SequencedTaskRunnerHandle::Get();
+}
+
+void MemoryReclaimer::Unregister(Client* client) {
+  AutoLock lock(lock_);
+  clients_.erase(client);
+}
+
+void MemoryReclaimer::OnMemoryPressure(
+    MemoryPressureListener::MemoryPressureLevel level) {
+  DCHECK_NE(level, MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE);
+  AutoLock lock(lock_);
+
+  if (reclamation_) {
+    if (level == MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL &&
+        reclamation_->level != level) {
+      reclamation_->level = level;
+      // The target is set once all estimates are in.
+      if (!reclamation_->pending_estimates)
+        SetTargetLocked();
+    }
+    return;
+  }
+  if (clients_.empty())
+    return;
+
+  TRACE_EVENT_ASYNC_BEGIN1("memory", "MemoryReclaimer::Reclaim", this,
+                           "level", level);
+  reclamation_ = std::make_unique<Reclamation>();
+  reclamation_->level = level;
+  reclamation_->pending_estimates = clients_.size();
+  for (const auto& entry : clients_) {
+    reclamation_->candidates.push_back({entry.first, entry.second, Estimate()});
+    entry.second->PostTask(
+        FROM_HERE,
+        BindOnce(&MemoryReclaimer::EstimateOnClientSequence, Unretained(this),
+                 entry.first, reclamation_->candidates.size() - 1));
+  }
+}
+
+bool MemoryReclaimer::IsRegistered(Client* client) {
+  AutoLock lock(lock_);
+  return clients_.count(client);
+}
+
+void MemoryReclaimer::EstimateOnClientSequence(Client* client, size_t index) {
+  // |client| can only be unregistered on this sequence, so it stays
+  // registered until this returns.
+  Estimate estimate;
+  if (IsRegistered(client))
+    estimate = client->EstimateReclaim();
+
+  AutoLock lock(lock_);
+  reclamation_->candidates[index].estimate = estimate;
+  if (--reclamation_->pending_estimates)
+    return;
+  StartReclaimingLocked();
+}
+
+void MemoryReclaimer::ReclaimOnClientSequence(Client* client, size_t bytes) {
+  size_t bytes_freed = 0;
+  if (IsRegistered(client)) {
+    TRACE_EVENT1("memory", "MemoryReclaimer::ReclaimOnClientSequence", "bytes",
+                 bytes);
+    bytes_freed = client->Reclaim(bytes);
+  }
+
+  AutoLock lock(lock_);
+  reclamation_->remaining_bytes -=
+      std::min(bytes_freed, reclamation_->remaining_bytes);
+  ReclaimNextLocked();
+}
+
+void MemoryReclaimer::StartReclaimingLocked() {
+  std::vector<Candidate>& candidates = reclamation_->candidates;
+  candidates.erase(std::remove_if(candidates.begin(), candidates.end(),
+                                  [](const Candidate& candidate) {
+                                    return !candidate.estimate
+                                                .reclaimable_bytes;
+                                  }),
+                   candidates.end());
+  std::stable_sort(candidates.begin(), candidates.end(),
+                   [](const Candidate& a, const Candidate& b) {
+                     return GetBenefitPerCost(a.estimate) >
+                            GetBenefitPerCost(b.estimate);
+                   });
+  SetTargetLocked();
+  ReclaimNextLocked();
+}
+
+void MemoryReclaimer::SetTargetLocked() {
+  if (reclamation_->level ==
+      MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL) {
+    reclamation_->remaining_bytes = std::numeric_limits<size_t>::max();
+    reclamation_->remaining_cost = TimeDelta::Max();
+    return;
+  }
+
+  size_t reclaimable_bytes = 0;
+  for (const Candidate& candidate : reclamation_->candidates)
+    reclaimable_bytes += candidate.estimate.reclaimable_bytes;
+  reclamation_->remaining_bytes = reclaimable_bytes * kModerateReclaimFraction;
+  reclamation_->remaining_cost = kModerateCostBudget;
+}
+
+void MemoryReclaimer::ReclaimNextLocked() {
+  std::vector<Candidate>& candidates = reclamation_->candidates;
+  while (reclamation_->remaining_bytes &&
+         reclamation_->next_candidate < candidates.size()) {
+    const Candidate& candidate = candidates[reclamation_->next_candidate++];
+    size_t bytes = std::min(reclamation_->remaining_bytes,
+                            candidate.estimate.reclaimable_bytes);
+
+    // Only the part of the estimated cost for the bytes asked for is spent.
+    TimeDelta cost = TimeDelta::FromMicrosecondsD(
+        candidate.estimate.cost.InMicrosecondsF() * bytes /
+        candidate.estimate.reclaimable_bytes);
+    if (!reclamation_->remaining_cost.is_max()) {
+      if (cost > reclamation_->remaining_cost)
+        continue;
+      reclamation_->remaining_cost -= cost;
+    }
+
+    candidate.task_runner->PostTask(
+        FROM_HERE, BindOnce(&MemoryReclaimer::ReclaimOnClientSequence,
+                            Unretained(this), candidate.client, bytes));
+    return;
+  }
+
+  TRACE_EVENT_ASYNC_END0("memory", "MemoryReclaimer::Reclaim", this);
+  reclamation_.reset();
+}
+
+}  // namespace base
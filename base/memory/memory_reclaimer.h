@@ -0,0 +1,125 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_MEMORY_MEMORY_RECLAIMER_H_
+#define BASE_MEMORY_MEMORY_RECLAIMER_H_
+
+#include <stddef.h>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "base/base_export.h"
+#include "base/macros.h"
+#include "base/memory/memory_pressure_listener.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/singleton.h"
+#include "base/sequenced_task_runner.h"
+#include "base/synchronization/lock.h"
+#include "base/time/time.h"
+
+namespace base {
+
+// MemoryReclaimer frees memory under memory pressure in graded steps instead
+// of having every subsystem drop its caches at once.
+//
+// Clients estimate how much memory they can free and what it costs to free
+// it and to re-create it later. On memory pressure, the reclaimer asks clients
+// for these estimates and then has them free memory one after the other, in
+// decreasing order of bytes freed per unit of cost, until a target is met:
+//  * At MEMORY_PRESSURE_LEVEL_MODERATE, a fraction of the reclaimable memory
+//    is freed within a budget of estimated cost.
+//  * At MEMORY_PRESSURE_LEVEL_CRITICAL, all of it is freed.
+//
+// Clients that adopt the reclaimer should stop reacting to moderate pressure
+// through MemoryPressureListener, which would defeat the grading.
+//
+// Threading guarantees:
+//  * Registering/unregistering clients is thread-safe.
+//  * Clients are called on the sequence on which they were registered, one
+//    at a time, and never after they have been unregistered.
+//
+// Ownership management:
+// This class doesn't take the ownership of clients. Clients must be
+// unregistered before they are destroyed.
+class BASE_EXPORT MemoryReclaimer {
+ public:
+  struct Estimate {
+    // Bytes of memory which the client can free.
+    size_t reclaimable_bytes = 0;
+    // Time it takes to free |reclaimable_bytes| and to re-create them when
+    // they are needed again.
+    TimeDelta cost;
+  };
+
+  class BASE_EXPORT Client {
+   public:
+    virtual Estimate EstimateReclaim() = 0;
+
+    // Frees at least |bytes| if possible, returning the number of bytes
+    // actually freed.
+    virtual size_t Reclaim(size_t bytes) = 0;
+
+   protected:
+    virtual ~Client() = default;
+  };
+
+  static MemoryReclaimer* GetInstance();
+
+  // Most code should use GetInstance(). A MemoryReclaimer must outlive the
+  // tasks it posts to its clients.
+  MemoryReclaimer();
+  ~MemoryReclaimer();
+
+  // Registers/unregisters a client. Does not take ownership of client.
+  void Register(Client* client);
+  void Unregister(Client* client);
+
+  // Starts reclaiming memory for |level|. Pressure reported while memory is
+  // being reclaimed only raises the target of the ongoing reclamation.
+  void OnMemoryPressure(MemoryPressureListener::MemoryPressureLevel level);
+
+ private:
+  struct Candidate {
+    Client* client;
+    scoped_refptr<SequencedTaskRunner> task_runner;
+    Estimate estimate;
+  };
+
+  struct Reclamation {
+    Reclamation();
+    ~Reclamation();
+
+    MemoryPressureListener::MemoryPressureLevel level;
+    std::vector<Candidate> candidates;
+    size_t pending_estimates = 0;
+    size_t next_candidate = 0;
+    size_t remaining_bytes = 0;
+    TimeDelta remaining_cost;
+  };
+
+  bool IsRegistered(Client* client);
+  void EstimateOnClientSequence(Client* client, size_t index);
+  void ReclaimOnClientSequence(Client* client, size_t bytes);
+
+  // Sorts the candidates by bytes freed per unit of cost and starts asking
+  // them to free memory.
+  void StartReclaimingLocked();
+  void SetTargetLocked();
+  // Asks the next candidate that fits in the remaining budget to free memory,
+  // or ends the reclamation if there is none or the target has been met.
+  void ReclaimNextLocked();
+
+  Lock lock_;
+  std::map<Client*, scoped_refptr<SequencedTaskRunner>> clients_;
+  // The ongoing reclamation, if any.
+  std::unique_ptr<Reclamation> reclamation_;
+
+  DISALLOW_COPY_AND_ASSIGN(MemoryReclaimer);
+};
+
+}  // namespace base
+
+#endif  // BASE_MEMORY_MEMORY_RECLAIMER_H_
@@ -0,0 +1,151 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/memory/memory_reclaimer.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "base/message_loop/message_loop.h"
+#include "base/run_loop.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+class TestReclaimerClient : public MemoryReclaimer::Client {
+ public:
+  TestReclaimerClient(size_t reclaimable_bytes,
+                      TimeDelta cost,
+                      std::vector<TestReclaimerClient*>* reclaim_order)
+      : reclaimable_bytes_(reclaimable_bytes),
+        cost_(cost),
+        reclaim_order_(reclaim_order) {}
+
+  MemoryReclaimer::Estimate EstimateReclaim() override {
+    MemoryReclaimer::Estimate estimate;
+    estimate.reclaimable_bytes = reclaimable_bytes_;
+    estimate.cost = cost_;
+    return estimate;
+  }
+
+  size_t Reclaim(size_t bytes) override {
+    reclaim_order_->push_back(this);
+    size_t bytes_freed = std::min(bytes, reclaimable_bytes_);
+    reclaimable_bytes_ -= bytes_freed;
+    return bytes_freed;
+  }
+
+  size_t reclaimable_bytes() const { return reclaimable_bytes_; }
+
+ private:
+  size_t reclaimable_bytes_;
+  const TimeDelta cost_;
+  std::vector<TestReclaimerClient*>* const reclaim_order_;
+};
+
+void RunUntilIdle() {
+  base::RunLoop loop;
+  loop.RunUntilIdle();
+}
+
+TEST(MemoryReclaimerTest, ModerateReclaimsBestBenefitPerCost) {
+  MessageLoop loop;
+  MemoryReclaimer reclaimer;
+  std::vector<TestReclaimerClient*> reclaim_order;
+  TestReclaimerClient expensive(1000, TimeDelta::FromMilliseconds(10),
+                                &reclaim_order);
+  TestReclaimerClient cheap(1000, TimeDelta::FromMilliseconds(1),
+                            &reclaim_order);
+  reclaimer.Register(&expensive);
+  reclaimer.Register(&cheap);
+
+  // Half of the reclaimable memory is freed, all of it by the cheapest
+  // client.
+  reclaimer.OnMemoryPressure(
+      MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE);
+  RunUntilIdle();
+  ASSERT_EQ(1u, reclaim_order.size());
+  EXPECT_EQ(&cheap, reclaim_order[0]);
+  EXPECT_EQ(0u, cheap.reclaimable_bytes());
+  EXPECT_EQ(1000u, expensive.reclaimable_bytes());
+
+  reclaimer.Unregister(&expensive);
+  reclaimer.Unregister(&cheap);
+}
+
+TEST(MemoryReclaimerTest, ModerateStaysWithinCostBudget) {
+  MessageLoop loop;
+  MemoryReclaimer reclaimer;
+  std::vector<TestReclaimerClient*> reclaim_order;
+  TestReclaimerClient too_expensive(1000, TimeDelta::FromSeconds(10),
+                                    &reclaim_order);
+  TestReclaimerClient cheap(100, TimeDelta::FromMilliseconds(1),
+                            &reclaim_order);
+  reclaimer.Register(&too_expensive);
+  reclaimer.Register(&cheap);
+
+  reclaimer.OnMemoryPressure(
+      MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE);
+  RunUntilIdle();
+  ASSERT_EQ(1u, reclaim_order.size());
+  EXPECT_EQ(&cheap, reclaim_order[0]);
+  EXPECT_EQ(1000u, too_expensive.reclaimable_bytes());
+
+  reclaimer.Unregister(&too_expensive);
+  reclaimer.Unregister(&cheap);
+}
+
+TEST(MemoryReclaimerTest, CriticalReclaimsEverything) {
+  MessageLoop loop;
+  MemoryReclaimer reclaimer;
+  std::vector<TestReclaimerClient*> reclaim_order;
+  TestReclaimerClient expensive(1000, TimeDelta::FromSeconds(10),
+                                &reclaim_order);
+  TestReclaimerClient cheap(1000, TimeDelta::FromMilliseconds(1),
+                            &reclaim_order);
+  TestReclaimerClient empty(0, TimeDelta(), &reclaim_order);
+  reclaimer.Register(&expensive);
+  reclaimer.Register(&cheap);
+  reclaimer.Register(&empty);
+
+  reclaimer.OnMemoryPressure(
+      MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL);
+  RunUntilIdle();
+  ASSERT_EQ(2u, reclaim_order.size());
+  EXPECT_EQ(&cheap, reclaim_order[0]);
+  EXPECT_EQ(&expensive, reclaim_order[1]);
+  EXPECT_EQ(0u, cheap.reclaimable_bytes());
+  EXPECT_EQ(0u, expensive.reclaimable_bytes());
+
+  reclaimer.Unregister(&expensive);
+  reclaimer.Unregister(&cheap);
+  reclaimer.Unregister(&empty);
+}
+
+TEST(MemoryReclaimerTest, UnregisteredClientIsNotCalled) {
+  MessageLoop loop;
+  MemoryReclaimer reclaimer;
+  std::vector<TestReclaimerClient*> reclaim_order;
+  TestReclaimerClient first(1000, TimeDelta::FromMilliseconds(1),
+                            &reclaim_order);
+  TestReclaimerClient second(1000, TimeDelta::FromMilliseconds(2),
+                             &reclaim_order);
+  reclaimer.Register(&first);
+  reclaimer.Register(&second);
+
+  reclaimer.OnMemoryPressure(
+      MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL);
+  reclaimer.Unregister(&first);
+  RunUntilIdle();
+  ASSERT_EQ(1u, reclaim_order.size());
+  EXPECT_EQ(&second, reclaim_order[0]);
+
+  reclaimer.Unregister(&second);
+}
+
+}  // namespace
+
+}  // namespace base
@@ -0,0 +1,191 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/memory/small_block_cache.h"
+
+#include <atomic>
+#include <new>
+
+#include "base/logging.h"
+#include "base/no_destructor.h"
+#include "base/threading/thread_local_storage.h"
+
+namespace base {
+namespace internal {
+
+namespace {
+
+constexpr size_t kSizeClassGranularity = 16;
+constexpr size_t kNumSizeClasses =
+    SmallBlockCache::kMaxBlockSize / kSizeClassGranularity;
+
+// Number of allocations on a thread after which its statistics are added to
+// the process-wide counters.
+constexpr uint32_t kStatsFlushInterval = 1024;
+
+struct FreeBlock {
+  FreeBlock* next;
+};
+
+struct ThreadCache {
+  FreeBlock* free_lists[kNumSizeClasses] = {};
+  size_t cached_bytes = 0;
+
+  // Statistics that haven't been added to the process-wide counters yet.
+  uint32_t pending_hits = 0;
+  uint32_t pending_misses = 0;
+  size_t reported_cached_bytes = 0;
+};
+
+// Set in the TLS slot of a thread whose ThreadCache was destroyed, so that
+// blocks freed later during thread teardown go back to the heap.
+ThreadCache* const kTeardownSentinel = reinterpret_cast<ThreadCache*>(1);
+
+std::atomic<uint64_t> g_hits{0};
+std::atomic<uint64_t> g_misses{0};
+std::atomic<int64_t> g_cached_bytes{0};
+
+size_t GetSizeClass(size_t size) {
+  DCHECK_LE(size, SmallBlockCache::kMaxBlockSize);
+  return size == 0 ? 0 : (size - 1) / kSizeClassGranularity;
+}
+
+size_t GetBlockSize(size_t size_class) {
+  return (size_class + 1) * kSizeClassGranularity;
+}
+
+void FlushStats(ThreadCache* cache) {
+  g_hits.fetch_add(cache->pending_hits, std::memory_order_relaxed);
+  g_misses.fetch_add(cache->pending_misses, std::memory_order_relaxed);
+  g_cached_bytes.fetch_add(static_cast<int64_t>(cache->cached_bytes) -
+                               static_cast<int64_t>(cache->reported_cached_bytes),
+                           std::memory_order_relaxed);
+  cache->pending_hits = 0;
+  cache->pending_misses = 0;
+  cache->reported_cached_bytes = cache->cached_bytes;
+}
+
+void OnThreadExit(void* value);
+
+ThreadLocalStorage::Slot& ThreadCacheTLS() {
+  static NoDestructor<ThreadLocalStorage::Slot> thread_cache_tls(
+      &OnThreadExit);
+  return *thread_cache_tls;
+}
+
+void OnThreadExit(void* value) {
+  // This is called a second time with the sentinel set below.
+  if (value == kTeardownSentinel)
+    return;
+
+  ThreadCacheTLS().Set(kTeardownSentinel);
+  ThreadCache* const cache = static_cast<ThreadCache*>(value);
+  for (FreeBlock*& free_list : cache->free_lists) {
+    while (free_list) {
+      FreeBlock* const block = free_list;
+      free_list = block->next;
+      ::operator delete(block);
+    }
+  }
+  cache->cached_bytes = 0;
+  FlushStats(cache);
+  delete cache;
+}
+
+}  // namespace
+
+// static
+void* SmallBlockCache::Allocate(size_t size) {
+#if defined(ADDRESS_SANITIZER)
+  return ::operator new(size);
+#else
+  if (size > kMaxBlockSize)
+    return ::operator new(size);
+
+  const size_t size_class = GetSizeClass(size);
+  const size_t block_size = GetBlockSize(size_class);
+
+  // Thread teardown may allocate after TLS is gone.
+  if (ThreadLocalStorage::HasBeenDestroyed())
+    return ::operator new(block_size);
+  void* const value = ThreadCacheTLS().Get();
+  if (value == kTeardownSentinel)
+    return ::operator new(block_size);
+
+  ThreadCache* cache = static_cast<ThreadCache*>(value);
+  if (!cache) {
+    cache = new ThreadCache;
+    ThreadCacheTLS().Set(cache);
+  }
+
+  FreeBlock* const block = cache->free_lists[size_class];
+  if (block) {
+    cache->free_lists[size_class] = block->next;
+    cache->cached_bytes -= block_size;
+    ++cache->pending_hits;
+  } else {
+    ++cache->pending_misses;
+  }
+  if (cache->pending_hits + cache->pending_misses >= kStatsFlushInterval)
+    FlushStats(cache);
+
+  return block ? static_cast<void*>(block) : ::operator new(block_size);
+#endif  // defined(ADDRESS_SANITIZER)
+}
+
+// static
+void SmallBlockCache::Free(void* block, size_t size) {
+  if (!block)
+    return;
+#if defined(ADDRESS_SANITIZER)
+  ::operator delete(block);
+#else
+  if (size > kMaxBlockSize || ThreadLocalStorage::HasBeenDestroyed()) {
+    ::operator delete(block);
+    return;
+  }
+
+  // Blocks are only cached on threads that allocate from the cache: a thread
+  // that never allocates would never reuse them.
+  void* const value = ThreadCacheTLS().Get();
+  const size_t size_class = GetSizeClass(size);
+  const size_t block_size = GetBlockSize(size_class);
+  if (!value || value == kTeardownSentinel) {
+    ::operator delete(block);
+    return;
+  }
+  ThreadCache* const cache = static_cast<ThreadCache*>(value);
+  if (cache->cached_bytes + block_size > kMaxCachedBytesPerThread) {
+    ::operator delete(block);
+    return;
+  }
+
+  FreeBlock* const free_block = static_cast<FreeBlock*>(block);
+  free_block->next = cache->free_lists[size_class];
+  cache->free_lists[size_class] = free_block;
+  cache->cached_bytes += block_size;
+#endif  // defined(ADDRESS_SANITIZER)
+}
+
+// static
+SmallBlockCache::Stats SmallBlockCache::GetStats() {
+#if !defined(ADDRESS_SANITIZER)
+  if (!ThreadLocalStorage::HasBeenDestroyed()) {
+    void* const value = ThreadCacheTLS().Get();
+    if (value && value != kTeardownSentinel)
+      FlushStats(static_cast<ThreadCache*>(value));
+  }
+#endif
+  Stats stats;
+  stats.hits = g_hits.load(std::memory_order_relaxed);
+  stats.misses = g_misses.load(std::memory_order_relaxed);
+  // Each thread adds the difference between its current and last reported
+  // cached bytes, so the sum is never negative.
+  stats.cached_bytes =
+      static_cast<uint64_t>(g_cached_bytes.load(std::memory_order_relaxed));
+  return stats;
+}
+
+}  // namespace internal
+}  // namespace base
@@ -0,0 +1,68 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_MEMORY_SMALL_BLOCK_CACHE_H_
+#define BASE_MEMORY_SMALL_BLOCK_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "base/base_export.h"
+#include "base/macros.h"
+
+namespace base {
+namespace internal {
+
+// Allocates small blocks of memory that are recycled through a per-thread cache
+// of recently freed blocks instead of being returned to the heap. This is
+// intended for objects that are allocated and freed at high rates, such as
+// BindStates and queued PendingTasks, to reduce allocator churn.
+//
+// Blocks are grouped in size classes. A block freed on a thread is added to the
+// cache of that thread, regardless of the thread it was allocated on, so that
+// the common pattern of a thread posting tasks to itself hits the cache. Each
+// thread caches at most |kMaxCachedBytesPerThread| bytes, which are returned to
+// the heap when the thread exits.
+//
+// When built with AddressSanitizer, blocks are never recycled so that
+// use-after-free errors are still detected.
+//
+// This class is thread-safe.
+class BASE_EXPORT SmallBlockCache {
+ public:
+  // Blocks larger than this aren't cached.
+  static constexpr size_t kMaxBlockSize = 256;
+
+  // Maximum number of bytes held in the cache of a thread.
+  static constexpr size_t kMaxCachedBytesPerThread = 32 * 1024;
+
+  struct Stats {
+    // Number of allocations of at most |kMaxBlockSize| bytes that were served
+    // from a thread cache.
+    uint64_t hits = 0;
+    // Number of allocations of at most |kMaxBlockSize| bytes that fell back to
+    // the heap.
+    uint64_t misses = 0;
+    // Number of bytes held in thread caches.
+    uint64_t cached_bytes = 0;
+  };
+
+  // Returns a block of at least |size| bytes. Never returns nullptr.
+  static void* Allocate(size_t size);
+
+  // Releases |block|, which must have been returned by Allocate(|size|).
+  static void Free(void* block, size_t size);
+
+  // Returns process-wide statistics. Counts from threads other than the calling
+  // thread are accumulated periodically and may lag behind.
+  static Stats GetStats();
+
+ private:
+  DISALLOW_IMPLICIT_CONSTRUCTORS(SmallBlockCache);
+};
+
+}  // namespace internal
+}  // namespace base
+
+#endif  // BASE_MEMORY_SMALL_BLOCK_CACHE_H_
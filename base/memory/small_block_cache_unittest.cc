@@ -0,0 +1,100 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/memory/small_block_cache.h"
+
+#include <set>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/callback.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+namespace internal {
+
+// AddressSanitizer builds don't recycle blocks.
+#if !defined(ADDRESS_SANITIZER)
+
+TEST(SmallBlockCacheTest, RecyclesFreedBlock) {
+  // Make sure that the cache of this thread exists.
+  SmallBlockCache::Free(SmallBlockCache::Allocate(40), 40);
+
+  const SmallBlockCache::Stats stats_before = SmallBlockCache::GetStats();
+  void* const block = SmallBlockCache::Allocate(40);
+  SmallBlockCache::Free(block, 40);
+  // 33 bytes is in the same size class as 40 bytes.
+  void* const recycled_block = SmallBlockCache::Allocate(33);
+  EXPECT_EQ(block, recycled_block);
+  SmallBlockCache::Free(recycled_block, 33);
+
+  const SmallBlockCache::Stats stats_after = SmallBlockCache::GetStats();
+  EXPECT_GE(stats_after.hits, stats_before.hits + 2);
+}
+
+TEST(SmallBlockCacheTest, DoesNotCacheLargeBlocks) {
+  // Blocks larger than kMaxBlockSize come from the heap and don't update the
+  // statistics. This doesn't check that they aren't recycled by the heap.
+  const SmallBlockCache::Stats stats_before = SmallBlockCache::GetStats();
+  SmallBlockCache::Free(
+      SmallBlockCache::Allocate(SmallBlockCache::kMaxBlockSize + 1),
+      SmallBlockCache::kMaxBlockSize + 1);
+  const SmallBlockCache::Stats stats_after = SmallBlockCache::GetStats();
+  EXPECT_EQ(stats_before.hits + stats_before.misses,
+            stats_after.hits + stats_after.misses);
+}
+
+TEST(SmallBlockCacheTest, CachedBytesPerThreadAreBounded) {
+  constexpr size_t kBlockSize = SmallBlockCache::kMaxBlockSize;
+  constexpr size_t kNumCachedBlocks =
+      SmallBlockCache::kMaxCachedBytesPerThread / kBlockSize;
+  constexpr size_t kNumBlocks = 2 * kNumCachedBlocks;
+
+  // Empty the size class in the cache of this thread.
+  std::vector<void*> blocks;
+  for (size_t i = 0; i < kNumBlocks; ++i)
+    blocks.push_back(SmallBlockCache::Allocate(kBlockSize));
+  for (void* block : blocks)
+    SmallBlockCache::Free(block, kBlockSize);
+  blocks.clear();
+  for (size_t i = 0; i < kNumBlocks; ++i)
+    blocks.push_back(SmallBlockCache::Allocate(kBlockSize));
+
+  // Free all blocks. The cache keeps no more than kNumCachedBlocks of them.
+  const std::set<void*> freed_blocks(blocks.begin(), blocks.end());
+  for (void* block : blocks)
+    SmallBlockCache::Free(block, kBlockSize);
+  blocks.clear();
+
+  size_t num_recycled_blocks = 0;
+  for (size_t i = 0; i < kNumCachedBlocks; ++i) {
+    blocks.push_back(SmallBlockCache::Allocate(kBlockSize));
+    if (freed_blocks.count(blocks.back()))
+      ++num_recycled_blocks;
+  }
+  EXPECT_EQ(kNumCachedBlocks, num_recycled_blocks);
+  for (void* block : blocks)
+    SmallBlockCache::Free(block, kBlockSize);
+}
+
+// Verify that BindStates are recycled.
+TEST(SmallBlockCacheTest, BindState) {
+  int value = 0;
+  OnceClosure closure =
+      BindOnce([](int* value) { ++*value; }, Unretained(&value));
+  std::move(closure).Run();
+  EXPECT_EQ(1, value);
+
+  const SmallBlockCache::Stats stats_before = SmallBlockCache::GetStats();
+  closure = BindOnce([](int* value) { ++*value; }, Unretained(&value));
+  std::move(closure).Run();
+  EXPECT_EQ(2, value);
+  const SmallBlockCache::Stats stats_after = SmallBlockCache::GetStats();
+  EXPECT_GE(stats_after.hits, stats_before.hits + 1);
+}
+
+#endif  // !defined(ADDRESS_SANITIZER)
+
+}  // namespace internal
+}  // namespace base
@@ -13,6 +13,7 @@
 #include "base/message_loop/message_loop.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/synchronization/waitable_event.h"
+#include "base/threading/platform_thread.h"
 #include "base/time/time.h"
 #include "build/build_config.h"
 
@@ -40,6 +41,10 @@ bool AlwaysNotifyPump(MessageLoop::Type type) {
 #endif
 }
 
+// Bits of IncomingTaskQueue::|posting_state_|.
+constexpr uint32_t kStopAcceptingTasksBit = 1;
+constexpr uint32_t kPostInProgressIncrement = 2;
+
 TimeTicks CalculateDelayedRuntime(TimeDelta delay) {
   TimeTicks delayed_run_time;
   if (delay > TimeDelta())
@@ -92,10 +97,33 @@ bool IncomingTaskQueue::AddToIncomingQueue(const Location& from_here,
   return PostPendingTask(&pending_task);
 }
 
+bool IncomingTaskQueue::AddTasksToIncomingQueue(
+    const Location& from_here,
+    std::vector<OnceClosure> tasks) {
+  if (tasks.empty())
+    return true;
+
+  std::vector<PendingTask> pending_tasks;
+  pending_tasks.reserve(tasks.size());
+  for (OnceClosure& task : tasks) {
+    // Use CHECK instead of DCHECK to crash earlier. See http://crbug.com/711167
+    // for details.
+    CHECK(task);
+    pending_tasks.emplace_back(from_here, std::move(task));
+  }
+
+  return PostPendingTasks(&pending_tasks);
+}
+
 void IncomingTaskQueue::WillDestroyCurrentMessageLoop() {
-  {
-    AutoLock auto_lock(incoming_queue_lock_);
-    accept_new_tasks_ = false;
+  // Stop accepting new tasks and wait until posts that saw the old state have
+  // completed, so that no task is added to |incoming_queue_| after this returns.
+  // Posts never block while they are in progress, so this spins briefly at
+  // most.
+  uint32_t posting_state = posting_state_.fetch_or(kStopAcceptingTasksBit);
+  while (posting_state != kStopAcceptingTasksBit) {
+    PlatformThread::YieldCurrentThread();
+    posting_state = posting_state_.load();
   }
   {
     AutoLock auto_lock(message_loop_lock_);
@@ -104,16 +132,13 @@ void IncomingTaskQueue::WillDestroyCurrentMessageLoop() {
 }
 
 void IncomingTaskQueue::StartScheduling() {
-  bool schedule_work;
-  {
-    AutoLock lock(incoming_queue_lock_);
-    DCHECK(!is_ready_for_scheduling_);
-    DCHECK(!message_loop_scheduled_);
-    is_ready_for_scheduling_ = true;
-    schedule_work = !incoming_queue_.empty();
-    if (schedule_work)
-      message_loop_scheduled_ = true;
-  }
+  DCHECK(!is_ready_for_scheduling_.load());
+  is_ready_for_scheduling_.store(true);
+  // A task pushed before the store above may not have seen
+  // |is_ready_for_scheduling_|. Both are sequentially consistent, so such a
+  // task is visible to IsEmpty().
+  const bool schedule_work =
+      !incoming_queue_.IsEmpty() && !message_loop_scheduled_.exchange(true);
   if (schedule_work) {
     DCHECK(message_loop_);
     AutoLock auto_lock(message_loop_lock_);
@@ -172,7 +197,7 @@ void IncomingTaskQueue::TriageQueue::Clear() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(outer_->sequence_checker_);
 
   // Clear() should be invoked before WillDestroyCurrentMessageLoop().
-  DCHECK(outer_->accept_new_tasks_);
+  DCHECK(outer_->AcceptsNewTasks());
 
   // Delete all currently pending tasks but not tasks potentially posted from
   // their destructors. See ~MessageLoop() for the full logic mitigating against
@@ -315,69 +340,96 @@ bool IncomingTaskQueue::PostPendingTask(PendingTask* pending_task) {
   // Warning: Don't try to short-circuit, and handle this thread's tasks more
   // directly, as it could starve handling of foreign threads.  Put every task
   // into this queue.
-  bool accept_new_tasks;
-  bool schedule_work = false;
-  {
-    AutoLock auto_lock(incoming_queue_lock_);
-    accept_new_tasks = accept_new_tasks_;
-    if (accept_new_tasks)
-      schedule_work = PostPendingTaskLockRequired(pending_task);
+  if (!BeginPost()) {
+    // Clear the pending task outside of any lock to prevent any chance of
+    // self-deadlock if destroying a task also posts a task to this queue.
+    pending_task->task.Reset();
+    return false;
   }
 
-  if (!accept_new_tasks) {
-    // Clear the pending task outside of |incoming_queue_lock_| to prevent any
-    // chance of self-deadlock if destroying a task also posts a task to this
-    // queue.
-    DCHECK(!schedule_work);
-    pending_task->task.Reset();
+  // Initialize the sequence number. The sequence number is used for delayed
+  // tasks (to facilitate FIFO sorting when two tasks have the same
+  // delayed_run_time value) and for identifying the task in about:tracing.
+  // Tasks posted from the same thread get increasing sequence numbers in
+  // posting order.
+  pending_task->sequence_num =
+      next_sequence_num_.fetch_add(1, std::memory_order_relaxed);
+
+  task_annotator_.DidQueueTask("MessageLoop::PostTask", *pending_task);
+
+  incoming_queue_.Push(std::move(*pending_task));
+
+  EndPost(1);
+  return true;
+}
+
+bool IncomingTaskQueue::PostPendingTasks(
+    std::vector<PendingTask>* pending_tasks) {
+  if (!BeginPost()) {
+    pending_tasks->clear();
     return false;
   }
 
-  // Wake up the message loop and schedule work. This is done outside
-  // |incoming_queue_lock_| to allow for multiple post tasks to occur while
+  // Reserve a contiguous range of sequence numbers so that the batch keeps its
+  // order relative to delayed tasks posted concurrently.
+  int sequence_num = next_sequence_num_.fetch_add(
+      static_cast<int>(pending_tasks->size()), std::memory_order_relaxed);
+  for (PendingTask& pending_task : *pending_tasks) {
+    pending_task.sequence_num = sequence_num++;
+    task_annotator_.DidQueueTask("MessageLoop::PostTask", pending_task);
+  }
+
+  const size_t num_tasks = pending_tasks->size();
+  incoming_queue_.PushAll(std::move(*pending_tasks));
+  pending_tasks->clear();
+
+  EndPost(num_tasks);
+  return true;
+}
+
+bool IncomingTaskQueue::BeginPost() {
+  const uint32_t posting_state =
+      posting_state_.fetch_add(kPostInProgressIncrement);
+  if (posting_state & kStopAcceptingTasksBit) {
+    posting_state_.fetch_sub(kPostInProgressIncrement);
+    return false;
+  }
+  return true;
+}
+
+void IncomingTaskQueue::EndPost(size_t num_tasks) {
+  // After we've scheduled the message loop, we do not need to do so again
+  // until we know it has processed all of the work in our queue and is waiting
+  // for more work again. The message loop will always attempt to reload from
+  // the incoming queue before waiting again so we clear
+  // |message_loop_scheduled_| in ReloadWorkQueue().
+  size_t num_schedule_work = 0;
+  if (is_ready_for_scheduling_.load()) {
+    const bool was_scheduled = message_loop_scheduled_.exchange(true);
+    if (always_schedule_work_)
+      num_schedule_work = num_tasks;
+    else if (!was_scheduled)
+      num_schedule_work = 1;
+  }
+
+  posting_state_.fetch_sub(kPostInProgressIncrement);
+
+  // Wake up the message loop and schedule work. This is done outside of the
+  // posting protocol above to allow for multiple post tasks to occur while
   // ScheduleWork() is running. For platforms (e.g. Android) that require one
   // call to ScheduleWork() for each task, all pending tasks may serialize
   // within the ScheduleWork() call. As a result, holding a lock to maintain the
   // lifetime of |message_loop_| is less of a concern.
-  if (schedule_work) {
+  if (num_schedule_work) {
     // Ensures |message_loop_| isn't destroyed while running.
     AutoLock auto_lock(message_loop_lock_);
-    if (message_loop_)
+    for (size_t i = 0; message_loop_ && i < num_schedule_work; ++i)
       message_loop_->ScheduleWork();
   }
-
-  return true;
 }
 
-bool IncomingTaskQueue::PostPendingTaskLockRequired(PendingTask* pending_task) {
-  incoming_queue_lock_.AssertAcquired();
-
-#if defined(OS_WIN)
-  if (pending_task->is_high_res)
-    ++high_res_task_count_;
-#endif
-
-  // Initialize the sequence number. The sequence number is used for delayed
-  // tasks (to facilitate FIFO sorting when two tasks have the same
-  // delayed_run_time value) and for identifying the task in about:tracing.
-  pending_task->sequence_num = next_sequence_num_++;
-
-  task_annotator_.DidQueueTask("MessageLoop::PostTask", *pending_task);
-
-  bool was_empty = incoming_queue_.empty();
-  incoming_queue_.push(std::move(*pending_task));
-
-  if (is_ready_for_scheduling_ &&
-      (always_schedule_work_ || (!message_loop_scheduled_ && was_empty))) {
-    // After we've scheduled the message loop, we do not need to do so again
-    // until we know it has processed all of the work in our queue and is
-    // waiting for more work again. The message loop will always attempt to
-    // reload from the incoming queue before waiting again so we clear this
-    // flag in ReloadWorkQueue().
-    message_loop_scheduled_ = true;
-    return true;
-  }
-  return false;
+bool IncomingTaskQueue::AcceptsNewTasks() const {
+  return !(posting_state_.load() & kStopAcceptingTasksBit);
 }
 
 int IncomingTaskQueue::ReloadWorkQueue(TaskQueue* work_queue) {
@@ -386,19 +438,20 @@ int IncomingTaskQueue::ReloadWorkQueue(TaskQueue* work_queue) {
   // Make sure no tasks are lost.
   DCHECK(work_queue->empty());
 
-  // Acquire all we can from the inter-thread queue with one lock acquisition.
-  AutoLock lock(incoming_queue_lock_);
-  if (incoming_queue_.empty()) {
+  // Acquire all we can from the inter-thread queue without a lock.
+  int high_res_tasks = incoming_queue_.PopAll(work_queue);
+  if (work_queue->empty()) {
     // If the loop attempts to reload but there are no tasks in the incoming
     // queue, that means it will go to sleep waiting for more work. If the
     // incoming queue becomes nonempty we need to schedule it again.
-    message_loop_scheduled_ = false;
-  } else {
-    incoming_queue_.swap(*work_queue);
+    //
+    // A task whose Push() completed after PopAll() above may have seen
+    // |message_loop_scheduled_| still set and skipped ScheduleWork(). The
+    // exchange synchronizes with that task's exchange, so it is visible to the
+    // PopAll() below.
+    message_loop_scheduled_.exchange(false);
+    high_res_tasks = incoming_queue_.PopAll(work_queue);
   }
-  // Reset the count of high resolution tasks since our queue is now empty.
-  int high_res_tasks = high_res_task_count_;
-  high_res_task_count_ = 0;
   return high_res_tasks;
 }
 
@@ -5,11 +5,17 @@
 #ifndef BASE_MESSAGE_LOOP_INCOMING_TASK_QUEUE_H_
 #define BASE_MESSAGE_LOOP_INCOMING_TASK_QUEUE_H_
 
+#include <stdint.h>
+
+#include <atomic>
+#include <vector>
+
 #include "base/base_export.h"
 #include "base/callback.h"
 #include "base/debug/task_annotator.h"
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
+#include "base/message_loop/lock_free_task_queue.h"
 #include "base/pending_task.h"
 #include "base/sequence_checker.h"
 #include "base/synchronization/lock.h"
@@ -24,7 +30,8 @@ namespace internal {
 
 // Implements a queue of tasks posted to the message loop running on the current
 // thread. This class takes care of synchronizing posting tasks from different
-// threads and together with MessageLoop ensures clean shutdown.
+// threads and together with MessageLoop ensures clean shutdown. Posting a task
+// doesn't acquire a lock unless the message loop must be woken up.
 class BASE_EXPORT IncomingTaskQueue
     : public RefCountedThreadSafe<IncomingTaskQueue> {
  public:
@@ -77,6 +84,17 @@ class BASE_EXPORT IncomingTaskQueue
                           TimeDelta delay,
                           Nestable nestable);
 
+  // Appends all of |tasks| to the incoming queue, without delay, as nestable
+  // tasks. The tasks are added atomically with respect to other posts and the
+  // message loop is scheduled at most once for the whole batch (unless the
+  // pump requires one ScheduleWork() per task).
+  //
+  // Returns true if the tasks were successfully added to the queue, otherwise
+  // returns false. In all cases, the ownership of |tasks| is transferred to the
+  // called method.
+  bool AddTasksToIncomingQueue(const Location& from_here,
+                               std::vector<OnceClosure> tasks);
+
   // Disconnects |this| from the parent message loop.
   void WillDestroyCurrentMessageLoop();
 
@@ -200,9 +218,20 @@ class BASE_EXPORT IncomingTaskQueue
   // does not retain |pending_task->task| beyond this function call.
   bool PostPendingTask(PendingTask* pending_task);
 
-  // Does the real work of posting a pending task. Returns true if the caller
-  // should call ScheduleWork() on the message loop.
-  bool PostPendingTaskLockRequired(PendingTask* pending_task);
+  // Same as PostPendingTask() for all of |pending_tasks|, which are added to
+  // |incoming_queue_| atomically. Clears |pending_tasks|.
+  bool PostPendingTasks(std::vector<PendingTask>* pending_tasks);
+
+  // Registers a post in progress in |posting_state_|. Returns false if new
+  // tasks are no longer accepted, in which case no post was registered.
+  bool BeginPost();
+
+  // Unregisters a post registered with BeginPost() that added |num_tasks| tasks
+  // to |incoming_queue_|, and schedules the message loop if needed.
+  void EndPost(size_t num_tasks);
+
+  // Returns true unless WillDestroyCurrentMessageLoop() was called.
+  bool AcceptsNewTasks() const;
 
   // Loads tasks from the |incoming_queue_| into |*work_queue|. Must be called
   // from the sequence processing the tasks. Returns the number of tasks that
@@ -237,30 +266,25 @@ class BASE_EXPORT IncomingTaskQueue
   // Points to the message loop that owns |this|.
   MessageLoop* message_loop_;
 
-  // Synchronizes access to all members below this line.
-  base::Lock incoming_queue_lock_;
-
-  // Number of tasks that require high resolution timing. This value is kept
-  // so that ReloadWorkQueue() completes in constant time.
-  int high_res_task_count_ = 0;
-
-  // An incoming queue of tasks that are acquired under a mutex for processing
-  // on this instance's thread. These tasks have not yet been been pushed to
-  // |triage_tasks_|.
-  TaskQueue incoming_queue_;
+  // An incoming queue of tasks pushed from any thread without a lock, for
+  // processing on this instance's thread. These tasks have not yet been been
+  // pushed to |triage_tasks_|.
+  LockFreeTaskQueue incoming_queue_;
 
-  // True if new tasks should be accepted.
-  bool accept_new_tasks_ = true;
+  // The low bit is set once new tasks are no longer accepted. The other bits
+  // count PostPendingTask() calls that are in progress, so that
+  // WillDestroyCurrentMessageLoop() can wait for them to complete.
+  std::atomic<uint32_t> posting_state_{0};
 
   // The next sequence number to use for delayed tasks.
-  int next_sequence_num_ = 0;
+  std::atomic<int> next_sequence_num_{0};
 
   // True if our message loop has already been scheduled and does not need to be
   // scheduled again until an empty reload occurs.
-  bool message_loop_scheduled_ = false;
+  std::atomic<bool> message_loop_scheduled_{false};
 
   // False until StartScheduling() is called.
-  bool is_ready_for_scheduling_ = false;
+  std::atomic<bool> is_ready_for_scheduling_{false};
 
   DISALLOW_COPY_AND_ASSIGN(IncomingTaskQueue);
 };
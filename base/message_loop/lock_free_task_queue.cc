@@ -0,0 +1,124 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/message_loop/lock_free_task_queue.h"
+
+#include <utility>
+
+#include "base/logging.h"
+#include "base/memory/small_block_cache.h"
+
+namespace base {
+namespace internal {
+
+// static
+void* LockFreeTaskQueue::Node::operator new(size_t size) {
+  return SmallBlockCache::Allocate(size);
+}
+
+// static
+void LockFreeTaskQueue::Node::operator delete(void* node, size_t size) {
+  SmallBlockCache::Free(node, size);
+}
+
+LockFreeTaskQueue::LockFreeTaskQueue() : head_(&stub_), tail_(&stub_) {
+  // The consumer isn't necessarily the constructing sequence.
+  DETACH_FROM_SEQUENCE(sequence_checker_);
+}
+
+LockFreeTaskQueue::~LockFreeTaskQueue() {
+  // The destructor can run on any sequence once producers are gone.
+  DETACH_FROM_SEQUENCE(sequence_checker_);
+  while (Node* node = PopNode())
+    delete node;
+  DCHECK(IsEmpty());
+}
+
+void LockFreeTaskQueue::Push(PendingTask pending_task) {
+  PushNode(new Node(std::move(pending_task)));
+}
+
+void LockFreeTaskQueue::PushAll(std::vector<PendingTask> pending_tasks) {
+  if (pending_tasks.empty())
+    return;
+
+  // Link the nodes privately, then publish the whole chain with one exchange.
+  Node* const first = new Node(std::move(pending_tasks.front()));
+  Node* last = first;
+  for (size_t i = 1; i < pending_tasks.size(); ++i) {
+    Node* const node = new Node(std::move(pending_tasks[i]));
+    last->next.store(node, std::memory_order_relaxed);
+    last = node;
+  }
+  PushNodes(first, last);
+}
+
+int LockFreeTaskQueue::PopAll(TaskQueue* work_queue) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  int high_res_tasks = 0;
+  while (Node* node = PopNode()) {
+    if (node->pending_task.is_high_res)
+      ++high_res_tasks;
+    work_queue->push(std::move(node->pending_task));
+    delete node;
+  }
+  return high_res_tasks;
+}
+
+bool LockFreeTaskQueue::IsEmpty() const {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  return tail_ == &stub_ && head_.load() == &stub_;
+}
+
+void LockFreeTaskQueue::PushNodes(NodeBase* first, NodeBase* last) {
+  // The exchange is sequentially consistent so that a producer that checks a
+  // flag after Push() is ordered with respect to a consumer that sets the flag
+  // before calling IsEmpty() (see IncomingTaskQueue::StartScheduling()).
+  NodeBase* const previous_head = head_.exchange(last);
+  // Between the exchange and this store, the consumer can't see |first| nor any
+  // node pushed after it. The release makes the links within the chain visible
+  // along with it.
+  previous_head->next.store(first, std::memory_order_release);
+}
+
+LockFreeTaskQueue::Node* LockFreeTaskQueue::PopNode() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  NodeBase* tail = tail_;
+  NodeBase* next = tail->next.load(std::memory_order_acquire);
+  if (tail == &stub_) {
+    if (!next)
+      return nullptr;
+    tail_ = next;
+    tail = next;
+    next = next->next.load(std::memory_order_acquire);
+  }
+
+  if (next) {
+    tail_ = next;
+    return static_cast<Node*>(tail);
+  }
+
+  // |tail| has no successor. If it isn't the head, a producer has exchanged
+  // |head_| but hasn't linked its node yet.
+  if (tail != head_.load(std::memory_order_acquire))
+    return nullptr;
+
+  // |tail| is the last node. Push |stub_| behind it so that |tail| can be
+  // unlinked without leaving the queue without a node.
+  stub_.next.store(nullptr, std::memory_order_relaxed);
+  PushNode(&stub_);
+  next = tail->next.load(std::memory_order_acquire);
+  if (next) {
+    tail_ = next;
+    return static_cast<Node*>(tail);
+  }
+
+  // A producer pushed between the load of |head_| and PushNode(&stub_) and
+  // hasn't linked its node yet.
+  return nullptr;
+}
+
+}  // namespace internal
+}  // namespace base
@@ -0,0 +1,101 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_MESSAGE_LOOP_LOCK_FREE_TASK_QUEUE_H_
+#define BASE_MESSAGE_LOOP_LOCK_FREE_TASK_QUEUE_H_
+
+#include <stddef.h>
+
+#include <atomic>
+#include <vector>
+
+#include "base/base_export.h"
+#include "base/macros.h"
+#include "base/pending_task.h"
+#include "base/sequence_checker.h"
+
+namespace base {
+namespace internal {
+
+// A multi-producer single-consumer queue of PendingTasks that doesn't acquire a
+// lock when tasks are pushed. This is Dmitry Vyukov's node-based MPSC queue:
+// Push() atomically exchanges |head_| with the new node and then links the
+// previous head to it, while the consumer follows |next| links from |tail_|.
+//
+// Tasks are dequeued in the order in which their Push() calls exchanged
+// |head_|. In particular, tasks pushed from the same thread are dequeued in the
+// order in which they were pushed.
+//
+// Push() can be called from any thread. The other methods must be called from
+// the consumer sequence. A Push() that hasn't completed when PopAll() is called
+// may not be visible until a subsequent call.
+class BASE_EXPORT LockFreeTaskQueue {
+ public:
+  LockFreeTaskQueue();
+
+  // Deletes all tasks that are still in the queue. No Push() may be in progress.
+  ~LockFreeTaskQueue();
+
+  // Appends |pending_task| to the queue.
+  void Push(PendingTask pending_task);
+
+  // Appends all of |pending_tasks| to the queue, in order. Tasks pushed
+  // concurrently from other threads are never interleaved with them.
+  void PushAll(std::vector<PendingTask> pending_tasks);
+
+  // Moves all tasks whose Push() has completed to the back of |work_queue|, in
+  // order. Returns the number of moved tasks that require high resolution
+  // timers.
+  int PopAll(TaskQueue* work_queue);
+
+  // Returns true if no Push() has started since the last PopAll() that emptied
+  // the queue. A Push() that is in progress makes this return false.
+  bool IsEmpty() const;
+
+ private:
+  struct NodeBase {
+    std::atomic<NodeBase*> next{nullptr};
+  };
+
+  struct Node : public NodeBase {
+    explicit Node(PendingTask pending_task)
+        : pending_task(std::move(pending_task)) {}
+
+    // Nodes are recycled through SmallBlockCache.
+    static void* operator new(size_t size);
+    static void operator delete(void* node, size_t size);
+
+    PendingTask pending_task;
+  };
+
+  // Links |node| at the head of the queue. |node->next| must be nullptr.
+  void PushNode(NodeBase* node) { PushNodes(node, node); }
+
+  // Links the chain of nodes that starts at |first| and ends at |last| at the
+  // head of the queue. |last->next| must be nullptr.
+  void PushNodes(NodeBase* first, NodeBase* last);
+
+  // Unlinks and returns the node at the tail of the queue, or nullptr if the
+  // queue is empty or if the node at the tail is still being linked.
+  Node* PopNode();
+
+  // Sentinel node that is in the queue whenever the consumer has caught up with
+  // all producers.
+  NodeBase stub_;
+
+  // Last node pushed. Exchanged by producers.
+  std::atomic<NodeBase*> head_;
+
+  // Next node to pop. Only accessed by the consumer.
+  NodeBase* tail_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+
+  DISALLOW_COPY_AND_ASSIGN(LockFreeTaskQueue);
+};
+
+}  // namespace internal
+}  // namespace base
+
+#endif  // BASE_MESSAGE_LOOP_LOCK_FREE_TASK_QUEUE_H_
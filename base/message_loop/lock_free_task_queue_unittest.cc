@@ -0,0 +1,243 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/message_loop/lock_free_task_queue.h"
+
+#include <memory>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/bind_helpers.h"
+#include "base/callback_helpers.h"
+#include "base/location.h"
+#include "base/macros.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/threading/simple_thread.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+namespace internal {
+
+namespace {
+
+PendingTask CreateTask(int sequence_num) {
+  PendingTask pending_task(FROM_HERE, DoNothing());
+  pending_task.sequence_num = sequence_num;
+  return pending_task;
+}
+
+// Pushes |num_tasks| tasks to a LockFreeTaskQueue once |start_event| is
+// signaled. The sequence number of each task encodes the id of the thread and
+// the index of the task.
+class PushingThread : public SimpleThread {
+ public:
+  // If |batch_size| is greater than 1, tasks are pushed in batches of
+  // |batch_size| tasks with PushAll().
+  PushingThread(LockFreeTaskQueue* queue,
+                WaitableEvent* start_event,
+                int id,
+                int num_tasks,
+                int batch_size = 1)
+      : SimpleThread("PushingThread"),
+        queue_(queue),
+        start_event_(start_event),
+        id_(id),
+        num_tasks_(num_tasks),
+        batch_size_(batch_size) {}
+
+  static int GetThreadId(int sequence_num) { return sequence_num >> 20; }
+  static int GetTaskIndex(int sequence_num) {
+    return sequence_num & ((1 << 20) - 1);
+  }
+
+ private:
+  void Run() override {
+    start_event_->Wait();
+    if (batch_size_ == 1) {
+      for (int i = 0; i < num_tasks_; ++i)
+        queue_->Push(CreateTask((id_ << 20) | i));
+      return;
+    }
+    for (int i = 0; i < num_tasks_; i += batch_size_) {
+      std::vector<PendingTask> pending_tasks;
+      for (int j = i; j < i + batch_size_ && j < num_tasks_; ++j)
+        pending_tasks.push_back(CreateTask((id_ << 20) | j));
+      queue_->PushAll(std::move(pending_tasks));
+    }
+  }
+
+  LockFreeTaskQueue* const queue_;
+  WaitableEvent* const start_event_;
+  const int id_;
+  const int num_tasks_;
+  const int batch_size_;
+
+  DISALLOW_COPY_AND_ASSIGN(PushingThread);
+};
+
+}  // namespace
+
+TEST(LockFreeTaskQueueTest, PushPopSingleThread) {
+  LockFreeTaskQueue queue;
+  EXPECT_TRUE(queue.IsEmpty());
+
+  TaskQueue work_queue;
+  EXPECT_EQ(0, queue.PopAll(&work_queue));
+  EXPECT_TRUE(work_queue.empty());
+
+  for (int i = 0; i < 10; ++i)
+    queue.Push(CreateTask(i));
+  EXPECT_FALSE(queue.IsEmpty());
+
+  EXPECT_EQ(0, queue.PopAll(&work_queue));
+  EXPECT_TRUE(queue.IsEmpty());
+  ASSERT_EQ(10U, work_queue.size());
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(i, work_queue.front().sequence_num);
+    work_queue.pop();
+  }
+
+  // The queue can be reused after it was emptied.
+  queue.Push(CreateTask(42));
+  EXPECT_FALSE(queue.IsEmpty());
+  EXPECT_EQ(0, queue.PopAll(&work_queue));
+  ASSERT_EQ(1U, work_queue.size());
+  EXPECT_EQ(42, work_queue.front().sequence_num);
+  EXPECT_TRUE(queue.IsEmpty());
+}
+
+TEST(LockFreeTaskQueueTest, HighResolutionTasks) {
+  LockFreeTaskQueue queue;
+  for (int i = 0; i < 6; ++i) {
+    PendingTask pending_task = CreateTask(i);
+    pending_task.is_high_res = i % 2 == 0;
+    queue.Push(std::move(pending_task));
+  }
+
+  TaskQueue work_queue;
+  EXPECT_EQ(3, queue.PopAll(&work_queue));
+  EXPECT_EQ(6U, work_queue.size());
+}
+
+TEST(LockFreeTaskQueueTest, PushAll) {
+  LockFreeTaskQueue queue;
+  queue.PushAll(std::vector<PendingTask>());
+  EXPECT_TRUE(queue.IsEmpty());
+
+  queue.Push(CreateTask(0));
+  std::vector<PendingTask> pending_tasks;
+  for (int i = 1; i < 10; ++i)
+    pending_tasks.push_back(CreateTask(i));
+  queue.PushAll(std::move(pending_tasks));
+  queue.Push(CreateTask(10));
+
+  TaskQueue work_queue;
+  EXPECT_EQ(0, queue.PopAll(&work_queue));
+  EXPECT_TRUE(queue.IsEmpty());
+  ASSERT_EQ(11U, work_queue.size());
+  for (int i = 0; i < 11; ++i) {
+    EXPECT_EQ(i, work_queue.front().sequence_num);
+    work_queue.pop();
+  }
+}
+
+// Verify that tasks left in the queue are deleted with it.
+TEST(LockFreeTaskQueueTest, DeleteTasksOnDestruction) {
+  bool deleted = false;
+  {
+    LockFreeTaskQueue queue;
+    queue.Push(PendingTask(
+        FROM_HERE, BindOnce([](ScopedClosureRunner) {},
+                            ScopedClosureRunner(BindOnce(
+                                [](bool* deleted) { *deleted = true; },
+                                Unretained(&deleted))))));
+    EXPECT_FALSE(deleted);
+  }
+  EXPECT_TRUE(deleted);
+}
+
+// Verify that all tasks pushed concurrently from multiple threads are popped,
+// and that tasks pushed from the same thread are popped in order.
+TEST(LockFreeTaskQueueTest, MultipleProducers) {
+  constexpr int kNumThreads = 8;
+  constexpr int kNumTasksPerThread = 10000;
+
+  LockFreeTaskQueue queue;
+  WaitableEvent start_event(WaitableEvent::ResetPolicy::MANUAL,
+                            WaitableEvent::InitialState::NOT_SIGNALED);
+  std::vector<std::unique_ptr<PushingThread>> threads;
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads.push_back(std::make_unique<PushingThread>(&queue, &start_event, i,
+                                                      kNumTasksPerThread));
+    threads.back()->Start();
+  }
+  start_event.Signal();
+
+  // Pop concurrently with the producers.
+  std::vector<int> next_task_index(kNumThreads, 0);
+  int num_popped = 0;
+  TaskQueue work_queue;
+  auto check_work_queue = [&]() {
+    while (!work_queue.empty()) {
+      const int sequence_num = work_queue.front().sequence_num;
+      const int thread_id = PushingThread::GetThreadId(sequence_num);
+      ASSERT_LT(thread_id, kNumThreads);
+      EXPECT_EQ(next_task_index[thread_id],
+                PushingThread::GetTaskIndex(sequence_num));
+      ++next_task_index[thread_id];
+      ++num_popped;
+      work_queue.pop();
+    }
+  };
+  while (num_popped < kNumThreads * kNumTasksPerThread / 2) {
+    queue.PopAll(&work_queue);
+    check_work_queue();
+  }
+
+  for (auto& thread : threads)
+    thread->Join();
+  queue.PopAll(&work_queue);
+  check_work_queue();
+
+  EXPECT_EQ(kNumThreads * kNumTasksPerThread, num_popped);
+  EXPECT_TRUE(queue.IsEmpty());
+}
+
+// Verify that batches pushed concurrently from multiple threads are popped
+// contiguously.
+TEST(LockFreeTaskQueueTest, MultipleProducersPushAll) {
+  constexpr int kNumThreads = 8;
+  constexpr int kBatchSize = 16;
+  constexpr int kNumTasksPerThread = 1000 * kBatchSize;
+
+  LockFreeTaskQueue queue;
+  WaitableEvent start_event(WaitableEvent::ResetPolicy::MANUAL,
+                            WaitableEvent::InitialState::NOT_SIGNALED);
+  std::vector<std::unique_ptr<PushingThread>> threads;
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads.push_back(std::make_unique<PushingThread>(
+        &queue, &start_event, i, kNumTasksPerThread, kBatchSize));
+    threads.back()->Start();
+  }
+  start_event.Signal();
+  for (auto& thread : threads)
+    thread->Join();
+
+  TaskQueue work_queue;
+  queue.PopAll(&work_queue);
+  ASSERT_EQ(static_cast<size_t>(kNumThreads * kNumTasksPerThread),
+            work_queue.size());
+  while (!work_queue.empty()) {
+    const int first_sequence_num = work_queue.front().sequence_num;
+    EXPECT_EQ(0, PushingThread::GetTaskIndex(first_sequence_num) % kBatchSize);
+    for (int i = 0; i < kBatchSize; ++i) {
+      EXPECT_EQ(first_sequence_num + i, work_queue.front().sequence_num);
+      work_queue.pop();
+    }
+  }
+}
+
+}  // namespace internal
+}  // namespace base
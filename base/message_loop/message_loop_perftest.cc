@@ -7,13 +7,16 @@
 
 #include "base/atomicops.h"
 #include "base/bind.h"
+#include "base/bind_helpers.h"
 #include "base/callback.h"
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
+#include "base/message_loop/lock_free_task_queue.h"
 #include "base/message_loop/message_loop.h"
 #include "base/run_loop.h"
 #include "base/strings/stringprintf.h"
 #include "base/synchronization/atomic_flag.h"
+#include "base/synchronization/lock.h"
 #include "base/synchronization/waitable_event.h"
 #include "base/threading/platform_thread.h"
 #include "base/threading/sequenced_task_runner_handle.h"
@@ -251,4 +254,115 @@ INSTANTIATE_TEST_CASE_P(,
                         MessageLoopPerfTest,
                         ::testing::Values(1, 5, 10),
                         MessageLoopPerfTest::ParamInfoToString);
+
+namespace {
+
+// The incoming queue implementation used by IncomingTaskQueue until tasks were
+// pushed without a lock, kept as a baseline for IncomingQueuePerfTest.
+class LockedTaskQueue {
+ public:
+  LockedTaskQueue() = default;
+
+  void Push(PendingTask pending_task) {
+    AutoLock auto_lock(lock_);
+    queue_.push(std::move(pending_task));
+  }
+
+  void PopAll(TaskQueue* work_queue) {
+    AutoLock auto_lock(lock_);
+    queue_.swap(*work_queue);
+  }
+
+ private:
+  Lock lock_;
+  TaskQueue queue_;
+
+  DISALLOW_COPY_AND_ASSIGN(LockedTaskQueue);
+};
+
+// Measures the rate at which tasks can be pushed to an incoming queue from
+// multiple threads while a single thread drains it, as IncomingTaskQueue does.
+// Parameterized on the number of pushing threads.
+class IncomingQueuePerfTest : public ::testing::TestWithParam<int> {
+ public:
+  IncomingQueuePerfTest()
+      : run_posting_threads_(WaitableEvent::ResetPolicy::MANUAL,
+                             WaitableEvent::InitialState::NOT_SIGNALED) {}
+
+ protected:
+  static constexpr int kNumTasksPerThread = 200000;
+
+  template <typename QueueType>
+  class PushTasks final : public PostingThread::Action {
+   public:
+    explicit PushTasks(QueueType* queue) : queue_(queue) {}
+    ~PushTasks() override = default;
+
+   private:
+    void Run() override {
+      for (int i = 0; i < kNumTasksPerThread; ++i)
+        queue_->Push(PendingTask(FROM_HERE, DoNothing()));
+    }
+
+    QueueType* const queue_;
+
+    DISALLOW_COPY_AND_ASSIGN(PushTasks);
+  };
+
+  // Pushes |kNumTasksPerThread| tasks to |queue| from GetParam() threads while
+  // draining it on this thread. Prints the average time per push.
+  template <typename QueueType>
+  void RunTest(const std::string& trace) {
+    QueueType queue;
+    std::vector<std::unique_ptr<PostingThread>> threads;
+    for (int i = 0; i < GetParam(); ++i) {
+      threads.emplace_back(PostingThread::Create(
+          &run_posting_threads_,
+          std::make_unique<PushTasks<QueueType>>(&queue)));
+      EXPECT_TRUE(threads[i]);
+    }
+
+    const size_t num_tasks =
+        static_cast<size_t>(GetParam()) * kNumTasksPerThread;
+    size_t num_tasks_popped = 0;
+    TaskQueue work_queue;
+    const TimeTicks start_time = TimeTicks::Now();
+    run_posting_threads_.Signal();
+    while (num_tasks_popped < num_tasks) {
+      queue.PopAll(&work_queue);
+      num_tasks_popped += work_queue.size();
+      work_queue = TaskQueue();
+    }
+    const TimeDelta duration = TimeTicks::Now() - start_time;
+
+    for (auto& thread : threads)
+      thread->Join();
+
+    perf_test::PrintResult(
+        "contended_push", trace,
+        MessageLoopPerfTest::PostingThreadCountToString(GetParam()),
+        duration.InMicrosecondsF() / num_tasks, "us/task", true);
+  }
+
+ private:
+  WaitableEvent run_posting_threads_;
+
+  DISALLOW_COPY_AND_ASSIGN(IncomingQueuePerfTest);
+};
+
+}  // namespace
+
+TEST_P(IncomingQueuePerfTest, LockedQueue) {
+  RunTest<LockedTaskQueue>("_locked");
+}
+
+TEST_P(IncomingQueuePerfTest, LockFreeQueue) {
+  RunTest<internal::LockFreeTaskQueue>("_lock_free");
+}
+
+INSTANTIATE_TEST_CASE_P(,
+                        IncomingQueuePerfTest,
+                        ::testing::Values(1, 2, 4, 8, 16),
+                        MessageLoopPerfTest::ParamInfoToString);
+
 }  // namespace base
@@ -46,6 +46,11 @@ bool MessageLoopTaskRunner::RunsTasksInCurrentSequence() const {
   return valid_thread_id_ == PlatformThread::CurrentId();
 }
 
+bool MessageLoopTaskRunner::PostTasks(const Location& from_here,
+                                      std::vector<OnceClosure> tasks) {
+  return incoming_queue_->AddTasksToIncomingQueue(from_here, std::move(tasks));
+}
+
 MessageLoopTaskRunner::~MessageLoopTaskRunner() = default;
 
 }  // namespace internal
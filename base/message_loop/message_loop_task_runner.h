@@ -5,6 +5,8 @@
 #ifndef BASE_MESSAGE_LOOP_MESSAGE_LOOP_TASK_RUNNER_H_
 #define BASE_MESSAGE_LOOP_MESSAGE_LOOP_TASK_RUNNER_H_
 
+#include <vector>
+
 #include "base/base_export.h"
 #include "base/callback.h"
 #include "base/macros.h"
@@ -38,6 +40,8 @@ class BASE_EXPORT MessageLoopTaskRunner : public SingleThreadTaskRunner {
                                   OnceClosure task,
                                   TimeDelta delay) override;
   bool RunsTasksInCurrentSequence() const override;
+  bool PostTasks(const Location& from_here,
+                 std::vector<OnceClosure> tasks) override;
 
  private:
   friend class RefCountedThreadSafe<MessageLoopTaskRunner>;
@@ -5,6 +5,7 @@
 #include "base/message_loop/message_loop_task_runner.h"
 
 #include <memory>
+#include <vector>
 
 #include "base/atomic_sequence_num.h"
 #include "base/bind.h"
@@ -362,4 +363,37 @@ TEST_F(MessageLoopTaskRunnerThreadingTest, PostTaskAfterThreadIsDeleted) {
   EXPECT_FALSE(ret);
 }
 
+TEST_F(MessageLoopTaskRunnerThreadingTest, PostTasks) {
+  std::vector<int> run_order;
+  std::vector<OnceClosure> tasks;
+  for (int i = 0; i < 10; ++i) {
+    tasks.push_back(BindOnce(
+        [](std::vector<int>* run_order, int i) { run_order->push_back(i); },
+        Unretained(&run_order), i));
+  }
+  tasks.push_back(BindOnce(&MessageLoopTaskRunnerThreadingTest::BasicFunction,
+                           Unretained(this)));
+  EXPECT_TRUE(
+      file_thread_->task_runner()->PostTasks(FROM_HERE, std::move(tasks)));
+  RunLoop().Run();
+
+  ASSERT_EQ(10U, run_order.size());
+  for (int i = 0; i < 10; ++i)
+    EXPECT_EQ(i, run_order[i]);
+}
+
+TEST_F(MessageLoopTaskRunnerThreadingTest, PostTasksAfterThreadExits) {
+  std::unique_ptr<Thread> test_thread(
+      new Thread("MessageLoopTaskRunnerThreadingTest_Dummy"));
+  test_thread->Start();
+  scoped_refptr<SingleThreadTaskRunner> task_runner =
+      test_thread->task_runner();
+  test_thread->Stop();
+
+  std::vector<OnceClosure> tasks;
+  tasks.push_back(BindOnce(&MessageLoopTaskRunnerThreadingTest::AssertNotRun));
+  tasks.push_back(BindOnce(&MessageLoopTaskRunnerThreadingTest::AssertNotRun));
+  EXPECT_FALSE(task_runner->PostTasks(FROM_HERE, std::move(tasks)));
+}
+
 }  // namespace base
@@ -501,7 +501,10 @@ void Histogram::AddCount(int value, int count) {
     NOTREACHED();
     return;
   }
-  unlogged_samples_->Accumulate(value, count);
+  if (flags() & kShardedCounts)
+    GetOrCreateShardedCounts()->Accumulate(value, count);
+  else
+    unlogged_samples_->Accumulate(value, count);
 
   FindAndRunCallback(value);
 }
@@ -638,7 +641,10 @@ Histogram::Histogram(const char* name,
       unlogged_samples_->id(), ranges, logged_meta, logged_counts));
 }
 
-Histogram::~Histogram() = default;
+Histogram::~Histogram() {
+  delete reinterpret_cast<ShardedSampleCounts*>(
+      subtle::NoBarrier_Load(&sharded_counts_));
+}
 
 bool Histogram::PrintEmptyBucket(uint32_t index) const {
   return true;
@@ -699,12 +705,33 @@ std::unique_ptr<SampleVector> Histogram::SnapshotAllSamples() const {
 }
 
 std::unique_ptr<SampleVector> Histogram::SnapshotUnloggedSamples() const {
+  if (ShardedSampleCounts* sharded_counts =
+          reinterpret_cast<ShardedSampleCounts*>(
+              subtle::Acquire_Load(&sharded_counts_))) {
+    sharded_counts->Fold();
+  }
+
   std::unique_ptr<SampleVector> samples(
       new SampleVector(unlogged_samples_->id(), bucket_ranges()));
   samples->Add(*unlogged_samples_);
   return samples;
 }
 
+ShardedSampleCounts* Histogram::GetOrCreateShardedCounts() {
+  subtle::AtomicWord sharded_counts = subtle::Acquire_Load(&sharded_counts_);
+  if (sharded_counts)
+    return reinterpret_cast<ShardedSampleCounts*>(sharded_counts);
+
+  // Threads adding the first samples may race to create the shards; the
+  // losers delete theirs.
+  auto created = std::make_unique<ShardedSampleCounts>(unlogged_samples_.get());
+  sharded_counts = subtle::Release_CompareAndSwap(
+      &sharded_counts_, 0, reinterpret_cast<subtle::AtomicWord>(created.get()));
+  if (sharded_counts)
+    return reinterpret_cast<ShardedSampleCounts*>(sharded_counts);
+  return created.release();
+}
+
 void Histogram::WriteAsciiImpl(bool graph_it,
                                const std::string& newline,
                                std::string* output) const {
@@ -72,6 +72,7 @@
 #include <string>
 #include <vector>
 
+#include "base/atomicops.h"
 #include "base/base_export.h"
 #include "base/compiler_specific.h"
 #include "base/containers/span.h"
@@ -96,6 +97,7 @@ class Pickle;
 class PickleIterator;
 class SampleVector;
 class SampleVectorBase;
+class ShardedSampleCounts;
 
 class BASE_EXPORT Histogram : public HistogramBase {
  public:
@@ -290,6 +292,10 @@ class BASE_EXPORT Histogram : public HistogramBase {
   // Create a copy of unlogged samples.
   std::unique_ptr<SampleVector> SnapshotUnloggedSamples() const;
 
+  // Returns the shards that samples are accumulated to when the
+  // kShardedCounts flag is set, creating them if needed.
+  ShardedSampleCounts* GetOrCreateShardedCounts();
+
   //----------------------------------------------------------------------------
   // Helpers for emitting Ascii graphic.  Each method appends data to output.
 
@@ -326,6 +332,10 @@ class BASE_EXPORT Histogram : public HistogramBase {
   // Accumulation of all samples that have been logged with SnapshotDelta().
   std::unique_ptr<SampleVectorBase> logged_samples_;
 
+  // Per-CPU shards of |unlogged_samples_|, holding a ShardedSampleCounts*
+  // created by the first sample added with the kShardedCounts flag set.
+  subtle::AtomicWord sharded_counts_ = 0;
+
 #if DCHECK_IS_ON()  // Don't waste memory if it won't be used.
   // Flag to indicate if PrepareFinalDelta has been previously called. It is
   // used to DCHECK that a final delta is not created multiple times.
@@ -131,6 +131,14 @@ class BASE_EXPORT HistogramBase {
     // MemoryAllocator, and that loaded into the Histogram module before this
     // histogram is created.
     kIsPersistent = 0x40,
+
+    // Indicates that samples are accumulated to per-CPU shards which are
+    // folded into the bucket counts when the histogram is snapshotted. This
+    // avoids contention on the bucket counts of histograms logged at high
+    // frequency from many threads, at the cost of memory for the shards and
+    // of other processes only seeing the samples once they are folded. Only
+    // supported by Histogram and its subclasses.
+    kShardedCounts = 0x80,
   };
 
   // Histogram data inconsistency types.
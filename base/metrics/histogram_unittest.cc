@@ -196,6 +196,41 @@ TEST_P(HistogramTest, DeltaTest) {
   EXPECT_EQ(0, samples->TotalCount());
 }
 
+// Check that samples accumulated to per-CPU shards are folded into the
+// snapshots, and only once.
+TEST_P(HistogramTest, ShardedCountsTest) {
+  HistogramBase* histogram =
+      Histogram::FactoryGet("ShardedHistogram", 1, 64, 8,
+                            HistogramBase::kShardedCounts);
+  histogram->Add(1);
+  histogram->Add(10);
+  histogram->AddCount(50, 3);
+
+  std::unique_ptr<HistogramSamples> samples = histogram->SnapshotSamples();
+  EXPECT_EQ(5, samples->TotalCount());
+  EXPECT_EQ(1 + 10 + 150, samples->sum());
+  EXPECT_EQ(samples->TotalCount(), samples->redundant_count());
+
+  samples = histogram->SnapshotDelta();
+  EXPECT_EQ(5, samples->TotalCount());
+  EXPECT_EQ(1, samples->GetCount(1));
+  EXPECT_EQ(1, samples->GetCount(10));
+  EXPECT_EQ(3, samples->GetCount(50));
+  EXPECT_EQ(samples->TotalCount(), samples->redundant_count());
+
+  samples = histogram->SnapshotDelta();
+  EXPECT_EQ(0, samples->TotalCount());
+
+  histogram->Add(10);
+  samples = histogram->SnapshotDelta();
+  EXPECT_EQ(1, samples->TotalCount());
+  EXPECT_EQ(1, samples->GetCount(10));
+
+  samples = histogram->SnapshotSamples();
+  EXPECT_EQ(6, samples->TotalCount());
+  EXPECT_EQ(2, samples->GetCount(10));
+}
+
 // Check that final-delta calculations work correctly.
 TEST_P(HistogramTest, FinalDeltaTest) {
   HistogramBase* histogram =
@@ -4,13 +4,24 @@
 
 #include "base/metrics/sample_vector.h"
 
+#include <string.h>
+
+#include "base/bits.h"
 #include "base/lazy_instance.h"
 #include "base/logging.h"
 #include "base/memory/ptr_util.h"
 #include "base/metrics/persistent_memory_allocator.h"
 #include "base/numerics/safe_conversions.h"
 #include "base/synchronization/lock.h"
+#include "base/sys_info.h"
 #include "base/threading/platform_thread.h"
+#include "build/build_config.h"
+
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+#include <sched.h>
+#elif defined(OS_WIN)
+#include <windows.h>
+#endif
 
 // This SampleVector makes use of the single-sample embedded in the base
 // HistogramSamples class. If the count is non-zero then there is guaranteed
@@ -23,6 +34,24 @@ namespace base {
 typedef HistogramBase::Count Count;
 typedef HistogramBase::Sample Sample;
 
+namespace {
+
+constexpr size_t kCacheLineSize = 64;
+
+// Beyond this many shards, CPUs share shards.
+constexpr size_t kMaxNumShards = 16;
+
+size_t GetNumShards() {
+  const size_t num_processors =
+      static_cast<size_t>(SysInfo::NumberOfProcessors());
+  size_t num_shards = 1;
+  while (num_shards < num_processors && num_shards < kMaxNumShards)
+    num_shards *= 2;
+  return num_shards;
+}
+
+}  // namespace
+
 SampleVectorBase::SampleVectorBase(uint64_t id,
                                    Metadata* meta,
                                    const BucketRanges* bucket_ranges)
@@ -361,6 +390,115 @@ PersistentSampleVector::CreateCountsStorageWhileLocked() {
   return static_cast<HistogramBase::AtomicCount*>(mem);
 }
 
+struct ShardedSampleCounts::Shard {
+#ifdef ARCH_CPU_64_BITS
+  subtle::Atomic64 sum;
+#else
+  // As in HistogramSamples::Metadata, 32-bit systems don't have atomic 64-bit
+  // operations.
+  int64_t sum;
+#endif
+  HistogramBase::AtomicCount redundant_count;
+};
+
+ShardedSampleCounts::ShardedSampleCounts(SampleVectorBase* samples)
+    : samples_(samples),
+      num_shards_(GetNumShards()),
+      shard_size_(bits::Align(
+          sizeof(Shard) +
+              samples->counts_size() * sizeof(HistogramBase::AtomicCount),
+          kCacheLineSize)),
+      shards_(static_cast<char*>(
+          AlignedAlloc(num_shards_ * shard_size_, kCacheLineSize))) {
+  memset(shards_.get(), 0, num_shards_ * shard_size_);
+}
+
+ShardedSampleCounts::~ShardedSampleCounts() = default;
+
+void ShardedSampleCounts::Accumulate(Sample value, Count count) {
+  const size_t bucket_index = samples_->GetBucketIndex(value);
+  Shard* const shard = GetShard(GetCurrentShardIndex());
+
+  // The redundant count is incremented last so that Fold() can skip the
+  // shards where it's zero.
+  subtle::NoBarrier_AtomicIncrement(&GetShardCounts(shard)[bucket_index],
+                                    count);
+#ifdef ARCH_CPU_64_BITS
+  subtle::NoBarrier_AtomicIncrement(&shard->sum,
+                                    strict_cast<int64_t>(count) * value);
+#else
+  shard->sum += strict_cast<int64_t>(count) * value;
+#endif
+  subtle::NoBarrier_AtomicIncrement(&shard->redundant_count, count);
+}
+
+void ShardedSampleCounts::Fold() {
+  const size_t counts_size = samples_->counts_size();
+  std::vector<HistogramBase::AtomicCount> counts(counts_size);
+  int64_t sum = 0;
+  Count redundant_count = 0;
+  for (size_t i = 0; i < num_shards_; ++i) {
+    Shard* const shard = GetShard(i);
+    if (!subtle::NoBarrier_Load(&shard->redundant_count))
+      continue;
+
+    HistogramBase::AtomicCount* const shard_counts = GetShardCounts(shard);
+    for (size_t bucket = 0; bucket < counts_size; ++bucket) {
+      if (subtle::NoBarrier_Load(&shard_counts[bucket])) {
+        counts[bucket] +=
+            subtle::NoBarrier_AtomicExchange(&shard_counts[bucket], 0);
+      }
+    }
+#ifdef ARCH_CPU_64_BITS
+    sum += subtle::NoBarrier_AtomicExchange(&shard->sum, 0);
+#else
+    sum += shard->sum;
+    shard->sum = 0;
+#endif
+    redundant_count +=
+        subtle::NoBarrier_AtomicExchange(&shard->redundant_count, 0);
+  }
+  if (!redundant_count)
+    return;
+
+  // Like HistogramSamples::Add(), without building a HistogramSamples.
+  samples_->IncreaseSumAndCount(sum, redundant_count);
+  SampleVectorIterator iterator(counts.data(), counts_size,
+                                samples_->bucket_ranges());
+  const bool success =
+      samples_->AddSubtractImpl(&iterator, SampleVectorBase::ADD);
+  DCHECK(success);
+}
+
+ShardedSampleCounts::Shard* ShardedSampleCounts::GetShard(size_t index) const {
+  DCHECK_LT(index, num_shards_);
+  return reinterpret_cast<Shard*>(shards_.get() + index * shard_size_);
+}
+
+HistogramBase::AtomicCount* ShardedSampleCounts::GetShardCounts(
+    Shard* shard) const {
+  static_assert(sizeof(Shard) % alignof(HistogramBase::AtomicCount) == 0,
+                "counts following a Shard must be aligned");
+  return reinterpret_cast<HistogramBase::AtomicCount*>(shard + 1);
+}
+
+size_t ShardedSampleCounts::GetCurrentShardIndex() const {
+  const size_t mask = num_shards_ - 1;
+#if defined(OS_WIN)
+  return GetCurrentProcessorNumber() & mask;
+#else
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+  const int cpu = sched_getcpu();
+  if (cpu >= 0)
+    return static_cast<size_t>(cpu) & mask;
+#endif
+  // Without the number of the current CPU, spread threads over the shards.
+  const uint32_t thread_id =
+      static_cast<uint32_t>(PlatformThread::CurrentId());
+  return ((thread_id * 0x9E3779B9u) >> 16) & mask;
+#endif
+}
+
 SampleVectorIterator::SampleVectorIterator(
     const std::vector<HistogramBase::AtomicCount>* counts,
     const BucketRanges* bucket_ranges)
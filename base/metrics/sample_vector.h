@@ -18,6 +18,7 @@
 #include "base/compiler_specific.h"
 #include "base/gtest_prod_util.h"
 #include "base/macros.h"
+#include "base/memory/aligned_memory.h"
 #include "base/metrics/bucket_ranges.h"
 #include "base/metrics/histogram_base.h"
 #include "base/metrics/histogram_samples.h"
@@ -88,6 +89,7 @@ class BASE_EXPORT SampleVectorBase : public HistogramSamples {
   size_t counts_size() const { return bucket_ranges_->bucket_count(); }
 
  private:
+  friend class ShardedSampleCounts;
   friend class SampleVectorTest;
   FRIEND_TEST_ALL_PREFIXES(HistogramTest, CorruptSampleCounts);
   FRIEND_TEST_ALL_PREFIXES(SharedHistogramTest, CorruptSampleCounts);
@@ -149,6 +151,57 @@ class BASE_EXPORT PersistentSampleVector : public SampleVectorBase {
   DISALLOW_COPY_AND_ASSIGN(PersistentSampleVector);
 };
 
+// Per-CPU shards of the samples of a sample vector, for histograms that are
+// logged at high frequency from many threads (see
+// HistogramBase::kShardedCounts). Threads accumulate to the shard of the CPU
+// they run on, so they don't bounce the cache lines of the bucket counts
+// between CPUs. The shards are folded into the sample vector, which may be in
+// persistent memory, when the histogram is snapshotted; until then the samples
+// are only visible through this object.
+class BASE_EXPORT ShardedSampleCounts {
+ public:
+  // Samples are folded into |samples|, which must outlive this object.
+  explicit ShardedSampleCounts(SampleVectorBase* samples);
+  ~ShardedSampleCounts();
+
+  // Adds |count| samples of |value| to the shard of the current CPU.
+  //
+  // This method is thread safe.
+  void Accumulate(HistogramBase::Sample value, HistogramBase::Count count);
+
+  // Moves the samples of all the shards to the sample vector. Samples
+  // accumulated concurrently are moved either by this call or the next one.
+  //
+  // This method is thread safe.
+  void Fold();
+
+  size_t num_shards() const { return num_shards_; }
+
+ private:
+  // The header of each shard, followed by its bucket counts.
+  struct Shard;
+
+  Shard* GetShard(size_t index) const;
+  HistogramBase::AtomicCount* GetShardCounts(Shard* shard) const;
+
+  // Returns the index of the shard of the current CPU.
+  size_t GetCurrentShardIndex() const;
+
+  SampleVectorBase* const samples_;
+
+  // A power of 2.
+  const size_t num_shards_;
+
+  // Size of each shard in bytes, a multiple of the cache line size so that
+  // shards don't share cache lines.
+  const size_t shard_size_;
+
+  // |num_shards_| shards of |shard_size_| bytes, aligned on cache lines.
+  std::unique_ptr<char, AlignedFreeDeleter> shards_;
+
+  DISALLOW_COPY_AND_ASSIGN(ShardedSampleCounts);
+};
+
 // An iterator for sample vectors. This could be defined privately in the .cc
 // file but is here for easy testing.
 class BASE_EXPORT SampleVectorIterator : public SampleCountIterator {
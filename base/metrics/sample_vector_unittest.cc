@@ -15,6 +15,7 @@
 #include "base/metrics/histogram.h"
 #include "base/metrics/persistent_memory_allocator.h"
 #include "base/test/gtest_util.h"
+#include "base/threading/simple_thread.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace base {
@@ -542,4 +543,94 @@ TEST_F(SampleVectorTest, PersistentSampleVectorTestWithOutsideAlloc) {
   EXPECT_EQ(200, samples2.GetCount(8));
 }
 
+TEST_F(SampleVectorTest, ShardedSampleCounts) {
+  // Custom buckets: [1, 5) [5, 10)
+  BucketRanges ranges(3);
+  ranges.set_range(0, 1);
+  ranges.set_range(1, 5);
+  ranges.set_range(2, 10);
+  SampleVector samples(1, &ranges);
+  ShardedSampleCounts sharded_counts(&samples);
+  EXPECT_GE(sharded_counts.num_shards(), 1u);
+
+  // Nothing is visible until the shards are folded.
+  sharded_counts.Accumulate(1, 200);
+  sharded_counts.Accumulate(5, 100);
+  EXPECT_EQ(0, samples.TotalCount());
+  EXPECT_EQ(0, samples.sum());
+
+  sharded_counts.Fold();
+  EXPECT_EQ(200, samples.GetCountAtIndex(0));
+  EXPECT_EQ(100, samples.GetCountAtIndex(1));
+  EXPECT_EQ(700, samples.sum());
+  EXPECT_EQ(300, samples.redundant_count());
+
+  // Folding moves the samples: they are only added once.
+  sharded_counts.Fold();
+  EXPECT_EQ(300, samples.TotalCount());
+
+  // A single folded sample can use the single-sample storage.
+  SampleVector single_sample(2, &ranges);
+  ShardedSampleCounts single_sample_shards(&single_sample);
+  single_sample_shards.Accumulate(6, 3);
+  single_sample_shards.Fold();
+  EXPECT_EQ(3, single_sample.GetCountAtIndex(1));
+  EXPECT_EQ(nullptr, GetSamplesCounts(single_sample));
+}
+
+namespace {
+
+class AccumulateThread : public SimpleThread {
+ public:
+  AccumulateThread(ShardedSampleCounts* sharded_counts, int num_samples)
+      : SimpleThread("AccumulateThread"),
+        sharded_counts_(sharded_counts),
+        num_samples_(num_samples) {}
+
+  void Run() override {
+    for (int i = 0; i < num_samples_; ++i)
+      sharded_counts_->Accumulate(i % 2 ? 1 : 5, 1);
+  }
+
+ private:
+  ShardedSampleCounts* const sharded_counts_;
+  const int num_samples_;
+
+  DISALLOW_COPY_AND_ASSIGN(AccumulateThread);
+};
+
+}  // namespace
+
+// Verify that folding concurrently with accumulation loses no samples.
+TEST_F(SampleVectorTest, ShardedSampleCountsConcurrentFold) {
+  constexpr int kNumThreads = 4;
+  constexpr int kNumSamplesPerThread = 10000;
+  // Custom buckets: [1, 5) [5, 10)
+  BucketRanges ranges(3);
+  ranges.set_range(0, 1);
+  ranges.set_range(1, 5);
+  ranges.set_range(2, 10);
+  SampleVector samples(1, &ranges);
+  ShardedSampleCounts sharded_counts(&samples);
+
+  std::vector<std::unique_ptr<AccumulateThread>> threads;
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads.push_back(std::make_unique<AccumulateThread>(
+        &sharded_counts, kNumSamplesPerThread));
+    threads.back()->Start();
+  }
+  for (int i = 0; i < 100; ++i)
+    sharded_counts.Fold();
+  for (const auto& thread : threads)
+    thread->Join();
+  sharded_counts.Fold();
+
+  EXPECT_EQ(kNumThreads * kNumSamplesPerThread / 2,
+            samples.GetCountAtIndex(0));
+  EXPECT_EQ(kNumThreads * kNumSamplesPerThread / 2,
+            samples.GetCountAtIndex(1));
+  EXPECT_EQ(kNumThreads * kNumSamplesPerThread * 3, samples.sum());
+  EXPECT_EQ(kNumThreads * kNumSamplesPerThread, samples.redundant_count());
+}
+
 }  // namespace base
@@ -23,6 +23,9 @@
 namespace base {
 namespace {
 
+// Capacity of empty histogram tables.
+constexpr size_t kMinCapacity = 64;
+
 bool HistogramNameLesser(const base::HistogramBase* a,
                          const base::HistogramBase* b) {
   return strcmp(a->histogram_name(), b->histogram_name()) < 0;
@@ -34,7 +37,7 @@ bool HistogramNameLesser(const base::HistogramBase* a,
 LazyInstance<Lock>::Leaky StatisticsRecorder::lock_;
 
 // static
-StatisticsRecorder* StatisticsRecorder::top_ = nullptr;
+std::atomic<StatisticsRecorder*> StatisticsRecorder::top_{nullptr};
 
 // static
 bool StatisticsRecorder::is_vlog_initialized_ = false;
@@ -50,30 +53,130 @@ bool StatisticsRecorder::BucketRangesEqual::operator()(
   return a->Equals(b);
 }
 
+struct StatisticsRecorder::HistogramTable::Slots {
+  explicit Slots(size_t capacity)
+      : capacity(capacity),
+        histograms(new std::atomic<HistogramBase*>[capacity]) {
+    for (size_t i = 0; i < capacity; ++i)
+      histograms[i].store(nullptr, std::memory_order_relaxed);
+  }
+
+  // Returns the slot of the histogram named |name|, or the empty slot where
+  // it would be added.
+  std::atomic<HistogramBase*>* FindSlot(StringPiece name) const {
+    const size_t mask = capacity - 1;
+    for (size_t i = StringPieceHash()(name) & mask;; i = (i + 1) & mask) {
+      HistogramBase* const histogram =
+          histograms[i].load(std::memory_order_acquire);
+      if (!histogram || name == histogram->histogram_name())
+        return &histograms[i];
+    }
+  }
+
+  // A power of 2.
+  const size_t capacity;
+  const std::unique_ptr<std::atomic<HistogramBase*>[]> histograms;
+};
+
+StatisticsRecorder::HistogramTable::HistogramTable() {
+  all_slots_.push_back(std::make_unique<Slots>(kMinCapacity));
+  slots_.store(all_slots_.back().get(), std::memory_order_release);
+}
+
+StatisticsRecorder::HistogramTable::~HistogramTable() = default;
+
+HistogramBase* StatisticsRecorder::HistogramTable::Find(
+    StringPiece name) const {
+  return slots_.load(std::memory_order_acquire)
+      ->FindSlot(name)
+      ->load(std::memory_order_acquire);
+}
+
+void StatisticsRecorder::HistogramTable::Insert(HistogramBase* histogram) {
+  lock_.Get().AssertAcquired();
+  const Slots* slots = slots_.load(std::memory_order_relaxed);
+  if ((size_ + 1) * 2 > slots->capacity) {
+    Rebuild(size_ + 1, nullptr);
+    slots = slots_.load(std::memory_order_relaxed);
+  }
+  std::atomic<HistogramBase*>* const slot =
+      slots->FindSlot(histogram->histogram_name());
+  DCHECK(!slot->load(std::memory_order_relaxed));
+  slot->store(histogram, std::memory_order_release);
+  ++size_;
+}
+
+void StatisticsRecorder::HistogramTable::Remove(StringPiece name) {
+  lock_.Get().AssertAcquired();
+  const HistogramBase* const histogram = Find(name);
+  if (!histogram)
+    return;
+  // Slots can't be emptied in place without breaking the probe sequences of
+  // concurrent lookups.
+  Rebuild(size_, histogram);
+  --size_;
+}
+
+void StatisticsRecorder::HistogramTable::AppendTo(
+    Histograms* histograms) const {
+  lock_.Get().AssertAcquired();
+  const Slots* const slots = slots_.load(std::memory_order_relaxed);
+  histograms->reserve(histograms->size() + size_);
+  for (size_t i = 0; i < slots->capacity; ++i) {
+    if (HistogramBase* histogram =
+            slots->histograms[i].load(std::memory_order_relaxed)) {
+      histograms->push_back(histogram);
+    }
+  }
+}
+
+void StatisticsRecorder::HistogramTable::Rebuild(
+    size_t min_size,
+    const HistogramBase* excluded) {
+  const Slots* const old_slots = slots_.load(std::memory_order_relaxed);
+  size_t capacity = kMinCapacity;
+  while (capacity < min_size * 2)
+    capacity *= 2;
+  auto new_slots = std::make_unique<Slots>(capacity);
+  for (size_t i = 0; i < old_slots->capacity; ++i) {
+    HistogramBase* const histogram =
+        old_slots->histograms[i].load(std::memory_order_relaxed);
+    if (histogram && histogram != excluded) {
+      new_slots->FindSlot(histogram->histogram_name())
+          ->store(histogram, std::memory_order_relaxed);
+    }
+  }
+  // Lookups that loaded the old table keep using it, so it is kept alive.
+  slots_.store(new_slots.get(), std::memory_order_release);
+  all_slots_.push_back(std::move(new_slots));
+}
+
 StatisticsRecorder::~StatisticsRecorder() {
   const AutoLock auto_lock(lock_.Get());
-  DCHECK_EQ(this, top_);
-  top_ = previous_;
+  DCHECK_EQ(this, top_.load(std::memory_order_relaxed));
+  top_.store(previous_, std::memory_order_release);
 }
 
 // static
-void StatisticsRecorder::EnsureGlobalRecorderWhileLocked() {
+StatisticsRecorder* StatisticsRecorder::EnsureGlobalRecorderWhileLocked() {
   lock_.Get().AssertAcquired();
-  if (top_)
-    return;
+  StatisticsRecorder* top = top_.load(std::memory_order_relaxed);
+  if (top)
+    return top;
 
-  const StatisticsRecorder* const p = new StatisticsRecorder;
+  top = new StatisticsRecorder;
   // The global recorder is never deleted.
-  ANNOTATE_LEAKING_OBJECT_PTR(p);
-  DCHECK_EQ(p, top_);
+  ANNOTATE_LEAKING_OBJECT_PTR(top);
+  DCHECK_EQ(top, top_.load(std::memory_order_relaxed));
+  return top;
 }
 
 // static
 void StatisticsRecorder::RegisterHistogramProvider(
     const WeakPtr<HistogramProvider>& provider) {
   const AutoLock auto_lock(lock_.Get());
-  EnsureGlobalRecorderWhileLocked();
-  top_->providers_.push_back(provider);
+  StatisticsRecorder* const top = EnsureGlobalRecorderWhileLocked();
+  top->providers_.push_back(provider);
 }
 
 // static
@@ -82,20 +185,20 @@ HistogramBase* StatisticsRecorder::RegisterOrDeleteDuplicate(
   // Declared before |auto_lock| to ensure correct destruction order.
   std::unique_ptr<HistogramBase> histogram_deleter;
   const AutoLock auto_lock(lock_.Get());
-  EnsureGlobalRecorderWhileLocked();
+  StatisticsRecorder* const top = EnsureGlobalRecorderWhileLocked();
 
   const char* const name = histogram->histogram_name();
-  HistogramBase*& registered = top_->histograms_[name];
+  HistogramBase* const registered = top->histograms_.Find(name);
 
   if (!registered) {
     // |name| is guaranteed to never change or be deallocated so long
     // as the histogram is alive (which is forever).
-    registered = histogram;
+    top->histograms_.Insert(histogram);
     ANNOTATE_LEAKING_OBJECT_PTR(histogram);  // see crbug.com/79322
     // If there are callbacks for this histogram, we set the kCallbackExists
     // flag.
-    const auto callback_iterator = top_->callbacks_.find(name);
-    if (callback_iterator != top_->callbacks_.end()) {
+    const auto callback_iterator = top->callbacks_.find(name);
+    if (callback_iterator != top->callbacks_.end()) {
       if (!callback_iterator->second.is_null())
         histogram->SetFlags(HistogramBase::kCallbackExists);
       else
@@ -122,9 +225,9 @@ const BucketRanges* StatisticsRecorder::RegisterOrDeleteDuplicateRanges(
   // Declared before |auto_lock| to ensure correct destruction order.
   std::unique_ptr<const BucketRanges> ranges_deleter;
   const AutoLock auto_lock(lock_.Get());
-  EnsureGlobalRecorderWhileLocked();
+  StatisticsRecorder* const top = EnsureGlobalRecorderWhileLocked();
 
-  const BucketRanges* const registered = *top_->ranges_.insert(ranges).first;
+  const BucketRanges* const registered = *top->ranges_.insert(ranges).first;
   if (registered == ranges) {
     ANNOTATE_LEAKING_OBJECT_PTR(ranges);
   } else {
@@ -178,9 +281,9 @@ std::string StatisticsRecorder::ToJSON(JSONVerbosityLevel verbosity_level) {
 std::vector<const BucketRanges*> StatisticsRecorder::GetBucketRanges() {
   std::vector<const BucketRanges*> out;
   const AutoLock auto_lock(lock_.Get());
-  EnsureGlobalRecorderWhileLocked();
-  out.reserve(top_->ranges_.size());
-  out.assign(top_->ranges_.begin(), top_->ranges_.end());
+  StatisticsRecorder* const top = EnsureGlobalRecorderWhileLocked();
+  out.reserve(top->ranges_.size());
+  out.assign(top->ranges_.begin(), top->ranges_.end());
   return out;
 }
 
@@ -191,19 +294,20 @@ HistogramBase* StatisticsRecorder::FindHistogram(base::StringPiece name) {
   // will acquire the lock at that time.
   ImportGlobalPersistentHistograms();
 
-  const AutoLock auto_lock(lock_.Get());
-  EnsureGlobalRecorderWhileLocked();
-
-  const HistogramMap::const_iterator it = top_->histograms_.find(name);
-  return it != top_->histograms_.end() ? it->second : nullptr;
+  const StatisticsRecorder* top = top_.load(std::memory_order_acquire);
+  if (!top) {
+    const AutoLock auto_lock(lock_.Get());
+    top = EnsureGlobalRecorderWhileLocked();
+  }
+  return top->histograms_.Find(name);
 }
 
 // static
 StatisticsRecorder::HistogramProviders
 StatisticsRecorder::GetHistogramProviders() {
   const AutoLock auto_lock(lock_.Get());
-  EnsureGlobalRecorderWhileLocked();
-  return top_->providers_;
+  StatisticsRecorder* const top = EnsureGlobalRecorderWhileLocked();
+  return top->providers_;
 }
 
 // static
@@ -242,14 +346,13 @@ bool StatisticsRecorder::SetCallback(
     const StatisticsRecorder::OnSampleCallback& cb) {
   DCHECK(!cb.is_null());
   const AutoLock auto_lock(lock_.Get());
-  EnsureGlobalRecorderWhileLocked();
+  StatisticsRecorder* const top = EnsureGlobalRecorderWhileLocked();
 
-  if (!top_->callbacks_.insert({name, cb}).second)
+  if (!top->callbacks_.insert({name, cb}).second)
     return false;
 
-  const HistogramMap::const_iterator it = top_->histograms_.find(name);
-  if (it != top_->histograms_.end())
-    it->second->SetFlags(HistogramBase::kCallbackExists);
+  if (HistogramBase* const histogram = top->histograms_.Find(name))
+    histogram->SetFlags(HistogramBase::kCallbackExists);
 
   return true;
 }
@@ -257,42 +360,40 @@ bool StatisticsRecorder::SetCallback(
 // static
 void StatisticsRecorder::ClearCallback(const std::string& name) {
   const AutoLock auto_lock(lock_.Get());
-  EnsureGlobalRecorderWhileLocked();
+  StatisticsRecorder* const top = EnsureGlobalRecorderWhileLocked();
 
-  top_->callbacks_.erase(name);
+  top->callbacks_.erase(name);
 
   // We also clear the flag from the histogram (if it exists).
-  const HistogramMap::const_iterator it = top_->histograms_.find(name);
-  if (it != top_->histograms_.end())
-    it->second->ClearFlags(HistogramBase::kCallbackExists);
+  if (HistogramBase* const histogram = top->histograms_.Find(name))
+    histogram->ClearFlags(HistogramBase::kCallbackExists);
 }
 
 // static
 StatisticsRecorder::OnSampleCallback StatisticsRecorder::FindCallback(
     const std::string& name) {
   const AutoLock auto_lock(lock_.Get());
-  EnsureGlobalRecorderWhileLocked();
-  const auto it = top_->callbacks_.find(name);
-  return it != top_->callbacks_.end() ? it->second : OnSampleCallback();
+  StatisticsRecorder* const top = EnsureGlobalRecorderWhileLocked();
+  const auto it = top->callbacks_.find(name);
+  return it != top->callbacks_.end() ? it->second : OnSampleCallback();
 }
 
 // static
 size_t StatisticsRecorder::GetHistogramCount() {
   const AutoLock auto_lock(lock_.Get());
-  EnsureGlobalRecorderWhileLocked();
-  return top_->histograms_.size();
+  StatisticsRecorder* const top = EnsureGlobalRecorderWhileLocked();
+  return top->histograms_.size();
 }
 
 // static
 void StatisticsRecorder::ForgetHistogramForTesting(base::StringPiece name) {
   const AutoLock auto_lock(lock_.Get());
-  EnsureGlobalRecorderWhileLocked();
+  StatisticsRecorder* const top = EnsureGlobalRecorderWhileLocked();
 
-  const HistogramMap::iterator found = top_->histograms_.find(name);
-  if (found == top_->histograms_.end())
+  HistogramBase* const base = top->histograms_.Find(name);
+  if (!base)
     return;
 
-  HistogramBase* const base = found->second;
   if (base->GetHistogramType() != SPARSE_HISTOGRAM) {
     // When forgetting a histogram, it's likely that other information is
     // also becoming invalid. Clear the persistent reference that may no
@@ -301,7 +402,7 @@ void StatisticsRecorder::ForgetHistogramForTesting(base::StringPiece name) {
     static_cast<Histogram*>(base)->bucket_ranges()->set_persistent_reference(0);
   }
 
-  top_->histograms_.erase(found);
+  top->histograms_.Remove(name);
 }
 
 // static
@@ -315,16 +416,16 @@ StatisticsRecorder::CreateTemporaryForTesting() {
 void StatisticsRecorder::SetRecordChecker(
     std::unique_ptr<RecordHistogramChecker> record_checker) {
   const AutoLock auto_lock(lock_.Get());
-  EnsureGlobalRecorderWhileLocked();
-  top_->record_checker_ = std::move(record_checker);
+  StatisticsRecorder* const top = EnsureGlobalRecorderWhileLocked();
+  top->record_checker_ = std::move(record_checker);
 }
 
 // static
 bool StatisticsRecorder::ShouldRecordHistogram(uint64_t histogram_hash) {
   const AutoLock auto_lock(lock_.Get());
-  EnsureGlobalRecorderWhileLocked();
-  return !top_->record_checker_ ||
-         top_->record_checker_->ShouldRecord(histogram_hash);
+  StatisticsRecorder* const top = EnsureGlobalRecorderWhileLocked();
+  return !top->record_checker_ ||
+         top->record_checker_->ShouldRecord(histogram_hash);
 }
 
 // static
@@ -337,11 +438,9 @@ StatisticsRecorder::Histograms StatisticsRecorder::GetHistograms() {
   Histograms out;
 
   const AutoLock auto_lock(lock_.Get());
-  EnsureGlobalRecorderWhileLocked();
+  StatisticsRecorder* const top = EnsureGlobalRecorderWhileLocked();
 
-  out.reserve(top_->histograms_.size());
-  for (const auto& entry : top_->histograms_)
-    out.push_back(entry.second);
+  top->histograms_.AppendTo(&out);
 
   return out;
 }
@@ -394,8 +493,8 @@ void StatisticsRecorder::ImportGlobalPersistentHistograms() {
 // support for all future calls.
 StatisticsRecorder::StatisticsRecorder() {
   lock_.Get().AssertAcquired();
-  previous_ = top_;
-  top_ = this;
+  previous_ = top_.load(std::memory_order_relaxed);
+  top_.store(this, std::memory_order_release);
   InitLogOnShutdownWhileLocked();
 }
 
@@ -12,6 +12,7 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -223,8 +224,60 @@ class BASE_EXPORT StatisticsRecorder {
  private:
   typedef std::vector<WeakPtr<HistogramProvider>> HistogramProviders;
 
-  typedef std::unordered_map<StringPiece, HistogramBase*, StringPieceHash>
-      HistogramMap;
+  // Histograms of a recorder, keyed by name. Lookups are lock-free so that
+  // the histogram factories, which look up the histogram on every call when
+  // the name isn't known at compile time, don't contend on the global lock.
+  //
+  // This is an open-addressed table of histogram pointers which is at most
+  // half full. Histograms are added in place with a release store, and a new
+  // table is published when it grows or when a histogram is removed. Replaced
+  // tables may still be read by lookups so they are only deleted with the
+  // recorder; their total size is bounded by the size of the current table
+  // since each growth doubles it.
+  class HistogramTable {
+   public:
+    HistogramTable();
+    ~HistogramTable();
+
+    // Returns the histogram named |name|, or a null pointer.
+    //
+    // This method is thread safe and lock-free.
+    HistogramBase* Find(StringPiece name) const;
+
+    // Adds |histogram|, whose name must not be in the table.
+    //
+    // Precondition: The global lock is already acquired.
+    void Insert(HistogramBase* histogram);
+
+    // Removes the histogram named |name|, if any.
+    //
+    // Precondition: The global lock is already acquired.
+    void Remove(StringPiece name);
+
+    // Appends all the histograms to |histograms|.
+    //
+    // Precondition: The global lock is already acquired.
+    void AppendTo(Histograms* histograms) const;
+
+    // Precondition: The global lock is already acquired.
+    size_t size() const { return size_; }
+
+   private:
+    struct Slots;
+
+    // Publishes a table with room for |min_size| histograms that has the
+    // histograms of the current one except |excluded|.
+    void Rebuild(size_t min_size, const HistogramBase* excluded);
+
+    std::atomic<const Slots*> slots_;
+
+    // The current table, followed by replaced ones.
+    std::vector<std::unique_ptr<Slots>> all_slots_;
+
+    size_t size_ = 0;
+
+    DISALLOW_COPY_AND_ASSIGN(HistogramTable);
+  };
 
   // We keep a map of callbacks to histograms, so that as histograms are
   // created, we can set the callback properly.
@@ -245,11 +298,11 @@ class BASE_EXPORT StatisticsRecorder {
   friend class StatisticsRecorderTest;
   FRIEND_TEST_ALL_PREFIXES(StatisticsRecorderTest, IterationTest);
 
-  // Initializes the global recorder if it doesn't already exist. Safe to call
-  // multiple times.
+  // Initializes the global recorder if it doesn't already exist, and returns
+  // it. Safe to call multiple times.
   //
   // Precondition: The global lock is already acquired.
-  static void EnsureGlobalRecorderWhileLocked();
+  static StatisticsRecorder* EnsureGlobalRecorderWhileLocked();
 
   // Gets histogram providers.
   //
@@ -273,7 +326,7 @@ class BASE_EXPORT StatisticsRecorder {
   // Precondition: The global lock is already acquired.
   static void InitLogOnShutdownWhileLocked();
 
-  HistogramMap histograms_;
+  HistogramTable histograms_;
   CallbackMap callbacks_;
   RangesMap ranges_;
   HistogramProviders providers_;
@@ -287,8 +340,9 @@ class BASE_EXPORT StatisticsRecorder {
 
   // Current global recorder. This recorder is used by static methods. When a
   // new global recorder is created by CreateTemporaryForTesting(), then the
-  // previous global recorder is referenced by top_->previous_.
-  static StatisticsRecorder* top_;
+  // previous global recorder is referenced by top_->previous_. Only changed
+  // with the global lock, but FindHistogram() reads it without the lock.
+  static std::atomic<StatisticsRecorder*> top_;
 
   // Tracks whether InitLogOnShutdownWhileLocked() has registered a logging
   // function that will be called when the program finishes.
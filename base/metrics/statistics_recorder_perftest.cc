@@ -0,0 +1,75 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/metrics/histogram_functions.h"
+#include "base/metrics/statistics_recorder.h"
+#include "base/strings/stringprintf.h"
+#include "base/test/perf_benchmark.h"
+#include "base/threading/simple_thread.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+constexpr int kNumSamplesPerThread = 100000;
+constexpr int kNumHistogramNames = 100;
+constexpr int kMaxNumThreads = 16;
+
+// Logs samples to histograms whose names are only known at runtime, which
+// looks up the histogram on every sample.
+class LoggingThread : public SimpleThread {
+ public:
+  explicit LoggingThread(const std::vector<std::string>* names)
+      : SimpleThread("LoggingThread"), names_(names) {}
+
+  void Run() override {
+    for (int i = 0; i < kNumSamplesPerThread; ++i)
+      UmaHistogramCounts1000((*names_)[i % names_->size()], i % 1000);
+  }
+
+ private:
+  const std::vector<std::string>* const names_;
+
+  DISALLOW_COPY_AND_ASSIGN(LoggingThread);
+};
+
+}  // namespace
+
+TEST(StatisticsRecorderPerfTest, DynamicallyNamedHistograms) {
+  auto statistics_recorder = StatisticsRecorder::CreateTemporaryForTesting();
+  std::vector<std::string> names;
+  for (int i = 0; i < kNumHistogramNames; ++i)
+    names.push_back(StringPrintf("StatisticsRecorderPerfTest.Histogram%d", i));
+
+  // Wall time per sample of each thread: doesn't grow with the number of
+  // threads if lookups scale.
+  PerfBenchmark::Options options;
+  options.repetitions = 10;
+  options.operations_per_run = kNumSamplesPerThread;
+  for (int num_threads = 1; num_threads <= kMaxNumThreads; num_threads *= 2) {
+    PerfBenchmark("StatisticsRecorder_dynamically_named_histograms",
+                  StringPrintf("%d_threads", num_threads), options)
+        .RunMeasured([&] {
+          std::vector<std::unique_ptr<LoggingThread>> threads;
+          for (int i = 0; i < num_threads; ++i)
+            threads.push_back(std::make_unique<LoggingThread>(&names));
+
+          const TimeTicks start = TimeTicks::Now();
+          for (const auto& thread : threads)
+            thread->Start();
+          for (const auto& thread : threads)
+            thread->Join();
+          return TimeTicks::Now() - start;
+        });
+  }
+}
+
+}  // namespace base
@@ -7,6 +7,7 @@
 #include <stddef.h>
 
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -19,6 +20,8 @@
 #include "base/metrics/persistent_histogram_allocator.h"
 #include "base/metrics/record_histogram_checker.h"
 #include "base/metrics/sparse_histogram.h"
+#include "base/strings/stringprintf.h"
+#include "base/threading/simple_thread.h"
 #include "base/values.h"
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -258,6 +261,88 @@ TEST_P(StatisticsRecorderTest, FindHistogram) {
   EXPECT_FALSE(StatisticsRecorder::FindHistogram("TestHistogram"));
 }
 
+// Verify that histograms are still found after the histogram table grows and
+// after histograms are removed.
+TEST_P(StatisticsRecorderTest, FindHistogramAfterGrowthAndRemoval) {
+  constexpr int kNumHistograms = 500;
+  std::vector<std::string> names;
+  std::vector<HistogramBase*> histograms;
+  for (int i = 0; i < kNumHistograms; ++i) {
+    names.push_back(StringPrintf("TestHistogram%d", i));
+    histograms.push_back(StatisticsRecorder::RegisterOrDeleteDuplicate(
+        CreateHistogram(names.back().c_str(), 1, 1000, 10)));
+  }
+  EXPECT_EQ(static_cast<size_t>(kNumHistograms),
+            StatisticsRecorder::GetHistogramCount());
+  EXPECT_EQ(static_cast<size_t>(kNumHistograms),
+            StatisticsRecorder::GetHistograms().size());
+  for (int i = 0; i < kNumHistograms; ++i)
+    EXPECT_EQ(histograms[i], StatisticsRecorder::FindHistogram(names[i]));
+
+  for (int i = 0; i < kNumHistograms; i += 2)
+    StatisticsRecorder::ForgetHistogramForTesting(names[i]);
+  EXPECT_EQ(static_cast<size_t>(kNumHistograms / 2),
+            StatisticsRecorder::GetHistogramCount());
+  for (int i = 0; i < kNumHistograms; ++i) {
+    EXPECT_EQ(i % 2 ? histograms[i] : nullptr,
+              StatisticsRecorder::FindHistogram(names[i]));
+  }
+}
+
+namespace {
+
+// Registers histograms and looks up the histograms of other threads.
+class RegisterAndFindThread : public SimpleThread {
+ public:
+  RegisterAndFindThread(int thread_index, int num_threads)
+      : SimpleThread("RegisterAndFindThread"),
+        thread_index_(thread_index),
+        num_threads_(num_threads) {}
+
+  void Run() override {
+    for (int i = 0; i < kNumHistogramsPerThread; ++i) {
+      const std::string name =
+          StringPrintf("TestHistogram%d.%d", thread_index_, i);
+      HistogramBase* histogram = Histogram::FactoryGet(
+          name, 1, 1000, 10, HistogramBase::kNoFlags);
+      EXPECT_EQ(histogram, StatisticsRecorder::FindHistogram(name));
+      HistogramBase* other = StatisticsRecorder::FindHistogram(StringPrintf(
+          "TestHistogram%d.%d", (thread_index_ + 1) % num_threads_, i));
+      if (other) {
+        EXPECT_EQ(other,
+                  StatisticsRecorder::FindHistogram(other->histogram_name()));
+      }
+    }
+  }
+
+  static constexpr int kNumHistogramsPerThread = 200;
+
+ private:
+  const int thread_index_;
+  const int num_threads_;
+
+  DISALLOW_COPY_AND_ASSIGN(RegisterAndFindThread);
+};
+
+}  // namespace
+
+// Verify that lookups concurrent with registrations, which grow the histogram
+// table, find the registered histograms.
+TEST_P(StatisticsRecorderTest, ConcurrentRegisterAndFind) {
+  constexpr int kNumThreads = 4;
+  std::vector<std::unique_ptr<RegisterAndFindThread>> threads;
+  for (int i = 0; i < kNumThreads; ++i)
+    threads.push_back(std::make_unique<RegisterAndFindThread>(i, kNumThreads));
+  for (const auto& thread : threads)
+    thread->Start();
+  for (const auto& thread : threads)
+    thread->Join();
+
+  EXPECT_EQ(static_cast<size_t>(
+                kNumThreads * RegisterAndFindThread::kNumHistogramsPerThread),
+            StatisticsRecorder::GetHistogramCount());
+}
+
 TEST_P(StatisticsRecorderTest, WithName) {
   Histogram::FactoryGet("TestHistogram1", 1, 1000, 10, Histogram::kNoFlags);
   Histogram::FactoryGet("TestHistogram2", 1, 1000, 10, Histogram::kNoFlags);
@@ -207,6 +207,25 @@ bool PickleIterator::ReadBytes(const char** data, int length) {
   return true;
 }
 
+bool PickleIterator::ReadData(span<const uint8_t>* data) {
+  int length;
+  if (!ReadLength(&length))
+    return false;
+  return ReadBytes(data, length);
+}
+
+bool PickleIterator::ReadBytes(span<const uint8_t>* data, size_t length) {
+  if (!IsValueInRangeForNumericType<int>(length)) {
+    read_index_ = end_index_;
+    return false;
+  }
+  const char* read_from = GetReadPointerAndAdvance(static_cast<int>(length));
+  if (!read_from)
+    return false;
+  *data = make_span(reinterpret_cast<const uint8_t*>(read_from), length);
+  return true;
+}
+
 Pickle::Attachment::Attachment() = default;
 
 Pickle::Attachment::~Attachment() = default;
@@ -217,7 +236,8 @@ Pickle::Pickle()
     : header_(nullptr),
       header_size_(sizeof(Header)),
       capacity_after_header_(0),
-      write_offset_(0) {
+      write_offset_(0),
+      uses_external_buffer_(false) {
   static_assert((Pickle::kPayloadUnit & (Pickle::kPayloadUnit - 1)) == 0,
                 "Pickle::kPayloadUnit must be a power of two");
   Resize(kPayloadUnit);
@@ -228,7 +248,8 @@ Pickle::Pickle(int header_size)
     : header_(nullptr),
       header_size_(bits::Align(header_size, sizeof(uint32_t))),
       capacity_after_header_(0),
-      write_offset_(0) {
+      write_offset_(0),
+      uses_external_buffer_(false) {
   DCHECK_GE(static_cast<size_t>(header_size), sizeof(Header));
   DCHECK_LE(header_size, kPayloadUnit);
   Resize(kPayloadUnit);
@@ -239,7 +260,8 @@ Pickle::Pickle(const char* data, int data_len)
     : header_(reinterpret_cast<Header*>(const_cast<char*>(data))),
       header_size_(0),
       capacity_after_header_(kCapacityReadOnly),
-      write_offset_(0) {
+      write_offset_(0),
+      uses_external_buffer_(false) {
   if (data_len >= static_cast<int>(sizeof(Header)))
     header_size_ = data_len - header_->payload_size;
 
@@ -254,17 +276,34 @@ Pickle::Pickle(const char* data, int data_len)
     header_ = nullptr;
 }
 
+Pickle::Pickle(int header_size, void* buffer, size_t buffer_size)
+    : header_(static_cast<Header*>(buffer)),
+      header_size_(bits::Align(header_size, sizeof(uint32_t))),
+      capacity_after_header_(0),
+      write_offset_(0),
+      uses_external_buffer_(true) {
+  DCHECK_GE(static_cast<size_t>(header_size), sizeof(Header));
+  DCHECK_LE(header_size, kPayloadUnit);
+  DCHECK_EQ(0u, reinterpret_cast<uintptr_t>(buffer) % sizeof(uint32_t));
+  CHECK_GE(buffer_size, header_size_);
+  // Writes are padded to 32 bits, so a partial unit at the end is unusable.
+  capacity_after_header_ =
+      (buffer_size - header_size_) & ~(sizeof(uint32_t) - 1);
+  memset(header_, 0, header_size_);
+}
+
 Pickle::Pickle(const Pickle& other)
     : header_(nullptr),
       header_size_(other.header_size_),
       capacity_after_header_(0),
-      write_offset_(other.write_offset_) {
+      write_offset_(other.write_offset_),
+      uses_external_buffer_(false) {
   Resize(other.header_->payload_size);
   memcpy(header_, other.header_, header_size_ + other.header_->payload_size);
 }
 
 Pickle::~Pickle() {
-  if (capacity_after_header_ != kCapacityReadOnly)
+  if (capacity_after_header_ != kCapacityReadOnly && !uses_external_buffer_)
     free(header_);
 }
 
@@ -272,9 +311,10 @@ Pickle& Pickle::operator=(const Pickle& other) {
   if (this == &other) {
     return *this;
   }
-  if (capacity_after_header_ == kCapacityReadOnly) {
+  if (capacity_after_header_ == kCapacityReadOnly || uses_external_buffer_) {
     header_ = nullptr;
     capacity_after_header_ = 0;
+    uses_external_buffer_ = false;
   }
   if (header_size_ != other.header_size_) {
     free(header_);
@@ -336,6 +376,15 @@ bool Pickle::HasAttachments() const {
 void Pickle::Resize(size_t new_capacity) {
   CHECK_NE(capacity_after_header_, kCapacityReadOnly);
   capacity_after_header_ = bits::Align(new_capacity, kPayloadUnit);
+  if (uses_external_buffer_) {
+    // Move the data out of the external buffer, which is too small.
+    uses_external_buffer_ = false;
+    void* p = malloc(GetTotalAllocatedSize());
+    CHECK(p);
+    memcpy(p, header_, header_size_ + write_offset_);
+    header_ = reinterpret_cast<Header*>(p);
+    return;
+  }
   void* p = realloc(header_, GetTotalAllocatedSize());
   CHECK(p);
   header_ = reinterpret_cast<Header*>(p);
@@ -349,7 +398,7 @@ void* Pickle::ClaimBytes(size_t num_bytes) {
 }
 
 size_t Pickle::GetTotalAllocatedSize() const {
-  if (capacity_after_header_ == kCapacityReadOnly)
+  if (capacity_after_header_ == kCapacityReadOnly || uses_external_buffer_)
     return 0;
   return header_size_ + capacity_after_header_;
 }
@@ -12,6 +12,7 @@
 
 #include "base/base_export.h"
 #include "base/compiler_specific.h"
+#include "base/containers/span.h"
 #include "base/gtest_prod_util.h"
 #include "base/logging.h"
 #include "base/memory/ref_counted.h"
@@ -67,6 +68,11 @@ class BASE_EXPORT PickleIterator {
   // mutated). Do not keep the pointer around!
   bool ReadBytes(const char** data, int length) WARN_UNUSED_RESULT;
 
+  // Like ReadData() and ReadBytes(), but return a view of the data. The same
+  // lifetime restrictions apply.
+  bool ReadData(span<const uint8_t>* data) WARN_UNUSED_RESULT;
+  bool ReadBytes(span<const uint8_t>* data, size_t length) WARN_UNUSED_RESULT;
+
   // A safer version of ReadInt() that checks for the result not being negative.
   // Use it for reading the object sizes.
   bool ReadLength(int* result) WARN_UNUSED_RESULT {
@@ -156,6 +162,15 @@ class BASE_EXPORT Pickle {
   // padding size is deduced from the data length.
   Pickle(const char* data, int data_len);
 
+  // Initializes an empty Pickle that writes into |buffer|, which must be
+  // 32bit-aligned, must remain valid while the Pickle uses it, and must be
+  // large enough for the header. This avoids an allocation and a copy when
+  // the final destination of the data, e.g. shared memory, is known upfront.
+  // If writes outgrow |buffer|, the data is moved to an allocation owned by
+  // the Pickle, like for other Pickles, and the contents of |buffer| are
+  // unspecified after that: check uses_external_buffer() once done writing.
+  Pickle(int header_size, void* buffer, size_t buffer_size);
+
   // Initializes a Pickle as a deep copy of another Pickle.
   Pickle(const Pickle& other);
 
@@ -181,6 +196,10 @@ class BASE_EXPORT Pickle {
   // purposes.
   size_t GetTotalAllocatedSize() const;
 
+  // Returns true if the data of this Pickle is in the buffer passed to the
+  // constructor.
+  bool uses_external_buffer() const { return uses_external_buffer_; }
+
   // Methods for adding to the payload of the Pickle.  These values are
   // appended to the end of the Pickle's payload.  When reading values from a
   // Pickle, it is important to read them in the order in which they were added
@@ -318,6 +337,9 @@ class BASE_EXPORT Pickle {
   // The offset at which we will write the next field. Note: this doesn't count
   // the header.
   size_t write_offset_;
+  // Whether |header_| points to a buffer that the Pickle writes to but
+  // doesn't own.
+  bool uses_external_buffer_;
 
   // Just like WriteBytes, but with a compile-time size, for performance.
   template<size_t length> void BASE_EXPORT WriteBytesStatic(const void* data);
@@ -8,6 +8,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <limits>
 #include <memory>
 #include <string>
 
@@ -570,4 +571,92 @@ TEST(PickleTest, ClaimBytes) {
   EXPECT_EQ(42, out_value);
 }
 
+TEST(PickleTest, ExternalBuffer) {
+  alignas(uint32_t) char buffer[64];
+  Pickle pickle(sizeof(Pickle::Header), buffer, sizeof(buffer));
+  pickle.WriteInt(42);
+  pickle.WriteString(teststring);
+  EXPECT_TRUE(pickle.uses_external_buffer());
+  EXPECT_EQ(buffer, pickle.data());
+  EXPECT_EQ(0u, pickle.GetTotalAllocatedSize());
+
+  // The buffer holds a valid pickle.
+  Pickle reader(buffer, static_cast<int>(pickle.size()));
+  PickleIterator iter(reader);
+  int out_int;
+  std::string out_string;
+  EXPECT_TRUE(iter.ReadInt(&out_int));
+  EXPECT_EQ(42, out_int);
+  EXPECT_TRUE(iter.ReadString(&out_string));
+  EXPECT_EQ(teststring, out_string);
+}
+
+TEST(PickleTest, ExternalBufferOverflow) {
+  alignas(uint32_t) char buffer[16];
+  Pickle pickle(sizeof(Pickle::Header), buffer, sizeof(buffer));
+  pickle.WriteInt(1);
+  pickle.WriteInt(2);
+  pickle.WriteInt(3);
+  EXPECT_TRUE(pickle.uses_external_buffer());
+
+  // The data moves to the heap once it doesn't fit anymore.
+  pickle.WriteString(teststring);
+  EXPECT_FALSE(pickle.uses_external_buffer());
+  EXPECT_NE(buffer, pickle.data());
+
+  PickleIterator iter(pickle);
+  int out_int;
+  std::string out_string;
+  for (int i = 1; i <= 3; ++i) {
+    EXPECT_TRUE(iter.ReadInt(&out_int));
+    EXPECT_EQ(i, out_int);
+  }
+  EXPECT_TRUE(iter.ReadString(&out_string));
+  EXPECT_EQ(teststring, out_string);
+
+  // Copies don't use the external buffer either.
+  Pickle external(sizeof(Pickle::Header), buffer, sizeof(buffer));
+  external.WriteInt(4);
+  Pickle copy(external);
+  EXPECT_FALSE(copy.uses_external_buffer());
+  external = pickle;
+  EXPECT_FALSE(external.uses_external_buffer());
+  EXPECT_EQ(pickle.size(), external.size());
+}
+
+TEST(PickleTest, ReadSpans) {
+  Pickle pickle;
+  pickle.WriteData(testdata, testdatalen);
+  pickle.WriteBytes(testrawstring, sizeof(testrawstring));
+  pickle.WriteInt(-1);
+
+  PickleIterator iter(pickle);
+  span<const uint8_t> data;
+  EXPECT_TRUE(iter.ReadData(&data));
+  EXPECT_EQ(std::string(testdata, testdatalen),
+            std::string(reinterpret_cast<const char*>(data.data()),
+                        data.size()));
+  // The span points into the pickle.
+  EXPECT_GE(reinterpret_cast<const char*>(data.data()), pickle.payload());
+  EXPECT_LT(reinterpret_cast<const char*>(data.data()),
+            pickle.end_of_payload());
+
+  EXPECT_TRUE(iter.ReadBytes(&data, sizeof(testrawstring)));
+  EXPECT_STREQ(testrawstring, reinterpret_cast<const char*>(data.data()));
+
+  // A negative length is rejected.
+  EXPECT_FALSE(iter.ReadData(&data));
+}
+
+TEST(PickleTest, ReadSpanTooLarge) {
+  Pickle pickle;
+  pickle.WriteInt(1);
+
+  PickleIterator iter(pickle);
+  span<const uint8_t> data;
+  EXPECT_FALSE(iter.ReadBytes(&data, std::numeric_limits<size_t>::max()));
+  int out_int;
+  EXPECT_FALSE(iter.ReadInt(&out_int));
+}
+
 }  // namespace base
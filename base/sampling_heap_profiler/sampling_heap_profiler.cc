@@ -18,6 +18,7 @@
 #include "base/partition_alloc_buildflags.h"
 #include "base/rand_util.h"
 #include "base/threading/thread_local_storage.h"
+#include "base/trace_event/heap_profiler_allocation_context_tracker.h"
 #include "build/build_config.h"
 
 namespace base {
@@ -320,6 +321,18 @@ void SamplingHeapProfiler::RecordStackTrace(Sample* sample,
 #endif
 }
 
+void SamplingHeapProfiler::RecordContext(Sample* sample) {
+  using base::trace_event::AllocationContextTracker;
+  if (AllocationContextTracker::capture_mode() ==
+      AllocationContextTracker::CaptureMode::DISABLED) {
+    return;
+  }
+  AllocationContextTracker* tracker =
+      AllocationContextTracker::GetInstanceForCurrentThread();
+  if (tracker)
+    sample->context = tracker->current_task_context();
+}
+
 void SamplingHeapProfiler::DoRecordAlloc(size_t total_allocated,
                                          size_t size,
                                          void* address,
@@ -331,6 +344,7 @@ void SamplingHeapProfiler::DoRecordAlloc(size_t total_allocated,
     base::AutoLock lock(mutex_);
     Sample sample(size, total_allocated, ++last_sample_ordinal_);
     RecordStackTrace(&sample, skip_frames);
+    RecordContext(&sample);
     for (auto* observer : observers_)
       observer->SampleAdded(sample.ordinal, size, total_allocated);
     EnsureNoRehashingMap().emplace(address, std::move(sample));
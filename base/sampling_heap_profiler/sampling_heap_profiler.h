@@ -35,6 +35,9 @@ class BASE_EXPORT SamplingHeapProfiler {
     size_t size;   // Allocation size.
     size_t total;  // Total size attributed to the sample.
     std::vector<void*> stack;
+    // The heap profiler task context in which the allocation was made, e.g.
+    // the origin of the frame running, if known. Has application lifetime.
+    const char* context = nullptr;
 
    private:
     friend class SamplingHeapProfiler;
@@ -96,6 +99,7 @@ class BASE_EXPORT SamplingHeapProfiler {
                      uint32_t skip_frames);
   void DoRecordFree(void* address);
   void RecordStackTrace(Sample*, uint32_t skip_frames);
+  void RecordContext(Sample*);
   SamplesMap& EnsureNoRehashingMap();
   static SamplesMap& samples();
 
@@ -8,7 +8,23 @@
 #include <stdint.h>
 #include <string.h>
 
+#include <algorithm>
+
 #include "base/sys_byteorder.h"
+#include "build/build_config.h"
+
+// The SHA extensions are only used where the compiler can target them per
+// function, and with runtime detection since few CPUs have them. The ARMv8
+// Cryptographic Extension is used when the build targets it.
+#if defined(ARCH_CPU_X86_FAMILY) && defined(COMPILER_GCC) && !defined(OS_NACL)
+#define SHA1_USE_X86_SHA_EXTENSIONS
+#include <immintrin.h>
+
+#include "base/cpu.h"
+#elif defined(ARCH_CPU_ARM64) && defined(__ARM_FEATURE_CRYPTO)
+#define SHA1_USE_ARM_CRYPTO_EXTENSIONS
+#include <arm_neon.h>
+#endif
 
 namespace base {
 
@@ -52,14 +68,9 @@ class SecureHashAlgorithm {
   void Pad();
   void Process();
 
-  uint32_t A, B, C, D, E;
-
   uint32_t H[5];
 
-  union {
-    uint32_t W[80];
-    uint8_t M[64];
-  };
+  uint8_t M[64];
 
   uint32_t cursor;
   uint64_t l;
@@ -93,14 +104,185 @@ static inline uint32_t K(uint32_t t) {
   }
 }
 
+// Runs the compression function on |num_blocks| 64-byte blocks of |data|.
+static void ProcessBlocksPortable(uint32_t* H,
+                                  const uint8_t* data,
+                                  size_t num_blocks) {
+  uint32_t W[80];
+  for (; num_blocks; --num_blocks, data += 64) {
+    uint32_t t;
+
+    // Each a...e corresponds to a section in the FIPS 180-3 algorithm.
+
+    // a.
+    memcpy(W, data, 64);
+    for (t = 0; t < 16; ++t)
+      W[t] = ByteSwap(W[t]);
+
+    // b.
+    for (t = 16; t < 80; ++t)
+      W[t] = S(1, W[t - 3] ^ W[t - 8] ^ W[t - 14] ^ W[t - 16]);
+
+    // c.
+    uint32_t A = H[0];
+    uint32_t B = H[1];
+    uint32_t C = H[2];
+    uint32_t D = H[3];
+    uint32_t E = H[4];
+
+    // d.
+    for (t = 0; t < 80; ++t) {
+      uint32_t TEMP = S(5, A) + f(t, B, C, D) + E + W[t] + K(t);
+      E = D;
+      D = C;
+      C = S(30, B);
+      B = A;
+      A = TEMP;
+    }
+
+    // e.
+    H[0] += A;
+    H[1] += B;
+    H[2] += C;
+    H[3] += D;
+    H[4] += E;
+  }
+}
+
+#if defined(SHA1_USE_X86_SHA_EXTENSIONS)
+
+// Same as ProcessBlocksPortable(), using the SHA extensions. Each step runs
+// four rounds, and computes the message schedule three steps ahead.
+__attribute__((target("sha,sse4.1"))) static void ProcessBlocksX86(
+    uint32_t* H,
+    const uint8_t* data,
+    size_t num_blocks) {
+  const __m128i kByteSwapMask =
+      _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+
+  __m128i abcd = _mm_shuffle_epi32(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(H)), 0x1b);
+  __m128i e[2] = {_mm_set_epi32(H[4], 0, 0, 0), _mm_setzero_si128()};
+  __m128i msg[4];
+
+  for (; num_blocks; --num_blocks, data += 64) {
+    const __m128i abcd_saved = abcd;
+    const __m128i e_saved = e[0];
+
+    for (int i = 0; i < 4; ++i) {
+      msg[i] = _mm_shuffle_epi8(
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16 * i)),
+          kByteSwapMask);
+    }
+
+    for (int i = 0; i < 20; ++i) {
+      const __m128i& w = msg[i & 3];
+      if (i == 0)
+        e[0] = _mm_add_epi32(e[0], w);
+      else
+        e[i & 1] = _mm_sha1nexte_epu32(e[i & 1], w);
+      e[~i & 1] = abcd;
+      if (i >= 3 && i <= 18)
+        msg[(i + 1) & 3] = _mm_sha1msg2_epu32(msg[(i + 1) & 3], w);
+      switch (i / 5) {
+        case 0:
+          abcd = _mm_sha1rnds4_epu32(abcd, e[i & 1], 0);
+          break;
+        case 1:
+          abcd = _mm_sha1rnds4_epu32(abcd, e[i & 1], 1);
+          break;
+        case 2:
+          abcd = _mm_sha1rnds4_epu32(abcd, e[i & 1], 2);
+          break;
+        default:
+          abcd = _mm_sha1rnds4_epu32(abcd, e[i & 1], 3);
+          break;
+      }
+      if (i >= 1 && i <= 16)
+        msg[(i + 3) & 3] = _mm_sha1msg1_epu32(msg[(i + 3) & 3], w);
+      if (i >= 2 && i <= 17)
+        msg[(i + 2) & 3] = _mm_xor_si128(msg[(i + 2) & 3], w);
+    }
+
+    e[0] = _mm_sha1nexte_epu32(e[0], e_saved);
+    abcd = _mm_add_epi32(abcd, abcd_saved);
+  }
+
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(H),
+                   _mm_shuffle_epi32(abcd, 0x1b));
+  H[4] = _mm_extract_epi32(e[0], 3);
+}
+
+#elif defined(SHA1_USE_ARM_CRYPTO_EXTENSIONS)
+
+// Same as ProcessBlocksPortable(), using the ARMv8 Cryptographic Extension.
+// Each step runs four rounds, and computes the message schedule three steps
+// ahead.
+static void ProcessBlocksArm(uint32_t* H,
+                             const uint8_t* data,
+                             size_t num_blocks) {
+  const uint32x4_t kK[4] = {vdupq_n_u32(K(0)), vdupq_n_u32(K(20)),
+                            vdupq_n_u32(K(40)), vdupq_n_u32(K(60))};
+
+  uint32x4_t abcd = vld1q_u32(H);
+  uint32_t e[2] = {H[4], 0};
+  uint32x4_t msg[4];
+  uint32x4_t tmp[2];
+
+  for (; num_blocks; --num_blocks, data += 64) {
+    const uint32x4_t abcd_saved = abcd;
+    const uint32_t e_saved = e[0];
+
+    for (int i = 0; i < 4; ++i)
+      msg[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 16 * i)));
+    tmp[0] = vaddq_u32(msg[0], kK[0]);
+    tmp[1] = vaddq_u32(msg[1], kK[0]);
+
+    for (int i = 0; i < 20; ++i) {
+      e[~i & 1] = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+      if (i < 5)
+        abcd = vsha1cq_u32(abcd, e[i & 1], tmp[i & 1]);
+      else if (i >= 10 && i < 15)
+        abcd = vsha1mq_u32(abcd, e[i & 1], tmp[i & 1]);
+      else
+        abcd = vsha1pq_u32(abcd, e[i & 1], tmp[i & 1]);
+      if (i <= 17)
+        tmp[i & 1] = vaddq_u32(msg[(i + 2) & 3], kK[(i + 2) / 5]);
+      if (i >= 1 && i <= 16)
+        msg[(i + 3) & 3] = vsha1su1q_u32(msg[(i + 3) & 3], msg[(i + 2) & 3]);
+      if (i <= 15) {
+        msg[i & 3] =
+            vsha1su0q_u32(msg[i & 3], msg[(i + 1) & 3], msg[(i + 2) & 3]);
+      }
+    }
+
+    e[0] += e_saved;
+    abcd = vaddq_u32(abcd, abcd_saved);
+  }
+
+  vst1q_u32(H, abcd);
+  H[4] = e[0];
+}
+
+#endif
+
+static void ProcessBlocks(uint32_t* H, const uint8_t* data, size_t num_blocks) {
+#if defined(SHA1_USE_X86_SHA_EXTENSIONS)
+  static const bool has_sha = CPU().has_sha();
+  if (has_sha) {
+    ProcessBlocksX86(H, data, num_blocks);
+    return;
+  }
+#elif defined(SHA1_USE_ARM_CRYPTO_EXTENSIONS)
+  ProcessBlocksArm(H, data, num_blocks);
+  return;
+#endif
+  ProcessBlocksPortable(H, data, num_blocks);
+}
+
 const int SecureHashAlgorithm::kDigestSizeBytes = 20;
 
 void SecureHashAlgorithm::Init() {
-  A = 0;
-  B = 0;
-  C = 0;
-  D = 0;
-  E = 0;
   cursor = 0;
   l = 0;
   H[0] = 0x67452301;
@@ -120,12 +302,30 @@ void SecureHashAlgorithm::Final() {
 
 void SecureHashAlgorithm::Update(const void* data, size_t nbytes) {
   const uint8_t* d = reinterpret_cast<const uint8_t*>(data);
-  while (nbytes--) {
-    M[cursor++] = *d++;
-    if (cursor >= 64)
-      Process();
-    l += 8;
+  l += 8 * static_cast<uint64_t>(nbytes);
+
+  // Complete a partially buffered block first, then hash whole blocks
+  // straight from |data| and buffer the rest.
+  if (cursor) {
+    size_t n = std::min<size_t>(64 - cursor, nbytes);
+    memcpy(M + cursor, d, n);
+    cursor += n;
+    d += n;
+    nbytes -= n;
+    if (cursor < 64)
+      return;
+    Process();
   }
+
+  size_t num_blocks = nbytes / 64;
+  if (num_blocks) {
+    ProcessBlocks(H, d, num_blocks);
+    d += num_blocks * 64;
+    nbytes -= num_blocks * 64;
+  }
+
+  memcpy(M, d, nbytes);
+  cursor = nbytes;
 }
 
 void SecureHashAlgorithm::Pad() {
@@ -153,45 +353,7 @@ void SecureHashAlgorithm::Pad() {
 }
 
 void SecureHashAlgorithm::Process() {
-  uint32_t t;
-
-  // Each a...e corresponds to a section in the FIPS 180-3 algorithm.
-
-  // a.
-  //
-  // W and M are in a union, so no need to memcpy.
-  // memcpy(W, M, sizeof(M));
-  for (t = 0; t < 16; ++t)
-    W[t] = ByteSwap(W[t]);
-
-  // b.
-  for (t = 16; t < 80; ++t)
-    W[t] = S(1, W[t - 3] ^ W[t - 8] ^ W[t - 14] ^ W[t - 16]);
-
-  // c.
-  A = H[0];
-  B = H[1];
-  C = H[2];
-  D = H[3];
-  E = H[4];
-
-  // d.
-  for (t = 0; t < 80; ++t) {
-    uint32_t TEMP = S(5, A) + f(t, B, C, D) + E + W[t] + K(t);
-    E = D;
-    D = C;
-    C = S(30, B);
-    B = A;
-    A = TEMP;
-  }
-
-  // e.
-  H[0] += A;
-  H[1] += B;
-  H[2] += C;
-  H[3] += D;
-  H[4] += E;
-
+  ProcessBlocks(H, M, 1);
   cursor = 0;
 }
 
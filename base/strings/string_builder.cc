@@ -0,0 +1,126 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/strings/string_builder.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include <algorithm>
+
+#include "base/logging.h"
+#include "base/scoped_clear_errno.h"
+#include "base/strings/string_util.h"
+#include "build/build_config.h"
+
+namespace base {
+
+namespace {
+
+// Same limit as StringAppendV().
+constexpr size_t kMaxFormattedSize = 32 * 1024 * 1024;
+
+}  // namespace
+
+StringBuilder::StringBuilder(char* inline_buffer, size_t inline_buffer_size)
+    : buffer_(inline_buffer), buffer_size_(inline_buffer_size) {
+  DCHECK_GT(buffer_size_, 0u);
+  buffer_[0] = '\0';
+}
+
+StringBuilder::~StringBuilder() = default;
+
+void StringBuilder::Append(StringPiece piece) {
+  Reserve(piece.size());
+  memcpy(buffer_ + size_, piece.data(), piece.size());
+  size_ += piece.size();
+  buffer_[size_] = '\0';
+}
+
+void StringBuilder::Append(span<const StringPiece> pieces) {
+  size_t additional_size = 0;
+  for (const auto& piece : pieces)
+    additional_size += piece.size();
+  Reserve(additional_size);
+
+  for (const auto& piece : pieces) {
+    memcpy(buffer_ + size_, piece.data(), piece.size());
+    size_ += piece.size();
+  }
+  buffer_[size_] = '\0';
+}
+
+void StringBuilder::AppendF(const char* format, ...) {
+  va_list ap;
+  va_start(ap, format);
+  AppendV(format, ap);
+  va_end(ap);
+}
+
+void StringBuilder::AppendV(const char* format, va_list ap) {
+  // Format straight into the free space, and only if that's too small, grow
+  // as StringAppendV() does and try again.
+  while (true) {
+    const size_t available = buffer_size_ - size_;
+
+    va_list ap_copy;
+    va_copy(ap_copy, ap);
+#if !defined(OS_WIN)
+    ScopedClearErrno clear_errno;
+#endif
+    int result = vsnprintf(buffer_ + size_, available, format, ap_copy);
+    va_end(ap_copy);
+
+    if (result >= 0 && static_cast<size_t>(result) < available) {
+      // It fit.
+      size_ += result;
+      return;
+    }
+
+    // Drop the truncated output.
+    buffer_[size_] = '\0';
+
+    size_t additional;
+    if (result < 0) {
+#if defined(OS_WIN)
+      // vsnprintf() always returns the size of the fully-formatted string on
+      // Windows, so no amount of growing is going to fix it.
+      return;
+#else
+      if (errno != 0 && errno != EOVERFLOW)
+        return;
+      additional = available * 2;
+#endif
+    } else {
+      // We need exactly |result| more characters.
+      additional = result;
+    }
+
+    if (additional > kMaxFormattedSize) {
+      DLOG(WARNING) << "Unable to printf the requested string due to size.";
+      return;
+    }
+    Reserve(additional);
+  }
+}
+
+void StringBuilder::clear() {
+  size_ = 0;
+  buffer_[0] = '\0';
+}
+
+void StringBuilder::Reserve(size_t additional) {
+  const size_t required_size = size_ + additional + 1;
+  if (required_size <= buffer_size_)
+    return;
+
+  const size_t new_size = std::max(required_size, buffer_size_ * 2);
+  std::unique_ptr<char[]> new_buffer(new char[new_size]);
+  memcpy(new_buffer.get(), buffer_, size_ + 1);
+  heap_buffer_ = std::move(new_buffer);
+  buffer_ = heap_buffer_.get();
+  buffer_size_ = new_size;
+}
+
+}  // namespace base
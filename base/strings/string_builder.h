@@ -0,0 +1,114 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_STRINGS_STRING_BUILDER_H_
+#define BASE_STRINGS_STRING_BUILDER_H_
+
+#include <stdarg.h>  // va_list
+#include <stddef.h>
+
+#include <initializer_list>
+#include <memory>
+#include <string>
+
+#include "base/base_export.h"
+#include "base/compiler_specific.h"
+#include "base/containers/span.h"
+#include "base/macros.h"
+#include "base/strings/string_piece.h"
+
+namespace base {
+
+// StackStringBuilder ----------------------------------------------------------
+//
+// StackStringBuilder concatenates and formats strings into a buffer inside the
+// object, and only allocates on the heap once the content outgrows it. Use it
+// instead of StrCat() or StringPrintf() for short-lived strings on hot paths,
+// e.g. a log line or a header assembled to be appended somewhere else:
+//
+//   StackStringBuilder<128> line;
+//   line.Append({name, ": "});
+//   line.AppendF("%d", value);
+//   headers->AppendLine(line);  // Takes a StringPiece.
+//
+// A builder converts implicitly to StringPiece, so it can be passed wherever a
+// StringPiece is taken, including as a piece of StrCat(). The content is always
+// NUL-terminated. As with a StringPiece, the conversion doesn't outlive the
+// builder, nor its next modification.
+//
+// Functions which write into a builder of any capacity take a StringBuilder*.
+
+class BASE_EXPORT StringBuilder {
+ public:
+  // Appends |piece|, or each of |pieces| as StrAppend() does. Unlike with
+  // std::string, the pieces must not point into the builder itself.
+  void Append(StringPiece piece);
+  void Append(span<const StringPiece> pieces);
+  void Append(std::initializer_list<StringPiece> pieces) {
+    Append(make_span(pieces.begin(), pieces.size()));
+  }
+
+  // Appends printf-like output, as StringAppendF() does.
+  void AppendF(_Printf_format_string_ const char* format, ...)
+      PRINTF_FORMAT(2, 3);
+  void AppendV(const char* format, va_list ap) PRINTF_FORMAT(2, 0);
+
+  // Empties the builder. Keeps the heap buffer if there is one.
+  void clear();
+
+  const char* data() const { return buffer_; }
+  const char* c_str() const { return buffer_; }
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  // Returns whether the content still fits in the inline buffer.
+  bool is_inline() const { return !heap_buffer_; }
+
+  StringPiece AsStringPiece() const { return StringPiece(buffer_, size_); }
+  operator StringPiece() const { return AsStringPiece(); }
+
+  std::string ToString() const { return std::string(buffer_, size_); }
+
+ protected:
+  // |inline_buffer| has room for |inline_buffer_size| - 1 characters and the
+  // terminating NUL.
+  StringBuilder(char* inline_buffer, size_t inline_buffer_size);
+  ~StringBuilder();
+
+ private:
+  // Makes room for |additional| more characters, growing at least 2x as
+  // std::string does so that repeated appends take linear time.
+  void Reserve(size_t additional);
+
+  // Either the inline buffer of the StackStringBuilder or |heap_buffer_|.
+  char* buffer_;
+
+  // Size of |buffer_|, including room for the terminating NUL.
+  size_t buffer_size_;
+
+  size_t size_ = 0;
+
+  std::unique_ptr<char[]> heap_buffer_;
+
+  DISALLOW_COPY_AND_ASSIGN(StringBuilder);
+};
+
+// |inline_capacity| is the number of characters, excluding the terminating
+// NUL, which fit without allocating. Builders are meant to live on the stack,
+// so it should be a few hundred bytes at most.
+template <size_t inline_capacity>
+class StackStringBuilder : public StringBuilder {
+ public:
+  StackStringBuilder()
+      : StringBuilder(inline_buffer_, arraysize(inline_buffer_)) {}
+
+ private:
+  char inline_buffer_[inline_capacity + 1];
+
+  DISALLOW_COPY_AND_ASSIGN(StackStringBuilder);
+};
+
+}  // namespace base
+
+#endif  // BASE_STRINGS_STRING_BUILDER_H_
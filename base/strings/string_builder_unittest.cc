@@ -0,0 +1,105 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/strings/string_builder.h"
+
+#include <string>
+
+#include "base/strings/strcat.h"
+#include "base/strings/string_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+TEST(StackStringBuilderTest, Empty) {
+  StackStringBuilder<16> builder;
+  EXPECT_TRUE(builder.empty());
+  EXPECT_EQ(0u, builder.size());
+  EXPECT_STREQ("", builder.c_str());
+  EXPECT_EQ("", builder.ToString());
+  EXPECT_TRUE(builder.is_inline());
+}
+
+TEST(StackStringBuilderTest, Append) {
+  StackStringBuilder<16> builder;
+  builder.Append("foo");
+  builder.Append(std::string("bar"));
+  builder.Append({"1", "22", "333"});
+  EXPECT_EQ("foobar122333", builder.AsStringPiece());
+  EXPECT_STREQ("foobar122333", builder.c_str());
+  EXPECT_TRUE(builder.is_inline());
+
+  builder.clear();
+  EXPECT_TRUE(builder.empty());
+  EXPECT_STREQ("", builder.c_str());
+}
+
+TEST(StackStringBuilderTest, AppendF) {
+  StackStringBuilder<16> builder;
+  builder.AppendF("%d-%s", 42, "abc");
+  builder.AppendF("%c", 'x');
+  EXPECT_EQ("42-abcx", builder.ToString());
+  EXPECT_TRUE(builder.is_inline());
+}
+
+TEST(StackStringBuilderTest, SpillsToHeap) {
+  StackStringBuilder<8> builder;
+  builder.Append("12345678");
+  EXPECT_TRUE(builder.is_inline());
+
+  builder.Append("9");
+  EXPECT_FALSE(builder.is_inline());
+  EXPECT_STREQ("123456789", builder.c_str());
+
+  const std::string long_string(1000, 'a');
+  builder.Append({long_string, "b"});
+  EXPECT_EQ("123456789" + long_string + "b", builder.ToString());
+
+  // Keeps the heap buffer once it has one.
+  builder.clear();
+  builder.Append("c");
+  EXPECT_FALSE(builder.is_inline());
+  EXPECT_STREQ("c", builder.c_str());
+}
+
+TEST(StackStringBuilderTest, AppendFSpillsToHeap) {
+  StackStringBuilder<8> builder;
+  builder.Append("foo");
+  builder.AppendF("%s", "12345");
+  EXPECT_TRUE(builder.is_inline());
+
+  builder.AppendF("%s-%d", "abcdefghijklmnop", 123456);
+  EXPECT_FALSE(builder.is_inline());
+  EXPECT_STREQ("foo12345abcdefghijklmnop-123456", builder.c_str());
+
+  const std::string long_string(5000, 'a');
+  builder.clear();
+  builder.AppendF("%s%s", long_string.c_str(), "b");
+  EXPECT_EQ(long_string + "b", builder.ToString());
+}
+
+TEST(StackStringBuilderTest, ConvertsToStringPiece) {
+  StackStringBuilder<32> builder;
+  builder.Append("World");
+  EXPECT_EQ("Hello World!", StrCat({"Hello ", builder, "!"}));
+  EXPECT_TRUE(StartsWith(builder, "Wor", CompareCase::SENSITIVE));
+}
+
+// Functions can write into builders of any capacity.
+void AppendGreeting(StringBuilder* builder) {
+  builder->AppendF("Hello %s", "World");
+}
+
+TEST(StackStringBuilderTest, StringBuilderPointer) {
+  StackStringBuilder<4> small;
+  StackStringBuilder<64> large;
+  AppendGreeting(&small);
+  AppendGreeting(&large);
+  EXPECT_EQ("Hello World", small.ToString());
+  EXPECT_FALSE(small.is_inline());
+  EXPECT_EQ("Hello World", large.ToString());
+  EXPECT_TRUE(large.is_inline());
+}
+
+}  // namespace base
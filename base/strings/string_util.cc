@@ -517,6 +517,13 @@ bool IsStringUTF8(StringPiece str) {
   int32_t char_index = 0;
 
   while (char_index < src_len) {
+    // ASCII characters are all valid, skip them in bulk.
+    if (static_cast<uint8_t>(src[char_index]) < 0x80) {
+      char_index += static_cast<int32_t>(
+          CountLeadingASCII(src + char_index, src_len - char_index));
+      continue;
+    }
+
     int32_t code_point;
     CBU8_NEXT(src, char_index, src_len, code_point);
     if (!IsValidCharacter(code_point))
@@ -4,11 +4,97 @@
 
 #include "base/strings/utf_string_conversion_utils.h"
 
+#include "base/bits.h"
 #include "base/third_party/icu/icu_utf.h"
 #include "build/build_config.h"
 
+// NaCl does not allow intrinsics.
+#if defined(ARCH_CPU_X86_FAMILY) && !defined(OS_NACL)
+#include <emmintrin.h>
+#define UTF_CONVERSION_USE_SSE2
+#elif defined(ARCH_CPU_ARM_FAMILY) && defined(__ARM_NEON) && !defined(OS_NACL)
+#include <arm_neon.h>
+#define UTF_CONVERSION_USE_NEON
+#endif
+
 namespace base {
 
+namespace {
+
+constexpr uint32_t kExtendedASCIIStart = 0x80;
+
+#if defined(UTF_CONVERSION_USE_NEON)
+// Returns true if any lane of |v| is non-zero.
+bool AnyLaneSet(uint8x16_t v) {
+  uint8x8_t any = vorr_u8(vget_low_u8(v), vget_high_u8(v));
+  any = vpmax_u8(any, any);
+  any = vpmax_u8(any, any);
+  any = vpmax_u8(any, any);
+  return vget_lane_u8(any, 0) != 0;
+}
+#endif
+
+}  // namespace
+
+// CountLeadingASCII -----------------------------------------------------------
+
+size_t CountLeadingASCII(const char* src, size_t src_len) {
+  const char* p = src;
+  const char* end = src + src_len;
+#if defined(UTF_CONVERSION_USE_SSE2)
+  for (; end - p >= 16; p += 16) {
+    const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    // The most significant bit of |chars| is set for non-ASCII bytes.
+    const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(chars));
+    if (mask)
+      return (p - src) + bits::CountTrailingZeroBits(mask);
+  }
+#elif defined(UTF_CONVERSION_USE_NEON)
+  const uint8x16_t extended_ascii_start = vdupq_n_u8(kExtendedASCIIStart);
+  for (; end - p >= 16; p += 16) {
+    const uint8x16_t chars = vld1q_u8(reinterpret_cast<const uint8_t*>(p));
+    // The loop below finds the non-ASCII byte in these 16 bytes.
+    if (AnyLaneSet(vcgeq_u8(chars, extended_ascii_start)))
+      break;
+  }
+#endif
+  while (p < end && static_cast<unsigned char>(*p) < kExtendedASCIIStart)
+    ++p;
+  return p - src;
+}
+
+size_t CountLeadingASCII(const char16* src, size_t src_len) {
+  const char16* p = src;
+  const char16* end = src + src_len;
+#if defined(UTF_CONVERSION_USE_SSE2)
+  const __m128i non_ascii_bits = _mm_set1_epi16(0xFF80);
+  const __m128i zero = _mm_setzero_si128();
+  for (; end - p >= 8; p += 8) {
+    const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    const __m128i ascii =
+        _mm_cmpeq_epi16(_mm_and_si128(chars, non_ascii_bits), zero);
+    // Two bits per character, set for non-ASCII characters.
+    const uint32_t mask =
+        ~static_cast<uint32_t>(_mm_movemask_epi8(ascii)) & 0xFFFF;
+    if (mask)
+      return (p - src) + bits::CountTrailingZeroBits(mask) / 2;
+  }
+#elif defined(UTF_CONVERSION_USE_NEON)
+  const uint16x8_t non_ascii_bits = vdupq_n_u16(0xFF80);
+  for (; end - p >= 16; p += 16) {
+    const uint16_t* chars = reinterpret_cast<const uint16_t*>(p);
+    const uint16x8_t bits =
+        vorrq_u16(vld1q_u16(chars), vld1q_u16(chars + 8));
+    // The loop below finds the non-ASCII character in these 16 characters.
+    if (AnyLaneSet(vreinterpretq_u8_u16(vandq_u16(bits, non_ascii_bits))))
+      break;
+  }
+#endif
+  while (p < end && *p < kExtendedASCIIStart)
+    ++p;
+  return p - src;
+}
+
 // ReadUnicodeCharacter --------------------------------------------------------
 
 bool ReadUnicodeCharacter(const char* src,
@@ -32,6 +32,14 @@ inline bool IsValidCharacter(uint32_t code_point) {
       code_point <= 0x10FFFFu && (code_point & 0xFFFEu) != 0xFFFEu);
 }
 
+// CountLeadingASCII -----------------------------------------------------------
+
+// Returns the number of ASCII characters at the beginning of |src|, which
+// converters can copy as is. Scans 16 characters at a time where SIMD
+// instructions are available, since most text is mostly ASCII.
+BASE_EXPORT size_t CountLeadingASCII(const char* src, size_t src_len);
+BASE_EXPORT size_t CountLeadingASCII(const char16* src, size_t src_len);
+
 // ReadUnicodeCharacter --------------------------------------------------------
 
 // Reads a UTF-8 stream, placing the next code point into the given output
@@ -6,6 +6,8 @@
 
 #include <stdint.h>
 
+#include <algorithm>
+
 #include "base/strings/string_piece.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversion_utils.h"
@@ -75,9 +77,24 @@ void UnicodeAppendUnsafe(wchar_t* out, int32_t* size, uint32_t code_point) {
 
 #endif  // defined(WCHAR_T_IS_UTF32)
 
+// CopyLeadingASCII -----------------------------------------------------------
+// Copies the ASCII characters at the beginning of src to dest, which has to
+// have enough room for them. Returns the number of characters copied.
+
+template <typename SrcChar, typename DestChar>
+int32_t CopyLeadingASCII(const SrcChar* src,
+                         int32_t src_len,
+                         DestChar* dest) {
+  const int32_t ascii_len =
+      static_cast<int32_t>(CountLeadingASCII(src, src_len));
+  std::copy(src, src + ascii_len, dest);
+  return ascii_len;
+}
+
 // DoUTFConversion ------------------------------------------------------------
 // Main driver of UTFConversion specialized for different Src encodings.
-// dest has to have enough room for the converted text.
+// dest has to have enough room for the converted text. Runs of ASCII
+// characters are copied in bulk.
 
 template <typename DestChar>
 bool DoUTFConversion(const char* src,
@@ -87,6 +104,14 @@ bool DoUTFConversion(const char* src,
   bool success = true;
 
   for (int32_t i = 0; i < src_len;) {
+    if (static_cast<uint8_t>(src[i]) < 0x80) {
+      const int32_t ascii_len =
+          CopyLeadingASCII(src + i, src_len - i, dest + *dest_len);
+      i += ascii_len;
+      *dest_len += ascii_len;
+      continue;
+    }
+
     int32_t code_point;
     CBU8_NEXT(src, i, src_len, code_point);
 
@@ -121,6 +146,14 @@ bool DoUTFConversion(const char16* src,
   // Always have another symbol in order to avoid checking boundaries in the
   // middle of the surrogate pair.
   while (i < src_len - 1) {
+    if (src[i] < 0x80) {
+      const int32_t ascii_len =
+          CopyLeadingASCII(src + i, src_len - i, dest + *dest_len);
+      i += ascii_len;
+      *dest_len += ascii_len;
+      continue;
+    }
+
     int32_t code_point;
 
     if (CBU16_IS_LEAD(src[i]) && CBU16_IS_TRAIL(src[i + 1])) {
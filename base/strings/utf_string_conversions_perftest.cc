@@ -0,0 +1,127 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stdint.h>
+
+#include <string>
+
+#include "base/strings/string16.h"
+#include "base/strings/string_util.h"
+#include "base/strings/utf_string_conversion_utils.h"
+#include "base/strings/utf_string_conversions.h"
+#include "base/test/perf_benchmark.h"
+#include "base/third_party/icu/icu_utf.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+constexpr size_t kCorpusSize = 64 * 1024;
+
+// The conversion one code point at a time, as UTF8ToUTF16() used to do it, to
+// compare against.
+bool ReferenceUTF8ToUTF16(const std::string& src, string16* dest) {
+  dest->clear();
+  dest->reserve(src.size());
+  bool success = true;
+  const int32_t src_len = static_cast<int32_t>(src.size());
+  for (int32_t i = 0; i < src_len;) {
+    int32_t code_point;
+    CBU8_NEXT(src.data(), i, src_len, code_point);
+    if (!IsValidCodepoint(code_point)) {
+      success = false;
+      code_point = 0xFFFD;
+    }
+    WriteUnicodeCharacter(code_point, dest);
+  }
+  return success;
+}
+
+bool ReferenceUTF16ToUTF8(const string16& src, std::string* dest) {
+  dest->clear();
+  dest->reserve(src.size() * 3);
+  bool success = true;
+  const int32_t src_len = static_cast<int32_t>(src.size());
+  for (int32_t i = 0; i < src_len; ++i) {
+    uint32_t code_point;
+    if (!ReadUnicodeCharacter(src.data(), src_len, &i, &code_point)) {
+      success = false;
+      code_point = 0xFFFD;
+    }
+    WriteUnicodeCharacter(code_point, dest);
+  }
+  return success;
+}
+
+// Returns about kCorpusSize bytes of UTF-8 made of repetitions of |pattern|.
+std::string MakeCorpus(const char* pattern) {
+  std::string corpus;
+  while (corpus.size() < kCorpusSize)
+    corpus.append(pattern);
+  return corpus;
+}
+
+// Measures |convert| and prints the time per conversion and the throughput.
+template <typename Convert>
+void PrintThroughput(const std::string& corpus_name,
+                     const std::string& implementation,
+                     size_t corpus_size,
+                     Convert convert) {
+  PerfBenchmark::Options options;
+  options.time_unit = PerfBenchmark::TimeUnit::kMicroseconds;
+  options.bytes_per_operation = corpus_size;
+  PerfBenchmark(corpus_name, implementation, options).Run(convert);
+}
+
+void RunConversions(const std::string& corpus_name, const char* pattern) {
+  const std::string utf8 = MakeCorpus(pattern);
+  const string16 utf16 = UTF8ToUTF16(utf8);
+  string16 utf16_out;
+  std::string utf8_out;
+
+  PrintThroughput(corpus_name, "UTF8ToUTF16", utf8.size(),
+                  [&] { UTF8ToUTF16(utf8.data(), utf8.size(), &utf16_out); });
+  PrintThroughput(corpus_name, "UTF8ToUTF16_reference", utf8.size(),
+                  [&] { ReferenceUTF8ToUTF16(utf8, &utf16_out); });
+  EXPECT_EQ(utf16, utf16_out);
+
+  PrintThroughput(
+      corpus_name, "UTF16ToUTF8", utf8.size(),
+      [&] { UTF16ToUTF8(utf16.data(), utf16.size(), &utf8_out); });
+  PrintThroughput(corpus_name, "UTF16ToUTF8_reference", utf8.size(),
+                  [&] { ReferenceUTF16ToUTF8(utf16, &utf8_out); });
+  EXPECT_EQ(utf8, utf8_out);
+
+  bool is_utf8 = false;
+  PrintThroughput(corpus_name, "IsStringUTF8", utf8.size(),
+                  [&] { is_utf8 = IsStringUTF8(utf8); });
+  EXPECT_TRUE(is_utf8);
+}
+
+}  // namespace
+
+TEST(UTFStringConversionsPerfTest, ASCII) {
+  RunConversions("ASCII",
+                 "The quick brown fox jumps over the lazy dog. "
+                 "https://www.example.com/search?q=fox&hl=en\n");
+}
+
+TEST(UTFStringConversionsPerfTest, CJK) {
+  RunConversions("CJK",
+                 "\xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E\xE3\x81\xAE"
+                 "\xE6\x96\x87\xE7\xAB\xA0\xE3\x81\xA7\xE3\x81\x99"
+                 "\xE3\x80\x82\xE4\xB8\xAD\xE6\x96\x87\xED\x95\x9C"
+                 "\xEA\xB5\xAD\xEC\x96\xB4");
+}
+
+// Mostly ASCII with some non-ASCII words, as in URLs, titles and history.
+TEST(UTFStringConversionsPerfTest, Mixed) {
+  RunConversions("Mixed",
+                 "Caf\xC3\xA9 au lait - \xE6\x97\xA5\xE6\x9C\xAC "
+                 "https://example.com/wiki/M\xC3\xBCnchen?ref=search "
+                 "\xF0\x9F\x98\x80 emoji and plain text.\n");
+}
+
+}  // namespace base
@@ -7,6 +7,8 @@
 
 #include <stddef.h>
 
+#include <vector>
+
 #include "base/base_export.h"
 #include "base/callback.h"
 #include "base/location.h"
@@ -70,6 +72,19 @@ class BASE_EXPORT TaskRunner
                                OnceClosure task,
                                base::TimeDelta delay) = 0;
 
+  // Posts all of |tasks| to be run, in order. Returns true if all tasks may be
+  // run at some point in the future, and false if at least one task definitely
+  // will not be run.
+  //
+  // Implementations may enqueue |tasks| atomically and wake up the thread or
+  // worker that runs them once for the whole batch, which is cheaper than
+  // calling PostTask() for each of them. The default implementation calls
+  // PostTask() for each task. A SequencedTaskRunner runs |tasks| in order and
+  // doesn't interleave them with tasks posted concurrently if it enqueues them
+  // atomically.
+  virtual bool PostTasks(const Location& from_here,
+                         std::vector<OnceClosure> tasks);
+
   // Returns true iff tasks posted to this TaskRunner are sequenced
   // with this call.
   //
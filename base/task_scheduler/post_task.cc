@@ -129,4 +129,27 @@ scoped_refptr<SingleThreadTaskRunner> CreateCOMSTATaskRunnerWithTraits(
 }
 #endif  // defined(OS_WIN)
 
+ScopedTaskBatch::ScopedTaskBatch(const Location& from_here,
+                                 scoped_refptr<TaskRunner> task_runner)
+    : from_here_(from_here), task_runner_(std::move(task_runner)) {
+  DCHECK(task_runner_);
+}
+
+ScopedTaskBatch::~ScopedTaskBatch() {
+  Flush();
+}
+
+void ScopedTaskBatch::AddTask(OnceClosure task) {
+  DCHECK(task);
+  tasks_.push_back(std::move(task));
+}
+
+bool ScopedTaskBatch::Flush() {
+  if (tasks_.empty())
+    return true;
+  std::vector<OnceClosure> tasks;
+  tasks.swap(tasks_);
+  return task_runner_->PostTasks(from_here_, std::move(tasks));
+}
+
 }  // namespace base
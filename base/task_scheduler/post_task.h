@@ -6,11 +6,13 @@
 #define BASE_TASK_SCHEDULER_POST_TASK_H_
 
 #include <utility>
+#include <vector>
 
 #include "base/base_export.h"
 #include "base/bind.h"
 #include "base/callback.h"
 #include "base/location.h"
+#include "base/macros.h"
 #include "base/memory/ref_counted.h"
 #include "base/post_task_and_reply_with_result_internal.h"
 #include "base/sequenced_task_runner.h"
@@ -220,6 +222,46 @@ CreateCOMSTATaskRunnerWithTraits(const TaskTraits& traits,
                                      SingleThreadTaskRunnerThreadMode::SHARED);
 #endif  // defined(OS_WIN)
 
+// Accumulates tasks for |task_runner| and posts them with a single
+// TaskRunner::PostTasks() call when Flush() is called or when the
+// ScopedTaskBatch goes out of scope. Use this to post many tasks back-to-back
+// to the same TaskRunner: the tasks are enqueued together and the thread or
+// worker that runs them is woken up once instead of once per task.
+//
+//     {
+//       ScopedTaskBatch batch(FROM_HERE, task_runner);
+//       for (const auto& tile : tiles)
+//         batch.AddTask(BindOnce(&OnTileCompleted, tile));
+//     }  // All tasks are posted here.
+//
+// Tasks added to a ScopedTaskBatch don't run before they are flushed, even if
+// the caller then blocks waiting for them. This class is not thread-safe.
+class BASE_EXPORT ScopedTaskBatch {
+ public:
+  ScopedTaskBatch(const Location& from_here,
+                  scoped_refptr<TaskRunner> task_runner);
+
+  // Posts the tasks that haven't been flushed yet.
+  ~ScopedTaskBatch();
+
+  // Adds |task| to the batch.
+  void AddTask(OnceClosure task);
+
+  // Posts all tasks added since the last Flush(). Returns true if they may all
+  // be run at some point in the future (see TaskRunner::PostTasks()).
+  bool Flush();
+
+  // Returns the number of tasks added since the last Flush().
+  size_t size() const { return tasks_.size(); }
+
+ private:
+  const Location from_here_;
+  const scoped_refptr<TaskRunner> task_runner_;
+  std::vector<OnceClosure> tasks_;
+
+  DISALLOW_COPY_AND_ASSIGN(ScopedTaskBatch);
+};
+
 }  // namespace base
 
 #endif  // BASE_TASK_SCHEDULER_POST_TASK_H_
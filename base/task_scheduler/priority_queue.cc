@@ -68,6 +68,7 @@ void PriorityQueue::Transaction::Push(
     scoped_refptr<Sequence> sequence,
     const SequenceSortKey& sequence_sort_key) {
   outer_queue_->container_.emplace(std::move(sequence), sequence_sort_key);
+  outer_queue_->UpdateSizeHint();
 }
 
 const SequenceSortKey& PriorityQueue::Transaction::PeekSortKey() const {
@@ -87,6 +88,7 @@ scoped_refptr<Sequence> PriorityQueue::Transaction::PopSequence() {
           outer_queue_->container_.top())
           .take_sequence();
   outer_queue_->container_.pop();
+  outer_queue_->UpdateSizeHint();
   return sequence;
 }
 
@@ -100,11 +102,24 @@ size_t PriorityQueue::Transaction::Size() const {
 
 PriorityQueue::PriorityQueue() = default;
 
+PriorityQueue::PriorityQueue(const SchedulerLock* predecessor_lock)
+    : container_lock_(predecessor_lock) {}
+
 PriorityQueue::~PriorityQueue() = default;
 
 std::unique_ptr<PriorityQueue::Transaction> PriorityQueue::BeginTransaction() {
   return WrapUnique(new Transaction(this));
 }
 
+size_t PriorityQueue::SizeHint() const {
+  return static_cast<size_t>(subtle::NoBarrier_Load(&size_hint_));
+}
+
+void PriorityQueue::UpdateSizeHint() {
+  container_lock_.AssertAcquired();
+  subtle::NoBarrier_Store(&size_hint_,
+                          static_cast<subtle::Atomic32>(container_.size()));
+}
+
 }  // namespace internal
 }  // namespace base
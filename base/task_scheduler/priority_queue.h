@@ -9,6 +9,7 @@
 #include <queue>
 #include <vector>
 
+#include "base/atomicops.h"
 #include "base/base_export.h"
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
@@ -73,6 +74,10 @@ class BASE_EXPORT PriorityQueue {
 
   PriorityQueue();
 
+  // Constructs a PriorityQueue whose Transactions can be started while a
+  // Transaction on the PriorityQueue that owns |predecessor_lock| is alive.
+  explicit PriorityQueue(const SchedulerLock* predecessor_lock);
+
   ~PriorityQueue();
 
   // Begins a Transaction. This method cannot be called on a thread which has an
@@ -83,6 +88,13 @@ class BASE_EXPORT PriorityQueue {
 
   const SchedulerLock* container_lock() const { return &container_lock_; }
 
+  // Returns the number of Sequences in the PriorityQueue as of the end of the
+  // last operation that modified it, without acquiring |container_lock_|. The
+  // returned value may be stale by the time it is used; callers must only use
+  // it to skip work that is guaranteed to be revisited (e.g. a wake up
+  // accompanies every Push()).
+  size_t SizeHint() const;
+
  private:
   // A class combining a Sequence and the SequenceSortKey that determines its
   // position in a PriorityQueue.
@@ -90,11 +102,18 @@ class BASE_EXPORT PriorityQueue {
 
   using ContainerType = std::priority_queue<SequenceAndSortKey>;
 
+  // Updates |size_hint_| to match |container_|. |container_lock_| must be held.
+  void UpdateSizeHint();
+
   // Synchronizes access to |container_|.
   SchedulerLock container_lock_;
 
   ContainerType container_;
 
+  // Mirrors |container_.size()|. Written with |container_lock_| held, read
+  // without synchronization by SizeHint().
+  subtle::Atomic32 size_hint_ = 0;
+
   DISALLOW_COPY_AND_ASSIGN(PriorityQueue);
 };
 
@@ -140,6 +140,45 @@ TEST(TaskSchedulerPriorityQueueTest, IllegalTwoTransactionsSameThread) {
       });
 }
 
+// Check that SizeHint() tracks the number of Sequences in the PriorityQueue.
+TEST(TaskSchedulerPriorityQueueTest, SizeHint) {
+  scoped_refptr<Sequence> sequence_a(new Sequence);
+  sequence_a->PushTask(Task(FROM_HERE, DoNothing(),
+                            TaskTraits(TaskPriority::USER_VISIBLE),
+                            TimeDelta()));
+  scoped_refptr<Sequence> sequence_b(new Sequence);
+  sequence_b->PushTask(Task(FROM_HERE, DoNothing(),
+                            TaskTraits(TaskPriority::USER_BLOCKING),
+                            TimeDelta()));
+
+  PriorityQueue pq;
+  EXPECT_EQ(0U, pq.SizeHint());
+
+  pq.BeginTransaction()->Push(sequence_a, sequence_a->GetSortKey());
+  EXPECT_EQ(1U, pq.SizeHint());
+  pq.BeginTransaction()->Push(sequence_b, sequence_b->GetSortKey());
+  EXPECT_EQ(2U, pq.SizeHint());
+
+  EXPECT_EQ(sequence_b, pq.BeginTransaction()->PopSequence());
+  EXPECT_EQ(1U, pq.SizeHint());
+  EXPECT_EQ(sequence_a, pq.BeginTransaction()->PopSequence());
+  EXPECT_EQ(0U, pq.SizeHint());
+}
+
+// Check that a Transaction can be created on a PriorityQueue while a
+// Transaction is alive on its predecessor PriorityQueue.
+TEST(TaskSchedulerPriorityQueueTest, TwoTransactionsWithPredecessor) {
+  PriorityQueue pq_a;
+  PriorityQueue pq_b(pq_a.container_lock());
+
+  std::unique_ptr<PriorityQueue::Transaction> transaction_a =
+      pq_a.BeginTransaction();
+  std::unique_ptr<PriorityQueue::Transaction> transaction_b =
+      pq_b.BeginTransaction();
+  EXPECT_TRUE(transaction_a->IsEmpty());
+  EXPECT_TRUE(transaction_b->IsEmpty());
+}
+
 // Check that it is possible to begin multiple Transactions for the same
 // PriorityQueue on different threads. The call to BeginTransaction() on the
 // second thread should block until the Transaction has ended on the first
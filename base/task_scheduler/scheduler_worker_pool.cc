@@ -112,6 +112,22 @@ class SchedulerSequencedTaskRunner : public SequencedTaskRunner {
     return PostDelayedTask(from_here, std::move(closure), delay);
   }
 
+  bool PostTasks(const Location& from_here,
+                 std::vector<OnceClosure> closures) override {
+    if (!g_active_pools_count)
+      return false;
+
+    std::vector<Task> tasks;
+    tasks.reserve(closures.size());
+    for (OnceClosure& closure : closures) {
+      tasks.emplace_back(from_here, std::move(closure), traits_, TimeDelta());
+      tasks.back().sequenced_task_runner_ref = this;
+    }
+
+    // Post the tasks as part of |sequence_|.
+    return worker_pool_->PostTasksWithSequence(std::move(tasks), sequence_);
+  }
+
   bool RunsTasksInCurrentSequence() const override {
     return sequence_->token() == SequenceToken::GetForCurrentThread();
   }
@@ -167,6 +183,37 @@ bool SchedulerWorkerPool::PostTaskWithSequence(
   return true;
 }
 
+bool SchedulerWorkerPool::PostTasksWithSequence(
+    std::vector<Task> tasks,
+    scoped_refptr<Sequence> sequence) {
+  DCHECK(sequence);
+
+  // Drop the tasks that can't be posted (e.g. because of shutdown) but post
+  // the others, as PostTaskWithSequence() would if it was called for each task.
+  std::vector<Task> accepted_tasks;
+  accepted_tasks.reserve(tasks.size());
+  for (Task& task : tasks) {
+    DCHECK(task.task);
+    DCHECK(task.delayed_run_time.is_null());
+    if (task_tracker_->WillPostTask(task))
+      accepted_tasks.push_back(std::move(task));
+  }
+  const bool all_posted = accepted_tasks.size() == tasks.size();
+  if (accepted_tasks.empty())
+    return all_posted;
+
+  // Schedule |sequence| if it was empty before |accepted_tasks| were inserted
+  // into it. See PostTaskWithSequenceNow().
+  const bool sequence_was_empty = sequence->PushTasks(std::move(accepted_tasks));
+  if (sequence_was_empty) {
+    sequence = task_tracker_->WillScheduleSequence(std::move(sequence), this);
+    if (sequence)
+      OnCanScheduleSequence(std::move(sequence));
+  }
+
+  return all_posted;
+}
+
 SchedulerWorkerPool::SchedulerWorkerPool(
     TrackedRef<TaskTracker> task_tracker,
     DelayedTaskManager* delayed_task_manager)
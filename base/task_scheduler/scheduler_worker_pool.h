@@ -5,6 +5,8 @@
 #ifndef BASE_TASK_SCHEDULER_SCHEDULER_WORKER_POOL_H_
 #define BASE_TASK_SCHEDULER_SCHEDULER_WORKER_POOL_H_
 
+#include <vector>
+
 #include "base/base_export.h"
 #include "base/memory/ref_counted.h"
 #include "base/sequenced_task_runner.h"
@@ -43,6 +45,13 @@ class BASE_EXPORT SchedulerWorkerPool : public CanScheduleSequenceObserver {
   // Returns true if |task| is posted.
   bool PostTaskWithSequence(Task task, scoped_refptr<Sequence> sequence);
 
+  // Posts all of |tasks| to be executed by this SchedulerWorkerPool as part of
+  // |sequence|, in order. |tasks| must not have a delayed run time. The tasks
+  // are added to |sequence| atomically and |sequence| is scheduled at most once
+  // for the whole batch. Returns true if all of |tasks| are posted.
+  bool PostTasksWithSequence(std::vector<Task> tasks,
+                             scoped_refptr<Sequence> sequence);
+
   // Registers the worker pool in TLS.
   void BindToCurrentThread();
 
@@ -14,6 +14,7 @@
 #include "base/bind.h"
 #include "base/bind_helpers.h"
 #include "base/compiler_specific.h"
+#include "base/lazy_instance.h"
 #include "base/location.h"
 #include "base/memory/ptr_util.h"
 #include "base/metrics/histogram.h"
@@ -26,6 +27,7 @@
 #include "base/threading/platform_thread.h"
 #include "base/threading/scoped_blocking_call.h"
 #include "base/threading/thread_checker.h"
+#include "base/threading/thread_local.h"
 #include "base/threading/thread_restrictions.h"
 
 #if defined(OS_WIN)
@@ -61,14 +63,30 @@ bool ContainsWorker(const std::vector<scoped_refptr<SchedulerWorker>>& workers,
   return it != workers.end();
 }
 
+// Identifies the local queue of the worker running on the current thread and
+// the pool that owns it. Only set on workers of pools with work stealing
+// enabled.
+struct WorkerQueueBinding {
+  const SchedulerWorkerPoolImpl* pool;
+  PriorityQueue* queue;
+};
+
+LazyInstance<ThreadLocalPointer<const WorkerQueueBinding>>::Leaky
+    tls_worker_queue_binding = LAZY_INSTANCE_INITIALIZER;
+
 }  // namespace
 
 class SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl
     : public SchedulerWorker::Delegate,
       public BlockingObserver {
  public:
-  // |outer| owns the worker for which this delegate is constructed.
-  SchedulerWorkerDelegateImpl(TrackedRef<SchedulerWorkerPoolImpl> outer);
+  // |outer| owns the worker for which this delegate is constructed. If work
+  // stealing is enabled, |local_queue| is the worker's local queue and
+  // |local_queue_index| is its index in |outer->worker_queues_|; otherwise
+  // |local_queue| is nullptr.
+  SchedulerWorkerDelegateImpl(TrackedRef<SchedulerWorkerPoolImpl> outer,
+                              PriorityQueue* local_queue,
+                              size_t local_queue_index);
   ~SchedulerWorkerDelegateImpl() override;
 
   // SchedulerWorker::Delegate:
@@ -112,8 +130,30 @@ class SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl
   // Called in GetWork() when a worker becomes idle.
   void OnWorkerBecomesIdleLockRequired(SchedulerWorker* worker);
 
+  // Returns the top Sequence of |local_queue_| unless |shared_transaction|
+  // holds a Sequence with a higher priority. If both are empty, steals a
+  // Sequence from another worker. Returns nullptr if the caller should get work
+  // from |shared_transaction| instead. |shared_transaction| must be a
+  // Transaction on |outer_->shared_priority_queue_|.
+  scoped_refptr<Sequence> GetLocalOrStolenWork(
+      const PriorityQueue::Transaction* shared_transaction);
+
+  // Moves all Sequences from |local_queue_| to
+  // |outer_->shared_priority_queue_| and wakes up a worker for each of them.
+  // Called when this worker can't be relied upon to run them soon.
+  void MoveLocalSequencesToSharedQueue();
+
   const TrackedRef<SchedulerWorkerPoolImpl> outer_;
 
+  // Local queue of this worker, or nullptr if work stealing is disabled. Only
+  // this worker pushes Sequences to it. Other workers may pop Sequences from
+  // it.
+  PriorityQueue* const local_queue_;
+  const size_t local_queue_index_;
+
+  // Pointed to by |tls_worker_queue_binding| on this worker's thread.
+  const WorkerQueueBinding worker_queue_binding_;
+
   // Time of the last detach.
   TimeTicks last_detach_time_;
 
@@ -219,6 +259,10 @@ void SchedulerWorkerPoolImpl::Start(
   suggested_reclaim_time_ = params.suggested_reclaim_time();
   backward_compatibility_ = params.backward_compatibility();
   worker_environment_ = worker_environment;
+  work_stealing_enabled_ = params.work_stealing() ==
+                           SchedulerWorkerPoolParams::WorkStealing::ENABLED;
+  if (work_stealing_enabled_)
+    worker_queues_.reserve(kMaxNumberOfWorkers);
 
   service_thread_task_runner_ = std::move(service_thread_task_runner);
 
@@ -260,9 +304,25 @@ SchedulerWorkerPoolImpl::~SchedulerWorkerPoolImpl() {
 void SchedulerWorkerPoolImpl::OnCanScheduleSequence(
     scoped_refptr<Sequence> sequence) {
   const auto sequence_sort_key = sequence->GetSortKey();
-  shared_priority_queue_.BeginTransaction()->Push(std::move(sequence),
-                                                  sequence_sort_key);
 
+  // When posting from one of this pool's workers, keep the Sequence close to
+  // the posting worker. BACKGROUND Sequences always go through
+  // |shared_priority_queue_| so that |max_background_tasks_| can be enforced
+  // in one place.
+  PriorityQueue* const local_queue =
+      sequence_sort_key.priority() != TaskPriority::BACKGROUND
+          ? GetLocalQueueForCurrentThread()
+          : nullptr;
+  if (local_queue) {
+    local_queue->BeginTransaction()->Push(std::move(sequence),
+                                          sequence_sort_key);
+  } else {
+    shared_priority_queue_.BeginTransaction()->Push(std::move(sequence),
+                                                    sequence_sort_key);
+  }
+
+  // Even when the Sequence was pushed to a local queue, wake up a worker so
+  // that it can steal the Sequence if the posting worker is busy for a while.
   WakeUpOneWorker();
 }
 
@@ -360,9 +420,18 @@ void SchedulerWorkerPoolImpl::MaximizeMayBlockThresholdForTesting() {
   maximum_blocked_threshold_for_testing_.Set();
 }
 
+size_t SchedulerWorkerPoolImpl::NumberOfStolenSequencesForTesting() const {
+  return static_cast<size_t>(subtle::NoBarrier_Load(&num_stolen_sequences_));
+}
+
 SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::
-    SchedulerWorkerDelegateImpl(TrackedRef<SchedulerWorkerPoolImpl> outer)
-    : outer_(std::move(outer)) {
+    SchedulerWorkerDelegateImpl(TrackedRef<SchedulerWorkerPoolImpl> outer,
+                                PriorityQueue* local_queue,
+                                size_t local_queue_index)
+    : outer_(std::move(outer)),
+      local_queue_(local_queue),
+      local_queue_index_(local_queue_index),
+      worker_queue_binding_({&*outer_, local_queue}) {
   // Bound in OnMainEntry().
   DETACH_FROM_THREAD(worker_thread_checker_);
 }
@@ -412,6 +481,8 @@ void SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::OnMainEntry(
 
   outer_->BindToCurrentThread();
   SetBlockingObserverForCurrentThread(this);
+  if (local_queue_)
+    tls_worker_queue_binding.Get().Set(&worker_queue_binding_);
 }
 
 scoped_refptr<Sequence>
@@ -421,6 +492,7 @@ SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::GetWork(
   DCHECK(!is_running_task_);
   DCHECK(!is_running_background_task_);
 
+  bool is_excess_worker;
   {
     AutoSchedulerLock auto_lock(outer_->lock_);
 
@@ -447,18 +519,43 @@ SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::GetWork(
     // max tasks increases or another worker cleans up). This ensures that if we
     // have excess workers in the pool, they get a chance to no longer be excess
     // before being cleaned up.
-    if (outer_->NumberOfExcessWorkersLockRequired() >
-        outer_->idle_workers_stack_.Size()) {
+    is_excess_worker = outer_->NumberOfExcessWorkersLockRequired() >
+                       outer_->idle_workers_stack_.Size();
+    if (is_excess_worker)
       OnWorkerBecomesIdleLockRequired(worker);
-      return nullptr;
-    }
   }
+  if (is_excess_worker) {
+    // Sequences in the local queue of an excess worker must be made available
+    // to other workers. This can't be done with |outer_->lock_| held.
+    if (local_queue_)
+      MoveLocalSequencesToSharedQueue();
+    return nullptr;
+  }
+
   scoped_refptr<Sequence> sequence;
-  {
+
+  // With work stealing enabled, the local queue is served without touching
+  // |outer_->shared_priority_queue_| when the latter appears to be empty. A
+  // Sequence pushed to the shared queue concurrently is accompanied by a wake
+  // up, so another worker or the next call to GetWork() will pick it up.
+  if (local_queue_ && outer_->shared_priority_queue_.SizeHint() == 0) {
+    std::unique_ptr<PriorityQueue::Transaction> local_transaction(
+        local_queue_->BeginTransaction());
+    if (!local_transaction->IsEmpty())
+      sequence = local_transaction->PopSequence();
+  }
+
+  if (!sequence) {
     std::unique_ptr<PriorityQueue::Transaction> transaction(
         outer_->shared_priority_queue_.BeginTransaction());
 
-    if (transaction->IsEmpty()) {
+    // The local queue and the neighbors' local queues are examined within the
+    // scope of |transaction| so that a worker never goes idle while its own
+    // local queue holds Sequences.
+    if (local_queue_)
+      sequence = GetLocalOrStolenWork(transaction.get());
+
+    if (!sequence && transaction->IsEmpty()) {
       // |transaction| is kept alive while |worker| is added to
       // |idle_workers_stack_| to avoid this race:
       // 1. This thread creates a Transaction, finds |shared_priority_queue_|
@@ -476,21 +573,26 @@ SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::GetWork(
       return nullptr;
     }
 
-    // Enforce that no more than |max_background_tasks_| run concurrently.
-    const TaskPriority priority = transaction->PeekSortKey().priority();
-    if (priority == TaskPriority::BACKGROUND) {
-      AutoSchedulerLock auto_lock(outer_->lock_);
-      if (outer_->num_running_background_tasks_ <
-          outer_->max_background_tasks_) {
-        ++outer_->num_running_background_tasks_;
-        is_running_background_task_ = true;
-      } else {
-        OnWorkerBecomesIdleLockRequired(worker);
-        return nullptr;
+    if (!sequence) {
+      // Enforce that no more than |max_background_tasks_| run concurrently.
+      const TaskPriority priority = transaction->PeekSortKey().priority();
+      if (priority == TaskPriority::BACKGROUND) {
+        AutoSchedulerLock auto_lock(outer_->lock_);
+        if (outer_->num_running_background_tasks_ <
+            outer_->max_background_tasks_) {
+          ++outer_->num_running_background_tasks_;
+          is_running_background_task_ = true;
+        } else {
+          // The local queue is necessarily empty here: it only holds
+          // non-BACKGROUND Sequences, which GetLocalOrStolenWork() would have
+          // returned ahead of a BACKGROUND Sequence.
+          OnWorkerBecomesIdleLockRequired(worker);
+          return nullptr;
+        }
       }
-    }
 
-    sequence = transaction->PopSequence();
+      sequence = transaction->PopSequence();
+    }
   }
   DCHECK(sequence);
 #if DCHECK_IS_ON()
@@ -527,11 +629,19 @@ void SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::
   DCHECK_CALLED_ON_VALID_THREAD(worker_thread_checker_);
 
   const SequenceSortKey sequence_sort_key = sequence->GetSortKey();
-  outer_->shared_priority_queue_.BeginTransaction()->Push(std::move(sequence),
-                                                          sequence_sort_key);
+  // BACKGROUND Sequences never go to |local_queue_|; see
+  // OnCanScheduleSequence().
+  if (local_queue_ &&
+      sequence_sort_key.priority() != TaskPriority::BACKGROUND) {
+    local_queue_->BeginTransaction()->Push(std::move(sequence),
+                                           sequence_sort_key);
+  } else {
+    outer_->shared_priority_queue_.BeginTransaction()->Push(
+        std::move(sequence), sequence_sort_key);
+  }
   // This worker will soon call GetWork(). Therefore, there is no need to wake
   // up a worker to run the sequence that was just inserted into
-  // |outer_->shared_priority_queue_|.
+  // |local_queue_| or |outer_->shared_priority_queue_|.
 }
 
 TimeDelta SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::
@@ -586,6 +696,8 @@ void SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::CleanupLockRequired(
   outer_->cleanup_timestamps_.push(TimeTicks::Now());
   worker->Cleanup();
   outer_->RemoveFromIdleWorkersStackLockRequired(worker);
+  if (local_queue_)
+    outer_->ReleaseWorkerQueueIndexLockRequired(local_queue_index_);
 
   // Remove the worker from |workers_|.
   auto worker_iter =
@@ -615,10 +727,73 @@ void SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::
   outer_->AddToIdleWorkersStackLockRequired(worker);
 }
 
+scoped_refptr<Sequence>
+SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::GetLocalOrStolenWork(
+    const PriorityQueue::Transaction* shared_transaction) {
+  DCHECK_CALLED_ON_VALID_THREAD(worker_thread_checker_);
+  DCHECK(local_queue_);
+
+  {
+    std::unique_ptr<PriorityQueue::Transaction> local_transaction(
+        local_queue_->BeginTransaction());
+    if (!local_transaction->IsEmpty()) {
+      if (shared_transaction->IsEmpty() ||
+          !(shared_transaction->PeekSortKey() >
+            local_transaction->PeekSortKey())) {
+        return local_transaction->PopSequence();
+      }
+      return nullptr;
+    }
+  }
+
+  // Only steal when there is no shared work: Sequences in the shared queue
+  // were posted before the ones in local queues would have been re-enqueued.
+  if (!shared_transaction->IsEmpty())
+    return nullptr;
+  return outer_->StealSequence(local_queue_index_);
+}
+
+void SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::
+    MoveLocalSequencesToSharedQueue() {
+  DCHECK_CALLED_ON_VALID_THREAD(worker_thread_checker_);
+  DCHECK(local_queue_);
+
+  if (local_queue_->SizeHint() == 0)
+    return;
+
+  std::vector<scoped_refptr<Sequence>> sequences;
+  {
+    std::unique_ptr<PriorityQueue::Transaction> local_transaction(
+        local_queue_->BeginTransaction());
+    while (!local_transaction->IsEmpty())
+      sequences.push_back(local_transaction->PopSequence());
+  }
+
+  // Sort keys must be computed without holding a PriorityQueue lock since
+  // GetSortKey() acquires the Sequence's lock.
+  std::vector<SequenceSortKey> sort_keys;
+  sort_keys.reserve(sequences.size());
+  for (const auto& sequence : sequences)
+    sort_keys.push_back(sequence->GetSortKey());
+
+  {
+    std::unique_ptr<PriorityQueue::Transaction> shared_transaction(
+        outer_->shared_priority_queue_.BeginTransaction());
+    for (size_t i = 0; i < sequences.size(); ++i)
+      shared_transaction->Push(std::move(sequences[i]), sort_keys[i]);
+  }
+
+  for (size_t i = 0; i < sort_keys.size(); ++i)
+    outer_->WakeUpOneWorker();
+}
+
 void SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::OnMainExit(
     SchedulerWorker* worker) {
   DCHECK_CALLED_ON_VALID_THREAD(worker_thread_checker_);
 
+  if (local_queue_)
+    tls_worker_queue_binding.Get().Set(nullptr);
+
 #if DCHECK_IS_ON()
   {
     bool shutdown_complete = outer_->task_tracker_->IsShutdownComplete();
@@ -648,6 +823,11 @@ void SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::BlockingStarted(
   if (!is_running_task_)
     return;
 
+  // Sequences in the local queue would otherwise wait for the blocking call to
+  // end unless another worker happens to steal them.
+  if (local_queue_)
+    MoveLocalSequencesToSharedQueue();
+
   switch (blocking_type) {
     case BlockingType::MAY_BLOCK:
       MayBlockEntered();
@@ -828,6 +1008,64 @@ void SchedulerWorkerPoolImpl::WakeUpOneWorker() {
     ScheduleAdjustMaxTasksIfNeeded();
 }
 
+PriorityQueue* SchedulerWorkerPoolImpl::GetLocalQueueForCurrentThread() const {
+  const WorkerQueueBinding* binding = tls_worker_queue_binding.Get().Get();
+  if (!binding || binding->pool != this)
+    return nullptr;
+  return binding->queue;
+}
+
+scoped_refptr<Sequence> SchedulerWorkerPoolImpl::StealSequence(
+    size_t thief_index) {
+  DCHECK(work_stealing_enabled_);
+
+  const size_t num_worker_queues =
+      static_cast<size_t>(subtle::Acquire_Load(&num_worker_queues_));
+  DCHECK_LT(thief_index, num_worker_queues);
+  for (size_t i = 1; i < num_worker_queues; ++i) {
+    PriorityQueue* const victim_queue =
+        worker_queues_[(thief_index + i) % num_worker_queues].get();
+    // Avoid acquiring the lock of queues that are likely to be empty.
+    if (victim_queue->SizeHint() == 0)
+      continue;
+    std::unique_ptr<PriorityQueue::Transaction> victim_transaction(
+        victim_queue->BeginTransaction());
+    if (!victim_transaction->IsEmpty()) {
+      subtle::NoBarrier_AtomicIncrement(&num_stolen_sequences_, 1);
+      return victim_transaction->PopSequence();
+    }
+  }
+  return nullptr;
+}
+
+size_t SchedulerWorkerPoolImpl::AcquireWorkerQueueIndexLockRequired() {
+  lock_.AssertAcquired();
+  DCHECK(work_stealing_enabled_);
+
+  if (!free_worker_queue_indices_.empty()) {
+    const size_t index = free_worker_queue_indices_.back();
+    free_worker_queue_indices_.pop_back();
+    return index;
+  }
+
+  // Appending must not reallocate: workers read |worker_queues_| without
+  // holding |lock_|.
+  DCHECK_LT(worker_queues_.size(), worker_queues_.capacity());
+  worker_queues_.push_back(
+      std::make_unique<PriorityQueue>(shared_priority_queue_.container_lock()));
+  subtle::Release_Store(&num_worker_queues_,
+                        static_cast<subtle::Atomic32>(worker_queues_.size()));
+  return worker_queues_.size() - 1;
+}
+
+void SchedulerWorkerPoolImpl::ReleaseWorkerQueueIndexLockRequired(
+    size_t index) {
+  lock_.AssertAcquired();
+  DCHECK_LT(index, worker_queues_.size());
+  DCHECK_EQ(0U, worker_queues_[index]->SizeHint());
+  free_worker_queue_indices_.push_back(index);
+}
+
 void SchedulerWorkerPoolImpl::MaintainAtLeastOneIdleWorkerLockRequired() {
   lock_.AssertAcquired();
 
@@ -867,17 +1105,27 @@ SchedulerWorkerPoolImpl::CreateRegisterAndStartSchedulerWorkerLockRequired() {
 
   DCHECK_LT(workers_.size(), max_tasks_);
   DCHECK_LT(workers_.size(), kMaxNumberOfWorkers);
+  size_t local_queue_index = 0;
+  PriorityQueue* local_queue = nullptr;
+  if (work_stealing_enabled_) {
+    local_queue_index = AcquireWorkerQueueIndexLockRequired();
+    local_queue = worker_queues_[local_queue_index].get();
+  }
+
   // SchedulerWorker needs |lock_| as a predecessor for its thread lock
   // because in WakeUpOneWorker, |lock_| is first acquired and then
   // the thread lock is acquired when WakeUp is called on the worker.
   scoped_refptr<SchedulerWorker> worker = MakeRefCounted<SchedulerWorker>(
       priority_hint_,
       std::make_unique<SchedulerWorkerDelegateImpl>(
-          tracked_ref_factory_.GetTrackedRef()),
+          tracked_ref_factory_.GetTrackedRef(), local_queue, local_queue_index),
       task_tracker_, &lock_, backward_compatibility_);
 
-  if (!worker->Start(scheduler_worker_observer_))
+  if (!worker->Start(scheduler_worker_observer_)) {
+    if (local_queue)
+      ReleaseWorkerQueueIndexLockRequired(local_queue_index);
     return nullptr;
+  }
 
   workers_.push_back(worker);
   DCHECK_LE(workers_.size(), max_tasks_);
@@ -11,6 +11,7 @@
 #include <string>
 #include <vector>
 
+#include "base/atomicops.h"
 #include "base/base_export.h"
 #include "base/containers/stack.h"
 #include "base/logging.h"
@@ -141,6 +142,10 @@ class BASE_EXPORT SchedulerWorkerPoolImpl : public SchedulerWorkerPool {
   // Sets the MayBlock waiting threshold to TimeDelta::Max().
   void MaximizeMayBlockThresholdForTesting();
 
+  // Returns the number of Sequences that were stolen from the local queue of
+  // another worker since Start(). Always 0 when work stealing is disabled.
+  size_t NumberOfStolenSequencesForTesting() const;
+
  private:
   class SchedulerWorkerDelegateImpl;
 
@@ -165,6 +170,24 @@ class BASE_EXPORT SchedulerWorkerPoolImpl : public SchedulerWorkerPool {
   // Wakes up the last worker from this worker pool to go idle, if any.
   void WakeUpOneWorker();
 
+  // Returns the local queue of the worker running on the current thread if it
+  // belongs to this pool and work stealing is enabled, nullptr otherwise.
+  PriorityQueue* GetLocalQueueForCurrentThread() const;
+
+  // Pops the highest priority Sequence from the local queue of a worker other
+  // than the one that owns |worker_queues_[thief_index]|, visiting neighbors
+  // in index order. Returns nullptr if all other local queues are empty. Must
+  // be called within the scope of a Transaction on |shared_priority_queue_|.
+  scoped_refptr<Sequence> StealSequence(size_t thief_index);
+
+  // Returns the index in |worker_queues_| of a local queue that isn't owned by
+  // any worker, creating one if needed.
+  size_t AcquireWorkerQueueIndexLockRequired();
+
+  // Makes the local queue at |index| in |worker_queues_| available to a future
+  // worker. The queue must be empty.
+  void ReleaseWorkerQueueIndexLockRequired(size_t index);
+
   // Performs the same action as WakeUpOneWorker() except asserts |lock_| is
   // acquired rather than acquires it and returns true if worker wakeups are
   // permitted.
@@ -231,6 +254,28 @@ class BASE_EXPORT SchedulerWorkerPoolImpl : public SchedulerWorkerPool {
 
   SchedulerBackwardCompatibility backward_compatibility_;
 
+  // Whether workers have local queues from which other workers can steal.
+  // Initialized by Start(). Never modified afterwards (i.e. can be read without
+  // synchronization after Start()).
+  bool work_stealing_enabled_ = false;
+
+  // Local queues of workers, created on demand when work stealing is enabled.
+  // Each queue has |shared_priority_queue_|'s lock as its predecessor so that
+  // a worker can look at local queues within the scope of a Transaction on
+  // |shared_priority_queue_| (more details in GetWork()). Capacity is reserved
+  // in Start() so that elements never move: queues are appended with |lock_|
+  // held and the first |num_worker_queues_| elements can be read without
+  // synchronization. Queues outlive the workers that use them.
+  std::vector<std::unique_ptr<PriorityQueue>> worker_queues_;
+  subtle::Atomic32 num_worker_queues_ = 0;
+
+  // Indices in |worker_queues_| of queues that aren't owned by any worker.
+  // Protected by |lock_|.
+  std::vector<size_t> free_worker_queue_indices_;
+
+  // Number of Sequences stolen from another worker's local queue.
+  subtle::Atomic32 num_stolen_sequences_ = 0;
+
   // Synchronizes accesses to |workers_|, |max_tasks_|, |max_background_tasks_|,
   // |num_running_background_tasks_|, |num_pending_may_block_workers_|,
   // |idle_workers_stack_|, |idle_workers_stack_cv_for_testing_|,
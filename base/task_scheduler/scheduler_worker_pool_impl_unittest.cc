@@ -1562,6 +1562,126 @@ TEST_F(TaskSchedulerWorkerPoolImplStartInBodyTest, MaxBackgroundTasks) {
   task_tracker_.FlushForTesting();
 }
 
+// Verify that Sequences posted from a worker to its local queue can run in
+// parallel on other workers when work stealing is enabled.
+TEST_F(TaskSchedulerWorkerPoolImplStartInBodyTest, WorkStealingNestedTasks) {
+  worker_pool_->Start(
+      SchedulerWorkerPoolParams(
+          kMaxTasks, base::TimeDelta::Max(),
+          SchedulerBackwardCompatibility::DISABLED,
+          SchedulerWorkerPoolParams::WorkStealing::ENABLED),
+      kMaxTasks, service_thread_.task_runner(), nullptr,
+      SchedulerWorkerPoolImpl::WorkerEnvironment::NONE);
+  const scoped_refptr<TaskRunner> task_runner =
+      worker_pool_->CreateTaskRunnerWithTraits({WithBaseSyncPrimitives()});
+
+  WaitableEvent nested_tasks_running;
+  WaitableEvent unblock_nested_tasks;
+  RepeatingClosure nested_tasks_running_barrier = BarrierClosure(
+      kMaxTasks - 1,
+      BindOnce(&WaitableEvent::Signal, Unretained(&nested_tasks_running)));
+
+  // The outer task doesn't return until all nested tasks are running. Since it
+  // waits without a blocking observer, the nested tasks stay in its local
+  // queue and can only run if other workers steal them.
+  task_runner->PostTask(FROM_HERE, BindLambdaForTesting([&]() {
+                          for (size_t i = 0; i < kMaxTasks - 1; ++i) {
+                            task_runner->PostTask(
+                                FROM_HERE, BindLambdaForTesting([&]() {
+                                  nested_tasks_running_barrier.Run();
+                                  WaitWithoutBlockingObserver(
+                                      &unblock_nested_tasks);
+                                }));
+                          }
+                          WaitWithoutBlockingObserver(&nested_tasks_running);
+                        }));
+
+  nested_tasks_running.Wait();
+  EXPECT_EQ(kMaxTasks - 1, worker_pool_->NumberOfStolenSequencesForTesting());
+  unblock_nested_tasks.Signal();
+  task_tracker_.FlushForTesting();
+}
+
+// Verify that entering a ScopedBlockingCall makes the Sequences in a worker's
+// local queue available to other workers.
+TEST_F(TaskSchedulerWorkerPoolImplStartInBodyTest,
+       WorkStealingBlockingCallReleasesLocalQueue) {
+  worker_pool_->Start(
+      SchedulerWorkerPoolParams(
+          kMaxTasks, base::TimeDelta::Max(),
+          SchedulerBackwardCompatibility::DISABLED,
+          SchedulerWorkerPoolParams::WorkStealing::ENABLED),
+      kMaxTasks, service_thread_.task_runner(), nullptr,
+      SchedulerWorkerPoolImpl::WorkerEnvironment::NONE);
+  const scoped_refptr<TaskRunner> task_runner =
+      worker_pool_->CreateTaskRunnerWithTraits(
+          {MayBlock(), WithBaseSyncPrimitives()});
+
+  WaitableEvent nested_task_ran;
+  task_runner->PostTask(
+      FROM_HERE, BindLambdaForTesting([&]() {
+        task_runner->PostTask(FROM_HERE,
+                              BindOnce(&WaitableEvent::Signal,
+                                       Unretained(&nested_task_ran)));
+        ScopedBlockingCall scoped_blocking_call(BlockingType::WILL_BLOCK);
+        nested_task_ran.Wait();
+      }));
+
+  task_tracker_.FlushForTesting();
+  EXPECT_TRUE(nested_task_ran.IsSignaled());
+}
+
+// Verify that the maximum number of background tasks that can run concurrently
+// is honored for tasks posted from workers when work stealing is enabled.
+TEST_F(TaskSchedulerWorkerPoolImplStartInBodyTest,
+       WorkStealingMaxBackgroundTasks) {
+  constexpr int kMaxBackgroundTasks = kMaxTasks / 2;
+  constexpr int kNumBackgroundTasks = kMaxTasks * 4;
+  worker_pool_->Start(
+      SchedulerWorkerPoolParams(
+          kMaxTasks, base::TimeDelta::Max(),
+          SchedulerBackwardCompatibility::DISABLED,
+          SchedulerWorkerPoolParams::WorkStealing::ENABLED),
+      kMaxBackgroundTasks, service_thread_.task_runner(), nullptr,
+      SchedulerWorkerPoolImpl::WorkerEnvironment::NONE);
+  const scoped_refptr<TaskRunner> foreground_runner =
+      worker_pool_->CreateTaskRunnerWithTraits({});
+  const scoped_refptr<TaskRunner> background_runner =
+      worker_pool_->CreateTaskRunnerWithTraits({TaskPriority::BACKGROUND});
+
+  subtle::Atomic32 num_running_background_tasks = 0;
+  subtle::Atomic32 max_running_background_tasks = 0;
+  auto background_task = [&]() {
+    const subtle::Atomic32 running =
+        subtle::NoBarrier_AtomicIncrement(&num_running_background_tasks, 1);
+    subtle::Atomic32 max = subtle::NoBarrier_Load(&max_running_background_tasks);
+    while (running > max) {
+      const subtle::Atomic32 previous = subtle::NoBarrier_CompareAndSwap(
+          &max_running_background_tasks, max, running);
+      if (previous == max)
+        break;
+      max = previous;
+    }
+    PlatformThread::Sleep(TimeDelta::FromMilliseconds(1));
+    subtle::NoBarrier_AtomicIncrement(&num_running_background_tasks, -1);
+  };
+
+  // Post the TaskPriority::BACKGROUND tasks from a worker so that they would be
+  // eligible for its local queue if it weren't for their priority.
+  foreground_runner->PostTask(FROM_HERE, BindLambdaForTesting([&]() {
+                                for (int i = 0; i < kNumBackgroundTasks; ++i) {
+                                  background_runner->PostTask(
+                                      FROM_HERE,
+                                      BindLambdaForTesting(background_task));
+                                }
+                              }));
+
+  task_tracker_.FlushForTesting();
+  EXPECT_LE(subtle::NoBarrier_Load(&max_running_background_tasks),
+            kMaxBackgroundTasks);
+  EXPECT_EQ(0U, worker_pool_->NumberOfStolenSequencesForTesting());
+}
+
 namespace {
 
 class TaskSchedulerWorkerPoolBlockingCallAndMaxBackgroundTasksTest
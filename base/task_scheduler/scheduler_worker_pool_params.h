@@ -12,17 +12,29 @@ namespace base {
 
 class BASE_EXPORT SchedulerWorkerPoolParams final {
  public:
+  enum class WorkStealing {
+    // All workers get Sequences from a single shared PriorityQueue.
+    DISABLED,
+
+    // Each worker also has a local PriorityQueue that receives non-BACKGROUND
+    // Sequences posted or re-enqueued from that worker. Idle workers steal
+    // from their neighbors' local queues when the shared queue is empty.
+    ENABLED,
+  };
+
   // Constructs a set of params used to initialize a pool. The pool will run
   // concurrently at most |max_tasks| that aren't blocked (ScopedBlockingCall).
   // |suggested_reclaim_time| sets a suggestion on when to reclaim idle threads.
   // The pool is free to ignore this value for performance or correctness
   // reasons. |backward_compatibility| indicates whether backward compatibility
-  // is enabled.
+  // is enabled. |work_stealing| indicates whether workers have local queues
+  // from which other workers can steal.
   SchedulerWorkerPoolParams(
       int max_tasks,
       TimeDelta suggested_reclaim_time,
       SchedulerBackwardCompatibility backward_compatibility =
-          SchedulerBackwardCompatibility::DISABLED);
+          SchedulerBackwardCompatibility::DISABLED,
+      WorkStealing work_stealing = WorkStealing::DISABLED);
 
   SchedulerWorkerPoolParams(const SchedulerWorkerPoolParams& other);
   SchedulerWorkerPoolParams& operator=(const SchedulerWorkerPoolParams& other);
@@ -32,11 +44,13 @@ class BASE_EXPORT SchedulerWorkerPoolParams final {
   SchedulerBackwardCompatibility backward_compatibility() const {
     return backward_compatibility_;
   }
+  WorkStealing work_stealing() const { return work_stealing_; }
 
  private:
   int max_tasks_;
   TimeDelta suggested_reclaim_time_;
   SchedulerBackwardCompatibility backward_compatibility_;
+  WorkStealing work_stealing_;
 };
 
 }  // namespace base
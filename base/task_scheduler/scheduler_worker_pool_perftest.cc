@@ -0,0 +1,195 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+#include <tuple>
+
+#include "base/atomicops.h"
+#include "base/barrier_closure.h"
+#include "base/bind.h"
+#include "base/callback.h"
+#include "base/macros.h"
+#include "base/strings/stringprintf.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/task_runner.h"
+#include "base/task_scheduler/delayed_task_manager.h"
+#include "base/task_scheduler/scheduler_worker_pool_impl.h"
+#include "base/task_scheduler/scheduler_worker_pool_params.h"
+#include "base/task_scheduler/task_tracker.h"
+#include "base/threading/thread.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+namespace internal {
+
+namespace {
+
+using WorkStealing = SchedulerWorkerPoolParams::WorkStealing;
+
+// Number of tasks posted by tests that measure post-to-run latency.
+constexpr size_t kNumLatencyTasks = 10000;
+
+// Number of tasks posted by tests that measure throughput.
+constexpr size_t kNumThroughputTasks = 100000;
+
+// Depth of the binary tree of tasks in the FanOut test. Every task that isn't
+// a leaf posts 2 tasks.
+constexpr int kFanOutDepth = 16;
+
+class TaskSchedulerWorkerPoolPerfTest
+    : public testing::TestWithParam<std::tuple<size_t, WorkStealing>> {
+ public:
+  TaskSchedulerWorkerPoolPerfTest()
+      : service_thread_("TaskSchedulerServiceThread") {}
+
+  static std::string ParamInfoToString(
+      ::testing::TestParamInfo<std::tuple<size_t, WorkStealing>> param_info) {
+    return StringPrintf(
+        "%zu_Workers_%s", std::get<0>(param_info.param),
+        std::get<1>(param_info.param) == WorkStealing::ENABLED ? "WorkStealing"
+                                                               : "Shared");
+  }
+
+ protected:
+  void SetUp() override {
+    service_thread_.Start();
+    delayed_task_manager_.Start(service_thread_.task_runner());
+    worker_pool_ = std::make_unique<SchedulerWorkerPoolImpl>(
+        "PerfTestWorkerPool", "PerfTest", ThreadPriority::NORMAL,
+        task_tracker_.GetTrackedRef(), &delayed_task_manager_);
+    worker_pool_->Start(
+        SchedulerWorkerPoolParams(num_workers(), TimeDelta::Max(),
+                                  SchedulerBackwardCompatibility::DISABLED,
+                                  std::get<1>(GetParam())),
+        num_workers(), service_thread_.task_runner(), nullptr,
+        SchedulerWorkerPoolImpl::WorkerEnvironment::NONE);
+    task_runner_ = worker_pool_->CreateTaskRunnerWithTraits({});
+  }
+
+  void TearDown() override {
+    service_thread_.Stop();
+    task_tracker_.FlushForTesting();
+    worker_pool_->JoinForTesting();
+  }
+
+  size_t num_workers() const { return std::get<0>(GetParam()); }
+
+  std::string trace() const {
+    return ParamInfoToString(
+        ::testing::TestParamInfo<std::tuple<size_t, WorkStealing>>(GetParam(),
+                                                                     0));
+  }
+
+  // Posts a task that posts 2 tasks, recursively, until |depth| is 0. Runs
+  // |done| once per leaf.
+  void PostFanOutTask(int depth, const RepeatingClosure& done) {
+    task_runner_->PostTask(
+        FROM_HERE, BindOnce(&TaskSchedulerWorkerPoolPerfTest::FanOut,
+                            Unretained(this), depth, done));
+  }
+
+  void FanOut(int depth, const RepeatingClosure& done) {
+    if (depth == 0) {
+      done.Run();
+      return;
+    }
+    PostFanOutTask(depth - 1, done);
+    PostFanOutTask(depth - 1, done);
+  }
+
+  scoped_refptr<TaskRunner> task_runner_;
+
+ private:
+  Thread service_thread_;
+  TaskTracker task_tracker_ = {"PerfTest"};
+  DelayedTaskManager delayed_task_manager_;
+  std::unique_ptr<SchedulerWorkerPoolImpl> worker_pool_;
+
+  DISALLOW_COPY_AND_ASSIGN(TaskSchedulerWorkerPoolPerfTest);
+};
+
+}  // namespace
+
+// Measures the average delay between posting a task from a thread that doesn't
+// belong to the pool and the start of its execution, with one task in flight
+// at a time.
+TEST_P(TaskSchedulerWorkerPoolPerfTest, PostToRunLatency) {
+  WaitableEvent task_ran(WaitableEvent::ResetPolicy::AUTOMATIC,
+                         WaitableEvent::InitialState::NOT_SIGNALED);
+  TimeDelta total_latency;
+  for (size_t i = 0; i < kNumLatencyTasks; ++i) {
+    TimeTicks run_time;
+    const TimeTicks post_time = TimeTicks::Now();
+    task_runner_->PostTask(FROM_HERE, BindOnce(
+                                          [](TimeTicks* run_time,
+                                             WaitableEvent* task_ran) {
+                                            *run_time = TimeTicks::Now();
+                                            task_ran->Signal();
+                                          },
+                                          &run_time, &task_ran));
+    task_ran.Wait();
+    total_latency += run_time - post_time;
+  }
+  perf_test::PrintResult(
+      "post_to_run_latency", "", trace(),
+      total_latency.InMicrosecondsF() / kNumLatencyTasks, "us/task", true);
+}
+
+// Measures the rate at which tasks posted from a thread that doesn't belong to
+// the pool are run.
+TEST_P(TaskSchedulerWorkerPoolPerfTest, ExternalPostThroughput) {
+  WaitableEvent all_tasks_ran;
+  RepeatingClosure task = BarrierClosure(
+      kNumThroughputTasks,
+      BindOnce(&WaitableEvent::Signal, Unretained(&all_tasks_ran)));
+
+  const TimeTicks start_time = TimeTicks::Now();
+  for (size_t i = 0; i < kNumThroughputTasks; ++i)
+    task_runner_->PostTask(FROM_HERE, task);
+  const TimeDelta post_duration = TimeTicks::Now() - start_time;
+  all_tasks_ran.Wait();
+  const TimeDelta run_duration = TimeTicks::Now() - start_time;
+
+  perf_test::PrintResult(
+      "external_post", "", trace(),
+      post_duration.InMicrosecondsF() / kNumThroughputTasks, "us/task", true);
+  perf_test::PrintResult(
+      "external_post_throughput", "", trace(),
+      kNumThroughputTasks / run_duration.InSecondsF(), "tasks/s", true);
+}
+
+// Measures the rate at which tasks that post tasks to the same pool are run.
+// This is the pattern that bursty PostTask storms from workers follow.
+TEST_P(TaskSchedulerWorkerPoolPerfTest, FanOutThroughput) {
+  constexpr size_t kNumLeaves = 1 << kFanOutDepth;
+  WaitableEvent all_leaves_ran;
+  RepeatingClosure done = BarrierClosure(
+      kNumLeaves, BindOnce(&WaitableEvent::Signal, Unretained(&all_leaves_ran)));
+
+  const TimeTicks start_time = TimeTicks::Now();
+  PostFanOutTask(kFanOutDepth, done);
+  all_leaves_ran.Wait();
+  const TimeDelta run_duration = TimeTicks::Now() - start_time;
+
+  // A binary tree with |kNumLeaves| leaves has 2 * |kNumLeaves| - 1 nodes.
+  perf_test::PrintResult(
+      "fan_out_throughput", "", trace(),
+      (2 * kNumLeaves - 1) / run_duration.InSecondsF(), "tasks/s", true);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    ,
+    TaskSchedulerWorkerPoolPerfTest,
+    ::testing::Combine(::testing::Values(1, 2, 4, 8, 16, 32, 64),
+                       ::testing::Values(WorkStealing::DISABLED,
+                                         WorkStealing::ENABLED)),
+    TaskSchedulerWorkerPoolPerfTest::ParamInfoToString);
+
+}  // namespace internal
+}  // namespace base
@@ -5,13 +5,16 @@
 #include "base/task_scheduler/scheduler_worker_pool.h"
 
 #include <memory>
+#include <vector>
 
 #include "base/bind.h"
 #include "base/bind_helpers.h"
 #include "base/location.h"
 #include "base/memory/ref_counted.h"
+#include "base/synchronization/lock.h"
 #include "base/task_runner.h"
 #include "base/task_scheduler/delayed_task_manager.h"
+#include "base/task_scheduler/post_task.h"
 #include "base/task_scheduler/scheduler_worker_pool_impl.h"
 #include "base/task_scheduler/scheduler_worker_pool_params.h"
 #include "base/task_scheduler/task_tracker.h"
@@ -217,6 +220,55 @@ TEST_P(TaskSchedulerWorkerPoolTest, PostTaskAfterShutdown) {
   EXPECT_FALSE(task_runner->PostTask(FROM_HERE, BindOnce(&ShouldNotRun)));
 }
 
+// Verify that a batch of Tasks can't be posted after shutdown.
+TEST_P(TaskSchedulerWorkerPoolTest, PostTasksAfterShutdown) {
+  StartWorkerPool();
+  auto task_runner = test::CreateTaskRunnerWithExecutionMode(
+      worker_pool_.get(), GetParam().execution_mode);
+  task_tracker_.Shutdown();
+  std::vector<OnceClosure> tasks;
+  tasks.push_back(BindOnce(&ShouldNotRun));
+  tasks.push_back(BindOnce(&ShouldNotRun));
+  EXPECT_FALSE(task_runner->PostTasks(FROM_HERE, std::move(tasks)));
+}
+
+// Verify that all tasks added to a ScopedTaskBatch run once it is flushed, in
+// order if the TaskRunner is sequenced.
+TEST_P(TaskSchedulerWorkerPoolTest, ScopedTaskBatch) {
+  constexpr int kNumTasks = 20;
+  StartWorkerPool();
+  auto task_runner = test::CreateTaskRunnerWithExecutionMode(
+      worker_pool_.get(), GetParam().execution_mode);
+
+  Lock lock;
+  std::vector<int> run_order;
+  WaitableEvent all_tasks_ran;
+  {
+    ScopedTaskBatch batch(FROM_HERE, task_runner);
+    for (int i = 0; i < kNumTasks; ++i) {
+      batch.AddTask(BindOnce(
+          [](Lock* lock, std::vector<int>* run_order,
+             WaitableEvent* all_tasks_ran, int i) {
+            AutoLock auto_lock(*lock);
+            run_order->push_back(i);
+            if (run_order->size() == kNumTasks)
+              all_tasks_ran->Signal();
+          },
+          Unretained(&lock), Unretained(&run_order), Unretained(&all_tasks_ran),
+          i));
+    }
+    EXPECT_EQ(static_cast<size_t>(kNumTasks), batch.size());
+  }
+  all_tasks_ran.Wait();
+
+  AutoLock auto_lock(lock);
+  ASSERT_EQ(static_cast<size_t>(kNumTasks), run_order.size());
+  if (GetParam().execution_mode == test::ExecutionMode::SEQUENCED) {
+    for (int i = 0; i < kNumTasks; ++i)
+      EXPECT_EQ(i, run_order[i]);
+  }
+}
+
 // Verify that posting tasks after the pool was destroyed fails but doesn't
 // crash.
 TEST_P(TaskSchedulerWorkerPoolTest, PostAfterDestroy) {
@@ -29,6 +29,26 @@ bool Sequence::PushTask(Task task) {
   return queue_.size() == 1;
 }
 
+bool Sequence::PushTasks(std::vector<Task> tasks) {
+  DCHECK(!tasks.empty());
+  const TimeTicks sequenced_time = TimeTicks::Now();
+  for (Task& task : tasks) {
+    // Use CHECK instead of DCHECK to crash earlier. See http://crbug.com/711167
+    // for details.
+    CHECK(task.task);
+    DCHECK(task.sequenced_time.is_null());
+    task.sequenced_time = sequenced_time;
+  }
+
+  AutoSchedulerLock auto_lock(lock_);
+  const bool was_empty = queue_.empty();
+  for (Task& task : tasks) {
+    ++num_tasks_per_priority_[static_cast<int>(task.traits.priority())];
+    queue_.push(std::move(task));
+  }
+  return was_empty;
+}
+
 Optional<Task> Sequence::TakeTask() {
   AutoSchedulerLock auto_lock(lock_);
   DCHECK(!queue_.empty());
@@ -7,6 +7,8 @@
 
 #include <stddef.h>
 
+#include <vector>
+
 #include "base/base_export.h"
 #include "base/containers/queue.h"
 #include "base/macros.h"
@@ -47,6 +49,11 @@ class BASE_EXPORT Sequence : public RefCountedThreadSafe<Sequence> {
   // Sequence was empty before this operation.
   bool PushTask(Task task);
 
+  // Adds all of |tasks|, in order, in new slots at the end of the Sequence
+  // while holding the Sequence's lock once. |tasks| must not be empty. Returns
+  // true if the Sequence was empty before this operation.
+  bool PushTasks(std::vector<Task> tasks);
+
   // Transfers ownership of the Task in the front slot of the Sequence to the
   // caller. The front slot of the Sequence will be nullptr and remain until
   // Pop(). Cannot be called on an empty Sequence or a Sequence whose front slot
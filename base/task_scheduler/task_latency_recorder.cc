@@ -0,0 +1,278 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/task_scheduler/task_latency_recorder.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "base/bits.h"
+#include "base/format_macros.h"
+#include "base/metrics/histogram.h"
+#include "base/strings/stringprintf.h"
+#include "base/trace_event/memory_allocator_dump.h"
+#include "base/trace_event/memory_dump_manager.h"
+#include "base/trace_event/process_memory_dump.h"
+
+namespace base {
+namespace internal {
+
+namespace {
+
+constexpr char kMicrosecondsUnits[] = "microseconds";
+
+// Adds the counts of |sketch| that are not in |merged_counts| yet to the
+// histogram named |histogram_name|, and updates |merged_counts|.
+void MergeSketchIntoHistogram(const std::string& histogram_name,
+                              const LatencySketch& sketch,
+                              uint32_t* merged_counts) {
+  HistogramBase* histogram = nullptr;
+  for (int bucket = 0; bucket < LatencySketch::kNumBuckets; ++bucket) {
+    const uint32_t count = sketch.GetCount(bucket);
+    if (count == merged_counts[bucket])
+      continue;
+    if (!histogram) {
+      histogram = Histogram::FactoryMicrosecondsTimeGet(
+          histogram_name, TimeDelta::FromMicroseconds(1),
+          TimeDelta::FromMinutes(1), 50, HistogramBase::kNoFlags);
+    }
+    histogram->AddCount(
+        static_cast<HistogramBase::Sample>(LatencySketch::GetBucketMin(bucket)),
+        static_cast<int>(count - merged_counts[bucket]));
+    merged_counts[bucket] = count;
+  }
+}
+
+void AddSketchToDump(const char* name,
+                     const LatencySketch& sketch,
+                     trace_event::MemoryAllocatorDump* dump) {
+  dump->AddScalar(StringPrintf("%s_count", name).c_str(),
+                  trace_event::MemoryAllocatorDump::kUnitsObjects,
+                  sketch.GetTotalCount());
+  dump->AddScalar(StringPrintf("%s_p50", name).c_str(), kMicrosecondsUnits,
+                  sketch.GetPercentile(50).InMicroseconds());
+  dump->AddScalar(StringPrintf("%s_p99", name).c_str(), kMicrosecondsUnits,
+                  sketch.GetPercentile(99).InMicroseconds());
+}
+
+}  // namespace
+
+LatencySketch::LatencySketch() : counts_() {}
+
+void LatencySketch::Add(TimeDelta duration) {
+  subtle::NoBarrier_AtomicIncrement(
+      &counts_[GetBucket(std::max<int64_t>(duration.InMicroseconds(), 0))], 1);
+}
+
+uint32_t LatencySketch::GetTotalCount() const {
+  uint32_t total = 0;
+  for (int bucket = 0; bucket < kNumBuckets; ++bucket)
+    total += GetCount(bucket);
+  return total;
+}
+
+TimeDelta LatencySketch::GetPercentile(double percentile) const {
+  DCHECK_GE(percentile, 0);
+  DCHECK_LE(percentile, 100);
+  const uint32_t total = GetTotalCount();
+  if (!total)
+    return TimeDelta();
+  const uint32_t rank = std::max<uint32_t>(
+      1, static_cast<uint32_t>(std::ceil(percentile / 100 * total)));
+  uint32_t seen = 0;
+  for (int bucket = 0; bucket < kNumBuckets; ++bucket) {
+    seen += GetCount(bucket);
+    if (seen >= rank)
+      return TimeDelta::FromMicroseconds(GetBucketMin(bucket));
+  }
+  // Counts were added concurrently.
+  return TimeDelta::FromMicroseconds(GetBucketMin(kNumBuckets - 1));
+}
+
+// static
+int LatencySketch::GetBucket(int64_t microseconds) {
+  DCHECK_GE(microseconds, 0);
+  if (microseconds < 2)
+    return static_cast<int>(microseconds);
+  // Two buckets per power of 2: the one for [2^n, 1.5 * 2^n) and the one for
+  // [1.5 * 2^n, 2^(n+1)).
+  const int log2 =
+      63 - bits::CountLeadingZeroBits(static_cast<uint64_t>(microseconds));
+  const int bucket =
+      2 * log2 + static_cast<int>((microseconds >> (log2 - 1)) & 1);
+  return std::min(bucket, kNumBuckets - 1);
+}
+
+// static
+int64_t LatencySketch::GetBucketMin(int bucket) {
+  DCHECK_GE(bucket, 0);
+  DCHECK_LT(bucket, kNumBuckets);
+  if (bucket < 2)
+    return bucket;
+  return static_cast<int64_t>(2 + bucket % 2) << (bucket / 2 - 1);
+}
+
+struct TaskLatencyRecorder::Entry {
+  // Program counter of the Location, or 0 if the entry is free. Claimed with
+  // a compare-and-swap.
+  subtle::AtomicWord program_counter = 0;
+
+  // Set with a release store once |file_name| and |line_number| are set.
+  subtle::Atomic32 published = 0;
+
+  const char* file_name = nullptr;
+  int line_number = -1;
+
+  LatencySketch queue_time;
+  LatencySketch run_time;
+};
+
+struct TaskLatencyRecorder::MergedCounts {
+  uint32_t queue_time[LatencySketch::kNumBuckets] = {};
+  uint32_t run_time[LatencySketch::kNumBuckets] = {};
+};
+
+TaskLatencyRecorder::TaskLatencyRecorder(StringPiece label)
+    : label_(label.as_string()),
+      entries_(new Entry[kMaxLocations + 1]),
+      weak_factory_(this) {
+  static_assert(bits::IsPowerOfTwo(kMaxLocations),
+                "kMaxLocations must be a power of 2");
+  subtle::NoBarrier_Store(&entries_[kMaxLocations].published, 1);
+}
+
+TaskLatencyRecorder::~TaskLatencyRecorder() = default;
+
+void TaskLatencyRecorder::RecordQueueTime(const Location& posted_from,
+                                          TimeDelta queue_time) {
+  GetOrCreateEntry(posted_from)->queue_time.Add(queue_time);
+}
+
+void TaskLatencyRecorder::RecordRunTime(const Location& posted_from,
+                                        TimeDelta run_time) {
+  GetOrCreateEntry(posted_from)->run_time.Add(run_time);
+}
+
+void TaskLatencyRecorder::RegisterProviders() {
+  trace_event::MemoryDumpManager::GetInstance()->RegisterDumpProvider(
+      this, "TaskSchedulerLatencyByLocation", nullptr);
+  StatisticsRecorder::RegisterHistogramProvider(weak_factory_.GetWeakPtr());
+}
+
+const LatencySketch* TaskLatencyRecorder::GetQueueTimeSketchForTesting(
+    const Location& posted_from) const {
+  const Entry* entry = FindEntry(posted_from);
+  return entry ? &entry->queue_time : nullptr;
+}
+
+const LatencySketch* TaskLatencyRecorder::GetRunTimeSketchForTesting(
+    const Location& posted_from) const {
+  const Entry* entry = FindEntry(posted_from);
+  return entry ? &entry->run_time : nullptr;
+}
+
+bool TaskLatencyRecorder::OnMemoryDump(const trace_event::MemoryDumpArgs& args,
+                                       trace_event::ProcessMemoryDump* pmd) {
+  const std::string dump_name =
+      "task_scheduler/latency_by_location/" + label_;
+  trace_event::MemoryAllocatorDump* dump =
+      pmd->CreateAllocatorDump(dump_name);
+  dump->AddScalar(trace_event::MemoryAllocatorDump::kNameSize,
+                  trace_event::MemoryAllocatorDump::kUnitsBytes,
+                  sizeof(Entry) * (kMaxLocations + 1));
+  if (args.level_of_detail != trace_event::MemoryDumpLevelOfDetail::DETAILED)
+    return true;
+
+  for (size_t i = 0; i <= kMaxLocations; ++i) {
+    const Entry& entry = entries_[i];
+    if (!subtle::Acquire_Load(&entry.published))
+      continue;
+    if (!entry.queue_time.GetTotalCount() && !entry.run_time.GetTotalCount())
+      continue;
+    trace_event::MemoryAllocatorDump* location_dump = pmd->CreateAllocatorDump(
+        StringPrintf("%s/location_%" PRIuS, dump_name.c_str(), i));
+    location_dump->AddString("location", "", GetLocationName(entry));
+    AddSketchToDump("queue_time", entry.queue_time, location_dump);
+    AddSketchToDump("run_time", entry.run_time, location_dump);
+  }
+  return true;
+}
+
+void TaskLatencyRecorder::MergeHistogramDeltas() {
+  AutoLock auto_lock(merge_lock_);
+  if (!merged_counts_)
+    merged_counts_.reset(new MergedCounts[kMaxLocations + 1]);
+
+  for (size_t i = 0; i <= kMaxLocations; ++i) {
+    const Entry& entry = entries_[i];
+    if (!subtle::Acquire_Load(&entry.published))
+      continue;
+    const std::string suffix = label_ + "." + GetLocationName(entry);
+    MergeSketchIntoHistogram("TaskScheduler.QueueTimeByLocation." + suffix,
+                             entry.queue_time, merged_counts_[i].queue_time);
+    MergeSketchIntoHistogram("TaskScheduler.RunTimeByLocation." + suffix,
+                             entry.run_time, merged_counts_[i].run_time);
+  }
+}
+
+TaskLatencyRecorder::Entry* TaskLatencyRecorder::GetOrCreateEntry(
+    const Location& posted_from) {
+  const subtle::AtomicWord program_counter =
+      reinterpret_cast<subtle::AtomicWord>(posted_from.program_counter());
+  Entry* const overflow_entry = &entries_[kMaxLocations];
+  if (!program_counter)
+    return overflow_entry;
+
+  size_t index = static_cast<size_t>(
+      (static_cast<uint64_t>(program_counter) * UINT64_C(0x9E3779B97F4A7C15)) >>
+      32);
+  for (size_t i = 0; i < kMaxLocations; ++i, ++index) {
+    Entry& entry = entries_[index & (kMaxLocations - 1)];
+    subtle::AtomicWord current = subtle::Acquire_Load(&entry.program_counter);
+    if (!current) {
+      current = subtle::NoBarrier_CompareAndSwap(&entry.program_counter, 0,
+                                                 program_counter);
+      if (!current) {
+        entry.file_name = posted_from.file_name();
+        entry.line_number = posted_from.line_number();
+        subtle::Release_Store(&entry.published, 1);
+        return &entry;
+      }
+    }
+    if (current == program_counter)
+      return &entry;
+  }
+  return overflow_entry;
+}
+
+const TaskLatencyRecorder::Entry* TaskLatencyRecorder::FindEntry(
+    const Location& posted_from) const {
+  const subtle::AtomicWord program_counter =
+      reinterpret_cast<subtle::AtomicWord>(posted_from.program_counter());
+  if (!program_counter)
+    return nullptr;
+  for (size_t i = 0; i < kMaxLocations; ++i) {
+    const Entry& entry = entries_[i];
+    if (subtle::Acquire_Load(&entry.published) &&
+        subtle::NoBarrier_Load(&entry.program_counter) == program_counter) {
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+// static
+std::string TaskLatencyRecorder::GetLocationName(const Entry& entry) {
+  if (!entry.file_name)
+    return "Other";
+  StringPiece file_name(entry.file_name);
+  const size_t last_separator = file_name.find_last_of("/\\");
+  if (last_separator != StringPiece::npos)
+    file_name.remove_prefix(last_separator + 1);
+  return StringPrintf("%.*s:%d", static_cast<int>(file_name.size()),
+                      file_name.data(), entry.line_number);
+}
+
+}  // namespace internal
+}  // namespace base
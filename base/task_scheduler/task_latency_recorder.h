@@ -0,0 +1,145 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_TASK_SCHEDULER_TASK_LATENCY_RECORDER_H_
+#define BASE_TASK_SCHEDULER_TASK_LATENCY_RECORDER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+
+#include "base/atomicops.h"
+#include "base/base_export.h"
+#include "base/location.h"
+#include "base/macros.h"
+#include "base/memory/weak_ptr.h"
+#include "base/metrics/statistics_recorder.h"
+#include "base/strings/string_piece.h"
+#include "base/synchronization/lock.h"
+#include "base/time/time.h"
+#include "base/trace_event/memory_dump_provider.h"
+
+namespace base {
+namespace internal {
+
+// A compact, thread-safe distribution of durations. Durations are counted in
+// log-linear buckets, like in an HDR histogram with 1 bit of sub-bucket
+// precision: bucket boundaries are 0, 1, 2, 3, 4, 6, 8, 12, 16, 24... us, so
+// that the relative error of a reported value is at most 50%, up to ~1 minute.
+// Add() is a relaxed atomic increment.
+class BASE_EXPORT LatencySketch {
+ public:
+  static constexpr int kNumBuckets = 54;
+
+  LatencySketch();
+
+  // Counts |duration|. Negative durations are counted as 0.
+  void Add(TimeDelta duration);
+
+  // Returns the number of durations counted in |bucket|.
+  uint32_t GetCount(int bucket) const {
+    return static_cast<uint32_t>(subtle::NoBarrier_Load(&counts_[bucket]));
+  }
+
+  // Returns the total number of durations counted.
+  uint32_t GetTotalCount() const;
+
+  // Returns the lower bound of the bucket that contains the |percentile|th
+  // percentile (in [0, 100]) of the counted durations, or zero if no duration
+  // was counted.
+  TimeDelta GetPercentile(double percentile) const;
+
+  // Returns the bucket that counts |microseconds|.
+  static int GetBucket(int64_t microseconds);
+
+  // Returns the smallest number of microseconds counted in |bucket|.
+  static int64_t GetBucketMin(int bucket);
+
+ private:
+  subtle::Atomic32 counts_[kNumBuckets];
+
+  DISALLOW_COPY_AND_ASSIGN(LatencySketch);
+};
+
+// Records the queueing time and the run time of tasks per posting Location,
+// for finding which posting sites are starving or slow. Recording doesn't
+// allocate or lock: Locations are keyed by program counter in a fixed-size
+// open-addressing table, and tasks posted from Locations that don't fit in it
+// are recorded under a single overflow entry.
+//
+// The distributions are reported in memory-infra dumps (as
+// "task_scheduler/latency_by_location/<label>/...") and, when
+// StatisticsRecorder::ImportProvidedHistograms() is called (e.g. by
+// chrome://histograms), merged into
+// "TaskScheduler.QueueTimeByLocation.<label>.<file>:<line>" and
+// "TaskScheduler.RunTimeByLocation.<label>.<file>:<line>" histograms, which
+// are not uploaded to UMA.
+class BASE_EXPORT TaskLatencyRecorder
+    : public trace_event::MemoryDumpProvider,
+      public StatisticsRecorder::HistogramProvider {
+ public:
+  // Maximum number of distinct Locations. Must be a power of 2.
+  static constexpr size_t kMaxLocations = 128;
+
+  explicit TaskLatencyRecorder(StringPiece label);
+  ~TaskLatencyRecorder() override;
+
+  // Records that a task posted from |posted_from| waited |queue_time| before
+  // running.
+  void RecordQueueTime(const Location& posted_from, TimeDelta queue_time);
+
+  // Records that a task posted from |posted_from| ran for |run_time|.
+  void RecordRunTime(const Location& posted_from, TimeDelta run_time);
+
+  // Registers with MemoryDumpManager and StatisticsRecorder.
+  void RegisterProviders();
+
+  // Returns the sketches for |posted_from|, or nullptr if no task posted from
+  // there was recorded (or if it was recorded under the overflow entry).
+  const LatencySketch* GetQueueTimeSketchForTesting(
+      const Location& posted_from) const;
+  const LatencySketch* GetRunTimeSketchForTesting(
+      const Location& posted_from) const;
+
+  // trace_event::MemoryDumpProvider:
+  bool OnMemoryDump(const trace_event::MemoryDumpArgs& args,
+                    trace_event::ProcessMemoryDump* pmd) override;
+
+  // StatisticsRecorder::HistogramProvider:
+  void MergeHistogramDeltas() override;
+
+ private:
+  struct Entry;
+
+  // Returns the entry for |posted_from|, claiming one if needed.
+  Entry* GetOrCreateEntry(const Location& posted_from);
+
+  // Returns the published entry for |posted_from|, or nullptr.
+  const Entry* FindEntry(const Location& posted_from) const;
+
+  // Returns a "<file basename>:<line>" description of |entry|'s Location.
+  static std::string GetLocationName(const Entry& entry);
+
+  const std::string label_;
+
+  // |kMaxLocations| entries followed by the overflow entry.
+  const std::unique_ptr<Entry[]> entries_;
+
+  // Counts already merged into histograms by MergeHistogramDeltas(), in the
+  // same layout as |entries_|. Allocated by the first merge.
+  struct MergedCounts;
+  Lock merge_lock_;
+  std::unique_ptr<MergedCounts[]> merged_counts_;
+
+  WeakPtrFactory<TaskLatencyRecorder> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(TaskLatencyRecorder);
+};
+
+}  // namespace internal
+}  // namespace base
+
+#endif  // BASE_TASK_SCHEDULER_TASK_LATENCY_RECORDER_H_
@@ -0,0 +1,208 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/task_scheduler/task_latency_recorder.h"
+
+#include <stdint.h>
+
+#include <memory>
+
+#include "base/bind.h"
+#include "base/bind_helpers.h"
+#include "base/metrics/histogram_base.h"
+#include "base/metrics/histogram_samples.h"
+#include "base/metrics/statistics_recorder.h"
+#include "base/task_scheduler/sequence.h"
+#include "base/task_scheduler/task.h"
+#include "base/task_scheduler/task_tracker.h"
+#include "base/task_scheduler/test_utils.h"
+#include "base/time/time.h"
+#include "base/trace_event/memory_allocator_dump.h"
+#include "base/trace_event/process_memory_dump.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+namespace internal {
+
+namespace {
+
+Location MakeLocation(const char* file_name, int line_number, uintptr_t pc) {
+  return Location("Function", file_name, line_number,
+                  reinterpret_cast<const void*>(pc));
+}
+
+}  // namespace
+
+TEST(TaskSchedulerLatencySketchTest, Buckets) {
+  EXPECT_EQ(0, LatencySketch::GetBucket(0));
+  EXPECT_EQ(1, LatencySketch::GetBucket(1));
+  EXPECT_EQ(2, LatencySketch::GetBucket(2));
+  EXPECT_EQ(3, LatencySketch::GetBucket(3));
+  EXPECT_EQ(4, LatencySketch::GetBucket(4));
+  EXPECT_EQ(4, LatencySketch::GetBucket(5));
+  EXPECT_EQ(5, LatencySketch::GetBucket(6));
+  EXPECT_EQ(5, LatencySketch::GetBucket(7));
+  EXPECT_EQ(6, LatencySketch::GetBucket(8));
+  EXPECT_EQ(LatencySketch::kNumBuckets - 1,
+            LatencySketch::GetBucket(TimeDelta::FromHours(1).InMicroseconds()));
+  EXPECT_EQ(LatencySketch::kNumBuckets - 1,
+            LatencySketch::GetBucket(INT64_MAX));
+
+  // Every bucket starts where the previous one ends.
+  for (int bucket = 0; bucket < LatencySketch::kNumBuckets; ++bucket) {
+    const int64_t min = LatencySketch::GetBucketMin(bucket);
+    EXPECT_EQ(bucket, LatencySketch::GetBucket(min));
+    if (bucket > 0)
+      EXPECT_EQ(bucket - 1, LatencySketch::GetBucket(min - 1));
+  }
+}
+
+TEST(TaskSchedulerLatencySketchTest, Percentiles) {
+  LatencySketch sketch;
+  EXPECT_EQ(0U, sketch.GetTotalCount());
+  EXPECT_EQ(TimeDelta(), sketch.GetPercentile(50));
+
+  for (int i = 0; i < 98; ++i)
+    sketch.Add(TimeDelta::FromMicroseconds(10));
+  sketch.Add(TimeDelta::FromMilliseconds(5));
+  sketch.Add(TimeDelta::FromSeconds(-1));
+
+  EXPECT_EQ(100U, sketch.GetTotalCount());
+  EXPECT_EQ(1U, sketch.GetCount(0));
+  EXPECT_EQ(98U, sketch.GetCount(LatencySketch::GetBucket(10)));
+  EXPECT_EQ(TimeDelta(), sketch.GetPercentile(0));
+  EXPECT_EQ(TimeDelta::FromMicroseconds(8), sketch.GetPercentile(50));
+  EXPECT_EQ(TimeDelta::FromMicroseconds(8), sketch.GetPercentile(99));
+  EXPECT_EQ(TimeDelta::FromMicroseconds(4096), sketch.GetPercentile(100));
+}
+
+TEST(TaskSchedulerTaskLatencyRecorderTest, RecordByLocation) {
+  TaskLatencyRecorder recorder("Test");
+  const Location location_a = MakeLocation("a.cc", 1, 0x1000);
+  const Location location_b = MakeLocation("b.cc", 2, 0x2000);
+
+  EXPECT_FALSE(recorder.GetQueueTimeSketchForTesting(location_a));
+
+  recorder.RecordQueueTime(location_a, TimeDelta::FromMicroseconds(10));
+  recorder.RecordQueueTime(location_a, TimeDelta::FromMicroseconds(20));
+  recorder.RecordRunTime(location_a, TimeDelta::FromMicroseconds(30));
+  recorder.RecordRunTime(location_b, TimeDelta::FromMicroseconds(40));
+
+  ASSERT_TRUE(recorder.GetQueueTimeSketchForTesting(location_a));
+  EXPECT_EQ(2U,
+            recorder.GetQueueTimeSketchForTesting(location_a)->GetTotalCount());
+  EXPECT_EQ(1U,
+            recorder.GetRunTimeSketchForTesting(location_a)->GetTotalCount());
+  ASSERT_TRUE(recorder.GetQueueTimeSketchForTesting(location_b));
+  EXPECT_EQ(0U,
+            recorder.GetQueueTimeSketchForTesting(location_b)->GetTotalCount());
+  EXPECT_EQ(1U,
+            recorder.GetRunTimeSketchForTesting(location_b)->GetTotalCount());
+}
+
+// Verify that Locations that don't fit in the table are recorded under the
+// overflow entry, which is reported as "Other".
+TEST(TaskSchedulerTaskLatencyRecorderTest, Overflow) {
+  auto statistics_recorder = StatisticsRecorder::CreateTemporaryForTesting();
+  TaskLatencyRecorder recorder("Test");
+
+  for (size_t i = 0; i < TaskLatencyRecorder::kMaxLocations; ++i) {
+    recorder.RecordQueueTime(MakeLocation("a.cc", static_cast<int>(i), i + 1),
+                             TimeDelta::FromMicroseconds(1));
+  }
+  const Location extra_location =
+      MakeLocation("extra.cc", 1, TaskLatencyRecorder::kMaxLocations + 1);
+  recorder.RecordQueueTime(extra_location, TimeDelta::FromMicroseconds(1));
+  recorder.RecordQueueTime(Location(), TimeDelta::FromMicroseconds(1));
+
+  EXPECT_FALSE(recorder.GetQueueTimeSketchForTesting(extra_location));
+  for (size_t i = 0; i < TaskLatencyRecorder::kMaxLocations; ++i) {
+    const LatencySketch* sketch = recorder.GetQueueTimeSketchForTesting(
+        MakeLocation("a.cc", static_cast<int>(i), i + 1));
+    ASSERT_TRUE(sketch);
+    EXPECT_EQ(1U, sketch->GetTotalCount());
+  }
+
+  recorder.MergeHistogramDeltas();
+  HistogramBase* histogram = StatisticsRecorder::FindHistogram(
+      "TaskScheduler.QueueTimeByLocation.Test.Other");
+  ASSERT_TRUE(histogram);
+  EXPECT_EQ(2, histogram->SnapshotSamples()->TotalCount());
+}
+
+// Verify that MergeHistogramDeltas() only adds counts recorded since the
+// previous merge.
+TEST(TaskSchedulerTaskLatencyRecorderTest, MergeHistogramDeltas) {
+  auto statistics_recorder = StatisticsRecorder::CreateTemporaryForTesting();
+  TaskLatencyRecorder recorder("Test");
+  const Location location = MakeLocation("dir/foo.cc", 12, 0x1000);
+  constexpr char kQueueTimeHistogram[] =
+      "TaskScheduler.QueueTimeByLocation.Test.foo.cc:12";
+  constexpr char kRunTimeHistogram[] =
+      "TaskScheduler.RunTimeByLocation.Test.foo.cc:12";
+
+  recorder.RecordQueueTime(location, TimeDelta::FromMilliseconds(1));
+  recorder.MergeHistogramDeltas();
+  HistogramBase* queue_time_histogram =
+      StatisticsRecorder::FindHistogram(kQueueTimeHistogram);
+  ASSERT_TRUE(queue_time_histogram);
+  EXPECT_EQ(1, queue_time_histogram->SnapshotSamples()->TotalCount());
+  // Histograms without samples aren't created.
+  EXPECT_FALSE(StatisticsRecorder::FindHistogram(kRunTimeHistogram));
+
+  recorder.RecordQueueTime(location, TimeDelta::FromMilliseconds(1));
+  recorder.RecordRunTime(location, TimeDelta::FromMilliseconds(2));
+  recorder.MergeHistogramDeltas();
+  recorder.MergeHistogramDeltas();
+  EXPECT_EQ(2, queue_time_histogram->SnapshotSamples()->TotalCount());
+  HistogramBase* run_time_histogram =
+      StatisticsRecorder::FindHistogram(kRunTimeHistogram);
+  ASSERT_TRUE(run_time_histogram);
+  EXPECT_EQ(1, run_time_histogram->SnapshotSamples()->TotalCount());
+}
+
+TEST(TaskSchedulerTaskLatencyRecorderTest, OnMemoryDump) {
+  TaskLatencyRecorder recorder("Test");
+  recorder.RecordQueueTime(MakeLocation("foo.cc", 12, 0x1000),
+                           TimeDelta::FromMicroseconds(10));
+
+  trace_event::MemoryDumpArgs background_args = {
+      trace_event::MemoryDumpLevelOfDetail::BACKGROUND};
+  trace_event::ProcessMemoryDump background_pmd(background_args);
+  EXPECT_TRUE(recorder.OnMemoryDump(background_args, &background_pmd));
+  EXPECT_TRUE(background_pmd.GetAllocatorDump(
+      "task_scheduler/latency_by_location/Test"));
+  EXPECT_EQ(1U, background_pmd.allocator_dumps().size());
+
+  trace_event::MemoryDumpArgs detailed_args = {
+      trace_event::MemoryDumpLevelOfDetail::DETAILED};
+  trace_event::ProcessMemoryDump detailed_pmd(detailed_args);
+  EXPECT_TRUE(recorder.OnMemoryDump(detailed_args, &detailed_pmd));
+  EXPECT_EQ(2U, detailed_pmd.allocator_dumps().size());
+}
+
+TEST(TaskSchedulerTaskLatencyRecorderTest, TaskTrackerRecordsByLocation) {
+  TaskTracker tracker("Test");
+  EXPECT_FALSE(tracker.latency_recorder_for_testing());
+  tracker.EnableLatencyByLocationRecording();
+  const TaskLatencyRecorder* recorder = tracker.latency_recorder_for_testing();
+  ASSERT_TRUE(recorder);
+
+  const Location location = MakeLocation("foo.cc", 12, 0x1000);
+  Task task(location, DoNothing(), TaskTraits(), TimeDelta());
+  EXPECT_TRUE(tracker.WillPostTask(task));
+  scoped_refptr<Sequence> sequence =
+      test::CreateSequenceWithTask(std::move(task));
+  EXPECT_EQ(sequence, tracker.WillScheduleSequence(sequence, nullptr));
+  EXPECT_FALSE(tracker.RunAndPopNextTask(std::move(sequence), nullptr));
+
+  ASSERT_TRUE(recorder->GetQueueTimeSketchForTesting(location));
+  EXPECT_EQ(1U, recorder->GetQueueTimeSketchForTesting(location)
+                    ->GetTotalCount());
+  EXPECT_EQ(1U,
+            recorder->GetRunTimeSketchForTesting(location)->GetTotalCount());
+}
+
+}  // namespace internal
+}  // namespace base
@@ -17,11 +17,13 @@
 #include "base/sequence_token.h"
 #include "base/synchronization/condition_variable.h"
 #include "base/task_scheduler/scoped_set_task_priority_for_current_thread.h"
+#include "base/task_scheduler/task_latency_recorder.h"
 #include "base/threading/sequence_local_storage_map.h"
 #include "base/threading/sequenced_task_runner_handle.h"
 #include "base/threading/thread_restrictions.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "base/time/time.h"
+#include "base/trace_event/memory_dump_manager.h"
 #include "base/trace_event/trace_event.h"
 #include "base/values.h"
 
@@ -124,6 +126,14 @@ int GetMaxNumScheduledBackgroundSequences() {
   return std::numeric_limits<int>::max();
 }
 
+// Returns true if latencies should be recorded per posting Location based on
+// command line flags.
+bool ShouldRecordLatencyByLocation() {
+  return CommandLine::InitializedForCurrentProcess() &&
+         CommandLine::ForCurrentProcess()->HasSwitch(
+             switches::kEnableTaskLatencyByLocation);
+}
+
 }  // namespace
 
 // Atomic internal state used by TaskTracker. Sequential consistency shouldn't
@@ -255,6 +265,7 @@ TaskTracker::TaskTracker(StringPiece histogram_label,
       shutdown_lock_(&flush_lock_),
       max_num_scheduled_background_sequences_(
           max_num_scheduled_background_sequences),
+      histogram_label_(histogram_label.as_string()),
       task_latency_histograms_{
           {GetLatencyHistogram("TaskLatencyMicroseconds",
                                histogram_label,
@@ -298,9 +309,19 @@ TaskTracker::TaskTracker(StringPiece histogram_label,
   DCHECK(*(&task_latency_histograms_[static_cast<int>(TaskPriority::HIGHEST) +
                                      1][0] -
            1));
+
+  if (ShouldRecordLatencyByLocation())
+    EnableLatencyByLocationRecording();
 }
 
-TaskTracker::~TaskTracker() = default;
+TaskTracker::~TaskTracker() {
+  // The recorder is a MemoryDumpProvider, which can't be deleted while a dump
+  // may be in progress.
+  if (latency_recorder_) {
+    trace_event::MemoryDumpManager::GetInstance()
+        ->UnregisterAndDeleteDumpProviderSoon(std::move(latency_recorder_));
+  }
+}
 
 void TaskTracker::Shutdown() {
   PerformShutdown();
@@ -444,6 +465,12 @@ void TaskTracker::SetHasShutdownStartedForTesting() {
   state_->StartShutdown();
 }
 
+void TaskTracker::EnableLatencyByLocationRecording() {
+  DCHECK(!latency_recorder_);
+  latency_recorder_ = std::make_unique<TaskLatencyRecorder>(histogram_label_);
+  latency_recorder_->RegisterProviders();
+}
+
 void TaskTracker::RecordLatencyHistogram(
     LatencyHistogramType latency_histogram_type,
     TaskTraits task_traits,
@@ -468,6 +495,10 @@ void TaskTracker::RunOrSkipTask(Task task,
                                 bool can_run_task) {
   RecordLatencyHistogram(LatencyHistogramType::TASK_LATENCY, task.traits,
                          task.sequenced_time);
+  if (latency_recorder_) {
+    latency_recorder_->RecordQueueTime(task.posted_from,
+                                       TimeTicks::Now() - task.sequenced_time);
+  }
 
   const bool previous_singleton_allowed =
       ThreadRestrictions::SetSingletonAllowed(
@@ -526,7 +557,14 @@ void TaskTracker::RunOrSkipTask(Task task,
             TRACE_EVENT_FLAG_FLOW_IN);
       }
 
-      task_annotator_.RunTask(nullptr, &task);
+      if (latency_recorder_) {
+        const TimeTicks start_time = TimeTicks::Now();
+        task_annotator_.RunTask(nullptr, &task);
+        latency_recorder_->RecordRunTime(task.posted_from,
+                                         TimeTicks::Now() - start_time);
+      } else {
+        task_annotator_.RunTask(nullptr, &task);
+      }
     }
 
     // Make sure the arguments bound to the callback are deleted within the
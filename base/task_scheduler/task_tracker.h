@@ -7,6 +7,7 @@
 
 #include <functional>
 #include <memory>
+#include <string>
 #include <queue>
 
 #include "base/atomicops.h"
@@ -32,6 +33,8 @@ class HistogramBase;
 
 namespace internal {
 
+class TaskLatencyRecorder;
+
 // TaskTracker enforces policies that determines whether:
 // - A task can be added to a sequence (WillPostTask).
 // - A sequence can be scheduled (WillScheduleSequence).
@@ -96,7 +99,9 @@ class BASE_EXPORT TaskTracker {
   // The first constructor sets the maximum number of TaskPriority::BACKGROUND
   // sequences that can be scheduled concurrently to 0 if the
   // --disable-background-tasks flag is specified, max() otherwise. The second
-  // constructor sets it to |max_num_scheduled_background_sequences|.
+  // constructor sets it to |max_num_scheduled_background_sequences|. Both
+  // call EnableLatencyByLocationRecording() if the
+  // --enable-task-latency-by-location flag is specified.
   TaskTracker(StringPiece histogram_label);
   TaskTracker(StringPiece histogram_label,
               int max_num_scheduled_background_sequences);
@@ -186,6 +191,18 @@ class BASE_EXPORT TaskTracker {
                               TaskTraits task_traits,
                               TimeTicks posted_time) const;
 
+  // Starts recording the queueing time and the run time of tasks per posting
+  // Location, and reporting them in memory dumps and histograms (see
+  // TaskLatencyRecorder). Must be called before any task is posted. Cheap
+  // enough to be enabled in production: recording doesn't lock or allocate.
+  void EnableLatencyByLocationRecording();
+
+  // Returns the recorder enabled by EnableLatencyByLocationRecording(), or
+  // nullptr.
+  const TaskLatencyRecorder* latency_recorder_for_testing() const {
+    return latency_recorder_.get();
+  }
+
   TrackedRef<TaskTracker> GetTrackedRef() {
     return tracked_ref_factory_.GetTrackedRef();
   }
@@ -344,9 +361,16 @@ class BASE_EXPORT TaskTracker {
   // these.
   static constexpr int kNumTaskPriorities =
       static_cast<int>(TaskPriority::HIGHEST) + 1;
+  // Suffix of histograms recorded by this TaskTracker.
+  const std::string histogram_label_;
+
   HistogramBase* const task_latency_histograms_[kNumTaskPriorities][2];
   HistogramBase* const heartbeat_latency_histograms_[kNumTaskPriorities][2];
 
+  // Records latencies per posting Location, if enabled. Handed to
+  // MemoryDumpManager for deletion when the TaskTracker is destroyed.
+  std::unique_ptr<TaskLatencyRecorder> latency_recorder_;
+
   // Number of BLOCK_SHUTDOWN tasks posted during shutdown.
   HistogramBase::Sample num_block_shutdown_tasks_posted_during_shutdown_ = 0;
 
@@ -0,0 +1,401 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/test/perf_benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+
+#include "base/allocator/buildflags.h"
+#include "base/command_line.h"
+#include "base/debug/thread_heap_usage_tracker.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/json/json_writer.h"
+#include "base/logging.h"
+#include "base/values.h"
+#include "build/build_config.h"
+#include "testing/perf/perf_test.h"
+
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+#include <linux/perf_event.h>
+#include <sched.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "base/files/scoped_file.h"
+#include "base/posix/eintr_wrapper.h"
+#endif
+
+namespace base {
+
+namespace {
+
+const char kCountAllocationsSwitch[] = "perf-count-allocations";
+const char kJSONOutputSwitch[] = "perf-benchmark-json";
+
+enum class HardwareEvent { kInstructions, kCacheMisses };
+
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+
+// Counts a hardware event on the current thread, in user space, if the kernel
+// allows it.
+class HardwareCounter {
+ public:
+  explicit HardwareCounter(HardwareEvent event) {
+    perf_event_attr attributes = {};
+    attributes.type = PERF_TYPE_HARDWARE;
+    attributes.size = sizeof(attributes);
+    attributes.config = event == HardwareEvent::kInstructions
+                            ? PERF_COUNT_HW_INSTRUCTIONS
+                            : PERF_COUNT_HW_CACHE_MISSES;
+    attributes.disabled = 1;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    fd_.reset(syscall(__NR_perf_event_open, &attributes, 0, -1, -1, 0));
+  }
+
+  void Start() {
+    if (!fd_.is_valid())
+      return;
+    ioctl(fd_.get(), PERF_EVENT_IOC_RESET, 0);
+    ioctl(fd_.get(), PERF_EVENT_IOC_ENABLE, 0);
+  }
+
+  Optional<uint64_t> Stop() {
+    if (!fd_.is_valid())
+      return nullopt;
+    ioctl(fd_.get(), PERF_EVENT_IOC_DISABLE, 0);
+    uint64_t count;
+    if (HANDLE_EINTR(read(fd_.get(), &count, sizeof(count))) != sizeof(count))
+      return nullopt;
+    return count;
+  }
+
+ private:
+  ScopedFD fd_;
+
+  DISALLOW_COPY_AND_ASSIGN(HardwareCounter);
+};
+
+// Keeps the current thread on the CPU on which it runs.
+class ScopedPinToCurrentCPU {
+ public:
+  ScopedPinToCurrentCPU() {
+    if (sched_getaffinity(0, sizeof(previous_cpus_), &previous_cpus_))
+      return;
+    const int cpu = sched_getcpu();
+    if (cpu < 0)
+      return;
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(cpu, &cpus);
+    pinned_ = !sched_setaffinity(0, sizeof(cpus), &cpus);
+  }
+
+  ~ScopedPinToCurrentCPU() {
+    if (pinned_)
+      sched_setaffinity(0, sizeof(previous_cpus_), &previous_cpus_);
+  }
+
+ private:
+  cpu_set_t previous_cpus_;
+  bool pinned_ = false;
+
+  DISALLOW_COPY_AND_ASSIGN(ScopedPinToCurrentCPU);
+};
+
+#else
+
+class HardwareCounter {
+ public:
+  explicit HardwareCounter(HardwareEvent event) {}
+  void Start() {}
+  Optional<uint64_t> Stop() { return nullopt; }
+};
+
+class ScopedPinToCurrentCPU {
+ public:
+  ScopedPinToCurrentCPU() {}
+  ~ScopedPinToCurrentCPU() {}
+};
+
+#endif  // defined(OS_LINUX) || defined(OS_ANDROID)
+
+// Counts heap allocations on the current thread, if heap tracking is enabled.
+class AllocationCounter {
+ public:
+  AllocationCounter() {
+#if BUILDFLAG(USE_ALLOCATOR_SHIM)
+    if (!debug::ThreadHeapUsageTracker::IsHeapTrackingEnabled() &&
+        CommandLine::ForCurrentProcess()->HasSwitch(kCountAllocationsSwitch)) {
+      debug::ThreadHeapUsageTracker::EnableHeapTracking();
+    }
+#endif
+    if (debug::ThreadHeapUsageTracker::IsHeapTrackingEnabled())
+      tracker_ = std::make_unique<debug::ThreadHeapUsageTracker>();
+  }
+
+  void Start() {
+    if (tracker_)
+      tracker_->Start();
+  }
+
+  // Stops counting, and returns false if allocations weren't counted.
+  bool Stop(uint64_t* allocations, uint64_t* allocated_bytes) {
+    if (!tracker_)
+      return false;
+    tracker_->Stop(true);
+    *allocations = tracker_->usage().alloc_ops;
+    *allocated_bytes = tracker_->usage().alloc_bytes;
+    return true;
+  }
+
+ private:
+  std::unique_ptr<debug::ThreadHeapUsageTracker> tracker_;
+
+  DISALLOW_COPY_AND_ASSIGN(AllocationCounter);
+};
+
+// Returns the value at |fraction| of the sorted |samples|, interpolating
+// between samples.
+double GetQuantile(const std::vector<double>& samples, double fraction) {
+  const double position = fraction * (samples.size() - 1);
+  const size_t index = static_cast<size_t>(position);
+  if (index + 1 >= samples.size())
+    return samples.back();
+  return samples[index] +
+         (samples[index + 1] - samples[index]) * (position - index);
+}
+
+double InUnit(double nanoseconds, PerfBenchmark::TimeUnit unit) {
+  switch (unit) {
+    case PerfBenchmark::TimeUnit::kNanoseconds:
+      return nanoseconds;
+    case PerfBenchmark::TimeUnit::kMicroseconds:
+      return nanoseconds / Time::kNanosecondsPerMicrosecond;
+    case PerfBenchmark::TimeUnit::kMilliseconds:
+      return nanoseconds / (Time::kNanosecondsPerMicrosecond *
+                            Time::kMicrosecondsPerMillisecond);
+  }
+  NOTREACHED();
+  return nanoseconds;
+}
+
+const char* GetUnitName(PerfBenchmark::TimeUnit unit) {
+  switch (unit) {
+    case PerfBenchmark::TimeUnit::kNanoseconds:
+      return "ns/op";
+    case PerfBenchmark::TimeUnit::kMicroseconds:
+      return "us/op";
+    case PerfBenchmark::TimeUnit::kMilliseconds:
+      return "ms/op";
+  }
+  NOTREACHED();
+  return "";
+}
+
+}  // namespace
+
+PerfBenchmark::Result::Result() = default;
+
+PerfBenchmark::Result::Result(const Result& other) = default;
+
+PerfBenchmark::Result::~Result() = default;
+
+PerfBenchmark::Result& PerfBenchmark::Result::operator=(const Result& other) =
+    default;
+
+PerfBenchmark::PerfBenchmark(const std::string& metric,
+                             const std::string& trace)
+    : PerfBenchmark(metric, trace, Options()) {}
+
+PerfBenchmark::PerfBenchmark(const std::string& metric,
+                             const std::string& trace,
+                             const Options& options)
+    : metric_(metric), trace_(trace), options_(options) {
+  DCHECK_GT(options_.repetitions, 0);
+  DCHECK_GT(options_.operations_per_run, 0);
+}
+
+PerfBenchmark::~PerfBenchmark() = default;
+
+// static
+PerfBenchmark::Result PerfBenchmark::SummarizeSamples(
+    std::vector<double> samples) {
+  DCHECK(!samples.empty());
+  std::sort(samples.begin(), samples.end());
+  const double first_quartile = GetQuantile(samples, 0.25);
+  const double third_quartile = GetQuantile(samples, 0.75);
+  const double fence = 1.5 * (third_quartile - first_quartile);
+  const auto begin = std::lower_bound(samples.begin(), samples.end(),
+                                      first_quartile - fence);
+  const auto end =
+      std::upper_bound(begin, samples.end(), third_quartile + fence);
+  const std::vector<double> kept(begin, end);
+
+  Result result;
+  result.repetitions = static_cast<int>(kept.size());
+  result.rejected_outliers = static_cast<int>(samples.size() - kept.size());
+  result.median = GetQuantile(kept, 0.5);
+  result.min = kept.front();
+  result.max = kept.back();
+  double sum = 0;
+  for (double sample : kept)
+    sum += sample;
+  result.mean = sum / kept.size();
+  if (kept.size() > 1) {
+    double sum_of_squares = 0;
+    for (double sample : kept)
+      sum_of_squares += (sample - result.mean) * (sample - result.mean);
+    result.standard_deviation = std::sqrt(sum_of_squares / (kept.size() - 1));
+  }
+  return result;
+}
+
+PerfBenchmark::Result PerfBenchmark::RunAndReport(
+    const RepeatingCallback<void(uint64_t)>& run) {
+  ScopedPinToCurrentCPU pin_to_current_cpu;
+
+  // Warm up while finding how many runs take |min_repetition_time|.
+  uint64_t runs = 1;
+  const TimeTicks warmup_start = TimeTicks::Now();
+  while (true) {
+    const TimeTicks start = TimeTicks::Now();
+    run.Run(runs);
+    const TimeTicks end = TimeTicks::Now();
+    const TimeDelta elapsed = end - start;
+    if (elapsed < options_.min_repetition_time) {
+      // Aim a little above the minimum, growing at least twofold.
+      const double scale =
+          elapsed.is_zero() ? 10
+                            : 1.2 * options_.min_repetition_time.InSecondsF() /
+                                  elapsed.InSecondsF();
+      runs = static_cast<uint64_t>(runs * std::min(std::max(scale, 2.0), 10.0));
+      continue;
+    }
+    if (end - warmup_start >= options_.warmup_time)
+      break;
+  }
+
+  HardwareCounter instructions(HardwareEvent::kInstructions);
+  HardwareCounter cache_misses(HardwareEvent::kCacheMisses);
+  AllocationCounter allocations;
+  std::vector<double> samples;
+  instructions.Start();
+  cache_misses.Start();
+  allocations.Start();
+  for (int i = 0; i < options_.repetitions; ++i) {
+    const TimeTicks start = TimeTicks::Now();
+    run.Run(runs);
+    samples.push_back((TimeTicks::Now() - start).InNanoseconds() /
+                      (runs * options_.operations_per_run));
+  }
+  uint64_t allocation_count = 0;
+  uint64_t allocated_bytes = 0;
+  const bool counted_allocations =
+      allocations.Stop(&allocation_count, &allocated_bytes);
+  const Optional<uint64_t> cache_miss_count = cache_misses.Stop();
+  const Optional<uint64_t> instruction_count = instructions.Stop();
+
+  Result result = SummarizeSamples(std::move(samples));
+  result.runs_per_repetition = runs;
+  const double operations =
+      options_.repetitions * runs * options_.operations_per_run;
+  if (instruction_count)
+    result.instructions = *instruction_count / operations;
+  if (cache_miss_count)
+    result.cache_misses = *cache_miss_count / operations;
+  if (counted_allocations) {
+    result.allocations = allocation_count / operations;
+    result.allocated_bytes = allocated_bytes / operations;
+  }
+  Report(result);
+  return result;
+}
+
+PerfBenchmark::Result PerfBenchmark::RunMeasuredAndReport(
+    const RepeatingCallback<TimeDelta()>& measure) {
+  measure.Run();
+  std::vector<double> samples;
+  for (int i = 0; i < options_.repetitions; ++i) {
+    samples.push_back(measure.Run().InNanoseconds() /
+                      options_.operations_per_run);
+  }
+  Result result = SummarizeSamples(std::move(samples));
+  result.runs_per_repetition = 1;
+  Report(result);
+  return result;
+}
+
+void PerfBenchmark::Report(const Result& result) const {
+  const std::string unit = GetUnitName(options_.time_unit);
+  perf_test::PrintResult(metric_, "", trace_,
+                         InUnit(result.median, options_.time_unit), unit,
+                         true);
+  perf_test::PrintResultMeanAndError(
+      metric_, "_mean", trace_,
+      std::to_string(InUnit(result.mean, options_.time_unit)) + "," +
+          std::to_string(InUnit(result.standard_deviation, options_.time_unit)),
+      unit, false);
+  perf_test::PrintResult(metric_, "_rejected_outliers", trace_,
+                         static_cast<size_t>(result.rejected_outliers),
+                         "repetitions", false);
+  if (options_.bytes_per_operation) {
+    perf_test::PrintResult(
+        metric_, "_throughput", trace_,
+        options_.bytes_per_operation * 1000.0 / result.median, "MB/s", true);
+  }
+  if (result.instructions) {
+    perf_test::PrintResult(metric_, "_instructions", trace_,
+                           *result.instructions, "instructions/op", false);
+  }
+  if (result.cache_misses) {
+    perf_test::PrintResult(metric_, "_cache_misses", trace_,
+                           *result.cache_misses, "misses/op", false);
+  }
+  if (result.allocations) {
+    perf_test::PrintResult(metric_, "_allocations", trace_,
+                           *result.allocations, "allocations/op", false);
+    perf_test::PrintResult(metric_, "_allocated_bytes", trace_,
+                           *result.allocated_bytes, "bytes/op", false);
+  }
+
+  const FilePath json_path =
+      CommandLine::ForCurrentProcess()->GetSwitchValuePath(kJSONOutputSwitch);
+  if (json_path.empty())
+    return;
+  DictionaryValue json;
+  json.SetString("metric", metric_);
+  json.SetString("trace", trace_);
+  json.SetString("unit", "ns/op");
+  json.SetDouble("median", result.median);
+  json.SetDouble("mean", result.mean);
+  json.SetDouble("standard_deviation", result.standard_deviation);
+  json.SetDouble("min", result.min);
+  json.SetDouble("max", result.max);
+  json.SetInteger("repetitions", result.repetitions);
+  json.SetInteger("rejected_outliers", result.rejected_outliers);
+  json.SetDouble("runs_per_repetition", result.runs_per_repetition);
+  if (result.instructions)
+    json.SetDouble("instructions", *result.instructions);
+  if (result.cache_misses)
+    json.SetDouble("cache_misses", *result.cache_misses);
+  if (result.allocations) {
+    json.SetDouble("allocations", *result.allocations);
+    json.SetDouble("allocated_bytes", *result.allocated_bytes);
+  }
+  std::string line;
+  JSONWriter::Write(json, &line);
+  line += '\n';
+  if (!PathExists(json_path))
+    WriteFile(json_path, "", 0);
+  if (!AppendToFile(json_path, line.data(), static_cast<int>(line.size())))
+    LOG(ERROR) << "Could not write to " << json_path.value();
+}
+
+}  // namespace base
@@ -0,0 +1,143 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_TEST_PERF_BENCHMARK_H_
+#define BASE_TEST_PERF_BENCHMARK_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/callback.h"
+#include "base/macros.h"
+#include "base/optional.h"
+#include "base/time/time.h"
+
+namespace base {
+
+// PerfBenchmark measures the time per operation of a piece of code, with
+// enough care that results can be compared between builds:
+//  * The code is run for a while before it is measured, to warm up caches,
+//    branch predictors and CPU frequency.
+//  * Each repetition runs the code enough times to take a minimum time, so
+//    that timer resolution doesn't matter.
+//  * The time per operation is measured over several repetitions, and
+//    repetitions far from the others (e.g. hit by a context switch) are
+//    rejected before the median, mean and standard deviation are computed.
+//  * The thread is pinned to its CPU while measuring, where supported.
+//  * On Linux and Android, the instructions and cache misses per operation
+//    are counted with perf_event, where the kernel allows it.
+//  * With --perf-count-allocations, in builds with the allocator shim, heap
+//    allocations on the measuring thread are counted.
+//
+// The median is reported with perf_test::PrintResult(), and the other
+// results as unimportant values. With --perf-benchmark-json=<file>, each
+// result is also appended to <file> as a line of JSON.
+//
+// Example:
+//   PerfBenchmark("Hash", "4096_bytes").Run([&] { result += Hash(input); });
+class PerfBenchmark {
+ public:
+  enum class TimeUnit { kNanoseconds, kMicroseconds, kMilliseconds };
+
+  struct Options {
+    // Time spent running the code before measuring it.
+    TimeDelta warmup_time = TimeDelta::FromMilliseconds(100);
+    // Minimum time of each repetition.
+    TimeDelta min_repetition_time = TimeDelta::FromMilliseconds(10);
+    int repetitions = 20;
+    // The unit in which times are reported.
+    TimeUnit time_unit = TimeUnit::kNanoseconds;
+    // The number of operations done by each run of the code.
+    double operations_per_run = 1;
+    // If non-zero, the number of bytes processed by each operation, to also
+    // report the throughput.
+    size_t bytes_per_operation = 0;
+  };
+
+  struct Result {
+    Result();
+    Result(const Result& other);
+    ~Result();
+
+    Result& operator=(const Result& other);
+
+    // Times per operation, in nanoseconds, over the repetitions kept.
+    double median = 0;
+    double mean = 0;
+    double standard_deviation = 0;
+    double min = 0;
+    double max = 0;
+    int repetitions = 0;
+    int rejected_outliers = 0;
+    uint64_t runs_per_repetition = 0;
+
+    // Counts per operation, when available.
+    Optional<double> instructions;
+    Optional<double> cache_misses;
+    Optional<double> allocations;
+    Optional<double> allocated_bytes;
+  };
+
+  // |metric| and |trace| are used as in perf_test::PrintResult().
+  PerfBenchmark(const std::string& metric, const std::string& trace);
+  PerfBenchmark(const std::string& metric,
+                const std::string& trace,
+                const Options& options);
+  ~PerfBenchmark();
+
+  // Measures |function|, which does |options.operations_per_run| operations
+  // each time it is called, reports the result and returns it.
+  template <typename Function>
+  Result Run(Function function) {
+    return RunAndReport(
+        BindRepeating(&RunRepeatedly<Function>, Unretained(&function)));
+  }
+
+  // Like Run(), for code that measures itself, e.g. because it runs on
+  // several threads: |measure| is called once per repetition after a warmup
+  // call, and returns the time taken by |options.operations_per_run|
+  // operations. Only times are reported.
+  template <typename Function>
+  Result RunMeasured(Function measure) {
+    return RunMeasuredAndReport(
+        BindRepeating(&Measure<Function>, Unretained(&measure)));
+  }
+
+  // Returns the statistics of |samples|, times per operation in nanoseconds,
+  // after rejecting the samples outside of Tukey's fences: more than 1.5
+  // times the interquartile range below the first or above the third
+  // quartile. |samples| may not be empty.
+  static Result SummarizeSamples(std::vector<double> samples);
+
+ private:
+  template <typename Function>
+  static void RunRepeatedly(Function* function, uint64_t runs) {
+    for (uint64_t i = 0; i < runs; ++i)
+      (*function)();
+  }
+
+  template <typename Function>
+  static TimeDelta Measure(Function* measure) {
+    return (*measure)();
+  }
+
+  Result RunAndReport(const RepeatingCallback<void(uint64_t)>& run);
+  Result RunMeasuredAndReport(const RepeatingCallback<TimeDelta()>& measure);
+
+  void Report(const Result& result) const;
+
+  const std::string metric_;
+  const std::string trace_;
+  const Options options_;
+
+  DISALLOW_COPY_AND_ASSIGN(PerfBenchmark);
+};
+
+}  // namespace base
+
+#endif  // BASE_TEST_PERF_BENCHMARK_H_
@@ -0,0 +1,73 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/test/perf_benchmark.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+TEST(PerfBenchmarkTest, SummarizeSamples) {
+  PerfBenchmark::Result result =
+      PerfBenchmark::SummarizeSamples({12, 10, 11, 10, 13});
+  EXPECT_EQ(5, result.repetitions);
+  EXPECT_EQ(0, result.rejected_outliers);
+  EXPECT_DOUBLE_EQ(11, result.median);
+  EXPECT_DOUBLE_EQ(11.2, result.mean);
+  EXPECT_DOUBLE_EQ(10, result.min);
+  EXPECT_DOUBLE_EQ(13, result.max);
+  EXPECT_NEAR(1.30384, result.standard_deviation, 1e-5);
+
+  result = PerfBenchmark::SummarizeSamples({42});
+  EXPECT_EQ(1, result.repetitions);
+  EXPECT_DOUBLE_EQ(42, result.median);
+  EXPECT_DOUBLE_EQ(0, result.standard_deviation);
+}
+
+TEST(PerfBenchmarkTest, SummarizeSamplesRejectsOutliers) {
+  // A repetition slowed down by a context switch, and one too fast to be
+  // true.
+  PerfBenchmark::Result result = PerfBenchmark::SummarizeSamples(
+      {10, 11, 10, 12, 1000, 11, 10, 12, 1, 11});
+  EXPECT_EQ(8, result.repetitions);
+  EXPECT_EQ(2, result.rejected_outliers);
+  EXPECT_DOUBLE_EQ(11, result.median);
+  EXPECT_DOUBLE_EQ(10, result.min);
+  EXPECT_DOUBLE_EQ(12, result.max);
+}
+
+TEST(PerfBenchmarkTest, Run) {
+  PerfBenchmark::Options options;
+  options.warmup_time = TimeDelta();
+  options.min_repetition_time = TimeDelta::FromMilliseconds(1);
+  options.repetitions = 3;
+  options.operations_per_run = 2;
+  int runs = 0;
+  PerfBenchmark::Result result =
+      PerfBenchmark("PerfBenchmarkTest", "Run", options).Run([&runs] {
+        ++runs;
+      });
+  EXPECT_EQ(3, result.repetitions + result.rejected_outliers);
+  EXPECT_GE(static_cast<uint64_t>(runs), 3 * result.runs_per_repetition);
+  EXPECT_GE(result.median, 0);
+}
+
+TEST(PerfBenchmarkTest, RunMeasured) {
+  PerfBenchmark::Options options;
+  options.repetitions = 4;
+  options.operations_per_run = 10;
+  int measurements = 0;
+  PerfBenchmark::Result result =
+      PerfBenchmark("PerfBenchmarkTest", "RunMeasured", options)
+          .RunMeasured([&measurements] {
+            ++measurements;
+            return TimeDelta::FromMicroseconds(1);
+          });
+  // One warmup measurement, and one per repetition.
+  EXPECT_EQ(5, measurements);
+  EXPECT_EQ(4, result.repetitions);
+  EXPECT_DOUBLE_EQ(100, result.median);
+}
+
+}  // namespace base
@@ -30,12 +30,19 @@ namespace base {
 
 class SamplingHeapProfiler;
 
+namespace allocator {
+namespace internal {
+class ThreadCacheAllocator;
+}  // namespace internal
+}  // namespace allocator
+
 namespace trace_event {
 class MallocDumpProvider;
 }  // namespace trace_event
 
 namespace internal {
 
+class SmallBlockCache;
 class ThreadLocalStorageTestInternal;
 
 // WARNING: You should *NOT* use this class directly.
@@ -158,6 +165,8 @@ class BASE_EXPORT ThreadLocalStorage {
   // disallowed and will hit a DCHECK. Any code that relies on TLS during thread
   // destruction must first check this method before calling Slot::Get().
   friend class base::SamplingHeapProfiler;
+  friend class base::allocator::internal::ThreadCacheAllocator;
+  friend class base::internal::SmallBlockCache;
   friend class base::internal::ThreadLocalStorageTestInternal;
   friend class base::trace_event::MallocDumpProvider;
   friend class heap_profiling::ScopedAllowAlloc;
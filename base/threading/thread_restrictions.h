@@ -14,6 +14,7 @@ class BrowserProcessImpl;
 class HistogramSynchronizer;
 class NativeBackendKWallet;
 class KeyStorageLinux;
+class SkBitmapOperations;
 
 namespace android_webview {
 class AwFormDatabaseService;
@@ -24,6 +25,7 @@ class ScopedAllowInitGLBindings;
 namespace cc {
 class CompletionEvent;
 class SingleThreadTaskGraphRunner;
+class WorkStealingTaskGraphRunner;
 }
 namespace chromeos {
 class BlockingMethodCaller;
@@ -68,6 +70,9 @@ class InFlightIO;
 namespace functions {
 class ExecScriptScopedAllowBaseSyncPrimitives;
 }
+namespace gfx {
+class ParallelPngEncoder;
+}
 namespace gpu {
 class GpuChannelHost;
 }
@@ -321,9 +326,11 @@ class BASE_EXPORT ScopedAllowBaseSyncPrimitivesOutsideBlockingScope {
       ThreadRestrictionsTest,
       ScopedAllowBaseSyncPrimitivesOutsideBlockingScopeResetsState);
   friend class ::KeyStorageLinux;
+  friend class ::SkBitmapOperations;
   friend class content::SynchronousCompositor;
   friend class content::SynchronousCompositorHost;
   friend class content::SynchronousCompositorSyncCallBridge;
+  friend class gfx::ParallelPngEncoder;
   friend class midi::TaskService;  // https://crbug.com/796830
   // Not used in production yet, https://crbug.com/844078.
   friend class service_manager::ServiceProcessLauncher;
@@ -434,6 +441,7 @@ class BASE_EXPORT ThreadRestrictions {
   friend class internal::TaskTracker;
   friend class cc::CompletionEvent;
   friend class cc::SingleThreadTaskGraphRunner;
+  friend class cc::WorkStealingTaskGraphRunner;
   friend class content::CategorizedWorkerPool;
   friend class remoting::AutoThread;
   friend class ui::WindowResizeHelperMac;
@@ -5,6 +5,7 @@
 #include "base/trace_event/blame_context.h"
 
 #include "base/strings/stringprintf.h"
+#include "base/trace_event/heap_profiler_allocation_context_tracker.h"
 #include "base/trace_event/trace_event.h"
 #include "base/trace_event/trace_event_argument.h"
 
@@ -45,6 +46,19 @@ void BlameContext::Enter() {
                                   category_group_enabled_, name_, scope_, id_,
                                   0 /* num_args */, nullptr, nullptr, nullptr,
                                   nullptr, TRACE_EVENT_FLAG_HAS_ID);
+
+  const char* pushed_context = nullptr;
+  if (allocation_context_ &&
+      AllocationContextTracker::capture_mode() !=
+          AllocationContextTracker::CaptureMode::DISABLED) {
+    AllocationContextTracker* tracker =
+        AllocationContextTracker::GetInstanceForCurrentThread();
+    if (tracker) {
+      tracker->PushCurrentTaskContext(allocation_context_);
+      pushed_context = allocation_context_;
+    }
+  }
+  entered_allocation_contexts_.push_back(pushed_context);
 }
 
 void BlameContext::Leave() {
@@ -53,6 +67,17 @@ void BlameContext::Leave() {
                                   category_group_enabled_, name_, scope_, id_,
                                   0 /* num_args */, nullptr, nullptr, nullptr,
                                   nullptr, TRACE_EVENT_FLAG_HAS_ID);
+
+  if (entered_allocation_contexts_.empty())
+    return;
+  const char* pushed_context = entered_allocation_contexts_.back();
+  entered_allocation_contexts_.pop_back();
+  if (pushed_context) {
+    AllocationContextTracker* tracker =
+        AllocationContextTracker::GetInstanceForCurrentThread();
+    if (tracker)
+      tracker->PopCurrentTaskContext(pushed_context);
+  }
 }
 
 void BlameContext::TakeSnapshot() {
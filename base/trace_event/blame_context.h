@@ -7,6 +7,8 @@
 
 #include <inttypes.h>
 
+#include <vector>
+
 #include "base/base_export.h"
 #include "base/macros.h"
 #include "base/threading/thread_checker.h"
@@ -94,6 +96,14 @@ class BASE_EXPORT BlameContext
   // or more of those properties have changed.
   void TakeSnapshot();
 
+  // Sets the context to which the heap profiler attributes allocations made
+  // while this blame context is entered, e.g. the origin of a frame. Takes
+  // effect the next time the blame context is entered. |context| must have
+  // application lifetime.
+  void SetAllocationContext(const char* context) {
+    allocation_context_ = context;
+  }
+
   const char* category() const { return category_; }
   const char* name() const { return name_; }
   const char* type() const { return type_; }
@@ -126,6 +136,11 @@ class BASE_EXPORT BlameContext
 
   const unsigned char* category_group_enabled_;
 
+  const char* allocation_context_ = nullptr;
+  // The allocation contexts pushed by Enter(), or null where none was, so
+  // that Leave() pops what Enter() pushed.
+  std::vector<const char*> entered_allocation_contexts_;
+
   ThreadChecker thread_checker_;
   WeakPtrFactory<BlameContext> weak_factory_;
 
@@ -7,6 +7,7 @@
 #include "base/json/json_writer.h"
 #include "base/message_loop/message_loop.h"
 #include "base/test/trace_event_analyzer.h"
+#include "base/trace_event/heap_profiler_allocation_context_tracker.h"
 #include "base/trace_event/trace_event_argument.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -88,6 +89,31 @@ TEST_F(BlameContextTest, EnterAndLeave) {
   EXPECT_EQ("0x1234", events[1]->id);
 }
 
+TEST_F(BlameContextTest, AllocationContext) {
+  const char kAllocationContext[] = "https://example.com";
+  AllocationContextTracker::SetCaptureMode(
+      AllocationContextTracker::CaptureMode::PSEUDO_STACK);
+  AllocationContextTracker* tracker =
+      AllocationContextTracker::GetInstanceForCurrentThread();
+  {
+    TestBlameContext blame_context(0x1234);
+    blame_context.Initialize();
+    blame_context.SetAllocationContext(kAllocationContext);
+    blame_context.Enter();
+    EXPECT_EQ(kAllocationContext, tracker->current_task_context());
+
+    // Changing the context while entered doesn't unbalance the stack.
+    blame_context.SetAllocationContext(nullptr);
+    blame_context.Enter();
+    EXPECT_EQ(kAllocationContext, tracker->current_task_context());
+    blame_context.Leave();
+    blame_context.Leave();
+    EXPECT_EQ(nullptr, tracker->current_task_context());
+  }
+  AllocationContextTracker::SetCaptureMode(
+      AllocationContextTracker::CaptureMode::DISABLED);
+}
+
 TEST_F(BlameContextTest, DifferentCategories) {
   // Ensure there is no cross talk between blame contexts from different
   // categories.
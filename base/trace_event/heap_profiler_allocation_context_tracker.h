@@ -108,6 +108,11 @@ class BASE_EXPORT AllocationContextTracker {
   void PushCurrentTaskContext(const char* context);
   void PopCurrentTaskContext(const char* context);
 
+  // Returns the context at the top of the task context stack, or null.
+  const char* current_task_context() const {
+    return task_contexts_.empty() ? nullptr : task_contexts_.back();
+  }
+
   // Fills a snapshot of the current thread-local context. Doesn't fill and
   // returns false if allocations are being ignored.
   bool GetContextSnapshot(AllocationContext* snapshot);
@@ -10,6 +10,9 @@
 
 #include "base/allocator/allocator_extension.h"
 #include "base/allocator/buildflags.h"
+#if BUILDFLAG(CAN_USE_THREAD_CACHE_ALLOCATOR)
+#include "base/allocator/thread_cache_allocator.h"
+#endif
 #include "base/debug/profiler.h"
 #include "base/trace_event/process_memory_dump.h"
 #include "base/trace_event/trace_event_argument.h"
@@ -146,6 +149,17 @@ bool MallocDumpProvider::OnMemoryDump(const MemoryDumpArgs& args,
   allocated_objects_size = info.uordblks;
 #endif
 
+#if BUILDFLAG(CAN_USE_THREAD_CACHE_ALLOCATOR)
+  // The thread cache allocator serves small allocations in front of the
+  // allocator above, from spans the latter doesn't know about.
+  allocator::ThreadCacheAllocatorStats thread_cache_allocator_stats;
+  if (allocator::GetThreadCacheAllocatorStats(&thread_cache_allocator_stats)) {
+    total_virtual_size += thread_cache_allocator_stats.committed_bytes;
+    resident_size += thread_cache_allocator_stats.committed_bytes;
+    allocated_objects_size += thread_cache_allocator_stats.allocated_bytes;
+  }
+#endif
+
   MemoryAllocatorDump* outer_dump = pmd->CreateAllocatorDump("malloc");
   outer_dump->AddScalar("virtual_size", MemoryAllocatorDump::kUnitsBytes,
                         total_virtual_size);
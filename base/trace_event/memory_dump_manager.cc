@@ -31,6 +31,7 @@
 #include "base/trace_event/memory_dump_scheduler.h"
 #include "base/trace_event/memory_infra_background_whitelist.h"
 #include "base/trace_event/process_memory_dump.h"
+#include "base/trace_event/small_block_cache_dump_provider.h"
 #include "base/trace_event/trace_event.h"
 #include "base/trace_event/trace_event_argument.h"
 #include "build/build_config.h"
@@ -136,6 +137,8 @@ void MemoryDumpManager::Initialize(
 #if defined(MALLOC_MEMORY_TRACING_SUPPORTED)
   RegisterDumpProvider(MallocDumpProvider::GetInstance(), "Malloc", nullptr);
 #endif
+  RegisterDumpProvider(SmallBlockCacheDumpProvider::GetInstance(),
+                       "SmallBlockCache", nullptr);
 
 #if defined(OS_ANDROID)
   RegisterDumpProvider(JavaHeapDumpProvider::GetInstance(), "JavaHeap",
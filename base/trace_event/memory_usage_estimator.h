@@ -23,6 +23,8 @@
 
 #include "base/base_export.h"
 #include "base/containers/circular_deque.h"
+#include "base/containers/flat_hash_map.h"
+#include "base/containers/flat_hash_set.h"
 #include "base/containers/flat_map.h"
 #include "base/containers/flat_set.h"
 #include "base/containers/linked_list.h"
@@ -166,6 +168,12 @@ size_t EstimateMemoryUsage(const base::flat_set<T, C>& set);
 template <class K, class V, class C>
 size_t EstimateMemoryUsage(const base::flat_map<K, V, C>& map);
 
+template <class T, class H, class E>
+size_t EstimateMemoryUsage(const base::flat_hash_set<T, H, E>& set);
+
+template <class K, class V, class H, class E>
+size_t EstimateMemoryUsage(const base::flat_hash_map<K, V, H, E>& map);
+
 template <class Key,
           class Payload,
           class HashOrComp,
@@ -639,6 +647,23 @@ size_t EstimateMemoryUsage(const base::flat_map<K, V, C>& map) {
   return sizeof(value_type) * map.capacity() + EstimateIterableMemoryUsage(map);
 }
 
+// Flat hash containers allocate one control byte per slot, plus a group of
+// control bytes that is ignored here.
+
+template <class T, class H, class E>
+size_t EstimateMemoryUsage(const base::flat_hash_set<T, H, E>& set) {
+  using value_type = typename base::flat_hash_set<T, H, E>::value_type;
+  return (sizeof(value_type) + 1) * set.capacity() +
+         EstimateIterableMemoryUsage(set);
+}
+
+template <class K, class V, class H, class E>
+size_t EstimateMemoryUsage(const base::flat_hash_map<K, V, H, E>& map) {
+  using value_type = typename base::flat_hash_map<K, V, H, E>::value_type;
+  return (sizeof(value_type) + 1) * map.capacity() +
+         EstimateIterableMemoryUsage(map);
+}
+
 template <class Key,
           class Payload,
           class HashOrComp,
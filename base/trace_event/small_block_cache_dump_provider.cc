@@ -0,0 +1,48 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/trace_event/small_block_cache_dump_provider.h"
+
+#include "base/memory/small_block_cache.h"
+#include "base/trace_event/malloc_dump_provider.h"
+#include "base/trace_event/process_memory_dump.h"
+
+namespace base {
+namespace trace_event {
+
+// static
+SmallBlockCacheDumpProvider* SmallBlockCacheDumpProvider::GetInstance() {
+  return Singleton<SmallBlockCacheDumpProvider,
+                   LeakySingletonTraits<SmallBlockCacheDumpProvider>>::get();
+}
+
+SmallBlockCacheDumpProvider::SmallBlockCacheDumpProvider() = default;
+
+SmallBlockCacheDumpProvider::~SmallBlockCacheDumpProvider() = default;
+
+bool SmallBlockCacheDumpProvider::OnMemoryDump(const MemoryDumpArgs& args,
+                                               ProcessMemoryDump* pmd) {
+  const internal::SmallBlockCache::Stats stats =
+      internal::SmallBlockCache::GetStats();
+  const uint64_t allocations = stats.hits + stats.misses;
+
+  MemoryAllocatorDump* dump = pmd->CreateAllocatorDump("small_block_cache");
+  dump->AddScalar(MemoryAllocatorDump::kNameSize,
+                  MemoryAllocatorDump::kUnitsBytes,
+                  stats.cached_bytes);
+  dump->AddScalar("hits", MemoryAllocatorDump::kUnitsObjects, stats.hits);
+  dump->AddScalar("misses", MemoryAllocatorDump::kUnitsObjects, stats.misses);
+  // Hit rate in 1/1000th, since scalars are integers.
+  dump->AddScalar("hit_rate_permille", MemoryAllocatorDump::kUnitsObjects,
+                  allocations ? stats.hits * 1000 / allocations : 0);
+
+#if defined(MALLOC_MEMORY_TRACING_SUPPORTED)
+  // Cached blocks are allocated from malloc.
+  pmd->AddSuballocation(dump->guid(), MallocDumpProvider::kAllocatedObjects);
+#endif
+  return true;
+}
+
+}  // namespace trace_event
+}  // namespace base
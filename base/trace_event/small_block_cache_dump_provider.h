@@ -0,0 +1,38 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_TRACE_EVENT_SMALL_BLOCK_CACHE_DUMP_PROVIDER_H_
+#define BASE_TRACE_EVENT_SMALL_BLOCK_CACHE_DUMP_PROVIDER_H_
+
+#include "base/base_export.h"
+#include "base/macros.h"
+#include "base/memory/singleton.h"
+#include "base/trace_event/memory_dump_provider.h"
+
+namespace base {
+namespace trace_event {
+
+// Dump provider which reports the memory held by base::internal::SmallBlockCache
+// and how often its thread caches serve allocations.
+class BASE_EXPORT SmallBlockCacheDumpProvider : public MemoryDumpProvider {
+ public:
+  static SmallBlockCacheDumpProvider* GetInstance();
+
+  // MemoryDumpProvider implementation.
+  bool OnMemoryDump(const MemoryDumpArgs& args,
+                    ProcessMemoryDump* pmd) override;
+
+ private:
+  friend struct DefaultSingletonTraits<SmallBlockCacheDumpProvider>;
+
+  SmallBlockCacheDumpProvider();
+  ~SmallBlockCacheDumpProvider() override;
+
+  DISALLOW_COPY_AND_ASSIGN(SmallBlockCacheDumpProvider);
+};
+
+}  // namespace trace_event
+}  // namespace base
+
+#endif  // BASE_TRACE_EVENT_SMALL_BLOCK_CACHE_DUMP_PROVIDER_H_
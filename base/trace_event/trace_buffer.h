@@ -27,6 +27,11 @@ class BASE_EXPORT TraceBufferChunk {
   bool IsFull() const { return next_free_ == kTraceBufferChunkSize; }
 
   uint32_t seq() const { return seq_; }
+
+  // Changes the sequence number without resetting the events, so that a chunk
+  // filled outside of a TraceBuffer can be returned to it in place of the one
+  // handed out by GetChunk().
+  void set_seq(uint32_t new_seq) { seq_ = new_seq; }
   size_t capacity() const { return kTraceBufferChunkSize; }
   size_t size() const { return next_free_; }
 
@@ -0,0 +1,568 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/trace_event/trace_event_binary_format.h"
+
+#include <string.h>
+
+#include <vector>
+
+#include "base/bit_cast.h"
+#include "base/format_macros.h"
+#include "base/json/string_escape.h"
+#include "base/logging.h"
+#include "base/process/process_handle.h"
+#include "base/strings/stringprintf.h"
+#include "base/trace_event/trace_event.h"
+#include "base/trace_event/trace_log.h"
+
+namespace base {
+namespace trace_event {
+
+namespace {
+
+constexpr char kMagic[] = "CrTrB";
+constexpr size_t kMagicLength = sizeof(kMagic) - 1;
+constexpr uint64_t kVersion = 1;
+
+enum RecordType : uint8_t {
+  kStringRecord = 1,
+  kEventRecord = 2,
+};
+
+// Bits of the |fields| of an event record.
+enum EventFields : uint64_t {
+  kHasThreadTimestamp = 1 << 0,
+  kHasDuration = 1 << 1,
+  kHasThreadDuration = 1 << 2,
+  kArgsStripped = 1 << 3,
+};
+
+// Type of the args stripped by the argument filter.
+constexpr uint8_t kStrippedArgType = 0;
+
+constexpr unsigned int kIdFlags = TRACE_EVENT_FLAG_HAS_ID |
+                                  TRACE_EVENT_FLAG_HAS_LOCAL_ID |
+                                  TRACE_EVENT_FLAG_HAS_GLOBAL_ID;
+constexpr unsigned int kFlowFlags =
+    TRACE_EVENT_FLAG_FLOW_IN | TRACE_EVENT_FLAG_FLOW_OUT;
+
+void AppendVarint(uint64_t value, std::string* out) {
+  while (value >= 0x80) {
+    out->push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out->push_back(static_cast<char>(value));
+}
+
+void AppendSignedVarint(int64_t value, std::string* out) {
+  AppendVarint((static_cast<uint64_t>(value) << 1) ^
+                   static_cast<uint64_t>(value >> 63),
+               out);
+}
+
+void AppendDouble(double value, std::string* out) {
+  const uint64_t bits = bit_cast<uint64_t>(value);
+  for (int i = 0; i < 8; ++i)
+    out->push_back(static_cast<char>(bits >> (8 * i)));
+}
+
+class BinaryTraceReader {
+ public:
+  explicit BinaryTraceReader(StringPiece data) : data_(data) {}
+
+  bool empty() const { return data_.empty(); }
+
+  bool ReadByte(uint8_t* value) {
+    if (data_.empty())
+      return false;
+    *value = static_cast<uint8_t>(data_[0]);
+    data_.remove_prefix(1);
+    return true;
+  }
+
+  bool ReadVarint(uint64_t* value) {
+    *value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      uint8_t byte;
+      if (!ReadByte(&byte))
+        return false;
+      *value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if (!(byte & 0x80))
+        return true;
+    }
+    return false;
+  }
+
+  bool ReadSignedVarint(int64_t* value) {
+    uint64_t encoded;
+    if (!ReadVarint(&encoded))
+      return false;
+    *value = static_cast<int64_t>(encoded >> 1) ^ -static_cast<int64_t>(
+                                                      encoded & 1);
+    return true;
+  }
+
+  bool ReadDouble(double* value) {
+    if (data_.size() < 8)
+      return false;
+    uint64_t bits = 0;
+    for (int i = 0; i < 8; ++i)
+      bits |= static_cast<uint64_t>(static_cast<uint8_t>(data_[i])) << (8 * i);
+    data_.remove_prefix(8);
+    *value = bit_cast<double>(bits);
+    return true;
+  }
+
+  bool ReadBytes(size_t length, StringPiece* bytes) {
+    if (data_.size() < length)
+      return false;
+    *bytes = data_.substr(0, length);
+    data_.remove_prefix(length);
+    return true;
+  }
+
+  bool ReadLengthPrefixedBytes(StringPiece* bytes) {
+    uint64_t length;
+    return ReadVarint(&length) && length <= data_.size() &&
+           ReadBytes(static_cast<size_t>(length), bytes);
+  }
+
+ private:
+  StringPiece data_;
+
+  DISALLOW_COPY_AND_ASSIGN(BinaryTraceReader);
+};
+
+// Converts binary traces to JSON, in the format of TraceEvent::AppendAsJSON().
+class BinaryTraceConverter {
+ public:
+  explicit BinaryTraceConverter(StringPiece binary_trace)
+      : reader_(binary_trace) {
+    // Id 0 stands for null.
+    strings_.emplace_back();
+  }
+
+  bool Convert(std::string* json) {
+    StringPiece magic;
+    uint64_t version;
+    if (!reader_.ReadBytes(kMagicLength, &magic) || magic != kMagic ||
+        !reader_.ReadVarint(&version) || version != kVersion) {
+      return false;
+    }
+
+    *json += "[";
+    bool first_event = true;
+    while (!reader_.empty()) {
+      uint8_t record_type;
+      reader_.ReadByte(&record_type);
+      if (record_type == kStringRecord) {
+        StringPiece bytes;
+        if (!reader_.ReadLengthPrefixedBytes(&bytes))
+          return false;
+        strings_.push_back(bytes.as_string());
+      } else if (record_type == kEventRecord) {
+        if (!first_event)
+          *json += ",\n";
+        first_event = false;
+        if (!ConvertEvent(json))
+          return false;
+      } else {
+        return false;
+      }
+    }
+    *json += "]";
+    return true;
+  }
+
+ private:
+  // Reads a string id and sets |*str| to the string, or to nullptr for id 0.
+  bool ReadString(const char** str) {
+    uint64_t id;
+    if (!reader_.ReadVarint(&id) || id >= strings_.size())
+      return false;
+    *str = id ? strings_[id].c_str() : nullptr;
+    return true;
+  }
+
+  bool ReadNonNullString(const char** str) {
+    return ReadString(str) && *str;
+  }
+
+  bool ConvertEvent(std::string* out) {
+    uint8_t phase;
+    uint64_t flags;
+    const char* category_group_name;
+    const char* name;
+    int64_t process_id;
+    int64_t thread_id;
+    int64_t timestamp_delta;
+    uint64_t fields;
+    if (!reader_.ReadByte(&phase) || !reader_.ReadVarint(&flags) ||
+        !ReadNonNullString(&category_group_name) || !ReadNonNullString(&name) ||
+        !reader_.ReadSignedVarint(&process_id) ||
+        !reader_.ReadSignedVarint(&thread_id) ||
+        !reader_.ReadSignedVarint(&timestamp_delta) ||
+        !reader_.ReadVarint(&fields)) {
+      return false;
+    }
+    timestamp_ += timestamp_delta;
+
+    StringAppendF(out,
+                  "{\"pid\":%i,\"tid\":%i,\"ts\":%" PRId64
+                  ",\"ph\":\"%c\",\"cat\":\"%s\",\"name\":",
+                  static_cast<int>(process_id), static_cast<int>(thread_id),
+                  timestamp_, phase, category_group_name);
+    EscapeJSONString(name, true, out);
+
+    int64_t thread_timestamp = 0;
+    int64_t duration = 0;
+    int64_t thread_duration = 0;
+    if (((fields & kHasThreadTimestamp) &&
+         !reader_.ReadSignedVarint(&thread_timestamp)) ||
+        ((fields & kHasDuration) && !reader_.ReadSignedVarint(&duration)) ||
+        ((fields & kHasThreadDuration) &&
+         !reader_.ReadSignedVarint(&thread_duration))) {
+      return false;
+    }
+
+    const char* scope = nullptr;
+    uint64_t id = 0;
+    if ((flags & kIdFlags) &&
+        (!ReadString(&scope) || !reader_.ReadVarint(&id))) {
+      return false;
+    }
+    uint64_t bind_id = 0;
+    if ((flags & kFlowFlags) && !reader_.ReadVarint(&bind_id))
+      return false;
+
+    *out += ",\"args\":";
+    if (!ConvertArgs(fields & kArgsStripped, out))
+      return false;
+
+    if (fields & kHasDuration)
+      StringAppendF(out, ",\"dur\":%" PRId64, duration);
+    if (fields & kHasThreadDuration)
+      StringAppendF(out, ",\"tdur\":%" PRId64, thread_duration);
+    if (fields & kHasThreadTimestamp)
+      StringAppendF(out, ",\"tts\":%" PRId64, thread_timestamp);
+
+    if (flags & TRACE_EVENT_FLAG_ASYNC_TTS)
+      StringAppendF(out, ", \"use_async_tts\":1");
+
+    if (flags & kIdFlags) {
+      if (scope)
+        StringAppendF(out, ",\"scope\":\"%s\"", scope);
+      switch (flags & kIdFlags) {
+        case TRACE_EVENT_FLAG_HAS_ID:
+          StringAppendF(out, ",\"id\":\"0x%" PRIx64 "\"", id);
+          break;
+        case TRACE_EVENT_FLAG_HAS_LOCAL_ID:
+          StringAppendF(out, ",\"id2\":{\"local\":\"0x%" PRIx64 "\"}", id);
+          break;
+        case TRACE_EVENT_FLAG_HAS_GLOBAL_ID:
+          StringAppendF(out, ",\"id2\":{\"global\":\"0x%" PRIx64 "\"}", id);
+          break;
+        default:
+          return false;
+      }
+    }
+
+    if (flags & TRACE_EVENT_FLAG_BIND_TO_ENCLOSING)
+      StringAppendF(out, ",\"bp\":\"e\"");
+
+    if (flags & kFlowFlags)
+      StringAppendF(out, ",\"bind_id\":\"0x%" PRIx64 "\"", bind_id);
+    if (flags & TRACE_EVENT_FLAG_FLOW_IN)
+      StringAppendF(out, ",\"flow_in\":true");
+    if (flags & TRACE_EVENT_FLAG_FLOW_OUT)
+      StringAppendF(out, ",\"flow_out\":true");
+
+    if (phase == TRACE_EVENT_PHASE_INSTANT) {
+      char instant_scope = '?';
+      switch (flags & TRACE_EVENT_FLAG_SCOPE_MASK) {
+        case TRACE_EVENT_SCOPE_GLOBAL:
+          instant_scope = TRACE_EVENT_SCOPE_NAME_GLOBAL;
+          break;
+        case TRACE_EVENT_SCOPE_PROCESS:
+          instant_scope = TRACE_EVENT_SCOPE_NAME_PROCESS;
+          break;
+        case TRACE_EVENT_SCOPE_THREAD:
+          instant_scope = TRACE_EVENT_SCOPE_NAME_THREAD;
+          break;
+      }
+      StringAppendF(out, ",\"s\":\"%c\"", instant_scope);
+    }
+
+    *out += "}";
+    return true;
+  }
+
+  bool ConvertArgs(bool args_stripped, std::string* out) {
+    uint8_t num_args;
+    if (!reader_.ReadByte(&num_args) || num_args > kTraceMaxNumArgs)
+      return false;
+    if (args_stripped) {
+      *out += "\"__stripped__\"";
+      return num_args == 0;
+    }
+
+    *out += "{";
+    for (uint8_t i = 0; i < num_args; ++i) {
+      const char* arg_name;
+      uint8_t type;
+      if (!ReadNonNullString(&arg_name) || !reader_.ReadByte(&type))
+        return false;
+      if (i > 0)
+        *out += ",";
+      *out += "\"";
+      *out += arg_name;
+      *out += "\":";
+
+      TraceEvent::TraceValue value;
+      switch (type) {
+        case kStrippedArgType:
+          *out += "\"__stripped__\"";
+          continue;
+        case TRACE_VALUE_TYPE_BOOL: {
+          uint8_t byte;
+          if (!reader_.ReadByte(&byte))
+            return false;
+          value.as_bool = byte != 0;
+          break;
+        }
+        case TRACE_VALUE_TYPE_UINT: {
+          uint64_t uint_value;
+          if (!reader_.ReadVarint(&uint_value))
+            return false;
+          value.as_uint = uint_value;
+          break;
+        }
+        case TRACE_VALUE_TYPE_INT: {
+          int64_t int_value;
+          if (!reader_.ReadSignedVarint(&int_value))
+            return false;
+          value.as_int = int_value;
+          break;
+        }
+        case TRACE_VALUE_TYPE_DOUBLE:
+          if (!reader_.ReadDouble(&value.as_double))
+            return false;
+          break;
+        case TRACE_VALUE_TYPE_POINTER: {
+          uint64_t pointer;
+          if (!reader_.ReadVarint(&pointer))
+            return false;
+          // AppendValueAsJSON() only prints the pointer value, which may be
+          // wider than the pointers of the converting process.
+          StringAppendF(out, "\"0x%" PRIx64 "\"", pointer);
+          continue;
+        }
+        case TRACE_VALUE_TYPE_STRING:
+          if (!ReadString(&value.as_string))
+            return false;
+          break;
+        case TRACE_VALUE_TYPE_CONVERTABLE: {
+          StringPiece convertable_json;
+          if (!reader_.ReadLengthPrefixedBytes(&convertable_json))
+            return false;
+          convertable_json.AppendToString(out);
+          continue;
+        }
+        default:
+          return false;
+      }
+      TraceEvent::AppendValueAsJSON(type, value, out);
+    }
+    *out += "}";
+    return true;
+  }
+
+  BinaryTraceReader reader_;
+  std::vector<std::string> strings_;
+  int64_t timestamp_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(BinaryTraceConverter);
+};
+
+}  // namespace
+
+TraceEventBinaryWriter::TraceEventBinaryWriter() = default;
+
+TraceEventBinaryWriter::~TraceEventBinaryWriter() = default;
+
+// static
+void TraceEventBinaryWriter::AppendHeader(std::string* out) {
+  out->append(kMagic, kMagicLength);
+  AppendVarint(kVersion, out);
+}
+
+void TraceEventBinaryWriter::AppendEvent(
+    const TraceEvent& trace_event,
+    const ArgumentFilterPredicate& argument_filter_predicate,
+    std::string* out) {
+  // Keep in sync with TraceEvent::AppendAsJSON().
+  const unsigned int flags = trace_event.flags();
+  int process_id;
+  int thread_id;
+  // thread_id() is the process id of events with an explicit one.
+  if ((flags & TRACE_EVENT_FLAG_HAS_PROCESS_ID) &&
+      trace_event.thread_id() != kNullProcessId) {
+    process_id = trace_event.thread_id();
+    thread_id = -1;
+  } else {
+    process_id = TraceLog::GetInstance()->process_id();
+    thread_id = trace_event.thread_id();
+  }
+  const char* category_group_name =
+      TraceLog::GetCategoryGroupName(trace_event.category_group_enabled());
+
+  int num_args = 0;
+  while (num_args < kTraceMaxNumArgs && trace_event.arg_name(num_args))
+    ++num_args;
+  ArgumentNameFilterPredicate argument_name_filter_predicate;
+  const bool strip_args =
+      num_args && !argument_filter_predicate.is_null() &&
+      !argument_filter_predicate.Run(category_group_name, trace_event.name(),
+                                     &argument_name_filter_predicate);
+
+  // Intern the strings before starting the event record.
+  const uint32_t category_id = InternString(category_group_name, out);
+  const uint32_t name_id = InternString(trace_event.name(), out);
+  uint32_t arg_name_ids[kTraceMaxNumArgs] = {};
+  uint32_t arg_string_ids[kTraceMaxNumArgs] = {};
+  for (int i = 0; !strip_args && i < num_args; ++i) {
+    arg_name_ids[i] = InternString(trace_event.arg_name(i), out);
+    const unsigned char type = trace_event.arg_type(i);
+    if (type == TRACE_VALUE_TYPE_STRING ||
+        type == TRACE_VALUE_TYPE_COPY_STRING) {
+      arg_string_ids[i] =
+          InternString(trace_event.arg_value(i).as_string, out);
+    }
+  }
+  const uint32_t scope_id =
+      (flags & kIdFlags) ? InternString(trace_event.scope(), out) : 0;
+
+  const char phase = trace_event.phase();
+  const int64_t timestamp = trace_event.timestamp().ToInternalValue();
+  const bool has_thread_timestamp = !trace_event.thread_timestamp().is_null();
+  const int64_t duration = trace_event.duration().ToInternalValue();
+  const int64_t thread_duration =
+      trace_event.thread_duration().ToInternalValue();
+  uint64_t fields = 0;
+  if (has_thread_timestamp)
+    fields |= kHasThreadTimestamp;
+  if (phase == TRACE_EVENT_PHASE_COMPLETE && duration != -1)
+    fields |= kHasDuration;
+  if (phase == TRACE_EVENT_PHASE_COMPLETE && has_thread_timestamp &&
+      thread_duration != -1) {
+    fields |= kHasThreadDuration;
+  }
+  if (strip_args)
+    fields |= kArgsStripped;
+
+  out->push_back(static_cast<char>(kEventRecord));
+  out->push_back(phase);
+  AppendVarint(flags, out);
+  AppendVarint(category_id, out);
+  AppendVarint(name_id, out);
+  AppendSignedVarint(process_id, out);
+  AppendSignedVarint(thread_id, out);
+  AppendSignedVarint(timestamp - previous_timestamp_, out);
+  previous_timestamp_ = timestamp;
+  AppendVarint(fields, out);
+  if (fields & kHasThreadTimestamp) {
+    AppendSignedVarint(trace_event.thread_timestamp().ToInternalValue(), out);
+  }
+  if (fields & kHasDuration)
+    AppendSignedVarint(duration, out);
+  if (fields & kHasThreadDuration)
+    AppendSignedVarint(thread_duration, out);
+  if (flags & kIdFlags) {
+    AppendVarint(scope_id, out);
+    AppendVarint(static_cast<uint64_t>(trace_event.id()), out);
+  }
+  if (flags & kFlowFlags)
+    AppendVarint(static_cast<uint64_t>(trace_event.bind_id()), out);
+
+  if (strip_args) {
+    out->push_back(0);
+    return;
+  }
+  out->push_back(static_cast<char>(num_args));
+  for (int i = 0; i < num_args; ++i) {
+    AppendVarint(arg_name_ids[i], out);
+    if (!argument_name_filter_predicate.is_null() &&
+        !argument_name_filter_predicate.Run(trace_event.arg_name(i))) {
+      out->push_back(static_cast<char>(kStrippedArgType));
+      continue;
+    }
+
+    const unsigned char type = trace_event.arg_type(i);
+    const TraceEvent::TraceValue& value = trace_event.arg_value(i);
+    switch (type) {
+      case TRACE_VALUE_TYPE_BOOL:
+        out->push_back(static_cast<char>(type));
+        out->push_back(value.as_bool ? 1 : 0);
+        break;
+      case TRACE_VALUE_TYPE_UINT:
+        out->push_back(static_cast<char>(type));
+        AppendVarint(value.as_uint, out);
+        break;
+      case TRACE_VALUE_TYPE_INT:
+        out->push_back(static_cast<char>(type));
+        AppendSignedVarint(value.as_int, out);
+        break;
+      case TRACE_VALUE_TYPE_DOUBLE:
+        out->push_back(static_cast<char>(type));
+        AppendDouble(value.as_double, out);
+        break;
+      case TRACE_VALUE_TYPE_POINTER:
+        out->push_back(static_cast<char>(type));
+        AppendVarint(reinterpret_cast<uintptr_t>(value.as_pointer), out);
+        break;
+      case TRACE_VALUE_TYPE_STRING:
+      case TRACE_VALUE_TYPE_COPY_STRING:
+        // AppendValueAsJSON() prints null strings as "NULL".
+        out->push_back(static_cast<char>(TRACE_VALUE_TYPE_STRING));
+        AppendVarint(arg_string_ids[i], out);
+        break;
+      case TRACE_VALUE_TYPE_CONVERTABLE: {
+        out->push_back(static_cast<char>(type));
+        std::string convertable_json;
+        trace_event.arg_convertible_value(i)->AppendAsTraceFormat(
+            &convertable_json);
+        AppendVarint(convertable_json.size(), out);
+        out->append(convertable_json);
+        break;
+      }
+      default:
+        NOTREACHED() << "Don't know how to write this value";
+        out->push_back(static_cast<char>(kStrippedArgType));
+        break;
+    }
+  }
+}
+
+uint32_t TraceEventBinaryWriter::InternString(const char* str,
+                                              std::string* out) {
+  if (!str)
+    return 0;
+  const auto result = string_ids_.emplace(
+      StringPiece(str), static_cast<uint32_t>(string_ids_.size() + 1));
+  if (result.second) {
+    out->push_back(static_cast<char>(kStringRecord));
+    const StringPiece& interned = result.first->first;
+    AppendVarint(interned.size(), out);
+    interned.AppendToString(out);
+  }
+  return result.first->second;
+}
+
+bool ConvertBinaryTraceToJSON(StringPiece binary_trace, std::string* json) {
+  return BinaryTraceConverter(binary_trace).Convert(json);
+}
+
+}  // namespace trace_event
+}  // namespace base
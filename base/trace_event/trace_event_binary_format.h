@@ -0,0 +1,83 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_TRACE_EVENT_TRACE_EVENT_BINARY_FORMAT_H_
+#define BASE_TRACE_EVENT_TRACE_EVENT_BINARY_FORMAT_H_
+
+#include <stdint.h>
+
+#include <string>
+
+#include "base/base_export.h"
+#include "base/containers/flat_hash_map.h"
+#include "base/macros.h"
+#include "base/strings/string_piece.h"
+#include "base/trace_event/trace_event_impl.h"
+
+namespace base {
+namespace trace_event {
+
+// A compact alternative to the JSON format of TraceEvent::AppendAsJSON(), for
+// flushing long traces with little CPU and output size (see
+// TraceLog::BINARY_OUTPUT_FORMAT). Every distinct string is written once and
+// then referred to by id, and numbers are written as varints. A binary trace
+// converts back to exactly the JSON TraceResultBuffer would have produced
+// with ConvertBinaryTraceToJSON(), or with tools/trace_event/
+// binary_trace_to_json.
+//
+// A binary trace is a header followed by records, where varints are LEB128,
+// svarints are zigzag-encoded varints and [] marks optional fields:
+//   header:  "CrTrB" varint(version)
+//   string:  0x01 varint(length) bytes
+//            Defines the next string id. Ids start at 1; 0 stands for null.
+//   event:   0x02 byte(phase) varint(flags) varint(category) varint(name)
+//            svarint(pid) svarint(tid) svarint(timestamp - previous timestamp)
+//            varint(fields) [svarint(thread timestamp)] [svarint(duration)]
+//            [svarint(thread duration)] [varint(scope) varint(id)]
+//            [varint(bind id)] byte(number of args) args
+//            |fields| tells which of the optional fields that follow are
+//            present, the id is present if |flags| has one of the ID flags,
+//            and the bind id if it has one of the FLOW flags.
+//   arg:     varint(name) byte(type) value
+//            Values are a byte for bools, a varint for unsigned integers and
+//            pointers, a svarint for integers, 8 little-endian bytes for
+//            doubles, a string id for strings and varint(length) bytes of JSON
+//            for convertables. Args stripped by the argument filter have type
+//            0 and no value.
+
+// Writes the events of a binary trace.
+class BASE_EXPORT TraceEventBinaryWriter {
+ public:
+  TraceEventBinaryWriter();
+  ~TraceEventBinaryWriter();
+
+  // Appends the header of a binary trace to |out|.
+  static void AppendHeader(std::string* out);
+
+  // Appends |trace_event| to |out|, preceded by the strings it uses that
+  // previous calls didn't append. All the events of a trace must be appended
+  // by the same writer, and the strings they point to must outlive it.
+  void AppendEvent(const TraceEvent& trace_event,
+                   const ArgumentFilterPredicate& argument_filter_predicate,
+                   std::string* out);
+
+ private:
+  // Returns the id of |str|, appending its definition to |out| if it's new.
+  uint32_t InternString(const char* str, std::string* out);
+
+  flat_hash_map<StringPiece, uint32_t, StringPieceHash> string_ids_;
+  int64_t previous_timestamp_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(TraceEventBinaryWriter);
+};
+
+// Converts |binary_trace| to a JSON array of trace events, in the format of
+// TraceResultBuffer. Returns false if |binary_trace| is malformed.
+BASE_EXPORT bool ConvertBinaryTraceToJSON(StringPiece binary_trace,
+                                          std::string* json);
+
+}  // namespace trace_event
+}  // namespace base
+
+#endif  // BASE_TRACE_EVENT_TRACE_EVENT_BINARY_FORMAT_H_
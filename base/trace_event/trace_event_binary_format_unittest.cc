@@ -0,0 +1,338 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/trace_event/trace_event_binary_format.h"
+
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+
+#include "base/bind.h"
+#include "base/json/json_reader.h"
+#include "base/memory/ref_counted_memory.h"
+#include "base/strings/pattern.h"
+#include "base/time/time.h"
+#include "base/trace_event/trace_event.h"
+#include "base/trace_event/trace_event_argument.h"
+#include "base/trace_event/trace_log.h"
+#include "base/values.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+namespace trace_event {
+
+namespace {
+
+bool IsArgNameWhitelisted(const char* arg_name) {
+  return MatchPattern(arg_name, "whitelisted");
+}
+
+bool IsTraceEventArgsWhitelisted(const char* category_group_name,
+                                 const char* event_name,
+                                 ArgumentNameFilterPredicate* arg_filter) {
+  if (MatchPattern(event_name, "granular")) {
+    *arg_filter = Bind(&IsArgNameWhitelisted);
+    return true;
+  }
+  return MatchPattern(event_name, "whitelisted");
+}
+
+void AppendFragment(std::string* out,
+                    const scoped_refptr<RefCountedString>& fragment,
+                    bool has_more_events) {
+  *out += fragment->data();
+}
+
+class TraceEventBinaryFormatTest : public testing::Test {
+ public:
+  void SetUp() override {
+    TraceLog::ResetForTesting();
+    category_group_enabled_ = TraceLog::GetCategoryGroupEnabled("cat");
+  }
+
+  void TearDown() override { TraceLog::ResetForTesting(); }
+
+  // Writes |events| as a binary trace, converts it back and verifies that it
+  // is the JSON TraceEvent::AppendAsJSON() writes.
+  void ExpectRoundTrip(const TraceEvent* const* events,
+                       size_t num_events,
+                       const ArgumentFilterPredicate& filter) {
+    TraceEventBinaryWriter writer;
+    std::string binary_trace;
+    TraceEventBinaryWriter::AppendHeader(&binary_trace);
+    std::string expected_json = "[";
+    for (size_t i = 0; i < num_events; ++i) {
+      writer.AppendEvent(*events[i], filter, &binary_trace);
+      if (i > 0)
+        expected_json += ",\n";
+      events[i]->AppendAsJSON(&expected_json, filter);
+    }
+    expected_json += "]";
+
+    std::string json;
+    EXPECT_TRUE(ConvertBinaryTraceToJSON(binary_trace, &json));
+    EXPECT_EQ(expected_json, json);
+    EXPECT_LT(binary_trace.size(), json.size());
+  }
+
+ protected:
+  const unsigned char* category_group_enabled_ = nullptr;
+};
+
+}  // namespace
+
+TEST_F(TraceEventBinaryFormatTest, RoundTrip) {
+  const char* const arg_names[] = {"bool", "int"};
+  const unsigned char arg_types[] = {TRACE_VALUE_TYPE_BOOL,
+                                     TRACE_VALUE_TYPE_INT};
+  const unsigned long long arg_values[] = {1,
+                                           static_cast<unsigned long long>(-42)};
+  TraceEvent begin;
+  begin.Initialize(12, TimeTicks::FromInternalValue(1000),
+                   ThreadTicks::FromInternalValue(500),
+                   TRACE_EVENT_PHASE_BEGIN, category_group_enabled_, "event",
+                   trace_event_internal::kGlobalScope, 0, 0, 2, arg_names,
+                   arg_types, arg_values, nullptr, TRACE_EVENT_FLAG_NONE);
+
+  const char* const more_arg_names[] = {"uint", "double"};
+  const unsigned char more_arg_types[] = {TRACE_VALUE_TYPE_UINT,
+                                          TRACE_VALUE_TYPE_DOUBLE};
+  TraceEvent::TraceValue double_value;
+  double_value.as_double = -1.5;
+  const unsigned long long more_arg_values[] = {UINT64_C(0xffffffffffff),
+                                                double_value.as_uint};
+  TraceEvent complete;
+  complete.Initialize(12, TimeTicks::FromInternalValue(900),
+                      ThreadTicks::FromInternalValue(600),
+                      TRACE_EVENT_PHASE_COMPLETE, category_group_enabled_,
+                      "complete\\event", trace_event_internal::kGlobalScope,
+                      0, 0, 2, more_arg_names, more_arg_types, more_arg_values,
+                      nullptr, TRACE_EVENT_FLAG_NONE);
+  complete.UpdateDuration(TimeTicks::FromInternalValue(1300),
+                          ThreadTicks::FromInternalValue(700));
+
+  TraceEvent instant;
+  instant.Initialize(34, TimeTicks::FromInternalValue(2000), ThreadTicks(),
+                     TRACE_EVENT_PHASE_INSTANT, category_group_enabled_,
+                     "instant", trace_event_internal::kGlobalScope, 0, 0, 0,
+                     nullptr, nullptr, nullptr, nullptr,
+                     TRACE_EVENT_SCOPE_THREAD);
+
+  const TraceEvent* const events[] = {&begin, &complete, &instant};
+  ExpectRoundTrip(events, arraysize(events), ArgumentFilterPredicate());
+}
+
+TEST_F(TraceEventBinaryFormatTest, IdsAndFlows) {
+  TraceEvent async;
+  async.Initialize(12, TimeTicks::FromInternalValue(1000), ThreadTicks(),
+                   TRACE_EVENT_PHASE_ASYNC_BEGIN, category_group_enabled_,
+                   "async", "scope", 0x1234, 0, 0, nullptr, nullptr, nullptr,
+                   nullptr,
+                   TRACE_EVENT_FLAG_HAS_ID | TRACE_EVENT_FLAG_ASYNC_TTS);
+
+  TraceEvent local_id;
+  local_id.Initialize(12, TimeTicks::FromInternalValue(1100), ThreadTicks(),
+                      TRACE_EVENT_PHASE_NESTABLE_ASYNC_BEGIN,
+                      category_group_enabled_, "local id",
+                      trace_event_internal::kGlobalScope, 0x5678, 0, 0,
+                      nullptr, nullptr, nullptr, nullptr,
+                      TRACE_EVENT_FLAG_HAS_LOCAL_ID);
+
+  TraceEvent flow;
+  flow.Initialize(12, TimeTicks::FromInternalValue(1200), ThreadTicks(),
+                  TRACE_EVENT_PHASE_BEGIN, category_group_enabled_, "flow",
+                  trace_event_internal::kGlobalScope, 0, 0x9abc, 0, nullptr,
+                  nullptr, nullptr, nullptr,
+                  TRACE_EVENT_FLAG_FLOW_IN | TRACE_EVENT_FLAG_FLOW_OUT |
+                      TRACE_EVENT_FLAG_BIND_TO_ENCLOSING);
+
+  TraceEvent other_process;
+  other_process.Initialize(56, TimeTicks::FromInternalValue(1300),
+                           ThreadTicks(), TRACE_EVENT_PHASE_INSTANT,
+                           category_group_enabled_, "other process",
+                           trace_event_internal::kGlobalScope, 0, 0, 0,
+                           nullptr, nullptr, nullptr, nullptr,
+                           TRACE_EVENT_FLAG_HAS_PROCESS_ID |
+                               TRACE_EVENT_SCOPE_PROCESS);
+
+  const TraceEvent* const events[] = {&async, &local_id, &flow,
+                                      &other_process};
+  ExpectRoundTrip(events, arraysize(events), ArgumentFilterPredicate());
+}
+
+TEST_F(TraceEventBinaryFormatTest, StringsAndConvertables) {
+  const char* const arg_names[] = {"string", "copy", "null"};
+  const unsigned char arg_types[] = {TRACE_VALUE_TYPE_STRING,
+                                     TRACE_VALUE_TYPE_COPY_STRING,
+                                     TRACE_VALUE_TYPE_STRING};
+  TraceEvent::TraceValue values[3];
+  values[0].as_string = "value \"with\" quotes";
+  values[1].as_string = "copied";
+  values[2].as_string = nullptr;
+  const unsigned long long arg_values[] = {values[0].as_uint, values[1].as_uint,
+                                           values[2].as_uint};
+  TraceEvent strings;
+  strings.Initialize(12, TimeTicks::FromInternalValue(1000), ThreadTicks(),
+                     TRACE_EVENT_PHASE_INSTANT, category_group_enabled_,
+                     "strings", trace_event_internal::kGlobalScope, 0, 0, 3,
+                     arg_names, arg_types, arg_values, nullptr,
+                     TRACE_EVENT_FLAG_COPY);
+
+  std::unique_ptr<TracedValue> traced_value(new TracedValue());
+  traced_value->SetInteger("int", 2018);
+  traced_value->SetString("string", "string");
+  std::unique_ptr<ConvertableToTraceFormat> convertable_values[] = {
+      std::move(traced_value)};
+  const char* const convertable_arg_names[] = {"value"};
+  const unsigned char convertable_arg_types[] = {TRACE_VALUE_TYPE_CONVERTABLE};
+  const unsigned long long convertable_arg_values[] = {0};
+  TraceEvent convertable;
+  convertable.Initialize(
+      12, TimeTicks::FromInternalValue(1100), ThreadTicks(),
+      TRACE_EVENT_PHASE_INSTANT, category_group_enabled_, "strings",
+      trace_event_internal::kGlobalScope, 0, 0, 1, convertable_arg_names,
+      convertable_arg_types, convertable_arg_values, convertable_values,
+      TRACE_EVENT_FLAG_NONE);
+
+  const TraceEvent* const events[] = {&strings, &convertable};
+  ExpectRoundTrip(events, arraysize(events), ArgumentFilterPredicate());
+}
+
+TEST_F(TraceEventBinaryFormatTest, ArgumentFilter) {
+  const char* const arg_names[] = {"whitelisted", "blacklisted"};
+  const unsigned char arg_types[] = {TRACE_VALUE_TYPE_INT,
+                                     TRACE_VALUE_TYPE_INT};
+  const unsigned long long arg_values[] = {1, 2};
+  TraceEvent whitelisted;
+  whitelisted.Initialize(
+      12, TimeTicks::FromInternalValue(1000), ThreadTicks(),
+      TRACE_EVENT_PHASE_INSTANT, category_group_enabled_, "whitelisted",
+      trace_event_internal::kGlobalScope, 0, 0, 2, arg_names, arg_types,
+      arg_values, nullptr, TRACE_EVENT_FLAG_NONE);
+  TraceEvent granular;
+  granular.Initialize(12, TimeTicks::FromInternalValue(1100), ThreadTicks(),
+                      TRACE_EVENT_PHASE_INSTANT, category_group_enabled_,
+                      "granular", trace_event_internal::kGlobalScope, 0, 0, 2,
+                      arg_names, arg_types, arg_values, nullptr,
+                      TRACE_EVENT_FLAG_NONE);
+  TraceEvent stripped;
+  stripped.Initialize(12, TimeTicks::FromInternalValue(1200), ThreadTicks(),
+                      TRACE_EVENT_PHASE_INSTANT, category_group_enabled_,
+                      "stripped", trace_event_internal::kGlobalScope, 0, 0, 2,
+                      arg_names, arg_types, arg_values, nullptr,
+                      TRACE_EVENT_FLAG_NONE);
+
+  const TraceEvent* const events[] = {&whitelisted, &granular, &stripped};
+  ExpectRoundTrip(events, arraysize(events),
+                  Bind(&IsTraceEventArgsWhitelisted));
+}
+
+TEST_F(TraceEventBinaryFormatTest, Malformed) {
+  std::string json;
+  EXPECT_FALSE(ConvertBinaryTraceToJSON("", &json));
+  EXPECT_FALSE(ConvertBinaryTraceToJSON("[{}]", &json));
+  // Unknown version.
+  EXPECT_FALSE(ConvertBinaryTraceToJSON(StringPiece("CrTrB\x02", 6), &json));
+
+  std::string binary_trace;
+  TraceEventBinaryWriter::AppendHeader(&binary_trace);
+  const size_t header_size = binary_trace.size();
+  json.clear();
+  EXPECT_TRUE(ConvertBinaryTraceToJSON(binary_trace, &json));
+  EXPECT_EQ("[]", json);
+
+  TraceEvent event;
+  event.Initialize(12, TimeTicks::FromInternalValue(1000), ThreadTicks(),
+                   TRACE_EVENT_PHASE_INSTANT, category_group_enabled_, "event",
+                   trace_event_internal::kGlobalScope, 0, 0, 0, nullptr,
+                   nullptr, nullptr, nullptr, TRACE_EVENT_FLAG_NONE);
+  TraceEventBinaryWriter writer;
+  writer.AppendEvent(event, ArgumentFilterPredicate(), &binary_trace);
+
+  // The event record follows the definitions of the strings it uses.
+  const size_t event_record = binary_trace.find('\x02', header_size);
+  ASSERT_NE(std::string::npos, event_record);
+
+  // Every truncation of the event record is malformed.
+  for (size_t length = event_record + 1; length < binary_trace.size();
+       ++length) {
+    json.clear();
+    EXPECT_FALSE(ConvertBinaryTraceToJSON(
+        StringPiece(binary_trace.data(), length), &json))
+        << length;
+  }
+
+  // So is an event record that refers to strings that aren't defined.
+  std::string undefined_strings;
+  TraceEventBinaryWriter::AppendHeader(&undefined_strings);
+  undefined_strings.append(binary_trace, event_record, std::string::npos);
+  json.clear();
+  EXPECT_FALSE(ConvertBinaryTraceToJSON(undefined_strings, &json));
+
+  // And a trace with an unknown record type.
+  binary_trace.push_back('\x7f');
+  json.clear();
+  EXPECT_FALSE(ConvertBinaryTraceToJSON(binary_trace, &json));
+}
+
+// Verify that a binary flush of TraceLog converts to the same events as a JSON
+// flush would have.
+TEST_F(TraceEventBinaryFormatTest, FlushWithBinaryOutputFormat) {
+  TraceLog* trace_log = TraceLog::GetInstance();
+  trace_log->SetEnabled(TraceConfig("cat", ""), TraceLog::RECORDING_MODE);
+  {
+    TRACE_EVENT1("cat", "complete", "int", 1);
+    TRACE_EVENT_INSTANT1("cat", "instant", TRACE_EVENT_SCOPE_THREAD, "string",
+                         "value");
+    TRACE_EVENT_ASYNC_BEGIN0("cat", "async", 0x42);
+  }
+  trace_log->SetDisabled();
+
+  std::string binary_trace;
+  trace_log->FlushWithOutputFormat(TraceLog::BINARY_OUTPUT_FORMAT,
+                                   Bind(&AppendFragment, &binary_trace));
+
+  std::string json;
+  ASSERT_TRUE(ConvertBinaryTraceToJSON(binary_trace, &json));
+  std::unique_ptr<Value> value = JSONReader::Read(json);
+  ListValue* events;
+  ASSERT_TRUE(value && value->GetAsList(&events));
+
+  bool found_complete = false;
+  bool found_instant = false;
+  bool found_async = false;
+  for (size_t i = 0; i < events->GetSize(); ++i) {
+    DictionaryValue* event;
+    ASSERT_TRUE(events->GetDictionary(i, &event));
+    std::string name;
+    std::string phase;
+    EXPECT_TRUE(event->GetString("name", &name));
+    EXPECT_TRUE(event->GetString("ph", &phase));
+    if (name == "complete") {
+      found_complete = true;
+      EXPECT_EQ("X", phase);
+      int int_value;
+      EXPECT_TRUE(event->GetInteger("args.int", &int_value));
+      EXPECT_EQ(1, int_value);
+      EXPECT_TRUE(event->HasKey("dur"));
+    } else if (name == "instant") {
+      found_instant = true;
+      std::string string_value;
+      EXPECT_TRUE(event->GetString("args.string", &string_value));
+      EXPECT_EQ("value", string_value);
+    } else if (name == "async") {
+      found_async = true;
+      std::string id;
+      EXPECT_TRUE(event->GetString("id", &id));
+      EXPECT_EQ("0x42", id);
+    }
+  }
+  EXPECT_TRUE(found_complete);
+  EXPECT_TRUE(found_instant);
+  EXPECT_TRUE(found_async);
+}
+
+}  // namespace trace_event
+}  // namespace base
@@ -0,0 +1,132 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/location.h"
+#include "base/macros.h"
+#include "base/single_thread_task_runner.h"
+#include "base/strings/stringprintf.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/test/perf_benchmark.h"
+#include "base/threading/simple_thread.h"
+#include "base/threading/thread.h"
+#include "base/time/time.h"
+#include "base/trace_event/trace_event.h"
+#include "base/trace_event/trace_log.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+namespace trace_event {
+
+namespace {
+
+constexpr int kNumEventsPerThread = 100000;
+constexpr int kMaxNumThreads = 8;
+
+void AddTraceEvents() {
+  for (int i = 0; i < kNumEventsPerThread; ++i)
+    TRACE_EVENT_INSTANT0("perftest", "event", TRACE_EVENT_SCOPE_THREAD);
+}
+
+void AddTraceEventsAndSignal(WaitableEvent* complete_event) {
+  AddTraceEvents();
+  complete_event->Signal();
+}
+
+// A thread without a message loop, whose events are added to the buffer
+// shared by such threads.
+class TraceEventThread : public SimpleThread {
+ public:
+  TraceEventThread() : SimpleThread("TraceEventThread") {}
+
+  void Run() override { AddTraceEvents(); }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(TraceEventThread);
+};
+
+class TraceEventPerfTest : public testing::Test {
+ public:
+  void SetUp() override {
+    // Record continuously so that the buffer never fills up.
+    TraceLog::GetInstance()->SetEnabled(
+        TraceConfig("perftest", RECORD_CONTINUOUSLY), TraceLog::RECORDING_MODE);
+  }
+
+  void TearDown() override { TraceLog::GetInstance()->SetDisabled(); }
+
+  // Reports the time measured by |measure| for |num_threads| threads.
+  template <typename Function>
+  void RunBenchmark(const std::string& modifier,
+                    int num_threads,
+                    Function measure) {
+    // Wall time per event of each thread: doesn't grow with the number of
+    // threads if adding events scales.
+    PerfBenchmark::Options options;
+    options.repetitions = 10;
+    options.operations_per_run = kNumEventsPerThread;
+    PerfBenchmark("TraceEvent" + modifier,
+                  StringPrintf("%d_threads", num_threads), options)
+        .RunMeasured(measure);
+  }
+};
+
+}  // namespace
+
+// Threads with a message loop add events to a thread local buffer.
+TEST_F(TraceEventPerfTest, ThreadsWithMessageLoop) {
+  for (int num_threads = 1; num_threads <= kMaxNumThreads; num_threads *= 2) {
+    std::vector<std::unique_ptr<Thread>> threads;
+    std::vector<std::unique_ptr<WaitableEvent>> complete_events;
+    for (int i = 0; i < num_threads; ++i) {
+      threads.push_back(std::make_unique<Thread>("TraceEventThread"));
+      threads.back()->Start();
+      complete_events.push_back(std::make_unique<WaitableEvent>(
+          WaitableEvent::ResetPolicy::MANUAL,
+          WaitableEvent::InitialState::NOT_SIGNALED));
+    }
+
+    RunBenchmark("_message_loop", num_threads, [&] {
+      for (const auto& complete_event : complete_events)
+        complete_event->Reset();
+      const TimeTicks start = TimeTicks::Now();
+      for (int i = 0; i < num_threads; ++i) {
+        threads[i]->task_runner()->PostTask(
+            FROM_HERE,
+            BindOnce(&AddTraceEventsAndSignal, complete_events[i].get()));
+      }
+      for (const auto& complete_event : complete_events)
+        complete_event->Wait();
+      return TimeTicks::Now() - start;
+    });
+
+    for (const auto& thread : threads)
+      thread->Stop();
+  }
+}
+
+// Threads without a message loop add events to a buffer shared under a lock.
+TEST_F(TraceEventPerfTest, ThreadsWithoutMessageLoop) {
+  for (int num_threads = 1; num_threads <= kMaxNumThreads; num_threads *= 2) {
+    RunBenchmark("_no_message_loop", num_threads, [&] {
+      std::vector<std::unique_ptr<TraceEventThread>> threads;
+      for (int i = 0; i < num_threads; ++i)
+        threads.push_back(std::make_unique<TraceEventThread>());
+
+      const TimeTicks start = TimeTicks::Now();
+      for (const auto& thread : threads)
+        thread->Start();
+      for (const auto& thread : threads)
+        thread->Join();
+      return TimeTicks::Now() - start;
+    });
+  }
+}
+
+}  // namespace trace_event
+}  // namespace base
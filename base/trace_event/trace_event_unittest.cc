@@ -1780,6 +1780,40 @@ TEST_F(TraceEventTestFixture, DataCapturedManyThreads) {
   }
 }
 
+void TraceCompleteEventAroundInstantEvents(int num_events,
+                                           WaitableEvent* task_complete_event) {
+  {
+    TRACE_EVENT0("all", "outer complete event");
+    TraceManyInstantEvents(0, num_events, nullptr);
+  }
+  task_complete_event->Signal();
+}
+
+// Test that the duration of a COMPLETE event is recorded when the thread local
+// buffer of its thread was merged into the main buffer before the event ended.
+TEST_F(TraceEventTestFixture, CompleteEventSpanningThreadLocalBufferMerges) {
+  BeginTrace();
+
+  const int num_events = 5000;
+  Thread thread("1");
+  WaitableEvent task_complete_event(WaitableEvent::ResetPolicy::AUTOMATIC,
+                                    WaitableEvent::InitialState::NOT_SIGNALED);
+  thread.Start();
+  thread.task_runner()->PostTask(
+      FROM_HERE, BindOnce(&TraceCompleteEventAroundInstantEvents, num_events,
+                          &task_complete_event));
+  task_complete_event.Wait();
+
+  EndTraceAndFlushInThreadWithMessageLoop();
+  thread.Stop();
+
+  ValidateInstantEventPresentOnEveryThread(trace_parsed_, 1, num_events);
+  const DictionaryValue* item = FindNamePhase("outer complete event", "X");
+  ASSERT_TRUE(item);
+  double duration;
+  EXPECT_TRUE(item->GetDouble("dur", &duration));
+}
+
 // Test that thread and process names show up in the trace
 TEST_F(TraceEventTestFixture, ThreadNames) {
   // Create threads before we enable tracing to make sure
@@ -44,6 +44,7 @@
 #include "base/trace_event/process_memory_dump.h"
 #include "base/trace_event/trace_buffer.h"
 #include "base/trace_event/trace_event.h"
+#include "base/trace_event/trace_event_binary_format.h"
 #include "build/build_config.h"
 
 #if defined(OS_WIN)
@@ -68,17 +69,21 @@ const size_t kTraceBufferChunkSize = TraceBufferChunk::kTraceBufferChunkSize;
 const size_t kTraceEventVectorBigBufferChunks =
     512000000 / kTraceBufferChunkSize;
 static_assert(
-    kTraceEventVectorBigBufferChunks <= TraceBufferChunk::kMaxChunkIndex,
+    kTraceEventVectorBigBufferChunks < TraceBufferChunk::kMaxChunkIndex,
     "Too many big buffer chunks");
 const size_t kTraceEventVectorBufferChunks = 256000 / kTraceBufferChunkSize;
 static_assert(
-    kTraceEventVectorBufferChunks <= TraceBufferChunk::kMaxChunkIndex,
+    kTraceEventVectorBufferChunks < TraceBufferChunk::kMaxChunkIndex,
     "Too many vector buffer chunks");
 const size_t kTraceEventRingBufferChunks = kTraceEventVectorBufferChunks / 4;
 
 // ECHO_TO_CONSOLE needs a small buffer to hold the unfinished COMPLETE events.
 const size_t kEchoToConsoleTraceEventBufferChunks = 256;
 
+// Chunk index of the handles of events that are still in a thread's
+// ThreadLocalEventBuffer. The buffers above never hand it out.
+const size_t kThreadLocalChunkIndex = TraceBufferChunk::kMaxChunkIndex;
+
 const size_t kTraceEventBufferSizeInBytes = 100 * 1024;
 const int kThreadFlushTimeoutMs = 3000;
 
@@ -143,6 +148,44 @@ class AutoThreadLocalBoolean {
   DISALLOW_COPY_AND_ASSIGN(AutoThreadLocalBoolean);
 };
 
+// Returns true if |chunk| contains a COMPLETE event whose duration wasn't
+// set yet.
+bool HasIncompleteEvent(const TraceBufferChunk& chunk) {
+  for (size_t i = 0; i < chunk.size(); ++i) {
+    const TraceEvent* trace_event = chunk.GetEventAt(i);
+    if (trace_event->phase() == TRACE_EVENT_PHASE_COMPLETE &&
+        trace_event->duration().ToInternalValue() == -1) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Passes the events of |logged_events| to |flush_output_callback| as a binary
+// trace, in strings of about kTraceEventBufferSizeInBytes.
+void ConvertTraceEventsToBinaryFormat(
+    TraceBuffer* logged_events,
+    const TraceLog::OutputCallback& flush_output_callback,
+    const ArgumentFilterPredicate& argument_filter_predicate) {
+  const size_t kReserveCapacity = kTraceEventBufferSizeInBytes * 5 / 4;
+  TraceEventBinaryWriter writer;
+  scoped_refptr<RefCountedString> events_str_ptr = new RefCountedString();
+  events_str_ptr->data().reserve(kReserveCapacity);
+  TraceEventBinaryWriter::AppendHeader(&events_str_ptr->data());
+  while (const TraceBufferChunk* chunk = logged_events->NextChunk()) {
+    for (size_t j = 0; j < chunk->size(); ++j) {
+      if (events_str_ptr->size() > kTraceEventBufferSizeInBytes) {
+        flush_output_callback.Run(events_str_ptr, true);
+        events_str_ptr = new RefCountedString();
+        events_str_ptr->data().reserve(kReserveCapacity);
+      }
+      writer.AppendEvent(*chunk->GetEventAt(j), argument_filter_predicate,
+                         &events_str_ptr->data());
+    }
+  }
+  flush_output_callback.Run(events_str_ptr, false);
+}
+
 // Use this function instead of TraceEventHandle constructor to keep the
 // overhead of ScopedTracer (trace_event.h) constructor minimum.
 void MakeHandle(uint32_t chunk_seq,
@@ -200,23 +243,37 @@ class TraceLog::ThreadLocalEventBuffer
     : public MessageLoopCurrent::DestructionObserver,
       public MemoryDumpProvider {
  public:
+  // Number of chunks a thread fills before merging them into the main buffer.
+  // Events are recorded without taking |trace_log_->lock_| in between.
+  static constexpr size_t kMaxChunks = 8;
+
+  // Number of merged chunks containing incomplete COMPLETE events whose
+  // handles can still be resolved. Only the innermost ones are likely to be
+  // ended at this point, so this doesn't need to be larger than the usual
+  // nesting depth of trace events.
+  static constexpr size_t kMaxMergedChunks = 16;
+
   explicit ThreadLocalEventBuffer(TraceLog* trace_log);
   ~ThreadLocalEventBuffer() override;
 
   TraceEvent* AddTraceEvent(TraceEventHandle* handle);
 
-  TraceEvent* GetEventByHandle(TraceEventHandle handle) {
-    if (!chunk_ || handle.chunk_seq != chunk_->seq() ||
-        handle.chunk_index != chunk_index_) {
-      return nullptr;
-    }
-
-    return chunk_->GetEventAt(handle.event_index);
-  }
+  // Returns the event for |handle| if it is still in this buffer. Otherwise,
+  // if it was merged into the main buffer, updates |handle| to refer to it
+  // there, and returns nullptr.
+  TraceEvent* GetEventByHandle(TraceEventHandle* handle);
 
   int generation() const { return generation_; }
 
  private:
+  // A chunk that was merged into the main buffer while it contained
+  // incomplete events.
+  struct MergedChunk {
+    uint32_t local_seq = 0;
+    size_t chunk_index = 0;
+    uint32_t chunk_seq = 0;
+  };
+
   // MessageLoopCurrent::DestructionObserver
   void WillDestroyCurrentMessageLoop() override;
 
@@ -224,6 +281,7 @@ class TraceLog::ThreadLocalEventBuffer
   bool OnMemoryDump(const MemoryDumpArgs& args,
                     ProcessMemoryDump* pmd) override;
 
+  // Moves the filled chunks into the main buffer.
   void FlushWhileLocked();
 
   void CheckThisIsCurrentBuffer() const {
@@ -233,8 +291,20 @@ class TraceLog::ThreadLocalEventBuffer
   // Since TraceLog is a leaky singleton, trace_log_ will always be valid
   // as long as the thread exists.
   TraceLog* trace_log_;
-  std::unique_ptr<TraceBufferChunk> chunk_;
-  size_t chunk_index_;
+
+  // |chunks_[0, num_chunks_)| hold the events that weren't merged into the
+  // main buffer yet; the last of them is being filled. The remaining non-null
+  // chunks are empty and reused once the former ones are merged. Chunks hold
+  // sequence numbers local to this buffer until they're merged.
+  std::unique_ptr<TraceBufferChunk> chunks_[kMaxChunks];
+  size_t num_chunks_;
+  uint32_t next_local_seq_;
+
+  // Circular list of the last kMaxMergedChunks chunks merged while they
+  // contained incomplete events.
+  MergedChunk merged_chunks_[kMaxMergedChunks];
+  size_t next_merged_chunk_;
+
   int generation_;
 
   DISALLOW_COPY_AND_ASSIGN(ThreadLocalEventBuffer);
@@ -242,7 +312,9 @@ class TraceLog::ThreadLocalEventBuffer
 
 TraceLog::ThreadLocalEventBuffer::ThreadLocalEventBuffer(TraceLog* trace_log)
     : trace_log_(trace_log),
-      chunk_index_(0),
+      num_chunks_(0),
+      next_local_seq_(1),
+      next_merged_chunk_(0),
       generation_(trace_log->generation()) {
   // ThreadLocalEventBuffer is created only if the thread has a message loop, so
   // the following message_loop won't be NULL.
@@ -274,54 +346,101 @@ TraceEvent* TraceLog::ThreadLocalEventBuffer::AddTraceEvent(
     TraceEventHandle* handle) {
   CheckThisIsCurrentBuffer();
 
-  if (chunk_ && chunk_->IsFull()) {
-    AutoLock lock(trace_log_->lock_);
-    FlushWhileLocked();
-    chunk_.reset();
-  }
-  if (!chunk_) {
-    AutoLock lock(trace_log_->lock_);
-    chunk_ = trace_log_->logged_events_->GetChunk(&chunk_index_);
-    trace_log_->CheckIfBufferIsFullWhileLocked();
+  if (!num_chunks_ || chunks_[num_chunks_ - 1]->IsFull()) {
+    if (num_chunks_ == kMaxChunks) {
+      AutoLock lock(trace_log_->lock_);
+      FlushWhileLocked();
+    }
+    std::unique_ptr<TraceBufferChunk>& chunk = chunks_[num_chunks_++];
+    // 0 isn't a valid chunk sequence number.
+    if (!next_local_seq_)
+      ++next_local_seq_;
+    if (chunk)
+      chunk->Reset(next_local_seq_++);
+    else
+      chunk.reset(new TraceBufferChunk(next_local_seq_++));
   }
-  if (!chunk_)
-    return nullptr;
 
+  TraceBufferChunk* chunk = chunks_[num_chunks_ - 1].get();
   size_t event_index;
-  TraceEvent* trace_event = chunk_->AddTraceEvent(&event_index);
-  if (trace_event && handle)
-    MakeHandle(chunk_->seq(), chunk_index_, event_index, handle);
-
+  TraceEvent* trace_event = chunk->AddTraceEvent(&event_index);
+  if (handle) {
+    handle->chunk_seq = chunk->seq();
+    handle->chunk_index = kThreadLocalChunkIndex;
+    handle->event_index = static_cast<unsigned>(event_index);
+  }
   return trace_event;
 }
 
+TraceEvent* TraceLog::ThreadLocalEventBuffer::GetEventByHandle(
+    TraceEventHandle* handle) {
+  if (handle->chunk_index != kThreadLocalChunkIndex)
+    return nullptr;
+
+  for (size_t i = 0; i < num_chunks_; ++i) {
+    if (chunks_[i]->seq() == handle->chunk_seq)
+      return chunks_[i]->GetEventAt(handle->event_index);
+  }
+  for (const MergedChunk& merged_chunk : merged_chunks_) {
+    if (merged_chunk.local_seq == handle->chunk_seq) {
+      handle->chunk_seq = merged_chunk.chunk_seq;
+      handle->chunk_index = merged_chunk.chunk_index;
+      break;
+    }
+  }
+  return nullptr;
+}
+
 void TraceLog::ThreadLocalEventBuffer::WillDestroyCurrentMessageLoop() {
   delete this;
 }
 
 bool TraceLog::ThreadLocalEventBuffer::OnMemoryDump(const MemoryDumpArgs& args,
                                                     ProcessMemoryDump* pmd) {
-  if (!chunk_)
+  if (!chunks_[0])
     return true;
   std::string dump_base_name = StringPrintf(
       "tracing/thread_%d", static_cast<int>(PlatformThread::CurrentId()));
   TraceEventMemoryOverhead overhead;
-  chunk_->EstimateTraceMemoryOverhead(&overhead);
+  for (const auto& chunk : chunks_) {
+    if (chunk)
+      chunk->EstimateTraceMemoryOverhead(&overhead);
+  }
   overhead.DumpInto(dump_base_name.c_str(), pmd);
   return true;
 }
 
 void TraceLog::ThreadLocalEventBuffer::FlushWhileLocked() {
-  if (!chunk_)
+  if (!num_chunks_)
     return;
 
   trace_log_->lock_.AssertAcquired();
+  // Merge the chunks into the buffer only if the generation matches. Otherwise
+  // this method may be called from the destructor, or TraceLog will find the
+  // generation mismatch and delete this buffer soon.
   if (trace_log_->CheckGeneration(generation_)) {
-    // Return the chunk to the buffer only if the generation matches.
-    trace_log_->logged_events_->ReturnChunk(chunk_index_, std::move(chunk_));
+    for (size_t i = 0; i < num_chunks_; ++i) {
+      // Swap the filled chunk with the empty one handed out by the main
+      // buffer, which is reused by this buffer, so that merging doesn't copy
+      // events.
+      size_t chunk_index;
+      std::unique_ptr<TraceBufferChunk> chunk =
+          trace_log_->logged_events_->GetChunk(&chunk_index);
+      if (!chunk)
+        break;
+      const uint32_t local_seq = chunks_[i]->seq();
+      chunks_[i]->set_seq(chunk->seq());
+      if (HasIncompleteEvent(*chunks_[i])) {
+        merged_chunks_[next_merged_chunk_] = {local_seq, chunk_index,
+                                              chunk->seq()};
+        next_merged_chunk_ = (next_merged_chunk_ + 1) % kMaxMergedChunks;
+      }
+      chunks_[i].swap(chunk);
+      trace_log_->logged_events_->ReturnChunk(chunk_index, std::move(chunk));
+    }
+    trace_log_->CheckIfBufferIsFullWhileLocked();
   }
-  // Otherwise this method may be called from the destructor, or TraceLog will
-  // find the generation mismatch and delete this buffer soon.
+  num_chunks_ = 0;
 }
 
 void TraceLog::SetAddTraceEventOverride(
@@ -370,6 +489,7 @@ TraceLog::TraceLog()
       thread_shared_chunk_index_(0),
       generation_(0),
       use_worker_thread_(false),
+      output_format_(JSON_OUTPUT_FORMAT),
       trace_event_override_(0),
       filter_factory_for_testing_(nullptr) {
   CategoryRegistry::Initialize();
@@ -833,18 +953,26 @@ void TraceLog::CheckIfBufferIsFullWhileLocked() {
 // 4. If any thread hasn't finish its flush in time, finish the flush.
 void TraceLog::Flush(const TraceLog::OutputCallback& cb,
                      bool use_worker_thread) {
-  FlushInternal(cb, use_worker_thread, false);
+  FlushInternal(cb, JSON_OUTPUT_FORMAT, use_worker_thread, false);
+}
+
+void TraceLog::FlushWithOutputFormat(OutputFormat output_format,
+                                     const OutputCallback& cb,
+                                     bool use_worker_thread) {
+  FlushInternal(cb, output_format, use_worker_thread, false);
 }
 
 void TraceLog::CancelTracing(const OutputCallback& cb) {
   SetDisabled();
-  FlushInternal(cb, false, true);
+  FlushInternal(cb, JSON_OUTPUT_FORMAT, false, true);
 }
 
 void TraceLog::FlushInternal(const TraceLog::OutputCallback& cb,
+                             OutputFormat output_format,
                              bool use_worker_thread,
                              bool discard_events) {
   use_worker_thread_ = use_worker_thread;
+  output_format_ = output_format;
   if (IsEnabled()) {
     // Can't flush when tracing is enabled because otherwise PostTask would
     // - generate more trace events;
@@ -899,12 +1027,19 @@ void TraceLog::FlushInternal(const TraceLog::OutputCallback& cb,
 // Usually it runs on a different thread.
 void TraceLog::ConvertTraceEventsToTraceFormat(
     std::unique_ptr<TraceBuffer> logged_events,
+    OutputFormat output_format,
     const OutputCallback& flush_output_callback,
     const ArgumentFilterPredicate& argument_filter_predicate) {
   if (flush_output_callback.is_null())
     return;
 
   HEAP_PROFILER_SCOPED_IGNORE;
+  if (output_format == BINARY_OUTPUT_FORMAT) {
+    ConvertTraceEventsToBinaryFormat(logged_events.get(), flush_output_callback,
+                                     argument_filter_predicate);
+    return;
+  }
+
   // The callback need to be called at least once even if there is no events
   // to let the caller know the completion of flush.
   scoped_refptr<RefCountedString> json_events_str_ptr = new RefCountedString();
@@ -966,13 +1101,13 @@ void TraceLog::FinishFlush(int generation, bool discard_events) {
         {MayBlock(), TaskPriority::BACKGROUND,
          TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN},
         BindOnce(&TraceLog::ConvertTraceEventsToTraceFormat,
-                 std::move(previous_logged_events), flush_output_callback,
-                 argument_filter_predicate));
+                 std::move(previous_logged_events), output_format_,
+                 flush_output_callback, argument_filter_predicate));
     return;
   }
 
   ConvertTraceEventsToTraceFormat(std::move(previous_logged_events),
-                                  flush_output_callback,
+                                  output_format_, flush_output_callback,
                                   argument_filter_predicate);
 }
 
@@ -1616,10 +1751,12 @@ TraceEvent* TraceLog::GetEventByHandleInternal(TraceEventHandle handle,
 
   if (thread_local_event_buffer_.Get()) {
     TraceEvent* trace_event =
-        thread_local_event_buffer_.Get()->GetEventByHandle(handle);
+        thread_local_event_buffer_.Get()->GetEventByHandle(&handle);
     if (trace_event)
       return trace_event;
   }
+  if (handle.chunk_index == kThreadLocalChunkIndex)
+    return nullptr;
 
   // The event has been out-of-control of the thread local buffer.
   // Try to get the event from the main buffer with a lock.
@@ -175,6 +175,22 @@ class BASE_EXPORT TraceLog : public MemoryDumpProvider {
                               bool has_more_events)> OutputCallback;
   void Flush(const OutputCallback& cb, bool use_worker_thread = false);
 
+  // Formats of the trace strings passed to the OutputCallback of Flush().
+  enum OutputFormat {
+    // JSON trace events, to be joined by TraceResultBuffer.
+    JSON_OUTPUT_FORMAT,
+    // A binary trace (see trace_event_binary_format.h) split across the calls
+    // to the callback, whose strings must be concatenated in order. This is
+    // much smaller and faster to produce than JSON.
+    BINARY_OUTPUT_FORMAT,
+  };
+
+  // Like Flush(), but with the given |output_format| instead of
+  // JSON_OUTPUT_FORMAT.
+  void FlushWithOutputFormat(OutputFormat output_format,
+                             const OutputCallback& cb,
+                             bool use_worker_thread = false);
+
   // Cancels tracing and discards collected data.
   void CancelTracing(const OutputCallback& cb);
 
@@ -416,6 +432,7 @@ class BASE_EXPORT TraceLog : public MemoryDumpProvider {
                                        OptionalAutoLock* lock);
 
   void FlushInternal(const OutputCallback& cb,
+                     OutputFormat output_format,
                      bool use_worker_thread,
                      bool discard_events);
 
@@ -425,6 +442,7 @@ class BASE_EXPORT TraceLog : public MemoryDumpProvider {
   // Usually it runs on a different thread.
   static void ConvertTraceEventsToTraceFormat(
       std::unique_ptr<TraceBuffer> logged_events,
+      OutputFormat output_format,
       const TraceLog::OutputCallback& flush_output_callback,
       const ArgumentFilterPredicate& argument_filter_predicate);
   void FinishFlush(int generation, bool discard_events);
@@ -515,6 +533,7 @@ class BASE_EXPORT TraceLog : public MemoryDumpProvider {
   ArgumentFilterPredicate argument_filter_predicate_;
   subtle::AtomicWord generation_;
   bool use_worker_thread_;
+  OutputFormat output_format_;
   subtle::AtomicWord trace_event_override_;
 
   FilterFactoryForTesting filter_factory_for_testing_;
@@ -7,14 +7,83 @@
 #include <stddef.h>
 
 #include <algorithm>
+#include <map>
+#include <utility>
 #include <vector>
 
 #include "base/logging.h"
 #include "base/macros.h"
 #include "base/memory/aligned_memory.h"
+#include "base/no_destructor.h"
+#include "base/threading/thread_local_storage.h"
 
 namespace {
 const size_t kDefaultNumElementTypesToReserve = 32;
+
+// The most memory a thread keeps in its ChunkPool.
+const size_t kMaxPooledChunkBytes = 4 * 1024 * 1024;
+
+// Keeps the memory of the InnerLists freed on a thread for the next ones
+// allocated there. The lists of the render passes of each frame are freed once
+// it is drawn, so this lets the next frames reuse their memory instead of
+// allocating it again.
+class ChunkPool {
+ public:
+  using Chunk = std::unique_ptr<char[], base::AlignedFreeDeleter>;
+
+  // Returns the pool of the current thread.
+  static ChunkPool* Get() {
+    static base::NoDestructor<base::ThreadLocalStorage::Slot> pool_slot(
+        &Delete);
+    ChunkPool* pool = static_cast<ChunkPool*>(pool_slot->Get());
+    if (!pool) {
+      pool = new ChunkPool;
+      pool_slot->Set(pool);
+    }
+    return pool;
+  }
+
+  // Returns a chunk of at least |bytes| bytes aligned to |alignment|, and its
+  // size in |chunk_bytes|.
+  Chunk Allocate(size_t bytes, size_t alignment, size_t* chunk_bytes) {
+    // Don't waste more than half of a pooled chunk.
+    auto end = free_chunks_.upper_bound(2 * bytes);
+    for (auto it = free_chunks_.lower_bound(bytes); it != end; ++it) {
+      if (it->second.alignment < alignment)
+        continue;
+      *chunk_bytes = it->first;
+      Chunk chunk = std::move(it->second.data);
+      free_chunks_.erase(it);
+      pooled_bytes_ -= *chunk_bytes;
+      return chunk;
+    }
+
+    *chunk_bytes = bytes;
+    return Chunk(static_cast<char*>(base::AlignedAlloc(bytes, alignment)));
+  }
+
+  // Takes |chunk| of |bytes| bytes aligned to |alignment|, or frees it if the
+  // pool is full.
+  void Release(Chunk chunk, size_t bytes, size_t alignment) {
+    if (!chunk || pooled_bytes_ + bytes > kMaxPooledChunkBytes)
+      return;
+    pooled_bytes_ += bytes;
+    free_chunks_.emplace(bytes, FreeChunk{std::move(chunk), alignment});
+  }
+
+ private:
+  struct FreeChunk {
+    Chunk data;
+    size_t alignment;
+  };
+
+  static void Delete(void* pool) { delete static_cast<ChunkPool*>(pool); }
+
+  // Keyed by size in bytes.
+  std::multimap<size_t, FreeChunk> free_chunks_;
+  size_t pooled_bytes_ = 0;
+};
+
 }  // namespace
 
 namespace cc {
@@ -40,8 +109,17 @@ class ListContainerHelper::CharAllocator {
     // The size of each element is in bytes. This is used to move from between
     // elements' memory locations.
     size_t step;
+    // The size of |data| in bytes, and its alignment. These are used to return
+    // it to the ChunkPool.
+    size_t data_bytes;
+    size_t data_alignment;
 
-    InnerList() : capacity(0), size(0), step(0) {}
+    InnerList()
+        : capacity(0), size(0), step(0), data_bytes(0), data_alignment(0) {}
+
+    ~InnerList() {
+      ChunkPool::Get()->Release(std::move(data), data_bytes, data_alignment);
+    }
 
     void Erase(char* position) {
       // Confident that destructor is called by caller of this function. Since
@@ -77,7 +155,10 @@ class ListContainerHelper::CharAllocator {
       // Copy the data after the inserted segment.
       memcpy(new_data.get() + position_offset + count * step,
              data.get() + position_offset, old_size * step - position_offset);
+      ChunkPool::Get()->Release(std::move(data), data_bytes, data_alignment);
       data = std::move(new_data);
+      data_bytes = size * step;
+      data_alignment = alignment;
     }
 
     bool IsEmpty() const { return !size; }
@@ -243,8 +324,9 @@ class ListContainerHelper::CharAllocator {
     new_list->capacity = list_size;
     new_list->size = 0;
     new_list->step = element_size_;
-    new_list->data.reset(static_cast<char*>(
-        base::AlignedAlloc(list_size * element_size_, alignment_)));
+    new_list->data = ChunkPool::Get()->Allocate(
+        list_size * element_size_, alignment_, &new_list->data_bytes);
+    new_list->data_alignment = alignment_;
     storage_.push_back(std::move(new_list));
   }
 
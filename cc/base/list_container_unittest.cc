@@ -1222,5 +1222,24 @@ TEST(ListContainerTest, GetCapacityInBytes) {
   }
 }
 
+TEST(ListContainerTest, ReusesMemoryOfDestroyedList) {
+  const size_t initial_capacity = 37;
+  DerivedElement* first_element;
+  {
+    ListContainer<DerivedElement> list(kLargestDerivedElementAlign,
+                                       kLargestDerivedElementSize,
+                                       initial_capacity);
+    first_element = list.AllocateAndConstruct<DerivedElement1>();
+  }
+
+  // A list created later on the same thread gets the memory back.
+  ListContainer<DerivedElement> list(kLargestDerivedElementAlign,
+                                     kLargestDerivedElementSize,
+                                     initial_capacity);
+  EXPECT_EQ(first_element, list.AllocateAndConstruct<DerivedElement2>());
+  EXPECT_EQ(initial_capacity - 1,
+            list.AvailableSizeWithoutAnotherAllocationForTesting());
+}
+
 }  // namespace
 }  // namespace cc
@@ -7,8 +7,10 @@
 
 #include <stddef.h>
 
+#include "base/logging.h"
 #include "cc/cc_export.h"
 #include "cc/paint/display_item_list.h"
+#include "cc/paint/paint_record.h"
 
 namespace gfx {
 class Rect;
@@ -41,6 +43,21 @@ class CC_EXPORT ContentLayerClient {
   virtual scoped_refptr<DisplayItemList> PaintContentsToDisplayList(
       PaintingControlSetting painting_control) = 0;
 
+  // Clients that can record any part of the layer on its own return true, and
+  // implement PaintContentsToRecord(). The layer is then recorded as a chunked
+  // DisplayItemList, and an invalidation only re-records the chunks it
+  // touches, rather than the whole layer.
+  virtual bool SupportsChunkedRecording() const { return false; }
+
+  // Returns a recording of everything that draws into |layer_rect|. It is
+  // clipped to |layer_rect| when rastered.
+  virtual sk_sp<PaintRecord> PaintContentsToRecord(
+      const gfx::Rect& layer_rect,
+      PaintingControlSetting painting_control) {
+    NOTREACHED();
+    return nullptr;
+  }
+
   // If true the layer may skip clearing the background before rasterizing,
   // because it will cover any uncleared data with content.
   virtual bool FillsBoundsCompletely() const = 0;
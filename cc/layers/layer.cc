@@ -639,7 +639,8 @@ void Layer::SetPosition(const gfx::PointF& position) {
     transform_node->update_post_local_transform(position, transform_origin());
     transform_node->needs_local_transform_update = true;
     transform_node->transform_changed = true;
-    layer_tree_host_->property_trees()->transform_tree.set_needs_update(true);
+    layer_tree_host_->property_trees()->transform_tree.SetNodeNeedsUpdate(
+        transform_node->id);
   } else {
     SetPropertyTreesNeedRebuild();
   }
@@ -717,7 +718,8 @@ void Layer::SetTransformOrigin(const gfx::Point3F& transform_origin) {
     transform_node->update_post_local_transform(position(), transform_origin);
     transform_node->needs_local_transform_update = true;
     transform_node->transform_changed = true;
-    layer_tree_host_->property_trees()->transform_tree.set_needs_update(true);
+    layer_tree_host_->property_trees()->transform_tree.SetNodeNeedsUpdate(
+        transform_node->id);
   } else {
     SetPropertyTreesNeedRebuild();
   }
@@ -825,7 +827,7 @@ void Layer::UpdateScrollOffset(const gfx::ScrollOffset& scroll_offset) {
   DCHECK_EQ(transform_tree_index(), transform_node->id);
   transform_node->scroll_offset = CurrentScrollOffset();
   transform_node->needs_local_transform_update = true;
-  property_trees.transform_tree.set_needs_update(true);
+  property_trees.transform_tree.SetNodeNeedsUpdate(transform_node->id);
 }
 
 void Layer::SetScrollable(const gfx::Size& bounds) {
@@ -121,9 +121,16 @@ bool PictureLayer::Update() {
       picture_layer_inputs_.recorded_viewport);
 
   if (updated) {
-    picture_layer_inputs_.display_list =
-        picture_layer_inputs_.client->PaintContentsToDisplayList(
-            ContentLayerClient::PAINTING_BEHAVIOR_NORMAL);
+    if (picture_layer_inputs_.client->SupportsChunkedRecording()) {
+      picture_layer_inputs_.display_list =
+          recording_source_->RecordChunkedDisplayItemList(
+              picture_layer_inputs_.client, last_updated_invalidation_,
+              layer_tree_host()->recording_scale_factor());
+    } else {
+      picture_layer_inputs_.display_list =
+          picture_layer_inputs_.client->PaintContentsToDisplayList(
+              ContentLayerClient::PAINTING_BEHAVIOR_NORMAL);
+    }
     picture_layer_inputs_.painter_reported_memory_usage =
         picture_layer_inputs_.client->GetApproximateUnsharedMemoryUsage();
     recording_source_->UpdateDisplayItemList(
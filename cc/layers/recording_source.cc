@@ -7,7 +7,10 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <utility>
+#include <vector>
 
+#include "base/containers/flat_map.h"
 #include "base/numerics/safe_math.h"
 #include "cc/base/region.h"
 #include "cc/layers/content_layer_client.h"
@@ -25,6 +28,8 @@ const int kMaxOpsToAnalyzeForLayer = 10;
 
 namespace cc {
 
+const int RecordingSource::kChunkSize = 256;
+
 RecordingSource::RecordingSource()
     : slow_down_raster_scale_factor_for_debug_(0),
       requires_clear_(false),
@@ -91,6 +96,58 @@ bool RecordingSource::UpdateAndExpandInvalidation(
   return true;
 }
 
+scoped_refptr<DisplayItemList> RecordingSource::RecordChunkedDisplayItemList(
+    ContentLayerClient* client,
+    const Region& invalidation,
+    float recording_scale_factor) const {
+  TRACE_EVENT0("cc", "RecordingSource::RecordChunkedDisplayItemList");
+  DCHECK(client->SupportsChunkedRecording());
+
+  // The chunks of the current display list, by the position of their bounds.
+  base::flat_map<std::pair<int, int>, scoped_refptr<DisplayItemList::Chunk>>
+      current_chunks;
+  if (display_list_ && recording_scale_factor == recording_scale_factor_) {
+    std::vector<
+        std::pair<std::pair<int, int>, scoped_refptr<DisplayItemList::Chunk>>>
+        chunks;
+    chunks.reserve(display_list_->chunks().size());
+    for (const auto& chunk : display_list_->chunks()) {
+      chunks.emplace_back(
+          std::make_pair(chunk->bounds().y(), chunk->bounds().x()), chunk);
+    }
+    current_chunks = base::flat_map<std::pair<int, int>,
+                                    scoped_refptr<DisplayItemList::Chunk>>(
+        std::move(chunks));
+  }
+
+  auto display_list = base::MakeRefCounted<DisplayItemList>();
+  for (int y = recorded_viewport_.y() / kChunkSize * kChunkSize;
+       y < recorded_viewport_.bottom(); y += kChunkSize) {
+    for (int x = recorded_viewport_.x() / kChunkSize * kChunkSize;
+         x < recorded_viewport_.right(); x += kChunkSize) {
+      gfx::Rect layer_rect = gfx::IntersectRects(
+          gfx::Rect(x, y, kChunkSize, kChunkSize), recorded_viewport_);
+      // Rounding, rather than taking the enclosing rect, keeps the bounds of
+      // adjacent chunks from overlapping.
+      gfx::Rect bounds =
+          gfx::ScaleToRoundedRect(layer_rect, recording_scale_factor);
+
+      auto it = current_chunks.find(std::make_pair(bounds.y(), bounds.x()));
+      if (it != current_chunks.end() && it->second->bounds() == bounds &&
+          !invalidation.Intersects(layer_rect)) {
+        display_list->AppendChunk(it->second);
+        continue;
+      }
+
+      display_list->AppendChunk(base::MakeRefCounted<DisplayItemList::Chunk>(
+          bounds, client->PaintContentsToRecord(
+                      layer_rect, ContentLayerClient::PAINTING_BEHAVIOR_NORMAL)));
+    }
+  }
+  display_list->Finalize();
+  return display_list;
+}
+
 void RecordingSource::UpdateDisplayItemList(
     const scoped_refptr<DisplayItemList>& display_list,
     const size_t& painter_reported_memory_usage,
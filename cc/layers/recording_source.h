@@ -19,6 +19,7 @@
 
 namespace cc {
 
+class ContentLayerClient;
 class DisplayItemList;
 class RasterSource;
 class Region;
@@ -35,12 +36,25 @@ class CC_EXPORT RecordingSource {
     RECORDING_MODE_COUNT,  // Must be the last entry.
   };
 
+  // The size, in layer pixels, of the chunks that
+  // RecordChunkedDisplayItemList() records.
+  static const int kChunkSize;
+
   RecordingSource();
   virtual ~RecordingSource();
 
   bool UpdateAndExpandInvalidation(Region* invalidation,
                                    const gfx::Size& layer_size,
                                    const gfx::Rect& new_recorded_viewport);
+  // Records |client|'s content for the recorded viewport as a chunked
+  // DisplayItemList, one chunk per square of kChunkSize layer pixels. Chunks
+  // of the current display list that don't intersect |invalidation| are
+  // reused, unless the recording scale factor changed. The client must support
+  // chunked recording.
+  scoped_refptr<DisplayItemList> RecordChunkedDisplayItemList(
+      ContentLayerClient* client,
+      const Region& invalidation,
+      float recording_scale_factor) const;
   void UpdateDisplayItemList(const scoped_refptr<DisplayItemList>& display_list,
                              const size_t& painter_reported_memory_usage,
                              float recording_scale_factor);
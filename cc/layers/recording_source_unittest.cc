@@ -2,9 +2,11 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <utility>
 #include <vector>
 
 #include "cc/base/region.h"
+#include "cc/paint/paint_op_buffer.h"
 #include "cc/raster/raster_source.h"
 #include "cc/test/fake_content_layer_client.h"
 #include "cc/test/fake_recording_source.h"
@@ -12,6 +14,7 @@
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "third_party/skia/include/core/SkRefCnt.h"
+#include "ui/gfx/skia_util.h"
 
 namespace cc {
 namespace {
@@ -20,6 +23,38 @@ gfx::ColorSpace DefaultColorSpace() {
   return gfx::ColorSpace::CreateSRGB();
 }
 
+// Records a rect filling each chunk, and |image| at |image_point|, and counts
+// the chunks it records.
+class ChunkedContentLayerClient : public FakeContentLayerClient {
+ public:
+  ChunkedContentLayerClient() = default;
+
+  void set_image(PaintImage image, const gfx::Point& image_point) {
+    image_ = std::move(image);
+    image_point_ = image_point;
+  }
+  int num_recorded_chunks() const { return num_recorded_chunks_; }
+
+  bool SupportsChunkedRecording() const override { return true; }
+  sk_sp<PaintRecord> PaintContentsToRecord(
+      const gfx::Rect& layer_rect,
+      PaintingControlSetting painting_control) override {
+    ++num_recorded_chunks_;
+    auto record = sk_make_sp<PaintOpBuffer>();
+    record->push<DrawRectOp>(gfx::RectToSkRect(layer_rect), PaintFlags());
+    if (image_ && layer_rect.Contains(image_point_)) {
+      record->push<DrawImageOp>(image_, image_point_.x(), image_point_.y(),
+                                nullptr);
+    }
+    return record;
+  }
+
+ private:
+  PaintImage image_;
+  gfx::Point image_point_;
+  int num_recorded_chunks_ = 0;
+};
+
 std::unique_ptr<FakeRecordingSource> CreateRecordingSource(
     const gfx::Rect& viewport) {
   gfx::Rect layer_rect(viewport.right(), viewport.bottom());
@@ -386,5 +421,53 @@ TEST(RecordingSourceTest, AnalyzeIsSolid) {
   }
 }
 
+// Only the chunks that intersect the invalidation are recorded again.
+TEST(RecordingSourceTest, ChunkedRecording) {
+  gfx::Size layer_size(2 * RecordingSource::kChunkSize,
+                       2 * RecordingSource::kChunkSize);
+  ChunkedContentLayerClient client;
+  client.set_bounds(layer_size);
+  RecordingSource recording_source;
+
+  Region invalidation;
+  EXPECT_TRUE(recording_source.UpdateAndExpandInvalidation(
+      &invalidation, layer_size, gfx::Rect(layer_size)));
+  scoped_refptr<DisplayItemList> display_list =
+      recording_source.RecordChunkedDisplayItemList(&client, invalidation, 1.f);
+  recording_source.UpdateDisplayItemList(display_list, 0u, 1.f);
+  EXPECT_EQ(4, client.num_recorded_chunks());
+  ASSERT_EQ(4u, display_list->chunks().size());
+
+  gfx::Point image_point(RecordingSource::kChunkSize + 10,
+                         RecordingSource::kChunkSize + 10);
+  PaintImage image = CreateDiscardablePaintImage(gfx::Size(32, 32));
+  client.set_image(image, image_point);
+  recording_source.SetNeedsDisplayRect(gfx::Rect(image_point, gfx::Size(32, 32)));
+  invalidation.Clear();
+  EXPECT_TRUE(recording_source.UpdateAndExpandInvalidation(
+      &invalidation, layer_size, gfx::Rect(layer_size)));
+  scoped_refptr<DisplayItemList> new_display_list =
+      recording_source.RecordChunkedDisplayItemList(&client, invalidation, 1.f);
+  recording_source.UpdateDisplayItemList(new_display_list, 0u, 1.f);
+  EXPECT_EQ(5, client.num_recorded_chunks());
+  ASSERT_EQ(4u, new_display_list->chunks().size());
+  for (size_t i = 0; i < 3; ++i)
+    EXPECT_EQ(display_list->chunks()[i], new_display_list->chunks()[i]);
+  EXPECT_NE(display_list->chunks()[3], new_display_list->chunks()[3]);
+  EXPECT_EQ(gfx::Rect(RecordingSource::kChunkSize, RecordingSource::kChunkSize,
+                      RecordingSource::kChunkSize, RecordingSource::kChunkSize),
+            new_display_list->chunks()[3]->bounds());
+
+  // The image of the new chunk is found through the list's metadata.
+  std::vector<const DrawImage*> images;
+  new_display_list->discardable_image_map().GetDiscardableImagesInRect(
+      gfx::Rect(layer_size), &images);
+  ASSERT_EQ(1u, images.size());
+  EXPECT_TRUE(images[0]->paint_image() == image);
+  EXPECT_EQ(1u, new_display_list->discardable_image_map()
+                    .GetRectsForImage(image.stable_id())
+                    ->size());
+}
+
 }  // namespace
 }  // namespace cc
@@ -443,6 +443,60 @@ void DiscardableImageMap::Generate(const PaintOpBuffer* paint_op_buffer,
          size_t index) { return items[index].first; });
 }
 
+void DiscardableImageMap::GenerateFromChunks(
+    std::vector<const DiscardableImageMap*> chunk_maps) {
+  TRACE_EVENT1("cc", "DiscardableImageMap::GenerateFromChunks", "chunks",
+               chunk_maps.size());
+  DCHECK(chunk_maps_.empty());
+
+  bool has_images = false;
+  bool all_images_are_srgb = true;
+  for (const DiscardableImageMap* chunk_map : chunk_maps) {
+    if (chunk_map->empty())
+      continue;
+    has_images = true;
+    all_images_are_srgb &= chunk_map->all_images_are_srgb_;
+
+    for (const auto& id_and_rects : chunk_map->image_id_to_rects_) {
+      auto& rects = image_id_to_rects_[id_and_rects.first];
+      for (const gfx::Rect& rect : id_and_rects.second) {
+        if (rects->size() >= kMaxRectsSize)
+          rects->back().Union(rect);
+        else
+          rects->push_back(rect);
+      }
+    }
+
+    // Chunk maps keep their decoding modes, since they may be shared with
+    // later versions of the list.
+    for (const auto& id_and_mode : chunk_map->decoding_mode_map_) {
+      auto decoding_mode_it = decoding_mode_map_.find(id_and_mode.first);
+      if (decoding_mode_it == decoding_mode_map_.end()) {
+        decoding_mode_map_[id_and_mode.first] = id_and_mode.second;
+      } else {
+        decoding_mode_it->second = PaintImage::GetConservative(
+            decoding_mode_it->second, id_and_mode.second);
+      }
+    }
+
+    animated_images_metadata_.insert(
+        animated_images_metadata_.end(),
+        chunk_map->animated_images_metadata_.begin(),
+        chunk_map->animated_images_metadata_.end());
+  }
+  all_images_are_srgb_ = has_images && all_images_are_srgb;
+
+  chunk_maps_ = std::move(chunk_maps);
+  chunk_maps_rtree_.Build(
+      chunk_maps_,
+      [](const std::vector<const DiscardableImageMap*>& items, size_t index) {
+        return items[index]->images_rtree_.GetBounds();
+      },
+      [](const std::vector<const DiscardableImageMap*>& items, size_t index) {
+        return index;
+      });
+}
+
 base::flat_map<PaintImage::Id, PaintImage::DecodingMode>
 DiscardableImageMap::TakeDecodingModeMap() {
   return std::move(decoding_mode_map_);
@@ -452,6 +506,11 @@ void DiscardableImageMap::GetDiscardableImagesInRect(
     const gfx::Rect& rect,
     std::vector<const DrawImage*>* images) const {
   *images = images_rtree_.SearchRefs(rect);
+  for (size_t index : chunk_maps_rtree_.Search(rect)) {
+    std::vector<const DrawImage*> chunk_images =
+        chunk_maps_[index]->images_rtree_.SearchRefs(rect);
+    images->insert(images->end(), chunk_images.begin(), chunk_images.end());
+  }
 }
 
 const DiscardableImageMap::Rects& DiscardableImageMap::GetRectsForImage(
@@ -465,6 +524,8 @@ void DiscardableImageMap::Reset() {
   image_id_to_rects_.clear();
   image_id_to_rects_.shrink_to_fit();
   images_rtree_.Reset();
+  chunk_maps_.clear();
+  chunk_maps_rtree_.Reset();
 }
 
 DiscardableImageMap::AnimatedImageMetadata::AnimatedImageMetadata(
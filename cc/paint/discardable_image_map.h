@@ -66,6 +66,13 @@ class CC_PAINT_EXPORT DiscardableImageMap {
   void Reset();
   void Generate(const PaintOpBuffer* paint_op_buffer, const gfx::Rect& bounds);
 
+  // Generates the metadata of a chunked display list from that of its chunks,
+  // which must outlive this map. The chunks' images stay in their own rtrees,
+  // so that the cost of updating a chunked list depends on the chunks that
+  // changed and the number of distinct images, rather than on the number of
+  // ops in the list.
+  void GenerateFromChunks(std::vector<const DiscardableImageMap*> chunk_maps);
+
   // This should only be called once from the compositor thread at commit time.
   base::flat_map<PaintImage::Id, PaintImage::DecodingMode>
   TakeDecodingModeMap();
@@ -86,6 +93,11 @@ class CC_PAINT_EXPORT DiscardableImageMap {
   bool all_images_are_srgb_ = false;
 
   RTree<DrawImage> images_rtree_;
+
+  // Set by GenerateFromChunks(). |chunk_maps_rtree_| stores indices into
+  // |chunk_maps_|, keyed by the bounds of each chunk's images.
+  std::vector<const DiscardableImageMap*> chunk_maps_;
+  RTree<size_t> chunk_maps_rtree_;
 };
 
 }  // namespace cc
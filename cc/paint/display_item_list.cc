@@ -7,6 +7,7 @@
 #include <stddef.h>
 
 #include <string>
+#include <utility>
 
 #include "base/trace_event/trace_event.h"
 #include "base/trace_event/trace_event_argument.h"
@@ -44,6 +45,30 @@ DisplayItemList::DisplayItemList(UsageHint usage_hint)
 
 DisplayItemList::~DisplayItemList() = default;
 
+DisplayItemList::Chunk::Chunk(const gfx::Rect& bounds,
+                              sk_sp<const PaintRecord> record)
+    : bounds_(bounds), record_(std::move(record)) {
+  image_map_.Generate(record_.get(), bounds_);
+}
+
+DisplayItemList::Chunk::~Chunk() = default;
+
+void DisplayItemList::AppendChunk(scoped_refptr<Chunk> chunk) {
+  DCHECK_EQ(usage_hint_, kTopLevelDisplayItemList);
+  DCHECK(!chunks_.empty() || paint_op_buffer_.size() == 0);
+
+  if (chunk->record()->size() > 0 && !chunk->bounds().IsEmpty()) {
+    StartPaint();
+    push<SaveOp>();
+    push<ClipRectOp>(gfx::RectToSkRect(chunk->bounds()), SkClipOp::kIntersect,
+                     false);
+    push<DrawRecordOp>(chunk->record());
+    push<RestoreOp>();
+    EndPaintOfUnpaired(chunk->bounds());
+  }
+  chunks_.push_back(std::move(chunk));
+}
+
 void DisplayItemList::Raster(SkCanvas* canvas,
                              ImageProvider* image_provider) const {
   DCHECK(usage_hint_ == kTopLevelDisplayItemList);
@@ -160,6 +185,14 @@ DisplayItemList::CreateTracedValue(bool include_items) const {
 
 void DisplayItemList::GenerateDiscardableImagesMetadata() {
   DCHECK(usage_hint_ == kTopLevelDisplayItemList);
+  if (!chunks_.empty()) {
+    std::vector<const DiscardableImageMap*> chunk_image_maps;
+    chunk_image_maps.reserve(chunks_.size());
+    for (const auto& chunk : chunks_)
+      chunk_image_maps.push_back(&chunk->discardable_image_map());
+    image_map_.GenerateFromChunks(std::move(chunk_image_maps));
+    return;
+  }
   image_map_.Generate(&paint_op_buffer_, rtree_.GetBounds());
 }
 
@@ -172,12 +205,17 @@ void DisplayItemList::Reset() {
   rtree_.Reset();
   image_map_.Reset();
   paint_op_buffer_.Reset();
+  chunks_.clear();
+  chunks_.shrink_to_fit();
   visual_rects_.clear();
   visual_rects_.shrink_to_fit();
   offsets_.clear();
   offsets_.shrink_to_fit();
   begin_paired_indices_.clear();
   begin_paired_indices_.shrink_to_fit();
+
+  base::AutoLock lock(solid_color_cache_lock_);
+  solid_color_cache_.clear();
 }
 
 sk_sp<PaintRecord> DisplayItemList::ReleaseAsRecord() {
@@ -192,6 +230,22 @@ bool DisplayItemList::GetColorIfSolidInRect(const gfx::Rect& rect,
                                             SkColor* color,
                                             int max_ops_to_analyze) {
   DCHECK(usage_hint_ == kTopLevelDisplayItemList);
+  // Bounds the memory used by the cache. Lists are usually analyzed for one
+  // set of tiles, well below this.
+  static const size_t kMaxSolidColorCacheSize = 256;
+
+  const auto key = std::make_pair(rect, max_ops_to_analyze);
+  {
+    base::AutoLock lock(solid_color_cache_lock_);
+    auto it = solid_color_cache_.find(key);
+    if (it != solid_color_cache_.end()) {
+      if (!it->second)
+        return false;
+      *color = *it->second;
+      return true;
+    }
+  }
+
   std::vector<size_t>* offsets_to_use = nullptr;
   std::vector<size_t> offsets;
   if (!rect.Contains(rtree_.GetBounds())) {
@@ -202,6 +256,12 @@ bool DisplayItemList::GetColorIfSolidInRect(const gfx::Rect& rect,
   base::Optional<SkColor> solid_color =
       SolidColorAnalyzer::DetermineIfSolidColor(
           &paint_op_buffer_, rect, max_ops_to_analyze, offsets_to_use);
+  {
+    base::AutoLock lock(solid_color_cache_lock_);
+    if (solid_color_cache_.size() >= kMaxSolidColorCacheSize)
+      solid_color_cache_.clear();
+    solid_color_cache_[key] = solid_color;
+  }
   if (solid_color) {
     *color = *solid_color;
     return true;
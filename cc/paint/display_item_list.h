@@ -11,9 +11,12 @@
 #include <utility>
 #include <vector>
 
+#include "base/containers/flat_map.h"
 #include "base/gtest_prod_util.h"
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
+#include "base/optional.h"
+#include "base/synchronization/lock.h"
 #include "base/trace_event/trace_event.h"
 #include "cc/base/rtree.h"
 #include "cc/paint/discardable_image_map.h"
@@ -157,6 +160,37 @@ class CC_PAINT_EXPORT DisplayItemList
     GrowCurrentBeginItemVisualRect(visual_rect);
   }
 
+  // A part of a chunked display list: a recording of everything that draws
+  // into |bounds|, with its discardable image metadata. Chunks are immutable,
+  // so that the chunks a change doesn't touch can be shared by consecutive
+  // versions of a layer's display list instead of being recorded again.
+  class CC_PAINT_EXPORT Chunk : public base::RefCountedThreadSafe<Chunk> {
+   public:
+    Chunk(const gfx::Rect& bounds, sk_sp<const PaintRecord> record);
+
+    const gfx::Rect& bounds() const { return bounds_; }
+    const sk_sp<const PaintRecord>& record() const { return record_; }
+    const DiscardableImageMap& discardable_image_map() const {
+      return image_map_;
+    }
+
+   private:
+    friend class base::RefCountedThreadSafe<Chunk>;
+    ~Chunk();
+
+    const gfx::Rect bounds_;
+    const sk_sp<const PaintRecord> record_;
+    DiscardableImageMap image_map_;
+
+    DISALLOW_COPY_AND_ASSIGN(Chunk);
+  };
+
+  // Appends |chunk|, clipped to its bounds, as a single item. A list built
+  // from chunks must not have other items, so that its discardable image
+  // metadata can be merged from that of the chunks.
+  void AppendChunk(scoped_refptr<Chunk> chunk);
+  const std::vector<scoped_refptr<Chunk>>& chunks() const { return chunks_; }
+
   // Called after all items are appended, to process the items.
   void Finalize();
 
@@ -186,7 +220,8 @@ class CC_PAINT_EXPORT DisplayItemList
 
   // If a rectangle is solid color, returns that color. |max_ops_to_analyze|
   // indicates the maximum number of draw ops we consider when determining if a
-  // rectangle is solid color.
+  // rectangle is solid color. Results are cached, since tiles sharing this
+  // list are analyzed again when they are recreated.
   bool GetColorIfSolidInRect(const gfx::Rect& rect,
                              SkColor* color,
                              int max_ops_to_analyze = 1);
@@ -217,6 +252,9 @@ class CC_PAINT_EXPORT DisplayItemList
   RTree<size_t> rtree_;
   DiscardableImageMap image_map_;
   PaintOpBuffer paint_op_buffer_;
+  // The chunks appended with AppendChunk(), in order. They own the metadata
+  // that |image_map_| refers to.
+  std::vector<scoped_refptr<Chunk>> chunks_;
 
   // The visual rects associated with each of the display items in the
   // display item list. These rects are intentionally kept separate because they
@@ -230,6 +268,12 @@ class CC_PAINT_EXPORT DisplayItemList
   // with the index.
   std::vector<std::pair<size_t, size_t>> begin_paired_indices_;
 
+  // Results of GetColorIfSolidInRect(), keyed by rect and
+  // |max_ops_to_analyze|.
+  base::Lock solid_color_cache_lock_;
+  base::flat_map<std::pair<gfx::Rect, int>, base::Optional<SkColor>>
+      solid_color_cache_;
+
 #if DCHECK_IS_ON()
   // While recording a range of ops, this is the position in the PaintOpBuffer
   // where the recording started.
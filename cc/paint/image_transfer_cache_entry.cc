@@ -6,11 +6,19 @@
 
 #include "base/logging.h"
 #include "base/numerics/checked_math.h"
+#include "base/optional.h"
 #include "cc/paint/paint_op_reader.h"
 #include "cc/paint/paint_op_writer.h"
+#include "cc/paint/service_image_upload_cache.h"
 #include "third_party/skia/include/gpu/GrContext.h"
 
 namespace cc {
+namespace {
+
+// Larger images are rarely shared, and not worth hashing.
+const size_t kMaxSharedImageBytes = 4 * 1024 * 1024;
+
+}  // namespace
 
 ClientImageTransferCacheEntry::ClientImageTransferCacheEntry(
     const SkPixmap* pixmap,
@@ -94,6 +102,22 @@ size_t ServiceImageTransferCacheEntry::CachedSize() const {
 bool ServiceImageTransferCacheEntry::Deserialize(
     GrContext* context,
     base::span<const uint8_t> data) {
+  size_ = data.size();
+  if (data.size() > kMaxSharedImageBytes)
+    return DeserializeImage(context, data, nullptr);
+
+  // |data| is shared with the client, which could change it after it is
+  // hashed. Work on a copy, so that the image shared with other clients always
+  // matches its key.
+  std::vector<uint8_t> data_copy(data.begin(), data.end());
+  return DeserializeImage(context, data_copy,
+                          ServiceImageUploadCache::GetInstance());
+}
+
+bool ServiceImageTransferCacheEntry::DeserializeImage(
+    GrContext* context,
+    base::span<const uint8_t> data,
+    ServiceImageUploadCache* upload_cache) {
   // We don't need to populate the DeSerializeOptions here since the reader is
   // only used for de-serializing primitives.
   PaintOp::DeserializeOptions options(nullptr, nullptr);
@@ -106,7 +130,6 @@ bool ServiceImageTransferCacheEntry::Deserialize(
   reader.Read(&height);
   size_t pixel_size;
   reader.ReadSize(&pixel_size);
-  size_ = data.size();
   sk_sp<SkColorSpace> pixmap_color_space;
   reader.Read(&pixmap_color_space);
   sk_sp<SkColorSpace> target_color_space;
@@ -133,6 +156,16 @@ bool ServiceImageTransferCacheEntry::Deserialize(
   // a software or GPU SkImage.
   uint32_t max_size = context->maxTextureSize();
   bool fits_on_gpu = width <= max_size && height <= max_size;
+
+  base::Optional<ServiceImageUploadCache::Key> key;
+  if (upload_cache) {
+    key.emplace(data, fits_on_gpu ? context->uniqueID()
+                                  : ServiceImageUploadCache::kNoContextId);
+    image_ = upload_cache->Find(*key);
+    if (image_)
+      return true;
+  }
+
   if (fits_on_gpu) {
     sk_sp<SkImage> image = SkImage::MakeFromRaster(pixmap, nullptr, nullptr);
     if (!image)
@@ -164,7 +197,11 @@ bool ServiceImageTransferCacheEntry::Deserialize(
   // TODO(enne): consider adding in the DeleteSkImageAndPreventCaching
   // optimization from GpuImageDecodeCache where we forcefully remove the
   // intermediate from Skia's cache.
-  return !!image_;
+  if (!image_)
+    return false;
+  if (upload_cache)
+    upload_cache->Insert(*key, image_);
+  return true;
 }
 
 }  // namespace cc
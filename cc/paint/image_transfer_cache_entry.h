@@ -13,6 +13,7 @@
 #include "third_party/skia/include/core/SkImage.h"
 
 namespace cc {
+class ServiceImageUploadCache;
 
 static constexpr uint32_t kInvalidImageTransferCacheEntryId =
     static_cast<uint32_t>(-1);
@@ -59,6 +60,12 @@ class CC_PAINT_EXPORT ServiceImageTransferCacheEntry
   const sk_sp<SkImage>& image() { return image_; }
 
  private:
+  // Creates |image_| from |data|, sharing it through |upload_cache| if not
+  // null.
+  bool DeserializeImage(GrContext* context,
+                        base::span<const uint8_t> data,
+                        ServiceImageUploadCache* upload_cache);
+
   sk_sp<SkImage> image_;
   size_t size_ = 0;
 };
@@ -4,7 +4,18 @@
 
 #include "cc/paint/paint_op_buffer_serializer.h"
 
+#include <string.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "base/barrier_closure.h"
 #include "base/bind.h"
+#include "base/memory/aligned_memory.h"
+#include "base/optional.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/task_runner.h"
+#include "base/trace_event/trace_event.h"
 #include "cc/paint/scoped_raster_flags.h"
 #include "third_party/skia/include/core/SkColorSpaceXformCanvas.h"
 #include "ui/gfx/skia_util.h"
@@ -60,6 +71,21 @@ SkTextBlobCacheDiffCanvas::Settings MakeCanvasSettings(
 // clip is applied to the canvas during serialization.
 const int kMaxExtent = std::numeric_limits<int>::max() >> 1;
 
+// Returns true if serializing |op| may use the image provider, the transfer
+// cache or the strike server, which aren't thread-safe.
+bool UsesSharedResources(const PaintOp* op) {
+  if (PaintOp::OpHasDiscardableImages(op) ||
+      op->GetType() == PaintOpType::DrawTextBlob ||
+      op->GetType() == PaintOpType::ClipPath ||
+      op->GetType() == PaintOpType::DrawPath) {
+    return true;
+  }
+  if (!op->IsPaintOpWithFlags())
+    return false;
+  const PaintFlags& flags = static_cast<const PaintOpWithFlags*>(op)->flags;
+  return flags.getShader() || flags.getImageFilter();
+}
+
 }  // namespace
 
 PaintOpBufferSerializer::PaintOpBufferSerializer(
@@ -115,6 +141,86 @@ void PaintOpBufferSerializer::Serialize(const PaintOpBuffer* buffer,
   RestoreToCount(kInitialSaveCount, options, params);
 }
 
+void PaintOpBufferSerializer::SerializeRange(
+    const PaintOpBuffer* buffer,
+    const std::vector<size_t>& offsets,
+    const Preamble& preamble,
+    size_t begin,
+    size_t end) {
+  DCHECK(canvas_->getTotalMatrix().isIdentity());
+  static const int kInitialSaveCount = 1;
+  DCHECK_EQ(kInitialSaveCount, canvas_->getSaveCount());
+  DCHECK_LT(begin, end);
+  DCHECK_LE(end, offsets.size());
+
+  PaintOp::SerializeOptions options = MakeSerializeOptions();
+  PlaybackParams params = MakeParams(canvas_.get());
+
+  // Only the first range includes the initial save and the preamble.
+  replaying_ = begin > 0;
+  Save(options, params);
+  SerializePreamble(preamble, options, params);
+
+  // As in Serialize(), the ops are played back relative to the post-preamble
+  // canvas.
+  PaintOp::SerializeOptions buffer_options = MakeSerializeOptions();
+  PlaybackParams buffer_params = MakeParams(canvas_.get());
+  if (begin > 0) {
+    std::vector<size_t> previous_offsets(offsets.begin(),
+                                         offsets.begin() + begin);
+    SerializeBufferWithParams(buffer, &previous_offsets, &buffer_options,
+                              buffer_params);
+    replaying_ = false;
+  }
+  std::vector<size_t> range_offsets(offsets.begin() + begin,
+                                    offsets.begin() + end);
+  SerializeBufferWithParams(buffer, &range_offsets, &buffer_options,
+                            buffer_params);
+
+  // Only the last range restores the initial save count.
+  if (end == offsets.size())
+    RestoreToCount(kInitialSaveCount, options, params);
+}
+
+// static
+std::vector<size_t> PaintOpBufferSerializer::SplitIntoRanges(
+    const PaintOpBuffer* buffer,
+    const std::vector<size_t>& offsets,
+    size_t max_ranges) {
+  DCHECK_GT(max_ranges, 0u);
+  const size_t target_range_size =
+      std::max<size_t>(offsets.size() / max_ranges, 1u);
+
+  std::vector<size_t> boundaries;
+  boundaries.push_back(0u);
+  int save_depth = 0;
+  size_t index = 0;
+  for (PaintOpBuffer::OffsetIterator iter(buffer, &offsets); iter;
+       ++iter, ++index) {
+    switch (iter->GetType()) {
+      case PaintOpType::Save:
+      case PaintOpType::SaveLayer:
+      case PaintOpType::SaveLayerAlpha:
+        ++save_depth;
+        break;
+      case PaintOpType::Restore:
+        save_depth = std::max(save_depth - 1, 0);
+        break;
+      default:
+        break;
+    }
+
+    size_t next_index = index + 1;
+    if (save_depth == 0 && next_index < offsets.size() &&
+        next_index - boundaries.back() >= target_range_size &&
+        boundaries.size() < max_ranges) {
+      boundaries.push_back(next_index);
+    }
+  }
+  boundaries.push_back(offsets.size());
+  return boundaries;
+}
+
 void PaintOpBufferSerializer::Serialize(const PaintOpBuffer* buffer) {
   DCHECK(canvas_->getTotalMatrix().isIdentity());
 
@@ -245,14 +351,27 @@ void PaintOpBufferSerializer::SerializePreamble(
 void PaintOpBufferSerializer::SerializeBuffer(
     const PaintOpBuffer* buffer,
     const std::vector<size_t>* offsets) {
-  DCHECK(buffer);
   PaintOp::SerializeOptions options = MakeSerializeOptions();
   PlaybackParams params = MakeParams(canvas_.get());
+  SerializeBufferWithParams(buffer, offsets, &options, params);
+}
+
+void PaintOpBufferSerializer::SerializeBufferWithParams(
+    const PaintOpBuffer* buffer,
+    const std::vector<size_t>* offsets,
+    PaintOp::SerializeOptions* options,
+    const PlaybackParams& params) {
+  DCHECK(buffer);
 
   for (PaintOpBuffer::PlaybackFoldingIterator iter(buffer, offsets); iter;
        ++iter) {
     const PaintOp* op = *iter;
 
+    // Draw ops don't change the canvas state. DrawRecordOps are wrapped in a
+    // save/restore.
+    if (replaying_ && op->IsDrawOp())
+      continue;
+
     // Skip ops outside the current clip if they have images. This saves
     // performing an unnecessary expensive decode.
     const bool skip_op = PaintOp::OpHasDiscardableImages(op) &&
@@ -261,12 +380,16 @@ void PaintOpBufferSerializer::SerializeBuffer(
       continue;
 
     if (op->GetType() != PaintOpType::DrawRecord) {
+      base::Optional<base::AutoLock> lock;
+      if (shared_resources_lock_ && UsesSharedResources(op))
+        lock.emplace(*shared_resources_lock_);
+
       bool success = false;
       if (op->IsPaintOpWithFlags()) {
         success = SerializeOpWithFlags(static_cast<const PaintOpWithFlags*>(op),
-                                       &options, params, iter.alpha());
+                                       options, params, iter.alpha());
       } else {
-        success = SerializeOp(op, options, params);
+        success = SerializeOp(op, *options, params);
       }
 
       if (!success)
@@ -275,10 +398,10 @@ void PaintOpBufferSerializer::SerializeBuffer(
     }
 
     int save_count = canvas_->getSaveCount();
-    Save(options, params);
+    Save(*options, params);
     SerializeBuffer(static_cast<const DrawRecordOp*>(op)->record.get(),
                     nullptr);
-    RestoreToCount(save_count, options, params);
+    RestoreToCount(save_count, *options, params);
   }
 }
 
@@ -306,14 +429,16 @@ bool PaintOpBufferSerializer::SerializeOp(
   if (!valid_)
     return false;
 
-  size_t bytes = serialize_cb_.Run(op, options);
-  if (!bytes) {
-    valid_ = false;
-    return false;
-  }
+  if (!replaying_) {
+    size_t bytes = serialize_cb_.Run(op, options);
+    if (!bytes) {
+      valid_ = false;
+      return false;
+    }
 
-  DCHECK_GE(bytes, 4u);
-  DCHECK_EQ(bytes % PaintOpBuffer::PaintOpAlign, 0u);
+    DCHECK_GE(bytes, 4u);
+    DCHECK_EQ(bytes % PaintOpBuffer::PaintOpAlign, 0u);
+  }
 
   if (op->IsPaintOpWithFlags() && options.flags_to_serialize) {
     static_cast<const PaintOpWithFlags*>(op)->RasterWithFlags(
@@ -391,4 +516,171 @@ size_t SimpleBufferSerializer::SerializeToMemory(
   return bytes;
 }
 
+// Serializes into memory that grows as needed.
+class ParallelPaintOpBufferSerializer::ChunkSerializer
+    : public PaintOpBufferSerializer {
+ public:
+  ChunkSerializer(ImageProvider* image_provider,
+                  TransferCacheSerializeHelper* transfer_cache,
+                  SkStrikeServer* strike_server,
+                  SkColorSpace* color_space,
+                  bool can_use_lcd_text,
+                  bool context_supports_distance_field_text,
+                  int max_texture_size,
+                  size_t max_texture_bytes)
+      : PaintOpBufferSerializer(
+            base::Bind(&ChunkSerializer::SerializeToMemory,
+                       base::Unretained(this)),
+            image_provider,
+            transfer_cache,
+            strike_server,
+            color_space,
+            can_use_lcd_text,
+            context_supports_distance_field_text,
+            max_texture_size,
+            max_texture_bytes) {
+    Grow(kInitialSize);
+  }
+  ~ChunkSerializer() override = default;
+
+  const char* data() const { return memory_.get(); }
+  size_t written() const { return written_; }
+
+ private:
+  static constexpr size_t kInitialSize = 64 * 1024;
+  // An op that doesn't fit is retried once with this much free memory, as
+  // when serializing into the transfer buffer.
+  static constexpr size_t kBlockSize = 512 * 1024;
+
+  size_t SerializeToMemory(const PaintOp* op,
+                           const PaintOp::SerializeOptions& options) {
+    size_t bytes = op->Serialize(memory_.get() + written_,
+                                 capacity_ - written_, options);
+    if (!bytes) {
+      Grow(written_ + kBlockSize);
+      bytes = op->Serialize(memory_.get() + written_, capacity_ - written_,
+                            options);
+      if (!bytes)
+        return 0u;
+    }
+    written_ += bytes;
+    DCHECK_GE(capacity_, written_);
+    return bytes;
+  }
+
+  void Grow(size_t min_capacity) {
+    size_t capacity = std::max(min_capacity, 2 * capacity_);
+    std::unique_ptr<char, base::AlignedFreeDeleter> memory(
+        static_cast<char*>(
+            base::AlignedAlloc(capacity, PaintOpBuffer::PaintOpAlign)));
+    if (written_)
+      memcpy(memory.get(), memory_.get(), written_);
+    memory_ = std::move(memory);
+    capacity_ = capacity;
+  }
+
+  std::unique_ptr<char, base::AlignedFreeDeleter> memory_;
+  size_t capacity_ = 0u;
+  size_t written_ = 0u;
+
+  DISALLOW_COPY_AND_ASSIGN(ChunkSerializer);
+};
+
+namespace {
+
+void SerializeRangeAndRun(PaintOpBufferSerializer* serializer,
+                          const PaintOpBuffer* buffer,
+                          const std::vector<size_t>* offsets,
+                          const PaintOpBufferSerializer::Preamble* preamble,
+                          size_t begin,
+                          size_t end,
+                          base::RepeatingClosure done_closure) {
+  TRACE_EVENT0("cc", "ParallelPaintOpBufferSerializer::SerializeRange");
+  serializer->SerializeRange(buffer, *offsets, *preamble, begin, end);
+  done_closure.Run();
+}
+
+}  // namespace
+
+ParallelPaintOpBufferSerializer::ParallelPaintOpBufferSerializer(
+    ImageProvider* image_provider,
+    TransferCacheSerializeHelper* transfer_cache,
+    SkStrikeServer* strike_server,
+    SkColorSpace* color_space,
+    bool can_use_lcd_text,
+    bool context_supports_distance_field_text,
+    int max_texture_size,
+    size_t max_texture_bytes)
+    : image_provider_(image_provider),
+      transfer_cache_(transfer_cache),
+      strike_server_(strike_server),
+      color_space_(color_space),
+      can_use_lcd_text_(can_use_lcd_text),
+      context_supports_distance_field_text_(
+          context_supports_distance_field_text),
+      max_texture_size_(max_texture_size),
+      max_texture_bytes_(max_texture_bytes) {}
+
+ParallelPaintOpBufferSerializer::~ParallelPaintOpBufferSerializer() = default;
+
+bool ParallelPaintOpBufferSerializer::Serialize(
+    const PaintOpBuffer* buffer,
+    const std::vector<size_t>& offsets,
+    const PaintOpBufferSerializer::Preamble& preamble,
+    size_t max_ranges,
+    base::TaskRunner* task_runner) {
+  TRACE_EVENT1("cc", "ParallelPaintOpBufferSerializer::Serialize", "num_ops",
+               offsets.size());
+  DCHECK(!offsets.empty());
+
+  std::vector<size_t> boundaries =
+      PaintOpBufferSerializer::SplitIntoRanges(buffer, offsets, max_ranges);
+  size_t num_ranges = boundaries.size() - 1;
+
+  chunks_.clear();
+  for (size_t i = 0; i < num_ranges; ++i) {
+    chunks_.push_back(std::make_unique<ChunkSerializer>(
+        image_provider_, transfer_cache_, strike_server_, color_space_,
+        can_use_lcd_text_, context_supports_distance_field_text_,
+        max_texture_size_, max_texture_bytes_));
+    if (num_ranges > 1)
+      chunks_.back()->set_shared_resources_lock(&shared_resources_lock_);
+  }
+
+  base::WaitableEvent ranges_done(
+      base::WaitableEvent::ResetPolicy::MANUAL,
+      base::WaitableEvent::InitialState::NOT_SIGNALED);
+  base::RepeatingClosure range_done = base::BarrierClosure(
+      num_ranges - 1, base::BindOnce(&base::WaitableEvent::Signal,
+                                     base::Unretained(&ranges_done)));
+  for (size_t i = 1; i < num_ranges; ++i) {
+    bool posted = task_runner->PostTask(
+        FROM_HERE,
+        base::BindOnce(&SerializeRangeAndRun, chunks_[i].get(), buffer,
+                       &offsets, &preamble, boundaries[i], boundaries[i + 1],
+                       range_done));
+    if (!posted) {
+      SerializeRangeAndRun(chunks_[i].get(), buffer, &offsets, &preamble,
+                           boundaries[i], boundaries[i + 1], range_done);
+    }
+  }
+  chunks_[0]->SerializeRange(buffer, offsets, preamble, boundaries[0],
+                             boundaries[1]);
+  ranges_done.Wait();
+
+  for (const auto& chunk : chunks_) {
+    if (!chunk->valid())
+      return false;
+  }
+  return true;
+}
+
+const char* ParallelPaintOpBufferSerializer::chunk_data(size_t index) const {
+  return chunks_[index]->data();
+}
+
+size_t ParallelPaintOpBufferSerializer::chunk_size(size_t index) const {
+  return chunks_[index]->written();
+}
+
 }  // namespace cc
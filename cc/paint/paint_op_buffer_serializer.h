@@ -5,11 +5,20 @@
 #ifndef CC_PAINT_PAINT_OP_BUFFER_SERIALIZER_H_
 #define CC_PAINT_PAINT_OP_BUFFER_SERIALIZER_H_
 
+#include <memory>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/synchronization/lock.h"
 #include "cc/paint/paint_op_buffer.h"
 
 #include "third_party/skia/src/core/SkRemoteGlyphCache.h"
 #include "ui/gfx/geometry/rect_f.h"
 
+namespace base {
+class TaskRunner;
+}  // namespace base
+
 namespace cc {
 
 class TransferCacheSerializeHelper;
@@ -74,6 +83,33 @@ class CC_PAINT_EXPORT PaintOpBufferSerializer {
                  const gfx::SizeF& post_scale,
                  const SkMatrix& post_matrix_for_analysis);
 
+  // Serializes the part of the output of Serialize(|buffer|, &|offsets|,
+  // |preamble|) that comes from the ops at |offsets|[|begin|, |end|). The
+  // canvas state set up by the preamble and the ops before |begin| is replayed
+  // first, without being serialized. Concatenating the output for consecutive
+  // ranges between the boundaries returned by SplitIntoRanges() gives the
+  // output of Serialize().
+  void SerializeRange(const PaintOpBuffer* buffer,
+                      const std::vector<size_t>& offsets,
+                      const Preamble& preamble,
+                      size_t begin,
+                      size_t end);
+
+  // Returns the boundaries of up to |max_ranges| ranges of |offsets| of
+  // similar sizes, starting with 0 and ending with |offsets|.size(). Ranges
+  // only start outside of save/restore blocks, so that they can be serialized
+  // independently.
+  static std::vector<size_t> SplitIntoRanges(const PaintOpBuffer* buffer,
+                                             const std::vector<size_t>& offsets,
+                                             size_t max_ranges);
+
+  // If set, ops that use the image provider, the transfer cache or the strike
+  // server are serialized with |lock| held, so that serializers running on
+  // several threads can share them.
+  void set_shared_resources_lock(base::Lock* lock) {
+    shared_resources_lock_ = lock;
+  }
+
   bool valid() const { return valid_; }
 
  private:
@@ -82,6 +118,10 @@ class CC_PAINT_EXPORT PaintOpBufferSerializer {
                          const PlaybackParams& params);
   void SerializeBuffer(const PaintOpBuffer* buffer,
                        const std::vector<size_t>* offsets);
+  void SerializeBufferWithParams(const PaintOpBuffer* buffer,
+                                 const std::vector<size_t>* offsets,
+                                 PaintOp::SerializeOptions* options,
+                                 const PlaybackParams& params);
   bool SerializeOpWithFlags(const PaintOpWithFlags* flags_op,
                             PaintOp::SerializeOptions* options,
                             const PlaybackParams& params,
@@ -109,6 +149,11 @@ class CC_PAINT_EXPORT PaintOpBufferSerializer {
   SkTextBlobCacheDiffCanvas text_blob_canvas_;
   std::unique_ptr<SkCanvas> canvas_;
   bool valid_ = true;
+
+  base::Lock* shared_resources_lock_ = nullptr;
+  // While set, ops only update the state of |canvas_|, and draw ops are
+  // skipped.
+  bool replaying_ = false;
 };
 
 // Serializes the ops in the memory available, fails on overflow.
@@ -137,6 +182,56 @@ class CC_PAINT_EXPORT SimpleBufferSerializer : public PaintOpBufferSerializer {
   size_t written_ = 0u;
 };
 
+// Serializes the ops of a tile on several threads. The ops are split with
+// PaintOpBufferSerializer::SplitIntoRanges(), and each range is serialized
+// into memory of its own. Sending the chunks in order is equivalent to
+// sending the output of PaintOpBufferSerializer::Serialize() with the same
+// preamble. Ops that use the image provider, the transfer cache or the strike
+// server are serialized one at a time.
+class CC_PAINT_EXPORT ParallelPaintOpBufferSerializer {
+ public:
+  ParallelPaintOpBufferSerializer(ImageProvider* image_provider,
+                                  TransferCacheSerializeHelper* transfer_cache,
+                                  SkStrikeServer* strike_server,
+                                  SkColorSpace* color_space,
+                                  bool can_use_lcd_text,
+                                  bool context_supports_distance_field_text,
+                                  int max_texture_size,
+                                  size_t max_texture_bytes);
+  ~ParallelPaintOpBufferSerializer();
+
+  // Serializes the first range on the calling thread and the others on
+  // |task_runner|, and blocks until they are done. Returns false if any range
+  // failed to serialize.
+  bool Serialize(const PaintOpBuffer* buffer,
+                 const std::vector<size_t>& offsets,
+                 const PaintOpBufferSerializer::Preamble& preamble,
+                 size_t max_ranges,
+                 base::TaskRunner* task_runner);
+
+  // The serialized ranges, in order.
+  size_t num_chunks() const { return chunks_.size(); }
+  const char* chunk_data(size_t index) const;
+  size_t chunk_size(size_t index) const;
+
+ private:
+  class ChunkSerializer;
+
+  ImageProvider* image_provider_;
+  TransferCacheSerializeHelper* transfer_cache_;
+  SkStrikeServer* strike_server_;
+  SkColorSpace* color_space_;
+  bool can_use_lcd_text_;
+  bool context_supports_distance_field_text_;
+  int max_texture_size_;
+  size_t max_texture_bytes_;
+
+  base::Lock shared_resources_lock_;
+  std::vector<std::unique_ptr<ChunkSerializer>> chunks_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelPaintOpBufferSerializer);
+};
+
 }  // namespace cc
 
 #endif  // CC_PAINT_PAINT_OP_BUFFER_SERIALIZER_H_
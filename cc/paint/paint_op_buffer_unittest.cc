@@ -4,6 +4,7 @@
 
 #include "cc/paint/paint_op_buffer.h"
 #include "base/strings/stringprintf.h"
+#include "base/threading/thread.h"
 #include "cc/paint/decoded_draw_image.h"
 #include "cc/paint/display_item_list.h"
 #include "cc/paint/image_provider.h"
@@ -12,6 +13,7 @@
 #include "cc/paint/paint_op_buffer_serializer.h"
 #include "cc/paint/paint_op_reader.h"
 #include "cc/paint/paint_op_writer.h"
+#include "cc/paint/path_content_cache.h"
 #include "cc/paint/shader_transfer_cache_entry.h"
 #include "cc/test/geometry_test_utils.h"
 #include "cc/test/paint_op_helper.h"
@@ -2162,6 +2164,100 @@ TEST(PaintOpSerializationTest, SerializesNestedRecords) {
   }
 }
 
+// Pushes an op onto |buffer| and its offset onto |offsets|.
+template <typename T, typename... Args>
+void PushOpWithOffset(PaintOpBuffer* buffer,
+                      std::vector<size_t>* offsets,
+                      Args&&... args) {
+  offsets->push_back(buffer->next_op_offset());
+  buffer->push<T>(std::forward<Args>(args)...);
+}
+
+// Ranges don't start inside save/restore blocks.
+TEST(PaintOpSerializationTest, SplitIntoRanges) {
+  PaintOpBuffer buffer;
+  std::vector<size_t> offsets;
+  PushOpWithOffset<DrawColorOp>(&buffer, &offsets, SK_ColorRED,
+                                SkBlendMode::kSrc);
+  PushOpWithOffset<SaveOp>(&buffer, &offsets);
+  PushOpWithOffset<TranslateOp>(&buffer, &offsets, 1.f, 2.f);
+  PushOpWithOffset<DrawRectOp>(&buffer, &offsets, SkRect::MakeWH(10.f, 20.f),
+                               PaintFlags());
+  PushOpWithOffset<RestoreOp>(&buffer, &offsets);
+  PushOpWithOffset<DrawColorOp>(&buffer, &offsets, SK_ColorBLUE,
+                                SkBlendMode::kSrc);
+
+  EXPECT_EQ(std::vector<size_t>({0u, 6u}),
+            PaintOpBufferSerializer::SplitIntoRanges(&buffer, offsets, 1u));
+  EXPECT_EQ(std::vector<size_t>({0u, 1u, 5u, 6u}),
+            PaintOpBufferSerializer::SplitIntoRanges(&buffer, offsets, 6u));
+}
+
+TEST(PaintOpSerializationTest, ParallelSerializationMatchesSerialize) {
+  PaintOpBuffer buffer;
+  std::vector<size_t> offsets;
+  PushOpWithOffset<ClipRectOp>(&buffer, &offsets, SkRect::MakeWH(80.f, 90.f),
+                               SkClipOp::kIntersect, false);
+  for (int i = 0; i < 10; ++i) {
+    PushOpWithOffset<SaveOp>(&buffer, &offsets);
+    PushOpWithOffset<TranslateOp>(&buffer, &offsets, i * 5.f, i * 3.f);
+    auto record = sk_make_sp<PaintOpBuffer>();
+    record->push<ScaleOp>(0.5f, 0.75f);
+    record->push<DrawRectOp>(SkRect::MakeWH(10.f, 20.f), PaintFlags());
+    PushOpWithOffset<DrawRecordOp>(&buffer, &offsets, record);
+    PushOpWithOffset<RestoreOp>(&buffer, &offsets);
+    PushOpWithOffset<ConcatOp>(&buffer, &offsets,
+                               SkMatrix::MakeScale(1.1f, 0.9f));
+    PushOpWithOffset<DrawRectOp>(&buffer, &offsets,
+                                 SkRect::MakeXYWH(i, i, 10.f, 10.f),
+                                 PaintFlags());
+  }
+
+  PaintOpBufferSerializer::Preamble preamble;
+  preamble.content_size = gfx::Size(100, 100);
+  preamble.full_raster_rect = gfx::Rect(10, 10, 50, 50);
+  preamble.playback_rect = gfx::Rect(20, 20, 30, 30);
+  preamble.post_translation = gfx::Vector2dF(2.f, 3.f);
+  preamble.post_scale = gfx::SizeF(2.f, 2.f);
+
+  size_t memory_size = kBufferBytesPerOp * (buffer.total_op_count() + 20);
+  std::unique_ptr<char, base::AlignedFreeDeleter> memory(static_cast<char*>(
+      base::AlignedAlloc(memory_size, PaintOpBuffer::PaintOpAlign)));
+  TestOptionsProvider options_provider;
+  SimpleBufferSerializer serializer(
+      memory.get(), memory_size, options_provider.image_provider(),
+      options_provider.transfer_cache_helper(),
+      options_provider.strike_server(), options_provider.color_space(),
+      options_provider.can_use_lcd_text(),
+      options_provider.context_supports_distance_field_text(),
+      options_provider.max_texture_size(),
+      options_provider.max_texture_bytes());
+  serializer.Serialize(&buffer, &offsets, preamble);
+  ASSERT_TRUE(serializer.valid());
+  std::string expected(memory.get(), serializer.written());
+
+  base::Thread thread("ParallelSerialization");
+  ASSERT_TRUE(thread.Start());
+  ParallelPaintOpBufferSerializer parallel_serializer(
+      options_provider.image_provider(),
+      options_provider.transfer_cache_helper(),
+      options_provider.strike_server(), options_provider.color_space(),
+      options_provider.can_use_lcd_text(),
+      options_provider.context_supports_distance_field_text(),
+      options_provider.max_texture_size(),
+      options_provider.max_texture_bytes());
+  ASSERT_TRUE(parallel_serializer.Serialize(&buffer, offsets, preamble, 4u,
+                                            thread.task_runner().get()));
+  EXPECT_EQ(4u, parallel_serializer.num_chunks());
+
+  std::string actual;
+  for (size_t i = 0; i < parallel_serializer.num_chunks(); ++i) {
+    actual.append(parallel_serializer.chunk_data(i),
+                  parallel_serializer.chunk_size(i));
+  }
+  EXPECT_EQ(expected, actual);
+}
+
 TEST(PaintOpBufferTest, ClipsImagesDuringSerialization) {
   struct {
     gfx::Rect clip_rect;
@@ -2409,6 +2505,55 @@ TEST(PaintOpBufferTest, ValidateSkClip) {
   }
 }
 
+TEST(PaintOpBufferTest, ReusesPathEntryForIdenticalContents) {
+  size_t buffer_size = kBufferBytesPerOp;
+  std::unique_ptr<char, base::AlignedFreeDeleter> serialized(static_cast<char*>(
+      base::AlignedAlloc(buffer_size, PaintOpBuffer::PaintOpAlign)));
+  std::unique_ptr<char, base::AlignedFreeDeleter> deserialized(
+      static_cast<char*>(
+          base::AlignedAlloc(buffer_size, PaintOpBuffer::PaintOpAlign)));
+
+  // Two separately built paths with the same, large enough, contents.
+  SkPath paths[2];
+  for (SkPath& path : paths) {
+    path.moveTo(0, 0);
+    for (int i = 1; i < 64; ++i)
+      path.lineTo(i, (i % 2) * 10);
+    path.close();
+  }
+  ASSERT_NE(paths[0].getGenerationID(), paths[1].getGenerationID());
+  ASSERT_EQ(paths[0], paths[1]);
+
+  TestOptionsProvider options_provider;
+  PathContentCache path_content_cache;
+  options_provider.set_path_content_cache(&path_content_cache);
+
+  PaintOpBuffer buffer;
+  for (const SkPath& path : paths)
+    buffer.push<ClipPathOp>(path, SkClipOp::kIntersect, true);
+
+  for (PaintOpBuffer::Iterator iter(&buffer); iter; ++iter) {
+    size_t bytes_written = iter->Serialize(
+        serialized.get(), buffer_size, options_provider.serialize_options());
+    ASSERT_GT(bytes_written, 0u);
+
+    // Only the first path is sent.
+    EXPECT_EQ(TransferCacheEntryType::kPath,
+              options_provider.GetLastAddedEntry().first);
+    EXPECT_EQ(paths[0].getGenerationID(),
+              options_provider.GetLastAddedEntry().second);
+
+    size_t bytes_read = 0;
+    PaintOp* written = PaintOp::Deserialize(
+        serialized.get(), bytes_written, deserialized.get(), buffer_size,
+        &bytes_read, options_provider.deserialize_options());
+    ASSERT_TRUE(written);
+    EXPECT_EQ(paths[1], static_cast<ClipPathOp*>(written)->path);
+    written->DestroyThis();
+  }
+  EXPECT_EQ(1u, path_content_cache.size());
+}
+
 TEST(PaintOpBufferTest, ValidateSkBlendMode) {
   size_t buffer_size = kBufferBytesPerOp;
   std::unique_ptr<char, base::AlignedFreeDeleter> serialized(static_cast<char*>(
@@ -11,6 +11,7 @@
 #include "cc/paint/paint_op_buffer_serializer.h"
 #include "cc/paint/paint_shader.h"
 #include "cc/paint/paint_typeface_transfer_cache_entry.h"
+#include "cc/paint/path_content_cache.h"
 #include "cc/paint/path_transfer_cache_entry.h"
 #include "cc/paint/transfer_cache_serialize_helper.h"
 #include "third_party/skia/include/core/SkSerialProcs.h"
@@ -167,12 +168,23 @@ void PaintOpWriter::Write(const SkRRect& rect) {
 }
 
 void PaintOpWriter::Write(const SkPath& path) {
+  auto* transfer_cache = options_.transfer_cache;
   auto id = path.getGenerationID();
-  auto locked =
-      options_.transfer_cache->LockEntry(TransferCacheEntryType::kPath, id);
+  auto locked = transfer_cache->LockEntry(TransferCacheEntryType::kPath, id);
   if (!locked) {
-    options_.transfer_cache->CreateEntry(ClientPathTransferCacheEntry(path));
-    options_.transfer_cache->AssertLocked(TransferCacheEntryType::kPath, id);
+    // Large paths are often rebuilt with identical contents, so reuse an entry
+    // that was sent for an equal path if the service still has it.
+    PathContentCache* content_cache = transfer_cache->path_content_cache();
+    uint32_t content_id = content_cache ? content_cache->Find(path) : 0u;
+    if (content_id &&
+        transfer_cache->LockEntry(TransferCacheEntryType::kPath, content_id)) {
+      id = content_id;
+    } else {
+      transfer_cache->CreateEntry(ClientPathTransferCacheEntry(path));
+      if (content_cache)
+        content_cache->Add(path);
+    }
+    transfer_cache->AssertLocked(TransferCacheEntryType::kPath, id);
   }
   Write(id);
 }
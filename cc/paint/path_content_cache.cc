@@ -0,0 +1,45 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/paint/path_content_cache.h"
+
+#include "base/hash.h"
+
+namespace cc {
+
+PathContentCache::PathContentCache(size_t max_entries) : paths_(max_entries) {}
+
+PathContentCache::~PathContentCache() = default;
+
+uint32_t PathContentCache::Find(const SkPath& path) {
+  uint32_t hash;
+  if (!ComputeHash(path, &hash))
+    return 0u;
+
+  auto it = paths_.Get(hash);
+  if (it == paths_.end() || it->second != path)
+    return 0u;
+  return it->second.getGenerationID();
+}
+
+void PathContentCache::Add(const SkPath& path) {
+  uint32_t hash;
+  if (!ComputeHash(path, &hash))
+    return;
+  paths_.Put(hash, path);
+}
+
+bool PathContentCache::ComputeHash(const SkPath& path, uint32_t* hash) {
+  size_t size = path.writeToMemory(nullptr);
+  if (size < kMinPathBytes)
+    return false;
+
+  scratch_.resize(size);
+  size_t written = path.writeToMemory(scratch_.data());
+  DCHECK_EQ(written, size);
+  *hash = static_cast<uint32_t>(base::FastHash(scratch_.data(), written));
+  return true;
+}
+
+}  // namespace cc
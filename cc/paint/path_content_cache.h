@@ -0,0 +1,60 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CC_PAINT_PATH_CONTENT_CACHE_H_
+#define CC_PAINT_PATH_CONTENT_CACHE_H_
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "base/containers/mru_cache.h"
+#include "base/macros.h"
+#include "cc/paint/paint_export.h"
+#include "third_party/skia/include/core/SkPath.h"
+
+namespace cc {
+
+// Tracks the contents of large paths sent over the transfer cache, so that a
+// path which is rebuilt with a new generation id but identical contents (e.g.
+// every frame) can reuse the entry that was already sent instead of
+// serializing it again. Lives on the client for the lifetime of the context
+// and forgets the least recently used paths first.
+class CC_PAINT_EXPORT PathContentCache {
+ public:
+  // Paths that serialize to fewer bytes than this are cheaper to re-send than
+  // to hash and compare.
+  static constexpr size_t kMinPathBytes = 256u;
+  static constexpr size_t kDefaultMaxEntries = 256u;
+
+  explicit PathContentCache(size_t max_entries = kDefaultMaxEntries);
+  ~PathContentCache();
+
+  // Returns the transfer cache id of a previously added path with the same
+  // contents as |path|, or 0 if there is none.
+  uint32_t Find(const SkPath& path);
+
+  // Records that |path| was sent under its generation id. Replaces any path
+  // with the same contents.
+  void Add(const SkPath& path);
+
+  size_t size() const { return paths_.size(); }
+
+ private:
+  // Returns false if |path| is too small to be tracked.
+  bool ComputeHash(const SkPath& path, uint32_t* hash);
+
+  // Keyed by a hash of the serialized path. Paths are compared on lookup, so
+  // a hash collision only causes a miss.
+  base::HashingMRUCache<uint32_t, SkPath> paths_;
+
+  // Scratch space for serializing paths before hashing them.
+  std::vector<uint8_t> scratch_;
+
+  DISALLOW_COPY_AND_ASSIGN(PathContentCache);
+};
+
+}  // namespace cc
+
+#endif  // CC_PAINT_PATH_CONTENT_CACHE_H_
@@ -0,0 +1,74 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/paint/service_image_upload_cache.h"
+
+#include <algorithm>
+
+#include "base/sha1.h"
+
+namespace cc {
+namespace {
+
+const size_t kMinPurgeThreshold = 64u;
+
+}  // namespace
+
+ServiceImageUploadCache::Key::Key(base::span<const uint8_t> data,
+                                  uint32_t context_id)
+    : context_id_(context_id), hash_(base::kSHA1Length, '\0') {
+  base::SHA1HashBytes(data.data(), data.size(),
+                      reinterpret_cast<unsigned char*>(&hash_[0]));
+}
+
+ServiceImageUploadCache::Key::Key(const Key& other) = default;
+
+ServiceImageUploadCache::Key::~Key() = default;
+
+// static
+ServiceImageUploadCache* ServiceImageUploadCache::GetInstance() {
+  static base::NoDestructor<ServiceImageUploadCache> instance;
+  return instance.get();
+}
+
+ServiceImageUploadCache::ServiceImageUploadCache()
+    : purge_threshold_(kMinPurgeThreshold) {}
+
+ServiceImageUploadCache::~ServiceImageUploadCache() = default;
+
+sk_sp<SkImage> ServiceImageUploadCache::Find(const Key& key) {
+  base::AutoLock hold(lock_);
+  auto it = images_.find(key);
+  if (it == images_.end())
+    return nullptr;
+  return it->second;
+}
+
+void ServiceImageUploadCache::Insert(const Key& key, sk_sp<SkImage> image) {
+  DCHECK(image);
+  base::AutoLock hold(lock_);
+  images_[key] = std::move(image);
+  if (images_.size() > purge_threshold_)
+    PurgeUnusedImages();
+}
+
+size_t ServiceImageUploadCache::size_for_testing() {
+  base::AutoLock hold(lock_);
+  return images_.size();
+}
+
+void ServiceImageUploadCache::PurgeUnusedImages() {
+  lock_.AssertAcquired();
+  for (auto it = images_.begin(); it != images_.end();) {
+    if (it->second->unique())
+      it = images_.erase(it);
+    else
+      ++it;
+  }
+  // Purging again only once the cache doubled keeps insertion amortized
+  // constant time.
+  purge_threshold_ = std::max(kMinPurgeThreshold, 2 * images_.size());
+}
+
+}  // namespace cc
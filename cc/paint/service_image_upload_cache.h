@@ -0,0 +1,82 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CC_PAINT_SERVICE_IMAGE_UPLOAD_CACHE_H_
+#define CC_PAINT_SERVICE_IMAGE_UPLOAD_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <map>
+#include <string>
+#include <tuple>
+
+#include "base/containers/span.h"
+#include "base/macros.h"
+#include "base/no_destructor.h"
+#include "base/synchronization/lock.h"
+#include "cc/paint/paint_export.h"
+#include "third_party/skia/include/core/SkImage.h"
+
+namespace cc {
+
+// A GPU process wide cache of the images created from image transfer cache
+// entries, so that identical images sent by several clients (for instance
+// logos, sprites or emoji atlases shown in many tabs) are uploaded and kept
+// only once. Images are keyed by a hash of their serialized pixels, which
+// were already decoded at the scale they are drawn at, and by the id of the
+// GrContext owning their texture, since textures can only be used with the
+// context that created them.
+//
+// The cache only holds references to images still used by some transfer cache
+// entry: the entries' discardable handles stay in charge of lifetime, and
+// images only referenced here are dropped as new images are added.
+class CC_PAINT_EXPORT ServiceImageUploadCache {
+ public:
+  // Used for images kept in CPU memory, which can be used with any context.
+  static constexpr uint32_t kNoContextId = 0u;
+
+  class CC_PAINT_EXPORT Key {
+   public:
+    Key(base::span<const uint8_t> data, uint32_t context_id);
+    Key(const Key& other);
+    ~Key();
+
+    bool operator<(const Key& other) const {
+      return std::tie(context_id_, hash_) <
+             std::tie(other.context_id_, other.hash_);
+    }
+
+   private:
+    uint32_t context_id_;
+    std::string hash_;
+  };
+
+  static ServiceImageUploadCache* GetInstance();
+
+  // Returns the image for |key|, or null.
+  sk_sp<SkImage> Find(const Key& key);
+  void Insert(const Key& key, sk_sp<SkImage> image);
+
+  size_t size_for_testing();
+
+ private:
+  friend class base::NoDestructor<ServiceImageUploadCache>;
+
+  ServiceImageUploadCache();
+  ~ServiceImageUploadCache();
+
+  void PurgeUnusedImages();
+
+  base::Lock lock_;
+  std::map<Key, sk_sp<SkImage>> images_;
+  // The number of images above which unused ones are purged on insertion.
+  size_t purge_threshold_;
+
+  DISALLOW_COPY_AND_ASSIGN(ServiceImageUploadCache);
+};
+
+}  // namespace cc
+
+#endif  // CC_PAINT_SERVICE_IMAGE_UPLOAD_CACHE_H_
@@ -0,0 +1,56 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/paint/service_image_upload_cache.h"
+
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+
+namespace cc {
+namespace {
+
+sk_sp<SkImage> CreateImage() {
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(4, 4);
+  bitmap.eraseColor(SK_ColorRED);
+  return SkImage::MakeFromBitmap(bitmap);
+}
+
+TEST(ServiceImageUploadCacheTest, KeyedByContentAndContext) {
+  ServiceImageUploadCache* cache = ServiceImageUploadCache::GetInstance();
+  std::vector<uint8_t> data(100, 1u);
+  std::vector<uint8_t> other_data(100, 2u);
+
+  sk_sp<SkImage> image = CreateImage();
+  ServiceImageUploadCache::Key key(data, 17u);
+  cache->Insert(key, image);
+
+  EXPECT_EQ(image, cache->Find(ServiceImageUploadCache::Key(data, 17u)));
+  EXPECT_FALSE(cache->Find(ServiceImageUploadCache::Key(data, 18u)));
+  EXPECT_FALSE(cache->Find(ServiceImageUploadCache::Key(other_data, 17u)));
+}
+
+TEST(ServiceImageUploadCacheTest, PurgesUnusedImages) {
+  ServiceImageUploadCache* cache = ServiceImageUploadCache::GetInstance();
+  std::vector<sk_sp<SkImage>> used_images;
+  for (uint8_t i = 0; i < 200; ++i) {
+    std::vector<uint8_t> data(16, i);
+    sk_sp<SkImage> image = CreateImage();
+    if (i % 2)
+      used_images.push_back(image);
+    cache->Insert(ServiceImageUploadCache::Key(data, 42u), std::move(image));
+  }
+
+  // Images still referenced elsewhere are kept.
+  for (uint8_t i = 1; i < 200; i += 2) {
+    std::vector<uint8_t> data(16, i);
+    EXPECT_TRUE(cache->Find(ServiceImageUploadCache::Key(data, 42u)));
+  }
+  EXPECT_LT(cache->size_for_testing(), 200u);
+}
+
+}  // namespace
+}  // namespace cc
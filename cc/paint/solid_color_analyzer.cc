@@ -6,10 +6,15 @@
 
 #include "base/trace_event/trace_event.h"
 #include "cc/paint/paint_op_buffer.h"
+#include "third_party/skia/include/core/SkPixmap.h"
+#include "third_party/skia/include/core/SkUnPreMultiply.h"
 #include "third_party/skia/include/utils/SkNoDrawCanvas.h"
 
 namespace cc {
 namespace {
+// Images with more pixels than this aren't scanned for a solid color.
+const int kMaxImagePixelsToAnalyze = 256 * 256;
+
 bool ActsLikeClear(SkBlendMode mode, unsigned src_alpha) {
   switch (mode) {
     case SkBlendMode::kClear:
@@ -130,6 +135,91 @@ void CheckIfSolidShape(const SkCanvas& canvas,
   }
 }
 
+// Returns true if all |count| pixels at |pixels| are |value|. There's no
+// early exit, so that the loop is vectorized.
+bool AllPixelsEqual(const uint32_t* pixels, int count, uint32_t value) {
+  uint32_t diff = 0;
+  for (int i = 0; i < count; ++i)
+    diff |= pixels[i] ^ value;
+  return diff == 0;
+}
+
+// Returns the color of the pixels of |image| in |src|, if they are all the same
+// opaque color.
+base::Optional<SkColor> GetImageSolidColor(const PaintImage& image,
+                                           const SkIRect& src) {
+  TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("cc.debug"),
+               "SolidColorAnalyzer::GetImageSolidColor");
+  // Lazy generated images would have to be decoded, and animated images
+  // change.
+  if (!image || image.IsLazyGenerated() || image.ShouldAnimate())
+    return base::nullopt;
+
+  // Only sRGB colors can be reported as an SkColor.
+  SkColorSpace* color_space = image.color_space();
+  if (color_space && !color_space->isSRGB())
+    return base::nullopt;
+
+  SkPixmap pixmap;
+  if (!image.GetSkImage()->peekPixels(&pixmap) ||
+      pixmap.colorType() != kN32_SkColorType ||
+      pixmap.alphaType() == kUnpremul_SkAlphaType) {
+    return base::nullopt;
+  }
+
+  SkIRect bounds = src;
+  if (bounds.isEmpty() || !bounds.intersect(pixmap.bounds()) ||
+      static_cast<int64_t>(bounds.width()) * bounds.height() >
+          kMaxImagePixelsToAnalyze) {
+    return base::nullopt;
+  }
+
+  const uint32_t value = *pixmap.addr32(bounds.x(), bounds.y());
+  if (SkGetPackedA32(value) != 0xFF)
+    return base::nullopt;
+  for (int y = bounds.top(); y < bounds.bottom(); ++y) {
+    if (!AllPixelsEqual(pixmap.addr32(bounds.x(), y), bounds.width(), value))
+      return base::nullopt;
+  }
+  return SkUnPreMultiply::PMColorToColor(value);
+}
+
+// Returns true if drawing an opaque image with |flags| draws its pixels as is.
+bool IsSolidImagePaint(const PaintFlags& flags) {
+  SkBlendMode blendmode = flags.getBlendMode();
+  return flags.getAlpha() == 255 &&
+         (blendmode == SkBlendMode::kSrc ||
+          blendmode == SkBlendMode::kSrcOver) &&
+         !flags.HasShader() && !flags.getLooper() && !flags.getMaskFilter() &&
+         !flags.getColorFilter() && !flags.getImageFilter();
+}
+
+// Returns true if the image covers the entire canvas and all of its pixels in
+// |src| are the same opaque color. Filtering only samples pixels next to
+// |src|, so those are checked too.
+bool CheckIfSolidImage(const SkCanvas& canvas,
+                       const PaintImage& image,
+                       const SkRect& src,
+                       const SkRect& dst,
+                       const PaintFlags& flags,
+                       bool* is_solid_color,
+                       bool* is_transparent,
+                       SkColor* color) {
+  if (!IsSolidImagePaint(flags) || !IsFullQuad(canvas, dst))
+    return false;
+
+  SkIRect src_irect = src.roundOut();
+  src_irect.outset(1, 1);
+  base::Optional<SkColor> image_color = GetImageSolidColor(image, src_irect);
+  if (!image_color)
+    return false;
+
+  *is_solid_color = true;
+  *is_transparent = false;
+  *color = *image_color;
+  return true;
+}
+
 bool CheckIfRRectClipCoversCanvas(const SkCanvas& canvas,
                                   const SkRRect& rrect) {
   TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("cc.debug"),
@@ -198,9 +288,6 @@ base::Optional<SkColor> SolidColorAnalyzer::DetermineIfSolidColor(
 
       // Any of the following ops result in non solid content.
       case PaintOpType::DrawDRRect:
-      case PaintOpType::DrawImage:
-      case PaintOpType::DrawImageRect:
-      case PaintOpType::DrawIRect:
       case PaintOpType::DrawLine:
       case PaintOpType::DrawOval:
       case PaintOpType::DrawPath:
@@ -243,6 +330,44 @@ base::Optional<SkColor> SolidColorAnalyzer::DetermineIfSolidColor(
                           &is_transparent, &color);
         break;
       }
+      case PaintOpType::DrawIRect: {
+        if (++num_draw_ops > max_ops_to_analyze)
+          return base::nullopt;
+        const DrawIRectOp* rect_op = static_cast<const DrawIRectOp*>(op);
+        CheckIfSolidShape(canvas, SkRect::Make(rect_op->rect), rect_op->flags,
+                          &is_solid, &is_transparent, &color);
+        break;
+      }
+      // Images are only solid if they are opaque, already decoded and cover
+      // the canvas with a single color, e.g. a stretched 1x1 background image.
+      case PaintOpType::DrawImage: {
+        if (++num_draw_ops > max_ops_to_analyze)
+          return base::nullopt;
+        const DrawImageOp* image_op = static_cast<const DrawImageOp*>(op);
+        if (!image_op->image)
+          return base::nullopt;
+        SkRect src = SkRect::MakeIWH(image_op->image.width(),
+                                     image_op->image.height());
+        SkRect dst = src.makeOffset(image_op->left, image_op->top);
+        if (!CheckIfSolidImage(canvas, image_op->image, src, dst,
+                               image_op->flags, &is_solid, &is_transparent,
+                               &color)) {
+          return base::nullopt;
+        }
+        break;
+      }
+      case PaintOpType::DrawImageRect: {
+        if (++num_draw_ops > max_ops_to_analyze)
+          return base::nullopt;
+        const DrawImageRectOp* image_op =
+            static_cast<const DrawImageRectOp*>(op);
+        if (!CheckIfSolidImage(canvas, image_op->image, image_op->src,
+                               image_op->dst, image_op->flags, &is_solid,
+                               &is_transparent, &color)) {
+          return base::nullopt;
+        }
+        break;
+      }
       case PaintOpType::DrawColor: {
         if (++num_draw_ops > max_ops_to_analyze)
           return base::nullopt;
@@ -8,8 +8,10 @@
 #include "base/optional.h"
 #include "cc/paint/display_item_list.h"
 #include "cc/paint/paint_filter.h"
+#include "cc/paint/paint_image_builder.h"
 #include "cc/paint/record_paint_canvas.h"
 #include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/skia/include/core/SkImage.h"
 #include "ui/gfx/skia_util.h"
 
 namespace cc {
@@ -133,6 +135,82 @@ TEST_F(SolidColorAnalyzerTest, DrawRect) {
   EXPECT_EQ(color, GetColor());
 }
 
+TEST_F(SolidColorAnalyzerTest, DrawIRect) {
+  Initialize();
+  PaintFlags flags;
+  SkColor color = SkColorSetARGB(255, 11, 22, 33);
+  flags.setColor(color);
+  canvas()->drawIRect(SkIRect::MakeWH(200, 200), flags);
+  EXPECT_EQ(color, GetColor());
+}
+
+PaintImage CreateFilledImage(int width, int height, SkColor color) {
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(width, height);
+  bitmap.eraseColor(color);
+  return PaintImageBuilder::WithDefault()
+      .set_id(PaintImage::GetNextId())
+      .set_image(SkImage::MakeFromBitmap(bitmap),
+                 PaintImage::GetNextContentId())
+      .TakePaintImage();
+}
+
+TEST_F(SolidColorAnalyzerTest, DrawImageSolid) {
+  Initialize();
+  SkColor color = SkColorSetARGB(255, 11, 22, 33);
+  canvas()->drawImage(CreateFilledImage(100, 100, color), 0, 0);
+  EXPECT_EQ(color, GetColor());
+}
+
+TEST_F(SolidColorAnalyzerTest, DrawImageRectStretchedSolid) {
+  Initialize();
+  SkColor color = SkColorSetARGB(255, 11, 22, 33);
+  canvas()->drawImageRect(CreateFilledImage(1, 1, color),
+                          SkRect::MakeWH(1, 1), SkRect::MakeWH(200, 200),
+                          nullptr, PaintCanvas::kFast_SrcRectConstraint);
+  EXPECT_EQ(color, GetColor());
+}
+
+TEST_F(SolidColorAnalyzerTest, DrawImageNotSolid) {
+  SkColor color = SkColorSetARGB(255, 11, 22, 33);
+  PaintImage image = CreateFilledImage(100, 100, color);
+
+  // Doesn't cover the canvas.
+  Initialize();
+  canvas()->drawImage(image, 1, 0);
+  EXPECT_FALSE(IsSolidColor());
+  Reset();
+
+  // Translucent.
+  Initialize();
+  canvas()->drawImage(CreateFilledImage(100, 100, SkColorSetA(color, 128)), 0,
+                      0);
+  EXPECT_FALSE(IsSolidColor());
+  Reset();
+
+  // Drawn with alpha.
+  Initialize();
+  PaintFlags flags;
+  flags.setAlpha(128);
+  canvas()->drawImage(image, 0, 0, &flags);
+  EXPECT_FALSE(IsSolidColor());
+  Reset();
+
+  // Not a single color.
+  Initialize();
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(100, 100);
+  bitmap.eraseColor(color);
+  bitmap.erase(SK_ColorRED, SkIRect::MakeXYWH(99, 99, 1, 1));
+  canvas()->drawImage(PaintImageBuilder::WithDefault()
+                          .set_id(PaintImage::GetNextId())
+                          .set_image(SkImage::MakeFromBitmap(bitmap),
+                                     PaintImage::GetNextContentId())
+                          .TakePaintImage(),
+                      0, 0);
+  EXPECT_FALSE(IsSolidColor());
+}
+
 // TODO(vmpstr): Generalize the DrawRect test cases so that we can test both
 // Rect and RRect.
 TEST_F(SolidColorAnalyzerTest, DrawRRect) {
@@ -13,6 +13,8 @@
 
 namespace cc {
 
+class PathContentCache;
+
 class CC_PAINT_EXPORT TransferCacheSerializeHelper {
  public:
   TransferCacheSerializeHelper();
@@ -24,6 +26,13 @@ class CC_PAINT_EXPORT TransferCacheSerializeHelper {
 
   void AssertLocked(TransferCacheEntryType type, uint32_t id);
 
+  // Optional. Used to reuse path entries for paths with identical contents
+  // but different generation ids. Must outlive this helper.
+  void set_path_content_cache(PathContentCache* path_content_cache) {
+    path_content_cache_ = path_content_cache;
+  }
+  PathContentCache* path_content_cache() const { return path_content_cache_; }
+
  protected:
   using EntryKey = std::pair<TransferCacheEntryType, uint32_t>;
 
@@ -33,6 +42,7 @@ class CC_PAINT_EXPORT TransferCacheSerializeHelper {
 
  private:
   std::set<EntryKey> added_entries_;
+  PathContentCache* path_content_cache_ = nullptr;
 };
 
 }  // namespace cc
@@ -13,10 +13,12 @@
 #include "base/strings/stringprintf.h"
 #include "base/trace_event/trace_event.h"
 #include "base/trace_event/trace_event_argument.h"
+#include "cc/raster/compressed_tile.h"
 #include "cc/raster/raster_source.h"
 #include "cc/trees/layer_tree_frame_sink.h"
 #include "components/viz/common/resources/bitmap_allocation.h"
 #include "components/viz/common/resources/platform_color.h"
+#include "components/viz/common/resources/resource_sizes.h"
 
 namespace cc {
 namespace {
@@ -72,6 +74,13 @@ class BitmapRasterBufferImpl : public RasterBuffer {
         /*gpu_compositing=*/false, playback_settings);
   }
 
+  void Decompress(const CompressedTile& compressed_tile) override {
+    DCHECK_EQ(resource_size_, compressed_tile.size());
+    compressed_tile.Decompress(
+        pixels_, viz::ResourceSizes::CheckedWidthInBytes<size_t>(
+                     resource_size_.width(), viz::RGBA_8888));
+  }
+
  private:
   const gfx::Size resource_size_;
   const gfx::ColorSpace color_space_;
@@ -158,4 +167,20 @@ uint64_t BitmapRasterBufferProvider::SetReadyToDrawCallback(
 
 void BitmapRasterBufferProvider::Shutdown() {}
 
+std::unique_ptr<CompressedTile> BitmapRasterBufferProvider::CompressResource(
+    const ResourcePool::InUsePoolResource& resource,
+    size_t max_bytes) {
+  DCHECK_EQ(resource.format(), viz::RGBA_8888);
+  // Bitmap resources are in memory, so reading them back is cheap.
+  BitmapSoftwareBacking* backing =
+      static_cast<BitmapSoftwareBacking*>(resource.software_backing());
+  if (!backing)
+    return nullptr;
+  return CompressedTile::Compress(
+      backing->shared_memory->memory(), resource.size(),
+      viz::ResourceSizes::CheckedWidthInBytes<size_t>(resource.size().width(),
+                                                       viz::RGBA_8888),
+      max_bytes);
+}
+
 }  // namespace cc
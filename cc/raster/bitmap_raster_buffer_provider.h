@@ -43,6 +43,9 @@ class CC_EXPORT BitmapRasterBufferProvider : public RasterBufferProvider {
       const base::Closure& callback,
       uint64_t pending_callback_id) const override;
   void Shutdown() override;
+  std::unique_ptr<CompressedTile> CompressResource(
+      const ResourcePool::InUsePoolResource& resource,
+      size_t max_bytes) override;
 
  private:
   std::unique_ptr<base::trace_event::ConvertableToTraceFormat> StateAsValue()
@@ -0,0 +1,105 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/raster/compressed_tile.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "base/logging.h"
+#include "base/memory/ptr_util.h"
+#include "base/trace_event/trace_event.h"
+
+namespace cc {
+namespace {
+
+const uint32_t kRunFlag = 1u << 31;
+
+// Shorter runs take as much space as literals.
+const int kMinRunLength = 3;
+
+void AppendLiteral(const uint32_t* pixels,
+                   int count,
+                   std::vector<uint32_t>* data) {
+  if (!count)
+    return;
+  data->push_back(count);
+  data->insert(data->end(), pixels, pixels + count);
+}
+
+}  // namespace
+
+// static
+std::unique_ptr<CompressedTile> CompressedTile::Compress(
+    const void* pixels,
+    const gfx::Size& size,
+    size_t stride,
+    size_t max_bytes) {
+  TRACE_EVENT0("cc", "CompressedTile::Compress");
+  DCHECK_GE(stride, size.width() * sizeof(uint32_t));
+  const size_t max_words = max_bytes / sizeof(uint32_t);
+
+  std::vector<uint32_t> data;
+  const uint8_t* row_bytes = static_cast<const uint8_t*>(pixels);
+  for (int y = 0; y < size.height(); ++y, row_bytes += stride) {
+    const uint32_t* row = reinterpret_cast<const uint32_t*>(row_bytes);
+    int literal_start = 0;
+    int x = 0;
+    while (x < size.width()) {
+      int run_end = x + 1;
+      while (run_end < size.width() && row[run_end] == row[x])
+        ++run_end;
+      if (run_end - x >= kMinRunLength) {
+        AppendLiteral(row + literal_start, x - literal_start, &data);
+        data.push_back(kRunFlag | (run_end - x));
+        data.push_back(row[x]);
+        literal_start = run_end;
+      }
+      x = run_end;
+    }
+    AppendLiteral(row + literal_start, size.width() - literal_start, &data);
+
+    if (data.size() > max_words)
+      return nullptr;
+  }
+
+  data.shrink_to_fit();
+  return base::WrapUnique(new CompressedTile(size, std::move(data)));
+}
+
+CompressedTile::CompressedTile(const gfx::Size& size,
+                               std::vector<uint32_t> data)
+    : size_(size), data_(std::move(data)) {}
+
+CompressedTile::~CompressedTile() = default;
+
+void CompressedTile::Decompress(void* pixels, size_t stride) const {
+  TRACE_EVENT0("cc", "CompressedTile::Decompress");
+  DCHECK_GE(stride, size_.width() * sizeof(uint32_t));
+
+  auto it = data_.begin();
+  uint8_t* row_bytes = static_cast<uint8_t*>(pixels);
+  for (int y = 0; y < size_.height(); ++y, row_bytes += stride) {
+    uint32_t* row = reinterpret_cast<uint32_t*>(row_bytes);
+    int x = 0;
+    while (x < size_.width()) {
+      DCHECK(it != data_.end());
+      uint32_t header = *it++;
+      int count = header & ~kRunFlag;
+      DCHECK_LE(x + count, size_.width());
+      if (header & kRunFlag) {
+        std::fill_n(row + x, count, *it++);
+      } else {
+        memcpy(row + x, &*it, count * sizeof(uint32_t));
+        it += count;
+      }
+      x += count;
+    }
+  }
+  DCHECK(it == data_.end());
+}
+
+}  // namespace cc
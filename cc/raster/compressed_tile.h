@@ -0,0 +1,55 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CC_RASTER_COMPRESSED_TILE_H_
+#define CC_RASTER_COMPRESSED_TILE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "base/macros.h"
+#include "cc/cc_export.h"
+#include "ui/gfx/geometry/size.h"
+
+namespace cc {
+
+// A losslessly compressed copy of the 32-bit pixels of a tile, kept so that a
+// tile evicted from memory can be restored without rastering it again. Rows
+// are run-length encoded, which is fast and works well for the large areas of
+// a single color common in web content.
+class CC_EXPORT CompressedTile {
+ public:
+  // Compresses the |size| pixels at |pixels|, whose rows are |stride| bytes
+  // apart. Returns null if they don't compress to at most |max_bytes|.
+  static std::unique_ptr<CompressedTile> Compress(const void* pixels,
+                                                  const gfx::Size& size,
+                                                  size_t stride,
+                                                  size_t max_bytes);
+
+  ~CompressedTile();
+
+  // Writes the pixels to |pixels|, whose rows are |stride| bytes apart.
+  void Decompress(void* pixels, size_t stride) const;
+
+  const gfx::Size& size() const { return size_; }
+  size_t bytes() const { return data_.size() * sizeof(uint32_t); }
+
+ private:
+  CompressedTile(const gfx::Size& size, std::vector<uint32_t> data);
+
+  const gfx::Size size_;
+  // A sequence of runs and literals, row by row. Each starts with a word
+  // holding the number of pixels, with the top bit set for a run. A run is
+  // followed by the repeated pixel, and a literal by its pixels.
+  const std::vector<uint32_t> data_;
+
+  DISALLOW_COPY_AND_ASSIGN(CompressedTile);
+};
+
+}  // namespace cc
+
+#endif  // CC_RASTER_COMPRESSED_TILE_H_
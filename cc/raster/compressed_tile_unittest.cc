@@ -0,0 +1,65 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/raster/compressed_tile.h"
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace cc {
+namespace {
+
+TEST(CompressedTileTest, RoundTrip) {
+  const gfx::Size size(37, 5);
+  const size_t stride = 40 * sizeof(uint32_t);
+  std::vector<uint32_t> pixels(40 * size.height());
+  for (int y = 0; y < size.height(); ++y) {
+    for (int x = 0; x < size.width(); ++x) {
+      // Mix runs of several lengths with literals.
+      pixels[y * 40 + x] = x < 10 ? 0xff0000ff : (x % (y + 1) ? x : 7);
+    }
+  }
+
+  std::unique_ptr<CompressedTile> compressed_tile = CompressedTile::Compress(
+      pixels.data(), size, stride, pixels.size() * sizeof(uint32_t) * 2);
+  ASSERT_TRUE(compressed_tile);
+  EXPECT_EQ(size, compressed_tile->size());
+
+  std::vector<uint32_t> decompressed(pixels.size(), 0u);
+  compressed_tile->Decompress(decompressed.data(), stride);
+  for (int y = 0; y < size.height(); ++y) {
+    for (int x = 0; x < size.width(); ++x)
+      EXPECT_EQ(pixels[y * 40 + x], decompressed[y * 40 + x]) << x << "," << y;
+    // The padding at the end of rows is left alone.
+    for (int x = size.width(); x < 40; ++x)
+      EXPECT_EQ(0u, decompressed[y * 40 + x]);
+  }
+}
+
+TEST(CompressedTileTest, SolidColorIsSmall) {
+  const gfx::Size size(256, 256);
+  std::vector<uint32_t> pixels(size.GetArea(), 0xffffffff);
+  std::unique_ptr<CompressedTile> compressed_tile =
+      CompressedTile::Compress(pixels.data(), size, 256 * sizeof(uint32_t),
+                               pixels.size() * sizeof(uint32_t));
+  ASSERT_TRUE(compressed_tile);
+  // One run per row.
+  EXPECT_EQ(256u * 2 * sizeof(uint32_t), compressed_tile->bytes());
+}
+
+TEST(CompressedTileTest, FailsOverMaxBytes) {
+  const gfx::Size size(64, 64);
+  std::vector<uint32_t> pixels(size.GetArea());
+  for (size_t i = 0; i < pixels.size(); ++i)
+    pixels[i] = i;
+  EXPECT_FALSE(CompressedTile::Compress(pixels.data(), size,
+                                        64 * sizeof(uint32_t),
+                                        pixels.size() * sizeof(uint32_t) / 2));
+}
+
+}  // namespace
+}  // namespace cc
@@ -4,10 +4,16 @@
 
 #include "cc/raster/raster_buffer.h"
 
+#include "base/logging.h"
+
 namespace cc {
 
 RasterBuffer::RasterBuffer() = default;
 
 RasterBuffer::~RasterBuffer() = default;
 
+void RasterBuffer::Decompress(const CompressedTile& compressed_tile) {
+  NOTREACHED();
+}
+
 }  // namespace cc
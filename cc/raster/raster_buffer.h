@@ -16,6 +16,7 @@ class AxisTransform2d;
 }  // namespace gfx
 
 namespace cc {
+class CompressedTile;
 
 class CC_EXPORT RasterBuffer {
  public:
@@ -29,6 +30,11 @@ class CC_EXPORT RasterBuffer {
       uint64_t new_content_id,
       const gfx::AxisTransform2d& transform,
       const RasterSource::PlaybackSettings& playback_settings) = 0;
+
+  // Writes the pixels of |compressed_tile| instead of playing back a raster
+  // source. Only called on buffers from providers that return compressed tiles
+  // from RasterBufferProvider::CompressResource().
+  virtual void Decompress(const CompressedTile& compressed_tile);
 };
 
 }  // namespace cc
@@ -7,6 +7,7 @@
 #include <stddef.h>
 
 #include "base/trace_event/trace_event.h"
+#include "cc/raster/compressed_tile.h"
 #include "cc/raster/raster_source.h"
 #include "cc/raster/texture_compressor.h"
 #include "components/viz/common/resources/platform_color.h"
@@ -22,6 +23,12 @@ RasterBufferProvider::RasterBufferProvider() = default;
 
 RasterBufferProvider::~RasterBufferProvider() = default;
 
+std::unique_ptr<CompressedTile> RasterBufferProvider::CompressResource(
+    const ResourcePool::InUsePoolResource& resource,
+    size_t max_bytes) {
+  return nullptr;
+}
+
 namespace {
 
 bool IsSupportedPlaybackToMemoryFormat(viz::ResourceFormat format) {
@@ -17,6 +17,7 @@
 #include "ui/gfx/geometry/size.h"
 
 namespace cc {
+class CompressedTile;
 class Resource;
 
 class CC_EXPORT RasterBufferProvider {
@@ -88,6 +89,13 @@ class CC_EXPORT RasterBufferProvider {
 
   // Shutdown for doing cleanup.
   virtual void Shutdown() = 0;
+
+  // Returns a compressed copy of the content of |resource|, if it can be read
+  // back cheaply and compresses to at most |max_bytes|, or null. The copy can
+  // be written back with RasterBuffer::Decompress().
+  virtual std::unique_ptr<CompressedTile> CompressResource(
+      const ResourcePool::InUsePoolResource& resource,
+      size_t max_bytes);
 };
 
 }  // namespace cc
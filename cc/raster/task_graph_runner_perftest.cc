@@ -13,7 +13,9 @@
 #include "base/time/time.h"
 #include "cc/base/completion_event.h"
 #include "cc/base/lap_timer.h"
+#include "cc/raster/task_category.h"
 #include "cc/raster/synchronous_task_graph_runner.h"
+#include "cc/raster/work_stealing_task_graph_runner.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/perf/perf_test.h"
 
@@ -217,6 +219,49 @@ class TaskGraphRunnerPerfTest : public testing::Test {
                            true);
   }
 
+  // Runs |num_tasks| independent foreground tasks on a
+  // WorkStealingTaskGraphRunner with |num_threads| foreground threads. A
+  // |max_batch_size| of 1 makes every worker go through the shared work queue
+  // for each task.
+  void RunWorkStealingExecuteTasksTest(const std::string& test_name,
+                                       int num_threads,
+                                       size_t max_batch_size,
+                                       int num_tasks) {
+    WorkStealingTaskGraphRunner task_graph_runner(max_batch_size);
+    task_graph_runner.Start("TaskGraphRunnerPerfTest", num_threads);
+    NamespaceToken token = task_graph_runner.GenerateNamespaceToken();
+
+    PerfTaskImpl::Vector tasks;
+    CreateTasks(num_tasks, &tasks);
+
+    // Avoid unnecessary heap allocations by reusing the same graph and
+    // completed tasks vector.
+    TaskGraph graph;
+    Task::Vector completed_tasks;
+
+    timer_.Reset();
+    do {
+      graph.Reset();
+      ResetTasks(tasks);
+      for (auto& task : tasks)
+        graph.nodes.emplace_back(task, TASK_CATEGORY_FOREGROUND, 0u, 0u);
+      task_graph_runner.ScheduleTasks(token, &graph);
+      task_graph_runner.WaitForTasksToFinishRunning(token);
+      task_graph_runner.CollectCompletedTasks(token, &completed_tasks);
+      completed_tasks.clear();
+      timer_.NextLap();
+    } while (!timer_.HasTimeLimitExpired());
+
+    task_graph_runner.Shutdown();
+
+    perf_test::PrintResult("execute_tasks",
+                           "_work_stealing_task_graph_runner",
+                           test_name,
+                           timer_.LapsPerSecond(),
+                           "runs/s",
+                           true);
+  }
+
  private:
   static std::string TestModifierString() {
     return std::string("_task_graph_runner");
@@ -313,5 +358,15 @@ TEST_F(TaskGraphRunnerPerfTest, ScheduleAndExecuteTasks) {
   RunScheduleAndExecuteTasksTest("2_32_1", 2, 32, 1);
 }
 
+// Compares workers that take one task at a time from the shared work queue
+// with workers that take batches and steal from each other.
+TEST_F(TaskGraphRunnerPerfTest, WorkStealingExecuteTasks) {
+  const size_t kBatchSize = WorkStealingTaskGraphRunner::kDefaultMaxBatchSize;
+  RunWorkStealingExecuteTasksTest("2_threads_unbatched_256", 2, 1u, 256);
+  RunWorkStealingExecuteTasksTest("2_threads_batched_256", 2, kBatchSize, 256);
+  RunWorkStealingExecuteTasksTest("4_threads_unbatched_256", 4, 1u, 256);
+  RunWorkStealingExecuteTasksTest("4_threads_batched_256", 4, kBatchSize, 256);
+}
+
 }  // namespace
 }  // namespace cc
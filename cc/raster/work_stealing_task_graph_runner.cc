@@ -0,0 +1,395 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/raster/work_stealing_task_graph_runner.h"
+
+#include <utility>
+
+#include "base/containers/circular_deque.h"
+#include "base/stl_util.h"
+#include "base/strings/stringprintf.h"
+#include "base/threading/simple_thread.h"
+#include "base/threading/thread_restrictions.h"
+#include "base/trace_event/trace_event.h"
+#include "build/build_config.h"
+#include "cc/raster/task_category.h"
+
+namespace cc {
+
+class WorkStealingTaskGraphRunner::Worker : public base::SimpleThread {
+ public:
+  Worker(WorkStealingTaskGraphRunner* runner,
+         const std::string& name_prefix,
+         const Options& options,
+         std::vector<TaskCategory> categories)
+      : SimpleThread(name_prefix, options),
+        runner_(runner),
+        categories_(std::move(categories)),
+        has_ready_to_run_tasks_cv_(&runner->lock_),
+        waiting_(false) {}
+
+  // base::SimpleThread:
+  void Run() override { runner_->RunWorker(this); }
+
+  // Categories listed first have higher priority.
+  const std::vector<TaskCategory>& categories() const { return categories_; }
+  bool CanRunCategory(TaskCategory category) const {
+    return base::ContainsValue(categories_, category);
+  }
+
+  // Guarded by the runner's lock.
+  base::ConditionVariable& has_ready_to_run_tasks_cv() {
+    return has_ready_to_run_tasks_cv_;
+  }
+  bool waiting() const { return waiting_; }
+  void set_waiting(bool waiting) { waiting_ = waiting; }
+
+  // Foreground tasks taken from the work queue but not yet run, highest
+  // priority first. Guarded by |deque_lock_|, which may be taken while
+  // holding the runner's lock, but not the other way around.
+  base::Lock& deque_lock() { return deque_lock_; }
+  base::circular_deque<PrioritizedTask>& deque() { return deque_; }
+
+ private:
+  WorkStealingTaskGraphRunner* const runner_;
+  const std::vector<TaskCategory> categories_;
+
+  base::ConditionVariable has_ready_to_run_tasks_cv_;
+  bool waiting_;
+
+  base::Lock deque_lock_;
+  base::circular_deque<PrioritizedTask> deque_;
+
+  DISALLOW_COPY_AND_ASSIGN(Worker);
+};
+
+const size_t WorkStealingTaskGraphRunner::kDefaultMaxBatchSize = 4;
+
+WorkStealingTaskGraphRunner::WorkStealingTaskGraphRunner(size_t max_batch_size)
+    : max_batch_size_(max_batch_size),
+      has_namespaces_with_finished_running_tasks_cv_(&lock_),
+      shutdown_(false) {
+  DCHECK_LT(0u, max_batch_size_);
+}
+
+WorkStealingTaskGraphRunner::~WorkStealingTaskGraphRunner() {
+  DCHECK(workers_.empty());
+}
+
+void WorkStealingTaskGraphRunner::Start(const std::string& thread_name_prefix,
+                                        int num_foreground_threads) {
+  DCHECK(workers_.empty());
+
+  std::vector<TaskCategory> foreground_categories;
+  foreground_categories.push_back(TASK_CATEGORY_NONCONCURRENT_FOREGROUND);
+  foreground_categories.push_back(TASK_CATEGORY_FOREGROUND);
+  for (int i = 0; i < num_foreground_threads; i++) {
+    workers_.push_back(std::make_unique<Worker>(
+        this, base::StringPrintf("%s%d", thread_name_prefix.c_str(), i + 1),
+        base::SimpleThread::Options(), foreground_categories));
+  }
+
+  std::vector<TaskCategory> background_categories;
+  background_categories.push_back(TASK_CATEGORY_BACKGROUND);
+  base::SimpleThread::Options background_thread_options;
+#if !defined(OS_MACOSX)
+  background_thread_options.priority = base::ThreadPriority::BACKGROUND;
+#endif
+  workers_.push_back(std::make_unique<Worker>(
+      this, thread_name_prefix + "Background", background_thread_options,
+      background_categories));
+
+  // Workers look at each other's deques, so they only start once |workers_|
+  // is complete.
+  for (const auto& worker : workers_)
+    worker->StartAsync();
+}
+
+void WorkStealingTaskGraphRunner::Shutdown() {
+  {
+    base::AutoLock lock(lock_);
+
+    DCHECK(!work_queue_.HasReadyToRunTasks());
+    DCHECK(!work_queue_.HasAnyNamespaces());
+
+    DCHECK(!shutdown_);
+    shutdown_ = true;
+
+    // Wake up the workers so they know they should exit.
+    for (const auto& worker : workers_)
+      worker->has_ready_to_run_tasks_cv().Signal();
+  }
+  for (const auto& worker : workers_)
+    worker->Join();
+  workers_.clear();
+}
+
+NamespaceToken WorkStealingTaskGraphRunner::GenerateNamespaceToken() {
+  base::AutoLock lock(lock_);
+  return work_queue_.GenerateNamespaceToken();
+}
+
+void WorkStealingTaskGraphRunner::ScheduleTasks(NamespaceToken token,
+                                                TaskGraph* graph) {
+  TRACE_EVENT2("cc", "WorkStealingTaskGraphRunner::ScheduleTasks", "num_nodes",
+               graph->nodes.size(), "num_edges", graph->edges.size());
+
+  DCHECK(token.IsValid());
+  DCHECK(!TaskGraphWorkQueue::DependencyMismatch(graph));
+
+  {
+    base::AutoLock lock(lock_);
+
+    DCHECK(!shutdown_);
+
+    work_queue_.ScheduleTasks(token, graph);
+
+    // There may be more work available, so wake up a worker thread.
+    SignalHasReadyToRunTasksWithLockAcquired();
+  }
+}
+
+void WorkStealingTaskGraphRunner::WaitForTasksToFinishRunning(
+    NamespaceToken token) {
+  TRACE_EVENT0("cc",
+               "WorkStealingTaskGraphRunner::WaitForTasksToFinishRunning");
+
+  DCHECK(token.IsValid());
+
+  {
+    base::AutoLock lock(lock_);
+    base::ThreadRestrictions::ScopedAllowWait allow_wait;
+
+    auto* task_namespace = work_queue_.GetNamespaceForToken(token);
+
+    if (!task_namespace)
+      return;
+
+    while (!work_queue_.HasFinishedRunningTasksInNamespace(task_namespace))
+      has_namespaces_with_finished_running_tasks_cv_.Wait();
+
+    // There may be other namespaces that have finished running tasks, so wake
+    // up another origin thread.
+    has_namespaces_with_finished_running_tasks_cv_.Signal();
+  }
+}
+
+void WorkStealingTaskGraphRunner::CollectCompletedTasks(
+    NamespaceToken token,
+    Task::Vector* completed_tasks) {
+  TRACE_EVENT0("cc", "WorkStealingTaskGraphRunner::CollectCompletedTasks");
+
+  DCHECK(token.IsValid());
+
+  {
+    base::AutoLock lock(lock_);
+    work_queue_.CollectCompletedTasks(token, completed_tasks);
+  }
+}
+
+void WorkStealingTaskGraphRunner::RunWorker(Worker* worker) {
+  // Tasks that have run but haven't been handed back to |work_queue_| yet.
+  std::vector<PrioritizedTask> completed_tasks;
+
+  while (true) {
+    base::Optional<PrioritizedTask> task = PopLocalTask(worker);
+    if (!task) {
+      base::AutoLock lock(lock_);
+
+      CompleteTasksWithLockAcquired(&completed_tasks);
+      task = TakeTasksWithLockAcquired(worker);
+      if (!task)
+        task = StealTaskWithLockAcquired(worker);
+      if (!task) {
+        // We are no longer running tasks, which may allow another category to
+        // start running. Signal other worker threads.
+        SignalHasReadyToRunTasksWithLockAcquired();
+
+        // Exit when shutdown is set and no more tasks are pending.
+        if (shutdown_)
+          break;
+
+        // Wait for more tasks.
+        worker->set_waiting(true);
+        worker->has_ready_to_run_tasks_cv().Wait();
+        worker->set_waiting(false);
+        continue;
+      }
+    }
+
+    {
+      TRACE_EVENT0("toplevel", "TaskGraphRunner::RunTask");
+      task->task->RunOnWorkerThread();
+    }
+    completed_tasks.push_back(std::move(*task));
+
+    // Hand finished tasks back right away unless another thread holds the
+    // lock, so that their dependents and origin threads aren't held up by the
+    // rest of the batch.
+    if (lock_.Try()) {
+      base::AutoLock lock(lock_, base::AutoLock::AlreadyAcquired());
+      CompleteTasksWithLockAcquired(&completed_tasks);
+    }
+  }
+
+  DCHECK(completed_tasks.empty());
+}
+
+base::Optional<WorkStealingTaskGraphRunner::PrioritizedTask>
+WorkStealingTaskGraphRunner::PopLocalTask(Worker* worker) {
+  base::AutoLock deque_lock(worker->deque_lock());
+  if (worker->deque().empty())
+    return base::nullopt;
+
+  base::Optional<PrioritizedTask> task(std::move(worker->deque().front()));
+  worker->deque().pop_front();
+  return task;
+}
+
+base::Optional<WorkStealingTaskGraphRunner::PrioritizedTask>
+WorkStealingTaskGraphRunner::TakeTasksWithLockAcquired(Worker* worker) {
+  lock_.AssertAcquired();
+
+  for (TaskCategory category : worker->categories()) {
+    if (!ShouldRunTaskForCategoryWithLockAcquired(category))
+      continue;
+
+    base::Optional<PrioritizedTask> task(
+        work_queue_.GetNextTaskToRun(category));
+
+    // Foreground tasks are the bulk of the work, so take a batch of them.
+    if (category == TASK_CATEGORY_FOREGROUND) {
+      base::AutoLock deque_lock(worker->deque_lock());
+      DCHECK(worker->deque().empty());
+      while (worker->deque().size() + 1 < max_batch_size_ &&
+             work_queue_.HasReadyToRunTasksForCategory(category)) {
+        worker->deque().push_back(work_queue_.GetNextTaskToRun(category));
+      }
+    }
+
+    // There may be more work available, or tasks to steal, so wake up another
+    // worker thread.
+    SignalHasReadyToRunTasksWithLockAcquired();
+    return task;
+  }
+  return base::nullopt;
+}
+
+base::Optional<WorkStealingTaskGraphRunner::PrioritizedTask>
+WorkStealingTaskGraphRunner::StealTaskWithLockAcquired(Worker* worker) {
+  lock_.AssertAcquired();
+
+  // Only foreground tasks are ever in a deque.
+  if (!worker->CanRunCategory(TASK_CATEGORY_FOREGROUND))
+    return base::nullopt;
+
+  for (const auto& victim : workers_) {
+    if (victim.get() == worker)
+      continue;
+
+    base::AutoLock deque_lock(victim->deque_lock());
+    if (victim->deque().empty())
+      continue;
+
+    // Take the task the victim would run last.
+    base::Optional<PrioritizedTask> task(std::move(victim->deque().back()));
+    victim->deque().pop_back();
+
+    // There may be more tasks to steal, so wake up another worker thread.
+    SignalHasReadyToRunTasksWithLockAcquired();
+    return task;
+  }
+  return base::nullopt;
+}
+
+void WorkStealingTaskGraphRunner::CompleteTasksWithLockAcquired(
+    std::vector<PrioritizedTask>* completed_tasks) {
+  lock_.AssertAcquired();
+
+  if (completed_tasks->empty())
+    return;
+
+  for (PrioritizedTask& task : *completed_tasks) {
+    auto* task_namespace = task.task_namespace;
+    work_queue_.CompleteTask(std::move(task));
+
+    // If namespace has finished running all tasks, wake up origin threads.
+    if (work_queue_.HasFinishedRunningTasksInNamespace(task_namespace))
+      has_namespaces_with_finished_running_tasks_cv_.Signal();
+  }
+  completed_tasks->clear();
+
+  // Completed tasks may have dependents that are now ready to run, or may
+  // allow another category to start running.
+  SignalHasReadyToRunTasksWithLockAcquired();
+}
+
+bool WorkStealingTaskGraphRunner::ShouldRunTaskForCategoryWithLockAcquired(
+    uint16_t category) {
+  lock_.AssertAcquired();
+
+  if (!work_queue_.HasReadyToRunTasksForCategory(category))
+    return false;
+
+  if (category == TASK_CATEGORY_BACKGROUND) {
+    // Only run background tasks if there are no foreground tasks running or
+    // ready to run. Tasks in the workers' deques count as running.
+    size_t num_running_foreground_tasks =
+        work_queue_.NumRunningTasksForCategory(
+            TASK_CATEGORY_NONCONCURRENT_FOREGROUND) +
+        work_queue_.NumRunningTasksForCategory(TASK_CATEGORY_FOREGROUND);
+    bool has_ready_to_run_foreground_tasks =
+        work_queue_.HasReadyToRunTasksForCategory(
+            TASK_CATEGORY_NONCONCURRENT_FOREGROUND) ||
+        work_queue_.HasReadyToRunTasksForCategory(TASK_CATEGORY_FOREGROUND);
+
+    if (num_running_foreground_tasks > 0 || has_ready_to_run_foreground_tasks)
+      return false;
+  }
+
+  // Enforce that only one nonconcurrent task runs at a time.
+  if (category == TASK_CATEGORY_NONCONCURRENT_FOREGROUND &&
+      work_queue_.NumRunningTasksForCategory(
+          TASK_CATEGORY_NONCONCURRENT_FOREGROUND) > 0) {
+    return false;
+  }
+
+  return true;
+}
+
+bool WorkStealingTaskGraphRunner::CanRunTaskWithLockAcquired(Worker* worker) {
+  lock_.AssertAcquired();
+
+  for (TaskCategory category : worker->categories()) {
+    if (ShouldRunTaskForCategoryWithLockAcquired(category))
+      return true;
+  }
+
+  if (!worker->CanRunCategory(TASK_CATEGORY_FOREGROUND))
+    return false;
+  for (const auto& victim : workers_) {
+    if (victim.get() == worker)
+      continue;
+    base::AutoLock deque_lock(victim->deque_lock());
+    if (!victim->deque().empty())
+      return true;
+  }
+  return false;
+}
+
+void WorkStealingTaskGraphRunner::SignalHasReadyToRunTasksWithLockAcquired() {
+  lock_.AssertAcquired();
+
+  // Wake up a single worker. Each worker that finds a task wakes up the next
+  // one, so that idle workers don't all contend for |lock_| at once.
+  for (const auto& worker : workers_) {
+    if (worker->waiting() && CanRunTaskWithLockAcquired(worker.get())) {
+      worker->set_waiting(false);
+      worker->has_ready_to_run_tasks_cv().Signal();
+      return;
+    }
+  }
+}
+
+}  // namespace cc
@@ -0,0 +1,119 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CC_RASTER_WORK_STEALING_TASK_GRAPH_RUNNER_H_
+#define CC_RASTER_WORK_STEALING_TASK_GRAPH_RUNNER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/optional.h"
+#include "base/synchronization/condition_variable.h"
+#include "base/synchronization/lock.h"
+#include "cc/cc_export.h"
+#include "cc/raster/task_graph_runner.h"
+#include "cc/raster/task_graph_work_queue.h"
+
+namespace cc {
+
+// Runs TaskGraphs on a pool of worker threads, with the same category rules as
+// content::CategorizedWorkerPool, but with less contention on the lock that
+// protects the TaskGraphWorkQueue.
+//
+// A worker that runs out of work takes up to |max_batch_size| ready to run
+// TASK_CATEGORY_FOREGROUND tasks at once, in priority order, into a deque of
+// its own, and runs them from the front. Workers that have nothing to do steal
+// from the back of other workers' deques, i.e. the lowest priority tasks,
+// before waiting. Finished tasks are handed back to the work queue whenever
+// its lock can be taken without waiting, and at the latest once the worker's
+// deque is empty.
+//
+// Other categories are taken one task at a time: only one
+// TASK_CATEGORY_NONCONCURRENT_FOREGROUND task runs at a time, and
+// TASK_CATEGORY_BACKGROUND tasks only run when no foreground task is running
+// or ready to run.
+//
+// Tasks in a deque are already running as far as the work queue is concerned,
+// so ScheduleTasks() doesn't cancel them. |max_batch_size| bounds that, and the
+// priority inversion that batching causes.
+class CC_EXPORT WorkStealingTaskGraphRunner : public TaskGraphRunner {
+ public:
+  static const size_t kDefaultMaxBatchSize;
+
+  explicit WorkStealingTaskGraphRunner(size_t max_batch_size);
+  ~WorkStealingTaskGraphRunner() override;
+
+  // Overridden from TaskGraphRunner:
+  NamespaceToken GenerateNamespaceToken() override;
+  void ScheduleTasks(NamespaceToken token, TaskGraph* graph) override;
+  void WaitForTasksToFinishRunning(NamespaceToken token) override;
+  void CollectCompletedTasks(NamespaceToken token,
+                             Task::Vector* completed_tasks) override;
+
+  // Starts |num_foreground_threads| threads for foreground work, including
+  // nonconcurrent foreground work, and a single thread for background work.
+  void Start(const std::string& thread_name_prefix, int num_foreground_threads);
+
+  // Joins the threads. All namespaces must have finished running their tasks
+  // and been collected.
+  void Shutdown();
+
+ private:
+  class Worker;
+
+  using PrioritizedTask = TaskGraphWorkQueue::PrioritizedTask;
+
+  void RunWorker(Worker* worker);
+
+  // Pops the next task from |worker|'s deque, if any.
+  base::Optional<PrioritizedTask> PopLocalTask(Worker* worker);
+
+  // Takes the next task to run for |worker| from |work_queue_|, and fills
+  // |worker|'s deque if it is a foreground task.
+  base::Optional<PrioritizedTask> TakeTasksWithLockAcquired(Worker* worker);
+
+  // Takes the lowest priority task from another worker's deque.
+  base::Optional<PrioritizedTask> StealTaskWithLockAcquired(Worker* worker);
+
+  // Hands |completed_tasks| back to |work_queue_| and clears it.
+  void CompleteTasksWithLockAcquired(
+      std::vector<PrioritizedTask>* completed_tasks);
+
+  bool ShouldRunTaskForCategoryWithLockAcquired(uint16_t category);
+  bool CanRunTaskWithLockAcquired(Worker* worker);
+
+  // Wakes up a waiting worker that has a task to run.
+  void SignalHasReadyToRunTasksWithLockAcquired();
+
+  const size_t max_batch_size_;
+
+  // Not modified while the workers are running.
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  // Lock to exclusively access all the following members, and the waiting
+  // state of the workers.
+  base::Lock lock_;
+
+  // Stores the actual tasks to be run, sorted by priority.
+  TaskGraphWorkQueue work_queue_;
+
+  // Condition variable that is waited on by origin threads until a namespace
+  // has finished running all associated tasks.
+  base::ConditionVariable has_namespaces_with_finished_running_tasks_cv_;
+
+  // Set during shutdown. Tells workers to return when no more tasks are
+  // pending.
+  bool shutdown_;
+
+  DISALLOW_COPY_AND_ASSIGN(WorkStealingTaskGraphRunner);
+};
+
+}  // namespace cc
+
+#endif  // CC_RASTER_WORK_STEALING_TASK_GRAPH_RUNNER_H_
@@ -0,0 +1,43 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/raster/work_stealing_task_graph_runner.h"
+#include "cc/test/task_graph_runner_test_template.h"
+
+namespace cc {
+namespace {
+
+class WorkStealingTaskGraphRunnerTestDelegate {
+ public:
+  WorkStealingTaskGraphRunnerTestDelegate()
+      : work_stealing_task_graph_runner_(
+            WorkStealingTaskGraphRunner::kDefaultMaxBatchSize) {}
+
+  void StartTaskGraphRunner() {
+    work_stealing_task_graph_runner_.Start(
+        "WorkStealingTaskGraphRunnerTestDelegate", 2);
+  }
+
+  TaskGraphRunner* GetTaskGraphRunner() {
+    return &work_stealing_task_graph_runner_;
+  }
+
+  void StopTaskGraphRunner() {}
+
+  ~WorkStealingTaskGraphRunnerTestDelegate() {
+    work_stealing_task_graph_runner_.Shutdown();
+  }
+
+ private:
+  WorkStealingTaskGraphRunner work_stealing_task_graph_runner_;
+};
+
+// Tasks run on several threads, so the order checks of
+// SingleThreadTaskGraphRunnerTest don't apply.
+INSTANTIATE_TYPED_TEST_CASE_P(WorkStealingTaskGraphRunner,
+                              TaskGraphRunnerTest,
+                              WorkStealingTaskGraphRunnerTestDelegate);
+
+}  // namespace
+}  // namespace cc
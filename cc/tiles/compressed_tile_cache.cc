@@ -0,0 +1,86 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/tiles/compressed_tile_cache.h"
+
+#include <utility>
+
+namespace cc {
+
+CompressedTileCache::Entry::Entry(
+    viz::ResourceFormat format,
+    const gfx::ColorSpace& color_space,
+    std::unique_ptr<CompressedTile> compressed_tile)
+    : format(format),
+      color_space(color_space),
+      compressed_tile(std::move(compressed_tile)) {}
+
+CompressedTileCache::Entry::Entry(Entry&& other) = default;
+
+CompressedTileCache::Entry::~Entry() = default;
+
+CompressedTileCache::Entry& CompressedTileCache::Entry::operator=(
+    Entry&& other) = default;
+
+CompressedTileCache::CompressedTileCache(size_t max_bytes)
+    : max_bytes_(max_bytes), entries_(EntryCache::NO_AUTO_EVICT) {}
+
+CompressedTileCache::~CompressedTileCache() = default;
+
+void CompressedTileCache::Put(Tile::Id tile_id,
+                              viz::ResourceFormat format,
+                              const gfx::ColorSpace& color_space,
+                              std::unique_ptr<CompressedTile> compressed_tile) {
+  DCHECK(compressed_tile);
+  Remove(tile_id);
+
+  size_t bytes = compressed_tile->bytes();
+  if (bytes > max_bytes_)
+    return;
+  while (bytes_ + bytes > max_bytes_)
+    Erase(--entries_.end());
+
+  bytes_ += bytes;
+  entries_.Put(tile_id, Entry(format, color_space, std::move(compressed_tile)));
+}
+
+std::unique_ptr<CompressedTile> CompressedTileCache::Take(
+    Tile::Id tile_id,
+    const gfx::Size& size,
+    viz::ResourceFormat format,
+    const gfx::ColorSpace& color_space) {
+  auto it = entries_.Peek(tile_id);
+  if (it == entries_.end())
+    return nullptr;
+
+  std::unique_ptr<CompressedTile> compressed_tile;
+  const Entry& entry = it->second;
+  if (entry.compressed_tile->size() == size && entry.format == format &&
+      entry.color_space == color_space) {
+    compressed_tile = std::move(it->second.compressed_tile);
+    bytes_ -= compressed_tile->bytes();
+    entries_.Erase(it);
+  } else {
+    Erase(it);
+  }
+  return compressed_tile;
+}
+
+void CompressedTileCache::Remove(Tile::Id tile_id) {
+  auto it = entries_.Peek(tile_id);
+  if (it != entries_.end())
+    Erase(it);
+}
+
+void CompressedTileCache::Clear() {
+  entries_.Clear();
+  bytes_ = 0;
+}
+
+void CompressedTileCache::Erase(EntryCache::iterator it) {
+  bytes_ -= it->second.compressed_tile->bytes();
+  entries_.Erase(it);
+}
+
+}  // namespace cc
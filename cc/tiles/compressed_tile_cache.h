@@ -0,0 +1,77 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CC_TILES_COMPRESSED_TILE_CACHE_H_
+#define CC_TILES_COMPRESSED_TILE_CACHE_H_
+
+#include <stddef.h>
+
+#include <memory>
+
+#include "base/containers/mru_cache.h"
+#include "base/macros.h"
+#include "cc/cc_export.h"
+#include "cc/raster/compressed_tile.h"
+#include "cc/tiles/tile.h"
+#include "components/viz/common/resources/resource_format.h"
+#include "ui/gfx/color_space.h"
+
+namespace cc {
+
+// Keeps compressed copies of the content of tiles whose resources were evicted
+// to stay within the memory budget, so that they can be restored instead of
+// rastered again when they are needed. Holds at most |max_bytes|, dropping the
+// least recently stored tiles first. Entries are keyed by Tile::Id, and must
+// be removed when the tile is released, since its content can't change
+// otherwise.
+class CC_EXPORT CompressedTileCache {
+ public:
+  explicit CompressedTileCache(size_t max_bytes);
+  ~CompressedTileCache();
+
+  size_t max_bytes() const { return max_bytes_; }
+  size_t bytes() const { return bytes_; }
+
+  void Put(Tile::Id tile_id,
+           viz::ResourceFormat format,
+           const gfx::ColorSpace& color_space,
+           std::unique_ptr<CompressedTile> compressed_tile);
+
+  // Removes and returns the content of |tile_id|, if it was kept and matches
+  // the other arguments.
+  std::unique_ptr<CompressedTile> Take(Tile::Id tile_id,
+                                       const gfx::Size& size,
+                                       viz::ResourceFormat format,
+                                       const gfx::ColorSpace& color_space);
+
+  void Remove(Tile::Id tile_id);
+  void Clear();
+
+ private:
+  struct Entry {
+    Entry(viz::ResourceFormat format,
+          const gfx::ColorSpace& color_space,
+          std::unique_ptr<CompressedTile> compressed_tile);
+    Entry(Entry&& other);
+    ~Entry();
+    Entry& operator=(Entry&& other);
+
+    viz::ResourceFormat format;
+    gfx::ColorSpace color_space;
+    std::unique_ptr<CompressedTile> compressed_tile;
+  };
+  using EntryCache = base::HashingMRUCache<Tile::Id, Entry>;
+
+  void Erase(EntryCache::iterator it);
+
+  const size_t max_bytes_;
+  size_t bytes_ = 0;
+  EntryCache entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(CompressedTileCache);
+};
+
+}  // namespace cc
+
+#endif  // CC_TILES_COMPRESSED_TILE_CACHE_H_
@@ -0,0 +1,68 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/tiles/compressed_tile_cache.h"
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace cc {
+namespace {
+
+// Returns a tile whose rows are single runs, taking 8 bytes per row.
+std::unique_ptr<CompressedTile> CreateSolidTile(const gfx::Size& size) {
+  std::vector<uint32_t> pixels(size.GetArea(), 0xff00ff00);
+  return CompressedTile::Compress(pixels.data(), size,
+                                  size.width() * sizeof(uint32_t),
+                                  pixels.size() * sizeof(uint32_t));
+}
+
+TEST(CompressedTileCacheTest, TakeMatchingTile) {
+  const gfx::Size size(16, 16);
+  const gfx::ColorSpace color_space = gfx::ColorSpace::CreateSRGB();
+  CompressedTileCache cache(1024);
+  cache.Put(1u, viz::RGBA_8888, color_space, CreateSolidTile(size));
+  EXPECT_EQ(128u, cache.bytes());
+
+  // A mismatch drops the entry.
+  cache.Put(2u, viz::RGBA_8888, color_space, CreateSolidTile(size));
+  EXPECT_FALSE(cache.Take(2u, gfx::Size(16, 8), viz::RGBA_8888, color_space));
+  EXPECT_FALSE(cache.Take(2u, size, viz::RGBA_8888, color_space));
+
+  EXPECT_FALSE(cache.Take(3u, size, viz::RGBA_8888, color_space));
+  std::unique_ptr<CompressedTile> compressed_tile =
+      cache.Take(1u, size, viz::RGBA_8888, color_space);
+  ASSERT_TRUE(compressed_tile);
+  EXPECT_EQ(size, compressed_tile->size());
+  EXPECT_EQ(0u, cache.bytes());
+}
+
+TEST(CompressedTileCacheTest, EvictsOldestTiles) {
+  const gfx::Size size(16, 16);
+  const gfx::ColorSpace color_space = gfx::ColorSpace::CreateSRGB();
+  CompressedTileCache cache(300);
+  cache.Put(1u, viz::RGBA_8888, color_space, CreateSolidTile(size));
+  cache.Put(2u, viz::RGBA_8888, color_space, CreateSolidTile(size));
+  cache.Put(3u, viz::RGBA_8888, color_space, CreateSolidTile(size));
+  EXPECT_EQ(256u, cache.bytes());
+
+  EXPECT_FALSE(cache.Take(1u, size, viz::RGBA_8888, color_space));
+  EXPECT_TRUE(cache.Take(2u, size, viz::RGBA_8888, color_space));
+  EXPECT_TRUE(cache.Take(3u, size, viz::RGBA_8888, color_space));
+
+  // Tiles larger than the cache are not kept.
+  cache.Put(4u, viz::RGBA_8888, color_space,
+            CreateSolidTile(gfx::Size(16, 64)));
+  EXPECT_EQ(0u, cache.bytes());
+
+  cache.Put(5u, viz::RGBA_8888, color_space, CreateSolidTile(size));
+  cache.Remove(5u);
+  EXPECT_EQ(0u, cache.bytes());
+}
+
+}  // namespace
+}  // namespace cc
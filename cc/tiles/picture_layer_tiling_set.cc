@@ -6,6 +6,8 @@
 
 #include <stddef.h>
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
 #include <set>
 #include <vector>
@@ -37,6 +39,35 @@ inline float LargerRatio(float float1, float float2) {
 const float kSoonBorderDistanceViewportPercentage = 0.15f;
 const float kMaxSoonBorderDistanceInScreenPixels = 312.f;
 
+// Three frames are enough to tell whether the visible rect is slowing down.
+const size_t kMaxVisibleRectHistorySize = 3;
+
+// Predicts how far an edge of the visible rect moves in |target_time| seconds,
+// given its positions at three consecutive frames. The velocity is taken from
+// the two most recent frames. If the edge is slowing down, as at the end of a
+// fling, the deceleration is extrapolated as well, so that the prediction
+// stops where the edge comes to rest instead of overshooting it.
+int PredictEdgeDisplacement(int oldest_position,
+                            double oldest_time,
+                            int old_position,
+                            double old_time,
+                            int new_position,
+                            double new_time,
+                            double target_time) {
+  double old_velocity = (old_position - oldest_position) /
+                        (old_time - oldest_time);
+  double new_velocity = (new_position - old_position) / (new_time - old_time);
+  bool is_decelerating = old_velocity * new_velocity > 0 &&
+                         std::abs(new_velocity) < std::abs(old_velocity);
+  if (!is_decelerating)
+    return new_velocity * target_time;
+
+  double acceleration =
+      (new_velocity - old_velocity) / ((new_time - oldest_time) / 2);
+  double time = std::min(target_time, -new_velocity / acceleration);
+  return new_velocity * time + acceleration * time * time / 2;
+}
+
 }  // namespace
 
 // static
@@ -421,15 +452,16 @@ gfx::Rect PictureLayerTilingSet::ComputeSkewport(
   if (skewport.IsEmpty() || visible_rect_history_.empty())
     return skewport;
 
-  // Use the oldest recorded history to get a stable skewport.
-  const auto& historical_frame = visible_rect_history_.back();
+  // Use the frame before last to get a stable skewport.
+  auto historical_frame_it = visible_rect_history_.begin();
+  if (visible_rect_history_.size() > 1)
+    ++historical_frame_it;
+  const auto& historical_frame = *historical_frame_it;
   double time_delta =
       current_frame_time_in_seconds - historical_frame.frame_time_in_seconds;
   if (time_delta == 0.)
     return skewport;
 
-  double extrapolation_multiplier =
-      skewport_target_time_in_seconds_ / time_delta;
   int old_x = historical_frame.visible_rect_in_layer_space.x();
   int old_y = historical_frame.visible_rect_in_layer_space.y();
   int old_right = historical_frame.visible_rect_in_layer_space.right();
@@ -440,10 +472,43 @@ gfx::Rect PictureLayerTilingSet::ComputeSkewport(
   int new_right = visible_rect_in_layer_space.right();
   int new_bottom = visible_rect_in_layer_space.bottom();
 
-  int inset_x = (new_x - old_x) * extrapolation_multiplier;
-  int inset_y = (new_y - old_y) * extrapolation_multiplier;
-  int inset_right = (old_right - new_right) * extrapolation_multiplier;
-  int inset_bottom = (old_bottom - new_bottom) * extrapolation_multiplier;
+  int inset_x;
+  int inset_y;
+  int inset_right;
+  int inset_bottom;
+  const auto& oldest_frame = visible_rect_history_.back();
+  double oldest_time_delta = historical_frame.frame_time_in_seconds -
+                             oldest_frame.frame_time_in_seconds;
+  if (visible_rect_history_.size() == kMaxVisibleRectHistorySize &&
+      oldest_time_delta > 0. && time_delta > 0. &&
+      !oldest_frame.visible_rect_in_layer_space.IsEmpty() &&
+      !historical_frame.visible_rect_in_layer_space.IsEmpty()) {
+    // With enough history, account for the visible rect slowing down, e.g.
+    // during a fling.
+    const gfx::Rect& oldest = oldest_frame.visible_rect_in_layer_space;
+    double oldest_time = oldest_frame.frame_time_in_seconds;
+    double old_time = historical_frame.frame_time_in_seconds;
+    double target_time = skewport_target_time_in_seconds_;
+    inset_x = PredictEdgeDisplacement(oldest.x(), oldest_time, old_x, old_time,
+                                      new_x, current_frame_time_in_seconds,
+                                      target_time);
+    inset_y = PredictEdgeDisplacement(oldest.y(), oldest_time, old_y, old_time,
+                                      new_y, current_frame_time_in_seconds,
+                                      target_time);
+    inset_right = -PredictEdgeDisplacement(
+        oldest.right(), oldest_time, old_right, old_time, new_right,
+        current_frame_time_in_seconds, target_time);
+    inset_bottom = -PredictEdgeDisplacement(
+        oldest.bottom(), oldest_time, old_bottom, old_time, new_bottom,
+        current_frame_time_in_seconds, target_time);
+  } else {
+    double extrapolation_multiplier =
+        skewport_target_time_in_seconds_ / time_delta;
+    inset_x = (new_x - old_x) * extrapolation_multiplier;
+    inset_y = (new_y - old_y) * extrapolation_multiplier;
+    inset_right = (old_right - new_right) * extrapolation_multiplier;
+    inset_bottom = (old_bottom - new_bottom) * extrapolation_multiplier;
+  }
 
   int skewport_extrapolation_limit_in_layer_pixels =
       skewport_extrapolation_limit_in_screen_pixels_ / ideal_contents_scale;
@@ -517,7 +582,7 @@ void PictureLayerTilingSet::UpdatePriorityRects(
   // stable skewports.
   visible_rect_history_.push_front(FrameVisibleRect(
       visible_rect_in_layer_space_, current_frame_time_in_seconds));
-  if (visible_rect_history_.size() > 2)
+  if (visible_rect_history_.size() > kMaxVisibleRectHistorySize)
     visible_rect_history_.pop_back();
 }
 
@@ -713,8 +713,9 @@ TEST(PictureLayerTilingSetTest, SkewportThroughUpdateTilePriorities) {
   // Advance time, but not the viewport.
   gfx::Rect result = tiling_set->ComputeSkewport(viewport_100, 2.5, 1.f);
   // Since the history did advance, we should still get a skewport but a smaller
-  // one.
-  EXPECT_EQ(gfx::Rect(0, 100, 100, 150), result);
+  // one. The viewport is slowing down, so the skewport only extends to where
+  // it is predicted to stop.
+  EXPECT_EQ(gfx::Rect(0, 100, 100, 118), result);
   tiling_set->UpdateTilePriorities(viewport_100, 1.f, 2.5, Occlusion(), true);
 
   // Advance time again.
@@ -749,6 +750,40 @@ TEST(PictureLayerTilingSetTest, SkewportThroughUpdateTilePriorities) {
   tiling_set->UpdateTilePriorities(viewport_250, 1.f, 3.5, Occlusion(), true);
 }
 
+TEST(PictureLayerTilingSetTest, SkewportDuringFling) {
+  FakePictureLayerTilingClient client;
+  gfx::Size layer_bounds(200, 200);
+  client.SetTileSize(gfx::Size(100, 100));
+
+  scoped_refptr<FakeRasterSource> raster_source =
+      FakeRasterSource::CreateFilled(layer_bounds);
+  std::unique_ptr<TestablePictureLayerTilingSet> tiling_set =
+      CreateTilingSet(&client);
+  tiling_set->AddTiling(gfx::AxisTransform2d(), raster_source);
+
+  // Scroll down at 400 pixels per second.
+  tiling_set->UpdateTilePriorities(gfx::Rect(0, 0, 100, 100), 1.f, 1.0,
+                                   Occlusion(), true);
+  tiling_set->UpdateTilePriorities(gfx::Rect(0, 100, 100, 100), 1.f, 1.25,
+                                   Occlusion(), true);
+
+  // The skewport extrapolates the velocity linearly.
+  EXPECT_EQ(gfx::Rect(0, 200, 100, 500),
+            tiling_set->ComputeSkewport(gfx::Rect(0, 200, 100, 100), 1.5,
+                                        1.f));
+  tiling_set->UpdateTilePriorities(gfx::Rect(0, 200, 100, 100), 1.f, 1.5,
+                                   Occlusion(), true);
+  tiling_set->UpdateTilePriorities(gfx::Rect(0, 260, 100, 100), 1.f, 1.75,
+                                   Occlusion(), true);
+
+  // Slow down to 160 pixels per second. At this deceleration, the viewport
+  // stops after 0.25 seconds, 20 pixels further, instead of moving 160 pixels
+  // in the next second.
+  EXPECT_EQ(gfx::Rect(0, 280, 100, 120),
+            tiling_set->ComputeSkewport(gfx::Rect(0, 280, 100, 100), 2.0,
+                                        1.f));
+}
+
 TEST(PictureLayerTilingTest, ViewportDistanceWithScale) {
   FakePictureLayerTilingClient client;
 
@@ -50,6 +50,10 @@ const size_t kNormalMaxItemsInCacheForSoftware = 1000;
 const size_t kThrottledMaxItemsInCacheForSoftware = 100;
 const size_t kSuspendedMaxItemsInCacheForSoftware = 0;
 
+// Rough rate at which images are decoded, used to estimate the cost of
+// evicting decoded images which are needed again.
+const double kDecodedBytesPerSecond = 100 * 1024 * 1024;
+
 class AutoRemoveKeyFromTaskMap {
  public:
   AutoRemoveKeyFromTaskMap(
@@ -172,6 +176,7 @@ SoftwareImageDecodeCache::SoftwareImageDecodeCache(
   }
   // Register this component with base::MemoryCoordinatorClientRegistry.
   base::MemoryCoordinatorClientRegistry::GetInstance()->Register(this);
+  base::MemoryReclaimer::GetInstance()->Register(this);
 }
 
 SoftwareImageDecodeCache::~SoftwareImageDecodeCache() {
@@ -180,6 +185,7 @@ SoftwareImageDecodeCache::~SoftwareImageDecodeCache() {
       this);
   // Unregister this component with memory_coordinator::ClientRegistry.
   base::MemoryCoordinatorClientRegistry::GetInstance()->Unregister(this);
+  base::MemoryReclaimer::GetInstance()->Unregister(this);
 
   // TODO(vmpstr): If we don't have a client name, it may cause problems in
   // unittests, since most tests don't set the name but some do. The UMA system
@@ -558,18 +564,25 @@ void SoftwareImageDecodeCache::ReduceCacheUsageUntilWithinLimit(size_t limit) {
       ++it;
       continue;
     }
+    it = RemoveCacheEntry(it);
+  }
+}
 
-    const CacheKey& key = it->first;
-    auto vector_it = frame_key_to_image_keys_.find(key.frame_key());
-    auto item_it =
-        std::find(vector_it->second.begin(), vector_it->second.end(), key);
-    DCHECK(item_it != vector_it->second.end());
-    vector_it->second.erase(item_it);
-    if (vector_it->second.empty())
-      frame_key_to_image_keys_.erase(vector_it);
+SoftwareImageDecodeCache::ImageMRUCache::reverse_iterator
+SoftwareImageDecodeCache::RemoveCacheEntry(ImageMRUCache::reverse_iterator it) {
+  lock_.AssertAcquired();
+  DCHECK_EQ(0, it->second->ref_count);
 
-    it = decoded_images_.Erase(it);
-  }
+  const CacheKey& key = it->first;
+  auto vector_it = frame_key_to_image_keys_.find(key.frame_key());
+  auto item_it =
+      std::find(vector_it->second.begin(), vector_it->second.end(), key);
+  DCHECK(item_it != vector_it->second.end());
+  vector_it->second.erase(item_it);
+  if (vector_it->second.empty())
+    frame_key_to_image_keys_.erase(vector_it);
+
+  return decoded_images_.Erase(it);
 }
 
 void SoftwareImageDecodeCache::ReduceCacheUsage() {
@@ -670,6 +683,37 @@ void SoftwareImageDecodeCache::OnPurgeMemory() {
   ReduceCacheUsageUntilWithinLimit(0);
 }
 
+base::MemoryReclaimer::Estimate SoftwareImageDecodeCache::EstimateReclaim() {
+  base::AutoLock lock(lock_);
+  base::MemoryReclaimer::Estimate estimate;
+  for (const auto& image_pair : decoded_images_) {
+    if (image_pair.second->ref_count == 0 && image_pair.second->memory)
+      estimate.reclaimable_bytes += image_pair.first.locked_bytes();
+  }
+  // Freeing is cheap, but evicted images have to be decoded again.
+  estimate.cost = base::TimeDelta::FromSecondsD(
+      static_cast<double>(estimate.reclaimable_bytes) / kDecodedBytesPerSecond);
+  return estimate;
+}
+
+size_t SoftwareImageDecodeCache::Reclaim(size_t bytes) {
+  TRACE_EVENT0("cc", "SoftwareImageDecodeCache::Reclaim");
+  base::AutoLock lock(lock_);
+  size_t bytes_freed = 0;
+  // Evict the least recently used images first.
+  for (auto it = decoded_images_.rbegin();
+       bytes_freed < bytes && it != decoded_images_.rend();) {
+    if (it->second->ref_count != 0) {
+      ++it;
+      continue;
+    }
+    if (it->second->memory)
+      bytes_freed += it->first.locked_bytes();
+    it = RemoveCacheEntry(it);
+  }
+  return bytes_freed;
+}
+
 SoftwareImageDecodeCache::CacheEntry* SoftwareImageDecodeCache::AddCacheEntry(
     const CacheKey& key) {
   lock_.AssertAcquired();
@@ -12,6 +12,7 @@
 
 #include "base/containers/mru_cache.h"
 #include "base/memory/memory_coordinator_client.h"
+#include "base/memory/memory_reclaimer.h"
 #include "base/memory/ref_counted.h"
 #include "base/numerics/safe_math.h"
 #include "base/trace_event/memory_dump_provider.h"
@@ -25,7 +26,8 @@ namespace cc {
 class CC_EXPORT SoftwareImageDecodeCache
     : public ImageDecodeCache,
       public base::trace_event::MemoryDumpProvider,
-      public base::MemoryCoordinatorClient {
+      public base::MemoryCoordinatorClient,
+      public base::MemoryReclaimer::Client {
  public:
   using Utils = SoftwareImageDecodeCacheUtils;
   using CacheKey = Utils::CacheKey;
@@ -111,10 +113,19 @@ class CC_EXPORT SoftwareImageDecodeCache
   // reduced within the given limit.
   void ReduceCacheUsageUntilWithinLimit(size_t limit);
 
+  // Removes the decoded image at |it|, which must be unlocked, and returns the
+  // iterator to the next older image.
+  ImageMRUCache::reverse_iterator RemoveCacheEntry(
+      ImageMRUCache::reverse_iterator it);
+
   // Overriden from base::MemoryCoordinatorClient.
   void OnMemoryStateChange(base::MemoryState state) override;
   void OnPurgeMemory() override;
 
+  // Overriden from base::MemoryReclaimer::Client.
+  base::MemoryReclaimer::Estimate EstimateReclaim() override;
+  size_t Reclaim(size_t bytes) override;
+
   // Helper method to get the different tasks. Note that this should be used as
   // if it was public (ie, all of the locks need to be properly acquired).
   TaskResult GetTaskForImageAndRefInternal(const DrawImage& image,
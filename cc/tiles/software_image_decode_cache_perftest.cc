@@ -8,6 +8,8 @@
 #include "cc/paint/draw_image.h"
 #include "cc/paint/paint_image_builder.h"
 #include "cc/raster/tile_task.h"
+#include "cc/test/skia_common.h"
+#include "cc/test/test_tile_task_runner.h"
 #include "cc/tiles/software_image_decode_cache.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/perf/perf_test.h"
@@ -82,6 +84,42 @@ class SoftwareImageDecodeCachePerfTest : public testing::Test {
                            "result", timer_.LapsPerSecond(), "runs/s", true);
   }
 
+  // Decodes large images, at full size and scaled down, through the decode
+  // tasks that tiles depend on.
+  void RunDecodeLargeImages() {
+    const int kImageSizes[] = {1024, 2048, 4096};
+    const float kScales[] = {1.f, 0.5f};
+
+    std::vector<DrawImage> images;
+    for (int size : kImageSizes) {
+      for (float scale : kScales) {
+        SkRect rect = SkRect::MakeWH(size, size);
+        images.push_back(CreateDiscardableDrawImage(
+            gfx::Size(size, size), nullptr, rect, kMedium_SkFilterQuality,
+            CreateMatrix(SkSize::Make(scale, scale))));
+      }
+    }
+
+    SoftwareImageDecodeCache cache(kN32_SkColorType, 256 * 1024 * 1024);
+    timer_.Reset();
+    do {
+      for (auto& image : images) {
+        ImageDecodeCache::TaskResult result = cache.GetTaskForImageAndRef(
+            image, ImageDecodeCache::TracingInfo());
+        if (result.task)
+          TestTileTaskRunner::ProcessTask(result.task.get());
+        if (result.need_unref)
+          cache.UnrefImage(image);
+      }
+      cache.ClearCache();
+      timer_.NextLap();
+    } while (!timer_.HasTimeLimitExpired());
+
+    perf_test::PrintResult("software_image_decode_cache_decode_large_images",
+                           "", "result", timer_.LapsPerSecond(), "runs/s",
+                           true);
+  }
+
  private:
   LapTimer timer_;
 };
@@ -90,5 +128,9 @@ TEST_F(SoftwareImageDecodeCachePerfTest, FromDrawImage) {
   RunFromImage();
 }
 
+TEST_F(SoftwareImageDecodeCachePerfTest, DecodeLargeImages) {
+  RunDecodeLargeImages();
+}
+
 }  // namespace
 }  // namespace cc
@@ -1584,6 +1584,36 @@ TEST(SoftwareImageDecodeCacheTest, ClearCache) {
   EXPECT_EQ(0u, cache.GetNumCacheEntriesForTesting());
 }
 
+TEST(SoftwareImageDecodeCacheTest, ReclaimMemory) {
+  TestSoftwareImageDecodeCache cache;
+  base::MemoryReclaimer::Client* client = &cache;
+  bool is_decomposable = true;
+  SkFilterQuality quality = kHigh_SkFilterQuality;
+
+  const size_t kImageBytes = 100 * 100 * 4;
+  for (int i = 0; i < 10; ++i) {
+    PaintImage paint_image = CreatePaintImage(100, 100);
+    DrawImage draw_image(
+        paint_image, SkIRect::MakeWH(paint_image.width(), paint_image.height()),
+        quality, CreateMatrix(SkSize::Make(1.0f, 1.0f), is_decomposable),
+        PaintImage::kDefaultFrameIndex, DefaultColorSpace());
+    ImageDecodeCache::TaskResult result = cache.GetTaskForImageAndRef(
+        draw_image, ImageDecodeCache::TracingInfo());
+    EXPECT_TRUE(result.need_unref);
+    EXPECT_TRUE(result.task);
+    TestTileTaskRunner::ProcessTask(result.task.get());
+    cache.UnrefImage(draw_image);
+  }
+
+  base::MemoryReclaimer::Estimate estimate = client->EstimateReclaim();
+  EXPECT_EQ(10 * kImageBytes, estimate.reclaimable_bytes);
+  EXPECT_LT(base::TimeDelta(), estimate.cost);
+
+  // Only as many images as needed are evicted.
+  EXPECT_EQ(3 * kImageBytes, client->Reclaim(2 * kImageBytes + 1));
+  EXPECT_EQ(7u, cache.GetNumCacheEntriesForTesting());
+}
+
 TEST(SoftwareImageDecodeCacheTest, CacheDecodesExpectedFrames) {
   TestSoftwareImageDecodeCache cache;
   std::vector<FrameMetadata> frames = {
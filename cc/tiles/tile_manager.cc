@@ -24,6 +24,7 @@
 #include "cc/base/devtools_instrumentation.h"
 #include "cc/base/histograms.h"
 #include "cc/layers/picture_layer_impl.h"
+#include "cc/raster/compressed_tile.h"
 #include "cc/raster/playback_image_provider.h"
 #include "cc/raster/raster_buffer.h"
 #include "cc/raster/task_category.h"
@@ -84,7 +85,8 @@ class RasterTaskImpl : public TileTask {
                  std::unique_ptr<RasterBuffer> raster_buffer,
                  TileTask::Vector* dependencies,
                  bool is_gpu_rasterization,
-                 PlaybackImageProvider image_provider)
+                 PlaybackImageProvider image_provider,
+                 std::unique_ptr<CompressedTile> compressed_tile)
       : TileTask(!is_gpu_rasterization, dependencies),
         tile_manager_(tile_manager),
         tile_id_(tile->id()),
@@ -102,7 +104,8 @@ class RasterTaskImpl : public TileTask {
         source_frame_number_(tile->source_frame_number()),
         is_gpu_rasterization_(is_gpu_rasterization),
         raster_buffer_(std::move(raster_buffer)),
-        image_provider_(std::move(image_provider)) {
+        image_provider_(std::move(image_provider)),
+        compressed_tile_(std::move(compressed_tile)) {
     DCHECK(origin_thread_checker_.CalledOnValidThread());
     playback_settings_.image_provider = &image_provider_;
   }
@@ -122,6 +125,12 @@ class RasterTaskImpl : public TileTask {
 
     DCHECK(raster_source_);
 
+    // The tile was rastered before and its content kept when it was evicted.
+    if (compressed_tile_) {
+      raster_buffer_->Decompress(*compressed_tile_);
+      return;
+    }
+
     raster_buffer_->Playback(raster_source_.get(), content_rect_,
                              invalid_content_rect_, new_content_id_,
                              raster_transform_, playback_settings_);
@@ -171,6 +180,7 @@ class RasterTaskImpl : public TileTask {
   bool is_gpu_rasterization_;
   std::unique_ptr<RasterBuffer> raster_buffer_;
   PlaybackImageProvider image_provider_;
+  std::unique_ptr<CompressedTile> compressed_tile_;
 
   DISALLOW_COPY_AND_ASSIGN(RasterTaskImpl);
 };
@@ -242,11 +252,15 @@ void InsertNodeForDecodeTask(TaskGraph* graph,
                     priority, dependency_count);
 }
 
+// Maps decode tasks to the priority they should be scheduled with.
+using DecodePriorityMap = std::unordered_map<TileTask*, size_t>;
+
 void InsertNodesForRasterTask(TaskGraph* graph,
                               TileTask* raster_task,
                               const TileTask::Vector& decode_tasks,
                               size_t priority,
-                              bool use_foreground_category) {
+                              bool use_foreground_category,
+                              const DecodePriorityMap& decode_priorities) {
   size_t dependencies = 0u;
 
   // Insert image decode tasks.
@@ -280,8 +294,11 @@ void InsertNodesForRasterTask(TaskGraph* graph,
     }
 
     if (decode_it == graph->nodes.end()) {
+      auto decode_priority = decode_priorities.find(decode_task);
       InsertNodeForDecodeTask(graph, decode_task, use_foreground_category,
-                              priority);
+                              decode_priority != decode_priorities.end()
+                                  ? decode_priority->second
+                                  : priority);
     }
 
     graph->edges.emplace_back(decode_task, raster_task);
@@ -364,6 +381,7 @@ TileManager::TileManager(
                              this,
                              tile_manager_settings_.enable_checker_imaging,
                              tile_manager_settings_.min_image_bytes_to_checker),
+      compressed_tile_cache_(tile_manager_settings_.max_compressed_tile_bytes),
       more_tiles_need_prepare_check_notifier_(
           task_runner_,
           base::Bind(&TileManager::CheckIfMoreTilesNeedToBePrepared,
@@ -409,6 +427,7 @@ void TileManager::FinishTasksAndCleanUp() {
   checker_image_tracker_.ClearTracker(can_clear_decode_policy_tracking);
   image_controller_.SetImageDecodeCache(nullptr);
   locked_image_tasks_.clear();
+  compressed_tile_cache_.Clear();
 }
 
 void TileManager::SetResources(ResourcePool* resource_pool,
@@ -432,6 +451,7 @@ void TileManager::Release(Tile* tile) {
   DCHECK_GE(num_of_tiles_with_checker_images_, 0);
 
   FreeResourcesForTile(tile);
+  compressed_tile_cache_.Remove(tile->id());
   tiles_.erase(tile->id());
 }
 
@@ -579,8 +599,10 @@ TileManager::FreeTileResourcesUntilUsageIsWithinLimit(
     if (eviction_priority_queue->IsEmpty())
       break;
 
-    Tile* tile = eviction_priority_queue->Top().tile();
+    const PrioritizedTile& prioritized_tile = eviction_priority_queue->Top();
+    Tile* tile = prioritized_tile.tile();
     *usage -= MemoryUsage::FromTile(tile);
+    CompressTileForEviction(prioritized_tile);
     FreeResourcesForTileAndNotifyClientIfTileWasReadyToDraw(tile);
     eviction_priority_queue->Pop();
   }
@@ -607,6 +629,7 @@ TileManager::FreeTileResourcesWithLowerPriorityUntilUsageIsWithinLimit(
 
     Tile* tile = prioritized_tile.tile();
     *usage -= MemoryUsage::FromTile(tile);
+    CompressTileForEviction(prioritized_tile);
     FreeResourcesForTileAndNotifyClientIfTileWasReadyToDraw(tile);
     eviction_priority_queue->Pop();
   }
@@ -864,6 +887,35 @@ void TileManager::FreeResourcesForTileAndNotifyClientIfTileWasReadyToDraw(
     client_->NotifyTileStateChanged(tile);
 }
 
+void TileManager::CompressTileForEviction(
+    const PrioritizedTile& prioritized_tile) {
+  if (!compressed_tile_cache_.max_bytes())
+    return;
+  if (prioritized_tile.priority().priority_bin != TilePriority::EVENTUALLY)
+    return;
+
+  Tile* tile = prioritized_tile.tile();
+  TileDrawInfo& draw_info = tile->draw_info();
+  if (!draw_info.IsReadyToDraw() || !draw_info.has_resource() ||
+      draw_info.is_checker_imaged()) {
+    return;
+  }
+
+  // Only keep tiles that compress to at most half of their resource, others
+  // are cheaper to raster again.
+  const ResourcePool::InUsePoolResource& resource = draw_info.GetResource();
+  size_t max_bytes = viz::ResourceSizes::UncheckedSizeInBytes<size_t>(
+                         resource.size(), resource.format()) /
+                     2;
+  std::unique_ptr<CompressedTile> compressed_tile =
+      raster_buffer_provider_->CompressResource(resource, max_bytes);
+  if (!compressed_tile)
+    return;
+  compressed_tile_cache_.Put(tile->id(), resource.format(),
+                             resource.color_space(),
+                             std::move(compressed_tile));
+}
+
 void TileManager::PartitionImagesForCheckering(
     const PrioritizedTile& prioritized_tile,
     const gfx::ColorSpace& raster_color_space,
@@ -919,6 +971,54 @@ void TileManager::AddCheckeredImagesToDecodeQueue(
   }
 }
 
+// static
+std::unordered_map<TileTask*, size_t> TileManager::ComputeDecodePriorities(
+    const std::vector<PrioritizedTile>& tiles,
+    size_t first_priority) {
+  struct DependentTiles {
+    size_t first_priority;
+    size_t bin_start_priority;
+    TilePriority::PriorityBin bin;
+    size_t count_in_bin;
+  };
+  std::unordered_map<TileTask*, DependentTiles> dependents;
+
+  size_t priority = first_priority;
+  size_t bin_start_priority = first_priority;
+  TilePriority::PriorityBin bin = TilePriority::NOW;
+  for (const PrioritizedTile& prioritized_tile : tiles) {
+    TilePriority::PriorityBin tile_bin =
+        prioritized_tile.priority().priority_bin;
+    if (tile_bin != bin) {
+      bin = tile_bin;
+      bin_start_priority = priority;
+    }
+
+    for (const auto& decode_task :
+         prioritized_tile.tile()->raster_task_->dependencies()) {
+      if (decode_task->HasCompleted())
+        continue;
+      auto result = dependents.emplace(
+          decode_task.get(),
+          DependentTiles{priority, bin_start_priority, bin, 0u});
+      if (result.first->second.bin == bin)
+        result.first->second.count_in_bin++;
+    }
+    priority++;
+  }
+
+  std::unordered_map<TileTask*, size_t> decode_priorities;
+  decode_priorities.reserve(dependents.size());
+  for (const auto& entry : dependents) {
+    const DependentTiles& dependent = entry.second;
+    size_t advance =
+        std::min(dependent.count_in_bin - 1,
+                 dependent.first_priority - dependent.bin_start_priority);
+    decode_priorities[entry.first] = dependent.first_priority - advance;
+  }
+  return decode_priorities;
+}
+
 void TileManager::ScheduleTasks(PrioritizedWorkToSchedule work_to_schedule) {
   const std::vector<PrioritizedTile>& tiles_that_need_to_be_rasterized =
       work_to_schedule.tiles_to_raster;
@@ -960,6 +1060,9 @@ void TileManager::ScheduleTasks(PrioritizedWorkToSchedule work_to_schedule) {
   scoped_refptr<TileTask> all_done_task =
       CreateTaskSetFinishedTask(&TileManager::DidFinishRunningAllTileTasks);
 
+  DecodePriorityMap decode_priorities =
+      ComputeDecodePriorities(tiles_that_need_to_be_rasterized, priority);
+
   // Build a new task queue containing all task currently needed. Tasks
   // are added in order of priority, highest priority task first.
   for (auto& prioritized_tile : tiles_that_need_to_be_rasterized) {
@@ -991,7 +1094,7 @@ void TileManager::ScheduleTasks(PrioritizedWorkToSchedule work_to_schedule) {
         tile->required_for_draw() || tile->required_for_activation() ||
         prioritized_tile.priority().priority_bin == TilePriority::NOW;
     InsertNodesForRasterTask(&graph_, task, task->dependencies(), priority++,
-                             use_foreground_category);
+                             use_foreground_category, decode_priorities);
   }
 
   const std::vector<PrioritizedTile>& tiles_to_process_for_images =
@@ -1122,6 +1225,14 @@ scoped_refptr<TileTask> TileManager::CreateRasterTask(
     DCHECK(resource);
   }
 
+  // Restore the content kept when the tile was evicted, if it still matches,
+  // instead of rastering it again.
+  std::unique_ptr<CompressedTile> compressed_tile;
+  if (!resource_content_id) {
+    compressed_tile = compressed_tile_cache_.Take(
+        tile->id(), resource.size(), resource.format(), resource.color_space());
+  }
+
   // For LOW_RESOLUTION tiles, we don't draw or predecode images.
   RasterSource::PlaybackSettings playback_settings;
   const bool skip_images =
@@ -1138,7 +1249,7 @@ scoped_refptr<TileTask> TileManager::CreateRasterTask(
   sync_decoded_images.clear();
   std::vector<PaintImage> checkered_images;
   base::flat_map<PaintImage::Id, size_t> image_id_to_current_frame_index;
-  if (!skip_images) {
+  if (!skip_images && !compressed_tile) {
     PartitionImagesForCheckering(
         prioritized_tile, raster_color_space.color_space, &sync_decoded_images,
         &checkered_images, partial_tile_decode ? &invalidated_rect : nullptr,
@@ -1208,7 +1319,8 @@ scoped_refptr<TileTask> TileManager::CreateRasterTask(
       this, tile, std::move(resource), prioritized_tile.raster_source(),
       playback_settings, prioritized_tile.priority().resolution,
       invalidated_rect, prepare_tiles_count_, std::move(raster_buffer),
-      &decode_tasks, use_gpu_rasterization_, std::move(image_provider));
+      &decode_tasks, use_gpu_rasterization_, std::move(image_provider),
+      std::move(compressed_tile));
 }
 
 void TileManager::ResetSignalsForTesting() {
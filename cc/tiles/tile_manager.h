@@ -24,6 +24,7 @@
 #include "cc/resources/memory_history.h"
 #include "cc/resources/resource_pool.h"
 #include "cc/tiles/checker_image_tracker.h"
+#include "cc/tiles/compressed_tile_cache.h"
 #include "cc/tiles/decoded_image_tracker.h"
 #include "cc/tiles/eviction_tile_priority_queue.h"
 #include "cc/tiles/image_controller.h"
@@ -340,6 +341,20 @@ class CC_EXPORT TileManager : CheckerImageTrackerClient {
 
   void FreeResourcesForTile(Tile* tile);
   void FreeResourcesForTileAndNotifyClientIfTileWasReadyToDraw(Tile* tile);
+  // Keeps a compressed copy of the content of |prioritized_tile| before its
+  // resource is evicted, if it is unlikely to be needed soon.
+  void CompressTileForEviction(const PrioritizedTile& prioritized_tile);
+
+  // Returns the priority to schedule the pending decode tasks of |tiles| with.
+  // Decodes run with the priority of their most important dependent raster
+  // task, moved ahead of as many raster tasks as they have other dependents in
+  // the same priority bin, so that a large image doesn't hold back the tiles it
+  // covers behind unrelated work. They never move ahead of tiles from a more
+  // important bin. |tiles| are in decreasing priority, and their raster tasks
+  // are scheduled with consecutive priorities from |first_priority|.
+  static std::unordered_map<TileTask*, size_t> ComputeDecodePriorities(
+      const std::vector<PrioritizedTile>& tiles,
+      size_t first_priority);
   scoped_refptr<TileTask> CreateRasterTask(
       const PrioritizedTile& prioritized_tile,
       const RasterColorSpace& raster_color_space,
@@ -417,6 +432,7 @@ class CC_EXPORT TileManager : CheckerImageTrackerClient {
   ImageController image_controller_;
   DecodedImageTracker decoded_image_tracker_;
   CheckerImageTracker checker_image_tracker_;
+  CompressedTileCache compressed_tile_cache_;
 
   RasterTaskCompletionStats raster_task_completion_stats_;
 
@@ -13,6 +13,7 @@ struct CC_EXPORT TileManagerSettings {
   bool use_partial_raster = false;
   bool enable_checker_imaging = false;
   size_t min_image_bytes_to_checker = 1 * 1024 * 1024;
+  size_t max_compressed_tile_bytes = 0;
 };
 
 }  // namespace cc
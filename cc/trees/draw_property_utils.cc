@@ -6,6 +6,7 @@
 
 #include <stddef.h>
 
+#include <algorithm>
 #include <vector>
 
 #include "base/containers/stack.h"
@@ -730,6 +731,20 @@ static void ComputeClips(PropertyTrees* property_trees) {
   clip_tree->set_needs_update(false);
 }
 
+// Returns, in |needs_update|, the nodes of |tree| marked with
+// SetNodeNeedsUpdate(), and the id of the first of them.
+template <typename TreeType>
+int FindNodesNeedingUpdate(const TreeType& tree,
+                           std::vector<bool>* needs_update) {
+  needs_update->assign(tree.size(), false);
+  int first_id = static_cast<int>(tree.size());
+  for (int id : tree.nodes_needing_update()) {
+    (*needs_update)[id] = true;
+    first_id = std::min(first_id, id);
+  }
+  return first_id;
+}
+
 }  // namespace
 
 void ConcatInverseSurfaceContentsScale(const EffectNode* effect_node,
@@ -809,18 +824,59 @@ void FindLayersThatNeedUpdates(LayerTreeImpl* layer_tree_impl,
 void ComputeTransforms(TransformTree* transform_tree) {
   if (!transform_tree->needs_update())
     return;
-  for (int i = TransformTree::kContentsRootNodeId;
-       i < static_cast<int>(transform_tree->size()); ++i)
+  if (transform_tree->needs_full_update()) {
+    for (int i = TransformTree::kContentsRootNodeId;
+         i < static_cast<int>(transform_tree->size()); ++i)
+      transform_tree->UpdateTransforms(i);
+    transform_tree->set_needs_update(false);
+    return;
+  }
+
+  // Only the changed nodes and the nodes deriving from them need an update.
+  // Nodes come after their parent and source nodes, so a single pass finds
+  // them. Sticky nodes depend on their scroller's offset, so they are always
+  // updated once a node before them changed.
+  std::vector<bool> needs_update;
+  int first_id = std::max(
+      static_cast<int>(TransformTree::kContentsRootNodeId),
+      FindNodesNeedingUpdate(*transform_tree, &needs_update));
+  for (int i = first_id; i < static_cast<int>(transform_tree->size()); ++i) {
+    const TransformNode* node = transform_tree->Node(i);
+    if (!needs_update[i] && !needs_update[node->parent_id] &&
+        (node->source_node_id == TransformTree::kInvalidNodeId ||
+         !needs_update[node->source_node_id]) &&
+        node->sticky_position_constraint_id < 0) {
+      continue;
+    }
+    needs_update[i] = true;
     transform_tree->UpdateTransforms(i);
+  }
   transform_tree->set_needs_update(false);
 }
 
 void ComputeEffects(EffectTree* effect_tree) {
   if (!effect_tree->needs_update())
     return;
-  for (int i = EffectTree::kContentsRootNodeId;
-       i < static_cast<int>(effect_tree->size()); ++i)
+  if (effect_tree->needs_full_update()) {
+    for (int i = EffectTree::kContentsRootNodeId;
+         i < static_cast<int>(effect_tree->size()); ++i)
+      effect_tree->UpdateEffects(i);
+    effect_tree->set_needs_update(false);
+    return;
+  }
+
+  // Only the changed nodes and their descendants need an update.
+  std::vector<bool> needs_update;
+  int first_id =
+      std::max(static_cast<int>(EffectTree::kContentsRootNodeId),
+               FindNodesNeedingUpdate(*effect_tree, &needs_update));
+  for (int i = first_id; i < static_cast<int>(effect_tree->size()); ++i) {
+    const EffectNode* node = effect_tree->Node(i);
+    if (!needs_update[i] && !needs_update[node->parent_id])
+      continue;
+    needs_update[i] = true;
     effect_tree->UpdateEffects(i);
+  }
   effect_tree->set_needs_update(false);
 }
 
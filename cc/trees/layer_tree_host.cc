@@ -1529,7 +1529,7 @@ void LayerTreeHost::SetElementTransformMutated(
     node->local = transform;
     node->needs_local_transform_update = true;
     node->has_potential_animation = true;
-    property_trees_.transform_tree.set_needs_update(true);
+    property_trees_.transform_tree.SetNodeNeedsUpdate(node->id);
   }
 
   SetNeedsUpdateLayers();
@@ -21,6 +21,7 @@
 #include "cc/test/layer_tree_test.h"
 #include "cc/trees/layer_tree_host_common.h"
 #include "cc/trees/layer_tree_impl.h"
+#include "cc/trees/property_tree.h"
 #include "cc/trees/transform_node.h"
 #include "components/viz/test/paths.h"
 #include "testing/perf/perf_test.h"
@@ -79,8 +80,15 @@ class LayerTreeHostCommonPerfTest : public LayerTreeTest {
 
 class CalcDrawPropsTest : public LayerTreeHostCommonPerfTest {
  public:
+  // What changes in the transform tree before each computation.
+  enum class TransformChange { kNone, kLastNode, kAllNodes };
+
   void RunCalcDrawProps() { RunTest(CompositorMode::SINGLE_THREADED); }
 
+  void set_transform_change(TransformChange transform_change) {
+    transform_change_ = transform_change;
+  }
+
   void BeginTest() override { PostSetNeedsCommitToMainThread(); }
 
   void DrawLayersOnThread(LayerTreeHostImpl* host_impl) override {
@@ -88,6 +96,7 @@ class CalcDrawPropsTest : public LayerTreeHostCommonPerfTest {
     LayerTreeImpl* active_tree = host_impl->active_tree();
 
     do {
+      ChangeTransforms(active_tree);
       int max_texture_size = 8096;
       DoCalcDrawPropertiesImpl(max_texture_size, active_tree, host_impl);
 
@@ -97,6 +106,24 @@ class CalcDrawPropsTest : public LayerTreeHostCommonPerfTest {
     EndTest();
   }
 
+  void ChangeTransforms(LayerTreeImpl* active_tree) {
+    TransformTree& transform_tree =
+        active_tree->property_trees()->transform_tree;
+    TransformNode* node = transform_tree.back();
+    switch (transform_change_) {
+      case TransformChange::kNone:
+        return;
+      case TransformChange::kLastNode:
+        node->needs_local_transform_update = true;
+        transform_tree.SetNodeNeedsUpdate(node->id);
+        return;
+      case TransformChange::kAllNodes:
+        node->needs_local_transform_update = true;
+        transform_tree.set_needs_update(true);
+        return;
+    }
+  }
+
   void DoCalcDrawPropertiesImpl(int max_texture_size,
                                 LayerTreeImpl* active_tree,
                                 LayerTreeHostImpl* host_impl) {
@@ -118,6 +145,9 @@ class CalcDrawPropsTest : public LayerTreeHostCommonPerfTest {
                 ->transform_tree_index()));
     LayerTreeHostCommon::CalculateDrawProperties(&inputs);
   }
+
+ private:
+  TransformChange transform_change_ = TransformChange::kNone;
 };
 
 TEST_F(CalcDrawPropsTest, TenTen) {
@@ -132,6 +162,22 @@ TEST_F(CalcDrawPropsTest, HeavyPage) {
   RunCalcDrawProps();
 }
 
+// Compares updating the whole transform tree to updating one changed node, as
+// for an animated or scrolled layer.
+TEST_F(CalcDrawPropsTest, HeavyPageAllTransformsChanged) {
+  SetTestName("heavy_page_all_transforms_changed");
+  ReadTestFile("heavy_layer_tree");
+  set_transform_change(TransformChange::kAllNodes);
+  RunCalcDrawProps();
+}
+
+TEST_F(CalcDrawPropsTest, HeavyPageOneTransformChanged) {
+  SetTestName("heavy_page_one_transform_changed");
+  ReadTestFile("heavy_layer_tree");
+  set_transform_change(TransformChange::kLastNode);
+  RunCalcDrawProps();
+}
+
 TEST_F(CalcDrawPropsTest, TouchRegionLight) {
   SetTestName("touch_region_light");
   ReadTestFile("touch_region_light");
@@ -172,7 +172,7 @@ void LayerTreeImpl::DidUpdateScrollOffset(ElementId id) {
   if (transform_node->scroll_offset != scroll_tree.current_scroll_offset(id)) {
     transform_node->scroll_offset = scroll_tree.current_scroll_offset(id);
     transform_node->needs_local_transform_update = true;
-    transform_tree.set_needs_update(true);
+    transform_tree.SetNodeNeedsUpdate(transform_node->id);
   }
   transform_node->transform_changed = true;
   property_trees()->changed = true;
@@ -780,7 +780,7 @@ void LayerTreeImpl::UpdatePropertyTreeAnimationFromMainThread() {
     }
     node->local = element_id_to_transform->second;
     node->needs_local_transform_update = true;
-    property_trees_.transform_tree.set_needs_update(true);
+    property_trees_.transform_tree.SetNodeNeedsUpdate(node->id);
     ++element_id_to_transform;
   }
 
@@ -804,7 +804,7 @@ void LayerTreeImpl::UpdateTransformAnimation(ElementId element_id,
         node->has_potential_animation = has_potential_animation;
         node->has_only_translation_animations =
             mutator_host()->HasOnlyTranslationTransforms(element_id, list_type);
-        transform_tree.set_needs_update(true);
+        transform_tree.SetNodeNeedsUpdate(node->id);
         set_needs_update_draw_properties();
       }
     }
@@ -107,6 +107,11 @@ class CC_EXPORT LayerTreeSettings {
   // deferred path.
   size_t min_image_bytes_to_checker = 1 * 1024 * 1024;  // 1MB.
 
+  // The memory kept for compressed copies of the content of evicted software
+  // tiles, used to restore them instead of rastering them again. Zero disables
+  // compression.
+  size_t max_compressed_tile_bytes = 0;
+
   // Disables checkering of images when not using gpu rasterization.
   bool only_checker_images_with_gpu_raster = false;
 
@@ -27,7 +27,7 @@ namespace cc {
 
 template <typename T>
 PropertyTree<T>::PropertyTree()
-    : needs_update_(false) {
+    : needs_update_(false), needs_full_update_(false) {
   nodes_.push_back(T());
   back()->id = kRootNodeId;
   back()->parent_id = kInvalidNodeId;
@@ -73,6 +73,8 @@ int PropertyTree<T>::Insert(const T& tree_node, int parent_id) {
 template <typename T>
 void PropertyTree<T>::clear() {
   needs_update_ = false;
+  needs_full_update_ = false;
+  nodes_needing_update_.clear();
   nodes_.clear();
   nodes_.push_back(T());
   back()->id = kRootNodeId;
@@ -84,6 +86,20 @@ void PropertyTree<T>::clear() {
 #endif
 }
 
+template <typename T>
+void PropertyTree<T>::SetNodeNeedsUpdate(int id) {
+  DCHECK_GT(id, kInvalidNodeId);
+  DCHECK_LT(id, static_cast<int>(size()));
+  // Once about as many nodes changed as there are, updating all of them is
+  // cheaper than finding their descendants.
+  bool needs_full_update = (needs_update_ && needs_full_update_) ||
+                           nodes_needing_update_.size() >= size();
+  if (!needs_full_update)
+    nodes_needing_update_.push_back(id);
+  set_needs_update(true);
+  needs_full_update_ = needs_full_update;
+}
+
 template <typename T>
 bool PropertyTree<T>::operator==(const PropertyTree<T>& other) const {
   return nodes_ == other.nodes() && needs_update_ == other.needs_update();
@@ -198,7 +214,7 @@ bool TransformTree::OnTransformAnimated(ElementId element_id,
   node->needs_local_transform_update = true;
   node->transform_changed = true;
   property_trees()->changed = true;
-  set_needs_update(true);
+  SetNodeNeedsUpdate(node->id);
   return true;
 }
 
@@ -523,19 +539,40 @@ void TransformTree::UpdateLocalTransform(TransformNode* node) {
 void TransformTree::UpdateScreenSpaceTransform(TransformNode* node,
                                                TransformNode* parent_node) {
   DCHECK(parent_node);
-  gfx::Transform to_screen_space_transform = ToScreen(parent_node->id);
+  DCHECK(static_cast<int>(cached_data_.size()) > node->id);
+  // This runs for every node on each update, so the screen space transforms
+  // are computed in place, and nodes that only translate, which are the vast
+  // majority, avoid full matrix multiplications and inversions.
+  const TransformCachedNodeData& parent_data = cached_data_[parent_node->id];
+  TransformCachedNodeData& data = cached_data_[node->id];
+  const bool translates_only = node->to_parent.IsIdentityOrTranslation();
+  const SkMatrix44& to_parent = node->to_parent.matrix();
+
+  data.to_screen = parent_data.to_screen;
   if (node->flattens_inherited_transform)
-    to_screen_space_transform.FlattenTo2d();
-  to_screen_space_transform.PreconcatTransform(node->to_parent);
+    data.to_screen.FlattenTo2d();
+  if (translates_only) {
+    data.to_screen.Translate3d(to_parent.get(0, 3), to_parent.get(1, 3),
+                               to_parent.get(2, 3));
+  } else {
+    data.to_screen.PreconcatTransform(node->to_parent);
+  }
+  data.is_showing_backface = data.to_screen.IsBackFaceVisible();
   node->ancestors_are_invertible = parent_node->ancestors_are_invertible;
   node->node_and_ancestors_are_flat =
       parent_node->node_and_ancestors_are_flat && node->to_parent.IsFlat();
-  SetToScreen(node->id, to_screen_space_transform);
 
-  gfx::Transform from_screen;
-  if (!ToScreen(node->id).GetInverse(&from_screen))
+  // Unless flattening changed the parent's transform, the inverse of a
+  // translated transform is the parent's inverse, translated back.
+  if (translates_only && parent_node->ancestors_are_invertible &&
+      (!node->flattens_inherited_transform ||
+       parent_node->node_and_ancestors_are_flat)) {
+    data.from_screen = parent_data.from_screen;
+    data.from_screen.matrix().postTranslate(
+        -to_parent.get(0, 3), -to_parent.get(1, 3), -to_parent.get(2, 3));
+  } else if (!data.to_screen.GetInverse(&data.from_screen)) {
     node->ancestors_are_invertible = false;
-  SetFromScreen(node->id, from_screen);
+  }
 }
 
 void TransformTree::UpdateAnimationProperties(TransformNode* node,
@@ -871,7 +908,7 @@ bool EffectTree::OnOpacityAnimated(ElementId id, float opacity) {
   node->opacity = opacity;
   node->effect_changed = true;
   property_trees()->changed = true;
-  property_trees()->effect_tree.set_needs_update(true);
+  SetNodeNeedsUpdate(node->id);
   return true;
 }
 
@@ -884,7 +921,7 @@ bool EffectTree::OnFilterAnimated(ElementId id,
   node->filters = filters;
   node->effect_changed = true;
   property_trees()->changed = true;
-  property_trees()->effect_tree.set_needs_update(true);
+  SetNodeNeedsUpdate(node->id);
   return true;
 }
 
@@ -90,9 +90,22 @@ class CC_EXPORT PropertyTree {
 
   virtual void set_needs_update(bool needs_update) {
     needs_update_ = needs_update;
+    needs_full_update_ = needs_update;
+    if (!needs_update)
+      nodes_needing_update_.clear();
   }
   bool needs_update() const { return needs_update_; }
 
+  // Marks only the node |id| as changed, so that the next update can be
+  // limited to it and its descendants, unless all nodes need an update anyway.
+  void SetNodeNeedsUpdate(int id);
+  // Whether all nodes need an update, rather than only the ones passed to
+  // SetNodeNeedsUpdate() and their descendants.
+  bool needs_full_update() const { return needs_full_update_; }
+  const std::vector<int>& nodes_needing_update() const {
+    return nodes_needing_update_;
+  }
+
   std::vector<T>& nodes() { return nodes_; }
   const std::vector<T>& nodes() const { return nodes_; }
 
@@ -108,6 +121,8 @@ class CC_EXPORT PropertyTree {
  protected:
   std::vector<T> nodes_;
   bool needs_update_;
+  bool needs_full_update_;
+  std::vector<int> nodes_needing_update_;
   PropertyTrees* property_trees_;
 };
 
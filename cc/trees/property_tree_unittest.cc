@@ -55,6 +55,93 @@ TEST(PropertyTreeTest, SetNeedsUpdate) {
   EXPECT_FALSE(tree.needs_update());
 }
 
+// Only nodes marked as changed and their descendants are updated.
+TEST(PropertyTreeTest, ComputeTransformsOfChangedSubtree) {
+  PropertyTrees property_trees;
+  TransformTree& tree = property_trees.transform_tree;
+  TransformNode contents_root;
+  contents_root.source_node_id = 0;
+  contents_root.id = tree.Insert(contents_root, 0);
+  TransformNode changed;
+  changed.source_node_id = contents_root.id;
+  changed.id = tree.Insert(changed, contents_root.id);
+  TransformNode sibling;
+  sibling.source_node_id = contents_root.id;
+  sibling.id = tree.Insert(sibling, contents_root.id);
+  TransformNode child;
+  child.source_node_id = changed.id;
+  child.id = tree.Insert(child, changed.id);
+  tree.set_needs_update(true);
+  draw_property_utils::ComputeTransforms(&tree);
+
+  tree.Node(changed.id)->local.Translate(2, 3);
+  tree.Node(changed.id)->needs_local_transform_update = true;
+  tree.SetNodeNeedsUpdate(changed.id);
+  // This change isn't reported, so it is not picked up.
+  tree.Node(sibling.id)->local.Translate(4, 5);
+  tree.Node(sibling.id)->needs_local_transform_update = true;
+  EXPECT_TRUE(tree.needs_update());
+  EXPECT_FALSE(tree.needs_full_update());
+  draw_property_utils::ComputeTransforms(&tree);
+  EXPECT_FALSE(tree.needs_update());
+
+  gfx::Transform expected;
+  expected.Translate(2, 3);
+  EXPECT_TRANSFORMATION_MATRIX_EQ(expected, tree.ToScreen(changed.id));
+  EXPECT_TRANSFORMATION_MATRIX_EQ(expected, tree.ToScreen(child.id));
+  EXPECT_TRANSFORMATION_MATRIX_EQ(gfx::Transform(),
+                                  tree.ToScreen(sibling.id));
+
+  // A full update picks up every change.
+  tree.SetNodeNeedsUpdate(changed.id);
+  tree.set_needs_update(true);
+  EXPECT_TRUE(tree.needs_full_update());
+  draw_property_utils::ComputeTransforms(&tree);
+  expected.MakeIdentity();
+  expected.Translate(4, 5);
+  EXPECT_TRANSFORMATION_MATRIX_EQ(expected, tree.ToScreen(sibling.id));
+}
+
+// Screen space transforms of translated nodes, which skip the full matrix
+// multiplication and inversion, match the general computation.
+TEST(PropertyTreeTest, ComputeTranslatedTransforms) {
+  PropertyTrees property_trees;
+  TransformTree& tree = property_trees.transform_tree;
+  TransformNode contents_root;
+  contents_root.local.Scale(2, 3);
+  contents_root.local.RotateAboutYAxis(30);
+  contents_root.source_node_id = 0;
+  contents_root.id = tree.Insert(contents_root, 0);
+  TransformNode translated;
+  translated.local.Translate3d(5, 7, 11);
+  translated.source_node_id = contents_root.id;
+  translated.id = tree.Insert(translated, contents_root.id);
+  TransformNode flattening;
+  flattening.local.Translate(-3, 4);
+  flattening.flattens_inherited_transform = true;
+  flattening.source_node_id = translated.id;
+  flattening.id = tree.Insert(flattening, translated.id);
+  tree.set_needs_update(true);
+  draw_property_utils::ComputeTransforms(&tree);
+
+  gfx::Transform expected_to_screen = contents_root.local;
+  expected_to_screen.Translate3d(5, 7, 11);
+  EXPECT_TRANSFORMATION_MATRIX_EQ(expected_to_screen,
+                                  tree.ToScreen(translated.id));
+  gfx::Transform expected_from_screen;
+  ASSERT_TRUE(expected_to_screen.GetInverse(&expected_from_screen));
+  EXPECT_TRANSFORMATION_MATRIX_EQ(expected_from_screen,
+                                  tree.FromScreen(translated.id));
+
+  expected_to_screen.FlattenTo2d();
+  expected_to_screen.Translate(-3, 4);
+  EXPECT_TRANSFORMATION_MATRIX_EQ(expected_to_screen,
+                                  tree.ToScreen(flattening.id));
+  ASSERT_TRUE(expected_to_screen.GetInverse(&expected_from_screen));
+  EXPECT_TRANSFORMATION_MATRIX_EQ(expected_from_screen,
+                                  tree.FromScreen(flattening.id));
+}
+
 TEST(PropertyTreeTest, ComputeTransformChild) {
   PropertyTrees property_trees;
   TransformTree& tree = property_trees.transform_tree;
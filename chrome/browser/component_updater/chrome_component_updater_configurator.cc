@@ -49,6 +49,7 @@ class ChromeConfigurator : public update_client::Configurator {
   int NextCheckDelay() const override;
   int OnDemandDelay() const override;
   int UpdateDelay() const override;
+  int MaxConcurrentUpdates() const override;
   std::vector<GURL> UpdateUrl() const override;
   std::vector<GURL> PingUrl() const override;
   std::string GetProdId() const override;
@@ -108,6 +109,10 @@ int ChromeConfigurator::UpdateDelay() const {
   return configurator_impl_.UpdateDelay();
 }
 
+int ChromeConfigurator::MaxConcurrentUpdates() const {
+  return configurator_impl_.MaxConcurrentUpdates();
+}
+
 std::vector<GURL> ChromeConfigurator::UpdateUrl() const {
   return configurator_impl_.UpdateUrl();
 }
@@ -119,6 +119,10 @@ int ChromeUpdateClientConfig::UpdateDelay() const {
   return impl_.UpdateDelay();
 }
 
+int ChromeUpdateClientConfig::MaxConcurrentUpdates() const {
+  return impl_.MaxConcurrentUpdates();
+}
+
 std::vector<GURL> ChromeUpdateClientConfig::UpdateUrl() const {
   return impl_.UpdateUrl();
 }
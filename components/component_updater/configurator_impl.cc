@@ -31,6 +31,10 @@ namespace {
 const int kDelayOneMinute = 60;
 const int kDelayOneHour = kDelayOneMinute * 60;
 
+// Enough to keep the network busy when many components are out of date,
+// e.g. after a long time offline, without competing with browsing for it.
+const int kMaxConcurrentUpdates = 4;
+
 }  // namespace
 
 ConfiguratorImpl::ConfiguratorImpl(
@@ -64,6 +68,10 @@ int ConfiguratorImpl::UpdateDelay() const {
   return fast_update_ ? 10 : (15 * kDelayOneMinute);
 }
 
+int ConfiguratorImpl::MaxConcurrentUpdates() const {
+  return kMaxConcurrentUpdates;
+}
+
 std::vector<GURL> ConfiguratorImpl::UpdateUrl() const {
   if (url_source_override_.is_valid()) {
     return {GURL(url_source_override_)};
@@ -46,6 +46,10 @@ class ConfiguratorImpl {
   // components.
   int UpdateDelay() const;
 
+  // The maximum number of components of an update whose updates are
+  // downloaded and applied at the same time.
+  int MaxConcurrentUpdates() const;
+
   // The URLs for the update checks. The URLs are tried in order, the first one
   // that succeeds wins.
   std::vector<GURL> UpdateUrl() const;
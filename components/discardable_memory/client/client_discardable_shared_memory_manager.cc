@@ -32,6 +32,13 @@ namespace {
 // Default allocation size.
 const size_t kAllocationSize = 4 * 1024 * 1024;
 
+// Free segments kept for future allocations when spans are released.
+const size_t kFreeSegmentsToKeep = 1;
+
+// Segments in which at most this fraction is allocated are purged by
+// PurgeSparseMemory().
+const double kSparseSegmentOccupancy = 0.25;
+
 // Global atomic to generate unique discardable shared memory IDs.
 base::AtomicSequenceNumber g_next_discardable_shared_memory_id;
 
@@ -285,6 +292,21 @@ void ClientDiscardableSharedMemoryManager::ReleaseFreeMemory() {
     MemoryUsageChanged(heap_->GetSize(), heap_->GetSizeOfFreeLists());
 }
 
+void ClientDiscardableSharedMemoryManager::PurgeSparseMemory() {
+  base::AutoLock lock(lock_);
+
+  size_t heap_size_prior_to_releasing_memory = heap_->GetSize();
+
+  size_t bytes_purged = heap_->PurgeSparseSegments(kSparseSegmentOccupancy);
+  TRACE_EVENT1("renderer", "ClientDiscardableSharedMemoryManager::"
+               "PurgeSparseMemory", "bytes_purged", bytes_purged);
+  heap_->ReleasePurgedMemory();
+  heap_->ReleaseFreeMemory();
+
+  if (heap_->GetSize() != heap_size_prior_to_releasing_memory)
+    MemoryUsageChanged(heap_->GetSize(), heap_->GetSizeOfFreeLists());
+}
+
 bool ClientDiscardableSharedMemoryManager::LockSpan(
     DiscardableSharedMemoryHeap::Span* span) {
   base::AutoLock lock(lock_);
@@ -335,6 +357,11 @@ void ClientDiscardableSharedMemoryManager::ReleaseSpan(
 
   heap_->MergeIntoFreeLists(std::move(span));
 
+  // Release segments which the span left free, unless they are needed to
+  // serve allocations without asking the parent process for more memory.
+  if (heap_->GetSizeOfFreeLists() > kFreeSegmentsToKeep * kAllocationSize)
+    heap_->ReleaseFreeSegments(kFreeSegmentsToKeep);
+
   // Bytes of free memory changed.
   MemoryUsageChanged(heap_->GetSize(), heap_->GetSizeOfFreeLists());
 }
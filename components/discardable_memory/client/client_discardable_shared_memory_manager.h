@@ -46,6 +46,11 @@ class DISCARDABLE_MEMORY_EXPORT ClientDiscardableSharedMemoryManager
   // Release memory and associated resources that have been purged.
   void ReleaseFreeMemory();
 
+  // Purge sparsely used segments which aren't locked, then release purged and
+  // free memory. Unlike ReleaseFreeMemory(), this discards unlocked contents
+  // and is meant for memory pressure.
+  void PurgeSparseMemory();
+
   bool LockSpan(DiscardableSharedMemoryHeap::Span* span);
   void UnlockSpan(DiscardableSharedMemoryHeap::Span* span);
   void ReleaseSpan(std::unique_ptr<DiscardableSharedMemoryHeap::Span> span);
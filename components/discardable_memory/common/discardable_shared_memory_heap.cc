@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "base/format_macros.h"
 #include "base/macros.h"
@@ -26,13 +27,19 @@ bool IsInFreeList(DiscardableSharedMemoryHeap::Span* span) {
   return span->previous() || span->next();
 }
 
+// Number of free spans considered when picking the one to allocate from.
+// Bounds the cost of preferring occupied segments on long free lists.
+const size_t kMaxFreeListCandidates = 8;
+
 }  // namespace
 
 DiscardableSharedMemoryHeap::Span::Span(
     base::DiscardableSharedMemory* shared_memory,
+    ScopedMemorySegment* segment,
     size_t start,
     size_t length)
     : shared_memory_(shared_memory),
+      segment_(segment),
       start_(start),
       length_(length),
       is_locked_(false) {}
@@ -64,6 +71,14 @@ bool DiscardableSharedMemoryHeap::ScopedMemorySegment::IsResident() const {
   return heap_->IsMemoryResident(shared_memory_.get());
 }
 
+bool DiscardableSharedMemoryHeap::ScopedMemorySegment::IsPurgeable() const {
+  return IsResident() && !shared_memory_->IsMemoryLocked();
+}
+
+double DiscardableSharedMemoryHeap::ScopedMemorySegment::GetOccupancy() const {
+  return static_cast<double>(allocated_blocks_ * heap_->block_size_) / size_;
+}
+
 bool DiscardableSharedMemoryHeap::ScopedMemorySegment::ContainsSpan(
     Span* span) const {
   return shared_memory_.get() == span->shared_memory();
@@ -121,19 +136,23 @@ DiscardableSharedMemoryHeap::Grow(
       0u);
   DCHECK_EQ(size & (block_size_ - 1), 0u);
 
+  size_t start =
+      reinterpret_cast<size_t>(shared_memory->memory()) / block_size_;
+  base::DiscardableSharedMemory* shared_memory_ptr = shared_memory.get();
+
+  // Start tracking if segment is resident by adding it to |memory_segments_|.
+  memory_segments_.push_back(std::make_unique<ScopedMemorySegment>(
+      this, std::move(shared_memory), size, id, deleted_callback));
+  ScopedMemorySegment* segment = memory_segments_.back().get();
+
   std::unique_ptr<Span> span(
-      new Span(shared_memory.get(),
-               reinterpret_cast<size_t>(shared_memory->memory()) / block_size_,
-               size / block_size_));
+      new Span(shared_memory_ptr, segment, start, size / block_size_));
   DCHECK(spans_.find(span->start_) == spans_.end());
   DCHECK(spans_.find(span->start_ + span->length_ - 1) == spans_.end());
   RegisterSpan(span.get());
 
   num_blocks_ += span->length_;
-
-  // Start tracking if segment is resident by adding it to |memory_segments_|.
-  memory_segments_.push_back(std::make_unique<ScopedMemorySegment>(
-      this, std::move(shared_memory), size, id, deleted_callback));
+  segment->DidAllocate(span->length_);
 
   return span;
 }
@@ -144,6 +163,7 @@ void DiscardableSharedMemoryHeap::MergeIntoFreeLists(
 
   // First add length of |span| to |num_free_blocks_|.
   num_free_blocks_ += span->length_;
+  span->segment_->DidFree(span->length_);
 
   // Merge with previous span if possible.
   SpanMap::iterator prev_it = spans_.find(span->start_ - 1);
@@ -178,8 +198,9 @@ DiscardableSharedMemoryHeap::Split(Span* span, size_t blocks) {
   DCHECK(blocks);
   DCHECK_LT(blocks, span->length_);
 
-  std::unique_ptr<Span> leftover(new Span(
-      span->shared_memory_, span->start_ + blocks, span->length_ - blocks));
+  std::unique_ptr<Span> leftover(new Span(span->shared_memory_, span->segment_,
+                                          span->start_ + blocks,
+                                          span->length_ - blocks));
   DCHECK(leftover->length_ == 1 ||
          spans_.find(leftover->start_) == spans_.end());
   RegisterSpan(leftover.get());
@@ -198,10 +219,8 @@ DiscardableSharedMemoryHeap::SearchFreeLists(size_t blocks, size_t slack) {
   // Search array of free lists for a suitable span.
   while (length - 1 < arraysize(free_spans_) - 1) {
     const base::LinkedList<Span>& free_spans = free_spans_[length - 1];
-    if (!free_spans.empty()) {
-      // Return the most recently used span located in tail.
-      return Carve(free_spans.tail()->value(), blocks);
-    }
+    if (!free_spans.empty())
+      return Carve(SelectFromFreeList(free_spans, length, length), blocks);
 
     // Return early after surpassing |max_length|.
     if (++length > max_length)
@@ -211,16 +230,9 @@ DiscardableSharedMemoryHeap::SearchFreeLists(size_t blocks, size_t slack) {
   const base::LinkedList<Span>& overflow_free_spans =
       free_spans_[arraysize(free_spans_) - 1];
 
-  // Search overflow free list for a suitable span. Starting with the most
-  // recently used span located in tail and moving towards head.
-  for (base::LinkNode<Span>* node = overflow_free_spans.tail();
-       node != overflow_free_spans.end(); node = node->previous()) {
-    Span* span = node->value();
-    if (span->length_ >= blocks && span->length_ <= max_length)
-      return Carve(span, blocks);
-  }
-
-  return nullptr;
+  // Search overflow free list for a suitable span.
+  Span* span = SelectFromFreeList(overflow_free_spans, blocks, max_length);
+  return span ? Carve(span, blocks) : nullptr;
 }
 
 void DiscardableSharedMemoryHeap::ReleaseFreeMemory() {
@@ -245,6 +257,42 @@ void DiscardableSharedMemoryHeap::ReleasePurgedMemory() {
       memory_segments_.end());
 }
 
+void DiscardableSharedMemoryHeap::ReleaseFreeSegments(size_t segments_to_keep) {
+  // Keep the free segments which were added last, as the older ones are the
+  // most likely to have been left behind by a drop in usage.
+  size_t free_segments_seen = 0;
+  auto is_released = [&free_segments_seen, segments_to_keep](
+                         const std::unique_ptr<ScopedMemorySegment>& segment) {
+    return !segment->IsUsed() && ++free_segments_seen > segments_to_keep;
+  };
+  // Partitioning the reversed segments moves the released ones to the end.
+  auto last_released = std::stable_partition(
+      memory_segments_.rbegin(), memory_segments_.rend(), is_released);
+  memory_segments_.erase(last_released.base(), memory_segments_.end());
+}
+
+size_t DiscardableSharedMemoryHeap::PurgeSparseSegments(double max_occupancy) {
+  std::vector<ScopedMemorySegment*> sparse_segments;
+  for (const std::unique_ptr<ScopedMemorySegment>& segment : memory_segments_) {
+    if (segment->IsUsed() && segment->GetOccupancy() <= max_occupancy &&
+        segment->IsPurgeable()) {
+      sparse_segments.push_back(segment.get());
+    }
+  }
+  std::sort(sparse_segments.begin(), sparse_segments.end(),
+            [](const ScopedMemorySegment* a, const ScopedMemorySegment* b) {
+              return a->GetOccupancy() < b->GetOccupancy();
+            });
+
+  size_t bytes_purged = 0;
+  base::Time now = base::Time::Now();
+  for (ScopedMemorySegment* segment : sparse_segments) {
+    if (segment->shared_memory()->Purge(now))
+      bytes_purged += segment->size();
+  }
+  return bytes_purged;
+}
+
 size_t DiscardableSharedMemoryHeap::GetSize() const {
   return num_blocks_ * block_size_;
 }
@@ -282,8 +330,9 @@ DiscardableSharedMemoryHeap::Carve(Span* span, size_t blocks) {
 
   const size_t extra = serving->length_ - blocks;
   if (extra) {
-    std::unique_ptr<Span> leftover(
-        new Span(serving->shared_memory_, serving->start_ + blocks, extra));
+    std::unique_ptr<Span> leftover(new Span(serving->shared_memory_,
+                                            serving->segment_,
+                                            serving->start_ + blocks, extra));
     leftover->set_is_locked(false);
     DCHECK(extra == 1 || spans_.find(leftover->start_) == spans_.end());
     RegisterSpan(leftover.get());
@@ -301,10 +350,35 @@ DiscardableSharedMemoryHeap::Carve(Span* span, size_t blocks) {
   // |num_free_blocks_|.
   DCHECK_GE(num_free_blocks_, serving->length_);
   num_free_blocks_ -= serving->length_;
+  serving->segment_->DidAllocate(serving->length_);
 
   return serving;
 }
 
+DiscardableSharedMemoryHeap::Span*
+DiscardableSharedMemoryHeap::SelectFromFreeList(
+    const base::LinkedList<Span>& free_spans,
+    size_t min_length,
+    size_t max_length) const {
+  Span* best_span = nullptr;
+  size_t candidates = 0;
+  // Start with the most recently used span located in tail and move towards
+  // head. Ties go to the most recently used span.
+  for (base::LinkNode<Span>* node = free_spans.tail();
+       node != free_spans.end() && candidates < kMaxFreeListCandidates;
+       node = node->previous()) {
+    Span* span = node->value();
+    if (span->length_ < min_length || span->length_ > max_length)
+      continue;
+    ++candidates;
+    if (!best_span || span->segment_->GetOccupancy() >
+                          best_span->segment_->GetOccupancy()) {
+      best_span = span;
+    }
+  }
+  return best_span;
+}
+
 void DiscardableSharedMemoryHeap::RegisterSpan(Span* span) {
   spans_[span->start_] = span;
   if (span->length_ > 1)
@@ -351,6 +425,7 @@ void DiscardableSharedMemoryHeap::ReleaseMemory(
     Span* span = spans_[offset];
     DCHECK_EQ(span->shared_memory_, shared_memory);
     span->shared_memory_ = nullptr;
+    span->segment_ = nullptr;
     UnregisterSpan(span);
 
     offset += span->length_;
@@ -14,6 +14,7 @@
 #include "base/callback.h"
 #include "base/containers/hash_tables.h"
 #include "base/containers/linked_list.h"
+#include "base/logging.h"
 #include "base/macros.h"
 #include "base/trace_event/process_memory_dump.h"
 #include "components/discardable_memory/common/discardable_memory_export.h"
@@ -26,7 +27,15 @@ namespace discardable_memory {
 
 // Implements a heap of discardable shared memory. An array of free lists
 // is used to keep track of free blocks.
+//
+// Spans can't be moved once allocated, so the heap limits fragmentation by
+// where it allocates: free spans in the most occupied segments are handed
+// out first, which lets sparsely used segments drain until they can be
+// released or purged.
 class DISCARDABLE_MEMORY_EXPORT DiscardableSharedMemoryHeap {
+ private:
+  class ScopedMemorySegment;
+
  public:
   class DISCARDABLE_MEMORY_EXPORT Span : public base::LinkNode<Span> {
    public:
@@ -41,10 +50,12 @@ class DISCARDABLE_MEMORY_EXPORT DiscardableSharedMemoryHeap {
     friend class DiscardableSharedMemoryHeap;
 
     Span(base::DiscardableSharedMemory* shared_memory,
+         ScopedMemorySegment* segment,
          size_t start,
          size_t length);
 
     base::DiscardableSharedMemory* shared_memory_;
+    ScopedMemorySegment* segment_;
     size_t start_;
     size_t length_;
     bool is_locked_;
@@ -87,6 +98,16 @@ class DISCARDABLE_MEMORY_EXPORT DiscardableSharedMemoryHeap {
   // Release shared memory segments that have been purged.
   void ReleasePurgedMemory();
 
+  // Release free shared memory segments, keeping at most |segments_to_keep|
+  // of them around for future allocations.
+  void ReleaseFreeSegments(size_t segments_to_keep);
+
+  // Purge the unlocked segments in which at most |max_occupancy| of the
+  // memory is allocated, least occupied first. These hold the least data for
+  // the memory they use. Returns the number of bytes purged, which are
+  // released by the next call to ReleasePurgedMemory().
+  size_t PurgeSparseSegments(double max_occupancy);
+
   // Returns total bytes of memory in heap.
   size_t GetSize() const;
 
@@ -116,6 +137,21 @@ class DISCARDABLE_MEMORY_EXPORT DiscardableSharedMemoryHeap {
 
     bool IsUsed() const;
     bool IsResident() const;
+    bool IsPurgeable() const;
+
+    // Fraction of the segment which is allocated.
+    double GetOccupancy() const;
+    size_t size() const { return size_; }
+    base::DiscardableSharedMemory* shared_memory() const {
+      return shared_memory_.get();
+    }
+
+    // Called when |blocks| of the segment are allocated or freed.
+    void DidAllocate(size_t blocks) { allocated_blocks_ += blocks; }
+    void DidFree(size_t blocks) {
+      DCHECK_GE(allocated_blocks_, blocks);
+      allocated_blocks_ -= blocks;
+    }
 
     bool ContainsSpan(Span* span) const;
 
@@ -134,6 +170,7 @@ class DISCARDABLE_MEMORY_EXPORT DiscardableSharedMemoryHeap {
     const size_t size_;
     const int32_t id_;
     const base::Closure deleted_callback_;
+    size_t allocated_blocks_ = 0;
 
     DISALLOW_COPY_AND_ASSIGN(ScopedMemorySegment);
   };
@@ -141,6 +178,12 @@ class DISCARDABLE_MEMORY_EXPORT DiscardableSharedMemoryHeap {
   void InsertIntoFreeList(std::unique_ptr<Span> span);
   std::unique_ptr<Span> RemoveFromFreeList(Span* span);
   std::unique_ptr<Span> Carve(Span* span, size_t blocks);
+  // Returns the span in the most occupied segment among the first
+  // candidates found in |free_spans|, from most recently used to least, which
+  // are at least |min_length| and at most |max_length| blocks.
+  Span* SelectFromFreeList(const base::LinkedList<Span>& free_spans,
+                           size_t min_length,
+                           size_t max_length) const;
   void RegisterSpan(Span* span);
   void UnregisterSpan(Span* span);
   bool IsMemoryUsed(const base::DiscardableSharedMemory* shared_memory,
@@ -96,5 +96,68 @@ TEST(DiscardableSharedMemoryHeapTest, SearchFreeLists) {
                          count / accumulator.InSecondsF(), "runs/s", true);
 }
 
+TEST(DiscardableSharedMemoryHeapTest, ReleaseAfterChurn) {
+  size_t block_size = base::GetPageSize();
+  DiscardableSharedMemoryHeap heap(block_size);
+
+  const size_t kBlocks = 256;
+  const size_t kSegments = 16;
+  const size_t kMaxSpanBlocks = 16;
+  const int kIterations = 100000;
+  size_t segment_size = block_size * kBlocks;
+  int next_discardable_shared_memory_id = 0;
+
+  for (size_t i = 0; i < kSegments; ++i) {
+    std::unique_ptr<base::DiscardableSharedMemory> memory(
+        new base::DiscardableSharedMemory);
+    ASSERT_TRUE(memory->CreateAndMap(segment_size));
+    heap.MergeIntoFreeLists(heap.Grow(std::move(memory), segment_size,
+                                      next_discardable_shared_memory_id++,
+                                      base::Bind(NullTask)));
+  }
+
+  unsigned kSeed = 1;
+  // Use kSeed as seed for random number generator.
+  srand(kSeed);
+
+  // Allocate and free spans of random sizes, keeping the heap about half
+  // full, then free most of them as happens when usage drops.
+  std::vector<std::unique_ptr<DiscardableSharedMemoryHeap::Span>> spans;
+  size_t allocated_blocks = 0;
+  for (int i = 0; i < kIterations; ++i) {
+    size_t blocks = 1 + std::rand() % kMaxSpanBlocks;
+    if (allocated_blocks + blocks <= kSegments * kBlocks / 2) {
+      std::unique_ptr<DiscardableSharedMemoryHeap::Span> span =
+          heap.SearchFreeLists(blocks, 0);
+      if (span) {
+        allocated_blocks += blocks;
+        spans.push_back(std::move(span));
+        continue;
+      }
+    }
+    if (spans.empty())
+      continue;
+    std::swap(spans[std::rand() % spans.size()], spans.back());
+    allocated_blocks -= spans.back()->length();
+    heap.MergeIntoFreeLists(std::move(spans.back()));
+    spans.pop_back();
+  }
+  std::random_shuffle(spans.begin(), spans.end());
+  for (size_t i = spans.size() / 8; i < spans.size(); ++i)
+    heap.MergeIntoFreeLists(std::move(spans[i]));
+  spans.resize(spans.size() / 8);
+
+  // Segments left without allocated spans can be returned to the system.
+  size_t size_before_release = heap.GetSize();
+  heap.ReleaseFreeSegments(0);
+  perf_test::PrintResult(
+      "release_after_churn", "", "",
+      100.0 * (size_before_release - heap.GetSize()) / size_before_release,
+      "%", true);
+
+  for (auto& span : spans)
+    heap.MergeIntoFreeLists(std::move(span));
+}
+
 }  // namespace
 }  // namespace discardable_memory
@@ -281,6 +281,113 @@ TEST(DiscardableSharedMemoryHeapTest, Slack) {
   heap.MergeIntoFreeLists(std::move(span));
 }
 
+TEST(DiscardableSharedMemoryHeapTest, PreferOccupiedSegment) {
+  size_t block_size = base::GetPageSize();
+  DiscardableSharedMemoryHeap heap(block_size);
+  int next_discardable_shared_memory_id = 0;
+
+  const size_t kBlocks = 4;
+  size_t memory_size = block_size * kBlocks;
+
+  std::unique_ptr<base::DiscardableSharedMemory> memory1(
+      new base::DiscardableSharedMemory);
+  ASSERT_TRUE(memory1->CreateAndMap(2 * memory_size));
+  std::unique_ptr<DiscardableSharedMemoryHeap::Span> span1 =
+      heap.Grow(std::move(memory1), 2 * memory_size,
+                next_discardable_shared_memory_id++, base::Bind(NullTask));
+  std::unique_ptr<base::DiscardableSharedMemory> memory2(
+      new base::DiscardableSharedMemory);
+  ASSERT_TRUE(memory2->CreateAndMap(memory_size));
+  std::unique_ptr<DiscardableSharedMemoryHeap::Span> span2 =
+      heap.Grow(std::move(memory2), memory_size,
+                next_discardable_shared_memory_id++, base::Bind(NullTask));
+
+  // Leave half of the first segment allocated and free all of the second
+  // segment, which makes it the most recently used span of the same length.
+  heap.MergeIntoFreeLists(heap.Split(span1.get(), kBlocks));
+  heap.MergeIntoFreeLists(std::move(span2));
+
+  // The allocation is served by the first segment, which is occupied, rather
+  // than by the most recently used span.
+  std::unique_ptr<DiscardableSharedMemoryHeap::Span> span =
+      heap.SearchFreeLists(kBlocks, 0);
+  ASSERT_TRUE(span);
+  EXPECT_EQ(span1->shared_memory(), span->shared_memory());
+
+  heap.MergeIntoFreeLists(std::move(span));
+  heap.MergeIntoFreeLists(std::move(span1));
+}
+
+TEST(DiscardableSharedMemoryHeapTest, ReleaseFreeSegments) {
+  size_t block_size = base::GetPageSize();
+  DiscardableSharedMemoryHeap heap(block_size);
+  int next_discardable_shared_memory_id = 0;
+
+  const size_t kSegments = 3;
+  std::unique_ptr<DiscardableSharedMemoryHeap::Span> used_span;
+  for (size_t i = 0; i < kSegments; ++i) {
+    std::unique_ptr<base::DiscardableSharedMemory> memory(
+        new base::DiscardableSharedMemory);
+    ASSERT_TRUE(memory->CreateAndMap(block_size));
+    std::unique_ptr<DiscardableSharedMemoryHeap::Span> span =
+        heap.Grow(std::move(memory), block_size,
+                  next_discardable_shared_memory_id++, base::Bind(NullTask));
+    if (i == 0)
+      used_span = std::move(span);
+    else
+      heap.MergeIntoFreeLists(std::move(span));
+  }
+  EXPECT_EQ(kSegments * block_size, heap.GetSize());
+
+  // Segments in use are never released.
+  heap.ReleaseFreeSegments(1);
+  EXPECT_EQ(2 * block_size, heap.GetSize());
+  EXPECT_EQ(block_size, heap.GetSizeOfFreeLists());
+  heap.ReleaseFreeSegments(0);
+  EXPECT_EQ(block_size, heap.GetSize());
+  EXPECT_EQ(0u, heap.GetSizeOfFreeLists());
+
+  heap.MergeIntoFreeLists(std::move(used_span));
+}
+
+TEST(DiscardableSharedMemoryHeapTest, PurgeSparseSegments) {
+  size_t block_size = base::GetPageSize();
+  DiscardableSharedMemoryHeap heap(block_size);
+  int next_discardable_shared_memory_id = 0;
+
+  const size_t kBlocks = 4;
+  size_t memory_size = block_size * kBlocks;
+
+  std::unique_ptr<base::DiscardableSharedMemory> memory1(
+      new base::DiscardableSharedMemory);
+  ASSERT_TRUE(memory1->CreateAndMap(memory_size));
+  std::unique_ptr<DiscardableSharedMemoryHeap::Span> span1 =
+      heap.Grow(std::move(memory1), memory_size,
+                next_discardable_shared_memory_id++, base::Bind(NullTask));
+  std::unique_ptr<base::DiscardableSharedMemory> memory2(
+      new base::DiscardableSharedMemory);
+  ASSERT_TRUE(memory2->CreateAndMap(memory_size));
+  std::unique_ptr<DiscardableSharedMemoryHeap::Span> span2 =
+      heap.Grow(std::move(memory2), memory_size,
+                next_discardable_shared_memory_id++, base::Bind(NullTask));
+
+  // Only one block of the first segment stays allocated.
+  heap.MergeIntoFreeLists(heap.Split(span1.get(), 1));
+
+  // Locked segments are never purged.
+  EXPECT_EQ(0u, heap.PurgeSparseSegments(0.5));
+
+  span1->shared_memory()->Unlock(0, 0);
+  span2->shared_memory()->Unlock(0, 0);
+  EXPECT_EQ(0u, heap.PurgeSparseSegments(0.1));
+  EXPECT_EQ(memory_size, heap.PurgeSparseSegments(0.5));
+  EXPECT_FALSE(span1->shared_memory()->IsMemoryResident());
+  EXPECT_TRUE(span2->shared_memory()->IsMemoryResident());
+
+  heap.ReleasePurgedMemory();
+  EXPECT_EQ(memory_size, heap.GetSize());
+}
+
 void OnDeleted(bool* deleted) {
   *deleted = true;
 }
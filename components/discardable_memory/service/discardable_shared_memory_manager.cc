@@ -316,6 +316,8 @@ bool DiscardableSharedMemoryManager::OnMemoryDump(
   for (const auto& client_entry : clients_) {
     const int client_id = client_entry.first;
     const MemorySegmentMap& client_segments = client_entry.second;
+    size_t client_size = 0;
+    size_t client_locked_size = 0;
     for (const auto& segment_entry : client_segments) {
       const int segment_id = segment_entry.first;
       const MemorySegment* segment = segment_entry.second.get();
@@ -339,7 +341,27 @@ bool DiscardableSharedMemoryManager::OnMemoryDump(
 
       segment->memory()->CreateSharedMemoryOwnershipEdge(dump, pmd,
                                                          /*is_owned=*/false);
+
+      client_size += segment->memory()->mapped_size();
+      if (segment->memory()->IsMemoryLocked())
+        client_locked_size += segment->memory()->mapped_size();
     }
+
+    // Usage of each client, which tells which process holds on to the most
+    // discardable memory.
+    base::trace_event::MemoryAllocatorDump* client_dump =
+        pmd->CreateAllocatorDump(
+            base::StringPrintf("discardable/process_%x", client_id));
+    client_dump->AddScalar(base::trace_event::MemoryAllocatorDump::kNameSize,
+                           base::trace_event::MemoryAllocatorDump::kUnitsBytes,
+                           client_size);
+    client_dump->AddScalar("locked_size",
+                           base::trace_event::MemoryAllocatorDump::kUnitsBytes,
+                           client_locked_size);
+    client_dump->AddScalar(
+        base::trace_event::MemoryAllocatorDump::kNameObjectCount,
+        base::trace_event::MemoryAllocatorDump::kUnitsObjects,
+        client_segments.size());
   }
   return true;
 }
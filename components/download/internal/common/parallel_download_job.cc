@@ -5,6 +5,7 @@
 #include "components/download/internal/common/parallel_download_job.h"
 
 #include <algorithm>
+#include <limits>
 
 #include "base/bind.h"
 #include "base/metrics/histogram_macros.h"
@@ -18,6 +19,9 @@
 namespace download {
 namespace {
 const int kDownloadJobVerboseLevel = 1;
+
+// How often the progress of the parallel requests is checked.
+constexpr base::TimeDelta kRebalanceInterval = base::TimeDelta::FromSeconds(2);
 }  // namespace
 
 ParallelDownloadJob::ParallelDownloadJob(
@@ -33,6 +37,7 @@ ParallelDownloadJob::ParallelDownloadJob(
       content_length_(create_info.total_bytes),
       requests_sent_(false),
       is_canceled_(false),
+      range_request_failed_(false),
       url_loader_factory_getter_(std::move(url_loader_factory_getter)),
       url_request_context_getter_(url_request_context_getter) {}
 
@@ -51,6 +56,7 @@ void ParallelDownloadJob::OnDownloadFileInitialized(
 void ParallelDownloadJob::Cancel(bool user_cancel) {
   is_canceled_ = true;
   DownloadJobImpl::Cancel(user_cancel);
+  rebalance_timer_.Stop();
 
   if (!requests_sent_) {
     timer_.Stop();
@@ -63,6 +69,7 @@ void ParallelDownloadJob::Cancel(bool user_cancel) {
 
 void ParallelDownloadJob::Pause() {
   DownloadJobImpl::Pause();
+  rebalance_timer_.Stop();
 
   if (!requests_sent_) {
     timer_.Stop();
@@ -87,6 +94,13 @@ void ParallelDownloadJob::Resume(bool resume_request) {
 
   for (auto& worker : workers_)
     worker.second->Resume();
+
+  // Rates measured before the pause don't apply anymore.
+  hole_progress_.clear();
+  if (!range_request_failed_ && GetParallelRequestCount() > 1) {
+    rebalance_timer_.Start(FROM_HERE, kRebalanceInterval, this,
+                           &ParallelDownloadJob::RebalanceSlices);
+  }
 }
 
 int ParallelDownloadJob::GetParallelRequestCount() const {
@@ -135,6 +149,9 @@ void ParallelDownloadJob::OnInputStreamReady(
 
   // Destroy the request if the sink is gone.
   if (!success) {
+    // The server may not honor the ranges of further requests either.
+    range_request_failed_ = true;
+    rebalance_timer_.Stop();
     VLOG(kDownloadJobVerboseLevel)
         << "Byte stream arrived after download file is released.";
     worker->Cancel(false);
@@ -211,6 +228,105 @@ void ParallelDownloadJob::BuildParallelRequests() {
   RecordParallelDownloadRequestCount(
       static_cast<int>(slices_to_download.size()));
   requests_sent_ = true;
+
+  if (GetParallelRequestCount() > 1) {
+    rebalance_timer_.Start(FROM_HERE, kRebalanceInterval, this,
+                           &ParallelDownloadJob::RebalanceSlices);
+  }
+}
+
+void ParallelDownloadJob::RebalanceSlices() {
+  if (is_canceled_ || is_paused() || range_request_failed_ ||
+      download_item_->GetState() != DownloadItem::DownloadState::IN_PROGRESS) {
+    return;
+  }
+  const int64_t total_bytes = download_item_->GetTotalBytes();
+  if (total_bytes <= 0)
+    return;
+
+  const DownloadItem::ReceivedSlices& received_slices =
+      download_item_->GetReceivedSlices();
+  DownloadItem::ReceivedSlices holes = FindSlicesToDownload(received_slices);
+  if (!received_slices.empty() && received_slices.back().finished)
+    holes.pop_back();
+
+  // Splits that received data are active connections like the others.
+  for (auto it = pending_split_offsets_.begin();
+       it != pending_split_offsets_.end();) {
+    bool received = false;
+    for (const auto& slice : received_slices) {
+      if (*it >= slice.offset && *it < slice.offset + slice.received_bytes) {
+        received = true;
+        break;
+      }
+    }
+    it = received ? pending_split_offsets_.erase(it) : std::next(it);
+  }
+
+  // Find the hole which will take the longest to fill at its current rate.
+  const base::TimeTicks now = base::TimeTicks::Now();
+  std::map<int64_t, HoleProgress> hole_progress;
+  int64_t slowest_hole_offset = -1;
+  int64_t slowest_hole_length = 0;
+  int64_t slowest_remaining_time = 0;
+  for (const auto& hole : holes) {
+    int64_t end = hole.received_bytes == DownloadSaveInfo::kLengthFullContent
+                      ? total_bytes
+                      : hole.offset + hole.received_bytes;
+    if (end <= hole.offset)
+      continue;
+    HoleProgress& progress = hole_progress[end];
+    progress.remaining_bytes = end - hole.offset;
+
+    auto previous = hole_progress_.find(end);
+    if (previous == hole_progress_.end())
+      continue;
+    progress.rate = previous->second.rate;
+    int64_t bytes_filled =
+        previous->second.remaining_bytes - progress.remaining_bytes;
+    if (bytes_filled > 0) {
+      progress.rate.Increment(
+          static_cast<uint32_t>(std::min<int64_t>(
+              bytes_filled, std::numeric_limits<uint32_t>::max())),
+          now);
+    }
+
+    // Don't split a hole twice before the first split receives data.
+    auto split = pending_split_offsets_.lower_bound(hole.offset);
+    if (split != pending_split_offsets_.end() && *split < end)
+      continue;
+
+    // A stalled connection isn't measured, and splitting it wouldn't help.
+    int64_t bytes_per_second =
+        static_cast<int64_t>(progress.rate.GetCountPerSecond(now));
+    if (bytes_per_second <= 0)
+      continue;
+    int64_t remaining_time = progress.remaining_bytes / bytes_per_second;
+    if (remaining_time > slowest_remaining_time) {
+      slowest_hole_offset = hole.offset;
+      slowest_hole_length = progress.remaining_bytes;
+      slowest_remaining_time = remaining_time;
+    }
+  }
+  hole_progress_.swap(hole_progress);
+
+  int connection_count =
+      static_cast<int>(holes.size() + pending_split_offsets_.size());
+  if (slowest_hole_offset < 0 || connection_count >= GetParallelRequestCount())
+    return;
+  if (slowest_hole_length < 2 * GetMinSliceSize() ||
+      slowest_remaining_time <= GetMinRemainingTimeInSeconds()) {
+    return;
+  }
+
+  int64_t offset = slowest_hole_offset + slowest_hole_length / 2;
+  if (workers_.find(offset) != workers_.end())
+    return;
+  VLOG(kDownloadJobVerboseLevel)
+      << "Splitting slow hole at " << slowest_hole_offset << ", new request at "
+      << offset;
+  pending_split_offsets_.insert(offset);
+  CreateRequest(offset, DownloadSaveInfo::kLengthFullContent);
 }
 
 void ParallelDownloadJob::ForkSubRequests(
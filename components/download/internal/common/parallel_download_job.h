@@ -5,7 +5,9 @@
 #ifndef COMPONENTS_DOWNLOAD_INTERNAL_COMMON_PARALLEL_DOWNLOAD_JOB_H_
 #define COMPONENTS_DOWNLOAD_INTERNAL_COMMON_PARALLEL_DOWNLOAD_JOB_H_
 
+#include <map>
 #include <memory>
+#include <set>
 #include <unordered_map>
 #include <vector>
 
@@ -15,6 +17,7 @@
 #include "components/download/internal/common/download_worker.h"
 #include "components/download/public/common/download_export.h"
 #include "components/download/public/common/parallel_download_configs.h"
+#include "components/download/public/common/rate_estimator.h"
 
 namespace net {
 class URLRequestContextGetter;
@@ -85,6 +88,12 @@ class COMPONENTS_DOWNLOAD_EXPORT ParallelDownloadJob
   // The first slice represents the original request.
   void ForkSubRequests(const DownloadItem::ReceivedSlices& slices_to_download);
 
+  // Measures how fast each hole in the file is being filled, and if fewer
+  // connections than GetParallelRequestCount() are active, creates a request
+  // for the second half of the hole that will take the longest to fill. The
+  // connection filling that hole stops once it reaches the new request's data.
+  void RebalanceSlices();
+
   // Create one range request, virtual for testing. Range request will start
   // from |offset| to |length|. Range request will be half open, e.g.
   // "Range:50-" if |length| is 0.
@@ -107,6 +116,27 @@ class COMPONENTS_DOWNLOAD_EXPORT ParallelDownloadJob
   // Used to send parallel requests after a delay based on Finch config.
   base::OneShotTimer timer_;
 
+  // Progress of the connection filling a hole in the file.
+  struct HoleProgress {
+    int64_t remaining_bytes = 0;
+    RateEstimator rate;
+  };
+
+  // Progress of the holes seen by the last RebalanceSlices() call, keyed by the
+  // end offset of the hole, which doesn't change while the hole is filled.
+  std::map<int64_t, HoleProgress> hole_progress_;
+
+  // Offsets of the requests created by RebalanceSlices() that haven't received
+  // data yet.
+  std::set<int64_t> pending_split_offsets_;
+
+  // Periodically calls RebalanceSlices() once parallel requests are sent.
+  base::RepeatingTimer rebalance_timer_;
+
+  // If a server response didn't match a range request, in which case no more
+  // requests are created.
+  bool range_request_failed_;
+
   // If we have sent parallel requests.
   bool requests_sent_;
 
@@ -152,6 +152,8 @@ class ParallelDownloadJobTest : public testing::Test {
 
   void BuildParallelRequests() { job_->BuildParallelRequests(); }
 
+  void RebalanceSlices() { job_->RebalanceSlices(); }
+
   void set_received_slices(const DownloadItem::ReceivedSlices& slices) {
     received_slices_ = slices;
   }
@@ -394,6 +396,40 @@ TEST_F(ParallelDownloadJobTest, LastReceivedSliceFinished) {
   DestroyParallelJob();
 }
 
+// Verifies that the hole filled the slowest is split in two once another
+// connection finishes.
+TEST_F(ParallelDownloadJobTest, SplitSlowestHole) {
+  CreateParallelJob(0, 900, DownloadItem::ReceivedSlices(), 3, 1, 0);
+  BuildParallelRequests();
+  EXPECT_EQ(2u, job_->workers().size());
+  VerifyWorker(300, 0);
+  VerifyWorker(600, 0);
+
+  // No connection is free, and no rates are known yet.
+  set_received_slices({DownloadItem::ReceivedSlice(0, 100),
+                       DownloadItem::ReceivedSlice(300, 50),
+                       DownloadItem::ReceivedSlice(600, 250)});
+  RebalanceSlices();
+  EXPECT_EQ(2u, job_->workers().size());
+
+  // The last connection finished, and the first hole fills slower than the
+  // second one.
+  set_received_slices({DownloadItem::ReceivedSlice(0, 110),
+                       DownloadItem::ReceivedSlice(300, 150),
+                       DownloadItem::ReceivedSlice(600, 300, true)});
+  RebalanceSlices();
+  EXPECT_EQ(3u, job_->workers().size());
+  VerifyWorker(205, 0);
+
+  // The hole isn't split again until the new request receives data.
+  set_received_slices({DownloadItem::ReceivedSlice(0, 120),
+                       DownloadItem::ReceivedSlice(300, 160),
+                       DownloadItem::ReceivedSlice(600, 300, true)});
+  RebalanceSlices();
+  EXPECT_EQ(3u, job_->workers().size());
+  DestroyParallelJob();
+}
+
 // Pause, cancel, resume can be called before or after the worker establish
 // the byte stream.
 // These tests ensure the states consistency between the job and workers.
@@ -4,6 +4,9 @@
 
 #include "components/leveldb_proto/leveldb_database.h"
 
+#include <inttypes.h>
+
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -11,7 +14,11 @@
 #include "base/files/file_util.h"
 #include "base/metrics/histogram.h"
 #include "base/strings/string_split.h"
+#include "base/strings/stringprintf.h"
+#include "base/threading/sequenced_task_runner_handle.h"
 #include "base/threading/thread_checker.h"
+#include "base/trace_event/memory_dump_manager.h"
+#include "base/trace_event/process_memory_dump.h"
 #include "third_party/leveldatabase/env_chromium.h"
 #include "third_party/leveldatabase/leveldb_chrome.h"
 #include "third_party/leveldatabase/src/include/leveldb/cache.h"
@@ -24,8 +31,16 @@
 
 namespace leveldb_proto {
 
+namespace {
+
+const int64_t kMinWriteBufferSize = 64 * 1024;
+
+}  // namespace
+
 LevelDB::LevelDB(const char* client_name)
-    : open_histogram_(nullptr), destroy_histogram_(nullptr) {
+    : client_name_(client_name),
+      open_histogram_(nullptr),
+      destroy_histogram_(nullptr) {
   // Used in lieu of UMA_HISTOGRAM_ENUMERATION because the histogram name is
   // not a constant.
   open_histogram_ = base::LinearHistogram::FactoryGet(
@@ -40,6 +55,10 @@ LevelDB::LevelDB(const char* client_name)
 
 LevelDB::~LevelDB() {
   DFAKE_SCOPED_LOCK(thread_checker_);
+  if (dump_provider_registered_) {
+    base::trace_event::MemoryDumpManager::GetInstance()->UnregisterDumpProvider(
+        this);
+  }
 }
 
 bool LevelDB::Init(const base::FilePath& database_dir,
@@ -53,6 +72,19 @@ bool LevelDB::Init(const base::FilePath& database_dir,
     open_options_.env = env_.get();
   }
 
+  if (open_options_.write_buffer_size == leveldb::Options().write_buffer_size) {
+    open_options_.write_buffer_size = ComputeWriteBufferSize(
+        database_dir.empty() ? 0 : base::ComputeDirectorySize(database_dir));
+  }
+
+  if (!dump_provider_registered_ && base::SequencedTaskRunnerHandle::IsSet()) {
+    base::trace_event::MemoryDumpManager::GetInstance()
+        ->RegisterDumpProviderWithSequencedTaskRunner(
+            this, "LevelDBProto", base::SequencedTaskRunnerHandle::Get(),
+            base::trace_event::MemoryDumpProvider::Options());
+    dump_provider_registered_ = true;
+  }
+
   const std::string path = database_dir.AsUTF8Unsafe();
 
   leveldb::Status status = leveldb_env::OpenDB(open_options_, path, &db_);
@@ -194,6 +226,39 @@ bool LevelDB::Get(const std::string& key, bool* found, std::string* entry) {
   return false;
 }
 
+// static
+size_t LevelDB::ComputeWriteBufferSize(int64_t database_size) {
+  // A quarter of the data, so that a full buffer flushes to a table which is
+  // small next to the existing ones.
+  const int64_t default_size = leveldb::Options().write_buffer_size;
+  return static_cast<size_t>(std::min(
+      default_size, std::max(kMinWriteBufferSize, database_size / 4)));
+}
+
+bool LevelDB::OnMemoryDump(const base::trace_event::MemoryDumpArgs& args,
+                           base::trace_event::ProcessMemoryDump* pmd) {
+  DFAKE_SCOPED_LOCK(thread_checker_);
+  if (!db_)
+    return true;
+  auto* db_dump =
+      leveldb_env::DBTracker::GetOrCreateAllocatorDump(pmd, db_.get());
+  if (!db_dump)
+    return true;
+
+  // Attribute the database, with its share of the block cache, to the client.
+  auto* client_dump = pmd->CreateAllocatorDump(
+      base::StringPrintf("leveldb_proto/%s/0x%" PRIXPTR, client_name_.c_str(),
+                         reinterpret_cast<uintptr_t>(this)));
+  client_dump->AddScalar(base::trace_event::MemoryAllocatorDump::kNameSize,
+                         base::trace_event::MemoryAllocatorDump::kUnitsBytes,
+                         db_dump->GetSizeInternal());
+  client_dump->AddScalar("write_buffer_size",
+                         base::trace_event::MemoryAllocatorDump::kUnitsBytes,
+                         open_options_.write_buffer_size);
+  pmd->AddOwnershipEdge(client_dump->guid(), db_dump->guid());
+  return true;
+}
+
 bool LevelDB::Destroy() {
   db_.reset();
   const std::string path = database_dir_.AsUTF8Unsafe();
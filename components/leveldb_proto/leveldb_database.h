@@ -5,6 +5,9 @@
 #ifndef COMPONENTS_LEVELDB_PROTO_LEVELDB_DATABASE_H_
 #define COMPONENTS_LEVELDB_PROTO_LEVELDB_DATABASE_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include <memory>
 #include <string>
 #include <vector>
@@ -13,6 +16,7 @@
 #include "base/macros.h"
 #include "base/strings/string_split.h"
 #include "base/threading/thread_collision_warner.h"
+#include "base/trace_event/memory_dump_provider.h"
 #include "third_party/leveldatabase/env_chromium.h"
 
 namespace base {
@@ -31,19 +35,24 @@ namespace leveldb_proto {
 // Interacts with the LevelDB third party module.
 // Once constructed, function calls and destruction should all occur on the
 // same thread (not necessarily the same as the constructor).
-class LevelDB {
+//
+// Databases use the block cache shared by the browser process unless the
+// options say otherwise. Each open database reports its memory, including its
+// share of that cache, to memory-infra as leveldb_proto/<client name>.
+class LevelDB : public base::trace_event::MemoryDumpProvider {
  public:
   // Constructor. Does *not* open a leveldb - only initialize this class.
   // |client_name| is the name of the "client" that owns this instance. Used
   // for UMA statics as so: LevelDB.<value>.<client name>. It is best to not
   // change once shipped.
   explicit LevelDB(const char* client_name);
-  virtual ~LevelDB();
+  ~LevelDB() override;
 
   using KeyFilter = base::RepeatingCallback<bool(const std::string& key)>;
 
   // Initializes a leveldb with the given options. If |database_dir| is
-  // empty, this opens an in-memory db.
+  // empty, this opens an in-memory db. If |options| leave write_buffer_size at
+  // leveldb's default, it is sized with ComputeWriteBufferSize() instead.
   virtual bool Init(const base::FilePath& database_dir,
                     const leveldb_env::Options& options);
 
@@ -60,6 +69,16 @@ class LevelDB {
   // directory.
   virtual bool Destroy();
 
+  // Returns the write buffer size for a database whose files currently take
+  // |database_size| bytes. Most databases are far smaller than leveldb's
+  // default 4MB write buffer, which would otherwise hold their whole content
+  // in memory a second time, next to the block cache.
+  static size_t ComputeWriteBufferSize(int64_t database_size);
+
+  // base::trace_event::MemoryDumpProvider implementation.
+  bool OnMemoryDump(const base::trace_event::MemoryDumpArgs& args,
+                    base::trace_event::ProcessMemoryDump* pmd) override;
+
  private:
   FRIEND_TEST_ALL_PREFIXES(ProtoDatabaseImplLevelDBTest, TestDBInitFail);
 
@@ -71,6 +90,8 @@ class LevelDB {
   std::unique_ptr<leveldb::DB> db_;
   base::FilePath database_dir_;
   leveldb_env::Options open_options_;
+  const std::string client_name_;
+  bool dump_provider_registered_ = false;
   base::HistogramBase* open_histogram_;
   base::HistogramBase* destroy_histogram_;
 
@@ -18,7 +18,10 @@
 #include "base/memory/ptr_util.h"
 #include "base/message_loop/message_loop.h"
 #include "base/run_loop.h"
+#include "base/strings/string_util.h"
 #include "base/threading/thread.h"
+#include "base/trace_event/memory_dump_request_args.h"
+#include "base/trace_event/process_memory_dump.h"
 #include "components/leveldb_proto/leveldb_database.h"
 #include "components/leveldb_proto/testing/proto/test.pb.h"
 #include "testing/gmock/include/gmock/gmock.h"
@@ -771,6 +774,36 @@ TEST_F(ProtoDatabaseImplLevelDBTest, TestMemoryDatabase) {
   EXPECT_EQ(1u, second_load_entries.size());
 }
 
+TEST_F(ProtoDatabaseImplLevelDBTest, TestWriteBufferSize) {
+  const size_t kDefaultSize = leveldb::Options().write_buffer_size;
+  EXPECT_EQ(64u * 1024, LevelDB::ComputeWriteBufferSize(0));
+  EXPECT_EQ(64u * 1024, LevelDB::ComputeWriteBufferSize(100 * 1024));
+  EXPECT_EQ(256u * 1024, LevelDB::ComputeWriteBufferSize(1024 * 1024));
+  EXPECT_EQ(kDefaultSize, LevelDB::ComputeWriteBufferSize(1024 * 1024 * 1024));
+}
+
+TEST_F(ProtoDatabaseImplLevelDBTest, TestMemoryDump) {
+  ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  LevelDB db(kTestLevelDBClientName);
+  ASSERT_TRUE(db.Init(temp_dir.GetPath(), CreateSimpleOptions()));
+
+  base::trace_event::MemoryDumpArgs args = {
+      base::trace_event::MemoryDumpLevelOfDetail::DETAILED};
+  base::trace_event::ProcessMemoryDump pmd(args);
+  ASSERT_TRUE(db.OnMemoryDump(args, &pmd));
+
+  bool found_client_dump = false;
+  for (const auto& dump : pmd.allocator_dumps()) {
+    if (base::StartsWith(dump.first,
+                         std::string("leveldb_proto/") + kTestLevelDBClientName,
+                         base::CompareCase::SENSITIVE)) {
+      found_client_dump = true;
+    }
+  }
+  EXPECT_TRUE(found_client_dump);
+}
+
 TEST_F(ProtoDatabaseImplLevelDBTest, TestCorruptDBReset) {
   ScopedTempDir temp_dir;
   ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
@@ -333,7 +333,7 @@ void MetricsLog::TruncateEvents() {
   }
 }
 
-void MetricsLog::GetEncodedLog(std::string* encoded_log) {
+void MetricsLog::GetEncodedLog(std::string* encoded_log) const {
   DCHECK(closed_);
   uma_proto_.SerializeToString(encoded_log);
 }
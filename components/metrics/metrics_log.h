@@ -125,8 +125,9 @@ class MetricsLog {
   void TruncateEvents();
 
   // Fills |encoded_log| with the serialized protobuf representation of the
-  // record.  Must only be called after CloseLog() has been called.
-  void GetEncodedLog(std::string* encoded_log);
+  // record.  Must only be called after CloseLog() has been called. As a closed
+  // log is no longer modified, this may be called on any thread.
+  void GetEncodedLog(std::string* encoded_log) const;
 
   const base::TimeTicks& creation_time() const {
     return creation_time_;
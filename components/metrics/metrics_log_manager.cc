@@ -24,13 +24,17 @@ void MetricsLogManager::BeginLoggingWithLog(std::unique_ptr<MetricsLog> log) {
 }
 
 void MetricsLogManager::FinishCurrentLog(MetricsLogStore* log_store) {
-  DCHECK(current_log_);
-  current_log_->CloseLog();
+  std::unique_ptr<MetricsLog> log = ReleaseCurrentLog();
   std::string log_data;
-  current_log_->GetEncodedLog(&log_data);
+  log->GetEncodedLog(&log_data);
   if (!log_data.empty())
-    log_store->StoreLog(log_data, current_log_->log_type());
-  current_log_.reset();
+    log_store->StoreLog(log_data, log->log_type());
+}
+
+std::unique_ptr<MetricsLog> MetricsLogManager::ReleaseCurrentLog() {
+  DCHECK(current_log_);
+  current_log_->CloseLog();
+  return std::move(current_log_);
 }
 
 void MetricsLogManager::DiscardCurrentLog() {
@@ -36,6 +36,10 @@ class MetricsLogManager {
   // later, leaving |current_log_| NULL.
   void FinishCurrentLog(MetricsLogStore* log_store);
 
+  // Closes |current_log_| and returns it, leaving |current_log_| NULL. The
+  // caller is responsible for encoding and storing it.
+  std::unique_ptr<MetricsLog> ReleaseCurrentLog();
+
   // Closes and discards |current_log|.
   void DiscardCurrentLog();
 
@@ -4,6 +4,9 @@
 
 #include "components/metrics/metrics_log_store.h"
 
+#include <utility>
+
+#include "base/logging.h"
 #include "components/metrics/metrics_pref_names.h"
 #include "components/metrics/persisted_logs_metrics_impl.h"
 #include "components/prefs/pref_registry_simple.h"
@@ -68,15 +71,12 @@ void MetricsLogStore::LoadPersistedUnsentLogs() {
 
 void MetricsLogStore::StoreLog(const std::string& log_data,
                                MetricsLog::LogType log_type) {
-  switch (log_type) {
-    case MetricsLog::INITIAL_STABILITY_LOG:
-      initial_log_queue_.StoreLog(log_data);
-      break;
-    case MetricsLog::ONGOING_LOG:
-    case MetricsLog::INDEPENDENT_LOG:
-      ongoing_log_queue_.StoreLog(log_data);
-      break;
-  }
+  GetQueueForLogType(log_type)->StoreLog(log_data);
+}
+
+void MetricsLogStore::StoreEncodedLog(PersistedLogs::EncodedLog encoded_log,
+                                      MetricsLog::LogType log_type) {
+  GetQueueForLogType(log_type)->StoreEncodedLog(std::move(encoded_log));
 }
 
 bool MetricsLogStore::has_unsent_logs() const {
@@ -126,4 +126,17 @@ void MetricsLogStore::PersistUnsentLogs() const {
   ongoing_log_queue_.PersistUnsentLogs();
 }
 
+PersistedLogs* MetricsLogStore::GetQueueForLogType(
+    MetricsLog::LogType log_type) {
+  switch (log_type) {
+    case MetricsLog::INITIAL_STABILITY_LOG:
+      return &initial_log_queue_;
+    case MetricsLog::ONGOING_LOG:
+    case MetricsLog::INDEPENDENT_LOG:
+      return &ongoing_log_queue_;
+  }
+  NOTREACHED();
+  return &ongoing_log_queue_;
+}
+
 }  // namespace metrics
@@ -35,6 +35,11 @@ class MetricsLogStore : public LogStore {
   // Saves |log_data| as the given type.
   void StoreLog(const std::string& log_data, MetricsLog::LogType log_type);
 
+  // Saves a log already encoded with PersistedLogs::EncodeLog() as the given
+  // type.
+  void StoreEncodedLog(PersistedLogs::EncodedLog encoded_log,
+                       MetricsLog::LogType log_type);
+
   // LogStore:
   bool has_unsent_logs() const override;
   bool has_staged_log() const override;
@@ -50,6 +55,9 @@ class MetricsLogStore : public LogStore {
   size_t initial_log_count() const { return initial_log_queue_.size(); }
 
  private:
+  // Returns the queue logs of |log_type| are stored in.
+  PersistedLogs* GetQueueForLogType(MetricsLog::LogType log_type);
+
   // Tracks whether unsent logs (if any) have been loaded from the serializer.
   bool unsent_logs_loaded_;
 
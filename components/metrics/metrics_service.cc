@@ -140,6 +140,8 @@
 #include "base/metrics/statistics_recorder.h"
 #include "base/single_thread_task_runner.h"
 #include "base/strings/string_piece.h"
+#include "base/task_scheduler/post_task.h"
+#include "base/task_scheduler/task_traits.h"
 #include "base/threading/sequenced_task_runner_handle.h"
 #include "base/time/time.h"
 #include "build/build_config.h"
@@ -188,6 +190,14 @@ void MarkAppCleanShutdownAndCommit(CleanExitBeacon* clean_exit_beacon,
 }
 #endif  // defined(OS_ANDROID) || defined(OS_IOS)
 
+// Serializes and compresses a closed |log|. May run on any thread.
+PersistedLogs::EncodedLog EncodeClosedLog(
+    scoped_refptr<base::RefCountedData<std::unique_ptr<MetricsLog>>> log) {
+  std::string log_data;
+  log->data->GetEncodedLog(&log_data);
+  return PersistedLogs::EncodeLog(log_data);
+}
+
 }  // namespace
 
 // static
@@ -628,6 +638,55 @@ void MetricsService::CloseCurrentLog() {
   if (!log_manager_.current_log())
     return;
 
+  FinalizeCurrentLog();
+  DVLOG(1) << "Generated an ongoing log.";
+  log_manager_.FinishCurrentLog(log_store());
+}
+
+void MetricsService::CloseCurrentLogInBackground() {
+  DCHECK(log_manager_.current_log());
+  FinalizeCurrentLog();
+  DVLOG(1) << "Generated an ongoing log.";
+
+  // Serializing and compressing a log with many histograms takes long enough
+  // to cause jank, so only snapshotting the histograms is done here.
+  scoped_refptr<EncodingLog> log =
+      base::MakeRefCounted<EncodingLog>(log_manager_.ReleaseCurrentLog());
+  logs_being_encoded_.push_back(log);
+  base::PostTaskWithTraitsAndReplyWithResult(
+      FROM_HERE,
+      {base::TaskPriority::USER_VISIBLE,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+      base::BindOnce(&EncodeClosedLog, log),
+      base::BindOnce(&MetricsService::OnLogEncoded,
+                     self_ptr_factory_.GetWeakPtr(), log));
+}
+
+void MetricsService::OnLogEncoded(scoped_refptr<EncodingLog> log,
+                                  PersistedLogs::EncodedLog encoded_log) {
+  // The log may already have been stored by StoreLogsBeingEncoded().
+  auto it =
+      std::find(logs_being_encoded_.begin(), logs_being_encoded_.end(), log);
+  if (it != logs_being_encoded_.end()) {
+    logs_being_encoded_.erase(it);
+    log_store()->StoreEncodedLog(std::move(encoded_log),
+                                 log->data->log_type());
+  }
+
+  reporting_service_.Start();
+  rotation_scheduler_->RotationFinished();
+  HandleIdleSinceLastTransmission(true);
+}
+
+void MetricsService::StoreLogsBeingEncoded() {
+  // The worker may still be reading a log, but a closed log is only read, so
+  // encoding it here as well is safe.
+  for (const scoped_refptr<EncodingLog>& log : logs_being_encoded_)
+    log_store()->StoreEncodedLog(EncodeClosedLog(log), log->data->log_type());
+  logs_being_encoded_.clear();
+}
+
+void MetricsService::FinalizeCurrentLog() {
   // If a persistent allocator is in use, update its internal histograms (such
   // as how much memory is being used) before reporting.
   base::PersistentHistogramAllocator* allocator =
@@ -649,14 +708,13 @@ void MetricsService::CloseCurrentLog() {
                                         incremental_uptime, uptime);
   RecordCurrentHistograms();
   current_log->TruncateEvents();
-  DVLOG(1) << "Generated an ongoing log.";
-  log_manager_.FinishCurrentLog(log_store());
 }
 
 void MetricsService::PushPendingLogsToPersistentStorage() {
   if (state_ < SENDING_LOGS)
     return;  // We didn't and still don't have time to get plugin list etc.
 
+  StoreLogsBeingEncoded();
   CloseCurrentLog();
   log_store()->PersistUnsentLogs();
 }
@@ -722,13 +780,15 @@ void MetricsService::OnFinalLogInfoCollectionDone() {
     return;
   }
 
-  if (state_ == INIT_TASK_DONE) {
-    PrepareInitialMetricsLog();
-  } else {
-    DCHECK_EQ(SENDING_LOGS, state_);
-    CloseCurrentLog();
+  if (state_ == SENDING_LOGS) {
+    // The rotation finishes once the closed log has been stored.
+    CloseCurrentLogInBackground();
     OpenNewLog();
+    return;
   }
+
+  DCHECK_EQ(INIT_TASK_DONE, state_);
+  PrepareInitialMetricsLog();
   reporting_service_.Start();
   rotation_scheduler_->RotationFinished();
   HandleIdleSinceLastTransmission(true);
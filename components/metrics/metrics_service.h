@@ -17,6 +17,7 @@
 
 #include "base/gtest_prod_util.h"
 #include "base/macros.h"
+#include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
 #include "base/metrics/field_trial.h"
 #include "base/metrics/histogram_flattener.h"
@@ -34,6 +35,7 @@
 #include "components/metrics/metrics_provider.h"
 #include "components/metrics/metrics_reporting_service.h"
 #include "components/metrics/net/network_metrics_provider.h"
+#include "components/metrics/persisted_logs.h"
 #include "components/variations/synthetic_trial_registry.h"
 
 class PrefService;
@@ -218,6 +220,9 @@ class MetricsService : public base::HistogramFlattener {
     UNSET
   };
 
+  // A closed log shared with the worker thread encoding it.
+  using EncodingLog = base::RefCountedData<std::unique_ptr<MetricsLog>>;
+
   // Calls into the client to initialize some system profile metrics.
   void StartInitTask();
 
@@ -258,6 +263,23 @@ class MetricsService : public base::HistogramFlattener {
   // Closes out the current log after adding any last information.
   void CloseCurrentLog();
 
+  // Like CloseCurrentLog(), but serializes and compresses the log on a worker
+  // thread, then stores it and finishes the rotation in OnLogEncoded().
+  void CloseCurrentLogInBackground();
+
+  // Adds the last information (environment, session data and histogram deltas)
+  // to the current log before it is closed.
+  void FinalizeCurrentLog();
+
+  // Called on the UI thread once |log| has been encoded by
+  // CloseCurrentLogInBackground().
+  void OnLogEncoded(scoped_refptr<EncodingLog> log,
+                    PersistedLogs::EncodedLog encoded_log);
+
+  // Synchronously encodes and stores the logs still being encoded on a worker
+  // thread, so that they are not lost on shutdown.
+  void StoreLogsBeingEncoded();
+
   // Pushes the text of the current and staged logs into persistent storage.
   // Called when Chrome shuts down.
   void PushPendingLogsToPersistentStorage();
@@ -380,6 +402,10 @@ class MetricsService : public base::HistogramFlattener {
 
   variations::SyntheticTrialRegistry synthetic_trial_registry_;
 
+  // Closed logs handed to a worker thread for encoding, in the order they were
+  // closed. A log is dropped from here once stored.
+  std::vector<scoped_refptr<EncodingLog>> logs_being_encoded_;
+
   // Redundant marker to check that we completed our shutdown, and set the
   // exited-cleanly bit in the prefs.
   static ShutdownCleanliness clean_shutdown_status_;
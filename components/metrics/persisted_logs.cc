@@ -43,22 +43,6 @@ std::string DecodeFromBase64(const std::string& to_convert) {
 
 }  // namespace
 
-void PersistedLogs::LogInfo::Init(PersistedLogsMetrics* metrics,
-                                  const std::string& log_data,
-                                  const std::string& log_timestamp) {
-  DCHECK(!log_data.empty());
-
-  if (!compression::GzipCompress(log_data, &compressed_log_data)) {
-    NOTREACHED();
-    return;
-  }
-
-  metrics->RecordCompressionRatio(compressed_log_data.size(), log_data.size());
-
-  hash = base::SHA1HashString(log_data);
-  timestamp = log_timestamp;
-}
-
 PersistedLogs::PersistedLogs(std::unique_ptr<PersistedLogsMetrics> metrics,
                              PrefService* local_state,
                              const char* pref_name,
@@ -133,10 +117,41 @@ void PersistedLogs::LoadPersistedUnsentLogs() {
   ReadLogsFromPrefList(*local_state_->GetList(pref_name_));
 }
 
+// static
+PersistedLogs::EncodedLog PersistedLogs::EncodeLog(
+    const std::string& log_data) {
+  EncodedLog encoded_log;
+  if (log_data.empty())
+    return encoded_log;
+
+  if (!compression::GzipCompress(log_data, &encoded_log.compressed_log_data)) {
+    NOTREACHED();
+    encoded_log.compressed_log_data.clear();
+    return encoded_log;
+  }
+  encoded_log.hash = base::SHA1HashString(log_data);
+  encoded_log.log_size = log_data.size();
+  return encoded_log;
+}
+
 void PersistedLogs::StoreLog(const std::string& log_data) {
+  DCHECK(!log_data.empty());
+  StoreEncodedLog(EncodeLog(log_data));
+}
+
+void PersistedLogs::StoreEncodedLog(EncodedLog encoded_log) {
+  // Either the log was empty, or compression failed.
+  if (encoded_log.compressed_log_data.empty())
+    return;
+
+  metrics_->RecordCompressionRatio(encoded_log.compressed_log_data.size(),
+                                   encoded_log.log_size);
+
   list_.push_back(LogInfo());
-  list_.back().Init(metrics_.get(), log_data,
-                    base::Int64ToString(base::Time::Now().ToTimeT()));
+  LogInfo& log_info = list_.back();
+  log_info.compressed_log_data = std::move(encoded_log.compressed_log_data);
+  log_info.hash = std::move(encoded_log.hash);
+  log_info.timestamp = base::Int64ToString(base::Time::Now().ToTimeT());
 }
 
 void PersistedLogs::Purge() {
@@ -53,9 +53,28 @@ class PersistedLogs : public LogStore {
   void PersistUnsentLogs() const override;
   void LoadPersistedUnsentLogs() override;
 
+  // A log compressed and hashed by EncodeLog(), ready to be stored.
+  struct EncodedLog {
+    // The gzipped log data, or empty if the log was empty.
+    std::string compressed_log_data;
+
+    // The SHA1 hash of the uncompressed log.
+    std::string hash;
+
+    // The size of the uncompressed log.
+    size_t log_size = 0;
+  };
+
+  // Compresses and hashes |log_data|. This is the expensive part of storing a
+  // log; it doesn't touch any PersistedLogs state, so it may run on any thread.
+  static EncodedLog EncodeLog(const std::string& log_data);
+
   // Adds a log to the list.
   void StoreLog(const std::string& log_data);
 
+  // Adds a log returned by EncodeLog() to the list.
+  void StoreEncodedLog(EncodedLog encoded_log);
+
   // Delete all logs, in memory and on disk.
   void Purge();
 
@@ -93,13 +112,6 @@ class PersistedLogs : public LogStore {
   const size_t max_log_size_;
 
   struct LogInfo {
-    // Initializes the members based on uncompressed |log_data| and
-    // |log_timestamp|.
-    // |metrics| is the parent's metrics_ object, and should not be held.
-    void Init(PersistedLogsMetrics* metrics,
-              const std::string& log_data,
-              const std::string& log_timestamp);
-
     // Compressed log data - a serialized protobuf that's been gzipped.
     std::string compressed_log_data;
 
@@ -119,6 +119,30 @@ TEST_F(PersistedLogsTest, SingleElementLogList) {
             result_persisted_logs.staged_log_timestamp());
 }
 
+// Logs encoded ahead of time are stored like logs stored directly.
+TEST_F(PersistedLogsTest, StoreEncodedLog) {
+  TestPersistedLogs persisted_logs(&prefs_, kLogByteLimit);
+
+  PersistedLogs::EncodedLog encoded_log =
+      PersistedLogs::EncodeLog("Hello world!");
+  EXPECT_EQ(Compress("Hello world!"), encoded_log.compressed_log_data);
+  persisted_logs.StoreEncodedLog(std::move(encoded_log));
+  persisted_logs.StoreLog("Hello world!");
+  ASSERT_EQ(2U, persisted_logs.size());
+
+  persisted_logs.StageNextLog();
+  std::string hash = persisted_logs.staged_log_hash();
+  persisted_logs.DiscardStagedLog();
+  persisted_logs.StageNextLog();
+  EXPECT_EQ(Compress("Hello world!"), persisted_logs.staged_log());
+  EXPECT_EQ(hash, persisted_logs.staged_log_hash());
+
+  // Empty logs are not stored.
+  persisted_logs.DiscardStagedLog();
+  persisted_logs.StoreEncodedLog(PersistedLogs::EncodeLog(std::string()));
+  EXPECT_EQ(0U, persisted_logs.size());
+}
+
 // Store a set of logs over the length limit, but smaller than the min number of
 // bytes.
 TEST_F(PersistedLogsTest, LongButTinyLogList) {
@@ -18,6 +18,7 @@
 #include "components/version_info/version_info.h"
 #include "net/log/file_net_log_observer.h"
 #include "net/log/net_log_util.h"
+#include "net/log/ring_buffer_net_log_observer.h"
 #include "net/log/trace_net_log_observer.h"
 
 namespace net_log {
@@ -30,6 +31,8 @@ ChromeNetLog::ChromeNetLog() {
 ChromeNetLog::~ChromeNetLog() {
   net_export_file_writer_.reset();
   ClearFileNetLogObserver();
+  if (ring_buffer_net_log_observer_)
+    ring_buffer_net_log_observer_->StopObserving();
   trace_net_log_observer_->StopWatchForTraceStart();
 }
 
@@ -53,6 +56,23 @@ NetExportFileWriter* ChromeNetLog::net_export_file_writer() {
   return net_export_file_writer_.get();
 }
 
+void ChromeNetLog::StartRecordingToRingBuffer(size_t max_entries) {
+  DCHECK(!ring_buffer_net_log_observer_);
+  ring_buffer_net_log_observer_ =
+      std::make_unique<net::RingBufferNetLogObserver>(
+          max_entries, true /* record_parameters */);
+  ring_buffer_net_log_observer_->StartObserving(this);
+}
+
+std::unique_ptr<base::Value> ChromeNetLog::GetRingBufferSnapshot(
+    const base::CommandLine::StringType& command_line_string,
+    const std::string& channel_string) {
+  if (!ring_buffer_net_log_observer_)
+    return nullptr;
+  return ring_buffer_net_log_observer_->GetSnapshot(
+      GetConstants(command_line_string, channel_string));
+}
+
 // static
 std::unique_ptr<base::Value> ChromeNetLog::GetConstants(
     const base::CommandLine::StringType& command_line_string,
@@ -5,6 +5,8 @@
 #ifndef COMPONENTS_NET_LOG_CHROME_NET_LOG_H_
 #define COMPONENTS_NET_LOG_CHROME_NET_LOG_H_
 
+#include <stddef.h>
+
 #include <memory>
 #include <string>
 
@@ -19,6 +21,7 @@ class Value;
 
 namespace net {
 class FileNetLogObserver;
+class RingBufferNetLogObserver;
 class TraceNetLogObserver;
 }
 
@@ -50,6 +53,17 @@ class ChromeNetLog : public net::NetLog {
 
   NetExportFileWriter* net_export_file_writer();
 
+  // Starts keeping the |max_entries| most recent events in memory, with
+  // small parameters, so that they can be dumped when a problem is reported.
+  // Cheap enough to leave on. Must not be called more than once.
+  void StartRecordingToRingBuffer(size_t max_entries);
+
+  // Returns the events kept since StartRecordingToRingBuffer(), in the format
+  // of a log file, or nullptr if it wasn't called.
+  std::unique_ptr<base::Value> GetRingBufferSnapshot(
+      const base::CommandLine::StringType& command_line_string,
+      const std::string& channel_string);
+
   // Returns a Value containing constants needed to load a log file.
   // Safe to call on any thread.
   static std::unique_ptr<base::Value> GetConstants(
@@ -86,6 +100,9 @@ class ChromeNetLog : public net::NetLog {
   // This observer handles writing NetLogs started by chrome://net-export/
   std::unique_ptr<NetExportFileWriter> net_export_file_writer_;
 
+  // This observer keeps the events recorded by StartRecordingToRingBuffer().
+  std::unique_ptr<net::RingBufferNetLogObserver> ring_buffer_net_log_observer_;
+
   // This observer forwards NetLog events to the chrome://tracing system.
   std::unique_ptr<net::TraceNetLogObserver> trace_net_log_observer_;
 
@@ -48,6 +48,10 @@
 
 namespace {
 
+// Longest time (in ms) between when a provider reports new matches, while
+// others are still running, and when its matches are merged into the result.
+const int kUpdateResultDelayMS = 16;
+
 // Converts the given match to a type (and possibly subtype) based on the AQS
 // specification. For more details, see
 // http://goto.google.com/binary-clients-logging.
@@ -297,6 +301,7 @@ void AutocompleteController::Start(const AutocompleteInput& input) {
 
   expire_timer_.Stop();
   stop_timer_.Stop();
+  update_delay_timer_.Stop();
 
   // Start the new query.
   in_start_ = true;
@@ -398,8 +403,23 @@ void AutocompleteController::OnProviderUpdate(bool updated_matches) {
   CheckIfDone();
   // Multiple providers may provide synchronous results, so we only update the
   // results if we're not in Start().
-  if (!in_start_ && (updated_matches || done_))
+  if (in_start_ || !(updated_matches || done_))
+    return;
+
+  // UpdateResult() sorts and dedupes the matches of every provider, so
+  // rather than doing that for each provider that reports, merge the ones
+  // reporting close together at once.  The delay runs from the first report
+  // after an update, so providers still running can't hold an update back for
+  // longer, and there's nothing to wait for once all of them are done.
+  if (done_) {
+    update_delay_timer_.Stop();
     UpdateResult(false, false);
+  } else if (!update_delay_timer_.IsRunning()) {
+    update_delay_timer_.Start(
+        FROM_HERE, base::TimeDelta::FromMilliseconds(kUpdateResultDelayMS),
+        base::Bind(&AutocompleteController::UpdateResult,
+                   base::Unretained(this), false, false));
+  }
 }
 
 void AutocompleteController::AddProvidersInfo(
@@ -723,6 +743,7 @@ void AutocompleteController::StopHelper(bool clear_result,
 
   expire_timer_.Stop();
   stop_timer_.Stop();
+  update_delay_timer_.Stop();
   done_ = true;
   if (clear_result && !result_.empty()) {
     result_.Reset();
@@ -143,6 +143,8 @@ class AutocompleteController : public AutocompleteProviderListener,
 
  private:
   friend class AutocompleteProviderTest;
+  FRIEND_TEST_ALL_PREFIXES(AutocompleteProviderTest,
+                           BatchesAsynchronousUpdates);
   FRIEND_TEST_ALL_PREFIXES(AutocompleteProviderTest,
                            RedundantKeywordsIgnoredInResult);
   FRIEND_TEST_ALL_PREFIXES(AutocompleteProviderTest, UpdateAssistedQueryStats);
@@ -248,6 +250,11 @@ class AutocompleteController : public AutocompleteProviderListener,
   // Timer used to tell the providers to Stop() searching for matches.
   base::OneShotTimer stop_timer_;
 
+  // Timer used to merge the matches of providers which have reported since the
+  // last UpdateResult(), so that providers reporting at about the same time
+  // cause a single update.  See OnProviderUpdate().
+  base::OneShotTimer update_delay_timer_;
+
   // Amount of time (in ms) between when the user stops typing and
   // when we send Stop() to every provider.  This is intended to avoid
   // the disruptive effect of belated omnibox updates, updates that
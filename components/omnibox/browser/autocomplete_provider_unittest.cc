@@ -547,6 +547,29 @@ TEST_F(AutocompleteProviderTest, Query) {
   EXPECT_EQ(provider2, result_.default_match()->provider);
 }
 
+// Tests that matches reported while other providers are still running are
+// merged once every provider is done.
+TEST_F(AutocompleteProviderTest, BatchesAsynchronousUpdates) {
+  ResetControllerWithTestProviders(false, nullptr, nullptr);
+  AutocompleteInput input(base::ASCIIToUTF16("a"),
+                          metrics::OmniboxEventProto::OTHER,
+                          TestingSchemeClassifier());
+  input.set_prevent_inline_autocomplete(true);
+  controller_->Start(input);
+  ASSERT_FALSE(controller_->done());
+  EXPECT_FALSE(controller_->update_delay_timer_.IsRunning());
+
+  // An update while the providers are running is held back for a while.
+  controller_->OnProviderUpdate(true);
+  EXPECT_TRUE(controller_->update_delay_timer_.IsRunning());
+
+  // The update after which every provider is done is merged immediately.
+  base::RunLoop().Run();
+  EXPECT_TRUE(controller_->done());
+  EXPECT_FALSE(controller_->update_delay_timer_.IsRunning());
+  EXPECT_EQ(kResultsPerProvider * 2, result_.size());
+}
+
 // Tests assisted query stats.
 TEST_F(AutocompleteProviderTest, AssistedQueryStats) {
   ResetControllerWithTestProviders(false, nullptr, nullptr);
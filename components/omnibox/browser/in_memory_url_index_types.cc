@@ -13,6 +13,7 @@
 #include "base/feature_list.h"
 #include "base/i18n/break_iterator.h"
 #include "base/i18n/case_conversion.h"
+#include "base/logging.h"
 #include "base/strings/string_util.h"
 #include "base/trace_event/memory_usage_estimator.h"
 #include "components/omnibox/browser/omnibox_field_trial.h"
@@ -214,3 +215,129 @@ void RowWordStarts::Clear() {
   url_word_starts_.clear();
   title_word_starts_.clear();
 }
+
+// WordMap ---------------------------------------------------------------------
+
+namespace {
+
+// |recent_word_ids_| is merged once it holds more than this many words, or an
+// eighth of the merged words if that is more, which keeps the cost of merging
+// proportional to the number of words added.
+const size_t kMinRecentWordsToMerge = 64;
+
+// Orders WordIDs by the words they refer to.
+class WordIDLess {
+ public:
+  explicit WordIDLess(const String16Vector& word_list)
+      : word_list_(word_list) {}
+
+  bool operator()(WordID lhs, WordID rhs) const {
+    return word_list_[lhs] < word_list_[rhs];
+  }
+  bool operator()(WordID lhs, const base::string16& rhs) const {
+    return word_list_[lhs] < rhs;
+  }
+
+ private:
+  const String16Vector& word_list_;
+};
+
+// Returns the position of |word| in |word_ids|, or |word_ids|.end().
+std::vector<WordID>::const_iterator FindWordID(
+    const std::vector<WordID>& word_ids,
+    const String16Vector& word_list,
+    const base::string16& word) {
+  auto it = std::lower_bound(word_ids.begin(), word_ids.end(), word,
+                             WordIDLess(word_list));
+  if (it == word_ids.end() || word_list[*it] != word)
+    return word_ids.end();
+  return it;
+}
+
+}  // namespace
+
+WordMap::WordMap() = default;
+WordMap::WordMap(const WordMap& other) = default;
+WordMap::WordMap(WordMap&& other) = default;
+WordMap& WordMap::operator=(const WordMap& other) = default;
+WordMap& WordMap::operator=(WordMap&& other) = default;
+WordMap::~WordMap() = default;
+
+bool WordMap::Find(const String16Vector& word_list,
+                   const base::string16& word,
+                   WordID* word_id) const {
+  for (const std::vector<WordID>* word_ids :
+       {&recent_word_ids_, &word_ids_}) {
+    auto it = FindWordID(*word_ids, word_list, word);
+    if (it != word_ids->end()) {
+      *word_id = *it;
+      return true;
+    }
+  }
+  return false;
+}
+
+void WordMap::Insert(const String16Vector& word_list, WordID word_id) {
+  const base::string16& word = word_list[word_id];
+  DCHECK(FindWordID(word_ids_, word_list, word) == word_ids_.end());
+  auto it = std::lower_bound(recent_word_ids_.begin(), recent_word_ids_.end(),
+                             word, WordIDLess(word_list));
+  DCHECK(it == recent_word_ids_.end() || word_list[*it] != word);
+  recent_word_ids_.insert(it, word_id);
+
+  if (recent_word_ids_.size() >
+      std::max(kMinRecentWordsToMerge, word_ids_.size() / 8)) {
+    MergeRecentWordIDs(word_list);
+  }
+}
+
+void WordMap::Erase(const String16Vector& word_list, WordID word_id) {
+  const base::string16& word = word_list[word_id];
+  for (std::vector<WordID>* word_ids : {&recent_word_ids_, &word_ids_}) {
+    auto it = FindWordID(*word_ids, word_list, word);
+    if (it != word_ids->end()) {
+      DCHECK_EQ(word_id, *it);
+      word_ids->erase(it);
+      return;
+    }
+  }
+}
+
+void WordMap::Assign(const String16Vector& word_list,
+                     std::vector<WordID> word_ids) {
+  // Maps are saved in word order, so restoring one doesn't need to sort.
+  WordIDLess less(word_list);
+  if (!std::is_sorted(word_ids.begin(), word_ids.end(), less))
+    std::sort(word_ids.begin(), word_ids.end(), less);
+  word_ids_ = std::move(word_ids);
+  recent_word_ids_.clear();
+}
+
+std::vector<WordID> WordMap::GetWordIDs(
+    const String16Vector& word_list) const {
+  std::vector<WordID> word_ids;
+  word_ids.reserve(size());
+  std::merge(word_ids_.begin(), word_ids_.end(), recent_word_ids_.begin(),
+             recent_word_ids_.end(), std::back_inserter(word_ids),
+             WordIDLess(word_list));
+  return word_ids;
+}
+
+void WordMap::clear() {
+  word_ids_.clear();
+  recent_word_ids_.clear();
+}
+
+size_t WordMap::EstimateMemoryUsage() const {
+  return base::trace_event::EstimateMemoryUsage(word_ids_) +
+         base::trace_event::EstimateMemoryUsage(recent_word_ids_);
+}
+
+void WordMap::MergeRecentWordIDs(const String16Vector& word_list) {
+  const size_t merged_size = word_ids_.size();
+  word_ids_.insert(word_ids_.end(), recent_word_ids_.begin(),
+                   recent_word_ids_.end());
+  std::inplace_merge(word_ids_.begin(), word_ids_.begin() + merged_size,
+                     word_ids_.end(), WordIDLess(word_list));
+  recent_word_ids_.clear();
+}
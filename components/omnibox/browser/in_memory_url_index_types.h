@@ -134,7 +134,56 @@ Char16Set Char16SetFromString16(const base::string16& uni_word);
 typedef size_t WordID;
 
 // A map allowing a WordID to be determined given a word.
-typedef std::map<base::string16, WordID> WordMap;
+//
+// The words themselves live in the word list, indexed by WordID, so rather
+// than holding a second copy of every word in a tree this keeps just the
+// WordIDs, sorted by word and found by binary search. Each call is passed the
+// word list the IDs refer to. Words added since the last merge are kept in a
+// smaller sorted array so that building the index does not shift the whole
+// array for every new word.
+class WordMap {
+ public:
+  WordMap();
+  WordMap(const WordMap& other);
+  WordMap(WordMap&& other);
+  WordMap& operator=(const WordMap& other);
+  WordMap& operator=(WordMap&& other);
+  ~WordMap();
+
+  // Returns true and sets |word_id| if |word| is in the map.
+  bool Find(const String16Vector& word_list,
+            const base::string16& word,
+            WordID* word_id) const;
+
+  // Adds the word at |word_id| in |word_list|, which must not be in the map.
+  void Insert(const String16Vector& word_list, WordID word_id);
+
+  // Removes the word at |word_id| in |word_list|. Must be called before that
+  // slot of the word list is cleared or reused.
+  void Erase(const String16Vector& word_list, WordID word_id);
+
+  // Replaces the contents of the map with |word_ids|, in any order.
+  void Assign(const String16Vector& word_list, std::vector<WordID> word_ids);
+
+  // Returns the IDs of all the words in the map, ordered by word.
+  std::vector<WordID> GetWordIDs(const String16Vector& word_list) const;
+
+  size_t size() const { return word_ids_.size() + recent_word_ids_.size(); }
+  bool empty() const { return size() == 0; }
+  void clear();
+
+  // Estimates dynamic memory usage.
+  // See base/trace_event/memory_usage_estimator.h for more info.
+  size_t EstimateMemoryUsage() const;
+
+ private:
+  // Merges |recent_word_ids_| into |word_ids_|.
+  void MergeRecentWordIDs(const String16Vector& word_list);
+
+  // Both sorted by word; no word is in both.
+  std::vector<WordID> word_ids_;
+  std::vector<WordID> recent_word_ids_;
+};
 
 // A map from character to the word_ids of words containing that character.
 typedef base::flat_set<WordID> WordIDSet;  // An index into the WordList.
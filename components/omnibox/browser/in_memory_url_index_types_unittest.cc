@@ -10,6 +10,7 @@
 
 #include "base/macros.h"
 #include "base/strings/string16.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -164,3 +165,45 @@ TEST_F(InMemoryURLIndexTypesTest, OffsetsAndTermMatches) {
   for (size_t i = 0; i < matches_b.size(); ++i)
     EXPECT_EQ(expected_offsets_b[i], matches_b[i].offset);
 }
+
+TEST_F(InMemoryURLIndexTypesTest, WordMap) {
+  String16Vector word_list;
+  WordMap word_map;
+  WordID word_id;
+  EXPECT_FALSE(word_map.Find(word_list, UTF8ToUTF16("a"), &word_id));
+
+  // Add enough words to merge the recently added ones at least once.
+  for (int i = 0; i < 200; ++i) {
+    word_list.push_back(UTF8ToUTF16(base::IntToString((i * 7) % 200)));
+    word_map.Insert(word_list, i);
+  }
+  EXPECT_EQ(200U, word_map.size());
+  for (WordID i = 0; i < word_list.size(); ++i) {
+    ASSERT_TRUE(word_map.Find(word_list, word_list[i], &word_id));
+    EXPECT_EQ(i, word_id);
+  }
+  EXPECT_FALSE(word_map.Find(word_list, UTF8ToUTF16("200"), &word_id));
+
+  std::vector<WordID> word_ids = word_map.GetWordIDs(word_list);
+  ASSERT_EQ(200U, word_ids.size());
+  for (size_t i = 1; i < word_ids.size(); ++i)
+    EXPECT_LT(word_list[word_ids[i - 1]], word_list[word_ids[i]]);
+
+  // Remove a word and reuse its slot for another.
+  word_map.Erase(word_list, 3);
+  EXPECT_FALSE(word_map.Find(word_list, word_list[3], &word_id));
+  word_list[3] = UTF8ToUTF16("new");
+  word_map.Insert(word_list, 3);
+  ASSERT_TRUE(word_map.Find(word_list, UTF8ToUTF16("new"), &word_id));
+  EXPECT_EQ(3U, word_id);
+  EXPECT_EQ(200U, word_map.size());
+
+  // Restoring from IDs in any order finds the same words.
+  WordMap restored;
+  std::reverse(word_ids.begin(), word_ids.end());
+  restored.Assign(word_list, word_ids);
+  EXPECT_EQ(word_map.GetWordIDs(word_list), restored.GetWordIDs(word_list));
+
+  word_map.clear();
+  EXPECT_TRUE(word_map.empty());
+}
@@ -50,6 +50,10 @@ float days_ago_to_recency_score[kDaysToPrecomputeRecencyScoresFor];
 // ScoredHistoryMatch::Init().
 float raw_term_score_to_topicality_score[kMaxRawTermScore];
 
+// The highest value in |raw_term_score_to_topicality_score|, which no URL's
+// topicality score can exceed.
+float max_topicality_score = 0;
+
 // Precalculates raw_term_score_to_topicality_score, used in
 // GetTopicalityScore().
 void InitRawTermScoreToTopicalityScoreArray() {
@@ -68,6 +72,7 @@ void InitRawTermScoreToTopicalityScoreArray() {
       topicality_score = (1.0 + 2.25 * log10(0.1 * term_score));
     }
     raw_term_score_to_topicality_score[term_score] = topicality_score;
+    max_topicality_score = std::max(max_topicality_score, topicality_score);
   }
 }
 
@@ -585,7 +590,43 @@ float ScoredHistoryMatch::GetTopicalityScore(
   return final_topicality_score;
 }
 
-float ScoredHistoryMatch::GetRecencyScore(int last_visit_days_ago) const {
+// static
+int ScoredHistoryMatch::GetMaxRawScore(const VisitInfoVector& visits,
+                                       bool is_url_bookmarked,
+                                       size_t num_matching_pages,
+                                       base::Time now) {
+  ScoredHistoryMatch::Init();
+
+  // The topicality score, averaged over the terms, is at most the score of a
+  // single term, and the other two scores don't depend on the terms.
+  const float frequency_score = GetFrequency(now, is_url_bookmarked, visits);
+  const float specificity_score =
+      GetDocumentSpecificityScore(num_matching_pages);
+  float max_score = GetFinalRelevancyScore(
+      max_topicality_score, frequency_score, specificity_score);
+
+  // The buckets needn't increase in relevance, so a lower topicality score
+  // could still reach the relevance of any bucket below the highest possible
+  // intermediate score.
+  const float max_intermediate_score =
+      max_topicality_score * frequency_score * specificity_score;
+  for (const ScoreMaxRelevance& bucket : GetRelevanceBuckets()) {
+    if (bucket.first > max_intermediate_score)
+      break;
+    max_score = std::max(max_score, static_cast<float>(bucket.second));
+  }
+  int max_raw_score = base::saturated_cast<int>(max_score);
+
+  if (also_do_hup_like_scoring_) {
+    max_raw_score = std::max(
+        {max_raw_score, HistoryURLProvider::kScoreForBestInlineableResult,
+         HistoryURLProvider::kBaseScoreForNonInlineableResult + 1});
+  }
+  return max_raw_score;
+}
+
+// static
+float ScoredHistoryMatch::GetRecencyScore(int last_visit_days_ago) {
   // Lookup the score in days_ago_to_recency_score, treating
   // everything older than what we've precomputed as the oldest thing
   // we've precomputed.  The std::max is to protect against corruption
@@ -594,9 +635,10 @@ float ScoredHistoryMatch::GetRecencyScore(int last_visit_days_ago) const {
       std::min(last_visit_days_ago, kDaysToPrecomputeRecencyScoresFor - 1), 0)];
 }
 
+// static
 float ScoredHistoryMatch::GetFrequency(const base::Time& now,
                                        const bool bookmarked,
-                                       const VisitInfoVector& visits) const {
+                                       const VisitInfoVector& visits) {
   // Compute the weighted sum of |value_of_transition| over the last at most
   // |max_visits_to_score_| visits, where each visit is weighted using
   // GetRecencyScore() based on how many days ago it happened.
@@ -639,8 +681,9 @@ float ScoredHistoryMatch::GetFrequency(const base::Time& now,
   return summed_visit_points;
 }
 
+// static
 float ScoredHistoryMatch::GetDocumentSpecificityScore(
-    size_t num_matching_pages) const {
+    size_t num_matching_pages) {
   // A mapping from the number of matching pages to their associated document
   // specificity scores.  See omnibox_field_trial.h for more details.
   CR_DEFINE_STATIC_LOCAL(OmniboxFieldTrial::NumMatchesScores,
@@ -664,11 +707,7 @@ float ScoredHistoryMatch::GetFinalRelevancyScore(float topicality_score,
                                                  float specificity_score) {
   // |relevance_buckets| gives a mapping from intemerdiate score to the final
   // relevance score.
-  CR_DEFINE_STATIC_LOCAL(ScoreMaxRelevances, default_relevance_buckets,
-                         (GetHQPBuckets()));
-  ScoreMaxRelevances* relevance_buckets = relevance_buckets_override_
-                                              ? relevance_buckets_override_
-                                              : &default_relevance_buckets;
+  const ScoreMaxRelevances* relevance_buckets = &GetRelevanceBuckets();
   DCHECK(!relevance_buckets->empty());
   DCHECK_EQ(0.0, (*relevance_buckets)[0].first);
 
@@ -718,6 +757,15 @@ float ScoredHistoryMatch::GetFinalRelevancyScore(float topicality_score,
   return (*relevance_buckets)[i - 1].second;
 }
 
+// static
+const ScoredHistoryMatch::ScoreMaxRelevances&
+ScoredHistoryMatch::GetRelevanceBuckets() {
+  CR_DEFINE_STATIC_LOCAL(ScoreMaxRelevances, default_relevance_buckets,
+                         (GetHQPBuckets()));
+  return relevance_buckets_override_ ? *relevance_buckets_override_
+                                     : default_relevance_buckets;
+}
+
 // static
 std::vector<ScoredHistoryMatch::ScoreMaxRelevance>
 ScoredHistoryMatch::GetHQPBuckets() {
@@ -77,6 +77,15 @@ struct ScoredHistoryMatch : public history::HistoryMatch {
   static bool MatchScoreGreater(const ScoredHistoryMatch& m1,
                                 const ScoredHistoryMatch& m2);
 
+  // Returns an upper bound on the raw score of a match for a URL with |visits|.
+  // It doesn't look at the terms, so it is much cheaper than scoring the URL,
+  // letting callers skip URLs which can't score well enough to be shown. The
+  // other arguments are as for the constructor.
+  static int GetMaxRawScore(const VisitInfoVector& visits,
+                            bool is_url_bookmarked,
+                            size_t num_matching_pages,
+                            base::Time now);
+
   // Returns |term_matches| after removing all matches that are not at a
   // word break that are in the range [|start_pos|, |end_pos|).
   // start_pos == string::npos is treated as start_pos = length of string.
@@ -133,20 +142,20 @@ struct ScoredHistoryMatch : public history::HistoryMatch {
 
   // Returns a recency score based on |last_visit_days_ago|, which is
   // how many days ago the page was last visited.
-  float GetRecencyScore(int last_visit_days_ago) const;
+  static float GetRecencyScore(int last_visit_days_ago);
 
   // Examines the first |max_visits_to_score_| and returns a score (higher is
   // better) based the rate of visits, whether the page is bookmarked, and
   // how often those visits are typed navigations (i.e., explicitly
   // invoked by the user).  |now| is passed in to avoid unnecessarily
   // recomputing it frequently.
-  float GetFrequency(const base::Time& now,
-                     const bool bookmarked,
-                     const VisitInfoVector& visits) const;
+  static float GetFrequency(const base::Time& now,
+                            const bool bookmarked,
+                            const VisitInfoVector& visits);
 
   // Returns a document specificity score based on how many pages matched the
   // user's input.
-  float GetDocumentSpecificityScore(size_t num_matching_pages) const;
+  static float GetDocumentSpecificityScore(size_t num_matching_pages);
 
   // Combines the three component scores into a final score that's
   // an appropriate value to use as a relevancy score.
@@ -154,6 +163,9 @@ struct ScoredHistoryMatch : public history::HistoryMatch {
                                       float frequency_score,
                                       float specificity_score);
 
+  // Returns the scoring buckets used by GetFinalRelevancyScore().
+  static const ScoreMaxRelevances& GetRelevanceBuckets();
+
   // Helper function that returns the string containing the scoring buckets
   // (either the default ones or ones specified in an experiment).
   static ScoreMaxRelevances GetHQPBuckets();
@@ -226,6 +226,42 @@ TEST_F(ScoredHistoryMatchTest, ScoringBookmarks) {
   EXPECT_GT(scored_with_bookmark.raw_score, scored.raw_score);
 }
 
+TEST_F(ScoredHistoryMatchTest, GetMaxRawScore) {
+  // We use NowFromSystemTime() because MakeURLRow uses the same function
+  // to calculate last visit time when building a row.
+  base::Time now = base::Time::NowFromSystemTime();
+  WordStarts one_word_no_offset(1, 0u);
+
+  // A strong match in the hostname, a weaker one in the title, and one which
+  // doesn't score at all.
+  const char* const kTerms[] = {"abc", "csi", "cd"};
+  history::URLRow row(MakeURLRow("http://abc.csi/csi_csi",
+                                 "CSI Guide to CSI Las Vegas", 10, 1, 3));
+  RowWordStarts word_starts;
+  PopulateWordStarts(row, &word_starts);
+  for (int visit_count : {1, 3, 10}) {
+    VisitInfoVector visits = CreateVisitInfoVector(visit_count, 1, now);
+    visits[0].second = ui::PAGE_TRANSITION_TYPED;
+    for (bool is_bookmarked : {false, true}) {
+      const int max_raw_score = ScoredHistoryMatch::GetMaxRawScore(
+          visits, is_bookmarked, 1, now);
+      for (const char* term : kTerms) {
+        ScoredHistoryMatch scored(row, visits, ASCIIToUTF16(term),
+                                  Make1Term(term), one_word_no_offset,
+                                  word_starts, is_bookmarked, 1, now);
+        EXPECT_LE(scored.raw_score, max_raw_score) << term;
+      }
+    }
+  }
+
+  // URLs with more, and more recent, visits may score higher.
+  const VisitInfoVector old_visits =
+      CreateVisitInfoVector(1, 1, now - base::TimeDelta::FromDays(300));
+  const VisitInfoVector recent_visits = CreateVisitInfoVector(10, 1, now);
+  EXPECT_LT(ScoredHistoryMatch::GetMaxRawScore(old_visits, false, 1, now),
+            ScoredHistoryMatch::GetMaxRawScore(recent_visits, false, 1, now));
+}
+
 TEST_F(ScoredHistoryMatchTest, ScoringTLD) {
   // We use NowFromSystemTime() because MakeURLRow uses the same function
   // to calculate last visit time when building a row.
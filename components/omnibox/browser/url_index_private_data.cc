@@ -7,9 +7,11 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <functional>
 #include <limits>
 #include <memory>
 #include <numeric>
+#include <queue>
 #include <set>
 #include <string>
 #include <utility>
@@ -215,7 +217,7 @@ ScoredHistoryMatches URLIndexPrivateData::HistoryItemsForTerms(
     history_ids_were_trimmed |= TrimHistoryIdsPool(&history_ids);
 
     HistoryIdsToScoredMatches(std::move(history_ids), lower_raw_string,
-                              template_url_service, bookmark_model,
+                              max_matches, template_url_service, bookmark_model,
                               &scored_items);
   }
   // Select and sort only the top |max_matches| results.
@@ -699,6 +701,7 @@ WordIDSet URLIndexPrivateData::WordIDSetForTermChars(
 void URLIndexPrivateData::HistoryIdsToScoredMatches(
     HistoryIDVector history_ids,
     const base::string16& lower_raw_string,
+    size_t max_matches,
     const TemplateURLService* template_url_service,
     bookmarks::BookmarkModel* bookmark_model,
     ScoredHistoryMatches* scored_items) const {
@@ -734,24 +737,64 @@ void URLIndexPrivateData::HistoryIdsToScoredMatches(
     return ShouldFilter(history_id, template_url_service);
   });
 
-  // Score the matches.
   const size_t num_matches = history_ids.size();
   const base::Time now = base::Time::Now();
 
+  // Bound the score each match could reach from its visits alone, and score
+  // the matches with the highest bounds first.
+  struct Candidate {
+    HistoryInfoMap::const_iterator hist_pos;
+    bool is_bookmarked;
+    int max_raw_score;
+  };
+  std::vector<Candidate> candidates;
+  candidates.reserve(num_matches);
   for (HistoryID history_id : history_ids) {
     auto hist_pos = history_info_map_.find(history_id);
-    const history::URLRow& hist_item = hist_pos->second.url_row;
-    auto starts_pos = word_starts_map_.find(history_id);
+    const bool is_bookmarked =
+        bookmark_model &&
+        bookmark_model->IsBookmarked(hist_pos->second.url_row.url());
+    candidates.push_back(
+        {hist_pos, is_bookmarked,
+         ScoredHistoryMatch::GetMaxRawScore(hist_pos->second.visits,
+                                            is_bookmarked, num_matches, now)});
+  }
+  std::sort(candidates.begin(), candidates.end(),
+            [](const Candidate& a, const Candidate& b) {
+              return a.max_raw_score > b.max_raw_score;
+            });
+
+  // The scores of the best |max_matches| matches so far, lowest on top. Once
+  // there are enough of them, a match that can't beat the lowest won't be
+  // shown, and neither will any of the matches after it.
+  std::priority_queue<int, std::vector<int>, std::greater<int>> best_scores;
+  auto add_best_score = [&best_scores, max_matches](int raw_score) {
+    best_scores.push(raw_score);
+    if (best_scores.size() > max_matches)
+      best_scores.pop();
+  };
+  for (const ScoredHistoryMatch& scored_item : *scored_items)
+    add_best_score(scored_item.raw_score);
+
+  // Score the matches.
+  for (const Candidate& candidate : candidates) {
+    if (!best_scores.empty() && best_scores.size() == max_matches &&
+        candidate.max_raw_score < best_scores.top()) {
+      break;
+    }
+    const history::URLRow& hist_item = candidate.hist_pos->second.url_row;
+    auto starts_pos = word_starts_map_.find(candidate.hist_pos->first);
     DCHECK(starts_pos != word_starts_map_.end());
     ScoredHistoryMatch new_scored_match(
-        hist_item, hist_pos->second.visits, lower_raw_string, lower_raw_terms,
-        lower_terms_to_word_starts_offsets, starts_pos->second,
-        bookmark_model && bookmark_model->IsBookmarked(hist_item.url()),
-        num_matches, now);
+        hist_item, candidate.hist_pos->second.visits, lower_raw_string,
+        lower_raw_terms, lower_terms_to_word_starts_offsets, starts_pos->second,
+        candidate.is_bookmarked, num_matches, now);
     // Filter new matches that ended up scoring 0. (These are usually matches
     // which didn't match the user's raw terms.)
-    if (new_scored_match.raw_score > 0)
+    if (new_scored_match.raw_score > 0) {
+      add_best_score(new_scored_match.raw_score);
       scored_items->push_back(std::move(new_scored_match));
+    }
   }
 }
 
@@ -882,22 +925,21 @@ void URLIndexPrivateData::AddRowWordsToIndex(const history::URLRow& row,
 
 void URLIndexPrivateData::AddWordToIndex(const base::string16& term,
                                          HistoryID history_id) {
-  WordMap::iterator word_pos;
-  bool is_new;
-  std::tie(word_pos, is_new) = word_map_.insert(std::make_pair(term, WordID()));
+  WordID word_id;
 
   // Adding a new word (i.e. a word that is not already in the word index).
-  if (is_new) {
-    word_pos->second = AddNewWordToWordList(term);
+  if (!word_map_.Find(word_list_, term, &word_id)) {
+    word_id = AddNewWordToWordList(term);
+    word_map_.Insert(word_list_, word_id);
 
     // For each character in the newly added word add the word to the character
     // index.
     for (base::char16 uni_char : Char16SetFromString16(term))
-      char_word_map_[uni_char].insert(word_pos->second);
+      char_word_map_[uni_char].insert(word_id);
   }
 
-  word_id_history_map_[word_pos->second].insert(history_id);
-  history_id_word_map_[history_id].insert(word_pos->second);
+  word_id_history_map_[word_id].insert(history_id);
+  history_id_word_map_[history_id].insert(word_id);
 }
 
 WordID URLIndexPrivateData::AddNewWordToWordList(const base::string16& term) {
@@ -947,7 +989,7 @@ void URLIndexPrivateData::RemoveRowWordsFromIndex(const history::URLRow& row) {
 
     // Complete the removal of references to the word.
     word_id_history_map_.erase(word_id_history_map_iter);
-    word_map_.erase(word);
+    word_map_.Erase(word_list_, word_id);
     word_list_[word_id] = base::string16();
     available_words_.push(word_id);
   }
@@ -1009,10 +1051,10 @@ void URLIndexPrivateData::SaveWordMap(InMemoryURLIndexCacheItem* cache) const {
     return;
   WordMapItem* map_item = cache->mutable_word_map();
   map_item->set_item_count(word_map_.size());
-  for (const auto& elem : word_map_) {
+  for (WordID word_id : word_map_.GetWordIDs(word_list_)) {
     WordMapEntry* map_entry = map_item->add_word_map_entry();
-    map_entry->set_word(base::UTF16ToUTF8(elem.first));
-    map_entry->set_word_id(elem.second);
+    map_entry->set_word(base::UTF16ToUTF8(word_list_[word_id]));
+    map_entry->set_word_id(word_id);
   }
 }
 
@@ -1154,8 +1196,15 @@ bool URLIndexPrivateData::RestoreWordMap(
   uint32_t actual_item_count = list_item.word_map_entry_size();
   if (actual_item_count == 0 || actual_item_count != expected_item_count)
     return false;
-  for (const auto& entry : list_item.word_map_entry())
-    word_map_[base::UTF8ToUTF16(entry.word())] = entry.word_id();
+  // The words are already in |word_list_|, so only the IDs are kept.
+  std::vector<WordID> word_ids;
+  word_ids.reserve(actual_item_count);
+  for (const auto& entry : list_item.word_map_entry()) {
+    if (entry.word_id() >= word_list_.size())
+      return false;
+    word_ids.push_back(entry.word_id());
+  }
+  word_map_.Assign(word_list_, std::move(word_ids));
 
   return true;
 }
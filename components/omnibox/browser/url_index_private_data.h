@@ -237,9 +237,11 @@ class URLIndexPrivateData
   WordIDSet WordIDSetForTermChars(const Char16Set& term_chars);
 
   // Helper function for HistoryItemsForTerms().  Fills in |scored_items| from
-  // the matches listed in |history_ids|.
+  // the matches listed in |history_ids|.  Matches which can't be among the
+  // best |max_matches| of |scored_items| may be left out.
   void HistoryIdsToScoredMatches(HistoryIDVector history_ids,
                                  const base::string16& lower_raw_string,
+                                 size_t max_matches,
                                  const TemplateURLService* template_url_service,
                                  bookmarks::BookmarkModel* bookmark_model,
                                  ScoredHistoryMatches* scored_items) const;
@@ -366,7 +368,8 @@ class URLIndexPrivateData
   base::stack<WordID> available_words_;
 
   // A one-to-one mapping from the a word string to its slot number (i.e.
-  // WordID) in the |word_list_|.
+  // WordID) in the |word_list_|. It refers to the words in |word_list_| rather
+  // than copying them.
   WordMap word_map_;
 
   // A one-to-many mapping from a single character to all WordIDs of words
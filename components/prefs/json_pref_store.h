@@ -7,6 +7,7 @@
 
 #include <stdint.h>
 
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
@@ -220,11 +221,19 @@ class COMPONENTS_PREFS_EXPORT JsonPrefStore
   // WriteablePrefStore::LOSSY_PREF_WRITE_FLAG.
   void ScheduleWrite(uint32_t flags);
 
+  // Drops the serialized JSON of the top-level pref containing |key|, which is
+  // about to change.
+  void InvalidateSerializedPref(const std::string& key);
+
   const base::FilePath path_;
   const scoped_refptr<base::SequencedTaskRunner> file_task_runner_;
 
   std::unique_ptr<base::DictionaryValue> prefs_;
 
+  // The JSON of each top-level pref as of the last write, so that a write only
+  // serializes the top-level prefs which changed since then.
+  std::map<std::string, std::string> serialized_prefs_;
+
   bool read_only_;
 
   // Helper for safely writing pref data.
@@ -815,6 +815,45 @@ TEST_F(JsonPrefStoreLossyWriteTest, ScheduleLossyWrite) {
   ASSERT_EQ("{\"lossy\":\"lossy\"}", GetTestFileContents());
 }
 
+// Top-level prefs are only serialized again after they changed, however they
+// were changed.
+TEST_F(JsonPrefStoreLossyWriteTest, WritesChangedPrefs) {
+  scoped_refptr<JsonPrefStore> pref_store = CreatePrefStore();
+  ImportantFileWriter* file_writer = GetImportantFileWriter(pref_store.get());
+
+  pref_store->SetValue("a.b", std::make_unique<base::Value>(1),
+                       WriteablePrefStore::DEFAULT_PREF_WRITE_FLAGS);
+  pref_store->SetValue("c", std::make_unique<base::Value>("c"),
+                       WriteablePrefStore::DEFAULT_PREF_WRITE_FLAGS);
+  file_writer->DoScheduledWrite();
+  ASSERT_EQ("{\"a\":{\"b\":1},\"c\":\"c\"}", GetTestFileContents());
+
+  pref_store->SetValue("a.d", std::make_unique<base::Value>(true),
+                       WriteablePrefStore::DEFAULT_PREF_WRITE_FLAGS);
+  file_writer->DoScheduledWrite();
+  ASSERT_EQ("{\"a\":{\"b\":1,\"d\":true},\"c\":\"c\"}",
+            GetTestFileContents());
+
+  // A value changed in place is written once it is reported.
+  base::Value* value = nullptr;
+  ASSERT_TRUE(pref_store->GetMutableValue("a.b", &value));
+  *value = base::Value(2);
+  pref_store->ReportValueChanged("a.b",
+                                 WriteablePrefStore::DEFAULT_PREF_WRITE_FLAGS);
+  file_writer->DoScheduledWrite();
+  ASSERT_EQ("{\"a\":{\"b\":2,\"d\":true},\"c\":\"c\"}",
+            GetTestFileContents());
+
+  pref_store->RemoveValueSilently("c",
+                                  WriteablePrefStore::DEFAULT_PREF_WRITE_FLAGS);
+  file_writer->DoScheduledWrite();
+  ASSERT_EQ("{\"a\":{\"b\":2,\"d\":true}}", GetTestFileContents());
+
+  pref_store->RemoveValue("a", WriteablePrefStore::DEFAULT_PREF_WRITE_FLAGS);
+  file_writer->DoScheduledWrite();
+  ASSERT_EQ("{}", GetTestFileContents());
+}
+
 class SuccessfulWriteReplyObserver {
  public:
   SuccessfulWriteReplyObserver() = default;
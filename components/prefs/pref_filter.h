@@ -6,10 +6,12 @@
 #define COMPONENTS_PREFS_PREF_FILTER_H_
 
 #include <memory>
+#include <set>
 #include <string>
 #include <utility>
 
 #include "base/callback_forward.h"
+#include "base/optional.h"
 #include "components/prefs/prefs_export.h"
 
 namespace base {
@@ -59,6 +61,14 @@ class COMPONENTS_PREFS_EXPORT PrefFilter {
   virtual OnWriteCallbackPair FilterSerializeData(
       base::DictionaryValue* pref_store_contents) = 0;
 
+  // Returns the top-level keys of |pref_store_contents| which
+  // FilterSerializeData() may modify, so that stores caching serialized data
+  // know what to serialize again. base::nullopt means any key.
+  virtual base::Optional<std::set<std::string>> GetKeysModifiedOnSerialize()
+      const {
+    return base::nullopt;
+  }
+
   // Cleans preference data that may have been saved outside of the store.
   virtual void OnStoreDeletionFromDisk() = 0;
 };
@@ -510,6 +510,7 @@ base::Value* PrefService::GetMutableUserPref(const std::string& path,
     }
     user_pref_store_->SetValueSilently(path, base::WrapUnique(value),
                                        GetWriteFlags(pref));
+    pref_value_store_->InvalidateControllingStore(path);
   }
   return value;
 }
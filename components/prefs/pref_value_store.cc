@@ -115,12 +115,20 @@ void PrefValueStore::set_callback(const PrefChangedCallback& callback) {
 bool PrefValueStore::GetValue(const std::string& name,
                               base::Value::Type type,
                               const base::Value** out_value) const {
+  auto it = controlling_stores_.find(name);
+  if (it != controlling_stores_.end() && it->second.type == type &&
+      GetValueFromStoreWithType(name, type, it->second.store, out_value)) {
+    return true;
+  }
+
   // Check the |PrefStore|s in order of their priority from highest to lowest,
   // looking for the first preference value with the given |name| and |type|.
   for (size_t i = 0; i <= PREF_STORE_TYPE_MAX; ++i) {
-    if (GetValueFromStoreWithType(name, type, static_cast<PrefStoreType>(i),
-                                  out_value))
+    PrefStoreType store = static_cast<PrefStoreType>(i);
+    if (GetValueFromStoreWithType(name, type, store, out_value)) {
+      controlling_stores_[name] = {type, store};
       return true;
+    }
   }
   return false;
 }
@@ -196,6 +204,24 @@ void PrefValueStore::UpdateCommandLinePrefStore(PrefStore* command_line_prefs) {
     delegate_->UpdateCommandLinePrefStore(command_line_prefs);
 }
 
+void PrefValueStore::InvalidateControllingStore(const std::string& name) {
+  controlling_stores_.erase(name);
+
+  // A change of |name| is a change of the values nested in it...
+  const std::string prefix = name + '.';
+  auto it = controlling_stores_.lower_bound(prefix);
+  while (it != controlling_stores_.end() &&
+         it->first.compare(0, prefix.size(), prefix) == 0) {
+    it = controlling_stores_.erase(it);
+  }
+
+  // ...and of the dictionaries containing it.
+  for (size_t pos = name.find('.'); pos != std::string::npos;
+       pos = name.find('.', pos + 1)) {
+    controlling_stores_.erase(name.substr(0, pos));
+  }
+}
+
 bool PrefValueStore::IsInitializationComplete() const {
   for (size_t i = 0; i <= PREF_STORE_TYPE_MAX; ++i) {
     const PrefStore* pref_store = GetPrefStore(static_cast<PrefStoreType>(i));
@@ -275,11 +301,14 @@ bool PrefValueStore::GetValueFromStoreWithType(
 
 void PrefValueStore::OnPrefValueChanged(PrefValueStore::PrefStoreType type,
                                         const std::string& key) {
+  InvalidateControllingStore(key);
   NotifyPrefChanged(key, type);
 }
 
 void PrefValueStore::OnInitializationCompleted(
     PrefValueStore::PrefStoreType type, bool succeeded) {
+  // Stores don't notify about the values they read during initialization.
+  controlling_stores_.clear();
   if (initialization_failed_)
     return;
   if (!succeeded) {
@@ -292,6 +321,7 @@ void PrefValueStore::OnInitializationCompleted(
 
 void PrefValueStore::InitPrefStore(PrefValueStore::PrefStoreType type,
                                    PrefStore* pref_store) {
+  controlling_stores_.clear();
   pref_stores_[type].Initialize(this, pref_store, type);
 }
 
@@ -178,6 +178,11 @@ class COMPONENTS_PREFS_EXPORT PrefValueStore {
   // Update the command line PrefStore with |command_line_prefs|.
   void UpdateCommandLinePrefStore(PrefStore* command_line_prefs);
 
+  // Forgets which PrefStore controls |name| and the preferences nested in it
+  // or containing it. Must be called when a value is set in one of the
+  // PrefStores without notifying its observers.
+  void InvalidateControllingStore(const std::string& name);
+
   bool IsInitializationComplete() const;
 
  private:
@@ -217,6 +222,13 @@ class COMPONENTS_PREFS_EXPORT PrefValueStore {
 
   typedef std::map<std::string, base::Value::Type> PrefTypeMap;
 
+  // The PrefStore that held the effective value of a preference when it was
+  // last looked up with |type|.
+  struct ControllingStore {
+    base::Value::Type type;
+    PrefStoreType store;
+  };
+
   // Returns true if the preference with the given name has a value in the
   // given PrefStoreType, of the same value type as the preference was
   // registered with.
@@ -290,6 +302,14 @@ class COMPONENTS_PREFS_EXPORT PrefValueStore {
   // A mapping of preference names to their registered types.
   PrefTypeMap pref_types_;
 
+  // Controlling PrefStores of the preferences read through GetValue(), so
+  // that reads don't walk all of the PrefStores in order of precedence. Kept
+  // up to date through PrefStore::Observer notifications. An entry whose store
+  // no longer has the value is ignored, but one that is overridden by a value
+  // newly set in a higher-priority store has to be invalidated. Ordered so
+  // that nested preferences can be invalidated together.
+  mutable std::map<std::string, ControllingStore> controlling_stores_;
+
   // True if not all of the PrefStores were initialized successfully.
   bool initialization_failed_;
 
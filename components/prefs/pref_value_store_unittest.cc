@@ -483,6 +483,50 @@ TEST_F(PrefValueStoreTest, PrefChanges) {
   CheckAndClearValueChangeNotifications();
 }
 
+TEST_F(PrefValueStoreTest, GetValueAfterChanges) {
+  const base::Value* value = nullptr;
+  ASSERT_TRUE(pref_value_store_->GetValue(prefs::kDefaultPref,
+                                          base::Value::Type::STRING, &value));
+  EXPECT_EQ(default_pref::kDefaultValue, value->GetString());
+
+  // Changes notified by the stores are picked up.
+  ExpectValueChangeNotifications(prefs::kDefaultPref);
+  user_pref_store_->SetString(prefs::kDefaultPref, user_pref::kUserValue);
+  CheckAndClearValueChangeNotifications();
+  ASSERT_TRUE(pref_value_store_->GetValue(prefs::kDefaultPref,
+                                          base::Value::Type::STRING, &value));
+  EXPECT_EQ(user_pref::kUserValue, value->GetString());
+
+  ExpectValueChangeNotifications(prefs::kDefaultPref);
+  user_pref_store_->RemoveValue(prefs::kDefaultPref, 0);
+  CheckAndClearValueChangeNotifications();
+  ASSERT_TRUE(pref_value_store_->GetValue(prefs::kDefaultPref,
+                                          base::Value::Type::STRING, &value));
+  EXPECT_EQ(default_pref::kDefaultValue, value->GetString());
+
+  // Values set silently are picked up once invalidated, together with the
+  // values nested in the invalidated preference...
+  ASSERT_TRUE(pref_value_store_->GetValue(prefs::kRecommendedPref,
+                                          base::Value::Type::STRING, &value));
+  managed_pref_store_->SetValueSilently(
+      prefs::kRecommendedPref,
+      std::make_unique<base::Value>(managed_pref::kManagedValue), 0);
+  pref_value_store_->InvalidateControllingStore("this.pref");
+  ASSERT_TRUE(pref_value_store_->GetValue(prefs::kRecommendedPref,
+                                          base::Value::Type::STRING, &value));
+  EXPECT_EQ(managed_pref::kManagedValue, value->GetString());
+
+  // ...and the dictionaries containing it.
+  managed_pref_store_->SetValueSilently(
+      prefs::kDefaultPref,
+      std::make_unique<base::Value>(managed_pref::kManagedValue), 0);
+  pref_value_store_->InvalidateControllingStore(
+      std::string(prefs::kDefaultPref) + ".nested");
+  ASSERT_TRUE(pref_value_store_->GetValue(prefs::kDefaultPref,
+                                          base::Value::Type::STRING, &value));
+  EXPECT_EQ(managed_pref::kManagedValue, value->GetString());
+}
+
 TEST_F(PrefValueStoreTest, OnInitializationCompleted) {
   EXPECT_CALL(pref_notifier_, OnInitializationCompleted(true)).Times(0);
   managed_pref_store_->SetInitializationCompleted();
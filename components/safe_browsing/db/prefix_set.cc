@@ -9,6 +9,7 @@
 #include <algorithm>
 #include <utility>
 
+#include "base/bits.h"
 #include "base/files/file_util.h"
 #include "base/files/scoped_file.h"
 #include "base/logging.h"
@@ -81,12 +82,6 @@ size_t EstimateFinalCount(SBPrefix current_prefix, size_t current_count) {
 
 }  // namespace
 
-// For |std::upper_bound()| to find a prefix w/in a vector of pairs.
-// static
-bool PrefixSet::PrefixLess(const IndexPair& a, const IndexPair& b) {
-  return a.first < b.first;
-}
-
 PrefixSet::PrefixSet() {}
 
 PrefixSet::PrefixSet(IndexVector* index,
@@ -96,27 +91,65 @@ PrefixSet::PrefixSet(IndexVector* index,
   index_.swap(*index);
   deltas_.swap(*deltas);
   full_hashes_.swap(*full_hashes);
+  BuildEytzingerIndex();
 }
 
 PrefixSet::~PrefixSet() {}
 
+void PrefixSet::BuildEytzingerIndex() {
+  const size_t n = index_.size();
+  IndexVector eytzinger_index(n ? n + 1 : 0);
+
+  // An in-order walk of the tree visits |index_| in sorted order.
+  size_t i = 0;
+  size_t k = 1;
+  while (i < n) {
+    // Go down to the leftmost unvisited node...
+    while (2 * k <= n)
+      k *= 2;
+    // ...visit it and the ancestors of which it is in the right subtree...
+    while (true) {
+      eytzinger_index[k] =
+          std::make_pair(index_[i].first, static_cast<uint32_t>(i));
+      ++i;
+      if (2 * k + 1 <= n) {
+        k = 2 * k + 1;
+        break;
+      }
+      // ...up to the first ancestor of which it is in the left subtree.
+      k >>= base::bits::CountTrailingZeroBits(~k) + 1;
+      if (!k)
+        break;
+    }
+  }
+  DCHECK_EQ(i, n);
+  eytzinger_index_.swap(eytzinger_index);
+}
+
 bool PrefixSet::PrefixExists(SBPrefix prefix) const {
   if (index_.empty())
     return false;
 
-  // Find the first position after |prefix| in |index_|.
-  IndexVector::const_iterator iter = std::upper_bound(
-      index_.begin(), index_.end(), IndexPair(prefix, 0), PrefixLess);
+  // Find the first position after |prefix| in |index_|. Going right on
+  // every prefix which is not after |prefix| leads to a leaf of the tree.
+  const size_t n = index_.size();
+  size_t k = 1;
+  while (k <= n)
+    k = 2 * k + (eytzinger_index_[k].first <= prefix);
+  // The last left turn was at the first prefix after |prefix|, if any.
+  k >>= base::bits::CountTrailingZeroBits(~k) + 1;
+  const size_t upper_bound = k ? eytzinger_index_[k].second : n;
 
   // |prefix| comes before anything that's in the set.
-  if (iter == index_.begin())
+  if (upper_bound == 0)
     return false;
 
   // Capture the upper bound of our target entry's deltas.
-  const size_t bound = (iter == index_.end() ? deltas_.size() : iter->second);
+  const size_t bound =
+      (upper_bound == n ? deltas_.size() : index_[upper_bound].second);
 
   // Back up to the entry our target is in.
-  --iter;
+  IndexVector::const_iterator iter = index_.begin() + upper_bound - 1;
 
   // All prefixes in |index_| are in the set.
   SBPrefix current = iter->first;
@@ -379,6 +412,7 @@ std::unique_ptr<const PrefixSet> PrefixSetBuilder::GetPrefixSet(
   // Precisely size |index_| for read-only.  It's 50k-60k, so minor savings, but
   // they're almost free.
   PrefixSet::IndexVector(prefix_set_->index_).swap(prefix_set_->index_);
+  prefix_set_->BuildEytzingerIndex();
 
   prefix_set_->full_hashes_ = hashes;
   std::sort(prefix_set_->full_hashes_.begin(), prefix_set_->full_hashes_.end(),
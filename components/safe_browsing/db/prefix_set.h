@@ -85,6 +85,7 @@ class PrefixSet {
   friend class PrefixSetTest;
   FRIEND_TEST_ALL_PREFIXES(PrefixSetTest, AllBig);
   FRIEND_TEST_ALL_PREFIXES(PrefixSetTest, EdgeCases);
+  FRIEND_TEST_ALL_PREFIXES(PrefixSetTest, EytzingerIndex);
   FRIEND_TEST_ALL_PREFIXES(PrefixSetTest, Empty);
   FRIEND_TEST_ALL_PREFIXES(PrefixSetTest, FullHashBuild);
   FRIEND_TEST_ALL_PREFIXES(PrefixSetTest, IntMinMax);
@@ -110,7 +111,6 @@ class PrefixSet {
   // Helpers to make |index_| easier to deal with.
   typedef std::pair<SBPrefix, uint32_t> IndexPair;
   typedef std::vector<IndexPair> IndexVector;
-  static bool PrefixLess(const IndexPair& a, const IndexPair& b);
 
   // Helper to let |PrefixSetBuilder| add a run of data.  |index_prefix| is
   // added to |index_|, with the other elements added into |deltas_|.
@@ -118,6 +118,9 @@ class PrefixSet {
               const uint16_t* run_begin,
               const uint16_t* run_end);
 
+  // Fills |eytzinger_index_| from |index_|.
+  void BuildEytzingerIndex();
+
   // |true| if |prefix| is one of the prefixes passed to the set's builder.
   // Provided for testing purposes.
   bool PrefixExists(SBPrefix prefix) const;
@@ -140,6 +143,13 @@ class PrefixSet {
   // index into |deltas_|.
   IndexVector index_;
 
+  // The prefixes of |index_| paired with their position in |index_|, laid out
+  // as an implicit binary search tree in breadth-first order (the Eytzinger
+  // layout): the children of element k are elements 2k and 2k+1, and element 0
+  // is unused. Searching it doesn't branch on the comparisons, and the first
+  // levels of the tree share cache lines. Not persisted.
+  IndexVector eytzinger_index_;
+
   // Deltas which are added to the prefix in |index_| to generate
   // prefixes.  Deltas are only valid between consecutive items from
   // |index_|, or the end of |deltas_| for the last |index_| pair.
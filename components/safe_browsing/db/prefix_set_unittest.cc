@@ -377,6 +377,27 @@ TEST_F(PrefixSetTest, EdgeCases) {
   }
 }
 
+// Every shape of the Eytzinger index finds the right entry of |index_|.
+TEST_F(PrefixSetTest, EytzingerIndex) {
+  // Deltas this large put every prefix in its own index entry.
+  const SBPrefix kDelta = 256 * 256 * 2;
+  std::vector<SBPrefix> prefixes;
+  for (SBPrefix prefix = kDelta; prefixes.size() < 40; prefix += kDelta) {
+    prefixes.push_back(prefix);
+    PrefixSetBuilder builder(prefixes);
+    std::unique_ptr<const PrefixSet> prefix_set =
+        builder.GetPrefixSetNoHashes();
+    ASSERT_EQ(prefixes.size(), prefix_set->index_.size());
+
+    EXPECT_FALSE(prefix_set->PrefixExists(0));
+    for (SBPrefix p : prefixes) {
+      EXPECT_TRUE(prefix_set->PrefixExists(p));
+      EXPECT_FALSE(prefix_set->PrefixExists(p - 1));
+      EXPECT_FALSE(prefix_set->PrefixExists(p + 1));
+    }
+  }
+}
+
 // Test writing a prefix set to disk and reading it back in.
 TEST_F(PrefixSetTest, ReadWrite) {
   base::FilePath filename;
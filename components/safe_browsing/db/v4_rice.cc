@@ -2,9 +2,12 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <string.h>
+
 #include <algorithm>
 #include <vector>
 
+#include "base/bits.h"
 #include "base/logging.h"
 #include "base/numerics/safe_math.h"
 #include "base/strings/stringprintf.h"
@@ -179,16 +182,31 @@ V4DecodeResult V4RiceDecoder::GetNextValue(uint32_t* value) {
     return DECODE_NO_MORE_ENTRIES_FAILURE;
   }
 
+  // The quotient is unary-coded as a run of 1 bits ended by a 0 bit. Count the
+  // run a word at a time rather than a bit at a time.
   V4DecodeResult result;
   uint32_t q = 0;
-  uint32_t bit;
-  do {
-    result = GetNextBits(1, &bit);
-    if (result != DECODE_SUCCESS) {
-      return result;
+  while (true) {
+    if (current_word_bit_index_ == kMaxBitIndex) {
+      result = GetNextWord(&current_word_);
+      if (result != DECODE_SUCCESS) {
+        return result;
+      }
+    }
+
+    // The unread bits are the low bits of |current_word_|, the others are 0.
+    unsigned int num_bits_left_in_current_word =
+        kMaxBitIndex - current_word_bit_index_;
+    unsigned int num_ones = base::bits::CountTrailingZeroBits(~current_word_);
+    if (num_ones < num_bits_left_in_current_word) {
+      q += num_ones;
+      GetBitsFromCurrentWord(num_ones + 1);
+      break;
     }
-    q += bit;
-  } while (bit);
+    q += num_bits_left_in_current_word;
+    GetBitsFromCurrentWord(num_bits_left_in_current_word);
+  }
+
   uint32_t r = 0;
   result = GetNextBits(rice_parameter_, &r);
   if (result != DECODE_SUCCESS) {
@@ -205,10 +223,17 @@ V4DecodeResult V4RiceDecoder::GetNextWord(uint32_t* word) {
     return DECODE_RAN_OUT_OF_BITS_FAILURE;
   }
 
+  current_word_bit_index_ = 0;
+  if (data_.size() - data_byte_index_ >= sizeof(*word)) {
+    // The data is little-endian, like the machine.
+    memcpy(word, data_.data() + data_byte_index_, sizeof(*word));
+    data_byte_index_ += sizeof(*word);
+    return DECODE_SUCCESS;
+  }
+
   const size_t mask = 0xFF;
   *word = (data_[data_byte_index_] & mask);
   data_byte_index_++;
-  current_word_bit_index_ = 0;
 
   if (data_byte_index_ < data_.size()) {
     *word |= ((data_[data_byte_index_] & mask) << 8);
@@ -268,6 +293,13 @@ V4DecodeResult V4RiceDecoder::GetNextBits(unsigned int num_requested_bits,
 
 uint32_t V4RiceDecoder::GetBitsFromCurrentWord(
     unsigned int num_requested_bits) {
+  if (num_requested_bits == kMaxBitIndex) {
+    // Shifting a 32-bit value by 32 is undefined.
+    uint32_t x = current_word_;
+    current_word_ = 0;
+    current_word_bit_index_ += num_requested_bits;
+    return x;
+  }
   uint32_t mask = 0xFFFFFFFF >> (kMaxBitIndex - num_requested_bits);
   uint32_t x = current_word_ & mask;
   current_word_ = current_word_ >> num_requested_bits;
@@ -211,6 +211,16 @@ TEST_F(V4RiceTest, TestDecoderIntegersWithMultipleValues) {
   EXPECT_EQ(29, out.Get(2));
 }
 
+TEST_F(V4RiceTest, TestDecoderIntegersWithQuotientAcrossWords) {
+  // A quotient of 40, unary-coded across two words, and a remainder of 1.
+  RepeatedField<int32> out;
+  EXPECT_EQ(DECODE_SUCCESS, V4RiceDecoder::DecodeIntegers(
+                                5, 2, 1, "\xff\xff\xff\xff\xff\x2", &out));
+  EXPECT_EQ(2, out.size());
+  EXPECT_EQ(5, out.Get(0));
+  EXPECT_EQ(5 + (40 << 2) + 1, out.Get(1));
+}
+
 #if defined(NDEBUG) && !defined(DCHECK_ALWAYS_ON)
 // This test hits a NOTREACHED so it is a release mode only test.
 TEST_F(V4RiceTest, TestDecoderPrefixesWithNoData) {
@@ -9,7 +9,9 @@
 
 #include "base/base64.h"
 #include "base/bind.h"
+#include "base/files/file.h"
 #include "base/files/file_util.h"
+#include "base/macros.h"
 #include "base/metrics/histogram_functions.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/stl_util.h"
@@ -20,6 +22,7 @@
 #include "components/safe_browsing/proto/webui.pb.h"
 #include "crypto/secure_hash.h"
 #include "crypto/sha2.h"
+#include "third_party/protobuf/src/google/protobuf/io/zero_copy_stream_impl_lite.h"
 
 using base::TimeTicks;
 
@@ -54,6 +57,26 @@ const uint32_t kFileVersion = 9;
 // The maximum store file size, as of today, is about 6MB.
 constexpr size_t kMaxStoreSizeBytes = 50 * 1000 * 1000;
 
+// Writes the serialized store to a base::File in buffer-sized chunks so that
+// the whole file never needs to be held in memory.
+class CopyingFileOutputStream
+    : public google::protobuf::io::CopyingOutputStream {
+ public:
+  explicit CopyingFileOutputStream(base::File* file) : file_(file) {}
+  ~CopyingFileOutputStream() override = default;
+
+  // google::protobuf::io::CopyingOutputStream:
+  bool Write(const void* buffer, int size) override {
+    return file_->WriteAtCurrentPos(static_cast<const char*>(buffer), size) ==
+           size;
+  }
+
+ private:
+  base::File* file_;
+
+  DISALLOW_COPY_AND_ASSIGN(CopyingFileOutputStream);
+};
+
 void RecordTimeWithAndWithoutSuffix(const std::string& metric,
                                     base::TimeDelta time,
                                     const base::FilePath& file_path) {
@@ -323,8 +346,8 @@ ApplyUpdateResult V4Store::ProcessUpdate(
     DCHECK(!raw_removals);
     // We delay the checksum check at startup to be able to load the DB
     // quickly. In this case, the |hash_prefix_map_old| should be empty, so just
-    // copy over the |hash_prefix_map|.
-    hash_prefix_map_ = hash_prefix_map;
+    // take over the |hash_prefix_map|.
+    hash_prefix_map_.swap(hash_prefix_map);
 
     // Calculate the checksum asynchronously later and if it doesn't match,
     // reset the store.
@@ -731,14 +754,18 @@ StoreWriteResult V4Store::WriteToDisk(const Checksum& checksum) {
   *(lur->mutable_checksum()) = checksum;
   lur->set_new_client_state(state_);
   lur->set_response_type(ListUpdateResponse::FULL_UPDATE);
-  for (auto map_iter : hash_prefix_map_) {
+  // The hash prefixes are lent to the proto rather than copied into it, and
+  // are returned once it has been written, so that a large store is only held
+  // in memory once.
+  for (auto& map_iter : hash_prefix_map_) {
     ThreatEntrySet* additions = lur->add_additions();
     // TODO(vakh): Write RICE encoded hash prefixes on disk. Not doing so
     // currently since it takes a long time to decode them on startup, which
     // blocks resource load. See: http://crbug.com/654819
     additions->set_compression_type(RAW);
     additions->mutable_raw_hashes()->set_prefix_size(map_iter.first);
-    additions->mutable_raw_hashes()->set_raw_hashes(map_iter.second);
+    additions->mutable_raw_hashes()->mutable_raw_hashes()->swap(
+        map_iter.second);
   }
 
   // Attempt writing to a temporary file first and at the end, swap the files.
@@ -746,12 +773,29 @@ StoreWriteResult V4Store::WriteToDisk(const Checksum& checksum) {
 
   file_format.set_magic_number(kFileMagic);
   file_format.set_version_number(kFileVersion);
-  std::string file_format_string;
-  file_format.SerializeToString(&file_format_string);
-  size_t written = base::WriteFile(new_filename, file_format_string.data(),
-                                   file_format_string.size());
+  const size_t expected_size = file_format.ByteSizeLong();
+  size_t written = 0;
+  bool write_succeeded = false;
+  {
+    base::File file(new_filename,
+                    base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
+    if (file.IsValid()) {
+      CopyingFileOutputStream file_stream(&file);
+      google::protobuf::io::CopyingOutputStreamAdaptor output(&file_stream);
+      write_succeeded =
+          file_format.SerializeToZeroCopyStream(&output) && output.Flush();
+      written = static_cast<size_t>(output.ByteCount());
+    }
+  }
+
+  int index = 0;
+  for (auto& map_iter : hash_prefix_map_) {
+    map_iter.second.swap(*lur->mutable_additions(index++)
+                              ->mutable_raw_hashes()
+                              ->mutable_raw_hashes());
+  }
 
-  if (file_format_string.size() != written) {
+  if (!write_succeeded || expected_size != written) {
     return UNEXPECTED_BYTES_WRITTEN_FAILURE;
   }
 
@@ -560,6 +560,10 @@ TEST_F(V4StoreTest, TestReadFullResponseWithValidHashPrefixMap) {
   EXPECT_FALSE(base::PathExists(write_store.store_path_));
   EXPECT_EQ(WRITE_SUCCESS, write_store.WriteToDisk(Checksum()));
   EXPECT_TRUE(base::PathExists(write_store.store_path_));
+  // The hash prefixes are still in the store after writing it.
+  ASSERT_EQ(2u, write_store.hash_prefix_map_.size());
+  EXPECT_EQ("00000abc", write_store.hash_prefix_map_[4]);
+  EXPECT_EQ("00000abcde", write_store.hash_prefix_map_[5]);
 
   V4Store read_store(task_runner_, store_path_);
   EXPECT_EQ(READ_SUCCESS, read_store.ReadFromDisk());
@@ -20,7 +20,7 @@ size_t ComputeHash(const std::vector<Address>& addrs) {
   if (addrs.empty())
     return 0;
   // Assume Address is a POD containing only the address with no padding.
-  return base::Hash(addrs.data(), addrs.size() * sizeof(Address));
+  return base::FastHash(addrs.data(), addrs.size() * sizeof(Address));
 }
 
 }  // namespace
@@ -4,6 +4,8 @@
 
 #include "components/services/patch/file_patcher_impl.h"
 
+#include "components/zucchini/zucchini.h"
+#include "components/zucchini/zucchini_integration.h"
 #include "courgette/courgette.h"
 #include "courgette/third_party/bsdiff/bsdiff.h"
 
@@ -41,4 +43,17 @@ void FilePatcherImpl::PatchFileCourgette(base::File input_file,
   std::move(callback).Run(patch_result_status);
 }
 
+void FilePatcherImpl::PatchFileZucchini(base::File input_file,
+                                        base::File patch_file,
+                                        base::File output_file,
+                                        PatchFileZucchiniCallback callback) {
+  DCHECK(input_file.IsValid());
+  DCHECK(patch_file.IsValid());
+  DCHECK(output_file.IsValid());
+
+  const zucchini::status::Code patch_result_status = zucchini::Apply(
+      std::move(input_file), std::move(patch_file), std::move(output_file));
+  std::move(callback).Run(patch_result_status);
+}
+
 }  // namespace patch
@@ -30,6 +30,10 @@ class FilePatcherImpl : public mojom::FilePatcher {
                           base::File patch_file,
                           base::File output_file,
                           PatchFileCourgetteCallback callback) override;
+  void PatchFileZucchini(base::File input_file,
+                         base::File patch_file,
+                         base::File output_file,
+                         PatchFileZucchiniCallback callback) override;
 
   const std::unique_ptr<service_manager::ServiceContextRef> service_ref_;
 
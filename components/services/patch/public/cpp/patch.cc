@@ -102,6 +102,11 @@ void Patch(service_manager::Connector* connector,
         ->PatchFileCourgette(std::move(input_file), std::move(patch_file),
                              std::move(output_file),
                              base::Bind(&PatchDone, patch_params));
+  } else if (operation == update_client::kZucchini) {
+    (*patch_params->file_patcher())
+        ->PatchFileZucchini(std::move(input_file), std::move(patch_file),
+                            std::move(output_file),
+                            base::Bind(&PatchDone, patch_params));
   } else {
     NOTREACHED();
   }
@@ -17,13 +17,21 @@
 
 namespace subresource_filter {
 
+namespace {
+
+const size_t kMaxCachedLoadDecisions = 64;
+const size_t kMaxCachedLoadDecisionBytes = 16 * 1024;
+
+}  // namespace
+
 DocumentSubresourceFilter::DocumentSubresourceFilter(
     url::Origin document_origin,
     ActivationState activation_state,
     scoped_refptr<const MemoryMappedRuleset> ruleset)
     : activation_state_(activation_state),
       ruleset_(std::move(ruleset)),
-      ruleset_matcher_(ruleset_->data(), ruleset_->length()) {
+      ruleset_matcher_(ruleset_->data(), ruleset_->length()),
+      load_decision_cache_(kMaxCachedLoadDecisions) {
   DCHECK_NE(activation_state_.activation_level, ActivationLevel::DISABLED);
   if (!activation_state_.filtering_disabled_for_document)
     document_origin_.reset(new FirstPartyOrigin(std::move(document_origin)));
@@ -62,10 +70,7 @@ LoadPolicy DocumentSubresourceFilter::GetLoadPolicy(
       });
 
   ++statistics_.num_loads_evaluated;
-  DCHECK(document_origin_);
-  if (ruleset_matcher_.ShouldDisallowResourceLoad(
-          subresource_url, *document_origin_, subresource_type,
-          activation_state_.generic_blocking_rules_disabled)) {
+  if (ShouldDisallowResourceLoad(subresource_url, subresource_type)) {
     ++statistics_.num_loads_matching_rules;
     if (activation_state_.activation_level == ActivationLevel::ENABLED) {
       ++statistics_.num_loads_disallowed;
@@ -77,6 +82,13 @@ LoadPolicy DocumentSubresourceFilter::GetLoadPolicy(
   return LoadPolicy::ALLOW;
 }
 
+void DocumentSubresourceFilter::set_activation_state(
+    const ActivationState& state) {
+  activation_state_ = state;
+  load_decision_cache_.Clear();
+  cached_url_bytes_ = 0;
+}
+
 const url_pattern_index::flat::UrlRule*
 DocumentSubresourceFilter::FindMatchingUrlRule(
     const GURL& subresource_url,
@@ -91,4 +103,35 @@ DocumentSubresourceFilter::FindMatchingUrlRule(
       activation_state_.generic_blocking_rules_disabled);
 }
 
+bool DocumentSubresourceFilter::ShouldDisallowResourceLoad(
+    const GURL& subresource_url,
+    url_pattern_index::proto::ElementType subresource_type) {
+  DCHECK(document_origin_);
+  const std::string& spec = subresource_url.possibly_invalid_spec();
+  if (spec.size() > kMaxCachedLoadDecisionBytes) {
+    return ruleset_matcher_.ShouldDisallowResourceLoad(
+        subresource_url, *document_origin_, subresource_type,
+        activation_state_.generic_blocking_rules_disabled);
+  }
+
+  const LoadDecisionKey key(spec, subresource_type);
+  auto it = load_decision_cache_.Get(key);
+  if (it != load_decision_cache_.end())
+    return it->second;
+
+  // Make room for the new entry, evicting the least recently used ones.
+  while (!load_decision_cache_.empty() &&
+         (load_decision_cache_.size() >= kMaxCachedLoadDecisions ||
+          cached_url_bytes_ + spec.size() > kMaxCachedLoadDecisionBytes)) {
+    cached_url_bytes_ -= load_decision_cache_.rbegin()->first.first.size();
+    load_decision_cache_.ShrinkToSize(load_decision_cache_.size() - 1);
+  }
+  cached_url_bytes_ += spec.size();
+  return load_decision_cache_
+      .Put(key, ruleset_matcher_.ShouldDisallowResourceLoad(
+                    subresource_url, *document_origin_, subresource_type,
+                    activation_state_.generic_blocking_rules_disabled))
+      ->second;
+}
+
 }  // namespace subresource_filter
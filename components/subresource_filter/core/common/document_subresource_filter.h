@@ -8,8 +8,11 @@
 #include <stddef.h>
 
 #include <memory>
+#include <string>
+#include <utility>
 #include <vector>
 
+#include "base/containers/mru_cache.h"
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
 #include "components/subresource_filter/core/common/activation_level.h"
@@ -64,11 +67,22 @@ class DocumentSubresourceFilter {
 
   // Called if the DocumentSubresourceFilter needs to change how it filters
   // subresources.
-  void set_activation_state(const ActivationState& state) {
-    activation_state_ = state;
+  void set_activation_state(const ActivationState& state);
+
+  size_t cached_load_decisions_for_testing() const {
+    return load_decision_cache_.size();
   }
 
  private:
+  using LoadDecisionKey =
+      std::pair<std::string, url_pattern_index::proto::ElementType>;
+
+  // Returns whether the ruleset disallows loading |subresource_url| as a
+  // |subresource_type| resource, from |load_decision_cache_| if possible.
+  bool ShouldDisallowResourceLoad(
+      const GURL& subresource_url,
+      url_pattern_index::proto::ElementType subresource_type);
+
   ActivationState activation_state_;
   const scoped_refptr<const MemoryMappedRuleset> ruleset_;
   const IndexedRulesetMatcher ruleset_matcher_;
@@ -78,6 +92,15 @@ class DocumentSubresourceFilter {
 
   DocumentLoadStatistics statistics_;
 
+  // Whether the ruleset disallows recently evaluated loads, most recent first.
+  // Documents often load the same tracker or pixel URL many times. The cache
+  // holds at most kMaxCachedLoadDecisions entries whose URLs take up at most
+  // kMaxCachedLoadDecisionBytes in total. The ruleset can't change during the
+  // lifetime of this filter, but the activation state can, so the cache is
+  // cleared when it does.
+  base::MRUCache<LoadDecisionKey, bool> load_decision_cache_;
+  size_t cached_url_bytes_ = 0;
+
   DISALLOW_COPY_AND_ASSIGN(DocumentSubresourceFilter);
 };
 
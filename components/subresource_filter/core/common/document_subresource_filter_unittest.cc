@@ -4,8 +4,11 @@
 
 #include "components/subresource_filter/core/common/document_subresource_filter.h"
 
+#include <string>
+
 #include "base/files/file.h"
 #include "base/macros.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/string_piece.h"
 #include "components/subresource_filter/core/common/memory_mapped_ruleset.h"
 #include "components/subresource_filter/core/common/test_ruleset_creator.h"
@@ -149,6 +152,53 @@ TEST_F(DocumentSubresourceFilterTest, Enabled) {
   test_impl(false /* measure_performance */);
 }
 
+TEST_F(DocumentSubresourceFilterTest, RepeatedLoadsUseCachedDecisions) {
+  ActivationState activation_state(kEnabled);
+  activation_state.measure_performance = false;
+  DocumentSubresourceFilter filter(url::Origin(), activation_state, ruleset());
+
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(LoadPolicy::DISALLOW,
+              filter.GetLoadPolicy(GURL(kTestAlphaURL), kImageType));
+    EXPECT_EQ(LoadPolicy::ALLOW,
+              filter.GetLoadPolicy(GURL(kTestBetaURL), kImageType));
+    EXPECT_EQ(LoadPolicy::DISALLOW,
+              filter.GetLoadPolicy(GURL(kTestAlphaURL), kSubdocumentType));
+  }
+  EXPECT_EQ(3u, filter.cached_load_decisions_for_testing());
+
+  const auto& statistics = filter.statistics();
+  EXPECT_EQ(9, statistics.num_loads_evaluated);
+  EXPECT_EQ(6, statistics.num_loads_matching_rules);
+  EXPECT_EQ(6, statistics.num_loads_disallowed);
+
+  // Cached decisions are dropped when the activation state changes, and the
+  // new state applies to repeated loads.
+  filter.set_activation_state(ActivationState(kDryRun));
+  EXPECT_EQ(0u, filter.cached_load_decisions_for_testing());
+  EXPECT_EQ(LoadPolicy::WOULD_DISALLOW,
+            filter.GetLoadPolicy(GURL(kTestAlphaURL), kImageType));
+}
+
+TEST_F(DocumentSubresourceFilterTest, LoadDecisionCacheIsBounded) {
+  ActivationState activation_state(kEnabled);
+  activation_state.measure_performance = false;
+  DocumentSubresourceFilter filter(url::Origin(), activation_state, ruleset());
+
+  for (int i = 0; i < 1000; ++i) {
+    const GURL url("http://example.com/" + base::IntToString(i) + "/" +
+                   std::string(100, 'x') + kTestAlphaURLPathSuffix);
+    EXPECT_EQ(LoadPolicy::DISALLOW, filter.GetLoadPolicy(url, kImageType));
+    EXPECT_LE(filter.cached_load_decisions_for_testing(), 64u);
+  }
+  EXPECT_GT(filter.cached_load_decisions_for_testing(), 0u);
+
+  // URLs too long to cache are still evaluated.
+  const GURL long_url("http://example.com/" + std::string(20 * 1024, 'x') +
+                      kTestAlphaURLPathSuffix);
+  EXPECT_EQ(LoadPolicy::DISALLOW, filter.GetLoadPolicy(long_url, kImageType));
+}
+
 TEST_F(DocumentSubresourceFilterTest, MatchingRuleEnabled) {
   ActivationState activation_state(kEnabled);
   activation_state.measure_performance = false;
@@ -8,20 +8,24 @@
 #include <sstream>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "base/files/file.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/files/scoped_temp_dir.h"
+#include "base/json/json_reader.h"
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/scoped_refptr.h"
 #include "base/path_service.h"
 #include "base/time/time.h"
 #include "base/timer/elapsed_timer.h"
+#include "base/values.h"
 #include "components/subresource_filter/core/common/memory_mapped_ruleset.h"
 #include "components/subresource_filter/tools/filter_tool.h"
 #include "components/subresource_filter/tools/indexing_tool.h"
+#include "components/url_pattern_index/fuzzy_pattern_matching.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/perf/perf_test.h"
 
@@ -111,4 +115,40 @@ TEST_F(IndexedRulesetPerftest, MatchAll) {
                          true /* important */);
 }
 
+TEST_F(IndexedRulesetPerftest, FindSubpatterns) {
+  // Subpatterns of the kinds found in filter lists, with and without separator
+  // placeholders.
+  const char* const kSubpatterns[] = {
+      "/ads/",  "^ad^",    "^banner^", "/pixel.gif^", ".js?",
+      "^track", "=video^", "/beacon",  "analytics.",  "doubleclick.net^",
+  };
+
+  std::vector<std::string> urls;
+  std::istringstream request_stream(requests());
+  std::string line;
+  while (std::getline(request_stream, line)) {
+    std::unique_ptr<base::Value> request = base::JSONReader::Read(line);
+    if (!request)
+      continue;
+    const base::Value* url = request->FindKey("request_url");
+    if (url && url->is_string())
+      urls.push_back(url->GetString());
+  }
+  ASSERT_FALSE(urls.empty());
+
+  std::vector<int64_t> results;
+  for (int i = 0; i < 5; ++i) {
+    base::ElapsedTimer timer;
+    for (const std::string& url : urls) {
+      for (const char* subpattern : kSubpatterns)
+        url_pattern_index::FindFuzzy(url, subpattern);
+    }
+    results.push_back(timer.Elapsed().InMicroseconds());
+  }
+  std::sort(results.begin(), results.end());
+  perf_test::PrintResult("median_find_subpatterns_time", "", "",
+                         static_cast<size_t>(results[2]), "microseconds",
+                         true /* important */);
+}
+
 }  // namespace subresource_filter
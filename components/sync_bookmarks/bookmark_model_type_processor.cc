@@ -6,6 +6,7 @@
 
 #include <utility>
 
+#include "base/bind.h"
 #include "base/callback.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/threading/thread_task_runner_handle.h"
@@ -125,6 +126,8 @@ class ScopedRemoteUpdateBookmarks {
 };
 }  // namespace
 
+const size_t BookmarkModelTypeProcessor::kMaxUpdatesPerBatch = 500;
+
 BookmarkModelTypeProcessor::BookmarkModelTypeProcessor(
     bookmarks::BookmarkModel* bookmark_model,
     BookmarkUndoService* bookmark_undo_service)
@@ -167,11 +170,24 @@ void BookmarkModelTypeProcessor::OnUpdateReceived(
     const syncer::UpdateResponseDataList& updates) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
+  // If updates are pending, a task to apply them is already posted.
+  const bool was_idle = pending_updates_.empty();
+  for (const syncer::UpdateResponseData* update : ReorderUpdates(updates))
+    pending_updates_.push_back(*update);
+  if (was_idle)
+    ProcessPendingUpdates();
+}
+
+void BookmarkModelTypeProcessor::ProcessPendingUpdates() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
   ScopedRemoteUpdateBookmarks update_bookmarks(bookmark_model_,
                                                bookmark_undo_service_);
 
-  for (const syncer::UpdateResponseData* update : ReorderUpdates(updates)) {
-    const syncer::EntityData& update_data = update->entity.value();
+  for (size_t i = 0; i < kMaxUpdatesPerBatch && !pending_updates_.empty();
+       ++i, pending_updates_.pop_front()) {
+    const syncer::EntityData& update_data =
+        pending_updates_.front().entity.value();
     // TODO(crbug.com/516866): Check |update_data| for sanity.
     // 1. Has bookmark specifics or no specifics in case of delete.
     // 2. All meta info entries in the specifics have unique keys.
@@ -192,6 +208,13 @@ void BookmarkModelTypeProcessor::OnUpdateReceived(
     }
     ProcessRemoteUpdate(update_data, tracked_entity);
   }
+
+  if (!pending_updates_.empty()) {
+    base::ThreadTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE,
+        base::BindOnce(&BookmarkModelTypeProcessor::ProcessPendingUpdates,
+                       weak_ptr_factory_.GetWeakPtr()));
+  }
 }
 
 // static
@@ -8,6 +8,7 @@
 #include <memory>
 #include <vector>
 
+#include "base/containers/circular_deque.h"
 #include "base/macros.h"
 #include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
@@ -51,6 +52,11 @@ class BookmarkModelTypeProcessor : public syncer::ModelTypeProcessor,
   void GetStatusCountersForDebugging(StatusCountersCallback callback) override;
   void RecordMemoryUsageHistogram() override;
 
+  // Maximum number of remote updates applied to the bookmark model in one
+  // task. Larger update lists, like the initial sync of big accounts, are
+  // applied over several tasks so that they don't block the UI thread.
+  static const size_t kMaxUpdatesPerBatch;
+
   // Public for testing.
   static std::vector<const syncer::UpdateResponseData*> ReorderUpdatesForTest(
       const syncer::UpdateResponseDataList& updates);
@@ -69,6 +75,10 @@ class BookmarkModelTypeProcessor : public syncer::ModelTypeProcessor,
   static std::vector<const syncer::UpdateResponseData*> ReorderUpdates(
       const syncer::UpdateResponseDataList& updates);
 
+  // Applies up to kMaxUpdatesPerBatch updates from |pending_updates_|, and
+  // posts a task to apply the next ones if any are left.
+  void ProcessPendingUpdates();
+
   // Given a remote update entity, it returns the parent bookmark node of the
   // corresponding node. It returns null if the parent node cannot be found.
   const bookmarks::BookmarkNode* GetParentNode(
@@ -125,6 +135,10 @@ class BookmarkModelTypeProcessor : public syncer::ModelTypeProcessor,
   // the metadata upon a local change until the commit configration is received.
   SyncedBookmarkTracker bookmark_tracker_;
 
+  // Remote updates, in the order returned by ReorderUpdates(), that haven't
+  // been applied yet. Their entity data is released as they are applied.
+  base::circular_deque<syncer::UpdateResponseData> pending_updates_;
+
   base::WeakPtrFactory<BookmarkModelTypeProcessor> weak_ptr_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(BookmarkModelTypeProcessor);
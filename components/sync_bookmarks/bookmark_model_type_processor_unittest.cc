@@ -6,6 +6,9 @@
 
 #include <string>
 
+#include "base/message_loop/message_loop.h"
+#include "base/run_loop.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
 #include "components/bookmarks/browser/bookmark_model.h"
 #include "components/bookmarks/test/test_bookmark_client.h"
@@ -135,6 +138,7 @@ class BookmarkModelTypeProcessorTest : public testing::Test {
   bookmarks::BookmarkModel* bookmark_model() { return bookmark_model_.get(); }
 
  private:
+  base::MessageLoop message_loop_;
   std::unique_ptr<bookmarks::BookmarkModel> bookmark_model_;
   TestSyncClient sync_client_;
 };
@@ -308,6 +312,41 @@ TEST_F(BookmarkModelTypeProcessorTest, ShouldUpdateModelAfterRemoteDelete) {
               Eq(ASCIIToUTF16(kTitle3)));
 }
 
+TEST_F(BookmarkModelTypeProcessorTest, ShouldApplyManyUpdatesInBatches) {
+  BookmarkModelTypeProcessor processor(
+      sync_client()->GetBookmarkModel(),
+      sync_client()->GetBookmarkUndoServiceIfExists());
+
+  syncer::UpdateResponseDataList updates;
+  updates.push_back(
+      CreateUpdateData({"bookmark_bar", std::string(), std::string(),
+                        kBookmarksRootId, kBookmarkBarTag}));
+  const size_t kNodeCount = BookmarkModelTypeProcessor::kMaxUpdatesPerBatch;
+  for (size_t i = 0; i < kNodeCount; ++i) {
+    updates.push_back(CreateUpdateData(
+        {"node" + base::NumberToString(i), "title", "http://www.url.com",
+         kBookmarkBarTag, /*server_tag=*/std::string()}));
+  }
+
+  processor.OnUpdateReceived(sync_pb::ModelTypeState(), updates);
+
+  // The first batch includes the permanent folder.
+  const bookmarks::BookmarkNode* bookmarkbar =
+      bookmark_model()->bookmark_bar_node();
+  EXPECT_THAT(bookmarkbar->child_count(), Eq(static_cast<int>(kNodeCount - 1)));
+
+  // Updates received meanwhile are applied after the pending ones.
+  updates.clear();
+  updates.push_back(CreateTombstone("node0"));
+  processor.OnUpdateReceived(sync_pb::ModelTypeState(), updates);
+  EXPECT_THAT(bookmarkbar->child_count(), Eq(static_cast<int>(kNodeCount - 1)));
+
+  base::RunLoop().RunUntilIdle();
+  EXPECT_THAT(bookmarkbar->child_count(), Eq(static_cast<int>(kNodeCount - 1)));
+  EXPECT_THAT(processor.GetTrackerForTest()->TrackedEntitiesCountForTest(),
+              Eq(kNodeCount));
+}
+
 }  // namespace
 
 }  // namespace sync_bookmarks
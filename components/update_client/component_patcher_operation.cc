@@ -20,6 +20,7 @@
 #include "components/update_client/update_client_errors.h"
 #include "components/update_client/utils.h"
 #include "courgette/courgette.h"
+#include "components/zucchini/zucchini.h"
 #include "courgette/third_party/bsdiff/bsdiff.h"
 
 namespace update_client {
@@ -32,12 +33,14 @@ const char kSha256[] = "sha256";
 // The integer offset disambiguates between overlapping error ranges.
 const int kCourgetteErrorOffset = 300;
 const int kBsdiffErrorOffset = 600;
+const int kZucchiniErrorOffset = 900;
 
 }  // namespace
 
 const char kOp[] = "op";
 const char kBsdiff[] = "bsdiff";
 const char kCourgette[] = "courgette";
+const char kZucchini[] = "zucchini";
 const char kInput[] = "input";
 const char kPatch[] = "patch";
 
@@ -47,7 +50,8 @@ DeltaUpdateOp* CreateDeltaUpdateOp(const std::string& operation,
     return new DeltaUpdateOpCopy();
   } else if (operation == "create") {
     return new DeltaUpdateOpCreate();
-  } else if (operation == "bsdiff" || operation == "courgette") {
+  } else if (operation == "bsdiff" || operation == "courgette" ||
+             operation == "zucchini") {
     return new DeltaUpdateOpPatch(operation, connector);
   }
   return nullptr;
@@ -165,7 +169,8 @@ void DeltaUpdateOpCreate::DoRun(ComponentPatcher::Callback callback) {
 DeltaUpdateOpPatch::DeltaUpdateOpPatch(const std::string& operation,
                                        service_manager::Connector* connector)
     : operation_(operation), connector_(connector) {
-  DCHECK(operation == kBsdiff || operation == kCourgette);
+  DCHECK(operation == kBsdiff || operation == kCourgette ||
+         operation == kZucchini);
 }
 
 DeltaUpdateOpPatch::~DeltaUpdateOpPatch() {
@@ -213,6 +218,13 @@ void DeltaUpdateOpPatch::DonePatching(ComponentPatcher::Callback callback,
       std::move(callback).Run(UnpackerError::kDeltaOperationFailure,
                               result + kCourgetteErrorOffset);
     }
+  } else if (operation_ == kZucchini) {
+    if (result == zucchini::status::kStatusSuccess) {
+      std::move(callback).Run(UnpackerError::kNone, 0);
+    } else {
+      std::move(callback).Run(UnpackerError::kDeltaOperationFailure,
+                              result + kZucchiniErrorOffset);
+    }
   } else {
     NOTREACHED();
   }
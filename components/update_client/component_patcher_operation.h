@@ -27,6 +27,7 @@ namespace update_client {
 extern const char kOp[];
 extern const char kBsdiff[];
 extern const char kCourgette[];
+extern const char kZucchini[];
 extern const char kInput[];
 extern const char kPatch[];
 
@@ -126,10 +127,10 @@ class DeltaUpdateOpCreate : public DeltaUpdateOp {
   DISALLOW_COPY_AND_ASSIGN(DeltaUpdateOpCreate);
 };
 
-// Both 'bsdiff' and 'courgette' operations take an existing file on disk,
-// and a bsdiff- or Courgette-format patch file provided in the delta update
-// package, and run bsdiff or Courgette to construct an output file in the
-// unpacking directory.
+// The 'bsdiff', 'courgette' and 'zucchini' operations take an existing file on
+// disk, and a bsdiff-, Courgette- or Zucchini-format patch file provided in the
+// delta update package, and run bsdiff, Courgette or Zucchini to construct an
+// output file in the unpacking directory.
 class DeltaUpdateOpPatch : public DeltaUpdateOp {
  public:
   DeltaUpdateOpPatch(const std::string& operation,
@@ -47,6 +47,10 @@ class Configurator : public base::RefCountedThreadSafe<Configurator> {
   // components.
   virtual int UpdateDelay() const = 0;
 
+  // The maximum number of components of an update whose updates are
+  // downloaded and applied at the same time.
+  virtual int MaxConcurrentUpdates() const = 0;
+
   // The URLs for the update checks. The URLs are tried in order, the first one
   // that succeeds wins.
   virtual std::vector<GURL> UpdateUrl() const = 0;
@@ -37,6 +37,7 @@ TestConfigurator::TestConfigurator()
       ondemand_time_(0),
       enabled_cup_signing_(false),
       enabled_component_updates_(true),
+      max_concurrent_updates_(1),
       context_(base::MakeRefCounted<net::TestURLRequestContextGetter>(
           base::ThreadTaskRunnerHandle::Get())) {
   service_manager::TestConnectorFactory::NameToServiceMap services;
@@ -68,6 +69,10 @@ int TestConfigurator::UpdateDelay() const {
   return 1;
 }
 
+int TestConfigurator::MaxConcurrentUpdates() const {
+  return max_concurrent_updates_;
+}
+
 std::vector<GURL> TestConfigurator::UpdateUrl() const {
   if (!update_check_url_.is_empty())
     return std::vector<GURL>(1, update_check_url_);
@@ -179,6 +184,10 @@ void TestConfigurator::SetAppGuid(const std::string& app_guid) {
   app_guid_ = app_guid;
 }
 
+void TestConfigurator::SetMaxConcurrentUpdates(int max_concurrent_updates) {
+  max_concurrent_updates_ = max_concurrent_updates;
+}
+
 PrefService* TestConfigurator::GetPrefService() const {
   return nullptr;
 }
@@ -4,6 +4,7 @@
 
 #include "components/update_client/update_engine.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 
@@ -12,6 +13,7 @@
 #include "base/location.h"
 #include "base/logging.h"
 #include "base/stl_util.h"
+#include "base/sys_info.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "components/prefs/pref_service.h"
 #include "components/update_client/component.h"
@@ -25,6 +27,32 @@
 
 namespace update_client {
 
+namespace {
+
+bool IsDownloadingState(ComponentState state) {
+  return state == ComponentState::kDownloadingDiff ||
+         state == ComponentState::kDownloading;
+}
+
+bool IsUnpackingState(ComponentState state) {
+  return state == ComponentState::kUpdatingDiff ||
+         state == ComponentState::kUpdating;
+}
+
+size_t GetMaxConcurrentUpdates(const Configurator& config) {
+  return std::max(config.MaxConcurrentUpdates(), 1);
+}
+
+// Unpacking, patching and installing are CPU bound, so fewer of them are run
+// at the same time than downloads.
+size_t GetMaxConcurrentUnpacks(const Configurator& config) {
+  const size_t max_unpacks =
+      std::max(base::SysInfo::NumberOfProcessors() / 2, 1);
+  return std::min(GetMaxConcurrentUpdates(config), max_unpacks);
+}
+
+}  // namespace
+
 UpdateContext::UpdateContext(
     scoped_refptr<Configurator> config,
     bool is_foreground,
@@ -293,6 +321,9 @@ void UpdateEngine::HandleComponent(
   auto& queue = update_context->component_queue;
 
   if (queue.empty()) {
+    if (!update_context->components_in_progress.empty())
+      return;
+
     const Error error = update_context->update_check_error
                             ? Error::UPDATE_CHECK_ERROR
                             : Error::NONE;
@@ -304,53 +335,127 @@ void UpdateEngine::HandleComponent(
     return;
   }
 
-  const auto& id = queue.front();
+  if (update_context->is_waiting_for_update_delay)
+    return;
+
+  while (!queue.empty() && update_context->components_in_progress.size() <
+                               GetMaxConcurrentUpdates(*config_)) {
+    const std::string id = queue.front();
+    DCHECK_EQ(1u, update_context->components.count(id));
+    const auto& component = update_context->components.at(id);
+    DCHECK(component);
+
+    auto& next_update_delay = update_context->next_update_delay;
+    if (!next_update_delay.is_zero() && component->IsUpdateAvailable()) {
+      update_context->is_waiting_for_update_delay = true;
+      base::ThreadTaskRunnerHandle::Get()->PostDelayedTask(
+          FROM_HERE,
+          base::BindOnce(&UpdateEngine::UpdateDelayElapsed,
+                         base::Unretained(this), update_context),
+          next_update_delay);
+      next_update_delay = base::TimeDelta();
+
+      notify_observers_callback_.Run(
+          UpdateClient::Observer::Events::COMPONENT_WAIT, id);
+      return;
+    }
+
+    queue.pop();
+    update_context->components_in_progress.insert(id);
+    HandleComponentState(update_context, id);
+  }
+}
+
+void UpdateEngine::UpdateDelayElapsed(
+    scoped_refptr<UpdateContext> update_context) {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  DCHECK(update_context);
+
+  update_context->is_waiting_for_update_delay = false;
+  HandleComponent(update_context);
+}
+
+void UpdateEngine::HandleComponentState(
+    scoped_refptr<UpdateContext> update_context,
+    const std::string& id) {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  DCHECK(update_context);
+
   DCHECK_EQ(1u, update_context->components.count(id));
   const auto& component = update_context->components.at(id);
   DCHECK(component);
 
-  auto& next_update_delay = update_context->next_update_delay;
-  if (!next_update_delay.is_zero() && component->IsUpdateAvailable()) {
-    base::ThreadTaskRunnerHandle::Get()->PostDelayedTask(
-        FROM_HERE,
-        base::BindOnce(&UpdateEngine::HandleComponent, base::Unretained(this),
-                       update_context),
-        next_update_delay);
-    next_update_delay = base::TimeDelta();
-
-    notify_observers_callback_.Run(
-        UpdateClient::Observer::Events::COMPONENT_WAIT, id);
-    return;
+  const ComponentState state = component->state();
+  if (IsDownloadingState(state)) {
+    if (num_downloads_ >= GetMaxConcurrentUpdates(*config_)) {
+      components_waiting_to_download_.push(std::make_pair(update_context, id));
+      return;
+    }
+    ++num_downloads_;
+  } else if (IsUnpackingState(state)) {
+    if (num_unpacks_ >= GetMaxConcurrentUnpacks(*config_)) {
+      components_waiting_to_unpack_.push(std::make_pair(update_context, id));
+      return;
+    }
+    ++num_unpacks_;
   }
 
   component->Handle(base::BindOnce(&UpdateEngine::HandleComponentComplete,
-                                   base::Unretained(this), update_context));
+                                   base::Unretained(this), update_context, id,
+                                   state));
 }
 
 void UpdateEngine::HandleComponentComplete(
-    scoped_refptr<UpdateContext> update_context) {
+    scoped_refptr<UpdateContext> update_context,
+    const std::string& id,
+    ComponentState handled_state) {
   DCHECK(thread_checker_.CalledOnValidThread());
   DCHECK(update_context);
 
-  auto& queue = update_context->component_queue;
-  DCHECK(!queue.empty());
+  // Release the slot used to handle |handled_state| to the next component
+  // waiting for it, if any.
+  WaitingComponents* waiting_components = nullptr;
+  if (IsDownloadingState(handled_state)) {
+    DCHECK_GT(num_downloads_, 0u);
+    --num_downloads_;
+    waiting_components = &components_waiting_to_download_;
+  } else if (IsUnpackingState(handled_state)) {
+    DCHECK_GT(num_unpacks_, 0u);
+    --num_unpacks_;
+    waiting_components = &components_waiting_to_unpack_;
+  }
+  if (waiting_components && !waiting_components->empty()) {
+    base::ThreadTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE,
+        base::BindOnce(&UpdateEngine::HandleComponentState,
+                       base::Unretained(this),
+                       waiting_components->front().first,
+                       waiting_components->front().second));
+    waiting_components->pop();
+  }
 
-  const auto& id = queue.front();
   DCHECK_EQ(1u, update_context->components.count(id));
   const auto& component = update_context->components.at(id);
   DCHECK(component);
 
-  if (component->IsHandled()) {
-    update_context->next_update_delay = component->GetUpdateDuration();
+  if (!component->IsHandled()) {
+    base::ThreadTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE,
+        base::BindOnce(&UpdateEngine::HandleComponentState,
+                       base::Unretained(this), update_context, id));
+    return;
+  }
 
-    if (!component->events().empty()) {
-      ping_manager_->SendPing(*component,
-                              base::BindOnce([](int, const std::string&) {}));
-    }
+  update_context->next_update_delay = component->GetUpdateDuration();
 
-    queue.pop();
+  if (!component->events().empty()) {
+    ping_manager_->SendPing(*component,
+                            base::BindOnce([](int, const std::string&) {}));
   }
 
+  const auto num_erased = update_context->components_in_progress.erase(id);
+  DCHECK_EQ(1u, num_erased);
+
   base::ThreadTaskRunnerHandle::Get()->PostTask(
       FROM_HERE, base::BindOnce(&UpdateEngine::HandleComponent,
                                 base::Unretained(this), update_context));
@@ -8,7 +8,9 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "base/callback.h"
@@ -35,8 +37,11 @@ class Configurator;
 struct UpdateContext;
 
 // Handles updates for a group of components. Updates for different groups
-// are run concurrently but within the same group of components, updates are
-// applied one at a time.
+// are run concurrently. Within the same group of components, up to
+// Configurator::MaxConcurrentUpdates() updates are applied at a time. Across
+// all groups, the number of concurrent downloads is bounded by the same
+// value, and the number of concurrent unpacking and patching operations is
+// bounded by the number of processors as well.
 class UpdateEngine : public base::RefCounted<UpdateEngine> {
  public:
   using Callback = base::OnceCallback<void(Error error)>;
@@ -89,8 +94,20 @@ class UpdateEngine : public base::RefCounted<UpdateEngine> {
       int error,
       int retry_after_sec);
 
+  // Starts handling the components queued in |update_context| as long as
+  // fewer than MaxConcurrentUpdates() of them are in progress, or completes
+  // the update once all of them have been handled.
   void HandleComponent(scoped_refptr<UpdateContext> update_context);
-  void HandleComponentComplete(scoped_refptr<UpdateContext> update_context);
+  void UpdateDelayElapsed(scoped_refptr<UpdateContext> update_context);
+
+  // Handles the current state of the component |id|, unless the download or
+  // unpacking budget is used up, in which case the component waits for
+  // another component to release it.
+  void HandleComponentState(scoped_refptr<UpdateContext> update_context,
+                            const std::string& id);
+  void HandleComponentComplete(scoped_refptr<UpdateContext> update_context,
+                               const std::string& id,
+                               ComponentState handled_state);
 
   // Returns true if the update engine rejects this update call because it
   // occurs too soon.
@@ -109,6 +126,16 @@ class UpdateEngine : public base::RefCounted<UpdateEngine> {
   // Contains the contexts associated with each update in progress.
   UpdateContexts update_contexts_;
 
+  // The number of components which are downloading or unpacking their
+  // update, and the components which wait for a download or an unpacking
+  // slot, in order.
+  using WaitingComponents =
+      base::queue<std::pair<scoped_refptr<UpdateContext>, std::string>>;
+  size_t num_downloads_ = 0;
+  size_t num_unpacks_ = 0;
+  WaitingComponents components_waiting_to_download_;
+  WaitingComponents components_waiting_to_unpack_;
+
   // Implements a rate limiting mechanism for background update checks. Has the
   // effect of rejecting the update call if the update call occurs before
   // a certain time, which is negotiated with the server as part of the
@@ -177,11 +204,19 @@ struct UpdateContext : public base::RefCounted<UpdateContext> {
   // Contains the ids of the components that the state machine must handle.
   base::queue<std::string> component_queue;
 
+  // Contains the ids of the components taken from |component_queue| which
+  // have not been handled completely yet.
+  std::set<std::string> components_in_progress;
+
+  // True while the component at the front of |component_queue| waits for
+  // |next_update_delay| to elapse.
+  bool is_waiting_for_update_delay = false;
+
   // The time to wait before handling the update for a component.
   // The wait time is proportional with the cost incurred by updating
   // the component. The more time it takes to download and apply the
-  // update for the current component, the longer the wait until the engine
-  // is handling the next component in the queue.
+  // update for the last handled component, the longer the wait until the
+  // engine is handling the next component in the queue.
   base::TimeDelta next_update_delay;
 
   // The unique session id of this context. The session id is serialized in
@@ -4,6 +4,8 @@
 
 #include "components/url_pattern_index/fuzzy_pattern_matching.h"
 
+#include <string.h>
+
 #include <algorithm>
 
 namespace url_pattern_index {
@@ -13,13 +15,20 @@ namespace {
 bool StartsWithFuzzyImpl(base::StringPiece text, base::StringPiece subpattern) {
   DCHECK_LE(subpattern.size(), text.size());
 
-  for (size_t i = 0; i != subpattern.size(); ++i) {
-    const char text_char = text[i];
-    const char pattern_char = subpattern[i];
-    if (text_char != pattern_char &&
-        (pattern_char != kSeparatorPlaceholder || !IsSeparator(text_char))) {
+  // Compare the runs of characters between placeholders with memcmp(), which
+  // is vectorized, and check the placeholders one by one.
+  size_t i = 0;
+  while (i != subpattern.size()) {
+    size_t placeholder = subpattern.find(kSeparatorPlaceholder, i);
+    if (placeholder == base::StringPiece::npos)
+      placeholder = subpattern.size();
+    if (memcmp(text.data() + i, subpattern.data() + i, placeholder - i) != 0)
       return false;
-    }
+    if (placeholder == subpattern.size())
+      break;
+    if (!IsSeparator(text[placeholder]))
+      return false;
+    i = placeholder + 1;
   }
   return true;
 }
@@ -44,7 +53,29 @@ size_t FindFuzzy(base::StringPiece text,
     return base::StringPiece::npos;
   if (subpattern.empty())
     return from;
+  if (subpattern.size() > text.size() - from)
+    return base::StringPiece::npos;
+
+  // Find candidate positions by looking for a character of the |subpattern|
+  // that has to occur as is with memchr(), which is vectorized, and only then
+  // compare the whole |subpattern|.
+  const size_t anchor = subpattern.find_first_not_of(kSeparatorPlaceholder);
+  if (anchor != base::StringPiece::npos) {
+    const char anchor_char = subpattern[anchor];
+    const size_t last_start = text.size() - subpattern.size();
+    for (size_t start = from; start <= last_start; ++start) {
+      const void* found = memchr(text.data() + start + anchor, anchor_char,
+                                 last_start - start + 1);
+      if (!found)
+        return base::StringPiece::npos;
+      start = static_cast<const char*>(found) - text.data() - anchor;
+      if (StartsWithFuzzyImpl(text.substr(start), subpattern))
+        return start;
+    }
+    return base::StringPiece::npos;
+  }
 
+  // The |subpattern| consists only of placeholders.
   auto fuzzy_compare = [](char text_char, char subpattern_char) {
     return text_char == subpattern_char ||
            (subpattern_char == kSeparatorPlaceholder && IsSeparator(text_char));
@@ -58,7 +58,9 @@ bool StartsWithFuzzy(base::StringPiece text, base::StringPiece subpattern);
 bool EndsWithFuzzy(base::StringPiece text, base::StringPiece subpattern);
 
 // Returns the position of the leftmost fuzzy occurrence of a |subpattern| in
-// the |text| starting no earlier than |from| the specified position.
+// the |text| starting no earlier than |from| the specified position. Also finds
+// exact occurrences of subpatterns without placeholders, faster than
+// StringPiece::find().
 size_t FindFuzzy(base::StringPiece text,
                  base::StringPiece subpattern,
                  size_t from = 0);
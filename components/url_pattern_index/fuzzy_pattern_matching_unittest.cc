@@ -86,6 +86,11 @@ TEST(SubresourceFilterFuzzyPatternMatchingTest, FindFuzzy) {
       {"a/a/a/a", "^a^a^a", {1}},
       {"a/a/a/a", "^a^a?a", std::vector<size_t>()},
       {"a/a/a/a", "?a?a?a", std::vector<size_t>()},
+
+      {"ab.cd/ab/cd", "ab^cd", {6}},
+      {"ab.cd/ab/cd", "^cd", {8}},
+      {"a//b/c", "^^", {1}},
+      {"a//b/c", "^^^", std::vector<size_t>()},
   };
 
   for (const auto& test_case : kTestCases) {
@@ -88,10 +88,7 @@ inline bool IsSubdomainAnchored(base::StringPiece url,
 size_t FindSubpattern(base::StringPiece text,
                       base::StringPiece subpattern,
                       size_t from = 0) {
-  const bool is_fuzzy =
-      (subpattern.find(kSeparatorPlaceholder) != base::StringPiece::npos);
-  return is_fuzzy ? FindFuzzy(text, subpattern, from)
-                  : text.find(subpattern, from);
+  return FindFuzzy(text, subpattern, from);
 }
 
 // Same as FindSubpattern(url, subpattern), but searches for an occurrence that
@@ -99,9 +96,6 @@ size_t FindSubpattern(base::StringPiece text,
 size_t FindSubdomainAnchoredSubpattern(base::StringPiece url,
                                        url::Component host,
                                        base::StringPiece subpattern) {
-  const bool is_fuzzy =
-      (subpattern.find(kSeparatorPlaceholder) != base::StringPiece::npos);
-
   // Any match found after the end of the host will be discarded, so just
   // avoid searching there for the subpattern to begin with.
   //
@@ -121,8 +115,7 @@ size_t FindSubdomainAnchoredSubpattern(base::StringPiece url,
     // searches for |subpattern|.
     DCHECK(IsSubdomainAnchored(url, host, position));
 
-    position = is_fuzzy ? FindFuzzy(url_match_candidate, subpattern, position)
-                        : url_match_candidate.find(subpattern, position);
+    position = FindSubpattern(url_match_candidate, subpattern, position);
     if (position == base::StringPiece::npos ||
         IsSubdomainAnchored(url, host, position)) {
       return position;
@@ -40,30 +40,33 @@ bool VisitedLinkCommon::IsVisited(const GURL& url) const {
 }
 
 bool VisitedLinkCommon::IsVisited(Fingerprint fingerprint) const {
+  if (!hash_table_ || table_length_ <= 0)
+    return false;
+
   // Go through the table until we find the item or an empty spot (meaning it
-  // wasn't found). This loop will terminate as long as the table isn't full,
-  // which should be enforced by AddFingerprint.
-  Hash first_hash = HashFingerprint(fingerprint);
-  Hash cur_hash = first_hash;
-  while (true) {
-    Fingerprint cur_fingerprint = FingerprintAt(cur_hash);
-    if (cur_fingerprint == null_fingerprint_)
+  // wasn't found). The probe sequence is a run of consecutive slots, so it is
+  // scanned directly from the first hash to the end of the table, and then
+  // from the start of the table if it wraps around.
+  const Fingerprint* table_begin = hash_table_;
+  const Fingerprint* table_end = hash_table_ + table_length_;
+  const Fingerprint* first = table_begin + HashFingerprint(fingerprint);
+  for (const Fingerprint* cur = first; cur != table_end; ++cur) {
+    if (*cur == null_fingerprint_)
       return false;  // End of probe sequence found.
-    if (cur_fingerprint == fingerprint)
+    if (*cur == fingerprint)
       return true;  // Found a match.
-
-    // This spot was taken, but not by the item we're looking for, search in
-    // the next position.
-    cur_hash++;
-    if (cur_hash == table_length_)
-      cur_hash = 0;
-    if (cur_hash == first_hash) {
-      // Wrapped around and didn't find an empty space, this means we're in an
-      // infinite loop because AddFingerprint didn't do its job resizing.
-      NOTREACHED();
+  }
+  for (const Fingerprint* cur = table_begin; cur != first; ++cur) {
+    if (*cur == null_fingerprint_)
       return false;
-    }
+    if (*cur == fingerprint)
+      return true;
   }
+
+  // Wrapped around and didn't find an empty space, this means
+  // AddFingerprint didn't do its job resizing.
+  NOTREACHED();
+  return false;
 }
 
 // Uses the top 64 bits of the MD5 sum of the canonical URL as the fingerprint,
@@ -139,6 +139,36 @@ TEST_F(VisitedLink, TestAddAndQuery) {
   CheckVisited(master, unadded_prefix, 0, add_count);
 }
 
+// Tests how long lookups take in a large table, which is what renderers do for
+// every link they style. URL fingerprints are computed up front so that only
+// the table probes are timed.
+TEST_F(VisitedLink, TestLookupLargeTable) {
+  VisitedLinkMaster master(new DummyVisitedLinkEventListener(), nullptr, false,
+                           true, db_path_, 0);
+  ASSERT_TRUE(master.Init());
+  content::RunAllTasksUntilIdle();
+  FillTable(master, added_prefix, 0, load_test_add_count);
+
+  std::vector<VisitedLinkCommon::Fingerprint> fingerprints;
+  for (const char* prefix : {added_prefix, unadded_prefix}) {
+    for (int i = 0; i < load_test_add_count; i++) {
+      const std::string spec = TestURL(prefix, i).spec();
+      fingerprints.push_back(
+          master.ComputeURLFingerprint(spec.data(), spec.size()));
+    }
+  }
+
+  const int kIterations = 10;
+  int visited = 0;
+  TimeLogger timer("Visited_link_lookup_large_table");
+  for (int iteration = 0; iteration < kIterations; iteration++) {
+    for (VisitedLinkCommon::Fingerprint fingerprint : fingerprints)
+      visited += master.IsVisited(fingerprint);
+  }
+  timer.Done();
+  EXPECT_EQ(kIterations * load_test_add_count, visited);
+}
+
 // Tests how long it takes to write and read a large database to and from disk.
 // Flaky, see crbug.com/822308.
 TEST_F(VisitedLink, DISABLED_TestLoad) {
@@ -14,6 +14,7 @@
 #include "base/metrics/histogram_macros.h"
 #include "base/numerics/safe_conversions.h"
 #include "base/stl_util.h"
+#include "base/timer/elapsed_timer.h"
 #include "base/trace_event/trace_event.h"
 #include "cc/base/math_util.h"
 #include "cc/paint/filter_operations.h"
@@ -285,6 +286,7 @@ void DirectRenderer::DrawFrame(RenderPassList* render_passes_in_draw_order,
 
   // Attempt to replace some or all of the quads of the root render pass with
   // overlays.
+  base::ElapsedTimer overlay_timer;
   overlay_processor_->ProcessForOverlays(
       resource_provider_, render_passes_in_draw_order,
       output_surface_->color_matrix(), render_pass_filters_,
@@ -293,6 +295,7 @@ void DirectRenderer::DrawFrame(RenderPassList* render_passes_in_draw_order,
       &current_frame()->dc_layer_overlay_list,
       &current_frame()->root_damage_rect,
       &current_frame()->root_content_bounds);
+  last_overlay_processing_time_ = overlay_timer.Elapsed();
 
   // Draw all non-root render passes except for the root render pass.
   for (const auto& pass : *render_passes_in_draw_order) {
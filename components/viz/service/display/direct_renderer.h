@@ -12,6 +12,7 @@
 #include "base/containers/circular_deque.h"
 #include "base/containers/flat_map.h"
 #include "base/macros.h"
+#include "base/time/time.h"
 #include "components/viz/common/quads/tile_draw_quad.h"
 #include "components/viz/service/display/ca_layer_overlay.h"
 #include "components/viz/service/display/dc_layer_overlay.h"
@@ -53,6 +54,11 @@ class VIZ_SERVICE_EXPORT DirectRenderer {
 
   bool use_partial_swap() const { return use_partial_swap_; }
 
+  // The time the last DrawFrame spent deciding which quads become overlays.
+  base::TimeDelta last_overlay_processing_time() const {
+    return last_overlay_processing_time_;
+  }
+
   void SetVisible(bool visible);
   void DecideRenderPassAllocationsForFrame(
       const RenderPassList& render_passes_in_draw_order);
@@ -259,6 +265,7 @@ class VIZ_SERVICE_EXPORT DirectRenderer {
   bool overdraw_feedback_support_missing_logged_once_ = false;
 #endif
   gfx::Size enlarge_pass_texture_amount_;
+  base::TimeDelta last_overlay_processing_time_;
 
   // The current drawing frame is valid only during the duration of the
   // DrawFrame function. Use the accessor current_frame() to ensure that use
@@ -4,11 +4,16 @@
 
 #include "components/viz/service/display/display.h"
 
+#include <inttypes.h>
 #include <stddef.h>
 #include <limits>
+#include <utility>
+#include <vector>
 
+#include "base/containers/flat_set.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/numerics/checked_math.h"
+#include "base/strings/stringprintf.h"
 #include "base/timer/elapsed_timer.h"
 #include "base/trace_event/trace_event.h"
 #include "cc/base/math_util.h"
@@ -18,6 +23,7 @@
 #include "components/viz/common/frame_sinks/begin_frame_source.h"
 #include "components/viz/common/quads/compositor_frame.h"
 #include "components/viz/common/quads/draw_quad.h"
+#include "components/viz/common/quads/render_pass_draw_quad.h"
 #include "components/viz/common/quads/shared_quad_state.h"
 #include "components/viz/service/display/direct_renderer.h"
 #include "components/viz/service/display/display_client.h"
@@ -273,12 +279,16 @@ bool Display::DrawAndSwap() {
     return false;
   }
 
+  base::ElapsedTimer total_timer;
+  FrameTimings timings;
+
   base::ElapsedTimer aggregate_timer;
   CompositorFrame frame = aggregator_->Aggregate(
       current_surface_id_, scheduler_ ? scheduler_->current_frame_display_time()
                                       : base::TimeTicks::Now());
+  timings.aggregate = aggregate_timer.Elapsed();
   UMA_HISTOGRAM_COUNTS_1M("Compositing.SurfaceAggregator.AggregateUs",
-                          aggregate_timer.Elapsed().InMicroseconds());
+                          timings.aggregate.InMicroseconds());
 
   if (frame.render_pass_list.empty()) {
     TRACE_EVENT_INSTANT0("viz", "Empty aggregated frame.",
@@ -331,9 +341,10 @@ bool Display::DrawAndSwap() {
     if (settings_.enable_draw_occlusion) {
       base::ElapsedTimer draw_occlusion_timer;
       RemoveOverdrawQuads(&frame);
+      timings.occlusion = draw_occlusion_timer.Elapsed();
       UMA_HISTOGRAM_COUNTS_1000(
           "Compositing.Display.Draw.Occlusion.Calculation.Time",
-          draw_occlusion_timer.Elapsed().InMicroseconds());
+          timings.occlusion.InMicroseconds());
     }
 
     bool disable_image_filtering =
@@ -350,12 +361,14 @@ bool Display::DrawAndSwap() {
     renderer_->DecideRenderPassAllocationsForFrame(frame.render_pass_list);
     renderer_->DrawFrame(&frame.render_pass_list, device_scale_factor_,
                          current_surface_size_);
+    timings.draw = draw_timer.Elapsed();
+    timings.overlay_processing = renderer_->last_overlay_processing_time();
     if (software_renderer_) {
       UMA_HISTOGRAM_COUNTS_1M("Compositing.DirectRenderer.Software.DrawFrameUs",
-                              draw_timer.Elapsed().InMicroseconds());
+                              timings.draw.InMicroseconds());
     } else {
       UMA_HISTOGRAM_COUNTS_1M("Compositing.DirectRenderer.GL.DrawFrameUs",
-                              draw_timer.Elapsed().InMicroseconds());
+                              timings.draw.InMicroseconds());
     }
   } else {
     TRACE_EVENT_INSTANT0("viz", "Draw skipped.", TRACE_EVENT_SCOPE_THREAD);
@@ -388,8 +401,10 @@ bool Display::DrawAndSwap() {
                                                  "Display::DrawAndSwap");
 
     cc::benchmark_instrumentation::IssueDisplayRenderingStatsEvent();
+    base::ElapsedTimer swap_timer;
     renderer_->SwapBuffers(std::move(frame.metadata.latency_info),
                            need_presentation_feedback);
+    timings.swap = swap_timer.Elapsed();
     if (scheduler_)
       scheduler_->DidSwapBuffers();
   } else {
@@ -426,6 +441,10 @@ bool Display::DrawAndSwap() {
 
   client_->DisplayDidDrawAndSwap();
 
+  timings.total = total_timer.Elapsed();
+  last_frame_timings_ = timings;
+  ReportFrameTimings(should_draw);
+
   // Garbage collection can lead to sync IPCs to the GPU service to verify sync
   // tokens. We defer garbage collection until the end of DrawAndSwap to avoid
   // stalling the critical path for compositing.
@@ -434,6 +453,34 @@ bool Display::DrawAndSwap() {
   return true;
 }
 
+void Display::ReportFrameTimings(bool drawn) {
+  const FrameTimings& timings = last_frame_timings_;
+  TRACE_EVENT_INSTANT2(
+      "viz", "Display::FrameTimings", TRACE_EVENT_SCOPE_THREAD, "drawn", drawn,
+      "timings_us",
+      base::StringPrintf("aggregate=%" PRId64 " occlusion=%" PRId64
+                         " overlays=%" PRId64 " draw=%" PRId64
+                         " swap=%" PRId64 " total=%" PRId64,
+                         timings.aggregate.InMicroseconds(),
+                         timings.occlusion.InMicroseconds(),
+                         timings.overlay_processing.InMicroseconds(),
+                         timings.draw.InMicroseconds(),
+                         timings.swap.InMicroseconds(),
+                         timings.total.InMicroseconds()));
+  TRACE_COUNTER1(TRACE_DISABLED_BY_DEFAULT("viz.frame_timing"),
+                 "DrawAndSwap Us", timings.total.InMicroseconds());
+
+  // Skipped frames would swamp the phase histograms with zeros.
+  if (!drawn)
+    return;
+  UMA_HISTOGRAM_COUNTS_1M("Compositing.Display.OverlayProcessingUs",
+                          timings.overlay_processing.InMicroseconds());
+  UMA_HISTOGRAM_COUNTS_1M("Compositing.Display.SwapBuffersUs",
+                          timings.swap.InMicroseconds());
+  UMA_HISTOGRAM_COUNTS_1M("Compositing.Display.DrawAndSwapUs",
+                          timings.total.InMicroseconds());
+}
+
 void Display::DidReceiveSwapBuffersAck() {
   if (scheduler_)
     scheduler_->DidReceiveSwapBuffersAck();
@@ -571,9 +618,6 @@ void Display::RemoveOverdrawQuads(CompositorFrame* frame) {
   if (frame->render_pass_list.empty())
     return;
 
-  const SharedQuadState* last_sqs = nullptr;
-  cc::SimpleEnclosedRegion occlusion_in_target_space;
-  bool current_sqs_intersects_occlusion = false;
   int minimum_draw_occlusion_height =
       settings_.kMinimumDrawOcclusionSize.height() * device_scale_factor_;
   int minimum_draw_occlusion_width =
@@ -585,33 +629,42 @@ void Display::RemoveOverdrawQuads(CompositorFrame* frame) {
   // Total area not draw skipped by draw occlusion.
   base::CheckedNumeric<uint64_t> total_area_saved_in_px = 0;
 
+  // Background filters read what is drawn behind the quads of their pass,
+  // including the parts that are covered later.
+  std::vector<RenderPassId> background_filter_pass_ids;
   for (const auto& pass : frame->render_pass_list) {
-    // TODO(yiyix): Add filter effects to draw occlusion calculation and perform
-    // draw occlusion on render pass.
-    if (!pass->filters.IsEmpty() || !pass->background_filters.IsEmpty()) {
-      for (auto* const quad : pass->quad_list) {
-        total_quad_area_shown_wo_occlusion_px +=
-            quad->visible_rect.size().GetCheckedArea();
-      }
-      continue;
-    }
-
-    // TODO(yiyix): Perform draw occlusion inside the render pass with
-    // transparent background.
-    if (pass != frame->render_pass_list.back()) {
-      for (auto* const quad : pass->quad_list) {
-        total_quad_area_shown_wo_occlusion_px +=
-            quad->visible_rect.size().GetCheckedArea();
-      }
-      continue;
-    }
+    if (!pass->background_filters.IsEmpty())
+      background_filter_pass_ids.push_back(pass->id);
+  }
+  base::flat_set<RenderPassId> background_filter_passes(
+      std::move(background_filter_pass_ids), base::KEEP_FIRST_OF_DUPES);
 
+  // Every pass is drawn to its own target before any filter is applied to it,
+  // so quads that are covered within their pass are never seen, whichever
+  // surfaces they came from.
+  for (const auto& pass : frame->render_pass_list) {
+    const SharedQuadState* last_sqs = nullptr;
+    cc::SimpleEnclosedRegion occlusion_in_target_space;
+    bool current_sqs_intersects_occlusion = false;
     auto quad_list_end = pass->quad_list.end();
     gfx::Rect occlusion_in_quad_content_space;
     for (auto quad = pass->quad_list.begin(); quad != quad_list_end;) {
       total_quad_area_shown_wo_occlusion_px +=
           quad->visible_rect.size().GetCheckedArea();
 
+      // Quads behind a pass with background filters can't be removed, as the
+      // filters may read them. Only quads in front of it occlude them.
+      if (quad->material == ContentDrawQuadBase::Material::RENDER_PASS &&
+          background_filter_passes.count(
+              RenderPassDrawQuad::MaterialCast(*quad)->render_pass_id)) {
+        last_sqs = nullptr;
+        occlusion_in_target_space = cc::SimpleEnclosedRegion();
+        current_sqs_intersects_occlusion = false;
+        occlusion_in_quad_content_space = gfx::Rect();
+        ++quad;
+        continue;
+      }
+
       // Skip quad if it is a RenderPassDrawQuad because RenderPassDrawQuad is a
       // special type of DrawQuad where the visible_rect of shared quad state is
       // not entirely covered by draw quads in it; or the DrawQuad size is
@@ -634,6 +687,7 @@ void Display::RemoveOverdrawQuads(CompositorFrame* frame) {
       // TODO(yiyix): Find a rect interior to each transformed quad.
       if (last_sqs != quad->shared_quad_state) {
         if (last_sqs->opacity == 1 && last_sqs->are_contents_opaque &&
+            last_sqs->blend_mode == SkBlendMode::kSrcOver &&
             last_sqs->quad_to_target_transform.Preserves2dAxisAlignment()) {
           gfx::Rect sqs_rect_in_target =
               cc::MathUtil::MapEnclosedRectWith2dAxisAlignedTransform(
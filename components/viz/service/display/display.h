@@ -12,6 +12,7 @@
 #include "base/macros.h"
 #include "base/observer_list.h"
 #include "base/single_thread_task_runner.h"
+#include "base/time/time.h"
 #include "components/viz/common/frame_sinks/begin_frame_source.h"
 #include "components/viz/common/gpu/context_lost_observer.h"
 #include "components/viz/common/resources/returned_resource.h"
@@ -59,6 +60,17 @@ class VIZ_SERVICE_EXPORT Display : public DisplaySchedulerClient,
                                    public LatestLocalSurfaceIdLookupDelegate,
                                    public SoftwareOutputDeviceClient {
  public:
+  // The CPU time spent in each phase of the last DrawAndSwap that produced a
+  // frame. Phases that were skipped are zero.
+  struct FrameTimings {
+    base::TimeDelta aggregate;
+    base::TimeDelta occlusion;
+    base::TimeDelta overlay_processing;
+    base::TimeDelta draw;
+    base::TimeDelta swap;
+    base::TimeDelta total;
+  };
+
   // The |begin_frame_source| and |scheduler| may be null (together). In that
   // case, DrawAndSwap must be called externally when needed.
   // The |current_task_runner| may be null if the Display is on a thread without
@@ -127,6 +139,7 @@ class VIZ_SERVICE_EXPORT Display : public DisplaySchedulerClient,
 
   bool has_scheduler() const { return !!scheduler_; }
   DirectRenderer* renderer_for_testing() const { return renderer_.get(); }
+  const FrameTimings& last_frame_timings() const { return last_frame_timings_; }
 
   void ForceImmediateDrawAndSwapIfPossible();
   void SetNeedsOneBeginFrame();
@@ -135,6 +148,7 @@ class VIZ_SERVICE_EXPORT Display : public DisplaySchedulerClient,
  private:
   void InitializeRenderer();
   void UpdateRootSurfaceResourcesLocked();
+  void ReportFrameTimings(bool drawn);
 
   // ContextLostObserver implementation.
   void OnContextLost() override;
@@ -165,6 +179,7 @@ class VIZ_SERVICE_EXPORT Display : public DisplaySchedulerClient,
   std::unique_ptr<DirectRenderer> renderer_;
   SoftwareRenderer* software_renderer_ = nullptr;
   std::vector<ui::LatencyInfo> stored_latency_info_;
+  FrameTimings last_frame_timings_;
 
   base::circular_deque<std::vector<Surface::PresentedCallback>>
       pending_presented_callbacks_;
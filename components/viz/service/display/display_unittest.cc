@@ -653,6 +653,51 @@ TEST_F(DisplayTest, ContextLossInformsClient) {
   TearDownDisplay();
 }
 
+// Each phase of a DrawAndSwap should be accounted for in the frame timings,
+// and phases that were skipped should be reported as taking no time.
+TEST_F(DisplayTest, FrameTimings) {
+  SetUpSoftwareDisplay(RendererSettings());
+
+  StubDisplayClient client;
+  display_->Initialize(&client, manager_.surface_manager());
+  display_->SetLocalSurfaceId(id_allocator_.GenerateId(), 1.f);
+  display_->Resize(gfx::Size(100, 100));
+
+  RenderPassList pass_list;
+  auto pass = RenderPass::Create();
+  pass->output_rect = gfx::Rect(0, 0, 100, 100);
+  pass->damage_rect = gfx::Rect(0, 0, 100, 100);
+  pass->id = 1u;
+  pass_list.push_back(std::move(pass));
+  SubmitCompositorFrame(&pass_list, id_allocator_.GetCurrentLocalSurfaceId());
+
+  display_->DrawAndSwap();
+  EXPECT_EQ(1u, output_surface_->num_sent_frames());
+  Display::FrameTimings timings = display_->last_frame_timings();
+  EXPECT_GE(timings.draw, timings.overlay_processing);
+  EXPECT_GE(timings.total,
+            timings.aggregate + timings.occlusion + timings.draw +
+                timings.swap);
+
+  // A frame without damage is neither drawn nor swapped.
+  pass = RenderPass::Create();
+  pass->output_rect = gfx::Rect(0, 0, 100, 100);
+  pass->id = 1u;
+  pass_list.push_back(std::move(pass));
+  SubmitCompositorFrame(&pass_list, id_allocator_.GetCurrentLocalSurfaceId());
+
+  display_->DrawAndSwap();
+  EXPECT_EQ(1u, output_surface_->num_sent_frames());
+  timings = display_->last_frame_timings();
+  EXPECT_TRUE(timings.occlusion.is_zero());
+  EXPECT_TRUE(timings.overlay_processing.is_zero());
+  EXPECT_TRUE(timings.draw.is_zero());
+  EXPECT_TRUE(timings.swap.is_zero());
+  EXPECT_GE(timings.total, timings.aggregate);
+
+  TearDownDisplay();
+}
+
 // Regression test for https://crbug.com/727162: Submitting a CompositorFrame to
 // a surface should only cause damage on the Display the surface belongs to.
 // There should not be a side-effect on other Displays.
@@ -2543,6 +2588,121 @@ TEST_F(DisplayTest, CompositorFrameWithCoveredRenderPass) {
   TearDownDisplay();
 }
 
+// Quads are removed when covered within a non-root RenderPass, but not by
+// quads that don't replace what is behind them.
+TEST_F(DisplayTest, CompositorFrameWithOcclusionInNonRootRenderPass) {
+  RendererSettings settings;
+  settings.kMinimumDrawOcclusionSize.set_width(0);
+  SetUpGpuDisplay(settings);
+
+  StubDisplayClient client;
+  display_->Initialize(&client, manager_.surface_manager());
+
+  CompositorFrame frame = MakeDefaultCompositorFrame();
+  gfx::Rect rect1(0, 0, 100, 100);
+  gfx::Rect rect2(10, 10, 50, 50);
+
+  std::unique_ptr<RenderPass> child_pass = RenderPass::Create();
+  child_pass->SetNew(2, rect1, rect1, gfx::Transform());
+  frame.render_pass_list.insert(frame.render_pass_list.begin(),
+                                std::move(child_pass));
+  RenderPass* child = frame.render_pass_list.front().get();
+  RenderPass* root = frame.render_pass_list.back().get();
+
+  bool is_clipped = false;
+  bool opaque_content = true;
+  float opacity = 1.f;
+
+  SharedQuadState* shared_quad_state = child->CreateAndAppendSharedQuadState();
+  auto* quad = child->quad_list.AllocateAndConstruct<SolidColorDrawQuad>();
+  SharedQuadState* shared_quad_state2 = child->CreateAndAppendSharedQuadState();
+  auto* quad2 = child->quad_list.AllocateAndConstruct<SolidColorDrawQuad>();
+  SharedQuadState* shared_quad_state3 = root->CreateAndAppendSharedQuadState();
+  auto* quad3 = root->quad_list.AllocateAndConstruct<SolidColorDrawQuad>();
+  SharedQuadState* shared_quad_state4 = root->CreateAndAppendSharedQuadState();
+  auto* quad4 = root->quad_list.AllocateAndConstruct<SolidColorDrawQuad>();
+
+  shared_quad_state->SetAll(gfx::Transform(), rect1, rect1, rect1, is_clipped,
+                            opaque_content, opacity, SkBlendMode::kSrcOver, 0);
+  shared_quad_state2->SetAll(gfx::Transform(), rect2, rect2, rect2, is_clipped,
+                             opaque_content, opacity, SkBlendMode::kSrcOver, 0);
+  shared_quad_state3->SetAll(gfx::Transform(), rect1, rect1, rect1, is_clipped,
+                             opaque_content, opacity, SkBlendMode::kMultiply,
+                             0);
+  shared_quad_state4->SetAll(gfx::Transform(), rect2, rect2, rect2, is_clipped,
+                             opaque_content, opacity, SkBlendMode::kSrcOver, 0);
+  quad->SetNew(shared_quad_state, rect1, rect1, SK_ColorBLACK, false);
+  quad2->SetNew(shared_quad_state2, rect2, rect2, SK_ColorBLACK, false);
+  quad3->SetNew(shared_quad_state3, rect1, rect1, SK_ColorBLACK, false);
+  quad4->SetNew(shared_quad_state4, rect2, rect2, SK_ColorBLACK, false);
+  display_->RemoveOverdrawQuads(&frame);
+
+  // |quad2| is covered by |quad| in the child pass. |quad4| is blended with
+  // |quad3|, so it is kept.
+  ASSERT_EQ(1u, child->quad_list.size());
+  EXPECT_EQ(rect1.ToString(),
+            child->quad_list.ElementAt(0)->visible_rect.ToString());
+  ASSERT_EQ(2u, root->quad_list.size());
+  EXPECT_EQ(rect2.ToString(),
+            root->quad_list.ElementAt(1)->visible_rect.ToString());
+
+  TearDownDisplay();
+}
+
+// Quads behind a RenderPassDrawQuad whose pass has background filters are
+// read by the filters, so they are not occluded by quads in front of it.
+TEST_F(DisplayTest, CompositorFrameWithBackgroundFilterRenderPass) {
+  RendererSettings settings;
+  settings.kMinimumDrawOcclusionSize.set_width(0);
+  SetUpGpuDisplay(settings);
+
+  StubDisplayClient client;
+  display_->Initialize(&client, manager_.surface_manager());
+
+  CompositorFrame frame = MakeDefaultCompositorFrame();
+  gfx::Rect rect1(0, 0, 100, 100);
+  gfx::Rect rect2(10, 10, 50, 50);
+  RenderPassId filter_pass_id = 2;
+
+  std::unique_ptr<RenderPass> filter_pass = RenderPass::Create();
+  filter_pass->SetNew(filter_pass_id, rect2, rect2, gfx::Transform());
+  filter_pass->background_filters.Append(
+      cc::FilterOperation::CreateBlurFilter(5.f));
+  frame.render_pass_list.insert(frame.render_pass_list.begin(),
+                                std::move(filter_pass));
+  RenderPass* root = frame.render_pass_list.back().get();
+
+  bool is_clipped = false;
+  bool opaque_content = true;
+  float opacity = 1.f;
+
+  SharedQuadState* shared_quad_state = root->CreateAndAppendSharedQuadState();
+  auto* quad = root->quad_list.AllocateAndConstruct<SolidColorDrawQuad>();
+  SharedQuadState* shared_quad_state2 = root->CreateAndAppendSharedQuadState();
+  auto* quad2 = root->quad_list.AllocateAndConstruct<RenderPassDrawQuad>();
+  SharedQuadState* shared_quad_state3 = root->CreateAndAppendSharedQuadState();
+  auto* quad3 = root->quad_list.AllocateAndConstruct<SolidColorDrawQuad>();
+
+  shared_quad_state->SetAll(gfx::Transform(), rect1, rect1, rect1, is_clipped,
+                            opaque_content, opacity, SkBlendMode::kSrcOver, 0);
+  shared_quad_state2->SetAll(gfx::Transform(), rect2, rect2, rect2, is_clipped,
+                             false, opacity, SkBlendMode::kSrcOver, 0);
+  shared_quad_state3->SetAll(gfx::Transform(), rect2, rect2, rect2, is_clipped,
+                             opaque_content, opacity, SkBlendMode::kSrcOver, 0);
+  quad->SetNew(shared_quad_state, rect1, rect1, SK_ColorBLACK, false);
+  quad2->SetNew(shared_quad_state2, rect2, rect2, filter_pass_id, 0,
+                gfx::RectF(), gfx::Size(), gfx::Vector2dF(1, 1), gfx::PointF(),
+                gfx::RectF(), false);
+  quad3->SetNew(shared_quad_state3, rect2, rect2, SK_ColorBLACK, false);
+  display_->RemoveOverdrawQuads(&frame);
+
+  ASSERT_EQ(3u, root->quad_list.size());
+  EXPECT_EQ(rect2.ToString(),
+            root->quad_list.ElementAt(2)->visible_rect.ToString());
+
+  TearDownDisplay();
+}
+
 TEST_F(DisplayTest, CompositorFrameWithClip) {
   RendererSettings settings;
   settings.kMinimumDrawOcclusionSize.set_width(0);
@@ -21,6 +21,7 @@
 #include "base/logging.h"
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
+#include "base/metrics/histogram_macros.h"
 #include "base/strings/string_split.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
@@ -333,6 +334,7 @@ GLRenderer::GLRenderer(
   use_blend_equation_advanced_coherent_ =
       context_caps.blend_equation_advanced_coherent;
   use_occlusion_query_ = context_caps.occlusion_query;
+  use_timer_query_ = context_caps.timer_queries;
   use_swap_with_bounds_ = context_caps.swap_buffers_with_bounds;
 
   InitializeSharedObjects();
@@ -441,6 +443,12 @@ void GLRenderer::ClearFramebuffer() {
 void GLRenderer::BeginDrawingFrame() {
   TRACE_EVENT0("viz", "GLRenderer::BeginDrawingFrame");
 
+  if (use_timer_query_) {
+    DCHECK(!gpu_timer_query_);
+    gl_->GenQueriesEXT(1, &gpu_timer_query_);
+    gl_->BeginQueryEXT(GL_TIME_ELAPSED_EXT, gpu_timer_query_);
+  }
+
   scoped_refptr<ResourceFence> read_lock_fence;
   if (use_sync_query_) {
     read_lock_fence = sync_queries_.StartNewFrame();
@@ -2487,6 +2495,15 @@ void GLRenderer::FinishDrawingFrame() {
 
   TRACE_COUNTER1(TRACE_DISABLED_BY_DEFAULT("viz.triangles"), "Triangles Drawn",
                  num_triangles_drawn_);
+
+  if (gpu_timer_query_) {
+    gl_->EndQueryEXT(GL_TIME_ELAPSED_EXT);
+    context_support_->SignalQuery(
+        gpu_timer_query_,
+        base::Bind(&GLRenderer::ProcessGpuTimerQuery,
+                   weak_ptr_factory_.GetWeakPtr(), gpu_timer_query_));
+    gpu_timer_query_ = 0;
+  }
 }
 
 void GLRenderer::FinishDrawingQuadList() {
@@ -3592,6 +3609,25 @@ void GLRenderer::ProcessOverdrawFeedback(std::vector<int>* overdraw,
           max_result);
 }
 
+void GLRenderer::ProcessGpuTimerQuery(unsigned query) {
+  GLuint64 elapsed_ns = 0;
+  gl_->GetQueryObjectui64vEXT(query, GL_QUERY_RESULT_EXT, &elapsed_ns);
+  gl_->DeleteQueriesEXT(1, &query);
+
+  // A disjoint operation, such as a power state change, makes the timings of
+  // any query that was active meanwhile meaningless.
+  GLint disjoint = 0;
+  gl_->GetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+  if (disjoint)
+    return;
+
+  int64_t elapsed_us = elapsed_ns / base::Time::kNanosecondsPerMicrosecond;
+  UMA_HISTOGRAM_COUNTS_1M("Compositing.DirectRenderer.GL.GpuDrawFrameUs",
+                          elapsed_us);
+  TRACE_COUNTER1(TRACE_DISABLED_BY_DEFAULT("viz.gpu_timing"),
+                 "GPU DrawFrame Us", elapsed_us);
+}
+
 void GLRenderer::UpdateRenderPassTextures(
     const RenderPassList& render_passes_in_draw_order,
     const base::flat_map<RenderPassId, RenderPassRequirements>&
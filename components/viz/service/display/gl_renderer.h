@@ -311,6 +311,9 @@ class VIZ_SERVICE_EXPORT GLRenderer : public DirectRenderer {
                                unsigned query,
                                int multiplier);
 
+  // Reports the GPU time spent drawing a frame, measured by the timer |query|.
+  void ProcessGpuTimerQuery(unsigned query);
+
   ResourceFormat BackbufferFormat() const;
 
   // A map from RenderPass id to the texture used to draw the RenderPass from.
@@ -383,7 +386,10 @@ class VIZ_SERVICE_EXPORT GLRenderer : public DirectRenderer {
   bool use_blend_equation_advanced_ = false;
   bool use_blend_equation_advanced_coherent_ = false;
   bool use_occlusion_query_ = false;
+  bool use_timer_query_ = false;
   bool use_swap_with_bounds_ = false;
+  // The GL_TIME_ELAPSED_EXT query bracketing the current frame, if any.
+  unsigned gpu_timer_query_ = 0;
 
   // If true, tints all the composited content to red.
   bool tint_gl_composited_content_ = true;
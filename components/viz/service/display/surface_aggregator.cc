@@ -103,6 +103,10 @@ SurfaceAggregator::PrewalkResult::PrewalkResult() {}
 
 SurfaceAggregator::PrewalkResult::~PrewalkResult() {}
 
+SurfaceAggregator::CachedSurfacePasses::CachedSurfacePasses() = default;
+
+SurfaceAggregator::CachedSurfacePasses::~CachedSurfacePasses() = default;
+
 // Create a clip rect for an aggregated quad from the original clip rect and
 // the clip rect from the surface it's on.
 SurfaceAggregator::ClipData SurfaceAggregator::CalculateClipRect(
@@ -131,6 +135,9 @@ SurfaceAggregator::ClipData SurfaceAggregator::CalculateClipRect(
 RenderPassId SurfaceAggregator::RemapPassId(RenderPassId surface_local_pass_id,
                                             const SurfaceId& surface_id) {
   auto key = std::make_pair(surface_id, surface_local_pass_id);
+  for (CachedSurfacePasses* cached_passes : recording_surface_passes_)
+    cached_passes->remapped_pass_ids.push_back(key);
+
   auto it = render_pass_allocator_map_.find(key);
   if (it != render_pass_allocator_map_.end()) {
     it->second.in_use = true;
@@ -338,10 +345,33 @@ void SurfaceAggregator::EmitSurfaceContent(
       base::IsApproximatelyEqual(source_sqs->opacity, 1.f, kOpacityEpsilon) &&
       copy_requests.empty() && combined_transform.Preserves2dAxisAlignment();
 
+  gfx::Transform surface_transform_to_root_target = combined_transform;
+  surface_transform_to_root_target.ConcatTransform(
+      dest_pass->transform_to_root_target);
+
+  // The passes of a surface drawn with a RenderPassDrawQuad only depend on its
+  // transform while neither it nor the surfaces it draws change, unless quads
+  // outside the root damage rect are dropped.
+  bool cache_passes = !merge_pass && copy_requests.empty() &&
+                      !aggregate_only_damaged_ && !has_copy_requests_ &&
+                      unchanged_surfaces_.count(surface_id);
+  bool reused_cached_passes =
+      cache_passes &&
+      AppendCachedSurfacePasses(surface_id, surface_transform_to_root_target);
+  std::unique_ptr<CachedSurfacePasses> cached_passes;
+  if (cache_passes && !reused_cached_passes) {
+    cached_passes = std::make_unique<CachedSurfacePasses>();
+    cached_passes->transform_to_root_target = surface_transform_to_root_target;
+    cached_passes->output_is_secure = output_is_secure_;
+    recording_surface_passes_.push_back(cached_passes.get());
+  }
+
   const RenderPassList& referenced_passes = render_pass_list;
   // TODO(fsamuel): Move this to a separate helper function.
   size_t passes_to_copy =
       merge_pass ? referenced_passes.size() - 1 : referenced_passes.size();
+  if (reused_cached_passes)
+    passes_to_copy = 0;
   for (size_t j = 0; j < passes_to_copy; ++j) {
     const RenderPass& source = *referenced_passes[j];
 
@@ -375,26 +405,13 @@ void SurfaceAggregator::EmitSurfaceContent(
                     child_to_parent_map, gfx::Transform(), ClipData(),
                     copy_pass.get(), surface_id);
 
-    // If the render pass has copy requests, or should be cached, or has
-    // moving-pixel filters, or in a moving-pixel surface, we should damage the
-    // whole output rect so that we always drawn the full content. Otherwise, we
-    // might have incompleted copy request, or cached patially drawn render
-    // pass.
-    if (!copy_request_passes_.count(remapped_pass_id) &&
-        !copy_pass->cache_render_pass &&
-        !moved_pixel_passes_.count(remapped_pass_id)) {
-      gfx::Transform inverse_transform(gfx::Transform::kSkipInitialization);
-      if (copy_pass->transform_to_root_target.GetInverse(&inverse_transform)) {
-        gfx::Rect damage_rect_in_render_pass_space =
-            cc::MathUtil::ProjectEnclosingClippedRect(inverse_transform,
-                                                      root_damage_rect_);
-        copy_pass->damage_rect.Intersect(damage_rect_in_render_pass_space);
-      }
-    }
+    AppendAggregatedPass(std::move(copy_pass));
+  }
 
-    if (copy_pass->has_damage_from_contributing_content)
-      contributing_content_damaged_passes_.insert(copy_pass->id);
-    dest_pass_list_->push_back(std::move(copy_pass));
+  if (cached_passes) {
+    DCHECK_EQ(cached_passes.get(), recording_surface_passes_.back());
+    recording_surface_passes_.pop_back();
+    cached_surface_passes_[surface_id] = std::move(cached_passes);
   }
 
   gfx::Transform surface_transform = scaled_quad_to_target_transform;
@@ -789,27 +806,56 @@ void SurfaceAggregator::CopyPasses(const CompositorFrame& frame,
                     gfx::Transform(), ClipData(), copy_pass.get(),
                     surface->surface_id());
 
-    // If the render pass has copy requests, or should be cached, or has
-    // moving-pixel filters, or in a moving-pixel surface, we should damage the
-    // whole output rect so that we always drawn the full content. Otherwise, we
-    // might have incompleted copy request, or cached patially drawn render
-    // pass.
-    if (!copy_request_passes_.count(remapped_pass_id) &&
-        !copy_pass->cache_render_pass &&
-        !moved_pixel_passes_.count(remapped_pass_id)) {
-      gfx::Transform inverse_transform(gfx::Transform::kSkipInitialization);
-      if (copy_pass->transform_to_root_target.GetInverse(&inverse_transform)) {
-        gfx::Rect damage_rect_in_render_pass_space =
-            cc::MathUtil::ProjectEnclosingClippedRect(inverse_transform,
-                                                      root_damage_rect_);
-        copy_pass->damage_rect.Intersect(damage_rect_in_render_pass_space);
-      }
+    AppendAggregatedPass(std::move(copy_pass));
+  }
+}
+
+void SurfaceAggregator::AppendAggregatedPass(std::unique_ptr<RenderPass> pass) {
+  for (CachedSurfacePasses* cached_passes : recording_surface_passes_)
+    cached_passes->passes.push_back(pass->DeepCopy());
+
+  // If the render pass has copy requests, or should be cached, or has
+  // moving-pixel filters, or in a moving-pixel surface, we should damage the
+  // whole output rect so that we always drawn the full content. Otherwise, we
+  // might have incompleted copy request, or cached patially drawn render
+  // pass.
+  if (!copy_request_passes_.count(pass->id) && !pass->cache_render_pass &&
+      !moved_pixel_passes_.count(pass->id)) {
+    gfx::Transform inverse_transform(gfx::Transform::kSkipInitialization);
+    if (pass->transform_to_root_target.GetInverse(&inverse_transform)) {
+      gfx::Rect damage_rect_in_render_pass_space =
+          cc::MathUtil::ProjectEnclosingClippedRect(inverse_transform,
+                                                    root_damage_rect_);
+      pass->damage_rect.Intersect(damage_rect_in_render_pass_space);
     }
+  }
 
-    if (copy_pass->has_damage_from_contributing_content)
-      contributing_content_damaged_passes_.insert(copy_pass->id);
-    dest_pass_list_->push_back(std::move(copy_pass));
+  if (pass->has_damage_from_contributing_content)
+    contributing_content_damaged_passes_.insert(pass->id);
+  dest_pass_list_->push_back(std::move(pass));
+}
+
+bool SurfaceAggregator::AppendCachedSurfacePasses(
+    const SurfaceId& surface_id,
+    const gfx::Transform& transform_to_root_target) {
+  auto it = cached_surface_passes_.find(surface_id);
+  if (it == cached_surface_passes_.end())
+    return false;
+  CachedSurfacePasses* cached_passes = it->second.get();
+  if (cached_passes->transform_to_root_target != transform_to_root_target ||
+      cached_passes->output_is_secure != output_is_secure_) {
+    return false;
   }
+
+  TRACE_EVENT1("viz", "SurfaceAggregator::AppendCachedSurfacePasses",
+               "passes", cached_passes->passes.size());
+  cached_passes->in_use = true;
+  // Keep the pass ids mapped, and record them in enclosing cache entries.
+  for (const auto& key : cached_passes->remapped_pass_ids)
+    RemapPassId(key.second, key.first);
+  for (const auto& pass : cached_passes->passes)
+    AppendAggregatedPass(pass->DeepCopy());
+  return true;
 }
 
 void SurfaceAggregator::ProcessAddedAndRemovedSurfaces() {
@@ -983,6 +1029,10 @@ gfx::Rect SurfaceAggregator::PrewalkTree(Surface* surface,
   damage_rect =
       DamageRectForSurface(surface, *last_pass, last_pass->output_rect);
 
+  auto previous_it = previous_contained_surfaces_.find(surface->surface_id());
+  bool unchanged = previous_it != previous_contained_surfaces_.end() &&
+                   previous_it->second == surface->GetActiveFrameIndex();
+
   // Avoid infinite recursion by adding current surface to
   // referenced_surfaces_.
   referenced_surfaces_.insert(surface->surface_id());
@@ -990,6 +1040,7 @@ gfx::Rect SurfaceAggregator::PrewalkTree(Surface* surface,
     Surface* child_surface = manager_->GetSurfaceForId(surface_info.primary_id);
     gfx::Rect surface_damage;
     if (!child_surface || !child_surface->HasActiveFrame()) {
+      unchanged = false;
       // If the primary surface is not available then we assume the damage is
       // the full size of the SurfaceDrawQuad because we might need to introduce
       // gutter.
@@ -1025,6 +1076,8 @@ gfx::Rect SurfaceAggregator::PrewalkTree(Surface* surface,
             PrewalkTree(child_surface, surface_info.has_moved_pixels,
                         surface_info.parent_pass_id, will_draw, result));
       }
+      if (!unchanged_surfaces_.count(child_surface->surface_id()))
+        unchanged = false;
     }
 
     if (surface_damage.IsEmpty())
@@ -1076,6 +1129,8 @@ gfx::Rect SurfaceAggregator::PrewalkTree(Surface* surface,
 
   auto it = referenced_surfaces_.find(surface->surface_id());
   referenced_surfaces_.erase(it);
+  if (unchanged)
+    unchanged_surfaces_.insert(surface->surface_id());
   if (!damage_rect.IsEmpty() && frame.metadata.may_contain_video)
     result->may_contain_video = true;
 
@@ -1168,6 +1223,7 @@ CompositorFrame SurfaceAggregator::Aggregate(
   expected_display_time_ = expected_display_time;
 
   valid_surfaces_.clear();
+  unchanged_surfaces_.clear();
   has_cached_render_passes_ = false;
   PrewalkResult prewalk_result;
   root_damage_rect_ =
@@ -1199,6 +1255,18 @@ CompositorFrame SurfaceAggregator::Aggregate(
     }
   }
 
+  // Remove all cached passes that weren't used in the current frame.
+  DCHECK(recording_surface_passes_.empty());
+  for (auto it = cached_surface_passes_.begin();
+       it != cached_surface_passes_.end();) {
+    if (it->second->in_use) {
+      it->second->in_use = false;
+      it++;
+    } else {
+      it = cached_surface_passes_.erase(it);
+    }
+  }
+
   DCHECK(referenced_surfaces_.empty());
 
   if (dest_pass_list_->empty())
@@ -1245,6 +1313,8 @@ void SurfaceAggregator::ReleaseResources(const SurfaceId& surface_id) {
     provider_->DestroyChild(it->second);
     surface_id_to_resource_child_id_.erase(it);
   }
+  // Cached passes may refer to the released resources.
+  cached_surface_passes_.clear();
 }
 
 void SurfaceAggregator::SetFullDamageForSurface(const SurfaceId& surface_id) {
@@ -1264,6 +1334,8 @@ void SurfaceAggregator::SetOutputColorSpace(
   output_color_space_ = output_color_space.IsValid()
                             ? output_color_space
                             : gfx::ColorSpace::CreateSRGB();
+  // Cached passes were aggregated in the previous blending color space.
+  cached_surface_passes_.clear();
 }
 
 }  // namespace viz
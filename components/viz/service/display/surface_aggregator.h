@@ -7,6 +7,8 @@
 
 #include <memory>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "base/containers/flat_map.h"
 #include "base/containers/flat_set.h"
@@ -18,6 +20,7 @@
 #include "components/viz/common/surfaces/surface_id.h"
 #include "components/viz/service/viz_service_export.h"
 #include "ui/gfx/color_space.h"
+#include "ui/gfx/transform.h"
 
 namespace viz {
 class CompositorFrame;
@@ -80,6 +83,25 @@ class VIZ_SERVICE_EXPORT SurfaceAggregator {
     bool in_use = true;
   };
 
+  // The aggregated render passes of a surface that is drawn with a
+  // RenderPassDrawQuad, including those of the surfaces it embeds, kept so
+  // that they can be copied instead of aggregated again while none of these
+  // surfaces change.
+  struct CachedSurfacePasses {
+    CachedSurfacePasses();
+    ~CachedSurfacePasses();
+
+    // The transform the passes were aggregated with.
+    gfx::Transform transform_to_root_target;
+    bool output_is_secure = false;
+    // The passes, with their damage rects not yet clipped to the root damage.
+    RenderPassList passes;
+    // The (SurfaceId, RenderPass id) pairs remapped for the passes.
+    std::vector<std::pair<SurfaceId, RenderPassId>> remapped_pass_ids;
+    // This is true if the passes were used in the last aggregated frame.
+    bool in_use = true;
+  };
+
   struct SurfaceDrawQuadUmaStats {
     void Reset() {
       valid_surface = 0;
@@ -180,6 +202,16 @@ class VIZ_SERVICE_EXPORT SurfaceAggregator {
                         PrewalkResult* result);
   void CopyUndrawnSurfaces(PrewalkResult* prewalk);
   void CopyPasses(const CompositorFrame& frame, Surface* surface);
+
+  // Appends |pass| to the aggregated frame after clipping its damage rect to
+  // the root damage rect.
+  void AppendAggregatedPass(std::unique_ptr<RenderPass> pass);
+
+  // Appends copies of the passes cached for |surface_id| if they were
+  // aggregated with |transform_to_root_target|. Returns false otherwise.
+  bool AppendCachedSurfacePasses(
+      const SurfaceId& surface_id,
+      const gfx::Transform& transform_to_root_target);
   void AddColorConversionPass();
 
   // Remove Surfaces that were referenced before but aren't currently
@@ -223,6 +255,13 @@ class VIZ_SERVICE_EXPORT SurfaceAggregator {
 
   base::flat_map<SurfaceId, int> surface_id_to_resource_child_id_;
 
+  // The passes of surfaces that didn't change in the last aggregated frame.
+  // Only used when the passes don't depend on the root damage rect, that is
+  // when not aggregating only damaged quads. An entry is removed if it's not
+  // used for one output frame.
+  base::flat_map<SurfaceId, std::unique_ptr<CachedSurfacePasses>>
+      cached_surface_passes_;
+
   // The following state is only valid for the duration of one Aggregate call
   // and is only stored on the class to avoid having to pass through every
   // function call.
@@ -241,6 +280,14 @@ class VIZ_SERVICE_EXPORT SurfaceAggregator {
   // After surface validation, every Surface in this set is valid.
   base::flat_set<SurfaceId> valid_surfaces_;
 
+  // Every Surface in this set has the same active frame as in the last
+  // aggregation, and so do all the surfaces it draws.
+  base::flat_set<SurfaceId> unchanged_surfaces_;
+
+  // The cache entries being filled by the surfaces currently aggregated,
+  // innermost last. Every pass appended to the frame is added to each of them.
+  std::vector<CachedSurfacePasses*> recording_surface_passes_;
+
   // This is the pass list for the aggregated frame.
   RenderPassList* dest_pass_list_;
 
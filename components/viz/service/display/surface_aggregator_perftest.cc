@@ -18,6 +18,7 @@
 #include "components/viz/test/test_context_provider.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/perf/perf_test.h"
+#include "third_party/khronos/GLES2/gl2.h"
 
 namespace viz {
 namespace {
@@ -39,6 +40,115 @@ class SurfaceAggregatorPerfTest : public testing::Test {
         &shared_bitmap_manager_);
   }
 
+  void AddTextureQuads(RenderPass* pass,
+                       int num_textures,
+                       bool is_software,
+                       CompositorFrameBuilder* frame_builder) {
+    auto* sqs = pass->CreateAndAppendSharedQuadState();
+    for (int j = 0; j < num_textures; j++) {
+      TransferableResource resource;
+      if (!is_software) {
+        resource = TransferableResource::MakeGL(gpu::Mailbox::Generate(),
+                                                GL_LINEAR, GL_TEXTURE_2D,
+                                                gpu::SyncToken());
+      }
+      resource.id = j;
+      resource.is_software = is_software;
+      frame_builder->AddTransferableResource(resource);
+
+      auto* quad = pass->CreateAndAppendDrawQuad<TextureDrawQuad>();
+      const gfx::Rect rect(0, 0, 1, 2);
+      // Half of rects should be visible with partial damage.
+      gfx::Rect visible_rect =
+          j % 2 == 0 ? gfx::Rect(0, 0, 1, 2) : gfx::Rect(0, 1, 1, 1);
+      bool needs_blending = false;
+      bool premultiplied_alpha = false;
+      const gfx::PointF uv_top_left;
+      const gfx::PointF uv_bottom_right;
+      SkColor background_color = SK_ColorGREEN;
+      const float vertex_opacity[4] = {0.f, 0.f, 1.f, 1.f};
+      bool flipped = false;
+      bool nearest_neighbor = false;
+      quad->SetAll(sqs, rect, visible_rect, needs_blending, j, gfx::Size(),
+                   premultiplied_alpha, uv_top_left, uv_bottom_right,
+                   background_color, vertex_opacity, flipped,
+                   nearest_neighbor, false);
+    }
+  }
+
+  void SubmitTextureFrame(CompositorFrameSinkSupport* support,
+                          const LocalSurfaceId& local_surface_id,
+                          int num_textures) {
+    auto pass = RenderPass::Create();
+    pass->output_rect = gfx::Rect(0, 0, 1, 2);
+    pass->damage_rect = pass->output_rect;
+
+    CompositorFrameBuilder frame_builder;
+    AddTextureQuads(pass.get(), num_textures, false, &frame_builder);
+    frame_builder.AddRenderPass(std::move(pass));
+    support->SubmitCompositorFrame(local_surface_id, frame_builder.Build());
+  }
+
+  // Aggregates a root surface embedding |num_surfaces| translucent surfaces
+  // side by side, one of which submits a new frame each time, as happens on
+  // pages with many iframes or with video under UI.
+  void RunSiblingsTest(int num_surfaces,
+                       int num_textures,
+                       const std::string& name) {
+    std::vector<std::unique_ptr<CompositorFrameSinkSupport>> child_supports(
+        num_surfaces);
+    for (int i = 0; i < num_surfaces; i++) {
+      child_supports[i] = std::make_unique<CompositorFrameSinkSupport>(
+          nullptr, &manager_, FrameSinkId(1, i + 1), kIsChildRoot,
+          kNeedsSyncPoints);
+      SubmitTextureFrame(child_supports[i].get(),
+                         LocalSurfaceId(i + 1, kArbitraryToken), num_textures);
+    }
+    aggregator_ = std::make_unique<SurfaceAggregator>(
+        manager_.surface_manager(), resource_provider_.get(), false);
+
+    auto root_support = std::make_unique<CompositorFrameSinkSupport>(
+        nullptr, &manager_, FrameSinkId(1, num_surfaces + 1), kIsRoot,
+        kNeedsSyncPoints);
+    auto pass = RenderPass::Create();
+    pass->output_rect = gfx::Rect(0, 0, 100, 100);
+    pass->damage_rect = pass->output_rect;
+    for (int i = 0; i < num_surfaces; i++) {
+      auto* sqs = pass->CreateAndAppendSharedQuadState();
+      sqs->quad_to_target_transform.Translate(i, 0);
+      sqs->opacity = .5f;
+      auto* surface_quad = pass->CreateAndAppendDrawQuad<SurfaceDrawQuad>();
+      surface_quad->SetNew(sqs, gfx::Rect(0, 0, 1, 2), gfx::Rect(0, 0, 1, 2),
+                           SurfaceId(FrameSinkId(1, i + 1),
+                                     LocalSurfaceId(i + 1, kArbitraryToken)),
+                           base::nullopt, SK_ColorWHITE, false);
+    }
+    LocalSurfaceId root_local_surface_id(num_surfaces + 1, kArbitraryToken);
+    root_support->SubmitCompositorFrame(
+        root_local_surface_id,
+        CompositorFrameBuilder().AddRenderPass(std::move(pass)).Build());
+
+    base::TimeTicks next_fake_display_time =
+        base::TimeTicks() + base::TimeDelta::FromSeconds(1);
+    int changed_surface = 0;
+    timer_.Reset();
+    do {
+      SubmitTextureFrame(
+          child_supports[changed_surface].get(),
+          LocalSurfaceId(changed_surface + 1, kArbitraryToken), num_textures);
+      changed_surface = (changed_surface + 1) % num_surfaces;
+
+      CompositorFrame aggregated = aggregator_->Aggregate(
+          SurfaceId(root_support->frame_sink_id(), root_local_surface_id),
+          next_fake_display_time);
+      next_fake_display_time += BeginFrameArgs::DefaultInterval();
+      timer_.NextLap();
+    } while (!timer_.HasTimeLimitExpired());
+
+    perf_test::PrintResult("aggregator_speed", "", name, timer_.LapsPerSecond(),
+                           "runs/s", true);
+  }
+
   void RunTest(int num_surfaces,
                int num_textures,
                float opacity,
@@ -62,32 +172,8 @@ class SurfaceAggregatorPerfTest : public testing::Test {
 
       CompositorFrameBuilder frame_builder;
 
+      AddTextureQuads(pass.get(), num_textures, true, &frame_builder);
       auto* sqs = pass->CreateAndAppendSharedQuadState();
-      for (int j = 0; j < num_textures; j++) {
-        TransferableResource resource;
-        resource.id = j;
-        resource.is_software = true;
-        frame_builder.AddTransferableResource(resource);
-
-        auto* quad = pass->CreateAndAppendDrawQuad<TextureDrawQuad>();
-        const gfx::Rect rect(0, 0, 1, 2);
-        // Half of rects should be visible with partial damage.
-        gfx::Rect visible_rect =
-            j % 2 == 0 ? gfx::Rect(0, 0, 1, 2) : gfx::Rect(0, 1, 1, 1);
-        bool needs_blending = false;
-        bool premultiplied_alpha = false;
-        const gfx::PointF uv_top_left;
-        const gfx::PointF uv_bottom_right;
-        SkColor background_color = SK_ColorGREEN;
-        const float vertex_opacity[4] = {0.f, 0.f, 1.f, 1.f};
-        bool flipped = false;
-        bool nearest_neighbor = false;
-        quad->SetAll(sqs, rect, visible_rect, needs_blending, j, gfx::Size(),
-                     premultiplied_alpha, uv_top_left, uv_bottom_right,
-                     background_color, vertex_opacity, flipped,
-                     nearest_neighbor, false);
-      }
-      sqs = pass->CreateAndAppendSharedQuadState();
       sqs->opacity = opacity;
       if (i >= 1) {
         auto* surface_quad = pass->CreateAndAppendDrawQuad<SurfaceDrawQuad>();
@@ -181,5 +267,9 @@ TEST_F(SurfaceAggregatorPerfTest, FewSurfacesAggregateDamaged) {
   RunTest(3, 1000, 1.f, true, false, "few_surfaces_aggregate_damaged");
 }
 
+TEST_F(SurfaceAggregatorPerfTest, ManySiblingSurfacesOneChanged) {
+  RunSiblingsTest(20, 100, "many_sibling_surfaces_one_changed");
+}
+
 }  // namespace
 }  // namespace viz
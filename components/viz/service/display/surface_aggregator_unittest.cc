@@ -574,6 +574,102 @@ TEST_F(SurfaceAggregatorValidSurfaceTest, OpacityCopied) {
   }
 }
 
+// Tests that the passes of a surface drawn with a RenderPassDrawQuad are
+// reused while it doesn't change, and aggregated again when it or its
+// transform does.
+TEST_F(SurfaceAggregatorValidSurfaceTest, UnchangedSurfacePassesReused) {
+  auto embedded_support = std::make_unique<CompositorFrameSinkSupport>(
+      nullptr, &manager_, kArbitraryFrameSinkId1, kRootIsRoot,
+      kNeedsSyncPoints);
+  LocalSurfaceId embedded_local_surface_id = allocator_.GenerateId();
+  SurfaceId embedded_surface_id(embedded_support->frame_sink_id(),
+                                embedded_local_surface_id);
+  SurfaceId root_surface_id(support_->frame_sink_id(), root_local_surface_id_);
+  constexpr float device_scale_factor = 1.0f;
+
+  Quad embedded_quads[] = {Quad::SolidColorQuad(SK_ColorGREEN, gfx::Rect(5, 5)),
+                           Quad::SolidColorQuad(SK_ColorBLUE, gfx::Rect(5, 5))};
+  Pass embedded_passes[] = {
+      Pass(embedded_quads, base::size(embedded_quads), SurfaceSize())};
+  SubmitCompositorFrame(embedded_support.get(), embedded_passes,
+                        base::size(embedded_passes), embedded_local_surface_id,
+                        device_scale_factor);
+
+  gfx::Transform transform;
+  transform.Translate(2, 3);
+  Quad quads[] = {Quad::SurfaceQuad(embedded_surface_id, InvalidSurfaceId(),
+                                    SK_ColorWHITE, gfx::Rect(5, 5), .5f,
+                                    transform, false)};
+  Pass passes[] = {Pass(quads, base::size(quads), SurfaceSize())};
+  SubmitCompositorFrame(support_.get(), passes, base::size(passes),
+                        root_local_surface_id_, device_scale_factor);
+
+  // The passes are cached once the surface is unchanged, and reused after.
+  RenderPassId embedded_pass_id = 0;
+  for (int i = 0; i < 3; ++i) {
+    SCOPED_TRACE(base::StringPrintf("Frame %d", i));
+    CompositorFrame aggregated_frame = aggregator_.Aggregate(
+        root_surface_id, GetNextDisplayTimeAndIncrement());
+
+    const auto& render_pass_list = aggregated_frame.render_pass_list;
+    ASSERT_EQ(2u, render_pass_list.size());
+    const RenderPass* embedded_pass = render_pass_list[0].get();
+    if (i == 0)
+      embedded_pass_id = embedded_pass->id;
+    EXPECT_EQ(embedded_pass_id, embedded_pass->id);
+    EXPECT_EQ(transform, embedded_pass->transform_to_root_target);
+    ASSERT_EQ(2u, embedded_pass->quad_list.size());
+    EXPECT_EQ(SK_ColorGREEN, SolidColorDrawQuad::MaterialCast(
+                                 embedded_pass->quad_list.ElementAt(0))
+                                 ->color);
+    EXPECT_EQ(SK_ColorBLUE, SolidColorDrawQuad::MaterialCast(
+                                embedded_pass->quad_list.ElementAt(1))
+                                ->color);
+    EXPECT_EQ(embedded_pass_id,
+              RenderPassDrawQuad::MaterialCast(
+                  render_pass_list[1]->quad_list.front())
+                  ->render_pass_id);
+  }
+
+  // Moving the surface updates the transform of its passes.
+  transform.Translate(1, 1);
+  Quad moved_quads[] = {Quad::SurfaceQuad(embedded_surface_id,
+                                          InvalidSurfaceId(), SK_ColorWHITE,
+                                          gfx::Rect(5, 5), .5f, transform,
+                                          false)};
+  Pass moved_passes[] = {
+      Pass(moved_quads, base::size(moved_quads), SurfaceSize())};
+  SubmitCompositorFrame(support_.get(), moved_passes, base::size(moved_passes),
+                        root_local_surface_id_, device_scale_factor);
+  {
+    CompositorFrame aggregated_frame = aggregator_.Aggregate(
+        root_surface_id, GetNextDisplayTimeAndIncrement());
+    const auto& render_pass_list = aggregated_frame.render_pass_list;
+    ASSERT_EQ(2u, render_pass_list.size());
+    EXPECT_EQ(transform, render_pass_list[0]->transform_to_root_target);
+    EXPECT_EQ(2u, render_pass_list[0]->quad_list.size());
+  }
+
+  // A new frame for the surface replaces its passes.
+  Quad new_embedded_quads[] = {
+      Quad::SolidColorQuad(SK_ColorRED, gfx::Rect(5, 5))};
+  Pass new_embedded_passes[] = {Pass(
+      new_embedded_quads, base::size(new_embedded_quads), SurfaceSize())};
+  SubmitCompositorFrame(embedded_support.get(), new_embedded_passes,
+                        base::size(new_embedded_passes),
+                        embedded_local_surface_id, device_scale_factor);
+  {
+    CompositorFrame aggregated_frame = aggregator_.Aggregate(
+        root_surface_id, GetNextDisplayTimeAndIncrement());
+    const auto& render_pass_list = aggregated_frame.render_pass_list;
+    ASSERT_EQ(2u, render_pass_list.size());
+    ASSERT_EQ(1u, render_pass_list[0]->quad_list.size());
+    EXPECT_EQ(SK_ColorRED, SolidColorDrawQuad::MaterialCast(
+                               render_pass_list[0]->quad_list.front())
+                               ->color);
+  }
+}
+
 // Test that when surface is rotated and we need the render surface to apply the
 // clip, we would keep the render surface.
 TEST_F(SurfaceAggregatorValidSurfaceTest, RotatedClip) {
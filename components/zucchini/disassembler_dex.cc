@@ -16,6 +16,7 @@
 
 #include "base/bind.h"
 #include "base/callback.h"
+#include "base/lazy_instance.h"
 #include "base/logging.h"
 #include "base/numerics/safe_conversions.h"
 #include "base/optional.h"
@@ -193,6 +194,24 @@ class CodeItemParser {
 
 /******** InstructionParser ********/
 
+// Lookup table from opcode to DEX Instruction data. Built on first use; patch
+// generation may disassemble several elements concurrently, so a
+// base::LazyInstance is used rather than a function-local static.
+struct DalvikInstructionTable {
+  DalvikInstructionTable() {
+    std::fill(std::begin(instructions), std::end(instructions), nullptr);
+    for (const dex::Instruction& instr : dex::kByteCode) {
+      std::fill(instructions + instr.opcode,
+                instructions + instr.opcode + instr.variant, &instr);
+    }
+  }
+
+  const dex::Instruction* instructions[256];
+};
+
+base::LazyInstance<DalvikInstructionTable>::Leaky g_dalvik_instruction_table =
+    LAZY_INSTANCE_INITIALIZER;
+
 // A class that successively reads |code_item| for Dalvik instructions, which
 // are found at |insns|, spanning |insns_size| uint16_t "units". These units
 // store instructions followed by optional non-instruction "payload". Finding
@@ -206,21 +225,9 @@ class InstructionParser {
   };
 
   // Returns pointer to DEX Instruction data for |opcode|, or null if |opcode|
-  // is unknown. An internal initialize-on-first-use table is used for fast
-  // lookup.
+  // is unknown. An initialize-on-first-use table is used for fast lookup.
   const dex::Instruction* FindDalvikInstruction(uint8_t opcode) {
-    static bool is_init = false;
-    static const dex::Instruction* instruction_table[256];
-    if (!is_init) {
-      is_init = true;
-      std::fill(std::begin(instruction_table), std::end(instruction_table),
-                nullptr);
-      for (const dex::Instruction& instr : dex::kByteCode) {
-        std::fill(instruction_table + instr.opcode,
-                  instruction_table + instr.opcode + instr.variant, &instr);
-      }
-    }
-    return instruction_table[opcode];
+    return g_dalvik_instruction_table.Get().instructions[opcode];
   }
 
   InstructionParser() = default;
@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include <algorithm>
@@ -82,6 +83,31 @@ void TestGenApply(const std::string& old_filename,
                          patched_new_buffer.begin()));
 }
 
+// Returns the serialized ensemble patch from |old_filename| to |new_filename|
+// generated with |num_threads| threads, or an empty vector on failure.
+std::vector<uint8_t> GenerateEnsemblePatch(const std::string& old_filename,
+                                           const std::string& new_filename,
+                                           size_t num_threads) {
+  base::MemoryMappedFile old_file;
+  base::MemoryMappedFile new_file;
+  if (!old_file.Initialize(MakeTestPath(old_filename)) ||
+      !new_file.Initialize(MakeTestPath(new_filename))) {
+    return {};
+  }
+  ConstBufferView old_region(old_file.data(), old_file.length());
+  ConstBufferView new_region(new_file.data(), new_file.length());
+
+  EnsemblePatchWriter patch_writer(old_region, new_region);
+  if (GenerateEnsembleWithImposedMatches(old_region, new_region, "",
+                                         num_threads, &patch_writer) !=
+      status::kStatusSuccess) {
+    return {};
+  }
+  std::vector<uint8_t> patch_buffer(patch_writer.SerializedSize());
+  patch_writer.SerializeInto({patch_buffer.data(), patch_buffer.size()});
+  return patch_buffer;
+}
+
 TEST(EndToEndTest, GenApplyRaw) {
   TestGenApply("setup1.exe", "setup2.exe", true);
   TestGenApply("chrome64_1.exe", "chrome64_2.exe", true);
@@ -101,4 +127,12 @@ TEST(EndToEndTest, GenApplyCross) {
   TestGenApply("setup1.exe", "chrome64_1.exe", false);
 }
 
+TEST(EndToEndTest, GenMultiThreaded) {
+  std::vector<uint8_t> patch =
+      GenerateEnsemblePatch("chrome64_1.exe", "chrome64_2.exe", 1);
+  ASSERT_FALSE(patch.empty());
+  EXPECT_EQ(patch,
+            GenerateEnsemblePatch("chrome64_1.exe", "chrome64_2.exe", 4));
+}
+
 }  // namespace zucchini
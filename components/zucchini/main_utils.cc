@@ -65,7 +65,7 @@ struct Command {
 constexpr Command kCommands[] = {
     {"gen",
      "-gen <old_file> <new_file> <patch_file> [-raw] [-keep]"
-     " [-impose=#+#=#+#,#+#=#+#,...]",
+     " [-impose=#+#=#+#,#+#=#+#,...] [-threads=N]",
      3, &MainGen},
     {"apply", "-apply <old_file> <patch_file> <new_file> [-keep]", 3,
      &MainApply},
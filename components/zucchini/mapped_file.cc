@@ -4,14 +4,38 @@
 
 #include "components/zucchini/mapped_file.h"
 
+#include <stdint.h>
+
 #include <utility>
 
 #include "base/files/file_util.h"
 #include "base/logging.h"
 #include "build/build_config.h"
 
+#if defined(OS_POSIX)
+#include <sys/mman.h>
+
+#include "base/process/process_metrics.h"
+#endif
+
 namespace zucchini {
 
+namespace {
+
+#if defined(OS_POSIX)
+// Returns the start and size of the pages spanning [|first|, |last|), which
+// must lie within a mapping.
+std::pair<void*, size_t> GetPageSpan(const uint8_t* first,
+                                     const uint8_t* last) {
+  const uintptr_t page_mask = base::GetPageSize() - 1;
+  uintptr_t lo = reinterpret_cast<uintptr_t>(first) & ~page_mask;
+  uintptr_t hi = (reinterpret_cast<uintptr_t>(last) + page_mask) & ~page_mask;
+  return {reinterpret_cast<void*>(lo), hi - lo};
+}
+#endif  // defined(OS_POSIX)
+
+}  // namespace
+
 MappedFileReader::MappedFileReader(base::File&& file) {
   if (!file.IsValid()) {
     error_ = "Invalid file.";
@@ -22,6 +46,18 @@ MappedFileReader::MappedFileReader(base::File&& file) {
   }
 }
 
+void MappedFileReader::ReleaseRegion(BufferRegion region) {
+  if (HasError() || region.size == 0)
+    return;
+  DCHECK(region.FitsIn(length()));
+#if defined(OS_POSIX)
+  // Pages shared with neighbouring regions are simply faulted back in.
+  std::pair<void*, size_t> span =
+      GetPageSpan(data() + region.lo(), data() + region.hi());
+  madvise(span.first, span.second, MADV_DONTNEED);
+#endif  // defined(OS_POSIX)
+}
+
 MappedFileWriter::MappedFileWriter(const base::FilePath& file_path,
                                    base::File&& file,
                                    size_t length)
@@ -67,4 +103,18 @@ bool MappedFileWriter::Keep() {
   return true;
 }
 
+void MappedFileWriter::ReleaseRegion(BufferRegion region) {
+  if (HasError() || region.size == 0)
+    return;
+  DCHECK(region.FitsIn(length()));
+#if defined(OS_POSIX)
+  // The mapping is shared, so dropping pages keeps their contents in the page
+  // cache; writing them out first lets the kernel reclaim them right away.
+  std::pair<void*, size_t> span =
+      GetPageSpan(data() + region.lo(), data() + region.hi());
+  if (msync(span.first, span.second, MS_SYNC) == 0)
+    madvise(span.first, span.second, MADV_DONTNEED);
+#endif  // defined(OS_POSIX)
+}
+
 }  // namespace zucchini
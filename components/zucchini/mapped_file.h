@@ -32,6 +32,11 @@ class MappedFileReader {
   bool HasError() { return !error_.empty() || !buffer_.IsValid(); }
   const std::string& error() { return error_; }
 
+  // Hints that |region| won't be read again soon, so its pages may be dropped
+  // from memory. They are read back from the file if needed. No-op on
+  // platforms without madvise().
+  void ReleaseRegion(BufferRegion region);
+
  private:
   std::string error_;
   base::MemoryMappedFile buffer_;
@@ -62,6 +67,12 @@ class MappedFileWriter {
   // iff the operation succeeds.
   bool Keep();
 
+  // Writes |region| out to the file and drops its pages from memory, keeping
+  // resident memory bounded while a large file is written sequentially. The
+  // contents remain readable through data(). No-op on platforms without
+  // madvise().
+  void ReleaseRegion(BufferRegion region);
+
  private:
   enum OnCloseDeleteBehavior {
     kKeep,
@@ -4,6 +4,10 @@
 
 #include "components/zucchini/mapped_file.h"
 
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
 #include <utility>
 
 #include "base/files/file.h"
@@ -44,6 +48,27 @@ TEST_F(MappedFileWriterTest, Keep) {
   EXPECT_TRUE(base::PathExists(file_path_));
 }
 
+TEST_F(MappedFileWriterTest, ReleaseRegion) {
+  constexpr size_t kLength = 3 * 4096 + 100;
+  using base::File;
+  File file(file_path_, File::FLAG_CREATE_ALWAYS | File::FLAG_READ |
+                            File::FLAG_WRITE | File::FLAG_SHARE_DELETE |
+                            File::FLAG_CAN_DELETE_ON_CLOSE);
+  MappedFileWriter file_writer(file_path_, std::move(file), kLength);
+  ASSERT_FALSE(file_writer.HasError());
+
+  // Write and release the file in unaligned chunks, as Apply() does.
+  for (size_t lo = 0; lo < kLength; lo += 1000) {
+    BufferRegion region = {lo, std::min<size_t>(1000, kLength - lo)};
+    for (size_t i = region.lo(); i < region.hi(); ++i)
+      file_writer.data()[i] = static_cast<uint8_t>(i * 7);
+    file_writer.ReleaseRegion(region);
+  }
+  EXPECT_FALSE(file_writer.HasError());
+  for (size_t i = 0; i < kLength; ++i)
+    ASSERT_EQ(static_cast<uint8_t>(i * 7), file_writer.data()[i]) << i;
+}
+
 TEST_F(MappedFileWriterTest, DeleteOnClose) {
   EXPECT_FALSE(base::PathExists(file_path_));
   {
@@ -5,8 +5,11 @@
 #ifndef COMPONENTS_ZUCCHINI_ZUCCHINI_H_
 #define COMPONENTS_ZUCCHINI_ZUCCHINI_H_
 
+#include <stddef.h>
+
 #include <string>
 
+#include "base/callback.h"
 #include "components/zucchini/buffer_view.h"
 #include "components/zucchini/patch_reader.h"
 #include "components/zucchini/patch_writer.h"
@@ -46,10 +49,14 @@ status::Code GenerateEnsemble(ConstBufferView old_image,
 //   "#+#=#+#,#+#=#+#,..."  (e.g., "1+2=3+4", "1+2=3+4,5+6=7+8"),
 // where "#+#=#+#" encodes a match as 4 unsigned integers:
 //   [offset in "old", size in "old", offset in "new", size in "new"].
+// Up to |num_threads| elements (and later, "gaps") are generated at the same
+// time. Each holds its own suffix arrays, so peak memory grows with
+// |num_threads|. The patch is the same for any |num_threads|.
 status::Code GenerateEnsembleWithImposedMatches(
     ConstBufferView old_image,
     ConstBufferView new_image,
     std::string imposed_matches,
+    size_t num_threads,
     EnsemblePatchWriter* patch_writer);
 
 // Generates raw patch from |old_image| to |new_image|, and writes it to
@@ -64,6 +71,19 @@ status::Code Apply(ConstBufferView old_image,
                    const EnsemblePatchReader& patch_reader,
                    MutableBufferView new_image);
 
+// Same as Apply(), but after each element is applied, calls |element_applied|
+// with the element's regions in |old_image| and |new_image|. Elements are
+// applied in increasing "new" offset order, and nothing is written to a "new"
+// region once it's reported, so callers backed by files may write it out and
+// release its memory.
+using ElementAppliedCallback =
+    base::RepeatingCallback<void(BufferRegion old_region,
+                                 BufferRegion new_region)>;
+status::Code Apply(ConstBufferView old_image,
+                   const EnsemblePatchReader& patch_reader,
+                   MutableBufferView new_image,
+                   const ElementAppliedCallback& element_applied);
+
 }  // namespace zucchini
 
 #endif  // COMPONENTS_ZUCCHINI_ZUCCHINI_H_
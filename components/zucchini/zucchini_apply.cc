@@ -191,6 +191,13 @@ bool ApplyElement(ExecutableType exe_type,
 status::Code Apply(ConstBufferView old_image,
                    const EnsemblePatchReader& patch_reader,
                    MutableBufferView new_image) {
+  return Apply(old_image, patch_reader, new_image, ElementAppliedCallback());
+}
+
+status::Code Apply(ConstBufferView old_image,
+                   const EnsemblePatchReader& patch_reader,
+                   MutableBufferView new_image,
+                   const ElementAppliedCallback& element_applied) {
   if (!patch_reader.CheckOldFile(old_image)) {
     LOG(ERROR) << "Invalid old_image.";
     return status::kStatusInvalidOldImage;
@@ -201,6 +208,10 @@ status::Code Apply(ConstBufferView old_image,
     if (!ApplyElement(match.exe_type(), old_image[match.old_element.region()],
                       element_patch, new_image[match.new_element.region()]))
       return status::kStatusFatal;
+    if (element_applied) {
+      element_applied.Run(match.old_element.region(),
+                          match.new_element.region());
+    }
   }
 
   if (!patch_reader.CheckNewFile(ConstBufferView(new_image))) {
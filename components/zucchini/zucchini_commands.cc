@@ -17,6 +17,7 @@
 #include "base/files/memory_mapped_file.h"
 #include "base/logging.h"
 #include "base/macros.h"
+#include "base/strings/string_number_conversions.h"
 #include "components/zucchini/buffer_view.h"
 #include "components/zucchini/crc32.h"
 #include "components/zucchini/io_utils.h"
@@ -33,6 +34,7 @@ constexpr char kSwitchDump[] = "dump";
 constexpr char kSwitchImpose[] = "impose";
 constexpr char kSwitchKeep[] = "keep";
 constexpr char kSwitchRaw[] = "raw";
+constexpr char kSwitchThreads[] = "threads";
 
 }  // namespace
 
@@ -65,9 +67,18 @@ zucchini::status::Code MainGen(MainParams params) {
     // May be empty.
     std::string imposed_matches =
         params.command_line.GetSwitchValueASCII(kSwitchImpose);
+    size_t num_threads = 1;
+    if (params.command_line.HasSwitch(kSwitchThreads) &&
+        (!base::StringToSizeT(
+             params.command_line.GetSwitchValueASCII(kSwitchThreads),
+             &num_threads) ||
+         num_threads == 0)) {
+      params.out << "Invalid thread count." << std::endl;
+      return zucchini::status::kStatusInvalidParam;
+    }
     result = GenerateEnsembleWithImposedMatches(
         old_image.region(), new_image.region(), std::move(imposed_matches),
-        &patch_writer);
+        num_threads, &patch_writer);
   }
 
   if (result != zucchini::status::kStatusSuccess) {
@@ -8,13 +8,17 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <atomic>
 #include <map>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "base/logging.h"
+#include "base/macros.h"
 #include "base/numerics/safe_conversions.h"
+#include "base/threading/simple_thread.h"
 #include "components/zucchini/disassembler.h"
 #include "components/zucchini/element_detection.h"
 #include "components/zucchini/encoded_view.h"
@@ -36,6 +40,41 @@ namespace {
 constexpr double kMinEquivalenceSimilarity = 12.0;
 constexpr double kMinLabelAffinity = 64.0;
 
+// Thread pool work item that hands out successive indices to |task|.
+template <class Task>
+class IndexedWorkItem : public base::DelegateSimpleThread::Delegate {
+ public:
+  explicit IndexedWorkItem(const Task& task) : task_(task) {}
+  ~IndexedWorkItem() override = default;
+
+  // base::DelegateSimpleThread::Delegate:
+  void Run() override { task_(next_index_.fetch_add(1)); }
+
+ private:
+  const Task& task_;
+  std::atomic<size_t> next_index_{0};
+
+  DISALLOW_COPY_AND_ASSIGN(IndexedWorkItem);
+};
+
+// Calls |task(i)| for each i in [0, |count|), spread over at most
+// |num_threads| threads. Calls must not depend on each other.
+template <class Task>
+void RunInParallel(size_t count, size_t num_threads, const Task& task) {
+  num_threads = std::min(num_threads, count);
+  if (num_threads <= 1) {
+    for (size_t i = 0; i < count; ++i)
+      task(i);
+    return;
+  }
+  IndexedWorkItem<Task> work_item(task);
+  base::DelegateSimpleThreadPool pool("ZucchiniGen",
+                                      base::checked_cast<int>(num_threads));
+  pool.AddWork(&work_item, base::checked_cast<int>(count));
+  pool.Start();
+  pool.JoinAll();
+}
+
 }  // namespace
 
 std::vector<offset_t> FindExtraTargets(const TargetPool& projected_old_targets,
@@ -322,6 +361,7 @@ bool GenerateExecutableElement(ExecutableType exe_type,
 status::Code GenerateEnsembleCommon(ConstBufferView old_image,
                                     ConstBufferView new_image,
                                     std::unique_ptr<EnsembleMatcher> matcher,
+                                    size_t num_threads,
                                     EnsemblePatchWriter* patch_writer) {
   if (!matcher->RunMatch(old_image, new_image)) {
     LOG(INFO) << "RunMatch() failed, generating raw patch.";
@@ -352,27 +392,47 @@ status::Code GenerateEnsembleCommon(ConstBufferView old_image,
   size_t covered_new_bytes = 0;
 
   // Process elements first, since non-fatal failures may turn some into gaps.
-  for (const ElementMatch& match : matches) {
+  // Elements are independent, so up to |num_threads| are generated at a time.
+  // Results are collected in |matches| order, so the patch does not depend on
+  // scheduling.
+  std::vector<PatchElementWriter> element_writers;
+  element_writers.reserve(num_elements);
+  for (const ElementMatch& match : matches)
+    element_writers.emplace_back(match);
+  // Not std::vector<bool>, which can't be written from multiple threads.
+  std::vector<uint8_t> element_generated(num_elements, 0);
+
+  RunInParallel(num_elements, num_threads, [&](size_t i) {
+    const ElementMatch& match = matches[i];
     BufferRegion new_region = match.new_element.region();
     LOG(INFO) << "--- Match [" << new_region.lo() << "," << new_region.hi()
               << ")";
 
-    auto it_and_success = patch_element_map.emplace(
-        base::checked_cast<offset_t>(new_region.lo()), match);
-    DCHECK(it_and_success.second);
-    PatchElementWriter& patch_element = it_and_success.first->second;
-
     ConstBufferView old_sub_image = old_image[match.old_element.region()];
     ConstBufferView new_sub_image = new_image[new_region];
     if (GenerateExecutableElement(match.exe_type(), old_sub_image,
-                                  new_sub_image, &patch_element)) {
-      covered_new_regions.push_back(new_region);
-      covered_new_bytes += new_region.size;
+                                  new_sub_image, &element_writers[i])) {
+      element_generated[i] = 1;
     } else {
-      LOG(INFO) << "Fall back to raw patching.";
-      patch_element_map.erase(it_and_success.first);
+      LOG(INFO) << "Fall back to raw patching [" << new_region.lo() << ","
+                << new_region.hi() << ").";
     }
+  });
+
+  for (size_t i = 0; i < num_elements; ++i) {
+    if (!element_generated[i])
+      continue;
+    BufferRegion new_region = matches[i].new_element.region();
+    covered_new_regions.push_back(new_region);
+    covered_new_bytes += new_region.size;
+    bool inserted =
+        patch_element_map
+            .emplace(base::checked_cast<offset_t>(new_region.lo()),
+                     std::move(element_writers[i]))
+            .second;
+    DCHECK(inserted);
   }
+  element_writers.clear();
 
   if (covered_new_bytes < new_image.size()) {
     // Process all "gaps", which are patched against the entire "old" image. To
@@ -389,27 +449,41 @@ status::Code GenerateEnsembleCommon(ConstBufferView old_image,
     // Add sentinel that points to end of "new" file, to simplify gap iteration.
     covered_new_regions.emplace_back(BufferRegion{new_image.size(), 0});
 
+    std::vector<BufferRegion> gaps;
+    std::vector<PatchElementWriter> gap_writers;
     for (const BufferRegion& covered : covered_new_regions) {
       offset_t gap_hi = base::checked_cast<offset_t>(covered.lo());
       DCHECK_GE(gap_hi, gap_lo);
       offset_t gap_size = gap_hi - gap_lo;
       if (gap_size > 0) {
-        LOG(INFO) << "--- Gap   [" << gap_lo << "," << gap_hi << ")";
-
-        ElementMatch gap_match{{entire_old_element, kExeTypeNoOp},
-                               {{gap_lo, gap_size}, kExeTypeNoOp}};
-        auto it_and_success = patch_element_map.emplace(gap_lo, gap_match);
-        DCHECK(it_and_success.second);
-        PatchElementWriter& patch_element = it_and_success.first->second;
-
-        ConstBufferView new_sub_image = new_image[{gap_lo, gap_size}];
-        if (!GenerateRawElement(old_sa_raw, old_image, new_sub_image,
-                                &patch_element)) {
-          return status::kStatusFatal;
-        }
+        gaps.push_back({gap_lo, gap_size});
+        gap_writers.emplace_back(
+            ElementMatch{{entire_old_element, kExeTypeNoOp},
+                         {{gap_lo, gap_size}, kExeTypeNoOp}});
       }
       gap_lo = base::checked_cast<offset_t>(covered.hi());
     }
+
+    // Gaps only read |old_sa_raw|, so they can also be generated concurrently.
+    std::vector<uint8_t> gap_generated(gaps.size(), 0);
+    RunInParallel(gaps.size(), num_threads, [&](size_t i) {
+      LOG(INFO) << "--- Gap   [" << gaps[i].lo() << "," << gaps[i].hi() << ")";
+      gap_generated[i] = GenerateRawElement(old_sa_raw, old_image,
+                                            new_image[gaps[i]], &gap_writers[i])
+                             ? 1
+                             : 0;
+    });
+
+    for (size_t i = 0; i < gaps.size(); ++i) {
+      if (!gap_generated[i])
+        return status::kStatusFatal;
+      bool inserted =
+          patch_element_map
+              .emplace(base::checked_cast<offset_t>(gaps[i].lo()),
+                       std::move(gap_writers[i]))
+              .second;
+      DCHECK(inserted);
+    }
   }
 
   // Write all PatchElementWriter sorted by "new" offset.
@@ -426,20 +500,23 @@ status::Code GenerateEnsemble(ConstBufferView old_image,
                               EnsemblePatchWriter* patch_writer) {
   return GenerateEnsembleCommon(
       old_image, new_image, std::make_unique<HeuristicEnsembleMatcher>(nullptr),
-      patch_writer);
+      1, patch_writer);
 }
 
 status::Code GenerateEnsembleWithImposedMatches(
     ConstBufferView old_image,
     ConstBufferView new_image,
     std::string imposed_matches,
+    size_t num_threads,
     EnsemblePatchWriter* patch_writer) {
+  std::unique_ptr<EnsembleMatcher> matcher;
   if (imposed_matches.empty())
-    return GenerateEnsemble(old_image, new_image, patch_writer);
+    matcher = std::make_unique<HeuristicEnsembleMatcher>(nullptr);
+  else
+    matcher = std::make_unique<ImposedEnsembleMatcher>(imposed_matches);
 
-  return GenerateEnsembleCommon(
-      old_image, new_image,
-      std::make_unique<ImposedEnsembleMatcher>(imposed_matches), patch_writer);
+  return GenerateEnsembleCommon(old_image, new_image, std::move(matcher),
+                                num_threads, patch_writer);
 }
 
 status::Code GenerateRaw(ConstBufferView old_image,
@@ -6,6 +6,7 @@
 
 #include <utility>
 
+#include "base/bind.h"
 #include "base/logging.h"
 #include "components/zucchini/buffer_view.h"
 #include "components/zucchini/mapped_file.h"
@@ -39,6 +40,17 @@ struct FileNames {
   const bool is_dummy;
 };
 
+// Releases the memory for an applied element. The "new" image is written
+// sequentially, so this keeps resident memory near the size of the largest
+// element rather than of both images.
+void ReleaseAppliedElement(MappedFileReader* old_file,
+                           MappedFileWriter* new_file,
+                           BufferRegion old_region,
+                           BufferRegion new_region) {
+  old_file->ReleaseRegion(old_region);
+  new_file->ReleaseRegion(new_region);
+}
+
 status::Code ApplyCommon(base::File&& old_file_handle,
                          base::File&& patch_file_handle,
                          base::File&& new_file_handle,
@@ -83,8 +95,10 @@ status::Code ApplyCommon(base::File&& old_file_handle,
   if (force_keep)
     new_file.Keep();
 
-  zucchini::status::Code result =
-      zucchini::Apply(old_file.region(), *patch_reader, new_file.region());
+  zucchini::status::Code result = zucchini::Apply(
+      old_file.region(), *patch_reader, new_file.region(),
+      base::BindRepeating(&ReleaseAppliedElement, base::Unretained(&old_file),
+                          base::Unretained(&new_file)));
   if (result != status::kStatusSuccess) {
     LOG(ERROR) << "Fatal error encountered while applying patch.";
     return result;
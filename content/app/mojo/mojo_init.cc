@@ -12,6 +12,7 @@
 #include "ipc/ipc_channel.h"
 #include "mojo/edk/embedder/configuration.h"
 #include "mojo/edk/embedder/embedder.h"
+#include "mojo/public/cpp/bindings/message_traffic_stats.h"
 
 namespace content {
 
@@ -23,6 +24,11 @@ class MojoInitializer {
     mojo::edk::Configuration config;
     config.max_message_num_bytes = IPC::Channel::kMaximumMessageSize;
     mojo::edk::Init(config);
+
+    if (base::CommandLine::ForCurrentProcess()->HasSwitch(
+            switches::kEnableMojoTrafficStats)) {
+      mojo::MessageTrafficStats::Enable();
+    }
   }
 };
 
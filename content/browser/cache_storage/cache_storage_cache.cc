@@ -420,6 +420,11 @@ struct CacheStorageCache::QueryCacheContext {
   // Iteration state
   std::unique_ptr<disk_cache::Backend::Iterator> backend_iterator;
   disk_cache::Entry* enumerated_entry = nullptr;
+  // Keys of the entries to open instead of enumerating the backend, taken
+  // from the URL index.
+  std::vector<std::string> indexed_keys;
+  // Keys seen while enumerating the backend, to build the URL index from.
+  std::unique_ptr<std::vector<std::string>> enumerated_keys;
 
   // Output of QueryCache
   std::unique_ptr<std::vector<QueryCacheResult>> matches;
@@ -822,7 +827,24 @@ void CacheStorageCache::QueryCache(
     return;
   }
 
+  if (query_cache_context->request &&
+      !query_cache_context->request->url.is_empty() && url_index_) {
+    // Only the entries with the same URL, ignoring the search, may match.
+    auto it = url_index_->find(
+        RemoveQueryParam(query_cache_context->request->url).spec());
+    if (it != url_index_->end()) {
+      query_cache_context->indexed_keys.assign(it->second.begin(),
+                                               it->second.end());
+    }
+    QueryCacheOpenNextEntry(std::move(query_cache_context));
+    return;
+  }
+
   query_cache_context->backend_iterator = backend_->CreateIterator();
+  if (!url_index_) {
+    query_cache_context->enumerated_keys =
+        std::make_unique<std::vector<std::string>>();
+  }
   QueryCacheOpenNextEntry(std::move(query_cache_context));
 }
 
@@ -843,6 +865,22 @@ void CacheStorageCache::QueryCacheOpenNextEntry(
     std::unique_ptr<QueryCacheContext> query_cache_context) {
   DCHECK_EQ(nullptr, query_cache_context->enumerated_entry);
 
+  if (!query_cache_context->indexed_keys.empty()) {
+    const std::string key =
+        std::move(query_cache_context->indexed_keys.back());
+    query_cache_context->indexed_keys.pop_back();
+    disk_cache::Entry** entry_ptr = &query_cache_context->enumerated_entry;
+    net::CompletionCallback open_entry_callback =
+        base::AdaptCallbackForRepeating(base::BindOnce(
+            &CacheStorageCache::QueryCacheDidOpenIndexedEntry,
+            weak_ptr_factory_.GetWeakPtr(), std::move(query_cache_context)));
+    int rv =
+        backend_->OpenEntry(key, net::HIGHEST, entry_ptr, open_entry_callback);
+    if (rv != net::ERR_IO_PENDING)
+      std::move(open_entry_callback).Run(rv);
+    return;
+  }
+
   if (!query_cache_context->backend_iterator) {
     // Iteration is complete.
     std::sort(query_cache_context->matches->begin(),
@@ -868,12 +906,25 @@ void CacheStorageCache::QueryCacheOpenNextEntry(
     std::move(open_entry_callback).Run(rv);
 }
 
+void CacheStorageCache::QueryCacheDidOpenIndexedEntry(
+    std::unique_ptr<QueryCacheContext> query_cache_context,
+    int rv) {
+  if (rv != net::OK) {
+    // The entry is gone, or was never created.
+    QueryCacheOpenNextEntry(std::move(query_cache_context));
+    return;
+  }
+  QueryCacheFilterEntry(std::move(query_cache_context), rv);
+}
+
 void CacheStorageCache::QueryCacheFilterEntry(
     std::unique_ptr<QueryCacheContext> query_cache_context,
     int rv) {
   if (rv == net::ERR_FAILED) {
     // This is the indicator that iteration is complete.
     query_cache_context->backend_iterator.reset();
+    if (query_cache_context->enumerated_keys && backend_state_ == BACKEND_OPEN)
+      BuildUrlIndex(*query_cache_context->enumerated_keys);
     QueryCacheOpenNextEntry(std::move(query_cache_context));
     return;
   }
@@ -895,6 +946,9 @@ void CacheStorageCache::QueryCacheFilterEntry(
     return;
   }
 
+  if (query_cache_context->enumerated_keys)
+    query_cache_context->enumerated_keys->push_back(entry->GetKey());
+
   if (query_cache_context->request &&
       !query_cache_context->request->url.is_empty()) {
     GURL requestURL = query_cache_context->request->url;
@@ -995,6 +1049,28 @@ void CacheStorageCache::QueryCacheDidReadMetadata(
   QueryCacheOpenNextEntry(std::move(query_cache_context));
 }
 
+void CacheStorageCache::BuildUrlIndex(const std::vector<std::string>& keys) {
+  url_index_ = std::make_unique<UrlIndex>();
+  for (const std::string& key : keys)
+    AddToUrlIndex(key);
+}
+
+void CacheStorageCache::AddToUrlIndex(const std::string& key) {
+  if (url_index_)
+    (*url_index_)[RemoveQueryParam(GURL(key)).spec()].insert(key);
+}
+
+void CacheStorageCache::RemoveFromUrlIndex(const std::string& key) {
+  if (!url_index_)
+    return;
+  auto it = url_index_->find(RemoveQueryParam(GURL(key)).spec());
+  if (it == url_index_->end())
+    return;
+  it->second.erase(key);
+  if (it->second.empty())
+    url_index_->erase(it);
+}
+
 // static
 bool CacheStorageCache::QueryCacheResultCompare(const QueryCacheResult& lhs,
                                                 const QueryCacheResult& rhs) {
@@ -1316,6 +1392,9 @@ void CacheStorageCache::PutDidDeleteEntry(
           &CacheStorageCache::PutDidCreateEntry, weak_ptr_factory_.GetWeakPtr(),
           std::move(scoped_entry_ptr), std::move(put_context)));
 
+  // Added before the entry exists, as the index may list keys of entries
+  // which don't exist but must list all which do.
+  AddToUrlIndex(request_ptr->url.spec());
   int rv = backend_ptr->CreateEntry(request_ptr->url.spec(), net::HIGHEST,
                                     entry_ptr, create_entry_callback);
 
@@ -1619,6 +1698,7 @@ void CacheStorageCache::DeleteDidQueryCache(
           CalculateResponsePadding(*result.response, cache_padding_key_.get(),
                                    entry->GetDataSize(INDEX_SIDE_DATA));
     }
+    RemoveFromUrlIndex(entry->GetKey());
     entry->Doom();
   }
 
@@ -1663,6 +1743,7 @@ void CacheStorageCache::CloseImpl(base::OnceClosure callback) {
   DCHECK_EQ(BACKEND_OPEN, backend_state_);
 
   backend_.reset();
+  url_index_.reset();
   post_backend_closed_callback_ = std::move(callback);
 }
 
@@ -1734,6 +1815,7 @@ void CacheStorageCache::CreateBackendDidCreate(
   }
 
   backend_ = std::move(*backend_ptr);
+  url_index_.reset();
   std::move(callback).Run(CacheStorageError::kSuccess);
 }
 
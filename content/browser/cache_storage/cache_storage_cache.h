@@ -7,7 +7,9 @@
 
 #include <stdint.h>
 
+#include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -279,6 +281,9 @@ class CONTENT_EXPORT CacheStorageCache {
       int rv);
   void QueryCacheOpenNextEntry(
       std::unique_ptr<QueryCacheContext> query_cache_context);
+  void QueryCacheDidOpenIndexedEntry(
+      std::unique_ptr<QueryCacheContext> query_cache_context,
+      int rv);
   void QueryCacheFilterEntry(
       std::unique_ptr<QueryCacheContext> query_cache_context,
       int rv);
@@ -289,6 +294,11 @@ class CONTENT_EXPORT CacheStorageCache {
   static bool QueryCacheResultCompare(const QueryCacheResult& lhs,
                                       const QueryCacheResult& rhs);
 
+  // Maintenance of |url_index_|. Adding does nothing until the index is built.
+  void BuildUrlIndex(const std::vector<std::string>& keys);
+  void AddToUrlIndex(const std::string& key);
+  void RemoveFromUrlIndex(const std::string& key);
+
   // Match callbacks
   void MatchImpl(std::unique_ptr<ServiceWorkerFetchRequest> request,
                  blink::mojom::QueryParamsPtr match_params,
@@ -473,6 +483,14 @@ class CONTENT_EXPORT CacheStorageCache {
   size_t max_query_size_bytes_;
   CacheStorageCacheObserver* cache_observer_;
 
+  // Maps each URL without its query to the keys of the entries with that URL,
+  // so that queries ignoring the search only open the entries which may
+  // match. Built by the first query which enumerates all entries, and may
+  // contain keys of entries which no longer exist. Null until built, and
+  // reset with the backend.
+  using UrlIndex = std::map<std::string, std::set<std::string>>;
+  std::unique_ptr<UrlIndex> url_index_;
+
   // Owns the elements of the list
   BlobToDiskCacheIDMap active_blob_to_disk_cache_writers_;
 
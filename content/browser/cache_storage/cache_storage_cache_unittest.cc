@@ -1224,6 +1224,29 @@ TEST_P(CacheStorageCacheTestP, MatchAll_IgnoreSearch) {
   EXPECT_EQ(2u, matched_set.size());
 }
 
+TEST_P(CacheStorageCacheTestP, MatchAll_IgnoreSearchAfterEnumeration) {
+  EXPECT_TRUE(Put(body_request_, body_response_));
+  EXPECT_TRUE(Put(no_body_request_, no_body_response_));
+  // Listing all keys indexes the URLs in the cache, which the following
+  // queries use.
+  EXPECT_TRUE(Keys());
+  EXPECT_TRUE(Put(body_request_with_query_, body_response_with_query_));
+
+  std::vector<ServiceWorkerResponse> responses;
+  blink::mojom::QueryParamsPtr match_params = blink::mojom::QueryParams::New();
+  match_params->ignore_search = true;
+  EXPECT_TRUE(MatchAll(body_request_, std::move(match_params), &responses));
+  EXPECT_EQ(2u, responses.size());
+
+  EXPECT_TRUE(Delete(body_request_));
+  match_params = blink::mojom::QueryParams::New();
+  match_params->ignore_search = true;
+  EXPECT_TRUE(MatchAll(body_request_, std::move(match_params), &responses));
+  ASSERT_EQ(1u, responses.size());
+  ASSERT_EQ(1u, responses[0].url_list.size());
+  EXPECT_EQ(body_request_with_query_.url, responses[0].url_list[0]);
+}
+
 TEST_P(CacheStorageCacheTestP, MatchAll_Head) {
   EXPECT_TRUE(Put(body_request_, body_response_));
 
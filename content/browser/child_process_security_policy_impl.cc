@@ -815,6 +815,10 @@ bool ChildProcessSecurityPolicyImpl::CanReadRequestBody(
         // Data is self-contained within |body| - no need to check access.
         break;
 
+      case network::DataElement::TYPE_READ_ONLY_SHARED_MEMORY:
+        // Data is self-contained within |body| - no need to check access.
+        break;
+
       case network::DataElement::TYPE_UNKNOWN:
       default:
         // Fail safe - deny access.
@@ -185,6 +185,10 @@ class LocalStorageContextMojo::LevelDBWrapperHolder final
     // of other values being set, so changes are batched.
     static constexpr base::TimeDelta kCommitDefaultDelaySecs =
         base::TimeDelta::FromSeconds(5);
+    // Pages rewriting the same keys in a loop get their changes batched for
+    // longer.
+    static constexpr base::TimeDelta kCommitMaxDelaySecs =
+        base::TimeDelta::FromSeconds(60);
 
     // To avoid excessive IO we apply limits to the amount of data being written
     // and the frequency of writes.
@@ -194,6 +198,7 @@ class LocalStorageContextMojo::LevelDBWrapperHolder final
     LevelDBWrapperImpl::Options options;
     options.max_size = kPerStorageAreaQuota + kPerStorageAreaOverQuotaAllowance;
     options.default_commit_delay = kCommitDefaultDelaySecs;
+    options.max_commit_delay = kCommitMaxDelaySecs;
     options.max_bytes_per_hour = kMaxBytesPerHour;
     options.max_commits_per_hour = kMaxCommitsPerHour;
 #if defined(OS_ANDROID)
@@ -215,6 +215,7 @@ static const char* const kSwitchNames[] = {
 #endif
     switches::kEnableGpuRasterization,
     switches::kEnableLogging,
+    switches::kEnableMojoTrafficStats,
     switches::kEnableVizDevTools,
     switches::kHeadless,
     switches::kLoggingLevel,
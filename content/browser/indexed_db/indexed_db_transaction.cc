@@ -26,6 +26,10 @@ namespace {
 
 const int64_t kInactivityTimeoutPeriodSeconds = 60;
 
+// Long enough for many small requests, short enough that a transaction on
+// other object stores isn't noticeably delayed by a bulk load.
+const int64_t kTaskQueueSliceMilliseconds = 5;
+
 // Helper for posting a task to call IndexedDBTransaction::Commit when we know
 // the transaction had no requests and therefore the commit must succeed.
 void CommitUnused(base::WeakPtr<IndexedDBTransaction> transaction) {
@@ -482,6 +486,7 @@ void IndexedDBTransaction::ProcessTaskQueue() {
     backing_store_transaction_begun_ = true;
   }
 
+  const base::TimeTicks slice_start = base::TimeTicks::Now();
   TaskQueue* task_queue =
       pending_preemptive_events_ ? &preemptive_task_queue_ : &task_queue_;
   while (!task_queue->empty() && state_ != FINISHED) {
@@ -501,6 +506,19 @@ void IndexedDBTransaction::ProcessTaskQueue() {
     // Event itself may change which queue should be processed next.
     task_queue =
         pending_preemptive_events_ ? &preemptive_task_queue_ : &task_queue_;
+
+    // All started transactions share this sequence, and the coordinator only
+    // starts transactions whose scopes don't conflict. Yield once the slice
+    // is used up so that they make progress side by side, rather than each
+    // waiting for the queues of those started before it to drain.
+    if (!pending_preemptive_events_ && !task_queue->empty() &&
+        state_ == STARTED &&
+        database_->transaction_coordinator().started_transaction_count() > 1 &&
+        base::TimeTicks::Now() - slice_start >= GetTaskQueueSlice()) {
+      processing_event_queue_ = false;
+      RunTasksIfStarted();
+      return;
+    }
   }
 
   // If there are no pending tasks, we haven't already committed/aborted,
@@ -537,6 +555,10 @@ base::TimeDelta IndexedDBTransaction::GetInactivityTimeout() const {
   return base::TimeDelta::FromSeconds(kInactivityTimeoutPeriodSeconds);
 }
 
+base::TimeDelta IndexedDBTransaction::GetTaskQueueSlice() const {
+  return base::TimeDelta::FromMilliseconds(kTaskQueueSliceMilliseconds);
+}
+
 void IndexedDBTransaction::Timeout() {
   Abort(IndexedDBDatabaseError(
       blink::kWebIDBDatabaseExceptionTimeoutError,
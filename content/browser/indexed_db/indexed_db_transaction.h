@@ -137,6 +137,10 @@ class CONTENT_EXPORT IndexedDBTransaction {
   // May be overridden in tests.
   virtual base::TimeDelta GetInactivityTimeout() const;
 
+  // How long ProcessTaskQueue() may run tasks while other transactions are
+  // started before it yields to them. May be overridden in tests.
+  virtual base::TimeDelta GetTaskQueueSlice() const;
+
  private:
   friend class BlobWriteCallbackImpl;
   friend class IndexedDBClassFactory;
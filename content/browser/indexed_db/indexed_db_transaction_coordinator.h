@@ -5,6 +5,7 @@
 #ifndef CONTENT_BROWSER_INDEXED_DB_INDEXED_DB_TRANSACTION_COORDINATOR_H_
 #define CONTENT_BROWSER_INDEXED_DB_INDEXED_DB_TRANSACTION_COORDINATOR_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include <map>
@@ -33,6 +34,10 @@ class CONTENT_EXPORT IndexedDBTransactionCoordinator {
 
   bool IsRunningVersionChangeTransaction() const;
 
+  size_t started_transaction_count() const {
+    return started_transactions_.size();
+  }
+
 #ifndef NDEBUG
   bool IsActive(IndexedDBTransaction* transaction);
 #endif
@@ -6,6 +6,8 @@
 
 #include <stdint.h>
 #include <memory>
+#include <set>
+#include <vector>
 
 #include "base/bind.h"
 #include "base/logging.h"
@@ -42,6 +44,29 @@ class AbortObserver {
   DISALLOW_COPY_AND_ASSIGN(AbortObserver);
 };
 
+// Yields to other started transactions after every task.
+class SlicedTransaction : public IndexedDBTransaction {
+ public:
+  SlicedTransaction(
+      int64_t id,
+      IndexedDBConnection* connection,
+      const std::set<int64_t>& object_store_ids,
+      IndexedDBBackingStore::Transaction* backing_store_transaction)
+      : IndexedDBTransaction(id,
+                             connection,
+                             object_store_ids,
+                             blink::kWebIDBTransactionModeReadWrite,
+                             backing_store_transaction) {}
+
+ protected:
+  base::TimeDelta GetTaskQueueSlice() const override {
+    return base::TimeDelta();
+  }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(SlicedTransaction);
+};
+
 class IndexedDBTransactionTest : public testing::Test {
  public:
   IndexedDBTransactionTest() : factory_(new MockIndexedDBFactory()) {
@@ -66,6 +91,12 @@ class IndexedDBTransactionTest : public testing::Test {
                                  IndexedDBTransaction* transaction) {
     return result;
   }
+  leveldb::Status RecordingOperation(std::vector<int>* log,
+                                     int entry,
+                                     IndexedDBTransaction* transaction) {
+    log->push_back(entry);
+    return leveldb::Status::OK();
+  }
   leveldb::Status AbortableOperation(AbortObserver* observer,
                                      IndexedDBTransaction* transaction) {
     transaction->ScheduleAbortTask(
@@ -139,6 +170,44 @@ TEST_F(IndexedDBTransactionTest, Timeout) {
   EXPECT_EQ(1, transaction->diagnostics().tasks_completed);
 }
 
+TEST_F(IndexedDBTransactionTest, DisjointTransactionsInterleave) {
+  const leveldb::Status commit_success = leveldb::Status::OK();
+  std::unique_ptr<IndexedDBConnection> connection(
+      std::make_unique<IndexedDBConnection>(
+          kFakeProcessId, db_, new MockIndexedDBDatabaseCallbacks()));
+  std::unique_ptr<IndexedDBTransaction> first =
+      std::make_unique<SlicedTransaction>(
+          0, connection.get(), std::set<int64_t>{1},
+          new IndexedDBFakeBackingStore::FakeTransaction(commit_success));
+  std::unique_ptr<IndexedDBTransaction> second =
+      std::make_unique<SlicedTransaction>(
+          1, connection.get(), std::set<int64_t>{2},
+          new IndexedDBFakeBackingStore::FakeTransaction(commit_success));
+  db_->TransactionCreated(first.get());
+  db_->TransactionCreated(second.get());
+  EXPECT_EQ(IndexedDBTransaction::STARTED, first->state());
+  EXPECT_EQ(IndexedDBTransaction::STARTED, second->state());
+
+  std::vector<int> log;
+  for (int i = 0; i < 3; ++i) {
+    first->ScheduleTask(
+        base::BindOnce(&IndexedDBTransactionTest::RecordingOperation,
+                       base::Unretained(this), &log, 10 + i));
+    second->ScheduleTask(
+        base::BindOnce(&IndexedDBTransactionTest::RecordingOperation,
+                       base::Unretained(this), &log, 20 + i));
+  }
+  RunPostedTasks();
+  EXPECT_EQ((std::vector<int>{10, 20, 11, 21, 12, 22}), log);
+  EXPECT_EQ(3, first->diagnostics().tasks_completed);
+  EXPECT_EQ(3, second->diagnostics().tasks_completed);
+
+  first->Commit();
+  second->Commit();
+  EXPECT_EQ(IndexedDBTransaction::FINISHED, first->state());
+  EXPECT_EQ(IndexedDBTransaction::FINISHED, second->state());
+}
+
 TEST_F(IndexedDBTransactionTest, NoTimeoutReadOnly) {
   const int64_t id = 0;
   const std::set<int64_t> scope;
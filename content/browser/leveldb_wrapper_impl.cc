@@ -54,7 +54,8 @@ base::TimeDelta LevelDBWrapperImpl::RateLimiter::ComputeDelayNeeded(
   return base::TimeDelta();
 }
 
-LevelDBWrapperImpl::CommitBatch::CommitBatch() : clear_all_first(false) {}
+LevelDBWrapperImpl::CommitBatch::CommitBatch()
+    : clear_all_first(false), write_count(0) {}
 LevelDBWrapperImpl::CommitBatch::~CommitBatch() {}
 
 LevelDBWrapperImpl::LevelDBWrapperImpl(
@@ -81,6 +82,9 @@ LevelDBWrapperImpl::LevelDBWrapperImpl(
       memory_used_(0),
       start_time_(base::TimeTicks::Now()),
       default_commit_delay_(options.default_commit_delay),
+      max_commit_delay_(
+          std::max(options.default_commit_delay, options.max_commit_delay)),
+      commit_delay_(options.default_commit_delay),
       data_rate_limiter_(options.max_bytes_per_hour,
                          base::TimeDelta::FromHours(1)),
       commit_rate_limiter_(options.max_commits_per_hour,
@@ -324,6 +328,7 @@ void LevelDBWrapperImpl::Put(
       commit_batch_->changed_values[key] = value;
     else
       commit_batch_->changed_keys.insert(key);
+    ++commit_batch_->write_count;
   }
 
   if (map_state_ == MapState::LOADED_KEYS_ONLY)
@@ -396,8 +401,10 @@ void LevelDBWrapperImpl::Delete(
     storage_used_ -= key.size() + found->second;
     keys_only_map_.erase(found);
     memory_used_ -= key.size() + sizeof(size_t);
-    if (commit_batch_)
+    if (commit_batch_) {
       commit_batch_->changed_values[key] = std::vector<uint8_t>();
+      ++commit_batch_->write_count;
+    }
   } else {
     DCHECK_EQ(map_state_, MapState::LOADED_KEYS_AND_VALUES);
     ValueMap::iterator found = keys_values_map_.find(key);
@@ -409,8 +416,10 @@ void LevelDBWrapperImpl::Delete(
     keys_values_map_.erase(found);
     memory_used_ -= key.size() + old_value.size();
     storage_used_ -= key.size() + old_value.size();
-    if (commit_batch_)
+    if (commit_batch_) {
       commit_batch_->changed_keys.insert(key);
+      ++commit_batch_->write_count;
+    }
   }
 
   observers_.ForAllPtrs(
@@ -730,14 +739,33 @@ base::TimeDelta LevelDBWrapperImpl::ComputeCommitDelay() const {
     return base::TimeDelta::FromSeconds(1);
 
   base::TimeDelta elapsed_time = base::TimeTicks::Now() - start_time_;
-  base::TimeDelta delay = std::max(
-      default_commit_delay_,
+  base::TimeDelta rate_limit_delay =
       std::max(commit_rate_limiter_.ComputeDelayNeeded(elapsed_time),
-               data_rate_limiter_.ComputeDelayNeeded(elapsed_time)));
+               data_rate_limiter_.ComputeDelayNeeded(elapsed_time));
+  base::TimeDelta delay = std::max(commit_delay_, rate_limit_delay);
   UMA_HISTOGRAM_LONG_TIMES("LevelDBWrapper.CommitDelay", delay);
+  UMA_HISTOGRAM_BOOLEAN("LevelDBWrapper.CommitDelayRateLimited",
+                        rate_limit_delay > commit_delay_);
   return delay;
 }
 
+void LevelDBWrapperImpl::AdaptCommitDelay(size_t write_count,
+                                          size_t keys_written) {
+  // Writes to a key already in the batch cost no IO, so while pages keep
+  // rewriting keys, commit less often. Back off quickly once they stop, so
+  // that writes aren't left uncommitted longer than needed.
+  const size_t merged_writes =
+      write_count > keys_written ? write_count - keys_written : 0;
+  if (write_count) {
+    UMA_HISTOGRAM_COUNTS_1000("LevelDBWrapper.CommitMergedWrites",
+                              merged_writes);
+  }
+  if (merged_writes > 0 && merged_writes >= keys_written)
+    commit_delay_ = std::min(commit_delay_ * 2, max_commit_delay_);
+  else
+    commit_delay_ = std::max(commit_delay_ / 2, default_commit_delay_);
+}
+
 void LevelDBWrapperImpl::CommitChanges() {
   // Note: commit_batch_ may be null if ScheduleImmediateCommit was called
   // after a delayed commit task was scheduled.
@@ -748,6 +776,9 @@ void LevelDBWrapperImpl::CommitChanges() {
   DCHECK(IsMapLoaded()) << static_cast<int>(map_state_);
 
   commit_rate_limiter_.add_samples(1);
+  AdaptCommitDelay(commit_batch_->write_count,
+                   commit_batch_->changed_values.size() +
+                       commit_batch_->changed_keys.size());
 
   // Commit all our changes in a single batch.
   std::vector<BatchedOperationPtr> operations = delegate_->PrepareToCommit();
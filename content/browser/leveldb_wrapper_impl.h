@@ -82,6 +82,11 @@ class CONTENT_EXPORT LevelDBWrapperImpl : public blink::mojom::StorageArea {
     size_t max_size = 0;
     // Minimum time between 2 commits to disk.
     base::TimeDelta default_commit_delay;
+    // The commit delay grows up to this while pages keep rewriting the same
+    // keys within a commit batch, so that more rewrites are merged, and
+    // shrinks back to |default_commit_delay| once they stop. No adaptation if
+    // not larger than |default_commit_delay|.
+    base::TimeDelta max_commit_delay;
     // Maximum number of bytes written to disk in one hour.
     int max_bytes_per_hour = 0;
     // Maximum number of disk write batches in one hour.
@@ -201,6 +206,7 @@ class CONTENT_EXPORT LevelDBWrapperImpl : public blink::mojom::StorageArea {
   FRIEND_TEST_ALL_PREFIXES(LevelDBWrapperImplTest, SetCacheModeConsistent);
   FRIEND_TEST_ALL_PREFIXES(LevelDBWrapperImplParamTest,
                            CommitOnDifferentCacheModes);
+  FRIEND_TEST_ALL_PREFIXES(LevelDBWrapperImplTest, CommitDelayAdaptsToRewrites);
 
   // Used to rate limit commits.
   class RateLimiter {
@@ -236,6 +242,8 @@ class CONTENT_EXPORT LevelDBWrapperImpl : public blink::mojom::StorageArea {
     std::map<std::vector<uint8_t>, std::vector<uint8_t>> changed_values;
     // Used if the map_type_ is LOADED_KEYS_AND_VALUES.
     std::set<std::vector<uint8_t>> changed_keys;
+    // Number of Put() and Delete() calls merged into this batch.
+    size_t write_count;
 
     CommitBatch();
     ~CommitBatch();
@@ -282,6 +290,9 @@ class CONTENT_EXPORT LevelDBWrapperImpl : public blink::mojom::StorageArea {
   void CreateCommitBatchIfNeeded();
   void StartCommitTimer();
   base::TimeDelta ComputeCommitDelay() const;
+  // Updates |commit_delay_| after committing a batch of |write_count| writes
+  // to |keys_written| keys.
+  void AdaptCommitDelay(size_t write_count, size_t keys_written);
 
   void CommitChanges();
   void OnCommitComplete(leveldb::mojom::DatabaseError error);
@@ -330,6 +341,9 @@ class CONTENT_EXPORT LevelDBWrapperImpl : public blink::mojom::StorageArea {
   size_t memory_used_;
   base::TimeTicks start_time_;
   base::TimeDelta default_commit_delay_;
+  base::TimeDelta max_commit_delay_;
+  // The delay before committing the next batch, between the two above.
+  base::TimeDelta commit_delay_;
   RateLimiter data_rate_limiter_;
   RateLimiter commit_rate_limiter_;
   int commit_batches_in_flight_ = 0;
@@ -148,6 +148,7 @@ LevelDBWrapperImpl::Options GetDefaultTestingOptions(CacheMode cache_mode) {
   LevelDBWrapperImpl::Options options;
   options.max_size = kTestSizeLimit;
   options.default_commit_delay = base::TimeDelta::FromSeconds(5);
+  options.max_commit_delay = base::TimeDelta::FromSeconds(20);
   options.max_bytes_per_hour = 10 * 1024 * 1024;
   options.max_commits_per_hour = 60;
   options.cache_mode = cache_mode;
@@ -1046,6 +1047,31 @@ TEST_F(LevelDBWrapperImplTest, SetCacheModeConsistent) {
             wrapper_impl()->map_state_);
 }
 
+TEST_F(LevelDBWrapperImplTest, CommitDelayAdaptsToRewrites) {
+  const base::TimeDelta kDefaultDelay = base::TimeDelta::FromSeconds(5);
+  EXPECT_EQ(kDefaultDelay, wrapper_impl()->commit_delay_);
+
+  // Each batch writes the same key several times.
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      EXPECT_TRUE(PutSync(ToBytes(test_key1_),
+                          ToBytes(test_value1_ + base::IntToString(j)),
+                          base::nullopt));
+    }
+    BlockingCommit();
+  }
+  EXPECT_EQ(base::TimeDelta::FromSeconds(20), wrapper_impl()->commit_delay_);
+  EXPECT_EQ("defdata3", get_mock_data(test_prefix_ + test_key1_));
+
+  // Batches without rewrites bring the delay back down.
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_TRUE(PutSync(ToBytes(test_key2_), ToBytes(base::IntToString(i)),
+                        base::nullopt));
+    BlockingCommit();
+  }
+  EXPECT_EQ(kDefaultDelay, wrapper_impl()->commit_delay_);
+}
+
 TEST_F(LevelDBWrapperImplTest, SendOldValueObservations) {
   should_record_send_old_value_observations(true);
   wrapper_impl()->SetCacheModeForTesting(CacheMode::KEYS_AND_VALUES);
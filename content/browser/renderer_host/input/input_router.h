@@ -5,6 +5,7 @@
 #ifndef CONTENT_BROWSER_RENDERER_HOST_INPUT_INPUT_ROUTER_H_
 #define CONTENT_BROWSER_RENDERER_HOST_INPUT_INPUT_ROUTER_H_
 
+#include "base/time/time.h"
 #include "cc/input/touch_action.h"
 #include "content/browser/renderer_host/event_with_latency_info.h"
 #include "content/browser/renderer_host/input/gesture_event_queue.h"
@@ -79,6 +80,10 @@ class InputRouter : public IPC::Listener {
   // Called when a set-touch-action message is received from the renderer
   // for a touch start event that is currently in flight.
   virtual void OnSetTouchAction(cc::TouchAction touch_action) = 0;
+
+  // Sends the continuous events batched since the last frame, if any. Called
+  // on the BeginFrame requested by the client when events are batched.
+  virtual void DispatchBatchedInput(base::TimeTicks frame_time) = 0;
 };
 
 }  // namespace content
@@ -47,6 +47,10 @@ using ui::WebInputEventTraits;
 
 namespace {
 
+// The longest batched events wait for a BeginFrame.
+constexpr base::TimeDelta kMaxBatchedInputDelay =
+    base::TimeDelta::FromMilliseconds(50);
+
 bool WasHandled(InputEventAckState state) {
   switch (state) {
     case INPUT_EVENT_ACK_STATE_CONSUMED:
@@ -88,6 +92,8 @@ InputRouterImpl::InputRouterImpl(
                            fling_scheduler_client,
                            config.gesture_config),
       device_scale_factor_(1.f),
+      batch_continuous_events_(
+          base::FeatureList::IsEnabled(features::kVsyncAlignedInputBatching)),
       host_binding_(this),
       frame_host_binding_(this),
       weak_ptr_factory_(this) {
@@ -112,16 +118,25 @@ void InputRouterImpl::SendMouseEvent(
           ->ShouldSuppressMouseUp())
     return;
 
+  if (batch_continuous_events_ &&
+      mouse_event.event.GetType() == WebInputEvent::kMouseMove) {
+    BatchMouseMove(mouse_event);
+    return;
+  }
+
+  DispatchBatchedMouseMove();
   SendMouseEventImmediately(mouse_event);
 }
 
 void InputRouterImpl::SendWheelEvent(
     const MouseWheelEventWithLatencyInfo& wheel_event) {
+  DispatchBatchedMouseMove();
   wheel_event_queue_.QueueEvent(wheel_event);
 }
 
 void InputRouterImpl::SendKeyboardEvent(
     const NativeWebKeyboardEventWithLatencyInfo& key_event) {
+  DispatchBatchedMouseMove();
   gesture_event_queue_.StopFling();
   gesture_event_queue_.FlingHasBeenHalted();
   mojom::WidgetInputHandler::DispatchEventCallback callback = base::BindOnce(
@@ -132,6 +147,7 @@ void InputRouterImpl::SendKeyboardEvent(
 
 void InputRouterImpl::SendGestureEvent(
     const GestureEventWithLatencyInfo& original_gesture_event) {
+  DispatchBatchedMouseMove();
   input_stream_validator_.Validate(original_gesture_event.event,
                                    FlingCancellationIsDeferred());
 
@@ -195,6 +211,7 @@ void InputRouterImpl::SendGestureEvent(
 
 void InputRouterImpl::SendTouchEvent(
     const TouchEventWithLatencyInfo& touch_event) {
+  DispatchBatchedMouseMove();
   TouchEventWithLatencyInfo updatd_touch_event = touch_event;
   SetMovementXYForTouchPoints(&updatd_touch_event.event);
   input_stream_validator_.Validate(updatd_touch_event.event);
@@ -206,7 +223,8 @@ void InputRouterImpl::NotifySiteIsMobileOptimized(bool is_mobile_optimized) {
 }
 
 bool InputRouterImpl::HasPendingEvents() const {
-  return !touch_event_queue_.Empty() || !gesture_event_queue_.empty() ||
+  return batched_mouse_move_ || !touch_event_queue_.Empty() ||
+         !gesture_event_queue_.empty() ||
          wheel_event_queue_.has_pending() ||
          touchpad_pinch_event_queue_.has_pending() ||
          active_renderer_fling_count_ > 0;
@@ -339,6 +357,42 @@ void InputRouterImpl::SendMouseEventImmediately(
                              std::move(callback));
 }
 
+void InputRouterImpl::BatchMouseMove(
+    const MouseEventWithLatencyInfo& mouse_event) {
+  if (batched_mouse_move_ &&
+      batched_mouse_move_->CanCoalesceWith(mouse_event)) {
+    batched_mouse_move_->CoalesceWith(mouse_event);
+  } else {
+    DispatchBatchedMouseMove();
+    batched_mouse_move_ = mouse_event;
+    client_->SetNeedsBeginFrameForBatchedInput();
+    batched_input_fallback_timer_.Start(
+        FROM_HERE, kMaxBatchedInputDelay, this,
+        &InputRouterImpl::DispatchBatchedMouseMove);
+  }
+  batched_mouse_move_events_.push_back(mouse_event.event);
+}
+
+void InputRouterImpl::DispatchBatchedMouseMove() {
+  if (!batched_mouse_move_)
+    return;
+  batched_input_fallback_timer_.Stop();
+  MouseEventWithLatencyInfo mouse_event = *batched_mouse_move_;
+  std::vector<WebMouseEvent> coalesced_events;
+  coalesced_events.swap(batched_mouse_move_events_);
+  batched_mouse_move_.reset();
+
+  TRACE_EVENT1("input", "InputRouterImpl::DispatchBatchedMouseMove",
+               "coalesced_count", coalesced_events.size());
+  mojom::WidgetInputHandler::DispatchEventCallback callback = base::BindOnce(
+      &InputRouterImpl::MouseEventHandled, weak_this_, mouse_event);
+  // A single event needs no coalesced list.
+  if (coalesced_events.size() == 1)
+    coalesced_events.clear();
+  FilterAndSendWebInputEvent(mouse_event.event, coalesced_events,
+                             mouse_event.latency, std::move(callback));
+}
+
 void InputRouterImpl::SendTouchEventImmediately(
     const TouchEventWithLatencyInfo& touch_event) {
   mojom::WidgetInputHandler::DispatchEventCallback callback = base::BindOnce(
@@ -450,6 +504,15 @@ void InputRouterImpl::FilterAndSendWebInputEvent(
     const WebInputEvent& input_event,
     const ui::LatencyInfo& latency_info,
     mojom::WidgetInputHandler::DispatchEventCallback callback) {
+  FilterAndSendWebInputEvent(input_event, std::vector<WebMouseEvent>(),
+                             latency_info, std::move(callback));
+}
+
+void InputRouterImpl::FilterAndSendWebInputEvent(
+    const WebInputEvent& input_event,
+    const std::vector<WebMouseEvent>& coalesced_events,
+    const ui::LatencyInfo& latency_info,
+    mojom::WidgetInputHandler::DispatchEventCallback callback) {
   TRACE_EVENT1("input", "InputRouterImpl::FilterAndSendWebInputEvent", "type",
                WebInputEvent::GetName(input_event.GetType()));
   TRACE_EVENT_WITH_FLOW2(
@@ -473,6 +536,10 @@ void InputRouterImpl::FilterAndSendWebInputEvent(
 
   std::unique_ptr<InputEvent> event = std::make_unique<InputEvent>(
       ScaleEvent(input_event, device_scale_factor_), latency_info);
+  for (const WebMouseEvent& coalesced_event : coalesced_events) {
+    event->coalesced_events.push_back(
+        ScaleEvent(coalesced_event, device_scale_factor_));
+  }
   if (WebInputEventTraits::ShouldBlockEventStream(
           input_event, wheel_scroll_latching_enabled_)) {
     TRACE_EVENT_INSTANT0("input", "InputEventSentBlocking",
@@ -630,6 +697,11 @@ void InputRouterImpl::OnSetTouchAction(cc::TouchAction touch_action) {
   UpdateTouchAckTimeoutEnabled();
 }
 
+void InputRouterImpl::DispatchBatchedInput(base::TimeTicks frame_time) {
+  TRACE_EVENT0("input", "InputRouterImpl::DispatchBatchedInput");
+  DispatchBatchedMouseMove();
+}
+
 void InputRouterImpl::UpdateTouchAckTimeoutEnabled() {
   // kTouchActionNone will prevent scrolling, in which case the timeout serves
   // little purpose. It's also a strong signal that touch handling is critical
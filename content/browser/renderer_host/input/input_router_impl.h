@@ -9,11 +9,14 @@
 
 #include <memory>
 #include <queue>
+#include <vector>
 
 #include "base/containers/flat_map.h"
 #include "base/gtest_prod_util.h"
 #include "base/macros.h"
+#include "base/optional.h"
 #include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "cc/input/touch_action.h"
 #include "content/browser/renderer_host/input/fling_scheduler.h"
 #include "content/browser/renderer_host/input/gesture_event_queue.h"
@@ -48,6 +51,8 @@ class CONTENT_EXPORT InputRouterImplClient : public InputRouterClient {
   virtual void OnImeCompositionRangeChanged(
       const gfx::Range& range,
       const std::vector<gfx::Rect>& bounds) = 0;
+  // Asks for a BeginFrame, on which DispatchBatchedInput() should be called.
+  virtual void SetNeedsBeginFrameForBatchedInput() = 0;
 };
 
 // A default implementation for browser input event routing.
@@ -85,6 +90,7 @@ class CONTENT_EXPORT InputRouterImpl : public InputRouter,
   void StopFling() override;
   bool FlingCancellationIsDeferred() override;
   void OnSetTouchAction(cc::TouchAction touch_action) override;
+  void DispatchBatchedInput(base::TimeTicks frame_time) override;
 
   // InputHandlerHost impl
   void CancelTouchTimeout() override;
@@ -111,6 +117,13 @@ class CONTENT_EXPORT InputRouterImpl : public InputRouter,
 
   void SendMouseEventImmediately(const MouseEventWithLatencyInfo& mouse_event);
 
+  // Coalesces |mouse_event| into the batched mouse move, which is sent on the
+  // next frame.
+  void BatchMouseMove(const MouseEventWithLatencyInfo& mouse_event);
+  // Sends the batched mouse move, if any, along with the events it was
+  // coalesced from. Called before any other event is sent to keep the order.
+  void DispatchBatchedMouseMove();
+
   // PassthroughTouchEventQueueClient
   void SendTouchEventImmediately(
       const TouchEventWithLatencyInfo& touch_event) override;
@@ -155,6 +168,12 @@ class CONTENT_EXPORT InputRouterImpl : public InputRouter,
       const blink::WebInputEvent& input_event,
       const ui::LatencyInfo& latency_info,
       mojom::WidgetInputHandler::DispatchEventCallback callback);
+  // As above, for an event coalesced from |coalesced_events|.
+  void FilterAndSendWebInputEvent(
+      const blink::WebInputEvent& input_event,
+      const std::vector<blink::WebMouseEvent>& coalesced_events,
+      const ui::LatencyInfo& latency_info,
+      mojom::WidgetInputHandler::DispatchEventCallback callback);
 
   void KeyboardEventHandled(
       const NativeWebKeyboardEventWithLatencyInfo& event,
@@ -229,6 +248,17 @@ class CONTENT_EXPORT InputRouterImpl : public InputRouter,
   // Last touch position relative to screen. Used to compute movementX/Y.
   base::flat_map<int, gfx::Point> global_touch_position_;
 
+  // Whether continuous events are batched and sent once per frame, see
+  // features::kVsyncAlignedInputBatching.
+  const bool batch_continuous_events_;
+  // The mouse moves received since the last frame, coalesced into one event,
+  // and the events it was coalesced from.
+  base::Optional<MouseEventWithLatencyInfo> batched_mouse_move_;
+  std::vector<blink::WebMouseEvent> batched_mouse_move_events_;
+  // Sends the batched events if no BeginFrame arrives in time, e.g. for
+  // hidden widgets.
+  base::OneShotTimer batched_input_fallback_timer_;
+
   // The host binding associated with the widget input handler from
   // the widget.
   mojo::Binding<mojom::WidgetInputHandlerHost> host_binding_;
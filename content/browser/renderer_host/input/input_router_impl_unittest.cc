@@ -114,6 +114,16 @@ class MockInputRouterImplClient : public InputRouterImplClient {
 
   void OnImeCancelComposition() override {}
 
+  void SetNeedsBeginFrameForBatchedInput() override {
+    needs_begin_frame_for_batched_input_ = true;
+  }
+
+  bool GetAndResetNeedsBeginFrameForBatchedInput() {
+    bool needs_begin_frame = needs_begin_frame_for_batched_input_;
+    needs_begin_frame_for_batched_input_ = false;
+    return needs_begin_frame;
+  }
+
   MockWidgetInputHandler::MessageVector GetAndResetDispatchedMessages() {
     return widget_input_handler_.GetAndResetDispatchedMessages();
   }
@@ -206,6 +216,7 @@ class MockInputRouterImplClient : public InputRouterImplClient {
 
   MockInputRouterClient input_router_client_;
   MockWidgetInputHandler widget_input_handler_;
+  bool needs_begin_frame_for_batched_input_ = false;
 };
 
 class InputRouterImplTest : public testing::Test {
@@ -499,6 +510,17 @@ class InputRouterImplAsyncWheelEventEnabledTest : public InputRouterImplTest {
       : InputRouterImplTest(kAsyncWheelEvents) {}
 };
 
+class InputRouterImplBatchedInputTest : public InputRouterImplTest {
+ public:
+  InputRouterImplBatchedInputTest() {
+    batching_feature_list_.InitAndEnableFeature(
+        features::kVsyncAlignedInputBatching);
+  }
+
+ private:
+  base::test::ScopedFeatureList batching_feature_list_;
+};
+
 TEST_F(InputRouterImplTest, HandledInputEvent) {
   client_->set_filter_state(INPUT_EVENT_ACK_STATE_CONSUMED);
 
@@ -1079,6 +1101,48 @@ TEST_F(InputRouterImplTest, MouseTypesIgnoringAck) {
   }
 }
 
+// Tests that mouse moves are sent once per frame, coalesced into one event
+// which carries the events it was coalesced from.
+TEST_F(InputRouterImplBatchedInputTest, MouseMovesBatchedPerFrame) {
+  SimulateMouseEvent(WebInputEvent::kMouseMove, 1, 1);
+  SimulateMouseEvent(WebInputEvent::kMouseMove, 2, 2);
+  SimulateMouseEvent(WebInputEvent::kMouseMove, 3, 3);
+  EXPECT_TRUE(client_->GetAndResetNeedsBeginFrameForBatchedInput());
+  EXPECT_EQ(0U, GetAndResetDispatchedMessages().size());
+  EXPECT_TRUE(input_router_->HasPendingEvents());
+
+  input_router_->DispatchBatchedInput(base::TimeTicks::Now());
+  DispatchedMessages dispatched_messages = GetAndResetDispatchedMessages();
+  ASSERT_EQ(1U, dispatched_messages.size());
+  ASSERT_TRUE(dispatched_messages[0]->ToEvent());
+  const InputEvent* event = dispatched_messages[0]->ToEvent()->Event();
+  EXPECT_EQ(3, static_cast<const WebMouseEvent*>(event->web_event.get())
+                   ->PositionInWidget()
+                   .x);
+  ASSERT_EQ(3U, event->coalesced_events.size());
+  EXPECT_EQ(1, static_cast<const WebMouseEvent*>(
+                   event->coalesced_events[0].get())
+                   ->PositionInWidget()
+                   .x);
+  dispatched_messages[0]->ToEvent()->CallCallback(
+      INPUT_EVENT_ACK_STATE_NOT_CONSUMED);
+  EXPECT_EQ(1U, disposition_handler_->GetAndResetAckCount());
+
+  // Other events send the batched mouse move first to keep the order.
+  SimulateMouseEvent(WebInputEvent::kMouseMove, 4, 4);
+  SimulateMouseEvent(WebInputEvent::kMouseDown, 4, 4);
+  dispatched_messages = GetAndResetDispatchedMessages();
+  ASSERT_EQ(2U, dispatched_messages.size());
+  ASSERT_TRUE(dispatched_messages[0]->ToEvent());
+  ASSERT_TRUE(dispatched_messages[1]->ToEvent());
+  EXPECT_EQ(WebInputEvent::kMouseMove,
+            dispatched_messages[0]->ToEvent()->Event()->web_event->GetType());
+  EXPECT_TRUE(
+      dispatched_messages[0]->ToEvent()->Event()->coalesced_events.empty());
+  EXPECT_EQ(WebInputEvent::kMouseDown,
+            dispatched_messages[1]->ToEvent()->Event()->web_event->GetType());
+}
+
 // Guard against breaking changes to the list of ignored event ack types in
 // |WebInputEventTraits::ShouldBlockEventStream|.
 TEST_F(InputRouterImplTest, RequiredEventAckTypes) {
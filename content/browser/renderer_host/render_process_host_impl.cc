@@ -20,6 +20,7 @@
 #include "base/callback.h"
 #include "base/command_line.h"
 #include "base/containers/adapters.h"
+#include "base/containers/circular_deque.h"
 #include "base/debug/alias.h"
 #include "base/debug/crash_logging.h"
 #include "base/debug/dump_without_crashing.h"
@@ -29,6 +30,7 @@
 #include "base/location.h"
 #include "base/logging.h"
 #include "base/macros.h"
+#include "base/memory/memory_pressure_monitor.h"
 #include "base/memory/ptr_util.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/shared_memory.h"
@@ -531,22 +533,37 @@ class SessionStorageHolder : public base::SupportsUserData::Data {
   DISALLOW_COPY_AND_ASSIGN(SessionStorageHolder);
 };
 
+// New processes needed during this long are used to size the pool of spare
+// RenderProcessHosts.
+constexpr base::TimeDelta kSpareDemandWindow = base::TimeDelta::FromSeconds(10);
+
+// Each spare RenderProcessHost beyond the first needs this much installed
+// memory.
+constexpr int kPhysicalMemoryPerAdditionalSpareMB = 1024;
+
 // This class manages spare RenderProcessHosts.
 //
-// There is a singleton instance of this class which manages a single spare
-// renderer (g_spare_render_process_host_manager, below). This class
+// There is a singleton instance of this class which manages a pool of spare
+// renderers (g_spare_render_process_host_manager, below). This class
 // encapsulates the implementation of
 // RenderProcessHost::WarmupSpareRenderProcessHost()
 //
 // RenderProcessHostImpl should call
 // SpareRenderProcessHostManager::MaybeTakeSpareRenderProcessHost when creating
-// a new RPH. In this implementation, the spare renderer is bound to a
+// a new RPH. In this implementation, the spare renderers are bound to a
 // BrowserContext and its default StoragePartition. If
 // MaybeTakeSpareRenderProcessHost is called with a BrowserContext that does not
-// match, the spare renderer is discarded. Only the default StoragePartition
-// will be able to use a spare renderer. The spare renderer will also not be
+// match, the spare renderers are discarded. Only the default StoragePartition
+// will be able to use a spare renderer. The spare renderers will also not be
 // used as a guest renderer (is_for_guests_ == true).
 //
+// The pool holds a single spare renderer unless a larger maximum is given with
+// --spare-renderer-process-pool-size. The pool then holds as many spares as
+// new processes were needed during the last kSpareDemandWindow, as long as
+// there is enough memory (see GetTargetPoolSize). Additional spares are
+// launched one at a time, once the previous spare is ready, so that their
+// startup doesn't compete with the navigations they are meant to speed up.
+//
 // It is safe to call WarmupSpareRenderProcessHost multiple times, although if
 // called in a context where the spare renderer is not likely to be used
 // performance may suffer due to the unnecessary RPH creation.
@@ -555,28 +572,14 @@ class SpareRenderProcessHostManager : public RenderProcessHostObserver {
   SpareRenderProcessHostManager() {}
 
   void WarmupSpareRenderProcessHost(BrowserContext* browser_context) {
-    if (spare_render_process_host_ &&
-        spare_render_process_host_->GetBrowserContext() == browser_context) {
+    RenderProcessHost* spare = spare_render_process_host();
+    if (spare && spare->GetBrowserContext() == browser_context) {
       DCHECK_EQ(BrowserContext::GetDefaultStoragePartition(browser_context),
-                spare_render_process_host_->GetStoragePartition());
-      return;  // Nothing to warm up.
+                spare->GetStoragePartition());
+    } else {
+      CleanupSpareRenderProcessHost();
     }
-
-    CleanupSpareRenderProcessHost();
-
-    // Don't create a spare renderer if we're using --single-process or if we've
-    // got too many processes. See also ShouldTryToUseExistingProcessHost in
-    // this file.
-    if (RenderProcessHost::run_renderer_in_process() ||
-        g_all_hosts.Get().size() >=
-            RenderProcessHostImpl::GetMaxRendererProcessCount())
-      return;
-
-    spare_render_process_host_ = RenderProcessHostImpl::CreateRenderProcessHost(
-        browser_context, nullptr /* storage_partition_impl */,
-        nullptr /* site_instance */, false /* is_for_guests_only */);
-    spare_render_process_host_->AddObserver(this);
-    spare_render_process_host_->Init();
+    ResizePool(browser_context);
   }
 
   RenderProcessHost* MaybeTakeSpareRenderProcessHost(
@@ -601,16 +604,20 @@ class SpareRenderProcessHostManager : public RenderProcessHostObserver {
     StoragePartition* site_storage =
         BrowserContext::GetStoragePartition(browser_context, site_instance);
 
+    // All the spares share the BrowserContext and StoragePartition of the
+    // first one.
+    RenderProcessHost* spare = spare_render_process_host();
+
     // Log UMA metrics.
     using SpareProcessMaybeTakeAction =
         RenderProcessHostImpl::SpareProcessMaybeTakeAction;
     SpareProcessMaybeTakeAction action =
         SpareProcessMaybeTakeAction::kNoSparePresent;
-    if (!spare_render_process_host_)
+    if (!spare)
       action = SpareProcessMaybeTakeAction::kNoSparePresent;
-    else if (browser_context != spare_render_process_host_->GetBrowserContext())
+    else if (browser_context != spare->GetBrowserContext())
       action = SpareProcessMaybeTakeAction::kMismatchedBrowserContext;
-    else if (site_storage != spare_render_process_host_->GetStoragePartition())
+    else if (site_storage != spare->GetStoragePartition())
       action = SpareProcessMaybeTakeAction::kMismatchedStoragePartition;
     else if (!embedder_allows_spare_usage)
       action = SpareProcessMaybeTakeAction::kRefusedByEmbedder;
@@ -621,30 +628,35 @@ class SpareRenderProcessHostManager : public RenderProcessHostObserver {
     UMA_HISTOGRAM_ENUMERATION(
         "BrowserRenderProcessHost.SpareProcessMaybeTakeAction", action);
 
+    // A spare could have been used here, had there been one left.
+    if ((action == SpareProcessMaybeTakeAction::kSpareTaken ||
+         action == SpareProcessMaybeTakeAction::kNoSparePresent) &&
+        !is_for_guests_only) {
+      RecordDemand();
+    }
+
     // Decide whether to take or drop the spare process.
     RenderProcessHost* returned_process = nullptr;
-    if (spare_render_process_host_ &&
-        browser_context == spare_render_process_host_->GetBrowserContext() &&
-        site_storage == spare_render_process_host_->GetStoragePartition() &&
-        !is_for_guests_only && embedder_allows_spare_usage &&
-        site_instance_allows_spare_usage) {
-      CHECK(spare_render_process_host_->HostHasNotBeenUsed());
+    if (spare && browser_context == spare->GetBrowserContext() &&
+        site_storage == spare->GetStoragePartition() && !is_for_guests_only &&
+        embedder_allows_spare_usage && site_instance_allows_spare_usage) {
+      CHECK(spare->HostHasNotBeenUsed());
 
       // If the spare process ends up getting killed, the spare manager should
       // discard the spare RPH, so if one exists, it should always be live here.
-      CHECK(spare_render_process_host_->IsInitializedAndNotDead());
+      CHECK(spare->IsInitializedAndNotDead());
 
       DCHECK_EQ(SpareProcessMaybeTakeAction::kSpareTaken, action);
-      returned_process = spare_render_process_host_;
-      ReleaseSpareRenderProcessHost(spare_render_process_host_);
+      returned_process = spare;
+      ReleaseSpareRenderProcessHost(spare);
     } else if (!RenderProcessHostImpl::IsSpareProcessKeptAtAllTimes()) {
-      // If the spare shouldn't be kept around, then discard it as soon as we
-      // find that the current spare was mismatched.
+      // If the spares shouldn't be kept around, then discard them as soon as
+      // we find that the current spares were mismatched.
       CleanupSpareRenderProcessHost();
     } else if (g_all_hosts.Get().size() >=
                RenderProcessHostImpl::GetMaxRendererProcessCount()) {
-      // Drop the spare if we are at a process limit and the spare wasn't taken.
-      // This helps avoid process reuse.
+      // Drop the spares if we are at a process limit and the spare wasn't
+      // taken. This helps avoid process reuse.
       CleanupSpareRenderProcessHost();
     }
 
@@ -655,50 +667,131 @@ class SpareRenderProcessHostManager : public RenderProcessHostObserver {
   // might require a new process for |browser_context|).
   //
   // Note that depending on the caller PrepareForFutureRequests can be called
-  // after the spare_render_process_host_ has either been 1) matched and taken
-  // or 2) mismatched and ignored or 3) matched and ignored.
+  // after a spare has either been 1) matched and taken or 2) mismatched and
+  // ignored or 3) matched and ignored.
   void PrepareForFutureRequests(BrowserContext* browser_context) {
     if (RenderProcessHostImpl::IsSpareProcessKeptAtAllTimes()) {
-      // Always keep around a spare process for the most recently requested
+      // Always keep around spare processes for the most recently requested
       // |browser_context|.
       WarmupSpareRenderProcessHost(browser_context);
     } else {
-      // Discard the ignored (probably non-matching) spare so as not to waste
+      // Discard the ignored (probably non-matching) spares so as not to waste
       // resources.
       CleanupSpareRenderProcessHost();
     }
   }
 
-  // Gracefully remove and cleanup a spare RenderProcessHost if it exists.
+  // Gracefully remove and cleanup all the spare RenderProcessHosts.
   void CleanupSpareRenderProcessHost() {
-    if (spare_render_process_host_) {
-      // Stop observing the process, to avoid getting notifications as a
-      // consequence of the Cleanup call below - such notification could call
-      // back into CleanupSpareRenderProcessHost leading to stack overflow.
-      spare_render_process_host_->RemoveObserver(this);
-
-      // Make sure the RenderProcessHost object gets destroyed.
-      if (!spare_render_process_host_->IsKeepAliveRefCountDisabled())
-        spare_render_process_host_->Cleanup();
-
-      // Drop reference to the RenderProcessHost object.
-      spare_render_process_host_ = nullptr;
-    }
+    while (!spare_render_process_hosts_.empty())
+      CleanupSpare(spare_render_process_hosts_.back());
   }
 
+  // Returns the spare that will be taken next, if any.
   RenderProcessHost* spare_render_process_host() {
-    return spare_render_process_host_;
+    if (spare_render_process_hosts_.empty())
+      return nullptr;
+    return spare_render_process_hosts_.front();
+  }
+
+  bool IsSpare(RenderProcessHost* host) const {
+    return base::ContainsValue(spare_render_process_hosts_, host);
   }
 
  private:
+  static size_t GetMaxPoolSize() {
+    const base::CommandLine& command_line =
+        *base::CommandLine::ForCurrentProcess();
+    size_t max_pool_size = 0;
+    if (!base::StringToSizeT(command_line.GetSwitchValueASCII(
+                                 switches::kSpareRendererProcessPoolSize),
+                             &max_pool_size)) {
+      return 1;
+    }
+    return std::max<size_t>(max_pool_size, 1);
+  }
+
+  // Returns how many spares the pool should hold.
+  size_t GetTargetPoolSize() {
+    size_t max_pool_size = GetMaxPoolSize();
+    if (max_pool_size == 1)
+      return 1;
+
+    base::TimeTicks now = base::TimeTicks::Now();
+    while (!recent_demand_.empty() &&
+           now - recent_demand_.front() > kSpareDemandWindow) {
+      recent_demand_.pop_front();
+    }
+    size_t target = std::max<size_t>(recent_demand_.size(), 1);
+
+    // Don't hold more than one spare when memory is short.
+    base::MemoryPressureMonitor* monitor = base::MemoryPressureMonitor::Get();
+    if (monitor &&
+        monitor->GetCurrentPressureLevel() !=
+            base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE) {
+      return 1;
+    }
+    size_t memory_limit = 1 + base::SysInfo::AmountOfPhysicalMemoryMB() /
+                                  kPhysicalMemoryPerAdditionalSpareMB;
+    return std::min({target, max_pool_size, memory_limit});
+  }
+
+  void RecordDemand() {
+    if (GetMaxPoolSize() > 1)
+      recent_demand_.push_back(base::TimeTicks::Now());
+  }
+
+  // Drops spares above the target size of the pool, or launches one more
+  // spare for |browser_context| if all the current spares are ready.
+  void ResizePool(BrowserContext* browser_context) {
+    size_t target_size = GetTargetPoolSize();
+    while (spare_render_process_hosts_.size() > target_size)
+      CleanupSpare(spare_render_process_hosts_.back());
+    if (spare_render_process_hosts_.size() == target_size)
+      return;
+    for (RenderProcessHost* spare : spare_render_process_hosts_) {
+      if (!spare->IsReady())
+        return;
+    }
+
+    // Don't create a spare renderer if we're using --single-process or if we've
+    // got too many processes. See also ShouldTryToUseExistingProcessHost in
+    // this file.
+    if (RenderProcessHost::run_renderer_in_process() ||
+        g_all_hosts.Get().size() >=
+            RenderProcessHostImpl::GetMaxRendererProcessCount())
+      return;
+
+    RenderProcessHost* spare = RenderProcessHostImpl::CreateRenderProcessHost(
+        browser_context, nullptr /* storage_partition_impl */,
+        nullptr /* site_instance */, false /* is_for_guests_only */);
+    spare_render_process_hosts_.push_back(spare);
+    spare->AddObserver(this);
+    spare->Init();
+  }
+
+  // Gracefully remove and cleanup |host|, which must be a spare.
+  void CleanupSpare(RenderProcessHost* host) {
+    // Stop observing the process, to avoid getting notifications as a
+    // consequence of the Cleanup call below - such notification could call
+    // back into CleanupSpareRenderProcessHost leading to stack overflow.
+    ReleaseSpareRenderProcessHost(host);
+
+    // Make sure the RenderProcessHost object gets destroyed.
+    if (!host->IsKeepAliveRefCountDisabled())
+      host->Cleanup();
+  }
+
   // Release ownership of |host| as a possible spare renderer.  Called when
   // |host| has either been 1) claimed to be used in a navigation or 2) shutdown
   // somewhere else.
   void ReleaseSpareRenderProcessHost(RenderProcessHost* host) {
-    if (spare_render_process_host_ && spare_render_process_host_ == host) {
-      spare_render_process_host_->RemoveObserver(this);
-      spare_render_process_host_ = nullptr;
-    }
+    auto it = std::find(spare_render_process_hosts_.begin(),
+                        spare_render_process_hosts_.end(), host);
+    if (it == spare_render_process_hosts_.end())
+      return;
+    host->RemoveObserver(this);
+    spare_render_process_hosts_.erase(it);
   }
 
   // RenderProcessHostObserver::RenderProcessWillExit is not overriden because:
@@ -707,19 +800,29 @@ class SpareRenderProcessHostManager : public RenderProcessHostObserver {
   // 3. Handling RenderProcessExited and RenderProcessHostDestroyed is
   //    sufficient from correctness perspective.
 
+  void RenderProcessReady(RenderProcessHost* host) override {
+    if (IsSpare(host))
+      ResizePool(host->GetBrowserContext());
+  }
+
   void RenderProcessExited(RenderProcessHost* host,
                            const ChildProcessTerminationInfo& info) override {
-    if (host == spare_render_process_host_)
-      CleanupSpareRenderProcessHost();
+    if (IsSpare(host))
+      CleanupSpare(host);
   }
 
   void RenderProcessHostDestroyed(RenderProcessHost* host) override {
     ReleaseSpareRenderProcessHost(host);
   }
 
-  // This is a bare pointer, because RenderProcessHost manages the lifetime of
-  // all its instances; see g_all_hosts, above.
-  RenderProcessHost* spare_render_process_host_ = nullptr;
+  // These are bare pointers, because RenderProcessHost manages the lifetime of
+  // all its instances; see g_all_hosts, above. Spares are taken in launch
+  // order.
+  std::vector<RenderProcessHost*> spare_render_process_hosts_;
+
+  // When new processes were needed recently, oldest first. Only recorded when
+  // the pool may hold more than one spare.
+  base::circular_deque<base::TimeTicks> recent_demand_;
 
   DISALLOW_COPY_AND_ASSIGN(SpareRenderProcessHostManager);
 };
@@ -1331,7 +1434,7 @@ int RenderProcessHost::GetCurrentRenderProcessCountForTesting() {
   while (!it.IsAtEnd()) {
     RenderProcessHost* host = it.GetCurrentValue();
     if (host->IsInitializedAndNotDead() &&
-        host != RenderProcessHostImpl::GetSpareRenderProcessHostForTesting()) {
+        !g_spare_render_process_host_manager.Get().IsSpare(host)) {
       count++;
     }
     it.Advance();
@@ -2729,6 +2832,7 @@ void RenderProcessHostImpl::PropagateBrowserCommandLineToRenderer(
     switches::kEnableMediaSuspend,
     switches::kEnableLCDText,
     switches::kEnableLogging,
+    switches::kEnableMojoTrafficStats,
     switches::kEnableNetworkInformationDownlinkMax,
     switches::kEnablePluginPlaceholderTesting,
     switches::kEnablePreciseMemoryInfo,
@@ -3563,10 +3667,9 @@ RenderProcessHost* RenderProcessHostImpl::GetExistingProcessHost(
     if (iter.GetCurrentValue()->MayReuseHost() &&
         RenderProcessHostImpl::IsSuitableHost(iter.GetCurrentValue(),
                                               browser_context, site_url)) {
-      // The spare is always considered before process reuse.
-      DCHECK_NE(iter.GetCurrentValue(),
-                g_spare_render_process_host_manager.Get()
-                    .spare_render_process_host());
+      // The spares are always considered before process reuse.
+      DCHECK(!g_spare_render_process_host_manager.Get().IsSpare(
+          iter.GetCurrentValue()));
 
       suitable_renderers.push_back(iter.GetCurrentValue());
     }
@@ -12,6 +12,7 @@
 #include "base/macros.h"
 #include "base/run_loop.h"
 #include "base/test/metrics/histogram_tester.h"
+#include "base/test/scoped_command_line.h"
 #include "build/build_config.h"
 #include "content/common/frame_messages.h"
 #include "content/common/frame_owner_properties.h"
@@ -1074,6 +1075,22 @@ TEST_F(SpareRenderProcessHostUnitTest,
     EXPECT_FALSE(new_spare);
 }
 
+// Spares beyond the first are only launched once the previous spare is ready,
+// which mock processes never are.
+TEST_F(SpareRenderProcessHostUnitTest, PoolLaunchesOneSpareAtATime) {
+  base::test::ScopedCommandLine scoped_command_line;
+  scoped_command_line.GetProcessCommandLine()->AppendSwitchASCII(
+      switches::kSpareRendererProcessPoolSize, "3");
+
+  RenderProcessHost::WarmupSpareRenderProcessHost(browser_context());
+  RenderProcessHost::WarmupSpareRenderProcessHost(browser_context());
+  ASSERT_EQ(1U, rph_factory_.GetProcesses()->size());
+  EXPECT_EQ(rph_factory_.GetProcesses()->at(0).get(),
+            RenderProcessHostImpl::GetSpareRenderProcessHostForTesting());
+  EXPECT_FALSE(RenderProcessHostImpl::GetSpareRenderProcessHostForTesting()
+                   ->IsReady());
+}
+
 // This unit test looks at the simplified equivalent of what
 // CtrlClickShouldEndUpInSameProcessTest.BlankTarget test would have
 // encountered.  The test verifies that the spare RPH is not launched if 1) we
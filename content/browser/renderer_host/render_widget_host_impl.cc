@@ -2305,6 +2305,11 @@ bool RenderWidgetHostImpl::IsWheelScrollInProgress() {
   return is_in_gesture_scroll_[blink::kWebGestureDeviceTouchpad];
 }
 
+void RenderWidgetHostImpl::SetNeedsBeginFrameForBatchedInput() {
+  batched_input_needs_begin_frame_ = true;
+  SetNeedsBeginFrame(true);
+}
+
 void RenderWidgetHostImpl::OnInvalidFrameToken(uint32_t frame_token) {
   bad_message::ReceivedBadMessage(GetProcess(),
                                   bad_message::RWH_INVALID_FRAME_TOKEN);
@@ -2869,7 +2874,9 @@ void RenderWidgetHostImpl::SetNeedsBeginFrame(bool needs_begin_frames) {
   if (needs_begin_frames_ == needs_begin_frames)
     return;
 
-  needs_begin_frames_ = needs_begin_frames || browser_fling_needs_begin_frame_;
+  needs_begin_frames_ = needs_begin_frames ||
+                        browser_fling_needs_begin_frame_ ||
+                        batched_input_needs_begin_frame_;
   if (view_)
     view_->SetNeedsBeginFrames(needs_begin_frames_);
 }
@@ -3092,6 +3099,13 @@ void RenderWidgetHostImpl::ProgressFlingIfNeeded(TimeTicks current_time) {
   fling_scheduler_->ProgressFlingOnBeginFrameIfneeded(current_time);
 }
 
+void RenderWidgetHostImpl::DispatchBatchedInputIfNeeded(TimeTicks frame_time) {
+  if (!batched_input_needs_begin_frame_)
+    return;
+  batched_input_needs_begin_frame_ = false;
+  input_router_->DispatchBatchedInput(frame_time);
+}
+
 void RenderWidgetHostImpl::DidReceiveFirstFrameAfterNavigation() {
   DCHECK(enable_surface_synchronization_);
   did_receive_first_frame_after_navigation_ = true;
@@ -678,6 +678,7 @@ class CONTENT_EXPORT RenderWidgetHostImpl
       const std::vector<gfx::Rect>& character_bounds) override;
   void OnImeCancelComposition() override;
   bool IsWheelScrollInProgress() override;
+  void SetNeedsBeginFrameForBatchedInput() override;
 
   // FrameTokenMessageQueue::Client:
   void OnInvalidFrameToken(uint32_t frame_token) override;
@@ -685,6 +686,8 @@ class CONTENT_EXPORT RenderWidgetHostImpl
   void OnProcessSwapMessage(const IPC::Message& message) override;
 
   void ProgressFlingIfNeeded(base::TimeTicks current_time);
+  // Sends the input events batched by the input router on a BeginFrame.
+  void DispatchBatchedInputIfNeeded(base::TimeTicks frame_time);
   void StopFling();
   bool FlingCancellationIsDeferred() const;
   void SetNeedsBeginFrameForFlingProgress();
@@ -1108,6 +1111,8 @@ class CONTENT_EXPORT RenderWidgetHostImpl
   // This is used to make sure that when the fling controller sets
   // needs_begin_frames_ it doesn't get overriden by the renderer.
   bool browser_fling_needs_begin_frame_ = false;
+  // Likewise for the input router's batched input.
+  bool batched_input_needs_begin_frame_ = false;
 
   // This value indicates how long to wait before we consider a renderer hung.
   base::TimeDelta hung_renderer_delay_;
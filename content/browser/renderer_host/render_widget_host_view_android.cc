@@ -2132,6 +2132,8 @@ void RenderWidgetHostViewAndroid::OnBeginFrame(
     return;
   }
 
+  host_->DispatchBatchedInputIfNeeded(args.frame_time);
+
   bool webview_fling = sync_compositor_ && is_currently_scrolling_viewport_;
   if (!webview_fling) {
     host_->ProgressFlingIfNeeded(args.frame_time);
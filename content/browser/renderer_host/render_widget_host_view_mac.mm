@@ -82,8 +82,10 @@ SkColor RenderWidgetHostViewMac::BrowserCompositorMacGetGutterColor() const {
 void RenderWidgetHostViewMac::BrowserCompositorMacOnBeginFrame(
     base::TimeTicks frame_time) {
   // ProgressFling must get called for middle click autoscroll fling on Mac.
-  if (host())
+  if (host()) {
+    host()->DispatchBatchedInputIfNeeded(frame_time);
     host()->ProgressFlingIfNeeded(frame_time);
+  }
   UpdateNeedsBeginFramesInternal();
 }
 
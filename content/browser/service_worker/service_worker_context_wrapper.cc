@@ -1092,6 +1092,9 @@ void ServiceWorkerContextWrapper::DidFindRegistrationForNavigationHint(
     return;
   }
 
+  // Start reading the imported scripts while the main script is read and
+  // evaluated, rather than after.
+  registration->active_version()->PreloadInstalledScripts();
   registration->active_version()->StartWorker(
       ServiceWorkerMetrics::EventType::NAVIGATION_HINT,
       base::BindOnce(
@@ -9,6 +9,7 @@
 
 #include "base/metrics/histogram_functions.h"
 #include "base/metrics/histogram_macros.h"
+#include "base/numerics/safe_conversions.h"
 #include "base/strings/string_util.h"
 #include "base/time/time.h"
 #include "content/browser/service_worker/embedded_worker_status.h"
@@ -507,6 +508,13 @@ void ServiceWorkerMetrics::RecordInstalledScriptsSenderStatus(
       ServiceWorkerInstalledScriptReader::FinishedReason::kMaxValue);
 }
 
+void ServiceWorkerMetrics::RecordScriptCachePreload(base::TimeDelta time,
+                                                    int64_t bytes) {
+  UMA_HISTOGRAM_MEDIUM_TIMES("ServiceWorker.ScriptCachePreload.Time", time);
+  UMA_HISTOGRAM_COUNTS_10M("ServiceWorker.ScriptCachePreload.Bytes",
+                           base::saturated_cast<int>(bytes));
+}
+
 void ServiceWorkerMetrics::RecordStartWorkerTime(base::TimeDelta time,
                                                  bool is_installed,
                                                  StartSituation start_situation,
@@ -274,6 +274,10 @@ class ServiceWorkerMetrics {
   static void RecordInstalledScriptsSenderStatus(
       ServiceWorkerInstalledScriptReader::FinishedReason reason);
 
+  // Records the time taken to read a worker's installed scripts ahead of its
+  // start, and the bytes read.
+  static void RecordScriptCachePreload(base::TimeDelta time, int64_t bytes);
+
   // Records the time taken to successfully start a worker. |is_installed|
   // indicates whether the version has been installed.
   static void RecordStartWorkerTime(base::TimeDelta time,
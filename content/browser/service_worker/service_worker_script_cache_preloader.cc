@@ -0,0 +1,115 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/browser/service_worker/service_worker_script_cache_preloader.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/trace_event/trace_event.h"
+#include "content/browser/service_worker/service_worker_disk_cache.h"
+#include "content/browser/service_worker/service_worker_metrics.h"
+#include "content/browser/service_worker/service_worker_storage.h"
+#include "net/base/io_buffer.h"
+#include "net/http/http_response_info.h"
+
+namespace content {
+
+namespace {
+
+const int kReadBufferSize = 32 * 1024;
+
+}  // namespace
+
+ServiceWorkerScriptCachePreloader::ServiceWorkerScriptCachePreloader(
+    ServiceWorkerStorage* storage,
+    const std::vector<int64_t>& resource_ids,
+    base::OnceClosure done)
+    : done_(std::move(done)), weak_factory_(this) {
+  for (int64_t resource_id : resource_ids)
+    readers_.push_back(storage->CreateResponseReader(resource_id));
+  buffers_.resize(readers_.size());
+}
+
+ServiceWorkerScriptCachePreloader::~ServiceWorkerScriptCachePreloader() {
+  if (pending_reads_) {
+    TRACE_EVENT_NESTABLE_ASYNC_END1("ServiceWorker",
+                                    "ServiceWorkerScriptCachePreloader", this,
+                                    "result", "Cancelled");
+  }
+}
+
+void ServiceWorkerScriptCachePreloader::Start() {
+  DCHECK(!pending_reads_);
+  DCHECK(start_time_.is_null());
+  TRACE_EVENT_NESTABLE_ASYNC_BEGIN1("ServiceWorker",
+                                    "ServiceWorkerScriptCachePreloader", this,
+                                    "scripts", readers_.size());
+  start_time_ = base::TimeTicks::Now();
+  pending_reads_ = readers_.size();
+  if (!pending_reads_) {
+    OnScriptRead(0);
+    return;
+  }
+  for (size_t i = 0; i < readers_.size(); ++i) {
+    auto info = base::MakeRefCounted<HttpResponseInfoIOBuffer>();
+    readers_[i]->ReadInfo(
+        info.get(),
+        base::BindOnce(&ServiceWorkerScriptCachePreloader::OnReadInfoComplete,
+                       weak_factory_.GetWeakPtr(), i, info));
+  }
+}
+
+void ServiceWorkerScriptCachePreloader::OnReadInfoComplete(
+    size_t index,
+    scoped_refptr<HttpResponseInfoIOBuffer> info,
+    int result) {
+  if (result < 0 || !info->http_info) {
+    OnScriptRead(index);
+    return;
+  }
+  bytes_read_ += result;
+  if (info->http_info->metadata)
+    bytes_read_ += info->http_info->metadata->size();
+  buffers_[index] = base::MakeRefCounted<net::IOBuffer>(kReadBufferSize);
+  ReadNextData(index);
+}
+
+void ServiceWorkerScriptCachePreloader::ReadNextData(size_t index) {
+  readers_[index]->ReadData(
+      buffers_[index].get(), kReadBufferSize,
+      base::BindOnce(&ServiceWorkerScriptCachePreloader::OnReadDataComplete,
+                     weak_factory_.GetWeakPtr(), index));
+}
+
+void ServiceWorkerScriptCachePreloader::OnReadDataComplete(size_t index,
+                                                           int result) {
+  if (result <= 0) {
+    // Done, or failed. Either way the worker's own read will tell.
+    OnScriptRead(index);
+    return;
+  }
+  bytes_read_ += result;
+  ReadNextData(index);
+}
+
+void ServiceWorkerScriptCachePreloader::OnScriptRead(size_t index) {
+  if (index < readers_.size()) {
+    readers_[index].reset();
+    buffers_[index] = nullptr;
+    DCHECK_GT(pending_reads_, 0u);
+    if (--pending_reads_)
+      return;
+  }
+
+  TRACE_EVENT_NESTABLE_ASYNC_END1("ServiceWorker",
+                                  "ServiceWorkerScriptCachePreloader", this,
+                                  "bytes_read", bytes_read_);
+  ServiceWorkerMetrics::RecordScriptCachePreload(
+      base::TimeTicks::Now() - start_time_, bytes_read_);
+  // May delete |this|.
+  std::move(done_).Run();
+}
+
+}  // namespace content
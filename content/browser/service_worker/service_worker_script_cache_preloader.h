@@ -0,0 +1,74 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CONTENT_BROWSER_SERVICE_WORKER_SERVICE_WORKER_SCRIPT_CACHE_PRELOADER_H_
+#define CONTENT_BROWSER_SERVICE_WORKER_SERVICE_WORKER_SCRIPT_CACHE_PRELOADER_H_
+
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "content/common/content_export.h"
+
+namespace net {
+class IOBuffer;
+}
+
+namespace content {
+
+struct HttpResponseInfoIOBuffer;
+class ServiceWorkerResponseReader;
+class ServiceWorkerStorage;
+
+// ServiceWorkerScriptCachePreloader reads installed scripts, with their
+// headers and V8 code cache, from the disk cache ahead of a predicted start of
+// their worker. On startup ServiceWorkerInstalledScriptsSender reads the
+// scripts one at a time, paying the disk latency once per script; reading
+// them all at once beforehand lets those reads be served from memory.
+//
+// The data read is discarded. |done| is run once every read has finished,
+// successfully or not.
+class CONTENT_EXPORT ServiceWorkerScriptCachePreloader {
+ public:
+  ServiceWorkerScriptCachePreloader(ServiceWorkerStorage* storage,
+                                    const std::vector<int64_t>& resource_ids,
+                                    base::OnceClosure done);
+  ~ServiceWorkerScriptCachePreloader();
+
+  void Start();
+
+  // Total bytes of headers, code cache and bodies read so far.
+  int64_t bytes_read() const { return bytes_read_; }
+
+ private:
+  void OnReadInfoComplete(size_t index,
+                          scoped_refptr<HttpResponseInfoIOBuffer> info,
+                          int result);
+  void ReadNextData(size_t index);
+  void OnReadDataComplete(size_t index, int result);
+  void OnScriptRead(size_t index);
+
+  // One reader and buffer per script, all reading at the same time. The
+  // reader is dropped once the script is read.
+  std::vector<std::unique_ptr<ServiceWorkerResponseReader>> readers_;
+  std::vector<scoped_refptr<net::IOBuffer>> buffers_;
+  size_t pending_reads_ = 0;
+  int64_t bytes_read_ = 0;
+  base::TimeTicks start_time_;
+  base::OnceClosure done_;
+
+  base::WeakPtrFactory<ServiceWorkerScriptCachePreloader> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(ServiceWorkerScriptCachePreloader);
+};
+
+}  // namespace content
+
+#endif  // CONTENT_BROWSER_SERVICE_WORKER_SERVICE_WORKER_SCRIPT_CACHE_PRELOADER_H_
@@ -0,0 +1,79 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/browser/service_worker/service_worker_script_cache_preloader.h"
+
+#include <string>
+#include <vector>
+
+#include "base/run_loop.h"
+#include "base/test/metrics/histogram_tester.h"
+#include "content/browser/service_worker/embedded_worker_test_helper.h"
+#include "content/browser/service_worker/service_worker_context_core.h"
+#include "content/browser/service_worker/service_worker_storage.h"
+#include "content/browser/service_worker/service_worker_test_utils.h"
+#include "content/public/test/test_browser_thread_bundle.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace content {
+
+class ServiceWorkerScriptCachePreloaderTest : public testing::Test {
+ public:
+  ServiceWorkerScriptCachePreloaderTest()
+      : thread_bundle_(TestBrowserThreadBundle::IO_MAINLOOP) {}
+
+ protected:
+  void SetUp() override {
+    helper_ = std::make_unique<EmbeddedWorkerTestHelper>(base::FilePath());
+    storage()->LazyInitializeForTest(base::DoNothing());
+    base::RunLoop().RunUntilIdle();
+  }
+
+  void TearDown() override { helper_.reset(); }
+
+  ServiceWorkerStorage* storage() { return helper_->context()->storage(); }
+
+  // Runs a preloader for |resource_ids| to completion and returns the bytes
+  // it read.
+  int64_t Preload(const std::vector<int64_t>& resource_ids) {
+    base::RunLoop loop;
+    ServiceWorkerScriptCachePreloader preloader(storage(), resource_ids,
+                                                loop.QuitClosure());
+    preloader.Start();
+    loop.Run();
+    return preloader.bytes_read();
+  }
+
+ private:
+  TestBrowserThreadBundle thread_bundle_;
+  std::unique_ptr<EmbeddedWorkerTestHelper> helper_;
+};
+
+TEST_F(ServiceWorkerScriptCachePreloaderTest, ReadsAllScripts) {
+  std::string long_body(100 * 1024, 'x');
+  const std::string kMetaData = "code cache";
+  WriteToDiskCacheSync(storage(), GURL("https://example.com/imported1"), 1,
+                       {{"Content-Type", "text/javascript"}}, long_body,
+                       kMetaData);
+  WriteToDiskCacheSync(storage(), GURL("https://example.com/imported2"), 2,
+                       {{"Content-Type", "text/javascript"}}, "body", "");
+
+  base::HistogramTester histogram_tester;
+  const int64_t bytes_read = Preload({1, 2});
+  // Bodies and code cache, plus the headers.
+  EXPECT_GT(bytes_read,
+            static_cast<int64_t>(long_body.size() + kMetaData.size() + 4));
+  histogram_tester.ExpectTotalCount("ServiceWorker.ScriptCachePreload.Time", 1);
+}
+
+TEST_F(ServiceWorkerScriptCachePreloaderTest, MissingScript) {
+  WriteToDiskCacheSync(storage(), GURL("https://example.com/imported1"), 1,
+                       {{"Content-Type", "text/javascript"}}, "body", "");
+
+  // The missing script doesn't keep the others from being read.
+  EXPECT_GT(Preload({1, 3}), 4);
+  EXPECT_EQ(0, Preload({3}));
+}
+
+}  // namespace content
@@ -30,6 +30,7 @@
 #include "content/browser/service_worker/service_worker_context_wrapper.h"
 #include "content/browser/service_worker/service_worker_installed_scripts_sender.h"
 #include "content/browser/service_worker/service_worker_registration.h"
+#include "content/browser/service_worker/service_worker_script_cache_preloader.h"
 #include "content/browser/service_worker/service_worker_type_converters.h"
 #include "content/common/service_worker/embedded_worker.mojom.h"
 #include "content/common/service_worker/service_worker_messages.h"
@@ -481,6 +482,34 @@ void ServiceWorkerVersion::set_fetch_handler_existence(
     site_for_uma_ = ServiceWorkerMetrics::Site::WITHOUT_FETCH_HANDLER;
 }
 
+void ServiceWorkerVersion::PreloadInstalledScripts() {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  if (!context_ || !IsInstalled(status()) || script_cache_preloader_)
+    return;
+
+  std::vector<ServiceWorkerDatabase::ResourceRecord> resources;
+  script_cache_map_.GetResources(&resources);
+  std::vector<int64_t> resource_ids;
+  for (const auto& resource : resources) {
+    // The main script is read first thing on startup anyway.
+    if (resource.url != script_url_)
+      resource_ids.push_back(resource.resource_id);
+  }
+  if (resource_ids.empty())
+    return;
+
+  // Unretained is safe since |this| owns the preloader.
+  script_cache_preloader_ = std::make_unique<ServiceWorkerScriptCachePreloader>(
+      context_->storage(), resource_ids,
+      base::BindOnce(&ServiceWorkerVersion::OnInstalledScriptsPreloaded,
+                     base::Unretained(this)));
+  script_cache_preloader_->Start();
+}
+
+void ServiceWorkerVersion::OnInstalledScriptsPreloaded() {
+  script_cache_preloader_.reset();
+}
+
 void ServiceWorkerVersion::StartWorker(ServiceWorkerMetrics::EventType purpose,
                                        StatusCallback callback) {
   TRACE_EVENT_INSTANT2(
@@ -57,6 +57,7 @@ namespace content {
 
 class ServiceWorkerContextCore;
 class ServiceWorkerInstalledScriptsSender;
+class ServiceWorkerScriptCachePreloader;
 class ServiceWorkerProviderHost;
 class ServiceWorkerRegistration;
 struct ServiceWorkerVersionInfo;
@@ -235,6 +236,12 @@ class CONTENT_EXPORT ServiceWorkerVersion
   void StartWorker(ServiceWorkerMetrics::EventType purpose,
                    StatusCallback callback);
 
+  // Reads the installed scripts other than the main script from the disk
+  // cache all at once, so that starting the worker doesn't wait for them one
+  // by one. Called when a start of this installed version is predicted. Does
+  // nothing if a preload is already in progress.
+  void PreloadInstalledScripts();
+
   // Stops an embedded worker for this version.
   void StopWorker(base::OnceClosure callback);
 
@@ -664,6 +671,7 @@ class CONTENT_EXPORT ServiceWorkerVersion
       ServiceWorkerStatusCode status,
       scoped_refptr<ServiceWorkerRegistration> registration);
   void StartWorkerInternal();
+  void OnInstalledScriptsPreloaded();
 
   // Callback function for simple events dispatched through mojo interface
   // mojom::ServiceWorkerEventDispatcher. Use CreateSimpleEventCallback() to
@@ -776,6 +784,7 @@ class CONTENT_EXPORT ServiceWorkerVersion
 
   std::unique_ptr<ServiceWorkerInstalledScriptsSender>
       installed_scripts_sender_;
+  std::unique_ptr<ServiceWorkerScriptCachePreloader> script_cache_preloader_;
 
   std::vector<SkipWaitingCallback> pending_skip_waiting_requests_;
   base::TimeTicks skip_waiting_time_;
@@ -4,47 +4,275 @@
 
 #include "content/browser/startup_task_runner.h"
 
+#include <algorithm>
+#include <string>
+#include <utility>
+
 #include "base/bind.h"
 #include "base/location.h"
+#include "base/strings/stringprintf.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/task_scheduler/post_task.h"
+#include "base/trace_event/trace_event.h"
 
 namespace content {
 
+class StartupTaskRunner::BackgroundTaskState
+    : public base::RefCountedThreadSafe<BackgroundTaskState> {
+ public:
+  BackgroundTaskState()
+      : done(base::WaitableEvent::ResetPolicy::MANUAL,
+             base::WaitableEvent::InitialState::NOT_SIGNALED) {}
+
+  base::WaitableEvent done;
+  // Written before |done| is signaled.
+  base::TimeTicks start_time;
+  base::TimeTicks end_time;
+
+ private:
+  friend class base::RefCountedThreadSafe<BackgroundTaskState>;
+  ~BackgroundTaskState() = default;
+
+  DISALLOW_COPY_AND_ASSIGN(BackgroundTaskState);
+};
+
+StartupTaskRunner::Task::Task() : name(nullptr), done(false) {}
+
+StartupTaskRunner::Task::Task(Task&&) = default;
+
+StartupTaskRunner::Task::~Task() = default;
+
 StartupTaskRunner::StartupTaskRunner(
     base::Callback<void(int)> const startup_complete_callback,
     scoped_refptr<base::SingleThreadTaskRunner> proxy)
-    : startup_complete_callback_(startup_complete_callback), proxy_(proxy) {}
+    : running_async_(false),
+      wrapped_task_posted_(false),
+      startup_completed_(false),
+      startup_complete_callback_(startup_complete_callback),
+      proxy_(proxy),
+      weak_factory_(this) {}
 
 StartupTaskRunner::~StartupTaskRunner() {}
 
-void StartupTaskRunner::AddTask(StartupTask callback) {
-  task_list_.push_back(callback);
+StartupTaskId StartupTaskRunner::AddTask(StartupTask callback) {
+  return AddTask("StartupTask", std::move(callback));
+}
+
+StartupTaskId StartupTaskRunner::AddTask(const char* name,
+                                         StartupTask callback) {
+  Task task;
+  task.name = name;
+  task.callback = std::move(callback);
+  // UI thread tasks run in the order they are added.
+  for (StartupTaskId id = tasks_.size(); id > 0; --id) {
+    if (!IsBackgroundTask(id - 1)) {
+      task.prerequisites.push_back(id - 1);
+      break;
+    }
+  }
+  tasks_.push_back(std::move(task));
+  task_list_.push_back(tasks_.size() - 1);
+  return tasks_.size() - 1;
+}
+
+StartupTaskId StartupTaskRunner::AddBackgroundTask(
+    const char* name,
+    base::OnceClosure callback,
+    const std::vector<StartupTaskId>& prerequisites) {
+  Task task;
+  task.name = name;
+  task.background_callback = std::move(callback);
+  task.background_state = base::MakeRefCounted<BackgroundTaskState>();
+  for (StartupTaskId prerequisite : prerequisites) {
+    DCHECK_LT(prerequisite, tasks_.size());
+    DCHECK(!IsBackgroundTask(prerequisite));
+  }
+  task.prerequisites = prerequisites;
+  tasks_.push_back(std::move(task));
+  return tasks_.size() - 1;
+}
+
+void StartupTaskRunner::AddPrerequisite(StartupTaskId task,
+                                        StartupTaskId prerequisite) {
+  DCHECK_LT(task, tasks_.size());
+  DCHECK_LT(prerequisite, task);
+  DCHECK(!IsBackgroundTask(task));
+  DCHECK(!IsDone(task));
+  tasks_[task].prerequisites.push_back(prerequisite);
 }
 
 void StartupTaskRunner::StartRunningTasksAsync() {
   DCHECK(proxy_.get());
+  running_async_ = true;
+  PostReadyBackgroundTasks();
+  if (task_list_.empty())
+    MaybeCompleteStartup(0);
+  else
+    PostWrappedTask();
+}
+
+void StartupTaskRunner::RunAllTasksNow() {
+  PostReadyBackgroundTasks();
   int result = 0;
-  if (task_list_.empty()) {
-    if (!startup_complete_callback_.is_null()) {
-      startup_complete_callback_.Run(result);
-      // Clear the callback to prevent it being called a second time
-      startup_complete_callback_.Reset();
+  while (!task_list_.empty()) {
+    StartupTaskId id = task_list_.front();
+    task_list_.pop_front();
+    result = RunTask(id);
+    if (result > 0) {
+      task_list_.clear();
+      break;
+    }
+  }
+  if (result == 0) {
+    for (const Task& task : tasks_) {
+      if (task.background_state && task.background_callback.is_null())
+        task.background_state->done.Wait();
     }
-  } else {
-    const base::Closure next_task =
-        base::Bind(&StartupTaskRunner::WrappedTask, base::Unretained(this));
-    proxy_->PostNonNestableTask(FROM_HERE, next_task);
   }
+  MaybeCompleteStartup(result);
 }
 
-void StartupTaskRunner::RunAllTasksNow() {
-  int result = 0;
-  for (std::list<StartupTask>::iterator it = task_list_.begin();
-       it != task_list_.end();
-       it++) {
-    result = it->Run();
-    if (result > 0) break;
+std::vector<const char*> StartupTaskRunner::GetCriticalPath() const {
+  std::vector<const char*> names;
+  for (StartupTaskId id : GetCriticalPathIds())
+    names.push_back(tasks_[id].name);
+  return names;
+}
+
+// static
+void StartupTaskRunner::RunBackgroundTask(
+    const char* name,
+    base::OnceClosure callback,
+    scoped_refptr<BackgroundTaskState> state,
+    scoped_refptr<base::SingleThreadTaskRunner> reply_task_runner,
+    base::OnceClosure reply) {
+  {
+    TRACE_EVENT0("startup", name);
+    state->start_time = base::TimeTicks::Now();
+    std::move(callback).Run();
+    state->end_time = base::TimeTicks::Now();
   }
-  task_list_.clear();
+  state->done.Signal();
+  if (reply_task_runner)
+    reply_task_runner->PostTask(FROM_HERE, std::move(reply));
+}
+
+bool StartupTaskRunner::IsBackgroundTask(StartupTaskId id) const {
+  return !!tasks_[id].background_state;
+}
+
+bool StartupTaskRunner::IsDone(StartupTaskId id) const {
+  if (IsBackgroundTask(id))
+    return tasks_[id].background_state->done.IsSignaled();
+  return tasks_[id].done;
+}
+
+base::TimeTicks StartupTaskRunner::GetStartTime(StartupTaskId id) const {
+  if (IsBackgroundTask(id))
+    return tasks_[id].background_state->start_time;
+  return tasks_[id].start_time;
+}
+
+base::TimeTicks StartupTaskRunner::GetEndTime(StartupTaskId id) const {
+  if (IsBackgroundTask(id))
+    return tasks_[id].background_state->end_time;
+  return tasks_[id].end_time;
+}
+
+bool StartupTaskRunner::PrerequisitesAreDone(StartupTaskId id) const {
+  for (StartupTaskId prerequisite : tasks_[id].prerequisites) {
+    if (!IsDone(prerequisite))
+      return false;
+  }
+  return true;
+}
+
+std::vector<StartupTaskId> StartupTaskRunner::GetCriticalPathIds() const {
+  std::vector<StartupTaskId> path;
+  if (tasks_.empty())
+    return path;
+  for (StartupTaskId id = 0; id < tasks_.size(); ++id) {
+    if (!IsDone(id))
+      return path;
+  }
+
+  // Walk back from the task which ended last, each time to the prerequisite
+  // which ended last. Ties go to the prerequisite added last, which started
+  // after the others.
+  StartupTaskId id = 0;
+  for (StartupTaskId candidate = 1; candidate < tasks_.size(); ++candidate) {
+    if (GetEndTime(candidate) >= GetEndTime(id))
+      id = candidate;
+  }
+  while (true) {
+    path.push_back(id);
+    const std::vector<StartupTaskId>& prerequisites = tasks_[id].prerequisites;
+    if (prerequisites.empty())
+      break;
+    id = prerequisites.front();
+    for (StartupTaskId prerequisite : prerequisites) {
+      if (GetEndTime(prerequisite) >= GetEndTime(id))
+        id = prerequisite;
+    }
+  }
+  std::reverse(path.begin(), path.end());
+  return path;
+}
+
+int StartupTaskRunner::RunTask(StartupTaskId id) {
+  Task& task = tasks_[id];
+  for (StartupTaskId prerequisite : task.prerequisites) {
+    if (!IsBackgroundTask(prerequisite) || IsDone(prerequisite))
+      continue;
+    TRACE_EVENT1("startup", "StartupTaskRunner::WaitForBackgroundTask", "task",
+                 tasks_[prerequisite].name);
+    tasks_[prerequisite].background_state->done.Wait();
+  }
+  task.start_time = base::TimeTicks::Now();
+  int result = task.callback.Run();
+  task.end_time = base::TimeTicks::Now();
+  task.done = true;
+  if (result == 0)
+    PostReadyBackgroundTasks();
+  return result;
+}
+
+void StartupTaskRunner::PostReadyBackgroundTasks() {
+  for (StartupTaskId id = 0; id < tasks_.size(); ++id) {
+    Task& task = tasks_[id];
+    if (task.background_callback.is_null() || !PrerequisitesAreDone(id))
+      continue;
+    base::PostTaskWithTraits(
+        FROM_HERE, {base::MayBlock(), base::TaskPriority::USER_BLOCKING},
+        base::BindOnce(&StartupTaskRunner::RunBackgroundTask, task.name,
+                       std::move(task.background_callback),
+                       task.background_state, proxy_,
+                       base::BindOnce(&StartupTaskRunner::OnBackgroundTaskDone,
+                                      weak_factory_.GetWeakPtr())));
+  }
+}
+
+void StartupTaskRunner::OnBackgroundTaskDone() {
+  if (!task_list_.empty()) {
+    // The next UI thread task may have been waiting for this one.
+    if (running_async_)
+      PostWrappedTask();
+    return;
+  }
+  MaybeCompleteStartup(0);
+}
+
+void StartupTaskRunner::MaybeCompleteStartup(int result) {
+  if (startup_completed_)
+    return;
+  if (result == 0) {
+    for (const Task& task : tasks_) {
+      if (task.background_state && !task.background_state->done.IsSignaled())
+        return;
+    }
+    ReportCriticalPath();
+  }
+  startup_completed_ = true;
   if (!startup_complete_callback_.is_null()) {
     startup_complete_callback_.Run(result);
     // Clear the callback to prevent it being called a second time
@@ -52,30 +280,56 @@ void StartupTaskRunner::RunAllTasksNow() {
   }
 }
 
+void StartupTaskRunner::ReportCriticalPath() const {
+  std::vector<StartupTaskId> path = GetCriticalPathIds();
+  if (path.empty())
+    return;
+  std::string tasks;
+  for (StartupTaskId id : path) {
+    if (!tasks.empty())
+      tasks += " > ";
+    base::StringAppendF(
+        &tasks, "%s (%.1f ms)", tasks_[id].name,
+        (GetEndTime(id) - GetStartTime(id)).InMillisecondsF());
+  }
+  TRACE_EVENT_INSTANT2(
+      "startup", "StartupTaskRunner::CriticalPath", TRACE_EVENT_SCOPE_THREAD,
+      "tasks", tasks, "duration_ms",
+      (GetEndTime(path.back()) - GetStartTime(path.front())).InMillisecondsF());
+}
+
+void StartupTaskRunner::PostWrappedTask() {
+  if (wrapped_task_posted_)
+    return;
+  wrapped_task_posted_ = true;
+  const base::Closure next_task =
+      base::Bind(&StartupTaskRunner::WrappedTask, base::Unretained(this));
+  proxy_->PostNonNestableTask(FROM_HERE, next_task);
+}
+
 void StartupTaskRunner::WrappedTask() {
+  wrapped_task_posted_ = false;
   if (task_list_.empty()) {
     // This will happen if the remaining tasks have been run synchronously since
     // the WrappedTask was created. Any callback will already have been called,
     // so there is nothing to do
     return;
   }
-  int result = task_list_.front().Run();
+  // Wait for the background tasks this one depends on. OnBackgroundTaskDone()
+  // posts this again.
+  if (!PrerequisitesAreDone(task_list_.front()))
+    return;
+  StartupTaskId id = task_list_.front();
   task_list_.pop_front();
+  int result = RunTask(id);
   if (result > 0) {
     // Stop now and throw away the remaining tasks
     task_list_.clear();
   }
-  if (task_list_.empty()) {
-    if (!startup_complete_callback_.is_null()) {
-      startup_complete_callback_.Run(result);
-      // Clear the callback to prevent it being called a second time
-      startup_complete_callback_.Reset();
-    }
-  } else {
-    const base::Closure next_task =
-        base::Bind(&StartupTaskRunner::WrappedTask, base::Unretained(this));
-    proxy_->PostNonNestableTask(FROM_HERE, next_task);
-  }
+  if (task_list_.empty())
+    MaybeCompleteStartup(result);
+  else
+    PostWrappedTask();
 }
 
 }  // namespace content
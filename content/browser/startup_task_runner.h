@@ -6,10 +6,14 @@
 #define CONTENT_BROWSER_STARTUP_TASK_RUNNER_H_
 
 #include <list>
+#include <vector>
 
 #include "base/callback.h"
 #include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
 #include "base/single_thread_task_runner.h"
+#include "base/time/time.h"
 
 #include "build/build_config.h"
 
@@ -22,6 +26,9 @@ namespace content {
 // be run.
 typedef base::Callback<int(void)> StartupTask;
 
+// Identifies a task added to a StartupTaskRunner.
+typedef size_t StartupTaskId;
+
 // This class runs startup tasks. The tasks are either run immediately inline,
 // or are queued one at a time on the UI thread's message loop. If the events
 // are queued, UI events that are received during startup will be acted upon
@@ -31,6 +38,13 @@ typedef base::Callback<int(void)> StartupTask;
 // Note that this differs from a SingleThreadedTaskRunner in that there may be
 // no opportunity to handle UI events between the tasks of a
 // SingleThreadedTaskRunner.
+//
+// Startup work which doesn't need the UI thread can be added with
+// AddBackgroundTask(). Such tasks run on the task scheduler, in parallel with
+// each other and with the UI thread tasks, as soon as the UI thread tasks they
+// depend on have run. UI thread tasks which need their results declare it with
+// AddPrerequisite(). Once all the tasks have run, the critical path through
+// this dependency graph is reported to tracing.
 
 class CONTENT_EXPORT StartupTaskRunner {
 
@@ -42,8 +56,25 @@ class CONTENT_EXPORT StartupTaskRunner {
 
   ~StartupTaskRunner();
 
-  // Add a task to the queue of startup tasks to be run.
-  void AddTask(StartupTask callback);
+  // Add a task to the queue of startup tasks to be run. It runs after the
+  // tasks added before it, and after its prerequisites. |name| is used for
+  // tracing and must outlive the runner.
+  StartupTaskId AddTask(StartupTask callback);
+  StartupTaskId AddTask(const char* name, StartupTask callback);
+
+  // Adds a task to be run on the task scheduler once all of |prerequisites|,
+  // which must be UI thread tasks, have run. Background tasks without
+  // prerequisites are posted when the runner starts; they only run once the
+  // task scheduler has been started.
+  StartupTaskId AddBackgroundTask(
+      const char* name,
+      base::OnceClosure callback,
+      const std::vector<StartupTaskId>& prerequisites);
+
+  // Makes the UI thread task |task| wait for |prerequisite|, which must have
+  // been added before it. When running synchronously, this blocks the UI
+  // thread until |prerequisite| has run.
+  void AddPrerequisite(StartupTaskId task, StartupTaskId prerequisite);
 
   // Start running the tasks asynchronously.
   void StartRunningTasksAsync();
@@ -51,15 +82,73 @@ class CONTENT_EXPORT StartupTaskRunner {
   // Run all tasks, or all remaining tasks, synchronously
   void RunAllTasksNow();
 
+  // Returns the names of the tasks on the critical path of the run, the
+  // longest chain of tasks each of which waited for the previous one. Empty
+  // until all the tasks have run successfully.
+  std::vector<const char*> GetCriticalPath() const;
+
  private:
   friend class base::RefCounted<StartupTaskRunner>;
 
-  std::list<StartupTask> task_list_;
+  // Shared with the task scheduler while a background task runs.
+  class BackgroundTaskState;
+
+  struct Task {
+    Task();
+    Task(Task&&);
+    ~Task();
+
+    const char* name;
+    // Null for background tasks.
+    StartupTask callback;
+    // Null for UI thread tasks, and once the task has been posted.
+    base::OnceClosure background_callback;
+    scoped_refptr<BackgroundTaskState> background_state;
+    std::vector<StartupTaskId> prerequisites;
+    // For UI thread tasks.
+    bool done;
+    base::TimeTicks start_time;
+    base::TimeTicks end_time;
+  };
+
+  static void RunBackgroundTask(
+      const char* name,
+      base::OnceClosure callback,
+      scoped_refptr<BackgroundTaskState> state,
+      scoped_refptr<base::SingleThreadTaskRunner> reply_task_runner,
+      base::OnceClosure reply);
+
+  bool IsBackgroundTask(StartupTaskId id) const;
+  bool IsDone(StartupTaskId id) const;
+  base::TimeTicks GetStartTime(StartupTaskId id) const;
+  base::TimeTicks GetEndTime(StartupTaskId id) const;
+  bool PrerequisitesAreDone(StartupTaskId id) const;
+  std::vector<StartupTaskId> GetCriticalPathIds() const;
+
+  // Runs the UI thread task |id|, first waiting for its prerequisites.
+  int RunTask(StartupTaskId id);
+  void PostReadyBackgroundTasks();
+  void OnBackgroundTaskDone();
+  // Completes startup, unless it succeeded and background tasks are still
+  // running.
+  void MaybeCompleteStartup(int result);
+  void ReportCriticalPath() const;
+
+  void PostWrappedTask();
   void WrappedTask();
 
+  std::vector<Task> tasks_;
+  // The UI thread tasks which have not run yet, in order.
+  std::list<StartupTaskId> task_list_;
+  bool running_async_;
+  bool wrapped_task_posted_;
+  bool startup_completed_;
+
   base::Callback<void(int)> startup_complete_callback_;
   scoped_refptr<base::SingleThreadTaskRunner> proxy_;
 
+  base::WeakPtrFactory<StartupTaskRunner> weak_factory_;
+
   DISALLOW_COPY_AND_ASSIGN(StartupTaskRunner);
 };
 
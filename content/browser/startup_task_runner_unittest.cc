@@ -13,6 +13,8 @@
 #include "base/run_loop.h"
 #include "base/single_thread_task_runner.h"
 #include "base/task_runner.h"
+#include "base/test/scoped_task_environment.h"
+#include "base/threading/thread_task_runner_handle.h"
 
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -309,5 +311,41 @@ TEST_F(StartupTaskRunnerTest, AsynchronousExecutionFailedTask) {
   EXPECT_EQ(observer_calls, 1);
   EXPECT_EQ(task_count, 1);
 }
+
+TEST_F(StartupTaskRunnerTest, BackgroundTask) {
+  base::test::ScopedTaskEnvironment scoped_task_environment;
+  StartupTaskRunner runner(base::Bind(&Observer),
+                           base::ThreadTaskRunnerHandle::Get());
+
+  bool background_task_ran = false;
+  StartupTaskId task1 = runner.AddTask(
+      "Task1",
+      base::Bind(&StartupTaskRunnerTest::Task1, base::Unretained(this)));
+  StartupTaskId background_task = runner.AddBackgroundTask(
+      "BackgroundTask",
+      base::BindOnce([](bool* ran) { *ran = true; }, &background_task_ran),
+      {task1});
+  StartupTaskId task2 = runner.AddTask(
+      "Task2",
+      base::Bind(&StartupTaskRunnerTest::Task2, base::Unretained(this)));
+  runner.AddPrerequisite(task2, background_task);
+  EXPECT_TRUE(runner.GetCriticalPath().empty());
+
+  runner.RunAllTasksNow();
+  EXPECT_TRUE(background_task_ran);
+  EXPECT_EQ(GetLastTask(), 2);
+  EXPECT_EQ(task_count, 2);
+  EXPECT_EQ(observer_calls, 1);
+  EXPECT_EQ(observer_result, 0);
+  EXPECT_THAT(runner.GetCriticalPath(),
+              testing::ElementsAre(testing::StrEq("Task1"),
+                                   testing::StrEq("BackgroundTask"),
+                                   testing::StrEq("Task2")));
+
+  // The background task's reply doesn't complete startup again.
+  scoped_task_environment.RunUntilIdle();
+  EXPECT_EQ(observer_calls, 1);
+}
+
 }  // namespace
 }  // namespace content
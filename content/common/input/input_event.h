@@ -6,6 +6,7 @@
 #define CONTENT_COMMON_INPUT_INPUT_EVENT_H_
 
 #include <memory>
+#include <vector>
 
 #include "base/macros.h"
 #include "content/common/content_export.h"
@@ -30,6 +31,9 @@ class CONTENT_EXPORT InputEvent {
 
   ui::WebScopedInputEvent web_event;
   ui::LatencyInfo latency_info;
+  // The events |web_event| was coalesced from, oldest first, when the browser
+  // batched them. Empty otherwise.
+  std::vector<ui::WebScopedInputEvent> coalesced_events;
 
  private:
   DISALLOW_COPY_AND_ASSIGN(InputEvent);
@@ -334,6 +334,17 @@ bool StructTraits<content::mojom::EventDataView, InputEventUniquePtr>::Read(
     return false;
   }
 
+  std::vector<InputEventUniquePtr> coalesced_events;
+  if (!event.ReadCoalescedEvents(&coalesced_events))
+    return false;
+  for (InputEventUniquePtr& coalesced_event : coalesced_events) {
+    if (!coalesced_event->web_event ||
+        coalesced_event->web_event->GetType() != type) {
+      return false;
+    }
+    (*out)->coalesced_events.push_back(std::move(coalesced_event->web_event));
+  }
+
   return event.ReadLatency(&((*out)->latency_info));
 }
 
@@ -510,4 +521,17 @@ StructTraits<content::mojom::EventDataView, InputEventUniquePtr>::touch_data(
   return touch_data;
 }
 
+// static
+std::vector<InputEventUniquePtr>
+StructTraits<content::mojom::EventDataView, InputEventUniquePtr>::
+    coalesced_events(const InputEventUniquePtr& event) {
+  std::vector<InputEventUniquePtr> coalesced_events;
+  for (const ui::WebScopedInputEvent& coalesced_event :
+       event->coalesced_events) {
+    coalesced_events.push_back(std::make_unique<content::InputEvent>(
+        *coalesced_event, ui::LatencyInfo()));
+  }
+  return coalesced_events;
+}
+
 }  // namespace mojo
@@ -5,6 +5,9 @@
 #ifndef CONTENT_COMMON_INPUT_INPUT_EVENT_STRUCT_TRAITS_H_
 #define CONTENT_COMMON_INPUT_INPUT_EVENT_STRUCT_TRAITS_H_
 
+#include <memory>
+#include <vector>
+
 #include "content/common/input/input_handler.mojom.h"
 
 namespace content {
@@ -40,6 +43,8 @@ struct StructTraits<content::mojom::EventDataView, InputEventUniquePtr> {
       const InputEventUniquePtr& event);
   static content::mojom::TouchDataPtr touch_data(
       const InputEventUniquePtr& event);
+  static std::vector<InputEventUniquePtr> coalesced_events(
+      const InputEventUniquePtr& event);
 
   static bool Read(content::mojom::EventDataView r, InputEventUniquePtr* out);
 };
@@ -711,6 +711,7 @@ void WriteResourceRequestBody(const network::ResourceRequestBody& request_body,
         break;
       case network::DataElement::TYPE_RAW_FILE:
       case network::DataElement::TYPE_CHUNKED_DATA_PIPE:
+      case network::DataElement::TYPE_READ_ONLY_SHARED_MEMORY:
       case network::DataElement::TYPE_UNKNOWN:
         NOTREACHED();
         continue;
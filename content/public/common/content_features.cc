@@ -453,6 +453,11 @@ const base::Feature kV8VmFuture{"V8VmFuture",
 const base::Feature kVrWebInputEditing{"VrWebInputEditing",
                                        base::FEATURE_ENABLED_BY_DEFAULT};
 
+// Batches continuous input events in the browser and sends them to the
+// renderer once per frame, coalesced into one event per type.
+const base::Feature kVsyncAlignedInputBatching{
+    "VsyncAlignedInputBatching", base::FEATURE_DISABLED_BY_DEFAULT};
+
 // Enable WebAssembly structured cloning.
 // http://webassembly.org/
 const base::Feature kWebAssembly{"WebAssembly",
@@ -362,6 +362,10 @@ const char kEnableLowResTiling[] = "enable-low-res-tiling";
 // builds.
 const char kEnableLogging[]                 = "enable-logging";
 
+// Counts the messages, bytes and dispatch time of every mojo interface and
+// reports them in memory-infra traces under "mojo/traffic/".
+const char kEnableMojoTrafficStats[] = "enable-mojo-traffic-stats";
+
 // Enables the type, downlinkMax attributes of the NetInfo API. Also, enables
 // triggering of change attribute of the NetInfo API when there is a change in
 // the connection type.
@@ -794,6 +798,11 @@ const char kSkiaFontCacheLimitMb[] = "skia-font-cache-limit-mb";
 // exceeds this limit.
 const char kSkiaResourceCacheLimitMb[] = "skia-resource-cache-limit-mb";
 
+// Sets the maximum number of spare renderer processes kept ready for new
+// navigations. The number actually kept follows the rate at which new renderer
+// processes are needed and the amount of memory. Defaults to 1.
+const char kSpareRendererProcessPoolSize[] = "spare-renderer-process-pool-size";
+
 // Type of the current test harness ("browser" or "ui").
 const char kTestType[]                      = "test-type";
 
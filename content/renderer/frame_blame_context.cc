@@ -4,6 +4,9 @@
 
 #include "content/renderer/frame_blame_context.h"
 
+#include <set>
+
+#include "base/no_destructor.h"
 #include "base/trace_event/trace_event_argument.h"
 #include "content/renderer/render_frame_impl.h"
 #include "content/renderer/top_level_blame_context.h"
@@ -20,6 +23,13 @@ base::trace_event::BlameContext* GetParentBlameContext(
   return blink::Platform::Current()->GetTopLevelBlameContext();
 }
 
+// Allocation contexts must have application lifetime, so the origins are
+// interned. A renderer only ever hosts a limited number of origins.
+const char* InternOrigin(const std::string& origin) {
+  static base::NoDestructor<std::set<std::string>> origins;
+  return origins->insert(origin).first->c_str();
+}
+
 }  // namespace
 
 const char kFrameBlameContextCategory[] = "blink";
@@ -38,4 +48,8 @@ FrameBlameContext::FrameBlameContext(RenderFrameImpl* render_frame,
 
 FrameBlameContext::~FrameBlameContext() {}
 
+void FrameBlameContext::SetOrigin(const std::string& origin) {
+  SetAllocationContext(InternOrigin(origin));
+}
+
 }  // namespace content
@@ -5,6 +5,8 @@
 #ifndef CONTENT_RENDERER_FRAME_BLAME_CONTEXT_H_
 #define CONTENT_RENDERER_FRAME_BLAME_CONTEXT_H_
 
+#include <string>
+
 #include "base/trace_event/blame_context.h"
 
 namespace content {
@@ -17,6 +19,10 @@ class FrameBlameContext : public base::trace_event::BlameContext {
   FrameBlameContext(RenderFrameImpl* frame, RenderFrameImpl* parent_frame);
   ~FrameBlameContext() override;
 
+  // Attributes allocations made while running the frame's tasks to |origin|,
+  // which is the origin of the frame's current document.
+  void SetOrigin(const std::string& origin);
+
   DISALLOW_COPY_AND_ASSIGN(FrameBlameContext);
 };
 
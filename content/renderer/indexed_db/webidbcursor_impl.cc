@@ -6,6 +6,7 @@
 
 #include <stddef.h>
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -65,6 +66,7 @@ WebIDBCursorImpl::WebIDBCursorImpl(
       used_prefetches_(0),
       pending_onsuccess_callbacks_(0),
       prefetch_amount_(kMinPrefetchAmount),
+      predicted_run_length_(0),
       weak_factory_(this) {
   IndexedDBDispatcher::ThreadSpecificInstance()->RegisterCursor(this);
   io_runner_->PostTask(FROM_HERE, base::BindOnce(&IOThreadHelper::Bind,
@@ -230,8 +232,16 @@ void WebIDBCursorImpl::CachedContinue(WebIDBCallbacks* callbacks) {
 }
 
 void WebIDBCursorImpl::ResetPrefetchCache() {
+  if (continue_count_ > kPrefetchContinueThreshold) {
+    const int run_length = continue_count_ - kPrefetchContinueThreshold;
+    predicted_run_length_ =
+        predicted_run_length_ ? (predicted_run_length_ + run_length) / 2
+                              : run_length;
+  }
   continue_count_ = 0;
-  prefetch_amount_ = kMinPrefetchAmount;
+  prefetch_amount_ =
+      std::max<int>(kMinPrefetchAmount,
+                    std::min<int>(predicted_run_length_, kMaxPrefetchAmount));
 
   if (prefetch_keys_.empty()) {
     // No prefetch cache, so no need to reset the cursor in the back-end.
@@ -56,6 +56,7 @@ class CONTENT_EXPORT WebIDBCursorImpl : public blink::WebIDBCursor {
  private:
   FRIEND_TEST_ALL_PREFIXES(IndexedDBDispatcherTest, CursorReset);
   FRIEND_TEST_ALL_PREFIXES(IndexedDBDispatcherTest, CursorTransactionId);
+  FRIEND_TEST_ALL_PREFIXES(WebIDBCursorImplTest, AdaptivePrefetchAmount);
   FRIEND_TEST_ALL_PREFIXES(WebIDBCursorImplTest, AdvancePrefetchTest);
   FRIEND_TEST_ALL_PREFIXES(WebIDBCursorImplTest, PrefetchReset);
   FRIEND_TEST_ALL_PREFIXES(WebIDBCursorImplTest, PrefetchTest);
@@ -90,6 +91,14 @@ class CONTENT_EXPORT WebIDBCursorImpl : public blink::WebIDBCursor {
   // Number of items to request in next prefetch.
   int prefetch_amount_;
 
+  // Smoothed number of results served from prefetches per run of continue()
+  // calls, or zero before the first run ends. A run ends when the cache is
+  // reset, e.g. because the page stopped iterating or continued to a key.
+  // The first prefetch of the next run asks for this many, so that cursors
+  // iterated in fixed-size pages need one round trip per page rather than
+  // one per doubling.
+  int predicted_run_length_;
+
   base::WeakPtrFactory<WebIDBCursorImpl> weak_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(WebIDBCursorImpl);
@@ -213,6 +213,60 @@ TEST_F(WebIDBCursorImplTest, PrefetchTest) {
   EXPECT_TRUE(mock_cursor_->destroyed());
 }
 
+TEST_F(WebIDBCursorImplTest, AdaptivePrefetchAmount) {
+  auto prefetch = [this](int count) {
+    std::vector<IndexedDBKey> keys(count);
+    std::vector<IndexedDBKey> primary_keys(count);
+    std::vector<WebIDBValue> values;
+    for (int i = 0; i < count; ++i)
+      values.emplace_back(WebData(), WebVector<WebBlobInfo>());
+    cursor_->SetPrefetchData(std::move(keys), std::move(primary_keys),
+                             std::move(values));
+    // As the real dispatcher does, serve the continue() which initiated it.
+    MockContinueCallbacks callbacks;
+    cursor_->CachedContinue(&callbacks);
+  };
+
+  for (int i = 0; i < WebIDBCursorImpl::kPrefetchContinueThreshold; ++i) {
+    cursor_->Continue(null_key_.View(), null_key_.View(),
+                      new MockContinueCallbacks());
+  }
+
+  // Use one full prefetch and six results of the next, then stop iterating.
+  cursor_->Continue(null_key_.View(), null_key_.View(),
+                    new MockContinueCallbacks());
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(static_cast<int>(WebIDBCursorImpl::kMinPrefetchAmount),
+            mock_cursor_->last_prefetch_count());
+  prefetch(WebIDBCursorImpl::kMinPrefetchAmount);
+  for (int i = 1; i < WebIDBCursorImpl::kMinPrefetchAmount; ++i) {
+    cursor_->Continue(null_key_.View(), null_key_.View(),
+                      new MockContinueCallbacks());
+  }
+  cursor_->Continue(null_key_.View(), null_key_.View(),
+                    new MockContinueCallbacks());
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(2, mock_cursor_->prefetch_calls());
+  prefetch(mock_cursor_->last_prefetch_count());
+  for (int i = 1; i < 6; ++i) {
+    cursor_->Continue(null_key_.View(), null_key_.View(),
+                      new MockContinueCallbacks());
+  }
+  cursor_->ResetPrefetchCache();
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(1, mock_cursor_->reset_calls());
+
+  // The next run starts by prefetching as many results as the last one used.
+  for (int i = 0; i <= WebIDBCursorImpl::kPrefetchContinueThreshold; ++i) {
+    cursor_->Continue(null_key_.View(), null_key_.View(),
+                      new MockContinueCallbacks());
+  }
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(3, mock_cursor_->prefetch_calls());
+  EXPECT_EQ(static_cast<int>(WebIDBCursorImpl::kMinPrefetchAmount) + 6,
+            mock_cursor_->last_prefetch_count());
+}
+
 TEST_F(WebIDBCursorImplTest, AdvancePrefetchTest) {
   // Call continue() until prefetching should kick in.
   EXPECT_EQ(0, mock_cursor_->continue_calls());
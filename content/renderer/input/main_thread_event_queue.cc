@@ -46,12 +46,16 @@ constexpr base::TimeDelta kAsyncTouchMoveInterval =
 class QueuedWebInputEvent : public ScopedWebInputEventWithLatencyInfo,
                             public MainThreadEventQueueTask {
  public:
-  QueuedWebInputEvent(ui::WebScopedInputEvent event,
-                      const ui::LatencyInfo& latency,
-                      bool originally_cancelable,
-                      HandledEventCallback callback,
-                      bool known_by_scheduler)
-      : ScopedWebInputEventWithLatencyInfo(std::move(event), latency),
+  QueuedWebInputEvent(
+      ui::WebScopedInputEvent event,
+      const std::vector<ui::WebScopedInputEvent>& coalesced_events,
+      const ui::LatencyInfo& latency,
+      bool originally_cancelable,
+      HandledEventCallback callback,
+      bool known_by_scheduler)
+      : ScopedWebInputEventWithLatencyInfo(std::move(event),
+                                           coalesced_events,
+                                           latency),
         non_blocking_coalesced_count_(0),
         creation_timestamp_(base::TimeTicks::Now()),
         last_coalesced_timestamp_(creation_timestamp_),
@@ -232,6 +236,7 @@ MainThreadEventQueue::~MainThreadEventQueue() {}
 
 void MainThreadEventQueue::HandleEvent(
     ui::WebScopedInputEvent event,
+    std::vector<ui::WebScopedInputEvent> coalesced_events,
     const ui::LatencyInfo& latency,
     InputEventDispatchType original_dispatch_type,
     InputEventAckState ack_result,
@@ -303,7 +308,7 @@ void MainThreadEventQueue::HandleEvent(
   }
 
   std::unique_ptr<QueuedWebInputEvent> queued_event(new QueuedWebInputEvent(
-      std::move(event), latency, originally_cancelable,
+      std::move(event), coalesced_events, latency, originally_cancelable,
       std::move(event_callback), IsForwardedAndSchedulerKnown(ack_result)));
 
   QueueEvent(std::move(queued_event));
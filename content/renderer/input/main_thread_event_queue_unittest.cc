@@ -165,6 +165,7 @@ class MainThreadEventQueueTest : public testing::Test,
     base::AutoReset<bool> in_handle_event(&handler_callback_->handling_event_,
                                           true);
     queue_->HandleEvent(ui::WebInputEventTraits::Clone(event),
+                        std::vector<ui::WebScopedInputEvent>(),
                         ui::LatencyInfo(), DISPATCH_TYPE_BLOCKING, ack_result,
                         handler_callback_->GetCallback());
   }
@@ -5,6 +5,8 @@
 #ifndef CONTENT_RENDERER_SCOPED_WEB_INPUT_EVENT_WITH_LATENCY_INFO_H_
 #define CONTENT_RENDERER_SCOPED_WEB_INPUT_EVENT_WITH_LATENCY_INFO_H_
 
+#include <vector>
+
 #include "base/compiler_specific.h"
 #include "base/logging.h"
 #include "content/common/content_export.h"
@@ -22,6 +24,12 @@ class ScopedWebInputEventWithLatencyInfo {
  public:
   ScopedWebInputEventWithLatencyInfo(ui::WebScopedInputEvent,
                                      const ui::LatencyInfo&);
+  // |coalesced_events| are the events the browser coalesced the event from,
+  // if any.
+  ScopedWebInputEventWithLatencyInfo(
+      ui::WebScopedInputEvent,
+      const std::vector<ui::WebScopedInputEvent>& coalesced_events,
+      const ui::LatencyInfo&);
 
   ~ScopedWebInputEventWithLatencyInfo();
 
@@ -221,7 +221,8 @@ void WidgetInputHandlerManager::DispatchNonBlockingEventToMainThread(
     const ui::LatencyInfo& latency_info) {
   DCHECK(input_event_queue_);
   input_event_queue_->HandleEvent(
-      std::move(event), latency_info, DISPATCH_TYPE_NON_BLOCKING,
+      std::move(event), std::vector<ui::WebScopedInputEvent>(), latency_info,
+      DISPATCH_TYPE_NON_BLOCKING,
       INPUT_EVENT_ACK_STATE_SET_NON_BLOCKING, HandledEventCallback());
 }
 
@@ -378,10 +379,10 @@ void WidgetInputHandlerManager::DispatchEvent(
         std::move(event->web_event), event->latency_info,
         base::BindOnce(
             &WidgetInputHandlerManager::DidHandleInputEventAndOverscroll, this,
-            std::move(callback)));
+            std::move(callback), std::move(event->coalesced_events)));
   } else {
-    HandleInputEvent(std::move(event->web_event), event->latency_info,
-                     std::move(callback));
+    HandleInputEvent(std::move(event->web_event), event->coalesced_events,
+                     event->latency_info, std::move(callback));
   }
 }
 
@@ -429,6 +430,7 @@ void WidgetInputHandlerManager::BindChannel(
 
 void WidgetInputHandlerManager::HandleInputEvent(
     const ui::WebScopedInputEvent& event,
+    const std::vector<ui::WebScopedInputEvent>& coalesced_events,
     const ui::LatencyInfo& latency,
     mojom::WidgetInputHandler::DispatchEventCallback callback) {
   if (!render_widget_ || render_widget_->is_swapped_out() ||
@@ -443,13 +445,20 @@ void WidgetInputHandlerManager::HandleInputEvent(
   auto send_callback = base::BindOnce(
       &WidgetInputHandlerManager::HandledInputEvent, this, std::move(callback));
 
-  blink::WebCoalescedInputEvent coalesced_event(*event);
+  std::vector<const blink::WebInputEvent*> coalesced_event_pointers;
+  for (const ui::WebScopedInputEvent& coalesced_event : coalesced_events)
+    coalesced_event_pointers.push_back(coalesced_event.get());
+  blink::WebCoalescedInputEvent coalesced_event =
+      coalesced_event_pointers.empty()
+          ? blink::WebCoalescedInputEvent(*event)
+          : blink::WebCoalescedInputEvent(*event, coalesced_event_pointers);
   render_widget_->HandleInputEvent(coalesced_event, latency,
                                    std::move(send_callback));
 }
 
 void WidgetInputHandlerManager::DidHandleInputEventAndOverscroll(
     mojom::WidgetInputHandler::DispatchEventCallback callback,
+    std::vector<ui::WebScopedInputEvent> coalesced_events,
     ui::InputHandlerProxy::EventDisposition event_disposition,
     ui::WebScopedInputEvent input_event,
     const ui::LatencyInfo& latency_info,
@@ -476,9 +485,9 @@ void WidgetInputHandlerManager::DidHandleInputEventAndOverscroll(
     HandledEventCallback handled_event =
         base::BindOnce(&WidgetInputHandlerManager::HandledInputEvent, this,
                        std::move(callback));
-    input_event_queue_->HandleEvent(std::move(input_event), latency_info,
-                                    dispatch_type, ack_state,
-                                    std::move(handled_event));
+    input_event_queue_->HandleEvent(
+        std::move(input_event), std::move(coalesced_events), latency_info,
+        dispatch_type, ack_state, std::move(handled_event));
     return;
   }
   if (callback) {
@@ -339,6 +339,7 @@ WebHTTPBody GetWebHTTPBodyForRequestBodyWithBlobPtrs(
       case network::DataElement::TYPE_UNKNOWN:
       case network::DataElement::TYPE_RAW_FILE:
       case network::DataElement::TYPE_CHUNKED_DATA_PIPE:
+      case network::DataElement::TYPE_READ_ONLY_SHARED_MEMORY:
         NOTREACHED();
         break;
     }
@@ -9,6 +9,7 @@
 
 #include "base/bind.h"
 #include "base/memory/ptr_util.h"
+#include "base/memory/shared_memory.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/unguessable_token.h"
 #include "build/build_config.h"
@@ -21,6 +22,7 @@
 #include "gpu/command_buffer/client/gpu_memory_buffer_manager.h"
 #include "gpu/command_buffer/common/gpu_memory_buffer_support.h"
 #include "gpu/ipc/client/gpu_channel_host.h"
+#include "gpu/ipc/common/gpu_memory_buffer_impl_shared_memory.h"
 #include "gpu/ipc/common/gpu_memory_buffer_support.h"
 #include "media/gpu/gpu_video_accelerator_util.h"
 #include "media/gpu/ipc/client/gpu_video_decode_accelerator_host.h"
@@ -272,6 +274,24 @@ GpuVideoAcceleratorFactoriesImpl::CreateGpuMemoryBuffer(
   return gpu_memory_buffer_manager_->CreateGpuMemoryBuffer(
       size, format, usage, gpu::kNullSurfaceHandle);
 }
+
+std::unique_ptr<gfx::GpuMemoryBuffer>
+GpuVideoAcceleratorFactoriesImpl::CreateGpuMemoryBufferFromHandle(
+    const gfx::GpuMemoryBufferHandle& handle,
+    const gfx::Size& size,
+    gfx::BufferFormat format) {
+  if (handle.type != gfx::SHARED_MEMORY_BUFFER)
+    return nullptr;
+  if (!gpu::GpuMemoryBufferImplSharedMemory::IsSizeValidForFormat(size,
+                                                                  format)) {
+    base::SharedMemory::CloseHandle(handle.handle);
+    return nullptr;
+  }
+  return gpu::GpuMemoryBufferImplSharedMemory::CreateFromHandle(
+      handle, size, format, gfx::BufferUsage::GPU_READ,
+      gpu::GpuMemoryBufferImpl::DestructionCallback());
+}
+
 bool GpuVideoAcceleratorFactoriesImpl::ShouldUseGpuMemoryBuffersForVideoFrames(
     bool for_media_stream) const {
   return for_media_stream ? enable_media_stream_gpu_memory_buffers_
@@ -89,6 +89,11 @@ class CONTENT_EXPORT GpuVideoAcceleratorFactoriesImpl
       gfx::BufferFormat format,
       gfx::BufferUsage usage) override;
 
+  std::unique_ptr<gfx::GpuMemoryBuffer> CreateGpuMemoryBufferFromHandle(
+      const gfx::GpuMemoryBufferHandle& handle,
+      const gfx::Size& size,
+      gfx::BufferFormat format) override;
+
   bool ShouldUseGpuMemoryBuffersForVideoFrames(
       bool for_media_stream) const override;
   unsigned ImageTextureTarget(gfx::BufferFormat format) override;
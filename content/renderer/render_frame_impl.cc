@@ -4072,6 +4072,9 @@ void RenderFrameImpl::DidCommitProvisionalLoad(
       return;
   }
 
+  // Attribute the memory allocated by the frame's tasks to its new origin.
+  blame_context_->SetOrigin(frame_->GetSecurityOrigin().ToString().Utf8());
+
   // Navigations that change the document represent a new content source.  Keep
   // track of that on the widget to help the browser process detect when stale
   // compositor frames are being shown after a commit.
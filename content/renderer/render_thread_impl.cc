@@ -2313,8 +2313,10 @@ void RenderThreadImpl::OnMemoryPressure(
         static_cast<blink::WebMemoryPressureLevel>(memory_pressure_level));
   }
   if (memory_pressure_level ==
-      base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL)
+      base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL) {
     ReleaseFreeMemory();
+    discardable_shared_memory_manager_->PurgeSparseMemory();
+  }
 }
 
 void RenderThreadImpl::OnMemoryStateChange(base::MemoryState state) {
@@ -2339,6 +2341,7 @@ void RenderThreadImpl::OnPurgeMemory() {
 
   OnTrimMemoryImmediately();
   ReleaseFreeMemory();
+  discardable_shared_memory_manager_->PurgeSparseMemory();
   if (blink_platform_impl_)
     blink::WebMemoryCoordinator::OnPurgeMemory();
 }
@@ -20,6 +20,8 @@
 #include "base/sys_info.h"
 #include "base/threading/platform_thread.h"
 #include "base/timer/hi_res_timer_manager.h"
+#include "base/trace_event/heap_profiler_allocation_context_tracker.h"
+#include "base/trace_event/memory_dump_manager.h"
 #include "base/trace_event/trace_event.h"
 #include "build/build_config.h"
 #include "content/common/content_constants_internal.h"
@@ -32,6 +34,7 @@
 #include "content/renderer/render_process_impl.h"
 #include "content/renderer/render_thread_impl.h"
 #include "content/renderer/renderer_main_platform_delegate.h"
+#include "content/renderer/sampled_heap_dump_provider.h"
 #include "media/media_buildflags.h"
 #include "ppapi/buildflags/buildflags.h"
 #include "services/service_manager/sandbox/switches.h"
@@ -103,6 +106,17 @@ int RendererMain(const MainFunctionParams& parameters) {
     if (parsed && sampling_interval > 0)
       profiler->SetSamplingInterval(sampling_interval * 1024);
     profiler->Start();
+
+    // Record the task contexts pushed by frame blame contexts, so that samples
+    // are attributed to the origins of the frames which allocate them.
+    using base::trace_event::AllocationContextTracker;
+    if (AllocationContextTracker::capture_mode() ==
+        AllocationContextTracker::CaptureMode::DISABLED) {
+      AllocationContextTracker::SetCaptureMode(
+          AllocationContextTracker::CaptureMode::PSEUDO_STACK);
+    }
+    base::trace_event::MemoryDumpManager::GetInstance()->RegisterDumpProvider(
+        SampledHeapDumpProvider::GetInstance(), "SampledHeap", nullptr);
   }
 
 #if defined(OS_MACOSX)
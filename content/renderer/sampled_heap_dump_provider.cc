@@ -0,0 +1,74 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/renderer/sampled_heap_dump_provider.h"
+
+#include <map>
+#include <vector>
+
+#include "base/no_destructor.h"
+#include "base/sampling_heap_profiler/sampling_heap_profiler.h"
+#include "base/strings/stringprintf.h"
+#include "base/trace_event/memory_allocator_dump.h"
+#include "base/trace_event/process_memory_dump.h"
+
+namespace content {
+
+namespace {
+
+// Context of the allocations made outside of any frame's tasks.
+const char kUnattributedContext[] = "unattributed";
+
+}  // namespace
+
+// static
+SampledHeapDumpProvider* SampledHeapDumpProvider::GetInstance() {
+  static base::NoDestructor<SampledHeapDumpProvider> instance;
+  return instance.get();
+}
+
+SampledHeapDumpProvider::SampledHeapDumpProvider() = default;
+
+SampledHeapDumpProvider::~SampledHeapDumpProvider() = default;
+
+bool SampledHeapDumpProvider::OnMemoryDump(
+    const base::trace_event::MemoryDumpArgs& args,
+    base::trace_event::ProcessMemoryDump* pmd) {
+  using base::trace_event::MemoryAllocatorDump;
+  if (args.level_of_detail !=
+      base::trace_event::MemoryDumpLevelOfDetail::DETAILED) {
+    return true;
+  }
+
+  struct ContextUsage {
+    size_t size = 0;
+    size_t count = 0;
+  };
+  std::map<const char*, ContextUsage> usage_by_context;
+  std::vector<base::SamplingHeapProfiler::Sample> samples =
+      base::SamplingHeapProfiler::GetInstance()->GetSamples(0);
+  for (const base::SamplingHeapProfiler::Sample& sample : samples) {
+    ContextUsage& usage = usage_by_context[sample.context];
+    usage.size += sample.total;
+    ++usage.count;
+  }
+
+  // Contexts are reported as an attribute since origins can't be part of
+  // dump names. The dumps are children of the malloc dump so that they are
+  // not counted twice.
+  int index = 0;
+  for (const auto& entry : usage_by_context) {
+    MemoryAllocatorDump* dump = pmd->CreateAllocatorDump(
+        base::StringPrintf("malloc/sampled_by_context/context_%d", index++));
+    dump->AddString("context", "",
+                    entry.first ? entry.first : kUnattributedContext);
+    dump->AddScalar(MemoryAllocatorDump::kNameSize,
+                    MemoryAllocatorDump::kUnitsBytes, entry.second.size);
+    dump->AddScalar("sample_count", MemoryAllocatorDump::kUnitsObjects,
+                    entry.second.count);
+  }
+  return true;
+}
+
+}  // namespace content
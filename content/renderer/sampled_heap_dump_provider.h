@@ -0,0 +1,45 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CONTENT_RENDERER_SAMPLED_HEAP_DUMP_PROVIDER_H_
+#define CONTENT_RENDERER_SAMPLED_HEAP_DUMP_PROVIDER_H_
+
+#include "base/macros.h"
+#include "base/trace_event/memory_dump_provider.h"
+
+namespace base {
+template <typename T>
+class NoDestructor;
+}
+
+namespace content {
+
+// Reports the native memory sampled by base::SamplingHeapProfiler by the
+// context in which it was allocated, which for frame tasks is the origin of
+// the frame (see FrameBlameContext). This attributes renderer memory to the
+// origins, including embedded third parties, which allocated it.
+//
+// The sizes are estimates from samples and only cover allocations made since
+// the profiler started. They are reported in detailed dumps only, as the
+// contexts contain origins.
+class SampledHeapDumpProvider : public base::trace_event::MemoryDumpProvider {
+ public:
+  static SampledHeapDumpProvider* GetInstance();
+
+  // base::trace_event::MemoryDumpProvider implementation.
+  bool OnMemoryDump(const base::trace_event::MemoryDumpArgs& args,
+                    base::trace_event::ProcessMemoryDump* pmd) override;
+
+ private:
+  friend class base::NoDestructor<SampledHeapDumpProvider>;
+
+  SampledHeapDumpProvider();
+  ~SampledHeapDumpProvider() override;
+
+  DISALLOW_COPY_AND_ASSIGN(SampledHeapDumpProvider);
+};
+
+}  // namespace content
+
+#endif  // CONTENT_RENDERER_SAMPLED_HEAP_DUMP_PROVIDER_H_
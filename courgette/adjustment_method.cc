@@ -12,6 +12,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "base/logging.h"
@@ -59,7 +60,7 @@ class LabelInfo {
   std::vector<uint32_t> positions_;  // Offsets into the trace of references.
 
   // Just a no-argument constructor and copy constructor.  Actual LabelInfo
-  // objects are allocated in std::pair structs in a std::map.
+  // objects are allocated in std::pair structs in a std::unordered_map.
   LabelInfo()
       : label_(NULL), is_model_(false), debug_index_(0), refs_(0),
         assignment_(NULL),
@@ -71,7 +72,7 @@ class LabelInfo {
 
   // Public compiler generated copy constructor is needed to constuct
   // std::pair<Label*, LabelInfo> so that fresh LabelInfos can be allocated
-  // inside a std::map.
+  // inside a std::unordered_map.
 };
 
 struct OrderLabelInfoByAddressAscending {
@@ -658,8 +659,8 @@ class GraphAdjuster : public AdjustmentMethod {
   int debug_label_index_gen_;
 
   // Note LabelInfo is allocated inside map, so the LabelInfo lifetimes are
-  // managed by the map.
-  std::map<Label*, LabelInfo> label_infos_;
+  // managed by the map. Its nodes don't move on rehash.
+  std::unordered_map<Label*, LabelInfo> label_infos_;
 
  private:
   DISALLOW_COPY_AND_ASSIGN(GraphAdjuster);
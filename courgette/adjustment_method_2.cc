@@ -13,6 +13,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "base/format_macros.h"
@@ -167,7 +168,7 @@ class ShinglePattern;
 class LabelInfo {
  public:
   // Just a no-argument constructor and copy constructor.  Actual LabelInfo
-  // objects are allocated in std::pair structs in a std::map.
+  // objects are allocated in std::pair structs in a std::unordered_map.
   LabelInfo()
       : label_(NULL), is_model_(false), debug_index_(0), refs_(0),
         assignment_(NULL), candidates_(NULL)
@@ -196,7 +197,7 @@ class LabelInfo {
   void operator=(const LabelInfo*);  // Disallow assignment only.
   // Public compiler generated copy constructor is needed to constuct
   // std::pair<Label*, LabelInfo> so that fresh LabelInfos can be allocated
-  // inside a std::map.
+  // inside a std::unordered_map.
 };
 
 typedef std::vector<LabelInfo*> Trace;
@@ -234,8 +235,9 @@ class LabelInfoMaker {
   int debug_label_index_gen_;
 
   // Note LabelInfo is allocated 'flat' inside map::value_type, so the LabelInfo
-  // lifetimes are managed by the map.
-  std::map<Label*, LabelInfo> label_infos_;
+  // lifetimes are managed by the map. A hash map is used since every reference
+  // in both programs is looked up here; its nodes don't move on rehash.
+  std::unordered_map<Label*, LabelInfo> label_infos_;
 
   DISALLOW_COPY_AND_ASSIGN(LabelInfoMaker);
 };
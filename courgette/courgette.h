@@ -98,6 +98,12 @@ Status ApplyEnsemblePatch(const base::FilePath::CharType* old_file_name,
 Status GenerateEnsemblePatch(SourceStream* old, SourceStream* target,
                              SinkStream* patch);
 
+// Same as above, but transforms up to |num_threads| elements at the same time.
+// Each element being transformed holds its own disassembly, so peak memory
+// grows with |num_threads|. The patch is the same for any |num_threads|.
+Status GenerateEnsemblePatch(SourceStream* old, SourceStream* target,
+                             SinkStream* patch, int num_threads);
+
 // Serializes |encoded| into the stream set.
 // Returns C_OK if succeeded, otherwise returns an error status.
 Status WriteEncodedProgram(EncodedProgram* encoded, SinkStreamSet* sink);
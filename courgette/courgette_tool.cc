@@ -33,7 +33,7 @@ namespace {
 
 using courgette::CourgetteFlow;
 
-const char kUsageGen[] = "-gen <old_in> <new_in> <patch_out>";
+const char kUsageGen[] = "-gen <old_in> <new_in> <patch_out> [-threads=N]";
 const char kUsageApply[] = "-apply <old_in> <patch_in> <new_out>";
 const char kUsageGenbsdiff[] = "-genbsdiff <old_in> <new_in> <patch_out>";
 const char kUsageApplybsdiff[] = "-applybsdiff <old_in> <patch_in> <new_out>";
@@ -282,7 +282,8 @@ void Assemble(const base::FilePath& input_file,
 
 void GenerateEnsemblePatch(const base::FilePath& old_file,
                            const base::FilePath& new_file,
-                           const base::FilePath& patch_file) {
+                           const base::FilePath& patch_file,
+                           int num_threads) {
   BufferedFileReader old_buffer(old_file, "'old' input");
   BufferedFileReader new_buffer(new_file, "'new' input");
 
@@ -293,7 +294,8 @@ void GenerateEnsemblePatch(const base::FilePath& old_file,
 
   courgette::SinkStream patch_stream;
   courgette::Status status =
-      courgette::GenerateEnsemblePatch(&old_stream, &new_stream, &patch_stream);
+      courgette::GenerateEnsemblePatch(&old_stream, &new_stream, &patch_stream,
+                                       num_threads);
 
   if (status != courgette::C_OK)
     Problem("-gen failed.");
@@ -439,6 +441,14 @@ int main(int argc, const char* argv[]) {
     if (!base::StringToInt(repeat_switch, &repeat_count))
       repeat_count = 1;
 
+  // '-threads=N' transforms up to N elements at a time in -gen.
+  int num_threads = 1;
+  std::string threads_switch = command_line.GetSwitchValueASCII("threads");
+  if (!threads_switch.empty() &&
+      (!base::StringToInt(threads_switch, &num_threads) || num_threads < 1)) {
+    UsageProblem(kUsageGen);
+  }
+
   if (cmd_sup + cmd_dis + cmd_asm + cmd_disadj + cmd_make_patch +
           cmd_apply_patch + cmd_make_bsdiff_patch + cmd_apply_bsdiff_patch +
           cmd_spread_1_adjusted + cmd_spread_1_unadjusted !=
@@ -469,7 +479,7 @@ int main(int argc, const char* argv[]) {
     } else if (cmd_make_patch) {
       if (values.size() != 3)
         UsageProblem(kUsageGen);
-      GenerateEnsemblePatch(values[0], values[1], values[2]);
+      GenerateEnsemblePatch(values[0], values[1], values[2], num_threads);
     } else if (cmd_apply_patch) {
       if (values.size() != 3)
         UsageProblem(kUsageApply);
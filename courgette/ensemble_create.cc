@@ -16,10 +16,14 @@
 
 #include <stddef.h>
 
+#include <algorithm>
 #include <limits>
+#include <memory>
 #include <vector>
 
 #include "base/logging.h"
+#include "base/macros.h"
+#include "base/threading/simple_thread.h"
 #include "base/time/time.h"
 
 #include "courgette/crc.h"
@@ -238,11 +242,55 @@ void FreeGenerators(std::vector<TransformationPatchGenerator*>* generators) {
   generators->clear();
 }
 
+// Runs TransformationPatchGenerator::Transform() for one element. Elements are
+// independent of each other, so tasks may run on a thread pool.
+class TransformTask : public base::DelegateSimpleThread::Delegate {
+ public:
+  explicit TransformTask(TransformationPatchGenerator* generator)
+      : generator_(generator) {}
+  ~TransformTask() override = default;
+
+  SourceStreamSet* parameters() { return &parameters_; }
+  SinkStreamSet* predicted_transformed_element() {
+    return &predicted_transformed_element_;
+  }
+  SinkStreamSet* corrected_transformed_element() {
+    return &corrected_transformed_element_;
+  }
+  Status status() const { return status_; }
+
+  // base::DelegateSimpleThread::Delegate:
+  void Run() override {
+    status_ = generator_->Transform(&parameters_,
+                                    &predicted_transformed_element_,
+                                    &corrected_transformed_element_);
+    if (status_ == C_OK && !parameters_.Empty())
+      status_ = C_STREAM_NOT_CONSUMED;
+  }
+
+ private:
+  TransformationPatchGenerator* generator_;
+  SourceStreamSet parameters_;
+  SinkStreamSet predicted_transformed_element_;
+  SinkStreamSet corrected_transformed_element_;
+  Status status_ = C_GENERAL_ERROR;
+
+  DISALLOW_COPY_AND_ASSIGN(TransformTask);
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Status GenerateEnsemblePatch(SourceStream* base,
                              SourceStream* update,
                              SinkStream* final_patch) {
+  return GenerateEnsemblePatch(base, update, final_patch, 1);
+}
+
+Status GenerateEnsemblePatch(SourceStream* base,
+                             SourceStream* update,
+                             SinkStream* final_patch,
+                             int num_threads) {
+  DCHECK_GE(num_threads, 1);
   VLOG(1) << "start GenerateEnsemblePatch";
   base::Time start_time = base::Time::Now();
 
@@ -335,26 +383,41 @@ Status GenerateEnsemblePatch(SourceStream* base,
   SinkStreamSet predicted_transformed_elements;
   SinkStreamSet corrected_transformed_elements;
 
-  for (size_t i = 0;  i < number_of_transformations;  ++i) {
-    SourceStreamSet single_parameters;
-    if (!corrected_parameters_source_set.ReadSet(&single_parameters))
-      return C_STREAM_ERROR;
-    SinkStreamSet single_predicted_transformed_element;
-    SinkStreamSet single_corrected_transformed_element;
-    Status status = generators[i]->Transform(
-        &single_parameters,
-        &single_predicted_transformed_element,
-        &single_corrected_transformed_element);
-    if (status != C_OK)
-      return status;
-    if (!single_parameters.Empty())
-      return C_STREAM_NOT_CONSUMED;
-    if (!predicted_transformed_elements.WriteSet(
-            &single_predicted_transformed_element))
-      return C_STREAM_ERROR;
-    if (!corrected_transformed_elements.WriteSet(
-            &single_corrected_transformed_element))
-      return C_STREAM_ERROR;
+  // Elements are transformed in batches of up to |num_threads| at a time. Each
+  // transformed element is held until its batch is done, so batching bounds
+  // the extra memory, while results are still written in element order.
+  for (size_t batch_begin = 0; batch_begin < number_of_transformations;
+       batch_begin += num_threads) {
+    size_t batch_end = std::min(number_of_transformations,
+                                batch_begin + static_cast<size_t>(num_threads));
+    std::vector<std::unique_ptr<TransformTask>> tasks;
+    for (size_t i = batch_begin; i < batch_end; ++i) {
+      tasks.push_back(std::make_unique<TransformTask>(generators[i]));
+      if (!corrected_parameters_source_set.ReadSet(tasks.back()->parameters()))
+        return C_STREAM_ERROR;
+    }
+
+    if (tasks.size() == 1) {
+      tasks[0]->Run();
+    } else {
+      base::DelegateSimpleThreadPool pool("CourgetteTransform",
+                                          static_cast<int>(tasks.size()));
+      for (const auto& task : tasks)
+        pool.AddWork(task.get());
+      pool.Start();
+      pool.JoinAll();
+    }
+
+    for (const auto& task : tasks) {
+      if (task->status() != C_OK)
+        return task->status();
+      if (!predicted_transformed_elements.WriteSet(
+              task->predicted_transformed_element()))
+        return C_STREAM_ERROR;
+      if (!corrected_transformed_elements.WriteSet(
+              task->corrected_transformed_element()))
+        return C_STREAM_ERROR;
+    }
   }
 
   if (!corrected_parameters_source_set.Empty())
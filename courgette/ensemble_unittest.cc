@@ -55,6 +55,17 @@ void EnsembleTest::TestEnsemble(const std::string& src_bytes,
   EXPECT_FALSE(memcmp(target.Buffer(),
                       patch_result.Buffer(),
                       target.OriginalLength()));
+
+  // Transforming elements concurrently must produce the same patch.
+  source.Init(src_bytes);
+  target.Init(tgt_bytes);
+  courgette::SinkStream threaded_patch_sink;
+  status = courgette::GenerateEnsemblePatch(&source, &target,
+                                            &threaded_patch_sink, 3);
+  EXPECT_EQ(courgette::C_OK, status);
+  ASSERT_EQ(patch_sink.Length(), threaded_patch_sink.Length());
+  EXPECT_FALSE(memcmp(patch_sink.Buffer(), threaded_patch_sink.Buffer(),
+                      patch_sink.Length()));
 }
 
 void EnsembleTest::Elf32Ensemble() const {
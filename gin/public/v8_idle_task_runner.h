@@ -5,7 +5,9 @@
 #ifndef GIN_PUBLIC_V8_IDLE_TASK_RUNNER_H_
 #define GIN_PUBLIC_V8_IDLE_TASK_RUNNER_H_
 
+#include <limits>
 #include <memory>
+
 #include "v8/include/v8-platform.h"
 
 namespace gin {
@@ -18,6 +20,15 @@ class GIN_EXPORT V8IdleTaskRunner {
  public:
   virtual void PostIdleTask(std::unique_ptr<v8::IdleTask> task) = 0;
 
+  // Returns when the embedder expects the thread to be needed for input, such
+  // as the next event of a fling, in seconds of
+  // v8::Platform::MonotonicallyIncreasingTime(), or infinity if it doesn't
+  // expect any. Idle tasks get deadlines no later than this, so that V8 only
+  // picks garbage collection steps which finish before the input arrives.
+  virtual double ExpectedInputArrivalTime() {
+    return std::numeric_limits<double>::infinity();
+  }
+
   virtual ~V8IdleTaskRunner() {}
 };
 
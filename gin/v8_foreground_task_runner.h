@@ -14,7 +14,7 @@ class SingleThreadTaskRunner;
 
 namespace gin {
 
-class V8ForegroundTaskRunner : public V8ForegroundTaskRunnerBase {
+class GIN_EXPORT V8ForegroundTaskRunner : public V8ForegroundTaskRunnerBase {
  public:
   V8ForegroundTaskRunner(
       scoped_refptr<base::SingleThreadTaskRunner> task_runner);
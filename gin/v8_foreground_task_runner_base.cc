@@ -4,8 +4,38 @@
 
 #include "v8_foreground_task_runner_base.h"
 
+#include <algorithm>
+
+#include "base/logging.h"
+#include "base/macros.h"
+
 namespace gin {
 
+namespace {
+
+class IdleTaskWithInputDeadline : public v8::IdleTask {
+ public:
+  IdleTaskWithInputDeadline(V8IdleTaskRunner* idle_task_runner,
+                            std::unique_ptr<v8::IdleTask> task)
+      : idle_task_runner_(idle_task_runner), task_(std::move(task)) {}
+
+  ~IdleTaskWithInputDeadline() override = default;
+
+  // v8::IdleTask implementation.
+  void Run(double deadline_in_seconds) override {
+    task_->Run(std::min(deadline_in_seconds,
+                        idle_task_runner_->ExpectedInputArrivalTime()));
+  }
+
+ private:
+  V8IdleTaskRunner* idle_task_runner_;
+  std::unique_ptr<v8::IdleTask> task_;
+
+  DISALLOW_COPY_AND_ASSIGN(IdleTaskWithInputDeadline);
+};
+
+}  // namespace
+
 V8ForegroundTaskRunnerBase::V8ForegroundTaskRunnerBase() = default;
 
 V8ForegroundTaskRunnerBase::~V8ForegroundTaskRunnerBase() = default;
@@ -19,4 +49,12 @@ bool V8ForegroundTaskRunnerBase::IdleTasksEnabled() {
   return idle_task_runner() != nullptr;
 }
 
+std::unique_ptr<v8::IdleTask>
+V8ForegroundTaskRunnerBase::LimitDeadlineToExpectedInput(
+    std::unique_ptr<v8::IdleTask> task) {
+  DCHECK(IdleTasksEnabled());
+  return std::make_unique<IdleTaskWithInputDeadline>(idle_task_runner(),
+                                                     std::move(task));
+}
+
 }  // namespace gin
@@ -14,7 +14,7 @@ namespace gin {
 
 // Base class for the V8ForegroundTaskRunners to share the capability of
 // enabling IdleTasks.
-class V8ForegroundTaskRunnerBase : public v8::TaskRunner {
+class GIN_EXPORT V8ForegroundTaskRunnerBase : public v8::TaskRunner {
  public:
   V8ForegroundTaskRunnerBase();
 
@@ -27,6 +27,11 @@ class V8ForegroundTaskRunnerBase : public v8::TaskRunner {
  protected:
   V8IdleTaskRunner* idle_task_runner() { return idle_task_runner_.get(); }
 
+  // Wraps |task| so that its deadline is capped by the idle task runner's
+  // expected input arrival time.
+  std::unique_ptr<v8::IdleTask> LimitDeadlineToExpectedInput(
+      std::unique_ptr<v8::IdleTask> task);
+
  private:
   std::unique_ptr<V8IdleTaskRunner> idle_task_runner_;
 };
@@ -0,0 +1,79 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gin/v8_foreground_task_runner.h"
+
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "base/test/scoped_task_environment.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace gin {
+
+namespace {
+
+// Keeps the idle tasks posted to it so that tests can run them with chosen
+// deadlines.
+class TestIdleTaskRunner : public V8IdleTaskRunner {
+ public:
+  explicit TestIdleTaskRunner(
+      std::vector<std::unique_ptr<v8::IdleTask>>* tasks)
+      : tasks_(tasks) {}
+
+  void PostIdleTask(std::unique_ptr<v8::IdleTask> task) override {
+    tasks_->push_back(std::move(task));
+  }
+
+  double ExpectedInputArrivalTime() override { return expected_input_; }
+
+  void set_expected_input(double expected_input) {
+    expected_input_ = expected_input;
+  }
+
+ private:
+  std::vector<std::unique_ptr<v8::IdleTask>>* tasks_;
+  double expected_input_ = std::numeric_limits<double>::infinity();
+};
+
+class RecordDeadlineTask : public v8::IdleTask {
+ public:
+  explicit RecordDeadlineTask(double* deadline) : deadline_(deadline) {}
+
+  void Run(double deadline_in_seconds) override {
+    *deadline_ = deadline_in_seconds;
+  }
+
+ private:
+  double* deadline_;
+};
+
+}  // namespace
+
+TEST(V8ForegroundTaskRunnerTest, IdleDeadlineEndsBeforeExpectedInput) {
+  base::test::ScopedTaskEnvironment scoped_task_environment;
+  V8ForegroundTaskRunner task_runner(base::ThreadTaskRunnerHandle::Get());
+  std::vector<std::unique_ptr<v8::IdleTask>> tasks;
+  auto idle_task_runner = std::make_unique<TestIdleTaskRunner>(&tasks);
+  TestIdleTaskRunner* test_idle_task_runner = idle_task_runner.get();
+  task_runner.EnableIdleTasks(std::move(idle_task_runner));
+
+  double deadline = 0;
+  task_runner.PostIdleTask(std::make_unique<RecordDeadlineTask>(&deadline));
+  task_runner.PostIdleTask(std::make_unique<RecordDeadlineTask>(&deadline));
+  ASSERT_EQ(2u, tasks.size());
+
+  // Without expected input, the idle period's deadline is used as is.
+  tasks[0]->Run(10.0);
+  EXPECT_EQ(10.0, deadline);
+
+  // Input expected within the idle period ends it early.
+  test_idle_task_runner->set_expected_input(4.0);
+  tasks[1]->Run(10.0);
+  EXPECT_EQ(4.0, deadline);
+}
+
+}  // namespace gin
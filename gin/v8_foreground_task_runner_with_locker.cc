@@ -70,8 +70,8 @@ void V8ForegroundTaskRunnerWithLocker::PostDelayedTask(
 void V8ForegroundTaskRunnerWithLocker::PostIdleTask(
     std::unique_ptr<v8::IdleTask> task) {
   DCHECK(IdleTasksEnabled());
-  idle_task_runner()->PostIdleTask(
-      std::make_unique<IdleTaskWithLocker>(isolate_, std::move(task)));
+  idle_task_runner()->PostIdleTask(LimitDeadlineToExpectedInput(
+      std::make_unique<IdleTaskWithLocker>(isolate_, std::move(task))));
 }
 
 }  // namespace gin
@@ -127,6 +127,11 @@ bool MapV8File(base::PlatformFile platform_file,
   std::unique_ptr<base::MemoryMappedFile> mmapped_file(
       new base::MemoryMappedFile());
   if (mmapped_file->Initialize(base::File(platform_file), region)) {
+    // The whole file is read when the isolate is created, and the context
+    // snapshot again on every navigation. Start paging it in now so that
+    // deserializing it doesn't stall on I/O. The pages are shared through the
+    // page cache by every process mapping the file.
+    mmapped_file->Prefetch(0, mmapped_file->length());
     *mmapped_file_out = mmapped_file.release();
     return true;
   }
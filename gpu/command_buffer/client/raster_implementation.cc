@@ -10,18 +10,21 @@
 #include <GLES3/gl3.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 #include <algorithm>
 #include <limits>
 #include <set>
 #include <sstream>
 #include <string>
+#include <utility>
 
 #include "base/atomic_sequence_num.h"
 #include "base/bits.h"
 #include "base/compiler_specific.h"
 #include "base/numerics/safe_math.h"
 #include "base/strings/stringprintf.h"
+#include "base/task_runner.h"
 #include "base/trace_event/memory_allocator_dump.h"
 #include "base/trace_event/memory_dump_manager.h"
 #include "base/trace_event/process_memory_dump.h"
@@ -166,19 +169,59 @@ class PaintOpSerializer {
     return size;
   }
 
+  // Copies ops that were already serialized, e.g. by a
+  // cc::ParallelPaintOpBufferSerializer. Returns false if the transfer buffer
+  // couldn't be mapped.
+  bool CopySerializedOps(const char* data, size_t size) {
+    while (size) {
+      if (!valid())
+        return false;
+
+      // Copy as many whole ops as fit.
+      size_t bytes = 0;
+      size_t skip = 0;
+      while (bytes < size) {
+        uint32_t header;
+        memcpy(&header, data + bytes, sizeof(header));
+        skip = header >> 8;
+        DCHECK_GE(skip, sizeof(header));
+        DCHECK_LE(bytes + skip, size);
+        if (bytes + skip > free_bytes_)
+          break;
+        bytes += skip;
+      }
+
+      if (bytes) {
+        memcpy(buffer_ + written_bytes_, data, bytes);
+        written_bytes_ += bytes;
+        free_bytes_ -= bytes;
+        data += bytes;
+        size -= bytes;
+        continue;
+      }
+
+      // The ops that come later may use the images and the transfer cache
+      // entries used so far, so they are kept until SendSerializedData().
+      SendRasterCommand();
+      GLsizeiptr alloc_size = kBlockAlloc;
+      if (static_cast<GLsizeiptr>(skip) > alloc_size)
+        alloc_size = skip;
+      buffer_ = static_cast<char*>(ri_->MapRasterCHROMIUM(alloc_size));
+      free_bytes_ = buffer_ ? alloc_size : 0;
+    }
+    return true;
+  }
+
   void SendSerializedData() {
     if (!valid())
       return;
 
-    // Serialize fonts before sending raster commands.
-    font_manager_->Serialize();
-    ri_->UnmapRasterCHROMIUM(written_bytes_);
+    SendRasterCommand();
     // Now that we've issued the RasterCHROMIUM referencing the stashed
     // images, Reset the |stashing_image_provider_|, causing us to issue
     // unlock commands for these images.
     stashing_image_provider_->Reset();
     transfer_cache_helper_->FlushEntries();
-    written_bytes_ = 0;
   }
 
   bool valid() const { return !!buffer_; }
@@ -186,6 +229,13 @@ class PaintOpSerializer {
  private:
   static constexpr GLsizeiptr kBlockAlloc = 512 * 1024;
 
+  void SendRasterCommand() {
+    // Serialize fonts before sending raster commands.
+    font_manager_->Serialize();
+    ri_->UnmapRasterCHROMIUM(written_bytes_);
+    written_bytes_ = 0;
+  }
+
   RasterImplementation* const ri_;
   char* buffer_;
   cc::DecodeStashingImageProvider* const stashing_image_provider_;
@@ -1216,9 +1266,35 @@ void RasterImplementation::RasterCHROMIUM(const cc::DisplayItemList* list,
 
   // TODO(enne): Don't access private members of DisplayItemList.
   TransferCacheSerializeHelperImpl transfer_cache_serialize_helper(this);
+  transfer_cache_serialize_helper.set_path_content_cache(&path_content_cache_);
   PaintOpSerializer op_serializer(free_size, this, &stashing_image_provider,
                                   &transfer_cache_serialize_helper,
                                   &font_manager_);
+
+  if (parallel_serialization_task_runner_ &&
+      offsets.size() >= parallel_serialization_min_ops_) {
+    cc::ParallelPaintOpBufferSerializer parallel_serializer(
+        &stashing_image_provider, &transfer_cache_serialize_helper,
+        font_manager_.strike_server(), raster_properties_->color_space.get(),
+        raster_properties_->can_use_lcd_text,
+        capabilities().context_supports_distance_field_text,
+        capabilities().max_texture_size,
+        capabilities().glyph_cache_max_texture_bytes);
+    // TODO(piman): raise error if serialization fails?
+    if (parallel_serializer.Serialize(
+            &list->paint_op_buffer_, offsets, preamble,
+            parallel_serialization_max_ranges_,
+            parallel_serialization_task_runner_.get())) {
+      for (size_t i = 0; i < parallel_serializer.num_chunks(); ++i) {
+        if (!op_serializer.CopySerializedOps(parallel_serializer.chunk_data(i),
+                                             parallel_serializer.chunk_size(i)))
+          break;
+      }
+    }
+    op_serializer.SendSerializedData();
+    return;
+  }
+
   cc::PaintOpBufferSerializer::SerializeCallback serialize_cb =
       base::BindRepeating(&PaintOpSerializer::Serialize,
                           base::Unretained(&op_serializer));
@@ -1235,6 +1311,16 @@ void RasterImplementation::RasterCHROMIUM(const cc::DisplayItemList* list,
   op_serializer.SendSerializedData();
 }
 
+void RasterImplementation::SetParallelPaintSerialization(
+    scoped_refptr<base::TaskRunner> task_runner,
+    size_t max_ranges,
+    size_t min_ops_per_tile) {
+  DCHECK_GT(max_ranges, 0u);
+  parallel_serialization_task_runner_ = std::move(task_runner);
+  parallel_serialization_max_ranges_ = max_ranges;
+  parallel_serialization_min_ops_ = min_ops_per_tile;
+}
+
 void RasterImplementation::EndRasterCHROMIUM() {
   DCHECK(raster_properties_);
 
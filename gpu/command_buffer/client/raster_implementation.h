@@ -14,8 +14,10 @@
 #include <vector>
 
 #include "base/macros.h"
+#include "base/memory/ref_counted.h"
 #include "base/optional.h"
 #include "base/trace_event/memory_dump_provider.h"
+#include "cc/paint/path_content_cache.h"
 #include "gpu/command_buffer/client/client_font_manager.h"
 #include "gpu/command_buffer/client/context_support.h"
 #include "gpu/command_buffer/client/gpu_control_client.h"
@@ -31,6 +33,10 @@
 #include "gpu/raster_export.h"
 #include "third_party/skia/include/core/SkColor.h"
 
+namespace base {
+class TaskRunner;
+}  // namespace base
+
 namespace gpu {
 
 class GpuControl;
@@ -168,6 +174,15 @@ class RASTER_EXPORT RasterImplementation : public RasterInterface,
   void* MapRasterCHROMIUM(GLsizeiptr size);
   void UnmapRasterCHROMIUM(GLsizeiptr written_size);
 
+  // If set, RasterCHROMIUM() serializes tiles with at least
+  // |min_ops_per_tile| ops on up to |max_ranges| threads, running all but the
+  // first range on |task_runner|. RasterCHROMIUM() blocks until they are done,
+  // so |task_runner| must not run on the calling thread.
+  void SetParallelPaintSerialization(
+      scoped_refptr<base::TaskRunner> task_runner,
+      size_t max_ranges,
+      size_t min_ops_per_tile);
+
   // ClientFontManager::Client implementation.
   void* MapFontBuffer(size_t size) override;
 
@@ -310,6 +325,15 @@ class RASTER_EXPORT RasterImplementation : public RasterInterface,
 
   ClientTransferCache transfer_cache_;
 
+  // Tracks large paths sent over |transfer_cache_| so that rebuilt paths with
+  // the same contents reuse their entries.
+  cc::PathContentCache path_content_cache_;
+
+  // See SetParallelPaintSerialization().
+  scoped_refptr<base::TaskRunner> parallel_serialization_task_runner_;
+  size_t parallel_serialization_max_ranges_ = 1u;
+  size_t parallel_serialization_min_ops_ = 0u;
+
   // Tracing helpers.
   int raster_chromium_id_ = 0;
 
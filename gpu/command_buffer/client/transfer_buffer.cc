@@ -17,6 +17,14 @@
 
 namespace gpu {
 
+namespace {
+
+// The ring buffer is only shrunk after this many times its size has been
+// allocated, so that occasional large uploads don't cause it to thrash.
+const uint64_t kShrinkThreshold = 120;
+
+}  // namespace
+
 TransferBuffer::TransferBuffer(
     CommandBufferHelper* helper)
     : helper_(helper),
@@ -127,6 +135,8 @@ void TransferBuffer::AllocateRingBuffer(unsigned int size) {
       buffer_id_ = id;
       result_buffer_ = buffer_->memory();
       result_shm_offset_ = 0;
+      bytes_since_last_shrink_check_ = 0;
+      high_water_mark_ = 0;
       return;
     }
     // we failed so don't try larger than this.
@@ -139,14 +149,18 @@ static unsigned int ComputePOTSize(unsigned int dimension) {
   return (dimension == 0) ? 0 : 1 << base::bits::Log2Ceiling(dimension);
 }
 
-void TransferBuffer::ReallocateRingBuffer(unsigned int size) {
-  // What size buffer would we ask for if we needed a new one?
+unsigned int TransferBuffer::ComputeBufferSize(unsigned int size) const {
   unsigned int needed_buffer_size = ComputePOTSize(size + result_size_);
   DCHECK_EQ(needed_buffer_size % alignment_, 0u)
       << "Buffer size is not a multiple of alignment_";
   needed_buffer_size = std::max(needed_buffer_size, min_buffer_size_);
   needed_buffer_size = std::max(needed_buffer_size, default_buffer_size_);
-  needed_buffer_size = std::min(needed_buffer_size, max_buffer_size_);
+  return std::min(needed_buffer_size, max_buffer_size_);
+}
+
+void TransferBuffer::ReallocateRingBuffer(unsigned int size) {
+  // What size buffer would we ask for if we needed a new one?
+  unsigned int needed_buffer_size = ComputeBufferSize(size);
 
   if (usable_ && (!HaveBuffer() || needed_buffer_size > buffer_->size())) {
     if (HaveBuffer()) {
@@ -156,10 +170,33 @@ void TransferBuffer::ReallocateRingBuffer(unsigned int size) {
   }
 }
 
+void TransferBuffer::ShrinkRingBufferIfUnderused(unsigned int size) {
+  if (!HaveBuffer())
+    return;
+
+  high_water_mark_ = std::max(high_water_mark_, size);
+  bytes_since_last_shrink_check_ += size;
+  if (bytes_since_last_shrink_check_ < buffer_->size() * kShrinkThreshold)
+    return;
+
+  unsigned int needed_buffer_size = ComputeBufferSize(high_water_mark_);
+  bytes_since_last_shrink_check_ = 0;
+  high_water_mark_ = 0;
+  if (needed_buffer_size > buffer_->size() / 2)
+    return;
+
+  // No block can be in use while allocating, so the buffer can be replaced
+  // like when it grows.
+  TRACE_EVENT1("gpu", "TransferBuffer::Shrink", "size", needed_buffer_size);
+  Free();
+  AllocateRingBuffer(needed_buffer_size);
+}
+
 void* TransferBuffer::AllocUpTo(
     unsigned int size, unsigned int* size_allocated) {
   DCHECK(size_allocated);
 
+  ShrinkRingBufferIfUnderused(size);
   ReallocateRingBuffer(size);
 
   if (!HaveBuffer()) {
@@ -173,6 +210,7 @@ void* TransferBuffer::AllocUpTo(
 }
 
 void* TransferBuffer::Alloc(unsigned int size) {
+  ShrinkRingBufferIfUnderused(size);
   ReallocateRingBuffer(size);
 
   if (!HaveBuffer()) {
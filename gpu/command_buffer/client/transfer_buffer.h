@@ -108,9 +108,16 @@ class GPU_EXPORT TransferBuffer : public TransferBufferInterface {
   unsigned int GetMaxAllocation() const;
 
  private:
+  // Returns the buffer size to ask for to allocate size bytes.
+  unsigned int ComputeBufferSize(unsigned int size) const;
+
   // Tries to reallocate the ring buffer if it's not large enough for size.
   void ReallocateRingBuffer(unsigned int size);
 
+  // Records an allocation of size bytes, and reallocates a smaller ring buffer
+  // if recent allocations would have fit in half of the current one.
+  void ShrinkRingBufferIfUnderused(unsigned int size);
+
   void AllocateRingBuffer(unsigned int size);
 
   CommandBufferHelper* helper_;
@@ -137,6 +144,13 @@ class GPU_EXPORT TransferBuffer : public TransferBufferInterface {
   // Number of bytes since we last flushed.
   unsigned int bytes_since_last_flush_;
 
+  // Number of bytes allocated since the buffer was allocated or we last
+  // considered shrinking it.
+  uint64_t bytes_since_last_shrink_check_ = 0;
+
+  // Largest allocation requested over the same period.
+  unsigned int high_water_mark_ = 0;
+
   // the current buffer.
   scoped_refptr<gpu::Buffer> buffer_;
 
@@ -515,6 +515,54 @@ TEST_F(TransferBufferExpandContractTest, ReallocsToDefault) {
       transfer_buffer_->GetCurrentMaxAllocationWithoutRealloc());
 }
 
+TEST_F(TransferBufferExpandContractTest, ShrinksWhenUnderused) {
+  // Grow to the max size.
+  EXPECT_CALL(*command_buffer(), DestroyTransferBuffer(_))
+      .Times(1)
+      .RetiresOnSaturation();
+  EXPECT_CALL(*command_buffer(),
+              CreateTransferBuffer(kMaxTransferBufferSize, _))
+      .WillOnce(Invoke(
+          command_buffer(),
+          &MockClientCommandBufferCanFail::RealCreateTransferBuffer))
+      .RetiresOnSaturation();
+
+  const unsigned int kLargeSize = kMaxTransferBufferSize - kStartingOffset;
+  unsigned int size_allocated = 0;
+  void* ptr = transfer_buffer_->AllocUpTo(kLargeSize, &size_allocated);
+  ASSERT_TRUE(ptr != NULL);
+  EXPECT_EQ(kLargeSize, size_allocated);
+  transfer_buffer_->DiscardBlock(ptr);
+
+  // Small allocations keep using the large buffer for a while.
+  const unsigned int kSmallSize = 64;
+  unsigned int bytes_allocated = 0;
+  while (bytes_allocated + kSmallSize < kMaxTransferBufferSize * 120) {
+    ptr = transfer_buffer_->Alloc(kSmallSize);
+    ASSERT_TRUE(ptr != NULL);
+    transfer_buffer_->DiscardBlock(ptr);
+    bytes_allocated += kSmallSize;
+  }
+  EXPECT_EQ(kLargeSize,
+            transfer_buffer_->GetCurrentMaxAllocationWithoutRealloc());
+
+  // Eventually the buffer is shrunk back to the default size.
+  EXPECT_CALL(*command_buffer(), DestroyTransferBuffer(_))
+      .Times(1)
+      .RetiresOnSaturation();
+  EXPECT_CALL(*command_buffer(),
+              CreateTransferBuffer(kStartTransferBufferSize, _))
+      .WillOnce(Invoke(
+          command_buffer(),
+          &MockClientCommandBufferCanFail::RealCreateTransferBuffer))
+      .RetiresOnSaturation();
+  ptr = transfer_buffer_->Alloc(kSmallSize);
+  ASSERT_TRUE(ptr != NULL);
+  EXPECT_EQ(kStartTransferBufferSize - kStartingOffset,
+            transfer_buffer_->GetCurrentMaxAllocationWithoutRealloc());
+  transfer_buffer_->DiscardBlock(ptr);
+}
+
 TEST_F(TransferBufferExpandContractTest, Shrink) {
   unsigned int alloc_size = transfer_buffer_->GetFreeSize();
   EXPECT_EQ(kStartTransferBufferSize - kStartingOffset, alloc_size);
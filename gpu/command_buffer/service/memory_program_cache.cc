@@ -493,6 +493,13 @@ void MemoryProgramCache::LoadProgram(const std::string& key,
   std::unique_ptr<GpuProgramProto> proto(
       GpuProgramProto::default_instance().New());
   if (proto->ParseFromString(program)) {
+    // Programs linked or loaded during this session are at least as recent as
+    // the ones from the disk cache, so keep them.
+    if (store_.Peek(proto->sha()) != store_.end())
+      return;
+    if (proto->program().length() > max_size_bytes())
+      return;
+
     AttributeMap vertex_attribs;
     UniformMap vertex_uniforms;
     VaryingMap vertex_varyings;
@@ -550,6 +557,11 @@ void MemoryProgramCache::LoadProgram(const std::string& key,
     std::vector<uint8_t> binary(proto->program().length());
     memcpy(binary.data(), proto->program().c_str(), proto->program().length());
 
+    while (curr_size_bytes_ + binary.size() > max_size_bytes()) {
+      DCHECK(!store_.empty());
+      store_.Erase(store_.rbegin());
+    }
+
     store_.Put(
         proto->sha(),
         new ProgramCacheValue(
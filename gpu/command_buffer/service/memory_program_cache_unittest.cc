@@ -551,6 +551,62 @@ TEST_F(MemoryProgramCacheTest, MemoryProgramCacheEviction) {
                                      old_sig, NULL, varyings_, GL_NONE));
 }
 
+TEST_F(MemoryProgramCacheTest, LoadProgramEvictsToFitCacheSize) {
+  const GLenum kFormat = 1;
+  const int kProgramId = 10;
+  const int kBinaryLength = 20;
+  char test_binary[kBinaryLength];
+  for (int i = 0; i < kBinaryLength; ++i) {
+    test_binary[i] = i;
+  }
+  ProgramBinaryEmulator emulator1(kBinaryLength, kFormat, test_binary);
+
+  SetExpectationsForSaveLinkedProgram(kProgramId, &emulator1);
+  cache_->SaveLinkedProgram(kProgramId, vertex_shader_, fragment_shader_, NULL,
+                            varyings_, GL_NONE, this);
+  const std::string old_sig = fragment_shader_->last_compiled_signature();
+  const std::string old_program = shader_cache_shader();
+
+  const int kEvictingProgramId = 11;
+  const GLuint kEvictingBinaryLength = kCacheSizeBytes - kBinaryLength + 1;
+
+  fragment_shader_->set_source("al sdfkjdk");
+  TestHelper::SetShaderStates(gl_.get(), fragment_shader_, true);
+
+  std::unique_ptr<char[]> bigTestBinary =
+      std::unique_ptr<char[]>(new char[kEvictingBinaryLength]);
+  for (size_t i = 0; i < kEvictingBinaryLength; ++i) {
+    bigTestBinary[i] = i % 250;
+  }
+  ProgramBinaryEmulator emulator2(kEvictingBinaryLength,
+                                  kFormat,
+                                  bigTestBinary.get());
+
+  SetExpectationsForSaveLinkedProgram(kEvictingProgramId, &emulator2);
+  cache_->SaveLinkedProgram(kEvictingProgramId, vertex_shader_,
+                            fragment_shader_, NULL, varyings_, GL_NONE, this);
+  const std::string new_program = shader_cache_shader();
+
+  // Programs from the disk cache don't fit together either, so loading the
+  // second one evicts the first.
+  cache_->Clear();
+  std::string blank;
+  cache_->LoadProgram(blank, old_program);
+  EXPECT_EQ(
+      ProgramCache::LINK_SUCCEEDED,
+      cache_->GetLinkedProgramStatus(vertex_shader_->last_compiled_signature(),
+                                     old_sig, NULL, varyings_, GL_NONE));
+  cache_->LoadProgram(blank, new_program);
+  EXPECT_EQ(ProgramCache::LINK_SUCCEEDED, cache_->GetLinkedProgramStatus(
+      vertex_shader_->last_compiled_signature(),
+      fragment_shader_->last_compiled_signature(),
+      NULL, varyings_, GL_NONE));
+  EXPECT_EQ(
+      ProgramCache::LINK_UNKNOWN,
+      cache_->GetLinkedProgramStatus(vertex_shader_->last_compiled_signature(),
+                                     old_sig, NULL, varyings_, GL_NONE));
+}
+
 TEST_F(MemoryProgramCacheTest, SaveCorrectProgram) {
   const GLenum kFormat = 1;
   const int kProgramId = 10;
@@ -61,12 +61,15 @@ Scheduler::Sequence::WaitFence& Scheduler::Sequence::WaitFence::operator=(
 Scheduler::Sequence::Sequence(Scheduler* scheduler,
                               SequenceId sequence_id,
                               SchedulingPriority priority,
-                              scoped_refptr<SyncPointOrderData> order_data)
+                              scoped_refptr<SyncPointOrderData> order_data,
+                              scoped_refptr<base::SingleThreadTaskRunner>
+                                  task_runner)
     : scheduler_(scheduler),
       sequence_id_(sequence_id),
       default_priority_(priority),
       current_priority_(priority),
-      order_data_(std::move(order_data)) {}
+      order_data_(std::move(order_data)),
+      task_runner_(std::move(task_runner)) {}
 
 Scheduler::Sequence::~Sequence() {
   for (auto& kv : wait_fences_) {
@@ -287,12 +290,19 @@ void Scheduler::Sequence::RemoveClientWait(CommandBufferId command_buffer_id) {
   UpdateSchedulingPriority();
 }
 
+Scheduler::PerThreadState::PerThreadState() = default;
+Scheduler::PerThreadState::PerThreadState(PerThreadState&& other) = default;
+Scheduler::PerThreadState::~PerThreadState() = default;
+Scheduler::PerThreadState& Scheduler::PerThreadState::operator=(
+    PerThreadState&& other) = default;
+
 Scheduler::Scheduler(scoped_refptr<base::SingleThreadTaskRunner> task_runner,
                      SyncPointManager* sync_point_manager)
     : task_runner_(std::move(task_runner)),
       sync_point_manager_(sync_point_manager),
       weak_factory_(this) {
   DCHECK(thread_checker_.CalledOnValidThread());
+  per_thread_state_map_[task_runner_.get()].task_runner = task_runner_;
 }
 
 Scheduler::~Scheduler() {
@@ -300,13 +310,25 @@ Scheduler::~Scheduler() {
 }
 
 SequenceId Scheduler::CreateSequence(SchedulingPriority priority) {
+  return CreateSequence(priority, task_runner_);
+}
+
+SequenceId Scheduler::CreateSequence(
+    SchedulingPriority priority,
+    scoped_refptr<base::SingleThreadTaskRunner> task_runner) {
   DCHECK(thread_checker_.CalledOnValidThread());
+  DCHECK(task_runner);
   base::AutoLock auto_lock(lock_);
+  PerThreadState& thread_state = per_thread_state_map_[task_runner.get()];
+  if (!thread_state.task_runner)
+    thread_state.task_runner = task_runner;
+
   scoped_refptr<SyncPointOrderData> order_data =
       sync_point_manager_->CreateSyncPointOrderData();
   SequenceId sequence_id = order_data->sequence_id();
-  auto sequence = std::make_unique<Sequence>(this, sequence_id, priority,
-                                             std::move(order_data));
+  auto sequence =
+      std::make_unique<Sequence>(this, sequence_id, priority,
+                                 std::move(order_data), std::move(task_runner));
   sequences_.emplace(sequence_id, std::move(sequence));
   return sequence_id;
 }
@@ -318,7 +340,7 @@ void Scheduler::DestroySequence(SequenceId sequence_id) {
   Sequence* sequence = GetSequence(sequence_id);
   DCHECK(sequence);
   if (sequence->scheduled())
-    rebuild_scheduling_queue_ = true;
+    GetThreadState(sequence->task_runner())->rebuild_scheduling_queue = true;
 
   sequences_.erase(sequence_id);
 }
@@ -331,37 +353,45 @@ Scheduler::Sequence* Scheduler::GetSequence(SequenceId sequence_id) {
   return nullptr;
 }
 
+Scheduler::PerThreadState* Scheduler::GetThreadState(
+    base::SingleThreadTaskRunner* task_runner) {
+  lock_.AssertAcquired();
+  auto it = per_thread_state_map_.find(task_runner);
+  DCHECK(it != per_thread_state_map_.end());
+  return &it->second;
+}
+
 void Scheduler::EnableSequence(SequenceId sequence_id) {
-  DCHECK(thread_checker_.CalledOnValidThread());
   base::AutoLock auto_lock(lock_);
   Sequence* sequence = GetSequence(sequence_id);
   DCHECK(sequence);
+  DCHECK(sequence->task_runner()->BelongsToCurrentThread());
   sequence->SetEnabled(true);
 }
 
 void Scheduler::DisableSequence(SequenceId sequence_id) {
-  DCHECK(thread_checker_.CalledOnValidThread());
   base::AutoLock auto_lock(lock_);
   Sequence* sequence = GetSequence(sequence_id);
   DCHECK(sequence);
+  DCHECK(sequence->task_runner()->BelongsToCurrentThread());
   sequence->SetEnabled(false);
 }
 
 void Scheduler::RaisePriorityForClientWait(SequenceId sequence_id,
                                            CommandBufferId command_buffer_id) {
-  DCHECK(thread_checker_.CalledOnValidThread());
   base::AutoLock auto_lock(lock_);
   Sequence* sequence = GetSequence(sequence_id);
   DCHECK(sequence);
+  DCHECK(sequence->task_runner()->BelongsToCurrentThread());
   sequence->AddClientWait(command_buffer_id);
 }
 
 void Scheduler::ResetPriorityForClientWait(SequenceId sequence_id,
                                            CommandBufferId command_buffer_id) {
-  DCHECK(thread_checker_.CalledOnValidThread());
   base::AutoLock auto_lock(lock_);
   Sequence* sequence = GetSequence(sequence_id);
   DCHECK(sequence);
+  DCHECK(sequence->task_runner()->BelongsToCurrentThread());
   sequence->RemoveClientWait(command_buffer_id);
 }
 
@@ -390,11 +420,20 @@ void Scheduler::ScheduleTaskHelper(Task task) {
     Sequence* release_sequence = GetSequence(release_sequence_id);
     if (!release_sequence)
       continue;
-    if (sync_point_manager_->Wait(
-            sync_token, sequence_id, order_num,
-            base::Bind(&Scheduler::SyncTokenFenceReleased,
-                       weak_factory_.GetWeakPtr(), sync_token, order_num,
-                       release_sequence_id, sequence_id))) {
+    // The release callback runs on the thread of the releasing sequence. Weak
+    // pointers to the scheduler may only be used on |task_runner_|, so fences
+    // released on other threads are forwarded there.
+    base::OnceClosure callback = base::BindOnce(
+        &Scheduler::SyncTokenFenceReleased, weak_factory_.GetWeakPtr(),
+        sync_token, order_num, release_sequence_id, sequence_id);
+    bool waiting =
+        release_sequence->task_runner() == task_runner_.get()
+            ? sync_point_manager_->Wait(sync_token, sequence_id, order_num,
+                                        std::move(callback))
+            : sync_point_manager_->WaitNonThreadSafe(
+                  sync_token, sequence_id, order_num, task_runner_,
+                  std::move(callback));
+    if (waiting) {
       sequence->AddWaitFence(sync_token, order_num, release_sequence_id,
                              release_sequence);
     }
@@ -405,27 +444,30 @@ void Scheduler::ScheduleTaskHelper(Task task) {
 
 void Scheduler::ContinueTask(SequenceId sequence_id,
                              base::OnceClosure closure) {
-  DCHECK(thread_checker_.CalledOnValidThread());
   base::AutoLock auto_lock(lock_);
   Sequence* sequence = GetSequence(sequence_id);
   DCHECK(sequence);
+  DCHECK(sequence->task_runner()->BelongsToCurrentThread());
   sequence->ContinueTask(std::move(closure));
 }
 
 bool Scheduler::ShouldYield(SequenceId sequence_id) {
-  DCHECK(thread_checker_.CalledOnValidThread());
   base::AutoLock auto_lock(lock_);
 
-  RebuildSchedulingQueue();
-
-  if (scheduling_queue_.empty())
-    return false;
-
   Sequence* running_sequence = GetSequence(sequence_id);
   DCHECK(running_sequence);
   DCHECK(running_sequence->running());
 
-  Sequence* next_sequence = GetSequence(scheduling_queue_.front().sequence_id);
+  // Only sequences on the same task runner compete for running time.
+  PerThreadState* thread_state =
+      GetThreadState(running_sequence->task_runner());
+  RebuildSchedulingQueue(thread_state);
+
+  if (thread_state->scheduling_queue.empty())
+    return false;
+
+  Sequence* next_sequence =
+      GetSequence(thread_state->scheduling_queue.front().sequence_id);
   DCHECK(next_sequence);
   DCHECK(next_sequence->scheduled());
 
@@ -445,68 +487,90 @@ void Scheduler::SyncTokenFenceReleased(const SyncToken& sync_token,
 
 void Scheduler::TryScheduleSequence(Sequence* sequence) {
   lock_.AssertAcquired();
+  PerThreadState* thread_state = GetThreadState(sequence->task_runner());
 
   if (sequence->running()) {
     // Update priority of running sequence because of sync token releases.
-    DCHECK(running_);
+    DCHECK(thread_state->running);
     sequence->UpdateRunningPriority();
   } else if (sequence->NeedsRescheduling()) {
     // Rebuild scheduling queue if priority changed for a scheduled sequence.
-    DCHECK(running_);
+    DCHECK(thread_state->running);
     DCHECK(sequence->IsRunnable());
-    rebuild_scheduling_queue_ = true;
+    thread_state->rebuild_scheduling_queue = true;
   } else if (!sequence->scheduled() && sequence->IsRunnable()) {
     // Insert into scheduling queue if sequence isn't already scheduled.
     SchedulingState scheduling_state = sequence->SetScheduled();
-    scheduling_queue_.push_back(scheduling_state);
-    std::push_heap(scheduling_queue_.begin(), scheduling_queue_.end(),
-                   &SchedulingState::Comparator);
-    if (!running_) {
-      TRACE_EVENT_ASYNC_BEGIN0("gpu", "Scheduler::Running", this);
-      running_ = true;
-      task_runner_->PostTask(FROM_HERE, base::Bind(&Scheduler::RunNextTask,
-                                                   weak_factory_.GetWeakPtr()));
+    std::vector<SchedulingState>& queue = thread_state->scheduling_queue;
+    queue.push_back(scheduling_state);
+    std::push_heap(queue.begin(), queue.end(), &SchedulingState::Comparator);
+    if (!thread_state->running) {
+      TRACE_EVENT_ASYNC_BEGIN0("gpu", "Scheduler::Running",
+                               thread_state->task_runner.get());
+      thread_state->running = true;
+      PostRunNextTask(thread_state);
     }
   }
 }
 
-void Scheduler::RebuildSchedulingQueue() {
-  DCHECK(thread_checker_.CalledOnValidThread());
+void Scheduler::RebuildSchedulingQueue(PerThreadState* thread_state) {
+  DCHECK(thread_state->task_runner->BelongsToCurrentThread());
   lock_.AssertAcquired();
 
-  if (!rebuild_scheduling_queue_)
+  if (!thread_state->rebuild_scheduling_queue)
     return;
-  rebuild_scheduling_queue_ = false;
+  thread_state->rebuild_scheduling_queue = false;
 
-  scheduling_queue_.clear();
+  std::vector<SchedulingState>& queue = thread_state->scheduling_queue;
+  queue.clear();
   for (const auto& kv : sequences_) {
     Sequence* sequence = kv.second.get();
-    if (!sequence->IsRunnable() || sequence->running())
+    if (sequence->task_runner() != thread_state->task_runner.get() ||
+        !sequence->IsRunnable() || sequence->running()) {
       continue;
+    }
     SchedulingState scheduling_state = sequence->SetScheduled();
-    scheduling_queue_.push_back(scheduling_state);
+    queue.push_back(scheduling_state);
   }
 
-  std::make_heap(scheduling_queue_.begin(), scheduling_queue_.end(),
-                 &SchedulingState::Comparator);
+  std::make_heap(queue.begin(), queue.end(), &SchedulingState::Comparator);
 }
 
-void Scheduler::RunNextTask() {
-  DCHECK(thread_checker_.CalledOnValidThread());
+void Scheduler::PostRunNextTask(PerThreadState* thread_state) {
+  lock_.AssertAcquired();
+  base::SingleThreadTaskRunner* task_runner = thread_state->task_runner.get();
+  // Weak pointers can't be used off |task_runner_|, so tasks on other task
+  // runners rely on those not outliving the scheduler.
+  if (task_runner == task_runner_.get()) {
+    task_runner->PostTask(FROM_HERE,
+                          base::BindOnce(&Scheduler::RunNextTask,
+                                         weak_factory_.GetWeakPtr(),
+                                         base::Unretained(task_runner)));
+  } else {
+    task_runner->PostTask(
+        FROM_HERE, base::BindOnce(&Scheduler::RunNextTask,
+                                  base::Unretained(this),
+                                  base::Unretained(task_runner)));
+  }
+}
+
+void Scheduler::RunNextTask(base::SingleThreadTaskRunner* task_runner) {
+  DCHECK(task_runner->BelongsToCurrentThread());
   base::AutoLock auto_lock(lock_);
 
-  RebuildSchedulingQueue();
+  PerThreadState* thread_state = GetThreadState(task_runner);
+  RebuildSchedulingQueue(thread_state);
 
-  if (scheduling_queue_.empty()) {
-    TRACE_EVENT_ASYNC_END0("gpu", "Scheduler::Running", this);
-    running_ = false;
+  std::vector<SchedulingState>& queue = thread_state->scheduling_queue;
+  if (queue.empty()) {
+    TRACE_EVENT_ASYNC_END0("gpu", "Scheduler::Running", task_runner);
+    thread_state->running = false;
     return;
   }
 
-  std::pop_heap(scheduling_queue_.begin(), scheduling_queue_.end(),
-                &SchedulingState::Comparator);
-  SchedulingState state = scheduling_queue_.back();
-  scheduling_queue_.pop_back();
+  std::pop_heap(queue.begin(), queue.end(), &SchedulingState::Comparator);
+  SchedulingState state = queue.back();
+  queue.pop_back();
 
   TRACE_EVENT1("gpu", "Scheduler::RunNextTask", "state", state.AsValue());
 
@@ -528,20 +592,23 @@ void Scheduler::RunNextTask() {
       order_data->FinishProcessingOrderNumber(order_num);
   }
 
+  // The state may have moved while the lock was released, since other
+  // threads can add task runners.
+  thread_state = GetThreadState(task_runner);
+
   // Check if sequence hasn't been destroyed.
   sequence = GetSequence(state.sequence_id);
   if (sequence) {
     sequence->FinishTask();
     if (sequence->IsRunnable()) {
       SchedulingState scheduling_state = sequence->SetScheduled();
-      scheduling_queue_.push_back(scheduling_state);
-      std::push_heap(scheduling_queue_.begin(), scheduling_queue_.end(),
-                     &SchedulingState::Comparator);
+      std::vector<SchedulingState>& queue = thread_state->scheduling_queue;
+      queue.push_back(scheduling_state);
+      std::push_heap(queue.begin(), queue.end(), &SchedulingState::Comparator);
     }
   }
 
-  task_runner_->PostTask(FROM_HERE, base::Bind(&Scheduler::RunNextTask,
-                                               weak_factory_.GetWeakPtr()));
+  PostRunNextTask(thread_state);
 }
 
 }  // namespace gpu
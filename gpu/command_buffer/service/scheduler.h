@@ -58,6 +58,17 @@ class GPU_EXPORT Scheduler {
   // release clients. Sequences start off as enabled (see |EnableSequence|).
   SequenceId CreateSequence(SchedulingPriority priority);
 
+  // Like the above, but the tasks of the sequence run on |task_runner| instead
+  // of the scheduler's task runner, in parallel with sequences that run on
+  // other task runners. Sequences sharing a task runner are scheduled against
+  // each other by priority. This is meant for sequences such as raster
+  // decoders that don't share a GL context with the others. Sync token fences
+  // between sequences on different task runners are honored as usual. The
+  // task runner must not run tasks after the scheduler is destroyed.
+  SequenceId CreateSequence(
+      SchedulingPriority priority,
+      scoped_refptr<base::SingleThreadTaskRunner> task_runner);
+
   // Destroy the sequence and run any scheduled tasks immediately.
   void DestroySequence(SequenceId sequence_id);
 
@@ -84,7 +95,7 @@ class GPU_EXPORT Scheduler {
   void ScheduleTasks(std::vector<Task> tasks);
 
   // Continue running task on the sequence with the closure. This must be called
-  // while running a previously scheduled task.
+  // while running a previously scheduled task, on the sequence's task runner.
   void ContinueTask(SequenceId sequence_id, base::OnceClosure closure);
 
   // If the sequence should yield so that a higher priority sequence may run.
@@ -120,12 +131,17 @@ class GPU_EXPORT Scheduler {
     Sequence(Scheduler* scheduler,
              SequenceId sequence_id,
              SchedulingPriority priority,
-             scoped_refptr<SyncPointOrderData> order_data);
+             scoped_refptr<SyncPointOrderData> order_data,
+             scoped_refptr<base::SingleThreadTaskRunner> task_runner);
 
     ~Sequence();
 
     SequenceId sequence_id() const { return sequence_id_; }
 
+    base::SingleThreadTaskRunner* task_runner() const {
+      return task_runner_.get();
+    }
+
     const scoped_refptr<SyncPointOrderData>& order_data() const {
       return order_data_;
     }
@@ -277,6 +293,9 @@ class GPU_EXPORT Scheduler {
 
     scoped_refptr<SyncPointOrderData> order_data_;
 
+    // The task runner the tasks of this sequence run on.
+    const scoped_refptr<base::SingleThreadTaskRunner> task_runner_;
+
     // Deque of tasks. Tasks are inserted at the back with increasing order
     // number generated from SyncPointOrderData. If a running task needs to be
     // continued, it is inserted at the front with the same order number.
@@ -297,6 +316,29 @@ class GPU_EXPORT Scheduler {
     DISALLOW_COPY_AND_ASSIGN(Sequence);
   };
 
+  // Scheduling state of the sequences that run on one task runner. Each task
+  // runner runs at most one task at a time, from the highest priority
+  // runnable sequence in its queue.
+  struct PerThreadState {
+    PerThreadState();
+    PerThreadState(PerThreadState&& other);
+    ~PerThreadState();
+    PerThreadState& operator=(PerThreadState&& other);
+
+    scoped_refptr<base::SingleThreadTaskRunner> task_runner;
+
+    // If a RunNextTask is pending or running on |task_runner|.
+    bool running = false;
+
+    // Used as a priority queue for scheduling sequences. Min heap of
+    // SchedulingState with highest priority (lowest order) in front.
+    std::vector<SchedulingState> scheduling_queue;
+
+    // If the scheduling queue needs to be rebuild because a sequence changed
+    // priority.
+    bool rebuild_scheduling_queue = false;
+  };
+
   void SyncTokenFenceReleased(const SyncToken& sync_token,
                               uint32_t order_num,
                               SequenceId release_sequence_id,
@@ -306,11 +348,15 @@ class GPU_EXPORT Scheduler {
 
   void TryScheduleSequence(Sequence* sequence);
 
-  void RebuildSchedulingQueue();
+  void RebuildSchedulingQueue(PerThreadState* thread_state);
 
   Sequence* GetSequence(SequenceId sequence_id);
 
-  void RunNextTask();
+  PerThreadState* GetThreadState(base::SingleThreadTaskRunner* task_runner);
+
+  void PostRunNextTask(PerThreadState* thread_state);
+
+  void RunNextTask(base::SingleThreadTaskRunner* task_runner);
 
   scoped_refptr<base::SingleThreadTaskRunner> task_runner_;
 
@@ -319,17 +365,11 @@ class GPU_EXPORT Scheduler {
   mutable base::Lock lock_;
 
   // The following are protected by |lock_|.
-  bool running_ = false;
-
   base::flat_map<SequenceId, std::unique_ptr<Sequence>> sequences_;
 
-  // Used as a priority queue for scheduling sequences. Min heap of
-  // SchedulingState with highest priority (lowest order) in front.
-  std::vector<SchedulingState> scheduling_queue_;
-
-  // If the scheduling queue needs to be rebuild because a sequence changed
-  // priority.
-  bool rebuild_scheduling_queue_ = false;
+  // Keyed by task runner. Always contains the state of |task_runner_|.
+  base::flat_map<base::SingleThreadTaskRunner*, PerThreadState>
+      per_thread_state_map_;
 
   base::ThreadChecker thread_checker_;
 
@@ -96,6 +96,53 @@ TEST_F(SchedulerTest, ContinuedTasksRunFirst) {
   EXPECT_TRUE(ran2);
 }
 
+TEST_F(SchedulerTest, SequencesOnOtherTaskRunnersWaitForFences) {
+  scoped_refptr<base::TestSimpleTaskRunner> worker_task_runner(
+      new base::TestSimpleTaskRunner());
+
+  SequenceId sequence_id1 =
+      scheduler()->CreateSequence(SchedulingPriority::kNormal);
+  SequenceId sequence_id2 = scheduler()->CreateSequence(
+      SchedulingPriority::kNormal, worker_task_runner);
+
+  CommandBufferNamespace namespace_id = CommandBufferNamespace::GPU_IO;
+  CommandBufferId command_buffer_id = CommandBufferId::FromUnsafeValue(1);
+  scoped_refptr<SyncPointClientState> release_state =
+      sync_point_manager()->CreateSyncPointClientState(
+          namespace_id, command_buffer_id, sequence_id2);
+  uint64_t release = 1;
+  SyncToken sync_token(namespace_id, command_buffer_id, release);
+
+  bool ran1 = false;
+  scheduler()->ScheduleTask(Scheduler::Task(sequence_id1,
+                                            GetClosure([&] { ran1 = true; }),
+                                            {sync_token}));
+
+  bool ran2 = false;
+  scheduler()->ScheduleTask(Scheduler::Task(
+      sequence_id2, GetClosure([&] {
+        release_state->ReleaseFenceSync(release);
+        ran2 = true;
+      }),
+      std::vector<SyncToken>()));
+
+  // The task on the main task runner is blocked on the worker's fence, so
+  // nothing has been posted to it.
+  EXPECT_FALSE(task_runner()->HasPendingTask());
+  worker_task_runner->RunPendingTasks();
+  EXPECT_TRUE(ran2);
+  EXPECT_FALSE(ran1);
+
+  // The release unblocks the task, which runs on the main task runner.
+  while (task_runner()->HasPendingTask())
+    task_runner()->RunPendingTasks();
+  EXPECT_TRUE(ran1);
+
+  release_state->Destroy();
+  scheduler()->DestroySequence(sequence_id2);
+  scheduler()->DestroySequence(sequence_id1);
+}
+
 class SchedulerTaskRunOrderTest : public SchedulerTest {
  public:
   SchedulerTaskRunOrderTest() = default;
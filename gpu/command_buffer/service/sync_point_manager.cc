@@ -190,7 +190,7 @@ SyncPointClientState::SyncPointClientState(
       command_buffer_id_(command_buffer_id) {}
 
 SyncPointClientState::~SyncPointClientState() {
-  DCHECK_EQ(UINT64_MAX, fence_sync_release_);
+  DCHECK_EQ(UINT64_MAX, fence_sync_release_.load());
 }
 
 void SyncPointClientState::Destroy() {
@@ -222,20 +222,28 @@ bool SyncPointClientState::WaitNonThreadSafe(
 }
 
 bool SyncPointClientState::IsFenceSyncReleased(uint64_t release) {
-  base::AutoLock lock(fence_sync_lock_);
-  return release <= fence_sync_release_;
+  return release <= fence_sync_release_.load();
 }
 
 bool SyncPointClientState::WaitForRelease(uint64_t release,
                                           uint32_t wait_order_num,
                                           base::OnceClosure callback) {
+  // Already released, do not run the callback.
+  if (IsFenceSyncReleased(release))
+    return false;
+
   // Lock must be held the whole time while we validate otherwise it could be
   // released while we are checking.
   base::AutoLock auto_lock(fence_sync_lock_);
 
-  // Already released, do not run the callback.
-  if (release <= fence_sync_release_)
+  // Publish the pending wait before checking the release again. A concurrent
+  // release either sees the flag and drains the queue under the lock, or has
+  // already stored a release count that is seen here.
+  has_release_callbacks_.store(true);
+  if (IsFenceSyncReleased(release)) {
+    has_release_callbacks_.store(!release_callback_queue_.empty());
     return false;
+  }
 
   uint64_t callback_id =
       order_data_->ValidateReleaseOrderNumber(this, wait_order_num, release);
@@ -245,6 +253,7 @@ bool SyncPointClientState::WaitForRelease(uint64_t release,
     return true;
   }
 
+  has_release_callbacks_.store(!release_callback_queue_.empty());
   DLOG(ERROR) << "Client waiting on non-existent sync token";
   return false;
 }
@@ -257,15 +266,21 @@ void SyncPointClientState::ReleaseFenceSync(uint64_t release) {
 }
 
 void SyncPointClientState::ReleaseFenceSyncHelper(uint64_t release) {
-  // Call callbacks without the lock to avoid possible deadlocks.
+  // Releases only happen on the order number processing thread (or during
+  // Destroy), so the store doesn't race with other writers.
+  DLOG_IF(ERROR, release <= fence_sync_release_.load())
+      << "Client submitted fence releases out of order.";
+  fence_sync_release_.store(release);
+
+  // Nobody is waiting, skip the lock.
+  if (!has_release_callbacks_.load())
+    return;
+
+  // Call callbacks without the lock to avoid possible deadlocks. All waiters
+  // satisfied by this release are woken in one batch.
   std::vector<base::OnceClosure> callback_list;
   {
     base::AutoLock auto_lock(fence_sync_lock_);
-
-    DLOG_IF(ERROR, release <= fence_sync_release_)
-        << "Client submitted fence releases out of order.";
-    fence_sync_release_ = release;
-
     while (!release_callback_queue_.empty() &&
            release_callback_queue_.top().release_count <= release) {
       ReleaseCallback& release_callback =
@@ -273,6 +288,7 @@ void SyncPointClientState::ReleaseFenceSyncHelper(uint64_t release) {
       callback_list.emplace_back(std::move(release_callback.callback_closure));
       release_callback_queue_.pop();
     }
+    has_release_callbacks_.store(!release_callback_queue_.empty());
   }
 
   for (base::OnceClosure& closure : callback_list)
@@ -286,7 +302,7 @@ void SyncPointClientState::EnsureWaitReleased(uint64_t release,
 
   {
     base::AutoLock auto_lock(fence_sync_lock_);
-    if (release <= fence_sync_release_)
+    if (IsFenceSyncReleased(release))
       return;
 
     std::vector<ReleaseCallback> popped_callbacks;
@@ -311,6 +327,7 @@ void SyncPointClientState::EnsureWaitReleased(uint64_t release,
     for (ReleaseCallback& popped_callback : popped_callbacks) {
       release_callback_queue_.emplace(std::move(popped_callback));
     }
+    has_release_callbacks_.store(!release_callback_queue_.empty());
   }
 
   if (callback) {
@@ -7,6 +7,7 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <queue>
@@ -215,7 +216,7 @@ class GPU_EXPORT SyncPointClientState
 
   ~SyncPointClientState();
 
-  // Returns true if fence sync has been released.
+  // Returns true if fence sync has been released. Does not take the lock.
   bool IsFenceSyncReleased(uint64_t release);
 
   // Queues the callback to be called if the release is valid. If the release
@@ -241,11 +242,19 @@ class GPU_EXPORT SyncPointClientState
   const CommandBufferNamespace namespace_id_;
   const CommandBufferId command_buffer_id_;
 
-  // Protects fence_sync_release_, fence_callback_queue_.
+  // Serializes writes to fence_sync_release_ and has_release_callbacks_ with
+  // modifications of release_callback_queue_.
   base::Lock fence_sync_lock_;
 
-  // Current fence sync release that has been signaled.
-  uint64_t fence_sync_release_ = 0;
+  // Current fence sync release that has been signaled. Readable without the
+  // lock so that checks for already released tokens don't contend with
+  // releases on other threads.
+  std::atomic<uint64_t> fence_sync_release_{0};
+
+  // Set before a waiter checks fence_sync_release_ for the last time and
+  // cleared once release_callback_queue_ drains, so that a release without
+  // waiters can skip the lock.
+  std::atomic<bool> has_release_callbacks_{false};
 
   // In well defined fence sync operations, fence syncs are released in order
   // so simply having a priority queue for callbacks is enough.
@@ -180,6 +180,58 @@ TEST_F(SyncPointManagerTest, BasicFenceSyncWaitRelease) {
   EXPECT_TRUE(sync_point_manager_->IsSyncTokenReleased(sync_token));
 }
 
+TEST_F(SyncPointManagerTest, ReleaseWakesAllSatisfiedWaiters) {
+  CommandBufferNamespace kNamespaceId = gpu::CommandBufferNamespace::GPU_IO;
+  CommandBufferId kReleaseCmdBufferId = CommandBufferId::FromUnsafeValue(0x123);
+  CommandBufferId kWaitCmdBufferId = CommandBufferId::FromUnsafeValue(0x234);
+
+  SyncPointStream release_stream(sync_point_manager_.get(), kNamespaceId,
+                                 kReleaseCmdBufferId);
+  SyncPointStream wait_stream(sync_point_manager_.get(), kNamespaceId,
+                              kWaitCmdBufferId);
+
+  release_stream.AllocateOrderNum();
+  wait_stream.AllocateOrderNum();
+
+  SyncToken sync_token1(kNamespaceId, kReleaseCmdBufferId, 1);
+  SyncToken sync_token2(kNamespaceId, kReleaseCmdBufferId, 2);
+  SyncToken sync_token3(kNamespaceId, kReleaseCmdBufferId, 3);
+
+  wait_stream.BeginProcessing();
+  int test_num1 = 10;
+  int test_num2 = 10;
+  int test_num3 = 10;
+  EXPECT_TRUE(wait_stream.client_state->Wait(
+      sync_token1,
+      base::Bind(&SyncPointManagerTest::SetIntegerFunction, &test_num1, 1)));
+  EXPECT_TRUE(wait_stream.client_state->Wait(
+      sync_token2,
+      base::Bind(&SyncPointManagerTest::SetIntegerFunction, &test_num2, 2)));
+  EXPECT_TRUE(wait_stream.client_state->Wait(
+      sync_token3,
+      base::Bind(&SyncPointManagerTest::SetIntegerFunction, &test_num3, 3)));
+
+  // A single release wakes every waiter it satisfies.
+  release_stream.BeginProcessing();
+  release_stream.client_state->ReleaseFenceSync(2);
+  EXPECT_EQ(1, test_num1);
+  EXPECT_EQ(2, test_num2);
+  EXPECT_EQ(10, test_num3);
+  EXPECT_TRUE(sync_point_manager_->IsSyncTokenReleased(sync_token2));
+  EXPECT_FALSE(sync_point_manager_->IsSyncTokenReleased(sync_token3));
+
+  // Waiting on an already released token is invalid and never runs.
+  int test_num4 = 10;
+  EXPECT_FALSE(wait_stream.client_state->Wait(
+      sync_token1,
+      base::Bind(&SyncPointManagerTest::SetIntegerFunction, &test_num4, 4)));
+  EXPECT_EQ(10, test_num4);
+
+  release_stream.client_state->ReleaseFenceSync(3);
+  EXPECT_EQ(3, test_num3);
+  EXPECT_TRUE(sync_point_manager_->IsSyncTokenReleased(sync_token3));
+}
+
 TEST_F(SyncPointManagerTest, WaitOnSelfFails) {
   CommandBufferNamespace kNamespaceId = gpu::CommandBufferNamespace::GPU_IO;
   CommandBufferId kReleaseCmdBufferId = CommandBufferId::FromUnsafeValue(0x123);
@@ -146,17 +146,22 @@ GpuPreferences GetGpuPreferences() {
   return preferences;
 }
 
+// The GL implementation the decoder sends commands to. The stub doesn't do any
+// GL work, so it measures the decoder overhead only, while the driver measures
+// the decoder and GL together.
+enum class GLBackend { kStub, kDriver };
+
 // This wraps a RecordReplayCommandBuffer and gives it a back-end decoder, as
 // well as a front-end GLES2Implementation. This allows recording commands at
 // the GL level and replaying them to the driver (or a stub).
 class RecordReplayContext : public GpuControl {
  public:
-  RecordReplayContext()
+  explicit RecordReplayContext(GLBackend backend)
       : gpu_preferences_(GetGpuPreferences()),
         share_group_(new gl::GLShareGroup),
         translator_cache_(gpu_preferences_) {
     bool bind_generates_resource = false;
-    if (base::CommandLine::ForCurrentProcess()->HasSwitch("use-stub")) {
+    if (backend == GLBackend::kStub) {
       surface_ = new gl::GLSurfaceStub;
       scoped_refptr<gl::GLContextStub> context_stub =
           new gl::GLContextStub(share_group_.get());
@@ -349,8 +354,14 @@ class RecordReplayContext : public GpuControl {
 // and then a number of performance capturing runs.
 class PerfIterator {
  public:
-  PerfIterator(std::string name, int runs, int iterations)
-      : name_(std::move(name)), runs_(runs), iterations_(iterations) {
+  PerfIterator(std::string name,
+               std::string modifier,
+               int runs,
+               int iterations)
+      : name_(std::move(name)),
+        modifier_(std::move(modifier)),
+        runs_(runs),
+        iterations_(iterations) {
     // When running under linux-perf, we try to isolate the microbenchmark
     // performance:
     // 1- sleep 1 second after warmup so that one can skip perf for
@@ -379,7 +390,7 @@ class PerfIterator {
     } else if (!for_linux_perf_) {
       time = base::TimeTicks::Now();
       double ns = (time - run_start_time_).InNanoseconds() / iterations_;
-      perf_test::PrintResult(name_, "", "wall_time", ns, "ns", true);
+      perf_test::PrintResult(name_, modifier_, "wall_time", ns, "ns", true);
     }
     if (runs_ == 0) {
       if (for_linux_perf_)
@@ -395,6 +406,7 @@ class PerfIterator {
   static constexpr int kWarmupIterations = 2;
 
   std::string name_;
+  std::string modifier_;
   base::TimeTicks run_start_time_;
   int runs_;
   int iterations_;
@@ -405,12 +417,15 @@ class PerfIterator {
   DISALLOW_COPY_AND_ASSIGN(PerfIterator);
 };
 
-class DecoderPerfTest : public testing::Test {
+// Each test runs against both GL backends. Results on the stub are reported
+// with a "_decode_only" modifier, so that the time spent in GL is the
+// difference with the unmodified result.
+class DecoderPerfTest : public testing::TestWithParam<GLBackend> {
  public:
   ~DecoderPerfTest() override = default;
 
   void SetUp() override {
-    context_ = std::make_unique<RecordReplayContext>();
+    context_ = std::make_unique<RecordReplayContext>(GetParam());
     gl_ = context_->gl();
     gl_->GenRenderbuffers(1, &renderbuffer_);
     gl_->BindRenderbuffer(GL_RENDERBUFFER, renderbuffer_);
@@ -430,6 +445,14 @@ class DecoderPerfTest : public testing::Test {
 
   void Replay() { context_->Replay(); }
 
+  void MeasureReplay(const char* name) {
+    PerfIterator iterator(
+        name, GetParam() == GLBackend::kStub ? "_decode_only" : "",
+        kDefaultRuns, kDefaultIterations);
+    while (iterator.Iterate())
+      Replay();
+  }
+
   GLuint CompileShader(GLenum type, const char* source) {
     GLuint shader = gl_->CreateShader(type);
     GLint length = base::checked_cast<GLint>(strlen(source));
@@ -520,7 +543,7 @@ constexpr const float kVertices[] = {
 };
 
 // Measures a loop with Uniform2f and DrawArrays.
-TEST_F(DecoderPerfTest, BasicDraw) {
+TEST_P(DecoderPerfTest, BasicDraw) {
   GLuint program =
       CreateAndLinkProgram(kVertexShader, kFragmentShader, {{"postition", 0}});
   gl_->UseProgram(program);
@@ -559,14 +582,11 @@ TEST_F(DecoderPerfTest, BasicDraw) {
   }
 
   StartReplay();
-  PerfIterator iterator("decoder_basic_draw_100", kDefaultRuns,
-                        kDefaultIterations);
-  while (iterator.Iterate())
-    Replay();
+  MeasureReplay("decoder_basic_draw_100");
 }
 
 // Measures a loop with changing the texture binding between draws.
-TEST_F(DecoderPerfTest, TextureDraw) {
+TEST_P(DecoderPerfTest, TextureDraw) {
   GLuint program =
       CreateAndLinkProgram(kVertexShader, kFragmentShader, {{"position", 0}});
   gl_->UseProgram(program);
@@ -610,14 +630,11 @@ TEST_F(DecoderPerfTest, TextureDraw) {
   }
 
   StartReplay();
-  PerfIterator iterator("decoder_texture_draw_100", kDefaultRuns,
-                        kDefaultIterations);
-  while (iterator.Iterate())
-    Replay();
+  MeasureReplay("decoder_texture_draw_100");
 }
 
 // Measures a loop with changing the program between draws.
-TEST_F(DecoderPerfTest, ProgramDraw) {
+TEST_P(DecoderPerfTest, ProgramDraw) {
   const char kVertexShader2[] =
       "attribute vec2 position;\n"
       "uniform vec2 scale;\n"
@@ -688,11 +705,12 @@ TEST_F(DecoderPerfTest, ProgramDraw) {
   }
 
   StartReplay();
-  PerfIterator iterator("decoder_program_draw_100", kDefaultRuns,
-                        kDefaultIterations);
-  while (iterator.Iterate())
-    Replay();
+  MeasureReplay("decoder_program_draw_100");
 }
 
+INSTANTIATE_TEST_CASE_P(,
+                        DecoderPerfTest,
+                        testing::Values(GLBackend::kStub, GLBackend::kDriver));
+
 }  // anonymous namespace
 }  // namespace gpu
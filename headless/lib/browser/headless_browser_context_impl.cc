@@ -12,6 +12,7 @@
 #include "base/guid.h"
 #include "base/path_service.h"
 #include "content/public/browser/browser_thread.h"
+#include "content/public/browser/render_process_host.h"
 #include "content/public/browser/resource_context.h"
 #include "content/public/browser/storage_partition.h"
 #include "headless/grit/headless_lib_resources.h"
@@ -133,8 +134,11 @@ HeadlessBrowserContextImpl* HeadlessBrowserContextImpl::From(
 // static
 std::unique_ptr<HeadlessBrowserContextImpl> HeadlessBrowserContextImpl::Create(
     HeadlessBrowserContext::Builder* builder) {
-  return base::WrapUnique(new HeadlessBrowserContextImpl(
-      builder->browser_, std::move(builder->options_)));
+  std::unique_ptr<HeadlessBrowserContextImpl> browser_context =
+      base::WrapUnique(new HeadlessBrowserContextImpl(
+          builder->browser_, std::move(builder->options_)));
+  browser_context->MaybeWarmUpSpareRenderer();
+  return browser_context;
 }
 
 HeadlessWebContents::Builder
@@ -326,6 +330,8 @@ HeadlessWebContents* HeadlessBrowserContextImpl::CreateWebContents(
   HeadlessWebContents* result = headless_web_contents.get();
 
   RegisterWebContents(std::move(headless_web_contents));
+  // The new web contents took the spare renderer, if any.
+  MaybeWarmUpSpareRenderer();
 
   return result;
 }
@@ -337,6 +343,11 @@ void HeadlessBrowserContextImpl::RegisterWebContents(
       std::move(web_contents);
 }
 
+void HeadlessBrowserContextImpl::MaybeWarmUpSpareRenderer() {
+  if (context_options_->keep_spare_renderer())
+    content::RenderProcessHost::WarmupSpareRenderProcessHost(this);
+}
+
 void HeadlessBrowserContextImpl::DestroyWebContents(
     HeadlessWebContentsImpl* web_contents) {
   auto it = web_contents_map_.find(web_contents->GetDevToolsAgentHostId());
@@ -519,6 +530,13 @@ HeadlessBrowserContext::Builder::SetCaptureResourceMetadata(
   return *this;
 }
 
+HeadlessBrowserContext::Builder&
+HeadlessBrowserContext::Builder::SetKeepSpareRenderer(
+    bool keep_spare_renderer) {
+  options_->keep_spare_renderer_ = keep_spare_renderer;
+  return *this;
+}
+
 HeadlessBrowserContext* HeadlessBrowserContext::Builder::Build() {
   if (!mojo_bindings_.empty()) {
     // Unless you know what you're doing it's unsafe to allow http/https for a
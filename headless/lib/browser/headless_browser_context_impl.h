@@ -133,6 +133,10 @@ class HEADLESS_EXPORT HeadlessBrowserContextImpl final
   // allowed on the current thread.
   void InitWhileIOAllowed();
 
+  // Starts a spare renderer for the next web contents, if the options ask for
+  // one.
+  void MaybeWarmUpSpareRenderer();
+
   HeadlessBrowserImpl* browser_;  // Not owned.
   std::unique_ptr<HeadlessBrowserContextOptions> context_options_;
   std::unique_ptr<HeadlessResourceContext> resource_context_;
@@ -89,6 +89,11 @@ bool HeadlessBrowserContextOptions::capture_resource_metadata() const {
                                browser_options_->capture_resource_metadata);
 }
 
+bool HeadlessBrowserContextOptions::keep_spare_renderer() const {
+  return ReturnOverriddenValue(keep_spare_renderer_,
+                               browser_options_->keep_spare_renderer);
+}
+
 bool HeadlessBrowserContextOptions::allow_cookies() const {
   return ReturnOverriddenValue(allow_cookies_, browser_options_->allow_cookies);
 }
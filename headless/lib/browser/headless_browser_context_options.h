@@ -54,6 +54,9 @@ class HeadlessBrowserContextOptions {
   // See HeadlessBrowser::Options::capture_resource_metadata.
   bool capture_resource_metadata() const;
 
+  // See HeadlessBrowser::Options::keep_spare_renderer.
+  bool keep_spare_renderer() const;
+
   bool allow_cookies() const;
 
   // See HeadlessBrowser::Options::font_render_hinting.
@@ -91,6 +94,7 @@ class HeadlessBrowserContextOptions {
   base::Optional<base::RepeatingCallback<void(WebPreferences*)>>
       override_web_preferences_callback_;
   base::Optional<bool> capture_resource_metadata_;
+  base::Optional<bool> keep_spare_renderer_;
 
   ProtocolHandlerMap protocol_handlers_;
 
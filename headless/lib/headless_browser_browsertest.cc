@@ -13,6 +13,7 @@
 #include "build/build_config.h"
 #include "content/public/browser/permission_manager.h"
 #include "content/public/browser/permission_type.h"
+#include "content/public/browser/render_process_host.h"
 #include "content/public/browser/web_contents.h"
 #include "content/public/common/content_switches.h"
 #include "content/public/common/url_constants.h"
@@ -94,6 +95,39 @@ IN_PROC_BROWSER_TEST_F(HeadlessBrowserTest, CreateAndDestroyWebContents) {
   EXPECT_TRUE(browser()->GetAllBrowserContexts().empty());
 }
 
+namespace {
+
+size_t CountRenderProcessHosts(HeadlessBrowserContext* browser_context) {
+  content::BrowserContext* context =
+      HeadlessBrowserContextImpl::From(browser_context);
+  size_t count = 0;
+  for (auto it = content::RenderProcessHost::AllHostsIterator(); !it.IsAtEnd();
+       it.Advance()) {
+    if (it.GetCurrentValue()->GetBrowserContext() == context)
+      ++count;
+  }
+  return count;
+}
+
+}  // namespace
+
+IN_PROC_BROWSER_TEST_F(HeadlessBrowserTest, KeepSpareRenderer) {
+  HeadlessBrowserContext* browser_context =
+      browser()
+          ->CreateBrowserContextBuilder()
+          .SetKeepSpareRenderer(true)
+          .Build();
+  EXPECT_EQ(1u, CountRenderProcessHosts(browser_context));
+
+  // The web contents takes the spare renderer and another one is started.
+  HeadlessWebContents* web_contents =
+      browser_context->CreateWebContentsBuilder().Build();
+  EXPECT_TRUE(web_contents);
+  EXPECT_EQ(2u, CountRenderProcessHosts(browser_context));
+
+  browser_context->Close();
+}
+
 IN_PROC_BROWSER_TEST_F(HeadlessBrowserTest,
                        WebContentsAreDestroyedWithContext) {
   HeadlessBrowserContext* browser_context =
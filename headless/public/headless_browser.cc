@@ -193,6 +193,11 @@ Builder& Builder::SetCaptureResourceMetadata(bool capture_resource_metadata) {
   return *this;
 }
 
+Builder& Builder::SetKeepSpareRenderer(bool keep_spare_renderer) {
+  options_.keep_spare_renderer = keep_spare_renderer;
+  return *this;
+}
+
 Builder& Builder::SetCrashDumpsDir(const base::FilePath& dir) {
   options_.crash_dumps_dir = dir;
   return *this;
@@ -191,6 +191,12 @@ struct HEADLESS_EXPORT HeadlessBrowser::Options {
   // blacks holes all writes.
   bool capture_resource_metadata = false;
 
+  // Whether or not a renderer should be started ahead of time for the next
+  // web contents of each browser context, so that loading a page doesn't wait
+  // for a renderer to launch. Useful when rendering many pages in a row. The
+  // number of spare renderers is set with --spare-renderer-process-pool-size.
+  bool keep_spare_renderer = false;
+
   // Set a callback that is invoked to override WebPreferences for RenderViews
   // created within the HeadlessBrowser. Called whenever the WebPreferences of a
   // RenderView change. Executed on the browser main thread.
@@ -273,6 +279,7 @@ class HEADLESS_EXPORT HeadlessBrowser::Options::Builder {
       base::RepeatingCallback<void(WebPreferences*)> callback);
   Builder& SetCrashReporterEnabled(bool enabled);
   Builder& SetCaptureResourceMetadata(bool capture_resource_metadata);
+  Builder& SetKeepSpareRenderer(bool keep_spare_renderer);
   Builder& SetCrashDumpsDir(const base::FilePath& dir);
   Builder& SetFontRenderHinting(
       gfx::FontRenderParams::Hinting font_render_hinting);
@@ -147,6 +147,7 @@ class HEADLESS_EXPORT HeadlessBrowserContext::Builder {
   Builder& SetOverrideWebPreferencesCallback(
       base::RepeatingCallback<void(WebPreferences*)> callback);
   Builder& SetCaptureResourceMetadata(bool capture_resource_metadata);
+  Builder& SetKeepSpareRenderer(bool keep_spare_renderer);
 
   HeadlessBrowserContext* Build();
 
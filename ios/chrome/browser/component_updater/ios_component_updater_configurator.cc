@@ -33,6 +33,7 @@ class IOSConfigurator : public update_client::Configurator {
   int NextCheckDelay() const override;
   int OnDemandDelay() const override;
   int UpdateDelay() const override;
+  int MaxConcurrentUpdates() const override;
   std::vector<GURL> UpdateUrl() const override;
   std::vector<GURL> PingUrl() const override;
   std::string GetProdId() const override;
@@ -87,6 +88,10 @@ int IOSConfigurator::UpdateDelay() const {
   return configurator_impl_.UpdateDelay();
 }
 
+int IOSConfigurator::MaxConcurrentUpdates() const {
+  return configurator_impl_.MaxConcurrentUpdates();
+}
+
 std::vector<GURL> IOSConfigurator::UpdateUrl() const {
   return configurator_impl_.UpdateUrl();
 }
@@ -11,6 +11,7 @@
 #include <memory>
 #include <string>
 
+#include "base/atomic_ref_count.h"
 #include "base/compiler_specific.h"
 #include "base/component_export.h"
 #include "base/files/scoped_file.h"
@@ -90,8 +91,21 @@ class COMPONENT_EXPORT(IPC) Channel : public Sender {
     using GenericAssociatedInterfaceFactory =
         base::Callback<void(mojo::ScopedInterfaceEndpointHandle)>;
 
+    // Counts messages which have been posted to the IPC thread to be sent
+    // but have not been sent yet.
+    using PendingSendCount = base::RefCountedData<base::AtomicRefCount>;
+
     virtual ~AssociatedInterfaceSupport() {}
 
+    // Sync messages sent from threads other than the IPC thread are written
+    // directly when possible, rather than being posted to the IPC thread.
+    // To keep them from overtaking messages which are already waiting to be
+    // sent from the IPC thread, they are only written directly while |count|
+    // is zero. Anyone posting messages to the IPC thread to be sent through
+    // this channel must count them in |count| until they have been sent.
+    virtual void SetPendingSendCount(
+        scoped_refptr<PendingSendCount> count) = 0;
+
     // Returns a ThreadSafeForwarded for this channel which can be used to
     // safely send mojom::Channel requests from arbitrary threads.
     virtual std::unique_ptr<mojo::ThreadSafeForwarder<mojom::Channel>>
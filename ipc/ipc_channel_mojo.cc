@@ -252,6 +252,10 @@ ChannelMojo::CreateThreadSafeChannel() {
       *bootstrap_->GetAssociatedGroup());
 }
 
+void ChannelMojo::SetPendingSendCount(scoped_refptr<PendingSendCount> count) {
+  bootstrap_->SetPendingSendCount(std::move(count));
+}
+
 void ChannelMojo::OnPeerPidReceived(int32_t peer_pid) {
   listener_->OnChannelConnected(peer_pid);
 }
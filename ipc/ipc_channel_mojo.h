@@ -111,6 +111,7 @@ class COMPONENT_EXPORT(IPC) ChannelMojo
   // Channel::AssociatedInterfaceSupport:
   std::unique_ptr<mojo::ThreadSafeForwarder<mojom::Channel>>
   CreateThreadSafeChannel() override;
+  void SetPendingSendCount(scoped_refptr<PendingSendCount> count) override;
   void AddGenericAssociatedInterface(
       const std::string& name,
       const GenericAssociatedInterfaceFactory& factory) override;
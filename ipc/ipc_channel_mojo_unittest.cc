@@ -1177,6 +1177,45 @@ DEFINE_IPC_CHANNEL_MOJO_TEST_CLIENT_WITH_CUSTOM_FIXTURE(SyncAssociatedInterface,
   DestroyProxy();
 }
 
+TEST_F(IPCChannelProxyMojoTest, SyncCallsStayOrdered) {
+  Init("SyncCallsStayOrdered");
+
+  ListenerWithSyncAssociatedInterface listener;
+  CreateProxy(&listener);
+  listener.set_sync_sender(proxy());
+  RunProxy();
+
+  listener.RunUntilQuitRequested();
+
+  EXPECT_TRUE(WaitForClientShutdown());
+  DestroyProxy();
+}
+
+DEFINE_IPC_CHANNEL_MOJO_TEST_CLIENT_WITH_CUSTOM_FIXTURE(SyncCallsStayOrdered,
+                                                        ChannelProxyClient) {
+  SimpleTestClientImpl client_impl;
+  CreateProxy(&client_impl);
+  client_impl.set_sync_sender(proxy());
+  RunProxy();
+
+  IPC::mojom::SimpleTestDriverAssociatedPtr driver;
+  proxy()->GetRemoteAssociatedInterface(&driver);
+
+  // Sync calls from this thread may be written without going through the IO
+  // thread, but must never overtake the async messages sent before them.
+  for (int32_t i = 0; i < 100; ++i) {
+    driver->ExpectValue(i);
+    if (i % 2)
+      driver->ExpectValue(i * 2);
+    int32_t expected_value = -1;
+    EXPECT_TRUE(driver->GetExpectedValue(&expected_value));
+    EXPECT_EQ(i % 2 ? i * 2 : i, expected_value);
+  }
+  RequestQuitAndWaitForAck(driver.get());
+
+  DestroyProxy();
+}
+
 TEST_F(IPCChannelProxyMojoTest, Pause) {
   // Ensures that pausing a channel elicits the expected behavior when sending
   // messages, unpausing, sending more messages, and then manually flushing.
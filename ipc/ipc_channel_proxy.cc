@@ -14,8 +14,10 @@
 #include "base/location.h"
 #include "base/memory/ptr_util.h"
 #include "base/memory/ref_counted.h"
+#include "base/optional.h"
 #include "base/single_thread_task_runner.h"
 #include "base/threading/thread_task_runner_handle.h"
+#include "base/time/time.h"
 #include "build/build_config.h"
 #include "ipc/ipc_channel_factory.h"
 #include "ipc/ipc_listener.h"
@@ -26,8 +28,30 @@
 
 namespace IPC {
 
+namespace {
+
+// How long a single listener task may spend dispatching queued messages before
+// it yields the listener thread to other tasks.
+constexpr base::TimeDelta kListenerQueueTimeBudget =
+    base::TimeDelta::FromMilliseconds(4);
+
+}  // namespace
+
 //------------------------------------------------------------------------------
 
+ChannelProxy::Context::ListenerQueueEntry::ListenerQueueEntry(
+    const Message& message)
+    : message(new Message(message)) {}
+
+ChannelProxy::Context::ListenerQueueEntry::ListenerQueueEntry(
+    base::OnceClosure task)
+    : task(std::move(task)) {}
+
+ChannelProxy::Context::ListenerQueueEntry::ListenerQueueEntry(
+    ListenerQueueEntry&& other) = default;
+
+ChannelProxy::Context::ListenerQueueEntry::~ListenerQueueEntry() = default;
+
 ChannelProxy::Context::Context(
     Listener* listener,
     const scoped_refptr<base::SingleThreadTaskRunner>& ipc_task_runner,
@@ -37,7 +61,9 @@ ChannelProxy::Context::Context(
       ipc_task_runner_(ipc_task_runner),
       channel_connected_called_(false),
       message_filter_router_(new MessageFilterRouter()),
-      peer_pid_(base::kNullProcessId) {
+      peer_pid_(base::kNullProcessId),
+      pending_send_count_(
+          new Channel::AssociatedInterfaceSupport::PendingSendCount) {
   DCHECK(ipc_task_runner_.get());
   // The Listener thread where Messages are handled must be a separate thread
   // to avoid oversubscribing the IO thread. If you trigger this error, you
@@ -67,6 +93,7 @@ void ChannelProxy::Context::CreateChannel(
       channel_->GetAssociatedInterfaceSupport();
   if (support) {
     thread_safe_channel_ = support->CreateThreadSafeChannel();
+    support->SetPendingSendCount(pending_send_count_);
 
     base::AutoLock l(pending_filters_lock_);
     for (auto& entry : pending_io_thread_interfaces_)
@@ -85,8 +112,9 @@ bool ChannelProxy::Context::TryFilters(const Message& message) {
 
   if (message_filter_router_->TryFilters(message)) {
     if (message.dispatch_error()) {
-      listener_task_runner_->PostTask(
-          FROM_HERE, base::Bind(&Context::OnDispatchBadMessage, this, message));
+      PostListenerTask(
+          base::BindOnce(&Context::OnDispatchBadMessage,
+                         base::Unretained(this), message));
     }
 #if BUILDFLAG(IPC_MESSAGE_LOG_ENABLED)
     if (logger->Enabled())
@@ -125,11 +153,28 @@ bool ChannelProxy::Context::OnMessageReceived(const Message& message) {
 
 // Called on the IPC::Channel thread
 bool ChannelProxy::Context::OnMessageReceivedNoFilter(const Message& message) {
-  listener_task_runner_->PostTask(
-      FROM_HERE, base::Bind(&Context::OnDispatchMessage, this, message));
+  EnqueueForListener(ListenerQueueEntry(message));
   return true;
 }
 
+// Called on the IPC::Channel thread
+void ChannelProxy::Context::PostListenerTask(base::OnceClosure task) {
+  EnqueueForListener(ListenerQueueEntry(std::move(task)));
+}
+
+// Called on the IPC::Channel thread
+void ChannelProxy::Context::EnqueueForListener(ListenerQueueEntry entry) {
+  {
+    base::AutoLock lock(listener_queue_lock_);
+    listener_queue_.push_back(std::move(entry));
+    if (listener_queue_task_pending_)
+      return;
+    listener_queue_task_pending_ = true;
+  }
+  listener_task_runner_->PostTask(
+      FROM_HERE, base::Bind(&Context::DispatchListenerQueue, this));
+}
+
 // Called on the IPC::Channel thread
 void ChannelProxy::Context::OnChannelConnected(int32_t peer_pid) {
   // We cache off the peer_pid so it can be safely accessed from both threads.
@@ -145,8 +190,8 @@ void ChannelProxy::Context::OnChannelConnected(int32_t peer_pid) {
   OnAddFilter();
 
   // See above comment about using listener_task_runner_ here.
-  listener_task_runner_->PostTask(
-      FROM_HERE, base::Bind(&Context::OnDispatchConnected, this));
+  PostListenerTask(
+      base::BindOnce(&Context::OnDispatchConnected, base::Unretained(this)));
 }
 
 // Called on the IPC::Channel thread
@@ -155,17 +200,17 @@ void ChannelProxy::Context::OnChannelError() {
     filters_[i]->OnChannelError();
 
   // See above comment about using listener_task_runner_ here.
-  listener_task_runner_->PostTask(
-      FROM_HERE, base::Bind(&Context::OnDispatchError, this));
+  PostListenerTask(
+      base::BindOnce(&Context::OnDispatchError, base::Unretained(this)));
 }
 
 // Called on the IPC::Channel thread
 void ChannelProxy::Context::OnAssociatedInterfaceRequest(
     const std::string& interface_name,
     mojo::ScopedInterfaceEndpointHandle handle) {
-  listener_task_runner_->PostTask(
-      FROM_HERE, base::Bind(&Context::OnDispatchAssociatedInterfaceRequest,
-                            this, interface_name, base::Passed(&handle)));
+  PostListenerTask(base::BindOnce(
+      &Context::OnDispatchAssociatedInterfaceRequest, base::Unretained(this),
+      interface_name, std::move(handle)));
 }
 
 // Called on the IPC::Channel thread
@@ -222,11 +267,14 @@ void ChannelProxy::Context::Clear() {
 // Called on the IPC::Channel thread
 void ChannelProxy::Context::OnSendMessage(std::unique_ptr<Message> message) {
   if (!channel_) {
+    DidSendPostedMessage();
     OnChannelClosed();
     return;
   }
 
-  if (!channel_->Send(message.release()))
+  bool sent = channel_->Send(message.release());
+  DidSendPostedMessage();
+  if (!sent)
     OnChannelError();
 }
 
@@ -299,6 +347,47 @@ void ChannelProxy::Context::AddFilter(MessageFilter* filter) {
       FROM_HERE, base::Bind(&Context::OnAddFilter, this));
 }
 
+// Called on the listener's thread
+void ChannelProxy::Context::DispatchListenerQueue() {
+  // Clearing the flag first lets the IPC thread post another task for entries
+  // queued while this one runs, so that nested run loops started by a handler
+  // still see them. Entries are always taken from the front of the queue, so
+  // dispatch order is unaffected.
+  {
+    base::AutoLock lock(listener_queue_lock_);
+    listener_queue_task_pending_ = false;
+  }
+
+  const base::TimeTicks deadline =
+      base::TimeTicks::Now() + kListenerQueueTimeBudget;
+  while (true) {
+    base::Optional<ListenerQueueEntry> entry;
+    {
+      base::AutoLock lock(listener_queue_lock_);
+      if (listener_queue_.empty())
+        return;
+      if (base::TimeTicks::Now() >= deadline) {
+        if (listener_queue_task_pending_)
+          return;
+        listener_queue_task_pending_ = true;
+        break;
+      }
+      entry.emplace(std::move(listener_queue_.front()));
+      listener_queue_.pop_front();
+    }
+
+    if (entry->message)
+      OnDispatchMessage(*entry->message);
+    else
+      std::move(entry->task).Run();
+  }
+
+  // Out of time with entries left over. Let other work on the listener thread
+  // run before continuing.
+  listener_task_runner_->PostTask(
+      FROM_HERE, base::Bind(&Context::DispatchListenerQueue, this));
+}
+
 // Called on the listener's thread
 void ChannelProxy::Context::OnDispatchMessage(const Message& message) {
   if (!listener_)
@@ -382,7 +471,28 @@ void ChannelProxy::Context::AddGenericAssociatedInterfaceForIOThread(
     support->AddGenericAssociatedInterface(name, factory);
 }
 
+void ChannelProxy::Context::GetRemoteAssociatedInterface(
+    const std::string& name,
+    mojo::ScopedInterfaceEndpointHandle handle) {
+  // The request is posted to the IPC thread by |thread_safe_channel_|, and
+  // the task posted after it runs once it has been sent.
+  WillPostSend();
+  thread_safe_channel().GetAssociatedInterface(
+      name, mojom::GenericInterfaceAssociatedRequest(std::move(handle)));
+  ipc_task_runner()->PostTask(
+      FROM_HERE, base::Bind(&Context::DidSendPostedMessage, this));
+}
+
+void ChannelProxy::Context::WillPostSend() {
+  pending_send_count_->data.Increment();
+}
+
+void ChannelProxy::Context::DidSendPostedMessage() {
+  pending_send_count_->data.Decrement();
+}
+
 void ChannelProxy::Context::Send(Message* message) {
+  WillPostSend();
   ipc_task_runner()->PostTask(
       FROM_HERE, base::Bind(&ChannelProxy::Context::OnSendMessage, this,
                             base::Passed(base::WrapUnique(message))));
@@ -566,8 +676,7 @@ void ChannelProxy::GetGenericRemoteAssociatedInterface(
     const std::string& name,
     mojo::ScopedInterfaceEndpointHandle handle) {
   DCHECK(did_init_);
-  context()->thread_safe_channel().GetAssociatedInterface(
-      name, mojom::GenericInterfaceAssociatedRequest(std::move(handle)));
+  context()->GetRemoteAssociatedInterface(name, std::move(handle));
 }
 
 void ChannelProxy::ClearIPCTaskRunner() {
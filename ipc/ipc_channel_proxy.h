@@ -14,6 +14,7 @@
 
 #include "base/callback.h"
 #include "base/component_export.h"
+#include "base/containers/circular_deque.h"
 #include "base/memory/ref_counted.h"
 #include "base/sequence_checker.h"
 #include "base/synchronization/lock.h"
@@ -267,9 +268,22 @@ class COMPONENT_EXPORT(IPC) ChannelProxy : public Sender {
     // Dispatches a message on the listener thread.
     void OnDispatchMessage(const Message& message);
 
+    // Runs |task| on the listener thread, in order with the messages and
+    // notifications this Context dispatches there. Called on the IPC thread.
+    // |task| is owned by this Context until it runs, and it only runs while a
+    // reference to the Context is held, so it may bind the Context unretained.
+    void PostListenerTask(base::OnceClosure task);
+
     // Sends |message| from appropriate thread.
     void Send(Message* message);
 
+    // Messages posted to the IPC thread which have not been sent yet. See
+    // Channel::AssociatedInterfaceSupport::SetPendingSendCount().
+    const scoped_refptr<Channel::AssociatedInterfaceSupport::PendingSendCount>&
+    pending_send_count() const {
+      return pending_send_count_;
+    }
+
    protected:
     friend class base::RefCountedThreadSafe<Context>;
     ~Context() override;
@@ -316,6 +330,7 @@ class COMPONENT_EXPORT(IPC) ChannelProxy : public Sender {
 
     // Methods called on the listener thread.
     void AddFilter(MessageFilter* filter);
+    void DispatchListenerQueue();
     void OnDispatchConnected();
     void OnDispatchError();
     void OnDispatchBadMessage(const Message& message);
@@ -329,6 +344,17 @@ class COMPONENT_EXPORT(IPC) ChannelProxy : public Sender {
       return thread_safe_channel_->proxy();
     }
 
+    // Requests a remote associated interface through |thread_safe_channel_|.
+    // Safe to call from any thread.
+    void GetRemoteAssociatedInterface(
+        const std::string& name,
+        mojo::ScopedInterfaceEndpointHandle handle);
+
+    // Must bracket every message posted to the IPC thread to be sent. See
+    // Channel::AssociatedInterfaceSupport::SetPendingSendCount().
+    void WillPostSend();
+    void DidSendPostedMessage();
+
     void AddGenericAssociatedInterfaceForIOThread(
         const std::string& name,
         const GenericAssociatedInterfaceFactory& factory);
@@ -336,6 +362,26 @@ class COMPONENT_EXPORT(IPC) ChannelProxy : public Sender {
     scoped_refptr<base::SingleThreadTaskRunner> listener_task_runner_;
     Listener* listener_;
 
+    // Work queued on the IPC thread for the listener thread. Consecutive
+    // entries are run by a single DispatchListenerQueue() task, so a burst of
+    // incoming messages costs one PostTask instead of one per message. An
+    // entry holds either a message to dispatch or a task to run.
+    struct ListenerQueueEntry {
+      explicit ListenerQueueEntry(const Message& message);
+      explicit ListenerQueueEntry(base::OnceClosure task);
+      ListenerQueueEntry(ListenerQueueEntry&& other);
+      ~ListenerQueueEntry();
+
+      std::unique_ptr<Message> message;
+      base::OnceClosure task;
+    };
+    void EnqueueForListener(ListenerQueueEntry entry);
+
+    base::Lock listener_queue_lock_;
+    base::circular_deque<ListenerQueueEntry> listener_queue_;
+    // Whether a DispatchListenerQueue() task has been posted and not started.
+    bool listener_queue_task_pending_ = false;
+
     // List of filters.  This is only accessed on the IPC thread.
     std::vector<scoped_refptr<MessageFilter> > filters_;
     scoped_refptr<base::SingleThreadTaskRunner> ipc_task_runner_;
@@ -371,6 +417,10 @@ class COMPONENT_EXPORT(IPC) ChannelProxy : public Sender {
     std::unique_ptr<mojo::ThreadSafeForwarder<mojom::Channel>>
         thread_safe_channel_;
 
+    // Messages posted to the IPC thread which have not been sent yet.
+    const scoped_refptr<Channel::AssociatedInterfaceSupport::PendingSendCount>
+        pending_send_count_;
+
     // Holds associated interface binders added by
     // AddGenericAssociatedInterfaceForIOThread until the underlying channel has
     // been initialized.
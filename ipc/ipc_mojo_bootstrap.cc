@@ -105,7 +105,9 @@ class ChannelAssociatedGroupController
         filters_(this),
         control_message_handler_(this),
         control_message_proxy_thunk_(this),
-        control_message_proxy_(&control_message_proxy_thunk_) {
+        control_message_proxy_(&control_message_proxy_thunk_),
+        pending_send_count_(
+            new Channel::AssociatedInterfaceSupport::PendingSendCount) {
     thread_checker_.DetachFromThread();
     control_message_handler_.SetDescription(
         "IPC::mojom::Bootstrap [master] PipeControlMessageHandler");
@@ -115,6 +117,13 @@ class ChannelAssociatedGroupController
     GetMemoryDumpProvider().AddController(this);
   }
 
+  void SetExternalPendingSendCount(
+      scoped_refptr<Channel::AssociatedInterfaceSupport::PendingSendCount>
+          count) {
+    base::AutoLock lock(direct_send_lock_);
+    external_pending_send_count_ = std::move(count);
+  }
+
   size_t GetQueuedMessageCount() {
     base::AutoLock lock(outgoing_messages_lock_);
     return outgoing_messages_.size();
@@ -124,24 +133,29 @@ class ChannelAssociatedGroupController
     DCHECK(thread_checker_.CalledOnValidThread());
     DCHECK(task_runner_->BelongsToCurrentThread());
 
+    // Sync messages may be written directly from the thread which sends them,
+    // so the connector must support sending from multiple threads.
     connector_.reset(new mojo::Connector(
-        std::move(handle), mojo::Connector::SINGLE_THREADED_SEND,
+        std::move(handle), mojo::Connector::MULTI_THREADED_SEND,
         task_runner_));
     connector_->set_incoming_receiver(&filters_);
     connector_->set_connection_error_handler(
         base::Bind(&ChannelAssociatedGroupController::OnPipeError,
                    base::Unretained(this)));
     connector_->SetWatcherHeapProfilerTag("IPC Channel");
+    UpdateCanSendDirectly();
   }
 
   void Pause() {
     DCHECK(!paused_);
     paused_ = true;
+    UpdateCanSendDirectly();
   }
 
   void Unpause() {
     DCHECK(paused_);
     paused_ = false;
+    UpdateCanSendDirectly();
   }
 
   void FlushOutgoingMessages() {
@@ -152,6 +166,7 @@ class ChannelAssociatedGroupController
     }
     for (auto& message : outgoing_messages)
       SendMessage(&message);
+    UpdateCanSendDirectly();
   }
 
   void CreateChannelEndpoints(mojom::ChannelAssociatedPtr* sender,
@@ -187,6 +202,7 @@ class ChannelAssociatedGroupController
   void ShutDown() {
     DCHECK(thread_checker_.CalledOnValidThread());
     shut_down_ = true;
+    UpdateCanSendDirectly();
     connector_->CloseMessagePipe();
     OnPipeError();
     connector_.reset();
@@ -632,6 +648,39 @@ class ChannelAssociatedGroupController
     GetMemoryDumpProvider().RemoveController(this);
   }
 
+  // Enables or disables direct sends from other threads to match the current
+  // state of the master endpoint. Must be called on the master endpoint's
+  // thread whenever that state changes.
+  void UpdateCanSendDirectly() {
+    DCHECK(thread_checker_.CalledOnValidThread());
+    bool can_send_directly = connector_ && !paused_ && !shut_down_;
+    if (can_send_directly) {
+      base::AutoLock locker(lock_);
+      can_send_directly = !encountered_error_;
+    }
+    if (can_send_directly) {
+      base::AutoLock lock(outgoing_messages_lock_);
+      can_send_directly = outgoing_messages_.empty();
+    }
+    base::AutoLock lock(direct_send_lock_);
+    can_send_directly_ = can_send_directly;
+  }
+
+  // Writes |message| to the pipe from the calling thread, if that can be done
+  // without reordering it ahead of messages already posted to the master
+  // endpoint's thread. Returns false if |message| was not sent.
+  bool TrySendMessageDirectly(mojo::Message* message) {
+    base::AutoLock lock(direct_send_lock_);
+    if (!can_send_directly_ || !pending_send_count_->data.IsZero() ||
+        (external_pending_send_count_ &&
+         !external_pending_send_count_->data.IsZero())) {
+      return false;
+    }
+    if (!connector_->Accept(message))
+      RaiseError();
+    return true;
+  }
+
   bool SendMessage(mojo::Message* message) {
     if (task_runner_->BelongsToCurrentThread()) {
       DCHECK(thread_checker_.CalledOnValidThread());
@@ -655,8 +704,19 @@ class ChannelAssociatedGroupController
       // information to the task scheduler.
       CHECK_LE(message->data_num_bytes(), Channel::kMaximumMessageSize);
 
-      // We always post tasks to the master endpoint thread when called from
-      // other threads in order to simulate IPC::ChannelProxy::Send behavior.
+      // A thread making a sync call blocks until the reply comes back, so
+      // sync messages skip the hop through the master endpoint's thread
+      // whenever they can.
+      if (message->has_flag(mojo::Message::kFlagIsSync) &&
+          TrySendMessageDirectly(message)) {
+        return true;
+      }
+
+      pending_send_count_->data.Increment();
+
+      // Otherwise we post tasks to the master endpoint thread when called
+      // from other threads in order to simulate IPC::ChannelProxy::Send
+      // behavior.
       task_runner_->PostTask(
           FROM_HERE,
           base::Bind(
@@ -670,6 +730,7 @@ class ChannelAssociatedGroupController
     DCHECK(thread_checker_.CalledOnValidThread());
     if (!SendMessage(&message))
       RaiseError();
+    pending_send_count_->data.Decrement();
   }
 
   void OnPipeError() {
@@ -679,6 +740,11 @@ class ChannelAssociatedGroupController
     // below to release all other references.
     scoped_refptr<ChannelAssociatedGroupController> keepalive(this);
 
+    {
+      base::AutoLock lock(direct_send_lock_);
+      can_send_directly_ = false;
+    }
+
     base::AutoLock locker(lock_);
     encountered_error_ = true;
 
@@ -934,6 +1000,23 @@ class ChannelAssociatedGroupController
   // real message pipe.
   std::vector<mojo::Message> outgoing_messages_;
 
+  // Guards the two fields below, which decide whether sync messages sent
+  // from other threads may be written to |connector_| directly. Held for the
+  // duration of such writes so that |connector_| stays alive.
+  base::Lock direct_send_lock_;
+  bool can_send_directly_ = false;
+
+  // Messages posted to this thread by the channel's users, e.g. through
+  // IPC::ChannelProxy. See |pending_send_count_|.
+  scoped_refptr<Channel::AssociatedInterfaceSupport::PendingSendCount>
+      external_pending_send_count_;
+
+  // Messages posted to the master endpoint's thread to be sent. Messages are
+  // only sent directly while this is zero, so that they never overtake an
+  // earlier message from the same thread.
+  const scoped_refptr<Channel::AssociatedInterfaceSupport::PendingSendCount>
+      pending_send_count_;
+
   // Guards the fields below for thread-safe access.
   base::Lock lock_;
 
@@ -1000,6 +1083,12 @@ class MojoBootstrapImpl : public MojoBootstrap {
     return &associated_group_;
   }
 
+  void SetPendingSendCount(
+      scoped_refptr<Channel::AssociatedInterfaceSupport::PendingSendCount>
+          count) override {
+    controller_->SetExternalPendingSendCount(std::move(count));
+  }
+
   scoped_refptr<ChannelAssociatedGroupController> controller_;
   mojo::AssociatedGroup associated_group_;
 
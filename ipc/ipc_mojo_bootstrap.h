@@ -57,6 +57,11 @@ class COMPONENT_EXPORT(IPC) MojoBootstrap {
 
   virtual mojo::AssociatedGroup* GetAssociatedGroup() = 0;
 
+  // See Channel::AssociatedInterfaceSupport::SetPendingSendCount().
+  virtual void SetPendingSendCount(
+      scoped_refptr<Channel::AssociatedInterfaceSupport::PendingSendCount>
+          count) = 0;
+
   enum { kMaxOutgoingMessagesSizeForTesting = 100000u };
 };
 
@@ -41,6 +41,7 @@ class PerformanceChannelListener : public Listener {
         msg_count_(0),
         msg_size_(0),
         sync_(false),
+        burst_(false),
         count_down_(0) {
     VLOG(1) << "Server listener up";
   }
@@ -52,12 +53,14 @@ class PerformanceChannelListener : public Listener {
     sender_ = sender;
   }
 
-  // Call this before running the message loop.
-  void SetTestParams(int msg_count, size_t msg_size, bool sync) {
+  // Call this before running the message loop. In |burst| mode all pings are
+  // sent up front, so the replies arrive back to back.
+  void SetTestParams(int msg_count, size_t msg_size, bool sync, bool burst) {
     DCHECK_EQ(0, count_down_);
     msg_count_ = msg_count;
     msg_size_ = msg_size;
     sync_ = sync;
+    burst_ = burst;
     count_down_ = msg_count_;
     payload_ = std::string(msg_size_, 'a');
   }
@@ -89,6 +92,9 @@ class PerformanceChannelListener : public Listener {
       }
       perf_logger_.reset();
       base::RunLoop::QuitCurrentWhenIdleDeprecated();
+    } else if (burst_) {
+      for (int i = 0; i < msg_count_; ++i)
+        SendPong();
     } else {
       SendPong();
     }
@@ -106,7 +112,8 @@ class PerformanceChannelListener : public Listener {
       return;
     }
 
-    SendPong();
+    if (!burst_)
+      SendPong();
   }
 
   void SendPong() { sender_->Send(new TestMsg_Ping(payload_)); }
@@ -117,6 +124,7 @@ class PerformanceChannelListener : public Listener {
   int msg_count_;
   size_t msg_size_;
   bool sync_;
+  bool burst_;
 
   int count_down_;
   std::string payload_;
@@ -197,7 +205,7 @@ class MojoChannelPerfTest : public IPCChannelMojoTestBase {
     std::vector<PingPongTestParams> params = GetDefaultTestParams();
     for (size_t i = 0; i < params.size(); i++) {
       listener.SetTestParams(params[i].message_count(),
-                             params[i].message_size(), false);
+                             params[i].message_size(), false, false);
 
       // This initial message will kick-start the ping-pong of messages.
       channel_proxy->Send(new TestMsg_Hello);
@@ -213,6 +221,37 @@ class MojoChannelPerfTest : public IPCChannelMojoTestBase {
     channel_proxy.reset();
   }
 
+  // Measures dispatch of bursts of incoming messages on the listener thread.
+  void RunTestChannelProxyBurst() {
+    Init("MojoPerfTestClient");
+
+    // Set up IPC channel and start client.
+    PerformanceChannelListener listener("ChannelProxyBurst");
+    auto channel_proxy = IPC::ChannelProxy::Create(
+        TakeHandle().release(), IPC::Channel::MODE_SERVER, &listener,
+        GetIOThreadTaskRunner(), base::ThreadTaskRunnerHandle::Get());
+    listener.Init(channel_proxy.get());
+
+    LockThreadAffinity thread_locker(kSharedCore);
+    std::vector<PingPongTestParams> params = GetDefaultTestParams();
+    for (size_t i = 0; i < params.size(); i++) {
+      listener.SetTestParams(params[i].message_count(),
+                             params[i].message_size(), false, true);
+
+      // The client echoes hello, which starts the burst.
+      channel_proxy->Send(new TestMsg_Hello);
+
+      // Run message loop.
+      base::RunLoop().Run();
+    }
+
+    // Send quit message.
+    channel_proxy->Send(new TestMsg_Quit);
+
+    EXPECT_TRUE(WaitForClientShutdown());
+    channel_proxy.reset();
+  }
+
   void RunTestChannelProxySyncPing() {
     Init("MojoPerfTestClient");
 
@@ -231,7 +270,7 @@ class MojoChannelPerfTest : public IPCChannelMojoTestBase {
     std::vector<PingPongTestParams> params = GetDefaultTestParams();
     for (size_t i = 0; i < params.size(); i++) {
       listener.SetTestParams(params[i].message_count(),
-                             params[i].message_size(), true);
+                             params[i].message_size(), true, false);
 
       // This initial message will kick-start the ping-pong of messages.
       channel_proxy->Send(new TestMsg_Hello);
@@ -255,6 +294,13 @@ TEST_F(MojoChannelPerfTest, ChannelProxyPingPong) {
   run_loop.RunUntilIdle();
 }
 
+TEST_F(MojoChannelPerfTest, ChannelProxyBurst) {
+  RunTestChannelProxyBurst();
+
+  base::RunLoop run_loop;
+  run_loop.RunUntilIdle();
+}
+
 TEST_F(MojoChannelPerfTest, ChannelProxySyncPing) {
   RunTestChannelProxySyncPing();
 
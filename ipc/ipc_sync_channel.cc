@@ -171,9 +171,12 @@ class SyncChannel::ReceivedSyncMsgQueue :
 
     dispatch_event_.Signal();
     if (!was_task_pending) {
-      listener_task_runner_->PostTask(
-          FROM_HERE, base::Bind(&ReceivedSyncMsgQueue::DispatchMessagesTask,
-                                this, base::RetainedRef(context)));
+      // Go through |context|'s listener queue so that the task runs after the
+      // asynchronous messages received before |msg|. The queue is owned by
+      // |context| and only runs tasks while holding a reference to it.
+      context->PostListenerTask(
+          base::BindOnce(&ReceivedSyncMsgQueue::DispatchMessagesTask, this,
+                         base::Unretained(context)));
     }
   }
 
@@ -594,6 +597,7 @@ void SyncChannel::SetRestrictDispatchChannelGroup(int group) {
 scoped_refptr<SyncMessageFilter> SyncChannel::CreateSyncMessageFilter() {
   scoped_refptr<SyncMessageFilter> filter = new SyncMessageFilter(
       sync_context()->shutdown_event());
+  filter->pending_send_count_ = context()->pending_send_count();
   AddFilter(filter.get());
   if (!did_init())
     pre_init_sync_message_filters_.push_back(filter);
@@ -36,9 +36,11 @@ bool SyncMessageFilter::Send(Message* message) {
         return true;
       }
     }
+    if (pending_send_count_)
+      pending_send_count_->data.Increment();
     io_task_runner_->PostTask(
-        FROM_HERE,
-        base::Bind(&SyncMessageFilter::SendOnIOThread, this, message));
+        FROM_HERE, base::Bind(&SyncMessageFilter::SendPostedMessageOnIOThread,
+                              this, message));
     return true;
   }
 
@@ -61,9 +63,12 @@ bool SyncMessageFilter::Send(Message* message) {
     pending_sync_messages_.insert(&pending_message);
 
     if (io_task_runner_.get()) {
+      if (pending_send_count_)
+        pending_send_count_->data.Increment();
       io_task_runner_->PostTask(
           FROM_HERE,
-          base::Bind(&SyncMessageFilter::SendOnIOThread, this, message));
+          base::Bind(&SyncMessageFilter::SendPostedMessageOnIOThread, this,
+                     message));
     } else {
       pending_messages_.emplace_back(base::WrapUnique(message));
     }
@@ -165,6 +170,12 @@ void SyncMessageFilter::SendOnIOThread(Message* message) {
   delete message;
 }
 
+void SyncMessageFilter::SendPostedMessageOnIOThread(Message* message) {
+  SendOnIOThread(message);
+  if (pending_send_count_)
+    pending_send_count_->data.Decrement();
+}
+
 void SyncMessageFilter::SignalAllEvents() {
   lock_.AssertAcquired();
   for (PendingSyncMessages::iterator iter = pending_sync_messages_.begin();
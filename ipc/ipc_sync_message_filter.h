@@ -12,6 +12,7 @@
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
 #include "base/synchronization/lock.h"
+#include "ipc/ipc_channel.h"
 #include "ipc/ipc_sender.h"
 #include "ipc/ipc_sync_message.h"
 #include "ipc/message_filter.h"
@@ -65,6 +66,7 @@ class COMPONENT_EXPORT(IPC) SyncMessageFilter : public MessageFilter,
   friend class SyncChannel;
 
   void SendOnIOThread(Message* message);
+  void SendPostedMessageOnIOThread(Message* message);
   // Signal all the pending sends as done, used in an error condition.
   void SignalAllEvents();
 
@@ -76,6 +78,11 @@ class COMPONENT_EXPORT(IPC) SyncMessageFilter : public MessageFilter,
   // The channel to which this filter was added.
   Channel* channel_;
 
+  // Counts messages posted to the IO thread by Send() until they have been
+  // sent. Set by SyncChannel on creation.
+  scoped_refptr<Channel::AssociatedInterfaceSupport::PendingSendCount>
+      pending_send_count_;
+
   // The process's main thread.
   scoped_refptr<base::SingleThreadTaskRunner> listener_task_runner_;
 
@@ -13,6 +13,7 @@
 namespace media {
 
 static const int kBenchmarkIterations = 200000;
+static const int kSurroundBenchmarkIterations = 20000;
 
 // InputCallback that zero's out the provided AudioBus.
 class NullInputProvider : public AudioConverter::InputCallback {
@@ -29,6 +30,7 @@ class NullInputProvider : public AudioConverter::InputCallback {
 void RunConvertBenchmark(const AudioParameters& in_params,
                          const AudioParameters& out_params,
                          bool fifo,
+                         int iterations,
                          const std::string& trace_name) {
   NullInputProvider fake_input1;
   NullInputProvider fake_input2;
@@ -41,10 +43,10 @@ void RunConvertBenchmark(const AudioParameters& in_params,
   converter.AddInput(&fake_input3);
 
   base::TimeTicks start = base::TimeTicks::Now();
-  for (int i = 0; i < kBenchmarkIterations; ++i) {
+  for (int i = 0; i < iterations; ++i) {
     converter.Convert(output_bus.get());
   }
-  double runs_per_second = kBenchmarkIterations /
+  double runs_per_second = iterations /
                            (base::TimeTicks::Now() - start).InSecondsF();
   perf_test::PrintResult(
       "audio_converter", "", trace_name, runs_per_second, "runs/s", true);
@@ -58,7 +60,8 @@ TEST(AudioConverterPerfTest, ConvertBenchmark) {
   AudioParameters output_params(AudioParameters::AUDIO_PCM_LINEAR,
                                 CHANNEL_LAYOUT_STEREO, 44100, 440);
 
-  RunConvertBenchmark(input_params, output_params, false, "convert");
+  RunConvertBenchmark(input_params, output_params, false, kBenchmarkIterations,
+                      "convert");
 }
 
 TEST(AudioConverterPerfTest, ConvertBenchmarkFIFO) {
@@ -71,9 +74,26 @@ TEST(AudioConverterPerfTest, ConvertBenchmarkFIFO) {
   AudioParameters output_params(AudioParameters::AUDIO_PCM_LINEAR,
                                 CHANNEL_LAYOUT_STEREO, 44100, 440);
 
-  RunConvertBenchmark(input_params, output_params, true, "convert_fifo_only");
-  RunConvertBenchmark(input_params, output_params, false,
+  RunConvertBenchmark(input_params, output_params, true, kBenchmarkIterations,
+                      "convert_fifo_only");
+  RunConvertBenchmark(input_params, output_params, false, kBenchmarkIterations,
                       "convert_pass_through");
 }
 
+TEST(AudioConverterPerfTest, ConvertBenchmarkSurround) {
+  // High sample rate surround content, which runs every channel through the
+  // resampler and the channel mixer.
+  AudioParameters input_params(AudioParameters::AUDIO_PCM_LINEAR,
+                               CHANNEL_LAYOUT_5_1, 96000, 2048);
+  AudioParameters downmix_params(AudioParameters::AUDIO_PCM_LINEAR,
+                                 CHANNEL_LAYOUT_STEREO, 48000, 480);
+  AudioParameters upmix_params(AudioParameters::AUDIO_PCM_LINEAR,
+                               CHANNEL_LAYOUT_7_1, 48000, 480);
+
+  RunConvertBenchmark(input_params, downmix_params, false,
+                      kSurroundBenchmarkIterations, "convert_surround_downmix");
+  RunConvertBenchmark(input_params, upmix_params, false,
+                      kSurroundBenchmarkIterations, "convert_surround_upmix");
+}
+
 } // namespace media
@@ -4,13 +4,17 @@
 
 #include "media/base/audio_renderer_mixer.h"
 
+#include <algorithm>
 #include <cmath>
+#include <iterator>
+#include <limits>
 
 #include "base/bind.h"
 #include "base/bind_helpers.h"
 #include "base/logging.h"
 #include "base/memory/ptr_util.h"
 #include "base/metrics/histogram_macros.h"
+#include "base/threading/platform_thread.h"
 #include "base/trace_event/trace_event.h"
 #include "media/base/audio_timestamp_helper.h"
 
@@ -18,6 +22,10 @@ namespace media {
 
 enum { kPauseDelaySeconds = 10 };
 
+// Special values of |render_generation_|.  Snapshot generations start at 1.
+constexpr uint64_t kRenderIdle = 0;
+constexpr uint64_t kRenderStarting = std::numeric_limits<uint64_t>::max();
+
 // Tracks the maximum value of a counter and logs it into a UMA histogram upon
 // each increase of the maximum. NOT thread-safe, make sure it is used under
 // lock.
@@ -55,12 +63,16 @@ AudioRendererMixer::AudioRendererMixer(const AudioParameters& output_params,
                                        const UmaLogCallback& log_callback)
     : output_params_(output_params),
       audio_sink_(std::move(sink)),
-      master_converter_(output_params, output_params, true),
-      pause_delay_(base::TimeDelta::FromSeconds(kPauseDelaySeconds)),
-      last_play_time_(base::TimeTicks::Now()),
+      last_generation_(1),
       // Initialize |playing_| to true since Start() results in an auto-play.
       playing_(true),
-      input_count_tracker_(new UMAMaxValueTracker(log_callback)) {
+      input_count_tracker_(new UMAMaxValueTracker(log_callback)),
+      pending_inputs_(nullptr),
+      render_generation_(kRenderIdle),
+      applied_inputs_(new InputSnapshot{last_generation_, {}}),
+      master_converter_(output_params, output_params, true),
+      pause_delay_(base::TimeDelta::FromSeconds(kPauseDelaySeconds)),
+      last_play_time_(base::TimeTicks::Now()) {
   DCHECK(audio_sink_);
   audio_sink_->Initialize(output_params, this);
   audio_sink_->Start();
@@ -71,6 +83,8 @@ AudioRendererMixer::~AudioRendererMixer() {
   audio_sink_->Stop();
 
   // Ensure that all mixer inputs have removed themselves prior to destruction.
+  DCHECK(inputs_.empty());
+  ApplyPendingInputs();
   DCHECK(master_converter_.empty());
   DCHECK(converters_.empty());
   DCHECK_EQ(error_callbacks_.size(), 0U);
@@ -81,13 +95,96 @@ void AudioRendererMixer::AddMixerInput(const AudioParameters& input_params,
   base::AutoLock auto_lock(lock_);
   if (!playing_) {
     playing_ = true;
-    last_play_time_ = base::TimeTicks::Now();
     audio_sink_->Play();
   }
 
-  int input_sample_rate = input_params.sample_rate();
+  MixerInput mixer_input = {input, input_params};
+  auto it = std::lower_bound(
+      inputs_.begin(), inputs_.end(), mixer_input,
+      [](const MixerInput& a, const MixerInput& b) {
+        return a.callback < b.callback;
+      });
+  DCHECK(it == inputs_.end() || it->callback != input);
+  inputs_.insert(it, mixer_input);
+  PublishInputsLocked();
+
+  input_count_tracker_->Increment();
+}
+
+void AudioRendererMixer::RemoveMixerInput(
+    const AudioParameters& input_params,
+    AudioConverter::InputCallback* input) {
+  uint64_t generation;
+  {
+    base::AutoLock auto_lock(lock_);
+    auto it = std::find_if(
+        inputs_.begin(), inputs_.end(),
+        [input](const MixerInput& entry) { return entry.callback == input; });
+    DCHECK(it != inputs_.end());
+    inputs_.erase(it);
+    generation = PublishInputsLocked();
+
+    input_count_tracker_->Decrement();
+  }
+
+  // |input| may be destroyed as soon as this returns.
+  WaitForRenderToCatchUp(generation);
+}
+
+uint64_t AudioRendererMixer::PublishInputsLocked() {
+  lock_.AssertAcquired();
+  InputSnapshot* snapshot = new InputSnapshot{++last_generation_, inputs_};
+
+  // A snapshot that is still pending was never seen by Render(), so it can be
+  // dropped here.
+  delete pending_inputs_.exchange(snapshot);
+  return snapshot->generation;
+}
+
+void AudioRendererMixer::WaitForRenderToCatchUp(uint64_t generation) {
+  for (;;) {
+    const uint64_t render_generation = render_generation_.load();
+    if (render_generation == kRenderIdle ||
+        (render_generation != kRenderStarting &&
+         render_generation >= generation)) {
+      return;
+    }
+    // The Render() call in progress will be done within one buffer.
+    base::PlatformThread::YieldCurrentThread();
+  }
+}
+
+bool AudioRendererMixer::ApplyPendingInputs() {
+  std::unique_ptr<InputSnapshot> snapshot(pending_inputs_.exchange(nullptr));
+  if (!snapshot)
+    return false;
+
+  auto by_callback = [](const MixerInput& a, const MixerInput& b) {
+    return a.callback < b.callback;
+  };
+  std::vector<MixerInput> removed;
+  std::set_difference(applied_inputs_->inputs.begin(),
+                      applied_inputs_->inputs.end(), snapshot->inputs.begin(),
+                      snapshot->inputs.end(), std::back_inserter(removed),
+                      by_callback);
+  std::vector<MixerInput> added;
+  std::set_difference(snapshot->inputs.begin(), snapshot->inputs.end(),
+                      applied_inputs_->inputs.begin(),
+                      applied_inputs_->inputs.end(), std::back_inserter(added),
+                      by_callback);
+  for (const MixerInput& input : removed)
+    RemoveConverterInput(input);
+  for (const MixerInput& input : added)
+    AddConverterInput(input);
+
+  applied_inputs_ = std::move(snapshot);
+  return true;
+}
+
+void AudioRendererMixer::AddConverterInput(const MixerInput& input) {
+  int input_sample_rate = input.params.sample_rate();
   if (is_master_sample_rate(input_sample_rate)) {
-    master_converter_.AddInput(input);
+    master_converter_.AddInput(input.callback);
   } else {
     AudioConvertersMap::iterator converter =
         converters_.find(input_sample_rate);
@@ -99,39 +196,31 @@ void AudioRendererMixer::AddMixerInput(const AudioParameters& input_params,
                                      // capable of handling arbitrary buffer
                                      // size requests, disabling FIFO.
                                      new LoopbackAudioConverter(
-                                         input_params, output_params_, true))));
+                                         input.params, output_params_, true))));
       converter = result.first;
 
       // Add newly-created resampler as an input to the master mixer.
       master_converter_.AddInput(converter->second.get());
     }
-    converter->second->AddInput(input);
+    converter->second->AddInput(input.callback);
   }
-
-  input_count_tracker_->Increment();
 }
 
-void AudioRendererMixer::RemoveMixerInput(
-    const AudioParameters& input_params,
-    AudioConverter::InputCallback* input) {
-  base::AutoLock auto_lock(lock_);
-
-  int input_sample_rate = input_params.sample_rate();
+void AudioRendererMixer::RemoveConverterInput(const MixerInput& input) {
+  int input_sample_rate = input.params.sample_rate();
   if (is_master_sample_rate(input_sample_rate)) {
-    master_converter_.RemoveInput(input);
+    master_converter_.RemoveInput(input.callback);
   } else {
     AudioConvertersMap::iterator converter =
         converters_.find(input_sample_rate);
     DCHECK(converter != converters_.end());
-    converter->second->RemoveInput(input);
+    converter->second->RemoveInput(input.callback);
     if (converter->second->empty()) {
       // Remove converter when it's empty.
       master_converter_.RemoveInput(converter->second.get());
       converters_.erase(converter);
     }
   }
-
-  input_count_tracker_->Decrement();
 }
 
 void AudioRendererMixer::AddErrorCallback(const base::Closure& error_cb) {
@@ -168,22 +257,33 @@ int AudioRendererMixer::Render(base::TimeDelta delay,
                                int prior_frames_skipped,
                                AudioBus* audio_bus) {
   TRACE_EVENT0("audio", "AudioRendererMixer::Render");
-  base::AutoLock auto_lock(lock_);
+
+  // Pick up any changes to the mixer inputs.  Until the generation is known,
+  // RemoveMixerInput() has to assume the oldest one is in use.
+  render_generation_.store(kRenderStarting);
+  const bool inputs_changed = ApplyPendingInputs();
+  render_generation_.store(applied_inputs_->generation);
 
   // If there are no mixer inputs and we haven't seen one for a while, pause the
   // sink to avoid wasting resources when media elements are present but remain
-  // in the pause state.
+  // in the pause state.  Only try to take |lock_|, as the main thread may hold
+  // it; pausing is simply retried on the next Render() then.
   const base::TimeTicks now = base::TimeTicks::Now();
-  if (!master_converter_.empty()) {
+  if (inputs_changed || !master_converter_.empty()) {
     last_play_time_ = now;
-  } else if (now - last_play_time_ >= pause_delay_ && playing_) {
-    audio_sink_->Pause();
-    playing_ = false;
+  } else if (now - last_play_time_ >= pause_delay_ && lock_.Try()) {
+    if (playing_ && inputs_.empty()) {
+      audio_sink_->Pause();
+      playing_ = false;
+    }
+    lock_.Release();
   }
 
   uint32_t frames_delayed =
       AudioTimestampHelper::TimeToFrames(delay, output_params_.sample_rate());
   master_converter_.ConvertWithDelay(frames_delayed, audio_bus);
+
+  render_generation_.store(kRenderIdle);
   return audio_bus->frames();
 }
 
@@ -7,9 +7,11 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/macros.h"
 #include "base/synchronization/lock.h"
@@ -23,6 +25,11 @@ namespace media {
 // Mixes a set of AudioConverter::InputCallbacks into a single output stream
 // which is funneled into a single shared AudioRendererSink; saving a bundle
 // on renderer side resources.
+//
+// Render() never waits for the threads adding and removing inputs: they
+// publish an immutable snapshot of the input list, which Render() picks up
+// before mixing, and RemoveMixerInput() waits out any Render() call still
+// using an older snapshot.
 class MEDIA_EXPORT AudioRendererMixer
     : public AudioRendererSink::RenderCallback {
  public:
@@ -34,6 +41,8 @@ class MEDIA_EXPORT AudioRendererMixer
   ~AudioRendererMixer() override;
 
   // Add or remove a mixer input from mixing; called by AudioRendererMixerInput.
+  // Neither may be called on the rendering thread. RemoveMixerInput() blocks
+  // until Render() no longer uses |input|.
   void AddMixerInput(const AudioParameters& input_params,
                      AudioConverter::InputCallback* input);
   void RemoveMixerInput(const AudioParameters& input_params,
@@ -63,6 +72,18 @@ class MEDIA_EXPORT AudioRendererMixer
   using AudioConvertersMap =
       std::map<int, std::unique_ptr<LoopbackAudioConverter>>;
 
+  struct MixerInput {
+    AudioConverter::InputCallback* callback;
+    AudioParameters params;
+  };
+
+  // An immutable copy of the mixer input list, handed to the rendering thread.
+  struct InputSnapshot {
+    uint64_t generation;
+    // Sorted by |callback|.
+    std::vector<MixerInput> inputs;
+  };
+
   // AudioRendererSink::RenderCallback implementation.
   int Render(base::TimeDelta delay,
              base::TimeTicks delay_timestamp,
@@ -74,6 +95,20 @@ class MEDIA_EXPORT AudioRendererMixer
     return sample_rate == output_params_.sample_rate();
   }
 
+  // Hands a copy of |inputs_| to the rendering thread.  Returns the generation
+  // of the new snapshot.
+  uint64_t PublishInputsLocked();
+
+  // Waits until no Render() call uses a snapshot older than |generation|.
+  void WaitForRenderToCatchUp(uint64_t generation);
+
+  // Called on the rendering thread, or once rendering has stopped.  Adopts the
+  // most recently published snapshot and brings the converters in line with
+  // it.  Returns false if there was no new snapshot.
+  bool ApplyPendingInputs();
+  void AddConverterInput(const MixerInput& input);
+  void RemoveConverterInput(const MixerInput& input);
+
   // Output parameters for this mixer.
   const AudioParameters output_params_;
 
@@ -81,12 +116,34 @@ class MEDIA_EXPORT AudioRendererMixer
   const scoped_refptr<AudioRendererSink> audio_sink_;
 
   // ---------------[ All variables below protected by |lock_| ]---------------
+  // Render() only ever tries to acquire |lock_|.
   base::Lock lock_;
 
   // List of error callbacks used by this mixer.
   typedef std::list<base::Closure> ErrorCallbackList;
   ErrorCallbackList error_callbacks_;
 
+  // The current mixer inputs, sorted by callback.
+  std::vector<MixerInput> inputs_;
+  uint64_t last_generation_;
+
+  bool playing_;
+
+  // Tracks the maximum number of simultaneous mixer inputs and logs it into
+  // UMA histogram upon the destruction.
+  std::unique_ptr<UMAMaxValueTracker> input_count_tracker_;
+
+  // ------------------------[ Lock-free hand-over ]---------------------------
+  // The latest snapshot not yet picked up by Render(), if any.
+  std::atomic<InputSnapshot*> pending_inputs_;
+
+  // The generation of the snapshot the current Render() call uses, or one of
+  // the special values in the .cc file.
+  std::atomic<uint64_t> render_generation_;
+
+  // -------------[ All variables below used on the render thread ]------------
+  std::unique_ptr<InputSnapshot> applied_inputs_;
+
   // Each of these converters mixes inputs with a given sample rate and
   // resamples them to the output sample rate. Inputs not reqiuring resampling
   // go directly to |master_converter_|.
@@ -100,11 +157,6 @@ class MEDIA_EXPORT AudioRendererMixer
   // reasons we don't want to immediately pause the physical stream.
   base::TimeDelta pause_delay_;
   base::TimeTicks last_play_time_;
-  bool playing_;
-
-  // Tracks the maximum number of simultaneous mixer inputs and logs it into
-  // UMA histogram upon the destruction.
-  std::unique_ptr<UMAMaxValueTracker> input_count_tracker_;
 
   DISALLOW_COPY_AND_ASSIGN(AudioRendererMixer);
 };
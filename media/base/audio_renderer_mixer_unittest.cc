@@ -17,6 +17,7 @@
 #include "base/macros.h"
 #include "base/synchronization/waitable_event.h"
 #include "base/threading/platform_thread.h"
+#include "base/threading/thread.h"
 #include "media/base/audio_renderer_mixer_input.h"
 #include "media/base/audio_renderer_mixer_pool.h"
 #include "media/base/fake_audio_render_callback.h"
@@ -516,6 +517,67 @@ TEST_P(AudioRendererMixerBehavioralTest, MixerPausesStream) {
   mixer_inputs_[0]->Stop();
 }
 
+// Render callback which blocks in Render() until released.
+class BlockingRenderCallback : public AudioRendererSink::RenderCallback {
+ public:
+  BlockingRenderCallback()
+      : entered(base::WaitableEvent::ResetPolicy::MANUAL,
+                base::WaitableEvent::InitialState::NOT_SIGNALED),
+        released(base::WaitableEvent::ResetPolicy::MANUAL,
+                 base::WaitableEvent::InitialState::NOT_SIGNALED) {}
+
+  int Render(base::TimeDelta delay,
+             base::TimeTicks delay_timestamp,
+             int prior_frames_skipped,
+             AudioBus* dest) override {
+    entered.Signal();
+    released.Wait();
+    dest->Zero();
+    return dest->frames();
+  }
+
+  void OnRenderError() override {}
+
+  base::WaitableEvent entered;
+  base::WaitableEvent released;
+};
+
+static void RenderOnce(AudioRendererSink::RenderCallback* callback,
+                       AudioBus* audio_bus) {
+  callback->Render(base::TimeDelta(), base::TimeTicks::Now(), 0, audio_bus);
+}
+
+// Ensure adding an input doesn't wait for a Render() call in progress.  The
+// test will hang if the behavior is incorrect.
+TEST_P(AudioRendererMixerBehavioralTest, AddInputWhileRendering) {
+  BlockingRenderCallback blocking_callback;
+  scoped_refptr<AudioRendererMixerInput> blocking_input = CreateMixerInput();
+  blocking_input->Initialize(input_parameters_[0], &blocking_callback);
+  blocking_input->Start();
+  blocking_input->Play();
+
+  base::Thread render_thread("AudioRenderThread");
+  ASSERT_TRUE(render_thread.Start());
+  render_thread.task_runner()->PostTask(
+      FROM_HERE, base::BindOnce(&RenderOnce, mixer_callback_,
+                                base::Unretained(audio_bus_.get())));
+  blocking_callback.entered.Wait();
+
+  InitializeInputs(1);
+  mixer_inputs_[0]->Start();
+  mixer_inputs_[0]->Play();
+
+  blocking_callback.released.Signal();
+  render_thread.Stop();
+
+  // The new input is mixed from the next Render() on.
+  FillAudioData(1.0f);
+  EXPECT_TRUE(RenderAndValidateAudioData(1.0f));
+
+  mixer_inputs_[0]->Stop();
+  blocking_input->Stop();
+}
+
 INSTANTIATE_TEST_CASE_P(
     /* no prefix */,
     AudioRendererMixerTest,
@@ -6,6 +6,8 @@
 
 #include <stddef.h>
 
+#include <algorithm>
+
 #include "base/logging.h"
 #include "media/base/audio_bus.h"
 #include "media/base/audio_parameters.h"
@@ -14,6 +16,11 @@
 
 namespace media {
 
+// Number of frames mixed at a time.  Small enough for a block of every input
+// and output channel to stay in L1 cache while all output channels are mixed,
+// and a multiple of vector_math::kRequiredAlignment.
+static const int kMixBlockFrames = 256;
+
 ChannelMixer::ChannelMixer(ChannelLayout input_layout,
                            ChannelLayout output_layout) {
   Initialize(input_layout,
@@ -54,11 +61,9 @@ void ChannelMixer::TransformPartial(const AudioBus* input,
   CHECK_LE(frame_count, input->frames());
   CHECK_LE(frame_count, output->frames());
 
-  // Zero initialize |output| so we're accumulating from zero.
-  output->ZeroFrames(frame_count);
-
   // If we're just remapping we can simply copy the correct input to output.
   if (remapping_) {
+    output->ZeroFrames(frame_count);
     for (int output_ch = 0; output_ch < output->channels(); ++output_ch) {
       for (int input_ch = 0; input_ch < input->channels(); ++input_ch) {
         float scale = matrix_[output_ch][input_ch];
@@ -73,15 +78,30 @@ void ChannelMixer::TransformPartial(const AudioBus* input,
     return;
   }
 
-  for (int output_ch = 0; output_ch < output->channels(); ++output_ch) {
-    for (int input_ch = 0; input_ch < input->channels(); ++input_ch) {
-      float scale = matrix_[output_ch][input_ch];
-      // Scale should always be positive.  Don't bother scaling by zero.
-      DCHECK_GE(scale, 0);
-      if (scale > 0) {
-        vector_math::FMAC(input->channel(input_ch), scale, frame_count,
-                          output->channel(output_ch));
+  // Mix all channels block by block instead of making a pass over the whole
+  // buffer for every input and output channel pair.
+  for (int offset = 0; offset < frame_count; offset += kMixBlockFrames) {
+    const int block_frames = std::min(kMixBlockFrames, frame_count - offset);
+    for (int output_ch = 0; output_ch < output->channels(); ++output_ch) {
+      float* dest = output->channel(output_ch) + offset;
+      bool dest_written = false;
+      for (int input_ch = 0; input_ch < input->channels(); ++input_ch) {
+        float scale = matrix_[output_ch][input_ch];
+        // Scale should always be positive.  Don't bother scaling by zero.
+        DCHECK_GE(scale, 0);
+        if (scale > 0) {
+          // The first input initializes the block, the rest accumulate.
+          const float* src = input->channel(input_ch) + offset;
+          if (dest_written) {
+            vector_math::FMAC(src, scale, block_frames, dest);
+          } else {
+            vector_math::FMUL(src, scale, block_frames, dest);
+            dest_written = true;
+          }
+        }
       }
+      if (!dest_written)
+        std::fill(dest, dest + block_frames, 0.0f);
     }
   }
 }
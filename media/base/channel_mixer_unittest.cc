@@ -52,6 +52,38 @@ TEST(ChannelMixerTest, ConstructAllPossibleLayouts) {
   }
 }
 
+// Verify that mixing a long buffer gives the same result as mixing each frame
+// on its own, and that frames past |frame_count| are left alone.
+TEST(ChannelMixerTest, TransformPartialLongBuffer) {
+  const int kLongFrames = 1000;
+  const int kPartialFrames = 777;
+  ChannelMixer mixer(CHANNEL_LAYOUT_5_1, CHANNEL_LAYOUT_STEREO);
+  std::unique_ptr<AudioBus> input_bus = AudioBus::Create(6, kLongFrames);
+  for (int ch = 0; ch < input_bus->channels(); ++ch) {
+    for (int frame = 0; frame < kLongFrames; ++frame)
+      input_bus->channel(ch)[frame] = ((frame * (ch + 1)) % 101) / 100.0f;
+  }
+  std::unique_ptr<AudioBus> output_bus = AudioBus::Create(2, kLongFrames);
+  for (int ch = 0; ch < output_bus->channels(); ++ch) {
+    std::fill(output_bus->channel(ch), output_bus->channel(ch) + kLongFrames,
+              -1.0f);
+  }
+
+  mixer.TransformPartial(input_bus.get(), kPartialFrames, output_bus.get());
+
+  std::unique_ptr<AudioBus> input_frame = AudioBus::Create(6, 1);
+  std::unique_ptr<AudioBus> output_frame = AudioBus::Create(2, 1);
+  for (int frame = 0; frame < kLongFrames; ++frame) {
+    input_bus->CopyPartialFramesTo(frame, 1, 0, input_frame.get());
+    mixer.Transform(input_frame.get(), output_frame.get());
+    for (int ch = 0; ch < output_bus->channels(); ++ch) {
+      ASSERT_FLOAT_EQ(
+          frame < kPartialFrames ? output_frame->channel(ch)[0] : -1.0f,
+          output_bus->channel(ch)[frame]);
+    }
+  }
+}
+
 struct ChannelMixerTestData {
   ChannelMixerTestData(ChannelLayout input_layout, ChannelLayout output_layout,
                        const float* channel_values, int num_channel_values,
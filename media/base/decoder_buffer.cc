@@ -15,6 +15,12 @@ static uint8_t* AllocateFFmpegSafeBlock(size_t size) {
   return block;
 }
 
+DecoderBuffer::ExternalMemory::ExternalMemory(const uint8_t* data,
+                                             size_t size)
+    : data_(data), size_(size) {}
+
+DecoderBuffer::ExternalMemory::~ExternalMemory() = default;
+
 DecoderBuffer::DecoderBuffer(size_t size)
     : size_(size), side_data_size_(0), is_key_frame_(false) {
   Initialize();
@@ -51,6 +57,12 @@ DecoderBuffer::DecoderBuffer(std::unique_ptr<UnalignedSharedMemory> shm,
       shm_(std::move(shm)),
       is_key_frame_(false) {}
 
+DecoderBuffer::DecoderBuffer(std::unique_ptr<ExternalMemory> external_memory)
+    : size_(external_memory->size()),
+      side_data_size_(0),
+      external_memory_(std::move(external_memory)),
+      is_key_frame_(false) {}
+
 DecoderBuffer::~DecoderBuffer() = default;
 
 void DecoderBuffer::Initialize() {
@@ -90,6 +102,15 @@ scoped_refptr<DecoderBuffer> DecoderBuffer::FromSharedMemoryHandle(
   return base::WrapRefCounted(new DecoderBuffer(std::move(shm), size));
 }
 
+// static
+scoped_refptr<DecoderBuffer> DecoderBuffer::FromExternalMemory(
+    std::unique_ptr<ExternalMemory> memory) {
+  // If you hit this CHECK you likely have a bug in a demuxer. Go fix it.
+  CHECK(memory && memory->data());
+  DCHECK_EQ(reinterpret_cast<uintptr_t>(memory->data()) % kAlignmentSize, 0u);
+  return base::WrapRefCounted(new DecoderBuffer(std::move(memory)));
+}
+
 // static
 scoped_refptr<DecoderBuffer> DecoderBuffer::CreateEOSBuffer() {
   return base::WrapRefCounted(new DecoderBuffer(NULL, 0, NULL, 0));
@@ -47,6 +47,27 @@ class MEDIA_EXPORT DecoderBuffer
 #endif
   };
 
+  // Memory owned by something other than the DecoderBuffer, such as a
+  // refcounted packet buffer from a demuxing library, which can back a
+  // DecoderBuffer without being copied. Subclasses release the memory when
+  // destroyed. The memory must remain valid and unmodified for the lifetime of
+  // this object, be aligned to kAlignmentSize and be followed by at least
+  // kPaddingSize zeroed bytes.
+  class MEDIA_EXPORT ExternalMemory {
+   public:
+    ExternalMemory(const uint8_t* data, size_t size);
+    virtual ~ExternalMemory();
+
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+
+   private:
+    const uint8_t* const data_;
+    const size_t size_;
+
+    DISALLOW_COPY_AND_ASSIGN(ExternalMemory);
+  };
+
   // Allocates buffer with |size| >= 0.  Buffer will be padded and aligned
   // as necessary, and |is_key_frame_| will default to false.
   explicit DecoderBuffer(size_t size);
@@ -79,6 +100,12 @@ class MEDIA_EXPORT DecoderBuffer
       off_t offset,
       size_t size);
 
+  // Create a DecoderBuffer whose data() is the memory held by |memory|, which
+  // is released when the buffer is destroyed. The buffer's |is_key_frame_|
+  // will default to false. writable_data() must not be called on the result.
+  static scoped_refptr<DecoderBuffer> FromExternalMemory(
+      std::unique_ptr<ExternalMemory> memory);
+
   // Create a DecoderBuffer indicating we've reached end of stream.
   //
   // Calling any method other than end_of_stream() on the resulting buffer
@@ -111,6 +138,8 @@ class MEDIA_EXPORT DecoderBuffer
     DCHECK(!end_of_stream());
     if (shm_)
       return static_cast<uint8_t*>(shm_->memory());
+    if (external_memory_)
+      return external_memory_->data();
     return data_.get();
   }
 
@@ -118,6 +147,7 @@ class MEDIA_EXPORT DecoderBuffer
   uint8_t* writable_data() const {
     DCHECK(!end_of_stream());
     DCHECK(!shm_);
+    DCHECK(!external_memory_);
     return data_.get();
   }
 
@@ -163,7 +193,7 @@ class MEDIA_EXPORT DecoderBuffer
   }
 
   // If there's no data in this buffer, it represents end of stream.
-  bool end_of_stream() const { return !shm_ && !data_; }
+  bool end_of_stream() const { return !shm_ && !external_memory_ && !data_; }
 
   bool is_key_frame() const {
     DCHECK(!end_of_stream());
@@ -199,6 +229,8 @@ class MEDIA_EXPORT DecoderBuffer
 
   DecoderBuffer(std::unique_ptr<UnalignedSharedMemory> shm, size_t size);
 
+  explicit DecoderBuffer(std::unique_ptr<ExternalMemory> external_memory);
+
   virtual ~DecoderBuffer();
 
  private:
@@ -210,6 +242,7 @@ class MEDIA_EXPORT DecoderBuffer
   size_t side_data_size_;
   std::unique_ptr<uint8_t, base::AlignedFreeDeleter> side_data_;
   std::unique_ptr<UnalignedSharedMemory> shm_;
+  std::unique_ptr<ExternalMemory> external_memory_;
   std::unique_ptr<DecryptConfig> decrypt_config_;
   DiscardPadding discard_padding_;
   bool is_key_frame_;
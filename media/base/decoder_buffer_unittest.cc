@@ -111,6 +111,55 @@ TEST(DecoderBufferTest, FromSharedMemoryHandle_ZeroSize) {
   ASSERT_FALSE(buffer.get());
 }
 
+namespace {
+
+// Owns an aligned and padded block and records when it is released.
+class TestExternalMemory : public DecoderBuffer::ExternalMemory {
+ public:
+  TestExternalMemory(uint8_t* block, size_t size, bool* released)
+      : ExternalMemory(block, size), block_(block), released_(released) {}
+  ~TestExternalMemory() override { *released_ = true; }
+
+ private:
+  std::unique_ptr<uint8_t, base::AlignedFreeDeleter> block_;
+  bool* const released_;
+
+  DISALLOW_COPY_AND_ASSIGN(TestExternalMemory);
+};
+
+}  // namespace
+
+TEST(DecoderBufferTest, FromExternalMemory) {
+  const uint8_t kData[] = "hello";
+  const size_t kDataSize = arraysize(kData);
+
+  uint8_t* block = static_cast<uint8_t*>(
+      base::AlignedAlloc(kDataSize + DecoderBuffer::kPaddingSize,
+                         DecoderBuffer::kAlignmentSize));
+  memcpy(block, kData, kDataSize);
+  memset(block + kDataSize, 0, DecoderBuffer::kPaddingSize);
+
+  bool released = false;
+  scoped_refptr<DecoderBuffer> buffer(DecoderBuffer::FromExternalMemory(
+      std::make_unique<TestExternalMemory>(block, kDataSize, &released)));
+  ASSERT_TRUE(buffer.get());
+  EXPECT_EQ(block, buffer->data());
+  EXPECT_EQ(kDataSize, buffer->data_size());
+  EXPECT_FALSE(buffer->end_of_stream());
+  EXPECT_FALSE(buffer->is_key_frame());
+
+  // Side data is still owned by the buffer itself.
+  const uint8_t kSideData[] = "world";
+  buffer->CopySideDataFrom(kSideData, arraysize(kSideData));
+  EXPECT_EQ(0, memcmp(buffer->side_data(), kSideData, arraysize(kSideData)));
+
+  EXPECT_TRUE(buffer->MatchesForTesting(*DecoderBuffer::CopyFrom(
+      kData, kDataSize, kSideData, arraysize(kSideData))));
+  EXPECT_FALSE(released);
+  buffer = nullptr;
+  EXPECT_TRUE(released);
+}
+
 #if !defined(OS_ANDROID)
 TEST(DecoderBufferTest, PaddingAlignment) {
   const uint8_t kData[] = "hello";
@@ -271,10 +271,20 @@ const base::Feature kMojoVideoDecoder {
 const base::Feature kD3D11VideoDecoder{"D3D11VideoDecoder",
                                        base::FEATURE_DISABLED_BY_DEFAULT};
 
+// Let DecoderBuffers produced by FFmpegDemuxer share FFmpeg's refcounted packet
+// buffers instead of copying every packet.
+const base::Feature kFFmpegDemuxerZeroCopy{"FFmpegDemuxerZeroCopy",
+                                           base::FEATURE_ENABLED_BY_DEFAULT};
+
 // Manage and report MSE buffered ranges by PTS intervals, not DTS intervals.
 const base::Feature kMseBufferByPts{"MseBufferByPts",
                                     base::FEATURE_DISABLED_BY_DEFAULT};
 
+// Parse MSE appends without holding the ChunkDemuxer lock, taking it only to
+// process each batch of parsed coded frames.
+const base::Feature kMseUnlockedAppendParsing{
+    "MseUnlockedAppendParsing", base::FEATURE_DISABLED_BY_DEFAULT};
+
 // Enable new cpu load estimator. Intended for evaluation in local
 // testing and origin-trial.
 // TODO(nisse): Delete once we have switched over to always using the
@@ -286,6 +296,12 @@ const base::Feature kNewEncodeCpuLoadEstimator{
 const base::Feature kNewRemotePlaybackPipeline{
     "NewRemotePlaybackPipeline", base::FEATURE_DISABLED_BY_DEFAULT};
 
+// Let software video decoders decode into shared memory, which
+// GpuMemoryBufferVideoFramePool then hands to the GPU without copying it into
+// GpuMemoryBuffers first.
+const base::Feature kSharedMemoryVideoFrameBuffers{
+    "SharedMemoryVideoFrameBuffers", base::FEATURE_DISABLED_BY_DEFAULT};
+
 // CanPlayThrough issued according to standard.
 const base::Feature kSpecCompliantCanPlayThrough{
     "SpecCompliantCanPlayThrough", base::FEATURE_ENABLED_BY_DEFAULT};
@@ -307,6 +323,11 @@ const base::Feature kUnifiedAutoplay{"UnifiedAutoplay",
 const base::Feature kUseSurfaceLayerForVideo{"UseSurfaceLayerForVideo",
                                              base::FEATURE_DISABLED_BY_DEFAULT};
 
+// Let several VA-API hardware decodes be in flight at once, only outputting
+// pictures once the hardware has finished decoding them.
+const base::Feature kVaapiPipelinedDecode{"VaapiPipelinedDecode",
+                                          base::FEATURE_DISABLED_BY_DEFAULT};
+
 // Enable VA-API hardware encode acceleration for VP8.
 const base::Feature kVaapiVP8Encoder{"VaapiVP8Encoder",
                                      base::FEATURE_ENABLED_BY_DEFAULT};
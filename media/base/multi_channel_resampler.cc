@@ -23,12 +23,15 @@ MultiChannelResampler::MultiChannelResampler(int channels,
       output_frames_ready_(0) {
   // Allocate each channel's resampler.
   resamplers_.reserve(channels);
+  resampler_ptrs_.reserve(channels);
   for (int i = 0; i < channels; ++i) {
     resamplers_.push_back(std::make_unique<SincResampler>(
         io_sample_rate_ratio, request_size,
         base::Bind(&MultiChannelResampler::ProvideInput, base::Unretained(this),
                    i)));
+    resampler_ptrs_.push_back(resamplers_.back().get());
   }
+  channel_destinations_.resize(channels);
 
   // Setup the wrapped AudioBus for channel data.
   wrapped_resampler_audio_bus_->set_frames(request_size);
@@ -64,19 +67,18 @@ void MultiChannelResampler::Resample(int frames, AudioBus* audio_bus) {
     int chunk_size = resamplers_[0]->ChunkSize();
     int frames_this_time = std::min(frames - output_frames_ready_, chunk_size);
 
-    // Resample each channel.
+    // Resample all channels together.  Depending on the sample-rate scale
+    // factor, and the internal buffering used in a SincResampler kernel, this
+    // will only sometimes call ProvideInput().  When it does, it calls it for
+    // the first channel and then for the remaining channels, since they all
+    // buffer in the same way and are processing the same number of frames.
     for (size_t i = 0; i < resamplers_.size(); ++i) {
       DCHECK_EQ(chunk_size, resamplers_[i]->ChunkSize());
-
-      // Depending on the sample-rate scale factor, and the internal buffering
-      // used in a SincResampler kernel, this call to Resample() will only
-      // sometimes call ProvideInput().  However, if it calls ProvideInput() for
-      // the first channel, then it will call it for the remaining channels,
-      // since they all buffer in the same way and are processing the same
-      // number of frames.
-      resamplers_[i]->Resample(
-          frames_this_time, audio_bus->channel(i) + output_frames_ready_);
+      channel_destinations_[i] = audio_bus->channel(i) + output_frames_ready_;
     }
+    SincResampler::ResampleChannels(
+        resampler_ptrs_.data(), static_cast<int>(resampler_ptrs_.size()),
+        frames_this_time, channel_destinations_.data());
 
     output_frames_ready_ += frames_this_time;
   }
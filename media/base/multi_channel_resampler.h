@@ -70,6 +70,11 @@ class MEDIA_EXPORT MultiChannelResampler {
   // Each channel has its own high quality resampler.
   std::vector<std::unique_ptr<SincResampler>> resamplers_;
 
+  // Arguments for SincResampler::ResampleChannels(), kept around to avoid
+  // allocating during Resample().
+  std::vector<SincResampler*> resampler_ptrs_;
+  std::vector<float*> channel_destinations_;
+
   // Buffers for audio data going into SincResampler from ReadCB.
   std::unique_ptr<AudioBus> resampler_audio_bus_;
 
@@ -77,6 +77,7 @@
 
 #include <limits>
 
+#include "base/cpu.h"
 #include "base/logging.h"
 #include "base/numerics/math_constants.h"
 #include "build/build_config.h"
@@ -91,6 +92,10 @@
 #define CONVOLVE_FUNC Convolve_C
 #endif
 
+#if defined(SINC_RESAMPLER_HAS_AVX2)
+#include <immintrin.h>
+#endif
+
 namespace media {
 
 static double SincScaleFactor(double io_ratio) {
@@ -116,7 +121,8 @@ static int CalculateChunkSize(int block_size_, double io_ratio) {
 SincResampler::SincResampler(double io_sample_rate_ratio,
                              int request_frames,
                              const ReadCB& read_cb)
-    : io_sample_rate_ratio_(io_sample_rate_ratio),
+    : convolve_proc_(CONVOLVE_FUNC),
+      io_sample_rate_ratio_(io_sample_rate_ratio),
       read_cb_(read_cb),
       request_frames_(request_frames),
       input_buffer_size_(request_frames_ + kKernelSize),
@@ -132,6 +138,11 @@ SincResampler::SincResampler(double io_sample_rate_ratio,
       r1_(input_buffer_.get()),
       r2_(input_buffer_.get() + kKernelSize / 2) {
   CHECK_GT(request_frames_, 0);
+#if defined(SINC_RESAMPLER_HAS_AVX2)
+  base::CPU cpu;
+  if (cpu.has_avx2() && cpu.has_fma3())
+    convolve_proc_ = Convolve_AVX2;
+#endif
   Flush();
   CHECK_GT(block_size_, kKernelSize)
       << "block_size must be greater than kKernelSize!";
@@ -227,27 +238,53 @@ void SincResampler::SetRatio(double io_sample_rate_ratio) {
 }
 
 void SincResampler::Resample(int frames, float* destination) {
+  SincResampler* resampler = this;
+  ResampleChannels(&resampler, 1, frames, &destination);
+}
+
+// static
+void SincResampler::ResampleChannels(SincResampler* const* resamplers,
+                                     int channels,
+                                     int frames,
+                                     float* const* destinations) {
+  DCHECK_GT(channels, 0);
+
+  // All of |resamplers| are at the same position, so the first one tracks it
+  // and provides the kernels for everyone.
+  SincResampler* const lead = resamplers[0];
+  for (int ch = 1; ch < channels; ++ch) {
+    const SincResampler* const resampler = resamplers[ch];
+    DCHECK_EQ(lead->io_sample_rate_ratio_, resampler->io_sample_rate_ratio_);
+    DCHECK_EQ(lead->virtual_source_idx_, resampler->virtual_source_idx_);
+    DCHECK_EQ(lead->request_frames_, resampler->request_frames_);
+  }
+
   int remaining_frames = frames;
+  int output_frame = 0;
 
   // Step (1) -- Prime the input buffer at the start of the input stream.
-  if (!buffer_primed_ && remaining_frames) {
-    read_cb_.Run(request_frames_, r0_);
-    buffer_primed_ = true;
+  if (!lead->buffer_primed_ && remaining_frames) {
+    for (int ch = 0; ch < channels; ++ch) {
+      SincResampler* const resampler = resamplers[ch];
+      resampler->read_cb_.Run(resampler->request_frames_, resampler->r0_);
+      resampler->buffer_primed_ = true;
+    }
   }
 
   // Step (2) -- Resample!
+  double virtual_source_idx = lead->virtual_source_idx_;
   while (remaining_frames) {
-    while (virtual_source_idx_ < block_size_) {
-      // |virtual_source_idx_| lies in between two kernel offsets so figure out
+    while (virtual_source_idx < lead->block_size_) {
+      // |virtual_source_idx| lies in between two kernel offsets so figure out
       // what they are.
-      const int source_idx = static_cast<int>(virtual_source_idx_);
+      const int source_idx = static_cast<int>(virtual_source_idx);
       const double virtual_offset_idx =
-          (virtual_source_idx_ - source_idx) * kKernelOffsetCount;
+          (virtual_source_idx - source_idx) * kKernelOffsetCount;
       const int offset_idx = static_cast<int>(virtual_offset_idx);
 
       // We'll compute "convolutions" for the two kernels which straddle
-      // |virtual_source_idx_|.
-      const float* k1 = kernel_storage_.get() + offset_idx * kKernelSize;
+      // |virtual_source_idx|.
+      const float* k1 = lead->kernel_storage_.get() + offset_idx * kKernelSize;
       const float* k2 = k1 + kKernelSize;
 
       // Ensure |k1|, |k2| are 16-byte aligned for SIMD usage.  Should always be
@@ -255,36 +292,51 @@ void SincResampler::Resample(int frames, float* destination) {
       DCHECK_EQ(0u, reinterpret_cast<uintptr_t>(k1) & 0x0F);
       DCHECK_EQ(0u, reinterpret_cast<uintptr_t>(k2) & 0x0F);
 
-      // Initialize input pointer based on quantized |virtual_source_idx_|.
-      const float* input_ptr = r1_ + source_idx;
-
       // Figure out how much to weight each kernel's "convolution".
       const double kernel_interpolation_factor =
           virtual_offset_idx - offset_idx;
-      *destination++ =
-          CONVOLVE_FUNC(input_ptr, k1, k2, kernel_interpolation_factor);
+
+      // The kernels are shared by every channel and stay in cache between
+      // them.  Input pointers are based on quantized |virtual_source_idx|.
+      for (int ch = 0; ch < channels; ++ch) {
+        destinations[ch][output_frame] = lead->convolve_proc_(
+            resamplers[ch]->r1_ + source_idx, k1, k2,
+            kernel_interpolation_factor);
+      }
+      ++output_frame;
 
       // Advance the virtual index.
-      virtual_source_idx_ += io_sample_rate_ratio_;
+      virtual_source_idx += lead->io_sample_rate_ratio_;
       if (!--remaining_frames)
-        return;
+        break;
     }
+    if (!remaining_frames)
+      break;
 
     // Wrap back around to the start.
-    DCHECK_GE(virtual_source_idx_, block_size_);
-    virtual_source_idx_ -= block_size_;
+    DCHECK_GE(virtual_source_idx, lead->block_size_);
+    virtual_source_idx -= lead->block_size_;
 
-    // Step (3) -- Copy r3_, r4_ to r1_, r2_.
-    // This wraps the last input frames back to the start of the buffer.
-    memcpy(r1_, r3_, sizeof(*input_buffer_.get()) * kKernelSize);
+    for (int ch = 0; ch < channels; ++ch) {
+      SincResampler* const resampler = resamplers[ch];
+      resampler->virtual_source_idx_ = virtual_source_idx;
 
-    // Step (4) -- Reinitialize regions if necessary.
-    if (r0_ == r2_)
-      UpdateRegions(true);
+      // Step (3) -- Copy r3_, r4_ to r1_, r2_.
+      // This wraps the last input frames back to the start of the buffer.
+      memcpy(resampler->r1_, resampler->r3_,
+             sizeof(*resampler->input_buffer_.get()) * kKernelSize);
 
-    // Step (5) -- Refresh the buffer with more input.
-    read_cb_.Run(request_frames_, r0_);
+      // Step (4) -- Reinitialize regions if necessary.
+      if (resampler->r0_ == resampler->r2_)
+        resampler->UpdateRegions(true);
+
+      // Step (5) -- Refresh the buffer with more input.
+      resampler->read_cb_.Run(resampler->request_frames_, resampler->r0_);
+    }
   }
+
+  for (int ch = 0; ch < channels; ++ch)
+    resamplers[ch]->virtual_source_idx_ = virtual_source_idx;
 }
 
 void SincResampler::PrimeWithSilence() {
@@ -365,6 +417,39 @@ float SincResampler::Convolve_SSE(const float* input_ptr, const float* k1,
 
   return result;
 }
+
+#if defined(SINC_RESAMPLER_HAS_AVX2)
+__attribute__((target("avx2,fma"))) float SincResampler::Convolve_AVX2(
+    const float* input_ptr,
+    const float* k1,
+    const float* k2,
+    double kernel_interpolation_factor) {
+  __m256 m_input;
+  __m256 m_sums1 = _mm256_setzero_ps();
+  __m256 m_sums2 = _mm256_setzero_ps();
+
+  // The kernels are only 16-byte aligned, so unaligned loads are used for
+  // everything; they cost nothing extra when the data is aligned anyway.
+  for (int i = 0; i < kKernelSize; i += 8) {
+    m_input = _mm256_loadu_ps(input_ptr + i);
+    m_sums1 = _mm256_fmadd_ps(m_input, _mm256_loadu_ps(k1 + i), m_sums1);
+    m_sums2 = _mm256_fmadd_ps(m_input, _mm256_loadu_ps(k2 + i), m_sums2);
+  }
+
+  // Linearly interpolate the two "convolutions".
+  m_sums1 = _mm256_mul_ps(m_sums1, _mm256_set1_ps(
+      static_cast<float>(1.0 - kernel_interpolation_factor)));
+  m_sums1 = _mm256_fmadd_ps(m_sums2, _mm256_set1_ps(
+      static_cast<float>(kernel_interpolation_factor)), m_sums1);
+
+  // Sum components together.
+  __m128 m_sum = _mm_add_ps(_mm256_castps256_ps128(m_sums1),
+                            _mm256_extractf128_ps(m_sums1, 1));
+  m_sum = _mm_add_ps(_mm_movehl_ps(m_sum, m_sum), m_sum);
+  m_sum = _mm_add_ss(m_sum, _mm_shuffle_ps(m_sum, m_sum, 1));
+  return _mm_cvtss_f32(m_sum);
+}
+#endif
 #elif defined(ARCH_CPU_ARM_FAMILY) && defined(USE_NEON)
 float SincResampler::Convolve_NEON(const float* input_ptr, const float* k1,
                                    const float* k2,
@@ -373,6 +458,30 @@ float SincResampler::Convolve_NEON(const float* input_ptr, const float* k1,
   float32x4_t m_sums1 = vmovq_n_f32(0);
   float32x4_t m_sums2 = vmovq_n_f32(0);
 
+#if defined(ARCH_CPU_ARM64)
+  // ARMv8 has enough registers to work on two vectors per iteration, with a
+  // second pair of accumulators to break up the fused multiply-add chains.
+  float32x4_t m_sums3 = vmovq_n_f32(0);
+  float32x4_t m_sums4 = vmovq_n_f32(0);
+  for (int i = 0; i < kKernelSize; i += 8) {
+    m_input = vld1q_f32(input_ptr + i);
+    m_sums1 = vfmaq_f32(m_sums1, m_input, vld1q_f32(k1 + i));
+    m_sums2 = vfmaq_f32(m_sums2, m_input, vld1q_f32(k2 + i));
+    m_input = vld1q_f32(input_ptr + i + 4);
+    m_sums3 = vfmaq_f32(m_sums3, m_input, vld1q_f32(k1 + i + 4));
+    m_sums4 = vfmaq_f32(m_sums4, m_input, vld1q_f32(k2 + i + 4));
+  }
+  m_sums1 = vaddq_f32(m_sums1, m_sums3);
+  m_sums2 = vaddq_f32(m_sums2, m_sums4);
+
+  // Linearly interpolate the two "convolutions".
+  m_sums1 = vfmaq_f32(
+      vmulq_f32(m_sums1, vmovq_n_f32(1.0 - kernel_interpolation_factor)),
+      m_sums2, vmovq_n_f32(kernel_interpolation_factor));
+
+  // Sum components together.
+  return vaddvq_f32(m_sums1);
+#else
   const float* upper = input_ptr + kKernelSize;
   for (; input_ptr < upper; ) {
     m_input = vld1q_f32(input_ptr);
@@ -391,6 +500,7 @@ float SincResampler::Convolve_NEON(const float* input_ptr, const float* k1,
   // Sum components together.
   float32x2_t m_half = vadd_f32(vget_high_f32(m_sums1), vget_low_f32(m_sums1));
   return vget_lane_f32(vpadd_f32(m_half, m_half), 0);
+#endif
 }
 #endif
 
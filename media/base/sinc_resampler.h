@@ -14,6 +14,13 @@
 #include "build/build_config.h"
 #include "media/base/media_export.h"
 
+// Convolve_AVX2() is compiled with a per-function target attribute, so it is
+// available on x86 whenever the compiler supports those.
+#if defined(ARCH_CPU_X86_FAMILY) && !defined(OS_NACL) && \
+    (defined(COMPILER_GCC) || defined(__clang__))
+#define SINC_RESAMPLER_HAS_AVX2
+#endif
+
 namespace media {
 
 // SincResampler is a high-quality single-channel sample-rate converter.
@@ -55,6 +62,17 @@ class MEDIA_EXPORT SincResampler {
   // Resample |frames| of data from |read_cb_| into |destination|.
   void Resample(int frames, float* destination);
 
+  // Resamples |frames| of data for |channels| channels in lockstep: channel i
+  // is read through |resamplers|[i] and written to |destinations|[i].  All
+  // resamplers must have been created and used identically so far, so that
+  // they are at the same position.  The kernel position is only computed once
+  // per output frame, and the first resampler's kernels serve every channel,
+  // so they stay in cache from one channel's convolution to the next.
+  static void ResampleChannels(SincResampler* const* resamplers,
+                               int channels,
+                               int frames,
+                               float* const* destinations);
+
   // The maximum size in frames that guarantees Resample() will only make a
   // single call to |read_cb_| for more data.  Note: If PrimeWithSilence() is
   // not called, chunk size will grow after the first two Resample() calls by
@@ -88,26 +106,42 @@ class MEDIA_EXPORT SincResampler {
   FRIEND_TEST_ALL_PREFIXES(SincResamplerPerfTest, Convolve_unoptimized_aligned);
   FRIEND_TEST_ALL_PREFIXES(SincResamplerPerfTest, Convolve_optimized_aligned);
   FRIEND_TEST_ALL_PREFIXES(SincResamplerPerfTest, Convolve_optimized_unaligned);
+  FRIEND_TEST_ALL_PREFIXES(SincResamplerPerfTest, Convolve_avx2_aligned);
+  FRIEND_TEST_ALL_PREFIXES(SincResamplerPerfTest, Convolve_avx2_unaligned);
+
+  using ConvolveProc = float (*)(const float* input_ptr,
+                                 const float* k1,
+                                 const float* k2,
+                                 double kernel_interpolation_factor);
 
   void InitializeKernel();
   void UpdateRegions(bool second_load);
 
   // Compute convolution of |k1| and |k2| over |input_ptr|, resultant sums are
   // linearly interpolated using |kernel_interpolation_factor|.  On x86, the
-  // underlying implementation is chosen at run time based on SSE support.  On
-  // ARM, NEON support is chosen at compile time based on compilation flags.
+  // underlying implementation is chosen at run time based on AVX2 and FMA3
+  // support, falling back to SSE.  On ARM, NEON support is chosen at compile
+  // time based on compilation flags.
   static float Convolve_C(const float* input_ptr, const float* k1,
                           const float* k2, double kernel_interpolation_factor);
 #if defined(ARCH_CPU_X86_FAMILY)
   static float Convolve_SSE(const float* input_ptr, const float* k1,
                             const float* k2,
                             double kernel_interpolation_factor);
+#if defined(SINC_RESAMPLER_HAS_AVX2)
+  static float Convolve_AVX2(const float* input_ptr, const float* k1,
+                             const float* k2,
+                             double kernel_interpolation_factor);
+#endif
 #elif defined(ARCH_CPU_ARM_FAMILY) && defined(USE_NEON)
   static float Convolve_NEON(const float* input_ptr, const float* k1,
                              const float* k2,
                              double kernel_interpolation_factor);
 #endif
 
+  // The Convolve_*() implementation used by Resample().
+  ConvolveProc convolve_proc_;
+
   // The ratio of input / output sample rates.
   double io_sample_rate_ratio_;
 
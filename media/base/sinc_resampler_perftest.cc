@@ -4,6 +4,7 @@
 
 #include "base/bind.h"
 #include "base/bind_helpers.h"
+#include "base/cpu.h"
 #include "base/time/time.h"
 #include "build/build_config.h"
 #include "media/base/sinc_resampler.h"
@@ -65,6 +66,22 @@ TEST(SincResamplerPerfTest, Convolve_optimized_unaligned) {
 }
 #endif
 
+#if defined(SINC_RESAMPLER_HAS_AVX2)
+TEST(SincResamplerPerfTest, Convolve_avx2_aligned) {
+  base::CPU cpu;
+  if (!cpu.has_avx2() || !cpu.has_fma3())
+    return;
+  RunConvolveBenchmark(SincResampler::Convolve_AVX2, true, "avx2_aligned");
+}
+
+TEST(SincResamplerPerfTest, Convolve_avx2_unaligned) {
+  base::CPU cpu;
+  if (!cpu.has_avx2() || !cpu.has_fma3())
+    return;
+  RunConvolveBenchmark(SincResampler::Convolve_AVX2, false, "avx2_unaligned");
+}
+#endif
+
 #undef CONVOLVE_FUNC
 
 } // namespace media
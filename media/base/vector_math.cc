@@ -7,6 +7,7 @@
 
 #include <algorithm>
 
+#include "base/cpu.h"
 #include "base/logging.h"
 #include "build/build_config.h"
 
@@ -36,6 +37,11 @@
 #define EWMAAndMaxPower_FUNC EWMAAndMaxPower_C
 #endif
 
+#if defined(VECTOR_MATH_HAS_AVX2)
+#include <immintrin.h>
+#define AVX2_TARGET __attribute__((target("avx2,fma")))
+#endif
+
 namespace media {
 namespace vector_math {
 
@@ -43,6 +49,10 @@ void FMAC(const float src[], float scale, int len, float dest[]) {
   // Ensure |src| and |dest| are 16-byte aligned.
   DCHECK_EQ(0u, reinterpret_cast<uintptr_t>(src) & (kRequiredAlignment - 1));
   DCHECK_EQ(0u, reinterpret_cast<uintptr_t>(dest) & (kRequiredAlignment - 1));
+#if defined(VECTOR_MATH_HAS_AVX2)
+  if (CanUseAVX2())
+    return FMAC_AVX2(src, scale, len, dest);
+#endif
   return FMAC_FUNC(src, scale, len, dest);
 }
 
@@ -55,6 +65,10 @@ void FMUL(const float src[], float scale, int len, float dest[]) {
   // Ensure |src| and |dest| are 16-byte aligned.
   DCHECK_EQ(0u, reinterpret_cast<uintptr_t>(src) & (kRequiredAlignment - 1));
   DCHECK_EQ(0u, reinterpret_cast<uintptr_t>(dest) & (kRequiredAlignment - 1));
+#if defined(VECTOR_MATH_HAS_AVX2)
+  if (CanUseAVX2())
+    return FMUL_AVX2(src, scale, len, dest);
+#endif
   return FMUL_FUNC(src, scale, len, dest);
 }
 
@@ -74,6 +88,10 @@ std::pair<float, float> EWMAAndMaxPower(
     float initial_value, const float src[], int len, float smoothing_factor) {
   // Ensure |src| is 16-byte aligned.
   DCHECK_EQ(0u, reinterpret_cast<uintptr_t>(src) & (kRequiredAlignment - 1));
+#if defined(VECTOR_MATH_HAS_AVX2)
+  if (CanUseAVX2())
+    return EWMAAndMaxPower_AVX2(initial_value, src, len, smoothing_factor);
+#endif
   return EWMAAndMaxPower_FUNC(initial_value, src, len, smoothing_factor);
 }
 
@@ -196,14 +214,146 @@ std::pair<float, float> EWMAAndMaxPower_SSE(
 }
 #endif
 
+#if defined(VECTOR_MATH_HAS_AVX2)
+bool CanUseAVX2() {
+  static const bool can_use_avx2 = [] {
+    base::CPU cpu;
+    return cpu.has_avx2() && cpu.has_fma3();
+  }();
+  return can_use_avx2;
+}
+
+// Callers only guarantee kRequiredAlignment, which is less than the 32 bytes
+// of an AVX register, so all loads and stores below are unaligned ones.
+AVX2_TARGET void FMAC_AVX2(const float src[],
+                           float scale,
+                           int len,
+                           float dest[]) {
+  const int rem = len % 8;
+  const int last_index = len - rem;
+  const __m256 m_scale = _mm256_set1_ps(scale);
+  for (int i = 0; i < last_index; i += 8) {
+    _mm256_storeu_ps(dest + i, _mm256_fmadd_ps(_mm256_loadu_ps(src + i),
+                                               m_scale,
+                                               _mm256_loadu_ps(dest + i)));
+  }
+
+  // Handle any remaining values that wouldn't fit in an AVX pass.
+  for (int i = last_index; i < len; ++i)
+    dest[i] += src[i] * scale;
+}
+
+AVX2_TARGET void FMUL_AVX2(const float src[],
+                           float scale,
+                           int len,
+                           float dest[]) {
+  const int rem = len % 8;
+  const int last_index = len - rem;
+  const __m256 m_scale = _mm256_set1_ps(scale);
+  for (int i = 0; i < last_index; i += 8) {
+    _mm256_storeu_ps(dest + i,
+                     _mm256_mul_ps(_mm256_loadu_ps(src + i), m_scale));
+  }
+
+  // Handle any remaining values that wouldn't fit in an AVX pass.
+  for (int i = last_index; i < len; ++i)
+    dest[i] = src[i] * scale;
+}
+
+AVX2_TARGET std::pair<float, float> EWMAAndMaxPower_AVX2(
+    float initial_value,
+    const float src[],
+    int len,
+    float smoothing_factor) {
+  // This is EWMAAndMaxPower_SSE() with 8 lanes instead of 4: lane 7 computes
+  // z[n], lane 6 z[n-1], and so on down to z[n-7] in lane 0, where
+  //
+  // z[n] = a(S[n]^2) + (1-a)^8(z[n-8]) + (1-a)^16(z[n-16]) + ...
+  //
+  // and the lanes are combined into
+  //
+  // y[n] = z[n] + (1-a)^1(z[n-1]) + ... + (1-a)^7(z[n-7]).
+
+  const int rem = len % 8;
+  const int last_index = len - rem;
+
+  const float weight_prev = 1.0f - smoothing_factor;
+  float lane_weights[8];
+  lane_weights[7] = 1.0f;
+  for (int lane = 6; lane >= 0; --lane)
+    lane_weights[lane] = lane_weights[lane + 1] * weight_prev;
+  const __m256 smoothing_factor_x8 = _mm256_set1_ps(smoothing_factor);
+  const __m256 weight_prev_8th_x8 =
+      _mm256_set1_ps(lane_weights[0] * weight_prev);
+
+  __m256 max_x8 = _mm256_setzero_ps();
+  __m256 ewma_x8 = _mm256_setr_ps(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+                                  initial_value);
+  int i;
+  for (i = 0; i < last_index; i += 8) {
+    const __m256 sample_x8 = _mm256_loadu_ps(src + i);
+    const __m256 sample_squared_x8 = _mm256_mul_ps(sample_x8, sample_x8);
+    max_x8 = _mm256_max_ps(max_x8, sample_squared_x8);
+    ewma_x8 = _mm256_fmadd_ps(sample_squared_x8, smoothing_factor_x8,
+                              _mm256_mul_ps(ewma_x8, weight_prev_8th_x8));
+  }
+
+  // Weight each lane by its distance from z[n] and sum them up.
+  ewma_x8 = _mm256_mul_ps(ewma_x8, _mm256_loadu_ps(lane_weights));
+  __m128 ewma_x4 = _mm_add_ps(_mm256_castps256_ps128(ewma_x8),
+                              _mm256_extractf128_ps(ewma_x8, 1));
+  ewma_x4 = _mm_add_ps(ewma_x4, _mm_movehl_ps(ewma_x4, ewma_x4));
+  ewma_x4 = _mm_add_ss(ewma_x4, _mm_shuffle_ps(ewma_x4, ewma_x4, 1));
+
+  // Fold the maximums together to get the overall maximum.
+  __m128 max_x4 = _mm_max_ps(_mm256_castps256_ps128(max_x8),
+                             _mm256_extractf128_ps(max_x8, 1));
+  max_x4 = _mm_max_ps(max_x4, _mm_movehl_ps(max_x4, max_x4));
+  max_x4 = _mm_max_ss(max_x4, _mm_shuffle_ps(max_x4, max_x4, 1));
+
+  std::pair<float, float> result(_mm_cvtss_f32(ewma_x4),
+                                 _mm_cvtss_f32(max_x4));
+
+  // Handle remaining values at the end of |src|.
+  for (; i < len; ++i) {
+    result.first *= weight_prev;
+    const float sample = src[i];
+    const float sample_squared = sample * sample;
+    result.first += sample_squared * smoothing_factor;
+    result.second = std::max(result.second, sample_squared);
+  }
+
+  return result;
+}
+#endif
+
 #if defined(ARCH_CPU_ARM_FAMILY) && defined(USE_NEON)
+// ARMv8 has twice as many NEON registers as ARMv7 and a fused multiply-add, so
+// the element-wise kernels process two vectors per iteration there.
+#if defined(ARCH_CPU_ARM64)
+constexpr int kNeonStep = 8;
+#else
+constexpr int kNeonStep = 4;
+#endif
+
+// Returns |a| + |b| * |c|.
+inline float32x4_t MultiplyAdd(float32x4_t a, float32x4_t b, float32x4_t c) {
+#if defined(ARCH_CPU_ARM64)
+  return vfmaq_f32(a, b, c);
+#else
+  return vmlaq_f32(a, b, c);
+#endif
+}
+
 void FMAC_NEON(const float src[], float scale, int len, float dest[]) {
-  const int rem = len % 4;
+  const int rem = len % kNeonStep;
   const int last_index = len - rem;
   float32x4_t m_scale = vmovq_n_f32(scale);
-  for (int i = 0; i < last_index; i += 4) {
-    vst1q_f32(dest + i, vmlaq_f32(
-        vld1q_f32(dest + i), vld1q_f32(src + i), m_scale));
+  for (int i = 0; i < last_index; i += kNeonStep) {
+    for (int j = i; j < i + kNeonStep; j += 4) {
+      vst1q_f32(dest + j, MultiplyAdd(
+          vld1q_f32(dest + j), vld1q_f32(src + j), m_scale));
+    }
   }
 
   // Handle any remaining values that wouldn't fit in an NEON pass.
@@ -212,11 +362,13 @@ void FMAC_NEON(const float src[], float scale, int len, float dest[]) {
 }
 
 void FMUL_NEON(const float src[], float scale, int len, float dest[]) {
-  const int rem = len % 4;
+  const int rem = len % kNeonStep;
   const int last_index = len - rem;
   float32x4_t m_scale = vmovq_n_f32(scale);
-  for (int i = 0; i < last_index; i += 4)
-    vst1q_f32(dest + i, vmulq_f32(vld1q_f32(src + i), m_scale));
+  for (int i = 0; i < last_index; i += kNeonStep) {
+    for (int j = i; j < i + kNeonStep; j += 4)
+      vst1q_f32(dest + j, vmulq_f32(vld1q_f32(src + j), m_scale));
+  }
 
   // Handle any remaining values that wouldn't fit in an NEON pass.
   for (int i = last_index; i < len; ++i)
@@ -258,7 +410,7 @@ std::pair<float, float> EWMAAndMaxPower_NEON(
     const float32x4_t sample_x4 = vld1q_f32(src + i);
     const float32x4_t sample_squared_x4 = vmulq_f32(sample_x4, sample_x4);
     max_x4 = vmaxq_f32(max_x4, sample_squared_x4);
-    ewma_x4 = vmlaq_f32(ewma_x4, sample_squared_x4, smoothing_factor_x4);
+    ewma_x4 = MultiplyAdd(ewma_x4, sample_squared_x4, smoothing_factor_x4);
   }
 
   // y[n] = z[n] + (1-a)^1(z[n-1]) + (1-a)^2(z[n-2]) + (1-a)^3(z[n-3])
@@ -271,10 +423,14 @@ std::pair<float, float> EWMAAndMaxPower_NEON(
   ewma += vgetq_lane_f32(ewma_x4, 0);
 
   // Fold the maximums together to get the overall maximum.
+#if defined(ARCH_CPU_ARM64)
+  std::pair<float, float> result(ewma, vmaxvq_f32(max_x4));
+#else
   float32x2_t max_x2 = vpmax_f32(vget_low_f32(max_x4), vget_high_f32(max_x4));
   max_x2 = vpmax_f32(max_x2, max_x2);
 
   std::pair<float, float> result(ewma, vget_lane_f32(max_x2, 0));
+#endif
 
   // Handle remaining values at the end of |src|.
   for (; i < len; ++i) {
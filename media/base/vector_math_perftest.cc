@@ -174,4 +174,54 @@ TEST_F(VectorMathPerfTest, EWMAAndMaxPower_optimized_aligned) {
 }
 #endif
 
+#if defined(VECTOR_MATH_HAS_AVX2)
+// Benchmarks for the AVX2 methods, which are chosen at run time on CPUs that
+// support them.
+TEST_F(VectorMathPerfTest, FMAC_avx2_unaligned) {
+  if (!vector_math::CanUseAVX2())
+    return;
+  RunBenchmark(
+      vector_math::FMAC_AVX2, false, "vector_math_fmac", "avx2_unaligned");
+}
+
+TEST_F(VectorMathPerfTest, FMAC_avx2_aligned) {
+  if (!vector_math::CanUseAVX2())
+    return;
+  RunBenchmark(
+      vector_math::FMAC_AVX2, true, "vector_math_fmac", "avx2_aligned");
+}
+
+TEST_F(VectorMathPerfTest, FMUL_avx2_unaligned) {
+  if (!vector_math::CanUseAVX2())
+    return;
+  RunBenchmark(
+      vector_math::FMUL_AVX2, false, "vector_math_fmul", "avx2_unaligned");
+}
+
+TEST_F(VectorMathPerfTest, FMUL_avx2_aligned) {
+  if (!vector_math::CanUseAVX2())
+    return;
+  RunBenchmark(
+      vector_math::FMUL_AVX2, true, "vector_math_fmul", "avx2_aligned");
+}
+
+TEST_F(VectorMathPerfTest, EWMAAndMaxPower_avx2_unaligned) {
+  if (!vector_math::CanUseAVX2())
+    return;
+  RunBenchmark(vector_math::EWMAAndMaxPower_AVX2,
+               kVectorSize - 1,
+               "vector_math_ewma_and_max_power",
+               "avx2_unaligned");
+}
+
+TEST_F(VectorMathPerfTest, EWMAAndMaxPower_avx2_aligned) {
+  if (!vector_math::CanUseAVX2())
+    return;
+  RunBenchmark(vector_math::EWMAAndMaxPower_AVX2,
+               kVectorSize,
+               "vector_math_ewma_and_max_power",
+               "avx2_aligned");
+}
+#endif
+
 } // namespace media
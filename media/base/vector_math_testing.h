@@ -10,6 +10,14 @@
 #include "build/build_config.h"
 #include "media/base/media_shmem_export.h"
 
+// The AVX2 versions are compiled with per-function target attributes, so that
+// the rest of the binary can still run on CPUs without AVX2. They are only
+// used when base::CPU reports both AVX2 and FMA3 support.
+#if defined(ARCH_CPU_X86_FAMILY) && !defined(OS_NACL) && \
+    (defined(COMPILER_GCC) || defined(__clang__))
+#define VECTOR_MATH_HAS_AVX2
+#endif
+
 namespace media {
 namespace vector_math {
 
@@ -44,6 +52,25 @@ MEDIA_SHMEM_EXPORT std::pair<float, float> EWMAAndMaxPower_SSE(
     float smoothing_factor);
 #endif
 
+#if defined(VECTOR_MATH_HAS_AVX2)
+// Returns true if the CPU supports the *_AVX2() versions below.
+MEDIA_SHMEM_EXPORT bool CanUseAVX2();
+
+MEDIA_SHMEM_EXPORT void FMAC_AVX2(const float src[],
+                                  float scale,
+                                  int len,
+                                  float dest[]);
+MEDIA_SHMEM_EXPORT void FMUL_AVX2(const float src[],
+                                  float scale,
+                                  int len,
+                                  float dest[]);
+MEDIA_SHMEM_EXPORT std::pair<float, float> EWMAAndMaxPower_AVX2(
+    float initial_value,
+    const float src[],
+    int len,
+    float smoothing_factor);
+#endif
+
 #if defined(ARCH_CPU_ARM_FAMILY) && defined(USE_NEON)
 MEDIA_SHMEM_EXPORT void FMAC_NEON(const float src[],
                                   float scale,
@@ -28,6 +28,8 @@ int VideoDecoder::GetMaxDecodeRequests() const {
   return 1;
 }
 
+void VideoDecoder::OnFramesDropped(int count) {}
+
 }  // namespace media
 
 namespace std {
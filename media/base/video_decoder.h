@@ -119,6 +119,11 @@ class MEDIA_EXPORT VideoDecoder {
   // Returns maximum number of parallel decode requests.
   virtual int GetMaxDecodeRequests() const;
 
+  // Called when the renderer has dropped |count| frames output by the decoder
+  // because they weren't ready in time to be displayed. Software decoders may
+  // use this to decode with more threads. Does nothing by default.
+  virtual void OnFramesDropped(int count);
+
  protected:
   // Deletion is only allowed via Destroy().
   virtual ~VideoDecoder();
@@ -504,6 +504,8 @@ scoped_refptr<VideoFrame> VideoFrame::WrapVideoFrame(
       DCHECK(frame->shared_memory_handle_.IsValid());
       wrapping_frame->AddSharedMemoryHandle(frame->shared_memory_handle_);
     }
+    // The wrapping frame shares the data pointers of |frame|.
+    wrapping_frame->shared_memory_offset_ = frame->shared_memory_offset_;
   }
 
   return wrapping_frame;
@@ -838,7 +840,6 @@ base::UnsafeSharedMemoryRegion* VideoFrame::unsafe_shared_memory_region()
 
 base::SharedMemoryHandle VideoFrame::shared_memory_handle() const {
   DCHECK_EQ(storage_type_, STORAGE_SHMEM);
-  DCHECK(shared_memory_handle_.IsValid());
   return shared_memory_handle_;
 }
 
@@ -903,10 +904,12 @@ void VideoFrame::AddUnsafeSharedMemoryRegion(
   unsafe_shared_memory_region_ = region;
 }
 
-void VideoFrame::AddSharedMemoryHandle(base::SharedMemoryHandle handle) {
+void VideoFrame::AddSharedMemoryHandle(base::SharedMemoryHandle handle,
+                                       size_t offset) {
   storage_type_ = STORAGE_SHMEM;
   DCHECK(SharedMemoryUninitialized());
   shared_memory_handle_ = handle;
+  shared_memory_offset_ = offset;
 }
 
 #if defined(OS_MACOSX)
@@ -1195,8 +1198,7 @@ VideoFrame::VideoFrame(VideoPixelFormat format,
                  natural_size,
                  timestamp) {
   DCHECK_EQ(storage_type, STORAGE_SHMEM);
-  AddSharedMemoryHandle(handle);
-  shared_memory_offset_ = shared_memory_offset;
+  AddSharedMemoryHandle(handle, shared_memory_offset);
 }
 
 VideoFrame::VideoFrame(VideoPixelFormat format,
@@ -381,7 +381,8 @@ class MEDIA_EXPORT VideoFrame : public base::RefCountedThreadSafe<VideoFrame> {
   // Returns a pointer to the unsafe shared memory handle, if present.
   base::UnsafeSharedMemoryRegion* unsafe_shared_memory_region() const;
 
-  // Retuns the legacy SharedMemoryHandle, if present.
+  // Retuns the legacy SharedMemoryHandle, if present, or an invalid handle if
+  // the frame is backed by a shared memory region instead.
   base::SharedMemoryHandle shared_memory_handle() const;
 
   // Returns the offset into the shared memory where the frame data begins.
@@ -401,7 +402,10 @@ class MEDIA_EXPORT VideoFrame : public base::RefCountedThreadSafe<VideoFrame> {
   void AddUnsafeSharedMemoryRegion(base::UnsafeSharedMemoryRegion* region);
 
   // Legacy, use one of the Add*SharedMemoryRegion methods above instead.
-  void AddSharedMemoryHandle(base::SharedMemoryHandle handle);
+  // |offset| is the offset of the frame data within the shared memory, see
+  // shared_memory_offset().
+  void AddSharedMemoryHandle(base::SharedMemoryHandle handle,
+                             size_t offset = 0);
 
 #if defined(OS_MACOSX)
   // Returns the backing CVPixelBuffer, if present.
@@ -43,6 +43,13 @@ class MEDIA_EXPORT VideoFrameMetadata {
     // contexts.
     COPY_REQUIRED,
 
+    // The times at which the decoder was asked to decode this frame and at
+    // which it output the frame, as seen by the DecoderStream.  Consumers can
+    // use these to measure decode latency.  Use Get/SetTimeTicks() for these
+    // keys.
+    DECODE_BEGIN_TIME,
+    DECODE_END_TIME,
+
     // Indicates if the current frame is the End of its current Stream. Use
     // Get/SetBoolean() for this Key.
     END_OF_STREAM,
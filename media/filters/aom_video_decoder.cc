@@ -6,14 +6,10 @@
 
 #include "base/bind.h"
 #include "base/callback.h"
-#include "base/command_line.h"
 #include "base/logging.h"
-#include "base/strings/string_number_conversions.h"
-#include "base/sys_info.h"
 #include "media/base/bind_to_current_loop.h"
 #include "media/base/decoder_buffer.h"
 #include "media/base/media_log.h"
-#include "media/base/media_switches.h"
 #include "media/base/video_util.h"
 #include "third_party/libyuv/include/libyuv/convert.h"
 
@@ -26,26 +22,12 @@ extern "C" {
 
 namespace media {
 
-// Returns the number of threads.
+// Returns the default number of threads, which VideoDecoderThreadPolicy may
+// adjust.
 static int GetThreadCount(const VideoDecoderConfig& config) {
-  // Always try to use at least two threads for video decoding. There is little
-  // reason not to since current day CPUs tend to be multi-core and we measured
-  // performance benefits on older machines such as P4s with hyperthreading.
-  constexpr int kDecodeThreads = 2;
-  int decode_threads = kDecodeThreads;
-
-  const base::CommandLine* cmd_line = base::CommandLine::ForCurrentProcess();
-  std::string threads(cmd_line->GetSwitchValueASCII(switches::kVideoThreads));
-  if (threads.empty() || !base::StringToInt(threads, &decode_threads)) {
-    // For AOM decode when using the default thread count, increase the number
-    // of decode threads to equal the maximum number of tiles possible for
-    // higher resolution streams.
-    decode_threads = std::min(config.coded_size().width() / 256,
-                              base::SysInfo::NumberOfProcessors());
-  }
-
-  constexpr int kMaxDecodeThreads = 32;
-  return std::min(std::max(decode_threads, 0), kMaxDecodeThreads);
+  // For AOM decode, use as many decode threads as the maximum number of tiles
+  // possible for the stream's resolution.
+  return config.coded_size().width() / 256;
 }
 
 static VideoPixelFormat AomImgFmtToVideoPixelFormat(const aom_image_t* img) {
@@ -229,20 +211,12 @@ void AomVideoDecoder::Initialize(
   // Clear any previously initialized decoder.
   CloseDecoder();
 
-  aom_codec_dec_cfg_t aom_config = {0};
-  aom_config.w = config.coded_size().width();
-  aom_config.h = config.coded_size().height();
-  aom_config.threads = GetThreadCount(config);
-
   // TODO(dalecurtis): Refactor the MemoryPool and OffloadTaskRunner out of
   // VpxVideoDecoder so that they can be used here for zero copy decoding off
   // of the media thread.
 
-  std::unique_ptr<aom_codec_ctx> context = std::make_unique<aom_codec_ctx>();
-  if (aom_codec_dec_init(context.get(), aom_codec_av1_dx(), &aom_config,
-                         0 /* flags */) != AOM_CODEC_OK) {
-    MEDIA_LOG(ERROR, media_log_) << "aom_codec_dec_init() failed: "
-                                 << aom_codec_error(aom_decoder_.get());
+  thread_policy_ = VideoDecoderThreadPolicy::Create(GetThreadCount(config));
+  if (!ConfigureDecoder(config)) {
     bound_init_cb.Run(false);
     return;
   }
@@ -250,7 +224,6 @@ void AomVideoDecoder::Initialize(
   config_ = config;
   state_ = DecoderState::kNormal;
   output_cb_ = BindToCurrentLoop(output_cb);
-  aom_decoder_ = std::move(context);
   bound_init_cb.Run(true);
 }
 
@@ -278,6 +251,18 @@ void AomVideoDecoder::Decode(scoped_refptr<DecoderBuffer> buffer,
     return;
   }
 
+  // libaom only takes a new thread count when the decoder is created, so
+  // recreate it at a keyframe, which doesn't reference earlier frames.
+  if (buffer->is_key_frame() &&
+      decode_threads_ != thread_policy_->thread_count()) {
+    CloseDecoder();
+    if (!ConfigureDecoder(config_)) {
+      state_ = DecoderState::kError;
+      bound_decode_cb.Run(DecodeStatus::DECODE_ERROR);
+      return;
+    }
+  }
+
   if (!DecodeBuffer(buffer.get())) {
     state_ = DecoderState::kError;
     bound_decode_cb.Run(DecodeStatus::DECODE_ERROR);
@@ -294,6 +279,37 @@ void AomVideoDecoder::Reset(const base::Closure& reset_cb) {
   base::ThreadTaskRunnerHandle::Get()->PostTask(FROM_HERE, reset_cb);
 }
 
+void AomVideoDecoder::OnFramesDropped(int count) {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+
+  // Drops are expected to continue until a pending change in the number of
+  // threads is applied at the next keyframe.
+  if (thread_policy_ && decode_threads_ == thread_policy_->thread_count())
+    thread_policy_->OnFramesDropped(count);
+}
+
+bool AomVideoDecoder::ConfigureDecoder(const VideoDecoderConfig& config) {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  DCHECK(!aom_decoder_);
+
+  aom_codec_dec_cfg_t aom_config = {0};
+  aom_config.w = config.coded_size().width();
+  aom_config.h = config.coded_size().height();
+  aom_config.threads = thread_policy_->thread_count();
+
+  std::unique_ptr<aom_codec_ctx> context = std::make_unique<aom_codec_ctx>();
+  if (aom_codec_dec_init(context.get(), aom_codec_av1_dx(), &aom_config,
+                         0 /* flags */) != AOM_CODEC_OK) {
+    MEDIA_LOG(ERROR, media_log_) << "aom_codec_dec_init() failed: "
+                                 << aom_codec_error(context.get());
+    return false;
+  }
+
+  decode_threads_ = aom_config.threads;
+  aom_decoder_ = std::move(context);
+  return true;
+}
+
 void AomVideoDecoder::CloseDecoder() {
   DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
   if (!aom_decoder_)
@@ -334,6 +350,7 @@ bool AomVideoDecoder::DecodeBuffer(const DecoderBuffer* buffer) {
     frame->metadata()->SetBoolean(VideoFrameMetadata::POWER_EFFICIENT, false);
 
     SetColorSpaceForFrame(img, config_, frame.get());
+    thread_policy_->OnFrameDecoded();
     output_cb_.Run(std::move(frame));
   }
 
@@ -12,6 +12,7 @@
 #include "media/base/video_decoder_config.h"
 #include "media/base/video_frame.h"
 #include "media/base/video_frame_pool.h"
+#include "media/filters/video_decoder_thread_policy.h"
 
 struct aom_codec_ctx;
 struct aom_image;
@@ -37,6 +38,7 @@ class MEDIA_EXPORT AomVideoDecoder : public VideoDecoder {
   void Decode(scoped_refptr<DecoderBuffer> buffer,
               const DecodeCB& decode_cb) override;
   void Reset(const base::Closure& reset_cb) override;
+  void OnFramesDropped(int count) override;
 
  private:
   enum class DecoderState {
@@ -47,6 +49,10 @@ class MEDIA_EXPORT AomVideoDecoder : public VideoDecoder {
     kError
   };
 
+  // Creates |aom_decoder_| for |config| using the thread count chosen by
+  // |thread_policy_|. Returns false on failure.
+  bool ConfigureDecoder(const VideoDecoderConfig& config);
+
   // Releases any configured decoder and clears |aom_decoder_|.
   void CloseDecoder();
 
@@ -75,6 +81,11 @@ class MEDIA_EXPORT AomVideoDecoder : public VideoDecoder {
   // Pool used for memory efficiency when vending frames from the decoder.
   VideoFramePool frame_pool_;
 
+  // Chooses the number of threads for |aom_decoder_|; |decode_threads_| is the
+  // number it was created with.
+  std::unique_ptr<VideoDecoderThreadPolicy> thread_policy_;
+  int decode_threads_ = 0;
+
   // The allocated decoder; null before Initialize() and anytime after
   // CloseDecoder().
   std::unique_ptr<aom_codec_ctx> aom_decoder_;
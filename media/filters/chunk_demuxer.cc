@@ -447,7 +447,9 @@ ChunkDemuxer::ChunkDemuxer(
       detected_audio_track_count_(0),
       detected_video_track_count_(0),
       detected_text_track_count_(0),
-      buffering_by_pts_(base::FeatureList::IsEnabled(kMseBufferByPts)) {
+      buffering_by_pts_(base::FeatureList::IsEnabled(kMseBufferByPts)),
+      unlocked_append_parsing_(
+          base::FeatureList::IsEnabled(kMseUnlockedAppendParsing)) {
   DCHECK(!open_cb_.is_null());
   DCHECK(!encrypted_media_init_data_cb_.is_null());
   MEDIA_LOG(INFO, media_log_)
@@ -853,10 +855,6 @@ bool ChunkDemuxer::AppendData(const std::string& id,
     base::AutoLock auto_lock(lock_);
     DCHECK_NE(state_, ENDED);
 
-    // Capture if any of the SourceBuffers are waiting for data before we start
-    // parsing.
-    bool old_waiting_for_data = IsSeekWaitingForData_Locked();
-
     if (length == 0u)
       return true;
 
@@ -864,15 +862,34 @@ bool ChunkDemuxer::AppendData(const std::string& id,
 
     switch (state_) {
       case INITIALIZING:
-      case INITIALIZED:
+      case INITIALIZED: {
         DCHECK(IsValidId(id));
-        if (!source_state_map_[id]->Append(data, length, append_window_start,
-                                           append_window_end,
-                                           timestamp_offset)) {
+        SourceBufferState* source_state = source_state_map_[id].get();
+        bool appended;
+        if (unlocked_append_parsing_ && state_ == INITIALIZED) {
+          // Only the media thread may call into |this| while |lock_| is
+          // released here, and SourceBufferState takes |lock_| back before
+          // touching anything it shares with it.
+          base::AutoUnlock auto_unlock(lock_);
+          appended = source_state->AppendWithoutLock(
+              &lock_, data, length, append_window_start, append_window_end,
+              timestamp_offset);
+        } else {
+          appended = source_state->Append(data, length, append_window_start,
+                                          append_window_end, timestamp_offset);
+        }
+
+        // Shutdown() may have run on the media thread during an unlocked
+        // append.
+        if (state_ == SHUTDOWN)
+          return false;
+
+        if (!appended) {
           ReportError_Locked(CHUNK_DEMUXER_ERROR_APPEND_FAILED);
           return false;
         }
         break;
+      }
 
       case PARSE_ERROR:
       case WAITING_FOR_INIT:
@@ -883,11 +900,11 @@ bool ChunkDemuxer::AppendData(const std::string& id,
     }
 
     // Check to see if data was appended at the pending seek point. This
-    // indicates we have parsed enough data to complete the seek.
-    if (old_waiting_for_data && !IsSeekWaitingForData_Locked() &&
-        !seek_cb_.is_null()) {
+    // indicates we have parsed enough data to complete the seek. A pending
+    // |seek_cb_| is always waiting for data, even if the seek started while
+    // |lock_| was released above.
+    if (!seek_cb_.is_null() && !IsSeekWaitingForData_Locked())
       base::ResetAndReturn(&seek_cb_).Run(PIPELINE_OK);
-    }
 
     ranges = GetBufferedRanges_Locked();
   }
@@ -484,6 +484,13 @@ class MEDIA_EXPORT ChunkDemuxer : public Demuxer {
   // uses the same behavior. See https://crbug.com/718641.
   const bool buffering_by_pts_;
 
+  // Caches whether |media::kMseUnlockedAppendParsing| was enabled at
+  // construction time. If so, once initialized, AppendData() runs the stream
+  // parser without |lock_| held so that the media thread isn't stalled by
+  // large appends; |lock_| is only taken to process each batch of parsed coded
+  // frames.
+  const bool unlocked_append_parsing_;
+
   std::map<MediaTrack::Id, ChunkDemuxerStream*> track_id_to_demux_stream_map_;
 
   DISALLOW_COPY_AND_ASSIGN(ChunkDemuxer);
@@ -1515,6 +1515,36 @@ TEST_P(ChunkDemuxerTest, ErrorWhileParsingClusterAfterInit) {
   AppendGarbage();
 }
 
+TEST_P(ChunkDemuxerTest, UnlockedAppendParsing) {
+  base::test::ScopedFeatureList scoped_feature_list;
+  scoped_feature_list.InitAndEnableFeature(kMseUnlockedAppendParsing);
+  CreateNewDemuxer();
+  ASSERT_TRUE(InitDemuxer(HAS_AUDIO | HAS_VIDEO));
+
+  // Make the cluster span several slices, each parsed as its own batch.
+  block_size_ = 4096;
+  std::unique_ptr<Cluster> cluster = GenerateCluster(0, 64);
+  ASSERT_GT(static_cast<size_t>(cluster->size()),
+            2 * SourceBufferState::kUnlockedAppendSliceSize);
+  ASSERT_TRUE(AppendCluster(std::move(cluster)));
+  block_size_ = kBlockSize;
+
+  GenerateExpectedReads(0, 64);
+}
+
+TEST_P(ChunkDemuxerTest, ErrorWhileUnlockedParsingAfterInit) {
+  base::test::ScopedFeatureList scoped_feature_list;
+  scoped_feature_list.InitAndEnableFeature(kMseUnlockedAppendParsing);
+  CreateNewDemuxer();
+
+  InSequence s;
+  ASSERT_TRUE(InitDemuxer(HAS_AUDIO | HAS_VIDEO));
+
+  EXPECT_MEDIA_LOG(StreamParsingFailed());
+  EXPECT_CALL(host_, OnDemuxerError(CHUNK_DEMUXER_ERROR_APPEND_FAILED));
+  AppendGarbage();
+}
+
 // Test the case where a Seek() is requested while the parser
 // is in the middle of cluster. This is to verify that the parser
 // does not reset itself on a seek.
@@ -230,6 +230,18 @@ int DecoderStream<DemuxerStream::AUDIO>::GetMaxDecodeRequests() const {
   return 1;
 }
 
+template <DemuxerStream::Type StreamType>
+void DecoderStream<StreamType>::OnFramesDropped(int count) {
+  DCHECK(task_runner_->BelongsToCurrentThread());
+  if (decoder_)
+    decoder_->OnFramesDropped(count);
+}
+
+template <>
+void DecoderStream<DemuxerStream::AUDIO>::OnFramesDropped(int count) {
+  NOTREACHED();
+}
+
 template <DemuxerStream::Type StreamType>
 bool DecoderStream<StreamType>::CanDecodeMore() const {
   DCHECK(task_runner_->BelongsToCurrentThread());
@@ -103,6 +103,10 @@ class MEDIA_EXPORT DecoderStream {
   // Returns maximum concurrent decode requests for the current |decoder_|.
   int GetMaxDecodeRequests() const;
 
+  // Tells the current |decoder_| that |count| of its outputs were dropped
+  // because they were decoded too late. Only used for video.
+  void OnFramesDropped(int count);
+
   // Returns true if one more decode request can be submitted to the decoder.
   bool CanDecodeMore() const;
 
@@ -315,6 +319,9 @@ bool DecoderStream<DemuxerStream::AUDIO>::CanReadWithoutStalling() const;
 template <>
 int DecoderStream<DemuxerStream::AUDIO>::GetMaxDecodeRequests() const;
 
+template <>
+void DecoderStream<DemuxerStream::AUDIO>::OnFramesDropped(int count);
+
 using VideoFrameStream = DecoderStream<DemuxerStream::VIDEO>;
 using AudioBufferStream = DecoderStream<DemuxerStream::AUDIO>;
 
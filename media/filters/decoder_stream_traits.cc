@@ -100,6 +100,10 @@ void DecoderStreamTraits<DemuxerStream::AUDIO>::OnConfigChanged(
 
 // Video decoder stream traits implementation.
 
+// Decoders which don't preserve buffer timestamps never match entries in
+// |decode_begin_times_|, so bound it.
+static const size_t kMaxDecodeBeginTimes = 64;
+
 // static
 std::string DecoderStreamTraits<DemuxerStream::VIDEO>::ToString() {
   return "video";
@@ -166,6 +170,7 @@ void DecoderStreamTraits<DemuxerStream::VIDEO>::OnStreamReset(
   DCHECK(stream);
   last_keyframe_timestamp_ = base::TimeDelta();
   frames_to_drop_.clear();
+  decode_begin_times_.clear();
 }
 
 void DecoderStreamTraits<DemuxerStream::VIDEO>::OnDecode(
@@ -178,6 +183,10 @@ void DecoderStreamTraits<DemuxerStream::VIDEO>::OnDecode(
   if (buffer.discard_padding().first == kInfiniteDuration)
     frames_to_drop_.insert(buffer.timestamp());
 
+  decode_begin_times_[buffer.timestamp()] = base::TimeTicks::Now();
+  if (decode_begin_times_.size() > kMaxDecodeBeginTimes)
+    decode_begin_times_.erase(decode_begin_times_.begin());
+
   if (!buffer.is_key_frame())
     return;
 
@@ -206,6 +215,18 @@ PostDecodeAction DecoderStreamTraits<DemuxerStream::VIDEO>::OnDecodeDone(
     return PostDecodeAction::DROP;
   }
 
+  // As above, entries before the output frame are for frames the decoder
+  // didn't output.
+  VideoFrameMetadata* metadata = buffer->metadata();
+  auto begin_it = decode_begin_times_.find(buffer->timestamp());
+  if (begin_it != decode_begin_times_.end()) {
+    metadata->SetTimeTicks(VideoFrameMetadata::DECODE_BEGIN_TIME,
+                           begin_it->second);
+    decode_begin_times_.erase(decode_begin_times_.begin(), begin_it + 1);
+  }
+  metadata->SetTimeTicks(VideoFrameMetadata::DECODE_END_TIME,
+                         base::TimeTicks::Now());
+
   return PostDecodeAction::DELIVER;
 }
 
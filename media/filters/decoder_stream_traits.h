@@ -5,6 +5,7 @@
 #ifndef MEDIA_FILTERS_DECODER_STREAM_TRAITS_H_
 #define MEDIA_FILTERS_DECODER_STREAM_TRAITS_H_
 
+#include "base/containers/flat_map.h"
 #include "base/containers/flat_set.h"
 #include "base/time/time.h"
 #include "media/base/audio_decoder.h"
@@ -109,6 +110,9 @@ class MEDIA_EXPORT DecoderStreamTraits<DemuxerStream::VIDEO> {
   base::TimeDelta last_keyframe_timestamp_;
   MovingAverage keyframe_distance_average_;
   base::flat_set<base::TimeDelta> frames_to_drop_;
+  // Times at which buffers still being decoded were sent to the decoder, by
+  // buffer timestamp.
+  base::flat_map<base::TimeDelta, base::TimeTicks> decode_begin_times_;
   PipelineStatistics stats_;
 };
 
@@ -11,12 +11,14 @@
 #include "base/macros.h"
 #include "base/run_loop.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/test/scoped_feature_list.h"
 #include "base/test/scoped_task_environment.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "base/time/time.h"
 #include "build/build_config.h"
 #include "media/base/media.h"
 #include "media/base/media_log.h"
+#include "media/base/media_switches.h"
 #include "media/base/media_tracks.h"
 #include "media/base/test_data_util.h"
 #include "media/base/timestamp_constants.h"
@@ -170,7 +172,15 @@ int StreamReader::GetNextStreamIndexToRead() {
   return index;
 }
 
-static void RunDemuxerBenchmark(const std::string& filename) {
+// When |zero_copy| is false every packet is copied into its DecoderBuffer, as
+// FFmpegDemuxer did before it could share FFmpeg's packet buffers.
+static void RunDemuxerBenchmark(const std::string& filename, bool zero_copy) {
+  base::test::ScopedFeatureList scoped_feature_list;
+  if (zero_copy)
+    scoped_feature_list.InitAndEnableFeature(kFFmpegDemuxerZeroCopy);
+  else
+    scoped_feature_list.InitAndDisableFeature(kFFmpegDemuxerZeroCopy);
+
   base::FilePath file_path(GetTestDataFilePath(filename));
   base::TimeDelta total_time;
   MediaLog media_log_;
@@ -207,7 +217,7 @@ static void RunDemuxerBenchmark(const std::string& filename) {
     base::RunLoop().RunUntilIdle();
   }
 
-  perf_test::PrintResult("demuxer_bench", "", filename,
+  perf_test::PrintResult("demuxer_bench", zero_copy ? "" : "_copy", filename,
                          kBenchmarkIterations / total_time.InSecondsF(),
                          "runs/s", true);
 }
@@ -215,7 +225,11 @@ static void RunDemuxerBenchmark(const std::string& filename) {
 class DemuxerPerfTest : public testing::TestWithParam<const char*> {};
 
 TEST_P(DemuxerPerfTest, Demuxer) {
-  RunDemuxerBenchmark(GetParam());
+  RunDemuxerBenchmark(GetParam(), true);
+}
+
+TEST_P(DemuxerPerfTest, DemuxerCopy) {
+  RunDemuxerBenchmark(GetParam(), false);
 }
 
 static const char* kDemuxerTestFiles[] {
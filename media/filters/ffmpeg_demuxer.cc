@@ -4,6 +4,9 @@
 
 #include "media/filters/ffmpeg_demuxer.h"
 
+#include <stdint.h>
+#include <string.h>
+
 #include <algorithm>
 #include <memory>
 #include <set>
@@ -12,6 +15,7 @@
 #include "base/base64.h"
 #include "base/bind.h"
 #include "base/callback_helpers.h"
+#include "base/feature_list.h"
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
 #include "base/metrics/histogram_functions.h"
@@ -31,6 +35,7 @@
 #include "media/base/demuxer_memory_limit.h"
 #include "media/base/limits.h"
 #include "media/base/media_log.h"
+#include "media/base/media_switches.h"
 #include "media/base/media_tracks.h"
 #include "media/base/sample_rates.h"
 #include "media/base/timestamp_constants.h"
@@ -54,6 +59,63 @@ namespace media {
 
 namespace {
 
+// Keeps the refcounted FFmpeg buffer behind a packet alive for as long as a
+// DecoderBuffer refers to it.
+class AVBufferMemory : public DecoderBuffer::ExternalMemory {
+ public:
+  AVBufferMemory(AVBufferRef* buffer, const uint8_t* data, size_t size)
+      : ExternalMemory(data, size), buffer_(buffer) {}
+  ~AVBufferMemory() override { av_buffer_unref(&buffer_); }
+
+ private:
+  AVBufferRef* buffer_;
+
+  DISALLOW_COPY_AND_ASSIGN(AVBufferMemory);
+};
+
+// Returns whether the |size| bytes at |data| within |packet| can back a
+// DecoderBuffer directly, i.e. they live in a refcounted buffer and satisfy the
+// DecoderBuffer alignment and padding requirements.
+bool CanShareAVPacketData(const AVPacket& packet,
+                          const uint8_t* data,
+                          size_t size) {
+  // If a packet is returned by FFmpeg's av_parser_parse2() the packet will
+  // reference inner memory of FFmpeg and has no |buf|.
+  if (!packet.buf || !base::FeatureList::IsEnabled(kFFmpegDemuxerZeroCopy))
+    return false;
+
+  if (reinterpret_cast<uintptr_t>(data) % DecoderBuffer::kAlignmentSize)
+    return false;
+
+  const uint8_t* buffer_end = packet.buf->data + packet.buf->size;
+  if (data < packet.buf->data || data > buffer_end ||
+      static_cast<size_t>(buffer_end - data) <
+          size + DecoderBuffer::kPaddingSize) {
+    return false;
+  }
+
+  // FFmpeg only guarantees AV_INPUT_BUFFER_PADDING_SIZE zeroed bytes, which
+  // may be less than DecoderBuffer::kPaddingSize.
+  static const uint8_t kZeroPadding[DecoderBuffer::kPaddingSize] = {};
+  return memcmp(data + size, kZeroPadding, sizeof(kZeroPadding)) == 0;
+}
+
+// Creates a DecoderBuffer holding the |size| bytes at |data| within |packet|.
+// The packet's buffer is shared when possible, otherwise the data is copied
+// into memory we control.
+scoped_refptr<DecoderBuffer> CreateDecoderBuffer(const AVPacket& packet,
+                                                 const uint8_t* data,
+                                                 size_t size) {
+  if (CanShareAVPacketData(packet, data, size)) {
+    AVBufferRef* buffer = av_buffer_ref(packet.buf);
+    if (buffer) {
+      return DecoderBuffer::FromExternalMemory(
+          std::make_unique<AVBufferMemory>(buffer, data, size));
+    }
+  }
+  return DecoderBuffer::CopyFrom(data, size);
+}
+
 void SetAVStreamDiscard(AVStream* stream, AVDiscard discard) {
   DCHECK(stream);
   stream->discard = discard;
@@ -454,17 +516,10 @@ void FFmpegDemuxerStream::EnqueuePacket(ScopedAVPacket packet) {
       }
     }
 
-    // If a packet is returned by FFmpeg's av_parser_parse2() the packet will
-    // reference inner memory of FFmpeg.  As such we should transfer the packet
-    // into memory we control.
-    if (side_data_size > 0) {
-      buffer = DecoderBuffer::CopyFrom(packet->data + data_offset,
-                                       packet->size - data_offset, side_data,
-                                       side_data_size);
-    } else {
-      buffer = DecoderBuffer::CopyFrom(packet->data + data_offset,
-                                       packet->size - data_offset);
-    }
+    buffer = CreateDecoderBuffer(*packet, packet->data + data_offset,
+                                 packet->size - data_offset);
+    if (side_data_size > 0)
+      buffer->CopySideDataFrom(side_data, side_data_size);
 
     int skip_samples_size = 0;
     const uint32_t* skip_samples_ptr =
@@ -4,21 +4,28 @@
 
 #include "media/filters/frame_buffer_pool.h"
 
+#include <memory>
+#include <utility>
+
 #include "base/bind.h"
 #include "base/callback_helpers.h"
 #include "base/location.h"
 #include "base/logging.h"
 #include "base/macros.h"
+#include "base/memory/shared_memory.h"
 #include "base/sequenced_task_runner.h"
 #include "base/stl_util.h"
 #include "base/threading/sequenced_task_runner_handle.h"
 #include "base/trace_event/memory_allocator_dump.h"
 #include "base/trace_event/memory_dump_manager.h"
 #include "base/trace_event/process_memory_dump.h"
+#include "media/base/video_frame.h"
 
 namespace media {
 
 struct FrameBufferPool::FrameBuffer {
+  // Decode memory, from |shared_memory| if set and |data| otherwise.
+  std::unique_ptr<base::SharedMemory> shared_memory;
   std::vector<uint8_t> data;
   std::vector<uint8_t> alpha_data;
   bool held_by_library = false;
@@ -27,8 +34,9 @@ struct FrameBufferPool::FrameBuffer {
   base::TimeTicks last_use_time;
 };
 
-FrameBufferPool::FrameBufferPool()
-    : tick_clock_(base::DefaultTickClock::GetInstance()) {
+FrameBufferPool::FrameBufferPool(bool use_shared_memory)
+    : use_shared_memory_(use_shared_memory),
+      tick_clock_(base::DefaultTickClock::GetInstance()) {
   DETACH_FROM_SEQUENCE(sequence_checker_);
 }
 
@@ -61,13 +69,30 @@ uint8_t* FrameBufferPool::GetFrameBuffer(size_t min_size, void** fb_priv) {
 
   auto& frame_buffer = *it;
 
-  // Resize the frame buffer if necessary.
   frame_buffer->held_by_library = true;
-  if (frame_buffer->data.size() < min_size)
-    frame_buffer->data.resize(min_size);
 
   // Provide the client with a private identifier.
   *fb_priv = frame_buffer.get();
+
+  // Shared memory can't be resized, so replace it if it is too small. Heap
+  // memory is used instead if shared memory can't be allocated.
+  if (use_shared_memory_ && frame_buffer->data.empty()) {
+    if (frame_buffer->shared_memory &&
+        frame_buffer->shared_memory->mapped_size() < min_size) {
+      frame_buffer->shared_memory.reset();
+    }
+    if (!frame_buffer->shared_memory) {
+      auto shared_memory = std::make_unique<base::SharedMemory>();
+      if (shared_memory->CreateAndMapAnonymous(min_size))
+        frame_buffer->shared_memory = std::move(shared_memory);
+    }
+    if (frame_buffer->shared_memory)
+      return static_cast<uint8_t*>(frame_buffer->shared_memory->memory());
+  }
+
+  // Resize the frame buffer if necessary.
+  if (frame_buffer->data.size() < min_size)
+    frame_buffer->data.resize(min_size);
   return frame_buffer->data.data();
 }
 
@@ -104,6 +129,24 @@ base::Closure FrameBufferPool::CreateFrameCallback(void* fb_priv) {
                     base::SequencedTaskRunnerHandle::Get(), frame_buffer);
 }
 
+void FrameBufferPool::AddSharedMemoryToFrame(void* fb_priv,
+                                             VideoFrame* video_frame) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  auto* frame_buffer = static_cast<FrameBuffer*>(fb_priv);
+  DCHECK(IsUsed(frame_buffer));
+  if (!frame_buffer->shared_memory)
+    return;
+
+  const uint8_t* memory =
+      static_cast<const uint8_t*>(frame_buffer->shared_memory->memory());
+  const uint8_t* data = video_frame->data(VideoFrame::kYPlane);
+  DCHECK_GE(data, memory);
+  DCHECK_LT(data, memory + frame_buffer->shared_memory->mapped_size());
+  video_frame->AddSharedMemoryHandle(frame_buffer->shared_memory->handle(),
+                                     data - memory);
+}
+
 bool FrameBufferPool::OnMemoryDump(
     const base::trace_event::MemoryDumpArgs& args,
     base::trace_event::ProcessMemoryDump* pmd) {
@@ -120,9 +163,10 @@ bool FrameBufferPool::OnMemoryDump(
   size_t bytes_used = 0;
   size_t bytes_reserved = 0;
   for (const auto& frame_buffer : frame_buffers_) {
+    const size_t size = GetDataSize(frame_buffer.get());
     if (IsUsed(frame_buffer.get()))
-      bytes_used += frame_buffer->data.size();
-    bytes_reserved += frame_buffer->data.size();
+      bytes_used += size;
+    bytes_reserved += size;
   }
 
   memory_dump->AddScalar(base::trace_event::MemoryAllocatorDump::kNameSize,
@@ -158,6 +202,12 @@ bool FrameBufferPool::IsUsed(const FrameBuffer* buf) {
   return buf->held_by_library || buf->held_by_frame > 0;
 }
 
+// static
+size_t FrameBufferPool::GetDataSize(const FrameBuffer* buf) {
+  return buf->shared_memory ? buf->shared_memory->mapped_size()
+                            : buf->data.size();
+}
+
 void FrameBufferPool::EraseUnusedResources() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   base::EraseIf(frame_buffers_, [](const std::unique_ptr<FrameBuffer>& buf) {
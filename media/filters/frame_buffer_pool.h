@@ -24,6 +24,8 @@ class SequencedTaskRunner;
 
 namespace media {
 
+class VideoFrame;
+
 // FrameBufferPool is a pool of simple CPU memory. This class needs to be ref-
 // counted since frames created using this memory may live beyond the lifetime
 // of the caller to this class.
@@ -31,7 +33,10 @@ class MEDIA_EXPORT FrameBufferPool
     : public base::RefCountedThreadSafe<FrameBufferPool>,
       public base::trace_event::MemoryDumpProvider {
  public:
-  FrameBufferPool();
+  // If |use_shared_memory| is true, frame buffers are allocated in shared
+  // memory when possible, so that frames decoded into them can be imported by
+  // the GPU without a copy; see AddSharedMemoryToFrame().
+  explicit FrameBufferPool(bool use_shared_memory = false);
 
   // Called when a frame buffer allocation is needed. Upon return |fb_priv| will
   // be set to a private value used to identify the buffer in future calls and a
@@ -49,6 +54,12 @@ class MEDIA_EXPORT FrameBufferPool
   // |fb_priv| must be a value previously returned by GetFrameBuffer().
   base::Closure CreateFrameCallback(void* fb_priv);
 
+  // Marks |video_frame|, whose planes must all lie within the frame buffer
+  // identified by |fb_priv|, as backed by that buffer's shared memory. Does
+  // nothing if the buffer is ordinary heap memory. Must be followed by a call
+  // to CreateFrameCallback() for |video_frame| so the memory outlives it.
+  void AddSharedMemoryToFrame(void* fb_priv, VideoFrame* video_frame);
+
   size_t get_pool_size_for_testing() const { return frame_buffers_.size(); }
 
   void set_tick_clock_for_testing(const base::TickClock* tick_clock) {
@@ -76,6 +87,9 @@ class MEDIA_EXPORT FrameBufferPool
 
   static bool IsUsed(const FrameBuffer* buf);
 
+  // Returns the number of bytes of decode memory held by |buf|.
+  static size_t GetDataSize(const FrameBuffer* buf);
+
   // Drop all entries in |frame_buffers_| that report !IsUsed().
   void EraseUnusedResources();
 
@@ -88,6 +102,8 @@ class MEDIA_EXPORT FrameBufferPool
   // Allocated frame buffers.
   std::vector<std::unique_ptr<FrameBuffer>> frame_buffers_;
 
+  const bool use_shared_memory_;
+
   bool in_shutdown_ = false;
 
   bool registered_dump_provider_ = false;
@@ -6,6 +6,7 @@
 
 #include "base/test/simple_test_tick_clock.h"
 #include "base/test/test_message_loop.h"
+#include "media/base/video_frame.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace media {
@@ -103,4 +104,44 @@ TEST(FrameBufferPool, DeferredDestruction) {
   pool->Shutdown();
 }
 
+TEST(FrameBufferPool, SharedMemory) {
+  base::TestMessageLoop message_loop;
+  scoped_refptr<FrameBufferPool> pool = new FrameBufferPool(true);
+
+  const gfx::Size size(16, 16);
+  const size_t y_size = size.GetArea();
+  const size_t uv_size = y_size / 4;
+  const size_t offset = 64;
+
+  void* priv = nullptr;
+  uint8_t* buf = pool->GetFrameBuffer(offset + y_size + 2 * uv_size, &priv);
+  ASSERT_TRUE(buf);
+
+  uint8_t* y_data = buf + offset;
+  scoped_refptr<VideoFrame> frame = VideoFrame::WrapExternalYuvData(
+      PIXEL_FORMAT_I420, size, gfx::Rect(size), size, size.width(),
+      size.width() / 2, size.width() / 2, y_data, y_data + y_size,
+      y_data + y_size + uv_size, base::TimeDelta());
+  ASSERT_TRUE(frame);
+  pool->AddSharedMemoryToFrame(priv, frame.get());
+  frame->AddDestructionObserver(pool->CreateFrameCallback(priv));
+  pool->ReleaseFrameBuffer(priv);
+
+  EXPECT_EQ(VideoFrame::STORAGE_SHMEM, frame->storage_type());
+  EXPECT_TRUE(frame->shared_memory_handle().IsValid());
+  EXPECT_EQ(offset, frame->shared_memory_offset());
+
+  // Wrapping frames refer to the same memory.
+  scoped_refptr<VideoFrame> wrapped_frame = VideoFrame::WrapVideoFrame(
+      frame, frame->format(), frame->visible_rect(), frame->natural_size());
+  ASSERT_TRUE(wrapped_frame);
+  EXPECT_EQ(VideoFrame::STORAGE_SHMEM, wrapped_frame->storage_type());
+  EXPECT_EQ(offset, wrapped_frame->shared_memory_offset());
+
+  wrapped_frame = nullptr;
+  frame = nullptr;
+  pool->Shutdown();
+  EXPECT_EQ(0u, pool->get_pool_size_for_testing());
+}
+
 }  // namespace media
@@ -193,4 +193,16 @@ int OffloadingVideoDecoder::GetMaxDecodeRequests() const {
   return offload_task_runner_ ? 2 : 1;
 }
 
+void OffloadingVideoDecoder::OnFramesDropped(int count) {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  if (!offload_task_runner_) {
+    helper_->decoder()->OnFramesDropped(count);
+    return;
+  }
+
+  offload_task_runner_->PostTask(
+      FROM_HERE, base::BindOnce(&OffloadableVideoDecoder::OnFramesDropped,
+                                base::Unretained(helper_->decoder()), count));
+}
+
 }  // namespace media
@@ -90,6 +90,7 @@ class MEDIA_EXPORT OffloadingVideoDecoder : public VideoDecoder {
               const DecodeCB& decode_cb) override;
   void Reset(const base::Closure& reset_cb) override;
   int GetMaxDecodeRequests() const override;
+  void OnFramesDropped(int count) override;
 
  private:
   // VideoDecoderConfigs given to Initialize() with a coded size that has width
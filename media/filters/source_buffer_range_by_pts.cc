@@ -8,8 +8,10 @@
 #include <memory>
 #include <sstream>
 #include <string>
+#include <utility>
 
 #include "base/logging.h"
+#include "base/memory/ptr_util.h"
 #include "media/base/timestamp_constants.h"
 
 namespace media {
@@ -28,6 +30,14 @@ SourceBufferRangeByPts::SourceBufferRangeByPts(
   AppendBuffersToEnd(new_buffers, range_start_pts_);
 }
 
+SourceBufferRangeByPts::SourceBufferRangeByPts(
+    GapPolicy gap_policy,
+    base::TimeDelta range_start_pts,
+    const InterbufferDistanceCB& interbuffer_distance_cb)
+    : SourceBufferRange(gap_policy, interbuffer_distance_cb),
+      range_start_pts_(range_start_pts),
+      keyframe_map_index_base_(0) {}
+
 SourceBufferRangeByPts::~SourceBufferRangeByPts() = default;
 
 void SourceBufferRangeByPts::DeleteAll(BufferQueue* deleted_buffers) {
@@ -224,28 +234,59 @@ std::unique_ptr<SourceBufferRangeByPts> SourceBufferRangeByPts::SplitRange(
   if (new_beginning_keyframe == keyframe_map_.end())
     return nullptr;
 
-  // Remove the data beginning at |keyframe_index| from |buffers_| and save it
-  // into |removed_buffers|.
   int keyframe_index =
       new_beginning_keyframe->second - keyframe_map_index_base_;
   CHECK_LT(keyframe_index, static_cast<int>(buffers_.size()));
-  BufferQueue::iterator starting_point = buffers_.begin() + keyframe_index;
-  BufferQueue removed_buffers(starting_point, buffers_.end());
 
   base::TimeDelta new_range_start_pts =
       std::max(timestamp, GetStartTimestamp());
-  DCHECK(new_range_start_pts <= removed_buffers.front()->timestamp());
-
-  keyframe_map_.erase(new_beginning_keyframe, keyframe_map_.end());
-  FreeBufferRange(starting_point, buffers_.end());
+  DCHECK(new_range_start_pts <= buffers_[keyframe_index]->timestamp());
+
+  std::unique_ptr<SourceBufferRangeByPts> split_range;
+  if (keyframe_index < static_cast<int>(buffers_.size()) - keyframe_index) {
+    // Fewer buffers stay in this range than move to the new one, so hand all
+    // of |buffers_| and |keyframe_map_| to the new range and move back only
+    // the buffers before |keyframe_index|. This keeps removals from the front
+    // of long ranges from copying and re-indexing everything after them.
+    split_range = base::WrapUnique(new SourceBufferRangeByPts(
+        gap_policy_, new_range_start_pts, interbuffer_distance_cb_));
+    split_range->buffers_.swap(buffers_);
+    split_range->keyframe_map_.swap(keyframe_map_);
+    split_range->size_in_bytes_ = size_in_bytes_;
+    size_in_bytes_ = 0;
+
+    keyframe_map_.insert(split_range->keyframe_map_.cbegin(),
+                         new_beginning_keyframe);
+    split_range->keyframe_map_.erase(split_range->keyframe_map_.cbegin(),
+                                     new_beginning_keyframe);
+    split_range->keyframe_map_index_base_ =
+        keyframe_map_index_base_ + keyframe_index;
+
+    for (int i = 0; i < keyframe_index; ++i) {
+      size_t data_size = split_range->buffers_.front()->data_size();
+      DCHECK_GE(split_range->size_in_bytes_, data_size);
+      split_range->size_in_bytes_ -= data_size;
+      size_in_bytes_ += data_size;
+      buffers_.push_back(std::move(split_range->buffers_.front()));
+      split_range->buffers_.pop_front();
+    }
+    split_range->UpdateEndTimeUsingLastGOP();
+  } else {
+    // Remove the data beginning at |keyframe_index| from |buffers_| and save
+    // it into |removed_buffers|.
+    BufferQueue::iterator starting_point = buffers_.begin() + keyframe_index;
+    BufferQueue removed_buffers(starting_point, buffers_.end());
+
+    keyframe_map_.erase(new_beginning_keyframe, keyframe_map_.end());
+    FreeBufferRange(starting_point, buffers_.end());
+
+    // Create a new range with |removed_buffers|.
+    split_range = std::make_unique<SourceBufferRangeByPts>(
+        gap_policy_, removed_buffers, new_range_start_pts,
+        interbuffer_distance_cb_);
+  }
   UpdateEndTimeUsingLastGOP();
 
-  // Create a new range with |removed_buffers|.
-  std::unique_ptr<SourceBufferRangeByPts> split_range =
-      std::make_unique<SourceBufferRangeByPts>(gap_policy_, removed_buffers,
-                                               new_range_start_pts,
-                                               interbuffer_distance_cb_);
-
   // If the next buffer position is now in |split_range|, update the state of
   // this range and |split_range| accordingly.
   if (next_buffer_index_ >= static_cast<int>(buffers_.size())) {
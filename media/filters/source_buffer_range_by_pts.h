@@ -100,6 +100,8 @@ class MEDIA_EXPORT SourceBufferRangeByPts : public SourceBufferRange {
   // SplitRange() returns null and this range is unmodified. This range can
   // become empty if |timestamp| <= the PTS of the first buffer in this range.
   // |highest_frame_| is updated, if necessary.
+  // The cost is linear in the size of the smaller of the two resulting ranges,
+  // so splitting near either end of a long range is cheap.
   std::unique_ptr<SourceBufferRangeByPts> SplitRange(base::TimeDelta timestamp);
 
   // Deletes the buffers from this range starting at |timestamp|, exclusive if
@@ -195,6 +197,12 @@ class MEDIA_EXPORT SourceBufferRangeByPts : public SourceBufferRange {
  private:
   typedef std::map<base::TimeDelta, int> KeyframeMap;
 
+  // Creates an empty range, which SplitRange() then fills by taking over this
+  // range's buffers.
+  SourceBufferRangeByPts(GapPolicy gap_policy,
+                         base::TimeDelta range_start_pts,
+                         const InterbufferDistanceCB& interbuffer_distance_cb);
+
   // Helper method for Appending |range| to the end of this range.  If |range|'s
   // first buffer time is before the time of the last buffer in this range,
   // returns kNoTimestamp.  Otherwise, returns the closest time within
@@ -4,6 +4,7 @@
 
 #include "media/filters/source_buffer_state.h"
 
+#include <algorithm>
 #include <set>
 
 #include "base/callback_helpers.h"
@@ -68,6 +69,8 @@ unsigned GetMSEBufferSizeLimitIfExists(base::StringPiece switch_string) {
 
 }  // namespace
 
+const size_t SourceBufferState::kUnlockedAppendSliceSize = 128 * 1024;
+
 // List of time ranges for each SourceBuffer.
 // static
 Ranges<TimeDelta> SourceBufferState::ComputeRangesIntersection(
@@ -244,6 +247,30 @@ bool SourceBufferState::Append(const uint8_t* data,
   return result;
 }
 
+bool SourceBufferState::AppendWithoutLock(base::Lock* lock,
+                                          const uint8_t* data,
+                                          size_t length,
+                                          TimeDelta append_window_start,
+                                          TimeDelta append_window_end,
+                                          TimeDelta* timestamp_offset) {
+  DCHECK(lock);
+  DCHECK(!parser_output_lock_);
+  parser_output_lock_ = lock;
+
+  // Byte stream parsers accept appended data split at arbitrary points, so
+  // slicing bounds how much parsed output each batch holds |lock| for.
+  bool result = true;
+  for (size_t offset = 0; result && offset < length;
+       offset += kUnlockedAppendSliceSize) {
+    result = Append(data + offset,
+                    std::min(kUnlockedAppendSliceSize, length - offset),
+                    append_window_start, append_window_end, timestamp_offset);
+  }
+
+  parser_output_lock_ = nullptr;
+  return result;
+}
+
 void SourceBufferState::ResetParserState(TimeDelta append_window_start,
                                          TimeDelta append_window_end,
                                          base::TimeDelta* timestamp_offset) {
@@ -497,6 +524,8 @@ void SourceBufferState::UnmarkEndOfStream() {
 }
 
 void SourceBufferState::Shutdown() {
+  shut_down_ = true;
+
   for (const auto& it : audio_streams_) {
     it.second->Shutdown();
   }
@@ -559,6 +588,10 @@ bool SourceBufferState::OnNewConfigs(
     std::string expected_codecs,
     std::unique_ptr<MediaTracks> tracks,
     const StreamParser::TextTrackConfigMap& text_configs) {
+  base::Optional<base::AutoLock> auto_lock;
+  if (!LockForParserOutput(&auto_lock))
+    return false;
+
   DCHECK(tracks.get());
   DVLOG(1) << __func__ << " expected_codecs=" << expected_codecs
            << " tracks=" << tracks->tracks().size();
@@ -838,6 +871,10 @@ void SourceBufferState::SetStreamMemoryLimits() {
 }
 
 void SourceBufferState::OnNewMediaSegment() {
+  base::Optional<base::AutoLock> auto_lock;
+  if (!LockForParserOutput(&auto_lock))
+    return;
+
   DVLOG(2) << "OnNewMediaSegment()";
   DCHECK_EQ(state_, PARSER_INITIALIZED);
   parsing_media_segment_ = true;
@@ -845,6 +882,10 @@ void SourceBufferState::OnNewMediaSegment() {
 }
 
 void SourceBufferState::OnEndOfMediaSegment() {
+  base::Optional<base::AutoLock> auto_lock;
+  if (!LockForParserOutput(&auto_lock))
+    return;
+
   DVLOG(2) << "OnEndOfMediaSegment()";
   DCHECK_EQ(state_, PARSER_INITIALIZED);
   parsing_media_segment_ = false;
@@ -873,6 +914,10 @@ void SourceBufferState::OnEndOfMediaSegment() {
 
 bool SourceBufferState::OnNewBuffers(
     const StreamParser::BufferQueueMap& buffer_queue_map) {
+  base::Optional<base::AutoLock> auto_lock;
+  if (!LockForParserOutput(&auto_lock))
+    return false;
+
   DVLOG(2) << __func__ << " buffer_queues=" << buffer_queue_map.size();
   DCHECK_EQ(state_, PARSER_INITIALIZED);
   DCHECK(timestamp_offset_during_append_);
@@ -926,15 +971,32 @@ bool SourceBufferState::OnNewBuffers(
 void SourceBufferState::OnEncryptedMediaInitData(
     EmeInitDataType type,
     const std::vector<uint8_t>& init_data) {
+  base::Optional<base::AutoLock> auto_lock;
+  if (!LockForParserOutput(&auto_lock))
+    return;
+
   encrypted_media_init_data_reported_ = true;
   encrypted_media_init_data_cb_.Run(type, init_data);
 }
 
 void SourceBufferState::OnSourceInitDone(
     const StreamParser::InitParameters& params) {
+  base::Optional<base::AutoLock> auto_lock;
+  if (!LockForParserOutput(&auto_lock))
+    return;
+
   DCHECK_EQ(state_, PENDING_PARSER_INIT);
   state_ = PARSER_INITIALIZED;
   base::ResetAndReturn(&init_cb_).Run(params);
 }
 
+bool SourceBufferState::LockForParserOutput(
+    base::Optional<base::AutoLock>* auto_lock) {
+  if (!parser_output_lock_)
+    return true;
+
+  auto_lock->emplace(*parser_output_lock_);
+  return !shut_down_;
+}
+
 }  // namespace media
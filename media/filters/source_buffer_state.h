@@ -10,6 +10,8 @@
 #include "base/bind.h"
 #include "base/macros.h"
 #include "base/memory/memory_pressure_listener.h"
+#include "base/optional.h"
+#include "base/synchronization/lock.h"
 #include "media/base/audio_codecs.h"
 #include "media/base/demuxer.h"
 #include "media/base/demuxer_stream.h"
@@ -30,6 +32,8 @@ class FrameProcessor;
 // Contains state belonging to a source id.
 class MEDIA_EXPORT SourceBufferState {
  public:
+  static const size_t kUnlockedAppendSliceSize;
+
   // Callback signature used to create ChunkDemuxerStreams.
   typedef base::Callback<ChunkDemuxerStream*(DemuxerStream::Type)>
       CreateDemuxerStreamCB;
@@ -62,6 +66,18 @@ class MEDIA_EXPORT SourceBufferState {
               TimeDelta append_window_end,
               TimeDelta* timestamp_offset);
 
+  // Like Append(), but called without |lock| held, where |lock| guards this
+  // object and the demuxer streams it feeds. The stream parser runs unlocked
+  // on slices of at most |kUnlockedAppendSliceSize| bytes, and |lock| is only
+  // held while each batch of parsed coded frames is processed. Fails, dropping
+  // the remaining coded frames, if Shutdown() runs during the append.
+  bool AppendWithoutLock(base::Lock* lock,
+                         const uint8_t* data,
+                         size_t length,
+                         TimeDelta append_window_start,
+                         TimeDelta append_window_end,
+                         TimeDelta* timestamp_offset);
+
   // Aborts the current append sequence and resets the parser.
   void ResetParserState(TimeDelta append_window_start,
                         TimeDelta append_window_end,
@@ -186,6 +202,11 @@ class MEDIA_EXPORT SourceBufferState {
   // Sets memory limits for all demuxer streams.
   void SetStreamMemoryLimits();
 
+  // Acquires |parser_output_lock_| into |auto_lock| during AppendWithoutLock().
+  // Returns false if the stream parser's output must be dropped because
+  // Shutdown() has been called.
+  bool LockForParserOutput(base::Optional<base::AutoLock>* auto_lock);
+
   // Tracks the number of MEDIA_LOGs emitted for segments missing expected audio
   // or video blocks. Useful to prevent log spam.
   int num_missing_track_logs_ = 0;
@@ -240,6 +261,10 @@ class MEDIA_EXPORT SourceBufferState {
   bool first_init_segment_received_ = false;
   bool encrypted_media_init_data_reported_ = false;
 
+  // Set only during AppendWithoutLock(); see LockForParserOutput().
+  base::Lock* parser_output_lock_ = nullptr;
+  bool shut_down_ = false;
+
   std::vector<AudioCodec> expected_audio_codecs_;
   std::vector<VideoCodec> expected_video_codecs_;
 
@@ -0,0 +1,105 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+
+#include "base/time/time.h"
+#include "media/base/media_log.h"
+#include "media/base/stream_parser_buffer.h"
+#include "media/base/test_helpers.h"
+#include "media/filters/source_buffer_range_by_pts.h"
+#include "media/filters/source_buffer_stream.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace media {
+
+// Simulates a long live stream of 30 fps video appended in one second media
+// segments, each starting with a keyframe.
+static const int kFramesPerSecond = 30;
+static const int kStreamSeconds = 3 * 60 * 60;
+static const int kFrameSize = 16;
+
+// Amount of media kept buffered behind the live edge, either by the memory
+// limit or by the application removing older data.
+static const int kWindowSeconds = 10 * 60;
+
+enum class EvictionMode { kNone, kGarbageCollection, kRemoveFront };
+
+static StreamParser::BufferQueue CreateSegment(int second) {
+  static const uint8_t kData[kFrameSize] = {};
+  const base::TimeDelta frame_duration = base::TimeDelta::FromMicroseconds(
+      base::Time::kMicrosecondsPerSecond / kFramesPerSecond);
+
+  StreamParser::BufferQueue buffers;
+  for (int i = 0; i < kFramesPerSecond; ++i) {
+    scoped_refptr<StreamParserBuffer> buffer = StreamParserBuffer::CopyFrom(
+        kData, kFrameSize, i == 0, DemuxerStream::VIDEO, 0);
+    const base::TimeDelta timestamp =
+        base::TimeDelta::FromSeconds(second) + frame_duration * i;
+    buffer->set_timestamp(timestamp);
+    buffer->SetDecodeTimestamp(
+        DecodeTimestamp::FromPresentationTime(timestamp));
+    buffer->set_duration(frame_duration);
+    buffers.push_back(buffer);
+  }
+  return buffers;
+}
+
+static void RunAppendBenchmark(const std::string& trace, EvictionMode mode) {
+  MediaLog media_log;
+  SourceBufferStream<SourceBufferRangeByPts> stream(TestVideoConfig::Normal(),
+                                                    &media_log);
+  const size_t segment_size = kFramesPerSecond * kFrameSize;
+  stream.set_memory_limit(mode == EvictionMode::kGarbageCollection
+                              ? kWindowSeconds * segment_size
+                              : kStreamSeconds * segment_size * 2);
+  stream.Seek(base::TimeDelta());
+
+  const base::TimeDelta window = base::TimeDelta::FromSeconds(kWindowSeconds);
+  const base::TimeDelta duration = base::TimeDelta::FromSeconds(kStreamSeconds);
+  base::TimeDelta total_time;
+  for (int second = 0; second < kStreamSeconds; ++second) {
+    StreamParser::BufferQueue buffers = CreateSegment(second);
+    const base::TimeDelta segment_start = base::TimeDelta::FromSeconds(second);
+
+    base::TimeTicks start = base::TimeTicks::Now();
+    if (mode == EvictionMode::kGarbageCollection) {
+      ASSERT_TRUE(stream.GarbageCollectIfNeeded(
+          DecodeTimestamp::FromPresentationTime(segment_start), segment_size));
+    } else if (mode == EvictionMode::kRemoveFront && second > kWindowSeconds) {
+      stream.Remove(base::TimeDelta(), segment_start - window, duration);
+    }
+    stream.OnStartOfCodedFrameGroup(
+        DecodeTimestamp::FromPresentationTime(segment_start), segment_start);
+    ASSERT_TRUE(stream.Append(buffers));
+    total_time += base::TimeTicks::Now() - start;
+
+    // Play at the live edge so that everything behind it may be evicted.
+    scoped_refptr<StreamParserBuffer> buffer;
+    while (stream.GetNextBuffer(&buffer) == SourceBufferStreamStatus::kSuccess)
+      continue;
+  }
+
+  perf_test::PrintResult("source_buffer_stream", "", trace,
+                         total_time.InMicrosecondsF() / kStreamSeconds,
+                         "us/segment", true);
+}
+
+TEST(SourceBufferStreamPerfTest, AppendLongStream) {
+  RunAppendBenchmark("append", EvictionMode::kNone);
+}
+
+TEST(SourceBufferStreamPerfTest, AppendLongStreamWithGarbageCollection) {
+  RunAppendBenchmark("append_gc", EvictionMode::kGarbageCollection);
+}
+
+TEST(SourceBufferStreamPerfTest, AppendLongStreamWithRemoveFront) {
+  RunAppendBenchmark("append_remove_front", EvictionMode::kRemoveFront);
+}
+
+}  // namespace media
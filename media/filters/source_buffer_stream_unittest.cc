@@ -4215,6 +4215,27 @@ TEST_P(SourceBufferStreamTest, Remove_BeforeCurrentPosition) {
   CheckExpectedBuffers("150 180K 210 240 270K 300 330");
 }
 
+// Test removing most of the selected range before the current position, which
+// leaves the remaining buffers and the read position in a new range.
+TEST_P(SourceBufferStreamTest, Remove_FrontOfLongRange) {
+  Seek(0);
+  NewCodedFrameGroupAppend(
+      "0K 30 60 90K 120 150 180K 210 240 270K 300 330 360K 390 420 450K 480 "
+      "510");
+  CheckExpectedRangesByTimestamp("{ [0,540) }");
+  CheckExpectedBuffers("0K 30 60 90K 120 150 180K 210");
+
+  RemoveInMs(0, 180, 540);
+  CheckExpectedRangesByTimestamp("{ [180,540) }");
+
+  // The remaining range still accepts appends continuing the coded frame group.
+  AppendBuffers("540K 570");
+  CheckExpectedRangesByTimestamp("{ [180,600) }");
+
+  CheckExpectedBuffers("240 270K 300 330 360K 390 420 450K 480 510 540K 570");
+  CheckNoNextBuffer();
+}
+
 // Test removing the preliminary portion for the current coded frame group being
 // appended.
 TEST_P(SourceBufferStreamTest, Remove_MidGroup) {
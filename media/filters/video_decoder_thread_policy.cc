@@ -0,0 +1,78 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "media/filters/video_decoder_thread_policy.h"
+
+#include <algorithm>
+#include <string>
+
+#include "base/command_line.h"
+#include "base/logging.h"
+#include "base/power_monitor/power_monitor.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/sys_info.h"
+#include "media/base/media_switches.h"
+
+namespace media {
+
+constexpr int VideoDecoderThreadPolicy::kMaxDroppedFrames;
+constexpr int VideoDecoderThreadPolicy::kWindowFrames;
+
+// static
+std::unique_ptr<VideoDecoderThreadPolicy> VideoDecoderThreadPolicy::Create(
+    int default_threads) {
+  constexpr int kMaxDecodeThreads = 32;
+
+  int threads = 0;
+  const base::CommandLine* cmd_line = base::CommandLine::ForCurrentProcess();
+  const std::string threads_switch =
+      cmd_line->GetSwitchValueASCII(switches::kVideoThreads);
+  if (!threads_switch.empty() && base::StringToInt(threads_switch, &threads)) {
+    threads = std::min(std::max(threads, 0), kMaxDecodeThreads);
+    return std::make_unique<VideoDecoderThreadPolicy>(threads, threads);
+  }
+
+  const int max_threads =
+      std::min(base::SysInfo::NumberOfProcessors(), kMaxDecodeThreads);
+  threads = std::min(default_threads, max_threads);
+
+  // Extra threads cost power in wakeups and synchronization, so on battery
+  // only use them once they turn out to be needed.
+  base::PowerMonitor* power_monitor = base::PowerMonitor::Get();
+  if (power_monitor && power_monitor->IsOnBatteryPower())
+    threads = (threads + 1) / 2;
+
+  return std::make_unique<VideoDecoderThreadPolicy>(threads, max_threads);
+}
+
+VideoDecoderThreadPolicy::VideoDecoderThreadPolicy(int initial_threads,
+                                                   int max_threads)
+    : max_threads_(max_threads), thread_count_(initial_threads) {
+  DCHECK_GE(initial_threads, 0);
+  DCHECK_LE(initial_threads, max_threads);
+}
+
+VideoDecoderThreadPolicy::~VideoDecoderThreadPolicy() = default;
+
+void VideoDecoderThreadPolicy::OnFrameDecoded() {
+  if (++frames_decoded_ < kWindowFrames)
+    return;
+
+  frames_decoded_ = 0;
+  frames_dropped_ = 0;
+}
+
+void VideoDecoderThreadPolicy::OnFramesDropped(int count) {
+  DCHECK_GT(count, 0);
+  frames_dropped_ += count;
+  if (frames_dropped_ <= kMaxDroppedFrames || thread_count_ >= max_threads_)
+    return;
+
+  thread_count_ = std::min(std::max(thread_count_ * 2, 2), max_threads_);
+  DVLOG(1) << __func__ << ": decoding with " << thread_count_ << " threads";
+  frames_decoded_ = 0;
+  frames_dropped_ = 0;
+}
+
+}  // namespace media
@@ -0,0 +1,64 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MEDIA_FILTERS_VIDEO_DECODER_THREAD_POLICY_H_
+#define MEDIA_FILTERS_VIDEO_DECODER_THREAD_POLICY_H_
+
+#include <memory>
+
+#include "base/macros.h"
+#include "media/base/media_export.h"
+
+namespace media {
+
+// Decides how many threads a software video decoder uses for a stream.
+//
+// Decoding starts with the decoder's default thread count for the stream, e.g.
+// one per tile column it may have, limited to the number of processors and
+// halved while on battery power. Each time the renderer drops too many frames
+// because they weren't decoded in time, the thread count is doubled, up to the
+// number of processors. The --video-threads switch disables adaptation.
+//
+// The decoder is responsible for applying a new thread_count(); libvpx and
+// libaom only take it when a decoder context is created, so they wait for the
+// next keyframe.
+class MEDIA_EXPORT VideoDecoderThreadPolicy {
+ public:
+  // Frames which may be dropped within |kWindowFrames| decoded frames before
+  // more threads are used.
+  static constexpr int kMaxDroppedFrames = 3;
+  static constexpr int kWindowFrames = 120;
+
+  // Returns the policy for the current process and power state.
+  static std::unique_ptr<VideoDecoderThreadPolicy> Create(int default_threads);
+
+  // Starts at |initial_threads|, which may be zero to let the codec library
+  // choose, and never grows beyond |max_threads|.
+  VideoDecoderThreadPolicy(int initial_threads, int max_threads);
+  ~VideoDecoderThreadPolicy();
+
+  int thread_count() const { return thread_count_; }
+
+  // Called for each frame output by the decoder.
+  void OnFrameDecoded();
+
+  // Called with the number of frames the renderer dropped because they were
+  // decoded too late. Decoders should not report drops while a change to
+  // thread_count() has yet to be applied.
+  void OnFramesDropped(int count);
+
+ private:
+  const int max_threads_;
+  int thread_count_;
+
+  // Frames decoded and dropped in the current window.
+  int frames_decoded_ = 0;
+  int frames_dropped_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(VideoDecoderThreadPolicy);
+};
+
+}  // namespace media
+
+#endif  // MEDIA_FILTERS_VIDEO_DECODER_THREAD_POLICY_H_
@@ -0,0 +1,56 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "media/filters/video_decoder_thread_policy.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace media {
+
+using Policy = VideoDecoderThreadPolicy;
+
+TEST(VideoDecoderThreadPolicyTest, GrowsWhenFramesAreDropped) {
+  Policy policy(2, 8);
+  EXPECT_EQ(2, policy.thread_count());
+
+  policy.OnFramesDropped(Policy::kMaxDroppedFrames);
+  EXPECT_EQ(2, policy.thread_count());
+  policy.OnFramesDropped(1);
+  EXPECT_EQ(4, policy.thread_count());
+
+  // Drops are counted afresh after each change.
+  policy.OnFramesDropped(Policy::kMaxDroppedFrames);
+  EXPECT_EQ(4, policy.thread_count());
+  policy.OnFramesDropped(Policy::kMaxDroppedFrames + 1);
+  EXPECT_EQ(8, policy.thread_count());
+
+  policy.OnFramesDropped(Policy::kMaxDroppedFrames + 1);
+  EXPECT_EQ(8, policy.thread_count());
+}
+
+TEST(VideoDecoderThreadPolicyTest, ForgetsOldDrops) {
+  Policy policy(2, 8);
+  policy.OnFramesDropped(Policy::kMaxDroppedFrames);
+  for (int i = 0; i < Policy::kWindowFrames; ++i)
+    policy.OnFrameDecoded();
+
+  policy.OnFramesDropped(1);
+  EXPECT_EQ(2, policy.thread_count());
+}
+
+TEST(VideoDecoderThreadPolicyTest, GrowsFromLibraryDefault) {
+  Policy policy(0, 3);
+  policy.OnFramesDropped(Policy::kMaxDroppedFrames + 1);
+  EXPECT_EQ(2, policy.thread_count());
+  policy.OnFramesDropped(Policy::kMaxDroppedFrames + 1);
+  EXPECT_EQ(3, policy.thread_count());
+}
+
+TEST(VideoDecoderThreadPolicyTest, FixedThreadCount) {
+  Policy policy(4, 4);
+  policy.OnFramesDropped(Policy::kMaxDroppedFrames + 1);
+  EXPECT_EQ(4, policy.thread_count());
+}
+
+}  // namespace media
@@ -7,6 +7,8 @@
 #include <algorithm>
 #include <limits>
 
+#include "base/metrics/histogram_macros.h"
+#include "base/trace_event/trace_event.h"
 #include "media/base/media_log.h"
 
 namespace media {
@@ -76,7 +78,7 @@ scoped_refptr<VideoFrame> VideoRendererAlgorithm::Render(
   if (!was_time_moving_ || !have_known_duration || render_interval_.is_zero()) {
     ReadyFrame& ready_frame = frame_queue_.front();
     DCHECK(ready_frame.frame);
-    ++ready_frame.render_count;
+    RenderFrontFrame(deadline_min);
     UpdateEffectiveFramesQueued();
 
     // If time stops, we should reset the |first_frame_| marker.
@@ -186,11 +188,16 @@ scoped_refptr<VideoFrame> VideoRendererAlgorithm::Render(
                  << " (" << frame.render_count << ", " << frame.drop_count
                  << ")";
         ++(*frames_dropped);
-        if (!cadence_estimator_.has_cadence() || frame.ideal_render_count)
+        if (!cadence_estimator_.has_cadence() || frame.ideal_render_count) {
           last_render_had_glitch_ = true;
+          ++late_frames_dropped_;
+        }
       }
     }
 
+    for (int i = 0; i < frame_to_render; ++i)
+      RecordFrameJourney(frame_queue_[i], deadline_min);
+
     // Increment the frame counter for all frames removed after the last
     // rendered frame.
     cadence_frame_counter_ += frame_to_render;
@@ -209,7 +216,7 @@ scoped_refptr<VideoFrame> VideoRendererAlgorithm::Render(
   if (first_frame_ && frame_to_render > 0)
     first_frame_ = false;
 
-  ++frame_queue_.front().render_count;
+  RenderFrontFrame(deadline_min);
 
   // Once we reach a glitch in our cadence sequence, reset the base frame number
   // used for defining the cadence sequence; the sequence restarts from the
@@ -267,6 +274,9 @@ size_t VideoRendererAlgorithm::RemoveExpiredFrames(base::TimeTicks deadline) {
     return 0;
   }
 
+  for (size_t i = 0; i < frames_to_expire; ++i)
+    RecordFrameJourney(frame_queue_[i], deadline);
+
   cadence_frame_counter_ += frames_to_expire;
   frame_queue_.erase(frame_queue_.begin(),
                      frame_queue_.begin() + frames_to_expire);
@@ -296,6 +306,7 @@ void VideoRendererAlgorithm::OnLastFrameDropped() {
 void VideoRendererAlgorithm::Reset(ResetFlag reset_flag) {
   out_of_order_frame_logs_ = 0;
   frames_dropped_during_enqueue_ = 0;
+  late_frames_dropped_ = 0;
   have_rendered_frames_ = last_render_had_glitch_ = false;
   render_interval_ = base::TimeDelta();
   frame_queue_.clear();
@@ -314,6 +325,12 @@ void VideoRendererAlgorithm::Reset(ResetFlag reset_flag) {
   max_acceptable_drift_ = base::TimeDelta::FromMilliseconds(15);
 }
 
+size_t VideoRendererAlgorithm::TakeLateFramesDropped() {
+  const size_t late_frames_dropped = late_frames_dropped_;
+  late_frames_dropped_ = 0;
+  return late_frames_dropped;
+}
+
 int64_t VideoRendererAlgorithm::GetMemoryUsage() const {
   int64_t allocation_size = 0;
   for (const auto& ready_frame : frame_queue_) {
@@ -344,6 +361,8 @@ void VideoRendererAlgorithm::EnqueueFrame(
         << ", which is earlier than the last rendered frame ("
         << frame_queue_.front().frame->timestamp() << ").";
     ++frames_dropped_during_enqueue_;
+    RecordFrameJourney(ready_frame, FrameDropReason::kBeforeLastRendered,
+                       base::TimeTicks());
     return;
   }
 
@@ -363,6 +382,8 @@ void VideoRendererAlgorithm::EnqueueFrame(
     DVLOG(2) << "Dropping frame too close to an already enqueued frame: "
              << delta.InMicroseconds() << " us";
     ++frames_dropped_during_enqueue_;
+    RecordFrameJourney(ready_frame, FrameDropReason::kTooCloseToQueuedFrame,
+                       base::TimeTicks());
     return;
   }
 
@@ -766,4 +787,83 @@ size_t VideoRendererAlgorithm::CountEffectiveFramesQueued() const {
   return renderable_frame_count;
 }
 
+void VideoRendererAlgorithm::RenderFrontFrame(base::TimeTicks deadline_min) {
+  ReadyFrame& ready_frame = frame_queue_.front();
+  if (!ready_frame.render_count++)
+    ready_frame.first_render_time = deadline_min;
+}
+
+void VideoRendererAlgorithm::RecordFrameJourney(
+    const ReadyFrame& ready_frame,
+    base::TimeTicks removal_time) const {
+  FrameDropReason drop_reason = FrameDropReason::kNotDropped;
+  if (ready_frame.render_count == ready_frame.drop_count) {
+    if (ready_frame.render_count) {
+      drop_reason = FrameDropReason::kCompositor;
+    } else if (cadence_estimator_.has_cadence() &&
+               !ready_frame.ideal_render_count) {
+      drop_reason = FrameDropReason::kCadence;
+    } else {
+      drop_reason = FrameDropReason::kLate;
+    }
+  }
+  RecordFrameJourney(ready_frame, drop_reason, removal_time);
+}
+
+// static
+void VideoRendererAlgorithm::RecordFrameJourney(const ReadyFrame& ready_frame,
+                                                FrameDropReason drop_reason,
+                                                base::TimeTicks removal_time) {
+  UMA_HISTOGRAM_ENUMERATION("Media.Video.FrameJourney.DropReason",
+                            drop_reason);
+
+  // The remaining stages are only known for frames output by a DecoderStream.
+  const VideoFrame& frame = *ready_frame.frame;
+  base::TimeTicks decode_begin_time;
+  base::TimeTicks decode_end_time;
+  if (!frame.metadata()->GetTimeTicks(VideoFrameMetadata::DECODE_END_TIME,
+                                      &decode_end_time)) {
+    return;
+  }
+  if (frame.metadata()->GetTimeTicks(VideoFrameMetadata::DECODE_BEGIN_TIME,
+                                     &decode_begin_time)) {
+    UMA_HISTOGRAM_TIMES("Media.Video.FrameJourney.DecodeTime",
+                        decode_end_time - decode_begin_time);
+  } else {
+    decode_begin_time = decode_end_time;
+  }
+
+  // Frames wait in the queue until they're first rendered or dropped.
+  const base::TimeTicks dequeue_time = ready_frame.first_render_time.is_null()
+                                           ? removal_time
+                                           : ready_frame.first_render_time;
+  if (!dequeue_time.is_null()) {
+    UMA_HISTOGRAM_TIMES("Media.Video.FrameJourney.QueueWait",
+                        dequeue_time - decode_end_time);
+  }
+
+  // How long before its ideal render time the frame was decoded; negative if
+  // it was decoded too late.
+  base::TimeDelta deadline_slack;
+  if (!ready_frame.start_time.is_null()) {
+    deadline_slack = ready_frame.start_time - decode_end_time;
+    if (deadline_slack >= base::TimeDelta()) {
+      UMA_HISTOGRAM_TIMES("Media.Video.FrameJourney.DeadlineSlack",
+                          deadline_slack);
+    } else {
+      UMA_HISTOGRAM_TIMES("Media.Video.FrameJourney.DeadlineMiss",
+                          -deadline_slack);
+    }
+  }
+
+  TRACE_EVENT_ASYNC_BEGIN_WITH_TIMESTAMP1(
+      "media", "VideoFrameJourney", frame.unique_id(), decode_begin_time,
+      "timestamp (ms)", frame.timestamp().InMilliseconds());
+  TRACE_EVENT_ASYNC_END_WITH_TIMESTAMP2(
+      "media", "VideoFrameJourney", frame.unique_id(),
+      dequeue_time.is_null() ? decode_end_time : dequeue_time, "drop reason",
+      static_cast<int>(drop_reason), "deadline slack (ms)",
+      deadline_slack.InMillisecondsF());
+}
+
 }  // namespace media
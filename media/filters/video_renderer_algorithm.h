@@ -49,6 +49,26 @@ class MediaLog;
 // Combined these three approaches enforce optimal smoothness in many cases.
 class MEDIA_EXPORT VideoRendererAlgorithm {
  public:
+  // Why a frame left |frame_queue_| without being displayed. Each frame's
+  // journey from decode to leaving the queue is traced as a "VideoFrameJourney"
+  // async event and recorded to the Media.Video.FrameJourney.* histograms.
+  // These values are persisted to logs; do not renumber or reuse them.
+  enum class FrameDropReason {
+    kNotDropped = 0,
+    // Not rendered before its display interval passed.
+    kLate = 1,
+    // Skipped to keep the display cadence, e.g. every other frame of 60fps
+    // content on a 30Hz display.
+    kCadence = 2,
+    // Rendered, but the compositor dropped it every time.
+    kCompositor = 3,
+    // Enqueued at or before the last rendered frame.
+    kBeforeLastRendered = 4,
+    // Enqueued less than a millisecond away from a queued frame.
+    kTooCloseToQueuedFrame = 5,
+    kMaxValue = kTooCloseToQueuedFrame,
+  };
+
   VideoRendererAlgorithm(const TimeSource::WallClockTimeCB& wall_clock_time_cb,
                          MediaLog* media_log);
   ~VideoRendererAlgorithm();
@@ -138,6 +158,11 @@ class MEDIA_EXPORT VideoRendererAlgorithm {
 
   size_t frames_queued() const { return frame_queue_.size(); }
 
+  // Returns the number of frames dropped by Render() since the last call which
+  // should have been displayed; i.e., frames which arrived too late, rather
+  // than those dropped because the display rate is lower than the frame rate.
+  size_t TakeLateFramesDropped();
+
   // Returns the average of the duration of all frames in |frame_queue_|
   // as measured in wall clock (not media) time.
   base::TimeDelta average_frame_duration() const {
@@ -194,8 +219,23 @@ class MEDIA_EXPORT VideoRendererAlgorithm {
     int ideal_render_count;
     int render_count;
     int drop_count;
+
+    // The |deadline_min| of the Render() call which first returned the frame.
+    base::TimeTicks first_render_time;
   };
 
+  // Increments the render count of the front of |frame_queue_|, which is being
+  // returned by the Render() call for |deadline_min|.
+  void RenderFrontFrame(base::TimeTicks deadline_min);
+
+  // Records the journey of |ready_frame|, which was removed from (or never
+  // made it into) |frame_queue_| at |removal_time|, if known.
+  void RecordFrameJourney(const ReadyFrame& ready_frame,
+                          base::TimeTicks removal_time) const;
+  static void RecordFrameJourney(const ReadyFrame& ready_frame,
+                                 FrameDropReason drop_reason,
+                                 base::TimeTicks removal_time);
+
   // Updates the render count for the last rendered frame based on the number
   // of missing intervals between Render() calls.
   void AccountForMissedIntervals(base::TimeTicks deadline_min,
@@ -313,6 +353,9 @@ class MEDIA_EXPORT VideoRendererAlgorithm {
   // to the queue.  Callers are told about these frames during Render().
   size_t frames_dropped_during_enqueue_;
 
+  // Tracks frames dropped during Render() for TakeLateFramesDropped().
+  size_t late_frames_dropped_;
+
   // When cadence is present, we don't want to start counting against cadence
   // until the first frame has reached its presentation time.
   bool first_frame_;
@@ -13,6 +13,7 @@
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
 #include "base/strings/stringprintf.h"
+#include "base/test/metrics/histogram_tester.h"
 #include "base/test/simple_test_tick_clock.h"
 #include "build/build_config.h"
 #include "media/base/media_log.h"
@@ -485,6 +486,71 @@ TEST_F(VideoRendererAlgorithmTest, AccountForMissingIntervals) {
   EXPECT_EQ(5, GetCurrentFrameDisplayCount());
 }
 
+TEST_F(VideoRendererAlgorithmTest, TakeLateFramesDropped) {
+  TickGenerator tg(tick_clock_->NowTicks(), 50);
+  time_source_.StartTicking();
+
+  algorithm_.EnqueueFrame(CreateFrame(tg.interval(0)));
+  algorithm_.EnqueueFrame(CreateFrame(tg.interval(1)));
+  algorithm_.EnqueueFrame(CreateFrame(tg.interval(2)));
+  algorithm_.EnqueueFrame(CreateFrame(tg.interval(3)));
+  EXPECT_EQ(0u, algorithm_.TakeLateFramesDropped());
+
+  // Render the third frame; the first two were due in intervals which were
+  // never rendered, so they're dropped as late.
+  tg.step(2);
+  size_t frames_dropped = 0;
+  scoped_refptr<VideoFrame> frame = RenderAndStep(&tg, &frames_dropped);
+  ASSERT_TRUE(frame);
+  EXPECT_EQ(tg.interval(2), frame->timestamp());
+  EXPECT_EQ(2u, frames_dropped);
+  EXPECT_EQ(2u, algorithm_.TakeLateFramesDropped());
+  EXPECT_EQ(0u, algorithm_.TakeLateFramesDropped());
+
+  frame = RenderAndStep(&tg, &frames_dropped);
+  ASSERT_TRUE(frame);
+  EXPECT_EQ(tg.interval(3), frame->timestamp());
+  EXPECT_EQ(0u, frames_dropped);
+  EXPECT_EQ(0u, algorithm_.TakeLateFramesDropped());
+}
+
+TEST_F(VideoRendererAlgorithmTest, RecordsFrameJourney) {
+  using DropReason = VideoRendererAlgorithm::FrameDropReason;
+  base::HistogramTester histogram_tester;
+  TickGenerator tg(tick_clock_->NowTicks(), 50);
+  time_source_.StartTicking();
+
+  algorithm_.EnqueueFrame(CreateFrame(tg.interval(0)));
+  algorithm_.EnqueueFrame(CreateFrame(tg.interval(1)));
+  scoped_refptr<VideoFrame> decoded_frame = CreateFrame(tg.interval(2));
+  decoded_frame->metadata()->SetTimeTicks(VideoFrameMetadata::DECODE_END_TIME,
+                                          tick_clock_->NowTicks());
+  algorithm_.EnqueueFrame(decoded_frame);
+  algorithm_.EnqueueFrame(CreateFrame(tg.interval(3)));
+
+  // The first two frames are dropped as late when the third is rendered.
+  tg.step(2);
+  ASSERT_EQ(decoded_frame, RenderAndStep(&tg, nullptr));
+  histogram_tester.ExpectUniqueSample("Media.Video.FrameJourney.DropReason",
+                                      DropReason::kLate, 2);
+
+  // The third frame's journey is recorded once it's replaced. It was decoded
+  // before its ideal render time.
+  ASSERT_TRUE(RenderAndStep(&tg, nullptr));
+  histogram_tester.ExpectBucketCount("Media.Video.FrameJourney.DropReason",
+                                     DropReason::kNotDropped, 1);
+  histogram_tester.ExpectTotalCount("Media.Video.FrameJourney.DecodeTime", 0);
+  histogram_tester.ExpectTotalCount("Media.Video.FrameJourney.QueueWait", 1);
+  histogram_tester.ExpectTotalCount("Media.Video.FrameJourney.DeadlineSlack",
+                                    1);
+  histogram_tester.ExpectTotalCount("Media.Video.FrameJourney.DeadlineMiss",
+                                    0);
+
+  algorithm_.EnqueueFrame(CreateFrame(tg.interval(1)));
+  histogram_tester.ExpectBucketCount("Media.Video.FrameJourney.DropReason",
+                                     DropReason::kBeforeLastRendered, 1);
+}
+
 TEST_F(VideoRendererAlgorithmTest, OnLastFrameDropped) {
   TickGenerator frame_tg(base::TimeTicks(), 25);
   TickGenerator display_tg(tick_clock_->NowTicks(), 50);
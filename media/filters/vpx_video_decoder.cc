@@ -7,20 +7,17 @@
 #include <stddef.h>
 #include <stdint.h>
 
-#include <algorithm>
 #include <string>
 #include <vector>
 
 #include "base/bind.h"
 #include "base/callback_helpers.h"
-#include "base/command_line.h"
+#include "base/feature_list.h"
 #include "base/location.h"
 #include "base/logging.h"
 #include "base/macros.h"
 #include "base/metrics/histogram_macros.h"
-#include "base/strings/string_number_conversions.h"
 #include "base/sys_byteorder.h"
-#include "base/sys_info.h"
 #include "base/trace_event/trace_event.h"
 #include "media/base/bind_to_current_loop.h"
 #include "media/base/decoder_buffer.h"
@@ -39,48 +36,38 @@ namespace media {
 // not to since current day CPUs tend to be multi-core and we measured
 // performance benefits on older machines such as P4s with hyperthreading.
 static const int kDecodeThreads = 2;
-static const int kMaxDecodeThreads = 32;
 
-// Returns the number of threads.
+// Returns the default number of threads, which VideoDecoderThreadPolicy may
+// adjust.
 static int GetThreadCount(const VideoDecoderConfig& config) {
   // Refer to http://crbug.com/93932 for tsan suppressions on decoding.
   int decode_threads = kDecodeThreads;
 
-  const base::CommandLine* cmd_line = base::CommandLine::ForCurrentProcess();
-  std::string threads(cmd_line->GetSwitchValueASCII(switches::kVideoThreads));
-  if (threads.empty() || !base::StringToInt(threads, &decode_threads)) {
-    if (config.codec() == kCodecVP9) {
-      // For VP9 decode when using the default thread count, increase the number
-      // of decode threads to equal the maximum number of tiles possible for
-      // higher resolution streams.
-      const int width = config.coded_size().width();
-      if (width >= 8192)
-        decode_threads = 32;
-      else if (width >= 4096)
-        decode_threads = 16;
-      else if (width >= 2048)
-        decode_threads = 8;
-      else if (width >= 1024)
-        decode_threads = 4;
-    }
-
-    decode_threads =
-        std::min(decode_threads, base::SysInfo::NumberOfProcessors());
-    return decode_threads;
+  if (config.codec() == kCodecVP9) {
+    // For VP9 decode, increase the number of decode threads to equal the
+    // maximum number of tiles possible for higher resolution streams.
+    const int width = config.coded_size().width();
+    if (width >= 8192)
+      decode_threads = 32;
+    else if (width >= 4096)
+      decode_threads = 16;
+    else if (width >= 2048)
+      decode_threads = 8;
+    else if (width >= 1024)
+      decode_threads = 4;
   }
 
-  decode_threads = std::max(decode_threads, 0);
-  decode_threads = std::min(decode_threads, kMaxDecodeThreads);
   return decode_threads;
 }
 
 static std::unique_ptr<vpx_codec_ctx> InitializeVpxContext(
-    const VideoDecoderConfig& config) {
+    const VideoDecoderConfig& config,
+    int threads) {
   auto context = std::make_unique<vpx_codec_ctx>();
   vpx_codec_dec_cfg_t vpx_config = {0};
   vpx_config.w = config.coded_size().width();
   vpx_config.h = config.coded_size().height();
-  vpx_config.threads = GetThreadCount(config);
+  vpx_config.threads = threads;
 
   vpx_codec_err_t status = vpx_codec_dec_init(
       context.get(),
@@ -142,6 +129,7 @@ void VpxVideoDecoder::Initialize(
   DCHECK(config.IsValidConfig());
 
   CloseDecoder();
+  thread_policy_ = VideoDecoderThreadPolicy::Create(GetThreadCount(config));
 
   InitCB bound_init_cb = bind_callbacks_ ? BindToCurrentLoop(init_cb) : init_cb;
   if (config.is_encrypted() || !ConfigureDecoder(config)) {
@@ -184,6 +172,18 @@ void VpxVideoDecoder::Decode(scoped_refptr<DecoderBuffer> buffer,
     return;
   }
 
+  // libvpx only takes a new thread count when the context is created, so
+  // recreate it at a keyframe, which doesn't reference earlier frames.
+  if (buffer->is_key_frame() &&
+      decode_threads_ != thread_policy_->thread_count()) {
+    CloseDecoder();
+    if (!ConfigureDecoder(config_)) {
+      state_ = kError;
+      bound_decode_cb.Run(DecodeStatus::DECODE_ERROR);
+      return;
+    }
+  }
+
   bool decode_okay;
   scoped_refptr<VideoFrame> video_frame;
   if (config_.codec() == kCodecVP9) {
@@ -202,6 +202,7 @@ void VpxVideoDecoder::Decode(scoped_refptr<DecoderBuffer> buffer,
   // We might get a successful VpxDecode but not a frame if only a partial
   // decode happened.
   if (video_frame) {
+    thread_policy_->OnFrameDecoded();
     video_frame->metadata()->SetBoolean(VideoFrameMetadata::POWER_EFFICIENT,
                                         false);
     // Safe to call |output_cb_| here even if we're on the offload thread since
@@ -226,6 +227,15 @@ void VpxVideoDecoder::Reset(const base::Closure& reset_cb) {
   DETACH_FROM_SEQUENCE(sequence_checker_);
 }
 
+void VpxVideoDecoder::OnFramesDropped(int count) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  // Drops are expected to continue until a pending change in the number of
+  // threads is applied at the next keyframe.
+  if (thread_policy_ && decode_threads_ == thread_policy_->thread_count())
+    thread_policy_->OnFramesDropped(count);
+}
+
 bool VpxVideoDecoder::ConfigureDecoder(const VideoDecoderConfig& config) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   if (config.codec() != kCodecVP8 && config.codec() != kCodecVP9)
@@ -247,7 +257,8 @@ bool VpxVideoDecoder::ConfigureDecoder(const VideoDecoderConfig& config) {
 #endif
 
   DCHECK(!vpx_codec_);
-  vpx_codec_ = InitializeVpxContext(config);
+  decode_threads_ = thread_policy_->thread_count();
+  vpx_codec_ = InitializeVpxContext(config, decode_threads_);
   if (!vpx_codec_)
     return false;
 
@@ -259,7 +270,8 @@ bool VpxVideoDecoder::ConfigureDecoder(const VideoDecoderConfig& config) {
            VPX_CODEC_CAP_EXTERNAL_FRAME_BUFFER);
 
     DCHECK(!memory_pool_);
-    memory_pool_ = new FrameBufferPool();
+    memory_pool_ = new FrameBufferPool(
+        base::FeatureList::IsEnabled(kSharedMemoryVideoFrameBuffers));
 
     if (vpx_codec_set_frame_buffer_functions(
             vpx_codec_.get(), &GetVP9FrameBuffer, &ReleaseVP9FrameBuffer,
@@ -274,7 +286,7 @@ bool VpxVideoDecoder::ConfigureDecoder(const VideoDecoderConfig& config) {
     return true;
 
   DCHECK(!vpx_codec_alpha_);
-  vpx_codec_alpha_ = InitializeVpxContext(config);
+  vpx_codec_alpha_ = InitializeVpxContext(config, decode_threads_);
   return !!vpx_codec_alpha_;
 }
 
@@ -588,6 +600,12 @@ bool VpxVideoDecoder::CopyVpxImageToVideoFrame(
           vpx_image->stride[VPX_PLANE_U], vpx_image->stride[VPX_PLANE_V],
           vpx_image->planes[VPX_PLANE_Y], vpx_image->planes[VPX_PLANE_U],
           vpx_image->planes[VPX_PLANE_V], kNoTimestamp);
+      // The alpha plane above is not part of the frame buffer, so only frames
+      // without one may be handed out as shared memory.
+      if (*video_frame) {
+        memory_pool_->AddSharedMemoryToFrame(vpx_image->fb_priv,
+                                             video_frame->get());
+      }
     }
     if (!(*video_frame))
       return false;
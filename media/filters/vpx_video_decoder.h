@@ -13,6 +13,7 @@
 #include "media/base/video_frame.h"
 #include "media/base/video_frame_pool.h"
 #include "media/filters/offloading_video_decoder.h"
+#include "media/filters/video_decoder_thread_policy.h"
 
 struct vpx_codec_ctx;
 struct vpx_image;
@@ -53,6 +54,7 @@ class MEDIA_EXPORT VpxVideoDecoder : public OffloadableVideoDecoder {
   void Decode(scoped_refptr<DecoderBuffer> buffer,
               const DecodeCB& decode_cb) override;
   void Reset(const base::Closure& reset_cb) override;
+  void OnFramesDropped(int count) override;
 
   // OffloadableVideoDecoder implementation.
   void Detach() override;
@@ -108,6 +110,11 @@ class MEDIA_EXPORT VpxVideoDecoder : public OffloadableVideoDecoder {
 
   VideoDecoderConfig config_;
 
+  // Chooses the number of threads for |vpx_codec_| and |vpx_codec_alpha_|;
+  // |decode_threads_| is the number they were created with.
+  std::unique_ptr<VideoDecoderThreadPolicy> thread_policy_;
+  int decode_threads_ = 0;
+
   std::unique_ptr<vpx_codec_ctx> vpx_codec_;
   std::unique_ptr<vpx_codec_ctx> vpx_codec_alpha_;
 
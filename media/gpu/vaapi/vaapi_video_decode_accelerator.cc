@@ -11,6 +11,7 @@
 #include <va/va.h>
 
 #include "base/bind.h"
+#include "base/feature_list.h"
 #include "base/files/scoped_file.h"
 #include "base/logging.h"
 #include "base/macros.h"
@@ -22,6 +23,7 @@
 #include "base/trace_event/trace_event.h"
 #include "gpu/ipc/service/gpu_channel.h"
 #include "media/base/bind_to_current_loop.h"
+#include "media/base/media_switches.h"
 #include "media/base/unaligned_shared_memory.h"
 #include "media/gpu/accelerated_video_decoder.h"
 #include "media/gpu/format_utils.h"
@@ -43,6 +45,16 @@ namespace media {
 
 namespace {
 
+// Number of pictures allocated in pipelined decode mode beyond those the
+// decoder requires, so that several decodes can be in flight in the hardware
+// while earlier pictures wait to be output.
+constexpr size_t kNumExtraPicturesForPipelinedDecode = 4;
+
+// How often to check whether the hardware has finished decoding the oldest
+// surface waiting for output in pipelined decode mode.
+constexpr base::TimeDelta kDecodedSurfacesPollInterval =
+    base::TimeDelta::FromMilliseconds(2);
+
 // UMA errors that the VaapiVideoDecodeAccelerator class reports.
 enum VAVDADecoderFailure {
   VAAPI_ERROR = 0,
@@ -150,6 +162,7 @@ VaapiVideoDecodeAccelerator::VaapiVideoDecodeAccelerator(
       decoder_thread_("VaapiDecoderThread"),
       num_frames_at_client_(0),
       finish_flush_pending_(false),
+      pipelined_decode_(base::FeatureList::IsEnabled(kVaapiPipelinedDecode)),
       awaiting_va_surfaces_recycle_(false),
       requested_num_pics_(0),
       profile_(VIDEO_CODEC_PROFILE_UNKNOWN),
@@ -267,8 +280,37 @@ void VaapiVideoDecodeAccelerator::TryOutputSurface() {
 
   output_cb.Run(picture);
 
-  if (finish_flush_pending_ && pending_output_cbs_.empty())
+  if (finish_flush_pending_ && pending_output_cbs_.empty() &&
+      decoding_surfaces_.empty()) {
     FinishFlush();
+  }
+}
+
+void VaapiVideoDecodeAccelerator::QueueDecodedSurfaces() {
+  DCHECK(task_runner_->BelongsToCurrentThread());
+
+  // Surfaces are output in order, so stop at the first one still decoding.
+  while (!decoding_surfaces_.empty()) {
+    bool is_ready = false;
+    RETURN_AND_NOTIFY_ON_FAILURE(
+        vaapi_wrapper_->IsSurfaceReady(decoding_surfaces_.front().first->id(),
+                                       &is_ready),
+        "Failed querying surface status", PLATFORM_FAILURE, );
+    if (!is_ready)
+      break;
+
+    pending_output_cbs_.push(decoding_surfaces_.front().second);
+    decoding_surfaces_.pop();
+  }
+
+  if (!decoding_surfaces_.empty()) {
+    decoded_surfaces_poll_timer_.Start(
+        FROM_HERE, kDecodedSurfacesPollInterval,
+        base::Bind(&VaapiVideoDecodeAccelerator::QueueDecodedSurfaces,
+                   base::Unretained(this)));
+  }
+
+  TryOutputSurface();
 }
 
 void VaapiVideoDecodeAccelerator::QueueInputBuffer(
@@ -418,15 +460,18 @@ void VaapiVideoDecodeAccelerator::DecodeTask() {
     }
 
     switch (res) {
-      case AcceleratedVideoDecoder::kAllocateNewSurfaces:
+      case AcceleratedVideoDecoder::kAllocateNewSurfaces: {
         VLOGF(2) << "Decoder requesting a new set of surfaces";
+        size_t num_pics = decoder_->GetRequiredNumOfPictures();
+        if (pipelined_decode_)
+          num_pics += kNumExtraPicturesForPipelinedDecode;
         task_runner_->PostTask(
             FROM_HERE,
             base::Bind(&VaapiVideoDecodeAccelerator::InitiateSurfaceSetChange,
-                       weak_this_, decoder_->GetRequiredNumOfPictures(),
-                       decoder_->GetPicSize()));
+                       weak_this_, num_pics, decoder_->GetPicSize()));
         // We'll get rescheduled once ProvidePictureBuffers() finishes.
         return;
+      }
 
       case AcceleratedVideoDecoder::kRanOutOfStreamData:
         ReturnCurrInputBuffer_Locked();
@@ -487,7 +532,7 @@ void VaapiVideoDecodeAccelerator::TryFinishSurfaceSetChange() {
   if (!awaiting_va_surfaces_recycle_)
     return;
 
-  if (!pending_output_cbs_.empty() ||
+  if (!pending_output_cbs_.empty() || !decoding_surfaces_.empty() ||
       pictures_.size() != available_va_surfaces_.size()) {
     // Either:
     // 1. Not all pending pending output callbacks have been executed yet.
@@ -735,9 +780,9 @@ void VaapiVideoDecodeAccelerator::FinishFlush() {
     return;
   }
 
-  // Still waiting for textures from client to finish outputting all pending
-  // frames. Try again later.
-  if (!pending_output_cbs_.empty()) {
+  // Still waiting for the hardware or for textures from client to finish
+  // outputting all pending frames. Try again later.
+  if (!pending_output_cbs_.empty() || !decoding_surfaces_.empty()) {
     finish_flush_pending_ = true;
     return;
   }
@@ -811,6 +856,9 @@ void VaapiVideoDecodeAccelerator::FinishReset() {
   // Drop pending outputs.
   while (!pending_output_cbs_.empty())
     pending_output_cbs_.pop();
+  while (!decoding_surfaces_.empty())
+    decoding_surfaces_.pop();
+  decoded_surfaces_poll_timer_.Stop();
 
   if (awaiting_va_surfaces_recycle_) {
     // Decoder requested a new surface set while we were waiting for it to
@@ -912,10 +960,19 @@ void VaapiVideoDecodeAccelerator::VASurfaceReady(
       return;
   }
 
-  pending_output_cbs_.push(
+  OutputCB output_cb =
       base::Bind(&VaapiVideoDecodeAccelerator::OutputPicture, weak_this_,
-                 va_surface, bitstream_id, visible_rect));
+                 va_surface, bitstream_id, visible_rect);
+
+  if (pipelined_decode_) {
+    decoding_surfaces_.push(std::make_pair(va_surface, output_cb));
+    // Otherwise the front surface is still decoding and a poll is pending.
+    if (!decoded_surfaces_poll_timer_.IsRunning())
+      QueueDecodedSurfaces();
+    return;
+  }
 
+  pending_output_cbs_.push(output_cb);
   TryOutputSurface();
 }
 
@@ -25,6 +25,7 @@
 #include "base/synchronization/condition_variable.h"
 #include "base/synchronization/lock.h"
 #include "base/threading/thread.h"
+#include "base/timer/timer.h"
 #include "media/base/bitstream_buffer.h"
 #include "media/gpu/gpu_video_decode_accelerator_helpers.h"
 #include "media/gpu/media_gpu_export.h"
@@ -176,6 +177,11 @@ class MEDIA_GPU_EXPORT VaapiVideoDecodeAccelerator
   // Try to OutputPicture() if we have both a ready surface and picture.
   void TryOutputSurface();
 
+  // In pipelined decode mode, moves the surfaces at the front of
+  // |decoding_surfaces_| which the hardware has finished decoding on to
+  // |pending_output_cbs_|, and polls again later for the rest.
+  void QueueDecodedSurfaces();
+
   // Called when a VASurface is no longer in use by the decoder or is not being
   // synced/waiting to be synced to a picture. Returns it to available surfaces
   // pool.
@@ -254,6 +260,16 @@ class MEDIA_GPU_EXPORT VaapiVideoDecodeAccelerator
   using OutputCB = base::Callback<void(VaapiPicture*)>;
   base::queue<OutputCB> pending_output_cbs_;
 
+  // In pipelined decode mode, surfaces the decoder asked us to output which
+  // the hardware may still be decoding, in output order, along with their
+  // OutputCBs. They're only queued on |pending_output_cbs_| once decoded, so
+  // that OutputPicture() doesn't wait for the hardware while holding the
+  // VA-API lock, which would keep the decoder thread from submitting the next
+  // decodes in the meantime.
+  base::queue<std::pair<scoped_refptr<VASurface>, OutputCB>>
+      decoding_surfaces_;
+  base::OneShotTimer decoded_surfaces_poll_timer_;
+
   // ChildThread's task runner.
   scoped_refptr<base::SingleThreadTaskRunner> task_runner_;
 
@@ -285,6 +301,10 @@ class MEDIA_GPU_EXPORT VaapiVideoDecodeAccelerator
   // NotifyingFlushDone.
   bool finish_flush_pending_;
 
+  // Whether several decodes may be in flight in the hardware at once. This
+  // allocates extra pictures, and uses |decoding_surfaces_|.
+  bool pipelined_decode_;
+
   // Decoder requested a new surface set and we are waiting for all the surfaces
   // to be returned before we can free them.
   bool awaiting_va_surfaces_recycle_;
@@ -20,6 +20,7 @@ using ::testing::_;
 using ::testing::DoAll;
 using ::testing::Invoke;
 using ::testing::Return;
+using ::testing::SetArgPointee;
 using ::testing::TestWithParam;
 using ::testing::ValuesIn;
 using ::testing::WithArg;
@@ -67,6 +68,7 @@ class MockVaapiWrapper : public VaapiWrapper {
       CreateSurfaces,
       bool(unsigned int, const gfx::Size&, size_t, std::vector<VASurfaceID>*));
   MOCK_METHOD0(DestroySurfaces, void());
+  MOCK_METHOD2(IsSurfaceReady, bool(VASurfaceID, bool*));
 
  private:
   ~MockVaapiWrapper() override = default;
@@ -175,6 +177,30 @@ class VaapiVideoDecodeAcceleratorTest : public TestWithParam<VideoCodecProfile>,
     vda_.AssignPictureBuffers(picture_buffers);
   }
 
+  void EnablePipelinedDecode() { vda_.pipelined_decode_ = true; }
+
+  // Pretends |mock_decoder_| asked for the surface with |va_surface_id| to be
+  // output.
+  void SurfaceReady(VASurfaceID va_surface_id, int32_t bitstream_id) {
+    auto va_surface = base::MakeRefCounted<VASurface>(
+        va_surface_id, kPictureSize, VA_RT_FORMAT_YUV420,
+        base::Bind([](VASurfaceID) {}));
+    vda_.VASurfaceReady(va_surface, bitstream_id, gfx::Rect(kPictureSize));
+  }
+
+  // Runs the poll for decoded surfaces without waiting for it, if it's pending.
+  bool PollDecodedSurfaces() {
+    if (!vda_.decoded_surfaces_poll_timer_.IsRunning())
+      return false;
+    vda_.decoded_surfaces_poll_timer_.Stop();
+    vda_.QueueDecodedSurfaces();
+    return true;
+  }
+
+  size_t GetNumPendingOutputs() const {
+    return vda_.pending_output_cbs_.size();
+  }
+
   // Reset epilogue, needed to get |vda_| worker thread out of its Wait().
   void ResetSequence() {
     base::RunLoop run_loop;
@@ -412,6 +438,34 @@ TEST_P(VaapiVideoDecodeAcceleratorTest,
   ResetSequence();
 }
 
+// Verifies that in pipelined decode mode surfaces are only queued for output
+// once the hardware has decoded them, and still in the order they're given.
+TEST_P(VaapiVideoDecodeAcceleratorTest, PipelinedDecodeWaitsForSurfaces) {
+  EnablePipelinedDecode();
+
+  const VASurfaceID kFirstSurface = 1;
+  const VASurfaceID kSecondSurface = 2;
+  EXPECT_CALL(*mock_vaapi_wrapper_, IsSurfaceReady(kFirstSurface, _))
+      .WillOnce(DoAll(SetArgPointee<1>(false), Return(true)))
+      .WillOnce(DoAll(SetArgPointee<1>(true), Return(true)));
+  EXPECT_CALL(*mock_vaapi_wrapper_, IsSurfaceReady(kSecondSurface, _))
+      .WillOnce(DoAll(SetArgPointee<1>(false), Return(true)))
+      .WillOnce(DoAll(SetArgPointee<1>(true), Return(true)));
+
+  SurfaceReady(kFirstSurface, kBitstreamId);
+  SurfaceReady(kSecondSurface, kBitstreamId + 1);
+  EXPECT_EQ(0u, GetNumPendingOutputs());
+
+  ASSERT_TRUE(PollDecodedSurfaces());
+  EXPECT_EQ(1u, GetNumPendingOutputs());
+
+  ASSERT_TRUE(PollDecodedSurfaces());
+  EXPECT_EQ(2u, GetNumPendingOutputs());
+  EXPECT_FALSE(PollDecodedSurfaces());
+
+  ResetSequence();
+}
+
 INSTANTIATE_TEST_CASE_P(/* No prefix. */,
                         VaapiVideoDecodeAcceleratorTest,
                         ValuesIn(kCodecProfiles));
@@ -1004,6 +1004,17 @@ bool VaapiWrapper::ExecuteAndDestroyPendingBuffers(VASurfaceID va_surface_id) {
   return result;
 }
 
+bool VaapiWrapper::IsSurfaceReady(VASurfaceID va_surface_id, bool* is_ready) {
+  base::AutoLock auto_lock(*va_lock_);
+
+  VASurfaceStatus status;
+  VAStatus va_res = vaQuerySurfaceStatus(va_display_, va_surface_id, &status);
+  VA_SUCCESS_OR_RETURN(va_res, "Failed querying surface status", false);
+
+  *is_ready = !(status & VASurfaceRendering);
+  return true;
+}
+
 #if defined(USE_X11)
 bool VaapiWrapper::PutSurfaceIntoPixmap(VASurfaceID va_surface_id,
                                         Pixmap x_pixmap,
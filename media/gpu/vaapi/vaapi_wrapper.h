@@ -144,6 +144,10 @@ class MEDIA_GPU_EXPORT VaapiWrapper
   // buffers. Return false if Execute() fails.
   bool ExecuteAndDestroyPendingBuffers(VASurfaceID va_surface_id);
 
+  // Sets |is_ready| to whether the HW codec has finished all jobs executed on
+  // |va_surface_id|, without waiting for them. Returns false on failure.
+  virtual bool IsSurfaceReady(VASurfaceID va_surface_id, bool* is_ready);
+
 #if defined(USE_X11)
   // Put data from |va_surface_id| into |x_pixmap| of size
   // |dest_size|, converting/scaling to it.
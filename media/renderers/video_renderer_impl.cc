@@ -123,6 +123,7 @@ VideoRendererImpl::VideoRendererImpl(
       pending_read_(false),
       drop_frames_(drop_frames),
       buffering_state_(BUFFERING_HAVE_NOTHING),
+      late_frames_dropped_(0),
       tick_clock_(base::DefaultTickClock::GetInstance()),
       was_background_rendering_(false),
       time_progressing_(false),
@@ -185,6 +186,7 @@ void VideoRendererImpl::Flush(const base::Closure& callback) {
   // they may use to output more frames that won't be used.
   algorithm_->Reset();
   painted_first_frame_ = false;
+  late_frames_dropped_ = 0;
 
   // Reset preroll capacity so seek time is not penalized.
   min_buffered_frames_ = limits::kMaxVideoFrames;
@@ -272,6 +274,7 @@ scoped_refptr<VideoFrame> VideoRendererImpl::Render(
   size_t frames_dropped = 0;
   scoped_refptr<VideoFrame> result =
       algorithm_->Render(deadline_min, deadline_max, &frames_dropped);
+  const size_t late_frames_dropped = algorithm_->TakeLateFramesDropped();
 
   // Due to how the |algorithm_| holds frames, this should never be null if
   // we've had a proper startup sequence.
@@ -298,8 +301,10 @@ scoped_refptr<VideoFrame> VideoRendererImpl::Render(
   //
   // Just after resuming from background rendering, we also don't count the
   // dropped frames since they are likely just dropped due to being too old.
-  if (!background_rendering && !was_background_rendering_)
+  if (!background_rendering && !was_background_rendering_) {
     stats_.video_frames_dropped += frames_dropped;
+    late_frames_dropped_ += late_frames_dropped;
+  }
   was_background_rendering_ = background_rendering;
 
   // Always post this task, it will acquire new frames if necessary and since it
@@ -661,6 +666,12 @@ void VideoRendererImpl::UpdateStats_Locked() {
   DCHECK(task_runner_->BelongsToCurrentThread());
   lock_.AssertAcquired();
 
+  // Let the decoder know that it isn't keeping up, so that it can try to.
+  if (late_frames_dropped_) {
+    video_frame_stream_->OnFramesDropped(late_frames_dropped_);
+    late_frames_dropped_ = 0;
+  }
+
   // No need to check for `stats_.video_frames_decoded_power_efficient` because
   // if it is greater than 0, `stats_.video_frames_decoded` will too.
   if (!stats_.video_frames_decoded && !stats_.video_frames_dropped)
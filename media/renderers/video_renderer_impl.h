@@ -263,6 +263,11 @@ class MEDIA_EXPORT VideoRendererImpl
   // last call to |statistics_cb_|. These must be accessed under lock.
   PipelineStatistics stats_;
 
+  // Frames dropped by |algorithm_| because they were decoded too late, which
+  // haven't been reported to |video_frame_stream_| yet. Must be accessed under
+  // lock.
+  size_t late_frames_dropped_;
+
   const base::TickClock* tick_clock_;
 
   // Algorithm for selecting which frame to render; manages frames and all
@@ -21,11 +21,14 @@
 #include "base/containers/stack_container.h"
 #include "base/location.h"
 #include "base/macros.h"
+#include "base/memory/shared_memory.h"
+#include "base/numerics/safe_conversions.h"
 #include "base/strings/stringprintf.h"
 #include "base/time/default_tick_clock.h"
 #include "base/trace_event/memory_dump_manager.h"
 #include "base/trace_event/memory_dump_provider.h"
 #include "base/trace_event/trace_event.h"
+#include "base/unguessable_token.h"
 #include "gpu/GLES2/gl2extchromium.h"
 #include "gpu/command_buffer/client/gles2_interface.h"
 #include "media/base/bind_to_current_loop.h"
@@ -111,13 +114,26 @@ class GpuMemoryBufferVideoFramePool::PoolImpl
     void MarkUnused(base::TimeTicks last_use_time) {
       is_used_ = false;
       last_use_time_ = last_use_time;
+      source_frame = nullptr;
     }
     bool is_used() const { return is_used_; }
     base::TimeTicks last_use_time() const { return last_use_time_; }
+    bool is_imported() const { return !shared_memory_guid.is_empty(); }
 
     const gfx::Size size;
     PlaneResource plane_resources[VideoFrame::kMaxPlanes];
 
+    // Set if the GpuMemoryBuffers wrap the shared memory of software frames
+    // instead of being copied into, see GetOrImportFrameResources(). Frames
+    // are imported into the same resources whenever the planes are found at
+    // the same |plane_offsets| and |plane_strides| within that memory.
+    base::UnguessableToken shared_memory_guid;
+    uint32_t plane_offsets[VideoFrame::kMaxPlanes] = {};
+    int32_t plane_strides[VideoFrame::kMaxPlanes] = {};
+
+    // The imported frame, kept alive while the GPU may read from its memory.
+    scoped_refptr<VideoFrame> source_frame;
+
    private:
     bool is_used_ = true;
     base::TimeTicks last_use_time_;
@@ -162,7 +178,7 @@ class GpuMemoryBufferVideoFramePool::PoolImpl
   // specific |format| and |size|.
   static bool AreFrameResourcesCompatible(const FrameResources* resources,
                                           const gfx::Size& size) {
-    return size == resources->size;
+    return size == resources->size && !resources->is_imported();
   }
 
   // Get the resources needed for a frame out of the pool, or create them if
@@ -172,6 +188,13 @@ class GpuMemoryBufferVideoFramePool::PoolImpl
       const gfx::Size& size,
       GpuVideoAcceleratorFactories::OutputFormat format);
 
+  // Returns resources whose GpuMemoryBuffers refer directly to the shared
+  // memory backing |video_frame|, reusing ones that were created for an
+  // earlier frame in the same memory if possible. Returns nullptr if
+  // |video_frame| can't be imported.
+  FrameResources* GetOrImportFrameResources(
+      const scoped_refptr<VideoFrame>& video_frame);
+
   // Calls the FrameReadyCB of the first entry in |frame_copy_requests_|, with
   // the provided |video_frame|, then deletes the entry from
   // |frame_copy_requests_| and attempts to start another copy if there are
@@ -538,6 +561,32 @@ gfx::Size CodedSize(const scoped_refptr<VideoFrame>& video_frame,
   DCHECK(gfx::Rect(video_frame->coded_size()).Contains(gfx::Rect(output)));
   return output;
 }
+
+// Returns true if |video_frame| is backed by shared memory that the GPU can
+// read its planes from directly, see GetOrImportFrameResources().
+bool CanImportSharedMemory(
+    const scoped_refptr<VideoFrame>& video_frame,
+    GpuVideoAcceleratorFactories::OutputFormat output_format) {
+  return output_format == GpuVideoAcceleratorFactories::OutputFormat::I420 &&
+         video_frame->format() == PIXEL_FORMAT_I420 &&
+         video_frame->storage_type() == VideoFrame::STORAGE_SHMEM &&
+         video_frame->shared_memory_handle().IsValid();
+}
+
+// Creates a texture to bind a plane's image to and a mailbox referring to it.
+void CreateTextureAndMailbox(gpu::gles2::GLES2Interface* gles2,
+                             unsigned texture_target,
+                             unsigned* texture_id,
+                             gpu::Mailbox* mailbox) {
+  gles2->GenTextures(1, texture_id);
+  gles2->BindTexture(texture_target, *texture_id);
+  gles2->TexParameteri(texture_target, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  gles2->TexParameteri(texture_target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  gles2->TexParameteri(texture_target, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  gles2->TexParameteri(texture_target, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  gles2->GenMailboxCHROMIUM(mailbox->name);
+  gles2->ProduceTextureDirectCHROMIUM(*texture_id, mailbox->name);
+}
 }  // unnamed namespace
 
 // Creates a VideoFrame backed by native textures starting from a software
@@ -687,6 +736,20 @@ void GpuMemoryBufferVideoFramePool::PoolImpl::StartCopy() {
 
   while (!frame_copy_requests_.empty()) {
     VideoFrameCopyRequest& request = frame_copy_requests_.front();
+
+    // Frames in shared memory that the GPU can read from directly don't need
+    // to be copied, which completes the request right away.
+    if (!request.passthrough &&
+        CanImportSharedMemory(request.video_frame, output_format_)) {
+      FrameResources* frame_resources =
+          GetOrImportFrameResources(request.video_frame);
+      if (frame_resources) {
+        BindAndCreateMailboxesHardwareFrameResources(request.video_frame,
+                                                     frame_resources);
+        return;
+      }
+    }
+
     // Acquire resources. Incompatible ones will be dropped from the pool.
     FrameResources* frame_resources =
         request.passthrough
@@ -1001,20 +1064,110 @@ GpuMemoryBufferVideoFramePool::PoolImpl::GetOrCreateFrameResources(
         plane_resource.size, buffer_format,
         gfx::BufferUsage::SCANOUT_CPU_READ_WRITE);
 
-    unsigned texture_target = gpu_factories_->ImageTextureTarget(buffer_format);
-    gles2->GenTextures(1, &plane_resource.texture_id);
-    gles2->BindTexture(texture_target, plane_resource.texture_id);
-    gles2->TexParameteri(texture_target, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    gles2->TexParameteri(texture_target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    gles2->TexParameteri(texture_target, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    gles2->TexParameteri(texture_target, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    gles2->GenMailboxCHROMIUM(plane_resource.mailbox.name);
-    gles2->ProduceTextureDirectCHROMIUM(plane_resource.texture_id,
-                                        plane_resource.mailbox.name);
+    CreateTextureAndMailbox(gles2,
+                            gpu_factories_->ImageTextureTarget(buffer_format),
+                            &plane_resource.texture_id,
+                            &plane_resource.mailbox);
   }
   return frame_resources;
 }
 
+GpuMemoryBufferVideoFramePool::PoolImpl::FrameResources*
+GpuMemoryBufferVideoFramePool::PoolImpl::GetOrImportFrameResources(
+    const scoped_refptr<VideoFrame>& video_frame) {
+  DCHECK(media_task_runner_->BelongsToCurrentThread());
+  DCHECK(CanImportSharedMemory(video_frame, output_format_));
+
+  // Find the visible part of each plane within the shared memory.
+  const size_t num_planes = NumGpuMemoryBuffers(output_format_);
+  const uint8_t* data = video_frame->data(VideoFrame::kYPlane);
+  uint32_t plane_offsets[VideoFrame::kMaxPlanes] = {};
+  int32_t plane_strides[VideoFrame::kMaxPlanes] = {};
+  for (size_t i = 0; i < num_planes; ++i) {
+    const uint8_t* plane_data = video_frame->visible_data(i);
+    if (plane_data < data)
+      return nullptr;
+    const size_t offset =
+        video_frame->shared_memory_offset() + (plane_data - data);
+    // Rows of shared memory images must be 4-byte aligned.
+    if (!base::IsValueInRangeForNumericType<uint32_t>(offset) ||
+        video_frame->stride(i) % 4) {
+      return nullptr;
+    }
+    plane_offsets[i] = offset;
+    plane_strides[i] = video_frame->stride(i);
+  }
+
+  const gfx::Size size = CodedSize(video_frame, output_format_);
+  const base::SharedMemoryHandle handle = video_frame->shared_memory_handle();
+  const base::UnguessableToken guid = handle.GetGUID();
+  if (guid.is_empty())
+    return nullptr;
+
+  // Decoders cycle through a small set of buffers, so resources imported for
+  // one of them are likely to be reused for a later frame.
+  for (FrameResources* frame_resources : resources_pool_) {
+    if (frame_resources->is_used() ||
+        frame_resources->shared_memory_guid != guid ||
+        frame_resources->size != size ||
+        !std::equal(plane_offsets, plane_offsets + num_planes,
+                    frame_resources->plane_offsets) ||
+        !std::equal(plane_strides, plane_strides + num_planes,
+                    frame_resources->plane_strides)) {
+      continue;
+    }
+    frame_resources->MarkUsed();
+    frame_resources->source_frame = video_frame;
+    return frame_resources;
+  }
+
+  gpu::gles2::GLES2Interface* gles2 = gpu_factories_->ContextGL();
+  if (!gles2)
+    return nullptr;
+
+  auto frame_resources = std::make_unique<FrameResources>(size);
+  for (size_t i = 0; i < num_planes; ++i) {
+    PlaneResource& plane_resource = frame_resources->plane_resources[i];
+    plane_resource.size = gfx::Size(
+        VideoFrame::Columns(i, VideoFormat(output_format_), size.width()),
+        VideoFrame::Rows(i, VideoFormat(output_format_), size.height()));
+
+    gfx::GpuMemoryBufferHandle buffer_handle;
+    buffer_handle.type = gfx::SHARED_MEMORY_BUFFER;
+    buffer_handle.handle = base::SharedMemory::DuplicateHandle(handle);
+    buffer_handle.offset = plane_offsets[i];
+    buffer_handle.stride = plane_strides[i];
+    if (!buffer_handle.handle.IsValid())
+      return nullptr;
+    plane_resource.gpu_memory_buffer =
+        gpu_factories_->CreateGpuMemoryBufferFromHandle(
+            buffer_handle, plane_resource.size,
+            GpuMemoryBufferFormat(output_format_, i));
+    if (!plane_resource.gpu_memory_buffer)
+      return nullptr;
+    plane_resource.gpu_memory_buffer->SetColorSpace(video_frame->ColorSpace());
+  }
+
+  gles2->ActiveTexture(GL_TEXTURE0);
+  for (size_t i = 0; i < num_planes; ++i) {
+    PlaneResource& plane_resource = frame_resources->plane_resources[i];
+    CreateTextureAndMailbox(gles2,
+                            gpu_factories_->ImageTextureTarget(
+                                GpuMemoryBufferFormat(output_format_, i)),
+                            &plane_resource.texture_id,
+                            &plane_resource.mailbox);
+  }
+
+  frame_resources->shared_memory_guid = guid;
+  std::copy(plane_offsets, plane_offsets + num_planes,
+            frame_resources->plane_offsets);
+  std::copy(plane_strides, plane_strides + num_planes,
+            frame_resources->plane_strides);
+  frame_resources->source_frame = video_frame;
+  resources_pool_.push_back(frame_resources.get());
+  return frame_resources.release();
+}
+
 void GpuMemoryBufferVideoFramePool::PoolImpl::
     CompleteCopyRequestAndMaybeStartNextCopy(
         const scoped_refptr<VideoFrame>& video_frame) {
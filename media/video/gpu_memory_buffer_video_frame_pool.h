@@ -49,7 +49,9 @@ class MEDIA_EXPORT GpuMemoryBufferVideoFramePool {
   // mailboxes to native resources. |cb| will be destroyed on
   // |media_worker_pool|.
   // The content of the new object is copied from the software-allocated
-  // |video_frame|.
+  // |video_frame|, unless |video_frame| is an I420 frame in shared memory
+  // (e.g. one decoded into a shared memory FrameBufferPool), in which case the
+  // new object refers to that memory and keeps |video_frame| alive.
   // If it's not possible to create a new hardware VideoFrame, |video_frame|
   // itself will passed to |cb|.
   virtual void MaybeCreateHardwareFrame(
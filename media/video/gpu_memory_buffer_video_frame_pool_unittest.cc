@@ -6,6 +6,7 @@
 #include <memory>
 
 #include "base/bind.h"
+#include "base/memory/shared_memory.h"
 #include "base/test/simple_test_tick_clock.h"
 #include "base/test/test_simple_task_runner.h"
 #include "base/threading/thread_task_runner_handle.h"
@@ -128,6 +129,27 @@ class GpuMemoryBufferVideoFramePoolTest : public ::testing::Test {
     return video_frame;
   }
 
+  // Creates an I420 frame whose planes follow each other in |shared_memory|,
+  // starting at |offset|.
+  static scoped_refptr<VideoFrame> CreateTestSharedMemoryVideoFrame(
+      base::SharedMemory* shared_memory,
+      size_t offset) {
+    const gfx::Size size(16, 16);
+    const size_t y_size = size.GetArea();
+    const size_t uv_size = y_size / 4;
+    if (!shared_memory->CreateAndMapAnonymous(offset + y_size + 2 * uv_size))
+      return nullptr;
+
+    uint8_t* y_data = static_cast<uint8_t*>(shared_memory->memory()) + offset;
+    scoped_refptr<VideoFrame> video_frame = VideoFrame::WrapExternalYuvData(
+        PIXEL_FORMAT_I420, size, gfx::Rect(size), size, size.width(),
+        size.width() / 2, size.width() / 2, y_data, y_data + y_size,
+        y_data + y_size + uv_size, base::TimeDelta());
+    EXPECT_TRUE(video_frame);
+    video_frame->AddSharedMemoryHandle(shared_memory->handle(), offset);
+    return video_frame;
+  }
+
   // Note, the X portion is set to 1 since it may use ARGB instead of
   // XRGB on some platforms.
   uint32_t as_xr30(uint32_t r, uint32_t g, uint32_t b) {
@@ -252,6 +274,69 @@ TEST_F(GpuMemoryBufferVideoFramePoolTest, ReuseFirstResource) {
   EXPECT_NE(frame->mailbox_holder(0).sync_token, sync_token);
 }
 
+TEST_F(GpuMemoryBufferVideoFramePoolTest, ImportSharedMemoryFrame) {
+  base::SharedMemory shared_memory;
+  scoped_refptr<VideoFrame> software_frame =
+      CreateTestSharedMemoryVideoFrame(&shared_memory, 64);
+  ASSERT_TRUE(software_frame);
+  scoped_refptr<VideoFrame> frame;
+  gpu_memory_buffer_pool_->MaybeCreateHardwareFrame(
+      software_frame, base::BindOnce(MaybeCreateHardwareFrameCallback, &frame));
+
+  // The frame is ready without any copies.
+  EXPECT_FALSE(copy_task_runner_->HasPendingTask());
+  RunUntilIdle();
+
+  ASSERT_TRUE(frame);
+  EXPECT_NE(software_frame.get(), frame.get());
+  EXPECT_EQ(PIXEL_FORMAT_I420, frame->format());
+  EXPECT_EQ(3u, frame->NumTextures());
+  EXPECT_EQ(3u, gles2_->gen_textures_count());
+  EXPECT_TRUE(mock_gpu_factories_->created_memory_buffers().empty());
+
+  const auto& handles = mock_gpu_factories_->imported_handles();
+  ASSERT_EQ(3u, handles.size());
+  EXPECT_EQ(64u, handles[0].offset);
+  EXPECT_EQ(64u + 256u, handles[1].offset);
+  EXPECT_EQ(64u + 256u + 64u, handles[2].offset);
+  EXPECT_EQ(16, handles[0].stride);
+  EXPECT_EQ(8, handles[1].stride);
+  EXPECT_EQ(8, handles[2].stride);
+
+  // The software frame's memory stays in use until the frame is released.
+  EXPECT_FALSE(software_frame->HasOneRef());
+  gpu::Mailbox mailbox = frame->mailbox_holder(0).mailbox;
+  frame = nullptr;
+  RunUntilIdle();
+  EXPECT_TRUE(software_frame->HasOneRef());
+
+  // Importing the same memory again reuses the resources.
+  gpu_memory_buffer_pool_->MaybeCreateHardwareFrame(
+      software_frame, base::BindOnce(MaybeCreateHardwareFrameCallback, &frame));
+  RunUntilIdle();
+  ASSERT_TRUE(frame);
+  EXPECT_EQ(mailbox, frame->mailbox_holder(0).mailbox);
+  EXPECT_EQ(3u, gles2_->gen_textures_count());
+  EXPECT_EQ(3u, mock_gpu_factories_->imported_handles().size());
+}
+
+TEST_F(GpuMemoryBufferVideoFramePoolTest, ImportSharedMemoryFrameFail) {
+  base::SharedMemory shared_memory;
+  scoped_refptr<VideoFrame> software_frame =
+      CreateTestSharedMemoryVideoFrame(&shared_memory, 0);
+  ASSERT_TRUE(software_frame);
+  mock_gpu_factories_->SetFailToAllocateGpuMemoryBufferForTesting(true);
+  scoped_refptr<VideoFrame> frame;
+  gpu_memory_buffer_pool_->MaybeCreateHardwareFrame(
+      software_frame, base::BindOnce(MaybeCreateHardwareFrameCallback, &frame));
+  RunUntilIdle();
+
+  // Falls back to copying the frame.
+  EXPECT_NE(software_frame.get(), frame.get());
+  EXPECT_EQ(3u, gles2_->gen_textures_count());
+  EXPECT_EQ(1u, mock_gpu_factories_->imported_handles().size());
+}
+
 TEST_F(GpuMemoryBufferVideoFramePoolTest, DropResourceWhenSizeIsDifferent) {
   scoped_refptr<VideoFrame> frame;
   gpu_memory_buffer_pool_->MaybeCreateHardwareFrame(
@@ -101,6 +101,15 @@ class MEDIA_EXPORT GpuVideoAcceleratorFactories {
       gfx::BufferFormat format,
       gfx::BufferUsage usage) = 0;
 
+  // Creates a GpuMemoryBuffer for the GPU to read from existing memory, such
+  // as a SHARED_MEMORY_BUFFER |handle| referring to the memory of a software
+  // decoded VideoFrame. Takes ownership of |handle| in all cases. Returns
+  // nullptr if |handle| is not supported.
+  virtual std::unique_ptr<gfx::GpuMemoryBuffer> CreateGpuMemoryBufferFromHandle(
+      const gfx::GpuMemoryBufferHandle& handle,
+      const gfx::Size& size,
+      gfx::BufferFormat format) = 0;
+
   // |for_media_stream| specifies webrtc use case of media streams.
   virtual bool ShouldUseGpuMemoryBuffersForVideoFrames(
       bool for_media_stream) const = 0;
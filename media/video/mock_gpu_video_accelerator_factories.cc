@@ -7,6 +7,7 @@
 #include <memory>
 
 #include "base/memory/ptr_util.h"
+#include "base/memory/shared_memory.h"
 #include "ui/gfx/buffer_format_util.h"
 #include "ui/gfx/gpu_memory_buffer.h"
 
@@ -105,6 +106,18 @@ MockGpuVideoAcceleratorFactories::CreateGpuMemoryBuffer(
   return ret;
 }
 
+std::unique_ptr<gfx::GpuMemoryBuffer>
+MockGpuVideoAcceleratorFactories::CreateGpuMemoryBufferFromHandle(
+    const gfx::GpuMemoryBufferHandle& handle,
+    const gfx::Size& size,
+    gfx::BufferFormat format) {
+  base::SharedMemory::CloseHandle(handle.handle);
+  imported_handles_.push_back(handle);
+  if (fail_to_allocate_gpu_memory_buffer_)
+    return nullptr;
+  return std::make_unique<GpuMemoryBufferImpl>(size, format);
+}
+
 std::unique_ptr<base::SharedMemory>
 MockGpuVideoAcceleratorFactories::CreateSharedMemory(size_t size) {
   std::unique_ptr<base::SharedMemory> shared_memory(new base::SharedMemory);
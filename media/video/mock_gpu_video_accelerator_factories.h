@@ -63,6 +63,11 @@ class MockGpuVideoAcceleratorFactories : public GpuVideoAcceleratorFactories {
       gfx::BufferFormat format,
       gfx::BufferUsage usage) override;
 
+  std::unique_ptr<gfx::GpuMemoryBuffer> CreateGpuMemoryBufferFromHandle(
+      const gfx::GpuMemoryBufferHandle& handle,
+      const gfx::Size& size,
+      gfx::BufferFormat format) override;
+
   bool ShouldUseGpuMemoryBuffersForVideoFrames(
       bool for_media_stream) const override;
   unsigned ImageTextureTarget(gfx::BufferFormat format) override;
@@ -96,6 +101,12 @@ class MockGpuVideoAcceleratorFactories : public GpuVideoAcceleratorFactories {
     return created_memory_buffers_;
   }
 
+  // Handles passed to CreateGpuMemoryBufferFromHandle(). The underlying shared
+  // memory handles have been closed.
+  const std::vector<gfx::GpuMemoryBufferHandle>& imported_handles() {
+    return imported_handles_;
+  }
+
  private:
   DISALLOW_COPY_AND_ASSIGN(MockGpuVideoAcceleratorFactories);
 
@@ -107,6 +118,7 @@ class MockGpuVideoAcceleratorFactories : public GpuVideoAcceleratorFactories {
   gpu::gles2::GLES2Interface* gles2_;
 
   std::vector<gfx::GpuMemoryBuffer*> created_memory_buffers_;
+  std::vector<gfx::GpuMemoryBufferHandle> imported_handles_;
 };
 
 }  // namespace media
@@ -39,6 +39,12 @@ struct Configuration {
 
   // Maximum size of a single shared memory segment, in bytes.
   size_t max_shared_memory_num_bytes = 1024 * 1024 * 1024;
+
+  // If |true|, channels to processes invited by this process move their
+  // message bytes onto shared memory rings once the invitation is accepted,
+  // so that small messages don't each cost a syscall. Platform handles still
+  // go over the underlying socket. Only supported on Linux and Android.
+  bool use_shared_memory_channels = false;
 };
 
 }  // namespace edk
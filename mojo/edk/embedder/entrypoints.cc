@@ -92,6 +92,15 @@ MojoResult MojoAppendMessageDataImpl(
                                    num_handles, options, buffer, buffer_size);
 }
 
+MojoResult MojoReserveMessageCapacityImpl(
+    MojoMessageHandle message,
+    uint32_t payload_buffer_size,
+    const MojoReserveMessageCapacityOptions* options,
+    uint32_t* buffer_size) {
+  return g_core->ReserveMessageCapacity(message, payload_buffer_size, options,
+                                        buffer_size);
+}
+
 MojoResult MojoGetMessageDataImpl(MojoMessageHandle message,
                                   const MojoGetMessageDataOptions* options,
                                   void** buffer,
@@ -375,7 +384,8 @@ MojoSystemThunks g_thunks = {sizeof(MojoSystemThunks),
                              MojoAttachMessagePipeToInvitationImpl,
                              MojoExtractMessagePipeFromInvitationImpl,
                              MojoSendInvitationImpl,
-                             MojoAcceptInvitationImpl};
+                             MojoAcceptInvitationImpl,
+                             MojoReserveMessageCapacityImpl};
 
 }  // namespace
 
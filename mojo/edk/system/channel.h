@@ -50,6 +50,12 @@ class MOJO_SYSTEM_IMPL_EXPORT Channel
 #endif
       // A normal message that uses Header and can contain extra header values.
       NORMAL,
+      // A control message offering a shared memory ring which carries all
+      // following message bytes from the sender.
+      SHARED_RING_OFFER,
+      // A control message carrying only the platform handles for a message
+      // written to a shared memory ring.
+      SHARED_RING_HANDLES,
     };
 
 #pragma pack(push, 1)
@@ -159,6 +165,10 @@ class MOJO_SYSTEM_IMPL_EXPORT Channel
     // new payload size, it will be reallocated accordingly.
     void ExtendPayload(size_t new_payload_size);
 
+    // Ensures that the message buffer can hold at least |payload_capacity|
+    // bytes of payload without reallocation. The payload size is unchanged.
+    void ReservePayloadCapacity(size_t payload_capacity);
+
     const void* extra_header() const;
     void* mutable_extra_header();
     size_t extra_header_size() const;
@@ -294,6 +304,12 @@ class MOJO_SYSTEM_IMPL_EXPORT Channel
   // of closing it.
   virtual void LeakHandle() = 0;
 
+  // Moves all further outgoing message bytes onto a shared memory ring, and
+  // makes the remote end do the same once it receives the offer. Platform
+  // handles are still sent over the underlying channel. Does nothing on
+  // platforms without support.
+  virtual void OfferSharedMemoryRing() {}
+
  protected:
   explicit Channel(Delegate* delegate);
   virtual ~Channel();
@@ -12,6 +12,7 @@
 #include <memory>
 
 #include "base/bind.h"
+#include "base/containers/circular_deque.h"
 #include "base/containers/queue.h"
 #include "base/location.h"
 #include "base/macros.h"
@@ -27,6 +28,19 @@
 #include <sys/uio.h>
 #endif
 
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include "base/files/scoped_file.h"
+#include "base/memory/platform_shared_memory_region.h"
+#include "base/memory/unsafe_shared_memory_region.h"
+#include "base/posix/eintr_wrapper.h"
+#include "base/unguessable_token.h"
+#include "mojo/edk/embedder/platform_handle_utils.h"
+#include "mojo/edk/system/shared_ring_buffer.h"
+#endif
+
 namespace mojo {
 namespace edk {
 
@@ -34,6 +48,25 @@ namespace {
 
 const size_t kMaxBatchReadCapacity = 256 * 1024;
 
+// The most queued messages gathered into a single writev() call.
+const size_t kMaxCoalescedWrites = 64;
+
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+// Size of the shared memory ring used for each direction of a channel once
+// it's been offered. Larger messages are streamed through it in chunks.
+const size_t kSharedRingCapacity = 128 * 1024;
+
+void SignalEvent(const base::ScopedFD& event) {
+  const uint64_t value = 1;
+  ignore_result(HANDLE_EINTR(write(event.get(), &value, sizeof(value))));
+}
+
+void DrainEvent(const base::ScopedFD& event) {
+  uint64_t value;
+  ignore_result(HANDLE_EINTR(read(event.get(), &value, sizeof(value))));
+}
+#endif
+
 // A view over a Channel::Message object. The write queue uses these since
 // large messages may need to be sent in chunks.
 class MessageView {
@@ -69,6 +102,7 @@ class MessageView {
     offset_ += num_bytes;
   }
 
+  bool has_handles() const { return !handles_.empty(); }
   std::vector<ScopedInternalPlatformHandle> TakeHandles() {
     return std::move(handles_);
   }
@@ -122,12 +156,8 @@ class ChannelPosix : public Channel,
       base::AutoLock lock(write_lock_);
       if (reject_writes_)
         return;
-      if (outgoing_messages_.empty()) {
-        if (!WriteNoLock(MessageView(std::move(message), 0)))
-          reject_writes_ = write_error = true;
-      } else {
-        outgoing_messages_.emplace_back(std::move(message), 0);
-      }
+      if (!SendNoLock(MessageView(std::move(message), 0)))
+        reject_writes_ = write_error = true;
     }
     if (write_error) {
       // Invoke OnWriteError() asynchronously on the IO thread, in case Write()
@@ -143,6 +173,14 @@ class ChannelPosix : public Channel,
     leak_handle_ = true;
   }
 
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+  void OfferSharedMemoryRing() override {
+    io_task_runner_->PostTask(
+        FROM_HERE,
+        base::BindOnce(&ChannelPosix::OfferSharedMemoryRingOnIOThread, this));
+  }
+#endif
+
   bool GetReadInternalPlatformHandles(
       size_t num_handles,
       const void* extra_header,
@@ -205,6 +243,10 @@ class ChannelPosix : public Channel,
   ~ChannelPosix() override {
     DCHECK(!read_watcher_);
     DCHECK(!write_watcher_);
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+    DCHECK(!ring_data_watcher_);
+    DCHECK(!ring_space_watcher_);
+#endif
   }
 
   void StartOnIOThread() {
@@ -255,6 +297,20 @@ class ChannelPosix : public Channel,
 
     read_watcher_.reset();
     write_watcher_.reset();
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+    ring_data_watcher_.reset();
+    ring_space_watcher_.reset();
+    incoming_ring_.reset();
+    incoming_data_event_.reset();
+    incoming_space_event_.reset();
+    {
+      base::AutoLock lock(write_lock_);
+      outgoing_ring_.reset();
+      outgoing_ring_messages_.clear();
+      outgoing_data_event_.reset();
+      outgoing_space_event_.reset();
+    }
+#endif
     if (leak_handle_)
       ignore_result(handle_.release());
     handle_.reset();
@@ -275,6 +331,18 @@ class ChannelPosix : public Channel,
 
   // base::MessagePumpForIO::FdWatcher:
   void OnFileCanReadWithoutBlocking(int fd) override {
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+    if (incoming_data_event_.is_valid() && fd == incoming_data_event_.get()) {
+      ReadFromRing();
+      return;
+    }
+    if (outgoing_space_event_.is_valid() && fd == outgoing_space_event_.get()) {
+      DrainEvent(outgoing_space_event_);
+      base::AutoLock lock(write_lock_);
+      FlushRingNoLock();
+      return;
+    }
+#endif
     CHECK_EQ(fd, handle_.get().handle);
     if (handle_.get().needs_connection) {
 #if !defined(OS_NACL)
@@ -295,6 +363,13 @@ class ChannelPosix : public Channel,
       return;
     }
 
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+    if (incoming_ring_) {
+      ReadHandlesForRing();
+      return;
+    }
+#endif
+
     bool validation_error = false;
     bool read_error = false;
     size_t next_read_size = 0;
@@ -317,13 +392,20 @@ class ChannelPosix : public Channel,
           validation_error = true;
           break;
         }
-      } else if (read_result == 0 ||
-                 (errno != EAGAIN && errno != EWOULDBLOCK)) {
-        read_error = true;
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+        // Everything after a ring offer arrives through the ring.
+        if (incoming_ring_)
+          break;
+#endif
+      } else {
+        if (read_result == 0 || (errno != EAGAIN && errno != EWOULDBLOCK))
+          read_error = true;
         break;
       }
+      // A full buffer means more data is likely waiting, so keep reading and
+      // dispatching until the socket is drained or the batch limit is hit.
     } while (bytes_read == buffer_capacity &&
-             total_bytes_read < kMaxBatchReadCapacity && next_read_size > 0);
+             total_bytes_read < kMaxBatchReadCapacity);
     if (read_error) {
       // Stop receiving read notifications.
       read_watcher_.reset();
@@ -331,7 +413,13 @@ class ChannelPosix : public Channel,
         OnError(Error::kReceivedMalformedData);
       else
         OnError(Error::kDisconnected);
+      return;
     }
+
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+    if (incoming_ring_ && !ring_data_watcher_)
+      StartReadingRing();
+#endif
   }
 
   void OnFileCanWriteWithoutBlocking(int fd) override {
@@ -346,6 +434,26 @@ class ChannelPosix : public Channel,
       OnWriteError(Error::kDisconnected);
   }
 
+  // Sends a message over the shared memory ring if there is one, and over
+  // the socket otherwise.
+  bool SendNoLock(MessageView message_view) {
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+    if (outgoing_ring_)
+      return WriteToRingNoLock(std::move(message_view));
+#endif
+    return WriteOrQueueNoLock(std::move(message_view));
+  }
+
+  // Writes a message to the socket, or queues it behind earlier messages
+  // which are still waiting to be written.
+  bool WriteOrQueueNoLock(MessageView message_view) {
+    if (!outgoing_messages_.empty()) {
+      outgoing_messages_.emplace_back(std::move(message_view));
+      return true;
+    }
+    return WriteNoLock(std::move(message_view));
+  }
+
   // Attempts to write a message directly to the channel. If the full message
   // cannot be written, it's queued and a wait is initiated to write the message
   // ASAP on the I/O thread.
@@ -431,11 +539,68 @@ class ChannelPosix : public Channel,
     return FlushOutgoingMessagesNoLock();
   }
 
+  // Writes the leading run of queued messages which carry no handles with a
+  // single writev(), and removes those fully written from |messages|. Sets
+  // |*would_block| if the socket couldn't take everything. Returns false on
+  // write error.
+  bool WriteCoalescedNoLock(base::circular_deque<MessageView>* messages,
+                            bool* would_block) {
+    iovec iov[kMaxCoalescedWrites];
+    size_t num_iov = 0;
+    size_t num_bytes = 0;
+    for (const MessageView& message_view : *messages) {
+      if (num_iov == kMaxCoalescedWrites || message_view.has_handles())
+        break;
+      iov[num_iov].iov_base = const_cast<void*>(message_view.data());
+      iov[num_iov].iov_len = message_view.data_num_bytes();
+      num_bytes += iov[num_iov].iov_len;
+      ++num_iov;
+    }
+    DCHECK_GT(num_iov, 0u);
+
+    ssize_t result = PlatformChannelWritev(handle_, iov, num_iov);
+    if (result < 0) {
+      if (errno != EAGAIN && errno != EWOULDBLOCK)
+        return false;
+      *would_block = true;
+      return true;
+    }
+
+    size_t bytes_written = static_cast<size_t>(result);
+    *would_block = bytes_written < num_bytes;
+    while (bytes_written > 0) {
+      MessageView& message_view = messages->front();
+      if (bytes_written < message_view.data_num_bytes()) {
+        message_view.advance_data_offset(bytes_written);
+        break;
+      }
+      bytes_written -= message_view.data_num_bytes();
+      messages->pop_front();
+    }
+    return true;
+  }
+
   bool FlushOutgoingMessagesNoLock() {
     base::circular_deque<MessageView> messages;
     std::swap(outgoing_messages_, messages);
 
     while (!messages.empty()) {
+      // Messages pile up here while the socket is full. Once it drains, write
+      // as many as possible at once rather than making a syscall for each.
+      if (messages.size() > 1 && !messages[0].has_handles() &&
+          !messages[1].has_handles() && !handle_.get().needs_connection) {
+        bool would_block = false;
+        if (!WriteCoalescedNoLock(&messages, &would_block))
+          return false;
+        if (would_block) {
+          DCHECK(outgoing_messages_.empty());
+          std::swap(messages, outgoing_messages_);
+          WaitForWriteOnIOThreadNoLock();
+          return true;
+        }
+        continue;
+      }
+
       if (!WriteNoLock(std::move(messages.front())))
         return false;
 
@@ -458,7 +623,249 @@ class ChannelPosix : public Channel,
     return true;
   }
 
-#if defined(OS_MACOSX)
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+  void OfferSharedMemoryRingOnIOThread() {
+    DCHECK(io_task_runner_->RunsTasksInCurrentSequence());
+    if (offered_ring_ || !handle_.is_valid())
+      return;
+    offered_ring_ = true;
+
+    std::unique_ptr<SharedRingBuffer> ring =
+        SharedRingBuffer::Create(kSharedRingCapacity);
+    base::ScopedFD data_event(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK));
+    base::ScopedFD space_event(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK));
+    if (!ring || !data_event.is_valid() || !space_event.is_valid()) {
+      DLOG(ERROR) << "Failed to create shared memory ring";
+      return;
+    }
+    base::ScopedFD remote_data_event(HANDLE_EINTR(dup(data_event.get())));
+    base::ScopedFD remote_space_event(HANDLE_EINTR(dup(space_event.get())));
+    base::subtle::PlatformSharedMemoryRegion region =
+        base::UnsafeSharedMemoryRegion::TakeHandleForSerialization(
+            ring->DuplicateRegion());
+    if (!region.IsValid() || !remote_data_event.is_valid() ||
+        !remote_space_event.is_valid()) {
+      DLOG(ERROR) << "Failed to duplicate shared memory ring handles";
+      return;
+    }
+
+    const uint64_t region_size = region.GetSize();
+    std::vector<ScopedInternalPlatformHandle> handles(3);
+    ScopedInternalPlatformHandle ignored_handle;
+    ExtractInternalPlatformHandlesFromSharedMemoryRegionHandle(
+        region.PassPlatformHandle(), &handles[0], &ignored_handle);
+    handles[1].reset(InternalPlatformHandle(remote_data_event.release()));
+    handles[2].reset(InternalPlatformHandle(remote_space_event.release()));
+    MessagePtr offer(new Channel::Message(
+        sizeof(region_size), handles.size(),
+        Message::MessageType::SHARED_RING_OFFER));
+    memcpy(offer->mutable_payload(), &region_size, sizeof(region_size));
+    offer->SetHandles(std::move(handles));
+
+    ring_space_watcher_.reset(
+        new base::MessagePumpForIO::FdWatchController(FROM_HERE));
+    base::MessageLoopCurrentForIO::Get()->WatchFileDescriptor(
+        space_event.get(), true /* persistent */,
+        base::MessagePumpForIO::WATCH_READ, ring_space_watcher_.get(), this);
+
+    bool write_error = false;
+    {
+      base::AutoLock lock(write_lock_);
+      if (reject_writes_)
+        return;
+      // Everything sent after the offer goes through the ring, which the
+      // remote end only starts reading once the offer has arrived, so message
+      // order is preserved.
+      if (!WriteOrQueueNoLock(MessageView(std::move(offer), 0)))
+        reject_writes_ = write_error = true;
+      outgoing_ring_ = std::move(ring);
+      outgoing_data_event_ = std::move(data_event);
+      outgoing_space_event_ = std::move(space_event);
+    }
+    if (write_error)
+      OnWriteError(Error::kDisconnected);
+  }
+
+  bool OnSharedRingOffer(const void* payload,
+                         size_t payload_size,
+                         std::vector<ScopedInternalPlatformHandle> handles) {
+    if (incoming_ring_ || payload_size != sizeof(uint64_t) ||
+        handles.size() != 3) {
+      return false;
+    }
+    uint64_t region_size;
+    memcpy(&region_size, payload, sizeof(region_size));
+    if (region_size > std::numeric_limits<size_t>::max())
+      return false;
+
+    incoming_ring_ =
+        SharedRingBuffer::Open(base::UnsafeSharedMemoryRegion::Deserialize(
+            base::subtle::PlatformSharedMemoryRegion::Take(
+                CreateSharedMemoryRegionHandleFromInternalPlatformHandles(
+                    std::move(handles[0]), ScopedInternalPlatformHandle()),
+                base::subtle::PlatformSharedMemoryRegion::Mode::kUnsafe,
+                static_cast<size_t>(region_size),
+                base::UnguessableToken::Create())));
+    if (!incoming_ring_)
+      return false;
+    incoming_data_event_.reset(handles[1].release().handle);
+    incoming_space_event_.reset(handles[2].release().handle);
+    // Reading from the ring shares the read buffer with the socket, so it
+    // only starts once the current socket read has been processed.
+    return true;
+  }
+
+  void StartReadingRing() {
+    ring_data_watcher_.reset(
+        new base::MessagePumpForIO::FdWatchController(FROM_HERE));
+    base::MessageLoopCurrentForIO::Get()->WatchFileDescriptor(
+        incoming_data_event_.get(), true /* persistent */,
+        base::MessagePumpForIO::WATCH_READ, ring_data_watcher_.get(), this);
+
+    // Answer with a ring of our own so that both directions avoid the socket.
+    OfferSharedMemoryRingOnIOThread();
+
+    // The remote end may have written to the ring before it was watched.
+    ReadFromRing();
+  }
+
+  void ReadFromRing() {
+    if (!incoming_ring_)
+      return;
+
+    // Drain the event before looking at the ring, so that a signal for data
+    // written after the last check below is never lost.
+    DrainEvent(incoming_data_event_);
+
+    size_t next_read_size = 0;
+    size_t total_bytes_read = 0;
+    while (total_bytes_read < kMaxBatchReadCapacity) {
+      size_t buffer_capacity = next_read_size;
+      char* buffer = GetReadBuffer(&buffer_capacity);
+      DCHECK_GT(buffer_capacity, 0u);
+
+      size_t bytes_read = 0;
+      bool wake_writer = false;
+      bool ok = incoming_ring_->Read(buffer, buffer_capacity, &bytes_read,
+                                     &wake_writer);
+      if (wake_writer)
+        SignalEvent(incoming_space_event_);
+      if (ok && bytes_read == 0) {
+        if (incoming_ring_->PrepareToWaitForData())
+          return;
+        continue;
+      }
+      if (!ok || !OnReadComplete(bytes_read, &next_read_size)) {
+        ring_data_watcher_.reset();
+        OnError(Error::kReceivedMalformedData);
+        return;
+      }
+      total_bytes_read += bytes_read;
+    }
+
+    // Let other tasks run before reading the rest.
+    io_task_runner_->PostTask(
+        FROM_HERE, base::BindOnce(&ChannelPosix::ReadFromRing, this));
+  }
+
+  // Once the remote end writes to a ring, the socket only carries
+  // SHARED_RING_HANDLES messages. Their bytes carry no information, and the
+  // descriptors are claimed by messages read from the ring.
+  void ReadHandlesForRing() {
+    size_t num_handles = incoming_platform_handles_.size();
+    bool disconnected = false;
+    char buffer[sizeof(Message::Header) * 16];
+    for (;;) {
+      ssize_t read_result = PlatformChannelRecvmsg(
+          handle_, buffer, sizeof(buffer), &incoming_platform_handles_);
+      if (read_result > 0)
+        continue;
+      if (read_result == 0 || (errno != EAGAIN && errno != EWOULDBLOCK))
+        disconnected = true;
+      break;
+    }
+
+    // Dispatch any ring messages which were waiting for these handles.
+    size_t next_read_size = 0;
+    if (incoming_platform_handles_.size() != num_handles &&
+        !OnReadComplete(0, &next_read_size)) {
+      read_watcher_.reset();
+      OnError(Error::kReceivedMalformedData);
+      return;
+    }
+
+    if (disconnected) {
+      // Pick up messages which were written before the remote end went away.
+      ReadFromRing();
+      read_watcher_.reset();
+      OnError(Error::kDisconnected);
+    }
+  }
+
+  // Sends |message_view| through the ring. Its platform handles are sent over
+  // the socket first, so they're available by the time the message is read.
+  bool WriteToRingNoLock(MessageView message_view) {
+    std::vector<ScopedInternalPlatformHandle> handles =
+        message_view.TakeHandles();
+    if (!handles.empty()) {
+      MessageView handles_view(
+          std::make_unique<Channel::Message>(
+              0, 0, Message::MessageType::SHARED_RING_HANDLES),
+          0);
+      handles_view.SetHandles(std::move(handles));
+      if (!WriteOrQueueNoLock(std::move(handles_view)))
+        return false;
+    }
+    outgoing_ring_messages_.emplace_back(std::move(message_view));
+    FlushRingNoLock();
+    return true;
+  }
+
+  // Copies queued messages into the ring until it's full, in which case the
+  // rest is written when the reader signals that it has freed some space.
+  void FlushRingNoLock() {
+    if (!outgoing_ring_)
+      return;
+    while (!outgoing_ring_messages_.empty()) {
+      MessageView& message_view = outgoing_ring_messages_.front();
+      bool wake_reader = false;
+      size_t bytes_written = outgoing_ring_->Write(
+          message_view.data(), message_view.data_num_bytes(), &wake_reader);
+      if (wake_reader)
+        SignalEvent(outgoing_data_event_);
+      if (bytes_written == message_view.data_num_bytes()) {
+        outgoing_ring_messages_.pop_front();
+        continue;
+      }
+      message_view.advance_data_offset(bytes_written);
+      if (outgoing_ring_->PrepareToWaitForSpace())
+        return;
+    }
+  }
+#endif  // defined(OS_LINUX) || defined(OS_ANDROID)
+
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+  bool OnControlMessage(
+      Message::MessageType message_type,
+      const void* payload,
+      size_t payload_size,
+      std::vector<ScopedInternalPlatformHandle> handles) override {
+    switch (message_type) {
+      case Message::MessageType::SHARED_RING_OFFER:
+        return OnSharedRingOffer(payload, payload_size, std::move(handles));
+
+      case Message::MessageType::SHARED_RING_HANDLES:
+        // The attached descriptors stay queued for the ring message which
+        // follows.
+        return incoming_ring_ != nullptr;
+
+      default:
+        break;
+    }
+
+    return false;
+  }
+#elif defined(OS_MACOSX)
   bool OnControlMessage(
       Message::MessageType message_type,
       const void* payload,
@@ -566,6 +973,27 @@ class ChannelPosix : public Channel,
 
   bool leak_handle_ = false;
 
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+  // Shared memory ring state; see OfferSharedMemoryRing(). The outgoing ring
+  // is protected by |write_lock_|. Everything else must only be accessed on
+  // the IO thread.
+  bool offered_ring_ = false;
+  std::unique_ptr<SharedRingBuffer> outgoing_ring_;
+  base::circular_deque<MessageView> outgoing_ring_messages_;
+  // Signaled to wake the remote reader.
+  base::ScopedFD outgoing_data_event_;
+  // Signaled by the remote reader once it has freed space.
+  base::ScopedFD outgoing_space_event_;
+  std::unique_ptr<base::MessagePumpForIO::FdWatchController>
+      ring_space_watcher_;
+
+  std::unique_ptr<SharedRingBuffer> incoming_ring_;
+  base::ScopedFD incoming_data_event_;
+  base::ScopedFD incoming_space_event_;
+  std::unique_ptr<base::MessagePumpForIO::FdWatchController>
+      ring_data_watcher_;
+#endif
+
 #if defined(OS_MACOSX)
   base::Lock handles_to_close_lock_;
   std::vector<ScopedInternalPlatformHandle> handles_to_close_;
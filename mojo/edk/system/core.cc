@@ -27,6 +27,7 @@
 #include "mojo/edk/embedder/process_error_callback.h"
 #include "mojo/edk/system/channel.h"
 #include "mojo/edk/system/configuration.h"
+#include "mojo/edk/system/data_pipe_buffer_pool.h"
 #include "mojo/edk/system/data_pipe_consumer_dispatcher.h"
 #include "mojo/edk/system/data_pipe_producer_dispatcher.h"
 #include "mojo/edk/system/handle_signals_state.h"
@@ -469,6 +470,31 @@ MojoResult Core::AppendMessageData(MojoMessageHandle message_handle,
   return MOJO_RESULT_OK;
 }
 
+MojoResult Core::ReserveMessageCapacity(
+    MojoMessageHandle message_handle,
+    uint32_t payload_buffer_size,
+    const MojoReserveMessageCapacityOptions* options,
+    uint32_t* buffer_size) {
+  if (!message_handle)
+    return MOJO_RESULT_INVALID_ARGUMENT;
+  if (options && options->struct_size != sizeof(*options))
+    return MOJO_RESULT_INVALID_ARGUMENT;
+
+  auto* message = reinterpret_cast<ports::UserMessageEvent*>(message_handle)
+                      ->GetMessage<UserMessageImpl>();
+  MojoResult rv = message->ReserveCapacity(payload_buffer_size);
+  if (rv != MOJO_RESULT_OK)
+    return rv;
+
+  if (buffer_size) {
+    *buffer_size =
+        message->IsSerialized()
+            ? base::checked_cast<uint32_t>(message->user_payload_capacity())
+            : 0;
+  }
+  return MOJO_RESULT_OK;
+}
+
 MojoResult Core::GetMessageData(MojoMessageHandle message_handle,
                                 const MojoGetMessageDataOptions* options,
                                 void** buffer,
@@ -698,29 +724,32 @@ MojoResult Core::CreateDataPipe(const MojoCreateDataPipeOptions* options,
     return MOJO_RESULT_INVALID_ARGUMENT;
   }
 
-  base::subtle::PlatformSharedMemoryRegion ring_buffer_region =
-      base::WritableSharedMemoryRegion::TakeHandleForSerialization(
-          GetNodeController()->CreateSharedBuffer(
-              create_options.capacity_num_bytes));
-
-  // NOTE: We demote the writable region to an unsafe region so that the
-  // producer handle can be transferred freely. There is no compelling reason
-  // to restrict access rights of consumers since they are the exclusive
-  // consumer of this pipe, and it would be impossible to support such access
-  // control on Android anyway.
-  auto writable_region_handle = ring_buffer_region.PassPlatformHandle();
+  base::UnsafeSharedMemoryRegion producer_region =
+      DataPipeBufferPool::Get()->Take(create_options.capacity_num_bytes);
+  if (!producer_region.IsValid()) {
+    base::subtle::PlatformSharedMemoryRegion ring_buffer_region =
+        base::WritableSharedMemoryRegion::TakeHandleForSerialization(
+            GetNodeController()->CreateSharedBuffer(
+                create_options.capacity_num_bytes));
+
+    // NOTE: We demote the writable region to an unsafe region so that the
+    // producer handle can be transferred freely. There is no compelling reason
+    // to restrict access rights of consumers since they are the exclusive
+    // consumer of this pipe, and it would be impossible to support such access
+    // control on Android anyway.
+    auto writable_region_handle = ring_buffer_region.PassPlatformHandle();
 #if defined(OS_POSIX) && !defined(OS_ANDROID) && !defined(OS_FUCHSIA) && \
     (!defined(OS_MACOSX) || defined(OS_IOS))
-  // This isn't strictly necessary, but it does make the handle configuration
-  // consistent with regular UnsafeSharedMemoryRegions.
-  writable_region_handle.readonly_fd.reset();
+    // This isn't strictly necessary, but it does make the handle configuration
+    // consistent with regular UnsafeSharedMemoryRegions.
+    writable_region_handle.readonly_fd.reset();
 #endif
-  base::UnsafeSharedMemoryRegion producer_region =
-      base::UnsafeSharedMemoryRegion::Deserialize(
-          base::subtle::PlatformSharedMemoryRegion::Take(
-              std::move(writable_region_handle),
-              base::subtle::PlatformSharedMemoryRegion::Mode::kUnsafe,
-              create_options.capacity_num_bytes, ring_buffer_region.GetGUID()));
+    producer_region = base::UnsafeSharedMemoryRegion::Deserialize(
+        base::subtle::PlatformSharedMemoryRegion::Take(
+            std::move(writable_region_handle),
+            base::subtle::PlatformSharedMemoryRegion::Mode::kUnsafe,
+            create_options.capacity_num_bytes, ring_buffer_region.GetGUID()));
+  }
   if (!producer_region.IsValid())
     return MOJO_RESULT_RESOURCE_EXHAUSTED;
 
@@ -732,15 +761,17 @@ MojoResult Core::CreateDataPipe(const MojoCreateDataPipeOptions* options,
 
   base::UnsafeSharedMemoryRegion consumer_region = producer_region.Duplicate();
   uint64_t pipe_id = base::RandUint64();
+  auto buffer_recycler = base::MakeRefCounted<DataPipeBufferPool::Recycler>(
+      DataPipeBufferPool::Get());
   scoped_refptr<Dispatcher> producer = DataPipeProducerDispatcher::Create(
-      GetNodeController(), port0, std::move(producer_region), create_options,
-      pipe_id);
+      GetNodeController(), port0, std::move(producer_region), buffer_recycler,
+      create_options, pipe_id);
   if (!producer)
     return MOJO_RESULT_RESOURCE_EXHAUSTED;
 
   scoped_refptr<Dispatcher> consumer = DataPipeConsumerDispatcher::Create(
-      GetNodeController(), port1, std::move(consumer_region), create_options,
-      pipe_id);
+      GetNodeController(), port1, std::move(consumer_region),
+      std::move(buffer_recycler), create_options, pipe_id);
   if (!consumer) {
     producer->Close();
     return MOJO_RESULT_RESOURCE_EXHAUSTED;
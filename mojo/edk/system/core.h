@@ -202,6 +202,11 @@ class MOJO_SYSTEM_IMPL_EXPORT Core {
                                const MojoAppendMessageDataOptions* options,
                                void** buffer,
                                uint32_t* buffer_size);
+  MojoResult ReserveMessageCapacity(
+      MojoMessageHandle message_handle,
+      uint32_t payload_buffer_size,
+      const MojoReserveMessageCapacityOptions* options,
+      uint32_t* buffer_size);
   MojoResult GetMessageData(MojoMessageHandle message_handle,
                             const MojoGetMessageDataOptions* options,
                             void** buffer,
@@ -0,0 +1,85 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "mojo/edk/system/data_pipe_buffer_pool.h"
+
+#include <string.h>
+
+#include <utility>
+
+#include "base/logging.h"
+#include "base/memory/shared_memory_mapping.h"
+#include "base/no_destructor.h"
+
+namespace mojo {
+namespace edk {
+
+DataPipeBufferPool::Recycler::Recycler(DataPipeBufferPool* pool)
+    : pool_(pool) {}
+
+DataPipeBufferPool::Recycler::~Recycler() = default;
+
+void DataPipeBufferPool::Recycler::OnEndpointClosed(
+    base::UnsafeSharedMemoryRegion ring_buffer) {
+  {
+    base::AutoLock lock(lock_);
+    DCHECK_GT(open_endpoints_, 0);
+    if (!ring_buffer.IsValid())
+      transferred_ = true;
+    if (--open_endpoints_ > 0 || transferred_)
+      return;
+  }
+  pool_->Recycle(std::move(ring_buffer));
+}
+
+DataPipeBufferPool::DataPipeBufferPool() = default;
+
+DataPipeBufferPool::~DataPipeBufferPool() = default;
+
+// static
+DataPipeBufferPool* DataPipeBufferPool::Get() {
+  static base::NoDestructor<DataPipeBufferPool> pool;
+  return pool.get();
+}
+
+base::UnsafeSharedMemoryRegion DataPipeBufferPool::Take(size_t num_bytes) {
+  base::AutoLock lock(lock_);
+  auto it = buffers_.find(num_bytes);
+  if (it == buffers_.end())
+    return base::UnsafeSharedMemoryRegion();
+
+  base::UnsafeSharedMemoryRegion ring_buffer = std::move(it->second.back());
+  it->second.pop_back();
+  if (it->second.empty())
+    buffers_.erase(it);
+  pooled_bytes_ -= num_bytes;
+  return ring_buffer;
+}
+
+void DataPipeBufferPool::Recycle(base::UnsafeSharedMemoryRegion ring_buffer) {
+  const size_t num_bytes = ring_buffer.GetSize();
+  {
+    base::AutoLock lock(lock_);
+    if (num_bytes > kMaxPooledBytes - pooled_bytes_)
+      return;
+  }
+
+  // The buffer may be handed to another process later, so nothing written by
+  // the previous pipe may be left in it.
+  {
+    base::WritableSharedMemoryMapping mapping = ring_buffer.Map();
+    if (!mapping.IsValid())
+      return;
+    memset(mapping.memory(), 0, num_bytes);
+  }
+
+  base::AutoLock lock(lock_);
+  if (num_bytes > kMaxPooledBytes - pooled_bytes_)
+    return;
+  pooled_bytes_ += num_bytes;
+  buffers_[num_bytes].push_back(std::move(ring_buffer));
+}
+
+}  // namespace edk
+}  // namespace mojo
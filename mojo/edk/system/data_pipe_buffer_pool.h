@@ -0,0 +1,86 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MOJO_EDK_SYSTEM_DATA_PIPE_BUFFER_POOL_H_
+#define MOJO_EDK_SYSTEM_DATA_PIPE_BUFFER_POOL_H_
+
+#include <stddef.h>
+
+#include <map>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/unsafe_shared_memory_region.h"
+#include "base/synchronization/lock.h"
+#include "mojo/edk/system/system_impl_export.h"
+
+namespace mojo {
+namespace edk {
+
+// Keeps the ring buffers of closed data pipes around for reuse by new ones,
+// bucketed by size, so that creating a data pipe doesn't always allocate a
+// new shared memory region. Pooled buffers are cleared before reuse.
+//
+// Only buffers which can no longer be referenced from anywhere else are
+// pooled: both endpoints of the pipe must have been closed in this process
+// without ever having been transferred. See Recycler.
+class MOJO_SYSTEM_IMPL_EXPORT DataPipeBufferPool {
+ public:
+  // Shared by the producer and consumer of a new data pipe. Each endpoint
+  // calls OnEndpointClosed() as it closes, and the buffer is recycled once
+  // both have done so.
+  class MOJO_SYSTEM_IMPL_EXPORT Recycler
+      : public base::RefCountedThreadSafe<Recycler> {
+   public:
+    explicit Recycler(DataPipeBufferPool* pool);
+
+    // |ring_buffer| is the endpoint's handle to the buffer, or an invalid
+    // region if the endpoint gave it up by being transferred. The endpoint
+    // must have unmapped the buffer already.
+    void OnEndpointClosed(base::UnsafeSharedMemoryRegion ring_buffer);
+
+   private:
+    friend class base::RefCountedThreadSafe<Recycler>;
+
+    ~Recycler();
+
+    DataPipeBufferPool* const pool_;
+
+    base::Lock lock_;
+    int open_endpoints_ = 2;
+    bool transferred_ = false;
+
+    DISALLOW_COPY_AND_ASSIGN(Recycler);
+  };
+
+  // Limits the total size of the buffers kept in a pool.
+  static constexpr size_t kMaxPooledBytes = 4 * 1024 * 1024;
+
+  DataPipeBufferPool();
+  ~DataPipeBufferPool();
+
+  // Returns the process-wide pool.
+  static DataPipeBufferPool* Get();
+
+  // Returns a zero-filled buffer of exactly |num_bytes| from the pool, or an
+  // invalid region if there is none.
+  base::UnsafeSharedMemoryRegion Take(size_t num_bytes);
+
+  // Clears |ring_buffer| and keeps it for reuse, unless the pool is full.
+  // There must be no other handles to or mappings of |ring_buffer|.
+  void Recycle(base::UnsafeSharedMemoryRegion ring_buffer);
+
+ private:
+  base::Lock lock_;
+  std::map<size_t, std::vector<base::UnsafeSharedMemoryRegion>> buffers_;
+  size_t pooled_bytes_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(DataPipeBufferPool);
+};
+
+}  // namespace edk
+}  // namespace mojo
+
+#endif  // MOJO_EDK_SYSTEM_DATA_PIPE_BUFFER_POOL_H_
@@ -0,0 +1,81 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "mojo/edk/system/data_pipe_buffer_pool.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <utility>
+
+#include "base/memory/shared_memory_mapping.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace mojo {
+namespace edk {
+namespace {
+
+const size_t kBufferSize = 4096;
+
+base::UnsafeSharedMemoryRegion CreateDirtyBuffer(size_t size) {
+  base::UnsafeSharedMemoryRegion region =
+      base::UnsafeSharedMemoryRegion::Create(size);
+  base::WritableSharedMemoryMapping mapping = region.Map();
+  memset(mapping.memory(), 'x', size);
+  return region;
+}
+
+TEST(DataPipeBufferPoolTest, RecyclesOnceBothEndpointsClose) {
+  DataPipeBufferPool pool;
+  base::UnsafeSharedMemoryRegion producer_buffer =
+      CreateDirtyBuffer(kBufferSize);
+  const base::UnguessableToken guid = producer_buffer.GetGUID();
+  base::UnsafeSharedMemoryRegion consumer_buffer = producer_buffer.Duplicate();
+
+  auto recycler = base::MakeRefCounted<DataPipeBufferPool::Recycler>(&pool);
+  recycler->OnEndpointClosed(std::move(producer_buffer));
+  EXPECT_FALSE(pool.Take(kBufferSize).IsValid());
+  recycler->OnEndpointClosed(std::move(consumer_buffer));
+
+  // Buffers are only handed out for the exact size they were created with.
+  EXPECT_FALSE(pool.Take(kBufferSize * 2).IsValid());
+
+  base::UnsafeSharedMemoryRegion reused = pool.Take(kBufferSize);
+  ASSERT_TRUE(reused.IsValid());
+  EXPECT_EQ(guid, reused.GetGUID());
+  base::WritableSharedMemoryMapping mapping = reused.Map();
+  ASSERT_TRUE(mapping.IsValid());
+  const uint8_t* data = static_cast<const uint8_t*>(mapping.memory());
+  for (size_t i = 0; i < kBufferSize; ++i)
+    ASSERT_EQ(0, data[i]);
+
+  EXPECT_FALSE(pool.Take(kBufferSize).IsValid());
+}
+
+TEST(DataPipeBufferPoolTest, TransferredBufferIsNotRecycled) {
+  DataPipeBufferPool pool;
+  base::UnsafeSharedMemoryRegion buffer = CreateDirtyBuffer(kBufferSize);
+
+  // The producer gave up its handle when it was serialized.
+  auto recycler = base::MakeRefCounted<DataPipeBufferPool::Recycler>(&pool);
+  recycler->OnEndpointClosed(base::UnsafeSharedMemoryRegion());
+  recycler->OnEndpointClosed(std::move(buffer));
+
+  EXPECT_FALSE(pool.Take(kBufferSize).IsValid());
+}
+
+TEST(DataPipeBufferPoolTest, LimitsPooledBytes) {
+  DataPipeBufferPool pool;
+  const size_t kCount = DataPipeBufferPool::kMaxPooledBytes / kBufferSize;
+  for (size_t i = 0; i < kCount + 1; ++i)
+    pool.Recycle(CreateDirtyBuffer(kBufferSize));
+
+  for (size_t i = 0; i < kCount; ++i)
+    EXPECT_TRUE(pool.Take(kBufferSize).IsValid());
+  EXPECT_FALSE(pool.Take(kBufferSize).IsValid());
+}
+
+}  // namespace
+}  // namespace edk
+}  // namespace mojo
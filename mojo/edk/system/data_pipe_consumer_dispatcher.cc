@@ -74,11 +74,13 @@ scoped_refptr<DataPipeConsumerDispatcher> DataPipeConsumerDispatcher::Create(
     NodeController* node_controller,
     const ports::PortRef& control_port,
     base::UnsafeSharedMemoryRegion shared_ring_buffer,
+    scoped_refptr<DataPipeBufferPool::Recycler> buffer_recycler,
     const MojoCreateDataPipeOptions& options,
     uint64_t pipe_id) {
   scoped_refptr<DataPipeConsumerDispatcher> consumer =
       new DataPipeConsumerDispatcher(node_controller, control_port,
-                                     std::move(shared_ring_buffer), options,
+                                     std::move(shared_ring_buffer),
+                                     std::move(buffer_recycler), options,
                                      pipe_id);
   base::AutoLock lock(consumer->lock_);
   if (!consumer->InitializeNoLock())
@@ -399,8 +401,8 @@ DataPipeConsumerDispatcher::Deserialize(const void* data,
 
   scoped_refptr<DataPipeConsumerDispatcher> dispatcher =
       new DataPipeConsumerDispatcher(node_controller, port,
-                                     std::move(ring_buffer), state->options,
-                                     state->pipe_id);
+                                     std::move(ring_buffer), nullptr,
+                                     state->options, state->pipe_id);
 
   {
     base::AutoLock lock(dispatcher->lock_);
@@ -420,6 +422,7 @@ DataPipeConsumerDispatcher::DataPipeConsumerDispatcher(
     NodeController* node_controller,
     const ports::PortRef& control_port,
     base::UnsafeSharedMemoryRegion shared_ring_buffer,
+    scoped_refptr<DataPipeBufferPool::Recycler> buffer_recycler,
     const MojoCreateDataPipeOptions& options,
     uint64_t pipe_id)
     : options_(options),
@@ -427,7 +430,8 @@ DataPipeConsumerDispatcher::DataPipeConsumerDispatcher(
       control_port_(control_port),
       pipe_id_(pipe_id),
       watchers_(this),
-      shared_ring_buffer_(std::move(shared_ring_buffer)) {}
+      shared_ring_buffer_(std::move(shared_ring_buffer)),
+      buffer_recycler_(std::move(buffer_recycler)) {}
 
 DataPipeConsumerDispatcher::~DataPipeConsumerDispatcher() {
   DCHECK(is_closed_ && !shared_ring_buffer_.IsValid() &&
@@ -460,6 +464,13 @@ MojoResult DataPipeConsumerDispatcher::CloseNoLock() {
     return MOJO_RESULT_INVALID_ARGUMENT;
   is_closed_ = true;
   ring_buffer_mapping_ = base::WritableSharedMemoryMapping();
+  if (buffer_recycler_) {
+    scoped_refptr<DataPipeBufferPool::Recycler> recycler =
+        std::move(buffer_recycler_);
+    base::UnsafeSharedMemoryRegion ring_buffer = std::move(shared_ring_buffer_);
+    base::AutoUnlock unlock(lock_);
+    recycler->OnEndpointClosed(std::move(ring_buffer));
+  }
   shared_ring_buffer_ = base::UnsafeSharedMemoryRegion();
 
   watchers_.NotifyClosed();
@@ -16,6 +16,7 @@
 #include "base/memory/unsafe_shared_memory_region.h"
 #include "base/synchronization/lock.h"
 #include "mojo/edk/embedder/scoped_platform_handle.h"
+#include "mojo/edk/system/data_pipe_buffer_pool.h"
 #include "mojo/edk/system/dispatcher.h"
 #include "mojo/edk/system/ports/port_ref.h"
 #include "mojo/edk/system/system_impl_export.h"
@@ -36,6 +37,7 @@ class MOJO_SYSTEM_IMPL_EXPORT DataPipeConsumerDispatcher final
       NodeController* node_controller,
       const ports::PortRef& control_port,
       base::UnsafeSharedMemoryRegion shared_ring_buffer,
+      scoped_refptr<DataPipeBufferPool::Recycler> buffer_recycler,
       const MojoCreateDataPipeOptions& options,
       uint64_t pipe_id);
 
@@ -75,11 +77,13 @@ class MOJO_SYSTEM_IMPL_EXPORT DataPipeConsumerDispatcher final
   class PortObserverThunk;
   friend class PortObserverThunk;
 
-  DataPipeConsumerDispatcher(NodeController* node_controller,
-                             const ports::PortRef& control_port,
-                             base::UnsafeSharedMemoryRegion shared_ring_buffer,
-                             const MojoCreateDataPipeOptions& options,
-                             uint64_t pipe_id);
+  DataPipeConsumerDispatcher(
+      NodeController* node_controller,
+      const ports::PortRef& control_port,
+      base::UnsafeSharedMemoryRegion shared_ring_buffer,
+      scoped_refptr<DataPipeBufferPool::Recycler> buffer_recycler,
+      const MojoCreateDataPipeOptions& options,
+      uint64_t pipe_id);
   ~DataPipeConsumerDispatcher() override;
 
   bool InitializeNoLock();
@@ -100,6 +104,8 @@ class MOJO_SYSTEM_IMPL_EXPORT DataPipeConsumerDispatcher final
   WatcherSet watchers_;
 
   base::UnsafeSharedMemoryRegion shared_ring_buffer_;
+  // Set if this endpoint was created along with its buffer in this process.
+  scoped_refptr<DataPipeBufferPool::Recycler> buffer_recycler_;
 
   // We don't really write to it, and it's safe because we're the only consumer
   // of this buffer.
@@ -73,11 +73,13 @@ scoped_refptr<DataPipeProducerDispatcher> DataPipeProducerDispatcher::Create(
     NodeController* node_controller,
     const ports::PortRef& control_port,
     base::UnsafeSharedMemoryRegion shared_ring_buffer,
+    scoped_refptr<DataPipeBufferPool::Recycler> buffer_recycler,
     const MojoCreateDataPipeOptions& options,
     uint64_t pipe_id) {
   scoped_refptr<DataPipeProducerDispatcher> producer =
       new DataPipeProducerDispatcher(node_controller, control_port,
-                                     std::move(shared_ring_buffer), options,
+                                     std::move(shared_ring_buffer),
+                                     std::move(buffer_recycler), options,
                                      pipe_id);
   base::AutoLock lock(producer->lock_);
   if (!producer->InitializeNoLock())
@@ -360,8 +362,8 @@ DataPipeProducerDispatcher::Deserialize(const void* data,
 
   scoped_refptr<DataPipeProducerDispatcher> dispatcher =
       new DataPipeProducerDispatcher(node_controller, port,
-                                     std::move(ring_buffer), state->options,
-                                     state->pipe_id);
+                                     std::move(ring_buffer), nullptr,
+                                     state->options, state->pipe_id);
 
   {
     base::AutoLock lock(dispatcher->lock_);
@@ -380,6 +382,7 @@ DataPipeProducerDispatcher::DataPipeProducerDispatcher(
     NodeController* node_controller,
     const ports::PortRef& control_port,
     base::UnsafeSharedMemoryRegion shared_ring_buffer,
+    scoped_refptr<DataPipeBufferPool::Recycler> buffer_recycler,
     const MojoCreateDataPipeOptions& options,
     uint64_t pipe_id)
     : options_(options),
@@ -388,6 +391,7 @@ DataPipeProducerDispatcher::DataPipeProducerDispatcher(
       pipe_id_(pipe_id),
       watchers_(this),
       shared_ring_buffer_(std::move(shared_ring_buffer)),
+      buffer_recycler_(std::move(buffer_recycler)),
       available_capacity_(options_.capacity_num_bytes) {}
 
 DataPipeProducerDispatcher::~DataPipeProducerDispatcher() {
@@ -421,6 +425,13 @@ MojoResult DataPipeProducerDispatcher::CloseNoLock() {
     return MOJO_RESULT_INVALID_ARGUMENT;
   is_closed_ = true;
   ring_buffer_mapping_ = base::WritableSharedMemoryMapping();
+  if (buffer_recycler_) {
+    scoped_refptr<DataPipeBufferPool::Recycler> recycler =
+        std::move(buffer_recycler_);
+    base::UnsafeSharedMemoryRegion ring_buffer = std::move(shared_ring_buffer_);
+    base::AutoUnlock unlock(lock_);
+    recycler->OnEndpointClosed(std::move(ring_buffer));
+  }
   shared_ring_buffer_ = base::UnsafeSharedMemoryRegion();
 
   watchers_.NotifyClosed();
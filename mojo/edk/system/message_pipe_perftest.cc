@@ -29,6 +29,9 @@ namespace mojo {
 namespace edk {
 namespace {
 
+// Marks the end of a burst. Payloads are otherwise never a single byte.
+const char kBurstEndMessage[] = ".";
+
 class MessagePipePerfTest : public test::MojoTestBase {
  public:
   MessagePipePerfTest() : message_count_(0), message_size_(0) {}
@@ -90,6 +93,72 @@ class MessagePipePerfTest : public test::MojoTestBase {
     SendQuitMessage(mp);
   }
 
+  // Writes |message_count_| messages back to back, then waits for the client
+  // to acknowledge the whole burst.
+  void WriteBurstThenWait(MojoHandle mp) {
+    for (int i = 0; i < message_count_; ++i) {
+      CHECK_EQ(WriteMessageRaw(MessagePipeHandle(mp), payload_.data(),
+                               payload_.size(), nullptr, 0,
+                               MOJO_WRITE_MESSAGE_FLAG_NONE),
+               MOJO_RESULT_OK);
+    }
+    CHECK_EQ(WriteMessageRaw(MessagePipeHandle(mp), kBurstEndMessage, 1,
+                             nullptr, 0, MOJO_WRITE_MESSAGE_FLAG_NONE),
+             MOJO_RESULT_OK);
+    HandleSignalsState hss;
+    CHECK_EQ(WaitForSignals(mp, MOJO_HANDLE_SIGNAL_READABLE, &hss),
+             MOJO_RESULT_OK);
+    CHECK_EQ(ReadMessageRaw(MessagePipeHandle(mp), &read_buffer_, nullptr,
+                            MOJO_READ_MESSAGE_FLAG_NONE),
+             MOJO_RESULT_OK);
+    CHECK_EQ(read_buffer_.size(), 1u);
+  }
+
+  void RunBurstServer(MojoHandle mp) {
+    const size_t kMsgSize[3] = {12, 144, 1728};
+    const int kBurstSize = 200;
+    const int kBurstCount = 250;
+
+    for (size_t i = 0; i < 3; i++) {
+      SetUpMeasurement(kBurstSize, kMsgSize[i]);
+      WriteBurstThenWait(mp);
+
+      std::string test_name = base::StringPrintf(
+          "IPC_Burst_Perf_%dx%dx_%u", kBurstCount, kBurstSize,
+          static_cast<unsigned>(kMsgSize[i]));
+      base::PerfTimeLogger logger(test_name.c_str());
+      for (int j = 0; j < kBurstCount; ++j)
+        WriteBurstThenWait(mp);
+      logger.Done();
+    }
+
+    SendQuitMessage(mp);
+  }
+
+  // Reads messages until the quit message, acknowledging the end of each
+  // burst.
+  static int RunBurstClient(MojoHandle mp) {
+    std::vector<uint8_t> buffer;
+    while (true) {
+      HandleSignalsState hss;
+      MojoResult result = WaitForSignals(mp, MOJO_HANDLE_SIGNAL_READABLE, &hss);
+      if (result != MOJO_RESULT_OK)
+        return result;
+
+      // Drain everything that has arrived before waiting again.
+      while (ReadMessageRaw(MessagePipeHandle(mp), &buffer, nullptr,
+                            MOJO_READ_MESSAGE_FLAG_NONE) == MOJO_RESULT_OK) {
+        if (buffer.empty())
+          return 0;
+        if (buffer.size() == 1) {
+          CHECK_EQ(WriteMessageRaw(MessagePipeHandle(mp), kBurstEndMessage, 1,
+                                   nullptr, 0, MOJO_WRITE_MESSAGE_FLAG_NONE),
+                   MOJO_RESULT_OK);
+        }
+      }
+    }
+  }
+
   static int RunPingPongClient(MojoHandle mp) {
     std::vector<uint8_t> buffer;
     int rv = 0;
@@ -157,6 +226,29 @@ TEST_F(MessagePipePerfTest, MultiprocessPingPong) {
   RunTestClient("PingPongClient", [&](MojoHandle h) { RunPingPongServer(h); });
 }
 
+// Measures throughput when many messages are queued to the peer at once,
+// where the channel can coalesce writes and dispatch reads in batches.
+TEST_F(MessagePipePerfTest, Burst) {
+  MojoHandle server_handle, client_handle;
+  CreateMessagePipe(&server_handle, &client_handle);
+
+  base::Thread client_thread("BurstClient");
+  client_thread.Start();
+  client_thread.task_runner()->PostTask(
+      FROM_HERE,
+      base::Bind(base::IgnoreResult(&RunBurstClient), client_handle));
+
+  RunBurstServer(server_handle);
+}
+
+DEFINE_TEST_CLIENT_WITH_PIPE(BurstClient, MessagePipePerfTest, h) {
+  return RunBurstClient(h);
+}
+
+TEST_F(MessagePipePerfTest, MultiprocessBurst) {
+  RunTestClient("BurstClient", [&](MojoHandle h) { RunBurstServer(h); });
+}
+
 }  // namespace
 }  // namespace edk
 }  // namespace mojo
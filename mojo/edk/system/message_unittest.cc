@@ -319,6 +319,35 @@ TEST_F(MessageTest, SerializeSimpleMessageWithHandlesWithContext) {
   });
 }
 
+// Large enough to have its payload moved into shared memory in transit.
+std::string MakeLargeMessagePayload() {
+  std::string payload(1024 * 1024, 0);
+  for (size_t i = 0; i < payload.size(); ++i)
+    payload[i] = static_cast<char>(i % 251);
+  return payload;
+}
+
+DEFINE_TEST_CLIENT_TEST_WITH_PIPE(ReceiveLargeMessageOneHandle,
+                                  MessageTest,
+                                  h) {
+  MojoTestBase::WaitForSignals(h, MOJO_HANDLE_SIGNAL_READABLE);
+  MojoHandle h1;
+  auto m = MojoTestBase::ReadMessageWithHandles(h, &h1, 1);
+  EXPECT_EQ(MakeLargeMessagePayload(), m);
+  MojoTestBase::WriteMessage(h1, kTestMessageWithContext2);
+}
+
+TEST_F(MessageTest, SendLargeMessageWithHandle) {
+  RunTestClient("ReceiveLargeMessageOneHandle", [&](MojoHandle h) {
+    mojo::MessagePipe pipe;
+    MojoHandle handle = pipe.handle0.release().value();
+    MojoTestBase::WriteMessageWithHandles(h, MakeLargeMessagePayload(),
+                                          &handle, 1);
+    EXPECT_EQ(kTestMessageWithContext2,
+              MojoTestBase::ReadMessage(pipe.handle1.get().value()));
+  });
+}
+
 #endif  // !defined(OS_IOS)
 
 TEST_F(MessageTest, SendLocalSimpleMessageWithHandlesWithContext) {
@@ -784,6 +813,47 @@ TEST_F(MessageTest, CorrectPayloadBufferBoundaries) {
   EXPECT_EQ(MOJO_RESULT_OK, MojoDestroyMessage(message));
 }
 
+TEST_F(MessageTest, ReserveMessageCapacity) {
+  constexpr uint32_t kReservedSize = 8192;
+  MojoMessageHandle message;
+  EXPECT_EQ(MOJO_RESULT_OK, MojoCreateMessage(nullptr, &message));
+
+  // Reserving before any data is appended applies to the first append.
+  uint32_t buffer_size = 1;
+  EXPECT_EQ(MOJO_RESULT_OK, MojoReserveMessageCapacity(message, kReservedSize,
+                                                       nullptr, &buffer_size));
+  EXPECT_EQ(0u, buffer_size);
+
+  void* buffer = nullptr;
+  EXPECT_EQ(MOJO_RESULT_OK, MojoAppendMessageData(message, 16, nullptr, 0,
+                                                  nullptr, &buffer,
+                                                  &buffer_size));
+  EXPECT_GE(buffer_size, kReservedSize);
+
+  // Appending within the reserved capacity never moves the buffer.
+  void* original_buffer = buffer;
+  for (uint32_t size = 16; size + 512 <= kReservedSize; size += 512) {
+    EXPECT_EQ(MOJO_RESULT_OK, MojoAppendMessageData(message, 512, nullptr, 0,
+                                                    nullptr, &buffer,
+                                                    &buffer_size));
+    EXPECT_EQ(original_buffer, buffer);
+  }
+
+  // Reserving more after data has been appended grows the buffer in place of
+  // later appends, preserving its contents.
+  memset(buffer, 'x', 16);
+  EXPECT_EQ(MOJO_RESULT_OK,
+            MojoReserveMessageCapacity(message, kReservedSize * 4, nullptr,
+                                       &buffer_size));
+  EXPECT_GE(buffer_size, kReservedSize * 4);
+  EXPECT_EQ(MOJO_RESULT_OK, MojoAppendMessageData(message, 0, nullptr, 0,
+                                                  nullptr, &buffer,
+                                                  &buffer_size));
+  EXPECT_EQ(0, memcmp(buffer, std::string(16, 'x').data(), 16));
+
+  EXPECT_EQ(MOJO_RESULT_OK, MojoDestroyMessage(message));
+}
+
 TEST_F(MessageTest, CommitInvalidMessageContents) {
   // Regression test for https://crbug.com/755127. Ensures that we don't crash
   // if we attempt to commit the contents of an unserialized message.
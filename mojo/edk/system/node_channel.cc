@@ -227,6 +227,12 @@ void NodeChannel::LeakHandleOnShutdown() {
   }
 }
 
+void NodeChannel::OfferSharedMemoryRing() {
+  base::AutoLock lock(channel_lock_);
+  if (channel_)
+    channel_->OfferSharedMemoryRing();
+}
+
 void NodeChannel::NotifyBadMessage(const std::string& error) {
   if (!process_error_callback_.is_null())
     process_error_callback_.Run("Received bad user message: " + error);
@@ -115,6 +115,10 @@ class NodeChannel : public base::RefCountedThreadSafe<NodeChannel>,
   // Leaks the pipe handle instead of closing it on shutdown.
   void LeakHandleOnShutdown();
 
+  // Moves message bytes in both directions onto shared memory rings. See
+  // Channel::OfferSharedMemoryRing().
+  void OfferSharedMemoryRing();
+
   // Invokes the bad message callback for this channel, if any.
   void NotifyBadMessage(const std::string& error);
 
@@ -94,6 +94,8 @@ ports::ScopedEvent DeserializeEventMessage(
   auto message = UserMessageImpl::CreateFromChannelMessage(
       message_event.get(), std::move(channel_message),
       static_cast<uint8_t*>(data) + event_size, size - event_size);
+  if (!message)
+    return nullptr;
   message->set_source_node(from_node);
 
   message_event->AttachMessage(std::move(message));
@@ -779,6 +781,11 @@ void NodeController::OnAcceptInvitation(const ports::NodeName& from_node,
 
   AddPeer(invitee_name, channel, false /* start_channel */);
 
+  // The invitee was launched by this process, so it's trusted enough to share
+  // memory with for faster messaging.
+  if (GetConfiguration().use_shared_memory_channels)
+    channel->OfferSharedMemoryRing();
+
   // TODO(rockot): We could simplify invitee initialization if we could
   // synchronously get a new async broker channel from the broker. For now we do
   // it asynchronously since it's only used to facilitate handle passing, not
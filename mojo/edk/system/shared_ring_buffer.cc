@@ -0,0 +1,165 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "mojo/edk/system/shared_ring_buffer.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <utility>
+
+#include "base/bits.h"
+#include "base/logging.h"
+#include "base/memory/ptr_util.h"
+
+namespace mojo {
+namespace edk {
+
+// Lives at the start of the shared region. Positions count every byte ever
+// written or read, so the ring is empty when they are equal and full when
+// they differ by the capacity.
+struct SharedRingBuffer::Header {
+  std::atomic<uint64_t> write_offset;
+  std::atomic<uint64_t> read_offset;
+  std::atomic<uint32_t> reader_waiting;
+  std::atomic<uint32_t> writer_waiting;
+};
+
+namespace {
+
+// Data starts on its own cache line, after the header.
+const size_t kDataOffset = 64;
+
+}  // namespace
+
+// static
+std::unique_ptr<SharedRingBuffer> SharedRingBuffer::Create(size_t capacity) {
+  static_assert(sizeof(Header) <= kDataOffset,
+                "Header must fit before the data");
+  DCHECK(base::bits::IsPowerOfTwo(capacity));
+  base::UnsafeSharedMemoryRegion region =
+      base::UnsafeSharedMemoryRegion::Create(kDataOffset + capacity);
+  if (!region.IsValid())
+    return nullptr;
+  base::WritableSharedMemoryMapping mapping = region.Map();
+  if (!mapping.IsValid())
+    return nullptr;
+
+  Header* header = new (mapping.memory()) Header;
+  header->write_offset.store(0);
+  header->read_offset.store(0);
+  header->reader_waiting.store(0);
+  header->writer_waiting.store(0);
+  return base::WrapUnique(
+      new SharedRingBuffer(std::move(region), std::move(mapping)));
+}
+
+// static
+std::unique_ptr<SharedRingBuffer> SharedRingBuffer::Open(
+    base::UnsafeSharedMemoryRegion region) {
+  if (!region.IsValid() || region.GetSize() <= kDataOffset ||
+      !base::bits::IsPowerOfTwo(region.GetSize() - kDataOffset)) {
+    return nullptr;
+  }
+  base::WritableSharedMemoryMapping mapping = region.Map();
+  if (!mapping.IsValid())
+    return nullptr;
+  return base::WrapUnique(
+      new SharedRingBuffer(std::move(region), std::move(mapping)));
+}
+
+SharedRingBuffer::SharedRingBuffer(base::UnsafeSharedMemoryRegion region,
+                                   base::WritableSharedMemoryMapping mapping)
+    : region_(std::move(region)),
+      mapping_(std::move(mapping)),
+      capacity_(mapping_.size() - kDataOffset) {}
+
+SharedRingBuffer::~SharedRingBuffer() = default;
+
+base::UnsafeSharedMemoryRegion SharedRingBuffer::DuplicateRegion() const {
+  return region_.Duplicate();
+}
+
+size_t SharedRingBuffer::Write(const void* data,
+                               size_t num_bytes,
+                               bool* wake_reader) {
+  *wake_reader = false;
+  uint64_t used = write_offset_ - header()->read_offset.load();
+  // A misbehaving reader is treated as never freeing any space.
+  if (used >= capacity_)
+    return 0;
+
+  size_t bytes_to_write =
+      std::min(num_bytes, capacity_ - static_cast<size_t>(used));
+  size_t start = static_cast<size_t>(write_offset_ & (capacity_ - 1));
+  size_t first_chunk = std::min(bytes_to_write, capacity_ - start);
+  memcpy(ring_data() + start, data, first_chunk);
+  memcpy(ring_data(), static_cast<const char*>(data) + first_chunk,
+         bytes_to_write - first_chunk);
+
+  write_offset_ += bytes_to_write;
+  header()->write_offset.store(write_offset_);
+  *wake_reader = bytes_to_write && header()->reader_waiting.load() &&
+                 header()->reader_waiting.exchange(0);
+  return bytes_to_write;
+}
+
+bool SharedRingBuffer::PrepareToWaitForSpace() {
+  header()->writer_waiting.store(1);
+  if (write_offset_ - header()->read_offset.load() < capacity_) {
+    header()->writer_waiting.store(0);
+    return false;
+  }
+  return true;
+}
+
+bool SharedRingBuffer::Read(void* buffer,
+                            size_t buffer_size,
+                            size_t* bytes_read,
+                            bool* wake_writer) {
+  *bytes_read = 0;
+  *wake_writer = false;
+  uint64_t available = header()->write_offset.load() - read_offset_;
+  if (available > capacity_) {
+    DLOG(ERROR) << "Invalid shared ring write offset";
+    return false;
+  }
+
+  size_t bytes_to_read =
+      std::min(buffer_size, static_cast<size_t>(available));
+  size_t start = static_cast<size_t>(read_offset_ & (capacity_ - 1));
+  size_t first_chunk = std::min(bytes_to_read, capacity_ - start);
+  memcpy(buffer, ring_data() + start, first_chunk);
+  memcpy(static_cast<char*>(buffer) + first_chunk, ring_data(),
+         bytes_to_read - first_chunk);
+
+  read_offset_ += bytes_to_read;
+  header()->read_offset.store(read_offset_);
+  *bytes_read = bytes_to_read;
+  *wake_writer = bytes_to_read && header()->writer_waiting.load() &&
+                 header()->writer_waiting.exchange(0);
+  return true;
+}
+
+bool SharedRingBuffer::PrepareToWaitForData() {
+  header()->reader_waiting.store(1);
+  if (header()->write_offset.load() != read_offset_) {
+    header()->reader_waiting.store(0);
+    return false;
+  }
+  return true;
+}
+
+SharedRingBuffer::Header* SharedRingBuffer::header() const {
+  return static_cast<Header*>(mapping_.memory());
+}
+
+char* SharedRingBuffer::ring_data() const {
+  return static_cast<char*>(mapping_.memory()) + kDataOffset;
+}
+
+}  // namespace edk
+}  // namespace mojo
@@ -0,0 +1,101 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MOJO_EDK_SYSTEM_SHARED_RING_BUFFER_H_
+#define MOJO_EDK_SYSTEM_SHARED_RING_BUFFER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+
+#include "base/macros.h"
+#include "base/memory/shared_memory_mapping.h"
+#include "base/memory/unsafe_shared_memory_region.h"
+#include "mojo/edk/system/system_impl_export.h"
+
+namespace mojo {
+namespace edk {
+
+// A single-producer, single-consumer byte stream in shared memory, used by
+// Channel to move message bytes to another process without a syscall per
+// message. One process creates the ring and writes to it; the peer opens a
+// duplicate of the region and reads from it.
+//
+// Neither side blocks. When the reader runs out of data (or the writer out of
+// space) it calls PrepareToWait*() and, if that returns true, sleeps until the
+// other side signals it through some external mechanism. Read() and Write()
+// report whether such a signal is needed, so that a busy peer is never woken
+// needlessly.
+//
+// The peer is not trusted: each side keeps its own position privately and
+// only publishes it, and the reader validates the writer's position before
+// copying any data out of the ring.
+class MOJO_SYSTEM_IMPL_EXPORT SharedRingBuffer {
+ public:
+  // Creates a new ring holding up to |capacity| bytes, which must be a power
+  // of two. Returns null on failure.
+  static std::unique_ptr<SharedRingBuffer> Create(size_t capacity);
+
+  // Maps a ring created by Create() in another process. Returns null if the
+  // region can't be mapped or is not a valid ring.
+  static std::unique_ptr<SharedRingBuffer> Open(
+      base::UnsafeSharedMemoryRegion region);
+
+  ~SharedRingBuffer();
+
+  size_t capacity() const { return capacity_; }
+
+  // Returns a duplicate of the region backing the ring, to be sent to the
+  // peer and passed to Open().
+  base::UnsafeSharedMemoryRegion DuplicateRegion() const;
+
+  // Writer side. Copies as much of |data| as fits and returns the number of
+  // bytes copied. Sets |*wake_reader| if the reader is waiting for data and
+  // must be signaled.
+  size_t Write(const void* data, size_t num_bytes, bool* wake_reader);
+
+  // Writer side. Returns true if the ring is still full after announcing that
+  // the writer is waiting for space, in which case the reader will ask for
+  // the writer to be signaled once it frees some.
+  bool PrepareToWaitForSpace();
+
+  // Reader side. Copies up to |buffer_size| bytes into |buffer| and sets
+  // |*bytes_read|. Sets |*wake_writer| if the writer is waiting for space and
+  // must be signaled. Returns false if the writer corrupted the ring.
+  bool Read(void* buffer,
+            size_t buffer_size,
+            size_t* bytes_read,
+            bool* wake_writer);
+
+  // Reader side. Returns true if the ring is still empty after announcing
+  // that the reader is waiting for data, in which case the writer will ask
+  // for the reader to be signaled once it adds some.
+  bool PrepareToWaitForData();
+
+ private:
+  struct Header;
+
+  SharedRingBuffer(base::UnsafeSharedMemoryRegion region,
+                   base::WritableSharedMemoryMapping mapping);
+
+  Header* header() const;
+  char* ring_data() const;
+
+  const base::UnsafeSharedMemoryRegion region_;
+  const base::WritableSharedMemoryMapping mapping_;
+  const size_t capacity_;
+
+  // Private copies of the positions owned by this side. These are published
+  // to the header but never read back from it.
+  uint64_t write_offset_ = 0;
+  uint64_t read_offset_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(SharedRingBuffer);
+};
+
+}  // namespace edk
+}  // namespace mojo
+
+#endif  // MOJO_EDK_SYSTEM_SHARED_RING_BUFFER_H_
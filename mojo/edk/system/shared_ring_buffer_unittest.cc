@@ -0,0 +1,146 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "mojo/edk/system/shared_ring_buffer.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <memory>
+#include <string>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace mojo {
+namespace edk {
+namespace {
+
+const size_t kCapacity = 64;
+
+std::unique_ptr<SharedRingBuffer> OpenPeer(const SharedRingBuffer& ring) {
+  return SharedRingBuffer::Open(ring.DuplicateRegion());
+}
+
+TEST(SharedRingBufferTest, WriteAndReadAcrossWrap) {
+  std::unique_ptr<SharedRingBuffer> writer =
+      SharedRingBuffer::Create(kCapacity);
+  ASSERT_TRUE(writer);
+  std::unique_ptr<SharedRingBuffer> reader = OpenPeer(*writer);
+  ASSERT_TRUE(reader);
+  EXPECT_EQ(kCapacity, reader->capacity());
+
+  // Walk the positions around the ring a few times with odd-sized messages.
+  const std::string message = "the quick brown fox jumps";
+  for (int i = 0; i < 10; ++i) {
+    bool wake_reader = true;
+    EXPECT_EQ(message.size(),
+              writer->Write(message.data(), message.size(), &wake_reader));
+    EXPECT_FALSE(wake_reader);
+
+    char buffer[kCapacity];
+    size_t bytes_read = 0;
+    bool wake_writer = true;
+    ASSERT_TRUE(reader->Read(buffer, sizeof(buffer), &bytes_read,
+                             &wake_writer));
+    EXPECT_FALSE(wake_writer);
+    EXPECT_EQ(message, std::string(buffer, bytes_read));
+  }
+}
+
+TEST(SharedRingBufferTest, PartialWriteWhenFull) {
+  std::unique_ptr<SharedRingBuffer> writer =
+      SharedRingBuffer::Create(kCapacity);
+  std::unique_ptr<SharedRingBuffer> reader = OpenPeer(*writer);
+  ASSERT_TRUE(reader);
+
+  const std::string data(kCapacity + 10, 'x');
+  bool wake_reader = false;
+  EXPECT_EQ(kCapacity, writer->Write(data.data(), data.size(), &wake_reader));
+  EXPECT_EQ(0u, writer->Write(data.data(), data.size(), &wake_reader));
+
+  char buffer[16];
+  size_t bytes_read = 0;
+  bool wake_writer = false;
+  ASSERT_TRUE(reader->Read(buffer, sizeof(buffer), &bytes_read,
+                           &wake_writer));
+  EXPECT_EQ(sizeof(buffer), bytes_read);
+  EXPECT_EQ(sizeof(buffer),
+            writer->Write(data.data(), data.size(), &wake_reader));
+}
+
+TEST(SharedRingBufferTest, WakesWaitingReader) {
+  std::unique_ptr<SharedRingBuffer> writer =
+      SharedRingBuffer::Create(kCapacity);
+  std::unique_ptr<SharedRingBuffer> reader = OpenPeer(*writer);
+  ASSERT_TRUE(reader);
+
+  EXPECT_TRUE(reader->PrepareToWaitForData());
+
+  bool wake_reader = false;
+  EXPECT_EQ(1u, writer->Write("a", 1, &wake_reader));
+  EXPECT_TRUE(wake_reader);
+
+  // Only the first write after the reader starts waiting asks for a signal.
+  EXPECT_EQ(1u, writer->Write("b", 1, &wake_reader));
+  EXPECT_FALSE(wake_reader);
+
+  // Data is already available, so the reader must not go to sleep.
+  EXPECT_FALSE(reader->PrepareToWaitForData());
+}
+
+TEST(SharedRingBufferTest, WakesWaitingWriter) {
+  std::unique_ptr<SharedRingBuffer> writer =
+      SharedRingBuffer::Create(kCapacity);
+  std::unique_ptr<SharedRingBuffer> reader = OpenPeer(*writer);
+  ASSERT_TRUE(reader);
+
+  const std::string data(kCapacity, 'x');
+  bool wake_reader = false;
+  EXPECT_EQ(kCapacity, writer->Write(data.data(), data.size(), &wake_reader));
+  EXPECT_TRUE(writer->PrepareToWaitForSpace());
+
+  char buffer[1];
+  size_t bytes_read = 0;
+  bool wake_writer = false;
+  ASSERT_TRUE(reader->Read(buffer, sizeof(buffer), &bytes_read,
+                           &wake_writer));
+  EXPECT_TRUE(wake_writer);
+  ASSERT_TRUE(reader->Read(buffer, sizeof(buffer), &bytes_read,
+                           &wake_writer));
+  EXPECT_FALSE(wake_writer);
+
+  EXPECT_FALSE(writer->PrepareToWaitForSpace());
+}
+
+TEST(SharedRingBufferTest, RejectsCorruptWriteOffset) {
+  std::unique_ptr<SharedRingBuffer> writer =
+      SharedRingBuffer::Create(kCapacity);
+  base::UnsafeSharedMemoryRegion region = writer->DuplicateRegion();
+  std::unique_ptr<SharedRingBuffer> reader = OpenPeer(*writer);
+  ASSERT_TRUE(reader);
+
+  // The write position is the first field of the shared header. Claim more
+  // data than the ring can hold.
+  base::WritableSharedMemoryMapping mapping = region.Map();
+  ASSERT_TRUE(mapping.IsValid());
+  const uint64_t bogus_offset = kCapacity * 4;
+  memcpy(mapping.memory(), &bogus_offset, sizeof(bogus_offset));
+
+  char buffer[kCapacity];
+  size_t bytes_read = 0;
+  bool wake_writer = false;
+  EXPECT_FALSE(reader->Read(buffer, sizeof(buffer), &bytes_read,
+                            &wake_writer));
+  EXPECT_EQ(0u, bytes_read);
+}
+
+TEST(SharedRingBufferTest, RejectsInvalidRegion) {
+  EXPECT_FALSE(SharedRingBuffer::Open(base::UnsafeSharedMemoryRegion()));
+  EXPECT_FALSE(
+      SharedRingBuffer::Open(base::UnsafeSharedMemoryRegion::Create(100)));
+}
+
+}  // namespace
+}  // namespace edk
+}  // namespace mojo
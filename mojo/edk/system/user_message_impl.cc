@@ -8,6 +8,8 @@
 #include <vector>
 
 #include "base/atomicops.h"
+#include "base/memory/platform_shared_memory_region.h"
+#include "base/memory/read_only_shared_memory_region.h"
 #include "base/memory/ptr_util.h"
 #include "base/metrics/histogram_macros_local.h"
 #include "base/no_destructor.h"
@@ -17,6 +19,9 @@
 #include "base/trace_event/memory_dump_manager.h"
 #include "base/trace_event/memory_dump_provider.h"
 #include "base/trace_event/trace_event.h"
+#include "base/unguessable_token.h"
+#include "mojo/edk/embedder/platform_handle_utils.h"
+#include "mojo/edk/system/configuration.h"
 #include "mojo/edk/system/core.h"
 #include "mojo/edk/system/node_channel.h"
 #include "mojo/edk/system/node_controller.h"
@@ -35,6 +40,11 @@ namespace {
 // incur any reallocations as they're expanded to full size.
 const uint32_t kMinimumPayloadBufferSize = 128;
 
+// User payloads of at least this many bytes are moved into a shared memory
+// region when their message leaves the process, rather than being written
+// through the channel.
+const size_t kMinSharedPayloadSize = 256 * 1024;
+
 // Indicates whether handle serialization failure should be emulated in testing.
 bool g_always_fail_handle_serialization = false;
 
@@ -46,6 +56,13 @@ struct MessageHeader {
 
   // Total size of the header, including serialized dispatcher data.
   uint32_t header_size;
+
+  // If non-zero, the user payload does not follow the header. Instead it is
+  // this many bytes at the start of a read-only shared memory region, whose
+  // handle is the last one attached to the message.
+  uint32_t shared_payload_size;
+
+  uint32_t padding;
 };
 
 // Header for each dispatcher in a message, immediately following the message
@@ -196,6 +213,8 @@ MojoResult CreateOrExtendSerializedEventMessage(
 
   header->num_dispatchers =
       base::CheckedNumeric<uint32_t>(total_num_dispatchers).ValueOrDie();
+  header->shared_payload_size = 0;
+  header->padding = 0;
 
   // |header_size| is the total number of bytes preceding the message payload,
   // including all dispatcher headers and serialized dispatcher state.
@@ -259,6 +278,104 @@ MojoResult CreateOrExtendSerializedEventMessage(
   return MOJO_RESULT_OK;
 }
 
+// Returns a copy of |message|, whose user payload begins |header_size| bytes
+// after |header|, with the user payload moved into a new shared memory region.
+// Returns |message| itself if the region cannot be created, in which case the
+// payload is sent inline as usual.
+Channel::MessagePtr MoveUserPayloadToSharedMemory(Channel::MessagePtr message,
+                                                  MessageHeader* header,
+                                                  size_t header_size) {
+  void* data;
+  size_t size;
+  NodeChannel::GetEventMessageData(message.get(), &data, &size);
+  const size_t prefix_size =
+      reinterpret_cast<uint8_t*>(header) - static_cast<uint8_t*>(data) +
+      header_size;
+  DCHECK_LE(prefix_size, size);
+  const size_t user_payload_size = size - prefix_size;
+  if (!base::IsValueInRangeForNumericType<uint32_t>(user_payload_size))
+    return message;
+
+  base::MappedReadOnlyRegion shared_payload =
+      base::ReadOnlySharedMemoryRegion::Create(user_payload_size);
+  if (!shared_payload.IsValid())
+    return message;
+  memcpy(shared_payload.mapping.memory(),
+         static_cast<uint8_t*>(data) + prefix_size, user_payload_size);
+
+  std::vector<ScopedInternalPlatformHandle> handles = message->TakeHandles();
+  ScopedInternalPlatformHandle region_handle;
+  ScopedInternalPlatformHandle ignored_handle;
+  ExtractInternalPlatformHandlesFromSharedMemoryRegionHandle(
+      base::ReadOnlySharedMemoryRegion::TakeHandleForSerialization(
+          std::move(shared_payload.region))
+          .PassPlatformHandle(),
+      &region_handle, &ignored_handle);
+  handles.push_back(std::move(region_handle));
+
+  void* new_data;
+  Channel::MessagePtr new_message = NodeChannel::CreateEventMessage(
+      prefix_size, prefix_size, &new_data, handles.size());
+  memcpy(new_data, data, prefix_size);
+  auto* new_header = reinterpret_cast<MessageHeader*>(
+      static_cast<uint8_t*>(new_data) +
+      (reinterpret_cast<uint8_t*>(header) - static_cast<uint8_t*>(data)));
+  new_header->shared_payload_size = static_cast<uint32_t>(user_payload_size);
+  new_message->SetHandles(std::move(handles));
+  return new_message;
+}
+
+// Reverses MoveUserPayloadToSharedMemory() on a received |message| whose
+// user payload is in shared memory, returning a message with the payload
+// inline again. |header| must be within |message|'s payload and |header_size|
+// must run to its end. Returns null if the shared memory can't be mapped.
+Channel::MessagePtr MoveUserPayloadFromSharedMemory(
+    Channel::MessagePtr message,
+    const MessageHeader* header,
+    size_t header_size) {
+  std::vector<ScopedInternalPlatformHandle> handles = message->TakeHandles();
+  if (handles.empty())
+    return nullptr;
+  ScopedInternalPlatformHandle region_handle = std::move(handles.back());
+  handles.pop_back();
+
+  const size_t user_payload_size = header->shared_payload_size;
+  base::ReadOnlySharedMemoryRegion region =
+      base::ReadOnlySharedMemoryRegion::Deserialize(
+          base::subtle::PlatformSharedMemoryRegion::Take(
+              CreateSharedMemoryRegionHandleFromInternalPlatformHandles(
+                  std::move(region_handle), ScopedInternalPlatformHandle()),
+              base::subtle::PlatformSharedMemoryRegion::Mode::kReadOnly,
+              user_payload_size, base::UnguessableToken::Create()));
+  base::ReadOnlySharedMemoryMapping mapping = region.Map();
+  if (!mapping.IsValid())
+    return nullptr;
+
+  void* data;
+  size_t size;
+  NodeChannel::GetEventMessageData(message.get(), &data, &size);
+  const size_t header_offset = reinterpret_cast<const uint8_t*>(header) -
+                               static_cast<const uint8_t*>(data);
+  const size_t prefix_size = header_offset + header_size;
+  DCHECK_EQ(prefix_size, size);
+
+  // The sender may still be able to write to the region, so the payload is
+  // copied out once instead of being read in place. Validation and
+  // deserialization must both see the same bytes.
+  void* new_data;
+  Channel::MessagePtr new_message = NodeChannel::CreateEventMessage(
+      prefix_size + user_payload_size, prefix_size + user_payload_size,
+      &new_data, handles.size());
+  memcpy(new_data, data, prefix_size);
+  memcpy(static_cast<uint8_t*>(new_data) + prefix_size, mapping.memory(),
+         user_payload_size);
+  reinterpret_cast<MessageHeader*>(static_cast<uint8_t*>(new_data) +
+                                   header_offset)
+      ->shared_payload_size = 0;
+  new_message->SetHandles(std::move(handles));
+  return new_message;
+}
+
 base::subtle::Atomic32 g_message_count = 0;
 
 void IncrementMessageCount() {
@@ -381,6 +498,25 @@ std::unique_ptr<UserMessageImpl> UserMessageImpl::CreateFromChannelMessage(
   if (header_size > payload_size)
     return nullptr;
 
+  const size_t shared_payload_size = header->shared_payload_size;
+  if (shared_payload_size) {
+    if (header_size != payload_size ||
+        shared_payload_size > GetConfiguration().max_message_num_bytes) {
+      return nullptr;
+    }
+    const size_t header_offset =
+        static_cast<uint8_t*>(payload) -
+        static_cast<uint8_t*>(channel_message->mutable_payload());
+    channel_message = MoveUserPayloadFromSharedMemory(
+        std::move(channel_message), header, header_size);
+    if (!channel_message)
+      return nullptr;
+    payload = static_cast<uint8_t*>(channel_message->mutable_payload()) +
+              header_offset;
+    payload_size = header_size + shared_payload_size;
+    header = static_cast<MessageHeader*>(payload);
+  }
+
   void* user_payload = static_cast<uint8_t*>(payload) + header_size;
   const size_t user_payload_size = payload_size - header_size;
   return base::WrapUnique(
@@ -398,6 +534,12 @@ Channel::MessagePtr UserMessageImpl::FinalizeEventMessage(
     return nullptr;
 
   Channel::MessagePtr channel_message = std::move(message->channel_message_);
+  if (channel_message &&
+      message->user_payload_size_ >= kMinSharedPayloadSize) {
+    channel_message = MoveUserPayloadToSharedMemory(
+        std::move(channel_message),
+        static_cast<MessageHeader*>(message->header_), message->header_size_);
+  }
   message->user_payload_ = nullptr;
   message->user_payload_size_ = 0;
 
@@ -464,7 +606,8 @@ MojoResult UserMessageImpl::AppendData(uint32_t additional_payload_size,
     Channel::MessagePtr channel_message;
     MojoResult rv = CreateOrExtendSerializedEventMessage(
         message_event_, additional_payload_size,
-        std::max(additional_payload_size, kMinimumPayloadBufferSize),
+        std::max({additional_payload_size, kMinimumPayloadBufferSize,
+                  reserved_payload_capacity_}),
         dispatchers.data(), num_handles, &channel_message, &header_,
         &header_size_, &user_payload_);
     if (num_handles > 0) {
@@ -528,6 +671,31 @@ MojoResult UserMessageImpl::CommitSize() {
   return MOJO_RESULT_OK;
 }
 
+MojoResult UserMessageImpl::ReserveCapacity(uint32_t payload_buffer_size) {
+  if (HasContext())
+    return MOJO_RESULT_FAILED_PRECONDITION;
+
+  if (!IsSerialized()) {
+    reserved_payload_capacity_ =
+        std::max(reserved_payload_capacity_, payload_buffer_size);
+    return MOJO_RESULT_OK;
+  }
+
+  size_t header_offset =
+      static_cast<uint8_t*>(header_) -
+      static_cast<const uint8_t*>(channel_message_->payload());
+  size_t user_payload_offset =
+      static_cast<uint8_t*>(user_payload_) -
+      static_cast<const uint8_t*>(channel_message_->payload());
+  channel_message_->ReservePayloadCapacity(user_payload_offset +
+                                           payload_buffer_size);
+  header_ = static_cast<uint8_t*>(channel_message_->mutable_payload()) +
+            header_offset;
+  user_payload_ = static_cast<uint8_t*>(channel_message_->mutable_payload()) +
+                  user_payload_offset;
+  return MOJO_RESULT_OK;
+}
+
 MojoResult UserMessageImpl::SerializeIfNecessary() {
   if (IsSerialized())
     return MOJO_RESULT_FAILED_PRECONDITION;
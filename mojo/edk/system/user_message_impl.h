@@ -125,6 +125,7 @@ class MOJO_SYSTEM_IMPL_EXPORT UserMessageImpl : public ports::UserMessage {
                         const MojoHandle* handles,
                         uint32_t num_handles);
   MojoResult CommitSize();
+  MojoResult ReserveCapacity(uint32_t payload_buffer_size);
 
   // If this message is not already serialized, this serializes it.
   MojoResult SerializeIfNecessary();
@@ -201,6 +202,10 @@ class MOJO_SYSTEM_IMPL_EXPORT UserMessageImpl : public ports::UserMessage {
   void* user_payload_ = nullptr;
   size_t user_payload_size_ = 0;
 
+  // Payload capacity requested by ReserveCapacity() before the message was
+  // serialized, applied when the first data is appended.
+  uint32_t reserved_payload_capacity_ = 0;
+
   // Handles which have been attached to the serialized message but which have
   // not yet been serialized.
   std::vector<Dispatcher::DispatcherInTransit> pending_handle_attachments_;
@@ -149,6 +149,24 @@ struct MOJO_ALIGNAS(8) MojoAppendMessageDataOptions {
 MOJO_STATIC_ASSERT(sizeof(MojoAppendMessageDataOptions) == 8,
                    "MojoAppendMessageDataOptions has wrong size");
 
+// Flags passed to |MojoReserveMessageCapacity()| via
+// |MojoReserveMessageCapacityOptions|.
+typedef uint32_t MojoReserveMessageCapacityFlags;
+
+// No flags. Default behavior.
+#define MOJO_RESERVE_MESSAGE_CAPACITY_FLAG_NONE ((uint32_t)0)
+
+// Options passed to |MojoReserveMessageCapacity()|.
+struct MOJO_ALIGNAS(8) MojoReserveMessageCapacityOptions {
+  // The size of this structure, used for versioning.
+  uint32_t struct_size;
+
+  // See |MojoReserveMessageCapacityFlags|.
+  MojoReserveMessageCapacityFlags flags;
+};
+MOJO_STATIC_ASSERT(sizeof(MojoReserveMessageCapacityOptions) == 8,
+                   "MojoReserveMessageCapacityOptions has wrong size");
+
 // Flags passed to |MojoGetMessageData()| via |MojoGetMessageDataOptions|.
 typedef uint32_t MojoGetMessageDataFlags;
 
@@ -451,6 +469,27 @@ MojoAppendMessageData(MojoMessageHandle message,
                       void** buffer,
                       uint32_t* buffer_size);
 
+// Ensures that a message's payload buffer can hold at least
+// |payload_buffer_size| bytes, so that subsequent calls to
+// |MojoAppendMessageData()| which stay within that size do not need to
+// reallocate it. This does not change the size of the message payload.
+//
+// May be called before or after data has been appended to |message|.
+//
+// |options| may be null.
+//
+// Returns:
+//   |MOJO_RESULT_OK| upon success. If |buffer_size| is non-null and data has
+//       already been appended to |message|, |*buffer_size| will contain the
+//       resulting storage capacity; otherwise it is set to zero.
+//   |MOJO_RESULT_INVALID_ARGUMENT| if |message| is not a valid message object.
+//   |MOJO_RESULT_FAILED_PRECONDITION| if |message| has a context attached.
+MOJO_SYSTEM_EXPORT MojoResult MojoReserveMessageCapacity(
+    MojoMessageHandle message,
+    uint32_t payload_buffer_size,
+    const struct MojoReserveMessageCapacityOptions* options,
+    uint32_t* buffer_size);
+
 // Retrieves data attached to a message object.
 //
 // |message|: The message.
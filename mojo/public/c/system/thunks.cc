@@ -280,6 +280,15 @@ MojoResult MojoAppendMessageData(MojoMessageHandle message,
                                     options, buffer, buffer_size);
 }
 
+MojoResult MojoReserveMessageCapacity(
+    MojoMessageHandle message,
+    uint32_t payload_buffer_size,
+    const MojoReserveMessageCapacityOptions* options,
+    uint32_t* buffer_size) {
+  return g_thunks.ReserveMessageCapacity(message, payload_buffer_size, options,
+                                         buffer_size);
+}
+
 MojoResult MojoGetMessageData(MojoMessageHandle message,
                               const MojoGetMessageDataOptions* options,
                               void** buffer,
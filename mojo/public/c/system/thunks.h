@@ -214,6 +214,11 @@ struct MojoSystemThunks {
       const struct MojoInvitationTransportEndpoint* transport_endpoint,
       const struct MojoAcceptInvitationOptions* options,
       MojoHandle* invitation_handle);
+  MojoResult (*ReserveMessageCapacity)(
+      MojoMessageHandle message,
+      uint32_t payload_buffer_size,
+      const struct MojoReserveMessageCapacityOptions* options,
+      uint32_t* buffer_size);
 };
 #pragma pack(pop)
 
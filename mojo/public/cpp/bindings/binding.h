@@ -130,6 +130,21 @@ class Binding {
     internal_state_.ResumeIncomingMethodCallProcessing();
   }
 
+  // Lets calls to methods marked urgent overtake other calls which arrived
+  // before them on the pipe, instead of being dispatched in FIFO order. Urgent
+  // calls carry Message::kFlagIsUrgent.
+  //
+  // This method may only be called if the object has been bound to a message
+  // pipe, and the binding won't be unbound afterwards. The interface must not
+  // have sync methods or pass associated interfaces, since those rely on sync
+  // handle watching. See Connector::set_prioritize_urgent_messages().
+  void PrioritizeUrgentMessages() {
+    static_assert(
+        !Interface::HasSyncMethods_ && !Interface::PassesAssociatedKinds_,
+        "Messages on this interface can't be read ahead of dispatch.");
+    internal_state_.PrioritizeUrgentMessages();
+  }
+
   // Blocks the calling sequence until either a call arrives on the previously
   // bound message pipe, the deadline is exceeded, or an error occurs. Returns
   // true if a method was successfully read and dispatched.
@@ -10,6 +10,7 @@
 
 #include "base/callback.h"
 #include "base/compiler_specific.h"
+#include "base/containers/circular_deque.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
 #include "base/optional.h"
@@ -102,6 +103,20 @@ class MOJO_CPP_BINDINGS_EXPORT Connector : public MessageReceiver {
     enforce_errors_from_incoming_receiver_ = enforce;
   }
 
+  // Lets messages flagged with Message::kFlagIsUrgent be dispatched ahead of
+  // non-urgent messages which arrived before them. To find them, the Connector
+  // reads up to |kMaxReadAheadMessages| messages ahead of the one it
+  // dispatches. Off by default, since urgent messages give up FIFO ordering.
+  //
+  // Messages which have been read ahead are not seen by sync handle watching
+  // and are dropped by PassMessagePipe(). This must therefore not be enabled on
+  // pipes which carry sync messages or which may be unbound.
+  void set_prioritize_urgent_messages(bool prioritize) {
+    DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+    DCHECK(!prioritize || !allow_woken_up_by_others_);
+    prioritize_urgent_messages_ = prioritize;
+  }
+
   // Sets the error handler to receive notifications when an error is
   // encountered while reading from the pipe or waiting to read from the pipe.
   void set_connection_error_handler(base::OnceClosure error_handler) {
@@ -211,6 +226,11 @@ class MOJO_CPP_BINDINGS_EXPORT Connector : public MessageReceiver {
   // |this| may have been destroyed in that case.
   WARN_UNUSED_RESULT bool ReadSingleMessage(MojoResult* read_result);
 
+  // Takes the next message to dispatch, either from |read_ahead_messages_| or
+  // from the pipe. Returns the result of reading from the pipe if there is no
+  // message to dispatch.
+  MojoResult ReadNextMessage(Message* message);
+
   // |this| can be destroyed during message dispatch.
   void ReadAllAvailableMessages();
 
@@ -240,6 +260,11 @@ class MOJO_CPP_BINDINGS_EXPORT Connector : public MessageReceiver {
 
   bool paused_ = false;
 
+  // See set_prioritize_urgent_messages().
+  static constexpr size_t kMaxReadAheadMessages = 64;
+  bool prioritize_urgent_messages_ = false;
+  base::circular_deque<Message> read_ahead_messages_;
+
   OutgoingSerializationMode outgoing_serialization_mode_;
   IncomingSerializationMode incoming_serialization_mode_;
 
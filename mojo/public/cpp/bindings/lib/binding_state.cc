@@ -32,6 +32,11 @@ void BindingStateBase::ResumeIncomingMethodCallProcessing() {
   router_->ResumeIncomingMethodCallProcessing();
 }
 
+void BindingStateBase::PrioritizeUrgentMessages() {
+  DCHECK(router_);
+  router_->PrioritizeUrgentMessages();
+}
+
 bool BindingStateBase::WaitForIncomingMethodCall(MojoDeadline deadline) {
   DCHECK(router_);
   return router_->WaitForIncomingMessage(deadline);
@@ -45,6 +45,8 @@ class MOJO_CPP_BINDINGS_EXPORT BindingStateBase {
   void PauseIncomingMethodCallProcessing();
   void ResumeIncomingMethodCallProcessing();
 
+  void PrioritizeUrgentMessages();
+
   bool WaitForIncomingMethodCall(
       MojoDeadline deadline = MOJO_DEADLINE_INDEFINITE);
 
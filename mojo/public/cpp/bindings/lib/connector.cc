@@ -6,6 +6,8 @@
 
 #include <stdint.h>
 
+#include <algorithm>
+
 #include "base/bind.h"
 #include "base/lazy_instance.h"
 #include "base/location.h"
@@ -16,8 +18,10 @@
 #include "base/run_loop.h"
 #include "base/synchronization/lock.h"
 #include "base/threading/thread_local.h"
+#include "base/time/time.h"
 #include "base/trace_event/trace_event.h"
 #include "mojo/public/cpp/bindings/lib/may_auto_lock.h"
+#include "mojo/public/cpp/bindings/message_traffic_stats.h"
 #include "mojo/public/cpp/bindings/mojo_buildflags.h"
 #include "mojo/public/cpp/bindings/sync_handle_watcher.h"
 #include "mojo/public/cpp/system/wait.h"
@@ -187,6 +191,7 @@ ScopedMessagePipeHandle Connector::PassMessagePipe() {
   CancelWait();
   internal::MayAutoLock locker(&lock_);
   ScopedMessagePipeHandle message_pipe = std::move(message_pipe_);
+  read_ahead_messages_.clear();
   weak_factory_.InvalidateWeakPtrs();
   sync_handle_watcher_callback_count_ = 0;
 
@@ -214,10 +219,12 @@ bool Connector::WaitForIncomingMessage(MojoDeadline deadline) {
   DCHECK(deadline == 0 || deadline == MOJO_DEADLINE_INDEFINITE);
 
   MojoResult rv = MOJO_RESULT_UNKNOWN;
-  if (deadline == 0 && !message_pipe_->QuerySignalsState().readable())
+  if (deadline == 0 && read_ahead_messages_.empty() &&
+      !message_pipe_->QuerySignalsState().readable()) {
     return false;
+  }
 
-  if (deadline == MOJO_DEADLINE_INDEFINITE) {
+  if (deadline == MOJO_DEADLINE_INDEFINITE && read_ahead_messages_.empty()) {
     rv = Wait(message_pipe_.get(), MOJO_HANDLE_SIGNAL_READABLE);
     if (rv != MOJO_RESULT_OK) {
       // Users that call WaitForIncomingMessage() should expect their code to be
@@ -274,12 +281,21 @@ bool Connector::Accept(Message* message) {
   if (!message_pipe_.is_valid() || drop_writes_)
     return true;
 
+  MessageTrafficStats* traffic_stats = MessageTrafficStats::Get();
+  const uint32_t message_name = traffic_stats ? message->name() : 0;
+  const size_t message_num_bytes =
+      traffic_stats && message->is_serialized() ? message->data_num_bytes() : 0;
+
   MojoResult rv =
       WriteMessageNew(message_pipe_.get(), message->TakeMojoMessage(),
                       MOJO_WRITE_MESSAGE_FLAG_NONE);
 
   switch (rv) {
     case MOJO_RESULT_OK:
+      if (traffic_stats) {
+        traffic_stats->RecordSent(heap_profiler_tag_, message_name,
+                                  message_num_bytes);
+      }
       break;
     case MOJO_RESULT_FAILED_PRECONDITION:
       // There's no point in continuing to write to this pipe since the other
@@ -310,6 +326,7 @@ bool Connector::Accept(Message* message) {
 }
 
 void Connector::AllowWokenUpBySyncWatchOnSameThread() {
+  DCHECK(!prioritize_urgent_messages_);
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
   allow_woken_up_by_others_ = true;
@@ -396,6 +413,12 @@ void Connector::WaitToReadMore() {
     task_runner_->PostTask(
         FROM_HERE,
         base::Bind(&Connector::OnWatcherHandleReady, weak_self_, rv));
+  } else if (!read_ahead_messages_.empty()) {
+    // The watcher won't notify for messages which have already been read off
+    // the pipe. It is armed again once they have been dispatched.
+    task_runner_->PostTask(
+        FROM_HERE, base::Bind(&Connector::OnWatcherHandleReady, weak_self_,
+                              MOJO_RESULT_OK));
   } else {
     handle_watcher_->ArmOrNotify();
   }
@@ -416,7 +439,7 @@ bool Connector::ReadSingleMessage(MojoResult* read_result) {
   base::WeakPtr<Connector> weak_self = weak_self_;
 
   Message message;
-  const MojoResult rv = ReadMessage(message_pipe_.get(), &message);
+  const MojoResult rv = ReadNextMessage(&message);
   *read_result = rv;
 
   if (rv == MOJO_RESULT_OK) {
@@ -439,8 +462,24 @@ bool Connector::ReadSingleMessage(MojoResult* read_result) {
     TRACE_EVENT0("mojom", heap_profiler_tag_);
 #endif
 
-    receiver_result =
-        incoming_receiver_ && incoming_receiver_->Accept(&message);
+    MessageTrafficStats* traffic_stats = MessageTrafficStats::Get();
+    if (traffic_stats) {
+      // |this| may be destroyed during dispatch, so everything recorded is
+      // read beforehand.
+      const char* interface_name = heap_profiler_tag_;
+      const uint32_t message_name = message.name();
+      const size_t message_num_bytes =
+          message.is_serialized() ? message.data_num_bytes() : 0;
+      const base::TimeTicks dispatch_start = base::TimeTicks::Now();
+      receiver_result =
+          incoming_receiver_ && incoming_receiver_->Accept(&message);
+      traffic_stats->RecordDispatched(interface_name, message_name,
+                                      message_num_bytes,
+                                      base::TimeTicks::Now() - dispatch_start);
+    } else {
+      receiver_result =
+          incoming_receiver_ && incoming_receiver_->Accept(&message);
+    }
 
     if (!weak_self)
       return false;
@@ -463,6 +502,35 @@ bool Connector::ReadSingleMessage(MojoResult* read_result) {
   return true;
 }
 
+MojoResult Connector::ReadNextMessage(Message* message) {
+  if (!prioritize_urgent_messages_ && read_ahead_messages_.empty())
+    return ReadMessage(message_pipe_.get(), message);
+
+  MojoResult rv = MOJO_RESULT_OK;
+  while (prioritize_urgent_messages_ &&
+         read_ahead_messages_.size() < kMaxReadAheadMessages) {
+    Message next;
+    rv = ReadMessage(message_pipe_.get(), &next);
+    if (rv != MOJO_RESULT_OK)
+      break;
+    read_ahead_messages_.push_back(std::move(next));
+  }
+  if (read_ahead_messages_.empty())
+    return rv;
+
+  // Any error reading from the pipe is reported again once the messages read
+  // before it have been dispatched.
+  auto it = std::find_if(read_ahead_messages_.begin(),
+                         read_ahead_messages_.end(), [](const Message& next) {
+                           return next.has_flag(Message::kFlagIsUrgent);
+                         });
+  if (it == read_ahead_messages_.end())
+    it = read_ahead_messages_.begin();
+  *message = std::move(*it);
+  read_ahead_messages_.erase(it);
+  return MOJO_RESULT_OK;
+}
+
 void Connector::ReadAllAvailableMessages() {
   while (!error_) {
     base::WeakPtr<Connector> weak_self = weak_self_;
@@ -9,6 +9,7 @@
 #include <stdlib.h>
 
 #include <algorithm>
+#include <atomic>
 #include <utility>
 
 #include "base/bind.h"
@@ -31,6 +32,33 @@ base::LazyInstance<base::ThreadLocalPointer<internal::MessageDispatchContext>>::
 base::LazyInstance<base::ThreadLocalPointer<SyncMessageResponseContext>>::Leaky
     g_tls_sync_response_context = LAZY_INSTANCE_INITIALIZER;
 
+// Payload sizes of recently serialized messages, indexed by message name. New
+// messages reserve this much capacity up front so their buffer isn't
+// reallocated repeatedly as it's filled in. Names from different interfaces
+// share slots, so this is only an estimate.
+constexpr size_t kNumPayloadSizeHints = 256;
+std::atomic<uint32_t> g_payload_size_hints[kNumPayloadSizeHints];
+
+// Larger messages aren't remembered, bounding the memory a hint taken from an
+// unrelated message can waste.
+constexpr size_t kMaxPayloadSizeHint = 64 * 1024;
+
+void ReservePayloadCapacityFromHint(MojoMessageHandle message, uint32_t name) {
+  uint32_t hint = g_payload_size_hints[name % kNumPayloadSizeHints].load(
+      std::memory_order_relaxed);
+  if (hint) {
+    MojoResult rv = MojoReserveMessageCapacity(message, hint, nullptr, nullptr);
+    DCHECK_EQ(MOJO_RESULT_OK, rv);
+  }
+}
+
+void UpdatePayloadSizeHint(uint32_t name, size_t payload_size) {
+  if (payload_size > kMaxPayloadSizeHint)
+    return;
+  g_payload_size_hints[name % kNumPayloadSizeHints].store(
+      static_cast<uint32_t>(payload_size), std::memory_order_relaxed);
+}
+
 void DoNotifyBadMessage(Message message, const std::string& error) {
   message.NotifyBadMessage(error);
 }
@@ -82,6 +110,7 @@ void CreateSerializedMessageObject(uint32_t name,
   MojoResult rv = mojo::CreateMessage(&handle);
   DCHECK_EQ(MOJO_RESULT_OK, rv);
   DCHECK(handle.is_valid());
+  ReservePayloadCapacityFromHint(handle->value(), name);
 
   void* buffer;
   uint32_t buffer_size;
@@ -117,6 +146,7 @@ void SerializeUnserializedContext(MojoMessageHandle message,
                                   uintptr_t context_value) {
   auto* context =
       reinterpret_cast<internal::UnserializedMessageContext*>(context_value);
+  ReservePayloadCapacityFromHint(message, context->message_name());
   void* buffer;
   uint32_t buffer_size;
   MojoResult attach_result = MojoAppendMessageData(
@@ -151,6 +181,7 @@ void SerializeUnserializedContext(MojoMessageHandle message,
   if (!serialization_context.handles()->empty())
     payload_buffer.AttachHandles(serialization_context.mutable_handles());
   payload_buffer.Seal();
+  UpdatePayloadSizeHint(context->message_name(), payload_buffer.cursor());
 }
 
 void DestroyUnserializedContext(uintptr_t context) {
@@ -351,6 +382,8 @@ ScopedMessageHandle Message::TakeMojoMessage() {
   DCHECK(associated_endpoint_handles_.empty());
   DCHECK(transferable_);
   payload_buffer_.Seal();
+  if (serialized_)
+    UpdatePayloadSizeHint(name(), payload_buffer_.cursor());
   auto handle = std::move(handle_);
   Reset();
   return handle;
@@ -0,0 +1,114 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "mojo/public/cpp/bindings/message_traffic_stats.h"
+
+#include <string.h>
+
+#include <string>
+
+#include "base/no_destructor.h"
+#include "base/strings/stringprintf.h"
+#include "base/trace_event/memory_allocator_dump.h"
+#include "base/trace_event/memory_dump_manager.h"
+#include "base/trace_event/process_memory_dump.h"
+
+namespace mojo {
+
+namespace {
+
+void Accumulate(const MessageTrafficStats::Counters& from,
+                MessageTrafficStats::Counters* to) {
+  to->messages_sent += from.messages_sent;
+  to->bytes_sent += from.bytes_sent;
+  to->messages_received += from.messages_received;
+  to->bytes_received += from.bytes_received;
+  to->dispatch_time += from.dispatch_time;
+}
+
+}  // namespace
+
+// static
+MessageTrafficStats* MessageTrafficStats::instance_ = nullptr;
+
+// static
+void MessageTrafficStats::Enable() {
+  static base::NoDestructor<MessageTrafficStats> stats;
+  instance_ = stats.get();
+}
+
+MessageTrafficStats::MessageTrafficStats() {
+  base::trace_event::MemoryDumpManager::GetInstance()->RegisterDumpProvider(
+      this, "MojoMessageTraffic", nullptr);
+}
+
+MessageTrafficStats::~MessageTrafficStats() = default;
+
+void MessageTrafficStats::RecordSent(const char* interface_name,
+                                     uint32_t message_name,
+                                     size_t num_bytes) {
+  base::AutoLock lock(lock_);
+  Counters& counters = counters_[Key(interface_name, message_name)];
+  ++counters.messages_sent;
+  counters.bytes_sent += num_bytes;
+}
+
+void MessageTrafficStats::RecordDispatched(const char* interface_name,
+                                           uint32_t message_name,
+                                           size_t num_bytes,
+                                           base::TimeDelta dispatch_time) {
+  base::AutoLock lock(lock_);
+  Counters& counters = counters_[Key(interface_name, message_name)];
+  ++counters.messages_received;
+  counters.bytes_received += num_bytes;
+  counters.dispatch_time += dispatch_time;
+}
+
+MessageTrafficStats::Counters MessageTrafficStats::GetCounters(
+    const char* interface_name,
+    uint32_t message_name) {
+  Counters result;
+  base::AutoLock lock(lock_);
+  for (const auto& entry : counters_) {
+    if (entry.first.second == message_name &&
+        strcmp(entry.first.first, interface_name) == 0) {
+      Accumulate(entry.second, &result);
+    }
+  }
+  return result;
+}
+
+bool MessageTrafficStats::OnMemoryDump(
+    const base::trace_event::MemoryDumpArgs& args,
+    base::trace_event::ProcessMemoryDump* pmd) {
+  std::map<std::string, Counters> merged_counters;
+  {
+    base::AutoLock lock(lock_);
+    for (const auto& entry : counters_) {
+      std::string dump_name =
+          base::StringPrintf("mojo/traffic/%s/%u", entry.first.first,
+                             entry.first.second);
+      Accumulate(entry.second, &merged_counters[dump_name]);
+    }
+  }
+
+  using base::trace_event::MemoryAllocatorDump;
+  for (const auto& entry : merged_counters) {
+    const Counters& counters = entry.second;
+    MemoryAllocatorDump* dump = pmd->CreateAllocatorDump(entry.first);
+    dump->AddScalar("messages_sent", MemoryAllocatorDump::kUnitsObjects,
+                    counters.messages_sent);
+    dump->AddScalar("bytes_sent", MemoryAllocatorDump::kUnitsBytes,
+                    counters.bytes_sent);
+    dump->AddScalar("messages_received", MemoryAllocatorDump::kUnitsObjects,
+                    counters.messages_received);
+    dump->AddScalar("bytes_received", MemoryAllocatorDump::kUnitsBytes,
+                    counters.bytes_received);
+    dump->AddScalar("dispatch_time_us", MemoryAllocatorDump::kUnitsObjects,
+                    counters.dispatch_time.InMicroseconds());
+  }
+  return true;
+}
+
+}  // namespace mojo
@@ -134,6 +134,12 @@ class MOJO_CPP_BINDINGS_EXPORT MultiplexRouter
   void PauseIncomingMethodCallProcessing();
   void ResumeIncomingMethodCallProcessing();
 
+  // See Connector::set_prioritize_urgent_messages().
+  void PrioritizeUrgentMessages() {
+    DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+    connector_.set_prioritize_urgent_messages(true);
+  }
+
   // Whether there are any associated interfaces running currently.
   bool HasAssociatedEndpoints() const;
 
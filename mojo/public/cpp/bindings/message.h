@@ -40,6 +40,10 @@ class COMPONENT_EXPORT(MOJO_CPP_BINDINGS_BASE) Message {
   static const uint32_t kFlagExpectsResponse = 1 << 0;
   static const uint32_t kFlagIsResponse = 1 << 1;
   static const uint32_t kFlagIsSync = 1 << 2;
+  // Lets the message overtake non-urgent messages which were sent before it
+  // on the same pipe, if the receiver has opted in. See
+  // Connector::set_prioritize_urgent_messages().
+  static const uint32_t kFlagIsUrgent = 1 << 3;
 
   // Constructs an uninitialized Message object.
   Message();
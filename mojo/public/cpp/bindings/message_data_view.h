@@ -0,0 +1,98 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MOJO_PUBLIC_CPP_BINDINGS_MESSAGE_DATA_VIEW_H_
+#define MOJO_PUBLIC_CPP_BINDINGS_MESSAGE_DATA_VIEW_H_
+
+#include <memory>
+#include <utility>
+
+#include "base/logging.h"
+#include "base/macros.h"
+#include "mojo/public/cpp/bindings/lib/bindings_internal.h"
+#include "mojo/public/cpp/bindings/lib/serialization.h"
+#include "mojo/public/cpp/bindings/lib/serialization_context.h"
+#include "mojo/public/cpp/bindings/message.h"
+
+namespace mojo {
+
+// Owns a received message together with a DataView over a struct serialized
+// within it, so that a handler can read individual fields straight out of the
+// message buffer instead of having the whole struct deserialized up front.
+// Fields are only deserialized when read through the DataView, or all at once
+// by Deserialize().
+//
+// Unlike a bare DataView, which must not outlive the message it points into,
+// a MessageDataView may be moved around and kept for as long as needed.
+//
+// Example:
+//
+//   void OnLargeStruct(MessageDataView<LargeStructDataView> params) {
+//     if (params->id() != expected_id_)
+//       return;
+//     LargeStructPtr full;
+//     if (!params.Deserialize(&full))
+//       ...
+//   }
+template <typename DataViewType>
+class MessageDataView {
+ public:
+  using Data = typename internal::MojomTypeTraits<DataViewType>::Data;
+
+  MessageDataView() = default;
+
+  // |data| must point to a validated struct within |message|'s payload. Takes
+  // ownership of |message| and of any handles attached to it.
+  MessageDataView(Message message, Data* data)
+      : message_(std::move(message)),
+        context_(std::make_unique<internal::SerializationContext>()),
+        data_(data),
+        view_(data, context_.get()) {
+    DCHECK(data_);
+    context_->TakeHandlesFromMessage(&message_);
+  }
+
+  MessageDataView(MessageDataView&& other) = default;
+  MessageDataView& operator=(MessageDataView&& other) = default;
+
+  ~MessageDataView() = default;
+
+  bool is_null() const { return !data_; }
+
+  DataViewType& operator*() {
+    DCHECK(!is_null());
+    return view_;
+  }
+  DataViewType* operator->() {
+    DCHECK(!is_null());
+    return &view_;
+  }
+
+  const Message& message() const { return message_; }
+
+  // Deserializes the whole struct into |output|, as a handler taking
+  // |UserType| would have received it. Handles can only be taken once, so
+  // this should not be mixed with Take*() calls on the DataView.
+  template <typename UserType>
+  bool Deserialize(UserType* output) {
+    DCHECK(!is_null());
+    return internal::Deserialize<DataViewType>(data_, output, context_.get());
+  }
+
+ private:
+  Message message_;
+
+  // Heap-allocated so that its address, which |view_| holds on to, survives
+  // moves.
+  std::unique_ptr<internal::SerializationContext> context_;
+
+  Data* data_ = nullptr;
+  DataViewType view_;
+
+  DISALLOW_COPY_AND_ASSIGN(MessageDataView);
+};
+
+}  // namespace mojo
+
+#endif  // MOJO_PUBLIC_CPP_BINDINGS_MESSAGE_DATA_VIEW_H_
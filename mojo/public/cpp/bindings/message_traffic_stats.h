@@ -0,0 +1,87 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MOJO_PUBLIC_CPP_BINDINGS_MESSAGE_TRAFFIC_STATS_H_
+#define MOJO_PUBLIC_CPP_BINDINGS_MESSAGE_TRAFFIC_STATS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <map>
+#include <utility>
+
+#include "base/macros.h"
+#include "base/synchronization/lock.h"
+#include "base/time/time.h"
+#include "base/trace_event/memory_dump_provider.h"
+#include "mojo/public/cpp/bindings/bindings_export.h"
+
+namespace base {
+template <typename T>
+class NoDestructor;
+}
+
+namespace mojo {
+
+// Opt-in accounting of the messages, bytes and dispatch time moved through
+// each Connector, broken down by interface and message name. Once enabled,
+// the counts are reported in memory-infra traces under "mojo/traffic/".
+//
+// Messages for associated interfaces are counted against the interface which
+// owns their message pipe. Bytes are only counted for serialized messages, so
+// messages passed within a process without serialization count as zero bytes.
+class MOJO_CPP_BINDINGS_EXPORT MessageTrafficStats
+    : public base::trace_event::MemoryDumpProvider {
+ public:
+  struct Counters {
+    uint64_t messages_sent = 0;
+    uint64_t bytes_sent = 0;
+    uint64_t messages_received = 0;
+    uint64_t bytes_received = 0;
+    base::TimeDelta dispatch_time;
+  };
+
+  // Starts counting. Counting can't be turned off again.
+  static void Enable();
+
+  // Returns the process-wide instance, or null if counting is not enabled.
+  static MessageTrafficStats* Get() { return instance_; }
+
+  void RecordSent(const char* interface_name,
+                  uint32_t message_name,
+                  size_t num_bytes);
+  void RecordDispatched(const char* interface_name,
+                        uint32_t message_name,
+                        size_t num_bytes,
+                        base::TimeDelta dispatch_time);
+
+  // Returns the counts for |interface_name| and |message_name|, summed over
+  // every Connector using that name.
+  Counters GetCounters(const char* interface_name, uint32_t message_name);
+
+  // base::trace_event::MemoryDumpProvider:
+  bool OnMemoryDump(const base::trace_event::MemoryDumpArgs& args,
+                    base::trace_event::ProcessMemoryDump* pmd) override;
+
+ private:
+  friend class base::NoDestructor<MessageTrafficStats>;
+
+  // Interface names are static strings, so entries are keyed by address to
+  // keep recording cheap. Entries with equal names are merged when reported.
+  using Key = std::pair<const char*, uint32_t>;
+
+  MessageTrafficStats();
+  ~MessageTrafficStats() override;
+
+  static MessageTrafficStats* instance_;
+
+  base::Lock lock_;
+  std::map<Key, Counters> counters_;
+
+  DISALLOW_COPY_AND_ASSIGN(MessageTrafficStats);
+};
+
+}  // namespace mojo
+
+#endif  // MOJO_PUBLIC_CPP_BINDINGS_MESSAGE_TRAFFIC_STATS_H_
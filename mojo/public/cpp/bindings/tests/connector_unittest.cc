@@ -17,6 +17,7 @@
 #include "base/threading/thread.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "mojo/public/cpp/bindings/message.h"
+#include "mojo/public/cpp/bindings/message_traffic_stats.h"
 #include "mojo/public/cpp/bindings/tests/message_queue.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -138,6 +139,70 @@ TEST_F(ConnectorTest, Basic) {
       std::string(reinterpret_cast<const char*>(message_received.payload())));
 }
 
+TEST_F(ConnectorTest, TrafficStats) {
+  MessageTrafficStats::Enable();
+  MessageTrafficStats* stats = MessageTrafficStats::Get();
+  ASSERT_TRUE(stats);
+
+  // Counts are process-wide, so use a name no other test does.
+  const char kInterfaceName[] = "ConnectorTest.TrafficStats";
+  Connector connector0(std::move(handle0_), Connector::SINGLE_THREADED_SEND,
+                       base::ThreadTaskRunnerHandle::Get());
+  Connector connector1(std::move(handle1_), Connector::SINGLE_THREADED_SEND,
+                       base::ThreadTaskRunnerHandle::Get());
+  connector0.SetWatcherHeapProfilerTag(kInterfaceName);
+  connector1.SetWatcherHeapProfilerTag(kInterfaceName);
+
+  Message message = CreateMessage("hello world");
+  const size_t message_size = message.data_num_bytes();
+  connector0.Accept(&message);
+
+  base::RunLoop run_loop;
+  MessageAccumulator accumulator(run_loop.QuitClosure());
+  connector1.set_incoming_receiver(&accumulator);
+  run_loop.Run();
+
+  // CreateMessage() always uses message name 1.
+  MessageTrafficStats::Counters counters =
+      stats->GetCounters(kInterfaceName, 1);
+  EXPECT_EQ(1u, counters.messages_sent);
+  EXPECT_EQ(message_size, counters.bytes_sent);
+  EXPECT_EQ(1u, counters.messages_received);
+  EXPECT_EQ(message_size, counters.bytes_received);
+  EXPECT_EQ(0u, stats->GetCounters(kInterfaceName, 2).messages_sent);
+}
+
+TEST_F(ConnectorTest, UrgentMessagesOvertake) {
+  Connector connector0(std::move(handle0_), Connector::SINGLE_THREADED_SEND,
+                       base::ThreadTaskRunnerHandle::Get());
+  Connector connector1(std::move(handle1_), Connector::SINGLE_THREADED_SEND,
+                       base::ThreadTaskRunnerHandle::Get());
+  connector1.set_prioritize_urgent_messages(true);
+
+  const char* const kTexts[] = {"first", "second", "urgent"};
+  for (const char* text : kTexts) {
+    const size_t size = strlen(text) + 1;
+    const uint32_t flags =
+        strcmp(text, "urgent") == 0 ? Message::kFlagIsUrgent : 0;
+    Message message(1, flags, size, 0, nullptr);
+    memcpy(message.payload_buffer()->AllocateAndGet(size), text, size);
+    connector0.Accept(&message);
+  }
+
+  MessageAccumulator accumulator;
+  connector1.set_incoming_receiver(&accumulator);
+  base::RunLoop().RunUntilIdle();
+
+  ASSERT_EQ(3u, accumulator.size());
+  for (const char* expected : {"urgent", "first", "second"}) {
+    Message message_received;
+    accumulator.Pop(&message_received);
+    EXPECT_EQ(std::string(expected),
+              std::string(
+                  reinterpret_cast<const char*>(message_received.payload())));
+  }
+}
+
 TEST_F(ConnectorTest, Basic_Synchronous) {
   Connector connector0(std::move(handle0_), Connector::SINGLE_THREADED_SEND,
                        base::ThreadTaskRunnerHandle::Get());
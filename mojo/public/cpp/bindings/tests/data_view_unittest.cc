@@ -11,6 +11,7 @@
 #include "mojo/public/cpp/bindings/binding.h"
 #include "mojo/public/cpp/bindings/lib/fixed_buffer.h"
 #include "mojo/public/cpp/bindings/lib/serialization.h"
+#include "mojo/public/cpp/bindings/message_data_view.h"
 #include "mojo/public/interfaces/bindings/tests/test_data_view.mojom.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -297,6 +298,34 @@ TEST_F(DataViewTest, UnionArray) {
   EXPECT_EQ(1024, union_ptr2->get_f_int32());
 }
 
+TEST_F(DataViewTest, MessageDataView) {
+  TestStructPtr obj(TestStruct::New());
+  obj->f_string = "hello";
+  obj->f_struct = NestedStruct::New();
+  obj->f_struct->f_int32 = 42;
+
+  Message message(0, 0, 0, 0, nullptr);
+  internal::TestStruct_Data::BufferWriter writer;
+  internal::SerializationContext context;
+  mojo::internal::Serialize<TestStructDataView>(
+      obj, message.payload_buffer(), &writer, &context);
+  MessageDataView<TestStructDataView> view(std::move(message), writer.data());
+
+  // The view owns the message, so it remains readable after being moved.
+  MessageDataView<TestStructDataView> moved_view = std::move(view);
+  ASSERT_FALSE(moved_view.is_null());
+
+  NestedStructDataView struct_data_view;
+  moved_view->GetFStructDataView(&struct_data_view);
+  ASSERT_FALSE(struct_data_view.is_null());
+  EXPECT_EQ(42, struct_data_view.f_int32());
+
+  TestStructPtr output;
+  ASSERT_TRUE(moved_view.Deserialize(&output));
+  EXPECT_EQ("hello", output->f_string);
+  EXPECT_EQ(42, output->f_struct->f_int32);
+}
+
 }  // namespace data_view
 }  // namespace test
 }  // namespace mojo
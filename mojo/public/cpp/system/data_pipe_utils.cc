@@ -2,6 +2,9 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <string.h>
+
+#include <algorithm>
 #include <utility>
 
 #include "base/bind.h"
@@ -92,4 +95,42 @@ BlockingCopyFromString(const std::string& source,
   }
 }
 
+MojoResult WriteDataSegments(const ScopedDataPipeProducerHandle& destination,
+                             const std::vector<base::StringPiece>& segments,
+                             size_t* num_bytes_written) {
+  *num_bytes_written = 0;
+  size_t segment = 0;
+  size_t segment_offset = 0;
+  while (segment < segments.size()) {
+    void* buffer = nullptr;
+    uint32_t buffer_num_bytes = 0;
+    MojoResult result = destination->BeginWriteData(
+        &buffer, &buffer_num_bytes, MOJO_BEGIN_WRITE_DATA_FLAG_NONE);
+    if (result != MOJO_RESULT_OK)
+      return *num_bytes_written ? MOJO_RESULT_OK : result;
+
+    char* char_buffer = static_cast<char*>(buffer);
+    uint32_t byte_index = 0;
+    while (segment < segments.size() && byte_index < buffer_num_bytes) {
+      const base::StringPiece& data = segments[segment];
+      const size_t num_bytes = std::min<size_t>(
+          data.size() - segment_offset, buffer_num_bytes - byte_index);
+      memcpy(char_buffer + byte_index, data.data() + segment_offset,
+             num_bytes);
+      byte_index += num_bytes;
+      segment_offset += num_bytes;
+      if (segment_offset == data.size()) {
+        ++segment;
+        segment_offset = 0;
+      }
+    }
+
+    result = destination->EndWriteData(byte_index);
+    if (result != MOJO_RESULT_OK)
+      return result;
+    *num_bytes_written += byte_index;
+  }
+  return MOJO_RESULT_OK;
+}
+
 }  // namespace mojo
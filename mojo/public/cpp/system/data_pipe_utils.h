@@ -5,9 +5,13 @@
 #ifndef MOJO_PUBLIC_CPP_SYSTEM_DATA_PIPE_UTILS_H_
 #define MOJO_PUBLIC_CPP_SYSTEM_DATA_PIPE_UTILS_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include <string>
+#include <vector>
+
+#include "base/strings/string_piece.h"
 
 #include "mojo/public/cpp/system/data_pipe.h"
 #include "mojo/public/cpp/system/system_export.h"
@@ -25,6 +29,17 @@ bool MOJO_CPP_SYSTEM_EXPORT
 BlockingCopyFromString(const std::string& source,
                        const ScopedDataPipeProducerHandle& destination);
 
+// Writes as much of the concatenation of |segments| as fits into |destination|
+// without waiting. Segments are gathered into one two-phase write per
+// contiguous region of the pipe's buffer, rather than one write per segment,
+// so the consumer is notified at most twice. |destination| must have an
+// element size of 1. Sets |*num_bytes_written| and returns MOJO_RESULT_OK if
+// anything was written, or else the result of BeginWriteData().
+MojoResult MOJO_CPP_SYSTEM_EXPORT
+WriteDataSegments(const ScopedDataPipeProducerHandle& destination,
+                  const std::vector<base::StringPiece>& segments,
+                  size_t* num_bytes_written);
+
 }  // namespace mojo
 
 #endif  // MOJO_PUBLIC_CPP_SYSTEM_DATA_PIPE_UTILS_H_
@@ -0,0 +1,85 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "mojo/public/cpp/system/data_pipe_utils.h"
+
+#include <string>
+#include <vector>
+
+#include "base/strings/string_piece.h"
+#include "mojo/public/cpp/system/data_pipe.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace mojo {
+namespace {
+
+const uint32_t kCapacity = 16;
+
+std::string ReadAll(const ScopedDataPipeConsumerHandle& consumer) {
+  char buffer[kCapacity];
+  uint32_t num_bytes = sizeof(buffer);
+  if (consumer->ReadData(buffer, &num_bytes, MOJO_READ_DATA_FLAG_NONE) !=
+      MOJO_RESULT_OK) {
+    return std::string();
+  }
+  return std::string(buffer, num_bytes);
+}
+
+TEST(DataPipeUtilsTest, WriteDataSegmentsStopsWhenFull) {
+  DataPipe pipe(kCapacity);
+
+  size_t num_bytes_written = 0;
+  EXPECT_EQ(MOJO_RESULT_OK,
+            WriteDataSegments(pipe.producer_handle,
+                              {"0123456789", "", "abcdefghij"},
+                              &num_bytes_written));
+  EXPECT_EQ(kCapacity, num_bytes_written);
+  EXPECT_EQ("0123456789abcdef", ReadAll(pipe.consumer_handle));
+
+  EXPECT_EQ(MOJO_RESULT_OK, WriteDataSegments(pipe.producer_handle,
+                                              {"ghij"}, &num_bytes_written));
+  EXPECT_EQ(4u, num_bytes_written);
+  EXPECT_EQ(MOJO_RESULT_OK, WriteDataSegments(pipe.producer_handle,
+                                              {std::string(kCapacity, 'x')},
+                                              &num_bytes_written));
+  EXPECT_EQ(kCapacity - 4, num_bytes_written);
+  EXPECT_EQ(MOJO_RESULT_SHOULD_WAIT,
+            WriteDataSegments(pipe.producer_handle, {"x"},
+                              &num_bytes_written));
+  EXPECT_EQ(0u, num_bytes_written);
+}
+
+TEST(DataPipeUtilsTest, WriteDataSegmentsWrapsAround) {
+  DataPipe pipe(kCapacity);
+
+  size_t num_bytes_written = 0;
+  ASSERT_EQ(MOJO_RESULT_OK,
+            WriteDataSegments(pipe.producer_handle, {"0123456789"},
+                              &num_bytes_written));
+  EXPECT_EQ("0123456789", ReadAll(pipe.consumer_handle));
+
+  // Only six bytes remain before the end of the ring buffer.
+  EXPECT_EQ(MOJO_RESULT_OK,
+            WriteDataSegments(pipe.producer_handle, {"abcd", "efgh", "ijkl"},
+                              &num_bytes_written));
+  EXPECT_EQ(12u, num_bytes_written);
+
+  std::string data = ReadAll(pipe.consumer_handle);
+  data += ReadAll(pipe.consumer_handle);
+  EXPECT_EQ("abcdefghijkl", data);
+}
+
+TEST(DataPipeUtilsTest, WriteDataSegmentsAfterConsumerClosed) {
+  DataPipe pipe(kCapacity);
+  pipe.consumer_handle.reset();
+
+  size_t num_bytes_written = 0;
+  EXPECT_EQ(MOJO_RESULT_FAILED_PRECONDITION,
+            WriteDataSegments(pipe.producer_handle, {"abc"},
+                              &num_bytes_written));
+  EXPECT_EQ(0u, num_bytes_written);
+}
+
+}  // namespace
+}  // namespace mojo
@@ -84,6 +84,7 @@
 // definition and roughly the same as Firefox's definition.
 
 #include <stdint.h>
+#include <string.h>
 #include <string>
 
 #include "net/base/mime_sniffer.h"
@@ -857,9 +858,31 @@ bool LooksLikeBinary(const char* content, size_t size) {
   // represents byte 0x1F.
   const uint32_t kBinaryBits =
       ~(1u << '\t' | 1u << '\n' | 1u << '\r' | 1u << '\f' | 1u << '\x1b');
-  for (size_t i = 0; i < size; ++i) {
-    uint8_t byte = static_cast<uint8_t>(content[i]);
-    if (byte < 0x20 && (kBinaryBits & (1u << byte)))
+  auto is_binary_byte = [kBinaryBits](char c) {
+    uint8_t byte = static_cast<uint8_t>(c);
+    return byte < 0x20 && (kBinaryBits & (1u << byte));
+  };
+
+  // Most sniffed content is text, which has few bytes < 0x20, so check eight
+  // bytes at a time whether any of them is < 0x20, and only look at the
+  // individual bytes of the words where one is. For each byte, the expression
+  // below sets the high bit if the byte is < 0x20 (a borrow from a lower byte
+  // can also set it, but only if there is a byte < 0x20 in the word already).
+  const uint64_t kOnes = 0x0101010101010101;
+  const uint64_t kHighBits = 0x8080808080808080;
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, content + i, sizeof(word));
+    if (((word - kOnes * 0x20) & ~word & kHighBits) == 0)
+      continue;
+    for (size_t j = i; j < i + sizeof(uint64_t); ++j) {
+      if (is_binary_byte(content[j]))
+        return true;
+    }
+  }
+  for (; i < size; ++i) {
+    if (is_binary_byte(content[i]))
       return true;
   }
   return false;
@@ -519,5 +519,25 @@ INSTANTIATE_TEST_CASE_P(MimeSnifferControlCodesEdgeCaseTest,
                                "_\x02_"   // a byte in the middle is binary
                                ));
 
+// LooksLikeBinary() checks several bytes at a time, so check that every byte
+// value is classified correctly at every position in a word, and next to
+// bytes that could affect the check of a word.
+TEST(MimeSnifferTest, LooksLikeBinaryAtEveryOffset) {
+  const char kNeighbors[] = {'a', '\n', '\x7f', '\x80', '\xff'};
+  for (char neighbor : kNeighbors) {
+    for (int value = 0; value < 0x100; ++value) {
+      char byte = static_cast<char>(value);
+      bool expected = value < 0x20 && value != '\t' && value != '\n' &&
+                      value != '\r' && value != '\f' && value != '\x1b';
+      for (size_t offset = 0; offset < 24; ++offset) {
+        std::string content(24, neighbor);
+        content[offset] = byte;
+        EXPECT_EQ(expected, LooksLikeBinary(content.data(), content.size()))
+            << "value " << value << " at offset " << offset;
+      }
+    }
+  }
+}
+
 }  // namespace
 }  // namespace net
@@ -9,11 +9,22 @@
 #include "base/macros.h"
 #include "base/message_loop/message_loop.h"
 #include "base/threading/thread.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "net/base/address_tracker_linux.h"
 #include "net/dns/dns_config_service.h"
 
 namespace net {
 
+namespace {
+
+// A network switch produces a burst of netlink messages, e.g. one per address
+// removed and added. IP address changes are coalesced over this window, so
+// that observers close idle sockets and flush caches once per switch.
+const int kIPAddressChangeCoalescingWindowMs = 250;
+
+}  // namespace
+
 class NetworkChangeNotifierLinux::Thread : public base::Thread {
  public:
   explicit Thread(const std::unordered_set<std::string>& ignored_interfaces);
@@ -37,7 +48,13 @@ class NetworkChangeNotifierLinux::Thread : public base::Thread {
  private:
   void OnIPAddressChanged();
   void OnLinkChanged();
+  // Notifies observers of the IP address changes coalesced by
+  // |ip_address_change_timer_|.
+  void NotifyIPAddressChanged();
   std::unique_ptr<DnsConfigService> dns_config_service_;
+  // Running while IP address changes are being coalesced. Created on the
+  // notifier thread.
+  std::unique_ptr<base::OneShotTimer> ip_address_change_timer_;
   // Used to detect online/offline state and IP address changes.
   std::unique_ptr<internal::AddressTrackerLinux> address_tracker_;
   NetworkChangeNotifier::ConnectionType last_type_;
@@ -62,6 +79,7 @@ NetworkChangeNotifierLinux::Thread::~Thread() {
 }
 
 void NetworkChangeNotifierLinux::Thread::Init() {
+  ip_address_change_timer_ = std::make_unique<base::OneShotTimer>();
   address_tracker_->Init();
   dns_config_service_ = DnsConfigService::CreateSystemService();
   dns_config_service_->WatchConfig(
@@ -74,15 +92,28 @@ void NetworkChangeNotifierLinux::Thread::CleanUp() {
   // MessageLoop.
   address_tracker_.reset();
   dns_config_service_.reset();
+  ip_address_change_timer_.reset();
 }
 
 void NetworkChangeNotifierLinux::Thread::OnIPAddressChanged() {
-  NetworkChangeNotifier::NotifyObserversOfIPAddressChange();
+  // Changes that arrive while the timer runs are covered by the notification
+  // it will send.
+  if (!ip_address_change_timer_->IsRunning()) {
+    ip_address_change_timer_->Start(
+        FROM_HERE,
+        base::TimeDelta::FromMilliseconds(kIPAddressChangeCoalescingWindowMs),
+        base::Bind(&NetworkChangeNotifierLinux::Thread::NotifyIPAddressChanged,
+                   base::Unretained(this)));
+  }
   // When the IP address of a network interface is added/deleted, the
   // connection type may have changed.
   OnLinkChanged();
 }
 
+void NetworkChangeNotifierLinux::Thread::NotifyIPAddressChanged() {
+  NetworkChangeNotifier::NotifyObserversOfIPAddressChange();
+}
+
 void NetworkChangeNotifierLinux::Thread::OnLinkChanged() {
   if (last_type_ != GetCurrentConnectionType()) {
     NetworkChangeNotifier::NotifyObserversOfConnectionTypeChange();
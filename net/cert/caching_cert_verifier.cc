@@ -6,6 +6,7 @@
 
 #include "base/time/time.h"
 #include "net/base/net_errors.h"
+#include "net/cert/crl_set.h"
 
 namespace net {
 
@@ -41,9 +42,13 @@ int CachingCertVerifier::Verify(const CertVerifier::RequestParams& params,
 
   requests_++;
 
+  // CRLSets are only ever replaced by newer ones, so a result verified against
+  // an older CRLSet may miss a revocation. Results verified against a newer
+  // CRLSet, e.g. by a request that raced with the update, are still usable.
+  uint32_t crl_set_sequence = crl_set ? crl_set->sequence() : 0;
   const CertVerificationCache::value_type* cached_entry =
       cache_.Get(params, CacheValidityPeriod(base::Time::Now()));
-  if (cached_entry) {
+  if (cached_entry && cached_entry->crl_set_sequence >= crl_set_sequence) {
     ++cache_hits_;
     *verify_result = cached_entry->result;
     return cached_entry->error;
@@ -52,12 +57,13 @@ int CachingCertVerifier::Verify(const CertVerifier::RequestParams& params,
   base::Time start_time = base::Time::Now();
   CompletionCallback caching_callback = base::Bind(
       &CachingCertVerifier::OnRequestFinished, base::Unretained(this), params,
-      start_time, callback, verify_result);
+      crl_set_sequence, start_time, callback, verify_result);
   int result = verifier_->Verify(params, crl_set, verify_result,
                                  caching_callback, out_req, net_log);
   if (result != ERR_IO_PENDING) {
     // Synchronous completion; add directly to cache.
-    AddResultToCache(params, start_time, *verify_result, result);
+    AddResultToCache(params, crl_set_sequence, start_time, *verify_result,
+                     result);
   }
 
   return result;
@@ -81,12 +87,14 @@ bool CachingCertVerifier::AddEntry(const RequestParams& params,
   if (entry)
     return false;
 
-  // Otherwise, go and add it.
-  AddResultToCache(params, verification_time, verify_result, error);
+  // Otherwise, go and add it. The CRLSet the result was verified against is
+  // not known, so it is replaced as soon as any CRLSet is in effect.
+  AddResultToCache(params, 0, verification_time, verify_result, error);
   return true;
 }
 
-CachingCertVerifier::CachedResult::CachedResult() : error(ERR_FAILED) {}
+CachingCertVerifier::CachedResult::CachedResult()
+    : error(ERR_FAILED), crl_set_sequence(0) {}
 
 CachingCertVerifier::CachedResult::~CachedResult() = default;
 
@@ -134,11 +142,13 @@ bool CachingCertVerifier::CacheExpirationFunctor::operator()(
 };
 
 void CachingCertVerifier::OnRequestFinished(const RequestParams& params,
+                                            uint32_t crl_set_sequence,
                                             base::Time start_time,
                                             const CompletionCallback& callback,
                                             CertVerifyResult* verify_result,
                                             int error) {
-  AddResultToCache(params, start_time, *verify_result, error);
+  AddResultToCache(params, crl_set_sequence, start_time, *verify_result,
+                   error);
 
   // Now chain to the user's callback, which may delete |this|.
   callback.Run(error);
@@ -146,6 +156,7 @@ void CachingCertVerifier::OnRequestFinished(const RequestParams& params,
 
 void CachingCertVerifier::AddResultToCache(
     const RequestParams& params,
+    uint32_t crl_set_sequence,
     base::Time start_time,
     const CertVerifyResult& verify_result,
     int error) {
@@ -175,6 +186,7 @@ void CachingCertVerifier::AddResultToCache(
   CachedResult cached_result;
   cached_result.error = error;
   cached_result.result = verify_result;
+  cached_result.crl_set_sequence = crl_set_sequence;
   cache_.Put(
       params, cached_result, CacheValidityPeriod(start_time),
       CacheValidityPeriod(start_time,
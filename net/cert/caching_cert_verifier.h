@@ -5,6 +5,8 @@
 #ifndef NET_CERT_CACHING_CERT_VERIFIER_H_
 #define NET_CERT_CACHING_CERT_VERIFIER_H_
 
+#include <stdint.h>
+
 #include <memory>
 
 #include "net/base/expiring_cache.h"
@@ -31,6 +33,10 @@ namespace net {
 // tries to balance the implementation complexity of needing to monitor the
 // above for meaningful changes and the practical utility of being able to
 // cache results when they're not expected to change.
+//
+// Results also record the sequence number of the CRLSet they were verified
+// against, and a result is not reused once a newer CRLSet is in effect, as it
+// may revoke the certificate.
 class NET_EXPORT CachingCertVerifier : public CertVerifier,
                                        public CertDatabase::Observer {
  public:
@@ -89,6 +95,7 @@ class NET_EXPORT CachingCertVerifier : public CertVerifier,
   FRIEND_TEST_ALL_PREFIXES(CachingCertVerifierTest, Visitor);
   FRIEND_TEST_ALL_PREFIXES(CachingCertVerifierTest, AddsEntries);
   FRIEND_TEST_ALL_PREFIXES(CachingCertVerifierTest, DifferentCACerts);
+  FRIEND_TEST_ALL_PREFIXES(CachingCertVerifierTest, NewerCRLSet);
 
   // CachedResult contains the result of a certificate verification.
   struct NET_EXPORT_PRIVATE CachedResult {
@@ -97,6 +104,9 @@ class NET_EXPORT CachingCertVerifier : public CertVerifier,
 
     int error;                // The return value of CertVerifier::Verify.
     CertVerifyResult result;  // The output of CertVerifier::Verify.
+    // The sequence number of the CRLSet passed to CertVerifier::Verify, or 0
+    // if there was none.
+    uint32_t crl_set_sequence;
   };
 
   // Rather than having a single validity point along a monotonically increasing
@@ -127,18 +137,22 @@ class NET_EXPORT CachingCertVerifier : public CertVerifier,
                                               CacheExpirationFunctor>;
 
   // Handles completion of the request matching |params|, which started at
-  // |start_time|, completing. |verify_result| and |result| are added to the
-  // cache, and then |callback| (the original caller's callback) is invoked.
+  // |start_time| against the CRLSet with |crl_set_sequence|, completing.
+  // |verify_result| and |result| are added to the cache, and then |callback|
+  // (the original caller's callback) is invoked.
   void OnRequestFinished(const RequestParams& params,
+                         uint32_t crl_set_sequence,
                          base::Time start_time,
                          const CompletionCallback& callback,
                          CertVerifyResult* verify_result,
                          int error);
 
   // Adds |verify_result| and |error| to the cache for |params|, whose
-  // verification attempt began at |start_time|. See the implementation
-  // for more details about the necessity of |start_time|.
+  // verification attempt against the CRLSet with |crl_set_sequence| began at
+  // |start_time|. See the implementation for more details about the necessity
+  // of |start_time|.
   void AddResultToCache(const RequestParams& params,
+                        uint32_t crl_set_sequence,
                         base::Time start_time,
                         const CertVerifyResult& verify_result,
                         int error);
@@ -6,10 +6,12 @@
 
 #include "base/files/file_path.h"
 #include "base/memory/ref_counted.h"
+#include "base/strings/stringprintf.h"
 #include "net/base/net_errors.h"
 #include "net/base/test_completion_callback.h"
 #include "net/cert/cert_verifier.h"
 #include "net/cert/cert_verify_result.h"
+#include "net/cert/crl_set.h"
 #include "net/cert/mock_cert_verifier.h"
 #include "net/cert/x509_certificate.h"
 #include "net/cert/x509_util.h"
@@ -45,6 +47,21 @@ class MockCacheVisitor : public CachingCertVerifier::CacheVisitor {
                     base::Time expiration_time));
 };
 
+// Returns an empty CRLSet with the sequence number |sequence|.
+scoped_refptr<CRLSet> MakeCRLSet(uint32_t sequence) {
+  std::string header = base::StringPrintf(
+      "{\"Version\":0,\"ContentType\":\"CRLSet\",\"Sequence\":%u}",
+      sequence);
+  uint16_t header_len = static_cast<uint16_t>(header.size());
+  std::string data(reinterpret_cast<const char*>(&header_len),
+                   sizeof(header_len));
+  data += header;
+
+  scoped_refptr<CRLSet> crl_set;
+  EXPECT_TRUE(CRLSet::Parse(data, &crl_set));
+  return crl_set;
+}
+
 }  // namespace
 
 class CachingCertVerifierTest : public ::testing::Test {
@@ -279,4 +296,55 @@ TEST_F(CachingCertVerifierTest, DifferentCACerts) {
   ASSERT_EQ(2u, verifier_.GetCacheSize());
 }
 
+// Tests that results verified against an older CRLSet are not reused once a
+// newer CRLSet is in effect, since it may revoke the certificate.
+TEST_F(CachingCertVerifierTest, NewerCRLSet) {
+  base::FilePath certs_dir = GetTestCertsDirectory();
+  scoped_refptr<X509Certificate> test_cert(
+      ImportCertFromFile(certs_dir, "ok_cert.pem"));
+  ASSERT_TRUE(test_cert.get());
+  scoped_refptr<CRLSet> old_crl_set = MakeCRLSet(1);
+  ASSERT_TRUE(old_crl_set);
+  scoped_refptr<CRLSet> new_crl_set = MakeCRLSet(2);
+  ASSERT_TRUE(new_crl_set);
+
+  CertVerifier::RequestParams params(test_cert, "www.example.com", 0,
+                                     std::string(), CertificateList());
+  int error;
+  CertVerifyResult verify_result;
+  TestCompletionCallback callback;
+  std::unique_ptr<CertVerifier::Request> request;
+
+  error = callback.GetResult(
+      verifier_.Verify(params, old_crl_set.get(), &verify_result,
+                       callback.callback(), &request, NetLogWithSource()));
+  ASSERT_TRUE(IsCertificateError(error));
+  ASSERT_EQ(1u, verifier_.requests());
+  ASSERT_EQ(0u, verifier_.cache_hits());
+
+  // A newer CRLSet causes the chain to be verified again, and the new result
+  // replaces the old one.
+  error = callback.GetResult(
+      verifier_.Verify(params, new_crl_set.get(), &verify_result,
+                       callback.callback(), &request, NetLogWithSource()));
+  ASSERT_TRUE(IsCertificateError(error));
+  ASSERT_EQ(2u, verifier_.requests());
+  ASSERT_EQ(0u, verifier_.cache_hits());
+  ASSERT_EQ(1u, verifier_.GetCacheSize());
+
+  // A result verified against a newer CRLSet may be used with an older one.
+  error = verifier_.Verify(params, old_crl_set.get(), &verify_result,
+                           callback.callback(), &request, NetLogWithSource());
+  ASSERT_TRUE(IsCertificateError(error));
+  ASSERT_FALSE(request);
+  ASSERT_EQ(3u, verifier_.requests());
+  ASSERT_EQ(1u, verifier_.cache_hits());
+
+  error = verifier_.Verify(params, nullptr, &verify_result,
+                           callback.callback(), &request, NetLogWithSource());
+  ASSERT_TRUE(IsCertificateError(error));
+  ASSERT_EQ(4u, verifier_.requests());
+  ASSERT_EQ(2u, verifier_.cache_hits());
+}
+
 }  // namespace net
@@ -44,6 +44,7 @@
 
 #include "net/cookies/cookie_monster.h"
 
+#include <algorithm>
 #include <functional>
 #include <set>
 
@@ -660,7 +661,10 @@ void CookieMonster::GetCookieListWithOptions(const GURL& url,
   if (HasCookieableScheme(url)) {
     std::vector<CanonicalCookie*> cookie_ptrs;
     FindCookiesForHostAndDomain(url, options, &cookie_ptrs);
-    std::sort(cookie_ptrs.begin(), cookie_ptrs.end(), CookieSorter);
+    // InternalInsertCookie() keeps the cookies of each key in this order, so
+    // they don't need to be sorted on every request.
+    DCHECK(std::is_sorted(cookie_ptrs.begin(), cookie_ptrs.end(),
+                          CookieSorter));
 
     cookies.reserve(cookie_ptrs.size());
     for (std::vector<CanonicalCookie*>::const_iterator it = cookie_ptrs.begin();
@@ -1192,8 +1196,18 @@ CookieMonster::CookieMap::iterator CookieMonster::InternalInsertCookie(
   if ((cc_ptr->IsPersistent() || persist_session_cookies_) && store_.get() &&
       sync_to_store)
     store_->AddCookie(*cc_ptr);
+  // Keep the cookies of |key| in the order they're sent in, so that
+  // GetCookieListWithOptions() doesn't have to sort them. Among cookies that
+  // sort the same, the new one goes last, as std::sort() makes no promises
+  // about their order anyway.
+  CookieMapItPair range = cookies_.equal_range(key);
+  CookieMap::iterator position = std::upper_bound(
+      range.first, range.second, cc_ptr,
+      [](CanonicalCookie* cookie, const CookieMap::value_type& entry) {
+        return CookieSorter(cookie, entry.second.get());
+      });
   CookieMap::iterator inserted =
-      cookies_.insert(CookieMap::value_type(key, std::move(cc)));
+      cookies_.insert(position, CookieMap::value_type(key, std::move(cc)));
 
   // See InitializeHistograms() for details.
   int32_t type_sample = cc_ptr->SameSite() != CookieSameSite::NO_RESTRICTION
@@ -9,6 +9,7 @@
 #include "base/memory/ref_counted.h"
 #include "base/message_loop/message_loop.h"
 #include "base/run_loop.h"
+#include "base/stl_util.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
 #include "base/test/perf_time_logger.h"
@@ -331,6 +332,54 @@ TEST_F(CookieMonsterTest, TestImport) {
   EXPECT_EQ("domain_1.com", cm->GetKey("www.Domain_1.com"));
 }
 
+// Queries a profile with 10k cookies, where each site has cookies on paths of
+// different depths that have to be returned longest path first.
+TEST_F(CookieMonsterTest, TestQueryLargeProfile) {
+  scoped_refptr<MockPersistentCookieStore> store(new MockPersistentCookieStore);
+  std::vector<std::unique_ptr<CanonicalCookie>> initial_cookies;
+  GetCookieListCallback getCookieListCallback;
+
+  const int kNumDomains = 200;
+  const int kCookiesPerDomain = 50;
+  const char* const kPaths[] = {"/", "/a", "/a/b", "/a/b/c", "/a/b/c/d"};
+  // Creation times must be unique. They decrease, so that the store returns
+  // each site's cookies in the opposite of the order they're sent in.
+  int64_t time_tick(base::Time::Now().ToInternalValue());
+
+  for (int domain_num = 0; domain_num < kNumDomains; domain_num++) {
+    GURL gurl(base::StringPrintf("http://www.domain_%d.com", domain_num));
+    for (int cookie_num = 0; cookie_num < kCookiesPerDomain; cookie_num++) {
+      std::string cookie_line(base::StringPrintf(
+          "Cookie_%d=1; Path=%s", cookie_num,
+          kPaths[cookie_num % base::size(kPaths)]));
+      AddCookieToList(gurl, cookie_line,
+                      base::Time::FromInternalValue(time_tick--),
+                      &initial_cookies);
+    }
+  }
+
+  store->SetLoadExpectation(true, std::move(initial_cookies));
+  std::unique_ptr<CookieMonster> cm(new CookieMonster(store.get()));
+
+  // Import happens on first access.
+  GURL first_gurl("http://www.domain_0.com/a/b/c/d");
+  EXPECT_EQ(static_cast<size_t>(kCookiesPerDomain),
+            getCookieListCallback.GetCookieList(cm.get(), first_gurl).size());
+
+  std::vector<GURL> probe_gurls;
+  for (int domain_num = 0; domain_num < kNumDomains; domain_num++) {
+    probe_gurls.push_back(GURL(base::StringPrintf(
+        "http://www.domain_%d.com/a/b/c/d/x.html", domain_num)));
+  }
+
+  base::PerfTimeLogger timer("Cookie_monster_query_large_profile");
+  for (int i = 0; i < kNumCookies; i++) {
+    getCookieListCallback.GetCookieList(cm.get(),
+                                        probe_gurls[i % probe_gurls.size()]);
+  }
+  timer.Done();
+}
+
 TEST_F(CookieMonsterTest, TestGetKey) {
   std::unique_ptr<CookieMonster> cm(new CookieMonster(nullptr));
   base::PerfTimeLogger timer("Cookie_monster_get_key");
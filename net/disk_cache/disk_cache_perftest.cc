@@ -5,6 +5,7 @@
 #include <limits>
 #include <memory>
 #include <string>
+#include <unordered_set>
 
 #include "base/barrier_closure.h"
 #include "base/bind.h"
@@ -32,6 +33,7 @@
 #include "net/disk_cache/disk_cache_test_base.h"
 #include "net/disk_cache/disk_cache_test_util.h"
 #include "net/disk_cache/simple/simple_backend_impl.h"
+#include "net/disk_cache/simple/simple_eviction_policy.h"
 #include "net/disk_cache/simple/simple_index.h"
 #include "net/disk_cache/simple/simple_index_file.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -621,4 +623,103 @@ TEST(SimpleIndexPerfTest, EvictionPerformance) {
              << "ms";
 }
 
+// Removes the entries SimpleIndex evicts from it and from the set of cached
+// entries of a trace replay.
+class EvictingDelegate : public disk_cache::SimpleIndexDelegate {
+ public:
+  explicit EvictingDelegate(std::unordered_set<uint64_t>* cached_entries)
+      : cached_entries_(cached_entries) {}
+
+  void set_index(disk_cache::SimpleIndex* index) { index_ = index; }
+
+  void DoomEntries(std::vector<uint64_t>* entry_hashes,
+                   net::CompletionOnceCallback callback) override {
+    for (uint64_t entry_hash : *entry_hashes) {
+      index_->Remove(entry_hash);
+      cached_entries_->erase(entry_hash);
+    }
+    std::move(callback).Run(net::OK);
+  }
+
+ private:
+  disk_cache::SimpleIndex* index_ = nullptr;
+  std::unordered_set<uint64_t>* const cached_entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(EvictingDelegate);
+};
+
+// Replays |trace| against a SimpleIndex of |max_size| bytes evicting with
+// |policy|, one access per second, and reports the hit ratio and the bytes
+// written to the cache on misses.
+void ReplayTrace(const char* policy_name,
+                 std::unique_ptr<disk_cache::SimpleEvictionPolicy> policy,
+                 const std::vector<uint64_t>& trace,
+                 uint64_t max_size) {
+  std::unordered_set<uint64_t> cached_entries;
+  EvictingDelegate delegate(&cached_entries);
+  disk_cache::SimpleIndex index(/* io_thread = */ nullptr,
+                                /* cleanup_tracker = */ nullptr, &delegate,
+                                net::DISK_CACHE,
+                                /* simple_index_file = */ nullptr);
+  delegate.set_index(&index);
+  index.SetEvictionPolicy(std::move(policy));
+  index.SetMaxSize(max_size);
+
+  const base::Time start =
+      base::Time::Now() - base::TimeDelta::FromSeconds(trace.size());
+  size_t hits = 0;
+  uint64_t bytes_written = 0;
+  for (size_t i = 0; i < trace.size(); ++i) {
+    const uint64_t entry_hash = trace[i];
+    const base::Time access_time = start + base::TimeDelta::FromSeconds(i);
+    if (cached_entries.count(entry_hash)) {
+      ++hits;
+      index.UseIfExists(entry_hash);
+      index.SetLastUsedTimeForTest(entry_hash, access_time);
+      continue;
+    }
+    // Entries are between 16 and 76 KiB.
+    const uint32_t entry_size = (16 + (entry_hash % 16) * 4) * 1024;
+    bytes_written += entry_size;
+    cached_entries.insert(entry_hash);
+    index.Insert(entry_hash);
+    index.SetLastUsedTimeForTest(entry_hash, access_time);
+    index.UpdateEntrySize(entry_hash, entry_size);
+  }
+
+  LOG(ERROR) << policy_name << " hit ratio: " << (100.0 * hits / trace.size())
+             << "%, bytes written: " << (bytes_written / (1024 * 1024))
+             << " MiB";
+}
+
+// Compares eviction policies on a trace where skewed accesses to a popular set
+// of entries are interrupted by scans of entries used only once.
+TEST(SimpleIndexPerfTest, EvictionPolicyTraceReplay) {
+  const size_t kAccesses = 500000;
+  const uint64_t kPopularEntries = 20000;
+  // Out of every kScanPeriod accesses, the first kScanLength are a scan.
+  const size_t kScanPeriod = 20000;
+  const size_t kScanLength = 5000;
+
+  std::vector<uint64_t> trace;
+  trace.reserve(kAccesses);
+  uint64_t next_scanned_entry = kPopularEntries;
+  for (size_t i = 0; i < kAccesses; ++i) {
+    if (i % kScanPeriod < kScanLength) {
+      trace.push_back(next_scanned_entry++);
+    } else {
+      // Cubing skews the accesses towards the first entries.
+      const double x = base::RandDouble();
+      trace.push_back(static_cast<uint64_t>(kPopularEntries * x * x * x));
+    }
+  }
+
+  // Room for about a tenth of the popular entries.
+  const uint64_t kMaxSize = kPopularEntries / 10 * 46 * 1024;
+  ReplayTrace("LRU", std::make_unique<disk_cache::LruEvictionPolicy>(), trace,
+              kMaxSize);
+  ReplayTrace("TinyLFU", std::make_unique<disk_cache::TinyLfuEvictionPolicy>(),
+              trace, kMaxSize);
+}
+
 }  // namespace
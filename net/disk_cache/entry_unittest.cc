@@ -3870,6 +3870,82 @@ TEST_F(DiskCacheEntryTest, SimpleCacheInFlightRead) {
   EXPECT_EQ(0, memcmp(write_buffer->data(), read_buffer->data(), kBufferSize));
 }
 
+// Tests that reads of stream 0, which is kept in memory, don't wait for IO in
+// flight on stream 1, unless a queued operation writes to stream 0.
+TEST_F(DiskCacheEntryTest, SimpleCacheStream0ReadDuringStream1IO) {
+  SetSimpleCacheMode();
+  InitCache();
+
+  const char key[] = "the first key";
+  disk_cache::Entry* entry = NULL;
+  ASSERT_EQ(net::OK, cache_->CreateEntry(key, net::HIGHEST, &entry,
+                                         net::CompletionCallback()));
+
+  const int kHeaderSize = 100;
+  const int kBodySize = 64 * 1024;
+  scoped_refptr<net::IOBuffer> header_buffer(new net::IOBuffer(kHeaderSize));
+  scoped_refptr<net::IOBuffer> body_buffer(new net::IOBuffer(kBodySize));
+  CacheTestFillBuffer(header_buffer->data(), kHeaderSize, false);
+  CacheTestFillBuffer(body_buffer->data(), kBodySize, false);
+  EXPECT_EQ(kHeaderSize,
+            WriteData(entry, 0, 0, header_buffer.get(), kHeaderSize, true));
+  EXPECT_EQ(kBodySize,
+            WriteData(entry, 1, 0, body_buffer.get(), kBodySize, true));
+  entry->Close();
+
+  ASSERT_THAT(OpenEntry(key, &entry), IsOk());
+  ScopedEntryPtr entry_closer(entry);
+
+  MessageLoopHelper helper;
+  int expected = 0;
+
+  scoped_refptr<net::IOBuffer> body_read_buffer(new net::IOBuffer(kBodySize));
+  CallbackTest body_read_callback(&helper, false);
+  EXPECT_EQ(net::ERR_IO_PENDING,
+            entry->ReadData(1, 0, body_read_buffer.get(), kBodySize,
+                            base::Bind(&CallbackTest::Run,
+                                       base::Unretained(&body_read_callback))));
+  ++expected;
+
+  // The header read completes right away.
+  scoped_refptr<net::IOBuffer> header_read_buffer(
+      new net::IOBuffer(kHeaderSize));
+  EXPECT_EQ(kHeaderSize,
+            entry->ReadData(0, 0, header_read_buffer.get(), kHeaderSize,
+                            net::CompletionCallback()));
+  EXPECT_EQ(0, memcmp(header_buffer->data(), header_read_buffer->data(),
+                      kHeaderSize));
+
+  // Once a write to stream 0 is queued, later reads of it queue behind it.
+  scoped_refptr<net::IOBuffer> new_header_buffer(
+      new net::IOBuffer(kHeaderSize));
+  CacheTestFillBuffer(new_header_buffer->data(), kHeaderSize, false);
+  CallbackTest header_write_callback(&helper, false);
+  EXPECT_EQ(net::ERR_IO_PENDING,
+            entry->WriteData(0, 0, new_header_buffer.get(), kHeaderSize,
+                             base::Bind(&CallbackTest::Run,
+                                        base::Unretained(
+                                            &header_write_callback)),
+                             true));
+  ++expected;
+  CallbackTest header_read_callback(&helper, false);
+  EXPECT_EQ(net::ERR_IO_PENDING,
+            entry->ReadData(0, 0, header_read_buffer.get(), kHeaderSize,
+                            base::Bind(&CallbackTest::Run,
+                                       base::Unretained(
+                                           &header_read_callback))));
+  ++expected;
+
+  EXPECT_TRUE(helper.WaitUntilCacheIoFinished(expected));
+  EXPECT_EQ(kBodySize, body_read_callback.last_result());
+  EXPECT_EQ(0, memcmp(body_buffer->data(), body_read_buffer->data(),
+                      kBodySize));
+  EXPECT_EQ(kHeaderSize, header_write_callback.last_result());
+  EXPECT_EQ(kHeaderSize, header_read_callback.last_result());
+  EXPECT_EQ(0, memcmp(new_header_buffer->data(), header_read_buffer->data(),
+                      kHeaderSize));
+}
+
 TEST_F(DiskCacheEntryTest, SimpleCacheOpenCreateRaceWithNoIndex) {
   SetSimpleCacheMode();
   DisableSimpleCacheWaitForIndex();
@@ -4103,6 +4179,72 @@ TEST_F(DiskCacheEntryTest, SimpleCacheStream1SizeChanges) {
   entry = NULL;
 }
 
+// Tests that a stream 1 which compresses well is stored compressed, and reads
+// back whole, across chunks, and after being written again.
+TEST_F(DiskCacheEntryTest, SimpleCacheCompressedStream1) {
+  base::test::ScopedFeatureList scoped_feature_list;
+  scoped_feature_list.InitAndEnableFeature(
+      disk_cache::kSimpleCacheCompressStream1);
+  SetSimpleCacheMode();
+  InitCache();
+  disk_cache::Entry* entry = NULL;
+  const std::string key("the key");
+  const int kHeaderSize = 100;
+  const int kBodySize = 3 * disk_cache::kSimpleCompressedChunkSize + 1000;
+  scoped_refptr<net::IOBuffer> header_buffer(new net::IOBuffer(kHeaderSize));
+  CacheTestFillBuffer(header_buffer->data(), kHeaderSize, false);
+  std::string body;
+  while (body.size() < static_cast<size_t>(kBodySize))
+    body += "body { color: black; background: white; }\n";
+  body.resize(kBodySize);
+  scoped_refptr<net::IOBuffer> body_buffer(new net::StringIOBuffer(body));
+
+  ASSERT_THAT(CreateEntry(key, &entry), IsOk());
+  EXPECT_EQ(kHeaderSize,
+            WriteData(entry, 0, 0, header_buffer.get(), kHeaderSize, false));
+  EXPECT_EQ(kBodySize,
+            WriteData(entry, 1, 0, body_buffer.get(), kBodySize, false));
+  entry->Close();
+
+  // Open synchronizes with the close, which compressed stream 1.
+  ASSERT_THAT(OpenEntry(key, &entry), IsOk());
+  int64_t file_size = 0;
+  ASSERT_TRUE(base::GetFileSize(
+      cache_path_.AppendASCII(
+          disk_cache::simple_util::GetFilenameFromKeyAndFileIndex(key, 0)),
+      &file_size));
+  EXPECT_LT(file_size, kBodySize / 4);
+  EXPECT_EQ(kBodySize, entry->GetDataSize(1));
+
+  scoped_refptr<net::IOBuffer> read_buffer(new net::IOBuffer(kBodySize));
+  EXPECT_EQ(kBodySize, ReadData(entry, 1, 0, read_buffer.get(), kBodySize));
+  EXPECT_EQ(0, memcmp(body.data(), read_buffer->data(), kBodySize));
+  const int kOffset = disk_cache::kSimpleCompressedChunkSize - 10;
+  EXPECT_EQ(kHeaderSize,
+            ReadData(entry, 1, kOffset, read_buffer.get(), kHeaderSize));
+  EXPECT_EQ(0, memcmp(body.data() + kOffset, read_buffer->data(), kHeaderSize));
+  EXPECT_EQ(kHeaderSize, ReadData(entry, 0, 0, read_buffer.get(), kHeaderSize));
+  EXPECT_EQ(0, memcmp(header_buffer->data(), read_buffer->data(), kHeaderSize));
+
+  // Appending to stream 1.
+  EXPECT_EQ(kHeaderSize, WriteData(entry, 1, kBodySize, header_buffer.get(),
+                                   kHeaderSize, false));
+  entry->Close();
+
+  const int kNewBodySize = kBodySize + kHeaderSize;
+  ASSERT_THAT(OpenEntry(key, &entry), IsOk());
+  EXPECT_EQ(kNewBodySize, entry->GetDataSize(1));
+  read_buffer = new net::IOBuffer(kNewBodySize);
+  EXPECT_EQ(kNewBodySize,
+            ReadData(entry, 1, 0, read_buffer.get(), kNewBodySize));
+  EXPECT_EQ(0, memcmp(body.data(), read_buffer->data(), kBodySize));
+  EXPECT_EQ(0, memcmp(header_buffer->data(), read_buffer->data() + kBodySize,
+                      kHeaderSize));
+  EXPECT_EQ(kHeaderSize, ReadData(entry, 0, 0, read_buffer.get(), kHeaderSize));
+  EXPECT_EQ(0, memcmp(header_buffer->data(), read_buffer->data(), kHeaderSize));
+  entry->Close();
+}
+
 // Test that writing within the range for which the crc has already been
 // computed will properly invalidate the computed crc.
 TEST_F(DiskCacheEntryTest, SimpleCacheCRCRewrite) {
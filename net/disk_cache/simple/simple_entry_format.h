@@ -24,6 +24,14 @@ const uint64_t kSimpleSparseRangeMagicNumber = UINT64_C(0xeb97bf016553676b);
 //   - (optionally) the SHA256 of the key.
 //   - a SimpleFileEOF record for stream 0.
 //
+// If the EOF record for stream 0 has FLAG_STREAM_1_COMPRESSED, the data from
+// stream 1 is stored as:
+//   - the data, split into chunks of kSimpleCompressedChunkSize bytes which
+//     were compressed independently by zlib.
+//   - the offset of the end of each compressed chunk, relative to the start of
+//     the stream, as a uint32_t.
+// and the EOF record for stream 1 has the uncompressed size in |stream_size|.
+//
 // Because stream 0 data (typically HTTP headers) is on the critical path of
 // requests, on open, the cache reads the end of the record and does not
 // read the SimpleFileHeader. If the key can be validated with a SHA256, then
@@ -45,6 +53,9 @@ static const int kSimpleEntryStreamCount = 3;
 // API and sparse streams.
 static const int kSimpleEntryTotalFileCount = kSimpleEntryNormalFileCount + 1;
 
+// The size of the uncompressed chunks of a compressed stream 1.
+const int kSimpleCompressedChunkSize = 32 * 1024;
+
 // Note that stream 0/stream 1 files rely on the footer to verify the entry,
 // so if the format changes, it's insufficient to change the version here;
 // likely the EOF magic should be updated as well.
@@ -61,6 +72,8 @@ struct NET_EXPORT_PRIVATE SimpleFileEOF {
   enum Flags {
     FLAG_HAS_CRC32 = (1U << 0),
     FLAG_HAS_KEY_SHA256 = (1U << 1),  // Preceding the record if present.
+    // Only in the EOF record for stream 0.
+    FLAG_STREAM_1_COMPRESSED = (1U << 2),
   };
 
   SimpleFileEOF();
@@ -68,7 +81,8 @@ struct NET_EXPORT_PRIVATE SimpleFileEOF {
   uint64_t final_magic_number;
   uint32_t flags;
   uint32_t data_crc32;
-  // |stream_size| is only used in the EOF record for stream 0.
+  // |stream_size| is only used in the EOF record for stream 0, and in the one
+  // for stream 1 if it is compressed.
   uint32_t stream_size;
 };
 
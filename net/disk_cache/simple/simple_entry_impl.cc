@@ -87,6 +87,23 @@ void InvokeCallbackIfBackendIsAlive(
   std::move(completion_callback).Run(result);
 }
 
+// Returns whether |operation| leaves the data of stream |stream_index| alone,
+// so that a later read of that stream needn't wait for it.
+bool OperationLeavesStreamAlone(const SimpleEntryOperation& operation,
+                                int stream_index) {
+  switch (operation.type()) {
+    case SimpleEntryOperation::TYPE_READ:
+    case SimpleEntryOperation::TYPE_READ_SPARSE:
+    case SimpleEntryOperation::TYPE_WRITE_SPARSE:
+    case SimpleEntryOperation::TYPE_GET_AVAILABLE_RANGE:
+      return true;
+    case SimpleEntryOperation::TYPE_WRITE:
+      return operation.index() != stream_index;
+    default:
+      return false;
+  }
+}
+
 // If |sync_possible| is false, and callback is available, posts rv to it and
 // return net::ERR_IO_PENDING; otherwise just passes through rv.
 int PostToCallbackIfNeeded(bool sync_possible,
@@ -158,6 +175,8 @@ SimpleEntryImpl::SimpleEntryImpl(
       doom_state_(DOOM_NONE),
       optimistic_create_pending_doom_state_(CREATE_NORMAL),
       state_(STATE_UNINITIALIZED),
+      io_pending_for_data_(false),
+      io_pending_write_stream_(-1),
       synchronous_entry_(NULL),
       prioritized_task_runner_(backend_->prioritized_task_runner()),
       net_log_(
@@ -216,7 +235,7 @@ int SimpleEntryImpl::OpenEntry(Entry** out_entry,
     return net::ERR_FAILED;
   }
 
-  pending_operations_.push(SimpleEntryOperation::OpenOperation(
+  pending_operations_.push_back(SimpleEntryOperation::OpenOperation(
       this, have_index, std::move(callback), out_entry));
   RunNextOperationIfNeeded();
   return net::ERR_IO_PENDING;
@@ -237,7 +256,7 @@ int SimpleEntryImpl::CreateEntry(Entry** out_entry,
         net::NetLogEventType::SIMPLE_CACHE_ENTRY_CREATE_OPTIMISTIC);
 
     ReturnEntryToCaller(out_entry);
-    pending_operations_.push(SimpleEntryOperation::CreateOperation(
+    pending_operations_.push_back(SimpleEntryOperation::CreateOperation(
         this, have_index, CompletionOnceCallback(),
         static_cast<Entry**>(NULL)));
     ret_value = net::OK;
@@ -250,7 +269,7 @@ int SimpleEntryImpl::CreateEntry(Entry** out_entry,
       state_ = STATE_IO_PENDING;
     }
   } else {
-    pending_operations_.push(SimpleEntryOperation::CreateOperation(
+    pending_operations_.push_back(SimpleEntryOperation::CreateOperation(
         this, have_index, std::move(callback), out_entry));
     ret_value = net::ERR_IO_PENDING;
   }
@@ -293,7 +312,7 @@ int SimpleEntryImpl::DoomEntry(net::CompletionOnceCallback callback) {
           CREATE_OPTIMISTIC_PENDING_DOOM_FOLLOWED_BY_DOOM;
     }
   }
-  pending_operations_.push(
+  pending_operations_.push_back(
       SimpleEntryOperation::DoomOperation(this, std::move(callback)));
   RunNextOperationIfNeeded();
   return net::ERR_IO_PENDING;
@@ -338,7 +357,7 @@ void SimpleEntryImpl::Close() {
     return;
   }
 
-  pending_operations_.push(SimpleEntryOperation::CloseOperation(this));
+  pending_operations_.push_back(SimpleEntryOperation::CloseOperation(this));
   DCHECK(!HasOneRef());
   Release();  // Balanced in ReturnEntryToCaller().
   RunNextOperationIfNeeded();
@@ -400,7 +419,12 @@ int SimpleEntryImpl::ReadData(int stream_index,
                             buf, buf_len, std::move(callback));
   }
 
-  pending_operations_.push(SimpleEntryOperation::ReadOperation(
+  // Reads of data kept in memory, e.g. of the headers in stream 0, needn't
+  // wait behind IO on the other streams, e.g. a large read of the body.
+  if (CanReadFromMemoryDuringIO(stream_index))
+    return ReadFromMemoryDuringIO(stream_index, offset, buf, buf_len);
+
+  pending_operations_.push_back(SimpleEntryOperation::ReadOperation(
       this, stream_index, offset, buf_len, buf, std::move(callback),
       alone_in_queue));
   RunNextOperationIfNeeded();
@@ -480,7 +504,7 @@ int SimpleEntryImpl::WriteData(int stream_index,
     }
   }
 
-  pending_operations_.push(SimpleEntryOperation::WriteOperation(
+  pending_operations_.push_back(SimpleEntryOperation::WriteOperation(
       this, stream_index, offset, buf_len, op_buf.get(), truncate, optimistic,
       std::move(op_callback)));
   return ret_value;
@@ -498,7 +522,7 @@ int SimpleEntryImpl::ReadSparseData(int64_t offset,
   }
 
   ScopedOperationRunner operation_runner(this);
-  pending_operations_.push(SimpleEntryOperation::ReadSparseOperation(
+  pending_operations_.push_back(SimpleEntryOperation::ReadSparseOperation(
       this, offset, buf_len, buf, std::move(callback)));
   return net::ERR_IO_PENDING;
 }
@@ -516,7 +540,7 @@ int SimpleEntryImpl::WriteSparseData(int64_t offset,
   }
 
   ScopedOperationRunner operation_runner(this);
-  pending_operations_.push(SimpleEntryOperation::WriteSparseOperation(
+  pending_operations_.push_back(SimpleEntryOperation::WriteSparseOperation(
       this, offset, buf_len, buf, std::move(callback)));
   return net::ERR_IO_PENDING;
 }
@@ -528,7 +552,7 @@ int SimpleEntryImpl::GetAvailableRange(int64_t offset,
   DCHECK(io_thread_checker_.CalledOnValidThread());
 
   ScopedOperationRunner operation_runner(this);
-  pending_operations_.push(SimpleEntryOperation::GetAvailableRangeOperation(
+  pending_operations_.push_back(SimpleEntryOperation::GetAvailableRangeOperation(
       this, offset, len, start, std::move(callback)));
   return net::ERR_IO_PENDING;
 }
@@ -649,7 +673,7 @@ void SimpleEntryImpl::RunNextOperationIfNeeded() {
   if (!pending_operations_.empty() && state_ != STATE_IO_PENDING) {
     std::unique_ptr<SimpleEntryOperation> operation(
         new SimpleEntryOperation(std::move(pending_operations_.front())));
-    pending_operations_.pop();
+    pending_operations_.pop_front();
     switch (operation->type()) {
       case SimpleEntryOperation::TYPE_OPEN:
         OpenEntryInternal(operation->have_index(), operation->ReleaseCallback(),
@@ -704,6 +728,49 @@ void SimpleEntryImpl::RunNextOperationIfNeeded() {
   }
 }
 
+bool SimpleEntryImpl::CanReadFromMemoryDuringIO(int stream_index) const {
+  // Only stream 0 is always kept in memory once the entry is open.
+  if (stream_index != 0 || state_ != STATE_IO_PENDING ||
+      !io_pending_for_data_ || io_pending_write_stream_ == stream_index) {
+    return false;
+  }
+  for (const SimpleEntryOperation& operation : pending_operations_) {
+    if (!OperationLeavesStreamAlone(operation, stream_index))
+      return false;
+  }
+  return true;
+}
+
+int SimpleEntryImpl::ReadFromMemoryDuringIO(int stream_index,
+                                            int offset,
+                                            net::IOBuffer* buf,
+                                            int buf_len) {
+  DCHECK(io_thread_checker_.CalledOnValidThread());
+  DCHECK_EQ(0, stream_index);
+  if (net_log_.IsCapturing()) {
+    net_log_.AddEvent(net::NetLogEventType::SIMPLE_CACHE_ENTRY_READ_BEGIN,
+                      CreateNetLogReadWriteDataCallback(stream_index, offset,
+                                                        buf_len, false));
+  }
+
+  int rv = 0;
+  if (offset >= GetDataSize(stream_index) || offset < 0 || !buf_len) {
+    RecordReadResult(cache_type_, READ_RESULT_NONBLOCK_EMPTY_RETURN);
+  } else {
+    rv = std::min(buf_len, GetDataSize(stream_index) - offset);
+    memcpy(buf->data(), stream_0_data_->data() + offset, rv);
+    // Unlike ReadFromBuffer(), leaves the metadata to be updated once the
+    // operation in flight completes.
+    RecordReadResult(cache_type_, READ_RESULT_SUCCESS);
+  }
+
+  if (net_log_.IsCapturing()) {
+    net_log_.AddEvent(net::NetLogEventType::SIMPLE_CACHE_ENTRY_READ_END,
+                      CreateNetLogReadWriteCompleteCallback(rv));
+  }
+  return rv;
+}
+
 void SimpleEntryImpl::OpenEntryInternal(bool have_index,
                                         net::CompletionOnceCallback callback,
                                         Entry** out_entry) {
@@ -901,6 +968,7 @@ int SimpleEntryImpl::ReadDataInternal(bool sync_possible,
   }
 
   state_ = STATE_IO_PENDING;
+  io_pending_for_data_ = true;
   if (doom_state_ == DOOM_NONE && backend_.get())
     backend_->index()->UseIfExists(entry_hash_);
 
@@ -987,6 +1055,8 @@ void SimpleEntryImpl::WriteDataInternal(int stream_index,
     }
   }
   state_ = STATE_IO_PENDING;
+  io_pending_for_data_ = true;
+  io_pending_write_stream_ = stream_index;
   if (doom_state_ == DOOM_NONE && backend_.get())
     backend_->index()->UseIfExists(entry_hash_);
 
@@ -1081,6 +1151,7 @@ void SimpleEntryImpl::ReadSparseDataInternal(
 
   DCHECK_EQ(STATE_READY, state_);
   state_ = STATE_IO_PENDING;
+  io_pending_for_data_ = true;
 
   std::unique_ptr<int> result(new int());
   std::unique_ptr<base::Time> last_used(new base::Time());
@@ -1126,6 +1197,7 @@ void SimpleEntryImpl::WriteSparseDataInternal(
 
   DCHECK_EQ(STATE_READY, state_);
   state_ = STATE_IO_PENDING;
+  io_pending_for_data_ = true;
 
   uint64_t max_sparse_data_size = std::numeric_limits<int64_t>::max();
   if (backend_.get()) {
@@ -1171,6 +1243,7 @@ void SimpleEntryImpl::GetAvailableRangeInternal(
 
   DCHECK_EQ(STATE_READY, state_);
   state_ = STATE_IO_PENDING;
+  io_pending_for_data_ = true;
 
   std::unique_ptr<int> result(new int());
   OnceClosure task =
@@ -1332,6 +1405,8 @@ void SimpleEntryImpl::EntryOperationComplete(
   DCHECK(io_thread_checker_.CalledOnValidThread());
   DCHECK(synchronous_entry_);
   DCHECK_EQ(STATE_IO_PENDING, state_);
+  io_pending_for_data_ = false;
+  io_pending_write_stream_ = -1;
   if (result < 0) {
     state_ = STATE_FAILURE;
     MarkAsDoomed(DOOM_COMPLETED);
@@ -10,7 +10,7 @@
 #include <memory>
 #include <string>
 
-#include "base/containers/queue.h"
+#include "base/containers/circular_deque.h"
 #include "base/files/file_path.h"
 #include "base/memory/ref_counted.h"
 #include "base/threading/thread_checker.h"
@@ -218,6 +218,17 @@ class NET_EXPORT_PRIVATE SimpleEntryImpl : public Entry,
   // the last reference.
   void RunNextOperationIfNeeded();
 
+  // Returns whether a read of stream |stream_index| can be served from the
+  // data kept in memory while IO is in flight, because neither the operation
+  // in flight nor the queued ones can change that stream.
+  bool CanReadFromMemoryDuringIO(int stream_index) const;
+
+  // Serves such a read. Returns the # of bytes read.
+  int ReadFromMemoryDuringIO(int stream_index,
+                             int offset,
+                             net::IOBuffer* buf,
+                             int buf_len);
+
   void OpenEntryInternal(bool have_index,
                          CompletionOnceCallback callback,
                          Entry** out_entry);
@@ -391,6 +402,13 @@ class NET_EXPORT_PRIVATE SimpleEntryImpl : public Entry,
 
   State state_;
 
+  // Whether |state_| is STATE_IO_PENDING because of a read, write or sparse
+  // operation, and the stream it writes to if it is a write, or -1. Such
+  // operations leave the entry's other streams alone, so reads of those which
+  // are kept in memory needn't wait for them.
+  bool io_pending_for_data_;
+  int io_pending_write_stream_;
+
   // When possible, we compute a crc32, for the data in each entry as we read or
   // write. For each stream, |crc32s_[index]| is the crc32 of that stream from
   // [0 .. |crc32s_end_offset_|). If |crc32s_end_offset_[index] == 0| then the
@@ -420,7 +438,7 @@ class NET_EXPORT_PRIVATE SimpleEntryImpl : public Entry,
 
   scoped_refptr<net::PrioritizedTaskRunner> prioritized_task_runner_;
 
-  base::queue<SimpleEntryOperation> pending_operations_;
+  base::circular_deque<SimpleEntryOperation> pending_operations_;
 
   net::NetLogWithSource net_log_;
 
@@ -0,0 +1,269 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/disk_cache/simple/simple_eviction_policy.h"
+
+#include <algorithm>
+#include <limits>
+#include <tuple>
+#include <utility>
+
+#include "base/trace_event/memory_usage_estimator.h"
+
+namespace disk_cache {
+
+namespace {
+
+// This is added to the size of each entry before using the size
+// to determine which entries to evict first. It's basically an
+// estimate of the filesystem overhead, but it also serves to flatten
+// the curve so that 1-byte entries and 2-byte entries are basically
+// treated the same.
+const int kEstimatedEntryOverhead = 512;
+
+// The window of TinyLfuEvictionPolicy is this fraction of the cache size.
+const uint64_t kTinyLfuWindowDivisor = 100;
+
+// The sketch starts with this many words, and gets one word per this many
+// entries of the index.
+const size_t kMinSketchTableSize = 64;
+const size_t kEntriesPerSketchWord = 2;
+
+// The counters are halved once there were this many increments per entry.
+const size_t kSketchIncrementsPerEntryBeforeAging = 10;
+
+const int kSketchRows = 4;
+const uint64_t kSketchSeeds[kSketchRows] = {
+    0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL, 0x9ae16a3b2f90404fULL,
+    0xcbf29ce484222325ULL};
+const int kSketchMaxCount = 15;
+
+using EntryPointer = const SimpleIndex::EntrySet::value_type*;
+
+// Returns how evictable |entry_metadata| is for LruEvictionPolicy, the higher
+// the sooner.
+uint64_t GetLruScore(const EntryMetadata& entry_metadata,
+                     uint32_t now,
+                     bool use_size) {
+  uint64_t score = now - entry_metadata.RawTimeForSorting();
+  if (use_size) {
+    // Will not overflow since we're multiplying two 32-bit values and storing
+    // them in a 64-bit variable.
+    score *= entry_metadata.GetEntrySize() + kEstimatedEntryOverhead;
+  }
+  return score;
+}
+
+// Appends |entry| to |entry_hashes| unless the entries appended so far already
+// add up to |amount_to_evict|. Returns false once they do.
+bool AppendEntryToEvict(EntryPointer entry,
+                        uint64_t amount_to_evict,
+                        uint64_t* evicted_so_far_size,
+                        SimpleIndex::HashList* entry_hashes) {
+  if (*evicted_so_far_size >= amount_to_evict)
+    return false;
+  *evicted_so_far_size += entry->second.GetEntrySize();
+  entry_hashes->push_back(entry->first);
+  return true;
+}
+
+}  // namespace
+
+const base::Feature kSimpleCacheTinyLfuEviction = {
+    "SimpleCacheTinyLfuEviction", base::FEATURE_DISABLED_BY_DEFAULT};
+
+size_t SimpleEvictionPolicy::EstimateMemoryUsage() const {
+  return 0;
+}
+
+LruEvictionPolicy::LruEvictionPolicy() = default;
+
+LruEvictionPolicy::~LruEvictionPolicy() = default;
+
+void LruEvictionPolicy::SelectEntriesToEvict(
+    const SimpleIndex::EntrySet& entries,
+    uint64_t amount_to_evict,
+    uint32_t now,
+    SimpleIndex::HashList* entry_hashes) {
+  // Flatten for sorting.
+  std::vector<std::pair<uint64_t, EntryPointer>> sorted_entries;
+  sorted_entries.reserve(entries.size());
+  const bool use_size =
+      base::FeatureList::IsEnabled(kSimpleCacheEvictionWithSize);
+  for (const auto& entry : entries) {
+    // Subtract so we don't need a custom comparator.
+    sorted_entries.emplace_back(std::numeric_limits<uint64_t>::max() -
+                                    GetLruScore(entry.second, now, use_size),
+                                &entry);
+  }
+
+  uint64_t evicted_so_far_size = 0;
+  std::sort(sorted_entries.begin(), sorted_entries.end());
+  for (const auto& score_entry_pair : sorted_entries) {
+    if (!AppendEntryToEvict(score_entry_pair.second, amount_to_evict,
+                            &evicted_so_far_size, entry_hashes)) {
+      break;
+    }
+  }
+}
+
+FrequencySketch::FrequencySketch() {
+  EnsureCapacity(0);
+}
+
+FrequencySketch::~FrequencySketch() = default;
+
+void FrequencySketch::EnsureCapacity(size_t expected_entries) {
+  size_t table_size = kMinSketchTableSize;
+  while (table_size * kEntriesPerSketchWord < expected_entries)
+    table_size *= 2;
+  const size_t old_table_size = table_.size();
+  if (table_size <= old_table_size)
+    return;
+
+  // The counters of an entry are in the word its hash indexes modulo the table
+  // size, which is a power of two, so copying the old table into each part of
+  // the new one keeps the estimates.
+  table_.resize(table_size);
+  if (old_table_size) {
+    for (size_t i = old_table_size; i < table_size; ++i)
+      table_[i] = table_[i & (old_table_size - 1)];
+  }
+  increments_before_aging_ =
+      table_size * kEntriesPerSketchWord * kSketchIncrementsPerEntryBeforeAging;
+}
+
+void FrequencySketch::Increment(uint64_t entry_hash) {
+  for (int row = 0; row < kSketchRows; ++row) {
+    int shift;
+    uint64_t& word = table_[GetCounterIndex(entry_hash, row, &shift)];
+    if (((word >> shift) & 0xf) < kSketchMaxCount)
+      word += uint64_t{1} << shift;
+  }
+  if (++increments_ >= increments_before_aging_)
+    Age();
+}
+
+int FrequencySketch::Estimate(uint64_t entry_hash) const {
+  int estimate = kSketchMaxCount;
+  for (int row = 0; row < kSketchRows; ++row) {
+    int shift;
+    const uint64_t word = table_[GetCounterIndex(entry_hash, row, &shift)];
+    estimate = std::min(estimate, static_cast<int>((word >> shift) & 0xf));
+  }
+  return estimate;
+}
+
+size_t FrequencySketch::EstimateMemoryUsage() const {
+  return base::trace_event::EstimateMemoryUsage(table_);
+}
+
+size_t FrequencySketch::GetCounterIndex(uint64_t entry_hash,
+                                        int row,
+                                        int* shift) const {
+  uint64_t hash = (entry_hash ^ kSketchSeeds[row]) * 0x9e3779b97f4a7c15ULL;
+  hash ^= hash >> 29;
+  // The top bits pick one of the 4 counters of the row in the word, and the
+  // bottom bits the word.
+  *shift = (row * 4 + static_cast<int>(hash >> 62)) * 4;
+  return static_cast<size_t>(hash & (table_.size() - 1));
+}
+
+void FrequencySketch::Age() {
+  for (uint64_t& word : table_)
+    word = (word >> 1) & 0x7777777777777777ULL;
+  increments_ /= 2;
+}
+
+TinyLfuEvictionPolicy::TinyLfuEvictionPolicy() = default;
+
+TinyLfuEvictionPolicy::~TinyLfuEvictionPolicy() = default;
+
+void TinyLfuEvictionPolicy::OnEntryUsed(uint64_t entry_hash) {
+  sketch_.Increment(entry_hash);
+}
+
+void TinyLfuEvictionPolicy::SelectEntriesToEvict(
+    const SimpleIndex::EntrySet& entries,
+    uint64_t amount_to_evict,
+    uint32_t now,
+    SimpleIndex::HashList* entry_hashes) {
+  sketch_.EnsureCapacity(entries.size());
+
+  std::vector<EntryPointer> by_recency;
+  by_recency.reserve(entries.size());
+  uint64_t cache_size = 0;
+  for (const auto& entry : entries) {
+    by_recency.push_back(&entry);
+    cache_size += entry.second.GetEntrySize();
+  }
+  std::sort(by_recency.begin(), by_recency.end(),
+            [](EntryPointer a, EntryPointer b) {
+              return a->second.RawTimeForSorting() >
+                     b->second.RawTimeForSorting();
+            });
+
+  // The most recently used entries form the window.
+  const uint64_t window_size = cache_size / kTinyLfuWindowDivisor;
+  size_t window_end = 0;
+  for (uint64_t size_in_window = 0;
+       window_end < by_recency.size() && size_in_window < window_size;
+       ++window_end) {
+    size_in_window += by_recency[window_end]->second.GetEntrySize();
+  }
+
+  // The others are evicted least frequently used first, then by their score
+  // for LruEvictionPolicy.
+  struct Candidate {
+    bool operator<(const Candidate& other) const {
+      return std::tie(frequency, inverse_lru_score) <
+             std::tie(other.frequency, other.inverse_lru_score);
+    }
+
+    int frequency;
+    uint64_t inverse_lru_score;
+    EntryPointer entry;
+  };
+  std::vector<Candidate> candidates;
+  candidates.reserve(by_recency.size() - window_end);
+  const bool use_size =
+      base::FeatureList::IsEnabled(kSimpleCacheEvictionWithSize);
+  for (size_t i = window_end; i < by_recency.size(); ++i) {
+    const EntryPointer entry = by_recency[i];
+    candidates.push_back(
+        {sketch_.Estimate(entry->first),
+         std::numeric_limits<uint64_t>::max() -
+             GetLruScore(entry->second, now, use_size),
+         entry});
+  }
+  std::sort(candidates.begin(), candidates.end());
+
+  uint64_t evicted_so_far_size = 0;
+  for (const Candidate& candidate : candidates) {
+    if (!AppendEntryToEvict(candidate.entry, amount_to_evict,
+                            &evicted_so_far_size, entry_hashes)) {
+      return;
+    }
+  }
+  // Only evict from the window if the rest of the cache wasn't enough, least
+  // recently used first.
+  for (size_t i = window_end; i > 0; --i) {
+    if (!AppendEntryToEvict(by_recency[i - 1], amount_to_evict,
+                            &evicted_so_far_size, entry_hashes)) {
+      return;
+    }
+  }
+}
+
+size_t TinyLfuEvictionPolicy::EstimateMemoryUsage() const {
+  return sketch_.EstimateMemoryUsage();
+}
+
+std::unique_ptr<SimpleEvictionPolicy> CreateSimpleEvictionPolicy() {
+  if (base::FeatureList::IsEnabled(kSimpleCacheTinyLfuEviction))
+    return std::make_unique<TinyLfuEvictionPolicy>();
+  return std::make_unique<LruEvictionPolicy>();
+}
+
+}  // namespace disk_cache
@@ -0,0 +1,135 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_DISK_CACHE_SIMPLE_SIMPLE_EVICTION_POLICY_H_
+#define NET_DISK_CACHE_SIMPLE_SIMPLE_EVICTION_POLICY_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "base/feature_list.h"
+#include "base/macros.h"
+#include "net/base/net_export.h"
+#include "net/disk_cache/simple/simple_index.h"
+
+namespace disk_cache {
+
+// Enables TinyLfuEvictionPolicy in place of LruEvictionPolicy.
+NET_EXPORT_PRIVATE extern const base::Feature kSimpleCacheTinyLfuEviction;
+
+// Chooses the entries SimpleIndex evicts once the cache grows past its high
+// watermark. Policies are told about every use of an entry, so they can keep
+// their own statistics next to the EntryMetadata of the index.
+class NET_EXPORT_PRIVATE SimpleEvictionPolicy {
+ public:
+  virtual ~SimpleEvictionPolicy() = default;
+
+  // Called when |entry_hash| is inserted in the index, or used.
+  virtual void OnEntryUsed(uint64_t entry_hash) {}
+
+  // Appends to |entry_hashes| entries of |entries| whose sizes add up to at
+  // least |amount_to_evict|, or all of them, in the order they should be
+  // evicted. |now| is in seconds since the epoch, as
+  // EntryMetadata::RawTimeForSorting().
+  virtual void SelectEntriesToEvict(const SimpleIndex::EntrySet& entries,
+                                    uint64_t amount_to_evict,
+                                    uint32_t now,
+                                    SimpleIndex::HashList* entry_hashes) = 0;
+
+  // Returns the estimate of dynamically allocated memory in bytes.
+  virtual size_t EstimateMemoryUsage() const;
+};
+
+// Evicts the least recently used entries first. With
+// kSimpleCacheEvictionWithSize, the age of entries is weighed by their size,
+// so that large entries go before small entries of the same age.
+class NET_EXPORT_PRIVATE LruEvictionPolicy : public SimpleEvictionPolicy {
+ public:
+  LruEvictionPolicy();
+  ~LruEvictionPolicy() override;
+
+  // SimpleEvictionPolicy:
+  void SelectEntriesToEvict(const SimpleIndex::EntrySet& entries,
+                            uint64_t amount_to_evict,
+                            uint32_t now,
+                            SimpleIndex::HashList* entry_hashes) override;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(LruEvictionPolicy);
+};
+
+// Count-min sketch estimating how often entries were used recently, in about
+// 4 bytes per entry. Each entry maps to one 4-bit counter in each of 4 rows;
+// the estimate is the smallest of them, which saturates at 15. All counters
+// are halved once there were 10 increments per entry, so that entries which
+// stop being used lose their weight.
+class NET_EXPORT_PRIVATE FrequencySketch {
+ public:
+  FrequencySketch();
+  ~FrequencySketch();
+
+  // Grows the sketch to fit |expected_entries|. Estimates are kept.
+  void EnsureCapacity(size_t expected_entries);
+
+  void Increment(uint64_t entry_hash);
+  int Estimate(uint64_t entry_hash) const;
+
+  size_t EstimateMemoryUsage() const;
+
+ private:
+  // Returns the index in |table_| of the word holding the counter of
+  // |entry_hash| in |row|, and its shift in the word in |*shift|.
+  size_t GetCounterIndex(uint64_t entry_hash, int row, int* shift) const;
+
+  // Halves all counters.
+  void Age();
+
+  // 16 counters per word, 4 of each row.
+  std::vector<uint64_t> table_;
+
+  size_t increments_ = 0;
+  size_t increments_before_aging_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(FrequencySketch);
+};
+
+// W-TinyLFU, adapted to the batch evictions of SimpleIndex. The most recently
+// used entries, making up 1% of the cache size, form a window which is never
+// evicted, so that new entries get a chance to be used again. Past the window,
+// an entry is admitted into the rest of the cache only if it is used more
+// often than the entries it competes with: the entries estimated to be the
+// least frequently used by a FrequencySketch are evicted first, the least
+// recently used among those, as by LruEvictionPolicy. This keeps scans of
+// entries used only once from flushing the entries which are used repeatedly.
+class NET_EXPORT_PRIVATE TinyLfuEvictionPolicy : public SimpleEvictionPolicy {
+ public:
+  TinyLfuEvictionPolicy();
+  ~TinyLfuEvictionPolicy() override;
+
+  // SimpleEvictionPolicy:
+  void OnEntryUsed(uint64_t entry_hash) override;
+  void SelectEntriesToEvict(const SimpleIndex::EntrySet& entries,
+                            uint64_t amount_to_evict,
+                            uint32_t now,
+                            SimpleIndex::HashList* entry_hashes) override;
+  size_t EstimateMemoryUsage() const override;
+
+  const FrequencySketch& sketch() const { return sketch_; }
+
+ private:
+  FrequencySketch sketch_;
+
+  DISALLOW_COPY_AND_ASSIGN(TinyLfuEvictionPolicy);
+};
+
+// Returns the policy selected by the features above.
+NET_EXPORT_PRIVATE std::unique_ptr<SimpleEvictionPolicy>
+CreateSimpleEvictionPolicy();
+
+}  // namespace disk_cache
+
+#endif  // NET_DISK_CACHE_SIMPLE_SIMPLE_EVICTION_POLICY_H_
@@ -0,0 +1,140 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/disk_cache/simple/simple_eviction_policy.h"
+
+#include <stdint.h>
+
+#include "base/test/scoped_feature_list.h"
+#include "base/time/time.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using testing::ElementsAre;
+
+namespace disk_cache {
+
+namespace {
+
+const uint32_t kNow = 1000000;
+
+class SimpleEvictionPolicyTest : public testing::Test {
+ protected:
+  SimpleEvictionPolicyTest() {
+    scoped_feature_list_.InitAndDisableFeature(kSimpleCacheEvictionWithSize);
+  }
+
+  // Adds an entry of |entry_size| bytes last used |age| seconds ago.
+  void AddEntry(uint64_t entry_hash, uint32_t age, uint32_t entry_size) {
+    SimpleIndex::InsertInEntrySet(
+        entry_hash,
+        EntryMetadata(base::Time::UnixEpoch() +
+                          base::TimeDelta::FromSeconds(kNow - age),
+                      entry_size),
+        &entries_);
+  }
+
+  SimpleIndex::HashList SelectEntriesToEvict(SimpleEvictionPolicy* policy,
+                                             uint64_t amount_to_evict) {
+    SimpleIndex::HashList entry_hashes;
+    policy->SelectEntriesToEvict(entries_, amount_to_evict, kNow,
+                                 &entry_hashes);
+    return entry_hashes;
+  }
+
+  SimpleIndex::EntrySet entries_;
+
+ private:
+  base::test::ScopedFeatureList scoped_feature_list_;
+};
+
+}  // namespace
+
+TEST(FrequencySketchTest, Estimate) {
+  FrequencySketch sketch;
+  EXPECT_EQ(0, sketch.Estimate(1));
+  for (int i = 0; i < 5; ++i)
+    sketch.Increment(1);
+  sketch.Increment(2);
+  EXPECT_EQ(5, sketch.Estimate(1));
+  EXPECT_EQ(1, sketch.Estimate(2));
+  EXPECT_EQ(0, sketch.Estimate(3));
+
+  // Counters saturate.
+  for (int i = 0; i < 100; ++i)
+    sketch.Increment(1);
+  EXPECT_EQ(15, sketch.Estimate(1));
+}
+
+TEST(FrequencySketchTest, Ages) {
+  FrequencySketch sketch;
+  for (int i = 0; i < 8; ++i)
+    sketch.Increment(1);
+
+  // Enough increments of any entry halve the counters.
+  int increments = 0;
+  while (sketch.Estimate(1) == 8 && increments < 100000) {
+    sketch.Increment(2);
+    ++increments;
+  }
+  EXPECT_LT(increments, 100000);
+  EXPECT_EQ(4, sketch.Estimate(1));
+}
+
+TEST(FrequencySketchTest, EnsureCapacityKeepsEstimates) {
+  FrequencySketch sketch;
+  for (int i = 0; i < 3; ++i)
+    sketch.Increment(42);
+  const size_t memory_usage = sketch.EstimateMemoryUsage();
+
+  sketch.EnsureCapacity(100000);
+  EXPECT_GT(sketch.EstimateMemoryUsage(), memory_usage);
+  EXPECT_EQ(3, sketch.Estimate(42));
+  sketch.Increment(42);
+  EXPECT_EQ(4, sketch.Estimate(42));
+}
+
+TEST_F(SimpleEvictionPolicyTest, Lru) {
+  AddEntry(1, 10, 1000);
+  AddEntry(2, 30, 1000);
+  AddEntry(3, 20, 1000);
+
+  LruEvictionPolicy policy;
+  EXPECT_THAT(SelectEntriesToEvict(&policy, 1500), ElementsAre(2, 3));
+  EXPECT_THAT(SelectEntriesToEvict(&policy, 10000), ElementsAre(2, 3, 1));
+}
+
+TEST_F(SimpleEvictionPolicyTest, TinyLfuEvictsLeastFrequentlyUsed) {
+  TinyLfuEvictionPolicy policy;
+  // An older entry used repeatedly, then a scan of entries used once.
+  AddEntry(1, 1000, 1000);
+  for (int i = 0; i < 5; ++i)
+    policy.OnEntryUsed(1);
+  for (uint64_t entry_hash = 2; entry_hash <= 10; ++entry_hash) {
+    AddEntry(entry_hash, 1000 - entry_hash, 1000);
+    policy.OnEntryUsed(entry_hash);
+  }
+
+  // The scan goes first, oldest first, but the most recent entry is in the
+  // window.
+  SimpleIndex::HashList entry_hashes = SelectEntriesToEvict(&policy, 8000);
+  EXPECT_THAT(entry_hashes, ElementsAre(2, 3, 4, 5, 6, 7, 8, 9));
+
+  // Once the rest of the cache is evicted, the window is too.
+  entry_hashes = SelectEntriesToEvict(&policy, 10000);
+  EXPECT_THAT(entry_hashes, ElementsAre(2, 3, 4, 5, 6, 7, 8, 9, 1, 10));
+
+  LruEvictionPolicy lru_policy;
+  EXPECT_THAT(SelectEntriesToEvict(&lru_policy, 1000), ElementsAre(1));
+}
+
+TEST_F(SimpleEvictionPolicyTest, CreateSimpleEvictionPolicy) {
+  EXPECT_EQ(0u, CreateSimpleEvictionPolicy()->EstimateMemoryUsage());
+
+  base::test::ScopedFeatureList scoped_feature_list;
+  scoped_feature_list.InitAndEnableFeature(kSimpleCacheTinyLfuEviction);
+  EXPECT_GT(CreateSimpleEvictionPolicy()->EstimateMemoryUsage(), 0u);
+}
+
+}  // namespace disk_cache
@@ -25,6 +25,7 @@
 #include "net/base/net_errors.h"
 #include "net/disk_cache/backend_cleanup_tracker.h"
 #include "net/disk_cache/simple/simple_entry_format.h"
+#include "net/disk_cache/simple/simple_eviction_policy.h"
 #include "net/disk_cache/simple/simple_experiment.h"
 #include "net/disk_cache/simple/simple_histogram_macros.h"
 #include "net/disk_cache/simple/simple_index_delegate.h"
@@ -50,12 +51,12 @@ const uint32_t kEvictionMarginDivisor = 20;
 
 const uint32_t kBytesInKb = 1024;
 
-// This is added to the size of each entry before using the size
-// to determine which entries to evict first. It's basically an
-// estimate of the filesystem overhead, but it also serves to flatten
-// the curve so that 1-byte entries and 2-byte entries are basically
-// treated the same.
-static const int kEstimatedEntryOverhead = 512;
+// The index file is rewritten rather than appended to its journal once the
+// journal would have more than this many records, plus one per this many
+// entries in the index. This keeps the journal, and the time to load it, small
+// relative to the index file.
+const int64_t kMinJournalRecordsBeforeRewrite = 1024;
+const int64_t kEntriesPerJournalRecordBeforeRewrite = 4;
 
 }  // namespace
 
@@ -155,8 +156,10 @@ SimpleIndex::SimpleIndex(
       high_watermark_(0),
       low_watermark_(0),
       eviction_in_progress_(false),
+      eviction_policy_(CreateSimpleEvictionPolicy()),
       initialized_(false),
       init_method_(INITIALIZE_METHOD_MAX),
+      journal_record_count_(-1),
       index_file_(std::move(index_file)),
       io_thread_(io_thread),
       // Creating the callback once so it is reused every time
@@ -274,7 +277,15 @@ uint64_t SimpleIndex::GetCacheSizeBetween(base::Time initial_time,
 
 size_t SimpleIndex::EstimateMemoryUsage() const {
   return base::trace_event::EstimateMemoryUsage(entries_set_) +
-         base::trace_event::EstimateMemoryUsage(removed_entries_);
+         base::trace_event::EstimateMemoryUsage(removed_entries_) +
+         base::trace_event::EstimateMemoryUsage(changed_entries_) +
+         eviction_policy_->EstimateMemoryUsage();
+}
+
+void SimpleIndex::SetEvictionPolicy(
+    std::unique_ptr<SimpleEvictionPolicy> eviction_policy) {
+  DCHECK(eviction_policy);
+  eviction_policy_ = std::move(eviction_policy);
 }
 
 void SimpleIndex::SetLastUsedTimeForTest(uint64_t entry_hash,
@@ -293,6 +304,8 @@ void SimpleIndex::Insert(uint64_t entry_hash) {
                    &entries_set_);
   if (!initialized_)
     removed_entries_.erase(entry_hash);
+  eviction_policy_->OnEntryUsed(entry_hash);
+  MarkAsChanged(entry_hash);
   PostponeWritingToDisk();
 }
 
@@ -306,6 +319,7 @@ void SimpleIndex::Remove(uint64_t entry_hash) {
 
   if (!initialized_)
     removed_entries_.insert(entry_hash);
+  MarkAsChanged(entry_hash);
   PostponeWritingToDisk();
 }
 
@@ -328,6 +342,7 @@ void SimpleIndex::SetEntryInMemoryData(uint64_t entry_hash, uint8_t value) {
   EntrySet::iterator it = entries_set_.find(entry_hash);
   if (it == entries_set_.end())
     return;
+  MarkAsChanged(entry_hash);
   return it->second.SetInMemoryData(value);
 }
 
@@ -340,6 +355,8 @@ bool SimpleIndex::UseIfExists(uint64_t entry_hash) {
     // If not initialized, always return true, forcing it to go to the disk.
     return !initialized_;
   it->second.SetLastUsedTime(base::Time::Now());
+  eviction_policy_->OnEntryUsed(entry_hash);
+  MarkAsChanged(entry_hash);
   PostponeWritingToDisk();
   return true;
 }
@@ -358,34 +375,14 @@ void SimpleIndex::StartEvictionIfNeeded() {
       MEMORY_KB, "Eviction.MaxCacheSizeOnStart2", cache_type_,
       static_cast<base::HistogramBase::Sample>(max_size_ / kBytesInKb));
 
-  // Flatten for sorting.
-  std::vector<std::pair<uint64_t, const EntrySet::value_type*>> entries;
-  entries.reserve(entries_set_.size());
-  uint32_t now = (base::Time::Now() - base::Time::UnixEpoch()).InSeconds();
-  bool use_size = base::FeatureList::IsEnabled(kSimpleCacheEvictionWithSize);
-  for (EntrySet::const_iterator i = entries_set_.begin();
-       i != entries_set_.end(); ++i) {
-    uint64_t sort_value = now - i->second.RawTimeForSorting();
-    if (use_size) {
-      // Will not overflow since we're multiplying two 32-bit values and storing
-      // them in a 64-bit variable.
-      sort_value *= i->second.GetEntrySize() + kEstimatedEntryOverhead;
-    }
-    // Subtract so we don't need a custom comparator.
-    entries.emplace_back(std::numeric_limits<uint64_t>::max() - sort_value,
-                         &*i);
-  }
-
-  uint64_t evicted_so_far_size = 0;
-  const uint64_t amount_to_evict = cache_size_ - low_watermark_;
+  const uint32_t now =
+      (base::Time::Now() - base::Time::UnixEpoch()).InSeconds();
   std::vector<uint64_t> entry_hashes;
-  std::sort(entries.begin(), entries.end());
-  for (const auto& score_metadata_pair : entries) {
-    if (evicted_so_far_size >= amount_to_evict)
-      break;
-    evicted_so_far_size += score_metadata_pair.second->second.GetEntrySize();
-    entry_hashes.push_back(score_metadata_pair.second->first);
-  }
+  eviction_policy_->SelectEntriesToEvict(
+      entries_set_, cache_size_ - low_watermark_, now, &entry_hashes);
+  uint64_t evicted_so_far_size = 0;
+  for (uint64_t entry_hash : entry_hashes)
+    evicted_so_far_size += entries_set_.find(entry_hash)->second.GetEntrySize();
 
   SIMPLE_CACHE_UMA(COUNTS_1M,
                    "Eviction.EntryCount", cache_type_, entry_hashes.size());
@@ -409,6 +406,7 @@ bool SimpleIndex::UpdateEntrySize(uint64_t entry_hash,
     return false;
 
   UpdateEntryIteratorSize(&it, entry_size);
+  MarkAsChanged(entry_hash);
   PostponeWritingToDisk();
   StartEvictionIfNeeded();
   return true;
@@ -444,6 +442,12 @@ void SimpleIndex::InsertEntryForTesting(uint64_t entry_hash,
   cache_size_ += entry_metadata.GetEntrySize();
 }
 
+void SimpleIndex::MarkAsChanged(uint64_t entry_hash) {
+  // Before initialization, the changes are found when merging.
+  if (initialized_)
+    changed_entries_.insert(entry_hash);
+}
+
 void SimpleIndex::PostponeWritingToDisk() {
   if (!initialized_)
     return;
@@ -472,16 +476,21 @@ void SimpleIndex::MergeInitializingSet(
 
   EntrySet* index_file_entries = &load_result->entries;
 
+  // What changed during initialization is what the index file and its
+  // journal are missing.
+  journal_record_count_ = load_result->journal_record_count;
   for (std::unordered_set<uint64_t>::const_iterator it =
            removed_entries_.begin();
        it != removed_entries_.end(); ++it) {
     index_file_entries->erase(*it);
+    changed_entries_.insert(*it);
   }
   removed_entries_.clear();
 
   for (EntrySet::const_iterator it = entries_set_.begin();
        it != entries_set_.end(); ++it) {
     const uint64_t entry_hash = it->first;
+    changed_entries_.insert(entry_hash);
     std::pair<EntrySet::iterator, bool> insert_result =
         index_file_entries->insert(EntrySet::value_type(entry_hash,
                                                         EntryMetadata()));
@@ -576,8 +585,26 @@ void SimpleIndex::WriteToDisk(IndexWriteToDiskReason reason) {
         cleanup_tracker_);
   }
 
-  index_file_->WriteToDisk(reason, entries_set_, cache_size_, start,
-                           app_on_background_, after_write);
+  // Appending the changes to the journal is much cheaper than rewriting the
+  // index file, until the journal grows too large compared to it.
+  const int64_t journal_record_count =
+      journal_record_count_ + changed_entries_.size();
+  if (journal_record_count_ >= 0 &&
+      journal_record_count <=
+          kMinJournalRecordsBeforeRewrite +
+              static_cast<int64_t>(entries_set_.size()) /
+                  kEntriesPerJournalRecordBeforeRewrite) {
+    HashList changed_entry_hashes(changed_entries_.begin(),
+                                  changed_entries_.end());
+    index_file_->AppendToJournal(entries_set_, changed_entry_hashes,
+                                 after_write);
+    journal_record_count_ = journal_record_count;
+  } else {
+    index_file_->WriteToDisk(reason, entries_set_, cache_size_, start,
+                             app_on_background_, after_write);
+    journal_record_count_ = 0;
+  }
+  changed_entries_.clear();
 }
 
 }  // namespace disk_cache
@@ -40,6 +40,7 @@ class PickleIterator;
 namespace disk_cache {
 
 class BackendCleanupTracker;
+class SimpleEvictionPolicy;
 class SimpleIndexDelegate;
 class SimpleIndexFile;
 struct SimpleIndexLoadResult;
@@ -192,6 +193,10 @@ class NET_EXPORT_PRIVATE SimpleIndex
   // Returns the estimate of dynamically allocated memory in bytes.
   size_t EstimateMemoryUsage() const;
 
+  // Replaces the policy choosing the entries to evict, which by default is
+  // selected by features, see CreateSimpleEvictionPolicy().
+  void SetEvictionPolicy(std::unique_ptr<SimpleEvictionPolicy> eviction_policy);
+
   void SetLastUsedTimeForTest(uint64_t entry_hash, const base::Time last_used);
 
  private:
@@ -199,11 +204,15 @@ class NET_EXPORT_PRIVATE SimpleIndex
   FRIEND_TEST_ALL_PREFIXES(SimpleIndexTest, IndexSizeCorrectOnMerge);
   FRIEND_TEST_ALL_PREFIXES(SimpleIndexTest, DiskWriteQueued);
   FRIEND_TEST_ALL_PREFIXES(SimpleIndexTest, DiskWriteExecuted);
+  FRIEND_TEST_ALL_PREFIXES(SimpleIndexTest, DiskWriteAppendsToJournal);
   FRIEND_TEST_ALL_PREFIXES(SimpleIndexTest, DiskWritePostponed);
 
   void StartEvictionIfNeeded();
   void EvictionDone(int result);
 
+  // Records that |entry_hash| needs to be written to disk.
+  void MarkAsChanged(uint64_t entry_hash);
+
   void PostponeWritingToDisk();
 
   void UpdateEntryIteratorSize(EntrySet::iterator* it,
@@ -233,6 +242,7 @@ class NET_EXPORT_PRIVATE SimpleIndex
   uint64_t low_watermark_;
   bool eviction_in_progress_;
   base::TimeTicks eviction_start_time_;
+  std::unique_ptr<SimpleEvictionPolicy> eviction_policy_;
 
   // This stores all the entry_hash of entries that are removed during
   // initialization.
@@ -240,6 +250,15 @@ class NET_EXPORT_PRIVATE SimpleIndex
   bool initialized_;
   IndexInitMethod init_method_;
 
+  // The entries inserted, updated or removed since the index was last written
+  // to disk, which are appended to the journal of the index file on the next
+  // write.
+  std::unordered_set<uint64_t> changed_entries_;
+
+  // Number of records in the journal of the index file, or -1 if the next
+  // write must rewrite the index file.
+  int64_t journal_record_count_;
+
   std::unique_ptr<SimpleIndexFile> index_file_;
 
   scoped_refptr<base::SingleThreadTaskRunner> io_thread_;
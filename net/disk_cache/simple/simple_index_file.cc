@@ -4,6 +4,9 @@
 
 #include "net/disk_cache/simple/simple_index_file.h"
 
+#include <string.h>
+
+#include <algorithm>
 #include <utility>
 #include <vector>
 
@@ -41,10 +44,79 @@ const int kMaxEntriesInIndex = 1000000;
 const int64_t kMaxIndexFileSizeBytes =
     kMaxEntriesInIndex * (8 + EntryMetadata::kOnDiskSizeBytes);
 
+// The journal is bounded by the number of entries WriteToDisk() is called
+// with, but only loosely since it also holds removed entries.
+const int64_t kMaxJournalFileSizeBytes = 2 * kMaxIndexFileSizeBytes;
+
+const uint64_t kSimpleIndexJournalMagicNumber = UINT64_C(0x6a6f75726e616c20);
+const uint32_t kSimpleIndexJournalVersion = 1;
+
+// Set in JournalRecord::flags for entries removed from the index.
+const uint32_t kJournalRecordRemoved = 1 << 8;
+
+// The journal starts with a JournalHeader, followed by batches of records,
+// each preceded by a JournalBatchHeader. Like the index file it is in host
+// byte order.
+struct JournalHeader {
+  uint64_t magic_number;
+  uint32_t version;
+  // CRC of the index file the journal follows.
+  uint32_t index_crc;
+};
+static_assert(sizeof(JournalHeader) == 16, "unexpected JournalHeader size");
+
+struct JournalBatchHeader {
+  uint32_t record_count;
+  // See CalculateJournalBatchCRC().
+  uint32_t crc;
+  // As the modification time written by SerializeFinalData().
+  int64_t cache_modified;
+};
+static_assert(sizeof(JournalBatchHeader) == 16,
+              "unexpected JournalBatchHeader size");
+
 uint32_t CalculatePickleCRC(const base::Pickle& pickle) {
   return simple_util::Crc32(pickle.payload(), pickle.payload_size());
 }
 
+// Covers the fields of |header| but |crc|, and the |records_size| bytes of
+// records which follow it.
+uint32_t CalculateJournalBatchCRC(const JournalBatchHeader& header,
+                                  const char* records,
+                                  size_t records_size) {
+  uint32_t crc =
+      simple_util::Crc32(reinterpret_cast<const char*>(&header.record_count),
+                         sizeof(header.record_count));
+  crc = simple_util::IncrementalCrc32(
+      crc, reinterpret_cast<const char*>(&header.cache_modified),
+      sizeof(header.cache_modified));
+  return simple_util::IncrementalCrc32(crc, records,
+                                       base::checked_cast<int>(records_size));
+}
+
+// Starts the journal at |journal_filename| over, for the index file of CRC
+// |index_crc|.
+bool WriteJournalHeader(const base::FilePath& journal_filename,
+                        uint32_t index_crc) {
+  File file(journal_filename,
+            File::FLAG_CREATE_ALWAYS | File::FLAG_WRITE |
+                File::FLAG_SHARE_DELETE);
+  if (!file.IsValid())
+    return false;
+
+  JournalHeader header = {};
+  header.magic_number = kSimpleIndexJournalMagicNumber;
+  header.version = kSimpleIndexJournalVersion;
+  header.index_crc = index_crc;
+  if (file.Write(0, reinterpret_cast<const char*>(&header), sizeof(header)) !=
+      static_cast<int>(sizeof(header))) {
+    file.Close();
+    simple_util::SimpleCacheDeleteFile(journal_filename);
+    return false;
+  }
+  return true;
+}
+
 // Used in histograms. Please only add new values at the end.
 enum IndexFileState {
   INDEX_STATE_CORRUPT = 0,
@@ -213,10 +285,20 @@ void ProcessEntryFile(SimpleIndex::EntrySet* entries,
 
 }  // namespace
 
+struct SimpleIndexFile::JournalRecord {
+  uint64_t entry_hash;
+  int64_t last_used_time;
+  uint32_t entry_size;
+  // The in-memory data of the entry in the low 8 bits, and
+  // kJournalRecordRemoved.
+  uint32_t flags;
+};
+
 SimpleIndexLoadResult::SimpleIndexLoadResult()
     : did_load(false),
       index_write_reason(SimpleIndex::INDEX_WRITE_REASON_MAX),
-      flush_required(false) {}
+      flush_required(false),
+      journal_record_count(-1) {}
 
 SimpleIndexLoadResult::~SimpleIndexLoadResult() = default;
 
@@ -224,6 +306,7 @@ void SimpleIndexLoadResult::Reset() {
   did_load = false;
   index_write_reason = SimpleIndex::INDEX_WRITE_REASON_MAX;
   flush_required = false;
+  journal_record_count = -1;
   entries.clear();
 }
 
@@ -233,6 +316,8 @@ const char SimpleIndexFile::kIndexFileName[] = "the-real-index";
 const char SimpleIndexFile::kIndexDirectory[] = "index-dir";
 // static
 const char SimpleIndexFile::kTempIndexFileName[] = "temp-index";
+// static
+const char SimpleIndexFile::kJournalFileName[] = "the-real-index-journal";
 
 SimpleIndexFile::IndexMetadata::IndexMetadata()
     : magic_number_(kSimpleIndexMagicNumber),
@@ -301,6 +386,12 @@ void SimpleIndexFile::SyncWriteToDisk(net::CacheType cache_type,
     return;
   }
 
+  // The journal of the current index file must not be appended to anymore,
+  // even if writing the new one fails.
+  const base::FilePath journal_filename =
+      index_file_directory.AppendASCII(kJournalFileName);
+  simple_util::SimpleCacheDeleteFile(journal_filename);
+
   // There is a chance that the index containing all the necessary data about
   // newly created entries will appear to be stale. This can happen if on-disk
   // part of a Create operation does not fit into the time budget for the index
@@ -321,6 +412,11 @@ void SimpleIndexFile::SyncWriteToDisk(net::CacheType cache_type,
   if (!base::ReplaceFile(temp_index_filename, index_filename, NULL))
     return;
 
+  if (!WriteJournalHeader(journal_filename,
+                          pickle->headerT<PickleHeader>()->crc)) {
+    LOG(ERROR) << "Failed to start the index journal";
+  }
+
   if (app_on_background) {
     SIMPLE_CACHE_UMA(TIMES,
                      "IndexWriteToDiskTime.Background", cache_type,
@@ -338,11 +434,11 @@ bool SimpleIndexFile::IndexMetadata::CheckIndexMetadata() {
     return false;
   }
 
-  static_assert(kSimpleVersion == 8, "index metadata reader out of date");
+  static_assert(kSimpleVersion == 9, "index metadata reader out of date");
   // No |reason_| is saved in the version 6 file format.
   if (version_ == 6)
     return reason_ == SimpleIndex::INDEX_WRITE_REASON_MAX;
-  return (version_ == 7 || version_ == 8) &&
+  return (version_ == 7 || version_ == 8 || version_ == 9) &&
          reason_ < SimpleIndex::INDEX_WRITE_REASON_MAX;
 }
 
@@ -358,7 +454,9 @@ SimpleIndexFile::SimpleIndexFile(
       index_file_(cache_directory_.AppendASCII(kIndexDirectory)
                       .AppendASCII(kIndexFileName)),
       temp_index_file_(cache_directory_.AppendASCII(kIndexDirectory)
-                           .AppendASCII(kTempIndexFileName)) {}
+                           .AppendASCII(kTempIndexFileName)),
+      journal_file_(cache_directory_.AppendASCII(kIndexDirectory)
+                        .AppendASCII(kJournalFileName)) {}
 
 SimpleIndexFile::~SimpleIndexFile() = default;
 
@@ -391,6 +489,35 @@ void SimpleIndexFile::WriteToDisk(SimpleIndex::IndexWriteToDiskReason reason,
     cache_runner_->PostTaskAndReply(FROM_HERE, task, callback);
 }
 
+void SimpleIndexFile::AppendToJournal(
+    const SimpleIndex::EntrySet& entry_set,
+    const SimpleIndex::HashList& changed_entry_hashes,
+    const base::Closure& callback) {
+  static_assert(sizeof(JournalRecord) == 24, "unexpected JournalRecord size");
+  auto records = std::make_unique<std::vector<JournalRecord>>();
+  records->reserve(changed_entry_hashes.size());
+  for (uint64_t entry_hash : changed_entry_hashes) {
+    JournalRecord record = {};
+    record.entry_hash = entry_hash;
+    SimpleIndex::EntrySet::const_iterator it = entry_set.find(entry_hash);
+    if (it == entry_set.end()) {
+      record.flags = kJournalRecordRemoved;
+    } else {
+      record.last_used_time = it->second.GetLastUsedTime().ToInternalValue();
+      record.entry_size = it->second.GetEntrySize();
+      record.flags = it->second.GetInMemoryData();
+    }
+    records->push_back(record);
+  }
+  base::Closure task =
+      base::Bind(&SimpleIndexFile::SyncAppendToJournal, cache_directory_,
+                 journal_file_, base::Passed(&records));
+  if (callback.is_null())
+    cache_runner_->PostTask(FROM_HERE, task);
+  else
+    cache_runner_->PostTaskAndReply(FROM_HERE, task, callback);
+}
+
 // static
 void SimpleIndexFile::SyncLoadIndexEntries(
     net::CacheType cache_type,
@@ -482,21 +609,147 @@ void SimpleIndexFile::SyncLoadFromDisk(const base::FilePath& index_filename,
     return;
   }
 
-  // Make sure to preallocate in one chunk, so we don't induce fragmentation
-  // reallocating a growing buffer.
-  auto buffer = std::make_unique<char[]>(file_length);
+  // The index file is only ever replaced by renaming a new one over it, so the
+  // mapping can't be truncated under us.
+  uint32_t index_crc = 0;
+  {
+    base::MemoryMappedFile index_file_map;
+    if (file_length > 0 && index_file_map.Initialize(std::move(file))) {
+      index_file_map.SetAccessPattern(
+          base::MemoryMappedFile::SEQUENTIAL_ACCESS);
+      const char* data = reinterpret_cast<const char*>(index_file_map.data());
+      const int data_len = base::checked_cast<int>(index_file_map.length());
+      SimpleIndexFile::Deserialize(data, data_len,
+                                   out_last_cache_seen_by_index, out_result);
+      if (out_result->did_load)
+        index_crc = base::Pickle(data, data_len).headerT<PickleHeader>()->crc;
+    }
+  }
 
-  int read = file.Read(0, buffer.get(), file_length);
-  if (read < file_length) {
+  if (!out_result->did_load) {
     simple_util::SimpleCacheDeleteFile(index_filename);
     return;
   }
 
-  SimpleIndexFile::Deserialize(buffer.get(), read, out_last_cache_seen_by_index,
-                               out_result);
+  out_result->journal_record_count = SyncLoadJournal(
+      index_filename.DirName().AppendASCII(kJournalFileName), index_crc,
+      out_last_cache_seen_by_index, &out_result->entries);
+}
 
-  if (!out_result->did_load)
-    simple_util::SimpleCacheDeleteFile(index_filename);
+// static
+void SimpleIndexFile::SyncAppendToJournal(
+    const base::FilePath& cache_directory,
+    const base::FilePath& journal_filename,
+    std::unique_ptr<std::vector<JournalRecord>> records) {
+  // As in SyncWriteToDisk(), the modification time is taken before writing so
+  // that entries created meanwhile make the journal look stale.
+  base::Time cache_dir_mtime;
+  if (!simple_util::GetMTime(cache_directory, &cache_dir_mtime)) {
+    LOG(ERROR) << "Could obtain information about cache age";
+    return;
+  }
+
+  // The journal is missing if writing the index file it follows failed, in
+  // which case the changes are left for the next WriteToDisk().
+  File file(journal_filename,
+            File::FLAG_OPEN | File::FLAG_APPEND | File::FLAG_SHARE_DELETE);
+  if (!file.IsValid())
+    return;
+
+  const size_t records_size = records->size() * sizeof(JournalRecord);
+  JournalBatchHeader header = {};
+  header.record_count = base::checked_cast<uint32_t>(records->size());
+  header.cache_modified = cache_dir_mtime.ToInternalValue();
+  header.crc = CalculateJournalBatchCRC(
+      header, reinterpret_cast<const char*>(records->data()), records_size);
+
+  // Write the batch at once, so that a partial write leaves at most one torn
+  // batch at the end of the journal.
+  std::vector<char> batch(sizeof(header) + records_size);
+  memcpy(batch.data(), &header, sizeof(header));
+  if (records_size)
+    memcpy(batch.data() + sizeof(header), records->data(), records_size);
+  if (file.WriteAtCurrentPos(batch.data(),
+                             base::checked_cast<int>(batch.size())) !=
+      base::checked_cast<int>(batch.size())) {
+    // Later batches would be stuck behind the torn one.
+    LOG(ERROR) << "Failed to append to the index journal";
+    file.Close();
+    simple_util::SimpleCacheDeleteFile(journal_filename);
+  }
+}
+
+// static
+int64_t SimpleIndexFile::SyncLoadJournal(
+    const base::FilePath& journal_filename,
+    uint32_t index_crc,
+    base::Time* out_last_cache_seen_by_index,
+    SimpleIndex::EntrySet* entries) {
+  File file(journal_filename, File::FLAG_OPEN | File::FLAG_READ |
+                                  File::FLAG_SHARE_DELETE |
+                                  File::FLAG_SEQUENTIAL_SCAN);
+  if (!file.IsValid())
+    return -1;
+
+  const int64_t file_length = file.GetLength();
+  if (file_length < static_cast<int64_t>(sizeof(JournalHeader)) ||
+      file_length > kMaxJournalFileSizeBytes) {
+    return -1;
+  }
+  const size_t length = static_cast<size_t>(file_length);
+  auto buffer = std::make_unique<char[]>(length);
+  if (file.Read(0, buffer.get(), base::checked_cast<int>(length)) !=
+      file_length) {
+    return -1;
+  }
+
+  JournalHeader header;
+  memcpy(&header, buffer.get(), sizeof(header));
+  if (header.magic_number != kSimpleIndexJournalMagicNumber ||
+      header.version != kSimpleIndexJournalVersion ||
+      header.index_crc != index_crc) {
+    return -1;
+  }
+
+  // Batches are applied up to the first which is torn or corrupt.
+  int64_t record_count = 0;
+  size_t offset = sizeof(header);
+  while (offset < length) {
+    JournalBatchHeader batch_header;
+    if (length - offset < sizeof(batch_header))
+      return -1;
+    memcpy(&batch_header, buffer.get() + offset, sizeof(batch_header));
+    offset += sizeof(batch_header);
+    if (batch_header.record_count > (length - offset) / sizeof(JournalRecord))
+      return -1;
+    const char* records = buffer.get() + offset;
+    const size_t records_size =
+        batch_header.record_count * sizeof(JournalRecord);
+    if (CalculateJournalBatchCRC(batch_header, records, records_size) !=
+        batch_header.crc) {
+      return -1;
+    }
+
+    for (uint32_t i = 0; i < batch_header.record_count; ++i) {
+      JournalRecord record;
+      memcpy(&record, records + i * sizeof(JournalRecord), sizeof(record));
+      if (record.flags & kJournalRecordRemoved) {
+        entries->erase(record.entry_hash);
+        continue;
+      }
+      EntryMetadata entry_metadata(
+          base::Time::FromInternalValue(record.last_used_time),
+          record.entry_size);
+      entry_metadata.SetInMemoryData(static_cast<uint8_t>(record.flags));
+      (*entries)[record.entry_hash] = entry_metadata;
+    }
+    offset += records_size;
+    record_count += batch_header.record_count;
+    *out_last_cache_seen_by_index =
+        std::max(*out_last_cache_seen_by_index,
+                 base::Time::FromInternalValue(batch_header.cache_modified));
+  }
+  return record_count;
 }
 
 // static
@@ -585,6 +838,8 @@ void SimpleIndexFile::SyncRestoreFromDisk(
     SimpleIndexLoadResult* out_result) {
   VLOG(1) << "Simple Cache Index is being restored from disk.";
   simple_util::SimpleCacheDeleteFile(index_file_path);
+  simple_util::SimpleCacheDeleteFile(
+      index_file_path.DirName().AppendASCII(kJournalFileName));
   out_result->Reset();
   SimpleIndex::EntrySet* entries = &out_result->entries;
 
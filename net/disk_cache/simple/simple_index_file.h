@@ -39,6 +39,10 @@ struct NET_EXPORT_PRIVATE SimpleIndexLoadResult {
   SimpleIndex::IndexWriteToDiskReason index_write_reason;
   SimpleIndex::IndexInitMethod init_method;
   bool flush_required;
+
+  // Number of journal records replayed on top of the index file, or -1 if
+  // there is no journal which later changes can be appended to.
+  int64_t journal_record_count;
 };
 
 // Simple Index File format is a pickle of IndexMetadata and EntryMetadata
@@ -47,6 +51,12 @@ struct NET_EXPORT_PRIVATE SimpleIndexLoadResult {
 // the format see |SimpleIndexFile::Serialize()| and
 // |SimpleIndexFile::LoadFromDisk()|.
 //
+// Next to the index file is a journal of the entries changed since it was
+// written, as fixed-size records appended in batches by AppendToJournal(), so
+// that flushing the index costs O(changed entries) rather than rewriting all
+// of it. The journal is replayed on top of the index file when loading, and is
+// started over by each WriteToDisk().
+//
 // The non-static methods must run on the IO thread. All the real
 // work is done in the static methods, which are run on the cache thread
 // or in worker threads. Synchronization between methods is the
@@ -105,9 +115,19 @@ class NET_EXPORT_PRIVATE SimpleIndexFile {
                            bool app_on_background,
                            const base::Closure& callback);
 
+  // Appends the current state of |changed_entry_hashes| in |entry_set| to the
+  // journal, those missing from it being recorded as removed. Only valid after
+  // the index file was loaded with a journal, or written by WriteToDisk().
+  virtual void AppendToJournal(
+      const SimpleIndex::EntrySet& entry_set,
+      const SimpleIndex::HashList& changed_entry_hashes,
+      const base::Closure& callback);
+
  private:
   friend class WrappedSimpleIndexFile;
 
+  struct JournalRecord;
+
   // Used for cache directory traversal.
   using EntryFileCallback = base::Callback<void(const base::FilePath&,
                                                 base::Time last_accessed,
@@ -125,7 +145,8 @@ class NET_EXPORT_PRIVATE SimpleIndexFile {
                                    const base::FilePath& index_file_path,
                                    SimpleIndexLoadResult* out_result);
 
-  // Load the index file from disk returning an EntrySet.
+  // Load the index file from disk returning an EntrySet. Also replays the
+  // journal of the index file, if any.
   static void SyncLoadFromDisk(const base::FilePath& index_filename,
                                base::Time* out_last_cache_seen_by_index,
                                SimpleIndexLoadResult* out_result);
@@ -161,7 +182,7 @@ class NET_EXPORT_PRIVATE SimpleIndexFile {
       const base::FilePath& cache_path,
       const EntryFileCallback& entry_file_callback);
 
-  // Writes the index file to disk atomically.
+  // Writes the index file to disk atomically, and starts a new journal for it.
   static void SyncWriteToDisk(net::CacheType cache_type,
                               const base::FilePath& cache_directory,
                               const base::FilePath& index_filename,
@@ -170,6 +191,23 @@ class NET_EXPORT_PRIVATE SimpleIndexFile {
                               const base::TimeTicks& start_time,
                               bool app_on_background);
 
+  // Appends a batch of |records| to the journal at |journal_filename|, if it
+  // exists.
+  static void SyncAppendToJournal(
+      const base::FilePath& cache_directory,
+      const base::FilePath& journal_filename,
+      std::unique_ptr<std::vector<JournalRecord>> records);
+
+  // Applies the journal at |journal_filename| to |entries|, if it follows the
+  // index file of CRC |index_crc|, and moves |*out_last_cache_seen_by_index|
+  // to when the last batch was written. Returns the number of records
+  // applied, or -1 if the journal can't be appended to, e.g. because it is
+  // missing or its end is torn.
+  static int64_t SyncLoadJournal(const base::FilePath& journal_filename,
+                                 uint32_t index_crc,
+                                 base::Time* out_last_cache_seen_by_index,
+                                 SimpleIndex::EntrySet* entries);
+
   // Scan the index directory for entries, returning an EntrySet of all entries
   // found.
   static void SyncRestoreFromDisk(const base::FilePath& cache_directory,
@@ -193,10 +231,12 @@ class NET_EXPORT_PRIVATE SimpleIndexFile {
   const base::FilePath cache_directory_;
   const base::FilePath index_file_;
   const base::FilePath temp_index_file_;
+  const base::FilePath journal_file_;
 
   static const char kIndexDirectory[];
   static const char kIndexFileName[];
   static const char kTempIndexFileName[];
+  static const char kJournalFileName[];
 
   DISALLOW_COPY_AND_ASSIGN(SimpleIndexFile);
 };
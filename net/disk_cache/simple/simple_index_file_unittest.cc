@@ -165,6 +165,8 @@ class WrappedSimpleIndexFile : public SimpleIndexFile {
     return temp_index_file_;
   }
 
+  const base::FilePath& GetJournalFilePath() const { return journal_file_; }
+
   bool CreateIndexFileDirectory() const {
     return base::CreateDirectory(index_file_.DirName());
   }
@@ -339,6 +341,67 @@ TEST_F(SimpleIndexFileTest, WriteThenLoadIndex) {
     EXPECT_EQ(1U, load_index_result.entries.count(kHashes[i]));
 }
 
+TEST_F(SimpleIndexFileTest, AppendToJournalThenLoadIndex) {
+  base::ScopedTempDir cache_dir;
+  ASSERT_TRUE(cache_dir.CreateUniqueTempDir());
+
+  SimpleIndex::EntrySet entries;
+  static const uint64_t kHashes[] = {11, 22, 33};
+  for (uint64_t hash : kHashes) {
+    SimpleIndex::InsertInEntrySet(
+        hash, EntryMetadata(Time(), static_cast<uint32_t>(hash)), &entries);
+  }
+
+  net::TestClosure closure;
+  WrappedSimpleIndexFile simple_index_file(cache_dir.GetPath());
+  simple_index_file.WriteToDisk(SimpleIndex::INDEX_WRITE_REASON_SHUTDOWN,
+                                entries, 0, base::TimeTicks(), false,
+                                closure.closure());
+  closure.WaitForResult();
+  EXPECT_TRUE(base::PathExists(simple_index_file.GetJournalFilePath()));
+
+  // Update one entry, remove another and add a new one.
+  const uint64_t kNewHash = 44;
+  entries.erase(22);
+  SimpleIndex::InsertInEntrySet(kNewHash, EntryMetadata(Time(), 4096u),
+                                &entries);
+  entries[11].SetEntrySize(8192u);
+  simple_index_file.AppendToJournal(entries, {11, 22, kNewHash},
+                                    closure.closure());
+  closure.WaitForResult();
+
+  base::Time fake_cache_mtime;
+  ASSERT_TRUE(simple_util::GetMTime(cache_dir.GetPath(), &fake_cache_mtime));
+  SimpleIndexLoadResult load_index_result;
+  simple_index_file.LoadIndexEntries(fake_cache_mtime, closure.closure(),
+                                     &load_index_result);
+  closure.WaitForResult();
+
+  EXPECT_TRUE(load_index_result.did_load);
+  EXPECT_FALSE(load_index_result.flush_required);
+  EXPECT_EQ(3, load_index_result.journal_record_count);
+  ASSERT_EQ(3U, load_index_result.entries.size());
+  EXPECT_EQ(0U, load_index_result.entries.count(22));
+  EXPECT_EQ(8192U, load_index_result.entries[11].GetEntrySize());
+  EXPECT_EQ(256U, load_index_result.entries[33].GetEntrySize());
+  EXPECT_EQ(4096U, load_index_result.entries[kNewHash].GetEntrySize());
+
+  // A torn batch at the end of the journal is ignored, and the journal can't
+  // be appended to anymore.
+  const char kGarbage[] = "torn";
+  ASSERT_TRUE(base::AppendToFile(simple_index_file.GetJournalFilePath(),
+                                 kGarbage, sizeof(kGarbage)));
+  SimpleIndexLoadResult torn_load_index_result;
+  simple_index_file.LoadIndexEntries(fake_cache_mtime, closure.closure(),
+                                     &torn_load_index_result);
+  closure.WaitForResult();
+
+  EXPECT_TRUE(torn_load_index_result.did_load);
+  EXPECT_EQ(-1, torn_load_index_result.journal_record_count);
+  EXPECT_EQ(3U, torn_load_index_result.entries.size());
+  EXPECT_EQ(0U, torn_load_index_result.entries.count(22));
+}
+
 TEST_F(SimpleIndexFileTest, LoadCorruptIndex) {
   base::ScopedTempDir cache_dir;
   ASSERT_TRUE(cache_dir.CreateUniqueTempDir());
@@ -71,7 +71,8 @@ class MockSimpleIndexFile : public SimpleIndexFile,
       : SimpleIndexFile(NULL, NULL, net::DISK_CACHE, base::FilePath()),
         load_result_(NULL),
         load_index_entries_calls_(0),
-        disk_writes_(0) {}
+        disk_writes_(0),
+        journal_appends_(0) {}
 
   void LoadIndexEntries(base::Time cache_last_modified,
                         const base::Closure& callback,
@@ -91,6 +92,13 @@ class MockSimpleIndexFile : public SimpleIndexFile,
     disk_write_entry_set_ = entry_set;
   }
 
+  void AppendToJournal(const SimpleIndex::EntrySet& entry_set,
+                       const SimpleIndex::HashList& changed_entry_hashes,
+                       const base::Closure& callback) override {
+    journal_appends_++;
+    journal_changed_entry_hashes_ = changed_entry_hashes;
+  }
+
   void GetAndResetDiskWriteEntrySet(SimpleIndex::EntrySet* entry_set) {
     entry_set->swap(disk_write_entry_set_);
   }
@@ -99,6 +107,10 @@ class MockSimpleIndexFile : public SimpleIndexFile,
   SimpleIndexLoadResult* load_result() const { return load_result_; }
   int load_index_entries_calls() const { return load_index_entries_calls_; }
   int disk_writes() const { return disk_writes_; }
+  int journal_appends() const { return journal_appends_; }
+  const SimpleIndex::HashList& journal_changed_entry_hashes() const {
+    return journal_changed_entry_hashes_;
+  }
 
  private:
   base::Closure load_callback_;
@@ -106,6 +118,8 @@ class MockSimpleIndexFile : public SimpleIndexFile,
   int load_index_entries_calls_;
   int disk_writes_;
   SimpleIndex::EntrySet disk_write_entry_set_;
+  int journal_appends_;
+  SimpleIndex::HashList journal_changed_entry_hashes_;
 };
 
 class SimpleIndexTest : public net::TestWithScopedTaskEnvironment,
@@ -755,6 +769,39 @@ TEST_F(SimpleIndexTest, DiskWriteExecuted) {
   EXPECT_EQ(RoundSize(20u), entry1.GetEntrySize());
 }
 
+TEST_F(SimpleIndexTest, DiskWriteAppendsToJournal) {
+  index()->SetMaxSize(1000);
+  const uint64_t kHash1 = hashes_.at<1>();
+  const uint64_t kHash2 = hashes_.at<2>();
+  const uint64_t kHash3 = hashes_.at<3>();
+  InsertIntoIndexFileReturn(kHash1, base::Time::Now(), 10u);
+  InsertIntoIndexFileReturn(kHash2, base::Time::Now(), 10u);
+  index_file_->load_result()->journal_record_count = 0;
+  ReturnIndexFile();
+
+  index()->UseIfExists(kHash1);
+  index()->Remove(kHash2);
+  index()->Insert(kHash3);
+  index()->UpdateEntrySize(kHash3, 20u);
+  index()->write_to_disk_timer_.Stop();
+  index()->WriteToDisk(SimpleIndex::INDEX_WRITE_REASON_IDLE);
+
+  // Only the changed entries are written, to the journal.
+  EXPECT_EQ(0, index_file_->disk_writes());
+  EXPECT_EQ(1, index_file_->journal_appends());
+  SimpleIndex::HashList changed_entry_hashes =
+      index_file_->journal_changed_entry_hashes();
+  std::sort(changed_entry_hashes.begin(), changed_entry_hashes.end());
+  SimpleIndex::HashList expected_hashes = {kHash1, kHash2, kHash3};
+  std::sort(expected_hashes.begin(), expected_hashes.end());
+  EXPECT_EQ(expected_hashes, changed_entry_hashes);
+
+  // Nothing changed since.
+  index()->WriteToDisk(SimpleIndex::INDEX_WRITE_REASON_IDLE);
+  EXPECT_EQ(2, index_file_->journal_appends());
+  EXPECT_TRUE(index_file_->journal_changed_entry_hashes().empty());
+}
+
 TEST_F(SimpleIndexTest, DiskWritePostponed) {
   index()->SetMaxSize(1000);
   ReturnIndexFile();
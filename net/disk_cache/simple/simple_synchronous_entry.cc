@@ -39,6 +39,20 @@ namespace disk_cache {
 
 namespace {
 
+// Streams smaller than this aren't worth compressing.
+const int kMinCompressedStreamSize = 4 * 1024;
+
+// Returns whether compressing |size| bytes into |compressed_size| bytes saves
+// enough to be worth decompressing on reads.
+bool IsWorthCompressing(int size, size_t compressed_size) {
+  return compressed_size <= static_cast<size_t>(size - size / 8);
+}
+
+int GetCompressedChunkCount(int stream_size) {
+  return (stream_size + kSimpleCompressedChunkSize - 1) /
+         kSimpleCompressedChunkSize;
+}
+
 void RecordSyncOpenResult(net::CacheType cache_type,
                           OpenEntryResult result,
                           bool had_index) {
@@ -133,6 +147,9 @@ const base::Feature kSimpleCachePrefetchExperiment = {
     "SimpleCachePrefetchExperiment", base::FEATURE_DISABLED_BY_DEFAULT};
 const char kSimplePrefetchBytesParam[] = "Bytes";
 
+const base::Feature kSimpleCacheCompressStream1 = {
+    "SimpleCacheCompressStream1", base::FEATURE_DISABLED_BY_DEFAULT};
+
 int GetSimpleCachePrefetchSize() {
   return base::GetFieldTrialParamByFeatureAsInt(kSimpleCachePrefetchExperiment,
                                                 kSimplePrefetchBytesParam, 0);
@@ -396,8 +413,14 @@ void SimpleSynchronousEntry::ReadData(const ReadRequest& in_entry_op,
   // be handled in the SimpleEntryImpl.
   DCHECK_GT(in_entry_op.buf_len, 0);
   DCHECK(!empty_file_omitted_[file_index]);
-  int bytes_read =
-      file->Read(file_offset, out_buf->data(), in_entry_op.buf_len);
+  int bytes_read;
+  if (in_entry_op.index == 1 && stream_1_compressed_) {
+    bytes_read = ReadCompressedStream1(file.get(), entry_stat->data_size(1),
+                                       in_entry_op.offset, in_entry_op.buf_len,
+                                       out_buf->data());
+  } else {
+    bytes_read = file->Read(file_offset, out_buf->data(), in_entry_op.buf_len);
+  }
   if (bytes_read > 0) {
     entry_stat->set_last_used(Time::Now());
     if (in_entry_op.request_update_crc) {
@@ -449,6 +472,19 @@ void SimpleSynchronousEntry::WriteData(const WriteRequest& in_entry_op,
       return;
     }
   }
+  if (index == 1 && stream_1_compressed_) {
+    // Writes go to the uncompressed data; the stream gets compressed again on
+    // close.
+    SimpleFileTracker::FileHandle file =
+        file_tracker_->Acquire(this, SubFileForFileIndex(file_index));
+    if (!file.IsOK() ||
+        !DecompressStream1(file.get(), out_entry_stat->data_size(1))) {
+      RecordWriteResult(cache_type_, SYNC_WRITE_RESULT_WRITE_FAILURE);
+      Doom();
+      out_write_result->result = net::ERR_CACHE_WRITE_FAILURE;
+      return;
+    }
+  }
   int offset = in_entry_op.offset;
   int buf_len = in_entry_op.buf_len;
   bool truncate = in_entry_op.truncate;
@@ -778,7 +814,8 @@ int SimpleSynchronousEntry::CheckEOFRecord(base::File* file,
                                            uint32_t expected_crc32) {
   DCHECK(initialized_);
   SimpleFileEOF eof_record;
-  int file_offset = entry_stat.GetEOFOffsetInFile(key_.size(), stream_index);
+  int file_offset = GetFileLayoutStat(entry_stat).GetEOFOffsetInFile(
+      key_.size(), stream_index);
   int file_index = GetFileIndexFromStreamIndex(stream_index);
   int rv = GetEOFRecordData(file, base::StringPiece(), file_index, file_offset,
                             &eof_record);
@@ -837,6 +874,23 @@ void SimpleSynchronousEntry::Close(
   base::ElapsedTimer close_time;
   DCHECK(stream_0_data);
 
+  // Stream 1 is compressed once it is complete, and before the streams after
+  // it get written.
+  if (base::FeatureList::IsEnabled(kSimpleCacheCompressStream1) &&
+      !stream_1_compressed_ &&
+      std::any_of(crc32s_to_write->begin(), crc32s_to_write->end(),
+                  [](const CRCRecord& record) { return record.index == 1; })) {
+    SimpleFileTracker::FileHandle file =
+        file_tracker_->Acquire(this, SimpleFileTracker::SubFile::FILE_0);
+    if (!file.IsOK() ||
+        !MaybeCompressStream1(file.get(), entry_stat.data_size(1))) {
+      RecordCloseResult(cache_type_, CLOSE_RESULT_WRITE_FAILURE);
+      DVLOG(1) << "Could not compress stream 1.";
+      Doom();
+    }
+  }
+  const SimpleEntryStat file_layout_stat = GetFileLayoutStat(entry_stat);
+
   for (std::vector<CRCRecord>::iterator it = crc32s_to_write->begin();
        it != crc32s_to_write->end(); ++it) {
     const int stream_index = it->index;
@@ -854,7 +908,8 @@ void SimpleSynchronousEntry::Close(
 
     if (stream_index == 0) {
       // Write stream 0 data.
-      int stream_0_offset = entry_stat.GetOffsetInFile(key_.size(), 0, 0);
+      int stream_0_offset =
+          file_layout_stat.GetOffsetInFile(key_.size(), 0, 0);
       if (file->Write(stream_0_offset, stream_0_data->data(),
                       entry_stat.data_size(0)) != entry_stat.data_size(0)) {
         RecordCloseResult(cache_type_, CLOSE_RESULT_WRITE_FAILURE);
@@ -887,10 +942,14 @@ void SimpleSynchronousEntry::Close(
     eof_record.flags = 0;
     if (it->has_crc32)
       eof_record.flags |= SimpleFileEOF::FLAG_HAS_CRC32;
-    if (stream_index == 0)
+    if (stream_index == 0) {
       eof_record.flags |= SimpleFileEOF::FLAG_HAS_KEY_SHA256;
+      if (stream_1_compressed_)
+        eof_record.flags |= SimpleFileEOF::FLAG_STREAM_1_COMPRESSED;
+    }
     eof_record.data_crc32 = it->data_crc32;
-    int eof_offset = entry_stat.GetEOFOffsetInFile(key_.size(), stream_index);
+    int eof_offset =
+        file_layout_stat.GetEOFOffsetInFile(key_.size(), stream_index);
     // If stream 0 changed size, the file needs to be resized, otherwise the
     // next open will yield wrong stream sizes. On stream 1 and stream 2 proper
     // resizing of the file is handled in SimpleSynchronousEntry::WriteData().
@@ -1441,9 +1500,29 @@ int SimpleSynchronousEntry::ReadAndValidateStream0AndMaybe1(
   if (rv != net::OK)
     return rv;
 
+  // A compressed stream 1 takes |stream1_size| bytes of the file, the size of
+  // its data is in its EOF record.
+  if (stream_0_eof.flags & SimpleFileEOF::FLAG_STREAM_1_COMPRESSED) {
+    SimpleFileEOF stream_1_eof;
+    rv = GetEOFRecordData(
+        file.get(), file_0_prefetch, /* file_index = */ 0,
+        out_entry_stat->GetEOFOffsetInFile(key_.size(), /* stream_index = */ 1),
+        &stream_1_eof);
+    if (rv != net::OK)
+      return rv;
+    const int32_t chunk_table_size =
+        GetCompressedChunkCount(stream_1_eof.stream_size) * sizeof(uint32_t);
+    if (chunk_table_size > stream1_size)
+      return net::ERR_FAILED;
+    stream_1_compressed_ = true;
+    stream_1_file_size_ = stream1_size;
+    out_entry_stat->set_data_size(1, stream_1_eof.stream_size);
+  }
+
   // If prefetch buffer is available, and we have sha256(key) (so we don't need
-  // to look at the header), extract out stream 1 info as well.
-  if (prefetch_buf && has_key_sha256) {
+  // to look at the header), extract out stream 1 info as well. A compressed
+  // stream 1 is left for reads to decompress.
+  if (prefetch_buf && has_key_sha256 && !stream_1_compressed_) {
     SimpleFileEOF stream_1_eof;
     rv = GetEOFRecordData(
         file.get(), file_0_prefetch, /* file_index = */ 0,
@@ -1617,6 +1696,173 @@ base::FilePath SimpleSynchronousEntry::GetFilenameForSubfile(
     return GetFilenameFromFileIndex(FileIndexForSubFile(sub_file));
 }
 
+SimpleEntryStat SimpleSynchronousEntry::GetFileLayoutStat(
+    const SimpleEntryStat& entry_stat) const {
+  SimpleEntryStat file_layout_stat = entry_stat;
+  if (stream_1_compressed_)
+    file_layout_stat.set_data_size(1, stream_1_file_size_);
+  return file_layout_stat;
+}
+
+bool SimpleSynchronousEntry::MaybeCompressStream1(base::File* file,
+                                                  int stream_1_size) {
+  DCHECK(!stream_1_compressed_);
+  if (stream_1_size < kMinCompressedStreamSize)
+    return true;
+
+  const int64_t stream_1_offset = GetHeaderSize(key_.size());
+  const int chunk_count = GetCompressedChunkCount(stream_1_size);
+  std::vector<char> chunk(kSimpleCompressedChunkSize);
+  std::vector<char> compressed;
+  std::vector<uint32_t> chunk_ends;
+  chunk_ends.reserve(chunk_count);
+  for (int i = 0; i < chunk_count; ++i) {
+    const int chunk_offset = i * kSimpleCompressedChunkSize;
+    const int chunk_size =
+        std::min(kSimpleCompressedChunkSize, stream_1_size - chunk_offset);
+    if (file->Read(stream_1_offset + chunk_offset, chunk.data(), chunk_size) !=
+        chunk_size) {
+      return false;
+    }
+
+    const size_t compressed_so_far = compressed.size();
+    uLongf compressed_size = compressBound(chunk_size);
+    compressed.resize(compressed_so_far + compressed_size);
+    if (compress2(reinterpret_cast<Bytef*>(compressed.data()) +
+                      compressed_so_far,
+                  &compressed_size, reinterpret_cast<Bytef*>(chunk.data()),
+                  chunk_size, Z_BEST_SPEED) != Z_OK) {
+      return true;
+    }
+    compressed.resize(compressed_so_far + compressed_size);
+    chunk_ends.push_back(compressed.size());
+
+    // Give up on the first chunk for data which is compressed already, e.g.
+    // images.
+    if (i == 0 && !IsWorthCompressing(chunk_size, compressed_size))
+      return true;
+  }
+
+  const size_t chunk_table_size = chunk_ends.size() * sizeof(uint32_t);
+  if (!IsWorthCompressing(stream_1_size, compressed.size() + chunk_table_size))
+    return true;
+  const char* chunk_table = reinterpret_cast<const char*>(chunk_ends.data());
+  compressed.insert(compressed.end(), chunk_table,
+                    chunk_table + chunk_table_size);
+
+  const int stream_1_file_size = compressed.size();
+  if (file->Write(stream_1_offset, compressed.data(), stream_1_file_size) !=
+      stream_1_file_size) {
+    return false;
+  }
+  stream_1_compressed_ = true;
+  stream_1_file_size_ = stream_1_file_size;
+  stream_1_chunk_ends_ = std::move(chunk_ends);
+  stream_1_chunk_index_ = -1;
+  return true;
+}
+
+bool SimpleSynchronousEntry::DecompressStream1(base::File* file,
+                                               int stream_1_size) {
+  DCHECK(stream_1_compressed_);
+  // Decompress everything first, since the data overwrites the chunks.
+  std::vector<char> data(stream_1_size);
+  if (ReadCompressedStream1(file, stream_1_size, 0, stream_1_size,
+                            data.data()) != stream_1_size) {
+    return false;
+  }
+  const int64_t stream_1_offset = GetHeaderSize(key_.size());
+  if (file->Write(stream_1_offset, data.data(), stream_1_size) !=
+          stream_1_size ||
+      !file->SetLength(stream_1_offset + stream_1_size)) {
+    return false;
+  }
+  stream_1_compressed_ = false;
+  stream_1_file_size_ = 0;
+  stream_1_chunk_ends_.clear();
+  stream_1_chunk_index_ = -1;
+  stream_1_chunk_data_.clear();
+  return true;
+}
+
+int SimpleSynchronousEntry::ReadCompressedStream1(base::File* file,
+                                                  int stream_1_size,
+                                                  int offset,
+                                                  int size,
+                                                  char* dest) {
+  DCHECK(stream_1_compressed_);
+  size = std::min(size, stream_1_size - offset);
+  int bytes_read = 0;
+  while (bytes_read < size) {
+    const int chunk_index = (offset + bytes_read) / kSimpleCompressedChunkSize;
+    if (!LoadCompressedStream1Chunk(file, stream_1_size, chunk_index))
+      return -1;
+    const int offset_in_chunk =
+        offset + bytes_read - chunk_index * kSimpleCompressedChunkSize;
+    const int size_from_chunk =
+        std::min(size - bytes_read,
+                 static_cast<int>(stream_1_chunk_data_.size()) -
+                     offset_in_chunk);
+    memcpy(dest + bytes_read, stream_1_chunk_data_.data() + offset_in_chunk,
+           size_from_chunk);
+    bytes_read += size_from_chunk;
+  }
+  return bytes_read;
+}
+
+bool SimpleSynchronousEntry::LoadCompressedStream1Chunk(base::File* file,
+                                                        int stream_1_size,
+                                                        int chunk_index) {
+  if (chunk_index == stream_1_chunk_index_)
+    return true;
+
+  const int64_t stream_1_offset = GetHeaderSize(key_.size());
+  const int chunk_count = GetCompressedChunkCount(stream_1_size);
+  DCHECK_LT(chunk_index, chunk_count);
+  const int chunk_table_size = chunk_count * sizeof(uint32_t);
+  const uint32_t chunks_size = stream_1_file_size_ - chunk_table_size;
+  if (stream_1_chunk_ends_.empty()) {
+    std::vector<uint32_t> chunk_ends(chunk_count);
+    if (file->Read(stream_1_offset + chunks_size,
+                   reinterpret_cast<char*>(chunk_ends.data()),
+                   chunk_table_size) != chunk_table_size) {
+      return false;
+    }
+    uint32_t previous_chunk_end = 0;
+    for (uint32_t chunk_end : chunk_ends) {
+      if (chunk_end < previous_chunk_end || chunk_end > chunks_size)
+        return false;
+      previous_chunk_end = chunk_end;
+    }
+    stream_1_chunk_ends_ = std::move(chunk_ends);
+  }
+
+  const uint32_t chunk_start =
+      chunk_index == 0 ? 0 : stream_1_chunk_ends_[chunk_index - 1];
+  const int compressed_size = stream_1_chunk_ends_[chunk_index] - chunk_start;
+  std::vector<char> compressed(compressed_size);
+  if (file->Read(stream_1_offset + chunk_start, compressed.data(),
+                 compressed_size) != compressed_size) {
+    return false;
+  }
+
+  const int chunk_size =
+      std::min(kSimpleCompressedChunkSize,
+               stream_1_size - chunk_index * kSimpleCompressedChunkSize);
+  stream_1_chunk_index_ = -1;
+  stream_1_chunk_data_.resize(chunk_size);
+  uLongf uncompressed_size = chunk_size;
+  if (uncompress(reinterpret_cast<Bytef*>(stream_1_chunk_data_.data()),
+                 &uncompressed_size,
+                 reinterpret_cast<const Bytef*>(compressed.data()),
+                 compressed_size) != Z_OK ||
+      uncompressed_size != static_cast<uLongf>(chunk_size)) {
+    return false;
+  }
+  stream_1_chunk_index_ = chunk_index;
+  return true;
+}
+
 bool SimpleSynchronousEntry::OpenSparseFileIfExists(
     int32_t* out_sparse_data_size) {
   DCHECK(!sparse_file_open());
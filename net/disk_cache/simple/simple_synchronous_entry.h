@@ -38,6 +38,10 @@ namespace disk_cache {
 NET_EXPORT_PRIVATE extern const base::Feature kSimpleCachePrefetchExperiment;
 NET_EXPORT_PRIVATE extern const char kSimplePrefetchBytesParam[];
 
+// Compresses stream 1 of entries on close when it is large enough and
+// compresses well, e.g. for text resources. See simple_entry_format.h.
+NET_EXPORT_PRIVATE extern const base::Feature kSimpleCacheCompressStream1;
+
 // Returns how large a file would get prefetched on reading the entry.
 // If the experiment is disabled, returns 0.
 NET_EXPORT_PRIVATE int GetSimpleCachePrefetchSize();
@@ -394,6 +398,34 @@ class SimpleSynchronousEntry {
                            const SimpleFileEOF& eof_record,
                            SimpleStreamPrefetchData* out);
 
+  // Returns |entry_stat| with the number of bytes stream 1 takes in file 0 in
+  // place of its size, for computing the layout of file 0.
+  SimpleEntryStat GetFileLayoutStat(const SimpleEntryStat& entry_stat) const;
+
+  // Replaces stream 1 of |stream_1_size| bytes in |file| by its compressed
+  // chunks if it is large enough and they are sufficiently smaller; leaves it
+  // as it is otherwise. Returns false on IO errors.
+  bool MaybeCompressStream1(base::File* file, int stream_1_size);
+
+  // Replaces the compressed stream 1 in |file| by its data, and truncates the
+  // file after it: the streams which followed must be rewritten by Close().
+  // Returns false on failure.
+  bool DecompressStream1(base::File* file, int stream_1_size);
+
+  // Reads up to |size| bytes of the compressed stream 1 from |offset| into
+  // |dest|. Returns the number of bytes read, or -1 on failure.
+  int ReadCompressedStream1(base::File* file,
+                            int stream_1_size,
+                            int offset,
+                            int size,
+                            char* dest);
+
+  // Decompresses chunk |chunk_index| of the compressed stream 1 into
+  // |stream_1_chunk_data_|, reading the table of chunks first if needed.
+  bool LoadCompressedStream1Chunk(base::File* file,
+                                  int stream_1_size,
+                                  int chunk_index);
+
   // Opens the sparse data file and scans it if it exists.
   bool OpenSparseFileIfExists(int32_t* out_sparse_data_size);
 
@@ -472,6 +504,20 @@ class SimpleSynchronousEntry {
   // was created to store it.
   bool empty_file_omitted_[kSimpleEntryNormalFileCount];
 
+  // True if stream 1 is stored compressed, in |stream_1_file_size_| bytes of
+  // file 0 including the table of chunk end offsets.
+  bool stream_1_compressed_ = false;
+  int32_t stream_1_file_size_ = 0;
+
+  // The table of chunk end offsets of the compressed stream 1, read on the
+  // first read of the stream.
+  std::vector<uint32_t> stream_1_chunk_ends_;
+
+  // The chunk of the compressed stream 1 last decompressed by a read, so that
+  // sequential reads decompress each chunk once.
+  int stream_1_chunk_index_ = -1;
+  std::vector<char> stream_1_chunk_data_;
+
   typedef std::map<int64_t, SparseRange> SparseRangeOffsetMap;
   typedef SparseRangeOffsetMap::iterator SparseRangeIterator;
   SparseRangeOffsetMap sparse_ranges_;
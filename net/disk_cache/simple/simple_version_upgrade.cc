@@ -204,6 +204,12 @@ bool UpgradeSimpleCacheOnDisk(const base::FilePath& path,
     version_from++;
   }
 
+  if (version_from == 8) {
+    // V9 entries may have a compressed stream 1, which is flagged in their
+    // files, so V8 entries can be read as they are.
+    version_from++;
+  }
+
   DCHECK_EQ(kSimpleVersion, version_from);
 
   if (!new_fake_index_needed)
@@ -194,6 +194,7 @@ class NET_EXPORT HostCache {
   void OnNetworkChange();
 
   void set_persistence_delegate(PersistenceDelegate* delegate);
+  bool has_persistence_delegate() const { return delegate_ != nullptr; }
 
   void set_tick_clock_for_testing(const base::TickClock* tick_clock) {
     tick_clock_ = tick_clock;
@@ -30,6 +30,7 @@
 #include "base/containers/linked_list.h"
 #include "base/debug/debugger.h"
 #include "base/debug/stack_trace.h"
+#include "base/feature_list.h"
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
 #include "base/metrics/field_trial.h"
@@ -299,6 +300,13 @@ const base::FeatureParam<base::TaskPriority> priority_mode{
     &kSystemResolverPriorityExperiment, "mode",
     base::TaskPriority::USER_VISIBLE, &prio_modes};
 
+// When enabled, a DnsTask for an unspecified address family sends its A and
+// AAAA queries at the same time instead of waiting for a second dispatcher
+// slot for the AAAA query. DnsTransactions don't block a thread, so only the
+// ProcTask fallback needs to be bounded by the dispatcher limits.
+const base::Feature kAsyncDnsRaceAddressFamilies = {
+    "AsyncDnsRaceAddressFamilies", base::FEATURE_DISABLED_BY_DEFAULT};
+
 //-----------------------------------------------------------------------------
 
 AddressList EnsurePortOnAddressList(const AddressList& list, uint16_t port) {
@@ -1013,6 +1021,7 @@ class HostResolverImpl::DnsTask : public base::SupportsWeakPtr<DnsTask> {
         delegate_(delegate),
         net_log_(job_net_log),
         num_completed_transactions_(0),
+        raced_transactions_(false),
         tick_clock_(tick_clock),
         task_start_time_(tick_clock_->NowTicks()) {
     DCHECK(client);
@@ -1042,6 +1051,16 @@ class HostResolverImpl::DnsTask : public base::SupportsWeakPtr<DnsTask> {
     StartAAAA();
   }
 
+  // Starts every transaction the task needs at once, racing the A and AAAA
+  // queries of an unspecified address family.
+  void StartAllTransactions() {
+    StartFirstTransaction();
+    if (needs_two_transactions()) {
+      raced_transactions_ = true;
+      StartSecondTransaction();
+    }
+  }
+
   base::TimeDelta ttl() { return ttl_; }
 
  private:
@@ -1111,6 +1130,10 @@ class HostResolverImpl::DnsTask : public base::SupportsWeakPtr<DnsTask> {
     }
 
     ++num_completed_transactions_;
+    if (raced_transactions_ && num_completed_transactions_ == 1) {
+      UMA_HISTOGRAM_BOOLEAN("AsyncDNS.RacedTransactions.AAAAFirst",
+                            transaction->GetType() == dns_protocol::kTypeAAAA);
+    }
     if (num_completed_transactions_ == 1) {
       ttl_ = ttl;
     } else {
@@ -1130,7 +1153,8 @@ class HostResolverImpl::DnsTask : public base::SupportsWeakPtr<DnsTask> {
     if (needs_two_transactions() && num_completed_transactions_ == 1) {
       // No need to repeat the suffix search.
       key_.hostname = transaction->GetHostname();
-      delegate_->OnFirstDnsTransactionComplete();
+      if (!raced_transactions_)
+        delegate_->OnFirstDnsTransactionComplete();
       return;
     }
 
@@ -1209,6 +1233,9 @@ class HostResolverImpl::DnsTask : public base::SupportsWeakPtr<DnsTask> {
 
   unsigned num_completed_transactions_;
 
+  // True if the A and AAAA transactions were started together.
+  bool raced_transactions_;
+
   // These are updated as each transaction completes.
   base::TimeDelta ttl_;
   // IPv6 addresses must appear first in the list.
@@ -1578,6 +1605,11 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job,
     dns_task_.reset(new DnsTask(resolver_->dns_client_.get(), key_, this,
                                 net_log_, tick_clock_));
 
+    if (base::FeatureList::IsEnabled(kAsyncDnsRaceAddressFamilies)) {
+      dns_task_->StartAllTransactions();
+      return;
+    }
+
     dns_task_->StartFirstTransaction();
     // Schedule a second transaction, if needed.
     if (dns_task_->needs_two_transactions())
@@ -1958,7 +1990,9 @@ int HostResolverImpl::Resolve(const RequestInfo& info,
 
   auto jobit = jobs_.find(key);
   Job* job;
+  UMA_HISTOGRAM_BOOLEAN("Net.DNS.JobCoalesced", jobit != jobs_.end());
   if (jobit == jobs_.end()) {
+    ++num_jobs_created_;
     auto new_job =
         std::make_unique<Job>(weak_ptr_factory_.GetWeakPtr(), key, priority,
                               proc_task_runner_, source_net_log, tick_clock_);
@@ -1979,6 +2013,7 @@ int HostResolverImpl::Resolve(const RequestInfo& info,
     jobs_[key] = std::move(new_job);
   } else {
     job = jobit->second.get();
+    ++num_requests_coalesced_;
   }
 
   // Can't complete synchronously. Create and attach request.
@@ -1998,6 +2033,8 @@ HostResolverImpl::HostResolverImpl(const Options& options, NetLog* net_log)
       net_log_(net_log),
       received_dns_config_(false),
       num_dns_failures_(0),
+      num_jobs_created_(0),
+      num_requests_coalesced_(0),
       assume_ipv6_failure_on_wifi_(false),
       use_local_ipv6_(false),
       last_ipv6_probe_result_(true),
@@ -176,6 +176,12 @@ class NET_EXPORT HostResolverImpl
 
   void SetTickClockForTesting(const base::TickClock* tick_clock);
 
+  // Returns the number of Jobs started by Resolve(), and the number of
+  // requests that Resolve() attached to an already existing Job instead. Their
+  // ratio is the rate at which in-flight resolutions were coalesced.
+  size_t num_jobs_created() const { return num_jobs_created_; }
+  size_t num_requests_coalesced() const { return num_requests_coalesced_; }
+
  protected:
   // Callback from HaveOnlyLoopbackAddresses probe.
   void SetHaveOnlyLoopbackAddresses(bool result);
@@ -352,6 +358,10 @@ class NET_EXPORT HostResolverImpl
   // Number of consecutive failures of DnsTask, counted when fallback succeeds.
   unsigned num_dns_failures_;
 
+  // See num_jobs_created() and num_requests_coalesced().
+  size_t num_jobs_created_;
+  size_t num_requests_coalesced_;
+
   // True if IPv6 should not be attempted when on a WiFi connection. See
   // https://crbug.com/696569 for further context.
   bool assume_ipv6_failure_on_wifi_;
@@ -20,6 +20,7 @@
 #include "base/strings/stringprintf.h"
 #include "base/synchronization/condition_variable.h"
 #include "base/synchronization/lock.h"
+#include "base/test/scoped_feature_list.h"
 #include "base/test/test_timeouts.h"
 #include "base/threading/thread_restrictions.h"
 #include "base/threading/thread_task_runner_handle.h"
@@ -829,6 +830,9 @@ TEST_F(HostResolverImplTest, DeDupeRequests) {
   for (size_t i = 0; i < requests_.size(); ++i) {
     EXPECT_EQ(OK, requests_[i]->WaitForResult()) << i;
   }
+
+  EXPECT_EQ(2u, resolver_->num_jobs_created());
+  EXPECT_EQ(3u, resolver_->num_requests_coalesced());
 }
 
 TEST_F(HostResolverImplTest, CancelMultipleRequests) {
@@ -2441,6 +2445,37 @@ TEST_F(HostResolverImplDnsTest, AAAAStartsAfterOtherJobFinishes) {
   EXPECT_TRUE(requests_[1]->HasAddress("::1", 80));
 }
 
+// Test that with racing enabled, the AAAA query starts along with the A query
+// and the Job only occupies a single dispatcher slot.
+TEST_F(HostResolverImplDnsTest, RaceAddressFamilies) {
+  base::test::ScopedFeatureList scoped_feature_list;
+  scoped_feature_list.InitFromCommandLine("AsyncDnsRaceAddressFamilies",
+                                          std::string());
+  CreateResolverWithLimitsAndParams(2u, DefaultParams(proc_.get()));
+  set_fallback_to_proctask(false);
+  ChangeDnsConfig(CreateValidDnsConfig());
+
+  EXPECT_THAT(CreateRequest("4slow_ok", 80)->Resolve(),
+              IsError(ERR_IO_PENDING));
+  EXPECT_THAT(CreateRequest("ok", 80)->Resolve(), IsError(ERR_IO_PENDING));
+  // Both Jobs run, since neither waits for a second slot.
+  EXPECT_EQ(2u, num_running_dispatcher_jobs());
+
+  base::RunLoop().RunUntilIdle();
+  EXPECT_FALSE(requests_[0]->completed());
+  EXPECT_TRUE(requests_[1]->completed());
+  EXPECT_THAT(requests_[1]->result(), IsOk());
+  EXPECT_EQ(2u, requests_[1]->NumberOfAddresses());
+  EXPECT_EQ(1u, num_running_dispatcher_jobs());
+
+  dns_client_->CompleteDelayedTransactions();
+  EXPECT_TRUE(requests_[0]->completed());
+  EXPECT_THAT(requests_[0]->result(), IsOk());
+  EXPECT_EQ(2u, requests_[0]->NumberOfAddresses());
+  EXPECT_TRUE(requests_[0]->HasAddress("127.0.0.1", 80));
+  EXPECT_TRUE(requests_[0]->HasAddress("::1", 80));
+}
+
 // Tests the case that a Job with a single transaction receives an empty address
 // list, triggering fallback to ProcTask.
 TEST_F(HostResolverImplDnsTest, IPv4EmptyFallback) {
@@ -8,6 +8,7 @@
 #include <map>
 #include <memory>
 #include <set>
+#include <tuple>
 
 #include "base/bind.h"
 #include "base/callback.h"
@@ -245,6 +246,8 @@ class SQLitePersistentCookieStore::Backend
   };
 
  private:
+  typedef std::list<std::unique_ptr<PendingOperation>> PendingOperationsList;
+
   // Creates or loads the SQLite database on background runner.
   void LoadAndNotifyInBackground(const LoadedCallback& loaded_callback,
                                  const base::Time& posted_at);
@@ -300,6 +303,9 @@ class SQLitePersistentCookieStore::Backend
                       const CanonicalCookie& cc);
   // Commit our pending operations to the database.
   void Commit();
+  // Drops the access time updates in |ops| that are made redundant by a later
+  // operation on the same cookie, so Commit() doesn't write them.
+  void DropSupersededAccessTimeUpdates(PendingOperationsList* ops);
   // Close() executed on the background runner.
   void InternalBackgroundClose(const base::Closure& callback);
 
@@ -322,7 +328,6 @@ class SQLitePersistentCookieStore::Backend
   std::unique_ptr<sql::Connection> db_;
   sql::MetaTable meta_table_;
 
-  typedef std::list<std::unique_ptr<PendingOperation>> PendingOperationsList;
   PendingOperationsList pending_;
   PendingOperationsList::size_type num_pending_;
   // Guard |cookies_|, |pending_|, |num_pending_|.
@@ -1321,6 +1326,8 @@ void SQLitePersistentCookieStore::Backend::Commit() {
   if (!del_smt.is_valid())
     return;
 
+  DropSupersededAccessTimeUpdates(&ops);
+
   sql::Transaction transaction(db_.get());
   if (!transaction.Begin())
     return;
@@ -1330,6 +1337,8 @@ void SQLitePersistentCookieStore::Backend::Commit() {
        ++it) {
     // Free the cookies as we commit them to the database.
     std::unique_ptr<PendingOperation> po(std::move(*it));
+    if (!po)
+      continue;
     switch (po->op()) {
       case PendingOperation::COOKIE_ADD:
         add_smt.Reset(true);
@@ -1411,6 +1420,29 @@ void SQLitePersistentCookieStore::Backend::Commit() {
                             BACKING_STORE_RESULTS_LAST_ENTRY);
 }
 
+void SQLitePersistentCookieStore::Backend::DropSupersededAccessTimeUpdates(
+    PendingOperationsList* ops) {
+  // Cookies are identified by name, domain and path in the database. Any
+  // operation on a cookie overwrites or deletes its access time, so only
+  // access time updates that aren't followed by another operation on the same
+  // cookie need to be written.
+  std::set<std::tuple<const std::string&, const std::string&,
+                      const std::string&>>
+      later_ops;
+  size_t num_dropped = 0;
+  for (auto it = ops->rbegin(); it != ops->rend(); ++it) {
+    const CanonicalCookie& cc = (*it)->cc();
+    bool inserted =
+        later_ops.insert(std::tie(cc.Name(), cc.Domain(), cc.Path())).second;
+    if (!inserted && (*it)->op() == PendingOperation::COOKIE_UPDATEACCESS) {
+      it->reset();
+      ++num_dropped;
+    }
+  }
+  UMA_HISTOGRAM_COUNTS_1000("Cookie.CommitDroppedAccessTimeUpdates",
+                            num_dropped);
+}
+
 void SQLitePersistentCookieStore::Backend::SetBeforeFlushCallback(
     base::RepeatingClosure callback) {
   base::AutoLock locked(before_flush_callback_lock_);
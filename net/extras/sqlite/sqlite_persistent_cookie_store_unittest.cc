@@ -20,6 +20,7 @@
 #include "base/strings/stringprintf.h"
 #include "base/synchronization/waitable_event.h"
 #include "base/task_scheduler/post_task.h"
+#include "base/test/metrics/histogram_tester.h"
 #include "base/threading/thread_restrictions.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "base/time/time.h"
@@ -482,6 +483,43 @@ TEST_F(SQLitePersistentCookieStoreTest, TestFlush) {
   ASSERT_GT(info.size, base_size);
 }
 
+// Access time updates followed by another operation on the same cookie in the
+// same commit are not written, and the cookies end up in the right state.
+TEST_F(SQLitePersistentCookieStoreTest, DropSupersededAccessTimeUpdates) {
+  InitializeStore(false, false);
+  base::HistogramTester histograms;
+  base::Time creation = base::Time::Now();
+  base::Time last_access = creation + base::TimeDelta::FromMinutes(5);
+
+  AddCookie("A", "B", "foo.bar", "/", creation);
+  for (int i = 1; i <= 5; ++i) {
+    store_->UpdateCookieAccessTime(CanonicalCookie(
+        "A", "B", "foo.bar", "/", creation, base::Time(),
+        creation + base::TimeDelta::FromMinutes(i), false, false,
+        CookieSameSite::DEFAULT_MODE, COOKIE_PRIORITY_DEFAULT));
+  }
+
+  // A cookie that is deleted in the same commit.
+  base::Time deleted_creation = creation + base::TimeDelta::FromSeconds(1);
+  CanonicalCookie deleted("C", "D", "foo.bar", "/", deleted_creation,
+                          base::Time(), deleted_creation, false, false,
+                          CookieSameSite::DEFAULT_MODE,
+                          COOKIE_PRIORITY_DEFAULT);
+  store_->AddCookie(deleted);
+  store_->UpdateCookieAccessTime(deleted);
+  store_->DeleteCookie(deleted);
+
+  Flush();
+  histograms.ExpectUniqueSample("Cookie.CommitDroppedAccessTimeUpdates", 5, 1);
+
+  DestroyStore();
+  CanonicalCookieVector cookies;
+  CreateAndLoad(false, false, &cookies);
+  ASSERT_EQ(1U, cookies.size());
+  EXPECT_EQ("A", cookies[0]->Name());
+  EXPECT_EQ(last_access, cookies[0]->LastAccessDate());
+}
+
 // Test loading old session cookies from the disk.
 TEST_F(SQLitePersistentCookieStoreTest, TestLoadOldSessionCookies) {
   InitializeStore(false, true);
@@ -8,6 +8,7 @@
 #include "base/callback_helpers.h"
 #include "base/logging.h"
 #include "base/metrics/histogram_macros.h"
+#include "base/numerics/ranges.h"
 #include "base/numerics/safe_conversions.h"
 #include "base/strings/string_util.h"
 #include "net/base/io_buffer.h"
@@ -22,7 +23,13 @@ const char kGZip[] = "gzip";
 const char kXGZip[] = "x-gzip";
 const char kBrotli[] = "br";
 
-const size_t kBufferSize = 32 * 1024;
+// Bounds of the size of the buffer that data is read into from upstream.
+const int kMinInputBufferSize = 32 * 1024;
+const int kMaxInputBufferSize = 256 * 1024;
+
+// Typical ratio of decoded to encoded size of text resources. The input buffer
+// is sized so that reading it once roughly fills the caller's buffer.
+const int kExpectedCompressionRatio = 4;
 
 }  // namespace
 
@@ -31,6 +38,7 @@ FilterSourceStream::FilterSourceStream(SourceType type,
     : SourceStream(type),
       upstream_(std::move(upstream)),
       next_state_(STATE_NONE),
+      input_buffer_size_(0),
       output_buffer_size_(0),
       upstream_end_reached_(false) {
   DCHECK(upstream_);
@@ -45,9 +53,14 @@ int FilterSourceStream::Read(IOBuffer* read_buffer,
   DCHECK(read_buffer);
   DCHECK_LT(0, read_buffer_size);
 
-  // Allocate a BlockBuffer during first Read().
+  // Allocate a BlockBuffer during first Read(). Callers that read with large
+  // buffers, like the network service for large bodies, get a larger input
+  // buffer, so each Read() decodes more data and fewer reads are needed.
   if (!input_buffer_) {
-    input_buffer_ = new IOBufferWithSize(kBufferSize);
+    input_buffer_size_ =
+        base::ClampToRange(read_buffer_size / kExpectedCompressionRatio,
+                           kMinInputBufferSize, kMaxInputBufferSize);
+    input_buffer_ = new IOBufferWithSize(input_buffer_size_);
     // This is first Read(), start with reading data from |upstream_|.
     next_state_ = STATE_READ_DATA;
   } else {
@@ -128,7 +141,7 @@ int FilterSourceStream::DoReadData() {
   next_state_ = STATE_READ_DATA_COMPLETE;
   // Use base::Unretained here is safe because |this| owns |upstream_|.
   int rv = upstream_->Read(
-      input_buffer_.get(), kBufferSize,
+      input_buffer_.get(), input_buffer_size_,
       base::Bind(&FilterSourceStream::OnIOComplete, base::Unretained(this)));
 
   return rv;
@@ -101,6 +101,7 @@ class NET_EXPORT_PRIVATE FilterSourceStream : public SourceStream {
   // Buffer for reading data out of |upstream_| and then for use by |this|
   // before the filtered data is returned through Read().
   scoped_refptr<IOBuffer> input_buffer_;
+  int input_buffer_size_;
 
   // Wrapper around |input_buffer_| that makes visible only the unread data.
   // Keep this as a member because subclass might not drain everything in a
@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include <algorithm>
+#include <memory>
 #include <string>
 
 #include "base/bind.h"
@@ -211,6 +212,41 @@ class ErrorFilterSourceStream : public FilterSourceStream {
   DISALLOW_COPY_AND_ASSIGN(ErrorFilterSourceStream);
 };
 
+// A SourceStream that records the size of the buffer passed to Read(), and
+// then returns EOF.
+class ReadSizeRecordingSourceStream : public SourceStream {
+ public:
+  explicit ReadSizeRecordingSourceStream(int* read_size)
+      : SourceStream(SourceStream::TYPE_NONE), read_size_(read_size) {}
+
+  int Read(IOBuffer* dest_buffer,
+           int buffer_size,
+           const CompletionCallback& callback) override {
+    *read_size_ = buffer_size;
+    return OK;
+  }
+  std::string Description() const override { return ""; }
+
+ private:
+  int* const read_size_;
+
+  DISALLOW_COPY_AND_ASSIGN(ReadSizeRecordingSourceStream);
+};
+
+// Returns the size of the buffer that a FilterSourceStream reads from upstream
+// into, when it is first read with a buffer of |read_buffer_size| bytes.
+int GetUpstreamReadSize(int read_buffer_size) {
+  int read_size = 0;
+  PassThroughFilterSourceStream stream(
+      std::make_unique<ReadSizeRecordingSourceStream>(&read_size));
+  scoped_refptr<IOBufferWithSize> output_buffer =
+      new IOBufferWithSize(read_buffer_size);
+  TestCompletionCallback callback;
+  EXPECT_EQ(OK, stream.Read(output_buffer.get(), output_buffer->size(),
+                            callback.callback()));
+  return read_size;
+}
+
 }  // namespace
 
 class FilterSourceStreamTest
@@ -544,4 +580,12 @@ TEST_P(FilterSourceStreamTest, ThrottleSourceStream) {
   EXPECT_EQ(input, actual_output);
 }
 
+// Tests that the upstream is read with a larger buffer when the caller reads
+// with a large buffer, within bounds.
+TEST(FilterSourceStreamInputBufferTest, InputBufferSize) {
+  EXPECT_EQ(32 * 1024, GetUpstreamReadSize(kDefaultBufferSize));
+  EXPECT_EQ(128 * 1024, GetUpstreamReadSize(512 * 1024));
+  EXPECT_EQ(256 * 1024, GetUpstreamReadSize(2 * 1024 * 1024));
+}
+
 }  // namespace net
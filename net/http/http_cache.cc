@@ -315,6 +315,7 @@ HttpCache::HttpCache(std::unique_ptr<HttpTransactionFactory> network_layer,
       bypass_lock_for_test_(false),
       bypass_lock_after_headers_for_test_(false),
       fail_conditionalization_for_test_(false),
+      race_network_with_slow_opens_(false),
       mode_(NORMAL),
       network_layer_(std::move(network_layer)),
       clock_(base::DefaultClock::GetInstance()),
@@ -455,6 +456,11 @@ void HttpCache::OnExternalCacheHit(const GURL& url,
   disk_cache_->OnExternalCacheHit(key);
 }
 
+void HttpCache::EnableNetworkRaceWithSlowOpens(base::TimeDelta threshold) {
+  race_network_with_slow_opens_ = true;
+  network_race_open_latency_threshold_ = threshold;
+}
+
 int HttpCache::CreateTransaction(RequestPriority priority,
                                  std::unique_ptr<HttpTransaction>* trans) {
   // Do lazy initialization of disk cache if needed.
@@ -1180,6 +1186,16 @@ bool HttpCache::IsWritingInProgress(ActiveEntry* entry) const {
   return entry->writers.get();
 }
 
+void HttpCache::RecordOpenEntryLatency(base::TimeDelta latency) {
+  // Weighs the latest sample by 1/8, as TCP does for its RTT estimate.
+  average_open_entry_latency_ += (latency - average_open_entry_latency_) / 8;
+}
+
+bool HttpCache::ShouldRaceNetworkWithOpenEntry() const {
+  return race_network_with_slow_opens_ && mode_ == NORMAL &&
+         average_open_entry_latency_ >= network_race_open_latency_threshold_;
+}
+
 LoadState HttpCache::GetLoadStateForPendingTransaction(
       const Transaction* trans) {
   auto i = active_entries_.find(trans->key());
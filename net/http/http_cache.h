@@ -199,6 +199,14 @@ class NET_EXPORT HttpCache : public HttpTransactionFactory {
   void set_mode(Mode value) { mode_ = value; }
   Mode mode() { return mode_; }
 
+  // Makes GET transactions send their request to the network while the cache
+  // entry is being opened, once opening entries was observed to take at least
+  // |threshold| on average, e.g. on slow storage. If the network responds
+  // first, the response is served without the cache. Otherwise the request is
+  // used if the cache would have sent it anyway, e.g. on a miss, and dropped
+  // if the entry is fresh or must be validated.
+  void EnableNetworkRaceWithSlowOpens(base::TimeDelta threshold);
+
   // Get/Set the cache's clock. These are public only for testing.
   void SetClockForTesting(base::Clock* clock) { clock_ = clock; }
   base::Clock* clock() const { return clock_; }
@@ -531,6 +539,13 @@ class NET_EXPORT HttpCache : public HttpTransactionFactory {
   // Returns true if a transaction is currently writing the response body.
   bool IsWritingInProgress(ActiveEntry* entry) const;
 
+  // Updates the average time opening an entry takes with |latency|.
+  void RecordOpenEntryLatency(base::TimeDelta latency);
+
+  // Returns true if transactions should send their request to the network
+  // while opening the entry, see EnableNetworkRaceWithSlowOpens().
+  bool ShouldRaceNetworkWithOpenEntry() const;
+
   // Returns the LoadState of the provided pending transaction.
   LoadState GetLoadStateForPendingTransaction(const Transaction* trans);
 
@@ -579,6 +594,12 @@ class NET_EXPORT HttpCache : public HttpTransactionFactory {
   bool bypass_lock_after_headers_for_test_;
   bool fail_conditionalization_for_test_;
 
+  // See EnableNetworkRaceWithSlowOpens().
+  bool race_network_with_slow_opens_;
+  base::TimeDelta network_race_open_latency_threshold_;
+  // Exponentially weighted moving average of the time opening entries takes.
+  base::TimeDelta average_open_entry_latency_;
+
   Mode mode_;
 
   std::unique_ptr<HttpTransactionFactory> network_layer_;
@@ -171,6 +171,8 @@ HttpCache::Transaction::Transaction(RequestPriority priority, HttpCache* cache)
       cache_(cache->GetWeakPtr()),
       entry_(NULL),
       new_entry_(NULL),
+      speculative_network_result_(ERR_IO_PENDING),
+      waiting_for_speculative_network_trans_(false),
       new_response_(NULL),
       mode_(NONE),
       reading_(false),
@@ -1159,7 +1161,13 @@ int HttpCache::Transaction::DoOpenEntry() {
     return net::ERR_CACHE_ENTRY_NOT_SUITABLE;
   }
 
-  return cache_->OpenEntry(cache_key_, &new_entry_, this);
+  open_entry_since_ = first_cache_access_since_;
+  int rv = cache_->OpenEntry(cache_key_, &new_entry_, this);
+  if (rv == ERR_IO_PENDING && CanRaceNetworkWithOpenEntry() &&
+      cache_->ShouldRaceNetworkWithOpenEntry()) {
+    StartSpeculativeNetworkTransaction();
+  }
+  return rv;
 }
 
 int HttpCache::Transaction::DoOpenEntryComplete(int result) {
@@ -1170,6 +1178,10 @@ int HttpCache::Transaction::DoOpenEntryComplete(int result) {
   net_log_.EndEventWithNetErrorCode(NetLogEventType::HTTP_CACHE_OPEN_ENTRY,
                                     result);
   cache_pending_ = false;
+  if (!open_entry_since_.is_null()) {
+    cache_->RecordOpenEntryLatency(TimeTicks::Now() - open_entry_since_);
+    open_entry_since_ = TimeTicks();
+  }
   if (result == OK) {
     TransitionToState(STATE_ADD_TO_ENTRY);
     return OK;
@@ -1640,6 +1652,23 @@ int HttpCache::Transaction::DoSendRequest() {
   DCHECK(mode_ & WRITE || mode_ == NONE);
   DCHECK(!network_trans_.get());
 
+  if (speculative_network_trans_) {
+    std::unique_ptr<HttpTransaction> speculative_network_trans =
+        std::move(speculative_network_trans_);
+    // The speculative request is only good if it is the one to send, e.g. not
+    // after the request was conditionalized to validate the entry.
+    if (request_ == initial_request_) {
+      network_trans_ = std::move(speculative_network_trans);
+      network_transaction_info_.old_network_trans_load_timing.reset();
+      network_transaction_info_.old_remote_endpoint = IPEndPoint();
+      TransitionToState(STATE_SEND_REQUEST_COMPLETE);
+      if (speculative_network_result_ != ERR_IO_PENDING)
+        return speculative_network_result_;
+      waiting_for_speculative_network_trans_ = true;
+      return ERR_IO_PENDING;
+    }
+  }
+
   send_request_since_ = TimeTicks::Now();
 
   // Create a network transaction.
@@ -2070,6 +2099,10 @@ int HttpCache::Transaction::DoHeadersPhaseCannotProceed(int result) {
 }
 
 int HttpCache::Transaction::DoFinishHeaders(int result) {
+  // The response headers came from the cache, or an error occurred, before
+  // the speculative network transaction was needed.
+  speculative_network_trans_.reset();
+
   if (!cache_.get() || !entry_ || result != OK) {
     TransitionToState(STATE_NONE);
     return result;
@@ -3558,6 +3591,78 @@ void HttpCache::Transaction::OnIOComplete(int result) {
   DoLoop(result);
 }
 
+bool HttpCache::Transaction::CanRaceNetworkWithOpenEntry() const {
+  return mode_ == READ_WRITE && method_ == "GET" && !partial_ &&
+         !(effective_load_flags_ &
+           (LOAD_SKIP_CACHE_VALIDATION | LOAD_VALIDATE_CACHE)) &&
+         !websocket_handshake_stream_base_create_helper_ &&
+         // Deferring the start of the request is left to DoSendRequest().
+         before_network_start_callback_.is_null() &&
+         !speculative_network_trans_;
+}
+
+void HttpCache::Transaction::StartSpeculativeNetworkTransaction() {
+  DCHECK(!network_trans_);
+  if (cache_->network_layer_->CreateTransaction(
+          priority_, &speculative_network_trans_) != OK) {
+    speculative_network_trans_.reset();
+    return;
+  }
+
+  speculative_network_trans_->SetBeforeHeadersSentCallback(
+      before_headers_sent_callback_);
+  speculative_network_trans_->SetRequestHeadersCallback(
+      request_headers_callback_);
+  speculative_network_trans_->SetResponseHeadersCallback(
+      response_headers_callback_);
+
+  send_request_since_ = TimeTicks::Now();
+  speculative_network_result_ = ERR_IO_PENDING;
+  int rv = speculative_network_trans_->Start(
+      request_,
+      base::BindOnce(&Transaction::OnSpeculativeNetworkTransactionStarted,
+                     weak_factory_.GetWeakPtr()),
+      net_log_);
+  if (rv != ERR_IO_PENDING)
+    speculative_network_result_ = rv;
+}
+
+void HttpCache::Transaction::OnSpeculativeNetworkTransactionStarted(
+    int result) {
+  DCHECK_NE(ERR_IO_PENDING, result);
+  speculative_network_result_ = result;
+
+  if (waiting_for_speculative_network_trans_) {
+    waiting_for_speculative_network_trans_ = false;
+    DoLoop(result);
+    return;
+  }
+
+  // The network responded before the entry was opened: give up on the cache.
+  // Errors are left for DoSendRequest(), in case the cache can serve the
+  // request.
+  if (result != OK || !speculative_network_trans_ ||
+      next_state_ != STATE_OPEN_ENTRY_COMPLETE || !cache_pending_) {
+    return;
+  }
+  DCHECK(cache_);
+  cache_->RemovePendingTransaction(this);
+  cache_pending_ = false;
+  net_log_.EndEventWithNetErrorCode(NetLogEventType::HTTP_CACHE_OPEN_ENTRY,
+                                    ERR_ABORTED);
+  cache_->RecordOpenEntryLatency(TimeTicks::Now() - open_entry_since_);
+  open_entry_since_ = TimeTicks();
+  new_entry_ = nullptr;
+  mode_ = NONE;
+  UpdateCacheEntryStatus(CacheEntryStatus::ENTRY_OTHER);
+
+  network_trans_ = std::move(speculative_network_trans_);
+  network_transaction_info_.old_network_trans_load_timing.reset();
+  network_transaction_info_.old_remote_endpoint = IPEndPoint();
+  next_state_ = STATE_SEND_REQUEST_COMPLETE;
+  DoLoop(result);
+}
+
 void HttpCache::Transaction::TransitionToState(State state) {
   // Ensure that the state is only set once per Do* state.
   DCHECK(in_do_loop_);
@@ -516,6 +516,18 @@ class NET_EXPORT_PRIVATE HttpCache::Transaction : public HttpTransaction {
   // |old_network_trans_load_timing_|, which must be NULL when this is called.
   void ResetNetworkTransaction();
 
+  // Returns true if the request can be sent to the network while the entry is
+  // being opened, see HttpCache::EnableNetworkRaceWithSlowOpens(). That is the
+  // case for GET requests which would be sent unchanged on a cache miss.
+  bool CanRaceNetworkWithOpenEntry() const;
+
+  // Starts |speculative_network_trans_|.
+  void StartSpeculativeNetworkTransaction();
+
+  // Called when the speculative network transaction, which may have become
+  // |network_trans_| since, completes its Start().
+  void OnSpeculativeNetworkTransactionStarted(int result);
+
   // Returns the currently active network transaction.
   const HttpTransaction* network_transaction() const;
   HttpTransaction* network_transaction();
@@ -586,6 +598,18 @@ class NET_EXPORT_PRIVATE HttpCache::Transaction : public HttpTransaction {
   HttpCache::ActiveEntry* entry_;
   HttpCache::ActiveEntry* new_entry_;
   std::unique_ptr<HttpTransaction> network_trans_;
+  // The network transaction started while the entry is being opened, and the
+  // result of its Start() or ERR_IO_PENDING. If the response headers arrive
+  // first, the transaction proceeds without the cache. Otherwise it becomes
+  // |network_trans_| if DoSendRequest() sends the same request, and is dropped
+  // if the request is conditionalized or served from the cache.
+  std::unique_ptr<HttpTransaction> speculative_network_trans_;
+  int speculative_network_result_;
+  // DoSendRequest() is waiting for the Start() of |network_trans_|, which was
+  // speculative.
+  bool waiting_for_speculative_network_trans_;
+  // When the current open of the entry was sent to the backend.
+  base::TimeTicks open_entry_since_;
   CompletionOnceCallback callback_;  // Consumer's callback.
   HttpResponseInfo response_;
   HttpResponseInfo auth_response_;
@@ -908,6 +908,59 @@ TEST_F(HttpCacheTest, SimpleGETWithDiskFailures3) {
   EXPECT_EQ(3, cache.disk_cache()->create_count());
 }
 
+// Tests that a GET is served from the network when it responds before a slow
+// open of the cache entry completes.
+TEST_F(HttpCacheTest, SimpleGET_NetworkRaceWinsOverSlowOpen) {
+  MockHttpCache cache;
+
+  // Write to the cache.
+  RunTransactionTest(cache.http_cache(), kSimpleGET_Transaction);
+  EXPECT_EQ(1, cache.network_layer()->transaction_count());
+
+  cache.http_cache()->EnableNetworkRaceWithSlowOpens(base::TimeDelta());
+  cache.disk_cache()->SetDefer(MockDiskEntry::DEFER_OPEN);
+
+  MockHttpRequest request(kSimpleGET_Transaction);
+  auto c = std::make_unique<Context>();
+  ASSERT_THAT(cache.CreateTransaction(&c->trans), IsOk());
+  int rv =
+      c->trans->Start(&request, c->callback.callback(), NetLogWithSource());
+  EXPECT_THAT(c->callback.GetResult(rv), IsOk());
+
+  const HttpResponseInfo* response = c->trans->GetResponseInfo();
+  ASSERT_TRUE(response);
+  EXPECT_FALSE(response->was_cached);
+  EXPECT_EQ(2, cache.network_layer()->transaction_count());
+  ReadAndVerifyTransaction(c->trans.get(), kSimpleGET_Transaction);
+  c.reset();
+
+  // The open completing later is harmless, and the entry is still there.
+  cache.disk_cache()->ResumeCacheOperation();
+  base::RunLoop().RunUntilIdle();
+
+  RunTransactionTest(cache.http_cache(), kSimpleGET_Transaction);
+  EXPECT_EQ(2, cache.network_layer()->transaction_count());
+  EXPECT_EQ(1, cache.disk_cache()->create_count());
+}
+
+// Tests that a GET is served from the cache when the network race is enabled
+// but opening the entry is fast.
+TEST_F(HttpCacheTest, SimpleGET_NetworkRaceNotStartedForFastOpen) {
+  MockHttpCache cache;
+
+  // Write to the cache.
+  RunTransactionTest(cache.http_cache(), kSimpleGET_Transaction);
+
+  cache.http_cache()->EnableNetworkRaceWithSlowOpens(
+      base::TimeDelta::FromSeconds(1));
+
+  HttpResponseInfo response;
+  RunTransactionTestWithResponseInfo(cache.http_cache(), kSimpleGET_Transaction,
+                                     &response);
+  EXPECT_TRUE(response.was_cached);
+  EXPECT_EQ(1, cache.network_layer()->transaction_count());
+}
+
 TEST_F(HttpCacheTest, SimpleGET_LoadOnlyFromCache_Hit) {
   MockHttpCache cache;
 
@@ -185,6 +185,8 @@ HttpNetworkSession::HttpNetworkSession(const Params& params,
       http_auth_handler_factory_(context.http_auth_handler_factory),
       proxy_resolution_service_(context.proxy_resolution_service),
       ssl_config_service_(context.ssl_config_service),
+      ssl_session_cache_shard_("http_network_session/" +
+                               base::IntToString(g_next_shard_id.GetNext())),
       websocket_endpoint_lock_manager_(
           std::make_unique<WebSocketEndpointLockManager>()),
       push_delegate_(nullptr),
@@ -249,13 +251,11 @@ HttpNetworkSession::HttpNetworkSession(const Params& params,
   DCHECK(ssl_config_service_.get());
   CHECK(http_server_properties_);
 
-  const std::string ssl_session_cache_shard =
-      "http_network_session/" + base::IntToString(g_next_shard_id.GetNext());
   normal_socket_pool_manager_ = CreateSocketPoolManager(
-      NORMAL_SOCKET_POOL, context, ssl_session_cache_shard,
+      NORMAL_SOCKET_POOL, context, ssl_session_cache_shard_,
       websocket_endpoint_lock_manager_.get());
   websocket_socket_pool_manager_ = CreateSocketPoolManager(
-      WEBSOCKET_SOCKET_POOL, context, ssl_session_cache_shard,
+      WEBSOCKET_SOCKET_POOL, context, ssl_session_cache_shard_,
       websocket_endpoint_lock_manager_.get());
 
   if (params_.enable_http2) {
@@ -342,6 +342,7 @@ std::unique_ptr<base::Value> HttpNetworkSession::SpdySessionPoolInfoToValue()
 std::unique_ptr<base::Value> HttpNetworkSession::QuicInfoToValue() const {
   std::unique_ptr<base::DictionaryValue> dict(new base::DictionaryValue());
   dict->Set("sessions", quic_stream_factory_.QuicStreamFactoryInfoToValue());
+  dict->Set("session_lookups", quic_stream_factory_.LookupStatsToValue());
   dict->SetBoolean("quic_enabled", IsQuicEnabled());
 
   auto connection_options(std::make_unique<base::ListValue>());
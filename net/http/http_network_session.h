@@ -328,6 +328,12 @@ class NET_EXPORT HttpNetworkSession : public base::MemoryCoordinatorClient {
   // Returns the original Context used to construct this session.
   const Context& context() const { return context_; }
 
+  // Returns the shard of the process-wide SSL session cache used by the
+  // sockets of this session.
+  const std::string& ssl_session_cache_shard() const {
+    return ssl_session_cache_shard_;
+  }
+
   bool IsProtocolEnabled(NextProto protocol) const;
 
   void SetServerPushDelegate(std::unique_ptr<ServerPushDelegate> push_delegate);
@@ -371,6 +377,7 @@ class NET_EXPORT HttpNetworkSession : public base::MemoryCoordinatorClient {
 
   ProxyResolutionService* const proxy_resolution_service_;
   const scoped_refptr<SSLConfigService> ssl_config_service_;
+  const std::string ssl_session_cache_shard_;
 
   HttpAuthCache http_auth_cache_;
   SSLClientAuthCache ssl_client_auth_cache_;
@@ -134,8 +134,29 @@ struct HttpResponseHeaders::ParsedHeader {
   std::string::const_iterator name_end;
   std::string::const_iterator value_begin;
   std::string::const_iterator value_end;
+
+  // For a header line, the index in parsed_ of the next line with the same
+  // name, or std::string::npos.
+  size_t next_line_with_same_name;
 };
 
+size_t HttpResponseHeaders::HeaderNameHash::operator()(
+    base::StringPiece name) const {
+  // FNV-1a over the lowercased name.
+  uint32_t hash = 2166136261u;
+  for (char c : name) {
+    hash ^= static_cast<uint8_t>(base::ToLowerASCII(c));
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+bool HttpResponseHeaders::HeaderNameEquals::operator()(
+    base::StringPiece a,
+    base::StringPiece b) const {
+  return base::EqualsCaseInsensitiveASCII(a, b);
+}
+
 //-----------------------------------------------------------------------------
 
 HttpResponseHeaders::HttpResponseHeaders(const std::string& raw_input)
@@ -295,6 +316,7 @@ void HttpResponseHeaders::MergeWithHeaders(const std::string& raw_headers,
   // Make this object hold the new data.
   raw_headers_.clear();
   parsed_.clear();
+  header_index_.clear();
   Parse(new_raw_headers);
 }
 
@@ -351,6 +373,7 @@ void HttpResponseHeaders::RemoveHeaderLine(const std::string& name,
   // Make this object hold the new data.
   raw_headers_.clear();
   parsed_.clear();
+  header_index_.clear();
   Parse(new_raw_headers);
 }
 
@@ -367,6 +390,7 @@ void HttpResponseHeaders::AddHeader(const std::string& header) {
   // Make this object hold the new data.
   raw_headers_.clear();
   parsed_.clear();
+  header_index_.clear();
   Parse(new_raw_headers);
 }
 
@@ -703,14 +727,17 @@ void HttpResponseHeaders::ParseStatusLine(
 
 size_t HttpResponseHeaders::FindHeader(size_t from,
                                        const base::StringPiece& search) const {
-  for (size_t i = from; i < parsed_.size(); ++i) {
-    if (parsed_[i].is_continuation())
-      continue;
-    base::StringPiece name(parsed_[i].name_begin, parsed_[i].name_end);
-    if (base::EqualsCaseInsensitiveASCII(search, name))
+  auto it = header_index_.find(search);
+  if (it == header_index_.end() || it->second.last < from)
+    return std::string::npos;
+
+  for (size_t i = it->second.first; i != std::string::npos;
+       i = parsed_[i].next_line_with_same_name) {
+    if (i >= from)
       return i;
   }
 
+  NOTREACHED();
   return std::string::npos;
 }
 
@@ -766,6 +793,18 @@ void HttpResponseHeaders::AddToParsed(std::string::const_iterator name_begin,
   header.name_end = name_end;
   header.value_begin = value_begin;
   header.value_end = value_end;
+  header.next_line_with_same_name = std::string::npos;
+
+  if (!header.is_continuation()) {
+    // Chain this line to the previous one with the same name, if any.
+    size_t index = parsed_.size();
+    auto result = header_index_.emplace(base::StringPiece(name_begin, name_end),
+                                        HeaderLines{index, index});
+    if (!result.second) {
+      parsed_[result.first->second.last].next_line_with_same_name = index;
+      result.first->second.last = index;
+    }
+  }
   parsed_.push_back(header);
 }
 
@@ -9,6 +9,7 @@
 #include <stdint.h>
 
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -312,6 +313,25 @@ class NET_EXPORT HttpResponseHeaders
   struct ParsedHeader;
   typedef std::vector<ParsedHeader> HeaderList;
 
+  // Case-insensitive hashing and comparison of header names.
+  struct HeaderNameHash {
+    size_t operator()(base::StringPiece name) const;
+  };
+  struct HeaderNameEquals {
+    bool operator()(base::StringPiece a, base::StringPiece b) const;
+  };
+
+  // The indices in parsed_ of the first and last header lines with a name.
+  struct HeaderLines {
+    size_t first;
+    size_t last;
+  };
+  // Keyed by header names pointing into raw_headers_.
+  using HeaderIndex = std::unordered_map<base::StringPiece,
+                                         HeaderLines,
+                                         HeaderNameHash,
+                                         HeaderNameEquals>;
+
   ~HttpResponseHeaders();
 
   // Initializes from the given raw headers.
@@ -336,7 +356,8 @@ class NET_EXPORT HttpResponseHeaders
                        bool has_headers);
 
   // Find the header in our list (case-insensitive) starting with parsed_ at
-  // index |from|.  Returns string::npos if not found.
+  // index |from|.  Returns string::npos if not found.  This only follows the
+  // lines of |name| through header_index_, without scanning other headers.
   size_t FindHeader(size_t from, const base::StringPiece& name) const;
 
   // Search the Cache-Control header for a directive matching |directive|. If
@@ -390,6 +411,11 @@ class NET_EXPORT HttpResponseHeaders
   // header-value pairs within raw_headers_.
   HeaderList parsed_;
 
+  // Indexes the header lines in parsed_ by name, so that looking up a header
+  // doesn't compare its name against every other header of the response. It
+  // is built along with parsed_, so that const lookups stay thread-safe.
+  HeaderIndex header_index_;
+
   // The raw_headers_ consists of the normalized status line (terminated with a
   // null byte) and then followed by the raw null-terminated headers from the
   // input that was passed to our constructor.  We preserve the input [*] to
@@ -539,6 +539,41 @@ TEST(HttpResponseHeadersTest, EnumerateHeader_Challenge) {
   EXPECT_FALSE(parsed->EnumerateHeader(&iter, "WWW-Authenticate", &value));
 }
 
+TEST(HttpResponseHeadersTest, EnumerateHeader_InterleavedLines) {
+  // Lines of a header are found in order whatever the case of their name, and
+  // the index follows changes to the headers.
+  std::string headers =
+      "HTTP/1.1 200 OK\n"
+      "Vary: Accept\n"
+      "X-Foo: 1\n"
+      "vary: Cookie, Origin\n"
+      "X-Bar: 2\n"
+      "VARY: User-Agent\n";
+  HeadersToRaw(&headers);
+  scoped_refptr<HttpResponseHeaders> parsed(new HttpResponseHeaders(headers));
+
+  size_t iter = 0;
+  std::string value;
+  EXPECT_TRUE(parsed->EnumerateHeader(&iter, "Vary", &value));
+  EXPECT_EQ("Accept", value);
+  EXPECT_TRUE(parsed->EnumerateHeader(&iter, "Vary", &value));
+  EXPECT_EQ("Cookie", value);
+  EXPECT_TRUE(parsed->EnumerateHeader(&iter, "Vary", &value));
+  EXPECT_EQ("Origin", value);
+  EXPECT_TRUE(parsed->EnumerateHeader(&iter, "Vary", &value));
+  EXPECT_EQ("User-Agent", value);
+  EXPECT_FALSE(parsed->EnumerateHeader(&iter, "Vary", &value));
+  EXPECT_TRUE(parsed->HasHeader("x-bar"));
+  EXPECT_FALSE(parsed->HasHeader("X-Ba"));
+
+  parsed->RemoveHeader("x-foo");
+  parsed->AddHeader("X-Foo: 3");
+  EXPECT_TRUE(parsed->GetNormalizedHeader("X-Foo", &value));
+  EXPECT_EQ("3", value);
+  EXPECT_TRUE(parsed->GetNormalizedHeader("Vary", &value));
+  EXPECT_EQ("Accept, Cookie, Origin, User-Agent", value);
+}
+
 TEST(HttpResponseHeadersTest, EnumerateHeader_DateValued) {
   // The comma in a date valued header should not be treated as a
   // field-value separator.
@@ -325,8 +325,13 @@ void HttpServerPropertiesManager::SetServerNetworkStats(
   http_server_properties_impl_->SetServerNetworkStats(server, stats);
   ServerNetworkStats new_stats =
       *(http_server_properties_impl_->GetServerNetworkStats(server));
-  if (old_stats != new_stats)
+  // The smoothed RTT is updated on every new connection, so only persist to
+  // disk if the server is new, or if the new RTT is more than twice or less
+  // than half the old one. Smaller changes are written with the next update.
+  if (!old_stats_ptr || new_stats.srtt > 2 * old_stats.srtt ||
+      2 * new_stats.srtt < old_stats.srtt) {
     ScheduleUpdatePrefs(SET_SERVER_NETWORK_STATS);
+  }
 }
 
 void HttpServerPropertiesManager::ClearServerNetworkStats(
@@ -438,6 +443,9 @@ void HttpServerPropertiesManager::UpdateCacheFromPrefs() {
   if (!http_server_properties_dict)
     return;
 
+  // Remember what is on disk, so that it isn't written back unchanged.
+  persisted_server_properties_ = http_server_properties_dict->CreateDeepCopy();
+
   bool detected_corrupted_prefs = false;
   net_log_.AddEvent(NetLogEventType::HTTP_SERVER_PROPERTIES_UPDATE_CACHE,
                     base::Bind(&NetLogCallback, http_server_properties_dict));
@@ -1070,10 +1078,11 @@ void HttpServerPropertiesManager::UpdatePrefsFromCache(
   base::DictionaryValue http_server_properties_dict;
 
   // Convert |server_pref_map| to a DictionaryValue and add it to
-  // |http_server_properties_dict|.
+  // |http_server_properties_dict|. Servers are saved in MRU order, which
+  // UpdateCacheFromPrefs() relies on to restore their recency.
   auto servers_list = std::make_unique<base::ListValue>();
-  for (ServerPrefMap::const_reverse_iterator map_it = server_pref_map.rbegin();
-       map_it != server_pref_map.rend(); ++map_it) {
+  for (ServerPrefMap::const_iterator map_it = server_pref_map.begin();
+       map_it != server_pref_map.end(); ++map_it) {
     const url::SchemeHostPort server = map_it->first;
     const ServerPref& server_pref = map_it->second;
 
@@ -1117,6 +1126,14 @@ void HttpServerPropertiesManager::UpdatePrefsFromCache(
       http_server_properties_impl_->recently_broken_alternative_services(),
       &http_server_properties_dict);
 
+  // Many updates don't change what is persisted, e.g. requiring HTTP/1.1 for a
+  // server, or marking an alternative service broken again. Skip writing the
+  // prefs in that case, unless the caller waits for them to be flushed.
+  if (callback.is_null() && persisted_server_properties_ &&
+      *persisted_server_properties_ == http_server_properties_dict) {
+    return;
+  }
+
   setting_prefs_ = true;
   pref_delegate_->SetServerProperties(http_server_properties_dict,
                                       std::move(callback));
@@ -1124,6 +1141,8 @@ void HttpServerPropertiesManager::UpdatePrefsFromCache(
 
   net_log_.AddEvent(NetLogEventType::HTTP_SERVER_PROPERTIES_UPDATE_PREFS,
                     base::Bind(&NetLogCallback, &http_server_properties_dict));
+
+  persisted_server_properties_ = http_server_properties_dict.CreateDeepCopy();
 }
 
 void HttpServerPropertiesManager::SaveAlternativeServiceToServerPrefs(
@@ -273,6 +273,10 @@ class NET_EXPORT HttpServerPropertiesManager : public HttpServerProperties {
   // Set to true once the initial prefs have been loaded.
   bool is_initialized_ = false;
 
+  // The server properties last loaded from or written to |pref_delegate_|.
+  // Used to avoid rewriting the prefs when nothing persisted has changed.
+  std::unique_ptr<base::DictionaryValue> persisted_server_properties_;
+
   // Used to post |prefs::kHttpServerProperties| pref update tasks.
   base::OneShotTimer network_prefs_update_timer_;
 
@@ -725,6 +725,32 @@ TEST_P(HttpServerPropertiesManagerTest, ServerNetworkStats) {
             http_server_props_manager_->GetServerNetworkStats(mail_server));
 }
 
+TEST_P(HttpServerPropertiesManagerTest, ServerNetworkStatsSmallSrttChange) {
+  url::SchemeHostPort mail_server("http", "mail.google.com", 80);
+  ServerNetworkStats stats;
+  stats.srtt = base::TimeDelta::FromMilliseconds(100);
+  http_server_props_manager_->SetServerNetworkStats(mail_server, stats);
+  EXPECT_TRUE(MainThreadHasPendingTask());
+  FastForwardUntilNoTasksRemain();
+  EXPECT_EQ(1, pref_delegate_->GetAndClearNumPrefUpdates());
+
+  // Changes of less than a factor of two are not worth persisting on their
+  // own.
+  stats.srtt = base::TimeDelta::FromMilliseconds(150);
+  http_server_props_manager_->SetServerNetworkStats(mail_server, stats);
+  stats.srtt = base::TimeDelta::FromMilliseconds(60);
+  http_server_props_manager_->SetServerNetworkStats(mail_server, stats);
+  EXPECT_FALSE(MainThreadHasPendingTask());
+  EXPECT_EQ(60, http_server_props_manager_->GetServerNetworkStats(mail_server)
+                    ->srtt.InMilliseconds());
+
+  stats.srtt = base::TimeDelta::FromMilliseconds(200);
+  http_server_props_manager_->SetServerNetworkStats(mail_server, stats);
+  EXPECT_TRUE(MainThreadHasPendingTask());
+  FastForwardUntilNoTasksRemain();
+  EXPECT_EQ(1, pref_delegate_->GetAndClearNumPrefUpdates());
+}
+
 TEST_P(HttpServerPropertiesManagerTest, QuicServerInfo) {
   quic::QuicServerId mail_quic_server_id("mail.google.com", 80);
   EXPECT_EQ(nullptr,
@@ -1046,18 +1072,18 @@ TEST_P(HttpServerPropertiesManagerTest, UpdatePrefsWithCache) {
       "{\"https://mail.google.com:80\":"
       "{\"server_info\":\"quic_server_info1\"}},"
       "\"servers\":["
-      "{\"https://www.google.com:80\":{"
-      "\"alternative_service\":[{\"advertised_versions\":[],"
-      "\"expiration\":\"13756212000000000\",\"port\":443,"
-      "\"protocol_str\":\"h2\"},"
-      "{\"advertised_versions\":[],\"expiration\":\"13758804000000000\","
-      "\"host\":\"www.google.com\",\"port\":1234,\"protocol_str\":\"h2\"}]}},"
       "{\"https://mail.google.com:80\":{"
       "\"alternative_service\":[{\"advertised_versions\":[],"
       "\"expiration\":\"9223372036854775807\",\"host\":\"foo.google.com\","
       "\"port\":444,\"protocol_str\":\"h2\"}],"
       "\"network_stats\":{\"srtt\":42},"
-      "\"supports_spdy\":true}}],"
+      "\"supports_spdy\":true}},"
+      "{\"https://www.google.com:80\":{"
+      "\"alternative_service\":[{\"advertised_versions\":[],"
+      "\"expiration\":\"13756212000000000\",\"port\":443,"
+      "\"protocol_str\":\"h2\"},"
+      "{\"advertised_versions\":[],\"expiration\":\"13758804000000000\","
+      "\"host\":\"www.google.com\",\"port\":1234,\"protocol_str\":\"h2\"}]}}],"
       "\"supports_quic\":{\"address\":\"127.0.0.1\",\"used_quic\":true},"
       "\"version\":5}";
 
@@ -1351,15 +1377,15 @@ TEST_P(HttpServerPropertiesManagerTest, PersistAdvertisedVersionsToPref) {
   const char expected_json[] =
       "{\"quic_servers\":{\"https://mail.google.com:80\":{"
       "\"server_info\":\"quic_server_info1\"}},\"servers\":["
+      "{\"https://mail.google.com:80\":{\"alternative_service\":[{"
+      "\"advertised_versions\":[43],\"expiration\":\"9223372036854775807\","
+      "\"host\":\"foo.google.com\",\"port\":444,\"protocol_str\":\"quic\"}],"
+      "\"network_stats\":{\"srtt\":42}}},"
       "{\"https://www.google.com:80\":{\"alternative_service\":[{"
       "\"advertised_versions\":[35,37],\"expiration\":\"13756212000000000\","
       "\"port\":443,\"protocol_str\":\"quic\"},{\"advertised_versions\":[],"
       "\"expiration\":\"13758804000000000\",\"host\":\"www.google.com\","
-      "\"port\":1234,\"protocol_str\":\"h2\"}]}},"
-      "{\"https://mail.google.com:80\":{\"alternative_service\":[{"
-      "\"advertised_versions\":[43],\"expiration\":\"9223372036854775807\","
-      "\"host\":\"foo.google.com\",\"port\":444,\"protocol_str\":\"quic\"}],"
-      "\"network_stats\":{\"srtt\":42}}}],\"supports_quic\":{"
+      "\"port\":1234,\"protocol_str\":\"h2\"}]}}],\"supports_quic\":{"
       "\"address\":\"127.0.0.1\",\"used_quic\":true},\"version\":5}";
 
   const base::Value* http_server_properties =
@@ -1775,4 +1801,91 @@ TEST_P(HttpServerPropertiesManagerTest, UpdateCacheWithPrefs) {
     EXPECT_EQ(4, pref_delegate_->GetAndClearNumPrefUpdates());
 }
 
+// Prefs are not written again when what would be persisted hasn't changed.
+TEST_P(HttpServerPropertiesManagerTest, DoNotRewriteUnchangedPrefs) {
+  const url::SchemeHostPort spdy_server("https", "mail.google.com", 443);
+  const HostPortPair host_port_pair("mail.google.com", 443);
+  http_server_props_manager_->SetSupportsSpdy(spdy_server, true);
+  EXPECT_TRUE(MainThreadHasPendingTask());
+  FastForwardUntilNoTasksRemain();
+  EXPECT_EQ(1, pref_delegate_->GetAndClearNumPrefUpdates());
+
+  // HTTP/1.1 requirements are not persisted.
+  http_server_props_manager_->SetHTTP11Required(host_port_pair);
+  EXPECT_TRUE(MainThreadHasPendingTask());
+  FastForwardUntilNoTasksRemain();
+  EXPECT_EQ(0, pref_delegate_->GetAndClearNumPrefUpdates());
+
+  // Nor are prefs written back after they have been loaded by a new manager.
+  base::DictionaryValue prefs;
+  prefs.MergeDictionary(pref_delegate_->GetServerProperties());
+  http_server_props_manager_.reset();
+  pref_delegate_ = new MockPrefDelegate;
+  http_server_props_manager_ = std::make_unique<HttpServerPropertiesManager>(
+      base::WrapUnique(pref_delegate_), /*net_log=*/nullptr,
+      GetMockTickClock());
+  pref_delegate_->SetPrefs(prefs);
+  EXPECT_TRUE(http_server_props_manager_->SupportsRequestPriority(spdy_server));
+  http_server_props_manager_->SetHTTP11Required(host_port_pair);
+  EXPECT_TRUE(MainThreadHasPendingTask());
+  FastForwardUntilNoTasksRemain();
+  EXPECT_EQ(0, pref_delegate_->GetAndClearNumPrefUpdates());
+
+  // A flush is still done when requested.
+  bool callback_invoked = false;
+  http_server_props_manager_->Clear(
+      base::BindOnce([](bool* callback_invoked) { *callback_invoked = true; },
+                     &callback_invoked));
+  EXPECT_EQ(1, pref_delegate_->GetAndClearNumPrefUpdates());
+  std::move(pref_delegate_->GetSetPropertiesCallback()).Run();
+  EXPECT_TRUE(callback_invoked);
+
+  // Nothing is left to write on shutdown.
+  int pref_updates = 0;
+  pref_delegate_->set_extra_update_prefs_callback(
+      base::Bind([](int* updates) { (*updates)++; }, &pref_updates));
+  http_server_props_manager_.reset();
+  EXPECT_EQ(0, pref_updates);
+}
+
+// Servers are persisted in MRU order, and loaded back in the same order.
+TEST_P(HttpServerPropertiesManagerTest, PersistServersInMRUOrder) {
+  const url::SchemeHostPort server_www("https", "www.google.com", 443);
+  const url::SchemeHostPort server_mail("https", "mail.google.com", 443);
+  const AlternativeService alternative_service(kProtoHTTP2, "", 444);
+  ASSERT_TRUE(http_server_props_manager_->SetHttp2AlternativeService(
+      server_www, alternative_service, one_day_from_now_));
+  ASSERT_TRUE(http_server_props_manager_->SetHttp2AlternativeService(
+      server_mail, alternative_service, one_day_from_now_));
+  FastForwardUntilNoTasksRemain();
+  EXPECT_EQ(1, pref_delegate_->GetAndClearNumPrefUpdates());
+
+  const base::ListValue* servers_list = nullptr;
+  ASSERT_TRUE(pref_delegate_->GetServerProperties()->GetList("servers",
+                                                             &servers_list));
+  ASSERT_EQ(2u, servers_list->GetSize());
+  const base::DictionaryValue* server_dict = nullptr;
+  ASSERT_TRUE(servers_list->GetDictionary(0, &server_dict));
+  EXPECT_TRUE(server_dict->HasKey("https://mail.google.com"));
+  ASSERT_TRUE(servers_list->GetDictionary(1, &server_dict));
+  EXPECT_TRUE(server_dict->HasKey("https://www.google.com"));
+
+  // Load the prefs in a new manager.
+  base::DictionaryValue prefs;
+  prefs.MergeDictionary(pref_delegate_->GetServerProperties());
+  http_server_props_manager_.reset();
+  pref_delegate_ = new MockPrefDelegate;
+  http_server_props_manager_ = std::make_unique<HttpServerPropertiesManager>(
+      base::WrapUnique(pref_delegate_), /*net_log=*/nullptr,
+      GetMockTickClock());
+  pref_delegate_->SetPrefs(prefs);
+  ASSERT_TRUE(http_server_props_manager_->IsInitialized());
+
+  const AlternativeServiceMap& map =
+      http_server_props_manager_->alternative_service_map();
+  ASSERT_EQ(2u, map.size());
+  EXPECT_EQ(server_mail, map.begin()->first);
+  EXPECT_EQ(server_www, map.rbegin()->first);
+}
+
 }  // namespace net
@@ -445,6 +445,14 @@ int MockDiskCache::OpenEntry(const std::string& key,
   if (GetTestModeForEntry(key) & TEST_MODE_SYNC_CACHE_START)
     return OK;
 
+  // Pause and resume.
+  if (defer_op_ == MockDiskEntry::DEFER_OPEN) {
+    defer_op_ = MockDiskEntry::DEFER_NONE;
+    resume_callback_ = std::move(callback);
+    resume_return_code_ = OK;
+    return ERR_IO_PENDING;
+  }
+
   CallbackLater(std::move(callback), OK);
   return ERR_IO_PENDING;
 }
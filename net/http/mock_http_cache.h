@@ -35,6 +35,7 @@ class MockDiskEntry : public disk_cache::Entry,
  public:
   enum DeferOp {
     DEFER_NONE,
+    DEFER_OPEN,
     DEFER_CREATE,
     DEFER_READ,
     DEFER_WRITE,
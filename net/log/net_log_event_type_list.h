@@ -1550,6 +1550,13 @@ EVENT_TYPE(HTTP2_SESSION_POOL_FOUND_EXISTING_SESSION)
 //   }
 EVENT_TYPE(HTTP2_SESSION_POOL_FOUND_EXISTING_SESSION_FROM_IP_POOL)
 
+// This event indicates the pool has no available session for a request.
+//   {
+//     "reason": <The reason the first candidate session could not be used, or
+//                "no_session" if there was none>,
+//   }
+EVENT_TYPE(HTTP2_SESSION_POOL_NO_AVAILABLE_SESSION)
+
 // This event indicates the pool created a new session
 //   {
 //     "source_dependency": <The session id>,
@@ -1649,6 +1656,14 @@ EVENT_TYPE(QUIC_STREAM_FACTORY_JOB)
 //  }
 EVENT_TYPE(QUIC_STREAM_FACTORY_JOB_BOUND_TO_HTTP_STREAM_JOB)
 
+// This event indicates the QuicStreamFactory has no session a request can use,
+// so the request starts a new job.
+//   {
+//     "reason": <"cannot_pool" if a session to the destination could not be
+//                used for the host, otherwise "no_session">,
+//   }
+EVENT_TYPE(QUIC_STREAM_FACTORY_NO_AVAILABLE_SESSION)
+
 // Measures the time taken to establish a QUIC connection.
 // The event parameters are:
 //  {
@@ -419,6 +419,10 @@ NET_EXPORT std::unique_ptr<base::DictionaryValue> GetNetInfo(
       status_dict->SetString("alpn_protos", next_protos_string);
     }
 
+    status_dict->Set(
+        "session_pool_lookups",
+        http_network_session->spdy_session_pool()->LookupStatsToValue());
+
     net_info_dict->Set(NetInfoSourceToString(NET_INFO_SPDY_STATUS),
                        std::move(status_dict));
   }
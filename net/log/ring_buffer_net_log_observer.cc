@@ -0,0 +1,129 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/log/ring_buffer_net_log_observer.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
+#include "base/logging.h"
+#include "base/values.h"
+#include "net/log/net_log_capture_mode.h"
+#include "net/log/net_log_entry.h"
+
+namespace net {
+
+const size_t RingBufferNetLogObserver::kMaxParametersLength;
+
+RingBufferNetLogObserver::RingBufferNetLogObserver(size_t max_entries,
+                                                   bool record_parameters)
+    : max_entries_(max_entries),
+      record_parameters_(record_parameters),
+      next_entry_(0) {
+  DCHECK_GT(max_entries_, 0u);
+  entries_.reserve(max_entries_);
+}
+
+RingBufferNetLogObserver::~RingBufferNetLogObserver() {
+  DCHECK(!net_log());
+}
+
+void RingBufferNetLogObserver::StartObserving(NetLog* net_log) {
+  net_log->AddObserver(this, NetLogCaptureMode::Default());
+}
+
+void RingBufferNetLogObserver::StopObserving() {
+  net_log()->RemoveObserver(this);
+}
+
+std::unique_ptr<base::DictionaryValue> RingBufferNetLogObserver::GetSnapshot(
+    std::unique_ptr<base::Value> constants) const {
+  auto events = std::make_unique<base::ListValue>();
+  {
+    base::AutoLock lock(lock_);
+    for (size_t i = 0; i < entries_.size(); ++i)
+      events->Append(
+          EntryToValue(entries_[(next_entry_ + i) % entries_.size()]));
+  }
+
+  auto snapshot = std::make_unique<base::DictionaryValue>();
+  if (constants)
+    snapshot->Set("constants", std::move(constants));
+  snapshot->Set("events", std::move(events));
+  return snapshot;
+}
+
+size_t RingBufferNetLogObserver::GetNumEntries() const {
+  base::AutoLock lock(lock_);
+  return entries_.size();
+}
+
+void RingBufferNetLogObserver::OnAddEntry(const NetLogEntry& entry) {
+  // Serialize the parameters before taking the lock, so that GetSnapshot()
+  // isn't held up by them.
+  std::string parameters;
+  if (record_parameters_) {
+    std::unique_ptr<base::Value> value = entry.ParametersToValue();
+    if (value)
+      base::JSONWriter::Write(*value, &parameters);
+  }
+
+  base::AutoLock lock(lock_);
+  Entry* slot;
+  if (entries_.size() < max_entries_) {
+    entries_.emplace_back();
+    slot = &entries_.back();
+  } else {
+    slot = &entries_[next_entry_];
+    next_entry_ = (next_entry_ + 1) % max_entries_;
+  }
+
+  slot->time = entry.time();
+  slot->source_id = entry.source().id;
+  slot->type = static_cast<uint16_t>(entry.type());
+  slot->source_type = static_cast<uint8_t>(entry.source().type);
+  slot->phase = static_cast<uint8_t>(entry.phase());
+  // Anything longer than kMaxParametersLength is truncated, so there's no
+  // need to keep its exact length.
+  slot->parameters_length = static_cast<uint16_t>(
+      std::min(parameters.size(), kMaxParametersLength + 1));
+  memcpy(slot->parameters, parameters.data(),
+         std::min(parameters.size(), kMaxParametersLength));
+}
+
+// static
+std::unique_ptr<base::Value> RingBufferNetLogObserver::EntryToValue(
+    const Entry& entry) {
+  auto entry_dict = std::make_unique<base::DictionaryValue>();
+  entry_dict->SetString("time", NetLog::TickCountToString(entry.time));
+
+  auto source_dict = std::make_unique<base::DictionaryValue>();
+  source_dict->SetInteger("id", entry.source_id);
+  source_dict->SetInteger("type", entry.source_type);
+  entry_dict->Set("source", std::move(source_dict));
+
+  entry_dict->SetInteger("type", entry.type);
+  entry_dict->SetInteger("phase", entry.phase);
+
+  if (entry.parameters_length > kMaxParametersLength) {
+    auto truncated = std::make_unique<base::DictionaryValue>();
+    truncated->SetString(
+        "truncated", std::string(entry.parameters, kMaxParametersLength));
+    entry_dict->Set("params", std::move(truncated));
+  } else if (entry.parameters_length > 0) {
+    std::unique_ptr<base::Value> params = base::JSONReader::Read(
+        base::StringPiece(entry.parameters, entry.parameters_length));
+    if (params)
+      entry_dict->Set("params", std::move(params));
+  }
+
+  return std::move(entry_dict);
+}
+
+}  // namespace net
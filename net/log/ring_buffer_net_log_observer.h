@@ -0,0 +1,95 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_LOG_RING_BUFFER_NET_LOG_OBSERVER_H_
+#define NET_LOG_RING_BUFFER_NET_LOG_OBSERVER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/synchronization/lock.h"
+#include "base/time/time.h"
+#include "net/base/net_export.h"
+#include "net/log/net_log.h"
+
+namespace base {
+class DictionaryValue;
+class Value;
+}  // namespace base
+
+namespace net {
+
+// RingBufferNetLogObserver keeps the most recent NetLog events in a fixed-size
+// in-memory buffer, so that it can be left on all the time and dumped after
+// the fact when a problem is reported.
+//
+// Unlike FileNetLogObserver, it doesn't serialize events as they are added.
+// Each entry only records the event type, source, phase and time, plus, if
+// |record_parameters| is true, the first kMaxParametersLength bytes of the
+// JSON-serialized parameters. Events are observed at
+// NetLogCaptureMode::Default(), so no cookies or credentials are kept.
+//
+// Threading: OnAddEntry() is called with the NetLog's lock held. The other
+// methods may be called on any thread.
+class NET_EXPORT RingBufferNetLogObserver : public NetLog::ThreadSafeObserver {
+ public:
+  // Maximum number of bytes of serialized parameters kept per entry.
+  static const size_t kMaxParametersLength = 64;
+
+  // Keeps the |max_entries| most recent events.
+  RingBufferNetLogObserver(size_t max_entries, bool record_parameters);
+  ~RingBufferNetLogObserver() override;
+
+  void StartObserving(NetLog* net_log);
+  void StopObserving();
+
+  // Returns the kept events, oldest first, in the format of a NetLog file:
+  // a dictionary with an "events" list and, if |constants| is non-null, the
+  // "constants" needed to load it. The parameters of an entry whose
+  // serialized parameters were cut short are a dictionary with the kept
+  // prefix under "truncated".
+  std::unique_ptr<base::DictionaryValue> GetSnapshot(
+      std::unique_ptr<base::Value> constants) const;
+
+  // Returns the number of events kept, which is at most |max_entries|.
+  size_t GetNumEntries() const;
+
+  // NetLog::ThreadSafeObserver implementation:
+  void OnAddEntry(const NetLogEntry& entry) override;
+
+ private:
+  struct Entry {
+    base::TimeTicks time;
+    uint32_t source_id;
+    uint16_t type;
+    uint8_t source_type;
+    uint8_t phase;
+    // Length of the serialized parameters, if any. Greater than
+    // kMaxParametersLength if they were truncated.
+    uint16_t parameters_length;
+    char parameters[kMaxParametersLength];
+  };
+
+  // Returns |entry| as a Value, in the format of NetLogEntry::ToValue().
+  static std::unique_ptr<base::Value> EntryToValue(const Entry& entry);
+
+  const size_t max_entries_;
+  const bool record_parameters_;
+
+  mutable base::Lock lock_;
+  // Grows up to |max_entries_|, then wraps around.
+  std::vector<Entry> entries_;
+  // Index of the oldest entry, once |entries_| is full.
+  size_t next_entry_;
+
+  DISALLOW_COPY_AND_ASSIGN(RingBufferNetLogObserver);
+};
+
+}  // namespace net
+
+#endif  // NET_LOG_RING_BUFFER_NET_LOG_OBSERVER_H_
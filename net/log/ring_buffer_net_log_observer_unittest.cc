@@ -0,0 +1,122 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/log/ring_buffer_net_log_observer.h"
+
+#include <memory>
+#include <string>
+
+#include "base/values.h"
+#include "net/log/net_log.h"
+#include "net/log/net_log_event_type.h"
+#include "net/log/net_log_source_type.h"
+#include "net/log/net_log_with_source.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+// Returns the "events" list of |snapshot|.
+const base::Value::ListStorage& GetEvents(
+    const base::DictionaryValue& snapshot) {
+  const base::Value* events = snapshot.FindKey("events");
+  EXPECT_TRUE(events);
+  return events->GetList();
+}
+
+TEST(RingBufferNetLogObserverTest, RecordsEvents) {
+  NetLog net_log;
+  RingBufferNetLogObserver observer(10, true);
+  observer.StartObserving(&net_log);
+
+  NetLogWithSource net_log_with_source =
+      NetLogWithSource::Make(&net_log, NetLogSourceType::URL_REQUEST);
+  net_log_with_source.BeginEvent(NetLogEventType::REQUEST_ALIVE);
+  net_log_with_source.AddEvent(NetLogEventType::URL_REQUEST_START_JOB,
+                               NetLog::IntCallback("load_flags", 7));
+  observer.StopObserving();
+
+  std::unique_ptr<base::DictionaryValue> snapshot =
+      observer.GetSnapshot(nullptr);
+  EXPECT_FALSE(snapshot->FindKey("constants"));
+  const base::Value::ListStorage& events = GetEvents(*snapshot);
+  ASSERT_EQ(2u, events.size());
+
+  const base::Value* type = events[0].FindKey("type");
+  ASSERT_TRUE(type);
+  EXPECT_EQ(static_cast<int>(NetLogEventType::REQUEST_ALIVE), type->GetInt());
+  const base::Value* phase = events[0].FindKey("phase");
+  ASSERT_TRUE(phase);
+  EXPECT_EQ(static_cast<int>(NetLogEventPhase::BEGIN), phase->GetInt());
+  const base::Value* source_id = events[0].FindPath({"source", "id"});
+  ASSERT_TRUE(source_id);
+  EXPECT_EQ(static_cast<int>(net_log_with_source.source().id),
+            source_id->GetInt());
+  EXPECT_FALSE(events[0].FindKey("params"));
+
+  const base::Value* load_flags = events[1].FindPath({"params", "load_flags"});
+  ASSERT_TRUE(load_flags);
+  EXPECT_EQ(7, load_flags->GetInt());
+}
+
+// Once the buffer is full, the oldest entries are overwritten.
+TEST(RingBufferNetLogObserverTest, Wraps) {
+  NetLog net_log;
+  RingBufferNetLogObserver observer(3, false);
+  observer.StartObserving(&net_log);
+
+  NetLogWithSource net_log_with_source =
+      NetLogWithSource::Make(&net_log, NetLogSourceType::URL_REQUEST);
+  for (int i = 0; i < 5; ++i) {
+    net_log_with_source.AddEvent(NetLogEventType::URL_REQUEST_START_JOB,
+                                 NetLog::IntCallback("index", i));
+  }
+  net_log_with_source.AddEvent(NetLogEventType::CANCELLED);
+  observer.StopObserving();
+  EXPECT_EQ(3u, observer.GetNumEntries());
+
+  std::unique_ptr<base::DictionaryValue> snapshot =
+      observer.GetSnapshot(std::make_unique<base::DictionaryValue>());
+  EXPECT_TRUE(snapshot->FindKey("constants"));
+  const base::Value::ListStorage& events = GetEvents(*snapshot);
+  ASSERT_EQ(3u, events.size());
+  EXPECT_EQ(static_cast<int>(NetLogEventType::URL_REQUEST_START_JOB),
+            events[0].FindKey("type")->GetInt());
+  EXPECT_EQ(static_cast<int>(NetLogEventType::URL_REQUEST_START_JOB),
+            events[1].FindKey("type")->GetInt());
+  EXPECT_EQ(static_cast<int>(NetLogEventType::CANCELLED),
+            events[2].FindKey("type")->GetInt());
+  // Parameters were not recorded.
+  EXPECT_FALSE(events[0].FindKey("params"));
+}
+
+// Parameters that don't fit in an entry are kept as a truncated string.
+TEST(RingBufferNetLogObserverTest, TruncatesParameters) {
+  NetLog net_log;
+  RingBufferNetLogObserver observer(10, true);
+  observer.StartObserving(&net_log);
+
+  std::string long_string(
+      2 * RingBufferNetLogObserver::kMaxParametersLength, 'a');
+  NetLogWithSource net_log_with_source =
+      NetLogWithSource::Make(&net_log, NetLogSourceType::URL_REQUEST);
+  net_log_with_source.AddEvent(NetLogEventType::URL_REQUEST_START_JOB,
+                               NetLog::StringCallback("url", &long_string));
+  observer.StopObserving();
+
+  std::unique_ptr<base::DictionaryValue> snapshot =
+      observer.GetSnapshot(nullptr);
+  const base::Value::ListStorage& events = GetEvents(*snapshot);
+  ASSERT_EQ(1u, events.size());
+  const base::Value* truncated = events[0].FindPath({"params", "truncated"});
+  ASSERT_TRUE(truncated);
+  EXPECT_EQ(RingBufferNetLogObserver::kMaxParametersLength,
+            truncated->GetString().size());
+  EXPECT_EQ("{\"url\":\"aaa", truncated->GetString().substr(0, 11));
+}
+
+}  // namespace
+
+}  // namespace net
@@ -30,6 +30,7 @@ QuicChromiumPacketReader::QuicChromiumPacketReader(
       yield_after_(quic::QuicTime::Infinite()),
       read_buffer_(
           new IOBufferWithSize(static_cast<size_t>(quic::kMaxPacketSize))),
+      addresses_initialized_(false),
       net_log_(net_log),
       weak_factory_(this) {}
 
@@ -55,8 +56,8 @@ void QuicChromiumPacketReader::StartReading() {
       return;
     }
 
-    if (++num_packets_read_ > yield_after_packets_ ||
-        clock_->Now() > yield_after_) {
+    quic::QuicTime now = clock_->Now();
+    if (++num_packets_read_ > yield_after_packets_ || now > yield_after_) {
       num_packets_read_ = 0;
       // Data was read, process it.
       // Schedule the work through the message loop to 1) prevent infinite
@@ -65,7 +66,7 @@ void QuicChromiumPacketReader::StartReading() {
           FROM_HERE, base::Bind(&QuicChromiumPacketReader::OnReadComplete,
                                 weak_factory_.GetWeakPtr(), rv));
     } else {
-      if (!ProcessReadResult(rv)) {
+      if (!ProcessReadResult(rv, now)) {
         return;
       }
     }
@@ -77,7 +78,8 @@ size_t QuicChromiumPacketReader::EstimateMemoryUsage() const {
   return quic::kMaxPacketSize;
 }
 
-bool QuicChromiumPacketReader::ProcessReadResult(int result) {
+bool QuicChromiumPacketReader::ProcessReadResult(int result,
+                                                 quic::QuicTime now) {
   read_pending_ = false;
   if (result == 0)
     result = ERR_CONNECTION_CLOSED;
@@ -87,19 +89,24 @@ bool QuicChromiumPacketReader::ProcessReadResult(int result) {
     return false;
   }
 
-  quic::QuicReceivedPacket packet(read_buffer_->data(), result, clock_->Now());
-  IPEndPoint local_address;
-  IPEndPoint peer_address;
-  socket_->GetLocalAddress(&local_address);
-  socket_->GetPeerAddress(&peer_address);
-  return visitor_->OnPacket(
-      packet,
-      quic::QuicSocketAddress(quic::QuicSocketAddressImpl(local_address)),
-      quic::QuicSocketAddress(quic::QuicSocketAddressImpl(peer_address)));
+  if (!addresses_initialized_) {
+    IPEndPoint local_address;
+    IPEndPoint peer_address;
+    socket_->GetLocalAddress(&local_address);
+    socket_->GetPeerAddress(&peer_address);
+    local_address_ =
+        quic::QuicSocketAddress(quic::QuicSocketAddressImpl(local_address));
+    peer_address_ =
+        quic::QuicSocketAddress(quic::QuicSocketAddressImpl(peer_address));
+    addresses_initialized_ = true;
+  }
+
+  quic::QuicReceivedPacket packet(read_buffer_->data(), result, now);
+  return visitor_->OnPacket(packet, local_address_, peer_address_);
 }
 
 void QuicChromiumPacketReader::OnReadComplete(int result) {
-  if (ProcessReadResult(result)) {
+  if (ProcessReadResult(result, clock_->Now())) {
     StartReading();
   }
 }
@@ -14,6 +14,7 @@
 #include "net/socket/datagram_client_socket.h"
 #include "net/third_party/quic/core/quic_packets.h"
 #include "net/third_party/quic/core/quic_time.h"
+#include "net/third_party/quic/platform/api/quic_socket_address.h"
 
 namespace quic {
 class QuicClock;
@@ -56,8 +57,9 @@ class NET_EXPORT_PRIVATE QuicChromiumPacketReader {
  private:
   // A completion callback invoked when a read completes.
   void OnReadComplete(int result);
-  // Return true if reading should continue.
-  bool ProcessReadResult(int result);
+  // Return true if reading should continue. |now| is the time the packet in
+  // |read_buffer_|, if any, was received.
+  bool ProcessReadResult(int result, quic::QuicTime now);
 
   DatagramClientSocket* socket_;
   Visitor* visitor_;
@@ -68,6 +70,11 @@ class NET_EXPORT_PRIVATE QuicChromiumPacketReader {
   quic::QuicTime::Delta yield_after_duration_;
   quic::QuicTime yield_after_;
   scoped_refptr<IOBufferWithSize> read_buffer_;
+  // The addresses of |socket_|, looked up when the first packet is read. The
+  // socket is connected, so they don't change while reading.
+  bool addresses_initialized_;
+  quic::QuicSocketAddress local_address_;
+  quic::QuicSocketAddress peer_address_;
   NetLogWithSource net_log_;
 
   base::WeakPtrFactory<QuicChromiumPacketReader> weak_factory_;
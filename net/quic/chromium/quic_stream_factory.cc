@@ -10,6 +10,7 @@
 #include <utility>
 
 #include "base/callback_helpers.h"
+#include "base/feature_list.h"
 #include "base/location.h"
 #include "base/metrics/field_trial.h"
 #include "base/metrics/histogram_functions.h"
@@ -74,6 +75,11 @@ size_t EstimateMemoryUsage(const IPEndPoint& end_point) {
 
 namespace {
 
+// Reads several QUIC packets per system call with recvmmsg(), on platforms
+// that support it.
+const base::Feature kQuicBatchedSocketReads{"QuicBatchedSocketReads",
+                                            base::FEATURE_DISABLED_BY_DEFAULT};
+
 enum CreateSessionFailure {
   CREATION_ERROR_CONNECTING_SOCKET,
   CREATION_ERROR_SETTING_RECEIVE_BUFFER,
@@ -103,6 +109,25 @@ const int32_t kQuicSocketReceiveBufferSize = 1024 * 1024;  // 1MB
 // Set the maximum number of undecryptable packets the connection will store.
 const int32_t kMaxUndecryptablePackets = 100;
 
+const char* LookupResultToString(QuicStreamFactory::LookupResult result) {
+  switch (result) {
+    case QuicStreamFactory::LOOKUP_FOUND_EXISTING:
+      return "found_existing";
+    case QuicStreamFactory::LOOKUP_FOUND_EXISTING_FOR_DESTINATION:
+      return "found_existing_for_destination";
+    case QuicStreamFactory::LOOKUP_JOINED_JOB:
+      return "joined_job";
+    case QuicStreamFactory::LOOKUP_NO_SESSION:
+      return "no_session";
+    case QuicStreamFactory::LOOKUP_CANNOT_POOL:
+      return "cannot_pool";
+    case QuicStreamFactory::LOOKUP_RESULT_MAX:
+      break;
+  }
+  NOTREACHED();
+  return "";
+}
+
 std::unique_ptr<base::Value> NetLogQuicStreamFactoryJobCallback(
     const quic::QuicServerId* server_id,
     NetLogCaptureMode capture_mode) {
@@ -811,6 +836,8 @@ QuicStreamFactory::QuicStreamFactory(
           headers_include_h2_stream_dependency),
       need_to_check_persisted_supports_quic_(true),
       num_push_streams_created_(0),
+      lookup_counts_(),
+      num_ip_pooled_jobs_(0),
       task_runner_(nullptr),
       ssl_config_service_(ssl_config_service),
       enable_socket_recv_optimization_(enable_socket_recv_optimization),
@@ -1002,6 +1029,7 @@ int QuicStreamFactory::Create(const QuicSessionKey& session_key,
         session_key.server_id().privacy_mode()) {
       request->SetSession(session->CreateHandle(destination));
       ++num_push_streams_created_;
+      RecordLookupResult(LOOKUP_FOUND_EXISTING, net_log);
       return OK;
     }
     // This should happen extremely rarely (if ever), but if somehow a
@@ -1017,6 +1045,7 @@ int QuicStreamFactory::Create(const QuicSessionKey& session_key,
     if (it != active_sessions_.end()) {
       QuicChromiumClientSession* session = it->second;
       request->SetSession(session->CreateHandle(destination));
+      RecordLookupResult(LOOKUP_FOUND_EXISTING, net_log);
       return OK;
     }
   }
@@ -1032,22 +1061,28 @@ int QuicStreamFactory::Create(const QuicSessionKey& session_key,
         NetLogEventType::HTTP_STREAM_JOB_BOUND_TO_QUIC_STREAM_FACTORY_JOB,
         job_net_log.source().ToEventParametersCallback());
     it->second->AddRequest(request);
+    RecordLookupResult(LOOKUP_JOINED_JOB, net_log);
     return ERR_IO_PENDING;
   }
 
   // Pool to active session to |destination| if possible.
+  LookupResult miss_result = LOOKUP_NO_SESSION;
   if (!active_sessions_.empty()) {
     for (const auto& key_value : active_sessions_) {
       QuicChromiumClientSession* session = key_value.second;
-      if (destination.Equals(all_sessions_[session].destination()) &&
-          session->CanPool(session_key.server_id().host(),
+      if (!destination.Equals(all_sessions_[session].destination()))
+        continue;
+      if (session->CanPool(session_key.server_id().host(),
                            session_key.server_id().privacy_mode(),
                            session_key.socket_tag())) {
         request->SetSession(session->CreateHandle(destination));
+        RecordLookupResult(LOOKUP_FOUND_EXISTING_FOR_DESTINATION, net_log);
         return OK;
       }
+      miss_result = LOOKUP_CANNOT_POOL;
     }
   }
+  RecordLookupResult(miss_result, net_log);
 
   // TODO(rtenneti): |task_runner_| is used by the Job. Initialize task_runner_
   // in the constructor after WebRequestActionWithThreadsTest.* tests are fixed.
@@ -1124,12 +1159,23 @@ bool QuicStreamFactory::HasMatchingIpSession(const QuicSessionAliasKey& key,
         continue;
       active_sessions_[key.session_key()] = session;
       session_aliases_[session].insert(key);
+      ++num_ip_pooled_jobs_;
       return true;
     }
   }
   return false;
 }
 
+void QuicStreamFactory::RecordLookupResult(LookupResult result,
+                                           const NetLogWithSource& net_log) {
+  ++lookup_counts_[result];
+  if (result != LOOKUP_NO_SESSION && result != LOOKUP_CANNOT_POOL)
+    return;
+  net_log.AddEvent(
+      NetLogEventType::QUIC_STREAM_FACTORY_NO_AVAILABLE_SESSION,
+      NetLog::StringCallback("reason", LookupResultToString(result)));
+}
+
 void QuicStreamFactory::OnJobHostResolutionComplete(Job* job, int rv) {
   auto iter = active_jobs_.find(job->key().session_key());
   DCHECK(iter != active_jobs_.end());
@@ -1262,6 +1308,17 @@ std::unique_ptr<base::Value> QuicStreamFactory::QuicStreamFactoryInfoToValue()
   return std::move(list);
 }
 
+std::unique_ptr<base::Value> QuicStreamFactory::LookupStatsToValue() const {
+  auto dict = std::make_unique<base::DictionaryValue>();
+  for (int i = 0; i < LOOKUP_RESULT_MAX; ++i) {
+    LookupResult result = static_cast<LookupResult>(i);
+    dict->SetInteger(LookupResultToString(result),
+                     static_cast<int>(lookup_counts_[result]));
+  }
+  dict->SetInteger("ip_pooled_jobs", static_cast<int>(num_ip_pooled_jobs_));
+  return std::move(dict);
+}
+
 void QuicStreamFactory::ClearCachedStatesInCryptoConfig(
     const base::Callback<bool(const GURL&)>& origin_filter) {
   ServerIdOriginFilter filter(origin_filter);
@@ -1369,6 +1426,8 @@ std::unique_ptr<DatagramClientSocket> QuicStreamFactory::CreateSocket(
       DatagramSocket::DEFAULT_BIND, net_log, source);
   if (enable_socket_recv_optimization_)
     socket->EnableRecvOptimization();
+  if (base::FeatureList::IsEnabled(kQuicBatchedSocketReads))
+    socket->SetRecvmmsgEnabled(true);
   return socket;
 }
 
@@ -186,6 +186,23 @@ class NET_EXPORT_PRIVATE QuicStreamFactory
       public SSLConfigService::Observer,
       public CertDatabase::Observer {
  public:
+  // The results of Create(), to see why requests do or don't reuse sessions.
+  enum LookupResult {
+    // There is a session for the key, or a promised stream on one.
+    LOOKUP_FOUND_EXISTING,
+    // There is a session to the destination that can be used for the host.
+    LOOKUP_FOUND_EXISTING_FOR_DESTINATION,
+    // The request waits for the job already connecting to the key.
+    LOOKUP_JOINED_JOB,
+    // There is no session for the key or to the destination. The job may
+    // still find a session to an IP address of the host once it resolves.
+    LOOKUP_NO_SESSION,
+    // A session to the destination has a different privacy mode or socket
+    // tag, or is not authenticated for the host.
+    LOOKUP_CANNOT_POOL,
+    LOOKUP_RESULT_MAX
+  };
+
   // This class encompasses |destination| and |server_id|.
   // |destination| is a HostPortPair which is resolved
   // and a quic::QuicConnection is made to the resulting IP address.
@@ -308,6 +325,18 @@ class NET_EXPORT_PRIVATE QuicStreamFactory
 
   std::unique_ptr<base::Value> QuicStreamFactoryInfoToValue() const;
 
+  // Returns the number of calls to Create() with |result|.
+  size_t lookup_count(LookupResult result) const {
+    return lookup_counts_[result];
+  }
+
+  // Returns the number of jobs that found a session to an IP address of their
+  // host instead of connecting.
+  size_t num_ip_pooled_jobs() const { return num_ip_pooled_jobs_; }
+
+  // Creates a Value summary of the results of Create() and of IP pooling.
+  std::unique_ptr<base::Value> LookupStatsToValue() const;
+
   // Delete cached state objects in |crypto_config_|. If |origin_filter| is not
   // null, only objects on matching origins will be deleted.
   void ClearCachedStatesInCryptoConfig(
@@ -411,6 +440,9 @@ class NET_EXPORT_PRIVATE QuicStreamFactory
 
   bool HasMatchingIpSession(const QuicSessionAliasKey& key,
                             const AddressList& address_list);
+  // Counts a call to Create() with |result|, and logs the reason a session
+  // was not found to |net_log|.
+  void RecordLookupResult(LookupResult result, const NetLogWithSource& net_log);
   void OnJobHostResolutionComplete(Job* job, int rv);
   void OnJobComplete(Job* job, int rv);
   void OnCertVerifyJobComplete(CertVerifierJob* job, int rv);
@@ -593,6 +625,9 @@ class NET_EXPORT_PRIVATE QuicStreamFactory
 
   int num_push_streams_created_;
 
+  size_t lookup_counts_[LOOKUP_RESULT_MAX];
+  size_t num_ip_pooled_jobs_;
+
   quic::QuicClientPushPromiseIndex push_promise_index_;
 
   base::SequencedTaskRunner* task_runner_;
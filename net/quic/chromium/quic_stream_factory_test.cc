@@ -896,6 +896,10 @@ TEST_P(QuicStreamFactoryTest, Create) {
   stream = CreateStream(&request3);  // Will reset stream 5.
   stream.reset();                    // Will reset stream 7.
 
+  EXPECT_EQ(1u, factory_->lookup_count(QuicStreamFactory::LOOKUP_NO_SESSION));
+  EXPECT_EQ(2u,
+            factory_->lookup_count(QuicStreamFactory::LOOKUP_FOUND_EXISTING));
+
   EXPECT_TRUE(socket_data.AllReadDataConsumed());
   EXPECT_TRUE(socket_data.AllWriteDataConsumed());
 }
@@ -1259,6 +1263,8 @@ TEST_P(QuicStreamFactoryTest, Pooling) {
   EXPECT_TRUE(stream2.get());
 
   EXPECT_EQ(GetActiveSession(host_port_pair_), GetActiveSession(server2));
+  EXPECT_EQ(2u, factory_->lookup_count(QuicStreamFactory::LOOKUP_NO_SESSION));
+  EXPECT_EQ(1u, factory_->num_ip_pooled_jobs());
 
   EXPECT_TRUE(socket_data.AllReadDataConsumed());
   EXPECT_TRUE(socket_data.AllWriteDataConsumed());
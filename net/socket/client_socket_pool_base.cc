@@ -7,10 +7,13 @@
 #include <algorithm>
 #include <utility>
 
+#include "base/bind.h"
 #include "base/compiler_specific.h"
+#include "base/feature_list.h"
 #include "base/format_macros.h"
 #include "base/location.h"
 #include "base/logging.h"
+#include "base/metrics/field_trial_params.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/single_thread_task_runner.h"
 #include "base/strings/string_util.h"
@@ -37,6 +40,18 @@ namespace {
 // after a certain timeout has passed without receiving an ACK.
 bool g_connect_backup_jobs_enabled = true;
 
+// When enabled, a request for a group that has no sockets also preconnects as
+// many sockets as the group needed the last time it was in use.
+const base::Feature kSocketPoolPredictDemand{"SocketPoolPredictDemand",
+                                             base::FEATURE_DISABLED_BY_DEFAULT};
+
+// Upper bound on the number of sockets opened for a single prediction.
+const base::FeatureParam<int> kMaxPredictedSockets{
+    &kSocketPoolPredictDemand, "max_predicted_sockets", 4};
+
+// Number of groups whose demand is remembered.
+const size_t kMaxDemandHistoryGroups = 256;
+
 }  // namespace
 
 ConnectJob::ConnectJob(const std::string& group_name,
@@ -176,11 +191,20 @@ ClientSocketPoolBaseHelper::ClientSocketPoolBaseHelper(
       connect_backup_jobs_enabled_(false),
       pool_generation_number_(0),
       pool_(pool),
+      predict_demand_(base::FeatureList::IsEnabled(kSocketPoolPredictDemand)),
+      peak_demand_(kMaxDemandHistoryGroups),
       weak_factory_(this) {
   DCHECK_LE(0, max_sockets_per_group);
   DCHECK_LE(max_sockets_per_group, max_sockets);
 
   NetworkChangeNotifier::AddIPAddressObserver(this);
+
+  if (predict_demand_) {
+    memory_pressure_listener_ =
+        std::make_unique<base::MemoryPressureListener>(base::BindRepeating(
+            &ClientSocketPoolBaseHelper::OnMemoryPressure,
+            base::Unretained(this)));
+  }
 }
 
 ClientSocketPoolBaseHelper::~ClientSocketPoolBaseHelper() {
@@ -303,6 +327,12 @@ int ClientSocketPoolBaseHelper::RequestSocket(
               weak_factory_.GetWeakPtr()));
     }
   }
+
+  if (predict_demand_) {
+    GroupMap::const_iterator it = group_map_.find(group_name);
+    if (it != group_map_.end())
+      RecordDemand(group_name, *it->second);
+  }
   return rv;
 }
 
@@ -357,6 +387,29 @@ void ClientSocketPoolBaseHelper::RequestSockets(const std::string& group_name,
       NetLogEventType::SOCKET_POOL_CONNECTING_N_SOCKETS, rv);
 }
 
+int ClientSocketPoolBaseHelper::TakePredictedSocketCount(
+    const std::string& group_name) {
+  if (!predict_demand_)
+    return 0;
+
+  // Only predict at the start of a burst of requests. Once the group has
+  // sockets, the ones it needs are already being connected or reused.
+  GroupMap::const_iterator group_it = group_map_.find(group_name);
+  if (group_it != group_map_.end() &&
+      group_it->second->NumActiveSocketSlots() > 0) {
+    return 0;
+  }
+
+  auto it = peak_demand_.Get(group_name);
+  if (it == peak_demand_.end())
+    return 0;
+  int num_sockets =
+      std::min({it->second, kMaxPredictedSockets.Get(), max_sockets_per_group_});
+  it->second = 0;
+  // A single socket is opened for the request itself.
+  return num_sockets > 1 ? num_sockets : 0;
+}
+
 int ClientSocketPoolBaseHelper::RequestSocketInternal(
     const std::string& group_name,
     const Request& request) {
@@ -587,6 +640,34 @@ bool ClientSocketPoolBaseHelper::HasGroup(const std::string& group_name) const {
   return base::ContainsKey(group_map_, group_name);
 }
 
+void ClientSocketPoolBaseHelper::RecordDemand(const std::string& group_name,
+                                              const Group& group) {
+  DCHECK(predict_demand_);
+  int demand = group.active_socket_count() +
+               static_cast<int>(group.pending_request_count());
+  auto it = peak_demand_.Get(group_name);
+  if (it == peak_demand_.end()) {
+    peak_demand_.Put(group_name, demand);
+  } else if (demand > it->second) {
+    it->second = demand;
+  }
+}
+
+void ClientSocketPoolBaseHelper::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
+  switch (memory_pressure_level) {
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE:
+      break;
+
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE:
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL:
+      // Idle sockets, including preconnected ones, are closed by
+      // HttpNetworkSession. Stop predicting so that they aren't reopened.
+      peak_demand_.Clear();
+      break;
+  }
+}
+
 void ClientSocketPoolBaseHelper::CloseIdleSockets() {
   CleanupIdleSockets(true);
   DCHECK_EQ(0, idle_socket_count_);
@@ -34,7 +34,9 @@
 #include <utility>
 #include <vector>
 
+#include "base/containers/mru_cache.h"
 #include "base/macros.h"
+#include "base/memory/memory_pressure_listener.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
 #include "base/time/time.h"
@@ -278,6 +280,14 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
                       const Request& request,
                       int num_sockets);
 
+  // Returns the number of sockets to preconnect alongside a request for
+  // |group_name|, which is the peak demand for the group the last time it
+  // was in use. Returns 0 if the group still has sockets, if there is no
+  // history for it, or if demand prediction is disabled. The history is
+  // consumed, and the peak demand of the new burst of requests is recorded
+  // in its place.
+  int TakePredictedSocketCount(const std::string& group_name);
+
   // See ClientSocketPool::SetPriority for documentation on this function.
   void SetPriority(const std::string& group_name,
                    ClientSocketHandle* handle,
@@ -640,6 +650,13 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
   // this pool is stalled.
   void TryToCloseSocketsInLayeredPools();
 
+  // Updates the peak demand recorded for |group_name|, where the demand is the
+  // number of sockets handed out plus the number of pending requests.
+  void RecordDemand(const std::string& group_name, const Group& group);
+
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
+
   GroupMap group_map_;
 
   // Map of the ClientSocketHandles for which we have a pending Task to invoke a
@@ -689,6 +706,18 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
   // will remove itself from all lower layered pools on destruction.
   std::set<LowerLayeredPool*> lower_pools_;
 
+  // Whether requests for a group with no sockets preconnect as many sockets as
+  // the group needed the last time it was in use.
+  const bool predict_demand_;
+
+  // Peak demand of the current or most recent burst of requests for each
+  // group, for the most recently used groups.
+  base::MRUCache<std::string, int> peak_demand_;
+
+  // Forgets |peak_demand_| under memory pressure, so that no more sockets are
+  // opened speculatively. Only set when |predict_demand_| is true.
+  std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_;
+
   base::WeakPtrFactory<ClientSocketPoolBaseHelper> weak_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(ClientSocketPoolBaseHelper);
@@ -784,10 +813,18 @@ class ClientSocketPoolBase {
                     ClientSocketHandle* handle,
                     const CompletionCallback& callback,
                     const NetLogWithSource& net_log) {
+    int num_predicted_sockets = 0;
+    if (respect_limits == ClientSocketPool::RespectLimits::ENABLED)
+      num_predicted_sockets = helper_.TakePredictedSocketCount(group_name);
     std::unique_ptr<Request> request(new Request(
         handle, callback, priority, socket_tag, respect_limits,
         internal::ClientSocketPoolBaseHelper::NORMAL, params, net_log));
-    return helper_.RequestSocket(group_name, std::move(request));
+    int rv = helper_.RequestSocket(group_name, std::move(request));
+    // Start connecting the sockets the requests that are likely to follow
+    // will need, so that they find them idle.
+    if (num_predicted_sockets > 0 && (rv == OK || rv == ERR_IO_PENDING))
+      RequestSockets(group_name, params, num_predicted_sockets, net_log);
+    return rv;
   }
 
   // RequestSockets bundles up the parameters into a Request and then forwards
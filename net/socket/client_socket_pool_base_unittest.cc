@@ -21,6 +21,7 @@
 #include "base/single_thread_task_runner.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/stringprintf.h"
+#include "base/test/scoped_feature_list.h"
 #include "base/threading/platform_thread.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "base/values.h"
@@ -3451,6 +3452,54 @@ TEST_F(ClientSocketPoolBaseTest, RequestSocketsDifferentNumSockets) {
   EXPECT_EQ(0, pool_->IdleSocketCountInGroup("a"));
 }
 
+// With demand prediction enabled, the first request for a group that has no
+// sockets also preconnects as many sockets as the group last needed.
+TEST_F(ClientSocketPoolBaseTest, PredictDemand) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitFromCommandLine("SocketPoolPredictDemand", std::string());
+  CreatePool(4, 4);
+
+  // Three sockets are in use at once.
+  ClientSocketHandle handles[3];
+  for (ClientSocketHandle& handle : handles) {
+    TestCompletionCallback callback;
+    EXPECT_THAT(
+        handle.Init("a", params_, DEFAULT_PRIORITY, SocketTag(),
+                    ClientSocketPool::RespectLimits::ENABLED,
+                    callback.callback(), pool_.get(), NetLogWithSource()),
+        IsOk());
+  }
+  for (ClientSocketHandle& handle : handles)
+    handle.Reset();
+  pool_->CloseIdleSockets();
+  ASSERT_FALSE(pool_->HasGroup("a"));
+
+  connect_job_factory_->set_job_type(TestConnectJob::kMockPendingJob);
+  ClientSocketHandle handle;
+  TestCompletionCallback callback;
+  EXPECT_EQ(ERR_IO_PENDING,
+            handle.Init("a", params_, DEFAULT_PRIORITY, SocketTag(),
+                        ClientSocketPool::RespectLimits::ENABLED,
+                        callback.callback(), pool_.get(), NetLogWithSource()));
+  EXPECT_EQ(3, pool_->NumConnectJobsInGroup("a"));
+  EXPECT_EQ(2, pool_->NumUnassignedConnectJobsInGroup("a"));
+
+  // Only a single socket was used this time, so the next burst of requests
+  // doesn't preconnect.
+  EXPECT_THAT(callback.WaitForResult(), IsOk());
+  handle.Reset();
+  base::RunLoop().RunUntilIdle();
+  pool_->CloseIdleSockets();
+  ASSERT_FALSE(pool_->HasGroup("a"));
+
+  EXPECT_EQ(ERR_IO_PENDING,
+            handle.Init("a", params_, DEFAULT_PRIORITY, SocketTag(),
+                        ClientSocketPool::RespectLimits::ENABLED,
+                        callback.callback(), pool_.get(), NetLogWithSource()));
+  EXPECT_EQ(1, pool_->NumConnectJobsInGroup("a"));
+  EXPECT_EQ(0, pool_->NumUnassignedConnectJobsInGroup("a"));
+}
+
 TEST_F(ClientSocketPoolBaseTest, PreconnectJobsTakenByNormalRequests) {
   CreatePool(kDefaultMaxSockets, kDefaultMaxSocketsPerGroup);
   connect_job_factory_->set_job_type(TestConnectJob::kMockPendingJob);
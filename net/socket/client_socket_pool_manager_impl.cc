@@ -82,6 +82,7 @@ ClientSocketPoolManagerImpl::ClientSocketPoolManagerImpl(
                                        host_resolver,
                                        socket_factory_,
                                        socket_performance_watcher_factory_,
+                                       network_quality_provider,
                                        net_log)),
       ssl_socket_pool_(new SSLClientSocketPool(max_sockets_per_pool(pool_type),
                                                max_sockets_per_group(pool_type),
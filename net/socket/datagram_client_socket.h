@@ -50,6 +50,12 @@ class NET_EXPORT_PRIVATE DatagramClientSocket : public DatagramSocket,
   // By default, this method is no-op.
   virtual void EnableRecvOptimization() {}
 
+  // Enables reading several datagrams per system call with recvmmsg() on
+  // platforms that support it. Reads still return one datagram each, but are
+  // served from the datagrams read ahead while there are any. Must be called
+  // before the first read. By default, this method is no-op.
+  virtual void SetRecvmmsgEnabled(bool enabled) {}
+
   // As Write, but internally this can delay writes and batch them up
   // for writing in a separate task.  This is to increase throughput
   // in bulk transfer scenarios (in QUIC) where a substantial
@@ -18,10 +18,12 @@
 #include "net/base/net_export.h"
 #include "net/socket/ssl_socket.h"
 #include "net/socket/stream_socket.h"
+#include "net/ssl/ssl_client_session_cache.h"
 #include "net/ssl/token_binding.h"
 
 namespace base {
 class FilePath;
+class ListValue;
 }
 
 namespace net {
@@ -87,6 +89,21 @@ class NET_EXPORT SSLClientSocket : public SSLSocket {
   // sessions.
   static void ClearSessionCache();
 
+  // Sets the delegate notified when the SSL session cache changes, or clears
+  // it if |delegate| is null. See SSLClientSessionCache::PersistenceDelegate.
+  static void SetSessionCachePersistenceDelegate(
+      SSLClientSessionCache::PersistenceDelegate* delegate);
+  static bool HasSessionCachePersistenceDelegate();
+
+  // Serializes the sessions of |shard| in the SSL session cache to |list|, and
+  // restores them. See SSLClientSessionCache::GetAsListValue() and
+  // SSLClientSessionCache::RestoreFromListValue().
+  static void GetSessionCacheAsListValue(const std::string& shard,
+                                         size_t max_entries,
+                                         base::ListValue* list);
+  static bool RestoreSessionCacheFromListValue(const base::ListValue& list,
+                                               const std::string& shard);
+
  protected:
   void set_signed_cert_timestamps_received(
       bool signed_cert_timestamps_received) {
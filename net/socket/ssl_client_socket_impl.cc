@@ -410,6 +410,40 @@ void SSLClientSocket::ClearSessionCache() {
   context->session_cache()->Flush();
 }
 
+// static
+void SSLClientSocket::SetSessionCachePersistenceDelegate(
+    SSLClientSessionCache::PersistenceDelegate* delegate) {
+  SSLClientSocketImpl::SSLContext::GetInstance()
+      ->session_cache()
+      ->set_persistence_delegate(delegate);
+}
+
+// static
+bool SSLClientSocket::HasSessionCachePersistenceDelegate() {
+  return SSLClientSocketImpl::SSLContext::GetInstance()
+      ->session_cache()
+      ->has_persistence_delegate();
+}
+
+// static
+void SSLClientSocket::GetSessionCacheAsListValue(const std::string& shard,
+                                                 size_t max_entries,
+                                                 base::ListValue* list) {
+  SSLClientSocketImpl::SSLContext::GetInstance()
+      ->session_cache()
+      ->GetAsListValue(shard, max_entries, list);
+}
+
+// static
+bool SSLClientSocket::RestoreSessionCacheFromListValue(
+    const base::ListValue& list,
+    const std::string& shard) {
+  SSLClientSocketImpl::SSLContext* context =
+      SSLClientSocketImpl::SSLContext::GetInstance();
+  return context->session_cache()->RestoreFromListValue(list, shard,
+                                                         context->ssl_ctx());
+}
+
 SSLClientSocketImpl::SSLClientSocketImpl(
     std::unique_ptr<ClientSocketHandle> transport_socket,
     const HostPortPair& host_and_port,
@@ -2798,6 +2798,45 @@ TEST_F(SSLClientSocketTest, SessionResumption) {
   EXPECT_EQ(SSLInfo::HANDSHAKE_FULL, ssl_info.handshake_type);
 }
 
+// Tests that sessions serialized from the session cache resume once restored
+// into an empty cache.
+TEST_F(SSLClientSocketTest, SessionResumptionAfterRestore) {
+  SpawnedTestServer::SSLOptions ssl_options;
+  ASSERT_TRUE(StartTestServer(ssl_options));
+  // The session cache is shared by the whole process.
+  SSLClientSocket::ClearSessionCache();
+
+  SSLConfig ssl_config;
+  // Disable TLS False Start to ensure the session is cached on Connect().
+  ssl_config.false_start_enabled = false;
+  int rv;
+  ASSERT_TRUE(CreateAndConnectSSLClientSocket(ssl_config, &rv));
+  ASSERT_THAT(rv, IsOk());
+  SSLInfo ssl_info;
+  ASSERT_TRUE(sock_->GetSSLInfo(&ssl_info));
+  EXPECT_EQ(SSLInfo::HANDSHAKE_FULL, ssl_info.handshake_type);
+  sock_.reset();
+
+  // Only sessions of the requested shard are serialized.
+  base::ListValue other_shard;
+  SSLClientSocket::GetSessionCacheAsListValue("other", 10, &other_shard);
+  EXPECT_TRUE(other_shard.empty());
+
+  base::ListValue list;
+  SSLClientSocket::GetSessionCacheAsListValue(context_.ssl_session_cache_shard,
+                                              10, &list);
+  EXPECT_EQ(1u, list.GetSize());
+
+  SSLClientSocket::ClearSessionCache();
+  EXPECT_TRUE(SSLClientSocket::RestoreSessionCacheFromListValue(
+      list, context_.ssl_session_cache_shard));
+
+  ASSERT_TRUE(CreateAndConnectSSLClientSocket(ssl_config, &rv));
+  ASSERT_THAT(rv, IsOk());
+  ASSERT_TRUE(sock_->GetSSLInfo(&ssl_info));
+  EXPECT_EQ(SSLInfo::HANDSHAKE_RESUME, ssl_info.handshake_type);
+}
+
 // Tests that ALPN works with session resumption.
 TEST_F(SSLClientSocketTest, SessionResumptionAlpn) {
   SpawnedTestServer::SSLOptions ssl_options;
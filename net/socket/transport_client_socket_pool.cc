@@ -6,9 +6,12 @@
 
 #include <algorithm>
 #include <utility>
+#include <vector>
 
 #include "base/compiler_specific.h"
+#include "base/feature_list.h"
 #include "base/logging.h"
+#include "base/metrics/field_trial_params.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/strings/string_util.h"
 #include "base/synchronization/lock.h"
@@ -22,6 +25,7 @@
 #include "net/log/net_log_event_type.h"
 #include "net/log/net_log_source_type.h"
 #include "net/log/net_log_with_source.h"
+#include "net/nqe/network_quality_provider.h"
 #include "net/socket/client_socket_factory.h"
 #include "net/socket/client_socket_handle.h"
 #include "net/socket/client_socket_pool_base.h"
@@ -36,6 +40,20 @@ namespace net {
 
 namespace {
 
+// Interleaves address families and races them whenever both are present, with
+// a fallback delay based on the transport RTT. See RFC 8305.
+const base::Feature kHappyEyeballsV2{"HappyEyeballsV2",
+                                     base::FEATURE_DISABLED_BY_DEFAULT};
+
+// Bounds of the fallback delay, and the multiple of the transport RTT
+// estimate it is set to. RFC 8305 recommends 100ms and 2s as bounds.
+const base::FeatureParam<int> kHappyEyeballsMinFallbackDelayMs{
+    &kHappyEyeballsV2, "min_fallback_delay_ms", 100};
+const base::FeatureParam<int> kHappyEyeballsMaxFallbackDelayMs{
+    &kHappyEyeballsV2, "max_fallback_delay_ms", 2000};
+const base::FeatureParam<double> kHappyEyeballsRttMultiplier{
+    &kHappyEyeballsV2, "rtt_multiplier", 2.0};
+
 // Returns true iff all addresses in |list| are in the IPv6 family.
 bool AddressListOnlyContainsIPv6(const AddressList& list) {
   DCHECK(!list.empty());
@@ -47,6 +65,17 @@ bool AddressListOnlyContainsIPv6(const AddressList& list) {
   return true;
 }
 
+// Returns true iff all addresses in |list| are in the same family.
+bool AddressListOnlyContainsOneFamily(const AddressList& list) {
+  DCHECK(!list.empty());
+  AddressFamily family = list.front().GetFamily();
+  for (const IPEndPoint& endpoint : list) {
+    if (endpoint.GetFamily() != family)
+      return false;
+  }
+  return true;
+}
+
 }  // namespace
 
 TransportSocketParams::TransportSocketParams(
@@ -86,6 +115,7 @@ TransportConnectJob::TransportConnectJob(
     ClientSocketFactory* client_socket_factory,
     SocketPerformanceWatcherFactory* socket_performance_watcher_factory,
     HostResolver* host_resolver,
+    NetworkQualityProvider* network_quality_provider,
     Delegate* delegate,
     NetLog* net_log)
     : ConnectJob(
@@ -100,6 +130,7 @@ TransportConnectJob::TransportConnectJob(
       params_(params),
       resolver_(host_resolver),
       client_socket_factory_(client_socket_factory),
+      network_quality_provider_(network_quality_provider),
       next_state_(STATE_NONE),
       socket_performance_watcher_factory_(socket_performance_watcher_factory),
       resolve_result_(OK) {}
@@ -149,6 +180,60 @@ void TransportConnectJob::MakeAddressListStartWithIPv4(AddressList* list) {
   }
 }
 
+// static
+void TransportConnectJob::InterleaveAddressFamilies(AddressList* list) {
+  if (list->empty())
+    return;
+
+  AddressFamily first_family = list->front().GetFamily();
+  std::vector<IPEndPoint> first;
+  std::vector<IPEndPoint> other;
+  for (const IPEndPoint& endpoint : *list) {
+    if (endpoint.GetFamily() == first_family)
+      first.push_back(endpoint);
+    else
+      other.push_back(endpoint);
+  }
+
+  list->clear();
+  for (size_t i = 0; i < std::max(first.size(), other.size()); ++i) {
+    if (i < first.size())
+      list->push_back(first[i]);
+    if (i < other.size())
+      list->push_back(other[i]);
+  }
+}
+
+// static
+base::TimeDelta TransportConnectJob::GetFallbackDelay(
+    const NetworkQualityProvider* network_quality_provider) {
+  base::TimeDelta default_delay =
+      base::TimeDelta::FromMilliseconds(kIPv6FallbackTimerInMs);
+  if (!network_quality_provider ||
+      !base::FeatureList::IsEnabled(kHappyEyeballsV2)) {
+    return default_delay;
+  }
+
+  base::Optional<base::TimeDelta> transport_rtt =
+      network_quality_provider->GetTransportRTT();
+  if (!transport_rtt)
+    return default_delay;
+
+  return std::max(
+      base::TimeDelta::FromMilliseconds(kHappyEyeballsMinFallbackDelayMs.Get()),
+      std::min(base::TimeDelta::FromMilliseconds(
+                   kHappyEyeballsMaxFallbackDelayMs.Get()),
+               transport_rtt.value() * kHappyEyeballsRttMultiplier.Get()));
+}
+
+// static
+bool TransportConnectJob::ShouldRaceAddressFamilies(const AddressList& list) {
+  if (base::FeatureList::IsEnabled(kHappyEyeballsV2))
+    return !AddressListOnlyContainsOneFamily(list);
+  return list.front().GetFamily() == ADDRESS_FAMILY_IPV6 &&
+         !AddressListOnlyContainsIPv6(list);
+}
+
 // static
 void TransportConnectJob::HistogramDuration(
     const LoadTimingInfo::ConnectTiming& connect_timing,
@@ -281,6 +366,9 @@ int TransportConnectJob::DoResolveHostComplete(int result) {
 
 int TransportConnectJob::DoTransportConnect() {
   next_state_ = STATE_TRANSPORT_CONNECT_COMPLETE;
+  if (base::FeatureList::IsEnabled(kHappyEyeballsV2))
+    InterleaveAddressFamilies(&addresses_);
+
   // Create a |SocketPerformanceWatcher|, and pass the ownership.
   std::unique_ptr<SocketPerformanceWatcher> socket_performance_watcher;
   if (socket_performance_watcher_factory_) {
@@ -294,15 +382,14 @@ int TransportConnectJob::DoTransportConnect() {
 
   // If the list contains IPv6 and IPv4 addresses, and the first address
   // is IPv6, the IPv4 addresses will be tried as fallback addresses, per
-  // "Happy Eyeballs" (RFC 6555).
-  bool try_ipv6_connect_with_ipv4_fallback =
-      addresses_.front().GetFamily() == ADDRESS_FAMILY_IPV6 &&
-      !AddressListOnlyContainsIPv6(addresses_);
+  // "Happy Eyeballs" (RFC 6555). With HappyEyeballsV2, the other family is
+  // tried as fallback whichever family comes first.
+  bool try_connect_with_fallback = ShouldRaceAddressFamilies(addresses_);
 
   // Enable TCP FastOpen if indicated by transport socket params.
   // Note: We currently do not turn on TCP FastOpen for destinations where
-  // we try a TCP connect over IPv6 with fallback to IPv4.
-  if (!try_ipv6_connect_with_ipv4_fallback &&
+  // we race connects to both address families.
+  if (!try_connect_with_fallback &&
       params_->combine_connect_and_write() ==
           TransportSocketParams::COMBINE_CONNECT_AND_WRITE_DESIRED) {
     transport_socket_->EnableTCPFastOpenIfSupported();
@@ -312,10 +399,10 @@ int TransportConnectJob::DoTransportConnect() {
 
   int rv = transport_socket_->Connect(base::BindOnce(
       &TransportConnectJob::OnIOComplete, base::Unretained(this)));
-  if (rv == ERR_IO_PENDING && try_ipv6_connect_with_ipv4_fallback) {
-    fallback_timer_.Start(
-        FROM_HERE, base::TimeDelta::FromMilliseconds(kIPv6FallbackTimerInMs),
-        this, &TransportConnectJob::DoIPv6FallbackTransportConnect);
+  if (rv == ERR_IO_PENDING && try_connect_with_fallback) {
+    fallback_timer_.Start(FROM_HERE,
+                          GetFallbackDelay(network_quality_provider_), this,
+                          &TransportConnectJob::DoIPv6FallbackTransportConnect);
   }
   return rv;
 }
@@ -334,12 +421,10 @@ int TransportConnectJob::DoTransportConnectComplete(int result) {
 
     bool is_ipv4 = addresses_.front().GetFamily() == ADDRESS_FAMILY_IPV4;
     RaceResult race_result = RACE_UNKNOWN;
-    if (is_ipv4)
-      race_result = RACE_IPV4_SOLO;
-    else if (AddressListOnlyContainsIPv6(addresses_))
-      race_result = RACE_IPV6_SOLO;
+    if (!ShouldRaceAddressFamilies(addresses_))
+      race_result = is_ipv4 ? RACE_IPV4_SOLO : RACE_IPV6_SOLO;
     else
-      race_result = RACE_IPV6_WINS;
+      race_result = is_ipv4 ? RACE_IPV4_WINS : RACE_IPV6_WINS;
     HistogramDuration(connect_timing_, race_result);
 
     SetSocket(std::move(transport_socket_));
@@ -370,7 +455,17 @@ void TransportConnectJob::DoIPv6FallbackTransportConnect() {
   DCHECK(!fallback_addresses_.get());
 
   fallback_addresses_.reset(new AddressList(addresses_));
-  MakeAddressListStartWithIPv4(fallback_addresses_.get());
+  if (addresses_.front().GetFamily() == ADDRESS_FAMILY_IPV6) {
+    MakeAddressListStartWithIPv4(fallback_addresses_.get());
+  } else {
+    // Only reachable with HappyEyeballsV2: fall back to IPv6.
+    AddressList::iterator it = std::find_if(
+        fallback_addresses_->begin(), fallback_addresses_->end(),
+        [](const IPEndPoint& endpoint) {
+          return endpoint.GetFamily() == ADDRESS_FAMILY_IPV6;
+        });
+    std::rotate(fallback_addresses_->begin(), it, fallback_addresses_->end());
+  }
 
   // Create a |SocketPerformanceWatcher|, and pass the ownership.
   std::unique_ptr<SocketPerformanceWatcher> socket_performance_watcher;
@@ -418,7 +513,11 @@ void TransportConnectJob::DoIPv6FallbackTransportConnectComplete(int result) {
     }
 
     connect_timing_.connect_start = fallback_connect_start_time_;
-    HistogramDuration(connect_timing_, RACE_IPV4_WINS);
+    HistogramDuration(connect_timing_,
+                      fallback_addresses_->front().GetFamily() ==
+                              ADDRESS_FAMILY_IPV4
+                          ? RACE_IPV4_WINS
+                          : RACE_IPV6_WINS);
     SetSocket(std::move(fallback_transport_socket_));
     next_state_ = STATE_NONE;
   } else {
@@ -458,7 +557,7 @@ TransportClientSocketPool::TransportConnectJobFactory::NewConnectJob(
       group_name, request.priority(), request.socket_tag(),
       request.respect_limits(), request.params(), ConnectionTimeout(),
       client_socket_factory_, socket_performance_watcher_factory_,
-      host_resolver_, delegate, net_log_));
+      host_resolver_, network_quality_provider_, delegate, net_log_));
 }
 
 base::TimeDelta
@@ -474,6 +573,22 @@ TransportClientSocketPool::TransportClientSocketPool(
     ClientSocketFactory* client_socket_factory,
     SocketPerformanceWatcherFactory* socket_performance_watcher_factory,
     NetLog* net_log)
+    : TransportClientSocketPool(max_sockets,
+                                max_sockets_per_group,
+                                host_resolver,
+                                client_socket_factory,
+                                socket_performance_watcher_factory,
+                                nullptr /* network_quality_provider */,
+                                net_log) {}
+
+TransportClientSocketPool::TransportClientSocketPool(
+    int max_sockets,
+    int max_sockets_per_group,
+    HostResolver* host_resolver,
+    ClientSocketFactory* client_socket_factory,
+    SocketPerformanceWatcherFactory* socket_performance_watcher_factory,
+    NetworkQualityProvider* network_quality_provider,
+    NetLog* net_log)
     : base_(NULL,
             max_sockets,
             max_sockets_per_group,
@@ -482,6 +597,7 @@ TransportClientSocketPool::TransportClientSocketPool(
             new TransportConnectJobFactory(client_socket_factory,
                                            host_resolver,
                                            socket_performance_watcher_factory,
+                                           network_quality_provider,
                                            net_log)),
       client_socket_factory_(client_socket_factory) {
   base_.EnableConnectBackupJobs();
@@ -26,6 +26,7 @@ class ClientSocketFactory;
 class SocketPerformanceWatcherFactory;
 class NetLog;
 class NetLogWithSource;
+class NetworkQualityProvider;
 
 typedef base::Callback<int(const AddressList&, const NetLogWithSource& net_log)>
     OnHostResolutionCallback;
@@ -80,6 +81,11 @@ class NET_EXPORT_PRIVATE TransportSocketParams
 // (kIPv6FallbackTimerInMs) and start a connect() to a IPv4 address if the timer
 // fires. Then we race the IPv4 connect() against the IPv6 connect() (which has
 // a headstart) and return the one that completes first to the socket pool.
+//
+// With the HappyEyeballsV2 feature (RFC 8305), the resolved addresses are
+// interleaved by family, the race happens whenever both families are present
+// regardless of which one is preferred, and the fallback delay is derived from
+// the transport RTT estimate of the NetworkQualityProvider, if there is one.
 class NET_EXPORT_PRIVATE TransportConnectJob : public ConnectJob {
  public:
   // For recording the connection time in the appropriate bucket.
@@ -110,6 +116,7 @@ class NET_EXPORT_PRIVATE TransportConnectJob : public ConnectJob {
       ClientSocketFactory* client_socket_factory,
       SocketPerformanceWatcherFactory* socket_performance_watcher_factory,
       HostResolver* host_resolver,
+      NetworkQualityProvider* network_quality_provider,
       Delegate* delegate,
       NetLog* net_log);
   ~TransportConnectJob() override;
@@ -122,6 +129,19 @@ class NET_EXPORT_PRIVATE TransportConnectJob : public ConnectJob {
   // WARNING: this method should only be used to implement the prefer-IPv4 hack.
   static void MakeAddressListStartWithIPv4(AddressList* addrlist);
 
+  // Reorders |addrlist| so that address families alternate, starting with the
+  // family of the first address, while keeping the relative order of the
+  // addresses of each family. Follows section 4 of RFC 8305.
+  static void InterleaveAddressFamilies(AddressList* addrlist);
+
+  // Returns the delay before the connection attempt to the other address
+  // family is started. Without the HappyEyeballsV2 feature or without a
+  // transport RTT estimate, this is kIPv6FallbackTimerInMs. Otherwise it is a
+  // multiple of the estimate, clamped to the range recommended by RFC 8305.
+  // |network_quality_provider| may be null.
+  static base::TimeDelta GetFallbackDelay(
+      const NetworkQualityProvider* network_quality_provider);
+
   // Record the histograms Net.DNS_Resolution_And_TCP_Connection_Latency2 and
   // Net.TCP_Connection_Latency and return the connect duration.
   static void HistogramDuration(
@@ -149,6 +169,10 @@ class NET_EXPORT_PRIVATE TransportConnectJob : public ConnectJob {
   void DoIPv6FallbackTransportConnect();
   void DoIPv6FallbackTransportConnectComplete(int result);
 
+  // Returns true if a connection attempt to the other address family should
+  // be raced against the one to the family of the first address in |list|.
+  static bool ShouldRaceAddressFamilies(const AddressList& list);
+
   // Begins the host resolution and the TCP connect.  Returns OK on success
   // and ERR_IO_PENDING if it cannot immediately service the request.
   // Otherwise, it returns a net error code.
@@ -160,6 +184,7 @@ class NET_EXPORT_PRIVATE TransportConnectJob : public ConnectJob {
   HostResolver* resolver_;
   std::unique_ptr<HostResolver::Request> request_;
   ClientSocketFactory* const client_socket_factory_;
+  NetworkQualityProvider* const network_quality_provider_;
 
   State next_state_;
 
@@ -197,6 +222,17 @@ class NET_EXPORT_PRIVATE TransportClientSocketPool : public ClientSocketPool {
       SocketPerformanceWatcherFactory* socket_performance_watcher_factory,
       NetLog* net_log);
 
+  // |network_quality_provider| is used to pick the delay before falling back
+  // to the other address family, and may be null.
+  TransportClientSocketPool(
+      int max_sockets,
+      int max_sockets_per_group,
+      HostResolver* host_resolver,
+      ClientSocketFactory* client_socket_factory,
+      SocketPerformanceWatcherFactory* socket_performance_watcher_factory,
+      NetworkQualityProvider* network_quality_provider,
+      NetLog* net_log);
+
   ~TransportClientSocketPool() override;
 
   // ClientSocketPool implementation.
@@ -259,11 +295,13 @@ class NET_EXPORT_PRIVATE TransportClientSocketPool : public ClientSocketPool {
         ClientSocketFactory* client_socket_factory,
         HostResolver* host_resolver,
         SocketPerformanceWatcherFactory* socket_performance_watcher_factory,
+        NetworkQualityProvider* network_quality_provider,
         NetLog* net_log)
         : client_socket_factory_(client_socket_factory),
           socket_performance_watcher_factory_(
               socket_performance_watcher_factory),
           host_resolver_(host_resolver),
+          network_quality_provider_(network_quality_provider),
           net_log_(net_log) {}
 
     ~TransportConnectJobFactory() override {}
@@ -281,6 +319,7 @@ class NET_EXPORT_PRIVATE TransportClientSocketPool : public ClientSocketPool {
     ClientSocketFactory* const client_socket_factory_;
     SocketPerformanceWatcherFactory* socket_performance_watcher_factory_;
     HostResolver* const host_resolver_;
+    NetworkQualityProvider* const network_quality_provider_;
     NetLog* net_log_;
 
     DISALLOW_COPY_AND_ASSIGN(TransportConnectJobFactory);
@@ -9,6 +9,7 @@
 #include "base/callback.h"
 #include "base/macros.h"
 #include "base/run_loop.h"
+#include "base/test/scoped_feature_list.h"
 #include "base/threading/platform_thread.h"
 #include "build/build_config.h"
 #include "net/base/ip_address.h"
@@ -20,6 +21,7 @@
 #include "net/dns/mock_host_resolver.h"
 #include "net/log/net_log_with_source.h"
 #include "net/log/test_net_log.h"
+#include "net/nqe/network_quality_provider.h"
 #include "net/socket/client_socket_handle.h"
 #include "net/socket/socket_tag.h"
 #include "net/socket/socket_test_util.h"
@@ -182,6 +184,102 @@ TEST(TransportConnectJobTest, MakeAddrListStartWithIPv4) {
   EXPECT_EQ(ADDRESS_FAMILY_IPV6, addrlist[3].GetFamily());
 }
 
+TEST(TransportConnectJobTest, InterleaveAddressFamilies) {
+  IPEndPoint addrlist_v4_1(IPAddress(192, 168, 1, 1), 80);
+  IPEndPoint addrlist_v4_2(IPAddress(192, 168, 1, 2), 80);
+  IPEndPoint addrlist_v4_3(IPAddress(192, 168, 1, 3), 80);
+  IPAddress ip_address;
+  ASSERT_TRUE(ip_address.AssignFromIPLiteral("2001:4860:b006::64"));
+  IPEndPoint addrlist_v6_1(ip_address, 80);
+  ASSERT_TRUE(ip_address.AssignFromIPLiteral("2001:4860:b006::66"));
+  IPEndPoint addrlist_v6_2(ip_address, 80);
+
+  AddressList addrlist;
+
+  // Test 1: IPv4 only.  Expect no change.
+  addrlist.push_back(addrlist_v4_1);
+  addrlist.push_back(addrlist_v4_2);
+  TransportConnectJob::InterleaveAddressFamilies(&addrlist);
+  ASSERT_EQ(2u, addrlist.size());
+  EXPECT_EQ(addrlist_v4_1, addrlist[0]);
+  EXPECT_EQ(addrlist_v4_2, addrlist[1]);
+
+  // Test 2: IPv6, IPv6, IPv4, IPv4, IPv4.  Expect the families to alternate,
+  // starting with IPv6, and the leftover IPv4 address to come last.
+  addrlist.clear();
+  addrlist.push_back(addrlist_v6_1);
+  addrlist.push_back(addrlist_v6_2);
+  addrlist.push_back(addrlist_v4_1);
+  addrlist.push_back(addrlist_v4_2);
+  addrlist.push_back(addrlist_v4_3);
+  TransportConnectJob::InterleaveAddressFamilies(&addrlist);
+  ASSERT_EQ(5u, addrlist.size());
+  EXPECT_EQ(addrlist_v6_1, addrlist[0]);
+  EXPECT_EQ(addrlist_v4_1, addrlist[1]);
+  EXPECT_EQ(addrlist_v6_2, addrlist[2]);
+  EXPECT_EQ(addrlist_v4_2, addrlist[3]);
+  EXPECT_EQ(addrlist_v4_3, addrlist[4]);
+
+  // Test 3: IPv4, IPv4, IPv6.  Expect the families to alternate, starting
+  // with IPv4.
+  addrlist.clear();
+  addrlist.push_back(addrlist_v4_1);
+  addrlist.push_back(addrlist_v4_2);
+  addrlist.push_back(addrlist_v6_1);
+  TransportConnectJob::InterleaveAddressFamilies(&addrlist);
+  ASSERT_EQ(3u, addrlist.size());
+  EXPECT_EQ(addrlist_v4_1, addrlist[0]);
+  EXPECT_EQ(addrlist_v6_1, addrlist[1]);
+  EXPECT_EQ(addrlist_v4_2, addrlist[2]);
+}
+
+class FakeNetworkQualityProvider : public NetworkQualityProvider {
+ public:
+  base::Optional<base::TimeDelta> GetTransportRTT() const override {
+    return transport_rtt_;
+  }
+
+  void set_transport_rtt(base::Optional<base::TimeDelta> transport_rtt) {
+    transport_rtt_ = transport_rtt;
+  }
+
+ private:
+  base::Optional<base::TimeDelta> transport_rtt_;
+};
+
+TEST(TransportConnectJobTest, FallbackDelay) {
+  const base::TimeDelta kDefaultDelay = base::TimeDelta::FromMilliseconds(
+      TransportConnectJob::kIPv6FallbackTimerInMs);
+  FakeNetworkQualityProvider network_quality_provider;
+  network_quality_provider.set_transport_rtt(
+      base::TimeDelta::FromMilliseconds(70));
+
+  // Without HappyEyeballsV2, the delay is fixed.
+  EXPECT_EQ(kDefaultDelay,
+            TransportConnectJob::GetFallbackDelay(&network_quality_provider));
+
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitFromCommandLine("HappyEyeballsV2", std::string());
+
+  EXPECT_EQ(kDefaultDelay, TransportConnectJob::GetFallbackDelay(nullptr));
+  EXPECT_EQ(base::TimeDelta::FromMilliseconds(140),
+            TransportConnectJob::GetFallbackDelay(&network_quality_provider));
+
+  // The delay is clamped.
+  network_quality_provider.set_transport_rtt(
+      base::TimeDelta::FromMilliseconds(10));
+  EXPECT_EQ(base::TimeDelta::FromMilliseconds(100),
+            TransportConnectJob::GetFallbackDelay(&network_quality_provider));
+  network_quality_provider.set_transport_rtt(base::TimeDelta::FromSeconds(5));
+  EXPECT_EQ(base::TimeDelta::FromSeconds(2),
+            TransportConnectJob::GetFallbackDelay(&network_quality_provider));
+
+  // No estimate.
+  network_quality_provider.set_transport_rtt(base::nullopt);
+  EXPECT_EQ(kDefaultDelay,
+            TransportConnectJob::GetFallbackDelay(&network_quality_provider));
+}
+
 TEST_F(TransportClientSocketPoolTest, Basic) {
   TestCompletionCallback callback;
   ClientSocketHandle handle;
@@ -957,6 +1055,52 @@ TEST_F(TransportClientSocketPoolTest, IPv6FallbackSocketIPv6FinishesFirst) {
   EXPECT_EQ(2, client_socket_factory_.allocation_count());
 }
 
+// With HappyEyeballsV2, a stalled IPv4 connect falls back to IPv6.
+TEST_F(TransportClientSocketPoolTest, HappyEyeballsV2IPv4FallsBackToIPv6) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitFromCommandLine("HappyEyeballsV2", std::string());
+
+  // Create a pool without backup jobs.
+  ClientSocketPoolBaseHelper::set_connect_backup_jobs_enabled(false);
+  TransportClientSocketPool pool(kMaxSockets, kMaxSocketsPerGroup,
+                                 host_resolver_.get(), &client_socket_factory_,
+                                 NULL, NULL);
+
+  MockTransportClientSocketFactory::ClientSocketType case_types[] = {
+      // This is the IPv4 socket. It stalls, but presents one failed connection
+      // attempt on GetConnectionAttempts.
+      MockTransportClientSocketFactory::MOCK_STALLED_FAILING_CLIENT_SOCKET,
+      // This is the IPv6 socket.
+      MockTransportClientSocketFactory::MOCK_PENDING_CLIENT_SOCKET};
+
+  client_socket_factory_.set_client_socket_types(case_types, 2);
+
+  // Resolve an AddressList with a IPv4 address first and then a IPv6 address.
+  host_resolver_->rules()
+      ->AddIPLiteralRule("*", "2.2.2.2,2:abcd::3:4:ff", std::string());
+
+  TestCompletionCallback callback;
+  ClientSocketHandle handle;
+  int rv = handle.Init("a", params_, LOW, SocketTag(),
+                       ClientSocketPool::RespectLimits::ENABLED,
+                       callback.callback(), &pool, NetLogWithSource());
+  EXPECT_THAT(rv, IsError(ERR_IO_PENDING));
+
+  EXPECT_THAT(callback.WaitForResult(), IsOk());
+  EXPECT_TRUE(handle.is_initialized());
+  IPEndPoint endpoint;
+  handle.socket()->GetLocalAddress(&endpoint);
+  EXPECT_TRUE(endpoint.address().IsIPv6());
+
+  // Check that the failed connection attempt on the main socket is collected.
+  ConnectionAttempts attempts;
+  handle.socket()->GetConnectionAttempts(&attempts);
+  ASSERT_EQ(1u, attempts.size());
+  EXPECT_TRUE(attempts[0].endpoint.address().IsIPv4());
+
+  EXPECT_EQ(2, client_socket_factory_.allocation_count());
+}
+
 TEST_F(TransportClientSocketPoolTest, IPv6NoIPv4AddressesToFallbackTo) {
   // Create a pool without backup jobs.
   ClientSocketPoolBaseHelper::set_connect_backup_jobs_enabled(false);
@@ -185,4 +185,10 @@ void UDPClientSocket::EnableRecvOptimization() {
 #endif
 }
 
+void UDPClientSocket::SetRecvmmsgEnabled(bool enabled) {
+#if defined(OS_POSIX)
+  socket_.SetRecvmmsgEnabled(enabled);
+#endif
+}
+
 }  // namespace net
@@ -65,6 +65,7 @@ class NET_EXPORT_PRIVATE UDPClientSocket : public DatagramClientSocket {
   void SetMsgConfirm(bool confirm) override;
   const NetLogWithSource& NetLog() const override;
   void EnableRecvOptimization() override;
+  void SetRecvmmsgEnabled(bool enabled) override;
 
   void SetWriteAsyncEnabled(bool enabled) override;
   bool WriteAsyncEnabled() override;
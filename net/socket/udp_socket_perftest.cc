@@ -48,6 +48,10 @@ class UDPSocketPerfTest : public PlatformTest {
   // has effect on Windows.
   void WriteBenchmark(bool use_nonblocking_io);
 
+  // Reads packets sent in bursts over loopback. Uses recvmmsg() if
+  // |use_recvmmsg| is true, on platforms that support it.
+  void ReadBenchmark(bool use_recvmmsg);
+
  protected:
   static const int kPacketSize = 1024;
   scoped_refptr<IOBufferWithSize> buffer_;
@@ -122,6 +126,62 @@ void UDPSocketPerfTest::WriteBenchmark(bool use_nonblocking_io) {
   LOG(INFO) << "Write speed: " << packets / 1024 / elapsed << " MB/s";
 }
 
+void UDPSocketPerfTest::ReadBenchmark(bool use_recvmmsg) {
+  base::MessageLoopForIO message_loop;
+
+  // Setup the receiver on an ephemeral port.
+  IPEndPoint bind_address;
+  CreateUDPAddress("127.0.0.1", 0, &bind_address);
+  UDPSocket receiver(DatagramSocket::DEFAULT_BIND, nullptr, NetLogSource());
+  ASSERT_THAT(receiver.Open(bind_address.GetFamily()), IsOk());
+#if defined(OS_POSIX)
+  receiver.SetRecvmmsgEnabled(use_recvmmsg);
+#endif
+  ASSERT_THAT(receiver.SetReceiveBufferSize(1024 * 1024), IsOk());
+  ASSERT_THAT(receiver.Bind(bind_address), IsOk());
+  IPEndPoint receiver_address;
+  ASSERT_THAT(receiver.GetLocalAddress(&receiver_address), IsOk());
+
+  // Setup the sender.
+  std::unique_ptr<UDPClientSocket> sender(new UDPClientSocket(
+      DatagramSocket::DEFAULT_BIND, nullptr, NetLogSource()));
+  ASSERT_THAT(sender->Connect(receiver_address), IsOk());
+
+  // Packets are sent in bursts small enough to fit in the receive buffer, so
+  // that none are dropped.
+  const int kBurstSize = 64;
+  const int kBursts = 2000;
+  scoped_refptr<IOBufferWithSize> write_buffer(
+      new IOBufferWithSize(kPacketSize));
+  memset(write_buffer->data(), 'G', kPacketSize);
+  scoped_refptr<IOBufferWithSize> read_buffer(
+      new IOBufferWithSize(kPacketSize + 1));
+
+  base::TimeDelta read_time;
+  for (int burst = 0; burst < kBursts; ++burst) {
+    for (int i = 0; i < kBurstSize; ++i) {
+      TestCompletionCallback write_callback;
+      int rv = sender->Write(write_buffer.get(), write_buffer->size(),
+                             write_callback.callback(),
+                             TRAFFIC_ANNOTATION_FOR_TESTS);
+      ASSERT_EQ(kPacketSize, write_callback.GetResult(rv));
+    }
+
+    base::TimeTicks start_ticks = base::TimeTicks::Now();
+    for (int i = 0; i < kBurstSize; ++i) {
+      TestCompletionCallback read_callback;
+      int rv = receiver.Read(read_buffer.get(), read_buffer->size(),
+                             read_callback.callback());
+      ASSERT_EQ(kPacketSize, read_callback.GetResult(rv));
+    }
+    read_time += base::TimeTicks::Now() - start_ticks;
+  }
+
+  int packets = kBursts * kBurstSize;
+  LOG(INFO) << "Read speed: " << packets / 1024 / read_time.InSecondsF()
+            << " MB/s";
+}
+
 TEST_F(UDPSocketPerfTest, Write) {
   base::PerfTimeLogger timer("UDP_socket_write");
   WriteBenchmark(false);
@@ -132,6 +192,16 @@ TEST_F(UDPSocketPerfTest, WriteNonBlocking) {
   WriteBenchmark(true);
 }
 
+TEST_F(UDPSocketPerfTest, Read) {
+  base::PerfTimeLogger timer("UDP_socket_read");
+  ReadBenchmark(false);
+}
+
+TEST_F(UDPSocketPerfTest, ReadRecvmmsg) {
+  base::PerfTimeLogger timer("UDP_socket_read_recvmmsg");
+  ReadBenchmark(true);
+}
+
 }  // namespace
 
 }  // namespace net
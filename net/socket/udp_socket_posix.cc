@@ -11,6 +11,8 @@
 #include <netinet/in.h>
 #include <sys/ioctl.h>
 
+#include <vector>
+
 #include "base/callback.h"
 #include "base/callback_helpers.h"
 #include "base/containers/stack_container.h"
@@ -19,6 +21,7 @@
 #include "base/logging.h"
 #include "base/message_loop/message_loop_current.h"
 #include "base/metrics/histogram_functions.h"
+#include "base/metrics/histogram_macros.h"
 #include "base/posix/eintr_wrapper.h"
 #include "base/rand_util.h"
 #include "base/task_runner_util.h"
@@ -193,6 +196,83 @@ const guardid_t kSocketFdGuard = 0xD712BC0BC9A4EAD4;
 
 }  // namespace
 
+#if HAVE_RECVMMSG
+// Buffers for up to kRecvmmsgMaxDatagrams datagrams, filled by one recvmmsg()
+// call and handed out one at a time.
+class UDPSocketPosix::RecvBatch {
+ public:
+  // One extra byte per datagram is allocated so that datagrams longer than
+  // |max_datagram_size| can be detected.
+  explicit RecvBatch(int max_datagram_size)
+      : datagram_size_(max_datagram_size + 1),
+        data_(datagram_size * kRecvmmsgMaxDatagrams),
+        count_(0),
+        next_(0) {}
+
+  bool empty() const { return next_ == count_; }
+
+  // Reads as many datagrams as are available from |fd|. Returns OK if at
+  // least one was read, or a net error code.
+  int Fill(int fd) {
+    DCHECK(empty());
+    for (int i = 0; i < kRecvmmsgMaxDatagrams; ++i) {
+      iov_[i].iov_base = &data_[i * datagram_size_];
+      iov_[i].iov_len = datagram_size_;
+      addresses_[i].addr_len = sizeof(addresses_[i].addr_storage);
+      std::memset(&msgs_[i], 0, sizeof(msgs_[i]));
+      msgs_[i].msg_hdr.msg_iov = &iov_[i];
+      msgs_[i].msg_hdr.msg_iovlen = 1;
+      msgs_[i].msg_hdr.msg_name = addresses_[i].addr;
+      msgs_[i].msg_hdr.msg_namelen = addresses_[i].addr_len;
+    }
+    int rv = HANDLE_EINTR(
+        recvmmsg(fd, msgs_, kRecvmmsgMaxDatagrams, 0, nullptr /* timeout */));
+    if (rv < 0)
+      return MapSystemError(errno);
+    DCHECK_GT(rv, 0);
+    count_ = rv;
+    next_ = 0;
+    UMA_HISTOGRAM_EXACT_LINEAR("Net.UDPSocket.RecvmmsgDatagrams", rv,
+                               kRecvmmsgMaxDatagrams + 1);
+    return OK;
+  }
+
+  // Copies the next datagram into |buf| and its source address into
+  // |address|. Returns the size of the datagram, or ERR_MSG_TOO_BIG if it
+  // doesn't fit in |buf_len| bytes or was truncated by the kernel.
+  int Pop(IOBuffer* buf, int buf_len, SockaddrStorage* address) {
+    DCHECK(!empty());
+    const struct mmsghdr& msg = msgs_[next_];
+    const char* data = &data_[next_ * datagram_size_];
+    *address = addresses_[next_];
+    address->addr_len = msg.msg_hdr.msg_namelen;
+    ++next_;
+
+    int length = static_cast<int>(msg.msg_len);
+    if ((msg.msg_hdr.msg_flags & MSG_TRUNC) || length > buf_len) {
+      return ERR_MSG_TOO_BIG;
+    }
+    memcpy(buf->data(), data, length);
+    return length;
+  }
+
+ private:
+  const int datagram_size_;
+  std::vector<char> data_;
+  struct iovec iov_[kRecvmmsgMaxDatagrams];
+  struct mmsghdr msgs_[kRecvmmsgMaxDatagrams];
+  SockaddrStorage addresses_[kRecvmmsgMaxDatagrams];
+  // Number of datagrams read by the last Fill(), and index of the next one to
+  // be returned by Pop().
+  int count_;
+  int next_;
+
+  DISALLOW_COPY_AND_ASSIGN(RecvBatch);
+};
+#else
+class UDPSocketPosix::RecvBatch {};
+#endif  // HAVE_RECVMMSG
+
 UDPSocketPosix::UDPSocketPosix(DatagramSocket::BindType bind_type,
                                net::NetLog* net_log,
                                const net::NetLogSource& source)
@@ -219,6 +299,7 @@ UDPSocketPosix::UDPSocketPosix(DatagramSocket::BindType bind_type,
       net_log_(NetLogWithSource::Make(net_log, NetLogSourceType::UDP_SOCKET)),
       bound_network_(NetworkChangeNotifier::kInvalidNetworkHandle),
       experimental_recv_optimization_enabled_(false),
+      recvmmsg_enabled_(false),
       weak_factory_(this) {
   net_log_.BeginEvent(NetLogEventType::SOCKET_ALIVE,
                       source.ToEventParametersCallback());
@@ -322,6 +403,7 @@ void UDPSocketPosix::Close() {
   write_buf_len_ = 0;
   write_callback_.Reset();
   send_to_address_.reset();
+  recv_batch_.reset();
 
   bool ok = read_socket_watcher_.StopWatchingFileDescriptor();
   DCHECK(ok);
@@ -387,6 +469,14 @@ int UDPSocketPosix::GetLocalAddress(IPEndPoint* address) const {
   return OK;
 }
 
+void UDPSocketPosix::SetRecvmmsgEnabled(bool enabled) {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  DCHECK(read_callback_.is_null());
+#if HAVE_RECVMMSG
+  recvmmsg_enabled_ = enabled;
+#endif
+}
+
 int UDPSocketPosix::Read(IOBuffer* buf,
                          int buf_len,
                          CompletionOnceCallback callback) {
@@ -793,6 +883,10 @@ void UDPSocketPosix::LogWrite(int result,
 int UDPSocketPosix::InternalRecvFrom(IOBuffer* buf,
                                      int buf_len,
                                      IPEndPoint* address) {
+#if HAVE_RECVMMSG
+  if (recvmmsg_enabled_)
+    return InternalRecvFromBatch(buf, buf_len, address);
+#endif
   // If the socket is connected and the remote address is known
   // use the more efficient method that uses read() instead of recvmsg().
   if (experimental_recv_optimization_enabled_ && is_connected_ &&
@@ -867,6 +961,42 @@ int UDPSocketPosix::InternalRecvFromNonConnectedSocket(IOBuffer* buf,
   return result;
 }
 
+int UDPSocketPosix::InternalRecvFromBatch(IOBuffer* buf,
+                                          int buf_len,
+                                          IPEndPoint* address) {
+#if HAVE_RECVMMSG
+  if (!recv_batch_)
+    recv_batch_ = std::make_unique<RecvBatch>(buf_len);
+
+  if (recv_batch_->empty()) {
+    int rv = recv_batch_->Fill(socket_);
+    if (rv == ERR_NOT_IMPLEMENTED) {
+      DLOG(WARNING) << "recvmmsg() not implemented, falling back to recvmsg()";
+      recvmmsg_enabled_ = false;
+      recv_batch_.reset();
+      return InternalRecvFromNonConnectedSocket(buf, buf_len, address);
+    }
+    if (rv != OK) {
+      if (rv != ERR_IO_PENDING)
+        LogRead(rv, nullptr, 0, nullptr);
+      return rv;
+    }
+  }
+
+  SockaddrStorage storage;
+  int result = recv_batch_->Pop(buf, buf_len, &storage);
+  if (result >= 0 && address &&
+      !address->FromSockAddr(storage.addr, storage.addr_len)) {
+    result = ERR_ADDRESS_INVALID;
+  }
+  LogRead(result, buf->data(), storage.addr_len, storage.addr);
+  return result;
+#else
+  NOTREACHED();
+  return ERR_NOT_IMPLEMENTED;
+#endif
+}
+
 int UDPSocketPosix::InternalSendTo(IOBuffer* buf,
                                    int buf_len,
                                    const IPEndPoint* address) {
@@ -39,6 +39,14 @@
 #define HAVE_SENDMMSG 0
 #endif
 
+#if defined(__ANDROID__) && defined(__aarch64__)
+#define HAVE_RECVMMSG 1
+#elif defined(OS_LINUX)
+#define HAVE_RECVMMSG 1
+#else
+#define HAVE_RECVMMSG 0
+#endif
+
 namespace net {
 
 class IPAddress;
@@ -75,6 +83,10 @@ const int kWriteAsyncPostBuffersThreshold = kWriteAsyncMaxBuffersThreshold / 2;
 // Don't unblock writer unless pending async writes are less than this.
 const int kWriteAsyncCallbackBuffersThreshold = kWriteAsyncMaxBuffersThreshold;
 
+// Maximum number of datagrams read by a single recvmmsg() call, see
+// UDPSocketPosix::SetRecvmmsgEnabled().
+const int kRecvmmsgMaxDatagrams = 16;
+
 // To allow mock |Send|/|Sendmsg| in testing.  This has to be
 // reference counted thread safe because |SendBuffers| and
 // |SendmmsgBuffers| may be invoked in another thread via PostTask*.
@@ -371,6 +383,14 @@ class NET_EXPORT UDPSocketPosix {
     experimental_recv_optimization_enabled_ = true;
   };
 
+  // Enables reading up to kRecvmmsgMaxDatagrams datagrams with a single
+  // recvmmsg() call, on platforms that support it. Datagrams that were read
+  // ahead are returned by subsequent Read() and RecvFrom() calls without
+  // further system calls. Datagrams are read ahead into buffers the size of
+  // the first read, so all reads should use the same buffer size. Should be
+  // called before the socket is used to read data for the first time.
+  void SetRecvmmsgEnabled(bool enabled);
+
  protected:
   // WriteAsync batching etc. are to improve throughput of large high
   // bandwidth uploads.
@@ -424,6 +444,8 @@ class NET_EXPORT UDPSocketPosix {
     SOCKET_OPTION_MULTICAST_LOOP = 1 << 0
   };
 
+  class RecvBatch;
+
   class ReadWatcher : public base::MessagePumpForIO::FdWatcher {
    public:
     explicit ReadWatcher(UDPSocketPosix* socket) : socket_(socket) {}
@@ -506,6 +528,10 @@ class NET_EXPORT UDPSocketPosix {
   int InternalRecvFromNonConnectedSocket(IOBuffer* buf,
                                          int buf_len,
                                          IPEndPoint* address);
+
+  // An implementation of the InternalRecvFrom() method that returns datagrams
+  // from |recv_batch_|, refilling it with recvmmsg() when it is empty.
+  int InternalRecvFromBatch(IOBuffer* buf, int buf_len, IPEndPoint* address);
   int InternalSendTo(IOBuffer* buf, int buf_len, const IPEndPoint* address);
 
   // Applies |socket_options_| to |socket_|. Should be called before
@@ -609,6 +635,12 @@ class NET_EXPORT UDPSocketPosix {
   // enable_experimental_recv_optimization() method.
   bool experimental_recv_optimization_enabled_;
 
+  // Set by SetRecvmmsgEnabled(). Cleared if recvmmsg() turns out not to be
+  // implemented.
+  bool recvmmsg_enabled_;
+  // Datagrams read ahead by recvmmsg(). Created on the first read.
+  std::unique_ptr<RecvBatch> recv_batch_;
+
   THREAD_CHECKER(thread_checker_);
 
   // Used for alternate writes that are posted for concurrent execution.
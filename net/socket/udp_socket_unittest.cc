@@ -988,6 +988,63 @@ TEST_F(UDPSocketTest, ReadWithSocketOptimizationTruncation) {
   client.Close();
 }
 
+// Tests that datagrams read ahead with recvmmsg() are returned one per read,
+// in order, and that truncation is detected per datagram. On platforms without
+// recvmmsg(), the reads go through the regular path with the same results.
+TEST_F(UDPSocketTest, ReadWithRecvmmsg) {
+  const uint16_t kPort = 10000;
+  std::string too_long_message(kMaxRead + 1, 'A');
+  std::string right_length_message(kMaxRead - 1, 'B');
+  std::string exact_length_message(kMaxRead, 'C');
+
+  // Setup the server to listen.
+  IPEndPoint server_address(IPAddress::IPv4Localhost(), kPort);
+  UDPServerSocket server(NULL, NetLogSource());
+  server.AllowAddressReuse();
+  int rv = server.Listen(server_address);
+  ASSERT_THAT(rv, IsOk());
+
+  // Setup the client, enable recvmmsg() and connect to the server.
+  UDPClientSocket client(DatagramSocket::DEFAULT_BIND, nullptr, NetLogSource());
+  client.SetRecvmmsgEnabled(true);
+  rv = client.Connect(server_address);
+  EXPECT_THAT(rv, IsOk());
+
+  IPEndPoint client_address;
+  rv = client.GetLocalAddress(&client_address);
+  EXPECT_THAT(rv, IsOk());
+
+  // Send all messages before the first read, so that they can be read in one
+  // batch.
+  rv = SendToSocket(&server, too_long_message, client_address);
+  EXPECT_EQ(too_long_message.length(), static_cast<size_t>(rv));
+  rv = SendToSocket(&server, right_length_message, client_address);
+  EXPECT_EQ(right_length_message.length(), static_cast<size_t>(rv));
+  rv = SendToSocket(&server, exact_length_message, client_address);
+  EXPECT_EQ(exact_length_message.length(), static_cast<size_t>(rv));
+
+  TestCompletionCallback callback;
+  rv = client.Read(buffer_.get(), kMaxRead, callback.callback());
+  EXPECT_EQ(ERR_MSG_TOO_BIG, callback.GetResult(rv));
+
+  rv = client.Read(buffer_.get(), kMaxRead, callback.callback());
+  rv = callback.GetResult(rv);
+  EXPECT_EQ(static_cast<int>(right_length_message.length()), rv);
+  EXPECT_EQ(right_length_message, std::string(buffer_->data(), rv));
+
+  rv = client.Read(buffer_.get(), kMaxRead, callback.callback());
+  rv = callback.GetResult(rv);
+  EXPECT_EQ(static_cast<int>(exact_length_message.length()), rv);
+  EXPECT_EQ(exact_length_message, std::string(buffer_->data(), rv));
+
+  // Nothing is left to read.
+  rv = client.Read(buffer_.get(), kMaxRead, callback.callback());
+  EXPECT_THAT(rv, IsError(ERR_IO_PENDING));
+
+  server.Close();
+  client.Close();
+}
+
 // On Android, where socket tagging is supported, verify that UDPSocket::Tag
 // works as expected.
 #if defined(OS_ANDROID)
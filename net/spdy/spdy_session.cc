@@ -85,6 +85,15 @@ constexpr net::NetworkTrafficAnnotationTag
         }
     )");
 
+// Gathers several small frames into a single socket write, and thus a single
+// TLS record, instead of writing each frame on its own.
+const base::Feature kSpdyCoalesceWrites{"SpdyCoalesceWrites",
+                                        base::FEATURE_DISABLED_BY_DEFAULT};
+
+// Frames are coalesced until a write reaches this size, the maximum TLS record
+// payload.
+const size_t kMaxCoalescedWriteSize = 16 * 1024;
+
 const int kReadBufferSize = 8 * 1024;
 const int kDefaultConnectionAtRiskOfLossSeconds = 10;
 const int kHungIntervalSeconds = 10;
@@ -786,6 +795,7 @@ SpdySession::SpdySession(
       bytes_pushed_and_unclaimed_count_(0u),
       in_flight_write_frame_type_(spdy::SpdyFrameType::DATA),
       in_flight_write_frame_size_(0),
+      coalesce_writes_(base::FeatureList::IsEnabled(kSpdyCoalesceWrites)),
       availability_state_(STATE_AVAILABLE),
       read_state_(READ_STATE_DO_READ),
       write_state_(WRITE_STATE_IDLE),
@@ -1013,6 +1023,12 @@ std::unique_ptr<spdy::SpdySerializedFrame> SpdySession::CreateHeaders(
                    source_dependency));
   }
 
+  // Size of the header list as defined for SETTINGS_MAX_HEADER_LIST_SIZE, to
+  // measure how much HPACK saves on request headers.
+  size_t uncompressed_size = 0;
+  for (const auto& header : block)
+    uncompressed_size += header.first.size() + header.second.size() + 32;
+
   spdy::SpdyHeadersIR headers(stream_id, std::move(block));
   headers.set_has_priority(has_priority);
   headers.set_weight(weight);
@@ -1022,8 +1038,14 @@ std::unique_ptr<spdy::SpdySerializedFrame> SpdySession::CreateHeaders(
 
   streams_initiated_count_++;
 
-  return std::make_unique<spdy::SpdySerializedFrame>(
+  auto frame = std::make_unique<spdy::SpdySerializedFrame>(
       buffered_spdy_framer_->SerializeFrame(headers));
+  if (uncompressed_size > 0) {
+    UMA_HISTOGRAM_PERCENTAGE(
+        "Net.SpdySession.HeadersCompressionPercentage",
+        std::min<size_t>(100, 100 * frame->size() / uncompressed_size));
+  }
+  return frame;
 }
 
 std::unique_ptr<SpdyBuffer> SpdySession::CreateDataBuffer(
@@ -2145,44 +2167,27 @@ int SpdySession::DoWrite() {
   } else {
     // Grab the next frame to send.
     spdy::SpdyFrameType frame_type = spdy::SpdyFrameType::DATA;
-    std::unique_ptr<SpdyBufferProducer> producer;
+    std::unique_ptr<SpdyBuffer> buffer;
     base::WeakPtr<SpdyStream> stream;
-    if (!write_queue_.Dequeue(&frame_type, &producer, &stream,
-                              &in_flight_write_traffic_annotation)) {
+    int rv = DequeueWrite(&frame_type, &buffer, &stream,
+                          &in_flight_write_traffic_annotation);
+    if (rv == ERR_IO_PENDING) {
       write_state_ = WRITE_STATE_IDLE;
       return ERR_IO_PENDING;
     }
+    if (rv != OK)
+      return rv;
 
-    if (stream.get())
-      CHECK(!stream->IsClosed());
-
-    // Activate the stream only when sending the HEADERS frame to
-    // guarantee monotonically-increasing stream IDs.
-    if (frame_type == spdy::SpdyFrameType::HEADERS) {
-      CHECK(stream.get());
-      CHECK_EQ(stream->stream_id(), 0u);
-      std::unique_ptr<SpdyStream> owned_stream =
-          ActivateCreatedStream(stream.get());
-      InsertActivatedStream(std::move(owned_stream));
-
-      if (stream_hi_water_mark_ > kLastStreamId) {
-        CHECK_EQ(stream->stream_id(), kLastStreamId);
-        // We've exhausted the stream ID space, and no new streams may be
-        // created after this one.
-        MakeUnavailable();
-        StartGoingAway(kLastStreamId, ERR_ABORTED);
-      }
-    }
-
-    in_flight_write_ = producer->ProduceBuffer();
-    if (!in_flight_write_) {
-      NOTREACHED();
-      return ERR_UNEXPECTED;
+    if (coalesce_writes_ &&
+        buffer->GetRemainingSize() < kMaxCoalescedWriteSize &&
+        CanCoalesceNextWrite()) {
+      CoalesceWrites(frame_type, std::move(buffer), stream);
+    } else {
+      in_flight_write_ = std::move(buffer);
+      in_flight_write_frame_type_ = frame_type;
+      in_flight_write_frame_size_ = in_flight_write_->GetRemainingSize();
+      in_flight_write_stream_ = stream;
     }
-    in_flight_write_frame_type_ = frame_type;
-    in_flight_write_frame_size_ = in_flight_write_->GetRemainingSize();
-    DCHECK_GE(in_flight_write_frame_size_, spdy::kFrameMinimumSize);
-    in_flight_write_stream_ = stream;
   }
 
   write_state_ = WRITE_STATE_DO_WRITE_COMPLETE;
@@ -2207,6 +2212,7 @@ int SpdySession::DoWriteComplete(int result) {
   if (result < 0) {
     DCHECK_NE(result, ERR_IO_PENDING);
     in_flight_write_.reset();
+    coalesced_frames_.clear();
     in_flight_write_frame_type_ = spdy::SpdyFrameType::DATA;
     in_flight_write_frame_size_ = 0;
     in_flight_write_stream_.reset();
@@ -2220,7 +2226,14 @@ int SpdySession::DoWriteComplete(int result) {
   // in_flight_write_.
   DCHECK_LE(static_cast<size_t>(result), in_flight_write_->GetRemainingSize());
 
-  if (result > 0) {
+  if (result > 0 && !coalesced_frames_.empty()) {
+    in_flight_write_->Consume(static_cast<size_t>(result));
+    ConsumeCoalescedFrames(static_cast<size_t>(result));
+    if (in_flight_write_->GetRemainingSize() == 0) {
+      DCHECK(coalesced_frames_.empty());
+      in_flight_write_.reset();
+    }
+  } else if (result > 0) {
     in_flight_write_->Consume(static_cast<size_t>(result));
     if (in_flight_write_stream_.get())
       in_flight_write_stream_->AddRawSentBytes(static_cast<size_t>(result));
@@ -2247,6 +2260,124 @@ int SpdySession::DoWriteComplete(int result) {
   return OK;
 }
 
+int SpdySession::DequeueWrite(
+    spdy::SpdyFrameType* frame_type,
+    std::unique_ptr<SpdyBuffer>* buffer,
+    base::WeakPtr<SpdyStream>* stream,
+    MutableNetworkTrafficAnnotationTag* traffic_annotation) {
+  std::unique_ptr<SpdyBufferProducer> producer;
+  if (!write_queue_.Dequeue(frame_type, &producer, stream,
+                            traffic_annotation)) {
+    return ERR_IO_PENDING;
+  }
+
+  if (stream->get())
+    CHECK(!(*stream)->IsClosed());
+
+  // Activate the stream only when sending the HEADERS frame to
+  // guarantee monotonically-increasing stream IDs.
+  if (*frame_type == spdy::SpdyFrameType::HEADERS) {
+    CHECK(stream->get());
+    CHECK_EQ((*stream)->stream_id(), 0u);
+    std::unique_ptr<SpdyStream> owned_stream =
+        ActivateCreatedStream(stream->get());
+    InsertActivatedStream(std::move(owned_stream));
+
+    if (stream_hi_water_mark_ > kLastStreamId) {
+      CHECK_EQ((*stream)->stream_id(), kLastStreamId);
+      // We've exhausted the stream ID space, and no new streams may be
+      // created after this one.
+      MakeUnavailable();
+      StartGoingAway(kLastStreamId, ERR_ABORTED);
+    }
+  }
+
+  *buffer = producer->ProduceBuffer();
+  if (!*buffer) {
+    NOTREACHED();
+    return ERR_UNEXPECTED;
+  }
+  DCHECK_GE((*buffer)->GetRemainingSize(), spdy::kFrameMinimumSize);
+  return OK;
+}
+
+bool SpdySession::CanCoalesceNextWrite() const {
+  // Frames with different traffic annotations are written separately.
+  return !write_queue_.IsEmpty() && write_queue_.PeekTrafficAnnotation() ==
+                                        in_flight_write_traffic_annotation;
+}
+
+void SpdySession::CoalesceWrites(spdy::SpdyFrameType frame_type,
+                                 std::unique_ptr<SpdyBuffer> buffer,
+                                 const base::WeakPtr<SpdyStream>& stream) {
+  DCHECK(!in_flight_write_);
+  DCHECK(coalesced_frames_.empty());
+
+  size_t total_size = buffer->GetRemainingSize();
+  coalesced_frames_.emplace_back(frame_type, std::move(buffer), stream);
+  // The last frame may take the write over kMaxCoalescedWriteSize.
+  while (total_size < kMaxCoalescedWriteSize && CanCoalesceNextWrite()) {
+    spdy::SpdyFrameType next_frame_type = spdy::SpdyFrameType::DATA;
+    std::unique_ptr<SpdyBuffer> next_buffer;
+    base::WeakPtr<SpdyStream> next_stream;
+    MutableNetworkTrafficAnnotationTag next_traffic_annotation;
+    if (DequeueWrite(&next_frame_type, &next_buffer, &next_stream,
+                     &next_traffic_annotation) != OK) {
+      break;
+    }
+    total_size += next_buffer->GetRemainingSize();
+    coalesced_frames_.emplace_back(next_frame_type, std::move(next_buffer),
+                                   next_stream);
+  }
+
+  std::string data;
+  data.reserve(total_size);
+  for (const CoalescedFrame& frame : coalesced_frames_) {
+    data.append(frame.buffer->GetRemainingData(),
+                frame.buffer->GetRemainingSize());
+  }
+  in_flight_write_ = std::make_unique<SpdyBuffer>(data.data(), data.size());
+
+  UMA_HISTOGRAM_COUNTS_100("Net.SpdySession.CoalescedFramesPerWrite",
+                           coalesced_frames_.size());
+}
+
+void SpdySession::ConsumeCoalescedFrames(size_t size) {
+  while (size > 0) {
+    DCHECK(!coalesced_frames_.empty());
+    CoalescedFrame& frame = coalesced_frames_.front();
+    size_t consumed = std::min(size, frame.buffer->GetRemainingSize());
+    frame.buffer->Consume(consumed);
+    size -= consumed;
+    if (frame.stream.get())
+      frame.stream->AddRawSentBytes(consumed);
+    if (frame.buffer->GetRemainingSize() > 0)
+      break;
+
+    // Remove the frame before notifying its stream, which may enqueue more
+    // writes.
+    CoalescedFrame written_frame = std::move(frame);
+    coalesced_frames_.pop_front();
+    if (written_frame.stream.get()) {
+      written_frame.stream->OnFrameWriteComplete(written_frame.frame_type,
+                                                 written_frame.frame_size);
+    }
+  }
+}
+
+SpdySession::CoalescedFrame::CoalescedFrame(
+    spdy::SpdyFrameType frame_type,
+    std::unique_ptr<SpdyBuffer> buffer,
+    const base::WeakPtr<SpdyStream>& stream)
+    : frame_type(frame_type),
+      frame_size(buffer->GetRemainingSize()),
+      buffer(std::move(buffer)),
+      stream(stream) {}
+
+SpdySession::CoalescedFrame::CoalescedFrame(CoalescedFrame&& other) = default;
+
+SpdySession::CoalescedFrame::~CoalescedFrame() = default;
+
 void SpdySession::SendInitialData() {
   DCHECK(enable_sending_initial_data_);
   DCHECK(buffered_spdy_framer_.get());
@@ -687,6 +687,30 @@ class NET_EXPORT SpdySession : public BufferedSpdyFramerVisitorInterface,
   int DoWrite();
   int DoWriteComplete(int result);
 
+  // Dequeues the next frame from |write_queue_|, activating its stream if it
+  // is a HEADERS frame, and produces its buffer. Returns ERR_IO_PENDING if
+  // the queue is empty.
+  int DequeueWrite(spdy::SpdyFrameType* frame_type,
+                   std::unique_ptr<SpdyBuffer>* buffer,
+                   base::WeakPtr<SpdyStream>* stream,
+                   MutableNetworkTrafficAnnotationTag* traffic_annotation);
+
+  // Whether the next frame in |write_queue_| can be written together with
+  // the frames in |in_flight_write_|.
+  bool CanCoalesceNextWrite() const;
+
+  // Dequeues frames after the given one, in priority order, until about
+  // kMaxCoalescedWriteSize bytes are gathered, and sets |in_flight_write_| to
+  // a copy of all of them. The frames are kept in |coalesced_frames_| until
+  // they have been written.
+  void CoalesceWrites(spdy::SpdyFrameType frame_type,
+                      std::unique_ptr<SpdyBuffer> buffer,
+                      const base::WeakPtr<SpdyStream>& stream);
+
+  // Consumes |size| written bytes from |coalesced_frames_|, notifying the
+  // streams of the frames written completely.
+  void ConsumeCoalescedFrames(size_t size);
+
   // TODO(akalin): Rename the Send* and Write* functions below to
   // Enqueue*.
 
@@ -1000,6 +1024,31 @@ class NET_EXPORT SpdySession : public BufferedSpdyFramerVisitorInterface,
   // Traffic annotation for the write in progress.
   MutableNetworkTrafficAnnotationTag in_flight_write_traffic_annotation;
 
+  // A frame written as part of a coalesced |in_flight_write_|.
+  struct CoalescedFrame {
+    CoalescedFrame(spdy::SpdyFrameType frame_type,
+                   std::unique_ptr<SpdyBuffer> buffer,
+                   const base::WeakPtr<SpdyStream>& stream);
+    CoalescedFrame(CoalescedFrame&& other);
+    ~CoalescedFrame();
+
+    spdy::SpdyFrameType frame_type;
+    size_t frame_size;
+    // Consumed as |in_flight_write_| is written, so that flow control
+    // callbacks run as for frames that are written on their own.
+    std::unique_ptr<SpdyBuffer> buffer;
+    base::WeakPtr<SpdyStream> stream;
+  };
+
+  // If non-empty, |in_flight_write_| holds a copy of these frames, in order.
+  // Otherwise it holds a single frame, described by the in_flight_write_*
+  // members above.
+  base::circular_deque<CoalescedFrame> coalesced_frames_;
+
+  // Whether small frames are coalesced into a single socket write. Set from
+  // the SpdyCoalesceWrites feature.
+  const bool coalesce_writes_;
+
   // Spdy Frame state.
   std::unique_ptr<BufferedSpdyFramer> buffered_spdy_framer_;
 
@@ -22,6 +22,7 @@
 #include "net/http/http_network_session.h"
 #include "net/http/http_server_properties.h"
 #include "net/http/http_stream_request.h"
+#include "net/log/net_log.h"
 #include "net/log/net_log_event_type.h"
 #include "net/log/net_log_source.h"
 #include "net/log/net_log_with_source.h"
@@ -44,6 +45,33 @@ enum SpdySessionGetTypes {
   SPDY_SESSION_GET_MAX        = 4
 };
 
+const char* LookupResultToString(SpdySessionPool::LookupResult result) {
+  switch (result) {
+    case SpdySessionPool::LOOKUP_FOUND_EXISTING:
+      return "found_existing";
+    case SpdySessionPool::LOOKUP_FOUND_EXISTING_FROM_IP_POOL:
+      return "found_existing_from_ip_pool";
+    case SpdySessionPool::LOOKUP_NO_SESSION:
+      return "no_session";
+    case SpdySessionPool::LOOKUP_IP_POOLING_DISABLED:
+      return "ip_pooling_disabled";
+    case SpdySessionPool::LOOKUP_NOT_IN_HOST_CACHE:
+      return "not_in_host_cache";
+    case SpdySessionPool::LOOKUP_PROXY_OR_PRIVACY_MODE_MISMATCH:
+      return "proxy_or_privacy_mode_mismatch";
+    case SpdySessionPool::LOOKUP_WEBSOCKETS_NOT_SUPPORTED:
+      return "websockets_not_supported";
+    case SpdySessionPool::LOOKUP_CERTIFICATE_MISMATCH:
+      return "certificate_mismatch";
+    case SpdySessionPool::LOOKUP_SOCKET_TAG_MISMATCH:
+      return "socket_tag_mismatch";
+    case SpdySessionPool::LOOKUP_RESULT_MAX:
+      break;
+  }
+  NOTREACHED();
+  return "";
+}
+
 }  // namespace
 
 SpdySessionPool::SpdySessionPool(
@@ -69,7 +97,8 @@ SpdySessionPool::SpdySessionPool(
       session_max_recv_window_size_(session_max_recv_window_size),
       initial_settings_(initial_settings),
       time_func_(time_func),
-      push_delegate_(nullptr) {
+      push_delegate_(nullptr),
+      lookup_counts_() {
   NetworkChangeNotifier::AddIPAddressObserver(this);
   if (ssl_config_service_.get())
     ssl_config_service_->AddObserver(this);
@@ -141,12 +170,16 @@ base::WeakPtr<SpdySession> SpdySessionPool::FindAvailableSession(
     bool enable_ip_based_pooling,
     bool is_websocket,
     const NetLogWithSource& net_log) {
+  // The reason the first candidate session could not be used, if any.
+  LookupResult miss_result = LOOKUP_NO_SESSION;
+
   AvailableSessionMap::iterator it = LookupAvailableSessionByKey(key);
   if (it != available_sessions_.end() &&
       (!is_websocket || it->second->support_websocket())) {
     if (key == it->second->spdy_session_key()) {
       UMA_HISTOGRAM_ENUMERATION("Net.SpdySessionGet", FOUND_EXISTING,
                                 SPDY_SESSION_GET_MAX);
+      RecordLookupResult(LOOKUP_FOUND_EXISTING, net_log);
       net_log.AddEvent(
           NetLogEventType::HTTP2_SESSION_POOL_FOUND_EXISTING_SESSION,
           it->second->net_log().source().ToEventParametersCallback());
@@ -157,6 +190,7 @@ base::WeakPtr<SpdySession> SpdySessionPool::FindAvailableSession(
       UMA_HISTOGRAM_ENUMERATION("Net.SpdySessionGet",
                                 FOUND_EXISTING_FROM_IP_POOL,
                                 SPDY_SESSION_GET_MAX);
+      RecordLookupResult(LOOKUP_FOUND_EXISTING_FROM_IP_POOL, net_log);
       net_log.AddEvent(
           NetLogEventType::
               HTTP2_SESSION_POOL_FOUND_EXISTING_SESSION_FROM_IP_POOL,
@@ -170,19 +204,28 @@ base::WeakPtr<SpdySession> SpdySessionPool::FindAvailableSession(
     it->second->RemovePooledAlias(key);
     UnmapKey(key);
     RemoveAliases(key);
+    RecordLookupResult(LOOKUP_IP_POOLING_DISABLED, net_log);
     return base::WeakPtr<SpdySession>();
   }
+  if (it != available_sessions_.end())
+    miss_result = LOOKUP_WEBSOCKETS_NOT_SUPPORTED;
 
-  if (!enable_ip_based_pooling)
+  if (!enable_ip_based_pooling) {
+    RecordLookupResult(miss_result, net_log);
     return base::WeakPtr<SpdySession>();
+  }
 
   // Look up IP addresses from resolver cache.
   HostResolver::RequestInfo resolve_info(key.host_port_pair());
   AddressList addresses;
   int rv = resolver_->ResolveFromCache(resolve_info, &addresses, net_log);
   DCHECK_NE(rv, ERR_IO_PENDING);
-  if (rv != OK)
+  if (rv != OK) {
+    if (miss_result == LOOKUP_NO_SESSION)
+      miss_result = LOOKUP_NOT_IN_HOST_CACHE;
+    RecordLookupResult(miss_result, net_log);
     return base::WeakPtr<SpdySession>();
+  }
 
   // Check if we have a session through a domain alias.
   for (AddressList::const_iterator address_it = addresses.begin();
@@ -197,6 +240,8 @@ base::WeakPtr<SpdySession> SpdySessionPool::FindAvailableSession(
       // settings match.
       if (!(alias_key.proxy_server() == key.proxy_server()) ||
           !(alias_key.privacy_mode() == key.privacy_mode())) {
+        if (miss_result == LOOKUP_NO_SESSION)
+          miss_result = LOOKUP_PROXY_OR_PRIVACY_MODE_MISMATCH;
         continue;
       }
 
@@ -213,8 +258,11 @@ base::WeakPtr<SpdySession> SpdySessionPool::FindAvailableSession(
           available_session_it->second;
       DCHECK(base::ContainsKey(sessions_, available_session.get()));
 
-      if (is_websocket && !available_session->support_websocket())
+      if (is_websocket && !available_session->support_websocket()) {
+        if (miss_result == LOOKUP_NO_SESSION)
+          miss_result = LOOKUP_WEBSOCKETS_NOT_SUPPORTED;
         continue;
+      }
 
       // If the session is a secure one, we need to verify that the
       // server is authenticated to serve traffic for |host_port_proxy_pair|
@@ -222,6 +270,8 @@ base::WeakPtr<SpdySession> SpdySessionPool::FindAvailableSession(
       if (!available_session->VerifyDomainAuthentication(
               key.host_port_pair().host())) {
         UMA_HISTOGRAM_ENUMERATION("Net.SpdyIPPoolDomainMatch", 0, 2);
+        if (miss_result == LOOKUP_NO_SESSION)
+          miss_result = LOOKUP_CERTIFICATE_MISMATCH;
         continue;
       }
 
@@ -231,8 +281,11 @@ base::WeakPtr<SpdySession> SpdySessionPool::FindAvailableSession(
       if (alias_key.socket_tag() != key.socket_tag()) {
         SpdySessionKey old_key = available_session->spdy_session_key();
 
-        if (!available_session->ChangeSocketTag(key.socket_tag()))
+        if (!available_session->ChangeSocketTag(key.socket_tag())) {
+          if (miss_result == LOOKUP_NO_SESSION)
+            miss_result = LOOKUP_SOCKET_TAG_MISMATCH;
           continue;
+        }
 
         const SpdySessionKey& new_key = available_session->spdy_session_key();
 
@@ -271,6 +324,7 @@ base::WeakPtr<SpdySession> SpdySessionPool::FindAvailableSession(
       UMA_HISTOGRAM_ENUMERATION("Net.SpdySessionGet",
                                 FOUND_EXISTING_FROM_IP_POOL,
                                 SPDY_SESSION_GET_MAX);
+      RecordLookupResult(LOOKUP_FOUND_EXISTING_FROM_IP_POOL, net_log);
       net_log.AddEvent(
           NetLogEventType::
               HTTP2_SESSION_POOL_FOUND_EXISTING_SESSION_FROM_IP_POOL,
@@ -284,6 +338,7 @@ base::WeakPtr<SpdySession> SpdySessionPool::FindAvailableSession(
     }
   }
 
+  RecordLookupResult(miss_result, net_log);
   return base::WeakPtr<SpdySession>();
 }
 
@@ -353,6 +408,16 @@ std::unique_ptr<base::Value> SpdySessionPool::SpdySessionPoolInfoToValue()
   return std::move(list);
 }
 
+std::unique_ptr<base::Value> SpdySessionPool::LookupStatsToValue() const {
+  auto dict = std::make_unique<base::DictionaryValue>();
+  for (int i = 0; i < LOOKUP_RESULT_MAX; ++i) {
+    LookupResult result = static_cast<LookupResult>(i);
+    dict->SetInteger(LookupResultToString(result),
+                     static_cast<int>(lookup_counts_[result]));
+  }
+  return std::move(dict);
+}
+
 void SpdySessionPool::OnIPAddressChanged() {
   WeakSessionList current_sessions = GetCurrentSessions();
   for (WeakSessionList::const_iterator it = current_sessions.begin();
@@ -568,6 +633,18 @@ void SpdySessionPool::RemoveAliases(const SpdySessionKey& key) {
   }
 }
 
+void SpdySessionPool::RecordLookupResult(LookupResult result,
+                                         const NetLogWithSource& net_log) {
+  ++lookup_counts_[result];
+  if (result == LOOKUP_FOUND_EXISTING ||
+      result == LOOKUP_FOUND_EXISTING_FROM_IP_POOL) {
+    return;
+  }
+  net_log.AddEvent(
+      NetLogEventType::HTTP2_SESSION_POOL_NO_AVAILABLE_SESSION,
+      NetLog::StringCallback("reason", LookupResultToString(result)));
+}
+
 SpdySessionPool::WeakSessionList SpdySessionPool::GetCurrentSessions() const {
   WeakSessionList current_sessions;
   for (SessionSet::const_iterator it = sessions_.begin();
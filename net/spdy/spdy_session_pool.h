@@ -56,6 +56,33 @@ class NET_EXPORT SpdySessionPool
  public:
   typedef base::TimeTicks (*TimeFunc)(void);
 
+  // The results of FindAvailableSession(), to see why requests do or don't
+  // reuse sessions. When no session is found, the result is the reason the
+  // first candidate session, if any, could not be used.
+  enum LookupResult {
+    LOOKUP_FOUND_EXISTING,
+    LOOKUP_FOUND_EXISTING_FROM_IP_POOL,
+    // There is no session for the key, and no session to any of the IP
+    // addresses of the host.
+    LOOKUP_NO_SESSION,
+    // A session could have been used if IP-based pooling were enabled.
+    LOOKUP_IP_POOLING_DISABLED,
+    // The host is not in the HostCache, so sessions to its IP addresses
+    // can't be found.
+    LOOKUP_NOT_IN_HOST_CACHE,
+    // A session to an IP address of the host uses a different proxy or
+    // privacy mode.
+    LOOKUP_PROXY_OR_PRIVACY_MODE_MISMATCH,
+    // A session does not support WebSockets over HTTP/2.
+    LOOKUP_WEBSOCKETS_NOT_SUPPORTED,
+    // A session to an IP address of the host is not authenticated for it.
+    LOOKUP_CERTIFICATE_MISMATCH,
+    // A session to an IP address of the host has a socket tag that can't be
+    // changed.
+    LOOKUP_SOCKET_TAG_MISMATCH,
+    LOOKUP_RESULT_MAX
+  };
+
   SpdySessionPool(
       HostResolver* host_resolver,
       SSLConfigService* ssl_config_service,
@@ -135,6 +162,14 @@ class NET_EXPORT SpdySessionPool
   // Creates a Value summary of the state of the spdy session pool.
   std::unique_ptr<base::Value> SpdySessionPoolInfoToValue() const;
 
+  // Returns the number of calls to FindAvailableSession() with |result|.
+  size_t lookup_count(LookupResult result) const {
+    return lookup_counts_[result];
+  }
+
+  // Creates a Value summary of the results of FindAvailableSession().
+  std::unique_ptr<base::Value> LookupStatsToValue() const;
+
   HttpServerProperties* http_server_properties() {
     return http_server_properties_;
   }
@@ -224,6 +259,10 @@ class NET_EXPORT SpdySessionPool
   // Remove all aliases for |key| from the aliases table.
   void RemoveAliases(const SpdySessionKey& key);
 
+  // Counts a call to FindAvailableSession() with |result|, and logs the
+  // reason a session was not found to |net_log|.
+  void RecordLookupResult(LookupResult result, const NetLogWithSource& net_log);
+
   // Get a copy of the current sessions as a list of WeakPtrs. Used by
   // CloseCurrentSessionsHelper() below.
   WeakSessionList GetCurrentSessions() const;
@@ -285,6 +324,8 @@ class NET_EXPORT SpdySessionPool
   TimeFunc time_func_;
   ServerPushDelegate* push_delegate_;
 
+  size_t lookup_counts_[LOOKUP_RESULT_MAX];
+
   DISALLOW_COPY_AND_ASSIGN(SpdySessionPool);
 };
 
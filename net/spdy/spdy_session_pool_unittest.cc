@@ -13,6 +13,7 @@
 #include "base/trace_event/memory_allocator_dump.h"
 #include "base/trace_event/process_memory_dump.h"
 #include "base/trace_event/trace_event_argument.h"
+#include "base/values.h"
 #include "build/build_config.h"
 #include "net/dns/host_cache.h"
 #include "net/http/http_network_session.h"
@@ -679,6 +680,101 @@ TEST_F(SpdySessionPoolTest, IPPoolingDisabled) {
   EXPECT_NE(session0.get(), session1.get());
 }
 
+// FindAvailableSession() counts why each lookup did or did not find a session,
+// and logs the reason for misses.
+TEST_F(SpdySessionPoolTest, LookupResults) {
+  const int kTestPort = 443;
+  session_deps_.host_resolver->set_synchronous_mode(true);
+  session_deps_.host_resolver->rules()->AddIPLiteralRule(
+      "www.example.org", "192.168.0.1", std::string());
+  session_deps_.host_resolver->rules()->AddIPLiteralRule(
+      "mail.example.org", "192.168.0.1", std::string());
+  for (const char* host : {"www.example.org", "mail.example.org"}) {
+    HostResolver::RequestInfo info(HostPortPair(host, kTestPort));
+    AddressList addresses;
+    std::unique_ptr<HostResolver::Request> request;
+    int rv = session_deps_.host_resolver->Resolve(
+        info, DEFAULT_PRIORITY, &addresses, CompletionCallback(), &request,
+        NetLogWithSource());
+    EXPECT_THAT(rv, IsOk());
+  }
+
+  SpdySessionKey key(HostPortPair("www.example.org", kTestPort),
+                     ProxyServer::Direct(), PRIVACY_MODE_DISABLED, SocketTag());
+  SpdySessionKey alias_key(HostPortPair("mail.example.org", kTestPort),
+                           ProxyServer::Direct(), PRIVACY_MODE_DISABLED,
+                           SocketTag());
+  SpdySessionKey private_alias_key(
+      HostPortPair("mail.example.org", kTestPort), ProxyServer::Direct(),
+      PRIVACY_MODE_ENABLED, SocketTag());
+  SpdySessionKey uncached_key(HostPortPair("uncached.example.org", kTestPort),
+                              ProxyServer::Direct(), PRIVACY_MODE_DISABLED,
+                              SocketTag());
+
+  MockRead reads[] = {MockRead(SYNCHRONOUS, ERR_IO_PENDING)};
+  StaticSocketDataProvider data(reads, base::span<MockWrite>());
+  data.set_connect_data(MockConnect(SYNCHRONOUS, OK));
+  session_deps_.socket_factory->AddSocketDataProvider(&data);
+  AddSSLSocketData();
+
+  CreateNetworkSession();
+
+  // CreateSpdySession() checks that there is no session for |key| yet.
+  base::WeakPtr<SpdySession> session =
+      CreateSpdySession(http_session_.get(), key, NetLogWithSource());
+  ASSERT_TRUE(session);
+  EXPECT_EQ(1u,
+            spdy_session_pool_->lookup_count(SpdySessionPool::LOOKUP_NO_SESSION));
+
+  EXPECT_TRUE(spdy_session_pool_->FindAvailableSession(
+      key, /* enable_ip_based_pooling = */ true,
+      /* is_websocket = */ false, NetLogWithSource()));
+  EXPECT_EQ(1u, spdy_session_pool_->lookup_count(
+                    SpdySessionPool::LOOKUP_FOUND_EXISTING));
+
+  EXPECT_TRUE(spdy_session_pool_->FindAvailableSession(
+      alias_key, /* enable_ip_based_pooling = */ true,
+      /* is_websocket = */ false, NetLogWithSource()));
+  EXPECT_EQ(1u, spdy_session_pool_->lookup_count(
+                    SpdySessionPool::LOOKUP_FOUND_EXISTING_FROM_IP_POOL));
+
+  EXPECT_FALSE(spdy_session_pool_->FindAvailableSession(
+      alias_key, /* enable_ip_based_pooling = */ false,
+      /* is_websocket = */ false, NetLogWithSource()));
+  EXPECT_EQ(1u, spdy_session_pool_->lookup_count(
+                    SpdySessionPool::LOOKUP_IP_POOLING_DISABLED));
+
+  EXPECT_FALSE(spdy_session_pool_->FindAvailableSession(
+      uncached_key, /* enable_ip_based_pooling = */ true,
+      /* is_websocket = */ false, NetLogWithSource()));
+  EXPECT_EQ(1u, spdy_session_pool_->lookup_count(
+                    SpdySessionPool::LOOKUP_NOT_IN_HOST_CACHE));
+
+  BoundTestNetLog net_log;
+  EXPECT_FALSE(spdy_session_pool_->FindAvailableSession(
+      private_alias_key, /* enable_ip_based_pooling = */ true,
+      /* is_websocket = */ false, net_log.bound()));
+  EXPECT_EQ(1u, spdy_session_pool_->lookup_count(
+                    SpdySessionPool::LOOKUP_PROXY_OR_PRIVACY_MODE_MISMATCH));
+
+  TestNetLogEntry::List entry_list;
+  net_log.GetEntries(&entry_list);
+  ASSERT_EQ(1u, entry_list.size());
+  EXPECT_EQ(NetLogEventType::HTTP2_SESSION_POOL_NO_AVAILABLE_SESSION,
+            entry_list[0].type);
+  std::string reason;
+  EXPECT_TRUE(entry_list[0].GetStringValue("reason", &reason));
+  EXPECT_EQ("proxy_or_privacy_mode_mismatch", reason);
+
+  std::unique_ptr<base::Value> stats =
+      spdy_session_pool_->LookupStatsToValue();
+  base::DictionaryValue* stats_dict = nullptr;
+  ASSERT_TRUE(stats->GetAsDictionary(&stats_dict));
+  int count = 0;
+  EXPECT_TRUE(stats_dict->GetInteger("found_existing_from_ip_pool", &count));
+  EXPECT_EQ(1, count);
+}
+
 // Construct a Pool with SpdySessions in various availability states. Simulate
 // an IP address change. Ensure sessions gracefully shut down. Regression test
 // for crbug.com/379469.
@@ -2297,6 +2297,63 @@ TEST_F(SpdySessionTest, CancelStream) {
   EXPECT_FALSE(spdy_stream2);
 }
 
+// With SpdyCoalesceWrites, the HEADERS frames of two streams are written to
+// the socket together, in priority order.
+TEST_F(SpdySessionTest, CoalesceWrites) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitFromCommandLine("SpdyCoalesceWrites", std::string());
+
+  spdy::SpdySerializedFrame req1(
+      spdy_util_.ConstructSpdyGet(nullptr, 0, 1, HIGHEST));
+  spdy::SpdySerializedFrame req2(
+      spdy_util_.ConstructSpdyGet(nullptr, 0, 3, LOWEST));
+  spdy::SpdySerializedFrame combined = CombineFrames({&req1, &req2});
+  MockWrite writes[] = {
+      CreateMockWrite(combined, 0),
+  };
+
+  MockRead reads[] = {
+      MockRead(ASYNC, ERR_IO_PENDING, 1), MockRead(ASYNC, 0, 2)  // EOF
+  };
+
+  SequencedSocketData data(reads, writes);
+  session_deps_.socket_factory->AddSocketDataProvider(&data);
+
+  AddSSLSocketData();
+
+  CreateNetworkSession();
+  CreateSpdySession();
+
+  base::WeakPtr<SpdyStream> spdy_stream2 =
+      CreateStreamSynchronously(SPDY_REQUEST_RESPONSE_STREAM, session_,
+                                test_url_, LOWEST, NetLogWithSource());
+  ASSERT_TRUE(spdy_stream2);
+  test::StreamDelegateDoNothing delegate2(spdy_stream2);
+  spdy_stream2->SetDelegate(&delegate2);
+
+  base::WeakPtr<SpdyStream> spdy_stream1 =
+      CreateStreamSynchronously(SPDY_REQUEST_RESPONSE_STREAM, session_,
+                                test_url_, HIGHEST, NetLogWithSource());
+  ASSERT_TRUE(spdy_stream1);
+  test::StreamDelegateDoNothing delegate1(spdy_stream1);
+  spdy_stream1->SetDelegate(&delegate1);
+
+  spdy_stream2->SendRequestHeaders(
+      spdy_util_.ConstructGetHeaderBlock(kDefaultUrl), NO_MORE_DATA_TO_SEND);
+  spdy_stream1->SendRequestHeaders(
+      spdy_util_.ConstructGetHeaderBlock(kDefaultUrl), NO_MORE_DATA_TO_SEND);
+
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(1u, spdy_stream1->stream_id());
+  EXPECT_EQ(3u, spdy_stream2->stream_id());
+  EXPECT_TRUE(data.AllWriteDataConsumed());
+
+  data.Resume();
+  base::RunLoop().RunUntilIdle();
+  EXPECT_FALSE(session_);
+  EXPECT_TRUE(data.AllReadDataConsumed());
+}
+
 // Create two streams that are set to re-close themselves on close,
 // and then close the session. Nothing should blow up. Also a
 // regression test for http://crbug.com/139518 .
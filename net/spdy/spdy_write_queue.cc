@@ -4,6 +4,7 @@
 
 #include "net/spdy/spdy_write_queue.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <utility>
 #include <vector>
@@ -28,7 +29,8 @@ SpdyWriteQueue::PendingWrite::PendingWrite(
       frame_producer(std::move(frame_producer)),
       stream(stream),
       traffic_annotation(traffic_annotation),
-      has_stream(stream.get() != nullptr) {}
+      has_stream(stream.get() != nullptr),
+      raw_stream(stream.get()) {}
 
 SpdyWriteQueue::PendingWrite::~PendingWrite() = default;
 
@@ -68,6 +70,8 @@ void SpdyWriteQueue::Enqueue(
   queue_[priority].push_back(
       {frame_type, std::move(frame_producer), stream,
        MutableNetworkTrafficAnnotationTag(traffic_annotation)});
+  if (stream.get())
+    ++num_writes_for_stream_[stream.get()];
 }
 
 bool SpdyWriteQueue::Dequeue(
@@ -84,14 +88,26 @@ bool SpdyWriteQueue::Dequeue(
       *frame_producer = std::move(pending_write.frame_producer);
       *stream = pending_write.stream;
       *traffic_annotation = pending_write.traffic_annotation;
-      if (pending_write.has_stream)
+      if (pending_write.has_stream) {
         DCHECK(stream->get());
+        OnWriteRemoved(pending_write.raw_stream);
+      }
       return true;
     }
   }
   return false;
 }
 
+MutableNetworkTrafficAnnotationTag SpdyWriteQueue::PeekTrafficAnnotation()
+    const {
+  for (int i = MAXIMUM_PRIORITY; i >= MINIMUM_PRIORITY; --i) {
+    if (!queue_[i].empty())
+      return queue_[i].front().traffic_annotation;
+  }
+  NOTREACHED();
+  return MutableNetworkTrafficAnnotationTag();
+}
+
 void SpdyWriteQueue::RemovePendingWritesForStream(SpdyStream* stream) {
   CHECK(!removing_writes_);
   removing_writes_ = true;
@@ -110,18 +126,28 @@ void SpdyWriteQueue::RemovePendingWritesForStream(SpdyStream* stream) {
   }
 #endif
 
+  if (num_writes_for_stream_.find(stream) == num_writes_for_stream_.end()) {
+    removing_writes_ = false;
+    return;
+  }
+
   // Defer deletion until queue iteration is complete, as
   // SpdyBuffer::~SpdyBuffer() can result in callbacks into SpdyWriteQueue.
+  // The remaining writes are compacted in a single pass, rather than erasing
+  // from the middle of |queue| once per removed write.
   std::vector<std::unique_ptr<SpdyBufferProducer>> erased_buffer_producers;
   base::circular_deque<PendingWrite>& queue = queue_[priority];
-  for (auto it = queue.begin(); it != queue.end();) {
-    if (it->stream.get() == stream) {
-      erased_buffer_producers.push_back(std::move(it->frame_producer));
-      it = queue.erase(it);
-    } else {
-      ++it;
-    }
-  }
+  auto new_end = std::remove_if(
+      queue.begin(), queue.end(), [&](PendingWrite& pending_write) {
+        if (pending_write.stream.get() != stream)
+          return false;
+        erased_buffer_producers.push_back(
+            std::move(pending_write.frame_producer));
+        return true;
+      });
+  queue.erase(new_end, queue.end());
+  for (size_t i = 0; i < erased_buffer_producers.size(); ++i)
+    OnWriteRemoved(stream);
   removing_writes_ = false;
 
   // Iteration on |queue| is completed.  Now |erased_buffer_producers| goes out
@@ -138,15 +164,19 @@ void SpdyWriteQueue::RemovePendingWritesForStreamsAfter(
   std::vector<std::unique_ptr<SpdyBufferProducer>> erased_buffer_producers;
   for (int i = MINIMUM_PRIORITY; i <= MAXIMUM_PRIORITY; ++i) {
     base::circular_deque<PendingWrite>& queue = queue_[i];
-    for (auto it = queue.begin(); it != queue.end();) {
-      if (it->stream.get() && (it->stream->stream_id() > last_good_stream_id ||
-                               it->stream->stream_id() == 0)) {
-        erased_buffer_producers.push_back(std::move(it->frame_producer));
-        it = queue.erase(it);
-      } else {
-        ++it;
-      }
-    }
+    auto new_end = std::remove_if(
+        queue.begin(), queue.end(), [&](PendingWrite& pending_write) {
+          SpdyStream* stream = pending_write.stream.get();
+          if (!stream || (stream->stream_id() <= last_good_stream_id &&
+                          stream->stream_id() != 0)) {
+            return false;
+          }
+          erased_buffer_producers.push_back(
+              std::move(pending_write.frame_producer));
+          OnWriteRemoved(pending_write.raw_stream);
+          return true;
+        });
+    queue.erase(new_end, queue.end());
   }
   removing_writes_ = false;
 
@@ -172,16 +202,19 @@ void SpdyWriteQueue::ChangePriorityOfWritesForStream(
   }
 #endif
 
+  if (num_writes_for_stream_.find(stream) == num_writes_for_stream_.end())
+    return;
+
   base::circular_deque<PendingWrite>& old_queue = queue_[old_priority];
   base::circular_deque<PendingWrite>& new_queue = queue_[new_priority];
-  for (auto it = old_queue.begin(); it != old_queue.end();) {
-    if (it->stream.get() == stream) {
-      new_queue.push_back(std::move(*it));
-      it = old_queue.erase(it);
-    } else {
-      ++it;
-    }
-  }
+  auto new_end = std::remove_if(
+      old_queue.begin(), old_queue.end(), [&](PendingWrite& pending_write) {
+        if (pending_write.stream.get() != stream)
+          return false;
+        new_queue.push_back(std::move(pending_write));
+        return true;
+      });
+  old_queue.erase(new_end, old_queue.end());
 }
 
 void SpdyWriteQueue::Clear() {
@@ -195,11 +228,20 @@ void SpdyWriteQueue::Clear() {
     }
     queue_[i].clear();
   }
+  num_writes_for_stream_.clear();
   removing_writes_ = false;
 }
 
 size_t SpdyWriteQueue::EstimateMemoryUsage() const {
-  return base::trace_event::EstimateMemoryUsage(queue_);
+  return base::trace_event::EstimateMemoryUsage(queue_) +
+         base::trace_event::EstimateMemoryUsage(num_writes_for_stream_);
+}
+
+void SpdyWriteQueue::OnWriteRemoved(SpdyStream* raw_stream) {
+  auto it = num_writes_for_stream_.find(raw_stream);
+  DCHECK(it != num_writes_for_stream_.end());
+  if (--it->second == 0)
+    num_writes_for_stream_.erase(it);
 }
 
 }  // namespace net
@@ -5,6 +5,7 @@
 #ifndef NET_SPDY_SPDY_WRITE_QUEUE_H_
 #define NET_SPDY_SPDY_WRITE_QUEUE_H_
 
+#include <map>
 #include <memory>
 
 #include "base/containers/circular_deque.h"
@@ -51,6 +52,10 @@ class NET_EXPORT_PRIVATE SpdyWriteQueue {
                base::WeakPtr<SpdyStream>* stream,
                MutableNetworkTrafficAnnotationTag* traffic_annotation);
 
+  // Returns the traffic annotation of the frame producer that the next
+  // call to Dequeue would return. The queue must not be empty.
+  MutableNetworkTrafficAnnotationTag PeekTrafficAnnotation() const;
+
   // Removes all pending writes for the given stream, which must be
   // non-NULL.
   void RemovePendingWritesForStream(SpdyStream* stream);
@@ -81,6 +86,9 @@ class NET_EXPORT_PRIVATE SpdyWriteQueue {
     MutableNetworkTrafficAnnotationTag traffic_annotation;
     // Whether |stream| was non-NULL when enqueued.
     bool has_stream;
+    // |stream| as it was when enqueued. Only used as a key into
+    // |num_writes_for_stream_|, and may dangle once |stream| is invalidated.
+    SpdyStream* raw_stream;
 
     PendingWrite();
     PendingWrite(spdy::SpdyFrameType frame_type,
@@ -97,8 +105,18 @@ class NET_EXPORT_PRIVATE SpdyWriteQueue {
     DISALLOW_COPY_AND_ASSIGN(PendingWrite);
   };
 
+  // Decrements the count of pending writes enqueued for |raw_stream|.
+  void OnWriteRemoved(SpdyStream* raw_stream);
+
   bool removing_writes_;
 
+  // The number of pending writes enqueued for each stream, so that removing
+  // or reprioritizing the writes of a stream with nothing queued doesn't have
+  // to scan the queue. Writes whose stream was destroyed without removing
+  // them stay counted until they are dequeued, so a count may be higher than
+  // the number of writes that still match the stream, but never lower.
+  std::map<SpdyStream*, size_t> num_writes_for_stream_;
+
   // The actual write queue, binned by priority.
   base::circular_deque<PendingWrite> queue_[NUM_PRIORITIES];
 
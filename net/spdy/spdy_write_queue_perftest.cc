@@ -0,0 +1,128 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/spdy/spdy_write_queue.h"
+
+#include <memory>
+#include <vector>
+
+#include "base/test/perf_time_logger.h"
+#include "net/base/request_priority.h"
+#include "net/log/net_log_with_source.h"
+#include "net/spdy/spdy_buffer.h"
+#include "net/spdy/spdy_buffer_producer.h"
+#include "net/spdy/spdy_stream.h"
+#include "net/traffic_annotation/network_traffic_annotation_test_helper.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace net {
+
+namespace {
+
+const int kNumStreams = 1000;
+const int kWritesPerStream = 4;
+const char kFrameData[] = "frame";
+
+class SpdyWriteQueuePerfTest : public ::testing::Test {
+ protected:
+  SpdyWriteQueuePerfTest() {
+    for (int i = 0; i < kNumStreams; ++i) {
+      RequestPriority priority =
+          static_cast<RequestPriority>(i % NUM_PRIORITIES);
+      streams_.push_back(std::make_unique<SpdyStream>(
+          SPDY_BIDIRECTIONAL_STREAM, base::WeakPtr<SpdySession>(), GURL(),
+          priority, 0, 0, NetLogWithSource(), TRAFFIC_ANNOTATION_FOR_TESTS));
+    }
+  }
+
+  // Enqueues |kWritesPerStream| writes for each stream, interleaved the way a
+  // busy session would produce them.
+  void EnqueueWrites(SpdyWriteQueue* write_queue) {
+    for (int i = 0; i < kWritesPerStream; ++i) {
+      for (const auto& stream : streams_) {
+        write_queue->Enqueue(
+            stream->priority(), spdy::SpdyFrameType::DATA,
+            std::make_unique<SimpleBufferProducer>(std::make_unique<SpdyBuffer>(
+                kFrameData, sizeof(kFrameData))),
+            stream->GetWeakPtr(), TRAFFIC_ANNOTATION_FOR_TESTS);
+      }
+    }
+  }
+
+  std::vector<std::unique_ptr<SpdyStream>> streams_;
+};
+
+// Drains the queue the way SpdySession::DoWrite() does.
+TEST_F(SpdyWriteQueuePerfTest, Dequeue) {
+  SpdyWriteQueue write_queue;
+  EnqueueWrites(&write_queue);
+
+  base::PerfTimeLogger timer("SpdyWriteQueue_Dequeue_1000_streams");
+  spdy::SpdyFrameType frame_type;
+  std::unique_ptr<SpdyBufferProducer> frame_producer;
+  base::WeakPtr<SpdyStream> stream;
+  MutableNetworkTrafficAnnotationTag traffic_annotation;
+  while (write_queue.Dequeue(&frame_type, &frame_producer, &stream,
+                             &traffic_annotation)) {
+  }
+  timer.Done();
+}
+
+// Closes every stream while all of their writes are still queued, as happens
+// when a page with many requests is torn down.
+TEST_F(SpdyWriteQueuePerfTest, RemovePendingWritesForStream) {
+  SpdyWriteQueue write_queue;
+  EnqueueWrites(&write_queue);
+
+  base::PerfTimeLogger timer(
+      "SpdyWriteQueue_RemovePendingWritesForStream_1000_streams");
+  for (const auto& stream : streams_)
+    write_queue.RemovePendingWritesForStream(stream.get());
+  timer.Done();
+  EXPECT_TRUE(write_queue.IsEmpty());
+}
+
+// Closes every stream once its writes were sent, which is the common case.
+TEST_F(SpdyWriteQueuePerfTest, RemovePendingWritesForIdleStream) {
+  SpdyWriteQueue write_queue;
+  EnqueueWrites(&write_queue);
+
+  // None of these streams have writes queued, but the writes of |streams_|
+  // are still queued behind them.
+  std::vector<std::unique_ptr<SpdyStream>> idle_streams;
+  for (int i = 0; i < kNumStreams; ++i) {
+    idle_streams.push_back(std::make_unique<SpdyStream>(
+        SPDY_BIDIRECTIONAL_STREAM, base::WeakPtr<SpdySession>(), GURL(),
+        LOWEST, 0, 0, NetLogWithSource(), TRAFFIC_ANNOTATION_FOR_TESTS));
+  }
+
+  base::PerfTimeLogger timer(
+      "SpdyWriteQueue_RemovePendingWritesForIdleStream_1000_streams");
+  for (const auto& stream : idle_streams)
+    write_queue.RemovePendingWritesForStream(stream.get());
+  timer.Done();
+  EXPECT_FALSE(write_queue.IsEmpty());
+}
+
+// Reprioritizes every stream, as happens when a renderer reorders the
+// resources of a page.
+TEST_F(SpdyWriteQueuePerfTest, ChangePriorityOfWritesForStream) {
+  SpdyWriteQueue write_queue;
+  EnqueueWrites(&write_queue);
+
+  base::PerfTimeLogger timer(
+      "SpdyWriteQueue_ChangePriorityOfWritesForStream_1000_streams");
+  for (const auto& stream : streams_) {
+    RequestPriority new_priority = static_cast<RequestPriority>(
+        (stream->priority() + 1) % NUM_PRIORITIES);
+    write_queue.ChangePriorityOfWritesForStream(
+        stream.get(), stream->priority(), new_priority);
+  }
+  timer.Done();
+}
+
+}  // namespace
+
+}  // namespace net
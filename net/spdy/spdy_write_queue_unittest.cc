@@ -205,6 +205,34 @@ TEST_F(SpdyWriteQueueTest, DequeuesFIFO) {
                                    &traffic_annotation));
 }
 
+// PeekTrafficAnnotation() returns the traffic annotation of the write that
+// Dequeue() returns next, in priority order.
+TEST_F(SpdyWriteQueueTest, PeekTrafficAnnotation) {
+  SpdyWriteQueue write_queue;
+
+  const NetworkTrafficAnnotationTag kLowAnnotation = NO_TRAFFIC_ANNOTATION_YET;
+  write_queue.Enqueue(LOW, spdy::SpdyFrameType::RST_STREAM, IntToProducer(1),
+                      base::WeakPtr<SpdyStream>(), kLowAnnotation);
+  EXPECT_EQ(MutableNetworkTrafficAnnotationTag(kLowAnnotation),
+            write_queue.PeekTrafficAnnotation());
+
+  write_queue.Enqueue(HIGHEST, spdy::SpdyFrameType::RST_STREAM,
+                      IntToProducer(2), base::WeakPtr<SpdyStream>(),
+                      TRAFFIC_ANNOTATION_FOR_TESTS);
+  EXPECT_EQ(MutableNetworkTrafficAnnotationTag(TRAFFIC_ANNOTATION_FOR_TESTS),
+            write_queue.PeekTrafficAnnotation());
+
+  spdy::SpdyFrameType frame_type = spdy::SpdyFrameType::DATA;
+  std::unique_ptr<SpdyBufferProducer> frame_producer;
+  base::WeakPtr<SpdyStream> stream;
+  MutableNetworkTrafficAnnotationTag traffic_annotation;
+  ASSERT_TRUE(write_queue.Dequeue(&frame_type, &frame_producer, &stream,
+                                  &traffic_annotation));
+  EXPECT_EQ(2, ProducerToInt(std::move(frame_producer)));
+  EXPECT_EQ(MutableNetworkTrafficAnnotationTag(kLowAnnotation),
+            write_queue.PeekTrafficAnnotation());
+}
+
 // Enqueue a bunch of writes and then call
 // RemovePendingWritesForStream() on one of the streams. No dequeued
 // write should be for that stream.
@@ -463,6 +491,47 @@ TEST_F(SpdyWriteQueueTest, ChangePriority) {
                                    &traffic_annotation));
 }
 
+// Writes of a stream that were already dequeued must not be affected by
+// removing or reprioritizing that stream's writes, and the writes that are
+// moved keep their relative order.
+TEST_F(SpdyWriteQueueTest, ChangePriorityAndRemoveAfterDequeue) {
+  SpdyWriteQueue write_queue;
+
+  std::unique_ptr<SpdyStream> stream1 = MakeTestStream(LOW);
+  std::unique_ptr<SpdyStream> stream2 = MakeTestStream(LOW);
+
+  for (int i = 0; i < 10; ++i) {
+    base::WeakPtr<SpdyStream> stream =
+        (((i % 2) == 0) ? stream1 : stream2)->GetWeakPtr();
+    write_queue.Enqueue(LOW, spdy::SpdyFrameType::DATA, IntToProducer(i),
+                        stream, TRAFFIC_ANNOTATION_FOR_TESTS);
+  }
+
+  spdy::SpdyFrameType frame_type = spdy::SpdyFrameType::DATA;
+  std::unique_ptr<SpdyBufferProducer> frame_producer;
+  base::WeakPtr<SpdyStream> stream;
+  MutableNetworkTrafficAnnotationTag traffic_annotation;
+  ASSERT_TRUE(write_queue.Dequeue(&frame_type, &frame_producer, &stream,
+                                  &traffic_annotation));
+  EXPECT_EQ(0, ProducerToInt(std::move(frame_producer)));
+  EXPECT_EQ(stream1.get(), stream.get());
+
+  write_queue.ChangePriorityOfWritesForStream(stream2.get(), LOW, HIGHEST);
+  for (int i = 1; i < 10; i += 2) {
+    ASSERT_TRUE(write_queue.Dequeue(&frame_type, &frame_producer, &stream,
+                                    &traffic_annotation));
+    EXPECT_EQ(i, ProducerToInt(std::move(frame_producer)));
+    EXPECT_EQ(stream2.get(), stream.get());
+  }
+
+  // |stream2| has nothing left to remove or reprioritize.
+  write_queue.RemovePendingWritesForStream(stream2.get());
+  write_queue.ChangePriorityOfWritesForStream(stream2.get(), HIGHEST, LOW);
+
+  write_queue.RemovePendingWritesForStream(stream1.get());
+  EXPECT_TRUE(write_queue.IsEmpty());
+}
+
 }  // namespace
 
 }  // namespace net
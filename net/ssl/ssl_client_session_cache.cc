@@ -6,21 +6,52 @@
 
 #include <utility>
 
+#include "base/base64.h"
 #include "base/containers/flat_set.h"
 #include "base/memory/memory_coordinator_client_registry.h"
 #include "base/strings/stringprintf.h"
 #include "base/time/clock.h"
 #include "base/time/default_clock.h"
 #include "base/trace_event/process_memory_dump.h"
+#include "base/values.h"
+#include "third_party/boringssl/src/include/openssl/mem.h"
 #include "third_party/boringssl/src/include/openssl/ssl.h"
 
 namespace net {
 
+namespace {
+
+const char kKeyKey[] = "key";
+const char kSessionKey[] = "session";
+
+// Session cache keys have the form "host:port/shard/flags", see
+// SSLClientSocketImpl::GetSessionCacheKey(). Returns |cache_key| with the
+// shard left out, or an empty string if the key is not in |shard|.
+std::string RemoveShard(const std::string& cache_key,
+                        const std::string& shard) {
+  const std::string infix = "/" + shard + "/";
+  size_t pos = cache_key.find(infix);
+  if (pos == std::string::npos)
+    return std::string();
+  return cache_key.substr(0, pos) + "//" + cache_key.substr(pos + infix.size());
+}
+
+// Reverses RemoveShard(). Returns an empty string if |key| is malformed.
+std::string AddShard(const std::string& key, const std::string& shard) {
+  size_t pos = key.find("//");
+  if (pos == std::string::npos)
+    return std::string();
+  return key.substr(0, pos) + "/" + shard + "/" + key.substr(pos + 2);
+}
+
+}  // namespace
+
 SSLClientSessionCache::SSLClientSessionCache(const Config& config)
     : clock_(base::DefaultClock::GetInstance()),
       config_(config),
       cache_(config.max_entries),
-      lookups_since_flush_(0) {
+      lookups_since_flush_(0),
+      delegate_(nullptr) {
   memory_pressure_listener_.reset(new base::MemoryPressureListener(base::Bind(
       &SSLClientSessionCache::OnMemoryPressure, base::Unretained(this))));
   base::MemoryCoordinatorClientRegistry::GetInstance()->Register(this);
@@ -79,12 +110,108 @@ void SSLClientSessionCache::Insert(const std::string& cache_key,
   if (iter == cache_.end())
     iter = cache_.Put(cache_key, Entry());
   iter->second.Push(bssl::UniquePtr<SSL_SESSION>(session));
+
+  if (delegate_)
+    delegate_->ScheduleWrite();
 }
 
 void SSLClientSessionCache::Flush() {
+  Clear();
+
+  // Flushes are requested when the sessions can no longer be trusted, e.g.
+  // after a change to the certificate database, so they must not be restored
+  // either.
   base::AutoLock lock(lock_);
+  if (delegate_)
+    delegate_->ScheduleWrite();
+}
 
-  cache_.Clear();
+void SSLClientSessionCache::GetAsListValue(const std::string& shard,
+                                           size_t max_entries,
+                                           base::ListValue* list) {
+  base::AutoLock lock(lock_);
+
+  time_t now = clock_->Now().ToTimeT();
+  size_t num_entries = 0;
+  for (auto iter = cache_.begin();
+       iter != cache_.end() && num_entries < max_entries; ++iter) {
+    SSL_SESSION* session = iter->second.sessions[0].get();
+    if (!session || IsExpired(session, now))
+      continue;
+    std::string key = RemoveShard(iter->first, shard);
+    if (key.empty())
+      continue;
+
+    uint8_t* data;
+    size_t len;
+    if (!SSL_SESSION_to_bytes(session, &data, &len))
+      continue;
+    bssl::UniquePtr<uint8_t> free_data(data);
+    std::string encoded_session;
+    base::Base64Encode(
+        base::StringPiece(reinterpret_cast<const char*>(data), len),
+        &encoded_session);
+
+    auto entry = std::make_unique<base::DictionaryValue>();
+    entry->SetString(kKeyKey, key);
+    entry->SetString(kSessionKey, encoded_session);
+    list->Append(std::move(entry));
+    ++num_entries;
+  }
+}
+
+bool SSLClientSessionCache::RestoreFromListValue(const base::ListValue& list,
+                                                 const std::string& shard,
+                                                 const SSL_CTX* ssl_ctx) {
+  base::AutoLock lock(lock_);
+
+  time_t now = clock_->Now().ToTimeT();
+  bool success = true;
+  // |list| is ordered most recently used first, so insert in reverse to keep
+  // that order in |cache_|.
+  const base::Value::ListStorage& entries = list.GetList();
+  for (auto it = entries.rbegin(); it != entries.rend(); ++it) {
+    const base::DictionaryValue* entry;
+    std::string key;
+    std::string encoded_session;
+    std::string session_bytes;
+    if (!it->GetAsDictionary(&entry) || !entry->GetString(kKeyKey, &key) ||
+        !entry->GetString(kSessionKey, &encoded_session) ||
+        !base::Base64Decode(encoded_session, &session_bytes)) {
+      success = false;
+      continue;
+    }
+    std::string cache_key = AddShard(key, shard);
+    if (cache_key.empty()) {
+      success = false;
+      continue;
+    }
+
+    bssl::UniquePtr<SSL_SESSION> session(SSL_SESSION_from_bytes(
+        reinterpret_cast<const uint8_t*>(session_bytes.data()),
+        session_bytes.size(), ssl_ctx));
+    if (!session) {
+      success = false;
+      continue;
+    }
+    if (IsExpired(session.get(), now) ||
+        cache_.Peek(cache_key) != cache_.end()) {
+      continue;
+    }
+    cache_.Put(cache_key, Entry())->second.Push(std::move(session));
+  }
+  return success;
+}
+
+void SSLClientSessionCache::set_persistence_delegate(
+    PersistenceDelegate* delegate) {
+  base::AutoLock lock(lock_);
+  delegate_ = delegate;
+}
+
+bool SSLClientSessionCache::has_persistence_delegate() {
+  base::AutoLock lock(lock_);
+  return delegate_ != nullptr;
 }
 
 void SSLClientSessionCache::SetClockForTesting(base::Clock* clock) {
@@ -220,13 +347,19 @@ void SSLClientSessionCache::OnMemoryPressure(
       FlushExpiredSessions();
       break;
     case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL:
-      Flush();
+      Clear();
       break;
   }
 }
 
 void SSLClientSessionCache::OnPurgeMemory() {
-  Flush();
+  Clear();
+}
+
+void SSLClientSessionCache::Clear() {
+  base::AutoLock lock(lock_);
+
+  cache_.Clear();
 }
 
 }  // namespace net
@@ -24,6 +24,7 @@
 
 namespace base {
 class Clock;
+class ListValue;
 namespace trace_event {
 class ProcessMemoryDump;
 }
@@ -40,6 +41,17 @@ class NET_EXPORT SSLClientSessionCache : public base::MemoryCoordinatorClient {
     size_t expiration_check_count = 256;
   };
 
+  class PersistenceDelegate {
+   public:
+    // Calling ScheduleWrite() signals that sessions were added or flushed and
+    // the cache should be written to persistent storage. The write might be
+    // delayed. Sessions dropped under memory pressure do not trigger a write.
+    virtual void ScheduleWrite() = 0;
+
+   protected:
+    virtual ~PersistenceDelegate() {}
+  };
+
   explicit SSLClientSessionCache(const Config& config);
   ~SSLClientSessionCache() override;
 
@@ -64,6 +76,25 @@ class NET_EXPORT SSLClientSessionCache : public base::MemoryCoordinatorClient {
   // Removes all entries from the cache.
   void Flush();
 
+  // Appends the newest unexpired session of each of the |max_entries| most
+  // recently used entries of |shard| to |list|, most recently used first. The
+  // shard is left out of the serialized keys, since shards are not stable
+  // across restarts.
+  void GetAsListValue(const std::string& shard,
+                      size_t max_entries,
+                      base::ListValue* list);
+
+  // Restores sessions serialized by GetAsListValue() into |shard|. |ssl_ctx|
+  // is used to parse them. Expired sessions are dropped, and entries already
+  // in the cache are kept rather than replaced. Returns false if any of the
+  // entries in |list| could not be parsed.
+  bool RestoreFromListValue(const base::ListValue& list,
+                            const std::string& shard,
+                            const SSL_CTX* ssl_ctx);
+
+  void set_persistence_delegate(PersistenceDelegate* delegate);
+  bool has_persistence_delegate();
+
   void SetClockForTesting(base::Clock* clock);
 
   // Dumps memory allocation stats. |pmd| is the ProcessMemoryDump of the
@@ -94,6 +125,9 @@ class NET_EXPORT SSLClientSessionCache : public base::MemoryCoordinatorClient {
   // base::MemoryCoordinatorClient implementation:
   void OnPurgeMemory() override;
 
+  // Removes all entries from the cache, without notifying |delegate_|.
+  void Clear();
+
   // Removes all expired sessions from the cache.
   void FlushExpiredSessions();
 
@@ -113,6 +147,9 @@ class NET_EXPORT SSLClientSessionCache : public base::MemoryCoordinatorClient {
 
   std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_;
 
+  // Guarded by |lock_|.
+  PersistenceDelegate* delegate_;
+
   DISALLOW_COPY_AND_ASSIGN(SSLClientSessionCache);
 };
 
@@ -129,6 +129,11 @@ constexpr base::TimeDelta kMaxProgressivePaintTime =
 constexpr base::TimeDelta kMaxInitialProgressivePaintTime =
     base::TimeDelta::FromMilliseconds(250);
 
+// The number of pages after the visible ones whose data is requested ahead of
+// time when loading a document in parts, so that scrolling down doesn't wait
+// on the network.
+constexpr int kPrefetchPageCount = 3;
+
 // Flag to turn edit mode tracking on.
 // Do not flip until form saving is completely functional.
 constexpr bool kIsEditModeTracked = false;
@@ -969,6 +974,8 @@ void PDFiumEngine::OnPendingRequestComplete() {
   pending_pages_.swap(still_pending);
   if (update_pages)
     LoadPageInfo(true);
+
+  RequestPagesAfterVisiblePages();
 }
 
 void PDFiumEngine::OnNewDataReceived() {
@@ -2782,6 +2789,8 @@ void PDFiumEngine::CalculateVisiblePages() {
   // screen coordinates.
   form_highlights_.clear();
 
+  RequestPagesAfterVisiblePages();
+
   int most_visible_page = visible_pages_.empty() ? -1 : visible_pages_.front();
   // Check if the next page is more visible than the first one.
   if (most_visible_page != -1 && !pages_.empty() &&
@@ -2797,6 +2806,21 @@ void PDFiumEngine::CalculateVisiblePages() {
   SetCurrentPage(most_visible_page);
 }
 
+void PDFiumEngine::RequestPagesAfterVisiblePages() {
+  // Wait for the visible pages to load first, since the document loader serves
+  // requests in file order rather than in the order they were made.
+  if (!doc_ || visible_pages_.empty() || !pending_pages_.empty())
+    return;
+
+  const int num_pages = static_cast<int>(pages_.size());
+  const int first_page = visible_pages_.back() + 1;
+  const int end_page = std::min(first_page + kPrefetchPageCount, num_pages);
+  // Pages which aren't available yet have their data requested through
+  // |download_hints_|, and are checked again as the data arrives.
+  for (int i = first_page; i < end_page; ++i)
+    CheckPageAvailable(i, &pending_pages_);
+}
+
 bool PDFiumEngine::IsPageVisible(int index) const {
   return base::ContainsValue(visible_pages_, index);
 }
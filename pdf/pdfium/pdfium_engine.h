@@ -257,6 +257,10 @@ class PDFiumEngine : public PDFEngine,
   // Calculates which pages should be displayed right now.
   void CalculateVisiblePages();
 
+  // Requests the data of the pages following the visible ones, once the
+  // visible pages are available.
+  void RequestPagesAfterVisiblePages();
+
   // Returns true iff the given page index is visible.  CalculateVisiblePages
   // must have been called first.
   bool IsPageVisible(int index) const;
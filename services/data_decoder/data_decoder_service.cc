@@ -18,7 +18,17 @@
 
 namespace data_decoder {
 
-DataDecoderService::DataDecoderService() = default;
+namespace {
+
+constexpr base::TimeDelta kDefaultIdleTimeout = base::TimeDelta::FromSeconds(5);
+
+}  // namespace
+
+DataDecoderService::DataDecoderService()
+    : DataDecoderService(kDefaultIdleTimeout) {}
+
+DataDecoderService::DataDecoderService(base::TimeDelta idle_timeout)
+    : idle_timeout_(idle_timeout) {}
 
 DataDecoderService::~DataDecoderService() = default;
 
@@ -27,10 +37,15 @@ std::unique_ptr<service_manager::Service> DataDecoderService::Create() {
   return std::make_unique<DataDecoderService>();
 }
 
+// static
+std::unique_ptr<service_manager::Service> DataDecoderService::Create(
+    base::TimeDelta idle_timeout) {
+  return std::make_unique<DataDecoderService>(idle_timeout);
+}
+
 void DataDecoderService::OnStart() {
-  constexpr int kMaxServiceIdleTimeInSeconds = 5;
   keepalive_ = std::make_unique<service_manager::ServiceKeepalive>(
-      context(), base::TimeDelta::FromSeconds(kMaxServiceIdleTimeInSeconds));
+      context(), idle_timeout_);
   registry_.AddInterface(base::BindRepeating(
       &DataDecoderService::BindImageDecoder, base::Unretained(this)));
   registry_.AddInterface(base::BindRepeating(
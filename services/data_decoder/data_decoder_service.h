@@ -8,6 +8,7 @@
 #include <memory>
 
 #include "base/macros.h"
+#include "base/time/time.h"
 #include "services/data_decoder/public/mojom/image_decoder.mojom.h"
 #include "services/data_decoder/public/mojom/json_parser.mojom.h"
 #include "services/data_decoder/public/mojom/xml_parser.mojom.h"
@@ -20,10 +21,16 @@ namespace data_decoder {
 class DataDecoderService : public service_manager::Service {
  public:
   DataDecoderService();
+  // |idle_timeout| is how long the service stays up once it has no more
+  // clients. Embedders which decode in bursts, e.g. icons at startup, can keep
+  // the process warm between bursts with a longer timeout.
+  explicit DataDecoderService(base::TimeDelta idle_timeout);
   ~DataDecoderService() override;
 
-  // Factory function for use as an embedded service.
+  // Factory functions for use as an embedded service.
   static std::unique_ptr<service_manager::Service> Create();
+  static std::unique_ptr<service_manager::Service> Create(
+      base::TimeDelta idle_timeout);
 
   // service_manager::Service:
   void OnStart() override;
@@ -36,6 +43,7 @@ class DataDecoderService : public service_manager::Service {
   void BindJsonParser(mojom::JsonParserRequest request);
   void BindXmlParser(mojom::XmlParserRequest request);
 
+  const base::TimeDelta idle_timeout_;
   service_manager::BinderRegistry registry_;
   std::unique_ptr<service_manager::ServiceKeepalive> keepalive_;
 
@@ -8,7 +8,9 @@
 
 #include <utility>
 
+#include "base/bind.h"
 #include "base/logging.h"
+#include "base/task_scheduler/post_task.h"
 #include "mojo/public/cpp/bindings/strong_binding.h"
 #include "skia/ext/image_operations.h"
 #include "third_party/blink/public/platform/web_data.h"
@@ -56,25 +58,11 @@ void ResizeImage(SkBitmap* decoded_image,
   }
 }
 
-}  // namespace
-
-ImageDecoderImpl::ImageDecoderImpl(
-    std::unique_ptr<service_manager::ServiceContextRef> service_ref)
-    : service_ref_(std::move(service_ref)) {}
-
-ImageDecoderImpl::~ImageDecoderImpl() = default;
-
-void ImageDecoderImpl::DecodeImage(const std::vector<uint8_t>& encoded_data,
-                                   mojom::ImageCodec codec,
-                                   bool shrink_to_fit,
-                                   int64_t max_size_in_bytes,
-                                   const gfx::Size& desired_image_frame_size,
-                                   DecodeImageCallback callback) {
-  if (encoded_data.size() == 0) {
-    std::move(callback).Run(SkBitmap());
-    return;
-  }
-
+SkBitmap DecodeImageOnWorker(const std::vector<uint8_t>& encoded_data,
+                              mojom::ImageCodec codec,
+                              bool shrink_to_fit,
+                              int64_t max_size_in_bytes,
+                              const gfx::Size& desired_image_frame_size) {
   SkBitmap decoded_image;
 #if defined(OS_CHROMEOS)
   if (codec == mojom::ImageCodec::ROBUST_JPEG) {
@@ -107,19 +95,13 @@ void ImageDecoderImpl::DecodeImage(const std::vector<uint8_t>& encoded_data,
 
   if (!decoded_image.isNull())
     ResizeImage(&decoded_image, shrink_to_fit, max_size_in_bytes);
-
-  std::move(callback).Run(decoded_image);
+  return decoded_image;
 }
 
-void ImageDecoderImpl::DecodeAnimation(const std::vector<uint8_t>& encoded_data,
-                                       bool shrink_to_fit,
-                                       int64_t max_size_in_bytes,
-                                       DecodeAnimationCallback callback) {
-  if (encoded_data.size() == 0) {
-    std::move(callback).Run(std::vector<mojom::AnimationFramePtr>());
-    return;
-  }
-
+std::vector<mojom::AnimationFramePtr> DecodeAnimationOnWorker(
+    const std::vector<uint8_t>& encoded_data,
+    bool shrink_to_fit,
+    int64_t max_size_in_bytes) {
   auto frames = blink::WebImage::AnimationFromData(blink::WebData(
       reinterpret_cast<const char*>(encoded_data.data()), encoded_data.size()));
 
@@ -141,8 +123,55 @@ void ImageDecoderImpl::DecodeAnimation(const std::vector<uint8_t>& encoded_data,
 
     decoded_images.push_back(std::move(image_frame));
   }
+  return decoded_images;
+}
+
+// Decodes run on the task scheduler so that several of them, e.g. a batch of
+// favicons, proceed concurrently instead of queuing on the service's thread.
+constexpr base::TaskTraits kDecodeTaskTraits = {
+    base::TaskPriority::USER_VISIBLE,
+    base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN};
+
+}  // namespace
+
+ImageDecoderImpl::ImageDecoderImpl(
+    std::unique_ptr<service_manager::ServiceContextRef> service_ref)
+    : service_ref_(std::move(service_ref)) {}
+
+ImageDecoderImpl::~ImageDecoderImpl() = default;
+
+void ImageDecoderImpl::DecodeImage(const std::vector<uint8_t>& encoded_data,
+                                   mojom::ImageCodec codec,
+                                   bool shrink_to_fit,
+                                   int64_t max_size_in_bytes,
+                                   const gfx::Size& desired_image_frame_size,
+                                   DecodeImageCallback callback) {
+  if (encoded_data.size() == 0) {
+    std::move(callback).Run(SkBitmap());
+    return;
+  }
+
+  base::PostTaskWithTraitsAndReplyWithResult(
+      FROM_HERE, kDecodeTaskTraits,
+      base::BindOnce(&DecodeImageOnWorker, encoded_data, codec, shrink_to_fit,
+                     max_size_in_bytes, desired_image_frame_size),
+      std::move(callback));
+}
+
+void ImageDecoderImpl::DecodeAnimation(const std::vector<uint8_t>& encoded_data,
+                                       bool shrink_to_fit,
+                                       int64_t max_size_in_bytes,
+                                       DecodeAnimationCallback callback) {
+  if (encoded_data.size() == 0) {
+    std::move(callback).Run(std::vector<mojom::AnimationFramePtr>());
+    return;
+  }
 
-  std::move(callback).Run(std::move(decoded_images));
+  base::PostTaskWithTraitsAndReplyWithResult(
+      FROM_HERE, kDecodeTaskTraits,
+      base::BindOnce(&DecodeAnimationOnWorker, encoded_data, shrink_to_fit,
+                     max_size_in_bytes),
+      std::move(callback));
 }
 
 }  // namespace data_decoder
@@ -14,6 +14,8 @@
 
 namespace data_decoder {
 
+// Decodes images on the task scheduler, so that concurrent requests are
+// decoded in parallel. Replies are posted back to the binding's sequence.
 class ImageDecoderImpl : public mojom::ImageDecoder {
  public:
   explicit ImageDecoderImpl(
@@ -7,7 +7,8 @@
 
 #include "base/bind.h"
 #include "base/lazy_instance.h"
-#include "base/message_loop/message_loop.h"
+#include "base/run_loop.h"
+#include "base/test/scoped_task_environment.h"
 #include "gin/array_buffer.h"
 #include "gin/public/isolate_holder.h"
 #include "services/data_decoder/image_decoder_impl.h"
@@ -58,20 +59,33 @@ class Request {
  public:
   explicit Request(ImageDecoderImpl* decoder) : decoder_(decoder) {}
 
-  void DecodeImage(const std::vector<unsigned char>& image, bool shrink) {
+  // Starts decoding |image|. Decodes run on the task scheduler, so call
+  // WaitForResult() before looking at bitmap().
+  void StartDecodeImage(const std::vector<unsigned char>& image, bool shrink) {
     decoder_->DecodeImage(
         image, mojom::ImageCodec::DEFAULT, shrink, kTestMaxImageSize,
         gfx::Size(),  // Take the smallest frame (there's only one frame).
         base::Bind(&Request::OnRequestDone, base::Unretained(this)));
   }
 
+  void WaitForResult() { run_loop_.Run(); }
+
+  void DecodeImage(const std::vector<unsigned char>& image, bool shrink) {
+    StartDecodeImage(image, shrink);
+    WaitForResult();
+  }
+
   const SkBitmap& bitmap() const { return bitmap_; }
 
  private:
-  void OnRequestDone(const SkBitmap& result_image) { bitmap_ = result_image; }
+  void OnRequestDone(const SkBitmap& result_image) {
+    bitmap_ = result_image;
+    run_loop_.Quit();
+  }
 
   ImageDecoderImpl* decoder_;
   SkBitmap bitmap_;
+  base::RunLoop run_loop_;
 };
 
 // We need to ensure that Blink and V8 are initialized in order to use content's
@@ -114,7 +128,7 @@ class ImageDecoderImplTest : public testing::Test {
   ImageDecoderImpl* decoder() { return &decoder_; }
 
  private:
-  base::MessageLoop message_loop_;
+  base::test::ScopedTaskEnvironment scoped_task_environment_;
   ImageDecoderImpl decoder_;
 };
 
@@ -159,6 +173,24 @@ TEST_F(ImageDecoderImplTest, DecodeImageSizeLimit) {
   }
 }
 
+// Several decodes can be in flight at once.
+TEST_F(ImageDecoderImplTest, DecodeImagesConcurrently) {
+  constexpr int kNumRequests = 4;
+  std::vector<std::unique_ptr<Request>> requests;
+  for (int i = 0; i < kNumRequests; i++) {
+    std::vector<unsigned char> jpg;
+    ASSERT_TRUE(CreateJPEGImage(16 + i, 16, SK_ColorBLUE, &jpg));
+    requests.push_back(std::make_unique<Request>(decoder()));
+    requests.back()->StartDecodeImage(jpg, false);
+  }
+
+  for (int i = 0; i < kNumRequests; i++) {
+    requests[i]->WaitForResult();
+    ASSERT_FALSE(requests[i]->bitmap().isNull());
+    EXPECT_EQ(16 + i, requests[i]->bitmap().width());
+  }
+}
+
 TEST_F(ImageDecoderImplTest, DecodeImageFailed) {
   // The "jpeg" is just some "random" data;
   const char kRandomData[] = "u gycfy7xdjkhfgui bdui ";
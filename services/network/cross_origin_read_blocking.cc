@@ -4,6 +4,7 @@
 
 #include "services/network/cross_origin_read_blocking.h"
 
+#include <inttypes.h>
 #include <stddef.h>
 
 #include <algorithm>
@@ -17,10 +18,12 @@
 #include "base/metrics/histogram_macros.h"
 #include "base/strings/string_piece.h"
 #include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
 #include "net/base/mime_sniffer.h"
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
 #include "net/http/http_response_headers.h"
 #include "net/url_request/url_request.h"
+#include "services/network/cross_origin_read_blocking_decision_cache.h"
 #include "services/network/public/cpp/resource_response.h"
 #include "services/network/public/cpp/resource_response_info.h"
 
@@ -564,8 +567,10 @@ CrossOriginReadBlocking::ResponseAnalyzer::ResponseAnalyzer(
 
   should_block_based_on_headers_ =
       ShouldBlockBasedOnHeaders(request, response, excluded_initiator_scheme);
-  if (should_block_based_on_headers_ == kNeedToSniffMore)
+  if (should_block_based_on_headers_ == kNeedToSniffMore) {
     CreateSniffers();
+    decision_cache_key_ = GetDecisionCacheKey(request, response);
+  }
 }
 
 CrossOriginReadBlocking::ResponseAnalyzer::~ResponseAnalyzer() = default;
@@ -792,6 +797,62 @@ void CrossOriginReadBlocking::ResponseAnalyzer::SniffResponseBody(
   }
 }
 
+bool CrossOriginReadBlocking::ResponseAnalyzer::UseCachedSniffingResult(
+    CrossOriginReadBlockingDecisionCache* cache) {
+  DCHECK(cache);
+  if (!needs_sniffing() || decision_cache_key_.empty())
+    return false;
+  DCHECK_EQ(-1, bytes_read_for_sniffing_);
+
+  const CrossOriginReadBlockingDecisionCache::Entry* entry =
+      cache->Get(decision_cache_key_);
+  if (!entry)
+    return false;
+
+  found_blockable_content_ = entry->found_blockable_content;
+  found_parser_breaker_ = entry->found_parser_breaker;
+  sniffers_.clear();
+  used_cached_sniffing_result_ = true;
+  return true;
+}
+
+void CrossOriginReadBlocking::ResponseAnalyzer::CacheSniffingResult(
+    CrossOriginReadBlockingDecisionCache* cache) const {
+  DCHECK(cache);
+  if (!needs_sniffing() || decision_cache_key_.empty() ||
+      used_cached_sniffing_result_) {
+    return;
+  }
+
+  CrossOriginReadBlockingDecisionCache::Entry entry;
+  entry.found_blockable_content = found_blockable_content_;
+  entry.found_parser_breaker = found_parser_breaker_;
+  cache->Put(decision_cache_key_, entry);
+}
+
+std::string CrossOriginReadBlocking::ResponseAnalyzer::GetDecisionCacheKey(
+    const net::URLRequest& request,
+    const ResourceResponse& response) const {
+  // Without a strong validator, there's no telling whether the body is the
+  // same as the one that was sniffed before.
+  const net::HttpResponseHeaders* headers = response.head.headers.get();
+  if (!headers || !headers->HasStrongValidators())
+    return std::string();
+
+  std::string etag;
+  std::string last_modified;
+  headers->EnumerateHeader(nullptr, "ETag", &etag);
+  headers->EnumerateHeader(nullptr, "Last-Modified", &last_modified);
+
+  // The sniffers that are used depend on the MIME type, so it's part of the
+  // key. The Content-Length is too, as a cheap extra check that the body is
+  // the same.
+  return base::StringPrintf(
+      "%d\n%" PRId64 "\n%s\n%s\n%s", static_cast<int>(canonical_mime_type_),
+      content_length_, etag.c_str(), last_modified.c_str(),
+      request.url().spec().c_str());
+}
+
 bool CrossOriginReadBlocking::ResponseAnalyzer::ShouldAllow() const {
   switch (should_block_based_on_headers_) {
     case kAllow:
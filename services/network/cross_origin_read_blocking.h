@@ -27,6 +27,7 @@ class URLRequest;
 
 namespace network {
 
+class CrossOriginReadBlockingDecisionCache;
 struct ResourceResponse;
 
 // CrossOriginReadBlocking (CORB) implements response blocking
@@ -101,6 +102,17 @@ class COMPONENT_EXPORT(NETWORK_SERVICE) CrossOriginReadBlocking {
 
     bool found_parser_breaker() const { return found_parser_breaker_; }
 
+    // If the body needs sniffing and |cache| has the outcome of sniffing an
+    // identical response before, uses that outcome rather than sniffing the
+    // body again. Returns true if it did, in which case either ShouldAllow()
+    // or ShouldBlock() returns true.
+    bool UseCachedSniffingResult(CrossOriginReadBlockingDecisionCache* cache);
+
+    // Stores the outcome of sniffing in |cache|. Must only be called once
+    // sniffing is over, i.e. once the response was blocked or allowed, or the
+    // body was sniffed up to its end or up to net::kMaxBytesToSniff.
+    void CacheSniffingResult(CrossOriginReadBlockingDecisionCache* cache) const;
+
     class ConfirmationSniffer;
     class SimpleConfirmationSniffer;
     class FetchOnlyResourceSniffer;
@@ -128,6 +140,12 @@ class COMPONENT_EXPORT(NETWORK_SERVICE) CrossOriginReadBlocking {
     // if ShouldBlockBasedOnHeaders returns kNeedToSniffMore
     void CreateSniffers();
 
+    // Returns the key under which the outcome of sniffing the body of
+    // |response| is cached, or an empty string if it can't be cached because
+    // the response has no strong validator.
+    std::string GetDecisionCacheKey(const net::URLRequest& request,
+                                    const ResourceResponse& response) const;
+
     // Logs bytes read for sniffing, but only if sniffing actually happened.
     void LogBytesReadForSniffing();
 
@@ -146,6 +164,13 @@ class COMPONENT_EXPORT(NETWORK_SERVICE) CrossOriginReadBlocking {
     // resource request.
     int http_response_code_ = 0;
 
+    // Key of the sniffing outcome in the CrossOriginReadBlockingDecisionCache.
+    // Empty if the body doesn't need sniffing or the outcome can't be cached.
+    std::string decision_cache_key_;
+
+    // Whether the sniffing outcome came from the cache.
+    bool used_cached_sniffing_result_ = false;
+
     // The sniffers to be used.
     std::vector<std::unique_ptr<ConfirmationSniffer>> sniffers_;
 
@@ -0,0 +1,43 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "services/network/cross_origin_read_blocking_decision_cache.h"
+
+namespace network {
+
+const size_t CrossOriginReadBlockingDecisionCache::kDefaultMaxEntries = 1000;
+
+CrossOriginReadBlockingDecisionCache::CrossOriginReadBlockingDecisionCache(
+    size_t max_entries)
+    : entries_(max_entries) {}
+
+CrossOriginReadBlockingDecisionCache::~CrossOriginReadBlockingDecisionCache() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+}
+
+const CrossOriginReadBlockingDecisionCache::Entry*
+CrossOriginReadBlockingDecisionCache::Get(const std::string& key) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  auto it = entries_.Get(key);
+  if (it == entries_.end())
+    return nullptr;
+  return &it->second;
+}
+
+void CrossOriginReadBlockingDecisionCache::Put(const std::string& key,
+                                               const Entry& entry) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  DCHECK(!key.empty());
+
+  entries_.Put(key, entry);
+}
+
+void CrossOriginReadBlockingDecisionCache::Clear() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  entries_.Clear();
+}
+
+}  // namespace network
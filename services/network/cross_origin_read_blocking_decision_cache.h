@@ -0,0 +1,62 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SERVICES_NETWORK_CROSS_ORIGIN_READ_BLOCKING_DECISION_CACHE_H_
+#define SERVICES_NETWORK_CROSS_ORIGIN_READ_BLOCKING_DECISION_CACHE_H_
+
+#include <stddef.h>
+
+#include <string>
+
+#include "base/component_export.h"
+#include "base/containers/mru_cache.h"
+#include "base/macros.h"
+#include "base/sequence_checker.h"
+
+namespace network {
+
+// Remembers the outcome of sniffing the body of cross-origin responses for
+// Cross-Origin Read Blocking, so that loading the same resource again doesn't
+// have to hold back the body until it has been sniffed again.
+//
+// Entries are keyed by CrossOriginReadBlocking::ResponseAnalyzer, using the
+// URL, a validator and the other response properties that sniffing depends
+// on. Only the sniffing outcome is cached: the decision based on headers,
+// which depends on the initiator, is made anew for each response.
+//
+// There is one cache per NetworkContext.
+class COMPONENT_EXPORT(NETWORK_SERVICE) CrossOriginReadBlockingDecisionCache {
+ public:
+  struct Entry {
+    bool found_blockable_content;
+    bool found_parser_breaker;
+  };
+
+  // Default maximum number of entries.
+  static const size_t kDefaultMaxEntries;
+
+  explicit CrossOriginReadBlockingDecisionCache(size_t max_entries);
+  ~CrossOriginReadBlockingDecisionCache();
+
+  // Returns the entry for |key|, or nullptr if there is none. The returned
+  // pointer is invalidated by the next call to Put() or Clear().
+  const Entry* Get(const std::string& key);
+
+  void Put(const std::string& key, const Entry& entry);
+
+  void Clear();
+
+  size_t size() const { return entries_.size(); }
+
+ private:
+  base::MRUCache<std::string, Entry> entries_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+
+  DISALLOW_COPY_AND_ASSIGN(CrossOriginReadBlockingDecisionCache);
+};
+
+}  // namespace network
+
+#endif  // SERVICES_NETWORK_CROSS_ORIGIN_READ_BLOCKING_DECISION_CACHE_H_
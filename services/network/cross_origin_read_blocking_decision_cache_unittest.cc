@@ -0,0 +1,48 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "services/network/cross_origin_read_blocking_decision_cache.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace network {
+namespace {
+
+TEST(CrossOriginReadBlockingDecisionCacheTest, PutAndGet) {
+  CrossOriginReadBlockingDecisionCache cache(10);
+  EXPECT_FALSE(cache.Get("a"));
+
+  CrossOriginReadBlockingDecisionCache::Entry entry;
+  entry.found_blockable_content = true;
+  entry.found_parser_breaker = false;
+  cache.Put("a", entry);
+
+  const CrossOriginReadBlockingDecisionCache::Entry* result = cache.Get("a");
+  ASSERT_TRUE(result);
+  EXPECT_TRUE(result->found_blockable_content);
+  EXPECT_FALSE(result->found_parser_breaker);
+  EXPECT_FALSE(cache.Get("b"));
+
+  cache.Clear();
+  EXPECT_FALSE(cache.Get("a"));
+  EXPECT_EQ(0u, cache.size());
+}
+
+// The least recently used entry is evicted once the cache is full.
+TEST(CrossOriginReadBlockingDecisionCacheTest, Eviction) {
+  CrossOriginReadBlockingDecisionCache cache(2);
+  CrossOriginReadBlockingDecisionCache::Entry entry = {false, false};
+  cache.Put("a", entry);
+  cache.Put("b", entry);
+  EXPECT_TRUE(cache.Get("a"));
+
+  cache.Put("c", entry);
+  EXPECT_EQ(2u, cache.size());
+  EXPECT_TRUE(cache.Get("a"));
+  EXPECT_FALSE(cache.Get("b"));
+  EXPECT_TRUE(cache.Get("c"));
+}
+
+}  // namespace
+}  // namespace network
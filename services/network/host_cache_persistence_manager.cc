@@ -0,0 +1,175 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "services/network/host_cache_persistence_manager.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/metrics/histogram_macros.h"
+#include "base/values.h"
+#include "components/prefs/pref_registry_simple.h"
+#include "components/prefs/pref_service.h"
+#include "net/base/address_list.h"
+#include "net/base/host_port_pair.h"
+#include "net/base/net_errors.h"
+#include "net/log/net_log.h"
+
+namespace network {
+
+namespace {
+
+const char kPrefPath[] = "net.host_cache";
+
+}  // namespace
+
+// A hostname being resolved again after the cache was restored.
+struct HostCachePersistenceManager::Refresh {
+  net::AddressList addresses;
+  std::unique_ptr<net::HostResolver::Request> request;
+};
+
+const size_t HostCachePersistenceManager::kMaxRefreshes = 20;
+
+HostCachePersistenceManager::HostCachePersistenceManager(
+    net::HostCache* cache,
+    net::HostResolver* host_resolver,
+    PrefService* pref_service,
+    base::TimeDelta delay,
+    net::NetLog* net_log)
+    : cache_(cache),
+      host_resolver_(host_resolver),
+      pref_service_(pref_service),
+      delay_(delay),
+      net_log_(net::NetLogWithSource::Make(
+          net_log,
+          net::NetLogSourceType::HOST_CACHE_PERSISTENCE_MANAGER)),
+      weak_factory_(this) {
+  DCHECK(cache_);
+  DCHECK(host_resolver_);
+  DCHECK(pref_service_);
+
+  // The pref store is read asynchronously, so the cache may have to wait for
+  // it.
+  if (pref_service_->GetInitializationStatus() ==
+      PrefService::INITIALIZATION_STATUS_WAITING) {
+    pref_service_->AddPrefInitObserver(base::BindOnce(
+        [](base::WeakPtr<HostCachePersistenceManager> manager, bool) {
+          if (manager)
+            manager->ReadFromDisk();
+        },
+        weak_factory_.GetWeakPtr()));
+  } else {
+    ReadFromDisk();
+  }
+  cache_->set_persistence_delegate(this);
+}
+
+HostCachePersistenceManager::~HostCachePersistenceManager() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  timer_.Stop();
+  cache_->set_persistence_delegate(nullptr);
+}
+
+// static
+void HostCachePersistenceManager::RegisterPrefs(
+    PrefRegistrySimple* pref_registry) {
+  pref_registry->RegisterListPref(kPrefPath);
+}
+
+void HostCachePersistenceManager::ScheduleWrite() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  if (timer_.IsRunning())
+    return;
+
+  net_log_.AddEvent(net::NetLogEventType::HOST_CACHE_PERSISTENCE_START_TIMER);
+  timer_.Start(FROM_HERE, delay_,
+               base::Bind(&HostCachePersistenceManager::WriteToDisk,
+                          weak_factory_.GetWeakPtr()));
+}
+
+void HostCachePersistenceManager::ReadFromDisk() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  net_log_.BeginEvent(net::NetLogEventType::HOST_CACHE_PREF_READ);
+  const base::ListValue* pref_value = pref_service_->GetList(kPrefPath);
+  bool success = cache_->RestoreFromListValue(*pref_value);
+  net_log_.EndEvent(net::NetLogEventType::HOST_CACHE_PREF_READ,
+                    net::NetLog::BoolCallback("success", success));
+
+  UMA_HISTOGRAM_BOOLEAN("Net.DNS.HostCache.PersistedRestoreSuccess", success);
+  UMA_HISTOGRAM_COUNTS_1000("Net.DNS.HostCache.PersistedRestoreSize",
+                            pref_value->GetSize());
+
+  StartRefreshes();
+}
+
+void HostCachePersistenceManager::WriteToDisk() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  net_log_.AddEvent(net::NetLogEventType::HOST_CACHE_PREF_WRITE);
+  base::ListValue value;
+  cache_->GetAsListValue(&value, false);
+  pref_service_->Set(kPrefPath, value);
+}
+
+void HostCachePersistenceManager::StartRefreshes() {
+  // Restored entries are marked as received on an earlier network. Refresh
+  // positive ones only, since negative entries are likely to stay negative.
+  std::vector<const net::HostCache::EntryMap::value_type*> candidates;
+  for (const auto& key_and_entry : cache_->entries()) {
+    const net::HostCache::Entry& entry = key_and_entry.second;
+    if (entry.error() == net::OK &&
+        entry.network_changes() < cache_->network_changes()) {
+      candidates.push_back(&key_and_entry);
+    }
+  }
+
+  size_t num_refreshes = std::min(candidates.size(), kMaxRefreshes);
+  std::partial_sort(
+      candidates.begin(), candidates.begin() + num_refreshes, candidates.end(),
+      [](const net::HostCache::EntryMap::value_type* a,
+         const net::HostCache::EntryMap::value_type* b) {
+        return a->second.expires() > b->second.expires();
+      });
+  candidates.resize(num_refreshes);
+
+  for (const auto* key_and_entry : candidates) {
+    const net::HostCache::Key& key = key_and_entry->first;
+    // The port doesn't matter, since the result is only used to fill the
+    // cache.
+    net::HostResolver::RequestInfo info(net::HostPortPair(key.hostname, 80));
+    info.set_address_family(key.address_family);
+    info.set_host_resolver_flags(key.host_resolver_flags);
+    info.set_allow_cached_response(false);
+    info.set_is_speculative(true);
+
+    auto refresh = std::make_unique<Refresh>();
+    Refresh* refresh_ptr = refresh.get();
+    int rv = host_resolver_->Resolve(
+        info, net::IDLE, &refresh->addresses,
+        base::Bind(&HostCachePersistenceManager::OnRefreshComplete,
+                   base::Unretained(this), refresh_ptr),
+        &refresh->request, net_log_);
+    if (rv == net::ERR_IO_PENDING)
+      refreshes_.insert(std::move(refresh));
+  }
+
+  UMA_HISTOGRAM_COUNTS_100("Net.DNS.HostCache.PersistedRefreshes",
+                           num_refreshes);
+}
+
+void HostCachePersistenceManager::OnRefreshComplete(Refresh* refresh,
+                                                    int result) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  auto it = refreshes_.find(refresh);
+  DCHECK(it != refreshes_.end());
+  refreshes_.erase(it);
+}
+
+}  // namespace network
@@ -0,0 +1,98 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SERVICES_NETWORK_HOST_CACHE_PERSISTENCE_MANAGER_H_
+#define SERVICES_NETWORK_HOST_CACHE_PERSISTENCE_MANAGER_H_
+
+#include <memory>
+#include <set>
+
+#include "base/component_export.h"
+#include "base/containers/unique_ptr_adapters.h"
+#include "base/macros.h"
+#include "base/memory/weak_ptr.h"
+#include "base/sequence_checker.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "net/dns/host_cache.h"
+#include "net/dns/host_resolver.h"
+#include "net/log/net_log_with_source.h"
+
+class PrefRegistrySimple;
+class PrefService;
+
+namespace net {
+class NetLog;
+}
+
+namespace network {
+
+// Persists the contents of a HostCache in the pref store that also holds the
+// HttpServerProperties of a NetworkContext, so that the cache is warm after a
+// restart.
+//
+// Restored entries are stale, and are only returned to callers that accept
+// stale results. Once the entries are restored, the most recently resolved
+// hostnames are resolved again at IDLE priority, so that fresh results are
+// usually cached by the time they are first needed.
+//
+// Must be destroyed before the HostCache, the HostResolver and the PrefService.
+class COMPONENT_EXPORT(NETWORK_SERVICE) HostCachePersistenceManager
+    : public net::HostCache::PersistenceDelegate {
+ public:
+  // Maximum number of restored hostnames that are resolved again on startup.
+  static const size_t kMaxRefreshes;
+
+  // |cache| is the cache of |host_resolver|. |delay| is the maximum time
+  // between a change to the cache and the write of that change to prefs.
+  HostCachePersistenceManager(net::HostCache* cache,
+                              net::HostResolver* host_resolver,
+                              PrefService* pref_service,
+                              base::TimeDelta delay,
+                              net::NetLog* net_log);
+  ~HostCachePersistenceManager() override;
+
+  static void RegisterPrefs(PrefRegistrySimple* pref_registry);
+
+  // net::HostCache::PersistenceDelegate implementation:
+  void ScheduleWrite() override;
+
+  size_t num_pending_refreshes_for_testing() const {
+    return refreshes_.size();
+  }
+
+ private:
+  struct Refresh;
+
+  // Restores the cache from prefs, then starts refreshing restored entries.
+  void ReadFromDisk();
+  // Serializes the cache and writes it to prefs.
+  void WriteToDisk();
+
+  // Resolves the hostnames of up to kMaxRefreshes of the positive cache
+  // entries resolved before the current network, the ones that expire last
+  // first.
+  void StartRefreshes();
+  void OnRefreshComplete(Refresh* refresh, int result);
+
+  net::HostCache* const cache_;
+  net::HostResolver* const host_resolver_;
+  PrefService* const pref_service_;
+
+  const base::TimeDelta delay_;
+  base::OneShotTimer timer_;
+
+  std::set<std::unique_ptr<Refresh>, base::UniquePtrComparator> refreshes_;
+
+  const net::NetLogWithSource net_log_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+  base::WeakPtrFactory<HostCachePersistenceManager> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(HostCachePersistenceManager);
+};
+
+}  // namespace network
+
+#endif  // SERVICES_NETWORK_HOST_CACHE_PERSISTENCE_MANAGER_H_
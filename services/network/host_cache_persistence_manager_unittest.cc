@@ -0,0 +1,149 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "services/network/host_cache_persistence_manager.h"
+
+#include "base/run_loop.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/test/scoped_task_environment.h"
+#include "base/values.h"
+#include "components/prefs/testing_pref_service.h"
+#include "net/base/address_list.h"
+#include "net/base/ip_address.h"
+#include "net/base/net_errors.h"
+#include "net/dns/host_cache.h"
+#include "net/dns/mock_host_resolver.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace network {
+namespace {
+
+const char kPrefName[] = "net.host_cache";
+
+net::HostCache::Key MakeKey(const std::string& host) {
+  return net::HostCache::Key(host, net::ADDRESS_FAMILY_UNSPECIFIED, 0);
+}
+
+class HostCachePersistenceManagerTest : public testing::Test {
+ protected:
+  HostCachePersistenceManagerTest()
+      : scoped_task_environment_(
+            base::test::ScopedTaskEnvironment::MainThreadType::MOCK_TIME) {
+    HostCachePersistenceManager::RegisterPrefs(pref_service_.registry());
+    host_resolver_.set_ondemand_mode(true);
+  }
+
+  void MakePersistenceManager() {
+    persistence_manager_ = std::make_unique<HostCachePersistenceManager>(
+        host_resolver_.GetHostCache(), &host_resolver_, &pref_service_,
+        base::TimeDelta::FromSeconds(60), nullptr);
+  }
+
+  // Writes a cache with |num_positive| resolved hostnames and one failed one
+  // to prefs.
+  void InitializePref(size_t num_positive) {
+    net::HostCache temp_cache(100);
+    net::AddressList addresses = net::AddressList::CreateFromIPAddress(
+        net::IPAddress(1, 2, 3, 4), 0);
+    for (size_t i = 0; i < num_positive; ++i) {
+      temp_cache.Set(
+          MakeKey("host" + base::NumberToString(i)),
+          net::HostCache::Entry(net::OK, addresses,
+                                net::HostCache::Entry::SOURCE_DNS),
+          base::TimeTicks::Now(), base::TimeDelta::FromSeconds(i + 1));
+    }
+    temp_cache.Set(MakeKey("failed"),
+                   net::HostCache::Entry(net::ERR_NAME_NOT_RESOLVED,
+                                         net::AddressList(),
+                                         net::HostCache::Entry::SOURCE_DNS),
+                   base::TimeTicks::Now(), base::TimeDelta::FromSeconds(60));
+
+    base::ListValue value;
+    temp_cache.GetAsListValue(&value, false);
+    pref_service_.Set(kPrefName, value);
+  }
+
+  size_t PrefSize() {
+    const base::Value* value = pref_service_.GetUserPref(kPrefName);
+    return value ? value->GetList().size() : 0;
+  }
+
+  base::test::ScopedTaskEnvironment scoped_task_environment_;
+
+  // The HostResolver and PrefService have to outlive the
+  // HostCachePersistenceManager.
+  net::MockCachingHostResolver host_resolver_;
+  TestingPrefServiceSimple pref_service_;
+  std::unique_ptr<HostCachePersistenceManager> persistence_manager_;
+};
+
+// Restored positive entries are resolved again, and the fresh results replace
+// them in the cache.
+TEST_F(HostCachePersistenceManagerTest, RestoreAndRefresh) {
+  InitializePref(2);
+  MakePersistenceManager();
+
+  net::HostCache* cache = host_resolver_.GetHostCache();
+  EXPECT_EQ(3u, cache->size());
+  // Restored entries are stale.
+  EXPECT_FALSE(cache->Lookup(MakeKey("host0"), base::TimeTicks::Now()));
+
+  // The negative entry isn't refreshed.
+  EXPECT_EQ(2u, persistence_manager_->num_pending_refreshes_for_testing());
+  EXPECT_EQ(2u, host_resolver_.num_resolve());
+  EXPECT_EQ(net::IDLE, host_resolver_.last_request_priority());
+
+  host_resolver_.ResolveAllPending();
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(0u, persistence_manager_->num_pending_refreshes_for_testing());
+  EXPECT_TRUE(cache->Lookup(MakeKey("host0"), base::TimeTicks::Now()));
+  EXPECT_TRUE(cache->Lookup(MakeKey("host1"), base::TimeTicks::Now()));
+}
+
+// Only the kMaxRefreshes entries that expire last are refreshed.
+TEST_F(HostCachePersistenceManagerTest, LimitRefreshes) {
+  size_t num_entries = HostCachePersistenceManager::kMaxRefreshes + 5;
+  InitializePref(num_entries);
+  MakePersistenceManager();
+
+  EXPECT_EQ(HostCachePersistenceManager::kMaxRefreshes,
+            persistence_manager_->num_pending_refreshes_for_testing());
+
+  host_resolver_.ResolveAllPending();
+  base::RunLoop().RunUntilIdle();
+  net::HostCache* cache = host_resolver_.GetHostCache();
+  EXPECT_FALSE(cache->Lookup(MakeKey("host0"), base::TimeTicks::Now()));
+  std::string last_host = "host" + base::NumberToString(num_entries - 1);
+  EXPECT_TRUE(cache->Lookup(MakeKey(last_host), base::TimeTicks::Now()));
+}
+
+// Destroying the manager cancels refreshes still in flight.
+TEST_F(HostCachePersistenceManagerTest, DestroyWithPendingRefreshes) {
+  InitializePref(2);
+  MakePersistenceManager();
+  EXPECT_EQ(2u, persistence_manager_->num_pending_refreshes_for_testing());
+
+  persistence_manager_.reset();
+  EXPECT_FALSE(host_resolver_.has_pending_requests());
+}
+
+// Changes to the cache are written to prefs once the delay has passed.
+TEST_F(HostCachePersistenceManagerTest, DelayedWrite) {
+  MakePersistenceManager();
+  EXPECT_EQ(0u, PrefSize());
+
+  host_resolver_.GetHostCache()->Set(
+      MakeKey("written"),
+      net::HostCache::Entry(net::OK, net::AddressList(),
+                            net::HostCache::Entry::SOURCE_DNS),
+      base::TimeTicks::Now(), base::TimeDelta::FromSeconds(60));
+
+  scoped_task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(59));
+  EXPECT_EQ(0u, PrefSize());
+  scoped_task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(1));
+  EXPECT_EQ(1u, PrefSize());
+}
+
+}  // namespace
+}  // namespace network
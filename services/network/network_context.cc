@@ -38,6 +38,7 @@
 #include "net/dns/host_cache.h"
 #include "net/dns/host_resolver.h"
 #include "net/dns/mapped_host_resolver.h"
+#include "net/extras/sqlite/cookie_crypto_delegate.h"
 #include "net/extras/sqlite/sqlite_channel_id_store.h"
 #include "net/extras/sqlite/sqlite_persistent_cookie_store.h"
 #include "net/http/failing_http_transaction_factory.h"
@@ -49,6 +50,7 @@
 #include "net/http/http_server_properties_manager.h"
 #include "net/http/http_transaction_factory.h"
 #include "net/proxy_resolution/proxy_config.h"
+#include "net/socket/ssl_client_socket.h"
 #include "net/ssl/channel_id_service.h"
 #include "net/ssl/default_channel_id_store.h"
 #include "net/traffic_annotation/network_traffic_annotation.h"
@@ -56,6 +58,7 @@
 #include "net/url_request/static_http_user_agent_settings.h"
 #include "net/url_request/url_request_context.h"
 #include "net/url_request/url_request_context_builder.h"
+#include "services/network/host_cache_persistence_manager.h"
 #include "services/network/http_server_properties_pref_delegate.h"
 #include "services/network/ignore_errors_cert_verifier.h"
 #include "services/network/mojo_net_log.h"
@@ -67,6 +70,7 @@
 #include "services/network/resource_scheduler_client.h"
 #include "services/network/restricted_cookie_manager.h"
 #include "services/network/ssl_config_service_mojo.h"
+#include "services/network/ssl_session_cache_persistence_manager.h"
 #include "services/network/throttling/network_conditions.h"
 #include "services/network/throttling/throttling_controller.h"
 #include "services/network/throttling/throttling_network_transaction_factory.h"
@@ -125,6 +129,32 @@ class WrappedTestingCertVerifier : public net::CertVerifier {
   }
 };
 
+// A CertVerifier that forwards all requests to the CertVerifier shared by all
+// NetworkContexts of a NetworkService, which must outlive it.
+class SharedCertVerifier : public net::CertVerifier {
+ public:
+  explicit SharedCertVerifier(net::CertVerifier* cert_verifier)
+      : cert_verifier_(cert_verifier) {}
+  ~SharedCertVerifier() override = default;
+
+  // CertVerifier implementation
+  int Verify(const RequestParams& params,
+             net::CRLSet* crl_set,
+             net::CertVerifyResult* verify_result,
+             const net::CompletionCallback& callback,
+             std::unique_ptr<Request>* out_req,
+             const net::NetLogWithSource& net_log) override {
+    return cert_verifier_->Verify(params, crl_set, verify_result, callback,
+                                  out_req, net_log);
+  }
+  bool SupportsOCSPStapling() override {
+    return cert_verifier_->SupportsOCSPStapling();
+  }
+
+ private:
+  net::CertVerifier* const cert_verifier_;
+};
+
 // Predicate function to determine if the given |domain| matches the
 // |filter_type| and |filter_domains| from a |mojom::ClearDataFilter|.
 bool MatchesDomainFilter(mojom::ClearDataFilter_Type filter_type,
@@ -235,6 +265,8 @@ NetworkContext::NetworkContext(
                                                     url_request_context_);
   resource_scheduler_ =
       std::make_unique<ResourceScheduler>(enable_resource_scheduler_);
+  MaybePersistHostCache();
+  MaybePersistSSLSessionCache();
 }
 
 // TODO(mmenke): Share URLRequestContextBulder configuration between two
@@ -264,6 +296,8 @@ NetworkContext::NetworkContext(
                                                     url_request_context_);
   resource_scheduler_ =
       std::make_unique<ResourceScheduler>(enable_resource_scheduler_);
+  MaybePersistHostCache();
+  MaybePersistSSLSessionCache();
 }
 
 NetworkContext::NetworkContext(NetworkService* network_service,
@@ -397,6 +431,8 @@ void NetworkContext::ClearNetworkingHistorySince(
   url_request_context_->transport_security_state()->DeleteAllDynamicDataSince(
       time);
 
+  corb_decision_cache_.Clear();
+
   url_request_context_->http_server_properties()->Clear(
       std::move(completion_callback));
 }
@@ -405,6 +441,10 @@ void NetworkContext::ClearHttpCache(base::Time start_time,
                                     base::Time end_time,
                                     mojom::ClearDataFilterPtr filter,
                                     ClearHttpCacheCallback callback) {
+  // The cache only has entries for URLs that were loaded, so it's cleared
+  // along with the HTTP cache, regardless of |filter|.
+  corb_decision_cache_.Clear();
+
   // It's safe to use Unretained below as the HttpCacheDataRemover is owner by
   // |this| and guarantees it won't call its callback if deleted.
   http_cache_data_removers_.push_back(HttpCacheDataRemover::CreateAndStart(
@@ -744,6 +784,8 @@ URLRequestContextOwner NetworkContext::ApplyContextParamsToBuilder(
     pref_service_factory.set_async(true);
     scoped_refptr<PrefRegistrySimple> pref_registry(new PrefRegistrySimple());
     HttpServerPropertiesPrefDelegate::RegisterPrefs(pref_registry.get());
+    HostCachePersistenceManager::RegisterPrefs(pref_registry.get());
+    SSLSessionCachePersistenceManager::RegisterPrefs(pref_registry.get());
     pref_service = pref_service_factory.Create(pref_registry.get());
 
     builder->SetHttpServerProperties(
@@ -897,6 +939,55 @@ URLRequestContextOwner NetworkContext::ApplyContextParamsToBuilder(
   return result;
 }
 
+void NetworkContext::MaybePersistHostCache() {
+  if (!base::FeatureList::IsEnabled(features::kPersistHostCache) ||
+      !url_request_context_owner_.pref_service) {
+    return;
+  }
+
+  // The HostResolver may be shared by all NetworkContexts, in which case only
+  // the first one that persists HttpServerProperties persists its cache.
+  net::HostResolver* host_resolver = url_request_context_->host_resolver();
+  net::HostCache* host_cache = host_resolver->GetHostCache();
+  if (!host_cache || host_cache->has_persistence_delegate())
+    return;
+
+  host_cache_persistence_manager_ =
+      std::make_unique<HostCachePersistenceManager>(
+          host_cache, host_resolver,
+          url_request_context_owner_.pref_service.get(),
+          base::TimeDelta::FromMinutes(1), network_service_->net_log());
+}
+
+void NetworkContext::MaybePersistSSLSessionCache() {
+  if (!base::FeatureList::IsEnabled(features::kPersistSSLSessionCache) ||
+      !url_request_context_owner_.pref_service) {
+    return;
+  }
+
+  // Sessions are only persisted on platforms where cookies are encrypted.
+  net::CookieCryptoDelegate* crypto_delegate =
+      cookie_config::GetCookieCryptoDelegate();
+  if (!crypto_delegate || !crypto_delegate->ShouldEncrypt())
+    return;
+
+  // The SSL session cache is shared by the whole process, so only the first
+  // NetworkContext that persists HttpServerProperties persists its sessions.
+  if (net::SSLClientSocket::HasSessionCachePersistenceDelegate())
+    return;
+
+  net::HttpNetworkSession* session =
+      url_request_context_->http_transaction_factory()->GetSession();
+  if (!session)
+    return;
+
+  ssl_session_cache_persistence_manager_ =
+      std::make_unique<SSLSessionCachePersistenceManager>(
+          session->ssl_session_cache_shard(),
+          url_request_context_owner_.pref_service.get(), crypto_delegate,
+          base::TimeDelta::FromMinutes(1));
+}
+
 void NetworkContext::OnHttpCacheCleared(ClearHttpCacheCallback callback,
                                         HttpCacheDataRemover* remover) {
   bool removed = false;
@@ -992,8 +1083,13 @@ URLRequestContextOwner NetworkContext::MakeURLRequestContext(
   if (g_cert_verifier_for_testing) {
     builder.SetCertVerifier(std::make_unique<WrappedTestingCertVerifier>());
   } else {
-    std::unique_ptr<net::CertVerifier> cert_verifier =
-        net::CertVerifier::CreateDefault();
+    std::unique_ptr<net::CertVerifier> cert_verifier;
+    if (network_service_->cert_verifier()) {
+      cert_verifier = std::make_unique<SharedCertVerifier>(
+          network_service_->cert_verifier());
+    } else {
+      cert_verifier = net::CertVerifier::CreateDefault();
+    }
     builder.SetCertVerifier(IgnoreErrorsCertVerifier::MaybeWrapCertVerifier(
         *command_line, nullptr, std::move(cert_verifier)));
   }
@@ -22,6 +22,7 @@
 #include "mojo/public/cpp/bindings/binding.h"
 #include "mojo/public/cpp/bindings/strong_binding_set.h"
 #include "services/network/cookie_manager.h"
+#include "services/network/cross_origin_read_blocking_decision_cache.h"
 #include "services/network/http_cache_data_remover.h"
 #include "services/network/public/mojom/network_context.mojom.h"
 #include "services/network/public/mojom/restricted_cookie_manager.mojom.h"
@@ -49,9 +50,11 @@ class STHReporter;
 }  // namespace certificate_transparency
 
 namespace network {
+class HostCachePersistenceManager;
 class NetworkService;
 class ResourceScheduler;
 class ResourceSchedulerClient;
+class SSLSessionCachePersistenceManager;
 class URLLoaderFactory;
 class URLRequestContextBuilderMojo;
 class WebSocketFactory;
@@ -115,6 +118,10 @@ class COMPONENT_EXPORT(NETWORK_SERVICE) NetworkContext
 
   ResourceScheduler* resource_scheduler() { return resource_scheduler_.get(); }
 
+  CrossOriginReadBlockingDecisionCache* corb_decision_cache() {
+    return &corb_decision_cache_;
+  }
+
   bool block_third_party_cookies() const { return block_third_party_cookies_; }
 
   // Creates a URLLoaderFactory with a ResourceSchedulerClient specified. This
@@ -223,6 +230,15 @@ class COMPONENT_EXPORT(NETWORK_SERVICE) NetworkContext
       std::unique_ptr<net::ReportSender>* out_certificate_report_sender,
       net::StaticHttpUserAgentSettings** out_http_user_agent_settings);
 
+  // Starts persisting the HostCache with the HttpServerProperties, if enabled
+  // and no other NetworkContext persists it already.
+  void MaybePersistHostCache();
+
+  // Starts persisting the SSL session cache with the HttpServerProperties, if
+  // enabled, sessions can be encrypted, and no other NetworkContext persists
+  // it already.
+  void MaybePersistSSLSessionCache();
+
   // Invoked when the HTTP cache was cleared. Invokes |callback|.
   void OnHttpCacheCleared(ClearHttpCacheCallback callback,
                           HttpCacheDataRemover* remover);
@@ -263,6 +279,10 @@ class COMPONENT_EXPORT(NETWORK_SERVICE) NetworkContext
 
   std::vector<std::unique_ptr<HttpCacheDataRemover>> http_cache_data_removers_;
 
+  // Must be above |url_loader_factories_|, as URLLoaders keep a pointer to it.
+  CrossOriginReadBlockingDecisionCache corb_decision_cache_{
+      CrossOriginReadBlockingDecisionCache::kDefaultMaxEntries};
+
   // This must be below |url_request_context_| so that the URLRequestContext
   // outlives all the URLLoaderFactories and URLLoaders that depend on it.
   std::set<std::unique_ptr<URLLoaderFactory>, base::UniquePtrComparator>
@@ -291,6 +311,15 @@ class COMPONENT_EXPORT(NETWORK_SERVICE) NetworkContext
       require_ct_delegate_;
   std::unique_ptr<certificate_transparency::TreeStateTracker> ct_tree_tracker_;
 
+  // Writes the HostCache to the pref service of |url_request_context_owner_|,
+  // so must be destroyed before it.
+  std::unique_ptr<HostCachePersistenceManager> host_cache_persistence_manager_;
+
+  // Writes TLS sessions to the pref service of |url_request_context_owner_|,
+  // so must be destroyed before it.
+  std::unique_ptr<SSLSessionCachePersistenceManager>
+      ssl_session_cache_persistence_manager_;
+
   DISALLOW_COPY_AND_ASSIGN(NetworkContext);
 };
 
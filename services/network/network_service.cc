@@ -9,6 +9,7 @@
 
 #include "base/bind.h"
 #include "base/command_line.h"
+#include "base/feature_list.h"
 #include "base/logging.h"
 #include "base/memory/ptr_util.h"
 #include "base/metrics/field_trial_params.h"
@@ -20,6 +21,7 @@
 #include "mojo/public/cpp/bindings/strong_binding.h"
 #include "net/base/logging_network_change_observer.h"
 #include "net/base/network_change_notifier.h"
+#include "net/cert/cert_verifier.h"
 #include "net/cert/ct_log_response_parser.h"
 #include "net/cert/signed_tree_head.h"
 #include "net/dns/host_resolver.h"
@@ -32,6 +34,7 @@
 #include "services/network/mojo_net_log.h"
 #include "services/network/network_context.h"
 #include "services/network/network_usage_accumulator.h"
+#include "services/network/public/cpp/features.h"
 #include "services/network/public/cpp/network_switches.h"
 #include "services/network/url_request_context_builder_mojo.h"
 
@@ -151,6 +154,8 @@ NetworkService::NetworkService(
 #endif
 
   host_resolver_ = CreateHostResolver(net_log_);
+  if (base::FeatureList::IsEnabled(features::kShareCertVerifier))
+    cert_verifier_ = net::CertVerifier::CreateDefault();
 
   network_usage_accumulator_ = std::make_unique<NetworkUsageAccumulator>();
   sth_distributor_ =
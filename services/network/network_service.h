@@ -24,6 +24,7 @@
 #include "services/service_manager/public/cpp/service.h"
 
 namespace net {
+class CertVerifier;
 class HostResolver;
 class LoggingNetworkChangeObserver;
 class NetworkQualityEstimator;
@@ -131,6 +132,9 @@ class COMPONENT_EXPORT(NETWORK_SERVICE) NetworkService
     return &keepalive_statistics_recorder_;
   }
   net::HostResolver* host_resolver() { return host_resolver_.get(); }
+  // Returns the CertVerifier shared by all NetworkContexts, or nullptr if each
+  // NetworkContext should create its own.
+  net::CertVerifier* cert_verifier() { return cert_verifier_.get(); }
   NetworkUsageAccumulator* network_usage_accumulator() {
     return network_usage_accumulator_.get();
   }
@@ -173,6 +177,11 @@ class COMPONENT_EXPORT(NETWORK_SERVICE) NetworkService
 
   std::unique_ptr<net::HostResolver> host_resolver_;
 
+  // Only created when features::kShareCertVerifier is enabled. Sharing it
+  // lets NetworkContexts reuse each other's cached verification results, and
+  // join each other's in-flight verifications of the same chain.
+  std::unique_ptr<net::CertVerifier> cert_verifier_;
+
   std::unique_ptr<NetworkUsageAccumulator> network_usage_accumulator_;
 
   // NetworkContexts created by CreateNetworkContext(). They call into the
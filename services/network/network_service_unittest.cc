@@ -7,6 +7,7 @@
 
 #include "base/run_loop.h"
 #include "base/strings/string_util.h"
+#include "base/test/scoped_feature_list.h"
 #include "base/test/scoped_task_environment.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "build/build_config.h"
@@ -17,6 +18,7 @@
 #include "net/traffic_annotation/network_traffic_annotation_test_helper.h"
 #include "services/network/network_context.h"
 #include "services/network/network_service.h"
+#include "services/network/public/cpp/features.h"
 #include "services/network/public/mojom/network_change_manager.mojom.h"
 #include "services/network/public/mojom/network_service.mojom.h"
 #include "services/network/test/test_url_loader_client.h"
@@ -97,6 +99,32 @@ TEST_F(NetworkServiceTest, CreateContextWithoutChannelID) {
   base::RunLoop().RunUntilIdle();
 }
 
+TEST_F(NetworkServiceTest, NoSharedCertVerifier) {
+  EXPECT_FALSE(service()->cert_verifier());
+}
+
+// NetworkContexts can be created and destroyed while they share the
+// CertVerifier of the NetworkService.
+TEST_F(NetworkServiceTest, SharedCertVerifier) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitFromCommandLine("ShareCertVerifier", std::string());
+  std::unique_ptr<NetworkService> service = NetworkService::CreateForTesting();
+  EXPECT_TRUE(service->cert_verifier());
+
+  mojom::NetworkContextPtr network_context1;
+  service->CreateNetworkContext(mojo::MakeRequest(&network_context1),
+                                CreateContextParams());
+  mojom::NetworkContextPtr network_context2;
+  service->CreateNetworkContext(mojo::MakeRequest(&network_context2),
+                                CreateContextParams());
+  network_context1.reset();
+  base::RunLoop().RunUntilIdle();
+
+  // The remaining NetworkContext is destroyed along with the service, before
+  // the CertVerifier.
+  service.reset();
+}
+
 namespace {
 
 class ServiceTestClient : public service_manager::test::ServiceTestClient,
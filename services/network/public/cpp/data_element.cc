@@ -60,6 +60,19 @@ void DataElement::SetToBlobRange(const std::string& blob_uuid,
   length_ = length;
 }
 
+void DataElement::SetToReadOnlySharedMemoryRegion(
+    base::ReadOnlySharedMemoryRegion region,
+    uint64_t offset,
+    uint64_t length) {
+  DCHECK(region.IsValid());
+  DCHECK_LE(offset, region.GetSize());
+  DCHECK_LE(length, region.GetSize() - offset);
+  type_ = TYPE_READ_ONLY_SHARED_MEMORY;
+  shared_memory_region_ = std::move(region);
+  offset_ = offset;
+  length_ = length;
+}
+
 void DataElement::SetToDataPipe(mojom::DataPipeGetterPtr data_pipe_getter) {
   DCHECK(data_pipe_getter);
   type_ = TYPE_DATA_PIPE;
@@ -123,6 +136,9 @@ void PrintTo(const DataElement& x, std::ostream* os) {
     case DataElement::TYPE_BLOB:
       *os << "TYPE_BLOB, uuid: " << x.blob_uuid();
       break;
+    case DataElement::TYPE_READ_ONLY_SHARED_MEMORY:
+      *os << "TYPE_READ_ONLY_SHARED_MEMORY";
+      break;
     case DataElement::TYPE_DATA_PIPE:
       *os << "TYPE_DATA_PIPE";
       break;
@@ -151,6 +167,8 @@ bool operator==(const DataElement& a, const DataElement& b) {
              a.expected_modification_time() == b.expected_modification_time();
     case DataElement::TYPE_BLOB:
       return a.blob_uuid() == b.blob_uuid();
+    case DataElement::TYPE_READ_ONLY_SHARED_MEMORY:
+      return false;
     case DataElement::TYPE_DATA_PIPE:
       return false;
     case DataElement::TYPE_CHUNKED_DATA_PIPE:
@@ -19,6 +19,7 @@
 #include "base/files/file_path.h"
 #include "base/gtest_prod_util.h"
 #include "base/logging.h"
+#include "base/memory/read_only_shared_memory_region.h"
 #include "base/time/time.h"
 #include "mojo/public/cpp/system/data_pipe.h"
 #include "services/network/public/mojom/chunked_data_pipe_getter.mojom.h"
@@ -47,6 +48,9 @@ class COMPONENT_EXPORT(NETWORK_CPP_BASE) DataElement {
 
     // Commonly used in every case:
     TYPE_BYTES,
+
+    // Only used for Upload with Network Service as of now:
+    TYPE_READ_ONLY_SHARED_MEMORY,
   };
 
   DataElement();
@@ -62,6 +66,9 @@ class COMPONENT_EXPORT(NETWORK_CPP_BASE) DataElement {
   const base::FilePath& path() const { return path_; }
   const base::File& file() const { return file_; }
   const std::string& blob_uuid() const { return blob_uuid_; }
+  const base::ReadOnlySharedMemoryRegion& shared_memory_region() const {
+    return shared_memory_region_;
+  }
   uint64_t offset() const { return offset_; }
   uint64_t length() const { return length_; }
   const base::Time& expected_modification_time() const {
@@ -150,6 +157,15 @@ class COMPONENT_EXPORT(NETWORK_CPP_BASE) DataElement {
                       uint64_t offset,
                       uint64_t length);
 
+  // Sets TYPE_READ_ONLY_SHARED_MEMORY data with range. The network service
+  // maps |region| and sends the bytes in it without copying them into a
+  // pipe first, so this is preferable to TYPE_BYTES or TYPE_DATA_PIPE for
+  // large bodies that are already in memory. |region| can't be modified once
+  // it's read-only, so the body can't change during the upload.
+  void SetToReadOnlySharedMemoryRegion(base::ReadOnlySharedMemoryRegion region,
+                                       uint64_t offset,
+                                       uint64_t length);
+
   // Sets TYPE_DATA_PIPE data. The data pipe consumer can safely wait for the
   // callback passed to Read() to be invoked before reading the request body.
   void SetToDataPipe(mojom::DataPipeGetterPtr data_pipe_getter);
@@ -189,6 +205,8 @@ class COMPONENT_EXPORT(NETWORK_CPP_BASE) DataElement {
   base::File file_;
   // For TYPE_BLOB.
   std::string blob_uuid_;
+  // For TYPE_READ_ONLY_SHARED_MEMORY.
+  base::ReadOnlySharedMemoryRegion shared_memory_region_;
   // For TYPE_DATA_PIPE.
   mojom::DataPipeGetterPtrInfo data_pipe_getter_;
   // For TYPE_CHUNKED_DATA_PIPE.
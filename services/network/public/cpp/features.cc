@@ -41,5 +41,29 @@ const base::Feature kThrottleDelayable{"ThrottleDelayable",
 const base::Feature kDelayRequestsOnMultiplexedConnections{
     "DelayRequestsOnMultiplexedConnections", base::FEATURE_DISABLED_BY_DEFAULT};
 
+// When kPersistHostCache is enabled, the HostCache is saved along with the
+// HttpServerProperties of the first NetworkContext that persists them, and is
+// restored and refreshed on startup.
+const base::Feature kPersistHostCache{"PersistHostCache",
+                                      base::FEATURE_DISABLED_BY_DEFAULT};
+
+// When kPersistSSLSessionCache is enabled, the TLS sessions of the first
+// NetworkContext that persists its HttpServerProperties are saved, encrypted,
+// along with them, and restored on startup.
+const base::Feature kPersistSSLSessionCache{"PersistSSLSessionCache",
+                                            base::FEATURE_DISABLED_BY_DEFAULT};
+
+// When kShareCertVerifier is enabled, all NetworkContexts verify certificates
+// with a single CertVerifier owned by the NetworkService, rather than each
+// creating its own, so they share its cache of verification results.
+const base::Feature kShareCertVerifier{"ShareCertVerifier",
+                                       base::FEATURE_DISABLED_BY_DEFAULT};
+
+// When kCrossOriginReadBlockingDecisionCache is enabled, each NetworkContext
+// remembers the outcome of CORB sniffing for responses with strong
+// validators, so that loading them again doesn't hold back the body.
+const base::Feature kCrossOriginReadBlockingDecisionCache{
+    "CrossOriginReadBlockingDecisionCache", base::FEATURE_DISABLED_BY_DEFAULT};
+
 }  // namespace features
 }  // namespace network
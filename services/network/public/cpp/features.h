@@ -25,6 +25,14 @@ COMPONENT_EXPORT(NETWORK_CPP)
 extern const base::Feature kThrottleDelayable;
 COMPONENT_EXPORT(NETWORK_CPP)
 extern const base::Feature kDelayRequestsOnMultiplexedConnections;
+COMPONENT_EXPORT(NETWORK_CPP)
+extern const base::Feature kPersistHostCache;
+COMPONENT_EXPORT(NETWORK_CPP)
+extern const base::Feature kPersistSSLSessionCache;
+COMPONENT_EXPORT(NETWORK_CPP)
+extern const base::Feature kShareCertVerifier;
+COMPONENT_EXPORT(NETWORK_CPP)
+extern const base::Feature kCrossOriginReadBlockingDecisionCache;
 
 }  // namespace features
 }  // namespace network
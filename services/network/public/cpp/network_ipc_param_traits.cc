@@ -541,6 +541,12 @@ void ParamTraits<network::DataElement>::Write(base::Pickle* m,
       WriteParam(m, p.length());
       break;
     }
+    case network::DataElement::TYPE_READ_ONLY_SHARED_MEMORY: {
+      WriteParam(m, p.shared_memory_region().Duplicate());
+      WriteParam(m, p.offset());
+      WriteParam(m, p.length());
+      break;
+    }
     case network::DataElement::TYPE_DATA_PIPE: {
       WriteParam(
           m, p.CloneDataPipeGetter().PassInterface().PassHandle().release());
@@ -625,6 +631,20 @@ bool ParamTraits<network::DataElement>::Read(const base::Pickle* m,
       r->SetToBlobRange(blob_uuid, offset, length);
       return true;
     }
+    case network::DataElement::TYPE_READ_ONLY_SHARED_MEMORY: {
+      base::ReadOnlySharedMemoryRegion region;
+      uint64_t offset, length;
+      if (!ReadParam(m, iter, &region) || !region.IsValid())
+        return false;
+      if (!ReadParam(m, iter, &offset))
+        return false;
+      if (!ReadParam(m, iter, &length))
+        return false;
+      if (offset > region.GetSize() || length > region.GetSize() - offset)
+        return false;
+      r->SetToReadOnlySharedMemoryRegion(std::move(region), offset, length);
+      return true;
+    }
     case network::DataElement::TYPE_DATA_PIPE: {
       network::mojom::DataPipeGetterPtr data_pipe_getter;
       mojo::MessagePipeHandle message_pipe;
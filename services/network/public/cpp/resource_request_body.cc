@@ -76,6 +76,18 @@ void ResourceRequestBody::AppendDataPipe(
   elements_.back().SetToDataPipe(std::move(data_pipe_getter));
 }
 
+void ResourceRequestBody::AppendReadOnlySharedMemoryRegion(
+    base::ReadOnlySharedMemoryRegion region,
+    uint64_t offset,
+    uint64_t length) {
+  DCHECK(elements_.empty() ||
+         elements_.front().type() != DataElement::TYPE_CHUNKED_DATA_PIPE);
+
+  elements_.push_back(DataElement());
+  elements_.back().SetToReadOnlySharedMemoryRegion(std::move(region), offset,
+                                                   length);
+}
+
 void ResourceRequestBody::SetToChunkedDataPipe(
     mojom::ChunkedDataPipeGetterPtr chunked_data_pipe_getter) {
   DCHECK(elements_.empty());
@@ -14,6 +14,7 @@
 #include "base/files/file.h"
 #include "base/files/file_path.h"
 #include "base/macros.h"
+#include "base/memory/read_only_shared_memory_region.h"
 #include "base/memory/ref_counted.h"
 #include "services/network/public/cpp/data_element.h"
 #include "url/gurl.h"
@@ -58,6 +59,13 @@ class COMPONENT_EXPORT(NETWORK_CPP_BASE) ResourceRequestBody
 
   void AppendDataPipe(mojom::DataPipeGetterPtr data_pipe_getter);
 
+  // Appends |length| bytes of |region| starting at |offset|. Large bodies
+  // that are already in memory should use this rather than AppendBytes(), so
+  // that they aren't copied when the body is sent over IPC.
+  void AppendReadOnlySharedMemoryRegion(base::ReadOnlySharedMemoryRegion region,
+                                        uint64_t offset,
+                                        uint64_t length);
+
   // |chunked_data_pipe_getter| will provide the upload body for a chunked
   // upload. Unlike the other methods, which support concatenating data of
   // various types, when this is called, |chunked_data_pipe_getter| will provide
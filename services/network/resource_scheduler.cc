@@ -6,6 +6,7 @@
 
 #include <stdint.h>
 
+#include <algorithm>
 #include <string>
 #include <utility>
 
@@ -68,6 +69,17 @@ const int kMaxRequestsBeforeYieldingDefault = 5;
 const char kYieldMsParam[] = "MaxYieldMs";
 const int kYieldMsDefault = 0;
 
+// When enabled, delayable requests are limited by an estimate of the response
+// bytes in flight rather than by their number. The budget is the
+// bandwidth-delay product estimated by the NetworkQualityEstimator, so more
+// requests are started on fast links and fewer on slow ones. The request
+// count limits still apply while there is no estimate.
+const base::Feature kBandwidthAwareResourceScheduling{
+    "BandwidthAwareResourceScheduling", base::FEATURE_DISABLED_BY_DEFAULT};
+// Response bytes assumed for a request whose size isn't known yet.
+const char kAssumedResponseBytesParam[] = "AssumedResponseBytes";
+const int kAssumedResponseBytesDefault = 32 * 1024;
+
 enum StartMode { START_SYNC, START_ASYNC };
 
 // Flags identifying various attributes of the request that are used
@@ -810,7 +822,10 @@ class ResourceScheduler::Client {
   //     to kMaxNumDelayableWhileLayoutBlockingPerClient.
   //   * If no high priority or layout-blocking requests are in flight, start
   //     loading delayable requests.
-  //   * Never exceed 10 delayable requests in flight per client.
+  //   * Never exceed 10 delayable requests in flight per client. With
+  //     kBandwidthAwareResourceScheduling and a network quality estimate,
+  //     never exceed the bandwidth-delay product in response bytes in flight
+  //     instead.
   //   * Never exceed 6 delayable requests for a given host.
 
   ShouldStartReqResult ShouldStartRequest(
@@ -858,13 +873,25 @@ class ResourceScheduler::Client {
       return START_REQUEST;
 
     // Delayable requests.
-    DCHECK_GE(in_flight_requests_.size(), in_flight_delayable_count_);
-    size_t num_non_delayable_requests_weighted = static_cast<size_t>(
-        params_for_network_quality_.non_delayable_weight *
-        (in_flight_requests_.size() - in_flight_delayable_count_));
-    if ((in_flight_delayable_count_ + num_non_delayable_requests_weighted >=
-         params_for_network_quality_.max_delayable_requests)) {
-      return DO_NOT_START_REQUEST_AND_STOP_SEARCHING;
+    base::Optional<int64_t> bytes_in_flight_budget = GetBytesInFlightBudget();
+    if (bytes_in_flight_budget) {
+      // At least one delayable request is always allowed, so that loading
+      // makes progress however slow the network is.
+      if (in_flight_delayable_count_ > 0 &&
+          EstimateBytesInFlight() +
+                  resource_scheduler_->assumed_response_bytes() >
+              bytes_in_flight_budget.value()) {
+        return DO_NOT_START_REQUEST_AND_STOP_SEARCHING;
+      }
+    } else {
+      DCHECK_GE(in_flight_requests_.size(), in_flight_delayable_count_);
+      size_t num_non_delayable_requests_weighted = static_cast<size_t>(
+          params_for_network_quality_.non_delayable_weight *
+          (in_flight_requests_.size() - in_flight_delayable_count_));
+      if ((in_flight_delayable_count_ + num_non_delayable_requests_weighted >=
+           params_for_network_quality_.max_delayable_requests)) {
+        return DO_NOT_START_REQUEST_AND_STOP_SEARCHING;
+      }
     }
 
     if (ReachedMaxRequestsPerHostPerClient(host_port_pair, supports_priority)) {
@@ -900,6 +927,40 @@ class ResourceScheduler::Client {
     return START_REQUEST;
   }
 
+  // Returns the number of response bytes that delayable requests may keep in
+  // flight, or nullopt if requests should be limited by their number.
+  base::Optional<int64_t> GetBytesInFlightBudget() const {
+    if (!resource_scheduler_->bandwidth_aware_scheduling_enabled() ||
+        !network_quality_estimator_) {
+      return base::nullopt;
+    }
+    base::Optional<int32_t> bandwidth_delay_product_kbits =
+        network_quality_estimator_->GetBandwidthDelayProductKbits();
+    if (!bandwidth_delay_product_kbits ||
+        bandwidth_delay_product_kbits.value() <= 0) {
+      return base::nullopt;
+    }
+    return static_cast<int64_t>(bandwidth_delay_product_kbits.value()) * 1000 /
+           8;
+  }
+
+  // Returns an estimate of the response bytes that the in-flight requests
+  // have yet to receive. Requests whose size isn't known yet are assumed to be
+  // |assumed_response_bytes()| long. The received byte count includes
+  // headers, which makes the estimate slightly low.
+  int64_t EstimateBytesInFlight() const {
+    int64_t bytes_in_flight = 0;
+    for (const ScheduledResourceRequestImpl* request : in_flight_requests_) {
+      const net::URLRequest* url_request = request->url_request();
+      int64_t expected_bytes = url_request->GetExpectedContentSize();
+      if (expected_bytes < 0)
+        expected_bytes = resource_scheduler_->assumed_response_bytes();
+      bytes_in_flight += std::max<int64_t>(
+          0, expected_bytes - url_request->GetTotalReceivedBytes());
+    }
+    return bytes_in_flight;
+  }
+
   // It is common for a burst of messages to come from the renderer which
   // trigger starting pending requests. Naively, this would result in O(n*m)
   // behavior for n pending requests and m <= n messages, as
@@ -1055,6 +1116,12 @@ ResourceScheduler::ResourceScheduler(bool enabled)
           base::GetFieldTrialParamByFeatureAsInt(kNetworkSchedulerYielding,
                                                  kYieldMsParam,
                                                  kYieldMsDefault))),
+      bandwidth_aware_scheduling_enabled_(
+          base::FeatureList::IsEnabled(kBandwidthAwareResourceScheduling)),
+      assumed_response_bytes_(base::GetFieldTrialParamByFeatureAsInt(
+          kBandwidthAwareResourceScheduling,
+          kAssumedResponseBytesParam,
+          kAssumedResponseBytesDefault)),
       task_runner_(base::ThreadTaskRunnerHandle::Get()) {
   // Don't run the two experiments together.
   if (priority_requests_delayable_ && head_priority_requests_delayable_)
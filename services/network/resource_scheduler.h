@@ -158,6 +158,10 @@ class COMPONENT_EXPORT(NETWORK_SERVICE) ResourceScheduler {
     return max_requests_before_yielding_;
   }
   base::TimeDelta yield_time() const { return yield_time_; }
+  bool bandwidth_aware_scheduling_enabled() const {
+    return bandwidth_aware_scheduling_enabled_;
+  }
+  int assumed_response_bytes() const { return assumed_response_bytes_; }
   base::SequencedTaskRunner* task_runner() { return task_runner_.get(); }
 
   // Testing setters
@@ -225,6 +229,12 @@ class COMPONENT_EXPORT(NETWORK_SERVICE) ResourceScheduler {
   int max_requests_before_yielding_;
   base::TimeDelta yield_time_;
 
+  // True if delayable requests are limited by the bandwidth-delay product
+  // rather than by their number. |assumed_response_bytes_| is the size used
+  // for responses whose length isn't known yet.
+  bool bandwidth_aware_scheduling_enabled_;
+  int assumed_response_bytes_;
+
   ResourceSchedulerParamsManager resource_scheduler_params_manager_;
 
   // The TaskRunner to post tasks on. Can be overridden for tests.
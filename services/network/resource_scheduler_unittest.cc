@@ -59,6 +59,9 @@ const char kPrioritySupportedRequestsDelayable[] =
 const char kHeadPrioritySupportedRequestsDelayable[] =
     "HeadPriorityRequestsDelayable";
 const char kNetworkSchedulerYielding[] = "NetworkSchedulerYielding";
+const char kBandwidthAwareResourceScheduling[] =
+    "BandwidthAwareResourceScheduling";
+const int kAssumedResponseBytes = 32 * 1024;
 const size_t kMaxNumDelayableRequestsPerHostPerClient = 6;
 
 void ConfigureYieldFieldTrial(
@@ -1169,6 +1172,85 @@ TEST_F(ResourceSchedulerTest, LimitedNumberOfDelayableRequestsInFlight) {
   EXPECT_FALSE(last_different_host->started());
 }
 
+// With the bandwidth-aware scheduler, delayable requests are limited by the
+// bandwidth-delay product. Requests that haven't started have no known size,
+// so each counts for kAssumedResponseBytes.
+TEST_F(ResourceSchedulerTest, BandwidthAwareLimitsBytesInFlight) {
+  base::test::ScopedFeatureList scoped_feature_list;
+  scoped_feature_list.InitFromCommandLine(kBandwidthAwareResourceScheduling,
+                                          kNetworkSchedulerYielding);
+  InitializeScheduler();
+  scheduler()->DeprecatedOnWillInsertBody(kChildId, kRouteId);
+
+  // Room for three responses of kAssumedResponseBytes.
+  network_quality_estimator_.set_bandwidth_delay_product_kbits(
+      3 * kAssumedResponseBytes * 8 / 1000 + 1);
+
+  std::vector<std::unique_ptr<TestRequest>> lows;
+  for (int i = 0; i < 4; ++i) {
+    string url = "http://host" + base::IntToString(i) + "/low";
+    lows.push_back(NewRequest(url.c_str(), net::LOWEST));
+  }
+  EXPECT_TRUE(lows[0]->started());
+  EXPECT_TRUE(lows[1]->started());
+  EXPECT_TRUE(lows[2]->started());
+  EXPECT_FALSE(lows[3]->started());
+
+  lows.erase(lows.begin());
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(lows.back()->started());
+}
+
+// A large bandwidth-delay product lets more delayable requests through than
+// the request count limit would, while the per-host limit still applies.
+TEST_F(ResourceSchedulerTest, BandwidthAwareExceedsRequestCountLimit) {
+  base::test::ScopedFeatureList scoped_feature_list;
+  scoped_feature_list.InitFromCommandLine(kBandwidthAwareResourceScheduling,
+                                          kNetworkSchedulerYielding);
+  InitializeScheduler();
+  scheduler()->DeprecatedOnWillInsertBody(kChildId, kRouteId);
+  network_quality_estimator_.set_bandwidth_delay_product_kbits(100000);
+
+  std::vector<std::unique_ptr<TestRequest>> lows;
+  for (int i = 0; i < 20; ++i) {
+    string url = "http://host" + base::IntToString(i) + "/low";
+    lows.push_back(NewRequest(url.c_str(), net::LOWEST));
+    EXPECT_TRUE(lows.back()->started());
+  }
+
+  for (size_t i = 0; i < kMaxNumDelayableRequestsPerHostPerClient; ++i) {
+    string url = "http://samehost/low" + base::NumberToString(i);
+    lows.push_back(NewRequest(url.c_str(), net::LOWEST));
+    EXPECT_TRUE(lows.back()->started());
+  }
+  std::unique_ptr<TestRequest> over_host_limit(
+      NewRequest("http://samehost/last", net::LOWEST));
+  EXPECT_FALSE(over_host_limit->started());
+}
+
+// Without a bandwidth-delay product estimate, the bandwidth-aware scheduler
+// uses the request count limit.
+TEST_F(ResourceSchedulerTest, BandwidthAwareWithoutEstimate) {
+  base::test::ScopedFeatureList scoped_feature_list;
+  scoped_feature_list.InitFromCommandLine(kBandwidthAwareResourceScheduling,
+                                          kNetworkSchedulerYielding);
+  InitializeScheduler();
+  scheduler()->DeprecatedOnWillInsertBody(kChildId, kRouteId);
+  ASSERT_FALSE(network_quality_estimator_.GetBandwidthDelayProductKbits());
+
+  const int kDefaultMaxNumDelayableRequestsPerClient =
+      10;  // Should match the .cc.
+  std::vector<std::unique_ptr<TestRequest>> lows;
+  for (int i = 0; i < kDefaultMaxNumDelayableRequestsPerClient; ++i) {
+    string url = "http://host" + base::IntToString(i) + "/low";
+    lows.push_back(NewRequest(url.c_str(), net::LOWEST));
+    EXPECT_TRUE(lows.back()->started());
+  }
+  std::unique_ptr<TestRequest> last(
+      NewRequest("http://host_new/last", net::LOWEST));
+  EXPECT_FALSE(last->started());
+}
+
 TEST_F(ResourceSchedulerTest, RaisePriorityAndStart) {
   // Dummies to enforce scheduling.
   std::unique_ptr<TestRequest> high(
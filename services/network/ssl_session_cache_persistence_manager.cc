@@ -0,0 +1,133 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "services/network/ssl_session_cache_persistence_manager.h"
+
+#include <memory>
+
+#include "base/base64.h"
+#include "base/bind.h"
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
+#include "base/metrics/histogram_macros.h"
+#include "base/values.h"
+#include "components/prefs/pref_registry_simple.h"
+#include "components/prefs/pref_service.h"
+#include "net/extras/sqlite/cookie_crypto_delegate.h"
+#include "net/socket/ssl_client_socket.h"
+
+namespace network {
+
+namespace {
+
+const char kPrefPath[] = "net.ssl_session_cache";
+
+}  // namespace
+
+const size_t SSLSessionCachePersistenceManager::kMaxPersistedSessions = 100;
+
+SSLSessionCachePersistenceManager::SSLSessionCachePersistenceManager(
+    const std::string& ssl_session_cache_shard,
+    PrefService* pref_service,
+    net::CookieCryptoDelegate* crypto_delegate,
+    base::TimeDelta delay)
+    : ssl_session_cache_shard_(ssl_session_cache_shard),
+      pref_service_(pref_service),
+      crypto_delegate_(crypto_delegate),
+      delay_(delay),
+      weak_factory_(this) {
+  DCHECK(!ssl_session_cache_shard_.empty());
+  DCHECK(pref_service_);
+  DCHECK(crypto_delegate_);
+
+  // The pref store is read asynchronously, so the cache may have to wait for
+  // it.
+  if (pref_service_->GetInitializationStatus() ==
+      PrefService::INITIALIZATION_STATUS_WAITING) {
+    pref_service_->AddPrefInitObserver(base::BindOnce(
+        [](base::WeakPtr<SSLSessionCachePersistenceManager> manager, bool) {
+          if (manager)
+            manager->ReadFromDisk();
+        },
+        weak_factory_.GetWeakPtr()));
+  } else {
+    ReadFromDisk();
+  }
+  net::SSLClientSocket::SetSessionCachePersistenceDelegate(this);
+}
+
+SSLSessionCachePersistenceManager::~SSLSessionCachePersistenceManager() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  timer_.Stop();
+  net::SSLClientSocket::SetSessionCachePersistenceDelegate(nullptr);
+}
+
+// static
+void SSLSessionCachePersistenceManager::RegisterPrefs(
+    PrefRegistrySimple* pref_registry) {
+  pref_registry->RegisterStringPref(kPrefPath, std::string());
+}
+
+void SSLSessionCachePersistenceManager::ScheduleWrite() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  if (timer_.IsRunning())
+    return;
+
+  timer_.Start(FROM_HERE, delay_,
+               base::Bind(&SSLSessionCachePersistenceManager::WriteToDisk,
+                          weak_factory_.GetWeakPtr()));
+}
+
+void SSLSessionCachePersistenceManager::ReadFromDisk() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  const std::string& encoded = pref_service_->GetString(kPrefPath);
+  if (encoded.empty())
+    return;
+
+  std::string encrypted;
+  std::string json;
+  std::unique_ptr<base::Value> value;
+  const base::ListValue* list = nullptr;
+  bool success = base::Base64Decode(encoded, &encrypted) &&
+                 crypto_delegate_->DecryptString(encrypted, &json);
+  if (success)
+    value = base::JSONReader::Read(json);
+  success = success && value && value->GetAsList(&list) &&
+            net::SSLClientSocket::RestoreSessionCacheFromListValue(
+                *list, ssl_session_cache_shard_);
+
+  UMA_HISTOGRAM_BOOLEAN("Net.SSLSessionCache.PersistedRestoreSuccess",
+                        success);
+  if (list) {
+    UMA_HISTOGRAM_COUNTS_1000("Net.SSLSessionCache.PersistedRestoreSize",
+                              list->GetSize());
+  }
+}
+
+void SSLSessionCachePersistenceManager::WriteToDisk() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  base::ListValue list;
+  net::SSLClientSocket::GetSessionCacheAsListValue(
+      ssl_session_cache_shard_, kMaxPersistedSessions, &list);
+
+  // Sessions are never written unencrypted, so clear the pref rather than
+  // leaving stale sessions behind if encryption fails.
+  std::string json;
+  std::string encrypted;
+  if (list.empty() || !base::JSONWriter::Write(list, &json) ||
+      !crypto_delegate_->EncryptString(json, &encrypted)) {
+    pref_service_->ClearPref(kPrefPath);
+    return;
+  }
+
+  std::string encoded;
+  base::Base64Encode(encrypted, &encoded);
+  pref_service_->SetString(kPrefPath, encoded);
+}
+
+}  // namespace network
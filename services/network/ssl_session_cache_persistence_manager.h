@@ -0,0 +1,84 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SERVICES_NETWORK_SSL_SESSION_CACHE_PERSISTENCE_MANAGER_H_
+#define SERVICES_NETWORK_SSL_SESSION_CACHE_PERSISTENCE_MANAGER_H_
+
+#include <stddef.h>
+
+#include <string>
+
+#include "base/component_export.h"
+#include "base/macros.h"
+#include "base/memory/weak_ptr.h"
+#include "base/sequence_checker.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "net/ssl/ssl_client_session_cache.h"
+
+class PrefRegistrySimple;
+class PrefService;
+
+namespace net {
+class CookieCryptoDelegate;
+}
+
+namespace network {
+
+// Persists the TLS sessions of a NetworkContext in the pref store that also
+// holds its HttpServerProperties, so that the first connection to an origin
+// after a restart can resume a session instead of doing a full handshake.
+//
+// Sessions are secrets, so they are only written encrypted, with the same
+// delegate (backed by OSCrypt) that encrypts cookies. If the OSCrypt key
+// changes, the persisted sessions can no longer be decrypted and are dropped.
+// Each session keeps the lifetime the server gave it, and only the most
+// recently used kMaxPersistedSessions are written.
+//
+// The SSL session cache is shared by the whole process, and sessions are
+// restored into the shard of |ssl_session_cache_shard|. Must be destroyed
+// before the PrefService and the CookieCryptoDelegate.
+class COMPONENT_EXPORT(NETWORK_SERVICE) SSLSessionCachePersistenceManager
+    : public net::SSLClientSessionCache::PersistenceDelegate {
+ public:
+  // Maximum number of sessions written to prefs.
+  static const size_t kMaxPersistedSessions;
+
+  // |delay| is the maximum time between a change to the cache and the write
+  // of that change to prefs.
+  SSLSessionCachePersistenceManager(
+      const std::string& ssl_session_cache_shard,
+      PrefService* pref_service,
+      net::CookieCryptoDelegate* crypto_delegate,
+      base::TimeDelta delay);
+  ~SSLSessionCachePersistenceManager() override;
+
+  static void RegisterPrefs(PrefRegistrySimple* pref_registry);
+
+  // net::SSLClientSessionCache::PersistenceDelegate implementation:
+  void ScheduleWrite() override;
+
+ private:
+  // Decrypts the sessions in prefs and restores them into the cache.
+  void ReadFromDisk();
+  // Serializes and encrypts the sessions of the cache and writes them to
+  // prefs.
+  void WriteToDisk();
+
+  const std::string ssl_session_cache_shard_;
+  PrefService* const pref_service_;
+  net::CookieCryptoDelegate* const crypto_delegate_;
+
+  const base::TimeDelta delay_;
+  base::OneShotTimer timer_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+  base::WeakPtrFactory<SSLSessionCachePersistenceManager> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(SSLSessionCachePersistenceManager);
+};
+
+}  // namespace network
+
+#endif  // SERVICES_NETWORK_SSL_SESSION_CACHE_PERSISTENCE_MANAGER_H_
@@ -0,0 +1,121 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "services/network/ssl_session_cache_persistence_manager.h"
+
+#include <string.h>
+
+#include "base/base64.h"
+#include "base/strings/string_util.h"
+#include "base/test/metrics/histogram_tester.h"
+#include "base/test/scoped_task_environment.h"
+#include "components/prefs/testing_pref_service.h"
+#include "net/extras/sqlite/cookie_crypto_delegate.h"
+#include "net/socket/ssl_client_socket.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace network {
+namespace {
+
+const char kPrefName[] = "net.ssl_session_cache";
+const char kShard[] = "test_shard";
+const char kEncryptedPrefix[] = "encrypted:";
+
+// Marks encrypted strings with a prefix, so tests can tell whether a string
+// went through the delegate.
+class FakeCryptoDelegate : public net::CookieCryptoDelegate {
+ public:
+  bool ShouldEncrypt() override { return true; }
+
+  bool EncryptString(const std::string& plaintext,
+                     std::string* ciphertext) override {
+    *ciphertext = kEncryptedPrefix + plaintext;
+    return true;
+  }
+
+  bool DecryptString(const std::string& ciphertext,
+                     std::string* plaintext) override {
+    if (!base::StartsWith(ciphertext, kEncryptedPrefix,
+                          base::CompareCase::SENSITIVE)) {
+      return false;
+    }
+    *plaintext = ciphertext.substr(strlen(kEncryptedPrefix));
+    return true;
+  }
+};
+
+class SSLSessionCachePersistenceManagerTest : public testing::Test {
+ protected:
+  SSLSessionCachePersistenceManagerTest()
+      : scoped_task_environment_(
+            base::test::ScopedTaskEnvironment::MainThreadType::MOCK_TIME) {
+    SSLSessionCachePersistenceManager::RegisterPrefs(pref_service_.registry());
+  }
+
+  void MakePersistenceManager() {
+    persistence_manager_ = std::make_unique<SSLSessionCachePersistenceManager>(
+        kShard, &pref_service_, &crypto_delegate_,
+        base::TimeDelta::FromSeconds(60));
+  }
+
+  void SetPref(const std::string& stored) {
+    std::string encoded;
+    base::Base64Encode(stored, &encoded);
+    pref_service_.SetString(kPrefName, encoded);
+  }
+
+  base::test::ScopedTaskEnvironment scoped_task_environment_;
+
+  // The PrefService and the delegate have to outlive the
+  // SSLSessionCachePersistenceManager.
+  TestingPrefServiceSimple pref_service_;
+  FakeCryptoDelegate crypto_delegate_;
+  std::unique_ptr<SSLSessionCachePersistenceManager> persistence_manager_;
+};
+
+TEST_F(SSLSessionCachePersistenceManagerTest, Restore) {
+  base::HistogramTester histograms;
+  SetPref(std::string(kEncryptedPrefix) + "[]");
+  MakePersistenceManager();
+
+  histograms.ExpectUniqueSample("Net.SSLSessionCache.PersistedRestoreSuccess",
+                                true, 1);
+  histograms.ExpectUniqueSample("Net.SSLSessionCache.PersistedRestoreSize", 0,
+                                1);
+}
+
+// Sessions that can't be decrypted, e.g. because the OSCrypt key changed, are
+// dropped.
+TEST_F(SSLSessionCachePersistenceManagerTest, RestoreUndecryptable) {
+  base::HistogramTester histograms;
+  SetPref("[]");
+  MakePersistenceManager();
+
+  histograms.ExpectUniqueSample("Net.SSLSessionCache.PersistedRestoreSuccess",
+                                false, 1);
+}
+
+// Writes happen once the delay has passed. Since the cache has no sessions
+// for the shard, the stale pref is cleared.
+TEST_F(SSLSessionCachePersistenceManagerTest, DelayedWrite) {
+  SetPref(std::string(kEncryptedPrefix) + "[]");
+  MakePersistenceManager();
+
+  persistence_manager_->ScheduleWrite();
+  scoped_task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(59));
+  EXPECT_FALSE(pref_service_.GetString(kPrefName).empty());
+  scoped_task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(1));
+  EXPECT_TRUE(pref_service_.GetString(kPrefName).empty());
+}
+
+TEST_F(SSLSessionCachePersistenceManagerTest, Detach) {
+  MakePersistenceManager();
+  EXPECT_TRUE(net::SSLClientSocket::HasSessionCachePersistenceDelegate());
+
+  persistence_manager_.reset();
+  EXPECT_FALSE(net::SSLClientSocket::HasSessionCachePersistenceDelegate());
+}
+
+}  // namespace
+}  // namespace network
@@ -10,8 +10,11 @@
 #include <vector>
 
 #include "base/files/file.h"
+#include "base/memory/read_only_shared_memory_region.h"
+#include "base/memory/shared_memory_mapping.h"
 #include "base/memory/weak_ptr.h"
 #include "base/metrics/histogram_macros.h"
+#include "base/numerics/ranges.h"
 #include "base/task_scheduler/post_task.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "base/time/time.h"
@@ -21,11 +24,13 @@
 #include "net/base/upload_bytes_element_reader.h"
 #include "net/base/upload_file_element_reader.h"
 #include "net/cert/symantec_certs.h"
+#include "net/http/http_response_headers.h"
 #include "net/ssl/client_cert_store.h"
 #include "net/ssl/ssl_private_key.h"
 #include "net/url_request/url_request_context.h"
 #include "net/url_request/url_request_context_getter.h"
 #include "services/network/chunked_data_pipe_upload_data_stream.h"
+#include "services/network/cross_origin_read_blocking_decision_cache.h"
 #include "services/network/data_pipe_element_reader.h"
 #include "services/network/loader_util.h"
 #include "services/network/network_usage_accumulator.h"
@@ -41,9 +46,37 @@ namespace network {
 namespace {
 constexpr size_t kDefaultAllocationSize = 512 * 1024;
 
+// Bounds of the data pipe for a body of known length. The minimum leaves room
+// for net::kMaxBytesToSniff, which is sniffed before the pipe is handed to the
+// client.
+constexpr size_t kMinAllocationSize = 4 * 1024;
+constexpr size_t kLargeBodyAllocationSize = 2 * 1024 * 1024;
+
+// Bodies at least this long, e.g. downloads and media, get a
+// kLargeBodyAllocationSize pipe, so that a slow consumer doesn't stall the
+// read from the network as often.
+constexpr int64_t kLargeBodySize = 8 * kDefaultAllocationSize;
+
 // Cannot use 0, because this means "default" in mojo::edk::Core::CreateDataPipe
 constexpr size_t kBlockedBodyAllocationSize = 1;
 
+// Returns the capacity of the data pipe for the body of |request|. A body
+// whose length is known gets a pipe that fits it, so that small resources
+// don't hold on to kDefaultAllocationSize bytes. Content-Length is the
+// encoded size, so bodies with a content encoding, which may grow when
+// decoded, get the default size.
+size_t GetBodyAllocationSize(net::URLRequest* request) {
+  int64_t content_length = request->GetExpectedContentSize();
+  if (content_length < 0 || !request->response_headers() ||
+      request->response_headers()->HasHeader("Content-Encoding")) {
+    return kDefaultAllocationSize;
+  }
+  if (content_length >= kLargeBodySize)
+    return kLargeBodyAllocationSize;
+  return base::ClampToRange(static_cast<size_t>(content_length),
+                            kMinAllocationSize, kDefaultAllocationSize);
+}
+
 // TODO: this duplicates some of PopulateResourceResponse in
 // content/browser/loader/resource_loader.cc
 void PopulateResourceResponse(net::URLRequest* request,
@@ -109,6 +142,38 @@ class BytesElementReader : public net::UploadBytesElementReader {
   DISALLOW_COPY_AND_ASSIGN(BytesElementReader);
 };
 
+// A subclass of net::UploadBytesElementReader which reads from a mapping of
+// a read-only shared memory region, so large bodies reach the socket without
+// being copied into a data pipe first.
+class SharedMemoryElementReader : public net::UploadBytesElementReader {
+ public:
+  SharedMemoryElementReader(base::ReadOnlySharedMemoryMapping mapping,
+                            const DataElement& element)
+      : net::UploadBytesElementReader(
+            mapping.IsValid()
+                ? mapping.GetMemoryAs<char>() + element.offset()
+                : nullptr,
+            mapping.IsValid() ? element.length() : 0),
+        mapping_(std::move(mapping)) {
+    DCHECK_EQ(DataElement::TYPE_READ_ONLY_SHARED_MEMORY, element.type());
+  }
+
+  ~SharedMemoryElementReader() override {}
+
+  // net::UploadBytesElementReader:
+  int Init(net::CompletionOnceCallback callback) override {
+    // The region may fail to map, e.g. if the address space is exhausted.
+    if (!mapping_.IsValid())
+      return net::ERR_FAILED;
+    return net::UploadBytesElementReader::Init(std::move(callback));
+  }
+
+ private:
+  base::ReadOnlySharedMemoryMapping mapping_;
+
+  DISALLOW_COPY_AND_ASSIGN(SharedMemoryElementReader);
+};
+
 // A subclass of net::UploadFileElementReader which owns
 // ResourceRequestBody.
 // This class is necessary to ensure the BlobData and any attached shareable
@@ -192,6 +257,13 @@ std::unique_ptr<net::UploadDataStream> CreateUploadDataStream(
         CHECK(false) << "Network service always uses DATA_PIPE for blobs.";
         break;
       }
+      case DataElement::TYPE_READ_ONLY_SHARED_MEMORY: {
+        // The whole region is mapped, as MapAt() requires an aligned offset.
+        // The traits checked that the range is within the region.
+        element_readers.push_back(std::make_unique<SharedMemoryElementReader>(
+            element.shared_memory_region().Map(), element));
+        break;
+      }
       case DataElement::TYPE_DATA_PIPE: {
         element_readers.push_back(std::make_unique<DataPipeElementReader>(
             body, element.CloneDataPipeGetter()));
@@ -281,7 +353,8 @@ URLLoader::URLLoader(
     uint32_t request_id,
     scoped_refptr<ResourceSchedulerClient> resource_scheduler_client,
     base::WeakPtr<KeepaliveStatisticsRecorder> keepalive_statistics_recorder,
-    base::WeakPtr<NetworkUsageAccumulator> network_usage_accumulator)
+    base::WeakPtr<NetworkUsageAccumulator> network_usage_accumulator,
+    CrossOriginReadBlockingDecisionCache* corb_decision_cache)
     : url_request_context_(url_request_context),
       network_service_client_(network_service_client),
       delete_callback_(std::move(delete_callback)),
@@ -302,6 +375,7 @@ URLLoader::URLLoader(
       peer_closed_handle_watcher_(FROM_HERE,
                                   mojo::SimpleWatcher::ArmingPolicy::MANUAL,
                                   base::SequencedTaskRunnerHandle::Get()),
+      corb_decision_cache_(corb_decision_cache),
       report_raw_headers_(report_raw_headers),
       resource_scheduler_client_(std::move(resource_scheduler_client)),
       keepalive_statistics_recorder_(std::move(keepalive_statistics_recorder)),
@@ -573,7 +647,7 @@ void URLLoader::OnResponseStarted(net::URLRequest* url_request, int net_error) {
     raw_response_headers_ = nullptr;
   }
 
-  mojo::DataPipe data_pipe(kDefaultAllocationSize);
+  mojo::DataPipe data_pipe(GetBodyAllocationSize(url_request_.get()));
   response_body_stream_ = std::move(data_pipe.producer_handle);
   consumer_handle_ = std::move(data_pipe.consumer_handle);
   peer_closed_handle_watcher_.Watch(
@@ -597,6 +671,12 @@ void URLLoader::OnResponseStarted(net::URLRequest* url_request, int net_error) {
             *url_request_, *response_,
             factory_params_->corb_excluded_initiator_scheme);
     is_more_corb_sniffing_needed_ = corb_analyzer_->needs_sniffing();
+    // Skip sniffing if an identical response was sniffed before, so the
+    // body isn't held back.
+    if (is_more_corb_sniffing_needed_ && corb_decision_cache_ &&
+        corb_analyzer_->UseCachedSniffingResult(corb_decision_cache_)) {
+      is_more_corb_sniffing_needed_ = false;
+    }
     if (corb_analyzer_->ShouldBlock()) {
       DCHECK(!is_more_corb_sniffing_needed_);
       corb_analyzer_->LogBlockedResponse();
@@ -651,6 +731,10 @@ void URLLoader::ReadMore() {
     }
   }
 
+  // |buf| wraps the memory of the data pipe, so the net stack reads straight
+  // into it: for responses served from the disk cache without a content
+  // encoding, the simple cache reads the body from its file into the pipe,
+  // without an intermediate buffer.
   auto buf = base::MakeRefCounted<NetToMojoIOBuffer>(
       pending_write_.get(), pending_write_buffer_offset_);
   int bytes_read;
@@ -712,10 +796,12 @@ void URLLoader::DidRead(int num_bytes, bool completed_synchronously) {
       if (corb_analyzer_->ShouldBlock()) {
         corb_analyzer_->LogBlockedResponse();
         is_more_corb_sniffing_needed_ = false;
+        CacheCorbSniffingResult();
         BlockResponseForCorb();
       } else if (corb_analyzer_->ShouldAllow()) {
         corb_analyzer_->LogAllowedResponse();
         is_more_corb_sniffing_needed_ = false;
+        CacheCorbSniffingResult();
       }
     }
 
@@ -726,6 +812,9 @@ void URLLoader::DidRead(int num_bytes, bool completed_synchronously) {
       if (is_more_corb_sniffing_needed_) {
         corb_analyzer_->LogAllowedResponse();
         is_more_corb_sniffing_needed_ = false;
+        // A failed read means the body wasn't sniffed in full.
+        if (num_bytes >= 0)
+          CacheCorbSniffingResult();
       }
     }
 
@@ -953,6 +1042,11 @@ void URLLoader::RecordBodyReadFromNetBeforePausedIfNeeded() {
   }
 }
 
+void URLLoader::CacheCorbSniffingResult() {
+  if (corb_decision_cache_)
+    corb_analyzer_->CacheSniffingResult(corb_decision_cache_);
+}
+
 void URLLoader::BlockResponseForCorb() {
   // TODO(lukasza): https://crbug.com/846334: Need to make sure that the cache
   // is still populated in the prefetch case (e.g. the implementation of CORB in
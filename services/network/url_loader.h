@@ -37,6 +37,7 @@ class URLRequestContext;
 
 namespace network {
 
+class CrossOriginReadBlockingDecisionCache;
 class NetToMojoPendingBuffer;
 class NetworkUsageAccumulator;
 class KeepaliveStatisticsRecorder;
@@ -51,6 +52,8 @@ class COMPONENT_EXPORT(NETWORK_SERVICE) URLLoader
 
   // |delete_callback| tells the URLLoader's owner to destroy the URLLoader.
   // The URLLoader must be destroyed before the |url_request_context|.
+  // |corb_decision_cache| may be null, and must otherwise outlive the
+  // URLLoader.
   URLLoader(
       net::URLRequestContext* url_request_context,
       mojom::NetworkServiceClient* network_service_client,
@@ -65,7 +68,8 @@ class COMPONENT_EXPORT(NETWORK_SERVICE) URLLoader
       uint32_t request_id,
       scoped_refptr<ResourceSchedulerClient> resource_scheduler_client,
       base::WeakPtr<KeepaliveStatisticsRecorder> keepalive_statistics_recorder,
-      base::WeakPtr<NetworkUsageAccumulator> network_usage_accumulator);
+      base::WeakPtr<NetworkUsageAccumulator> network_usage_accumulator,
+      CrossOriginReadBlockingDecisionCache* corb_decision_cache);
   ~URLLoader() override;
 
   // mojom::URLLoader implementation:
@@ -121,6 +125,8 @@ class COMPONENT_EXPORT(NETWORK_SERVICE) URLLoader
   void RecordBodyReadFromNetBeforePausedIfNeeded();
   void ResumeStart();
   void BlockResponseForCorb();
+  // Called once CORB is done sniffing the response body.
+  void CacheCorbSniffingResult();
 
   net::URLRequestContext* url_request_context_;
   mojom::NetworkServiceClient* network_service_client_;
@@ -161,6 +167,7 @@ class COMPONENT_EXPORT(NETWORK_SERVICE) URLLoader
   std::unique_ptr<CrossOriginReadBlocking::ResponseAnalyzer> corb_analyzer_;
   bool did_corb_block_response_ = false;
   bool is_more_corb_sniffing_needed_ = false;
+  CrossOriginReadBlockingDecisionCache* const corb_decision_cache_;
   bool is_more_mime_sniffing_needed_ = false;
 
   std::unique_ptr<ResourceScheduler::ScheduledResourceRequest>
@@ -7,10 +7,12 @@
 #include <memory>
 #include <utility>
 
+#include "base/feature_list.h"
 #include "base/logging.h"
 #include "services/network/network_context.h"
 #include "services/network/network_service.h"
 #include "services/network/network_usage_accumulator.h"
+#include "services/network/public/cpp/features.h"
 #include "services/network/public/cpp/resource_request.h"
 #include "services/network/resource_scheduler_client.h"
 #include "services/network/url_loader.h"
@@ -131,7 +133,11 @@ void URLLoaderFactory::CreateLoaderAndStart(
       static_cast<net::NetworkTrafficAnnotationTag>(traffic_annotation),
       params_.get(), request_id, resource_scheduler_client_,
       std::move(keepalive_statistics_recorder),
-      std::move(network_usage_accumulator)));
+      std::move(network_usage_accumulator),
+      base::FeatureList::IsEnabled(
+          features::kCrossOriginReadBlockingDecisionCache)
+          ? context_->corb_decision_cache()
+          : nullptr));
 }
 
 void URLLoaderFactory::Clone(mojom::URLLoaderFactoryRequest request) {
@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include <stdint.h>
+#include <string.h>
 
 #include <limits>
 #include <list>
@@ -16,6 +17,7 @@
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/macros.h"
+#include "base/memory/read_only_shared_memory_region.h"
 #include "base/memory/ref_counted.h"
 #include "base/metrics/statistics_recorder.h"
 #include "base/path_service.h"
@@ -347,7 +349,8 @@ class URLLoaderTest : public testing::Test {
         mojo::MakeRequest(&loader), options, request, false,
         client_.CreateInterfacePtr(), TRAFFIC_ANNOTATION_FOR_TESTS, &params,
         0 /* request_id */, resource_scheduler_client(), nullptr,
-        nullptr /* network_usage_accumulator */);
+        nullptr /* network_usage_accumulator */,
+        nullptr /* corb_decision_cache */);
 
     ran_ = true;
 
@@ -860,7 +863,8 @@ TEST_F(URLLoaderTest, DestroyOnURLLoaderPipeClosed) {
       mojo::MakeRequest(&loader), 0, request, false,
       client()->CreateInterfacePtr(), TRAFFIC_ANNOTATION_FOR_TESTS, &params,
       0 /* request_id */, resource_scheduler_client(), nullptr,
-      nullptr /* network_usage_accumulator */);
+      nullptr /* network_usage_accumulator */,
+      nullptr /* corb_decision_cache */);
 
   // Run until the response body pipe arrives, to make sure that a live body
   // pipe does not result in keeping the loader alive when the URLLoader pipe is
@@ -912,7 +916,8 @@ TEST_F(URLLoaderTest, CloseResponseBodyConsumerBeforeProducer) {
       mojo::MakeRequest(&loader), 0, request, false,
       client()->CreateInterfacePtr(), TRAFFIC_ANNOTATION_FOR_TESTS, &params,
       0 /* request_id */, resource_scheduler_client(), nullptr,
-      nullptr /* network_usage_accumulator */);
+      nullptr /* network_usage_accumulator */,
+      nullptr /* corb_decision_cache */);
 
   client()->RunUntilResponseBodyArrived();
   EXPECT_TRUE(client()->has_received_response());
@@ -966,7 +971,8 @@ TEST_F(URLLoaderTest, PauseReadingBodyFromNetBeforeResponseHeaders) {
       mojo::MakeRequest(&loader), 0, request, false,
       client()->CreateInterfacePtr(), TRAFFIC_ANNOTATION_FOR_TESTS, &params,
       0 /* request_id */, resource_scheduler_client(), nullptr,
-      nullptr /* network_usage_accumulator */);
+      nullptr /* network_usage_accumulator */,
+      nullptr /* corb_decision_cache */);
 
   // Pausing reading response body from network stops future reads from the
   // underlying URLRequest. So no data should be sent using the response body
@@ -1042,7 +1048,8 @@ TEST_F(URLLoaderTest, PauseReadingBodyFromNetWhenReadIsPending) {
       mojo::MakeRequest(&loader), 0, request, false,
       client()->CreateInterfacePtr(), TRAFFIC_ANNOTATION_FOR_TESTS, &params,
       0 /* request_id */, resource_scheduler_client(), nullptr,
-      nullptr /* network_usage_accumulator */);
+      nullptr /* network_usage_accumulator */,
+      nullptr /* corb_decision_cache */);
 
   response_controller.WaitForRequest();
   response_controller.Send(
@@ -1107,7 +1114,8 @@ TEST_F(URLLoaderTest, ResumeReadingBodyFromNetAfterClosingConsumer) {
       mojo::MakeRequest(&loader), 0, request, false,
       client()->CreateInterfacePtr(), TRAFFIC_ANNOTATION_FOR_TESTS, &params,
       0 /* request_id */, resource_scheduler_client(), nullptr,
-      nullptr /* network_usage_accumulator */);
+      nullptr /* network_usage_accumulator */,
+      nullptr /* corb_decision_cache */);
 
   loader->PauseReadingBodyFromNet();
   loader.FlushForTesting();
@@ -1167,7 +1175,8 @@ TEST_F(URLLoaderTest, MultiplePauseResumeReadingBodyFromNet) {
       mojo::MakeRequest(&loader), 0, request, false,
       client()->CreateInterfacePtr(), TRAFFIC_ANNOTATION_FOR_TESTS, &params,
       0 /* request_id */, resource_scheduler_client(), nullptr,
-      nullptr /* network_usage_accumulator */);
+      nullptr /* network_usage_accumulator */,
+      nullptr /* corb_decision_cache */);
 
   // It is okay to call ResumeReadingBodyFromNet() even if there is no prior
   // PauseReadingBodyFromNet().
@@ -1223,6 +1232,25 @@ TEST_F(URLLoaderTest, UploadBytes) {
   EXPECT_EQ(kRequestBody, response_body);
 }
 
+TEST_F(URLLoaderTest, UploadReadOnlySharedMemoryRegion) {
+  const std::string kRequestBody = "Request Body";
+
+  base::MappedReadOnlyRegion region_and_mapping =
+      base::ReadOnlySharedMemoryRegion::Create(kRequestBody.length() + 3);
+  ASSERT_TRUE(region_and_mapping.IsValid());
+  memcpy(region_and_mapping.mapping.memory(), ("xx" + kRequestBody).c_str(),
+         kRequestBody.length() + 2);
+
+  scoped_refptr<ResourceRequestBody> request_body(new ResourceRequestBody());
+  request_body->AppendReadOnlySharedMemoryRegion(
+      std::move(region_and_mapping.region), 2, kRequestBody.length());
+  set_request_body(std::move(request_body));
+
+  std::string response_body;
+  EXPECT_EQ(net::OK, Load(test_server()->GetURL("/echo"), &response_body));
+  EXPECT_EQ(kRequestBody, response_body);
+}
+
 TEST_F(URLLoaderTest, UploadFile) {
   base::FilePath file_path = GetTestFilePath("simple_page.html");
 
@@ -1431,7 +1459,8 @@ TEST_F(URLLoaderTest, UploadChunkedDataPipe) {
       client()->CreateInterfacePtr(), TRAFFIC_ANNOTATION_FOR_TESTS, &params,
       0 /* request_id */, nullptr /* resource_scheduler_client */,
       nullptr /* keepalive_statistics_reporter */,
-      nullptr /* network_usage_accumulator */);
+      nullptr /* network_usage_accumulator */,
+      nullptr /* corb_decision_cache */);
 
   mojom::ChunkedDataPipeGetter::GetSizeCallback get_size_callback =
       data_pipe_getter.WaitForGetSize();
@@ -1497,7 +1526,8 @@ TEST_F(URLLoaderTest, RedirectModifiedHeaders) {
       mojo::MakeRequest(&loader), mojom::kURLLoadOptionNone, request, false,
       client()->CreateInterfacePtr(), TRAFFIC_ANNOTATION_FOR_TESTS, &params,
       0 /* request_id */, resource_scheduler_client(), nullptr,
-      nullptr /* network_usage_accumulator */);
+      nullptr /* network_usage_accumulator */,
+      nullptr /* corb_decision_cache */);
 
   client()->RunUntilRedirectReceived();
 
@@ -1618,7 +1648,8 @@ TEST_F(URLLoaderTest, ResourceSchedulerIntegration) {
         mojo::MakeRequest(&loaderInterfacePtr), 0, request, false,
         client.CreateInterfacePtr(), TRAFFIC_ANNOTATION_FOR_TESTS, &params,
         0 /* request_id */, resource_scheduler_client(), nullptr,
-        nullptr /* network_usage_accumulator */);
+        nullptr /* network_usage_accumulator */,
+        nullptr /* corb_decision_cache */);
 
     loaders.emplace_back(
         std::make_pair(std::move(url_loader), std::move(loaderInterfacePtr)));
@@ -1639,7 +1670,8 @@ TEST_F(URLLoaderTest, ResourceSchedulerIntegration) {
       mojo::MakeRequest(&loader_interface_ptr), 0, request, false,
       client()->CreateInterfacePtr(), TRAFFIC_ANNOTATION_FOR_TESTS, &params,
       0 /* request_id */, resource_scheduler_client(), nullptr,
-      nullptr /* network_usage_accumulator */);
+      nullptr /* network_usage_accumulator */,
+      nullptr /* corb_decision_cache */);
   base::RunLoop().RunUntilIdle();
 
   // Make sure that the ResourceScheduler throttles this request.
@@ -1674,7 +1706,8 @@ TEST_F(URLLoaderTest, ReadPipeClosedWhileReadTaskPosted) {
       mojo::MakeRequest(&loader), mojom::kURLLoadOptionNone, request, false,
       client()->CreateInterfacePtr(), TRAFFIC_ANNOTATION_FOR_TESTS, &params,
       0 /* request_id */, resource_scheduler_client(), nullptr,
-      nullptr /* network_usage_accumulator */);
+      nullptr /* network_usage_accumulator */,
+      nullptr /* corb_decision_cache */);
 
   client()->RunUntilResponseBodyArrived();
   client()->response_body_release();
@@ -1777,7 +1810,8 @@ TEST_F(URLLoaderTest, SetAuth) {
       mojo::MakeRequest(&loader), 0, request, false,
       client()->CreateInterfacePtr(), TRAFFIC_ANNOTATION_FOR_TESTS, &params,
       0 /* request_id */, resource_scheduler_client(), nullptr,
-      nullptr /* network_usage_accumulator */);
+      nullptr /* network_usage_accumulator */,
+      nullptr /* corb_decision_cache */);
   base::RunLoop().RunUntilIdle();
 
   ASSERT_TRUE(url_loader);
@@ -1818,7 +1852,8 @@ TEST_F(URLLoaderTest, CancelAuth) {
       mojo::MakeRequest(&loader), 0, request, false,
       client()->CreateInterfacePtr(), TRAFFIC_ANNOTATION_FOR_TESTS, &params,
       0 /* request_id */, resource_scheduler_client(), nullptr,
-      nullptr /* network_usage_accumulator */);
+      nullptr /* network_usage_accumulator */,
+      nullptr /* corb_decision_cache */);
   base::RunLoop().RunUntilIdle();
 
   ASSERT_TRUE(url_loader);
@@ -1860,7 +1895,8 @@ TEST_F(URLLoaderTest, TwoChallenges) {
       mojo::MakeRequest(&loader), 0, request, false,
       client()->CreateInterfacePtr(), TRAFFIC_ANNOTATION_FOR_TESTS, &params,
       0 /* request_id */, resource_scheduler_client(), nullptr,
-      nullptr /* network_usage_accumulator */);
+      nullptr /* network_usage_accumulator */,
+      nullptr /* corb_decision_cache */);
   base::RunLoop().RunUntilIdle();
 
   ASSERT_TRUE(url_loader);
@@ -1903,7 +1939,8 @@ TEST_F(URLLoaderTest, NoAuthRequiredForFavicon) {
       mojo::MakeRequest(&loader), 0, request, false,
       client()->CreateInterfacePtr(), TRAFFIC_ANNOTATION_FOR_TESTS, &params,
       0 /* request_id */, resource_scheduler_client(), nullptr,
-      nullptr /* network_usage_accumulator */);
+      nullptr /* network_usage_accumulator */,
+      nullptr /* corb_decision_cache */);
   base::RunLoop().RunUntilIdle();
 
   ASSERT_TRUE(url_loader);
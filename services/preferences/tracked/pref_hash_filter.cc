@@ -199,6 +199,12 @@ PrefFilter::OnWriteCallbackPair PrefHashFilter::FilterSerializeData(
   return callback_pair;
 }
 
+base::Optional<std::set<std::string>>
+PrefHashFilter::GetKeysModifiedOnSerialize() const {
+  // DictionaryHashStoreContents keeps all the hashes under "protection".
+  return std::set<std::string>{"protection"};
+}
+
 void PrefHashFilter::OnStoreDeletionFromDisk() {
   if (external_validation_hash_store_pair_) {
     external_validation_hash_store_pair_->second.get()->Reset();
@@ -91,6 +91,8 @@ class PrefHashFilter : public InterceptablePrefFilter {
   void FilterUpdate(const std::string& path) override;
   OnWriteCallbackPair FilterSerializeData(
       base::DictionaryValue* pref_store_contents) override;
+  base::Optional<std::set<std::string>> GetKeysModifiedOnSerialize()
+      const override;
 
   void OnStoreDeletionFromDisk() override;
 
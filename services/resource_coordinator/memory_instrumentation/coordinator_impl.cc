@@ -17,11 +17,13 @@
 #include "base/logging.h"
 #include "base/memory/ref_counted.h"
 #include "base/metrics/histogram_macros.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/threading/sequenced_task_runner_handle.h"
 #include "base/trace_event/memory_dump_manager.h"
 #include "base/trace_event/memory_dump_request_args.h"
 #include "base/trace_event/trace_event.h"
 #include "build/build_config.h"
+#include "services/resource_coordinator/memory_instrumentation/memory_dump_sampler.h"
 #include "services/resource_coordinator/memory_instrumentation/queued_request_dispatcher.h"
 #include "services/resource_coordinator/memory_instrumentation/switches.h"
 #include "services/resource_coordinator/public/cpp/memory_instrumentation/client_process_impl.h"
@@ -76,6 +78,16 @@ CoordinatorImpl::CoordinatorImpl(service_manager::Connector* connector)
 
   tracing_observer_ = std::make_unique<TracingObserver>(
       base::trace_event::TraceLog::GetInstance(), nullptr);
+
+  int sampling_budget_ms;
+  if (base::StringToInt(
+          base::CommandLine::ForCurrentProcess()->GetSwitchValueASCII(
+              switches::kMemoryDumpSamplingBudgetMs),
+          &sampling_budget_ms) &&
+      sampling_budget_ms >= 0) {
+    set_sampling_budget(
+        base::TimeDelta::FromMilliseconds(sampling_budget_ms));
+  }
 }
 
 CoordinatorImpl::~CoordinatorImpl() {
@@ -259,6 +271,8 @@ void CoordinatorImpl::UnregisterClientProcess(
             base::Unretained(this), pair.second->dump_guid));
   }
 
+  if (sampler_)
+    sampler_->RemoveClient(client_process);
   size_t num_deleted = clients_.erase(client_process);
   DCHECK(num_deleted == 1);
 }
@@ -361,6 +375,11 @@ void CoordinatorImpl::PerformNextQueuedGlobalMemoryDump() {
     clients.emplace_back(kv.second->client.get(), pid, kv.second->process_type);
   }
 
+  if (sampler_ && request->can_be_sampled()) {
+    request->sampled = true;
+    clients = sampler_->SampleClients(clients, request);
+  }
+
   auto chrome_callback = base::Bind(
       &CoordinatorImpl::OnChromeMemoryDumpResponse, base::Unretained(this));
   auto os_callback = base::Bind(&CoordinatorImpl::OnOSMemoryDumpResponse,
@@ -429,6 +448,9 @@ void CoordinatorImpl::OnChromeMemoryDumpResponse(
   auto* response = &request->responses[client];
   response->chrome_dump = std::move(chrome_memory_dump);
 
+  if (request->sampled && sampler_)
+    sampler_->AddCost(client, base::Time::Now() - request->start_time);
+
   if (!success) {
     request->failed_memory_dump_count++;
     VLOG(1) << "RequestGlobalMemoryDump() FAIL: NACK from client process";
@@ -575,6 +597,8 @@ void CoordinatorImpl::FinalizeGlobalMemoryDumpIfAllManagersReplied() {
   }
 
   QueuedRequestDispatcher::Finalize(request, tracing_observer_.get());
+  if (request->sampled && sampler_)
+    sampler_->TakeResponses(request);
 
   queued_memory_dump_requests_.pop_front();
   request = nullptr;
@@ -588,6 +612,10 @@ void CoordinatorImpl::FinalizeGlobalMemoryDumpIfAllManagersReplied() {
   }
 }
 
+void CoordinatorImpl::set_sampling_budget(base::TimeDelta budget) {
+  sampler_ = std::make_unique<MemoryDumpSampler>(budget);
+}
+
 CoordinatorImpl::ClientInfo::ClientInfo(
     const service_manager::Identity& identity,
     mojom::ClientProcessPtr client,
@@ -30,6 +30,8 @@ class Connector;
 
 namespace memory_instrumentation {
 
+class MemoryDumpSampler;
+
 // Memory instrumentation service. It serves two purposes:
 // - Handles a registry of the processes that have a memory instrumentation
 //   client library instance (../../public/cpp/memory).
@@ -149,6 +151,9 @@ class CoordinatorImpl : public Coordinator,
     client_process_timeout_ = client_process_timeout;
   }
 
+  // Enables sampled dumps, see MemoryDumpSampler.
+  void set_sampling_budget(base::TimeDelta budget);
+
   // Map of registered client processes.
   std::map<mojom::ClientProcess*, std::unique_ptr<ClientInfo>> clients_;
 
@@ -194,6 +199,9 @@ class CoordinatorImpl : public Coordinator,
   // Timeout for registered client processes to respond to dump requests.
   base::TimeDelta client_process_timeout_;
 
+  // When not null, background dumps only dump a subset of the processes.
+  std::unique_ptr<MemoryDumpSampler> sampler_;
+
   // When not null, can be queried for heap dumps.
   mojom::HeapProfilerPtr heap_profiler_;
 
@@ -24,6 +24,7 @@ ACTION_P(RunClosure, closure) {
 
 using ::testing::_;
 using ::testing::AllOf;
+using ::testing::Between;
 using ::testing::Contains;
 using ::testing::Eq;
 using ::testing::Field;
@@ -133,6 +134,10 @@ class CoordinatorImplTest : public testing::Test {
         base::TimeDelta::FromMilliseconds(5));
   }
 
+  void EnableSampling(base::TimeDelta budget) {
+    coordinator_->set_sampling_budget(budget);
+  }
+
  private:
   std::unique_ptr<NiceMock<FakeCoordinatorImpl>> coordinator_;
   base::MessageLoop message_loop_;
@@ -640,6 +645,51 @@ TEST_F(CoordinatorImplTest, GlobalMemoryDumpStruct) {
   run_loop.Run();
 }
 
+// With a zero budget, sampled dumps only dump the browser and the least
+// recently dumped child, and report the other children with their last dump.
+TEST_F(CoordinatorImplTest, SampledDumps) {
+  EnableSampling(base::TimeDelta());
+
+  NiceMock<MockClientProcess> browser_client(this, 1,
+                                             mojom::ProcessType::BROWSER);
+  NiceMock<MockClientProcess> renderer_client_1(this, 2,
+                                                mojom::ProcessType::RENDERER);
+  NiceMock<MockClientProcess> renderer_client_2(this, 3,
+                                                mojom::ProcessType::RENDERER);
+  for (MockClientProcess* client :
+       {&browser_client, &renderer_client_1, &renderer_client_2}) {
+    ON_CALL(*client, RequestOSMemoryDumpMock(_, _, _))
+        .WillByDefault(Invoke(
+            [](mojom::MemoryMapOption, const std::vector<base::ProcessId>& pids,
+               MockClientProcess::RequestOSMemoryDumpCallback& callback) {
+              base::flat_map<base::ProcessId, mojom::RawOSMemDumpPtr> results;
+              for (base::ProcessId pid : pids)
+                results[pid] = FillRawOSDump(pid);
+              std::move(callback).Run(true, std::move(results));
+            }));
+  }
+
+  EXPECT_CALL(browser_client, RequestChromeMemoryDumpMock(_, _)).Times(3);
+  EXPECT_CALL(renderer_client_1, RequestChromeMemoryDumpMock(_, _))
+      .Times(Between(1, 2));
+  EXPECT_CALL(renderer_client_2, RequestChromeMemoryDumpMock(_, _))
+      .Times(Between(1, 2));
+
+  // The second renderer is only reported once it has been dumped.
+  for (size_t expected_process_dumps : {2u, 3u, 3u}) {
+    base::RunLoop run_loop;
+    MockGlobalMemoryDumpCallback callback;
+    EXPECT_CALL(callback, OnCall(true, NotNull()))
+        .WillOnce(Invoke([&run_loop, expected_process_dumps](
+                             bool success, GlobalMemoryDump* global_dump) {
+          EXPECT_EQ(expected_process_dumps, global_dump->process_dumps.size());
+          run_loop.Quit();
+        }));
+    RequestGlobalMemoryDump(callback.Get());
+    run_loop.Run();
+  }
+}
+
 TEST_F(CoordinatorImplTest, VmRegionsForHeapProfiler) {
   base::RunLoop run_loop;
   // Not using a constexpr base::ProcessId because std:unordered_map<>
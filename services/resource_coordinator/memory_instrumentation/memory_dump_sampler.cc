@@ -0,0 +1,116 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "services/resource_coordinator/memory_instrumentation/memory_dump_sampler.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace memory_instrumentation {
+
+namespace {
+
+// Cost assumed for clients which have not replied to a sampled dump yet.
+constexpr base::TimeDelta kDefaultCost = base::TimeDelta::FromMilliseconds(20);
+
+}  // namespace
+
+MemoryDumpSampler::ClientState::ClientState() = default;
+MemoryDumpSampler::ClientState::~ClientState() = default;
+
+MemoryDumpSampler::MemoryDumpSampler(base::TimeDelta budget)
+    : budget_(budget) {}
+
+MemoryDumpSampler::~MemoryDumpSampler() = default;
+
+std::vector<MemoryDumpSampler::ClientInfo> MemoryDumpSampler::SampleClients(
+    const std::vector<ClientInfo>& clients,
+    QueuedRequest* request) {
+  // Clients which were never dumped have a null |last_dump_time| and come
+  // first.
+  std::vector<std::pair<const ClientInfo*, ClientState*>> candidates;
+  for (const ClientInfo& client_info : clients)
+    candidates.emplace_back(&client_info, &clients_[client_info.client]);
+  std::stable_sort(
+      candidates.begin(), candidates.end(),
+      [](const std::pair<const ClientInfo*, ClientState*>& a,
+         const std::pair<const ClientInfo*, ClientState*>& b) {
+        return a.second->last_dump_time < b.second->last_dump_time;
+      });
+
+  const base::TimeTicks now = base::TimeTicks::Now();
+  std::vector<ClientInfo> sampled;
+  base::TimeDelta total_cost;
+  bool sampled_child = false;
+  for (const auto& candidate : candidates) {
+    const ClientInfo* client_info = candidate.first;
+    ClientState& state = *candidate.second;
+    base::TimeDelta cost = state.cost.is_zero() ? kDefaultCost : state.cost;
+    bool is_browser = client_info->process_type == mojom::ProcessType::BROWSER;
+    // On Linux, the browser dumps the OS counters of all the other processes,
+    // so it is dumped every time.
+    if (is_browser || !sampled_child || total_cost + cost <= budget_) {
+      sampled.push_back(*client_info);
+      total_cost += cost;
+      sampled_child |= !is_browser;
+      state.last_dump_time = now;
+      continue;
+    }
+
+    if (!state.chrome_dump)
+      continue;
+    QueuedRequest::Response& response = request->responses[client_info->client];
+    response.process_id = client_info->pid;
+    response.process_type = client_info->process_type;
+    response.chrome_dump = std::move(state.chrome_dump);
+    if (state.os_dump)
+      response.os_dumps[base::kNullProcessId] = std::move(state.os_dump);
+  }
+  return sampled;
+}
+
+void MemoryDumpSampler::AddCost(mojom::ClientProcess* client,
+                                base::TimeDelta cost) {
+  auto it = clients_.find(client);
+  if (it == clients_.end())
+    return;
+  // Smooth the estimate, since a single reply can be delayed by unrelated
+  // work in the client.
+  base::TimeDelta& estimate = it->second.cost;
+  estimate = estimate.is_zero() ? cost : (estimate * 3 + cost) / 4;
+}
+
+void MemoryDumpSampler::TakeResponses(QueuedRequest* request) {
+  std::map<base::ProcessId, mojom::ClientProcess*> pid_to_client;
+  for (const auto& response : request->responses)
+    pid_to_client[response.second.process_id] = response.first;
+
+  for (auto& response : request->responses) {
+    auto it = clients_.find(response.first);
+    if (it == clients_.end())
+      continue;
+    if (response.second.chrome_dump)
+      it->second.chrome_dump = std::move(response.second.chrome_dump);
+
+    // On Linux, the browser's response holds the OS dumps of all the
+    // processes, keyed by pid.
+    for (auto& os_dump : response.second.os_dumps) {
+      base::ProcessId pid = os_dump.first == base::kNullProcessId
+                                ? response.second.process_id
+                                : os_dump.first;
+      auto client_it = pid_to_client.find(pid);
+      if (client_it == pid_to_client.end())
+        continue;
+      auto state_it = clients_.find(client_it->second);
+      if (state_it != clients_.end() && os_dump.second)
+        state_it->second.os_dump = std::move(os_dump.second);
+    }
+  }
+}
+
+void MemoryDumpSampler::RemoveClient(mojom::ClientProcess* client) {
+  clients_.erase(client);
+}
+
+}  // namespace memory_instrumentation
@@ -0,0 +1,69 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SERVICES_RESOURCE_COORDINATOR_MEMORY_INSTRUMENTATION_MEMORY_DUMP_SAMPLER_H_
+#define SERVICES_RESOURCE_COORDINATOR_MEMORY_INSTRUMENTATION_MEMORY_DUMP_SAMPLER_H_
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/time/time.h"
+#include "base/trace_event/process_memory_dump.h"
+#include "services/resource_coordinator/memory_instrumentation/queued_request.h"
+#include "services/resource_coordinator/memory_instrumentation/queued_request_dispatcher.h"
+
+namespace memory_instrumentation {
+
+// Keeps the cost of recurring background dumps bounded by dumping only a
+// rotating subset of the client processes each time.
+//
+// Each client's cost is estimated from how long it took to reply to previous
+// dumps. For every sampled dump, the clients that were dumped least recently
+// are picked until their estimated costs add up to the budget. The clients
+// that are skipped are reported with their most recent dump, so global totals
+// are extrapolated from the latest known state of every process.
+class MemoryDumpSampler {
+ public:
+  using ClientInfo = QueuedRequestDispatcher::ClientInfo;
+
+  explicit MemoryDumpSampler(base::TimeDelta budget);
+  ~MemoryDumpSampler();
+
+  // Returns the clients out of |clients| that should be dumped for |request|,
+  // and adds the last dumps of the other clients to |request|'s responses.
+  // The browser process and at least one other client are always dumped.
+  std::vector<ClientInfo> SampleClients(const std::vector<ClientInfo>& clients,
+                                        QueuedRequest* request);
+
+  // Records that |client| took |cost| to reply to a sampled dump.
+  void AddCost(mojom::ClientProcess* client, base::TimeDelta cost);
+
+  // Keeps the dumps of the finalized |request| to stand in for the clients
+  // that are skipped by the next dumps.
+  void TakeResponses(QueuedRequest* request);
+
+  void RemoveClient(mojom::ClientProcess* client);
+
+ private:
+  struct ClientState {
+    ClientState();
+    ~ClientState();
+
+    base::TimeTicks last_dump_time;
+    base::TimeDelta cost;
+    std::unique_ptr<base::trace_event::ProcessMemoryDump> chrome_dump;
+    mojom::RawOSMemDumpPtr os_dump;
+  };
+
+  const base::TimeDelta budget_;
+  std::map<mojom::ClientProcess*, ClientState> clients_;
+
+  DISALLOW_COPY_AND_ASSIGN(MemoryDumpSampler);
+};
+
+}  // namespace memory_instrumentation
+
+#endif  // SERVICES_RESOURCE_COORDINATOR_MEMORY_INSTRUMENTATION_MEMORY_DUMP_SAMPLER_H_
@@ -85,6 +85,14 @@ struct QueuedRequest {
     return args.dump_type == base::trace_event::MemoryDumpType::SUMMARY_ONLY;
   }
 
+  // Whether the request can be served by dumping only some of the processes.
+  // Only recurring background dumps which are not added to the trace qualify.
+  bool can_be_sampled() const {
+    return args.dump_type != MemoryDumpType::EXPLICITLY_TRIGGERED &&
+           args.level_of_detail == MemoryDumpLevelOfDetail::BACKGROUND &&
+           !args.add_to_trace && args.pid == base::kNullProcessId;
+  }
+
   const Args args;
   const uint64_t dump_guid;
   RequestGlobalMemoryDumpInternalCallback callback;
@@ -98,6 +106,10 @@ struct QueuedRequest {
   int failed_memory_dump_count = 0;
   bool dump_in_progress = false;
 
+  // Whether only some of the processes were dumped, the others being reported
+  // with their last dump. See MemoryDumpSampler.
+  bool sampled = false;
+
   // This field is set to |true| before a heap dump is requested, and set to
   // |false| after the heap dump has been added to the trace.
   bool heap_dump_in_progress = false;
@@ -11,5 +11,10 @@ namespace switches {
 const char kEnableChromeTracingComputation[] =
     "enable-chrome-tracing-computation";
 
+// Dumps only a rotating subset of the processes for background dumps which
+// are not traced, such that their estimated cost stays within the given
+// number of milliseconds.
+const char kMemoryDumpSamplingBudgetMs[] = "memory-dump-sampling-budget-ms";
+
 }  // namespace switches
 }  // namespace memory_instrumentation
\ No newline at end of file
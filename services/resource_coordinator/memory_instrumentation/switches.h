@@ -11,6 +11,7 @@ namespace switches {
 // All switches in alphabetical order. The switches should be documented
 // alongside the definition of their values in the .cc file.
 extern const char kEnableChromeTracingComputation[];
+extern const char kMemoryDumpSamplingBudgetMs[];
 
 }  // namespace switches
 }  // namespace memory_instrumentation
@@ -78,6 +78,10 @@ class Coordinator::TraceStreamer : public base::SupportsWeakPtr<TraceStreamer> {
         MakeRequest(&ptr), type,
         base::BindRepeating(&Coordinator::TraceStreamer::OnRecorderDataChange,
                             AsWeakPtr(), label));
+    // Only the data of |agent_label_| is streamed when it is set, so the other
+    // agents' chunks are not kept around until flushing is done.
+    if (!agent_label_.empty() && label != agent_label_)
+      recorder->set_discard_data(true);
     recorders_[label].insert(std::move(recorder));
     DCHECK(type != mojom::TraceDataType::STRING ||
            recorders_[label].size() == 1);
@@ -109,12 +113,21 @@ class Coordinator::TraceStreamer : public base::SupportsWeakPtr<TraceStreamer> {
 
  private:
   // Handles synchronize writes to |stream_|, if the stream is not already
-  // closed.
+  // closed. Writes block while the pipe is full, so the consumer paces how
+  // fast recorders are drained.
   void WriteToStream(const std::string& data) {
     if (stream_.is_valid())
       mojo::BlockingCopyFromString(data, stream_);
   }
 
+  // Writes |prefix| followed by |data| without concatenating them, since
+  // |data| can hold many megabytes of trace events.
+  void WriteToStream(const std::string& prefix, const std::string& data) {
+    if (!prefix.empty())
+      WriteToStream(prefix);
+    WriteToStream(data);
+  }
+
   // Called from |background_task_runner_|.
   void OnRecorderDataChange(const std::string& label) {
     // Bail out if we are in the middle of writing events for another label to
@@ -172,8 +185,6 @@ class Coordinator::TraceStreamer : public base::SupportsWeakPtr<TraceStreamer> {
         (*recorders_[streaming_label_].begin())->data_type();
     for (const auto& recorder : recorders_[streaming_label_]) {
       waiting_for_agents |= recorder->is_recording();
-      if (!agent_label_.empty() && streaming_label_ != agent_label_)
-        recorder->clear_data();
       if (recorder->data().empty())
         continue;
 
@@ -200,11 +211,11 @@ class Coordinator::TraceStreamer : public base::SupportsWeakPtr<TraceStreamer> {
         std::string escaped;
         base::EscapeJSONString(recorder->data(), false /* put_in_quotes */,
                                &escaped);
-        WriteToStream(prefix + escaped);
+        WriteToStream(prefix, escaped);
       } else {
         if (prefix.empty() && !stream_is_empty_)
           prefix = ",";
-        WriteToStream(prefix + recorder->data());
+        WriteToStream(prefix, recorder->data());
       }
       stream_is_empty_ = false;
       recorder->clear_data();
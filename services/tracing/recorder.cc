@@ -27,7 +27,7 @@ Recorder::Recorder(mojom::RecorderRequest request,
 Recorder::~Recorder() = default;
 
 void Recorder::AddChunk(const std::string& chunk) {
-  if (chunk.empty())
+  if (chunk.empty() || discard_data_)
     return;
   if (data_type_ != mojom::TraceDataType::STRING && !data_.empty())
     data_.append(",");
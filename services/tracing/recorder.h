@@ -41,6 +41,10 @@ class Recorder : public mojom::Recorder {
 
   void clear_data() { data_.clear(); }
 
+  // Makes the recorder drop the chunks it receives instead of buffering them,
+  // for agents whose data is not going to be streamed.
+  void set_discard_data(bool discard_data) { discard_data_ = discard_data; }
+
   const base::DictionaryValue& metadata() const { return metadata_; }
   bool is_recording() const { return is_recording_; }
   mojom::TraceDataType data_type() const { return data_type_; }
@@ -57,6 +61,7 @@ class Recorder : public mojom::Recorder {
   std::string data_;
   base::DictionaryValue metadata_;
   bool is_recording_;
+  bool discard_data_ = false;
   mojom::TraceDataType data_type_;
   base::RepeatingClosure on_data_change_callback_;
   mojo::Binding<mojom::Recorder> binding_;
@@ -92,6 +92,20 @@ TEST_F(RecorderTest, AddChunkString) {
   EXPECT_EQ(3u, num_calls);
 }
 
+TEST_F(RecorderTest, DiscardData) {
+  size_t num_calls = 0;
+  CreateRecorder(mojom::TraceDataType::ARRAY,
+                 base::BindRepeating([](size_t* num_calls) { (*num_calls)++; },
+                                     base::Unretained(&num_calls)));
+  recorder_->set_discard_data(true);
+  AddChunk("chunk1");
+  AddChunk("chunk2");
+
+  // Discarded chunks are neither buffered nor reported.
+  EXPECT_TRUE(recorder_->data().empty());
+  EXPECT_EQ(0u, num_calls);
+}
+
 TEST_F(RecorderTest, AddMetadata) {
   CreateRecorder(mojom::TraceDataType::ARRAY, base::BindRepeating([] {}));
 
@@ -9,6 +9,7 @@
 #include <stdint.h>
 #include <string.h>
 
+#include <algorithm>
 #include <utility>
 
 #include "base/debug/alias.h"
@@ -257,6 +258,8 @@ Connection::Connection()
       page_size_(0),
       cache_size_(0),
       exclusive_locking_(false),
+      wal_mode_(false),
+      read_only_(false),
       restrict_to_user_(false),
       transaction_nesting_(0),
       needs_rollback_(false),
@@ -264,6 +267,9 @@ Connection::Connection()
       poisoned_(false),
       mmap_alt_status_(false),
       mmap_disabled_(false),
+      mmap_size_limit_(0),
+      preload_on_open_(false),
+      scan_read_ahead_size_(0),
       mmap_enabled_(false),
       total_changes_at_last_release_(0),
       stats_histogram_(NULL),
@@ -393,6 +399,22 @@ void Connection::CloseInternal(bool forced) {
     // of the function. http://crbug.com/136655.
     AssertIOAllowed();
 
+    // Pages found in the cache over the connection's lifetime, to check
+    // set_cache_size() against.
+    int cache_hits = 0;
+    int cache_misses = 0;
+    int unused = 0;
+    if (sqlite3_db_status(db_, SQLITE_DBSTATUS_CACHE_HIT, &cache_hits, &unused,
+                          0) == SQLITE_OK &&
+        sqlite3_db_status(db_, SQLITE_DBSTATUS_CACHE_MISS, &cache_misses,
+                          &unused, 0) == SQLITE_OK &&
+        cache_hits + cache_misses > 0) {
+      RecordIOPolicyPercentage(
+          "Sqlite.IOPolicy.CacheHitRate",
+          static_cast<int>(int64_t{cache_hits} * 100 /
+                           (int64_t{cache_hits} + cache_misses)));
+    }
+
     // Reseting acquires a lock to ensure no dump is happening on the database
     // at the same time. Unregister takes ownership of provider and it is safe
     // since the db is reset. memory_dump_provider_ could be null if db_ was
@@ -440,19 +462,43 @@ void Connection::Preload() {
   if (preload_size < 1)
     return;
 
+  ReadFilePrefix(page_size, preload_size);
+}
+
+void Connection::ReadAheadForScan() {
+  AssertIOAllowed();
+
+  if (!db_) {
+    DCHECK(poisoned_) << "Cannot read ahead on null db";
+    return;
+  }
+  if (!scan_read_ahead_size_)
+    return;
+
+  // Large reads let the OS read ahead further and cost fewer syscalls.
+  const int kChunkSize = 256 * 1024;
+  const base::TimeTicks before = base::TimeTicks::Now();
+  ReadFilePrefix(kChunkSize, scan_read_ahead_size_);
+  RecordIOPolicyTime("Sqlite.IOPolicy.ScanReadAheadTime",
+                     base::TimeTicks::Now() - before);
+}
+
+void Connection::ReadFilePrefix(int chunk_size, int64_t max_bytes) {
   sqlite3_file* file = NULL;
   sqlite3_int64 file_size = 0;
   int rc = GetSqlite3FileAndSize(db_, &file, &file_size);
   if (rc != SQLITE_OK)
     return;
 
-  // Don't preload more than the file contains.
-  if (preload_size > file_size)
-    preload_size = file_size;
+  // Don't read more than the file contains.
+  if (max_bytes > file_size)
+    max_bytes = file_size;
 
-  std::unique_ptr<char[]> buf(new char[page_size]);
-  for (sqlite3_int64 pos = 0; pos < preload_size; pos += page_size) {
-    rc = file->pMethods->xRead(file, buf.get(), page_size, pos);
+  std::unique_ptr<char[]> buf(new char[chunk_size]);
+  for (sqlite3_int64 pos = 0; pos < max_bytes; pos += chunk_size) {
+    const int amount =
+        static_cast<int>(std::min<sqlite3_int64>(chunk_size, file_size - pos));
+    rc = file->pMethods->xRead(file, buf.get(), amount, pos);
 
     // TODO(shess): Consider calling OnSqliteError().
     if (rc != SQLITE_OK)
@@ -460,6 +506,20 @@ void Connection::Preload() {
   }
 }
 
+void Connection::RecordIOPolicyPercentage(const std::string& name,
+                                          int sample) {
+  base::UmaHistogramPercentage(name, sample);
+  if (!histogram_tag_.empty())
+    base::UmaHistogramPercentage(name + "." + histogram_tag_, sample);
+}
+
+void Connection::RecordIOPolicyTime(const std::string& name,
+                                    base::TimeDelta sample) {
+  base::UmaHistogramTimes(name, sample);
+  if (!histogram_tag_.empty())
+    base::UmaHistogramTimes(name + "." + histogram_tag_, sample);
+}
+
 // SQLite keeps unused pages associated with a connection in a cache.  It asks
 // the cache for pages by an id, and if the page is present and the database is
 // unchanged, it considers the content of the page valid and doesn't read it
@@ -962,6 +1022,22 @@ size_t Connection::GetAppropriateMmapSize() {
   return mmap_ofs;
 }
 
+bool Connection::CheckpointDatabase() {
+  AssertIOAllowed();
+  if (!db_)
+    return false;
+
+  // |log_frames| is -1 when the database isn't in WAL mode.
+  int log_frames = -1;
+  int rc = sqlite3_wal_checkpoint_v2(db_, nullptr, SQLITE_CHECKPOINT_PASSIVE,
+                                     &log_frames, nullptr);
+  if (rc != SQLITE_OK) {
+    DLOG(WARNING) << "Could not checkpoint database: " << GetErrorMessage();
+    return false;
+  }
+  return log_frames >= 0;
+}
+
 void Connection::TrimMemory(bool aggressively) {
   if (!db_)
     return;
@@ -1413,12 +1489,41 @@ scoped_refptr<Connection::StatementRef> Connection::GetCachedStatement(
     // case it still has some stuff bound.
     DCHECK(i->second->is_valid());
     sqlite3_reset(i->second->stmt());
+    if (memory_dump_provider_)
+      memory_dump_provider_->RecordStatementCacheHit();
     return i->second;
   }
 
+  if (memory_dump_provider_)
+    memory_dump_provider_->RecordStatementCacheMiss();
+  return PrepareAndCacheStatement(id, sql);
+}
+
+bool Connection::PrepareCachedStatements(
+    const std::vector<CachedStatementSpec>& statements) {
+  bool success = true;
+  for (const CachedStatementSpec& statement : statements) {
+    if (HasCachedStatement(statement.id))
+      continue;
+    if (!PrepareAndCacheStatement(statement.id, statement.sql)->is_valid())
+      success = false;
+  }
+  return success;
+}
+
+scoped_refptr<Connection::StatementRef> Connection::PrepareAndCacheStatement(
+    const StatementID& id,
+    const char* sql) {
+  const base::TimeTicks before = base::TimeTicks::Now();
   scoped_refptr<StatementRef> statement = GetUniqueStatement(sql);
-  if (statement->is_valid())
-    statement_cache_[id] = statement;  // Only cache valid statements.
+  if (!statement->is_valid())
+    return statement;
+
+  statement_cache_[id] = statement;  // Only cache valid statements.
+  if (memory_dump_provider_) {
+    memory_dump_provider_->RecordStatementPrepared(
+        base::TimeTicks::Now() - before, statement_cache_.size());
+  }
   return statement;
 }
 
@@ -1631,9 +1736,10 @@ bool Connection::OpenInternal(const std::string& file_name,
   // Custom memory-mapping VFS which reads pages using regular I/O on first hit.
   sqlite3_vfs* vfs = VFSWrapper();
   const char* vfs_name = (vfs ? vfs->zName : nullptr);
-  int err = sqlite3_open_v2(file_name.c_str(), &db_,
-                            SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE,
-                            vfs_name);
+  const int open_flags = read_only_
+                             ? SQLITE_OPEN_READONLY
+                             : SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+  int err = sqlite3_open_v2(file_name.c_str(), &db_, open_flags, vfs_name);
   if (err != SQLITE_OK) {
     // Extended error codes cannot be enabled until a handle is
     // available, fetch manually.
@@ -1670,8 +1776,10 @@ bool Connection::OpenInternal(const std::string& file_name,
       // be fatal unless the file doesn't exist.
       base::FilePath journal_path(file_name + FILE_PATH_LITERAL("-journal"));
       base::FilePath wal_path(file_name + FILE_PATH_LITERAL("-wal"));
+      base::FilePath shm_path(file_name + FILE_PATH_LITERAL("-shm"));
       base::SetPosixFilePermissions(journal_path, mode);
       base::SetPosixFilePermissions(wal_path, mode);
+      base::SetPosixFilePermissions(shm_path, mode);
     }
   }
 #endif  // defined(OS_POSIX)
@@ -1739,10 +1847,18 @@ bool Connection::OpenInternal(const std::string& file_name,
   // DELETE (default) - delete -journal file to commit.
   // TRUNCATE - truncate -journal file to commit.
   // PERSIST - zero out header of -journal file to commit.
+  // WAL - append to -wal file, checkpoint into the database later.
   // TRUNCATE should be faster than DELETE because it won't need directory
   // changes for each transaction.  PERSIST may break the spirit of using
-  // secure_delete.
-  ignore_result(Execute("PRAGMA journal_mode = TRUNCATE"));
+  // secure_delete.  WAL is used on request, since it lets readers proceed
+  // while a write is in progress.  A read-only connection uses whatever mode
+  // the database was left in.
+  if (!read_only_) {
+    if (wal_mode_ && !in_memory_)
+      ignore_result(Execute("PRAGMA journal_mode = WAL"));
+    else
+      ignore_result(Execute("PRAGMA journal_mode = TRUNCATE"));
+  }
 
   const base::TimeDelta kBusyTimeout =
     base::TimeDelta::FromSeconds(kBusyTimeoutSeconds);
@@ -1794,7 +1910,10 @@ bool Connection::OpenInternal(const std::string& file_name,
   // safe range to memory-map based on past regular I/O.  This value will be
   // capped by SQLITE_MAX_MMAP_SIZE, which could be different between 32-bit and
   // 64-bit platforms.
-  size_t mmap_size = mmap_disabled_ ? 0 : GetAppropriateMmapSize();
+  size_t mmap_size =
+      (mmap_disabled_ || read_only_) ? 0 : GetAppropriateMmapSize();
+  if (mmap_size_limit_)
+    mmap_size = std::min(mmap_size, mmap_size_limit_);
   std::string mmap_sql =
       base::StringPrintf("PRAGMA mmap_size = %" PRIuS, mmap_size);
   ignore_result(Execute(mmap_sql.c_str()));
@@ -1806,6 +1925,22 @@ bool Connection::OpenInternal(const std::string& file_name,
     Statement s(GetUniqueStatement("PRAGMA mmap_size"));
     if (s.Step() && s.ColumnInt64(0) > 0)
       mmap_enabled_ = true;
+
+    // A limit covering less of the file than this leaves the rest to regular
+    // reads.
+    if (mmap_enabled_ && db_size > 0) {
+      RecordIOPolicyPercentage(
+          "Sqlite.IOPolicy.MmapCoverage",
+          static_cast<int>(std::min<int64_t>(
+              100, s.ColumnInt64(0) * 100 / db_size)));
+    }
+  }
+
+  if (preload_on_open_) {
+    const base::TimeTicks before = base::TimeTicks::Now();
+    Preload();
+    RecordIOPolicyTime("Sqlite.IOPolicy.PreloadTime",
+                       base::TimeTicks::Now() - before);
   }
 
   DCHECK(!memory_dump_provider_);
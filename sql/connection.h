@@ -147,6 +147,20 @@ class SQL_EXPORT Connection {
   // This must be called before Open() to have an effect.
   void set_exclusive_locking() { exclusive_locking_ = true; }
 
+  // Call to use write-ahead logging instead of a rollback journal. Readers on
+  // other connections then don't block the writer, nor it them; each read
+  // transaction sees the database as of its first read. Combined with
+  // set_exclusive_locking() no other connection can read the database.
+  //
+  // This must be called before Open() to have an effect, and has none on
+  // in-memory databases.
+  void set_wal_mode() { wal_mode_ = true; }
+
+  // Call to open the database read-only. The journal mode isn't changed and
+  // memory-mapping is disabled, since tracking it writes to the database.
+  // Open() fails if the database doesn't exist.
+  void set_read_only() { read_only_ = true; }
+
   // Call to cause Open() to restrict access permissions of the
   // database file to only the owner.
   // TODO(shess): Currently only supported on OS_POSIX, is a noop on
@@ -161,6 +175,28 @@ class SQL_EXPORT Connection {
   // Call to opt out of memory-mapped file I/O.
   void set_mmap_disabled() { mmap_disabled_ = true; }
 
+  // IO policy -----------------------------------------------------------------
+  //
+  // Together with set_cache_size() and set_mmap_disabled(), these tune how a
+  // database reads its file. Their effect is recorded in Sqlite.IOPolicy.*
+  // histograms, suffixed by the histogram tag, so each choice can be checked
+  // against what the database actually does. Call them before Open().
+
+  // Caps how much of the file is memory-mapped. Zero leaves the default, which
+  // maps up to 256MB once the file has been verified to read without errors.
+  // Sqlite.IOPolicy.MmapCoverage records how much of the file ends up mapped.
+  void set_mmap_size_limit(size_t bytes) { mmap_size_limit_ = bytes; }
+
+  // Call to Preload() as part of Open(), for databases which are read heavily
+  // as soon as they are opened. Sqlite.IOPolicy.PreloadTime records the cost.
+  void set_preload_on_open() { preload_on_open_ = true; }
+
+  // Sets how much of the file ReadAheadForScan() reads. Zero, the default,
+  // makes it a no-op.
+  void set_scan_read_ahead_size(size_t bytes) {
+    scan_read_ahead_size_ = bytes;
+  }
+
   // Set an error-handling callback.  On errors, the error number (and
   // statement, if available) will be passed to the callback.
   //
@@ -303,6 +339,18 @@ class SQL_EXPORT Connection {
   // usage by half.
   void TrimMemory(bool aggressively);
 
+  // Reads up to set_scan_read_ahead_size() bytes of the file in large
+  // sequential chunks, so that a following full-table scan, whose reads are
+  // scattered across the file in b-tree order, finds the pages in the OS page
+  // cache. Sqlite.IOPolicy.ScanReadAheadTime records the cost.
+  void ReadAheadForScan();
+
+  // Copies as much of the write-ahead log into the database as can be done
+  // without waiting for readers or the writer, so that the log doesn't grow
+  // without bound while readers keep it pinned. Returns false on error or if
+  // the database isn't in WAL mode.
+  bool CheckpointDatabase();
+
   // Raze the database to the ground.  This approximates creating a
   // fresh database from scratch, within the constraints of SQLite's
   // locking protocol (locks and open handles can make doing this with
@@ -450,6 +498,22 @@ class SQL_EXPORT Connection {
   scoped_refptr<StatementRef> GetCachedStatement(const StatementID& id,
                                                  const char* sql);
 
+  // A statement for PrepareCachedStatements(). |id| and |sql| must match those
+  // later passed to GetCachedStatement(), so |id| is usually a named
+  // StatementID shared by both call sites.
+  struct CachedStatementSpec {
+    StatementID id;
+    const char* sql;
+  };
+
+  // Compiles |statements| into the statement cache, so that their first
+  // GetCachedStatement() doesn't pay for it. Databases whose startup queries
+  // are known can call this from a low-priority task on the database's
+  // sequence soon after Open(), before those queries are needed. Returns false
+  // if any statement failed to compile.
+  bool PrepareCachedStatements(
+      const std::vector<CachedStatementSpec>& statements);
+
   // Used to check a |sql| statement for syntactic validity. If the statement is
   // valid SQL, returns true.
   bool IsSQLValid(const char* sql);
@@ -531,6 +595,7 @@ class SQL_EXPORT Connection {
   FRIEND_TEST_ALL_PREFIXES(SQLConnectionTest, GetAppropriateMmapSize);
   FRIEND_TEST_ALL_PREFIXES(SQLConnectionTest, GetAppropriateMmapSizeAltStatus);
   FRIEND_TEST_ALL_PREFIXES(SQLConnectionTest, OnMemoryDump);
+  FRIEND_TEST_ALL_PREFIXES(SQLConnectionTest, PrepareCachedStatements);
   FRIEND_TEST_ALL_PREFIXES(SQLConnectionTest, RegisterIntentToUpload);
   FRIEND_TEST_ALL_PREFIXES(SQLiteFeaturesTest, WALNoClose);
 
@@ -546,6 +611,11 @@ class SQL_EXPORT Connection {
   };
   bool OpenInternal(const std::string& file_name, Retry retry_flag);
 
+  // Compiles |sql| and, if valid, caches it under |id|. Prepare time is
+  // reported to |memory_dump_provider_|.
+  scoped_refptr<StatementRef> PrepareAndCacheStatement(const StatementID& id,
+                                                       const char* sql);
+
   // Internal close function used by Close() and RazeAndClose().
   // |forced| indicates that orderly-shutdown checks should not apply.
   void CloseInternal(bool forced);
@@ -749,6 +819,14 @@ class SQL_EXPORT Connection {
   bool GetMmapAltStatus(int64_t* status);
   bool SetMmapAltStatus(int64_t status);
 
+  // Reads up to |max_bytes| from the start of the file through the VFS in
+  // |chunk_size| pieces, stopping at the end of the file or the first error.
+  void ReadFilePrefix(int chunk_size, int64_t max_bytes);
+
+  // Records |sample| to the untagged and, if set, tagged histogram |name|.
+  void RecordIOPolicyPercentage(const std::string& name, int sample);
+  void RecordIOPolicyTime(const std::string& name, base::TimeDelta sample);
+
   // The actual sqlite database. Will be NULL before Init has been called or if
   // Init resulted in an error.
   sqlite3* db_;
@@ -758,6 +836,8 @@ class SQL_EXPORT Connection {
   int page_size_;
   int cache_size_;
   bool exclusive_locking_;
+  bool wal_mode_;
+  bool read_only_;
   bool restrict_to_user_;
 
   // All cached statements. Keeping a reference to these statements means that
@@ -797,6 +877,11 @@ class SQL_EXPORT Connection {
   // |true| if SQLite memory-mapped I/O is not desired for this connection.
   bool mmap_disabled_;
 
+  // IO policy, see set_mmap_size_limit() and the setters following it.
+  size_t mmap_size_limit_;
+  bool preload_on_open_;
+  size_t scan_read_ahead_size_;
+
   // |true| if SQLite memory-mapped I/O was enabled for this connection.
   // Used by ReleaseCacheMemoryIfNeeded().
   bool mmap_enabled_;
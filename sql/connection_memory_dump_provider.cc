@@ -24,6 +24,25 @@ void ConnectionMemoryDumpProvider::ResetDatabase() {
   db_ = nullptr;
 }
 
+void ConnectionMemoryDumpProvider::RecordStatementCacheHit() {
+  base::AutoLock lock(lock_);
+  ++statement_cache_hits_;
+}
+
+void ConnectionMemoryDumpProvider::RecordStatementCacheMiss() {
+  base::AutoLock lock(lock_);
+  ++statement_cache_misses_;
+}
+
+void ConnectionMemoryDumpProvider::RecordStatementPrepared(
+    base::TimeDelta prepare_time,
+    size_t cached_statements) {
+  base::AutoLock lock(lock_);
+  ++statements_prepared_;
+  statement_prepare_time_ += prepare_time;
+  cached_statements_ = cached_statements;
+}
+
 bool ConnectionMemoryDumpProvider::OnMemoryDump(
     const base::trace_event::MemoryDumpArgs& args,
     base::trace_event::ProcessMemoryDump* pmd) {
@@ -51,6 +70,22 @@ bool ConnectionMemoryDumpProvider::OnMemoryDump(
   dump->AddScalar("statement_size",
                   base::trace_event::MemoryAllocatorDump::kUnitsBytes,
                   statement_size);
+
+  base::AutoLock lock(lock_);
+  dump->AddScalar("cached_statements",
+                  base::trace_event::MemoryAllocatorDump::kUnitsObjects,
+                  cached_statements_);
+  dump->AddScalar("statement_cache_hits",
+                  base::trace_event::MemoryAllocatorDump::kUnitsObjects,
+                  statement_cache_hits_);
+  dump->AddScalar("statement_cache_misses",
+                  base::trace_event::MemoryAllocatorDump::kUnitsObjects,
+                  statement_cache_misses_);
+  dump->AddScalar("statements_prepared",
+                  base::trace_event::MemoryAllocatorDump::kUnitsObjects,
+                  statements_prepared_);
+  dump->AddScalar("statement_prepare_time_us", "microseconds",
+                  statement_prepare_time_.InMicroseconds());
   return true;
 }
 
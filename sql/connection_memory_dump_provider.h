@@ -5,10 +5,14 @@
 #ifndef SQL_CONNECTION_MEMORY_DUMP_PROVIDER_H
 #define SQL_CONNECTION_MEMORY_DUMP_PROVIDER_H
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include <string>
 
 #include "base/macros.h"
 #include "base/synchronization/lock.h"
+#include "base/time/time.h"
 #include "base/trace_event/memory_dump_provider.h"
 
 struct sqlite3;
@@ -29,6 +33,13 @@ class ConnectionMemoryDumpProvider
 
   void ResetDatabase();
 
+  // Statement cache activity, reported in detailed dumps. Called by
+  // sql::Connection. |cached_statements| is the size of the cache afterwards.
+  void RecordStatementCacheHit();
+  void RecordStatementCacheMiss();
+  void RecordStatementPrepared(base::TimeDelta prepare_time,
+                               size_t cached_statements);
+
   // base::trace_event::MemoryDumpProvider implementation.
   bool OnMemoryDump(
       const base::trace_event::MemoryDumpArgs& args,
@@ -50,6 +61,13 @@ class ConnectionMemoryDumpProvider
   base::Lock lock_;
   std::string connection_name_;
 
+  // Guarded by |lock_|.
+  uint64_t statement_cache_hits_ = 0;
+  uint64_t statement_cache_misses_ = 0;
+  uint64_t statements_prepared_ = 0;
+  base::TimeDelta statement_prepare_time_;
+  size_t cached_statements_ = 0;
+
   DISALLOW_COPY_AND_ASSIGN(ConnectionMemoryDumpProvider);
 };
 
@@ -0,0 +1,90 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sql/connection_pool.h"
+
+#include <utility>
+
+#include "base/logging.h"
+#include "base/memory/ptr_util.h"
+#include "sql/connection.h"
+#include "sql/statement.h"
+
+namespace sql {
+
+ConnectionPool::ReadSnapshot::ReadSnapshot(
+    scoped_refptr<ConnectionPool> pool,
+    std::unique_ptr<Connection> connection)
+    : pool_(std::move(pool)), connection_(std::move(connection)) {}
+
+ConnectionPool::ReadSnapshot::~ReadSnapshot() {
+  // Nothing was written, so committing just ends the read transaction.
+  if (!connection_->CommitTransaction())
+    return;
+  pool_->ReturnConnection(std::move(connection_));
+}
+
+ConnectionPool::ConnectionPool(const base::FilePath& path,
+                               size_t max_idle_connections,
+                               const std::string& histogram_tag)
+    : path_(path),
+      max_idle_connections_(max_idle_connections),
+      histogram_tag_(histogram_tag) {}
+
+ConnectionPool::~ConnectionPool() = default;
+
+std::unique_ptr<ConnectionPool::ReadSnapshot> ConnectionPool::BeginRead() {
+  std::unique_ptr<Connection> connection = TakeConnection();
+  if (!connection)
+    return nullptr;
+
+  if (!connection->BeginTransaction())
+    return nullptr;
+
+  // BEGIN is deferred, so the snapshot is only taken by the first read.
+  // Take it now rather than whenever the caller gets around to reading.
+  {
+    Statement s(
+        connection->GetUniqueStatement("SELECT COUNT(*) FROM sqlite_master"));
+    if (!s.Step()) {
+      connection->RollbackTransaction();
+      return nullptr;
+    }
+  }
+
+  return base::WrapUnique(new ReadSnapshot(this, std::move(connection)));
+}
+
+std::unique_ptr<Connection> ConnectionPool::TakeConnection() {
+  {
+    base::AutoLock auto_lock(lock_);
+    if (!idle_connections_.empty()) {
+      std::unique_ptr<Connection> connection =
+          std::move(idle_connections_.back());
+      idle_connections_.pop_back();
+      return connection;
+    }
+  }
+
+  auto connection = std::make_unique<Connection>();
+  if (!histogram_tag_.empty())
+    connection->set_histogram_tag(histogram_tag_);
+  connection->set_read_only();
+  if (!connection->Open(path_)) {
+    DLOG(WARNING) << "Could not open pooled connection to " << path_.value();
+    return nullptr;
+  }
+  return connection;
+}
+
+void ConnectionPool::ReturnConnection(std::unique_ptr<Connection> connection) {
+  if (!connection->is_open())
+    return;
+
+  base::AutoLock auto_lock(lock_);
+  if (idle_connections_.size() < max_idle_connections_)
+    idle_connections_.push_back(std::move(connection));
+}
+
+}  // namespace sql
@@ -0,0 +1,93 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SQL_CONNECTION_POOL_H_
+#define SQL_CONNECTION_POOL_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/synchronization/lock.h"
+#include "sql/sql_export.h"
+
+namespace sql {
+
+class Connection;
+
+// Hands out read-only connections to a database in WAL mode (see
+// Connection::set_wal_mode()), so that queries from several sequences can run
+// in parallel with each other and with the owner's writes, instead of queuing
+// behind them on the single connection.
+//
+// The pool may be used from any sequence. Each ReadSnapshot, and the
+// connection in it, must be used on a single sequence at a time.
+class SQL_EXPORT ConnectionPool
+    : public base::RefCountedThreadSafe<ConnectionPool> {
+ public:
+  // A read transaction on a pooled connection. All reads through connection()
+  // see the database as it was when the snapshot was begun; writes committed
+  // afterwards aren't visible. The connection returns to the pool when the
+  // snapshot is destroyed.
+  //
+  // Holding a snapshot keeps the write-ahead log from being checkpointed past
+  // it, so snapshots should be short-lived.
+  class SQL_EXPORT ReadSnapshot {
+   public:
+    ~ReadSnapshot();
+
+    Connection* connection() { return connection_.get(); }
+
+   private:
+    friend class ConnectionPool;
+
+    ReadSnapshot(scoped_refptr<ConnectionPool> pool,
+                 std::unique_ptr<Connection> connection);
+
+    scoped_refptr<ConnectionPool> pool_;
+    std::unique_ptr<Connection> connection_;
+
+    DISALLOW_COPY_AND_ASSIGN(ReadSnapshot);
+  };
+
+  // Opens connections to the database at |path| as they are needed, keeping
+  // up to |max_idle_connections| open between snapshots. |histogram_tag| is
+  // passed to each connection, see Connection::set_histogram_tag().
+  ConnectionPool(const base::FilePath& path,
+                 size_t max_idle_connections,
+                 const std::string& histogram_tag);
+
+  // Begins a snapshot of the database, or returns null if the database could
+  // not be opened or read.
+  std::unique_ptr<ReadSnapshot> BeginRead();
+
+ private:
+  friend class base::RefCountedThreadSafe<ConnectionPool>;
+
+  ~ConnectionPool();
+
+  // Returns an idle connection or opens a new one. Returns null on failure.
+  std::unique_ptr<Connection> TakeConnection();
+
+  // Called by ReadSnapshot once its transaction has ended.
+  void ReturnConnection(std::unique_ptr<Connection> connection);
+
+  const base::FilePath path_;
+  const size_t max_idle_connections_;
+  const std::string histogram_tag_;
+
+  base::Lock lock_;
+  std::vector<std::unique_ptr<Connection>> idle_connections_;
+
+  DISALLOW_COPY_AND_ASSIGN(ConnectionPool);
+};
+
+}  // namespace sql
+
+#endif  // SQL_CONNECTION_POOL_H_
@@ -0,0 +1,115 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sql/connection_pool.h"
+
+#include <memory>
+#include <string>
+
+#include "base/memory/ref_counted.h"
+#include "sql/connection.h"
+#include "sql/statement.h"
+#include "sql/test/scoped_error_expecter.h"
+#include "sql/test/sql_test_base.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/sqlite/sqlite3.h"
+
+namespace sql {
+
+namespace {
+
+class SQLConnectionPoolTest : public SQLTestBase {
+ public:
+  void SetUp() override {
+    SQLTestBase::SetUp();
+
+    db().Close();
+    db().set_wal_mode();
+    ASSERT_TRUE(db().Open(db_path()));
+    ASSERT_TRUE(db().Execute("CREATE TABLE foo (a)"));
+    ASSERT_TRUE(db().Execute("INSERT INTO foo VALUES (1)"));
+
+    pool_ = base::MakeRefCounted<ConnectionPool>(db_path(), 2, std::string());
+  }
+
+  static int CountFoo(Connection* connection) {
+    Statement s(connection->GetUniqueStatement("SELECT COUNT(*) FROM foo"));
+    EXPECT_TRUE(s.Step());
+    return s.ColumnInt(0);
+  }
+
+ protected:
+  scoped_refptr<ConnectionPool> pool_;
+};
+
+TEST_F(SQLConnectionPoolTest, UsesWal) {
+  Statement s(db().GetUniqueStatement("PRAGMA journal_mode"));
+  ASSERT_TRUE(s.Step());
+  EXPECT_EQ("wal", s.ColumnString(0));
+}
+
+TEST_F(SQLConnectionPoolTest, SnapshotIgnoresLaterWrites) {
+  std::unique_ptr<ConnectionPool::ReadSnapshot> snapshot = pool_->BeginRead();
+  ASSERT_TRUE(snapshot);
+  EXPECT_EQ(1, CountFoo(snapshot->connection()));
+
+  // The writer isn't blocked by the open read transaction.
+  ASSERT_TRUE(db().Execute("INSERT INTO foo VALUES (2)"));
+  EXPECT_EQ(2, CountFoo(&db()));
+  EXPECT_EQ(1, CountFoo(snapshot->connection()));
+
+  snapshot.reset();
+  snapshot = pool_->BeginRead();
+  ASSERT_TRUE(snapshot);
+  EXPECT_EQ(2, CountFoo(snapshot->connection()));
+}
+
+TEST_F(SQLConnectionPoolTest, ConcurrentSnapshots) {
+  std::unique_ptr<ConnectionPool::ReadSnapshot> first = pool_->BeginRead();
+  ASSERT_TRUE(db().Execute("INSERT INTO foo VALUES (2)"));
+  std::unique_ptr<ConnectionPool::ReadSnapshot> second = pool_->BeginRead();
+  ASSERT_TRUE(first);
+  ASSERT_TRUE(second);
+  EXPECT_NE(first->connection(), second->connection());
+  EXPECT_EQ(1, CountFoo(first->connection()));
+  EXPECT_EQ(2, CountFoo(second->connection()));
+}
+
+TEST_F(SQLConnectionPoolTest, ReusesConnections) {
+  Connection* connection = nullptr;
+  {
+    std::unique_ptr<ConnectionPool::ReadSnapshot> snapshot =
+        pool_->BeginRead();
+    ASSERT_TRUE(snapshot);
+    connection = snapshot->connection();
+  }
+  std::unique_ptr<ConnectionPool::ReadSnapshot> snapshot = pool_->BeginRead();
+  ASSERT_TRUE(snapshot);
+  EXPECT_EQ(connection, snapshot->connection());
+}
+
+TEST_F(SQLConnectionPoolTest, ConnectionsAreReadOnly) {
+  std::unique_ptr<ConnectionPool::ReadSnapshot> snapshot = pool_->BeginRead();
+  ASSERT_TRUE(snapshot);
+  {
+    test::ScopedErrorExpecter expecter;
+    expecter.ExpectError(SQLITE_READONLY);
+    EXPECT_FALSE(
+        snapshot->connection()->Execute("INSERT INTO foo VALUES (2)"));
+    ASSERT_TRUE(expecter.SawExpectedErrors());
+  }
+}
+
+TEST_F(SQLConnectionPoolTest, Checkpoint) {
+  ASSERT_TRUE(db().Execute("INSERT INTO foo VALUES (2)"));
+  EXPECT_TRUE(db().CheckpointDatabase());
+
+  Connection memory_db;
+  ASSERT_TRUE(memory_db.OpenInMemory());
+  EXPECT_FALSE(memory_db.CheckpointDatabase());
+}
+
+}  // namespace
+
+}  // namespace sql
@@ -1427,6 +1427,43 @@ TEST_F(SQLConnectionTest, OnMemoryDump) {
   EXPECT_GE(pmd.allocator_dumps().size(), 1u);
 }
 
+TEST_F(SQLConnectionTest, PrepareCachedStatements) {
+  const sql::StatementID kSelectId("SelectId");
+  const sql::StatementID kSelectValue("SelectValue");
+  ASSERT_TRUE(db().Execute("CREATE TABLE foo (id INTEGER, value TEXT)"));
+
+  EXPECT_TRUE(db().PrepareCachedStatements(
+      {{kSelectId, "SELECT id FROM foo"},
+       {kSelectValue, "SELECT value FROM foo"}}));
+  EXPECT_TRUE(db().HasCachedStatement(kSelectId));
+  EXPECT_TRUE(db().HasCachedStatement(kSelectValue));
+
+  {
+    Statement s(db().GetCachedStatement(kSelectId, "SELECT id FROM foo"));
+    EXPECT_TRUE(s.is_valid());
+  }
+
+  base::trace_event::MemoryDumpArgs args = {
+      base::trace_event::MemoryDumpLevelOfDetail::DETAILED};
+  base::trace_event::ProcessMemoryDump pmd(args);
+  ASSERT_TRUE(db().memory_dump_provider_->OnMemoryDump(args, &pmd));
+  ASSERT_EQ(1u, pmd.allocator_dumps().size());
+  const base::trace_event::MemoryAllocatorDump* dump =
+      pmd.allocator_dumps().begin()->second.get();
+  auto get_scalar = [dump](const char* name) -> uint64_t {
+    for (const auto& entry : dump->entries()) {
+      if (entry.name == name)
+        return entry.value_uint64;
+    }
+    ADD_FAILURE() << "No " << name;
+    return 0;
+  };
+  EXPECT_EQ(2u, get_scalar("cached_statements"));
+  EXPECT_EQ(2u, get_scalar("statements_prepared"));
+  EXPECT_EQ(1u, get_scalar("statement_cache_hits"));
+  EXPECT_EQ(0u, get_scalar("statement_cache_misses"));
+}
+
 // Test that the functions to collect diagnostic data run to completion, without
 // worrying too much about what they generate (since that will change).
 TEST_F(SQLConnectionTest, CollectDiagnosticInfo) {
@@ -1556,6 +1593,42 @@ TEST_F(SQLConnectionTest, MmapInitiallyEnabledAltStatus) {
   EXPECT_EQ("0", ExecuteWithResult(&db(), "PRAGMA mmap_size"));
 }
 
+TEST_F(SQLConnectionTest, IOPolicy) {
+  const char kMmapSizeSql[] = "PRAGMA mmap_size";
+  ASSERT_TRUE(db().Execute("CREATE TABLE foo (x BLOB)"));
+  ASSERT_TRUE(db().Execute("INSERT INTO foo VALUES (zeroblob(65536))"));
+  db().Close();
+
+  base::HistogramTester tester;
+  db().set_histogram_tag("Test");
+  db().set_mmap_size_limit(4096);
+  db().set_preload_on_open();
+  db().set_scan_read_ahead_size(32 * 1024);
+  ASSERT_TRUE(db().Open(db_path()));
+  tester.ExpectTotalCount("Sqlite.IOPolicy.PreloadTime", 1);
+  tester.ExpectTotalCount("Sqlite.IOPolicy.PreloadTime.Test", 1);
+
+  // mmap may not be supported, but if it is it must respect the limit.
+  {
+    sql::Statement s(db().GetUniqueStatement(kMmapSizeSql));
+    ASSERT_TRUE(s.Step());
+    EXPECT_LE(s.ColumnInt64(0), 4096);
+    if (s.ColumnInt64(0) > 0) {
+      tester.ExpectTotalCount("Sqlite.IOPolicy.MmapCoverage.Test", 1);
+      EXPECT_GT(100,
+                tester.GetAllSamples("Sqlite.IOPolicy.MmapCoverage.Test")[0]
+                    .min);
+    }
+  }
+
+  db().ReadAheadForScan();
+  tester.ExpectTotalCount("Sqlite.IOPolicy.ScanReadAheadTime.Test", 1);
+
+  ASSERT_EQ("1", ExecuteWithResult(&db(), "SELECT COUNT(*) FROM foo"));
+  db().Close();
+  tester.ExpectTotalCount("Sqlite.IOPolicy.CacheHitRate.Test", 1);
+}
+
 TEST_F(SQLConnectionTest, GetAppropriateMmapSize) {
   const size_t kMmapAlot = 25 * 1024 * 1024;
   int64_t mmap_status = MetaTable::kMmapFailure;
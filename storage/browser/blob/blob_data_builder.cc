@@ -126,6 +126,7 @@ void BlobDataBuilder::AppendIPCDataElement(
     // This type can't be sent by IPC.
     case network::DataElement::TYPE_DATA_PIPE:
     case network::DataElement::TYPE_CHUNKED_DATA_PIPE:
+    case network::DataElement::TYPE_READ_ONLY_SHARED_MEMORY:
       NOTREACHED();
       break;
   }
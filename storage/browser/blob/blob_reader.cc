@@ -6,6 +6,7 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 #include <algorithm>
 #include <limits>
@@ -32,6 +33,10 @@ namespace storage {
 namespace {
 const char kCacheStorageRecordBytesLabel[] = "DiskCache.CacheStorage";
 
+// Upper bound on the memory used by read-ahead, whatever the consumer's chunk
+// size.
+const int kMaxReadAheadBytes = 1024 * 1024;
+
 bool IsFileType(BlobDataItem::Type type) {
   switch (type) {
     case BlobDataItem::Type::kFile:
@@ -234,6 +239,8 @@ BlobReader::Status BlobReader::Read(net::IOBuffer* buffer,
   Status status = ReadLoop(bytes_read);
   if (status == Status::IO_PENDING)
     read_callback_ = std::move(done);
+  else if (status == Status::DONE)
+    MaybeStartReadAhead(dest_size);
   return status;
 }
 
@@ -471,7 +478,10 @@ BlobReader::Status BlobReader::ReadItem() {
 
 void BlobReader::AdvanceItem() {
   // Close the file if the current item is a file.
+  DCHECK(!read_ahead_pending_);
   DeleteCurrentFileReader();
+  read_ahead_offset_ = 0;
+  read_ahead_size_ = 0;
 
   // Advance to the next item.
   current_item_index_++;
@@ -512,6 +522,27 @@ BlobReader::Status BlobReader::ReadFileItem(FileStreamReader* reader,
       << "Can't begin IO while another IO operation is pending.";
   DCHECK_GE(read_buf_->BytesRemaining(), bytes_to_read);
   DCHECK(reader);
+
+  // The reader is busy reading ahead; this read continues once it's done.
+  if (read_ahead_pending_) {
+    io_pending_ = true;
+    return Status::IO_PENDING;
+  }
+  if (read_ahead_error_ != net::OK) {
+    const int error = read_ahead_error_;
+    read_ahead_error_ = net::OK;
+    return ReportError(error);
+  }
+  if (read_ahead_offset_ < read_ahead_size_) {
+    const int bytes_to_copy =
+        std::min(bytes_to_read, read_ahead_size_ - read_ahead_offset_);
+    memcpy(read_buf_->data(), read_ahead_buf_->data() + read_ahead_offset_,
+           bytes_to_copy);
+    read_ahead_offset_ += bytes_to_copy;
+    AdvanceBytesRead(bytes_to_copy);
+    return Status::DONE;
+  }
+
   TRACE_EVENT_ASYNC_BEGIN1("Blob", "BlobRequest::ReadFileItem", this, "uuid",
                            blob_data_->uuid());
   const int result = reader->Read(
@@ -534,11 +565,71 @@ void BlobReader::DidReadFile(int result) {
   DidReadItem(result);
 }
 
+void BlobReader::MaybeStartReadAhead(int chunk_size) {
+  if (!read_ahead_enabled_ || read_ahead_pending_ || net_error_ != net::OK ||
+      read_ahead_error_ != net::OK || read_ahead_offset_ < read_ahead_size_ ||
+      remaining_bytes_ == 0) {
+    return;
+  }
+
+  const auto& items = blob_data_->items();
+  if (current_item_index_ >= items.size() ||
+      !IsFileType(items.at(current_item_index_)->type())) {
+    return;
+  }
+
+  // Stay within the current item, so that it isn't advanced past while bytes
+  // are buffered for it.
+  const uint64_t item_remaining =
+      item_length_list_[current_item_index_] - current_item_offset_;
+  const int size = static_cast<int>(
+      std::min<uint64_t>(std::min<uint64_t>(item_remaining, remaining_bytes_),
+                         std::min(chunk_size, kMaxReadAheadBytes)));
+  if (size <= 0)
+    return;
+
+  FileStreamReader* const reader =
+      GetOrCreateFileReaderAtIndex(current_item_index_);
+  if (!reader)
+    return;
+
+  if (!read_ahead_buf_ || read_ahead_buf_->size() != size)
+    read_ahead_buf_ = new net::IOBufferWithSize(size);
+  read_ahead_offset_ = 0;
+  read_ahead_size_ = 0;
+  TRACE_EVENT_ASYNC_BEGIN1("Blob", "BlobReader::ReadAhead", this, "uuid",
+                           blob_data_->uuid());
+  read_ahead_pending_ = true;
+  const int result = reader->Read(
+      read_ahead_buf_.get(), size,
+      base::Bind(&BlobReader::DidReadAhead, weak_factory_.GetWeakPtr()));
+  if (result != net::ERR_IO_PENDING)
+    DidReadAhead(result);
+}
+
+void BlobReader::DidReadAhead(int result) {
+  TRACE_EVENT_ASYNC_END1("Blob", "BlobReader::ReadAhead", this, "uuid",
+                         blob_data_->uuid());
+  DCHECK(read_ahead_pending_);
+  read_ahead_pending_ = false;
+  if (result > 0)
+    read_ahead_size_ = result;
+  else
+    read_ahead_error_ = result < 0 ? result : net::ERR_FAILED;
+
+  // A read of this item was waiting for the read-ahead.
+  if (io_pending_) {
+    io_pending_ = false;
+    ContinueAsyncReadLoop();
+  }
+}
+
 void BlobReader::ContinueAsyncReadLoop() {
   int bytes_read = 0;
   Status read_status = ReadLoop(&bytes_read);
   switch (read_status) {
     case Status::DONE:
+      MaybeStartReadAhead(bytes_read);
       std::move(read_callback_).Run(bytes_read);
       return;
     case Status::NET_ERROR:
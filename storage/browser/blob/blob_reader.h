@@ -118,6 +118,12 @@ class STORAGE_EXPORT BlobReader {
   // after this call.
   void Kill();
 
+  // Makes the reader start reading the next chunk of a file item as soon as a
+  // Read() completes, so that it's ready by the time the consumer asks for
+  // it. For consumers which read the whole blob, or the range, in chunks of
+  // similar size. Costs an extra buffer the size of the last Read().
+  void EnableReadAhead() { read_ahead_enabled_ = true; }
+
   // Returns if all of the blob's items are in memory. Should only be called
   // after CalculateSize.
   bool IsInMemory() const;
@@ -180,6 +186,10 @@ class STORAGE_EXPORT BlobReader {
   void ReadBytesItem(const BlobDataItem& item, int bytes_to_read);
   BlobReader::Status ReadFileItem(FileStreamReader* reader, int bytes_to_read);
   void DidReadFile(int result);
+  // Starts reading up to |chunk_size| bytes ahead in the current item if it's
+  // a file and nothing is buffered yet.
+  void MaybeStartReadAhead(int chunk_size);
+  void DidReadAhead(int result);
   void DeleteCurrentFileReader();
   Status ReadDiskCacheEntryItem(const BlobDataItem& item, int bytes_to_read);
   void DidReadDiskCacheEntry(int result);
@@ -223,6 +233,16 @@ class STORAGE_EXPORT BlobReader {
 
   bool io_pending_ = false;
 
+  // See EnableReadAhead(). Bytes [|read_ahead_offset_|, |read_ahead_size_|)
+  // of |read_ahead_buf_| have been read from the current file item but not
+  // yet returned. A read-ahead error is reported by the next read of the item.
+  bool read_ahead_enabled_ = false;
+  bool read_ahead_pending_ = false;
+  scoped_refptr<net::IOBufferWithSize> read_ahead_buf_;
+  int read_ahead_offset_ = 0;
+  int read_ahead_size_ = 0;
+  int read_ahead_error_ = 0;
+
   net::CompletionOnceCallback size_callback_;
   net::CompletionOnceCallback read_callback_;
 
@@ -757,6 +757,56 @@ TEST_F(BlobReaderTest, FileAsync) {
   EXPECT_EQ(0, memcmp(buffer->data(), "FileData!!!", kData.size()));
 }
 
+TEST_F(BlobReaderTest, FileAsyncReadAhead) {
+  auto b = std::make_unique<BlobDataBuilder>("uuid");
+  const FilePath kPath = FilePath::FromUTF8Unsafe("/fake/file.txt");
+  const std::string kData = "FileData!!!";
+  const base::Time kTime = base::Time::Now();
+  b->AppendFile(kPath, 0, kData.size(), kTime);
+  this->InitializeReader(std::move(b));
+  reader_->EnableReadAhead();
+
+  std::unique_ptr<FakeFileStreamReader> reader(new FakeFileStreamReader(kData));
+  reader->SetAsyncRunner(base::ThreadTaskRunnerHandle::Get().get());
+  ExpectLocalFileCall(kPath, kTime, 0, reader.release());
+
+  int size_result = -1;
+  EXPECT_EQ(
+      BlobReader::Status::IO_PENDING,
+      reader_->CalculateSize(base::BindOnce(&SetValue<int>, &size_result)));
+  base::RunLoop().RunUntilIdle();
+  CheckSizeCalculatedAsynchronously(kData.size(), size_result);
+
+  const int kChunkSize = 4;
+  scoped_refptr<net::IOBuffer> buffer = CreateBuffer(kChunkSize);
+  int bytes_read = 0;
+  int async_bytes_read = 0;
+  EXPECT_EQ(BlobReader::Status::IO_PENDING,
+            reader_->Read(buffer.get(), kChunkSize, &bytes_read,
+                          base::BindOnce(&SetValue<int>, &async_bytes_read)));
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(kChunkSize, async_bytes_read);
+  EXPECT_EQ(0, memcmp(buffer->data(), "File", kChunkSize));
+
+  // The next chunk was read while the consumer handled the first one.
+  async_bytes_read = 0;
+  EXPECT_EQ(BlobReader::Status::DONE,
+            reader_->Read(buffer.get(), kChunkSize, &bytes_read,
+                          base::BindOnce(&SetValue<int>, &async_bytes_read)));
+  EXPECT_EQ(kChunkSize, bytes_read);
+  EXPECT_EQ(0, memcmp(buffer->data(), "Data", kChunkSize));
+
+  // Reading again before the read-ahead completes waits for it.
+  EXPECT_EQ(BlobReader::Status::IO_PENDING,
+            reader_->Read(buffer.get(), kChunkSize, &bytes_read,
+                          base::BindOnce(&SetValue<int>, &async_bytes_read)));
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(net::OK, reader_->net_error());
+  EXPECT_EQ(3, async_bytes_read);
+  EXPECT_EQ(0, memcmp(buffer->data(), "!!!", 3));
+  EXPECT_EQ(0u, reader_->remaining_bytes());
+}
+
 TEST_F(BlobReaderTest, FileSystemAsync) {
   auto b = std::make_unique<BlobDataBuilder>("uuid");
   const GURL kURL("file://test_file/here.txt");
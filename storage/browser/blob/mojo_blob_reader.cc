@@ -33,6 +33,8 @@ MojoBlobReader::MojoBlobReader(const BlobDataHandle* handle,
       weak_factory_(this) {
   TRACE_EVENT_ASYNC_BEGIN1("Blob", "BlobReader", this, "uuid", handle->uuid());
   DCHECK(delegate_);
+  // The blob is streamed into the pipe from start to end.
+  blob_reader_->EnableReadAhead();
   base::SequencedTaskRunnerHandle::Get()->PostTask(
       FROM_HERE,
       base::BindOnce(&MojoBlobReader::Start, weak_factory_.GetWeakPtr()));
@@ -24,6 +24,7 @@ UploadBlobElementReader::~UploadBlobElementReader() = default;
 
 int UploadBlobElementReader::Init(net::CompletionOnceCallback callback) {
   reader_ = handle_->CreateReader();
+  reader_->EnableReadAhead();
   BlobReader::Status status = reader_->CalculateSize(std::move(callback));
   switch (status) {
     case BlobReader::Status::NET_ERROR:
@@ -29,7 +29,9 @@
 
 #include "third_party/blink/renderer/core/dom/class_collection.h"
 
+#include "third_party/blink/renderer/core/dom/descendant_class_filter.h"
 #include "third_party/blink/renderer/core/dom/document.h"
+#include "third_party/blink/renderer/core/dom/element_traversal.h"
 #include "third_party/blink/renderer/core/dom/node_rare_data.h"
 
 namespace blink {
@@ -44,4 +46,26 @@ ClassCollection::ClassCollection(ContainerNode& root_node,
 
 ClassCollection::~ClassCollection() = default;
 
+Element* ClassCollection::NextMatch(const Element* current) const {
+  if (!class_names_.size())
+    return nullptr;
+  ContainerNode& root = RootNode();
+  DescendantClassFilter& filter = GetDocument().EnsureDescendantClassFilter();
+  if (!current) {
+    filter.WillWalkDescendants(root);
+    if (!filter.MayHaveDescendantWithClasses(root, class_names_))
+      return nullptr;
+  }
+  auto next_element = [&](const Element& element) {
+    if (filter.MayHaveDescendantWithClasses(element, class_names_))
+      return ElementTraversal::Next(element, &root);
+    return ElementTraversal::NextSkippingChildren(element, &root);
+  };
+  Element* next =
+      current ? next_element(*current) : ElementTraversal::FirstWithin(root);
+  while (next && !ElementMatches(*next))
+    next = next_element(*next);
+  return next;
+}
+
 }  // namespace blink
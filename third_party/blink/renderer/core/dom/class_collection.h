@@ -53,6 +53,11 @@ class ClassCollection final : public HTMLCollection {
 
   bool ElementMatches(const Element&) const;
 
+  // Returns the first matching element following |current|, or the first
+  // matching element if |current| is null, skipping the subtrees the
+  // document's DescendantClassFilter rules out.
+  Element* NextMatch(const Element* current) const;
+
  private:
   ClassCollection(ContainerNode& root_node, const AtomicString& class_names);
 
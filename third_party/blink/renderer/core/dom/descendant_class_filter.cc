@@ -0,0 +1,147 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/core/dom/descendant_class_filter.h"
+
+#include "third_party/blink/renderer/core/dom/container_node.h"
+#include "third_party/blink/renderer/core/dom/element.h"
+#include "third_party/blink/renderer/core/dom/element_traversal.h"
+#include "third_party/blink/renderer/core/dom/space_split_string.h"
+#include "third_party/blink/renderer/platform/wtf/vector.h"
+
+namespace blink {
+
+const unsigned DescendantClassFilter::kMinElementCount;
+const unsigned DescendantClassFilter::Filter::kBitCount;
+
+void DescendantClassFilter::Filter::Add(const AtomicString& name) {
+  unsigned hash = name.Impl()->ExistingHash();
+  bits_.set(hash % kBitCount);
+  bits_.set((hash >> 16) % kBitCount);
+}
+
+void DescendantClassFilter::Filter::AddClassesOf(const Element& element) {
+  if (!element.HasClass())
+    return;
+  const SpaceSplitString& class_names = element.ClassNames();
+  for (size_t i = 0; i < class_names.size(); ++i)
+    Add(class_names[i]);
+}
+
+bool DescendantClassFilter::Filter::MayContain(const AtomicString& name) const {
+  unsigned hash = name.Impl()->ExistingHash();
+  return bits_.test(hash % kBitCount) && bits_.test((hash >> 16) % kBitCount);
+}
+
+bool DescendantClassFilter::MayHaveDescendantWithClasses(
+    const ContainerNode& node,
+    const SpaceSplitString& class_names) const {
+  if (filters_.IsEmpty())
+    return true;
+  auto it = filters_.find(&node);
+  if (it == filters_.end())
+    return true;
+  for (size_t i = 0; i < class_names.size(); ++i) {
+    if (!it->value.MayContain(class_names[i]))
+      return false;
+  }
+  return true;
+}
+
+void DescendantClassFilter::WillWalkDescendants(const ContainerNode& root) {
+  if (filters_.Contains(&root))
+    return;
+  if (walked_roots_.insert(&root).is_new_entry)
+    return;
+  Build(root);
+}
+
+void DescendantClassFilter::ChildInserted(const ContainerNode& parent,
+                                          const Element& child) {
+  if (filters_.IsEmpty())
+    return;
+  Filter added;
+  if (ElementTraversal::FirstChild(child)) {
+    auto it = filters_.find(&child);
+    if (it == filters_.end()) {
+      for (const ContainerNode* node = &parent; node;
+           node = node->parentNode()) {
+        filters_.erase(node);
+      }
+      return;
+    }
+    added = it->value;
+  }
+  added.AddClassesOf(child);
+  AddToAncestors(parent, added);
+}
+
+void DescendantClassFilter::ClassesChanged(const Element& element) {
+  if (filters_.IsEmpty() || !element.parentNode())
+    return;
+  Filter added;
+  added.AddClassesOf(element);
+  AddToAncestors(*element.parentNode(), added);
+}
+
+void DescendantClassFilter::Clear() {
+  filters_.clear();
+  walked_roots_.clear();
+}
+
+void DescendantClassFilter::Build(const ContainerNode& root) {
+  struct Frame {
+    const ContainerNode* node;
+    Filter filter;
+    unsigned element_count;
+  };
+  // The filters of the ancestors of the current element, which are complete
+  // once the walk leaves their subtree.
+  Vector<Frame, 32> stack;
+  auto pop_frame = [this, &stack]() {
+    Frame frame = stack.back();
+    stack.pop_back();
+    if (frame.element_count >= kMinElementCount &&
+        !frame.filter.IsSaturated()) {
+      filters_.Set(frame.node, frame.filter);
+    }
+    if (!stack.IsEmpty()) {
+      stack.back().filter.Add(frame.filter);
+      stack.back().element_count += frame.element_count;
+    }
+  };
+
+  stack.push_back(Frame{&root, Filter(), 0});
+  for (Element* element = ElementTraversal::FirstWithin(root); element;
+       element = ElementTraversal::Next(*element, &root)) {
+    while (stack.back().node != element->parentNode())
+      pop_frame();
+    stack.back().filter.AddClassesOf(*element);
+    ++stack.back().element_count;
+    if (ElementTraversal::FirstChild(*element))
+      stack.push_back(Frame{element, Filter(), 0});
+  }
+  while (!stack.IsEmpty())
+    pop_frame();
+}
+
+void DescendantClassFilter::AddToAncestors(const ContainerNode& node,
+                                           const Filter& filter) {
+  for (const ContainerNode* ancestor = &node; ancestor;
+       ancestor = ancestor->parentNode()) {
+    auto it = filters_.find(ancestor);
+    if (it == filters_.end())
+      continue;
+    it->value.Add(filter);
+    if (it->value.IsSaturated())
+      filters_.erase(it);
+  }
+}
+
+void DescendantClassFilter::Trace(blink::Visitor* visitor) {
+  visitor->Trace(filters_);
+  visitor->Trace(walked_roots_);
+}
+
+}  // namespace blink
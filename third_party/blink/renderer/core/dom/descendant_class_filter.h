@@ -0,0 +1,89 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef THIRD_PARTY_BLINK_RENDERER_CORE_DOM_DESCENDANT_CLASS_FILTER_H_
+#define THIRD_PARTY_BLINK_RENDERER_CORE_DOM_DESCENDANT_CLASS_FILTER_H_
+
+#include <bitset>
+
+#include "base/macros.h"
+#include "third_party/blink/renderer/core/core_export.h"
+#include "third_party/blink/renderer/platform/heap/handle.h"
+#include "third_party/blink/renderer/platform/wtf/text/atomic_string.h"
+
+namespace blink {
+
+class ContainerNode;
+class Element;
+class SpaceSplitString;
+
+// Bloom filters of the class names found below large subtrees, which let
+// getElementsByClassName() walks skip subtrees that can't contain a match.
+//
+// Filters are built for the subtrees of a root that is walked more than once,
+// and are only ever supersets of the class names they describe: class changes
+// and insertions of leaves or filtered subtrees are added to the filters of
+// the ancestors, while removals leave stale names behind. Any other insertion
+// drops the filters of the ancestors.
+class CORE_EXPORT DescendantClassFilter final
+    : public GarbageCollected<DescendantClassFilter> {
+ public:
+  // Subtrees with fewer elements than this aren't worth a filter.
+  static const unsigned kMinElementCount = 32;
+
+  static DescendantClassFilter* Create() { return new DescendantClassFilter; }
+
+  // Returns false if no descendant of |node| can have all of |class_names|.
+  bool MayHaveDescendantWithClasses(const ContainerNode& node,
+                                    const SpaceSplitString& class_names) const;
+
+  // Called before the descendants of |root| are walked looking for classes.
+  // Builds the filters of the subtrees of |root| the second time it is walked.
+  void WillWalkDescendants(const ContainerNode& root);
+
+  void ChildInserted(const ContainerNode& parent, const Element& child);
+  void ClassesChanged(const Element&);
+  void Clear();
+
+  bool HasFilter(const ContainerNode& node) const {
+    return filters_.Contains(&node);
+  }
+
+  void Trace(blink::Visitor*);
+
+ private:
+  // A 256 bit Bloom filter with two probes per class name.
+  class Filter {
+    DISALLOW_NEW();
+
+   public:
+    static const unsigned kBitCount = 256;
+
+    void Add(const AtomicString&);
+    void AddClassesOf(const Element&);
+    void Add(const Filter& other) { bits_ |= other.bits_; }
+    bool MayContain(const AtomicString&) const;
+    // Filters with more than half of their bits set rule out too little to be
+    // worth keeping.
+    bool IsSaturated() const { return bits_.count() > kBitCount / 2; }
+
+   private:
+    std::bitset<kBitCount> bits_;
+  };
+
+  DescendantClassFilter() = default;
+
+  void Build(const ContainerNode& root);
+  // Adds |filter| to the filters of |node| and its ancestors.
+  void AddToAncestors(const ContainerNode& node, const Filter& filter);
+
+  HeapHashMap<WeakMember<const ContainerNode>, Filter> filters_;
+  HeapHashSet<WeakMember<const ContainerNode>> walked_roots_;
+
+  DISALLOW_COPY_AND_ASSIGN(DescendantClassFilter);
+};
+
+}  // namespace blink
+
+#endif  // THIRD_PARTY_BLINK_RENDERER_CORE_DOM_DESCENDANT_CLASS_FILTER_H_
@@ -0,0 +1,91 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/core/dom/descendant_class_filter.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/blink/renderer/core/dom/document.h"
+#include "third_party/blink/renderer/core/dom/space_split_string.h"
+#include "third_party/blink/renderer/core/html/html_collection.h"
+#include "third_party/blink/renderer/core/html/html_element.h"
+#include "third_party/blink/renderer/core/html_names.h"
+#include "third_party/blink/renderer/core/testing/page_test_base.h"
+#include "third_party/blink/renderer/platform/wtf/text/string_builder.h"
+
+namespace blink {
+
+class DescendantClassFilterTest : public PageTestBase {
+ protected:
+  void SetUp() override {
+    PageTestBase::SetUp();
+    StringBuilder markup;
+    markup.Append("<div id=big>");
+    for (unsigned i = 0; i < 2 * DescendantClassFilter::kMinElementCount; ++i)
+      markup.Append("<span class=item></span>");
+    markup.Append("</div><div id=small><span class=other></span></div>");
+    GetDocument().body()->SetInnerHTMLFromString(markup.ToString());
+  }
+
+  // Walks the document for |class_names| and returns the number of matches.
+  unsigned CountMatches(const AtomicString& class_names) {
+    HTMLCollection* collection =
+        GetDocument().getElementsByClassName(class_names);
+    unsigned length = collection->length();
+    collection->InvalidateCache();
+    return length;
+  }
+
+  DescendantClassFilter& Filter() {
+    return *GetDocument().GetDescendantClassFilter();
+  }
+};
+
+TEST_F(DescendantClassFilterTest, BuiltOnSecondWalk) {
+  Element* big = GetElementById("big");
+  EXPECT_EQ(1u, CountMatches("other"));
+  EXPECT_FALSE(Filter().HasFilter(*big));
+  EXPECT_EQ(1u, CountMatches("other"));
+  EXPECT_TRUE(Filter().HasFilter(*big));
+  EXPECT_FALSE(Filter().HasFilter(*GetElementById("small")));
+
+  EXPECT_TRUE(Filter().MayHaveDescendantWithClasses(
+      *big, SpaceSplitString("item")));
+  EXPECT_EQ(1u, CountMatches("other"));
+  EXPECT_EQ(2 * DescendantClassFilter::kMinElementCount, CountMatches("item"));
+}
+
+TEST_F(DescendantClassFilterTest, UpdatedOnMutation) {
+  Element* big = GetElementById("big");
+  CountMatches("other");
+  CountMatches("other");
+  ASSERT_TRUE(Filter().HasFilter(*big));
+
+  // A class added below a filtered subtree is added to its filter.
+  big->firstElementChild()->setAttribute(HTMLNames::classAttr, "item other");
+  EXPECT_TRUE(Filter().HasFilter(*big));
+  EXPECT_EQ(2u, CountMatches("other"));
+
+  // So is an inserted leaf.
+  Element* leaf = GetDocument().CreateRawElement(HTMLNames::spanTag);
+  leaf->setAttribute(HTMLNames::classAttr, "new");
+  big->AppendChild(leaf);
+  EXPECT_TRUE(Filter().HasFilter(*big));
+  EXPECT_EQ(1u, CountMatches("new"));
+
+  // Inserting an unfiltered subtree drops the filters of its ancestors.
+  Element* subtree = GetDocument().CreateRawElement(HTMLNames::divTag);
+  subtree->AppendChild(GetDocument().CreateRawElement(HTMLNames::spanTag));
+  subtree->firstElementChild()->setAttribute(HTMLNames::classAttr, "deep");
+  big->AppendChild(subtree);
+  EXPECT_FALSE(Filter().HasFilter(*big));
+  EXPECT_EQ(1u, CountMatches("deep"));
+
+  // The next walk builds them again, and removals leave them conservative.
+  ASSERT_TRUE(Filter().HasFilter(*big));
+  big->RemoveChild(subtree);
+  EXPECT_TRUE(Filter().HasFilter(*big));
+  EXPECT_EQ(0u, CountMatches("deep"));
+}
+
+}  // namespace blink
@@ -83,6 +83,7 @@
 #include "third_party/blink/renderer/core/dom/cdata_section.h"
 #include "third_party/blink/renderer/core/dom/comment.h"
 #include "third_party/blink/renderer/core/dom/context_features.h"
+#include "third_party/blink/renderer/core/dom/descendant_class_filter.h"
 #include "third_party/blink/renderer/core/dom/document_fragment.h"
 #include "third_party/blink/renderer/core/dom/document_parser_timing.h"
 #include "third_party/blink/renderer/core/dom/document_type.h"
@@ -6521,6 +6522,12 @@ ResizeObserverController& Document::EnsureResizeObserverController() {
   return *resize_observer_controller_;
 }
 
+DescendantClassFilter& Document::EnsureDescendantClassFilter() {
+  if (!descendant_class_filter_)
+    descendant_class_filter_ = DescendantClassFilter::Create();
+  return *descendant_class_filter_;
+}
+
 static void RunAddConsoleMessageTask(MessageSource source,
                                      MessageLevel level,
                                      const String& message,
@@ -7411,6 +7418,7 @@ void Document::Trace(blink::Visitor* visitor) {
   visitor->Trace(intersection_observer_controller_);
   visitor->Trace(snap_coordinator_);
   visitor->Trace(resize_observer_controller_);
+  visitor->Trace(descendant_class_filter_);
   visitor->Trace(property_registry_);
   visitor->Trace(network_state_observer_);
   visitor->Trace(policy_);
@@ -104,6 +104,7 @@ class V0CustomElementMicrotaskRunQueue;
 class V0CustomElementRegistrationContext;
 class DOMImplementation;
 class DOMWindow;
+class DescendantClassFilter;
 class DocumentFragment;
 class DocumentLoader;
 class DocumentMarkerController;
@@ -871,6 +872,11 @@ class CORE_EXPORT Document : public ContainerNode,
   }
   ResizeObserverController& EnsureResizeObserverController();
 
+  DescendantClassFilter* GetDescendantClassFilter() const {
+    return descendant_class_filter_;
+  }
+  DescendantClassFilter& EnsureDescendantClassFilter();
+
   void UpdateViewportDescription();
 
   // Returns the owning element in the parent document. Returns nullptr if
@@ -1793,6 +1799,7 @@ class CORE_EXPORT Document : public ContainerNode,
   TraceWrapperMember<IntersectionObserverController>
       intersection_observer_controller_;
   Member<ResizeObserverController> resize_observer_controller_;
+  Member<DescendantClassFilter> descendant_class_filter_;
 
   int node_count_;
 
@@ -55,6 +55,7 @@
 #include "third_party/blink/renderer/core/dom/ax_object_cache.h"
 #include "third_party/blink/renderer/core/dom/computed_accessible_node.h"
 #include "third_party/blink/renderer/core/dom/dataset_dom_string_map.h"
+#include "third_party/blink/renderer/core/dom/descendant_class_filter.h"
 #include "third_party/blink/renderer/core/dom/document.h"
 #include "third_party/blink/renderer/core/dom/dom_token_list.h"
 #include "third_party/blink/renderer/core/dom/element_data_cache.h"
@@ -1670,6 +1671,8 @@ void Element::ClassAttributeChanged(const AtomicString& new_class_string) {
     else
       GetElementData()->ClearClass();
   }
+  if (DescendantClassFilter* filter = GetDocument().GetDescendantClassFilter())
+    filter->ClassesChanged(*this);
 }
 
 bool Element::ShouldInvalidateDistributionWhenAttributeChanged(
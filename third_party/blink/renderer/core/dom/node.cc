@@ -37,6 +37,7 @@
 #include "third_party/blink/renderer/core/dom/ax_object_cache.h"
 #include "third_party/blink/renderer/core/dom/child_list_mutation_scope.h"
 #include "third_party/blink/renderer/core/dom/child_node_list.h"
+#include "third_party/blink/renderer/core/dom/descendant_class_filter.h"
 #include "third_party/blink/renderer/core/dom/document.h"
 #include "third_party/blink/renderer/core/dom/document_fragment.h"
 #include "third_party/blink/renderer/core/dom/document_type.h"
@@ -1996,6 +1997,13 @@ void Node::WillMoveToNewDocument(Document& old_document,
 void Node::DidMoveToNewDocument(Document& old_document) {
   TreeScopeAdopter::EnsureDidMoveToNewDocumentWasCalled(old_document);
 
+  // Changes made to the subtree while it is in another document don't update
+  // the filters of this one.
+  if (DescendantClassFilter* filter = old_document.GetDescendantClassFilter())
+    filter->Clear();
+  if (DescendantClassFilter* filter = GetDocument().GetDescendantClassFilter())
+    filter->Clear();
+
   if (const EventTargetData* event_target_data = GetEventTargetData()) {
     const EventListenerMap& listener_map =
         event_target_data->event_listener_map;
@@ -347,8 +347,7 @@ Element* HTMLCollection::TraverseToFirst() const {
       return ElementTraversal::FirstWithin(
           RootNode(), MakeIsMatch(ToHTMLTagCollection(*this)));
     case kClassCollectionType:
-      return ElementTraversal::FirstWithin(
-          RootNode(), MakeIsMatch(ToClassCollection(*this)));
+      return ToClassCollection(*this).NextMatch(nullptr);
     default:
       if (OverridesItemAfter())
         return VirtualItemAfter(nullptr);
@@ -375,10 +374,15 @@ Element* HTMLCollection::TraverseForwardToOffset(
       return TraverseMatchingElementsForwardToOffset(
           current_element, &RootNode(), offset, current_offset,
           MakeIsMatch(ToHTMLTagCollection(*this)));
-    case kClassCollectionType:
-      return TraverseMatchingElementsForwardToOffset(
-          current_element, &RootNode(), offset, current_offset,
-          MakeIsMatch(ToClassCollection(*this)));
+    case kClassCollectionType: {
+      const ClassCollection& collection = ToClassCollection(*this);
+      for (Element* next = collection.NextMatch(&current_element); next;
+           next = collection.NextMatch(next)) {
+        if (++current_offset == offset)
+          return next;
+      }
+      return nullptr;
+    }
     default:
       if (OverridesItemAfter()) {
         for (Element* next = VirtualItemAfter(&current_element); next;
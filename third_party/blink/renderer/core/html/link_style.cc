@@ -17,6 +17,7 @@
 #include "third_party/blink/renderer/core/loader/subresource_integrity_helper.h"
 #include "third_party/blink/renderer/platform/histogram.h"
 #include "third_party/blink/renderer/platform/loader/fetch/fetch_parameters.h"
+#include "third_party/blink/renderer/platform/loader/fetch/resource_fetcher.h"
 #include "third_party/blink/renderer/platform/loader/subresource_integrity.h"
 #include "third_party/blink/renderer/platform/network/mime/content_type.h"
 #include "third_party/blink/renderer/platform/network/mime/mime_type_registry.h"
@@ -182,6 +183,11 @@ void LinkStyle::AddPendingSheet(PendingSheetType type) {
   if (pending_sheet_type_ == kNonBlocking)
     return;
   GetDocument().GetStyleEngine().AddPendingSheet(style_engine_context_);
+
+  // A sheet which was loading at a low priority, e.g. an alternate sheet which
+  // has been enabled, now blocks rendering.
+  if (GetResource() && GetDocument().Fetcher())
+    GetDocument().Fetcher()->MarkResourceAsRenderBlocking(GetResource());
 }
 
 void LinkStyle::RemovePendingSheet() {
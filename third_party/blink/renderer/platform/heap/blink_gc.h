@@ -64,6 +64,9 @@ using MovingObjectCallback = void (*)(void* callback_data,
 class PLATFORM_EXPORT WorklistTaskId {
  public:
   static constexpr int MainThread = 0;
+  // Number of tasks, the main thread included, that may mark in parallel. See
+  // ThreadHeap::ProcessMarkingWorklistInParallel().
+  static constexpr int kMaxMarkingTasks = 4;
 };
 
 class PLATFORM_EXPORT BlinkGC final {
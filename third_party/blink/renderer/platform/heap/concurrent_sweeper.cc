@@ -0,0 +1,89 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/platform/heap/concurrent_sweeper.h"
+
+#include "base/threading/platform_thread.h"
+
+namespace blink {
+
+ConcurrentSweeper::ConcurrentSweeper(const std::vector<NormalPage*>& pages)
+    : entries_(pages.size()),
+      stopped_(0),
+      thread_(this, "BlinkHeapSweeper") {
+  for (size_t i = 0; i < pages.size(); ++i) {
+    DCHECK(!pages[i]->HasBeenSwept());
+    entries_[i].page = pages[i];
+    entries_[i].state = kUnclaimed;
+    entry_indices_.insert(pages[i], i);
+  }
+}
+
+ConcurrentSweeper::~ConcurrentSweeper() {
+  Stop();
+}
+
+void ConcurrentSweeper::Start() {
+  thread_.Start();
+}
+
+void ConcurrentSweeper::Stop() {
+  if (!thread_.HasBeenStarted() || thread_.HasBeenJoined())
+    return;
+  base::subtle::Release_Store(&stopped_, 1);
+  thread_.Join();
+}
+
+bool ConcurrentSweeper::IsSweptConcurrently(BasePage* page) {
+  PageEntry* entry = FindEntry(page);
+  return entry && ClaimForMainThread(entry) == kSweptConcurrently;
+}
+
+bool ConcurrentSweeper::FinishSweepingPage(BasePage* page) {
+  PageEntry* entry = FindEntry(page);
+  if (!entry || ClaimForMainThread(entry) != kSweptConcurrently)
+    return false;
+  entry->page->FinishSweep(entry->result);
+  entry->result = NormalPage::SweepResult();
+  entry_indices_.erase(page);
+  return true;
+}
+
+void ConcurrentSweeper::Run() {
+  for (PageEntry& entry : entries_) {
+    if (base::subtle::Acquire_Load(&stopped_))
+      return;
+    if (base::subtle::Acquire_CompareAndSwap(&entry.state, kUnclaimed,
+                                             kSweepingConcurrently) !=
+        kUnclaimed) {
+      continue;
+    }
+    // Empty pages are freed by the main thread.
+    bool swept = !entry.page->IsEmpty() &&
+                 entry.page->SweepWithoutFinalizers(&entry.result);
+    base::subtle::Release_Store(
+        &entry.state, swept ? kSweptConcurrently : kLeftToMainThread);
+  }
+}
+
+ConcurrentSweeper::PageEntry* ConcurrentSweeper::FindEntry(BasePage* page) {
+  auto it = entry_indices_.find(page);
+  if (it == entry_indices_.end())
+    return nullptr;
+  return &entries_[it->value];
+}
+
+base::subtle::Atomic32 ConcurrentSweeper::ClaimForMainThread(
+    PageEntry* entry) {
+  base::subtle::Atomic32 state = base::subtle::Acquire_CompareAndSwap(
+      &entry->state, kUnclaimed, kLeftToMainThread);
+  // The background thread sweeps one page at a time, so this is short.
+  while (state == kSweepingConcurrently) {
+    base::PlatformThread::YieldCurrentThread();
+    state = base::subtle::Acquire_Load(&entry->state);
+  }
+  return state == kUnclaimed ? kLeftToMainThread : state;
+}
+
+}  // namespace blink
@@ -0,0 +1,88 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef THIRD_PARTY_BLINK_RENDERER_PLATFORM_HEAP_CONCURRENT_SWEEPER_H_
+#define THIRD_PARTY_BLINK_RENDERER_PLATFORM_HEAP_CONCURRENT_SWEEPER_H_
+
+#include <vector>
+
+#include "base/atomicops.h"
+#include "base/macros.h"
+#include "base/threading/simple_thread.h"
+#include "third_party/blink/renderer/platform/heap/heap_page.h"
+#include "third_party/blink/renderer/platform/platform_export.h"
+#include "third_party/blink/renderer/platform/wtf/hash_map.h"
+
+namespace blink {
+
+// Sweeps normal pages on a background thread while the mutator runs after a
+// garbage collection, ahead of lazy sweeping on the main thread.
+//
+// Only pages on which no dead object needs to be finalized are swept in the
+// background, as finalizers must run on the main thread. The free memory found
+// is added to the arena's free list by the main thread once lazy sweeping
+// reaches the page (FinishSweepingPage()). Pages stay on their arena's list of
+// unswept pages until then, and each page is claimed by exactly one of the
+// two threads.
+class PLATFORM_EXPORT ConcurrentSweeper final
+    : public base::DelegateSimpleThread::Delegate {
+ public:
+  // |pages| must all be unswept.
+  explicit ConcurrentSweeper(const std::vector<NormalPage*>& pages);
+  ~ConcurrentSweeper() override;
+
+  void Start();
+
+  // Stops the background thread. Pages it has not claimed yet are left to the
+  // main thread.
+  void Stop();
+
+  // Returns true if |page| is being or has been swept on the background
+  // thread, waiting for the former to finish. Otherwise makes sure the page
+  // is left to the main thread.
+  bool IsSweptConcurrently(BasePage* page);
+
+  // Must be called by the main thread before it sweeps |page|. Returns true if
+  // the page has been swept on the background thread, in which case the free
+  // memory found has been added to the arena and the page must not be swept
+  // again.
+  bool FinishSweepingPage(BasePage* page);
+
+  // base::DelegateSimpleThread::Delegate:
+  void Run() override;
+
+ private:
+  enum PageState : base::subtle::Atomic32 {
+    kUnclaimed,
+    kSweepingConcurrently,
+    kSweptConcurrently,
+    kLeftToMainThread,
+  };
+
+  struct PageEntry {
+    NormalPage* page;
+    base::subtle::Atomic32 state;
+    NormalPage::SweepResult result;
+  };
+
+  PageEntry* FindEntry(BasePage*);
+
+  // Claims |entry| for the main thread unless the background thread claimed
+  // it first, in which case this waits for it to be swept. Returns the
+  // resulting state.
+  base::subtle::Atomic32 ClaimForMainThread(PageEntry* entry);
+
+  // Not resized once the background thread has started.
+  std::vector<PageEntry> entries_;
+  // Main thread only.
+  HashMap<BasePage*, size_t> entry_indices_;
+  base::subtle::Atomic32 stopped_;
+  base::DelegateSimpleThread thread_;
+
+  DISALLOW_COPY_AND_ASSIGN(ConcurrentSweeper);
+};
+
+}  // namespace blink
+
+#endif  // THIRD_PARTY_BLINK_RENDERER_PLATFORM_HEAP_CONCURRENT_SWEEPER_H_
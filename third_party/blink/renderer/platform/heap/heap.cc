@@ -33,12 +33,19 @@
 #include <algorithm>
 #include <limits>
 #include <memory>
+#include <utility>
+#include <vector>
 
+#include "base/atomicops.h"
+#include "base/sys_info.h"
+#include "base/threading/platform_thread.h"
+#include "base/threading/simple_thread.h"
 #include "base/trace_event/process_memory_dump.h"
 #include "third_party/blink/public/platform/platform.h"
 #include "third_party/blink/renderer/platform/bindings/script_forbidden_scope.h"
 #include "third_party/blink/renderer/platform/heap/address_cache.h"
 #include "third_party/blink/renderer/platform/heap/blink_gc_memory_dump_provider.h"
+#include "third_party/blink/renderer/platform/heap/concurrent_sweeper.h"
 #include "third_party/blink/renderer/platform/heap/heap_compact.h"
 #include "third_party/blink/renderer/platform/heap/heap_stats_collector.h"
 #include "third_party/blink/renderer/platform/heap/marking_visitor.h"
@@ -50,6 +57,7 @@
 #include "third_party/blink/renderer/platform/instrumentation/tracing/trace_event.h"
 #include "third_party/blink/renderer/platform/instrumentation/tracing/web_memory_allocator_dump.h"
 #include "third_party/blink/renderer/platform/instrumentation/tracing/web_process_memory_dump.h"
+#include "third_party/blink/renderer/platform/runtime_enabled_features.h"
 #include "third_party/blink/renderer/platform/wtf/allocator/partitions.h"
 #include "third_party/blink/renderer/platform/wtf/assertions.h"
 #include "third_party/blink/renderer/platform/wtf/leak_annotations.h"
@@ -60,6 +68,58 @@ namespace blink {
 HeapAllocHooks::AllocationHook* HeapAllocHooks::allocation_hook_ = nullptr;
 HeapAllocHooks::FreeHook* HeapAllocHooks::free_hook_ = nullptr;
 
+namespace {
+
+// Empties a marking worklist using several visitors at once. A marker that
+// runs out of work waits for others to publish more to the global pool, and
+// all markers return once none of them has any work left.
+class ParallelMarker {
+ public:
+  ParallelMarker(MarkingWorklist* worklist, int marker_count)
+      : worklist_(worklist), active_markers_(marker_count) {}
+
+  void Mark(MarkingVisitor* visitor) {
+    const int task_id = visitor->task_id();
+    MarkingItem item;
+    while (true) {
+      while (worklist_->Pop(task_id, &item))
+        item.callback(visitor, item.object);
+
+      base::subtle::Barrier_AtomicIncrement(&active_markers_, -1);
+      while (worklist_->IsGlobalPoolEmpty()) {
+        if (!base::subtle::Acquire_Load(&active_markers_))
+          return;
+        base::PlatformThread::YieldCurrentThread();
+      }
+      base::subtle::Barrier_AtomicIncrement(&active_markers_, 1);
+    }
+  }
+
+ private:
+  MarkingWorklist* const worklist_;
+  // Number of markers that may still push work to |worklist_|.
+  base::subtle::Atomic32 active_markers_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelMarker);
+};
+
+class ParallelMarkingTask : public base::DelegateSimpleThread::Delegate {
+ public:
+  ParallelMarkingTask(ParallelMarker* marker,
+                      std::unique_ptr<MarkingVisitor> visitor)
+      : marker_(marker), visitor_(std::move(visitor)) {}
+
+  void Run() override { marker_->Mark(visitor_.get()); }
+
+ private:
+  ParallelMarker* const marker_;
+  std::unique_ptr<MarkingVisitor> visitor_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelMarkingTask);
+};
+
+}  // namespace
+
 
 ThreadHeap::ThreadHeap(ThreadState* thread_state)
     : thread_state_(thread_state),
@@ -87,6 +147,7 @@ ThreadHeap::ThreadHeap(ThreadState* thread_state)
 }
 
 ThreadHeap::~ThreadHeap() {
+  DCHECK(!concurrent_sweeper_);
   for (int i = 0; i < BlinkGC::kNumberOfArenas; ++i)
     delete arenas_[i];
 }
@@ -170,6 +231,7 @@ Address ThreadHeap::CheckAndMarkPointer(
 void ThreadHeap::RegisterWeakTable(void* table,
                                    EphemeronCallback iteration_callback) {
   DCHECK(thread_state_->InAtomicMarkingPause());
+  base::AutoLock lock(ephemeron_callbacks_lock_);
 #if DCHECK_IS_ON()
   auto result = ephemeron_callbacks_.insert(table, iteration_callback);
   DCHECK(result.is_new_entry ||
@@ -269,6 +331,13 @@ bool ThreadHeap::AdvanceMarkingStackProcessing(Visitor* visitor,
       // currently pushed onto the marking worklist.
       ThreadHeapStatsCollector::Scope stats_scope(
           stats_collector(), ThreadHeapStatsCollector::kMarkProcessWorklist);
+      if (deadline_seconds == std::numeric_limits<double>::infinity()) {
+        MarkingVisitor* marking_visitor =
+            reinterpret_cast<MarkingVisitor*>(visitor);
+        int helper_count = ParallelMarkingHelperCount(marking_visitor);
+        if (helper_count > 0)
+          ProcessMarkingWorklistInParallel(marking_visitor, helper_count);
+      }
       MarkingItem item;
       while (marking_worklist_->Pop(WorklistTaskId::MainThread, &item)) {
         item.callback(visitor, item.object);
@@ -288,6 +357,56 @@ bool ThreadHeap::AdvanceMarkingStackProcessing(Visitor* visitor,
   return true;
 }
 
+int ThreadHeap::ParallelMarkingHelperCount(MarkingVisitor* visitor) const {
+  if (!RuntimeEnabledFeatures::HeapParallelMarkingEnabled())
+    return 0;
+  // Compaction and snapshots record marked objects in data structures that
+  // are not thread safe.
+  if (visitor->marking_mode() != MarkingVisitor::kGlobalMarking)
+    return 0;
+  if (!thread_state_->InAtomicMarkingPause())
+    return 0;
+  return std::min(WorklistTaskId::kMaxMarkingTasks,
+                  base::SysInfo::NumberOfProcessors()) -
+         1;
+}
+
+void ThreadHeap::ProcessMarkingWorklistInParallel(MarkingVisitor* visitor,
+                                                  int helper_count) {
+  DCHECK(thread_state_->InAtomicMarkingPause());
+  DCHECK_EQ(WorklistTaskId::MainThread, visitor->task_id());
+  DCHECK_GT(helper_count, 0);
+  DCHECK_LT(helper_count, WorklistTaskId::kMaxMarkingTasks);
+
+  // Make the main thread's pending work available to the helpers.
+  marking_worklist_->FlushToGlobal(WorklistTaskId::MainThread);
+
+  ParallelMarker marker(marking_worklist_.get(), helper_count + 1);
+  std::vector<std::unique_ptr<ParallelMarkingTask>> tasks;
+  std::vector<std::unique_ptr<base::DelegateSimpleThread>> threads;
+  visitor->set_marks_in_parallel(true);
+  for (int task_id = 1; task_id <= helper_count; ++task_id) {
+    tasks.push_back(std::make_unique<ParallelMarkingTask>(
+        &marker, std::make_unique<MarkingVisitor>(
+                     thread_state_, visitor->marking_mode(), task_id)));
+    threads.push_back(std::make_unique<base::DelegateSimpleThread>(
+        tasks.back().get(), "BlinkHeapMarker"));
+    threads.back()->Start();
+  }
+  marker.Mark(visitor);
+  for (auto& thread : threads)
+    thread->Join();
+  visitor->set_marks_in_parallel(false);
+
+  // Later phases only process the main thread's worklists, which pick up
+  // anything published to the global pools.
+  for (int task_id = 1; task_id <= helper_count; ++task_id) {
+    not_fully_constructed_worklist_->FlushToGlobal(task_id);
+    weak_callback_worklist_->FlushToGlobal(task_id);
+  }
+  DCHECK(marking_worklist_->IsGlobalEmpty());
+}
+
 void ThreadHeap::WeakProcessing(Visitor* visitor) {
   ThreadHeapStatsCollector::Scope stats_scope(
       stats_collector(), ThreadHeapStatsCollector::kMarkWeakProcessing);
@@ -409,6 +528,51 @@ void ThreadHeap::CompleteSweep() {
     arenas_[i]->CompleteSweep();
 }
 
+void ThreadHeap::StartConcurrentSweeping() {
+  DCHECK(thread_state_->CheckThread());
+  DCHECK(thread_state_->IsSweepingInProgress());
+  DCHECK(!concurrent_sweeper_);
+#if defined(ADDRESS_SANITIZER)
+  // Unmarked objects stay poisoned until the main thread sweeps them.
+  const bool can_sweep_concurrently = false;
+#else
+  // Frees must be reported to the hook on the main thread.
+  const bool can_sweep_concurrently = !HeapAllocHooks::IsFreeHookEnabled();
+#endif
+  if (!can_sweep_concurrently)
+    return;
+
+  std::vector<NormalPage*> pages;
+  for (int i = 0; i < BlinkGC::kLargeObjectArenaIndex; ++i) {
+    // The eagerly swept arena has been swept already.
+    if (i == BlinkGC::kEagerSweepArenaIndex)
+      continue;
+    for (BasePage* page = arenas_[i]->first_unswept_page(); page;
+         page = page->Next())
+      pages.push_back(static_cast<NormalPage*>(page));
+  }
+  if (pages.empty())
+    return;
+  concurrent_sweeper_ = std::make_unique<ConcurrentSweeper>(pages);
+  concurrent_sweeper_->Start();
+}
+
+void ThreadHeap::StopConcurrentSweeping() {
+  DCHECK(thread_state_->CheckThread());
+  if (!concurrent_sweeper_)
+    return;
+  concurrent_sweeper_->Stop();
+  concurrent_sweeper_.reset();
+}
+
+bool ThreadHeap::FinishConcurrentlySweptPage(BasePage* page) {
+  return concurrent_sweeper_ && concurrent_sweeper_->FinishSweepingPage(page);
+}
+
+bool ThreadHeap::IsSweptConcurrently(BasePage* page) {
+  return concurrent_sweeper_ && concurrent_sweeper_->IsSweptConcurrently(page);
+}
+
 void ThreadHeap::ClearArenaAges() {
   memset(arena_ages_, 0, sizeof(size_t) * BlinkGC::kNumberOfArenas);
   memset(likely_to_be_promptly_freed_.get(), 0,
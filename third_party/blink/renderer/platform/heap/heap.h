@@ -35,6 +35,7 @@
 #include <memory>
 
 #include "base/macros.h"
+#include "base/synchronization/lock.h"
 #include "build/build_config.h"
 #include "third_party/blink/renderer/platform/heap/gc_info.h"
 #include "third_party/blink/renderer/platform/heap/heap_page.h"
@@ -71,11 +72,16 @@ using NotFullyConstructedItem = void*;
 
 // Segment size of 512 entries necessary to avoid throughput regressions. Since
 // the work list is currently a temporary object this is not a problem.
-using MarkingWorklist = Worklist<MarkingItem, 512 /* local entries */>;
+using MarkingWorklist = Worklist<MarkingItem,
+                                 512 /* local entries */,
+                                 WorklistTaskId::kMaxMarkingTasks>;
 using NotFullyConstructedWorklist =
-    Worklist<NotFullyConstructedItem, 16 /* local entries */>;
-using WeakCallbackWorklist =
-    Worklist<CustomCallbackItem, 256 /* local entries */>;
+    Worklist<NotFullyConstructedItem,
+             16 /* local entries */,
+             WorklistTaskId::kMaxMarkingTasks>;
+using WeakCallbackWorklist = Worklist<CustomCallbackItem,
+                                      256 /* local entries */,
+                                      WorklistTaskId::kMaxMarkingTasks>;
 
 class PLATFORM_EXPORT HeapAllocHooks {
  public:
@@ -103,6 +109,8 @@ class PLATFORM_EXPORT HeapAllocHooks {
       allocation_hook(address, size, type_name);
   }
 
+  static bool IsFreeHookEnabled() { return !!free_hook_; }
+
   static void FreeHookIfEnabled(Address address) {
     FreeHook* free_hook = free_hook_;
     if (UNLIKELY(!!free_hook))
@@ -114,6 +122,7 @@ class PLATFORM_EXPORT HeapAllocHooks {
   static FreeHook* free_hook_;
 };
 
+class ConcurrentSweeper;
 class HeapCompact;
 template <typename T>
 class Member;
@@ -227,6 +236,11 @@ class PLATFORM_EXPORT ThreadHeap {
       return false;
     DCHECK(page->Arena()->GetThreadState()->IsSweepingInProgress());
 
+    // Only pages without dead objects to finalize are swept concurrently, so
+    // objects on them are alive.
+    if (page->Arena()->GetThreadState()->Heap().IsSweptConcurrently(page))
+      return false;
+
     // If marked and alive, the object hasn't yet been swept..and won't
     // be once its page is processed.
     if (ThreadHeap::IsHeapObjectAlive(const_cast<T*>(object_pointer)))
@@ -393,6 +407,21 @@ class PLATFORM_EXPORT ThreadHeap {
   void RemoveAllPages();
   void CompleteSweep();
 
+  // Starts sweeping pages on a background thread ahead of lazy sweeping; see
+  // ConcurrentSweeper. StopConcurrentSweeping() must be called once sweeping
+  // has completed.
+  void StartConcurrentSweeping();
+  void StopConcurrentSweeping();
+  bool IsSweepingConcurrently() const { return !!concurrent_sweeper_; }
+
+  // Must be called before sweeping |page| on the main thread. Returns true if
+  // the page has already been swept on the background thread.
+  bool FinishConcurrentlySweptPage(BasePage*);
+
+  // Returns true if |page| is being or has been swept on the background
+  // thread.
+  bool IsSweptConcurrently(BasePage*);
+
   enum SnapshotType { kHeapSnapshot, kFreelistSnapshot };
   void TakeSnapshot(SnapshotType);
 
@@ -430,6 +459,16 @@ class PLATFORM_EXPORT ThreadHeap {
 
   void InvokeEphemeronCallbacks(Visitor*);
 
+  // Returns the number of helper threads ProcessMarkingWorklistInParallel()
+  // would use with |visitor|, or zero if marking must stay on the main thread.
+  int ParallelMarkingHelperCount(MarkingVisitor*) const;
+
+  // Empties the marking worklist using |visitor| on the main thread and
+  // |helper_count| helper threads. Only used in the atomic pause, while the
+  // mutator is stopped, and only when not compacting, as compaction's slot
+  // registration is not thread safe.
+  void ProcessMarkingWorklistInParallel(MarkingVisitor*, int helper_count);
+
   // Write barrier assuming that incremental marking is running and value is not
   // nullptr. Use MarkingVisitor::WriteBarrier as entrypoint.
   void WriteBarrier(void* value);
@@ -445,9 +484,12 @@ class PLATFORM_EXPORT ThreadHeap {
   // No duplicates allowed for ephemeron callbacks. Hence, we use a hashmap
   // with the key being the HashTable.
   WTF::HashMap<void*, EphemeronCallback> ephemeron_callbacks_;
+  // Guards |ephemeron_callbacks_| while marking in parallel.
+  base::Lock ephemeron_callbacks_lock_;
   StackFrameDepth stack_frame_depth_;
 
   std::unique_ptr<HeapCompact> compaction_;
+  std::unique_ptr<ConcurrentSweeper> concurrent_sweeper_;
 
   BaseArena* arenas_[BlinkGC::kNumberOfArenas];
   int vector_backing_arena_index_;
@@ -20,6 +20,9 @@ void HeapAllocator::BackingFree(void* address) {
   BasePage* page = PageFromObject(address);
   if (page->IsLargeObjectPage() || page->Arena()->GetThreadState() != state)
     return;
+  // Don't touch pages that may be being swept on another thread.
+  if (!page->HasBeenSwept() && state->Heap().IsSweepingConcurrently())
+    return;
 
   HeapObjectHeader* header = HeapObjectHeader::FromPayload(address);
   // Don't promptly free marked backing as they may be registered on the marking
@@ -102,6 +105,9 @@ bool HeapAllocator::BackingShrink(void* address,
   BasePage* page = PageFromObject(address);
   if (page->IsLargeObjectPage() || page->Arena()->GetThreadState() != state)
     return false;
+  // Don't touch pages that may be being swept on another thread.
+  if (!page->HasBeenSwept() && state->Heap().IsSweepingConcurrently())
+    return true;
 
   HeapObjectHeader* header = HeapObjectHeader::FromPayload(address);
   NormalPageArena* arena = static_cast<NormalPage*>(page)->ArenaForNormalPage();
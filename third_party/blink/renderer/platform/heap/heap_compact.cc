@@ -382,16 +382,20 @@ void HeapCompact::UpdateHeapResidency() {
     size_t arena_size = arena->ArenaSize();
     size_t free_list_size = arena->FreeListSize();
     total_arena_size += arena_size;
-    total_free_list_size += free_list_size;
 #if DEBUG_HEAP_FREELIST
     stream << i << ": [" << arena_size << ", " << free_list_size << "], ";
 #endif
-    // TODO: be more discriminating and consider arena
-    // load factor, effectiveness of past compactions etc.
     if (!arena_size)
       continue;
+    // Skip arenas whose free lists hold too little of their size for moving
+    // their objects to be worth it, unless compaction is forced.
+    if (!force_compaction_gc_ &&
+        free_list_size * 100 < arena_size * kMinFragmentationPercent) {
+      continue;
+    }
     // Mark the arena as compactable.
     compactable_arenas_ |= 0x1u << i;
+    total_free_list_size += free_list_size;
   }
 #if DEBUG_HEAP_FREELIST
   LOG_HEAP_FREELIST() << "Arena residencies: {" << stream.str() << "}";
@@ -146,6 +146,10 @@ class PLATFORM_EXPORT HeapCompact final {
   // should be considered.
   static const size_t kFreeListSizeThreshold = 512 * 1024;
 
+  // Percentage of an arena's size that must be on its freelist for the arena
+  // to be compacted.
+  static const size_t kMinFragmentationPercent = 20;
+
   ThreadHeap* const heap_;
 
   MovableObjectFixups& Fixups();
@@ -156,7 +160,7 @@ class PLATFORM_EXPORT HeapCompact final {
   bool do_compact_;
   size_t gc_count_since_last_compaction_;
 
-  // Last reported freelist size, across all compactable arenas.
+  // Last reported freelist size, across the arenas picked for compaction.
   size_t free_list_size_;
 
   // If compacting, i'th heap arena will be compacted
@@ -278,19 +278,25 @@ Address BaseArena::LazySweep(size_t allocation_size, size_t gc_info_index) {
   return result;
 }
 
-void BaseArena::SweepUnsweptPage() {
+bool BaseArena::SweepUnsweptPage() {
   BasePage* page = first_unswept_page_;
-  if (page->IsEmpty()) {
+  // Pages swept concurrently only need their free memory added to the free
+  // list.
+  bool swept_concurrently =
+      GetThreadState()->Heap().FinishConcurrentlySweptPage(page);
+  if (!swept_concurrently && page->IsEmpty()) {
     page->Unlink(&first_unswept_page_);
     page->RemoveFromHeap();
-  } else {
-    // Sweep a page and move the page from m_firstUnsweptPages to
-    // m_firstPages.
-    page->Sweep();
-    page->Unlink(&first_unswept_page_);
-    page->Link(&first_page_);
-    page->MarkAsSwept();
+    return false;
   }
+  // Sweep a page and move the page from m_firstUnsweptPages to
+  // m_firstPages.
+  if (!swept_concurrently)
+    page->Sweep();
+  page->Unlink(&first_unswept_page_);
+  page->Link(&first_page_);
+  page->MarkAsSwept();
+  return true;
 }
 
 bool BaseArena::LazySweepWithDeadline(double deadline_seconds) {
@@ -834,24 +840,13 @@ Address NormalPageArena::LazySweepPages(size_t allocation_size,
   base::AutoReset<bool> is_lazy_sweeping(&is_lazy_sweeping_, true);
   Address result = nullptr;
   while (!SweepingCompleted()) {
-    BasePage* page = first_unswept_page_;
-    if (page->IsEmpty()) {
-      page->Unlink(&first_unswept_page_);
-      page->RemoveFromHeap();
-    } else {
-      // Sweep a page and move the page from m_firstUnsweptPages to
-      // m_firstPages.
-      page->Sweep();
-      page->Unlink(&first_unswept_page_);
-      page->Link(&first_page_);
-      page->MarkAsSwept();
-
-      // For NormalPage, stop lazy sweeping once we find a slot to
-      // allocate a new object.
-      result = AllocateFromFreeList(allocation_size, gc_info_index);
-      if (result)
-        break;
-    }
+    if (!SweepUnsweptPage())
+      continue;
+    // For NormalPage, stop lazy sweeping once we find a slot to
+    // allocate a new object.
+    result = AllocateFromFreeList(allocation_size, gc_info_index);
+    if (result)
+      break;
   }
   return result;
 }
@@ -1400,6 +1395,82 @@ void NormalPage::Sweep() {
   VerifyObjectStartBitmapIsConsistentWithPayload();
 }
 
+bool NormalPage::SweepWithoutFinalizers(SweepResult* result) {
+  DCHECK(result->free_ranges.empty());
+  // GCInfo entries never change once registered, so reading them here is
+  // safe on any thread.
+  GCInfoTable& gc_info_table = GCInfoTable::Get();
+  for (Address header_address = Payload(); header_address < PayloadEnd();) {
+    HeapObjectHeader* header =
+        reinterpret_cast<HeapObjectHeader*>(header_address);
+    if (!header->IsFree() && !header->IsMarked() &&
+        gc_info_table.GCInfoFromIndex(header->GcInfoIndex())->HasFinalizer()) {
+      return false;
+    }
+    header_address += header->size();
+  }
+
+  object_start_bit_map()->Clear();
+  size_t marked_object_size = 0;
+  Address start_of_gap = Payload();
+  for (Address header_address = start_of_gap; header_address < PayloadEnd();) {
+    HeapObjectHeader* header =
+        reinterpret_cast<HeapObjectHeader*>(header_address);
+    size_t size = header->size();
+    DCHECK_GT(size, 0u);
+    DCHECK_LT(size, BlinkPagePayloadSize());
+
+    if (header->IsFree()) {
+      SET_MEMORY_INACCESSIBLE(header_address, size < sizeof(FreeListEntry)
+                                                  ? size
+                                                  : sizeof(FreeListEntry));
+      CHECK_MEMORY_INACCESSIBLE(header_address, size);
+      header_address += size;
+      continue;
+    }
+    if (!header->IsMarked()) {
+      // Dead objects here need no finalization; just clear their memory.
+      SET_MEMORY_INACCESSIBLE(header_address, size);
+      header_address += size;
+      continue;
+    }
+    if (start_of_gap != header_address) {
+      result->free_ranges.emplace_back(start_of_gap,
+                                       header_address - start_of_gap);
+#if !DCHECK_IS_ON() && !defined(LEAK_SANITIZER) && !defined(ADDRESS_SANITIZER)
+      if (MemoryCoordinator::IsLowEndDevice())
+        DiscardPages(start_of_gap + sizeof(FreeListEntry), header_address);
+#endif
+    }
+    object_start_bit_map()->SetBit(header_address);
+    header->Unmark();
+    header_address += size;
+    marked_object_size += size;
+    start_of_gap = header_address;
+  }
+  if (start_of_gap != PayloadEnd()) {
+    result->free_ranges.emplace_back(start_of_gap, PayloadEnd() - start_of_gap);
+#if !DCHECK_IS_ON() && !defined(LEAK_SANITIZER) && !defined(ADDRESS_SANITIZER)
+    if (MemoryCoordinator::IsLowEndDevice())
+      DiscardPages(start_of_gap + sizeof(FreeListEntry), PayloadEnd());
+#endif
+  }
+  result->marked_object_size = marked_object_size;
+
+  VerifyObjectStartBitmapIsConsistentWithPayload();
+  return true;
+}
+
+void NormalPage::FinishSweep(const SweepResult& result) {
+  NormalPageArena* page_arena = ArenaForNormalPage();
+  for (const auto& free_range : result.free_ranges)
+    page_arena->AddToFreeList(free_range.first, free_range.second);
+  if (result.marked_object_size) {
+    page_arena->GetThreadState()->Heap().IncreaseMarkedObjectSize(
+        result.marked_object_size);
+  }
+}
+
 void NormalPage::SweepAndCompact(CompactionContext& context) {
   object_start_bit_map()->Clear();
   NormalPage*& current_page = context.current_page_;
@@ -32,6 +32,11 @@
 #define THIRD_PARTY_BLINK_RENDERER_PLATFORM_HEAP_HEAP_PAGE_H_
 
 #include <stdint.h>
+
+#include <utility>
+#include <vector>
+
+#include "base/atomicops.h"
 #include "base/bits.h"
 #include "base/trace_event/memory_allocator_dump.h"
 #include "build/build_config.h"
@@ -206,6 +211,8 @@ class PLATFORM_EXPORT HeapObjectHeader {
   void Mark();
   void Unmark();
   bool TryMark();
+  // Like TryMark(), but safe against other threads marking at the same time.
+  bool TryMarkAtomic();
 
   // The payload starts directly after the HeapObjectHeader, and the payload
   // size does not include the sizeof(HeapObjectHeader).
@@ -554,6 +561,21 @@ class PLATFORM_EXPORT NormalPage final : public BasePage {
 
   void SweepAndCompact(CompactionContext&);
 
+  // Free memory and size of marked objects found by SweepWithoutFinalizers().
+  struct SweepResult {
+    std::vector<std::pair<Address, size_t>> free_ranges;
+    size_t marked_object_size = 0;
+  };
+
+  // Like Sweep(), but may run off the main thread: free memory is recorded in
+  // |result| rather than added to the arena's free list. Returns false,
+  // leaving the page untouched, if any dead object on the page needs to be
+  // finalized.
+  bool SweepWithoutFinalizers(SweepResult* result);
+
+  // Adds the free memory found by SweepWithoutFinalizers() to the arena.
+  void FinishSweep(const SweepResult&);
+
   // Object start bitmap of this page.
   ObjectStartBitmap* object_start_bit_map() { return &object_start_bit_map_; }
 
@@ -714,7 +736,9 @@ class PLATFORM_EXPORT BaseArena {
   void PoisonArena();
 #endif
   Address LazySweep(size_t, size_t gc_info_index);
-  void SweepUnsweptPage();
+  // Sweeps the first unswept page. Returns false if the page was empty and
+  // has been freed.
+  bool SweepUnsweptPage();
   // Returns true if we have swept all pages within the deadline. Returns false
   // otherwise.
   bool LazySweepWithDeadline(double deadline_seconds);
@@ -727,6 +751,8 @@ class PLATFORM_EXPORT BaseArena {
 
   bool WillObjectBeLazilySwept(BasePage*, void*) const;
 
+  BasePage* first_unswept_page() const { return first_unswept_page_; }
+
   virtual void VerifyObjectStartBitmap(){};
   virtual void VerifyMarking(){};
 
@@ -1025,6 +1051,24 @@ NO_SANITIZE_ADDRESS inline bool HeapObjectHeader::TryMark() {
   return true;
 }
 
+NO_SANITIZE_ADDRESS inline bool HeapObjectHeader::TryMarkAtomic() {
+  CheckHeader();
+  const base::subtle::Atomic32 mark_bit =
+      static_cast<base::subtle::Atomic32>(kHeaderMarkBitMask);
+  base::subtle::Atomic32* encoded =
+      reinterpret_cast<base::subtle::Atomic32*>(&encoded_);
+  base::subtle::Atomic32 old_value = base::subtle::NoBarrier_Load(encoded);
+  while (!(old_value & mark_bit)) {
+    const base::subtle::Atomic32 seen_value =
+        base::subtle::NoBarrier_CompareAndSwap(encoded, old_value,
+                                               old_value | mark_bit);
+    if (seen_value == old_value)
+      return true;
+    old_value = seen_value;
+  }
+  return false;
+}
+
 NO_SANITIZE_ADDRESS inline bool BasePage::IsValid() const {
   return GetMagic() == magic_;
 }
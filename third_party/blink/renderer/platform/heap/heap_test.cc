@@ -51,6 +51,7 @@
 #include "third_party/blink/renderer/platform/heap/stack_frame_depth.h"
 #include "third_party/blink/renderer/platform/heap/thread_state.h"
 #include "third_party/blink/renderer/platform/heap/visitor.h"
+#include "third_party/blink/renderer/platform/runtime_enabled_features.h"
 #include "third_party/blink/renderer/platform/testing/unit_test_helpers.h"
 #include "third_party/blink/renderer/platform/web_task_runner.h"
 #include "third_party/blink/renderer/platform/wtf/hash_traits.h"
@@ -1969,6 +1970,45 @@ TEST(HeapTest, LazySweepingPages) {
   EXPECT_EQ(11000, SimpleFinalizedObject::destructor_calls_);
 }
 
+TEST(HeapTest, ConcurrentSweeping) {
+  bool was_enabled = RuntimeEnabledFeatures::HeapConcurrentSweepingEnabled();
+  RuntimeEnabledFeatures::SetHeapConcurrentSweepingEnabled(true);
+  ClearOutOldGarbage();
+  ThreadState* state = ThreadState::Current();
+
+  SimpleFinalizedObject::destructor_calls_ = 0;
+  Persistent<HeapVector<Member<IntNode>>> live =
+      new HeapVector<Member<IntNode>>();
+  for (int i = 0; i < 10000; i++) {
+    IntNode* node = IntNode::Create(i);
+    if (i % 10 == 0)
+      live->push_back(node);
+  }
+  for (int i = 0; i < 1000; i++)
+    SimpleFinalizedObject::Create();
+  state->CollectGarbage(BlinkGC::kNoHeapPointersOnStack,
+                        BlinkGC::kAtomicMarking, BlinkGC::kLazySweeping,
+                        BlinkGC::kForcedGC);
+#if !defined(ADDRESS_SANITIZER)
+  EXPECT_TRUE(state->Heap().IsSweepingConcurrently());
+#endif
+
+  // Reuse memory freed by either thread.
+  for (int i = 0; i < 10000; i++)
+    IntNode::Create(-1);
+  state->CompleteSweep();
+  EXPECT_FALSE(state->Heap().IsSweepingConcurrently());
+  EXPECT_EQ(1000, SimpleFinalizedObject::destructor_calls_);
+  ASSERT_EQ(1000u, live->size());
+  for (int i = 0; i < 1000; i++)
+    EXPECT_EQ(10 * i, live->at(i)->Value());
+
+  PreciselyCollectGarbage();
+  for (int i = 0; i < 1000; i++)
+    EXPECT_EQ(10 * i, live->at(i)->Value());
+  RuntimeEnabledFeatures::SetHeapConcurrentSweepingEnabled(was_enabled);
+}
+
 TEST(HeapTest, LazySweepingLargeObjectPages) {
   ClearOutOldGarbage();
 
@@ -2215,6 +2255,59 @@ TEST(HeapTest, WideTest) {
   EXPECT_EQ(0u, Bar::live_);
 }
 
+class TreeNode : public Bar {
+ public:
+  static TreeNode* Create(unsigned depth) { return new TreeNode(depth); }
+
+  void Trace(blink::Visitor* visitor) override {
+    visitor->Trace(left_);
+    visitor->Trace(right_);
+    Bar::Trace(visitor);
+  }
+
+ private:
+  explicit TreeNode(unsigned depth) {
+    if (!depth)
+      return;
+    left_ = Create(depth - 1);
+    right_ = Create(depth - 1);
+  }
+
+  Member<TreeNode> left_;
+  Member<TreeNode> right_;
+};
+
+TEST(HeapTest, ParallelMarking) {
+  const unsigned kDepth = 14;
+  const unsigned kNodes = (1u << (kDepth + 1)) - 1;
+  typedef HeapHashMap<WeakMember<IntWrapper>, Member<TreeNode>> EphemeronMap;
+
+  bool was_enabled = RuntimeEnabledFeatures::HeapParallelMarkingEnabled();
+  RuntimeEnabledFeatures::SetHeapParallelMarkingEnabled(true);
+  ClearOutOldGarbage();
+  Bar::live_ = 0;
+  {
+    Persistent<TreeNode> tree = TreeNode::Create(kDepth);
+    Persistent<IntWrapper> key = IntWrapper::Create(1);
+    Persistent<EphemeronMap> map = new EphemeronMap();
+    map->insert(key, TreeNode::Create(kDepth));
+    map->insert(IntWrapper::Create(2), TreeNode::Create(kDepth));
+    EXPECT_EQ(3 * kNodes, Bar::live_);
+
+    // Everything reachable from the tree and the live key survives.
+    PreciselyCollectGarbage();
+    EXPECT_EQ(2 * kNodes, Bar::live_);
+    EXPECT_EQ(1u, map->size());
+    EXPECT_TRUE(map->Contains(key));
+
+    PreciselyCollectGarbage();
+    EXPECT_EQ(2 * kNodes, Bar::live_);
+  }
+  PreciselyCollectGarbage();
+  EXPECT_EQ(0u, Bar::live_);
+  RuntimeEnabledFeatures::SetHeapParallelMarkingEnabled(was_enabled);
+}
+
 TEST(HeapTest, HashMapOfMembers) {
   ThreadHeap& heap = ThreadState::Current()->Heap();
   IntWrapper::destructor_calls_ = 0;
@@ -23,14 +23,21 @@ std::unique_ptr<MarkingVisitor> MarkingVisitor::Create(ThreadState* state,
 }
 
 MarkingVisitor::MarkingVisitor(ThreadState* state, MarkingMode marking_mode)
+    : MarkingVisitor(state, marking_mode, WorklistTaskId::MainThread) {}
+
+MarkingVisitor::MarkingVisitor(ThreadState* state,
+                               MarkingMode marking_mode,
+                               int task_id)
     : Visitor(state),
-      marking_worklist_(Heap().GetMarkingWorklist(),
-                        WorklistTaskId::MainThread),
+      marking_worklist_(Heap().GetMarkingWorklist(), task_id),
       not_fully_constructed_worklist_(Heap().GetNotFullyConstructedWorklist(),
-                                      WorklistTaskId::MainThread),
-      weak_callback_worklist_(Heap().GetWeakCallbackWorklist(),
-                              WorklistTaskId::MainThread),
-      marking_mode_(marking_mode) {
+                                      task_id),
+      weak_callback_worklist_(Heap().GetWeakCallbackWorklist(), task_id),
+      marking_mode_(marking_mode),
+      task_id_(task_id),
+      marks_in_parallel_(task_id != WorklistTaskId::MainThread) {
+  DCHECK_GE(task_id, 0);
+  DCHECK_LT(task_id, WorklistTaskId::kMaxMarkingTasks);
   DCHECK(state->InAtomicMarkingPause());
 #if DCHECK_IS_ON()
   DCHECK(state->CheckThread());
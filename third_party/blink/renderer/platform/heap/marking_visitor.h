@@ -47,8 +47,21 @@ class PLATFORM_EXPORT MarkingVisitor final : public Visitor {
   ALWAYS_INLINE static void TraceMarkedBackingStore(void* value);
 
   MarkingVisitor(ThreadState*, MarkingMode);
+  // Visitor for the worklist task |task_id|. Visitors for tasks other than
+  // WorklistTaskId::MainThread are used by parallel marking helper threads.
+  MarkingVisitor(ThreadState*, MarkingMode, int task_id);
   ~MarkingVisitor() override;
 
+  MarkingMode marking_mode() const { return marking_mode_; }
+  int task_id() const { return task_id_; }
+
+  // Whether other visitors may be marking at the same time, requiring mark
+  // bits to be set atomically.
+  bool marks_in_parallel() const { return marks_in_parallel_; }
+  void set_marks_in_parallel(bool marks_in_parallel) {
+    marks_in_parallel_ = marks_in_parallel;
+  }
+
   // Marking implementation.
 
   // Conservatively marks an object if pointed to by Address.
@@ -83,7 +96,10 @@ class PLATFORM_EXPORT MarkingVisitor final : public Visitor {
     //
     // If the trait allows it, invoke the trace callback right here on the
     // not-yet-marked object.
-    if (desc.can_trace_eagerly) {
+    //
+    // Only the main thread traces eagerly, as the stack depth limit is that of
+    // the main thread's stack.
+    if (desc.can_trace_eagerly && task_id_ == WorklistTaskId::MainThread) {
       // Protect against too deep trace call chains, and the
       // unbounded system stack usage they can bring about.
       //
@@ -169,6 +185,8 @@ class PLATFORM_EXPORT MarkingVisitor final : public Visitor {
   NotFullyConstructedWorklist::View not_fully_constructed_worklist_;
   WeakCallbackWorklist::View weak_callback_worklist_;
   const MarkingMode marking_mode_;
+  const int task_id_;
+  bool marks_in_parallel_ = false;
 };
 
 inline bool MarkingVisitor::MarkHeaderNoTracing(HeapObjectHeader* header) {
@@ -181,6 +199,8 @@ inline bool MarkingVisitor::MarkHeaderNoTracing(HeapObjectHeader* header) {
   // freed backing store.
   DCHECK(!header->IsFree());
 
+  if (UNLIKELY(marks_in_parallel_))
+    return header->TryMarkAtomic();
   return header->TryMark();
 }
 
@@ -1185,6 +1185,7 @@ void UpdateHistograms(const ThreadHeapStatsCollector::Event& event) {
 
 void ThreadState::PostSweep() {
   DCHECK(CheckThread());
+  Heap().StopConcurrentSweeping();
 
   SetGCPhase(GCPhase::kNone);
   if (GetGCState() == kIdleGCScheduled)
@@ -1592,6 +1593,8 @@ void ThreadState::RunAtomicPause(BlinkGC::StackState stack_state,
   } else {
     DCHECK(sweeping_type == BlinkGC::kLazySweeping);
     // The default behavior is lazy sweeping.
+    if (RuntimeEnabledFeatures::HeapConcurrentSweepingEnabled())
+      Heap().StartConcurrentSweeping();
     ScheduleIdleLazySweep();
   }
 }
@@ -22,6 +22,8 @@
 
 #include "third_party/blink/renderer/platform/loader/fetch/memory_cache.h"
 
+#include <algorithm>
+
 #include "base/auto_reset.h"
 #include "third_party/blink/public/platform/platform.h"
 #include "third_party/blink/renderer/platform/instrumentation/tracing/trace_event.h"
@@ -45,6 +47,11 @@ static const double kCMaxPruneDeferralDelay = 0.5;      // Seconds.
 // again.
 static const float kCTargetPrunePercentage = .95f;
 
+// Percentage of the capacity toward which decoded image data is pruned before
+// any other decoded data, so that large images don't push out scripts and
+// stylesheets.
+static const float kCDecodedImageCapacityPercentage = .5f;
+
 MemoryCache* GetMemoryCache() {
   DCHECK(WTF::IsMainThread());
   if (!g_memory_cache)
@@ -197,15 +204,30 @@ void MemoryCache::RemoveInternal(ResourceMap* resource_map,
   resource_map->erase(it);
 }
 
-bool MemoryCache::Contains(const Resource* resource) const {
+MemoryCacheEntry* MemoryCache::EntryForResource(
+    const Resource* resource) const {
   if (!resource || resource->Url().IsEmpty())
-    return false;
+    return nullptr;
   const ResourceMap* resources = resource_maps_.at(resource->CacheIdentifier());
   if (!resources)
-    return false;
+    return nullptr;
   KURL url = RemoveFragmentIdentifierIfNeeded(resource->Url());
   MemoryCacheEntry* entry = resources->at(url);
-  return entry && resource == entry->GetResource();
+  return entry && resource == entry->GetResource() ? entry : nullptr;
+}
+
+bool MemoryCache::Contains(const Resource* resource) const {
+  return EntryForResource(resource);
+}
+
+void MemoryCache::RecordHit(const Resource* resource) {
+  if (MemoryCacheEntry* entry = EntryForResource(resource))
+    entry->hit_count_++;
+}
+
+unsigned MemoryCache::HitCount(const Resource* resource) const {
+  MemoryCacheEntry* entry = EntryForResource(resource);
+  return entry ? entry->hit_count_ : 0;
 }
 
 Resource* MemoryCache::ResourceForURL(const KURL& resource_url) const {
@@ -252,7 +274,11 @@ void MemoryCache::PruneResources(PruneStrategy strategy) {
   // Cut by a percentage to avoid immediately pruning again.
   size_t target_size =
       static_cast<size_t>(size_limit * kCTargetPrunePercentage);
+  size_t target_decoded_image_size =
+      static_cast<size_t>(target_size * kCDecodedImageCapacityPercentage);
 
+  HeapVector<Member<MemoryCacheEntry>> candidates;
+  size_t decoded_image_size = 0;
   for (const auto& resource_map_iter : resource_maps_) {
     for (const auto& resource_iter : *resource_map_iter.value) {
       Resource* resource = resource_iter.value->GetResource();
@@ -264,12 +290,41 @@ void MemoryCache::PruneResources(PruneStrategy strategy) {
         if (strategy == kAutomaticPrune &&
             elapsed_time < delay_before_live_decoded_prune_)
           continue;
-        resource->Prune();
-        if (size_ <= target_size)
-          return;
+        if (resource->GetType() == Resource::kImage)
+          decoded_image_size += resource->DecodedSize();
+        candidates.push_back(resource_iter.value);
       }
     }
   }
+
+  // Prune the decoded data with the fewest hits per byte first, so that large
+  // resources used once don't push out small ones used over and over.
+  std::sort(candidates.begin(), candidates.end(),
+            [](const Member<MemoryCacheEntry>& a,
+               const Member<MemoryCacheEntry>& b) {
+              return static_cast<uint64_t>(a->hit_count_ + 1) *
+                         b->GetResource()->DecodedSize() <
+                     static_cast<uint64_t>(b->hit_count_ + 1) *
+                         a->GetResource()->DecodedSize();
+            });
+
+  for (const auto& entry : candidates) {
+    if (decoded_image_size <= target_decoded_image_size)
+      break;
+    Resource* resource = entry->GetResource();
+    if (resource->GetType() != Resource::kImage)
+      continue;
+    size_t old_decoded_size = resource->DecodedSize();
+    resource->Prune();
+    DCHECK_LE(resource->DecodedSize(), old_decoded_size);
+    decoded_image_size -= old_decoded_size - resource->DecodedSize();
+  }
+
+  for (const auto& entry : candidates) {
+    if (size_ <= target_size)
+      return;
+    entry->GetResource()->Prune();
+  }
 }
 
 void MemoryCache::SetCapacity(size_t total_bytes) {
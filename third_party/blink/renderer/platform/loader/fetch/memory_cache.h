@@ -56,10 +56,12 @@ class MemoryCacheEntry final : public GarbageCollected<MemoryCacheEntry> {
   Resource* GetResource() const { return resource_; }
 
   double last_decoded_access_time_;  // Used as a thrash guard
+  // The number of times the resource was served from the cache.
+  unsigned hit_count_;
 
  private:
   explicit MemoryCacheEntry(Resource* resource)
-      : last_decoded_access_time_(0.0), resource_(resource) {}
+      : last_decoded_access_time_(0.0), hit_count_(0), resource_(resource) {}
 
   void ClearResourceWeak(Visitor*);
 
@@ -121,6 +123,13 @@ class PLATFORM_EXPORT MemoryCache final
   void Remove(Resource*);
   bool Contains(const Resource*) const;
 
+  // Records that |resource| was served from the cache to another request. The
+  // decoded data of resources which are used often for their size is pruned
+  // last.
+  void RecordHit(const Resource*);
+  // Returns the number of hits recorded for |resource| while in the cache.
+  unsigned HitCount(const Resource*) const;
+
   static KURL RemoveFragmentIdentifierIfNeeded(const KURL& original_url);
 
   static String DefaultCacheIdentifier();
@@ -185,6 +194,7 @@ class PLATFORM_EXPORT MemoryCache final
 
   MemoryCache();
 
+  MemoryCacheEntry* EntryForResource(const Resource*) const;
   void AddInternal(ResourceMap*, MemoryCacheEntry*);
   void RemoveInternal(ResourceMap*, const ResourceMap::iterator&);
 
@@ -242,6 +242,38 @@ TEST_F(MemoryCacheTest, ResourcePruningAtEndOfTask_MultipleResourceMaps) {
   }
 }
 
+TEST_F(MemoryCacheTest, PruneFewestHitsPerByteFirst) {
+  GetMemoryCache()->SetDelayBeforeLiveDecodedPrune(0);
+  GetMemoryCache()->SetMaxPruneDeferralDelay(0);
+
+  const char kData[101] = {};
+  FetchParameters params1(ResourceRequest("data:text/html,large"));
+  Persistent<Resource> large =
+      FakeDecodedResource::Fetch(params1, fetcher_, nullptr);
+  GetMemoryCache()->Remove(large);
+  large->AppendData(kData, 100u);
+  large->FinishForTest();
+  GetMemoryCache()->Add(large);
+
+  FetchParameters params2(ResourceRequest("data:text/html,small"));
+  Persistent<Resource> small =
+      FakeDecodedResource::Fetch(params2, fetcher_, nullptr);
+  GetMemoryCache()->Remove(small);
+  small->AppendData(kData, 10u);
+  small->FinishForTest();
+  GetMemoryCache()->Add(small);
+  GetMemoryCache()->RecordHit(small);
+  GetMemoryCache()->RecordHit(small);
+  EXPECT_EQ(2u, GetMemoryCache()->HitCount(small));
+  EXPECT_EQ(0u, GetMemoryCache()->HitCount(large));
+
+  ASSERT_GT(large->DecodedSize(), 0u);
+  ASSERT_GT(small->DecodedSize(), 0u);
+  GetMemoryCache()->SetCapacity(GetMemoryCache()->size() - 1);
+  EXPECT_EQ(0u, large->DecodedSize());
+  EXPECT_GT(small->DecodedSize(), 0u);
+}
+
 // Verifies that
 // - Resources are not pruned synchronously when ResourceClient is removed.
 // - size() is updated appropriately when Resources are added to MemoryCache
@@ -839,6 +839,8 @@ Resource* ResourceFetcher::RequestResource(
     case kUse:
       if (resource->IsLinkPreload() && !params.IsLinkPreload())
         resource->SetLinkPreload(false);
+      if (IsMainThread())
+        GetMemoryCache()->RecordHit(resource);
       break;
   }
   DCHECK(resource);
@@ -1677,6 +1679,26 @@ void ResourceFetcher::UpdateAllImageResourcePriorities() {
   }
 }
 
+void ResourceFetcher::MarkResourceAsRenderBlocking(Resource* resource) {
+  if (!resource->IsLoading() && !resource->StillNeedsLoad())
+    return;
+
+  // Stylesheets and fonts get kVeryHigh, anything else which blocks rendering,
+  // e.g. a parser-blocking script, kHigh.
+  ResourceLoadPriority resource_load_priority =
+      Context().ModifyPriorityForExperiments(
+          std::max(TypeToPriority(resource->GetType()),
+                   ResourceLoadPriority::kHigh));
+  if (resource_load_priority <= resource->GetResourceRequest().Priority())
+    return;
+
+  resource->DidChangePriority(resource_load_priority, 0);
+  network_instrumentation::ResourcePrioritySet(resource->Identifier(),
+                                               resource_load_priority);
+  Context().DispatchDidChangeResourcePriority(resource->Identifier(),
+                                              resource_load_priority, 0);
+}
+
 void ResourceFetcher::ReloadLoFiImages() {
   for (Resource* resource : document_resources_) {
     if (resource)
@@ -152,6 +152,14 @@ class PLATFORM_EXPORT ResourceFetcher
 
   void UpdateAllImageResourcePriorities();
 
+  // Called when |resource|, which may have been requested at a low priority,
+  // e.g. as an alternate stylesheet, turns out to block rendering. Raises its
+  // load priority to that of render-blocking resources of its type, without
+  // waiting for it to be requested again. The priority of an in-flight load is
+  // changed in the network stack, and a load throttled by the
+  // ResourceLoadScheduler is reordered accordingly.
+  void MarkResourceAsRenderBlocking(Resource*);
+
   void ReloadLoFiImages();
 
   // Calling this method before main document resource is fetched is invalid.
@@ -540,6 +540,28 @@ TEST_F(ResourceFetcherTest, PingPriority) {
             resource->GetResourceRequest().Priority());
 }
 
+TEST_F(ResourceFetcherTest, MarkResourceAsRenderBlocking) {
+  KURL url("http://127.0.0.1:8000/foo.png");
+  RegisterMockedURLLoad(url);
+
+  ResourceFetcher* fetcher = ResourceFetcher::Create(Context());
+  ResourceRequest resource_request(url);
+  resource_request.SetRequestContext(WebURLRequest::kRequestContextInternal);
+  FetchParameters fetch_params(resource_request);
+  fetch_params.SetDefer(FetchParameters::kLazyLoad);
+  Resource* resource = RawResource::Fetch(fetch_params, fetcher, nullptr);
+  ASSERT_TRUE(resource->IsLoading());
+  EXPECT_EQ(ResourceLoadPriority::kVeryLow,
+            resource->GetResourceRequest().Priority());
+
+  fetcher->MarkResourceAsRenderBlocking(resource);
+  EXPECT_EQ(ResourceLoadPriority::kHigh,
+            resource->GetResourceRequest().Priority());
+
+  platform_->GetURLLoaderMockFactory()->ServeAsynchronousRequests();
+  EXPECT_TRUE(resource->IsLoaded());
+}
+
 TEST_F(ResourceFetcherTest, PreloadResourceTwice) {
   ResourceFetcher* fetcher = ResourceFetcher::Create(Context());
 
@@ -1006,6 +1006,10 @@ void TaskQueueImpl::OnTaskCompleted(const TaskQueue::Task& task,
                                     TimeTicks start,
                                     TimeTicks end,
                                     Optional<TimeDelta> thread_time) {
+  // The latest task accounts for a quarter of the expected duration.
+  TimeDelta& expected_duration = main_thread_only().expected_task_duration;
+  expected_duration += (end - start - expected_duration) / 4;
+
   if (!main_thread_only().on_task_completed_handler.is_null()) {
     main_thread_only().on_task_completed_handler.Run(task, start, end,
                                                      thread_time);
@@ -1017,6 +1021,10 @@ bool TaskQueueImpl::RequiresTaskTiming() const {
          !main_thread_only().on_task_completed_handler.is_null();
 }
 
+TimeDelta TaskQueueImpl::GetExpectedTaskDuration() const {
+  return main_thread_only().expected_task_duration;
+}
+
 bool TaskQueueImpl::IsUnregistered() const {
   AutoLock lock(any_thread_lock_);
   return !any_thread().task_queue_manager;
@@ -300,6 +300,11 @@ class PLATFORM_EXPORT TaskQueueImpl {
                        Optional<TimeDelta> thread_time);
   bool RequiresTaskTiming() const;
 
+  // Returns the expected duration of the next task from this queue, estimated
+  // from the durations of the tasks reported to OnTaskCompleted(), or zero if
+  // none was.
+  TimeDelta GetExpectedTaskDuration() const;
+
   WeakPtr<TaskQueueManagerImpl> GetTaskQueueManagerWeakPtr();
 
   scoped_refptr<GracefulQueueShutdownHelper> GetGracefulQueueShutdownHelper();
@@ -361,6 +366,8 @@ class PLATFORM_EXPORT TaskQueueImpl {
     Optional<TimeTicks> delayed_fence;
     OnTaskStartedHandler on_task_started_handler;
     OnTaskCompletedHandler on_task_completed_handler;
+    // Exponential moving average of the durations of completed tasks.
+    TimeDelta expected_task_duration;
     // Last reported wake up, used only in UpdateWakeUp to avoid
     // excessive calls.
     Optional<DelayedWakeUp> scheduled_wake_up;
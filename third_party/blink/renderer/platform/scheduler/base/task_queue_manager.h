@@ -79,6 +79,12 @@ class PLATFORM_EXPORT TaskQueueManager {
   // tasks posted to the main loop. The batch size is 1 by default.
   virtual void SetWorkBatchSize(int work_batch_size) = 0;
 
+  // Sets the deadline of the current frame, e.g. the deadline of the
+  // compositor's BeginFrame. Until it has passed, normal and lower priority
+  // tasks which are expected to overrun it, going by the durations of the
+  // previous tasks of their queue, are deferred. A null |deadline| clears it.
+  virtual void SetFrameDeadline(TimeTicks deadline) = 0;
+
   virtual void EnableCrashKeys(const char* file_name_crash_key,
                                const char* function_name_crash_key) = 0;
 
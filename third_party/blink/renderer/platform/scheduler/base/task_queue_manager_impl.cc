@@ -314,6 +314,18 @@ Optional<PendingTask> TaskQueueManagerImpl::TakeTask() {
   LazyNow lazy_now(main_thread_only().real_time_domain->CreateLazyNow());
   WakeUpReadyDelayedQueues(&lazy_now);
 
+  if (!main_thread_only().frame_deadline.is_null()) {
+    TimeDelta time_until_frame_deadline =
+        main_thread_only().frame_deadline - lazy_now.Now();
+    if (time_until_frame_deadline <= TimeDelta()) {
+      // The deadline has passed, tasks no longer need to be deferred.
+      main_thread_only().frame_deadline = TimeTicks();
+      time_until_frame_deadline = TimeDelta::Max();
+    }
+    main_thread_only().selector.SetTimeUntilFrameDeadline(
+        time_until_frame_deadline);
+  }
+
   while (true) {
     internal::WorkQueue* work_queue = nullptr;
     bool should_run =
@@ -372,9 +384,14 @@ TimeDelta TaskQueueManagerImpl::DelayTillNextTask(LazyNow* lazy_now) {
   DCHECK_CALLED_ON_VALID_THREAD(main_thread_checker_);
 
   // If the selector has non-empty queues we trivially know there is immediate
-  // work to be done.
-  if (!main_thread_only().selector.AllEnabledWorkQueuesAreEmpty())
+  // work to be done, unless all of it was deferred until the frame deadline.
+  bool deferred_until_frame_deadline =
+      !main_thread_only().frame_deadline.is_null() &&
+      main_thread_only().selector.DidDeferAllTasksForFrameDeadline();
+  if (!deferred_until_frame_deadline &&
+      !main_thread_only().selector.AllEnabledWorkQueuesAreEmpty()) {
     return TimeDelta();
+  }
 
   // Its possible the selectors state is dirty because ReloadEmptyWorkQueues
   // hasn't been called yet. This check catches the case of fresh incoming work.
@@ -391,7 +408,10 @@ TimeDelta TaskQueueManagerImpl::DelayTillNextTask(LazyNow* lazy_now) {
   // Otherwise we need to find the shortest delay, if any.  NB we don't need to
   // call WakeUpReadyDelayedQueues because it's assumed DelayTillNextTask will
   // return TimeDelta>() if the delayed task is due to run now.
-  TimeDelta delay_till_next_task = TimeDelta::Max();
+  TimeDelta delay_till_next_task =
+      deferred_until_frame_deadline
+          ? main_thread_only().frame_deadline - lazy_now->Now()
+          : TimeDelta::Max();
   for (TimeDomain* time_domain : main_thread_only().time_domains) {
     Optional<TimeDelta> delay = time_domain->DelayTillNextTask(lazy_now);
     if (!delay)
@@ -531,6 +551,17 @@ void TaskQueueManagerImpl::SetWorkBatchSize(int work_batch_size) {
   controller_->SetWorkBatchSize(work_batch_size);
 }
 
+void TaskQueueManagerImpl::SetFrameDeadline(TimeTicks deadline) {
+  DCHECK_CALLED_ON_VALID_THREAD(main_thread_checker_);
+  main_thread_only().frame_deadline = deadline;
+  if (!deadline.is_null())
+    return;
+  main_thread_only().selector.SetTimeUntilFrameDeadline(TimeDelta::Max());
+  // Run the tasks which were deferred until the deadline.
+  if (main_thread_only().selector.DidDeferAllTasksForFrameDeadline())
+    MaybeScheduleImmediateWork(FROM_HERE);
+}
+
 void TaskQueueManagerImpl::AddTaskObserver(
     MessageLoop::TaskObserver* task_observer) {
   DCHECK_CALLED_ON_VALID_THREAD(main_thread_checker_);
@@ -104,6 +104,7 @@ class PLATFORM_EXPORT TaskQueueManagerImpl
   void SweepCanceledDelayedTasks() override;
   bool GetAndClearSystemIsQuiescentBit() override;
   void SetWorkBatchSize(int work_batch_size) override;
+  void SetFrameDeadline(TimeTicks deadline) override;
   void EnableCrashKeys(const char* file_name_crash_key,
                        const char* function_name_crash_key) override;
   double GetSamplingRateForRecordingCPUTime() const override;
@@ -212,6 +213,8 @@ class PLATFORM_EXPORT TaskQueueManagerImpl
     std::uniform_real_distribution<double> uniform_distribution;
 
     internal::TaskQueueSelector selector;
+    // Null if there is no frame deadline.
+    TimeTicks frame_deadline;
     ObserverList<MessageLoop::TaskObserver> task_observers;
     ObserverList<TaskTimeObserver> task_time_observers;
     std::set<TimeDomain*> time_domains;
@@ -52,6 +52,8 @@ TaskQueueSelector::TaskQueueSelector()
       high_priority_starvation_score_(0),
       normal_priority_starvation_score_(0),
       low_priority_starvation_score_(0),
+      time_until_frame_deadline_(TimeDelta::Max()),
+      deferred_all_tasks_for_frame_deadline_(false),
       task_queue_selector_observer_(nullptr) {}
 
 TaskQueueSelector::~TaskQueueSelector() = default;
@@ -260,14 +262,22 @@ bool TaskQueueSelector::PrioritizingSelector::SelectWorkQueueToService(
     return true;
   }
 
-  // Otherwise choose in priority order.
+  // Otherwise choose in priority order, skipping tasks which would overrun the
+  // frame deadline.
   for (TaskQueue::QueuePriority priority = TaskQueue::kHighestPriority;
        priority < max_priority; priority = NextPriority(priority)) {
-    if (ChooseOldestWithPriority(priority, out_chose_delayed_over_immediate,
-                                 out_work_queue)) {
-      ReportTaskSelectionLogic(QueuePriorityToSelectorLogic(priority));
-      return true;
+    if (!ChooseOldestWithPriority(priority, out_chose_delayed_over_immediate,
+                                  out_work_queue)) {
+      continue;
+    }
+    if (task_queue_selector_->ShouldDeferForFrameDeadline(priority,
+                                                          *out_work_queue)) {
+      task_queue_selector_->deferred_all_tasks_for_frame_deadline_ = true;
+      *out_chose_delayed_over_immediate = false;
+      continue;
     }
+    ReportTaskSelectionLogic(QueuePriorityToSelectorLogic(priority));
+    return true;
   }
   return false;
 }
@@ -291,11 +301,13 @@ bool TaskQueueSelector::PrioritizingSelector::CheckContainsQueueForTest(
 bool TaskQueueSelector::SelectWorkQueueToService(WorkQueue** out_work_queue) {
   DCHECK(main_thread_checker_.CalledOnValidThread());
   bool chose_delayed_over_immediate = false;
+  deferred_all_tasks_for_frame_deadline_ = false;
   bool found_queue = prioritizing_selector_.SelectWorkQueueToService(
       TaskQueue::kQueuePriorityCount, out_work_queue,
       &chose_delayed_over_immediate);
   if (!found_queue)
     return false;
+  deferred_all_tasks_for_frame_deadline_ = false;
 
   // We could use |(*out_work_queue)->task_queue()->GetQueuePriority()| here but
   // for re-queued non-nestable tasks |task_queue()| returns null.
@@ -305,6 +317,12 @@ bool TaskQueueSelector::SelectWorkQueueToService(WorkQueue** out_work_queue) {
   return true;
 }
 
+void TaskQueueSelector::SetTimeUntilFrameDeadline(
+    TimeDelta time_until_deadline) {
+  DCHECK(main_thread_checker_.CalledOnValidThread());
+  time_until_frame_deadline_ = time_until_deadline;
+}
+
 void TaskQueueSelector::DidSelectQueueWithPriority(
     TaskQueue::QueuePriority priority,
     bool chose_delayed_over_immediate) {
@@ -368,6 +386,10 @@ void TaskQueueSelector::AsValueInto(trace_event::TracedValue* state) const {
   state->SetInteger("low_priority_starvation_score",
                     low_priority_starvation_score_);
   state->SetInteger("immediate_starvation_count", immediate_starvation_count_);
+  if (!time_until_frame_deadline_.is_max()) {
+    state->SetDouble("time_until_frame_deadline_ms",
+                     time_until_frame_deadline_.InMillisecondsF());
+  }
 }
 
 void TaskQueueSelector::SetTaskQueueSelectorObserver(Observer* observer) {
@@ -402,6 +424,19 @@ bool TaskQueueSelector::HasTasksWithPriority(
              priority);
 }
 
+bool TaskQueueSelector::ShouldDeferForFrameDeadline(
+    TaskQueue::QueuePriority priority,
+    const WorkQueue* work_queue) const {
+  if (priority < TaskQueue::kNormalPriority ||
+      time_until_frame_deadline_.is_max()) {
+    return false;
+  }
+  // Re-queued non-nestable tasks have no task queue.
+  const TaskQueueImpl* task_queue = work_queue->task_queue();
+  return task_queue &&
+         task_queue->GetExpectedTaskDuration() > time_until_frame_deadline_;
+}
+
 }  // namespace internal
 }  // namespace sequence_manager
 }  // namespace base
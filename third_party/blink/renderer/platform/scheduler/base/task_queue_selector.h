@@ -13,6 +13,7 @@
 #include "base/macros.h"
 #include "base/pending_task.h"
 #include "base/threading/thread_checker.h"
+#include "base/time/time.h"
 #include "third_party/blink/renderer/platform/scheduler/base/task_queue_selector_logic.h"
 #include "third_party/blink/renderer/platform/scheduler/base/work_queue_sets.h"
 
@@ -53,6 +54,20 @@ class PLATFORM_EXPORT TaskQueueSelector {
   // This function is called on the main thread.
   bool SelectWorkQueueToService(WorkQueue** out_work_queue);
 
+  // Sets the time left until the deadline of the current frame. Until it is
+  // reset to TimeDelta::Max(), a normal or lower priority task is deferred if
+  // its queue's expected task duration exceeds |time_until_deadline|, so that
+  // it doesn't delay the frame. Another task that fits is selected instead if
+  // there is one. Starved queues are still serviced.
+  void SetTimeUntilFrameDeadline(TimeDelta time_until_deadline);
+
+  // Returns true if the last call to SelectWorkQueueToService() found no work
+  // queue to service only because their tasks were deferred until the frame
+  // deadline.
+  bool DidDeferAllTasksForFrameDeadline() const {
+    return deferred_all_tasks_for_frame_deadline_;
+  }
+
   // Serialize the selector state for tracing.
   void AsValueInto(trace_event::TracedValue* state) const;
 
@@ -128,7 +143,7 @@ class PLATFORM_EXPORT TaskQueueSelector {
         bool* out_chose_delayed_over_immediate,
         WorkQueue** out_work_queue) const;
 
-    const TaskQueueSelector* task_queue_selector_;
+    TaskQueueSelector* task_queue_selector_;
     WorkQueueSets delayed_work_queue_sets_;
     WorkQueueSets immediate_work_queue_sets_;
 
@@ -208,6 +223,11 @@ class PLATFORM_EXPORT TaskQueueSelector {
   // Returns true if there are pending tasks with priority |priority|.
   bool HasTasksWithPriority(TaskQueue::QueuePriority priority);
 
+  // Returns true if the next task of |work_queue|, of priority |priority|, is
+  // expected to overrun the frame deadline.
+  bool ShouldDeferForFrameDeadline(TaskQueue::QueuePriority priority,
+                                   const WorkQueue* work_queue) const;
+
   ThreadChecker main_thread_checker_;
 
   PrioritizingSelector prioritizing_selector_;
@@ -215,6 +235,8 @@ class PLATFORM_EXPORT TaskQueueSelector {
   size_t high_priority_starvation_score_;
   size_t normal_priority_starvation_score_;
   size_t low_priority_starvation_score_;
+  TimeDelta time_until_frame_deadline_;
+  bool deferred_all_tasks_for_frame_deadline_;
 
   Observer* task_queue_selector_observer_;  // NOT OWNED
   DISALLOW_COPY_AND_ASSIGN(TaskQueueSelector);
@@ -138,6 +138,14 @@ class TaskQueueSelectorTest : public testing::Test {
     return order;
   }
 
+  // Reports a task of |duration| as completed on |task_queue|.
+  void CompleteTaskWithDuration(TaskQueueImpl* task_queue, TimeDelta duration) {
+    TaskQueueImpl::Task task(TaskQueue::PostedTask(test_closure_, FROM_HERE),
+                             TimeTicks(), 0);
+    TimeTicks start = TimeTicks() + TimeDelta::FromSeconds(1);
+    task_queue->OnTaskCompleted(task, start, start + duration, nullopt);
+  }
+
   static void TestFunction() {}
 
  protected:
@@ -823,6 +831,50 @@ TEST_F(TaskQueueSelectorTest, TestObserverWithTwoBlockedQueues) {
   task_queue2->UnregisterTaskQueue();
 }
 
+TEST_F(TaskQueueSelectorTest, ExpectedTaskDuration) {
+  EXPECT_EQ(TimeDelta(), task_queues_[0]->GetExpectedTaskDuration());
+  CompleteTaskWithDuration(task_queues_[0].get(),
+                           TimeDelta::FromMilliseconds(40));
+  EXPECT_EQ(TimeDelta::FromMilliseconds(10),
+            task_queues_[0]->GetExpectedTaskDuration());
+  CompleteTaskWithDuration(task_queues_[0].get(),
+                           TimeDelta::FromMilliseconds(2));
+  EXPECT_EQ(TimeDelta::FromMicroseconds(8000),
+            task_queues_[0]->GetExpectedTaskDuration());
+}
+
+TEST_F(TaskQueueSelectorTest, DefersTasksOverrunningFrameDeadline) {
+  CompleteTaskWithDuration(task_queues_[0].get(),
+                           TimeDelta::FromMilliseconds(40));
+  CompleteTaskWithDuration(task_queues_[1].get(),
+                           TimeDelta::FromMilliseconds(4));
+  size_t queue_order[] = {0, 1, 2};
+  PushTasks(queue_order, 3);
+
+  // Queue 0 is expected to take 10ms and queue 1 1ms.
+  selector_.SetTimeUntilFrameDeadline(TimeDelta::FromMilliseconds(5));
+  EXPECT_THAT(PopTasks(), testing::ElementsAre(1, 2));
+  EXPECT_TRUE(selector_.DidDeferAllTasksForFrameDeadline());
+
+  selector_.SetTimeUntilFrameDeadline(TimeDelta::Max());
+  EXPECT_THAT(PopTasks(), testing::ElementsAre(0));
+  EXPECT_FALSE(selector_.DidDeferAllTasksForFrameDeadline());
+}
+
+TEST_F(TaskQueueSelectorTest, FrameDeadlineDoesNotDeferHighPriorityTasks) {
+  CompleteTaskWithDuration(task_queues_[0].get(),
+                           TimeDelta::FromMilliseconds(40));
+  CompleteTaskWithDuration(task_queues_[1].get(),
+                           TimeDelta::FromMilliseconds(40));
+  size_t queue_order[] = {0, 1};
+  PushTasks(queue_order, 2);
+  selector_.SetQueuePriority(task_queues_[1].get(), TaskQueue::kHighPriority);
+
+  selector_.SetTimeUntilFrameDeadline(TimeDelta::FromMilliseconds(5));
+  EXPECT_THAT(PopTasks(), testing::ElementsAre(1));
+  EXPECT_TRUE(selector_.DidDeferAllTasksForFrameDeadline());
+}
+
 struct ChooseOldestWithPriorityTestParam {
   int delayed_task_enqueue_order;
   int immediate_task_enqueue_order;
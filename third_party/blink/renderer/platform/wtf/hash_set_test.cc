@@ -367,6 +367,30 @@ TEST(HashSetTest, HasTraitsForEnum) {
   HashSet<std::pair<TestEnum, TestEnumClass>> set3;
 }
 
+// Maps keys to few hashes so that most lookups need to probe.
+struct CollidingIntHash {
+  static unsigned GetHash(int key) { return static_cast<unsigned>(key) % 7; }
+  static bool Equal(int a, int b) { return a == b; }
+  static const bool safe_to_compare_to_empty_or_deleted = true;
+};
+
+TEST(HashSetTest, ProbesAllBucketsOnCollisions) {
+  HashSet<int, CollidingIntHash> set;
+  for (int i = 1; i <= 500; ++i)
+    EXPECT_TRUE(set.insert(i).is_new_entry);
+  for (int i = 1; i <= 500; i += 2)
+    set.erase(i);
+  EXPECT_EQ(250u, set.size());
+  for (int i = 1; i <= 500; ++i)
+    EXPECT_EQ(i % 2 == 0, set.Contains(i)) << i;
+  // Deleted buckets are reused.
+  for (int i = 1; i <= 500; i += 2)
+    EXPECT_TRUE(set.insert(i).is_new_entry);
+  for (int i = 1; i <= 500; ++i)
+    EXPECT_FALSE(set.insert(i).is_new_entry);
+  EXPECT_EQ(500u, set.size());
+}
+
 static_assert(!IsTraceable<HashSet<int>>::value,
               "HashSet<int, int> must not be traceable.");
 
@@ -984,6 +984,58 @@ inline unsigned DoubleHash(unsigned key) {
   return key;
 }
 
+constexpr unsigned LargestPowerOfTwoNotAbove(size_t n) {
+  return n < 2 ? 1 : 2 * LargestPowerOfTwoNotAbove(n / 2);
+}
+
+// Probe sequence of a hash table with |BucketSize|-byte buckets.
+//
+// Buckets are probed in groups of consecutive buckets that together fit in a
+// cache line, starting with the bucket selected by the hash, so collisions are
+// mostly resolved without touching another cache line. Groups are visited in
+// double hashing order. Every bucket is visited before any is visited twice.
+template <size_t BucketSize>
+class HashTableProbeSequence {
+  STACK_ALLOCATED();
+
+ public:
+  HashTableProbeSequence(unsigned hash, unsigned size_mask)
+      : hash_(hash),
+        size_mask_(size_mask),
+        group_mask_((kMaxGroupSize < size_mask + 1 ? kMaxGroupSize
+                                                   : size_mask + 1) -
+                    1),
+        group_(hash & size_mask & ~group_mask_),
+        offset_(hash & group_mask_) {}
+
+  size_t Index() const { return group_ + (offset_ & group_mask_); }
+
+  void Next() {
+    ++offset_;
+    if (++probes_in_group_ <= group_mask_)
+      return;
+    // Move on to another group. Stepping by an odd number of groups visits
+    // each group once as the number of groups is a power of two.
+    probes_in_group_ = 0;
+    if (!group_step_)
+      group_step_ = (1 | DoubleHash(hash_)) * (group_mask_ + 1);
+    group_ = (group_ + group_step_) & size_mask_;
+  }
+
+ private:
+  static constexpr size_t kCacheLineSize = 64;
+  static constexpr unsigned kMaxGroupSize =
+      LargestPowerOfTwoNotAbove(kCacheLineSize / BucketSize);
+
+  const unsigned hash_;
+  const unsigned size_mask_;
+  const unsigned group_mask_;
+  unsigned group_;
+  unsigned offset_;
+  unsigned probes_in_group_ = 0;
+  unsigned group_step_ = 0;
+};
+
 inline unsigned CalculateCapacity(unsigned size) {
   for (unsigned mask = size; mask; mask >>= 1)
     size |= mask;         // 00110101010 -> 00111111111
@@ -1051,15 +1103,13 @@ HashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits, Allocator>::
   if (!table)
     return nullptr;
 
-  size_t k = 0;
-  size_t size_mask = TableSizeMask();
   unsigned h = HashTranslator::GetHash(key);
-  size_t i = h & size_mask;
+  HashTableProbeSequence<sizeof(ValueType)> probe(h, TableSizeMask());
 
   UPDATE_ACCESS_COUNTS();
 
   while (1) {
-    const ValueType* entry = table + i;
+    const ValueType* entry = table + probe.Index();
 
     if (HashFunctions::safe_to_compare_to_empty_or_deleted) {
       if (HashTranslator::Equal(Extractor::Extract(*entry), key))
@@ -1076,9 +1126,7 @@ HashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits, Allocator>::
         return entry;
     }
     UPDATE_PROBE_COUNTS();
-    if (!k)
-      k = 1 | DoubleHash(h);
-    i = (i + k) & size_mask;
+    probe.Next();
   }
 }
 
@@ -1104,17 +1152,15 @@ HashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits, Allocator>::
   RegisterModification();
 
   ValueType* table = table_;
-  size_t k = 0;
-  size_t size_mask = TableSizeMask();
   unsigned h = HashTranslator::GetHash(key);
-  size_t i = h & size_mask;
+  HashTableProbeSequence<sizeof(ValueType)> probe(h, TableSizeMask());
 
   UPDATE_ACCESS_COUNTS();
 
   ValueType* deleted_entry = nullptr;
 
   while (1) {
-    ValueType* entry = table + i;
+    ValueType* entry = table + probe.Index();
 
     if (IsEmptyBucket(*entry))
       return LookupType(deleted_entry ? deleted_entry : entry, false);
@@ -1132,9 +1178,7 @@ HashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits, Allocator>::
         return LookupType(entry, true);
     }
     UPDATE_PROBE_COUNTS();
-    if (!k)
-      k = 1 | DoubleHash(h);
-    i = (i + k) & size_mask;
+    probe.Next();
   }
 }
 
@@ -1160,17 +1204,15 @@ HashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits, Allocator>::
   RegisterModification();
 
   ValueType* table = table_;
-  size_t k = 0;
-  size_t size_mask = TableSizeMask();
   unsigned h = HashTranslator::GetHash(key);
-  size_t i = h & size_mask;
+  HashTableProbeSequence<sizeof(ValueType)> probe(h, TableSizeMask());
 
   UPDATE_ACCESS_COUNTS();
 
   ValueType* deleted_entry = nullptr;
 
   while (1) {
-    ValueType* entry = table + i;
+    ValueType* entry = table + probe.Index();
 
     if (IsEmptyBucket(*entry))
       return MakeLookupResult(deleted_entry ? deleted_entry : entry, false, h);
@@ -1188,9 +1230,7 @@ HashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits, Allocator>::
         return MakeLookupResult(entry, true, h);
     }
     UPDATE_PROBE_COUNTS();
-    if (!k)
-      k = 1 | DoubleHash(h);
-    i = (i + k) & size_mask;
+    probe.Next();
   }
 }
 
@@ -1259,17 +1299,15 @@ HashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits, Allocator>::
   DCHECK(table_);
 
   ValueType* table = table_;
-  size_t k = 0;
-  size_t size_mask = TableSizeMask();
   unsigned h = HashTranslator::GetHash(key);
-  size_t i = h & size_mask;
+  HashTableProbeSequence<sizeof(ValueType)> probe(h, TableSizeMask());
 
   UPDATE_ACCESS_COUNTS();
 
   ValueType* deleted_entry = nullptr;
   ValueType* entry;
   while (1) {
-    entry = table + i;
+    entry = table + probe.Index();
 
     if (IsEmptyBucket(*entry))
       break;
@@ -1287,9 +1325,7 @@ HashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits, Allocator>::
         return AddResult(this, entry, false);
     }
     UPDATE_PROBE_COUNTS();
-    if (!k)
-      k = 1 | DoubleHash(h);
-    i = (i + k) & size_mask;
+    probe.Next();
   }
 
   RegisterModification();
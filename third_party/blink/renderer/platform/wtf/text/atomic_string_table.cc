@@ -9,7 +9,10 @@
 
 namespace WTF {
 
-AtomicStringTable::AtomicStringTable() {
+AtomicStringTable::AtomicStringTable()
+    : shares_static_strings_(StringImpl::StaticStringsAreFrozen()) {
+  if (shares_static_strings_)
+    return;
   for (StringImpl* string : StringImpl::AllStaticStrings().Values())
     Add(string);
 }
@@ -27,6 +30,23 @@ void AtomicStringTable::ReserveCapacity(unsigned size) {
   table_.ReserveCapacityForSize(size);
 }
 
+template <typename T, typename HashTranslator>
+StringImpl* AtomicStringTable::FindStaticString(const T& value,
+                                                unsigned length) {
+  if (!shares_static_strings_ ||
+      length > StringImpl::HighestStaticStringLength()) {
+    return nullptr;
+  }
+
+  // The static strings are frozen, so they may be read from any thread.
+  const StaticStringsTable& static_strings = StringImpl::AllStaticStrings();
+  StaticStringsTable::const_iterator it =
+      static_strings.find(HashTranslator::GetHash(value));
+  if (it == static_strings.end() || !HashTranslator::Equal(it->value, value))
+    return nullptr;
+  return it->value;
+}
+
 template <typename T, typename HashTranslator>
 scoped_refptr<StringImpl> AtomicStringTable::AddToStringTable(const T& value) {
   HashSet<StringImpl*>::AddResult add_result =
@@ -44,6 +64,16 @@ struct HashTranslatorCharBuffer {
   unsigned length;
 };
 
+struct StringImplTranslator {
+  static unsigned GetHash(StringImpl* const& string) {
+    return string->GetHash();
+  }
+
+  static bool Equal(StringImpl* const& a, StringImpl* const& b) {
+    return WTF::Equal(a, b);
+  }
+};
+
 typedef HashTranslatorCharBuffer<UChar> UCharBuffer;
 struct UCharBufferTranslator {
   static unsigned GetHash(const UCharBuffer& buf) {
@@ -154,6 +184,10 @@ scoped_refptr<StringImpl> AtomicStringTable::Add(const UChar* s,
     return StringImpl::empty_;
 
   UCharBuffer buffer = {s, length};
+  StringImpl* static_string =
+      FindStaticString<UCharBuffer, UCharBufferTranslator>(buffer, length);
+  if (static_string)
+    return static_string;
   return AddToStringTable<UCharBuffer, UCharBufferTranslator>(buffer);
 }
 
@@ -187,6 +221,10 @@ scoped_refptr<StringImpl> AtomicStringTable::Add(const LChar* s,
     return StringImpl::empty_;
 
   LCharBuffer buffer = {s, length};
+  StringImpl* static_string =
+      FindStaticString<LCharBuffer, LCharBufferTranslator>(buffer, length);
+  if (static_string)
+    return static_string;
   return AddToStringTable<LCharBuffer, LCharBufferTranslator>(buffer);
 }
 
@@ -194,6 +232,12 @@ StringImpl* AtomicStringTable::Add(StringImpl* string) {
   if (!string->length())
     return StringImpl::empty_;
 
+  StringImpl* static_string =
+      FindStaticString<StringImpl*, StringImplTranslator>(string,
+                                                          string->length());
+  if (static_string)
+    return static_string;
+
   StringImpl* result = *table_.insert(string).stored_value;
 
   if (!result->IsAtomic())
@@ -214,6 +258,11 @@ scoped_refptr<StringImpl> AtomicStringTable::AddUTF8(
   if (!buffer.hash)
     return nullptr;
 
+  StringImpl* static_string =
+      FindStaticString<HashAndUTF8Characters, HashAndUTF8CharactersTranslator>(
+          buffer, buffer.utf16_length);
+  if (static_string)
+    return static_string;
   return AddToStringTable<HashAndUTF8Characters,
                           HashAndUTF8CharactersTranslator>(buffer);
 }
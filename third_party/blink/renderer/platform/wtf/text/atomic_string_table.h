@@ -17,6 +17,13 @@ namespace WTF {
 
 // The underlying storage that keeps the map of unique AtomicStrings. This is
 // not thread safe and each WTFThreadData has one.
+//
+// Static strings (e.g. tag and attribute names) are shared by all threads.
+// Once StringImpl::FreezeStaticStrings() has been called they are looked up in
+// the read-only StringImpl::AllStaticStrings() before the thread's own table,
+// so atomizing them gives the same StringImpl on every thread and tables
+// created afterwards don't copy them. Other atomic strings can't be shared, as
+// their reference counts aren't thread safe.
 class WTF_EXPORT AtomicStringTable final {
   USING_FAST_MALLOC(AtomicStringTable);
 
@@ -54,8 +61,17 @@ class WTF_EXPORT AtomicStringTable final {
   template <typename T, typename HashTranslator>
   inline scoped_refptr<StringImpl> AddToStringTable(const T& value);
 
+  // Returns the static string equal to |value|, which is |length| characters
+  // long, or null if there is none or static strings aren't shared yet.
+  template <typename T, typename HashTranslator>
+  inline StringImpl* FindStaticString(const T& value, unsigned length);
+
   HashSet<StringImpl*> table_;
 
+  // Whether the static strings are looked up in StringImpl::AllStaticStrings()
+  // rather than copied into |table_|.
+  const bool shares_static_strings_;
+
   DISALLOW_COPY_AND_ASSIGN(AtomicStringTable);
 };
 
@@ -0,0 +1,148 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/platform/wtf/text/chunked_string_builder.h"
+
+#include <limits>
+#include <utility>
+
+#include "third_party/blink/renderer/platform/wtf/text/string_impl.h"
+
+namespace WTF {
+
+namespace {
+
+void CopySegment(LChar* destination, const String& segment) {
+  DCHECK(segment.Is8Bit());
+  StringImpl::CopyChars(destination, segment.Characters8(), segment.length());
+}
+
+void CopySegment(UChar* destination, const String& segment) {
+  if (segment.Is8Bit()) {
+    StringImpl::CopyChars(destination, segment.Characters8(), segment.length());
+    return;
+  }
+  StringImpl::CopyChars(destination, segment.Characters16(),
+                        segment.length());
+}
+
+template <typename CharType>
+String ConcatenateSegments(const Vector<String>& segments, unsigned length) {
+  CharType* data;
+  scoped_refptr<StringImpl> result =
+      StringImpl::CreateUninitialized(length, data);
+  for (const String& segment : segments) {
+    CopySegment(data, segment);
+    data += segment.length();
+  }
+  return String(std::move(result));
+}
+
+}  // namespace
+
+const unsigned ChunkedStringBuilder::kMinSharedLength;
+const unsigned ChunkedStringBuilder::kChunkSize;
+
+ChunkedStringBuilder::ChunkedStringBuilder() : length_(0) {}
+
+ChunkedStringBuilder::~ChunkedStringBuilder() = default;
+
+void ChunkedStringBuilder::Append(const StringView& string) {
+  if (string.IsEmpty())
+    return;
+
+  StringImpl* impl = string.SharedImpl();
+  if (impl && string.length() >= kMinSharedLength) {
+    AddLength(string.length());
+    FlushChunk();
+    segments_.push_back(impl);
+    return;
+  }
+
+  if (string.Is8Bit())
+    Append(string.Characters8(), string.length());
+  else
+    Append(string.Characters16(), string.length());
+}
+
+void ChunkedStringBuilder::Append(const LChar* characters, unsigned length) {
+  if (!length)
+    return;
+  AddLength(length);
+  if (length >= kChunkSize) {
+    FlushChunk();
+    segments_.push_back(String(characters, length));
+    return;
+  }
+  chunk_.Append(characters, length);
+  FlushChunkIfFull();
+}
+
+void ChunkedStringBuilder::Append(const UChar* characters, unsigned length) {
+  if (!length)
+    return;
+  AddLength(length);
+  if (length >= kChunkSize) {
+    FlushChunk();
+    segments_.push_back(String(characters, length));
+    return;
+  }
+  chunk_.Append(characters, length);
+  FlushChunkIfFull();
+}
+
+void ChunkedStringBuilder::Append(LChar c) {
+  AddLength(1);
+  chunk_.Append(c);
+  FlushChunkIfFull();
+}
+
+void ChunkedStringBuilder::Append(UChar c) {
+  AddLength(1);
+  chunk_.Append(c);
+  FlushChunkIfFull();
+}
+
+String ChunkedStringBuilder::ToString() {
+  if (!length_)
+    return g_empty_string;
+
+  FlushChunk();
+  if (segments_.size() == 1)
+    return segments_[0];
+
+  bool is8_bit = true;
+  for (const String& segment : segments_)
+    is8_bit = is8_bit && segment.Is8Bit();
+  String result = is8_bit ? ConcatenateSegments<LChar>(segments_, length_)
+                          : ConcatenateSegments<UChar>(segments_, length_);
+  segments_.clear();
+  segments_.push_back(result);
+  return result;
+}
+
+void ChunkedStringBuilder::Clear() {
+  segments_.clear();
+  chunk_.Clear();
+  length_ = 0;
+}
+
+void ChunkedStringBuilder::FlushChunk() {
+  if (chunk_.IsEmpty())
+    return;
+  segments_.push_back(chunk_.ToString());
+  chunk_.Clear();
+}
+
+void ChunkedStringBuilder::FlushChunkIfFull() {
+  if (chunk_.length() >= kChunkSize)
+    FlushChunk();
+}
+
+void ChunkedStringBuilder::AddLength(unsigned length) {
+  CHECK_LE(length, std::numeric_limits<unsigned>::max() - length_);
+  length_ += length;
+}
+
+}  // namespace WTF
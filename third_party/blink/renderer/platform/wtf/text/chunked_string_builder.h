@@ -0,0 +1,76 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef THIRD_PARTY_BLINK_RENDERER_PLATFORM_WTF_TEXT_CHUNKED_STRING_BUILDER_H_
+#define THIRD_PARTY_BLINK_RENDERER_PLATFORM_WTF_TEXT_CHUNKED_STRING_BUILDER_H_
+
+#include "base/macros.h"
+#include "third_party/blink/renderer/platform/wtf/text/string_builder.h"
+#include "third_party/blink/renderer/platform/wtf/text/string_view.h"
+#include "third_party/blink/renderer/platform/wtf/text/wtf_string.h"
+#include "third_party/blink/renderer/platform/wtf/vector.h"
+#include "third_party/blink/renderer/platform/wtf/wtf_export.h"
+
+namespace WTF {
+
+// A builder for large strings, e.g. serialized markup, that are only read
+// once complete. Unlike StringBuilder, whose single buffer is reallocated and
+// copied as it grows, appended text is kept as a list of segments and copied
+// into the result only once, by ToString(). Long strings are kept by
+// reference rather than copied, and short appends are gathered into segments
+// of about kChunkSize characters.
+//
+// The result is only 16-bit if some appended text was. 8-bit segments are
+// widened when the result is built rather than as soon as the first 16-bit
+// character is appended.
+class WTF_EXPORT ChunkedStringBuilder {
+ public:
+  // Appended strings at least this long are referenced rather than copied.
+  static const unsigned kMinSharedLength = 256;
+  // Short appends are gathered into segments of about this many characters.
+  static const unsigned kChunkSize = 16 * 1024;
+
+  ChunkedStringBuilder();
+  ~ChunkedStringBuilder();
+
+  void Append(const StringView&);
+  void Append(const LChar*, unsigned length);
+  void Append(const UChar*, unsigned length);
+  void Append(const char* characters, unsigned length) {
+    Append(reinterpret_cast<const LChar*>(characters), length);
+  }
+  void Append(LChar);
+  void Append(UChar);
+  void Append(char c) { Append(static_cast<LChar>(c)); }
+
+  unsigned length() const { return length_; }
+  bool IsEmpty() const { return !length_; }
+
+  // Returns the concatenation of everything appended so far. The result is
+  // kept, so calling this again without appending more doesn't copy again.
+  String ToString();
+
+  void Clear();
+
+ private:
+  // Moves |chunk_| to |segments_|.
+  void FlushChunk();
+  // Starts a new chunk if |chunk_| is full.
+  void FlushChunkIfFull();
+  void AddLength(unsigned length);
+
+  // Completed segments, in order.
+  Vector<String> segments_;
+  // Short appends not yet moved to |segments_|.
+  StringBuilder chunk_;
+  unsigned length_;
+
+  DISALLOW_COPY_AND_ASSIGN(ChunkedStringBuilder);
+};
+
+}  // namespace WTF
+
+using WTF::ChunkedStringBuilder;
+
+#endif  // THIRD_PARTY_BLINK_RENDERER_PLATFORM_WTF_TEXT_CHUNKED_STRING_BUILDER_H_
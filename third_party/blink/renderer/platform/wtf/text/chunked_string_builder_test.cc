@@ -0,0 +1,79 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/platform/wtf/text/chunked_string_builder.h"
+
+#include <string>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/blink/renderer/platform/wtf/text/string_builder.h"
+#include "third_party/blink/renderer/platform/wtf/text/wtf_string.h"
+
+namespace WTF {
+
+TEST(ChunkedStringBuilderTest, Empty) {
+  ChunkedStringBuilder builder;
+  EXPECT_TRUE(builder.IsEmpty());
+  EXPECT_EQ(g_empty_string, builder.ToString());
+}
+
+TEST(ChunkedStringBuilderTest, MatchesStringBuilder) {
+  ChunkedStringBuilder builder;
+  StringBuilder expected;
+  const String long_string(std::string(500, 'x').data(), 500);
+  for (unsigned i = 0; i < 2 * ChunkedStringBuilder::kChunkSize; ++i) {
+    builder.Append("abc", 3);
+    expected.Append("abc", 3);
+    builder.Append('d');
+    expected.Append('d');
+    if (i % 1000 == 0) {
+      builder.Append(long_string);
+      expected.Append(long_string);
+    }
+  }
+  EXPECT_EQ(expected.length(), builder.length());
+
+  String result = builder.ToString();
+  EXPECT_TRUE(result.Is8Bit());
+  EXPECT_EQ(expected.ToString(), result);
+  // The result is kept.
+  EXPECT_EQ(result.Impl(), builder.ToString().Impl());
+}
+
+TEST(ChunkedStringBuilderTest, SharesLongStrings) {
+  const String long_string(std::string(500, 'x').data(), 500);
+  ChunkedStringBuilder builder;
+  builder.Append(long_string);
+  EXPECT_EQ(long_string.Impl(), builder.ToString().Impl());
+}
+
+TEST(ChunkedStringBuilderTest, DefersUpconversion) {
+  const UChar kSnowman = 0x2603;
+  ChunkedStringBuilder builder;
+  for (unsigned i = 0; i < ChunkedStringBuilder::kChunkSize; ++i)
+    builder.Append("ab", 2);
+  builder.Append(kSnowman);
+  builder.Append(static_cast<UChar>(0xe9));
+  builder.Append("cd", 2);
+
+  String result = builder.ToString();
+  ASSERT_FALSE(result.Is8Bit());
+  ASSERT_EQ(2 * ChunkedStringBuilder::kChunkSize + 4, result.length());
+  EXPECT_EQ('a', result[0]);
+  EXPECT_EQ('b', result[2 * ChunkedStringBuilder::kChunkSize - 1]);
+  EXPECT_EQ(kSnowman, result[2 * ChunkedStringBuilder::kChunkSize]);
+  EXPECT_EQ(0xe9, result[2 * ChunkedStringBuilder::kChunkSize + 1]);
+  EXPECT_EQ('d', result[2 * ChunkedStringBuilder::kChunkSize + 3]);
+}
+
+TEST(ChunkedStringBuilderTest, Clear) {
+  ChunkedStringBuilder builder;
+  builder.Append("abc", 3);
+  builder.Clear();
+  EXPECT_TRUE(builder.IsEmpty());
+  builder.Append("de", 2);
+  EXPECT_EQ("de", builder.ToString());
+}
+
+}  // namespace WTF
@@ -141,10 +141,6 @@ static StaticStringsTable& StaticStrings() {
   return static_strings;
 }
 
-#if DCHECK_IS_ON()
-static bool g_allow_creation_of_static_strings = true;
-#endif
-
 const StaticStringsTable& StringImpl::AllStaticStrings() {
   return StaticStrings();
 }
@@ -152,12 +148,15 @@ const StaticStringsTable& StringImpl::AllStaticStrings() {
 void StringImpl::FreezeStaticStrings() {
   DCHECK(IsMainThread());
 
-#if DCHECK_IS_ON()
-  g_allow_creation_of_static_strings = false;
-#endif
+  // From now on the static strings are looked up directly by every thread's
+  // AtomicStringTable, so mark them atomic once here.
+  for (StringImpl* string : StaticStrings().Values())
+    string->SetIsAtomic(true);
+  static_strings_frozen_ = true;
 }
 
 unsigned StringImpl::highest_static_string_length_ = 0;
+bool StringImpl::static_strings_frozen_ = false;
 
 DEFINE_GLOBAL(StringImpl, g_global_empty);
 DEFINE_GLOBAL(StringImpl, g_global_empty16_bit);
@@ -179,9 +178,7 @@ void StringImpl::InitStatics() {
 StringImpl* StringImpl::CreateStatic(const char* string,
                                      unsigned length,
                                      unsigned hash) {
-#if DCHECK_IS_ON()
-  DCHECK(g_allow_creation_of_static_strings);
-#endif
+  DCHECK(!static_strings_frozen_);
   DCHECK(string);
   DCHECK(length);
 
@@ -222,9 +219,7 @@ StringImpl* StringImpl::CreateStatic(const char* string,
 }
 
 void StringImpl::ReserveStaticStringsCapacityForSize(unsigned size) {
-#if DCHECK_IS_ON()
-  DCHECK(g_allow_creation_of_static_strings);
-#endif
+  DCHECK(!static_strings_frozen_);
   StaticStrings().ReserveCapacityForSize(size);
 }
 
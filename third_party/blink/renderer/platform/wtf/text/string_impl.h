@@ -168,6 +168,7 @@ class WTF_EXPORT StringImpl {
                                   unsigned hash);
   static void ReserveStaticStringsCapacityForSize(unsigned size);
   static void FreezeStaticStrings();
+  static bool StaticStringsAreFrozen() { return static_strings_frozen_; }
   static const StaticStringsTable& AllStaticStrings();
   static unsigned HighestStaticStringLength() {
     return highest_static_string_length_;
@@ -466,6 +467,7 @@ class WTF_EXPORT StringImpl {
 #endif
 
   static unsigned highest_static_string_length_;
+  static bool static_strings_frozen_;
 
 #if DCHECK_IS_ON()
   void AssertHashIsCorrect() {
@@ -27,8 +27,16 @@
 #ifndef THIRD_PARTY_BLINK_RENDERER_PLATFORM_WTF_TEXT_TEXT_CODEC_ASCII_FAST_PATH_H_
 #define THIRD_PARTY_BLINK_RENDERER_PLATFORM_WTF_TEXT_TEXT_CODEC_ASCII_FAST_PATH_H_
 
+#include <string.h>
+
 #include "third_party/blink/renderer/platform/wtf/text/ascii_fast_path.h"
 
+#if defined(ARCH_CPU_X86_FAMILY)
+#include <emmintrin.h>
+#elif defined(ARCH_CPU_ARM64) || WTF_CPU_ARM_NEON
+#include <arm_neon.h>
+#endif
+
 namespace WTF {
 
 template <size_t size>
@@ -72,6 +80,77 @@ inline void CopyASCIIMachineWord(UChar* destination, const uint8_t* source) {
   UCharByteFiller<sizeof(WTF::MachineWord)>::Copy(destination, source);
 }
 
+// Number of bytes checked and copied at once by CopyASCIIBlock().
+const size_t kASCIIBlockSize = 16;
+
+// If the kASCIIBlockSize bytes at |source| are all ASCII, copies them to
+// |destination| and returns true. Otherwise returns false without writing
+// anything. Neither pointer needs to be aligned.
+inline bool CopyASCIIBlock(LChar* destination, const uint8_t* source) {
+#if defined(ARCH_CPU_X86_FAMILY)
+  __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+  if (_mm_movemask_epi8(block))
+    return false;
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(destination), block);
+  return true;
+#elif defined(ARCH_CPU_ARM64) || WTF_CPU_ARM_NEON
+  uint8x16_t block = vld1q_u8(source);
+  uint64x2_t words = vreinterpretq_u64_u8(block);
+  if ((vgetq_lane_u64(words, 0) | vgetq_lane_u64(words, 1)) &
+      0x8080808080808080ULL) {
+    return false;
+  }
+  vst1q_u8(destination, block);
+  return true;
+#else
+  MachineWord words[kASCIIBlockSize / sizeof(MachineWord)];
+  memcpy(words, source, kASCIIBlockSize);
+  MachineWord all_char_bits = 0;
+  for (MachineWord word : words)
+    all_char_bits |= word;
+  if (!IsAllASCII<LChar>(all_char_bits))
+    return false;
+  memcpy(destination, words, kASCIIBlockSize);
+  return true;
+#endif
+}
+
+inline bool CopyASCIIBlock(UChar* destination, const uint8_t* source) {
+#if defined(ARCH_CPU_X86_FAMILY)
+  __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+  if (_mm_movemask_epi8(block))
+    return false;
+  const __m128i zero = _mm_setzero_si128();
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(destination),
+                   _mm_unpacklo_epi8(block, zero));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + 8),
+                   _mm_unpackhi_epi8(block, zero));
+  return true;
+#elif defined(ARCH_CPU_ARM64) || WTF_CPU_ARM_NEON
+  uint8x16_t block = vld1q_u8(source);
+  uint64x2_t words = vreinterpretq_u64_u8(block);
+  if ((vgetq_lane_u64(words, 0) | vgetq_lane_u64(words, 1)) &
+      0x8080808080808080ULL) {
+    return false;
+  }
+  uint16_t* destination16 = reinterpret_cast<uint16_t*>(destination);
+  vst1q_u16(destination16, vmovl_u8(vget_low_u8(block)));
+  vst1q_u16(destination16 + 8, vmovl_u8(vget_high_u8(block)));
+  return true;
+#else
+  MachineWord words[kASCIIBlockSize / sizeof(MachineWord)];
+  memcpy(words, source, kASCIIBlockSize);
+  MachineWord all_char_bits = 0;
+  for (MachineWord word : words)
+    all_char_bits |= word;
+  if (!IsAllASCII<LChar>(all_char_bits))
+    return false;
+  for (size_t i = 0; i < kASCIIBlockSize; ++i)
+    destination[i] = source[i];
+  return true;
+#endif
+}
+
 }  // namespace WTF
 
 #endif  // THIRD_PARTY_BLINK_RENDERER_PLATFORM_WTF_TEXT_TEXT_CODEC_ASCII_FAST_PATH_H_
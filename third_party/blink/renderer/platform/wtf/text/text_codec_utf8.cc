@@ -323,6 +323,15 @@ String TextCodecUTF8::Decode(const char* bytes,
     while (source < end) {
       if (IsASCII(*source)) {
         // Fast path for ASCII. Most UTF-8 text will be ASCII.
+        while (end - source >= static_cast<ptrdiff_t>(kASCIIBlockSize) &&
+               CopyASCIIBlock(destination, source)) {
+          source += kASCIIBlockSize;
+          destination += kASCIIBlockSize;
+        }
+        if (source == end)
+          break;
+        if (!IsASCII(*source))
+          continue;
         if (IsAlignedToMachineWord(source)) {
           while (source < aligned_end) {
             MachineWord chunk =
@@ -404,6 +413,15 @@ upConvertTo16Bit:
     while (source < end) {
       if (IsASCII(*source)) {
         // Fast path for ASCII. Most UTF-8 text will be ASCII.
+        while (end - source >= static_cast<ptrdiff_t>(kASCIIBlockSize) &&
+               CopyASCIIBlock(destination16, source)) {
+          source += kASCIIBlockSize;
+          destination16 += kASCIIBlockSize;
+        }
+        if (source == end)
+          break;
+        if (!IsASCII(*source))
+          continue;
         if (IsAlignedToMachineWord(source)) {
           while (source < aligned_end) {
             MachineWord chunk =
@@ -30,7 +30,11 @@
 
 #include "third_party/blink/renderer/platform/wtf/text/text_codec_utf8.h"
 
+#include <string.h>
+
 #include <memory>
+#include <string>
+
 #include "testing/gtest/include/gtest/gtest.h"
 #include "third_party/blink/renderer/platform/wtf/text/text_codec.h"
 #include "third_party/blink/renderer/platform/wtf/text/text_encoding.h"
@@ -77,6 +81,34 @@ TEST(TextCodecUTF8, DecodeChineseCharacters) {
   EXPECT_EQ(0x5b57U, result[1]);
 }
 
+// Exercises the block-wise ASCII fast path with a non-ASCII character at every
+// offset of a string longer than several blocks.
+TEST(TextCodecUTF8, DecodeLongAsciiWithNonAscii) {
+  TextEncoding encoding("UTF-8");
+  const std::string ascii(70, 'a');
+  // "é" and "漢" in UTF-8, giving an 8-bit and a 16-bit result respectively.
+  for (const char* non_ascii : {"\xc3\xa9", "\xe6\xbc\xa2"}) {
+    const UChar expected_character = strlen(non_ascii) == 2 ? 0xe9 : 0x6f22;
+    for (size_t offset = 0; offset <= ascii.size(); ++offset) {
+      std::string test_case = ascii;
+      test_case.insert(offset, non_ascii);
+      std::unique_ptr<TextCodec> codec(NewTextCodec(encoding));
+
+      bool saw_error = false;
+      const String& result =
+          codec->Decode(test_case.data(), test_case.size(),
+                        FlushBehavior::kDataEOF, false, saw_error);
+      EXPECT_FALSE(saw_error);
+      EXPECT_EQ(expected_character == 0xe9, result.Is8Bit());
+      ASSERT_EQ(ascii.size() + 1, result.length());
+      for (size_t i = 0; i < result.length(); ++i) {
+        EXPECT_EQ(i == offset ? expected_character : 'a', result[i])
+            << "offset " << offset << ", index " << i;
+      }
+    }
+  }
+}
+
 TEST(TextCodecUTF8, Decode0xFF) {
   TextEncoding encoding("UTF-8");
   std::unique_ptr<TextCodec> codec(NewTextCodec(encoding));
@@ -0,0 +1,72 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Converts a trace flushed with TraceLog::BINARY_OUTPUT_FORMAT to the JSON
+// trace format, which the trace viewer loads.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <string>
+
+#include "base/command_line.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/logging.h"
+#include "base/macros.h"
+#include "base/trace_event/trace_event_binary_format.h"
+
+namespace {
+
+const char kHelpText[] =
+    "Usage: binary_trace_to_json [--output=<file>] <binary trace>\n"
+    "\n"
+    "Converts a binary trace to JSON. Writes to stdout unless --output is\n"
+    "given.\n";
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  base::CommandLine::Init(argc, argv);
+  logging::LoggingSettings settings;
+  settings.logging_dest = logging::LOG_TO_SYSTEM_DEBUG_LOG;
+  logging::InitLogging(settings);
+  const base::CommandLine* command_line =
+      base::CommandLine::ForCurrentProcess();
+  if (command_line->HasSwitch("help") ||
+      command_line->GetArgs().size() != 1) {
+    fwrite(kHelpText, 1, arraysize(kHelpText) - 1, stdout);
+    return command_line->HasSwitch("help") ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+
+  const base::FilePath input_path(command_line->GetArgs()[0]);
+  std::string binary_trace;
+  if (!base::ReadFileToString(input_path, &binary_trace)) {
+    LOG(ERROR) << "Couldn't read '" << input_path.AsUTF8Unsafe() << "'";
+    return EXIT_FAILURE;
+  }
+
+  std::string json;
+  if (!base::trace_event::ConvertBinaryTraceToJSON(binary_trace, &json)) {
+    LOG(ERROR) << "'" << input_path.AsUTF8Unsafe()
+               << "' isn't a valid binary trace";
+    return EXIT_FAILURE;
+  }
+
+  const base::FilePath output_path = command_line->GetSwitchValuePath("output");
+  FILE* output = stdout;
+  if (!output_path.empty()) {
+    output = base::OpenFile(output_path, "wb");
+    if (!output)
+      PLOG(FATAL) << "Couldn't open '" << output_path.AsUTF8Unsafe()
+                  << "' for writing";
+  }
+  if (fwrite(json.data(), 1, json.size(), output) != json.size())
+    PLOG(FATAL) << "Couldn't write the JSON trace";
+  if (!output_path.empty() && !base::CloseFile(output))
+    PLOG(FATAL) << "Couldn't finish writing '" << output_path.AsUTF8Unsafe()
+                << "'";
+
+  return EXIT_SUCCESS;
+}
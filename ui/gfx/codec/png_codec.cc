@@ -5,10 +5,23 @@
 #include "ui/gfx/codec/png_codec.h"
 
 #include <stdint.h>
+#include <string.h>
 
+#include <algorithm>
+#include <iterator>
+
+#include "base/atomicops.h"
+#include "base/bind.h"
 #include "base/logging.h"
 #include "base/macros.h"
+#include "base/memory/ref_counted.h"
 #include "base/strings/string_util.h"
+#include "base/synchronization/condition_variable.h"
+#include "base/synchronization/lock.h"
+#include "base/sys_info.h"
+#include "base/task_scheduler/post_task.h"
+#include "base/task_scheduler/task_scheduler.h"
+#include "base/threading/thread_restrictions.h"
 #include "third_party/libpng/png.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkColorPriv.h"
@@ -417,26 +430,348 @@ static void AddComments(SkPngEncoder::Options& options,
       static_cast<int>(comment_pointers.size()));
 }
 
+// Raw images smaller than this are encoded in a single band.
+const size_t kMinBandBytes = 64 * 1024;
+
+// Room left after deflateBound() for the empty stored block of Z_SYNC_FLUSH.
+const size_t kDeflateFlushSlack = 16;
+
+const unsigned char kPngSignature[] = {137, 80, 78, 71, 13, 10, 26, 10};
+const unsigned char kPngColorTypeGray = 0;
+const unsigned char kPngColorTypeRGB = 2;
+const unsigned char kPngColorTypeRGBA = 6;
+const unsigned char kPngFilterUp = 2;
+
+int ToZlibStrategy(PNGCodec::CompressionStrategy strategy) {
+  switch (strategy) {
+    case PNGCodec::STRATEGY_DEFAULT:
+      return Z_DEFAULT_STRATEGY;
+    case PNGCodec::STRATEGY_FILTERED:
+      return Z_FILTERED;
+    case PNGCodec::STRATEGY_HUFFMAN_ONLY:
+      return Z_HUFFMAN_ONLY;
+    case PNGCodec::STRATEGY_RLE:
+      return Z_RLE;
+  }
+  NOTREACHED();
+  return Z_DEFAULT_STRATEGY;
+}
+
+void AppendUint32(uint32_t value, std::vector<unsigned char>* output) {
+  output->push_back(value >> 24);
+  output->push_back(value >> 16);
+  output->push_back(value >> 8);
+  output->push_back(value);
+}
+
+void AppendPngChunk(const char* type,
+                    const unsigned char* data,
+                    size_t size,
+                    std::vector<unsigned char>* output) {
+  AppendUint32(size, output);
+  output->insert(output->end(), type, type + 4);
+  if (size)
+    output->insert(output->end(), data, data + size);
+  uLong crc = crc32(0, Z_NULL, 0);
+  crc = crc32(crc, reinterpret_cast<const Bytef*>(type), 4);
+  crc = crc32(crc, data, size);
+  AppendUint32(crc, output);
+}
+
+// Drops the alpha channel of |pixel_count| RGBA pixels. This is kept a plain
+// loop over bytes, which compilers vectorize into shuffles.
+void PackRGBAToRGB(const unsigned char* rgba,
+                   int pixel_count,
+                   unsigned char* rgb) {
+  for (int i = 0; i < pixel_count; ++i) {
+    rgb[3 * i] = rgba[4 * i];
+    rgb[3 * i + 1] = rgba[4 * i + 1];
+    rgb[3 * i + 2] = rgba[4 * i + 2];
+  }
+}
+
+// Deflates |input| as a raw deflate stream. Unless |last| is set, the stream
+// is left unterminated and ends on a byte boundary, so that it can be
+// followed by another one.
+bool DeflateBand(const std::vector<unsigned char>& input,
+                 int zlib_level,
+                 int zlib_strategy,
+                 bool last,
+                 std::vector<unsigned char>* output) {
+  z_stream stream = {};
+  if (deflateInit2(&stream, zlib_level, Z_DEFLATED, -MAX_WBITS, 8,
+                   zlib_strategy) != Z_OK) {
+    return false;
+  }
+  output->resize(deflateBound(&stream, input.size()) + kDeflateFlushSlack);
+  stream.next_in = const_cast<Bytef*>(input.data());
+  stream.avail_in = input.size();
+  stream.next_out = output->data();
+  stream.avail_out = output->size();
+  int result = deflate(&stream, last ? Z_FINISH : Z_SYNC_FLUSH);
+  bool success = last ? result == Z_STREAM_END
+                      : result == Z_OK && !stream.avail_in && stream.avail_out;
+  output->resize(stream.total_out);
+  deflateEnd(&stream);
+  return success;
+}
+
+}  // namespace
+
+// Filters and deflates the rows of an image in bands, which TaskScheduler
+// workers and the calling thread pick up concurrently. Every band is deflated
+// into its own raw deflate stream ending on a byte boundary, so the streams
+// can simply be concatenated, as pigz does. Rows are written with the Up
+// filter, which is cheap and works well for screen content.
+class ParallelPngEncoder
+    : public base::RefCountedThreadSafe<ParallelPngEncoder> {
+ public:
+  ParallelPngEncoder(const SkPixmap& src,
+                     const PNGCodec::EncodeOptions& options,
+                     int band_count)
+      : src_(src),
+        bytes_per_pixel_(GetBytesPerPixel(src)),
+        zlib_level_(options.zlib_level),
+        zlib_strategy_(ToZlibStrategy(options.strategy)),
+        bands_(band_count),
+        bands_done_cv_(&lock_) {
+    DCHECK_GT(band_count, 0);
+    DCHECK_LE(band_count, src.height());
+    for (int i = 0; i < band_count; ++i) {
+      bands_[i].first_row = src.height() * i / band_count;
+      bands_[i].end_row = src.height() * (i + 1) / band_count;
+    }
+  }
+
+  // Returns the number of bytes per pixel in the encoded image, or 0 if the
+  // color type of |src| isn't supported.
+  static int GetBytesPerPixel(const SkPixmap& src) {
+    switch (src.colorType()) {
+      case kGray_8_SkColorType:
+        return 1;
+      case kRGBA_8888_SkColorType:
+      case kBGRA_8888_SkColorType:
+        return src.alphaType() == kOpaque_SkAlphaType ? 3 : 4;
+      default:
+        return 0;
+    }
+  }
+
+  static unsigned char GetColorType(const SkPixmap& src) {
+    switch (GetBytesPerPixel(src)) {
+      case 1:
+        return kPngColorTypeGray;
+      case 3:
+        return kPngColorTypeRGB;
+      default:
+        return kPngColorTypeRGBA;
+    }
+  }
+
+  // Writes the zlib stream of the filtered image rows to |output|. Returns
+  // false if deflating failed.
+  bool Run(std::vector<unsigned char>* output) {
+    for (size_t i = 1; i < bands_.size(); ++i) {
+      base::PostTaskWithTraits(
+          FROM_HERE, {base::TaskPriority::USER_BLOCKING},
+          base::BindOnce(&ParallelPngEncoder::EncodeBands, this));
+    }
+    EncodeBands();
+
+    {
+      base::AutoLock lock(lock_);
+      // The bands left were picked up by workers which are already running,
+      // so this never waits for tasks which are still queued.
+      base::ScopedAllowBaseSyncPrimitivesOutsideBlockingScope allow_wait;
+      while (bands_done_ < bands_.size())
+        bands_done_cv_.Wait();
+    }
+
+    // zlib header for a 32K window, without preset dictionary.
+    output->assign({0x78, 0x01});
+    uLong adler = adler32(0, Z_NULL, 0);
+    for (const Band& band : bands_) {
+      if (!band.success)
+        return false;
+      output->insert(output->end(), band.deflated.begin(),
+                     band.deflated.end());
+      adler = adler32_combine(adler, band.adler, band.raw_size);
+    }
+    AppendUint32(adler, output);
+    return true;
+  }
+
+ private:
+  friend class base::RefCountedThreadSafe<ParallelPngEncoder>;
+
+  struct Band {
+    int first_row = 0;
+    int end_row = 0;
+    std::vector<unsigned char> deflated;
+    uLong adler = 0;
+    size_t raw_size = 0;
+    bool success = false;
+  };
+
+  ~ParallelPngEncoder() = default;
+
+  // Encodes bands until none are left.
+  void EncodeBands() {
+    while (true) {
+      size_t index =
+          base::subtle::NoBarrier_AtomicIncrement(&next_band_, 1) - 1;
+      if (index >= bands_.size())
+        return;
+      bool success = EncodeBand(&bands_[index], index == bands_.size() - 1);
+
+      base::AutoLock lock(lock_);
+      bands_[index].success = success;
+      if (++bands_done_ == bands_.size())
+        bands_done_cv_.Signal();
+    }
+  }
+
+  bool EncodeBand(Band* band, bool last) const {
+    const size_t row_bytes = src_.width() * bytes_per_pixel_;
+    // Each filtered row starts with its filter type.
+    std::vector<unsigned char> filtered((band->end_row - band->first_row) *
+                                        (row_bytes + 1));
+    std::vector<unsigned char> previous(row_bytes);
+    std::vector<unsigned char> current(row_bytes);
+    std::vector<unsigned char> scratch;
+    if (band->first_row > 0)
+      ReadRow(band->first_row - 1, previous.data(), &scratch);
+
+    unsigned char* out = filtered.data();
+    for (int y = band->first_row; y < band->end_row; ++y) {
+      ReadRow(y, current.data(), &scratch);
+      *out++ = kPngFilterUp;
+      for (size_t i = 0; i < row_bytes; ++i)
+        out[i] = current[i] - previous[i];
+      out += row_bytes;
+      current.swap(previous);
+    }
+
+    band->adler = adler32(adler32(0, Z_NULL, 0), filtered.data(),
+                          filtered.size());
+    band->raw_size = filtered.size();
+    return DeflateBand(filtered, zlib_level_, zlib_strategy_, last,
+                       &band->deflated);
+  }
+
+  // Writes row |y| of |src_| in the byte order of the encoded image.
+  void ReadRow(int y,
+               unsigned char* row,
+               std::vector<unsigned char>* scratch) const {
+    if (bytes_per_pixel_ == 1) {
+      memcpy(row, src_.addr8(0, y), src_.width());
+      return;
+    }
+    // readPixels() swizzles and unpremultiplies.
+    SkImageInfo row_info = SkImageInfo::Make(
+        src_.width(), 1, kRGBA_8888_SkColorType, kUnpremul_SkAlphaType);
+    if (bytes_per_pixel_ == 4) {
+      src_.readPixels(row_info, row, row_info.minRowBytes(), 0, y);
+      return;
+    }
+    scratch->resize(row_info.computeMinByteSize());
+    src_.readPixels(row_info, scratch->data(), row_info.minRowBytes(), 0, y);
+    PackRGBAToRGB(scratch->data(), src_.width(), row);
+  }
+
+  const SkPixmap src_;
+  const int bytes_per_pixel_;
+  const int zlib_level_;
+  const int zlib_strategy_;
+
+  std::vector<Band> bands_;
+  base::subtle::Atomic32 next_band_ = 0;
+
+  base::Lock lock_;
+  base::ConditionVariable bands_done_cv_;
+  size_t bands_done_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelPngEncoder);
+};
+
+namespace {
+
+int GetBandCount(const SkPixmap& src, const PNGCodec::EncodeOptions& options) {
+  if (!options.parallel || !base::TaskScheduler::GetInstance())
+    return 1;
+  size_t image_bytes = static_cast<size_t>(src.width()) * src.height() *
+                       ParallelPngEncoder::GetBytesPerPixel(src);
+  size_t band_count =
+      std::min<size_t>(base::SysInfo::NumberOfProcessors(),
+                       image_bytes / kMinBandBytes);
+  return std::max<size_t>(1, std::min<size_t>(band_count, src.height()));
+}
+
+// Encodes |src| with zlib directly, for the options SkPngEncoder doesn't
+// support.
+bool EncodeSkPixmapWithZlib(const SkPixmap& src,
+                            const std::vector<PNGCodec::Comment>& comments,
+                            const PNGCodec::EncodeOptions& options,
+                            std::vector<unsigned char>* output) {
+  if (!ParallelPngEncoder::GetBytesPerPixel(src) || src.width() <= 0 ||
+      src.height() <= 0) {
+    return false;
+  }
+
+  output->assign(std::begin(kPngSignature), std::end(kPngSignature));
+
+  std::vector<unsigned char> header;
+  AppendUint32(src.width(), &header);
+  AppendUint32(src.height(), &header);
+  header.push_back(8);  // Bit depth.
+  header.push_back(ParallelPngEncoder::GetColorType(src));
+  header.push_back(0);  // Compression method.
+  header.push_back(0);  // Filter method.
+  header.push_back(0);  // Interlace method.
+  AppendPngChunk("IHDR", header.data(), header.size(), output);
+
+  for (const auto& comment : comments) {
+    std::vector<unsigned char> text(comment.key.begin(), comment.key.end());
+    text.push_back('\0');
+    text.insert(text.end(), comment.text.begin(), comment.text.end());
+    AppendPngChunk("tEXt", text.data(), text.size(), output);
+  }
+
+  auto encoder = base::MakeRefCounted<ParallelPngEncoder>(
+      src, options, GetBandCount(src, options));
+  std::vector<unsigned char> image_data;
+  if (!encoder->Run(&image_data))
+    return false;
+  AppendPngChunk("IDAT", image_data.data(), image_data.size(), output);
+  AppendPngChunk("IEND", nullptr, 0, output);
+  return true;
+}
+
 }  // namespace
 
 static bool EncodeSkPixmap(const SkPixmap& src,
                            const std::vector<PNGCodec::Comment>& comments,
-                           std::vector<unsigned char>* output,
-                           int zlib_level) {
+                           const PNGCodec::EncodeOptions& options,
+                           std::vector<unsigned char>* output) {
+  DCHECK_GE(options.zlib_level, 0);
+  DCHECK_LE(options.zlib_level, 9);
+  if (options.strategy != PNGCodec::STRATEGY_DEFAULT || options.parallel)
+    return EncodeSkPixmapWithZlib(src, comments, options, output);
+
   output->clear();
   VectorWStream dst(output);
 
-  SkPngEncoder::Options options;
-  AddComments(options, comments);
-  options.fZLibLevel = zlib_level;
-  return SkPngEncoder::Encode(&dst, src, options);
+  SkPngEncoder::Options sk_options;
+  AddComments(sk_options, comments);
+  sk_options.fZLibLevel = options.zlib_level;
+  return SkPngEncoder::Encode(&dst, src, sk_options);
 }
 
 static bool EncodeSkPixmap(const SkPixmap& src,
                            bool discard_transparency,
                            const std::vector<PNGCodec::Comment>& comments,
-                           std::vector<unsigned char>* output,
-                           int zlib_level) {
+                           const PNGCodec::EncodeOptions& options,
+                           std::vector<unsigned char>* output) {
   if (discard_transparency) {
     SkImageInfo opaque_info = src.info().makeAlphaType(kOpaque_SkAlphaType);
     SkBitmap copy;
@@ -453,9 +788,9 @@ static bool EncodeSkPixmap(const SkPixmap& src,
         src.readPixels(opaque_info.makeAlphaType(kUnpremul_SkAlphaType),
                        opaque_pixmap.writable_addr(), opaque_pixmap.rowBytes());
     DCHECK(success);
-    return EncodeSkPixmap(opaque_pixmap, comments, output, zlib_level);
+    return EncodeSkPixmap(opaque_pixmap, comments, options, output);
   }
-  return EncodeSkPixmap(src, comments, output, zlib_level);
+  return EncodeSkPixmap(src, comments, options, output);
 }
 
 // static
@@ -466,6 +801,19 @@ bool PNGCodec::Encode(const unsigned char* input,
                       bool discard_transparency,
                       const std::vector<Comment>& comments,
                       std::vector<unsigned char>* output) {
+  return Encode(input, format, size, row_byte_width, discard_transparency,
+                comments, EncodeOptions(), output);
+}
+
+// static
+bool PNGCodec::Encode(const unsigned char* input,
+                      ColorFormat format,
+                      const Size& size,
+                      int row_byte_width,
+                      bool discard_transparency,
+                      const std::vector<Comment>& comments,
+                      const EncodeOptions& options,
+                      std::vector<unsigned char>* output) {
   // Initialization required for Windows although the switch covers all cases.
   SkColorType colorType = kN32_SkColorType;
   switch (format) {
@@ -484,28 +832,34 @@ bool PNGCodec::Encode(const unsigned char* input,
   SkImageInfo info =
       SkImageInfo::Make(size.width(), size.height(), colorType, alphaType);
   SkPixmap src(info, input, row_byte_width);
-  return EncodeSkPixmap(src, discard_transparency, comments, output,
-                        DEFAULT_ZLIB_COMPRESSION);
+  return EncodeSkPixmap(src, discard_transparency, comments, options, output);
 }
 
 static bool EncodeSkBitmap(const SkBitmap& input,
                            bool discard_transparency,
-                           std::vector<unsigned char>* output,
-                           int zlib_level) {
+                           const PNGCodec::EncodeOptions& options,
+                           std::vector<unsigned char>* output) {
   SkPixmap src;
   if (!input.peekPixels(&src)) {
     return false;
   }
   return EncodeSkPixmap(src, discard_transparency,
-                        std::vector<PNGCodec::Comment>(), output, zlib_level);
+                        std::vector<PNGCodec::Comment>(), options, output);
+}
+
+// static
+bool PNGCodec::EncodeBGRASkBitmap(const SkBitmap& input,
+                                  bool discard_transparency,
+                                  std::vector<unsigned char>* output) {
+  return EncodeSkBitmap(input, discard_transparency, EncodeOptions(), output);
 }
 
 // static
 bool PNGCodec::EncodeBGRASkBitmap(const SkBitmap& input,
                                   bool discard_transparency,
+                                  const EncodeOptions& options,
                                   std::vector<unsigned char>* output) {
-  return EncodeSkBitmap(input, discard_transparency, output,
-                        DEFAULT_ZLIB_COMPRESSION);
+  return EncodeSkBitmap(input, discard_transparency, options, output);
 }
 
 // static
@@ -516,15 +870,17 @@ bool PNGCodec::EncodeA8SkBitmap(const SkBitmap& input,
                   .makeColorType(kGray_8_SkColorType)
                   .makeAlphaType(kOpaque_SkAlphaType);
   SkPixmap src(info, input.getAddr(0, 0), input.rowBytes());
-  return EncodeSkPixmap(src, std::vector<PNGCodec::Comment>(), output,
-                        DEFAULT_ZLIB_COMPRESSION);
+  return EncodeSkPixmap(src, std::vector<PNGCodec::Comment>(), EncodeOptions(),
+                        output);
 }
 
 // static
 bool PNGCodec::FastEncodeBGRASkBitmap(const SkBitmap& input,
                                       bool discard_transparency,
                                       std::vector<unsigned char>* output) {
-  return EncodeSkBitmap(input, discard_transparency, output, Z_BEST_SPEED);
+  EncodeOptions options;
+  options.zlib_level = Z_BEST_SPEED;
+  return EncodeSkBitmap(input, discard_transparency, options, output);
 }
 
 PNGCodec::Comment::Comment(const std::string& k, const std::string& t)
@@ -44,6 +44,36 @@ class CODEC_EXPORT PNGCodec {
     FORMAT_SkBitmap
   };
 
+  // zlib compression strategies, see deflateInit2() in zlib.h.
+  enum CompressionStrategy {
+    STRATEGY_DEFAULT,
+
+    // Favors the PNG row filters over string matching, which suits
+    // photographic content.
+    STRATEGY_FILTERED,
+
+    // Huffman coding only, without string matching.
+    STRATEGY_HUFFMAN_ONLY,
+
+    // Run-length encoding, which suits flat screen content.
+    STRATEGY_RLE,
+  };
+
+  // Options trading compression ratio for encoding speed, for images such as
+  // screenshots and thumbnails which are encoded often.
+  struct EncodeOptions {
+    // zlib compression level, from 0 (no compression) to 9 (best).
+    int zlib_level = DEFAULT_ZLIB_COMPRESSION;
+
+    CompressionStrategy strategy = STRATEGY_DEFAULT;
+
+    // When true, bands of rows are filtered and deflated in parallel on the
+    // TaskScheduler, at a small cost in compression ratio. Small images, and
+    // all images in processes without a TaskScheduler, are still encoded on
+    // the calling thread.
+    bool parallel = false;
+  };
+
   // Represents a comment in the tEXt ancillary chunk of the png.
   struct CODEC_EXPORT Comment {
     Comment(const std::string& k, const std::string& t);
@@ -78,6 +108,16 @@ class CODEC_EXPORT PNGCodec {
                      const std::vector<Comment>& comments,
                      std::vector<unsigned char>* output);
 
+  // Like Encode() above, compressing the image as given by |options|.
+  static bool Encode(const unsigned char* input,
+                     ColorFormat format,
+                     const Size& size,
+                     int row_byte_width,
+                     bool discard_transparency,
+                     const std::vector<Comment>& comments,
+                     const EncodeOptions& options,
+                     std::vector<unsigned char>* output);
+
   // Call PNGCodec::Encode on the supplied SkBitmap |input|, which is assumed to
   // be kN32_SkColorType, 32 bits per pixel. The params |discard_transparency|
   // and |output| are passed directly to Encode; refer to Encode for more
@@ -86,6 +126,13 @@ class CODEC_EXPORT PNGCodec {
                                  bool discard_transparency,
                                  std::vector<unsigned char>* output);
 
+  // Like EncodeBGRASkBitmap() above, compressing the image as given by
+  // |options|.
+  static bool EncodeBGRASkBitmap(const SkBitmap& input,
+                                 bool discard_transparency,
+                                 const EncodeOptions& options,
+                                 std::vector<unsigned char>* output);
+
   // Call PNGCodec::Encode on the supplied SkBitmap |input|. The difference
   // between this and the previous method is that this restricts compression to
   // zlib q1, which is just rle encoding.
@@ -10,6 +10,7 @@
 
 #include "base/logging.h"
 #include "base/macros.h"
+#include "base/test/scoped_task_environment.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "third_party/libpng/png.h"
 #include "third_party/skia/include/core/SkBitmap.h"
@@ -965,5 +966,76 @@ TEST(PNGCodec, EncodeDecodeWithVaryingCompressionLevels) {
   EXPECT_TRUE(BitmapsAreEqual(decoded, original_bitmap));
 }
 
+TEST(PNGCodec, EncodeDecodeWithOptions) {
+  base::test::ScopedTaskEnvironment scoped_task_environment;
+  // Large enough to be split into several bands when encoding in parallel.
+  const int w = 256, h = 256;
+
+  SkBitmap original_bitmap;
+  MakeTestBGRASkBitmap(w, h, &original_bitmap);
+
+  const PNGCodec::CompressionStrategy kStrategies[] = {
+      PNGCodec::STRATEGY_DEFAULT, PNGCodec::STRATEGY_FILTERED,
+      PNGCodec::STRATEGY_HUFFMAN_ONLY, PNGCodec::STRATEGY_RLE};
+  for (PNGCodec::CompressionStrategy strategy : kStrategies) {
+    for (bool parallel : {false, true}) {
+      SCOPED_TRACE(testing::Message() << "strategy " << strategy
+                                      << ", parallel " << parallel);
+      PNGCodec::EncodeOptions options;
+      options.zlib_level = Z_BEST_SPEED;
+      options.strategy = strategy;
+      options.parallel = parallel;
+      std::vector<unsigned char> encoded;
+      ASSERT_TRUE(PNGCodec::EncodeBGRASkBitmap(original_bitmap, false,
+                                               options, &encoded));
+
+      SkBitmap decoded_bitmap;
+      ASSERT_TRUE(PNGCodec::Decode(&encoded.front(), encoded.size(),
+                                   &decoded_bitmap));
+      ASSERT_EQ(w, decoded_bitmap.width());
+      ASSERT_EQ(h, decoded_bitmap.height());
+      for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+          uint32_t original_pixel = original_bitmap.getAddr32(0, y)[x];
+          uint32_t decoded_pixel = decoded_bitmap.getAddr32(0, y)[x];
+          ASSERT_TRUE(ColorsClose(original_pixel, decoded_pixel));
+        }
+      }
+    }
+  }
+}
+
+TEST(PNGCodec, EncodeRGBInParallelWithComment) {
+  base::test::ScopedTaskEnvironment scoped_task_environment;
+  const int w = 256, h = 256;
+
+  // The image is opaque, so discarding transparency encodes it as RGB without
+  // loss.
+  std::vector<unsigned char> original;
+  MakeRGBAImage(w, h, false, &original);
+
+  PNGCodec::EncodeOptions options;
+  options.parallel = true;
+  std::vector<unsigned char> encoded;
+  std::vector<PNGCodec::Comment> comments;
+  comments.push_back(PNGCodec::Comment("key", "text"));
+  ASSERT_TRUE(PNGCodec::Encode(&original[0], PNGCodec::FORMAT_RGBA, Size(w, h),
+                               w * 4, true, comments, options, &encoded));
+
+  const unsigned char kExpected[] =
+      "\x00\x00\x00\x08tEXtkey\x00text\x9e\xe7\x66\x51";
+  EXPECT_NE(std::search(encoded.begin(), encoded.end(), kExpected,
+                        kExpected + arraysize(kExpected)),
+            encoded.end());
+
+  std::vector<unsigned char> decoded;
+  int outw, outh;
+  ASSERT_TRUE(PNGCodec::Decode(&encoded[0], encoded.size(),
+                               PNGCodec::FORMAT_RGBA, &decoded, &outw, &outh));
+  ASSERT_EQ(w, outw);
+  ASSERT_EQ(h, outh);
+  EXPECT_TRUE(original == decoded);
+}
+
 
 }  // namespace gfx
@@ -9,9 +9,11 @@
 #include <list>
 #include <memory>
 #include <sstream>
+#include <vector>
 
 #include "base/logging.h"
 #include "base/strings/stringprintf.h"
+#include "base/synchronization/lock.h"
 #include "third_party/skia/include/core/SkColor.h"
 #include "third_party/skia/include/core/SkColorSpaceXform.h"
 #include "ui/gfx/color_space.h"
@@ -33,6 +35,18 @@ namespace gfx {
 
 namespace {
 
+// Number of colors transformed at once from which per-channel transfer
+// functions are tabulated. Building a table costs kLutSize evaluations, after
+// which it is used for all colors.
+const size_t kMinColorsForLut = 1024;
+
+// Number of entries of transfer function tables, which span [0, 1].
+const size_t kLutSize = 4096;
+
+// Tables which interpolate a transfer function with a larger error, relative
+// to values above 1, are not used.
+const float kMaxLutError = 1.f / 4096.f;
+
 void InitStringStream(std::stringstream* ss) {
   ss->imbue(std::locale::classic());
   ss->precision(8);
@@ -329,8 +343,27 @@ class ColorTransformMatrix : public ColorTransformStep {
   }
 
   void Transform(ColorTransform::TriStim* colors, size_t num) const override {
-    for (size_t i = 0; i < num; i++)
-      matrix_.TransformPoint(colors + i);
+    if (matrix_.HasPerspective()) {
+      for (size_t i = 0; i < num; i++)
+        matrix_.TransformPoint(colors + i);
+      return;
+    }
+
+    // Read the coefficients once rather than mapping each color through
+    // SkMatrix44, which keeps the loop simple enough to be vectorized.
+    const SkMatrix44& m = matrix_.matrix();
+    const float m00 = m.get(0, 0), m01 = m.get(0, 1), m02 = m.get(0, 2);
+    const float m10 = m.get(1, 0), m11 = m.get(1, 1), m12 = m.get(1, 2);
+    const float m20 = m.get(2, 0), m21 = m.get(2, 1), m22 = m.get(2, 2);
+    const float t0 = m.get(0, 3), t1 = m.get(1, 3), t2 = m.get(2, 3);
+    for (size_t i = 0; i < num; i++) {
+      const float x = colors[i].x();
+      const float y = colors[i].y();
+      const float z = colors[i].z();
+      colors[i].SetPoint(m00 * x + m01 * y + m02 * z + t0,
+                         m10 * x + m11 * y + m12 * z + t1,
+                         m20 * x + m21 * y + m22 * z + t2);
+    }
   }
 
   bool CanAppendShaderSource() override { return true; }
@@ -367,16 +400,17 @@ class ColorTransformPerChannelTransferFn : public ColorTransformStep {
       : extended_(extended) {}
 
   void Transform(ColorTransform::TriStim* colors, size_t num) const override {
+    const std::vector<float>* lut = GetLut(num >= kMinColorsForLut);
     for (size_t i = 0; i < num; i++) {
       ColorTransform::TriStim& c = colors[i];
       if (extended_) {
-        c.set_x(copysign(Evaluate(abs(c.x())), c.x()));
-        c.set_y(copysign(Evaluate(abs(c.y())), c.y()));
-        c.set_z(copysign(Evaluate(abs(c.z())), c.z()));
+        c.set_x(copysign(EvaluateWithLut(abs(c.x()), lut), c.x()));
+        c.set_y(copysign(EvaluateWithLut(abs(c.y()), lut), c.y()));
+        c.set_z(copysign(EvaluateWithLut(abs(c.z()), lut), c.z()));
       } else {
-        c.set_x(Evaluate(c.x()));
-        c.set_y(Evaluate(c.y()));
-        c.set_z(Evaluate(c.z()));
+        c.set_x(EvaluateWithLut(c.x(), lut));
+        c.set_y(EvaluateWithLut(c.y(), lut));
+        c.set_z(EvaluateWithLut(c.z(), lut));
       }
     }
   }
@@ -410,6 +444,51 @@ class ColorTransformPerChannelTransferFn : public ColorTransformStep {
   // True if the transfer function is extended to be defined for all real
   // values by point symmetry.
   bool extended_ = false;
+
+ private:
+  // Returns the table of Evaluate() over [0, 1], building it first if |build|
+  // is true. Returns null if the table isn't built or isn't accurate enough.
+  const std::vector<float>* GetLut(bool build) const {
+    base::AutoLock lock(lut_lock_);
+    if (build && !lut_built_) {
+      BuildLut();
+      lut_built_ = true;
+    }
+    return lut_.empty() ? nullptr : &lut_;
+  }
+
+  void BuildLut() const {
+    const float kScale = kLutSize - 1;
+    lut_.resize(kLutSize);
+    for (size_t i = 0; i < kLutSize; i++)
+      lut_[i] = Evaluate(i / kScale);
+
+    // Interpolating can be too coarse where the function is steep, e.g. near 0
+    // for some curves, in which case the function is always evaluated.
+    for (size_t i = 0; i + 1 < kLutSize; i++) {
+      float expected = Evaluate((i + 0.5f) / kScale);
+      float interpolated = (lut_[i] + lut_[i + 1]) / 2;
+      if (!(abs(expected - interpolated) <=
+            kMaxLutError * max(1.f, abs(expected)))) {
+        lut_.clear();
+        return;
+      }
+    }
+  }
+
+  float EvaluateWithLut(float v, const std::vector<float>* lut) const {
+    // The negated comparison also sends NaN to Evaluate().
+    if (!lut || !(v >= 0.f && v <= 1.f))
+      return Evaluate(v);
+    float position = v * (kLutSize - 1);
+    size_t index = min(static_cast<size_t>(position), kLutSize - 2);
+    float fraction = position - index;
+    return (*lut)[index] + fraction * ((*lut)[index + 1] - (*lut)[index]);
+  }
+
+  mutable base::Lock lut_lock_;
+  mutable bool lut_built_ = false;
+  mutable std::vector<float> lut_;
 };
 
 class ColorTransformSkTransferFn : public ColorTransformPerChannelTransferFn {
@@ -0,0 +1,68 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+#include "ui/gfx/color_space.h"
+#include "ui/gfx/color_transform.h"
+
+namespace gfx {
+namespace {
+
+const int kTimeLimitMs = 2000;
+const size_t kWidth = 1024;
+const size_t kHeight = 256;
+
+void RunTransformTest(const std::string& name,
+                      const ColorSpace& src,
+                      const ColorSpace& dst) {
+  std::unique_ptr<ColorTransform> transform(ColorTransform::NewColorTransform(
+      src, dst, ColorTransform::Intent::INTENT_PERCEPTUAL));
+
+  std::vector<ColorTransform::TriStim> source(kWidth * kHeight);
+  for (size_t i = 0; i < source.size(); i++) {
+    source[i].SetPoint((i % 256) / 255.f, ((i / 256) % 256) / 255.f,
+                       (i % 97) / 96.f);
+  }
+
+  // Transform the image row by row, as image and video conversions do.
+  std::vector<ColorTransform::TriStim> colors;
+  base::TimeTicks start = base::TimeTicks::Now();
+  base::TimeTicks end = start + base::TimeDelta::FromMilliseconds(kTimeLimitMs);
+  int count = 0;
+  while (base::TimeTicks::Now() < end) {
+    colors = source;
+    for (size_t row = 0; row < kHeight; row++)
+      transform->Transform(colors.data() + row * kWidth, kWidth);
+    ++count;
+  }
+  base::TimeDelta elapsed = base::TimeTicks::Now() - start;
+
+  perf_test::PrintResult(
+      "color_transform", "", name,
+      count * source.size() / elapsed.InMicrosecondsF(), "pixels/us", true);
+}
+
+TEST(ColorTransformPerfTest, SRGBToDisplayP3) {
+  RunTransformTest("srgb_to_display_p3", ColorSpace::CreateSRGB(),
+                   ColorSpace::CreateDisplayP3D65());
+}
+
+TEST(ColorTransformPerfTest, REC709ToSRGB) {
+  RunTransformTest("rec709_to_srgb", ColorSpace::CreateREC709(),
+                   ColorSpace::CreateSRGB());
+}
+
+TEST(ColorTransformPerfTest, SRGBToLinear) {
+  RunTransformTest("srgb_to_linear", ColorSpace::CreateSRGB(),
+                   ColorSpace::CreateSCRGBLinear());
+}
+
+}  // namespace
+}  // namespace gfx
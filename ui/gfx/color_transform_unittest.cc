@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include <tuple>
+#include <vector>
 
 #include "base/logging.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -646,6 +647,33 @@ TEST_P(ColorSpaceTest, toXYZandBack) {
   EXPECT_NEAR(tristim.z(), 0.6f, 0.001f);
 }
 
+TEST_P(ColorSpaceTest, bulkMatchesSingle) {
+  // Transforming many colors at once uses tables for transfer functions,
+  // which must match evaluating them for each color.
+  std::unique_ptr<ColorTransform> bulk(ColorTransform::NewColorTransform(
+      color_space_, ColorSpace::CreateXYZD50(), intent_));
+  std::unique_ptr<ColorTransform> single(ColorTransform::NewColorTransform(
+      color_space_, ColorSpace::CreateXYZD50(), intent_));
+  const size_t kSteps = 17;
+  std::vector<ColorTransform::TriStim> colors;
+  for (size_t r = 0; r < kSteps; r++) {
+    for (size_t g = 0; g < kSteps; g++) {
+      for (size_t b = 0; b < kSteps; b++) {
+        colors.push_back(ColorTransform::TriStim(
+            r / (kSteps - 1.f), g / (kSteps - 1.f), b / (kSteps - 1.f)));
+      }
+    }
+  }
+  std::vector<ColorTransform::TriStim> expected = colors;
+  bulk->Transform(colors.data(), colors.size());
+  for (size_t i = 0; i < expected.size(); i++) {
+    single->Transform(&expected[i], 1);
+    EXPECT_NEAR(expected[i].x(), colors[i].x(), 0.001f);
+    EXPECT_NEAR(expected[i].y(), colors[i].y(), 0.001f);
+    EXPECT_NEAR(expected[i].z(), colors[i].z(), 0.001f);
+  }
+}
+
 INSTANTIATE_TEST_CASE_P(
     A,
     ColorSpaceTest,
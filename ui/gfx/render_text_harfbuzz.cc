@@ -6,18 +6,28 @@
 
 #include <limits>
 #include <set>
+#include <tuple>
 
 #include "base/command_line.h"
+#include "base/containers/mru_cache.h"
 #include "base/feature_list.h"
 #include "base/i18n/base_i18n_switches.h"
 #include "base/i18n/bidi_line_iterator.h"
 #include "base/i18n/break_iterator.h"
 #include "base/i18n/char_iterator.h"
 #include "base/macros.h"
+#include "base/memory/memory_reclaimer.h"
 #include "base/memory/ptr_util.h"
+#include "base/no_destructor.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/synchronization/lock.h"
+#include "base/trace_event/memory_allocator_dump.h"
+#include "base/trace_event/memory_dump_manager.h"
+#include "base/trace_event/memory_dump_provider.h"
+#include "base/trace_event/memory_usage_estimator.h"
+#include "base/trace_event/process_memory_dump.h"
 #include "base/trace_event/trace_event.h"
 #include "build/build_config.h"
 #include "third_party/icu/source/common/unicode/ubidi.h"
@@ -50,6 +60,17 @@ namespace {
 // Text length limit. Longer strings are slow and not fully tested.
 const size_t kMaxTextLength = 10000;
 
+// The number of characters around a run which HarfBuzz looks at when shaping
+// it, i.e. HB_BUFFER_CONTEXT_LENGTH.
+const size_t kShapingContextLength = 5;
+
+// The memory budget of the shaped runs kept by ShapeRunCache.
+const size_t kMaxShapeRunCacheBytes = 1024 * 1024;
+
+// The rough rate at which shaping re-creates the glyph data of evicted runs,
+// used to estimate the cost of reclaiming the cache.
+const size_t kShapedBytesPerSecond = 16 * 1024 * 1024;
+
 // The maximum number of scripts a Unicode character can belong to. This value
 // is arbitrarily chosen to be a good limit because it is unlikely for a single
 // character to belong to more scripts.
@@ -644,10 +665,205 @@ void ApplyForcedDirection(UBiDiLevel* level) {
   }
 }
 
+// The inputs of RenderTextHarfBuzz::ShapeRunWithFont() which determine the
+// shaped glyphs of a run.
+struct ShapeRunCacheKey {
+  bool operator<(const ShapeRunCacheKey& other) const {
+    return Tie() < other.Tie();
+  }
+
+  auto Tie() const {
+    return std::tie(text, run_start, run_length, typeface_id, font_size,
+                    script, is_rtl, antialiasing, subpixel_positioning,
+                    autohinter, hinting, subpixel_rendering,
+                    subpixel_rendering_suppressed, glyph_spacing);
+  }
+
+  // The run text along with its shaping context.
+  base::string16 text;
+  size_t run_start;
+  size_t run_length;
+  SkFontID typeface_id;
+  int font_size;
+  UScriptCode script;
+  bool is_rtl;
+  bool antialiasing;
+  bool subpixel_positioning;
+  bool autohinter;
+  FontRenderParams::Hinting hinting;
+  FontRenderParams::SubpixelRendering subpixel_rendering;
+  bool subpixel_rendering_suppressed;
+  float glyph_spacing;
+};
+
+// The glyph data of a shaped run. |glyph_to_char| is relative to the start of
+// the run.
+struct ShapedRun {
+  size_t EstimateMemoryUsage() const {
+    return base::trace_event::EstimateMemoryUsage(glyphs) +
+           base::trace_event::EstimateMemoryUsage(positions) +
+           base::trace_event::EstimateMemoryUsage(glyph_to_char);
+  }
+
+  std::vector<uint16_t> glyphs;
+  std::vector<SkPoint> positions;
+  std::vector<uint32_t> glyph_to_char;
+  float width;
+};
+
+// Keeps the glyphs of recently shaped runs, shared by all RenderTextHarfBuzz
+// instances, since browser UI shapes the same labels (tab titles, menu items,
+// omnibox suggestions) over and over. The least recently used runs are evicted
+// once the cache exceeds kMaxShapeRunCacheBytes.
+class ShapeRunCache : public base::MemoryReclaimer::Client,
+                      public base::trace_event::MemoryDumpProvider {
+ public:
+  static ShapeRunCache* GetInstance() {
+    static base::NoDestructor<ShapeRunCache> instance;
+    return instance.get();
+  }
+
+  // Copies the glyphs cached for |key| into |run|. Returns false if there are
+  // none.
+  bool Get(const ShapeRunCacheKey& key, internal::TextRunHarfBuzz* run) {
+    base::AutoLock lock(lock_);
+    auto it = cache_.Get(key);
+    if (it == cache_.end())
+      return false;
+
+    const ShapedRun& shaped = it->second;
+    run->glyph_count = shaped.glyphs.size();
+    run->glyphs.reset(new uint16_t[run->glyph_count]);
+    std::copy(shaped.glyphs.begin(), shaped.glyphs.end(), run->glyphs.get());
+    run->positions.reset(new SkPoint[run->glyph_count]);
+    std::copy(shaped.positions.begin(), shaped.positions.end(),
+              run->positions.get());
+    run->glyph_to_char.resize(run->glyph_count);
+    for (size_t i = 0; i < run->glyph_count; ++i)
+      run->glyph_to_char[i] = shaped.glyph_to_char[i] + run->range.start();
+    run->width = shaped.width;
+    return true;
+  }
+
+  // Caches the glyphs of the shaped |run| for |key|.
+  void Put(const ShapeRunCacheKey& key, const internal::TextRunHarfBuzz& run) {
+    ShapedRun shaped;
+    shaped.glyphs.assign(run.glyphs.get(), run.glyphs.get() + run.glyph_count);
+    shaped.positions.assign(run.positions.get(),
+                            run.positions.get() + run.glyph_count);
+    shaped.glyph_to_char.reserve(run.glyph_count);
+    for (uint32_t index : run.glyph_to_char)
+      shaped.glyph_to_char.push_back(index - run.range.start());
+    shaped.width = run.width;
+    const size_t entry_bytes = GetEntryBytes(key, shaped);
+    if (entry_bytes > kMaxShapeRunCacheBytes)
+      return;
+
+    base::AutoLock lock(lock_);
+    auto it = cache_.Peek(key);
+    if (it != cache_.end())
+      bytes_ -= GetEntryBytes(it->first, it->second);
+    cache_.Put(key, std::move(shaped));
+    bytes_ += entry_bytes;
+    EvictLocked(kMaxShapeRunCacheBytes);
+  }
+
+  size_t size() {
+    base::AutoLock lock(lock_);
+    return cache_.size();
+  }
+
+  void Clear() {
+    base::AutoLock lock(lock_);
+    cache_.Clear();
+    bytes_ = 0;
+  }
+
+  // base::MemoryReclaimer::Client:
+  base::MemoryReclaimer::Estimate EstimateReclaim() override {
+    base::AutoLock lock(lock_);
+    base::MemoryReclaimer::Estimate estimate;
+    estimate.reclaimable_bytes = bytes_;
+    estimate.cost = base::TimeDelta::FromSecondsD(
+        static_cast<double>(bytes_) / kShapedBytesPerSecond);
+    return estimate;
+  }
+
+  size_t Reclaim(size_t bytes) override {
+    base::AutoLock lock(lock_);
+    return EvictLocked(bytes_ - std::min(bytes, bytes_));
+  }
+
+  // base::trace_event::MemoryDumpProvider:
+  bool OnMemoryDump(const base::trace_event::MemoryDumpArgs& args,
+                    base::trace_event::ProcessMemoryDump* pmd) override {
+    using base::trace_event::MemoryAllocatorDump;
+    base::AutoLock lock(lock_);
+    MemoryAllocatorDump* dump = pmd->CreateAllocatorDump("gfx/shape_run_cache");
+    dump->AddScalar(MemoryAllocatorDump::kNameSize,
+                    MemoryAllocatorDump::kUnitsBytes, bytes_);
+    dump->AddScalar(MemoryAllocatorDump::kNameObjectCount,
+                    MemoryAllocatorDump::kUnitsObjects, cache_.size());
+    const char* system_allocator_name =
+        base::trace_event::MemoryDumpManager::GetInstance()
+            ->system_allocator_pool_name();
+    if (system_allocator_name)
+      pmd->AddSuballocation(dump->guid(), system_allocator_name);
+    return true;
+  }
+
+ private:
+  friend class base::NoDestructor<ShapeRunCache>;
+
+  using Cache = base::MRUCache<ShapeRunCacheKey, ShapedRun>;
+
+  ShapeRunCache() : cache_(Cache::NO_AUTO_EVICT) {
+    base::MemoryReclaimer::GetInstance()->Register(this);
+    base::trace_event::MemoryDumpManager::GetInstance()->RegisterDumpProvider(
+        this, "ShapeRunCache", nullptr);
+  }
+
+  ~ShapeRunCache() override = default;
+
+  static size_t GetEntryBytes(const ShapeRunCacheKey& key,
+                              const ShapedRun& shaped) {
+    return sizeof(ShapeRunCacheKey) + sizeof(ShapedRun) +
+           base::trace_event::EstimateMemoryUsage(key.text) +
+           shaped.EstimateMemoryUsage();
+  }
+
+  // Evicts the least recently used runs until the cache holds at most
+  // |max_bytes|. Returns the number of bytes evicted.
+  size_t EvictLocked(size_t max_bytes) {
+    lock_.AssertAcquired();
+    const size_t initial_bytes = bytes_;
+    while (bytes_ > max_bytes && !cache_.empty()) {
+      auto it = cache_.rbegin();
+      bytes_ -= GetEntryBytes(it->first, it->second);
+      cache_.Erase(it);
+    }
+    return initial_bytes - bytes_;
+  }
+
+  base::Lock lock_;
+  Cache cache_;
+  size_t bytes_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(ShapeRunCache);
+};
+
 }  // namespace
 
 namespace internal {
 
+size_t GetShapeRunCacheSizeForTesting() {
+  return ShapeRunCache::GetInstance()->size();
+}
+
+void ClearShapeRunCacheForTesting() {
+  ShapeRunCache::GetInstance()->Clear();
+}
+
 #if !defined(OS_MACOSX)
 sk_sp<SkTypeface> CreateSkiaTypeface(const Font& font,
                                      bool italic,
@@ -1623,6 +1839,34 @@ bool RenderTextHarfBuzz::ShapeRunWithFont(const base::string16& text,
   run->font = font;
   run->render_params = params;
 
+  // The glyph width for tests applies to the glyphs of all fonts, so runs
+  // shaped with it aren't cached.
+  const bool use_cache = glyph_width_for_test_ <= 0;
+  ShapeRunCacheKey key;
+  if (use_cache) {
+    const size_t context_start =
+        run->range.start() -
+        std::min(run->range.start(), kShapingContextLength);
+    const size_t context_end =
+        std::min(text.length(), run->range.end() + kShapingContextLength);
+    key.text = text.substr(context_start, context_end - context_start);
+    key.run_start = run->range.start() - context_start;
+    key.run_length = run->range.length();
+    key.typeface_id = skia_face->uniqueID();
+    key.font_size = run->font_size;
+    key.script = run->script;
+    key.is_rtl = run->is_rtl;
+    key.antialiasing = params.antialiasing;
+    key.subpixel_positioning = params.subpixel_positioning;
+    key.autohinter = params.autohinter;
+    key.hinting = params.hinting;
+    key.subpixel_rendering = params.subpixel_rendering;
+    key.subpixel_rendering_suppressed = subpixel_rendering_suppressed();
+    key.glyph_spacing = glyph_spacing();
+    if (ShapeRunCache::GetInstance()->Get(key, run))
+      return true;
+  }
+
   hb_font_t* harfbuzz_font = CreateHarfBuzzFont(
       run->skia_face, SkIntToScalar(run->font_size), run->render_params,
       subpixel_rendering_suppressed());
@@ -1685,6 +1929,8 @@ bool RenderTextHarfBuzz::ShapeRunWithFont(const base::string16& text,
 
   hb_buffer_destroy(buffer);
   hb_font_destroy(harfbuzz_font);
+  if (use_cache)
+    ShapeRunCache::GetInstance()->Put(key, *run);
   return true;
 }
 
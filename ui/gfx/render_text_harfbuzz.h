@@ -97,6 +97,11 @@ struct GFX_EXPORT TextRunHarfBuzz {
   DISALLOW_COPY_AND_ASSIGN(TextRunHarfBuzz);
 };
 
+// Returns the number of runs in, or clears, the cache of shaped runs shared by
+// all RenderTextHarfBuzz instances.
+GFX_EXPORT size_t GetShapeRunCacheSizeForTesting();
+GFX_EXPORT void ClearShapeRunCacheForTesting();
+
 // Manages the list of TextRunHarfBuzz and its logical <-> visual index mapping.
 class TextRunList {
  public:
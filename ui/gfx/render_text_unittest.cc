@@ -5230,6 +5230,39 @@ TEST_P(RenderTextHarfBuzzTest, FontSizeOverride) {
   EXPECT_EQ(default_font_size, run_list->runs()[2].get()->font_size);
 }
 
+// Ensures that runs shaped by one RenderText are reused by others.
+TEST_P(RenderTextHarfBuzzTest, ShapeRunCache) {
+  internal::ClearShapeRunCacheForTesting();
+  RenderTextHarfBuzz* render_text = GetRenderTextHarfBuzz();
+  render_text->SetText(UTF8ToUTF16("abc"));
+  test_api()->EnsureLayout();
+  const size_t cache_size = internal::GetShapeRunCacheSizeForTesting();
+  EXPECT_LT(0U, cache_size);
+  const internal::TextRunHarfBuzz* run = GetHarfBuzzRunList()->runs()[0].get();
+
+  // Another RenderText with the same text gets the cached glyphs.
+  std::unique_ptr<RenderText> other = render_text->CreateInstanceOfSameType();
+  other->SetText(UTF8ToUTF16("abc"));
+  test::RenderTextTestApi other_api(other.get());
+  other_api.EnsureLayout();
+  EXPECT_EQ(cache_size, internal::GetShapeRunCacheSizeForTesting());
+  const internal::TextRunHarfBuzz* other_run =
+      other_api.GetHarfBuzzRunList()->runs()[0].get();
+
+  ASSERT_EQ(run->glyph_count, other_run->glyph_count);
+  EXPECT_EQ(run->width, other_run->width);
+  for (size_t i = 0; i < run->glyph_count; ++i) {
+    EXPECT_EQ(run->glyphs[i], other_run->glyphs[i]);
+    EXPECT_EQ(run->positions[i], other_run->positions[i]);
+    EXPECT_EQ(run->glyph_to_char[i], other_run->glyph_to_char[i]);
+  }
+
+  // Different text is shaped and cached.
+  other->SetText(UTF8ToUTF16("abcd"));
+  other_api.EnsureLayout();
+  EXPECT_EQ(cache_size + 1, internal::GetShapeRunCacheSizeForTesting());
+}
+
 // Prefix for test instantiations intentionally left blank since each test
 // fixture class has a single parameterization.
 #if defined(OS_MACOSX)
@@ -9,7 +9,16 @@
 #include <string.h>
 #include <algorithm>
 
+#include "base/atomicops.h"
+#include "base/bind.h"
 #include "base/logging.h"
+#include "base/memory/ref_counted.h"
+#include "base/synchronization/condition_variable.h"
+#include "base/synchronization/lock.h"
+#include "base/sys_info.h"
+#include "base/task_scheduler/post_task.h"
+#include "base/task_scheduler/task_scheduler.h"
+#include "base/threading/thread_restrictions.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkColorFilter.h"
@@ -20,6 +29,94 @@
 #include "ui/gfx/geometry/point.h"
 #include "ui/gfx/geometry/size.h"
 
+namespace {
+
+// Bitmaps are split into bands of at least this many pixels when processed in
+// parallel, so icons and favicons are processed on the calling thread.
+const int kMinPixelsPerBand = 128 * 128;
+
+// Bands of rows which TaskScheduler workers and the calling thread pick up
+// concurrently.
+class RowBands : public base::RefCountedThreadSafe<RowBands> {
+ public:
+  RowBands(int height,
+           int band_count,
+           const base::RepeatingCallback<void(int, int)>& process_rows)
+      : height_(height),
+        band_count_(band_count),
+        process_rows_(process_rows),
+        bands_done_cv_(&lock_) {}
+
+  // Processes bands until none are left.
+  void ProcessBands() {
+    while (true) {
+      int band = base::subtle::NoBarrier_AtomicIncrement(&next_band_, 1) - 1;
+      if (band >= band_count_)
+        return;
+      process_rows_.Run(height_ * band / band_count_,
+                        height_ * (band + 1) / band_count_);
+
+      base::AutoLock lock(lock_);
+      if (++bands_done_ == band_count_)
+        bands_done_cv_.Signal();
+    }
+  }
+
+  // Waits until the bands picked up by other threads have been processed.
+  void WaitUntilDone() {
+    base::AutoLock lock(lock_);
+    while (bands_done_ < band_count_)
+      bands_done_cv_.Wait();
+  }
+
+ private:
+  friend class base::RefCountedThreadSafe<RowBands>;
+
+  ~RowBands() = default;
+
+  const int height_;
+  const int band_count_;
+  const base::RepeatingCallback<void(int, int)> process_rows_;
+  base::subtle::Atomic32 next_band_ = 0;
+
+  base::Lock lock_;
+  base::ConditionVariable bands_done_cv_;
+  int bands_done_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(RowBands);
+};
+
+}  // namespace
+
+// static
+void SkBitmapOperations::ProcessRows(int width,
+                                     int height,
+                                     const RowProcessor& process_rows) {
+  int band_count = 1;
+  if (base::TaskScheduler::GetInstance()) {
+    int64_t max_band_count =
+        static_cast<int64_t>(width) * height / kMinPixelsPerBand;
+    band_count = static_cast<int>(std::min<int64_t>(
+        {base::SysInfo::NumberOfProcessors(), height, max_band_count}));
+  }
+  if (band_count <= 1) {
+    process_rows.Run(0, height);
+    return;
+  }
+
+  auto bands = base::MakeRefCounted<RowBands>(height, band_count, process_rows);
+  for (int i = 1; i < band_count; ++i) {
+    base::PostTaskWithTraits(FROM_HERE, {base::TaskPriority::USER_BLOCKING},
+                             base::BindOnce(&RowBands::ProcessBands, bands));
+  }
+  bands->ProcessBands();
+
+  // The bands left were picked up by workers which are already running, so
+  // this never waits for tasks which are still queued.
+  base::ScopedAllowBaseSyncPrimitivesOutsideBlockingScope allow_wait;
+  bands->WaitUntilDone();
+}
+
 // static
 SkBitmap SkBitmapOperations::CreateInvertedBitmap(const SkBitmap& image) {
   DCHECK(image.colorType() == kN32_SkColorType);
@@ -41,6 +138,64 @@ SkBitmap SkBitmapOperations::CreateInvertedBitmap(const SkBitmap& image) {
   return inverted;
 }
 
+namespace {
+
+// Fixed-point denominator of the blend weights.
+const uint32_t kBlendDenominator = 65536;
+
+// Blends rows [begin, end) of |first| and |second| into |blended|, weighting
+// |second| by |second_weight| / kBlendDenominator. This uses integer math on
+// separate channels, which compilers vectorize.
+void BlendRows(const SkBitmap& first,
+               const SkBitmap& second,
+               uint32_t second_weight,
+               SkBitmap* blended,
+               int begin,
+               int end) {
+  const uint32_t first_weight = kBlendDenominator - second_weight;
+  for (int y = begin; y < end; ++y) {
+    const uint32_t* first_row = first.getAddr32(0, y);
+    const uint32_t* second_row = second.getAddr32(0, y);
+    uint32_t* dst_row = blended->getAddr32(0, y);
+
+    for (int x = 0; x < first.width(); ++x) {
+      uint32_t first_pixel = first_row[x];
+      uint32_t second_pixel = second_row[x];
+
+      uint32_t a = (SkColorGetA(first_pixel) * first_weight +
+                    SkColorGetA(second_pixel) * second_weight) >> 16;
+      uint32_t r = (SkColorGetR(first_pixel) * first_weight +
+                    SkColorGetR(second_pixel) * second_weight) >> 16;
+      uint32_t g = (SkColorGetG(first_pixel) * first_weight +
+                    SkColorGetG(second_pixel) * second_weight) >> 16;
+      uint32_t b = (SkColorGetB(first_pixel) * first_weight +
+                    SkColorGetB(second_pixel) * second_weight) >> 16;
+
+      dst_row[x] = SkColorSetARGB(a, r, g, b);
+    }
+  }
+}
+
+// Masks rows [begin, end) of |rgb| by the alpha of |alpha| into |masked|.
+void MaskRows(const SkBitmap& rgb,
+              const SkBitmap& alpha,
+              SkBitmap* masked,
+              int begin,
+              int end) {
+  for (int y = begin; y < end; ++y) {
+    const uint32_t* rgb_row = rgb.getAddr32(0, y);
+    const uint32_t* alpha_row = alpha.getAddr32(0, y);
+    uint32_t* dst_row = masked->getAddr32(0, y);
+
+    for (int x = 0; x < masked->width(); ++x) {
+      unsigned scale = SkAlpha255To256(SkGetPackedA32(alpha_row[x]));
+      dst_row[x] = SkAlphaMulQ(rgb_row[x], scale);
+    }
+  }
+}
+
+}  // namespace
+
 // static
 SkBitmap SkBitmapOperations::CreateBlendedBitmap(const SkBitmap& first,
                                                  const SkBitmap& second,
@@ -62,30 +217,10 @@ SkBitmap SkBitmapOperations::CreateBlendedBitmap(const SkBitmap& first,
   SkBitmap blended;
   blended.allocN32Pixels(first.width(), first.height());
 
-  double first_alpha = 1 - alpha;
-
-  for (int y = 0; y < first.height(); ++y) {
-    uint32_t* first_row = first.getAddr32(0, y);
-    uint32_t* second_row = second.getAddr32(0, y);
-    uint32_t* dst_row = blended.getAddr32(0, y);
-
-    for (int x = 0; x < first.width(); ++x) {
-      uint32_t first_pixel = first_row[x];
-      uint32_t second_pixel = second_row[x];
-
-      int a = static_cast<int>((SkColorGetA(first_pixel) * first_alpha) +
-                               (SkColorGetA(second_pixel) * alpha));
-      int r = static_cast<int>((SkColorGetR(first_pixel) * first_alpha) +
-                               (SkColorGetR(second_pixel) * alpha));
-      int g = static_cast<int>((SkColorGetG(first_pixel) * first_alpha) +
-                               (SkColorGetG(second_pixel) * alpha));
-      int b = static_cast<int>((SkColorGetB(first_pixel) * first_alpha) +
-                               (SkColorGetB(second_pixel) * alpha));
-
-      dst_row[x] = SkColorSetARGB(a, r, g, b);
-    }
-  }
-
+  uint32_t second_weight = static_cast<uint32_t>(alpha * kBlendDenominator);
+  ProcessRows(first.width(), first.height(),
+              base::BindRepeating(&BlendRows, first, second, second_weight,
+                                  &blended));
   return blended;
 }
 
@@ -101,18 +236,8 @@ SkBitmap SkBitmapOperations::CreateMaskedBitmap(const SkBitmap& rgb,
   SkBitmap masked;
   masked.allocN32Pixels(rgb.width(), rgb.height());
 
-  for (int y = 0; y < masked.height(); ++y) {
-    uint32_t* rgb_row = rgb.getAddr32(0, y);
-    uint32_t* alpha_row = alpha.getAddr32(0, y);
-    uint32_t* dst_row = masked.getAddr32(0, y);
-
-    for (int x = 0; x < masked.width(); ++x) {
-      unsigned alpha = SkGetPackedA32(alpha_row[x]);
-      unsigned scale = SkAlpha255To256(alpha);
-      dst_row[x] = SkAlphaMulQ(rgb_row[x], scale);
-    }
-  }
-
+  ProcessRows(masked.width(), masked.height(),
+              base::BindRepeating(&MaskRows, rgb, alpha, &masked));
   return masked;
 }
 
@@ -470,6 +595,20 @@ const LineProcessor kLineProcessors[kNumHOps][kNumSOps][kNumLOps] = {
 };
 
 }  // namespace HSLShift
+
+// Shifts rows [begin, end) of |bitmap| into |shifted| with |line_proc|.
+void HSLShiftRows(HSLShift::LineProcessor line_proc,
+                  const color_utils::HSL& hsl_shift,
+                  const SkBitmap& bitmap,
+                  SkBitmap* shifted,
+                  int begin,
+                  int end) {
+  for (int y = begin; y < end; ++y) {
+    (*line_proc)(hsl_shift, bitmap.getAddr32(0, y), shifted->getAddr32(0, y),
+                 bitmap.width());
+  }
+}
+
 }  // namespace
 
 // static
@@ -505,14 +644,9 @@ SkBitmap SkBitmapOperations::CreateHSLShiftedBitmap(
   SkBitmap shifted;
   shifted.allocN32Pixels(bitmap.width(), bitmap.height());
 
-  // Loop through the pixels of the original bitmap.
-  for (int y = 0; y < bitmap.height(); ++y) {
-    SkPMColor* pixels = bitmap.getAddr32(0, y);
-    SkPMColor* tinted_pixels = shifted.getAddr32(0, y);
-
-    (*line_proc)(hsl_shift, pixels, tinted_pixels, bitmap.width());
-  }
-
+  ProcessRows(bitmap.width(), bitmap.height(),
+              base::BindRepeating(&HSLShiftRows, line_proc, hsl_shift, bitmap,
+                                  &shifted));
   return shifted;
 }
 
@@ -561,32 +695,31 @@ SkBitmap SkBitmapOperations::DownsampleByTwoUntilSize(const SkBitmap& bitmap,
   return current;
 }
 
-// static
-SkBitmap SkBitmapOperations::DownsampleByTwo(const SkBitmap& bitmap) {
-  // Handle the nop case.
-  if ((bitmap.width() <= 1) || (bitmap.height() <= 1))
-    return bitmap;
-
-  SkBitmap result;
-  result.allocN32Pixels((bitmap.width() + 1) / 2, (bitmap.height() + 1) / 2);
+namespace {
 
-  const int resultLastX = result.width() - 1;
+// Downsamples |bitmap| into rows [begin, end) of |result|, see
+// SkBitmapOperations::DownsampleByTwo().
+void DownsampleRows(const SkBitmap& bitmap,
+                    SkBitmap* result,
+                    int begin,
+                    int end) {
+  const int resultLastX = result->width() - 1;
   const int srcLastX = bitmap.width() - 1;
 
-  for (int dest_y = 0; dest_y < result.height(); ++dest_y) {
+  for (int dest_y = begin; dest_y < end; ++dest_y) {
     const int src_y = dest_y << 1;
     const SkPMColor* SK_RESTRICT cur_src0 = bitmap.getAddr32(0, src_y);
     const SkPMColor* SK_RESTRICT cur_src1 = cur_src0;
     if (src_y + 1 < bitmap.height())
       cur_src1 = bitmap.getAddr32(0, src_y + 1);
 
-    SkPMColor* SK_RESTRICT cur_dst = result.getAddr32(0, dest_y);
+    SkPMColor* SK_RESTRICT cur_dst = result->getAddr32(0, dest_y);
 
     for (int dest_x = 0; dest_x <= resultLastX; ++dest_x) {
       // This code is based on downsampleby2_proc32 in SkBitmap.cpp. It is very
       // clever in that it does two channels at once: alpha and green ("ag")
       // and red and blue ("rb"). Each channel gets averaged across 4 pixels
-      // to get the result.
+      // to get the result->
       int bump_x = (dest_x << 1) < srcLastX;
       SkPMColor tmp, ag, rb;
 
@@ -620,6 +753,21 @@ SkBitmap SkBitmapOperations::DownsampleByTwo(const SkBitmap& bitmap) {
       cur_src1 += 2;
     }
   }
+}
+
+}  // namespace
+
+// static
+SkBitmap SkBitmapOperations::DownsampleByTwo(const SkBitmap& bitmap) {
+  // Handle the nop case.
+  if ((bitmap.width() <= 1) || (bitmap.height() <= 1))
+    return bitmap;
+
+  SkBitmap result;
+  result.allocN32Pixels((bitmap.width() + 1) / 2, (bitmap.height() + 1) / 2);
+
+  ProcessRows(result.width(), result.height(),
+              base::BindRepeating(&DownsampleRows, bitmap, &result));
 
   return result;
 }
@@ -5,6 +5,7 @@
 #ifndef UI_GFX_SKBITMAP_OPERATIONS_H_
 #define UI_GFX_SKBITMAP_OPERATIONS_H_
 
+#include "base/callback.h"
 #include "base/gtest_prod_util.h"
 #include "ui/gfx/color_utils.h"
 #include "ui/gfx/gfx_export.h"
@@ -110,8 +111,18 @@ class GFX_EXPORT SkBitmapOperations {
   static SkBitmap Rotate(const SkBitmap& source, RotationAmount rotation);
 
  private:
+  // Processes rows [begin, end) of a bitmap.
+  using RowProcessor = base::RepeatingCallback<void(int begin, int end)>;
+
   SkBitmapOperations();  // Class for scoping only.
 
+  // Runs |process_rows| over the |height| rows of a bitmap with |width|
+  // columns. Large bitmaps are split into bands of rows which are processed in
+  // parallel on the TaskScheduler, if there is one.
+  static void ProcessRows(int width,
+                          int height,
+                          const RowProcessor& process_rows);
+
   FRIEND_TEST_ALL_PREFIXES(SkBitmapOperationsTest, DownsampleByTwo);
   FRIEND_TEST_ALL_PREFIXES(SkBitmapOperationsTest, DownsampleByTwoSmall);
 };
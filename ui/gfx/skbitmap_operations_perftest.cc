@@ -0,0 +1,101 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/gfx/skbitmap_operations.h"
+
+#include <string>
+
+#include "base/bind.h"
+#include "base/callback.h"
+#include "base/test/scoped_task_environment.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkColorPriv.h"
+
+namespace {
+
+const int kTimeLimitMs = 2000;
+
+// Sizes of a favicon and of a high-DPI theme image.
+const int kSmallSize = 32;
+const int kLargeSize = 2048;
+
+SkBitmap MakeBitmap(int size) {
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(size, size);
+  for (int y = 0; y < size; ++y) {
+    for (int x = 0; x < size; ++x) {
+      *bitmap.getAddr32(x, y) =
+          SkPreMultiplyARGB((x + y) % 256, x % 256, y % 256, (x * y) % 256);
+    }
+  }
+  return bitmap;
+}
+
+void RunOperationTest(const std::string& name,
+                      int size,
+                      const base::RepeatingCallback<SkBitmap(const SkBitmap&)>&
+                          operation) {
+  SkBitmap bitmap = MakeBitmap(size);
+
+  base::TimeTicks start = base::TimeTicks::Now();
+  base::TimeTicks end = start + base::TimeDelta::FromMilliseconds(kTimeLimitMs);
+  int count = 0;
+  while (base::TimeTicks::Now() < end) {
+    operation.Run(bitmap);
+    ++count;
+  }
+  base::TimeDelta elapsed = base::TimeTicks::Now() - start;
+
+  perf_test::PrintResult(
+      "skbitmap_operations", "_" + std::to_string(size), name,
+      count * static_cast<double>(size) * size / elapsed.InMicrosecondsF(),
+      "pixels/us", true);
+}
+
+SkBitmap Blend(const SkBitmap& bitmap) {
+  return SkBitmapOperations::CreateBlendedBitmap(bitmap, bitmap, 0.3);
+}
+
+SkBitmap Mask(const SkBitmap& bitmap) {
+  return SkBitmapOperations::CreateMaskedBitmap(bitmap, bitmap);
+}
+
+SkBitmap ShiftHSL(const SkBitmap& bitmap) {
+  return SkBitmapOperations::CreateHSLShiftedBitmap(bitmap,
+                                                    {0.3, 0.8, 0.4});
+}
+
+SkBitmap Downsample(const SkBitmap& bitmap) {
+  return SkBitmapOperations::DownsampleByTwo(bitmap);
+}
+
+void RunOperationTests(
+    const std::string& name,
+    const base::RepeatingCallback<SkBitmap(const SkBitmap&)>& operation) {
+  // Large bitmaps are processed in parallel on the TaskScheduler.
+  base::test::ScopedTaskEnvironment scoped_task_environment;
+  RunOperationTest(name, kSmallSize, operation);
+  RunOperationTest(name, kLargeSize, operation);
+}
+
+TEST(SkBitmapOperationsPerfTest, CreateBlendedBitmap) {
+  RunOperationTests("blend", base::BindRepeating(&Blend));
+}
+
+TEST(SkBitmapOperationsPerfTest, CreateMaskedBitmap) {
+  RunOperationTests("mask", base::BindRepeating(&Mask));
+}
+
+TEST(SkBitmapOperationsPerfTest, CreateHSLShiftedBitmap) {
+  RunOperationTests("hsl_shift", base::BindRepeating(&ShiftHSL));
+}
+
+TEST(SkBitmapOperationsPerfTest, DownsampleByTwo) {
+  RunOperationTests("downsample", base::BindRepeating(&Downsample));
+}
+
+}  // namespace
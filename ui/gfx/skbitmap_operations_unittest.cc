@@ -5,7 +5,9 @@
 #include "ui/gfx/skbitmap_operations.h"
 
 #include <stdint.h>
+#include <string.h>
 
+#include "base/test/scoped_task_environment.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkCanvas.h"
@@ -30,6 +32,11 @@ inline bool MultipliedColorsClose(uint32_t a, uint32_t b) {
                      SkUnPreMultiply::PMColorToColor(b));
 }
 
+bool BitmapsEqual(const SkBitmap& a, const SkBitmap& b) {
+  return a.width() == b.width() && a.height() == b.height() &&
+         !memcmp(a.getPixels(), b.getPixels(), a.computeByteSize());
+}
+
 bool BitmapsClose(const SkBitmap& a, const SkBitmap& b) {
   for (int y = 0; y < a.height(); y++) {
     for (int x = 0; x < a.width(); x++) {
@@ -535,3 +542,32 @@ TEST(SkBitmapOperationsTest, RotateImage) {
     }
   }
 }
+
+// Large bitmaps are processed in bands of rows in parallel, which must give
+// the same results as processing them on the calling thread.
+TEST(SkBitmapOperationsTest, ParallelMatchesSerial) {
+  const int src_w = 512, src_h = 515;
+  SkBitmap first, second;
+  FillDataToBitmap(src_w, src_h, &first);
+  FillDataToBitmap(src_w, src_h, &second);
+  second.eraseArea(SkIRect::MakeWH(src_w / 2, src_h), SK_ColorBLUE);
+  color_utils::HSL hsl_shift = {0.3, 0.8, 0.4};
+
+  // There is no TaskScheduler yet, so these run on this thread.
+  SkBitmap blended =
+      SkBitmapOperations::CreateBlendedBitmap(first, second, 0.3);
+  SkBitmap masked = SkBitmapOperations::CreateMaskedBitmap(first, second);
+  SkBitmap shifted =
+      SkBitmapOperations::CreateHSLShiftedBitmap(first, hsl_shift);
+  SkBitmap downsampled = SkBitmapOperations::DownsampleByTwo(first);
+
+  base::test::ScopedTaskEnvironment scoped_task_environment;
+  EXPECT_TRUE(BitmapsEqual(
+      blended, SkBitmapOperations::CreateBlendedBitmap(first, second, 0.3)));
+  EXPECT_TRUE(BitmapsEqual(
+      masked, SkBitmapOperations::CreateMaskedBitmap(first, second)));
+  EXPECT_TRUE(BitmapsEqual(
+      shifted, SkBitmapOperations::CreateHSLShiftedBitmap(first, hsl_shift)));
+  EXPECT_TRUE(
+      BitmapsEqual(downsampled, SkBitmapOperations::DownsampleByTwo(first)));
+}
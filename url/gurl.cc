@@ -63,38 +63,40 @@ GURL::GURL(const char* canonical_spec,
            size_t canonical_spec_len,
            const url::Parsed& parsed,
            bool is_valid)
-    : spec_(canonical_spec, canonical_spec_len),
-      is_valid_(is_valid),
-      parsed_(parsed) {
+    : is_valid_(is_valid), parsed_(parsed) {
+  SetSpec(std::string(canonical_spec, canonical_spec_len));
   InitializeFromCanonicalSpec();
 }
 
 GURL::GURL(std::string canonical_spec, const url::Parsed& parsed, bool is_valid)
-    : spec_(std::move(canonical_spec)), is_valid_(is_valid), parsed_(parsed) {
+    : is_valid_(is_valid), parsed_(parsed) {
+  SetSpec(std::move(canonical_spec));
   InitializeFromCanonicalSpec();
 }
 
 template<typename STR>
 void GURL::InitCanonical(base::BasicStringPiece<STR> input_spec,
                          bool trim_path_end) {
-  url::StdStringCanonOutput output(&spec_);
+  std::string spec;
+  url::StdStringCanonOutput output(&spec);
   is_valid_ = url::Canonicalize(
       input_spec.data(), static_cast<int>(input_spec.length()), trim_path_end,
       NULL, &output, &parsed_);
 
   output.Complete();  // Must be done before using string.
+  SetSpec(std::move(spec));
   if (is_valid_ && SchemeIsFileSystem()) {
-    inner_url_.reset(new GURL(spec_.data(), parsed_.Length(),
+    inner_url_.reset(new GURL(spec_->data.data(), parsed_.Length(),
                               *parsed_.inner_parsed(), true));
   }
   // Valid URLs always have non-empty specs.
-  DCHECK(!is_valid_ || !spec_.empty());
+  DCHECK(!is_valid_ || spec_);
 }
 
 void GURL::InitializeFromCanonicalSpec() {
   if (is_valid_ && SchemeIsFileSystem()) {
     inner_url_.reset(
-        new GURL(spec_.data(), parsed_.Length(),
+        new GURL(spec_->data.data(), parsed_.Length(),
                  *parsed_.inner_parsed(), true));
   }
 
@@ -103,22 +105,23 @@ void GURL::InitializeFromCanonicalSpec() {
   // what we would have produced. Skip checking for invalid URLs have no meaning
   // and we can't always canonicalize then reproducibly.
   if (is_valid_) {
-    DCHECK(!spec_.empty());
+    DCHECK(spec_);
+    const std::string& spec = spec_->data;
     url::Component scheme;
     // We can't do this check on the inner_url of a filesystem URL, as
     // canonical_spec actually points to the start of the outer URL, so we'd
     // end up with infinite recursion in this constructor.
-    if (!url::FindAndCompareScheme(spec_.data(), spec_.length(),
+    if (!url::FindAndCompareScheme(spec.data(), spec.length(),
                                    url::kFileSystemScheme, &scheme) ||
         scheme.begin == parsed_.scheme.begin) {
       // We need to retain trailing whitespace on path URLs, as the |parsed_|
       // spec we originally received may legitimately contain trailing white-
       // space on the path or  components e.g. if the #ref has been
       // removed from a "foo:hello #ref" URL (see http://crbug.com/291747).
-      GURL test_url(spec_, RETAIN_TRAILING_PATH_WHITEPACE);
+      GURL test_url(spec, RETAIN_TRAILING_PATH_WHITEPACE);
 
       DCHECK(test_url.is_valid_ == is_valid_);
-      DCHECK(test_url.spec_ == spec_);
+      DCHECK(test_url.possibly_invalid_spec() == spec);
 
       DCHECK(test_url.parsed_.scheme == parsed_.scheme);
       DCHECK(test_url.parsed_.username == parsed_.username);
@@ -162,19 +165,19 @@ GURL& GURL::operator=(GURL&& other) noexcept {
 }
 
 const std::string& GURL::spec() const {
-  if (is_valid_ || spec_.empty())
-    return spec_;
+  if (is_valid_ || !spec_)
+    return possibly_invalid_spec();
 
   DCHECK(false) << "Trying to get the spec of an invalid URL!";
   return empty_string.Get();
 }
 
 bool GURL::operator<(const GURL& other) const {
-  return spec_ < other.spec_;
+  return possibly_invalid_spec() < other.possibly_invalid_spec();
 }
 
 bool GURL::operator>(const GURL& other) const {
-  return spec_ > other.spec_;
+  return possibly_invalid_spec() > other.possibly_invalid_spec();
 }
 
 // Note: code duplicated below (it's inconvenient to use a template here).
@@ -184,20 +187,23 @@ GURL GURL::Resolve(const std::string& relative) const {
     return GURL();
 
   GURL result;
-  url::StdStringCanonOutput output(&result.spec_);
-  if (!url::ResolveRelative(spec_.data(), static_cast<int>(spec_.length()),
-                            parsed_, relative.data(),
-                            static_cast<int>(relative.length()),
-                            nullptr, &output, &result.parsed_)) {
+  std::string result_spec;
+  url::StdStringCanonOutput output(&result_spec);
+  if (!url::ResolveRelative(spec_->data.data(),
+                            static_cast<int>(spec_->data.length()), parsed_,
+                            relative.data(),
+                            static_cast<int>(relative.length()), nullptr,
+                            &output, &result.parsed_)) {
     // Error resolving, return an empty URL.
     return GURL();
   }
 
   output.Complete();
+  result.SetSpec(std::move(result_spec));
   result.is_valid_ = true;
   if (result.SchemeIsFileSystem()) {
     result.inner_url_.reset(
-        new GURL(result.spec_.data(), result.parsed_.Length(),
+        new GURL(result.spec_->data.data(), result.parsed_.Length(),
                  *result.parsed_.inner_parsed(), true));
   }
   return result;
@@ -210,20 +216,23 @@ GURL GURL::Resolve(const base::string16& relative) const {
     return GURL();
 
   GURL result;
-  url::StdStringCanonOutput output(&result.spec_);
-  if (!url::ResolveRelative(spec_.data(), static_cast<int>(spec_.length()),
-                            parsed_, relative.data(),
-                            static_cast<int>(relative.length()),
-                            nullptr, &output, &result.parsed_)) {
+  std::string result_spec;
+  url::StdStringCanonOutput output(&result_spec);
+  if (!url::ResolveRelative(spec_->data.data(),
+                            static_cast<int>(spec_->data.length()), parsed_,
+                            relative.data(),
+                            static_cast<int>(relative.length()), nullptr,
+                            &output, &result.parsed_)) {
     // Error resolving, return an empty URL.
     return GURL();
   }
 
   output.Complete();
+  result.SetSpec(std::move(result_spec));
   result.is_valid_ = true;
   if (result.SchemeIsFileSystem()) {
     result.inner_url_.reset(
-        new GURL(result.spec_.data(), result.parsed_.Length(),
+        new GURL(result.spec_->data.data(), result.parsed_.Length(),
                  *result.parsed_.inner_parsed(), true));
   }
   return result;
@@ -238,14 +247,16 @@ GURL GURL::ReplaceComponents(
   if (!is_valid_)
     return GURL();
 
-  url::StdStringCanonOutput output(&result.spec_);
+  std::string result_spec;
+  url::StdStringCanonOutput output(&result_spec);
   result.is_valid_ = url::ReplaceComponents(
-      spec_.data(), static_cast<int>(spec_.length()), parsed_, replacements,
-      NULL, &output, &result.parsed_);
+      spec_->data.data(), static_cast<int>(spec_->data.length()), parsed_,
+      replacements, NULL, &output, &result.parsed_);
 
   output.Complete();
+  result.SetSpec(std::move(result_spec));
   if (result.is_valid_ && result.SchemeIsFileSystem()) {
-    result.inner_url_.reset(new GURL(result.spec_.data(),
+    result.inner_url_.reset(new GURL(result.spec_->data.data(),
                                      result.parsed_.Length(),
                                      *result.parsed_.inner_parsed(), true));
   }
@@ -261,14 +272,16 @@ GURL GURL::ReplaceComponents(
   if (!is_valid_)
     return GURL();
 
-  url::StdStringCanonOutput output(&result.spec_);
+  std::string result_spec;
+  url::StdStringCanonOutput output(&result_spec);
   result.is_valid_ = url::ReplaceComponents(
-      spec_.data(), static_cast<int>(spec_.length()), parsed_, replacements,
-      NULL, &output, &result.parsed_);
+      spec_->data.data(), static_cast<int>(spec_->data.length()), parsed_,
+      replacements, NULL, &output, &result.parsed_);
 
   output.Complete();
+  result.SetSpec(std::move(result_spec));
   if (result.is_valid_ && result.SchemeIsFileSystem()) {
-    result.inner_url_.reset(new GURL(result.spec_.data(),
+    result.inner_url_.reset(new GURL(result.spec_->data.data(),
                                      result.parsed_.Length(),
                                      *result.parsed_.inner_parsed(), true));
   }
@@ -324,11 +337,12 @@ GURL GURL::GetWithEmptyPath() const {
   other.parsed_.query.reset();
   other.parsed_.ref.reset();
 
-  // Set the path, since the path is longer than one, we can just set the
-  // first character and resize.
-  other.spec_[other.parsed_.path.begin] = '/';
+  // Set the path, since the path is longer than one, we can just keep
+  // everything before it and append the slash.
+  std::string spec(spec_->data, 0, other.parsed_.path.begin);
+  spec.push_back('/');
+  other.SetSpec(std::move(spec));
   other.parsed_.path.len = 1;
-  other.spec_.resize(other.parsed_.path.begin + 1);
   return other;
 }
 
@@ -337,7 +351,7 @@ GURL GURL::GetWithoutFilename() const {
 }
 
 bool GURL::IsStandard() const {
-  return url::IsStandard(spec_.data(), parsed_.scheme);
+  return url::IsStandard(possibly_invalid_spec().data(), parsed_.scheme);
 }
 
 bool GURL::IsAboutBlank() const {
@@ -367,7 +381,8 @@ bool GURL::SchemeIsHTTPOrHTTPS() const {
 }
 
 bool GURL::SchemeIsValidForReferrer() const {
-  return is_valid_ && IsReferrerScheme(spec_.data(), parsed_.scheme);
+  return is_valid_ &&
+         IsReferrerScheme(possibly_invalid_spec().data(), parsed_.scheme);
 }
 
 bool GURL::SchemeIsWSOrWSS() const {
@@ -376,21 +391,23 @@ bool GURL::SchemeIsWSOrWSS() const {
 
 int GURL::IntPort() const {
   if (parsed_.port.is_nonempty())
-    return url::ParsePort(spec_.data(), parsed_.port);
+    return url::ParsePort(possibly_invalid_spec().data(), parsed_.port);
   return url::PORT_UNSPECIFIED;
 }
 
 int GURL::EffectiveIntPort() const {
   int int_port = IntPort();
   if (int_port == url::PORT_UNSPECIFIED && IsStandard())
-    return url::DefaultPortForScheme(spec_.data() + parsed_.scheme.begin,
-                                     parsed_.scheme.len);
+    return url::DefaultPortForScheme(
+        possibly_invalid_spec().data() + parsed_.scheme.begin,
+        parsed_.scheme.len);
   return int_port;
 }
 
 std::string GURL::ExtractFileName() const {
   url::Component file_component;
-  url::ExtractFileName(spec_.data(), parsed_.path, &file_component);
+  url::ExtractFileName(possibly_invalid_spec().data(), parsed_.path,
+                       &file_component);
   return ComponentString(file_component);
 }
 
@@ -400,7 +417,7 @@ std::string GURL::PathForRequest() const {
   if (parsed_.ref.len >= 0) {
     // Clip off the reference when it exists. The reference starts after the
     // #-sign, so we have to subtract one to also remove it.
-    return std::string(spec_, parsed_.path.begin,
+    return std::string(possibly_invalid_spec(), parsed_.path.begin,
                        parsed_.ref.begin - parsed_.path.begin - 1);
   }
   // Compute the actual path length, rather than depending on the spec's
@@ -410,7 +427,7 @@ std::string GURL::PathForRequest() const {
   if (parsed_.query.is_valid())
     path_len = parsed_.query.end() - parsed_.path.begin;
 
-  return std::string(spec_, parsed_.path.begin, path_len);
+  return std::string(possibly_invalid_spec(), parsed_.path.begin, path_len);
 }
 
 std::string GURL::HostNoBrackets() const {
@@ -420,7 +437,8 @@ std::string GURL::HostNoBrackets() const {
 base::StringPiece GURL::HostNoBracketsPiece() const {
   // If host looks like an IPv6 literal, strip the square brackets.
   url::Component h(parsed_.host);
-  if (h.len >= 2 && spec_[h.begin] == '[' && spec_[h.end() - 1] == ']') {
+  const std::string& spec = possibly_invalid_spec();
+  if (h.len >= 2 && spec[h.begin] == '[' && spec[h.end() - 1] == ']') {
     h.begin++;
     h.len -= 2;
   }
@@ -439,6 +457,20 @@ const GURL& GURL::EmptyGURL() {
   return empty_gurl.Get();
 }
 
+void GURL::SetSpec(std::string spec) {
+  if (spec.empty()) {
+    spec_ = nullptr;
+    return;
+  }
+  spec_ = base::MakeRefCounted<base::RefCountedData<std::string>>(
+      std::move(spec));
+}
+
+// static
+const std::string& GURL::EmptySpec() {
+  return empty_string.Get();
+}
+
 bool GURL::DomainIs(base::StringPiece canonical_domain) const {
   if (!is_valid_)
     return false;
@@ -453,8 +485,9 @@ bool GURL::EqualsIgnoringRef(const GURL& other) const {
   int ref_position = parsed_.CountCharactersBefore(url::Parsed::REF, true);
   int ref_position_other =
       other.parsed_.CountCharactersBefore(url::Parsed::REF, true);
-  return base::StringPiece(spec_).substr(0, ref_position) ==
-         base::StringPiece(other.spec_).substr(0, ref_position_other);
+  return base::StringPiece(possibly_invalid_spec()).substr(0, ref_position) ==
+         base::StringPiece(other.possibly_invalid_spec())
+             .substr(0, ref_position_other);
 }
 
 void GURL::Swap(GURL* other) {
@@ -465,7 +498,10 @@ void GURL::Swap(GURL* other) {
 }
 
 size_t GURL::EstimateMemoryUsage() const {
-  return base::trace_event::EstimateMemoryUsage(spec_) +
+  // The spec is shared between copies, but each of them counts it.
+  return (spec_ ? sizeof(base::RefCountedData<std::string>) +
+                      base::trace_event::EstimateMemoryUsage(spec_->data)
+                : 0) +
          base::trace_event::EstimateMemoryUsage(inner_url_) +
          (parsed_.inner_parsed() ? sizeof(url::Parsed) : 0);
 }
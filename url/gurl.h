@@ -12,6 +12,7 @@
 #include <string>
 
 #include "base/debug/alias.h"
+#include "base/memory/ref_counted.h"
 #include "base/strings/string16.h"
 #include "base/strings/string_piece.h"
 #include "url/third_party/mozilla/url_parse.h"
@@ -51,8 +52,8 @@ class URL_EXPORT GURL {
   // Creates an empty, invalid URL.
   GURL();
 
-  // Copy construction is relatively inexpensive, with most of the time going
-  // to reallocating the string. It does not re-parse.
+  // Copy construction is inexpensive: copies share the spec, which never
+  // changes once the URL is built. It does not re-parse.
   GURL(const GURL& other);
   GURL(GURL&& other) noexcept;
 
@@ -93,7 +94,7 @@ class URL_EXPORT GURL {
   // invalid, and is_valid() will return false for them. This is provided
   // because some users may want to treat the empty case differently.
   bool is_empty() const {
-    return spec_.empty();
+    return !spec_;
   }
 
   // Returns the raw spec, i.e., the full text of the URL, in canonical UTF-8,
@@ -118,7 +119,7 @@ class URL_EXPORT GURL {
   //
   // The returned string is guaranteed to be valid UTF-8.
   const std::string& possibly_invalid_spec() const {
-    return spec_;
+    return spec_ ? spec_->data : EmptySpec();
   }
 
   // Getter for the raw parsed structure. This allows callers to locate parts
@@ -444,16 +445,23 @@ class URL_EXPORT GURL {
   std::string ComponentString(const url::Component& comp) const {
     if (comp.len <= 0)
       return std::string();
-    return std::string(spec_, comp.begin, comp.len);
+    return std::string(possibly_invalid_spec(), comp.begin, comp.len);
   }
   base::StringPiece ComponentStringPiece(const url::Component& comp) const {
     if (comp.len <= 0)
       return base::StringPiece();
-    return base::StringPiece(&spec_[comp.begin], comp.len);
+    return base::StringPiece(&possibly_invalid_spec()[comp.begin], comp.len);
   }
 
-  // The actual text of the URL, in canonical ASCII form.
-  std::string spec_;
+  // Sets |spec_| to |spec|.
+  void SetSpec(std::string spec);
+
+  // Returns the empty string returned as the spec of empty URLs.
+  static const std::string& EmptySpec();
+
+  // The actual text of the URL, in canonical ASCII form. It is shared by the
+  // copies of this URL, and null if it is empty.
+  scoped_refptr<const base::RefCountedData<std::string>> spec_;
 
   // Set when the given URL is valid. Otherwise, we may still have a spec and
   // components, but they may not identify valid resources (for example, an
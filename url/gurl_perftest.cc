@@ -0,0 +1,111 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string.h>
+
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/test/perf_time_logger.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+#include "url/third_party/mozilla/url_parse.h"
+#include "url/url_canon.h"
+#include "url/url_canon_stdstring.h"
+
+namespace url {
+
+namespace {
+
+const int kIterations = 100000;
+
+// URLs that are already canonical, like most of the URLs that are parsed
+// again after coming out of IPC, history or the subresource filter.
+const char* const kCanonicalURLs[] = {
+    "https://www.example.com/",
+    "https://www.example.com/search?q=url+canonicalization&ie=utf-8&oe=utf-8"
+    "&client=chromium",
+    "https://cdn.example.net/static/js/vendor/framework/2018/bundle.min.js"
+    "?v=3f7a9c1e2b4d6f80",
+    "https://store.example.org/1-800-MY-STORE/WebObjects/Store.woa/wa/RSLID"
+    "?nnmm=browse&mco=578E9744&node=home/desktop/mac_pro",
+    "https://ads.example.com/pagead/conversion/1234567890/?random=1539600000"
+    "&cv=9&fst=1539600000&num=1&label=AbCdEfGhIjKlMnOpQr&guid=ON"
+    "&u_h=1080&u_w=1920&u_ah=1050&u_aw=1920&u_cd=24&u_his=2&u_tz=-420",
+};
+
+// URLs with characters that have to be escaped or unescaped, which take the
+// slow path.
+const char* const kNonCanonicalURLs[] = {
+    "HTTPS://WWW.Example.COM/a b/c\"d\"/e<f>?q=<script>&r=\"x\"",
+    "https://www.example.com/%7Euser/./dir/../file%2Ehtml?a='b'",
+};
+
+void ParseAndCanonicalize(const char* const* urls,
+                          size_t num_urls,
+                          const char* name) {
+  std::string output_str;
+  base::PerfTimeLogger timer(name);
+  for (int i = 0; i < kIterations; ++i) {
+    for (size_t j = 0; j < num_urls; ++j) {
+      int len = static_cast<int>(strlen(urls[j]));
+      Parsed parsed;
+      ParseStandardURL(urls[j], len, &parsed);
+      output_str.clear();
+      StdStringCanonOutput output(&output_str);
+      Parsed out_parsed;
+      CanonicalizeStandardURL(urls[j], len, parsed, nullptr, &output,
+                              &out_parsed);
+      output.Complete();
+    }
+  }
+  timer.Done();
+}
+
+TEST(GURLPerfTest, CanonicalizeCanonicalURLs) {
+  ParseAndCanonicalize(kCanonicalURLs, arraysize(kCanonicalURLs),
+                       "Canonicalize_CanonicalURLs");
+}
+
+TEST(GURLPerfTest, CanonicalizeNonCanonicalURLs) {
+  ParseAndCanonicalize(kNonCanonicalURLs, arraysize(kNonCanonicalURLs),
+                       "Canonicalize_NonCanonicalURLs");
+}
+
+TEST(GURLPerfTest, ConstructGURL) {
+  // Don't time creating the input strings.
+  std::vector<std::string> urls(std::begin(kCanonicalURLs),
+                                std::end(kCanonicalURLs));
+
+  for (const std::string& url : urls)
+    EXPECT_EQ(url, GURL(url).spec());
+
+  base::PerfTimeLogger timer("GURL_Construct_CanonicalURLs");
+  for (int i = 0; i < kIterations; ++i) {
+    for (const std::string& url : urls)
+      GURL gurl(url);
+  }
+  timer.Done();
+}
+
+// Copies URLs the way resource loads and history rows do.
+TEST(GURLPerfTest, CopyGURL) {
+  std::vector<GURL> urls(std::begin(kCanonicalURLs), std::end(kCanonicalURLs));
+  std::vector<GURL> copies;
+  copies.reserve(urls.size());
+
+  base::PerfTimeLogger timer("GURL_Copy_CanonicalURLs");
+  for (int i = 0; i < kIterations * 10; ++i) {
+    copies.clear();
+    for (const GURL& url : urls)
+      copies.push_back(url);
+  }
+  timer.Done();
+}
+
+}  // namespace
+
+}  // namespace url
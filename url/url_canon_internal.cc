@@ -7,11 +7,22 @@
 #include <errno.h>
 #include <stddef.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <cstdio>
 #include <string>
 
 #include "base/strings/utf_string_conversion_utils.h"
+#include "build/build_config.h"
+
+// NaCl does not allow intrinsics.
+#if defined(ARCH_CPU_X86_FAMILY) && !defined(OS_NACL)
+#include <emmintrin.h>
+#define URL_CANON_USE_SSE2
+#elif defined(ARCH_CPU_ARM_FAMILY) && defined(__ARM_NEON) && !defined(OS_NACL)
+#include <arm_neon.h>
+#define URL_CANON_USE_NEON
+#endif
 
 namespace url {
 
@@ -248,6 +259,51 @@ void AppendStringOfType(const base::char16* source, int length,
       source, length, type, output);
 }
 
+size_t CountPlainASCIIBlocks(const char* begin,
+                             const char* end,
+                             const char* special_chars) {
+  const char* p = begin;
+#if defined(URL_CANON_USE_SSE2)
+  const size_t num_special_chars = strlen(special_chars);
+  // Signed comparisons also treat the non-ASCII bytes as below the range.
+  const __m128i below_printable = _mm_set1_epi8(0x21);
+  const __m128i above_printable = _mm_set1_epi8(0x7e);
+  for (; end - p >= 16; p += 16) {
+    const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i special = _mm_or_si128(_mm_cmplt_epi8(chars, below_printable),
+                                   _mm_cmpgt_epi8(chars, above_printable));
+    for (size_t i = 0; i < num_special_chars; ++i) {
+      special = _mm_or_si128(
+          special, _mm_cmpeq_epi8(chars, _mm_set1_epi8(special_chars[i])));
+    }
+    if (_mm_movemask_epi8(special))
+      break;
+  }
+#elif defined(URL_CANON_USE_NEON)
+  const size_t num_special_chars = strlen(special_chars);
+  const uint8x16_t below_printable = vdupq_n_u8(0x21);
+  const uint8x16_t above_printable = vdupq_n_u8(0x7e);
+  for (; end - p >= 16; p += 16) {
+    const uint8x16_t chars = vld1q_u8(reinterpret_cast<const uint8_t*>(p));
+    uint8x16_t special = vorrq_u8(vcltq_u8(chars, below_printable),
+                                  vcgtq_u8(chars, above_printable));
+    for (size_t i = 0; i < num_special_chars; ++i) {
+      special = vorrq_u8(
+          special,
+          vceqq_u8(chars, vdupq_n_u8(static_cast<uint8_t>(special_chars[i]))));
+    }
+    uint8x8_t any_special =
+        vorr_u8(vget_low_u8(special), vget_high_u8(special));
+    any_special = vpmax_u8(any_special, any_special);
+    any_special = vpmax_u8(any_special, any_special);
+    any_special = vpmax_u8(any_special, any_special);
+    if (vget_lane_u8(any_special, 0))
+      break;
+  }
+#endif
+  return p - begin;
+}
+
 bool ReadUTFChar(const char* str, int* begin, int length,
                  unsigned* code_point_out) {
   // This depends on ints and int32s being the same thing. If they're not, it
@@ -82,6 +82,16 @@ void AppendStringOfType(const base::char16* source, int length,
                         SharedCharTypes type,
                         CanonOutput* output);
 
+// Returns the number of characters at the beginning of [|begin|, |end|) that
+// are in whole 16-byte blocks of printable ASCII characters (0x21 to 0x7e)
+// none of which are in |special_chars|. Canonicalizers use this to skip over
+// long runs of input that are already canonical without looking up every
+// character, and then scan the rest of the run with their own tables. Returns
+// 0 on platforms without SSE2 or NEON.
+size_t CountPlainASCIIBlocks(const char* begin,
+                             const char* end,
+                             const char* special_chars);
+
 // Maps the hex numerical values 0x0 to 0xf to the corresponding ASCII digit
 // that will be used to represent it.
 URL_EXPORT extern const char kHexCharLookup[0x10];
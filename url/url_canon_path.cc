@@ -77,6 +77,38 @@ const unsigned char kPathCharLookup[0x100] = {
      ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,
      ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE};
 
+// The printable ASCII characters that have the SPECIAL flag in
+// kPathCharLookup.
+const char kPathSpecialChars[] = "\"#%.<>?\\^`{|}";
+
+// Appends the run of characters starting at |begin| that DoPartialPath()
+// copies unchanged to |output|, and returns the index after it. Most paths
+// are already canonical, so they are copied in as many runs as they have dots
+// and escape sequences.
+int AppendPlainPathRun(const char* spec,
+                       int begin,
+                       int end,
+                       CanonOutput* output) {
+  int run_end = begin + static_cast<int>(CountPlainASCIIBlocks(
+                            &spec[begin], &spec[end], kPathSpecialChars));
+  while (run_end < end &&
+         !(kPathCharLookup[static_cast<unsigned char>(spec[run_end])] &
+           SPECIAL)) {
+    run_end++;
+  }
+  output->Append(&spec[begin], run_end - begin);
+  return run_end;
+}
+
+// 16-bit input has to be narrowed, so it is appended one character at a time.
+int AppendPlainPathRun(const base::char16* spec,
+                       int begin,
+                       int end,
+                       CanonOutput* output) {
+  output->push_back(static_cast<char>(spec[begin]));
+  return begin + 1;
+}
+
 enum DotDisposition {
   // The given dot is just part of a filename and is not special.
   NOT_A_DIRECTORY,
@@ -369,8 +401,9 @@ bool DoPartialPath(const CHAR* spec,
           AppendEscapedChar(out_ch, output);
         }
       } else {
-        // Nothing special about this character, just append it.
-        output->push_back(out_ch);
+        // Nothing special about this character, just append it along with
+        // the rest of the run of such characters.
+        i = AppendPlainPathRun(spec, i, end, output) - 1;
       }
     }
   }
@@ -66,6 +66,29 @@ void AppendRaw8BitQueryString(const CHAR* source, int length,
   }
 }
 
+// The printable ASCII characters that are not query characters in
+// kSharedCharTypeTable.
+const char kQuerySpecialChars[] = "\"#'<>";
+
+// 8-bit version of the above, which copies runs of query characters to the
+// output as a whole. Most queries have nothing to escape.
+void AppendRaw8BitQueryString(const char* source, int length,
+                              CanonOutput* output) {
+  int i = 0;
+  while (i < length) {
+    int run_end = i + static_cast<int>(CountPlainASCIIBlocks(
+                          &source[i], &source[length], kQuerySpecialChars));
+    while (run_end < length &&
+           IsQueryChar(static_cast<unsigned char>(source[run_end]))) {
+      run_end++;
+    }
+    output->Append(&source[i], run_end - i);
+    if (run_end < length)
+      AppendEscapedChar(static_cast<unsigned char>(source[run_end]), output);
+    i = run_end + 1;
+  }
+}
+
 // Runs the converter on the given UTF-8 input. Since the converter expects
 // UTF-16, we have to convert first. The converter must be non-NULL.
 void RunConverter(const char* spec,
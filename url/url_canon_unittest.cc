@@ -1280,6 +1280,48 @@ TEST(URLCanonTest, Query) {
   EXPECT_EQ("?a%20%00z%01", out_str);
 }
 
+// 8-bit paths and queries are copied in runs of characters that don't need
+// canonicalization, while 16-bit input is handled one character at a time.
+// Puts every ASCII character at every offset of input that is long enough for
+// the runs to be scanned in blocks, and checks that both give the same result.
+TEST(URLCanonTest, PathAndQueryRuns) {
+  const std::string kPlain = "/abcdefghijklmnopqrstuvwxyz0123456789/ABCDEFG";
+  for (size_t offset = 1; offset < kPlain.size(); offset++) {
+    for (int c = 0; c < 0x80; c++) {
+      std::string input8 = kPlain;
+      input8[offset] = static_cast<char>(c);
+      base::string16 input16(input8.begin(), input8.end());
+      Component in_comp(0, static_cast<int>(input8.size()));
+      Component out_comp;
+
+      std::string path8;
+      StdStringCanonOutput path_output8(&path8);
+      bool success8 =
+          CanonicalizePath(input8.data(), in_comp, &path_output8, &out_comp);
+      path_output8.Complete();
+      std::string path16;
+      StdStringCanonOutput path_output16(&path16);
+      bool success16 =
+          CanonicalizePath(input16.data(), in_comp, &path_output16, &out_comp);
+      path_output16.Complete();
+      EXPECT_EQ(path16, path8) << "offset " << offset << " char " << c;
+      EXPECT_EQ(success16, success8) << "offset " << offset << " char " << c;
+
+      std::string query8;
+      StdStringCanonOutput query_output8(&query8);
+      CanonicalizeQuery(input8.data(), in_comp, nullptr, &query_output8,
+                        &out_comp);
+      query_output8.Complete();
+      std::string query16;
+      StdStringCanonOutput query_output16(&query16);
+      CanonicalizeQuery(input16.data(), in_comp, nullptr, &query_output16,
+                        &out_comp);
+      query_output16.Complete();
+      EXPECT_EQ(query16, query8) << "offset " << offset << " char " << c;
+    }
+  }
+}
+
 TEST(URLCanonTest, Ref) {
   // Refs are trivial, it just checks the encoding.
   DualComponentCase ref_cases[] = {